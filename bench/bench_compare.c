@@ -0,0 +1,291 @@
+/**
+ * @file bench_compare.c
+ * @brief Comparison of benchmark runs against stored profiles
+ * @ingroup benchmark
+ */
+
+#include "bench_compare.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Minimal JSON reader for the layout vv_bench_write_results() produces */
+typedef struct {
+    const char* p;
+    const char* end;
+} json_cursor;
+
+static void skip_ws(json_cursor* c) {
+    while (c->p < c->end && isspace((unsigned char)*c->p)) c->p++;
+}
+
+static int expect(json_cursor* c, char ch) {
+    skip_ws(c);
+    if (c->p >= c->end || *c->p != ch) return -1;
+    c->p++;
+    return 0;
+}
+
+/* Consume ch if it is next; returns 1 if it was */
+static int accept(json_cursor* c, char ch) {
+    skip_ws(c);
+    if (c->p < c->end && *c->p == ch) {
+        c->p++;
+        return 1;
+    }
+    return 0;
+}
+
+static int parse_string(json_cursor* c, char* buf, size_t cap) {
+    size_t n = 0;
+    if (expect(c, '"') != 0) return -1;
+    while (c->p < c->end && *c->p != '"') {
+        char ch = *c->p++;
+        if (ch == '\\') {
+            if (c->p >= c->end) return -1;
+            ch = *c->p++;
+            if (ch == 'u') {
+                if (c->end - c->p < 4) return -1;
+                c->p += 4;
+                ch = '?';
+            } else if (ch == 'n') {
+                ch = '\n';
+            } else if (ch == 't') {
+                ch = '\t';
+            }
+        }
+        if (n + 1 < cap) buf[n++] = ch;
+    }
+    if (cap) buf[n] = '\0';
+    return expect(c, '"');
+}
+
+static int parse_number(json_cursor* c, double* value) {
+    char tmp[64];
+    size_t n = 0;
+    skip_ws(c);
+    while (c->p < c->end && n + 1 < sizeof(tmp) && strchr("+-0123456789.eE", *c->p)) {
+        tmp[n++] = *c->p++;
+    }
+    tmp[n] = '\0';
+    char* stop = NULL;
+    *value = strtod(tmp, &stop);
+    return (n == 0 || *stop != '\0') ? -1 : 0;
+}
+
+static int skip_value(json_cursor* c, int depth) {
+    double ignored;
+    char key[8];
+    if (depth > 32) return -1;
+    skip_ws(c);
+    if (c->p >= c->end) return -1;
+    switch (*c->p) {
+        case '"':
+            return parse_string(c, key, sizeof(key));
+        case '{':
+            c->p++;
+            if (accept(c, '}')) return 0;
+            do {
+                if (parse_string(c, key, sizeof(key)) != 0 || expect(c, ':') != 0 ||
+                    skip_value(c, depth + 1) != 0) {
+                    return -1;
+                }
+            } while (accept(c, ','));
+            return expect(c, '}');
+        case '[':
+            c->p++;
+            if (accept(c, ']')) return 0;
+            do {
+                if (skip_value(c, depth + 1) != 0) return -1;
+            } while (accept(c, ','));
+            return expect(c, ']');
+        default:
+            if (isalpha((unsigned char)*c->p)) {
+                while (c->p < c->end && isalpha((unsigned char)*c->p)) c->p++;
+                return 0;
+            }
+            return parse_number(c, &ignored);
+    }
+}
+
+static int parse_size(json_cursor* c, size_t* value) {
+    double v;
+    if (parse_number(c, &v) != 0 || v < 0.0) return -1;
+    *value = (size_t)v;
+    return 0;
+}
+
+static int parse_stats(json_cursor* c, vv_bench_stats* st) {
+    char key[32];
+    if (expect(c, '{') != 0) return -1;
+    if (accept(c, '}')) return 0;
+    do {
+        int rc;
+        if (parse_string(c, key, sizeof(key)) != 0 || expect(c, ':') != 0) return -1;
+        if (strcmp(key, "samples") == 0) rc = parse_size(c, &st->samples);
+        else if (strcmp(key, "iterations_per_sample") == 0) rc = parse_size(c, &st->iterations_per_sample);
+        else if (strcmp(key, "min_ns") == 0) rc = parse_number(c, &st->min_ns);
+        else if (strcmp(key, "median_ns") == 0) rc = parse_number(c, &st->median_ns);
+        else if (strcmp(key, "p95_ns") == 0) rc = parse_number(c, &st->p95_ns);
+        else if (strcmp(key, "p99_ns") == 0) rc = parse_number(c, &st->p99_ns);
+        else if (strcmp(key, "mean_ns") == 0) rc = parse_number(c, &st->mean_ns);
+        else if (strcmp(key, "stddev_ns") == 0) rc = parse_number(c, &st->stddev_ns);
+        else if (strcmp(key, "cycles_per_iteration") == 0) rc = parse_number(c, &st->cycles_per_iteration);
+        else rc = skip_value(c, 1);
+        if (rc != 0) return -1;
+    } while (accept(c, ','));
+    return expect(c, '}');
+}
+
+static int parse_result(json_cursor* c, vv_bench_suite* suite) {
+    vv_bench_result r;
+    char key[32];
+    memset(&r, 0, sizeof(r));
+    if (expect(c, '{') != 0) return -1;
+    if (!accept(c, '}')) {
+        do {
+            int rc;
+            if (parse_string(c, key, sizeof(key)) != 0 || expect(c, ':') != 0) return -1;
+            if (strcmp(key, "name") == 0) rc = parse_string(c, r.name, sizeof(r.name));
+            else if (strcmp(key, "elapsed_seconds") == 0) rc = parse_number(c, &r.elapsed_seconds);
+            else if (strcmp(key, "samples_per_second") == 0) rc = parse_number(c, &r.samples_per_second);
+            else if (strcmp(key, "real_time_factor") == 0) rc = parse_number(c, &r.real_time_factor);
+            else if (strcmp(key, "iterations") == 0) rc = parse_size(c, &r.iterations);
+            else if (strcmp(key, "stats") == 0) rc = parse_stats(c, &r.stats);
+            else rc = skip_value(c, 1);
+            if (rc != 0) return -1;
+        } while (accept(c, ','));
+        if (expect(c, '}') != 0) return -1;
+    }
+    if (r.name[0] == '\0') return -1;
+
+    if (vv_bench_add_result(suite, r.name, r.elapsed_seconds, r.samples_per_second,
+                            r.real_time_factor, r.iterations) != 0) {
+        return -1;
+    }
+    suite->results[suite->num_results - 1].stats = r.stats;
+    return 0;
+}
+
+static int parse_document(json_cursor* c, vv_bench_suite* suite) {
+    char key[32];
+    if (expect(c, '{') != 0) return -1;
+    if (accept(c, '}')) return 0;
+    do {
+        if (parse_string(c, key, sizeof(key)) != 0 || expect(c, ':') != 0) return -1;
+        if (strcmp(key, "results") == 0) {
+            if (expect(c, '[') != 0) return -1;
+            if (!accept(c, ']')) {
+                do {
+                    if (parse_result(c, suite) != 0) return -1;
+                } while (accept(c, ','));
+                if (expect(c, ']') != 0) return -1;
+            }
+        } else if (skip_value(c, 0) != 0) {
+            return -1;
+        }
+    } while (accept(c, ','));
+    return expect(c, '}');
+}
+
+int vv_bench_load_results(const char* path, vv_bench_suite* suite) {
+    if (!path || !suite) return -1;
+    memset(suite, 0, sizeof(*suite));
+    suite->json_format = 1;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    if (fseek(f, 0, SEEK_END) != 0) {
+        fclose(f);
+        return -1;
+    }
+    long size = ftell(f);
+    if (size < 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return -1;
+    }
+    char* text = (char*)malloc((size_t)size + 1);
+    if (!text) {
+        fclose(f);
+        return -1;
+    }
+    size_t got = fread(text, 1, (size_t)size, f);
+    fclose(f);
+
+    json_cursor c;
+    c.p = text;
+    c.end = text + got;
+    int rc = parse_document(&c, suite);
+    free(text);
+    if (rc != 0) {
+        vv_bench_suite_free(suite);
+    }
+    return rc;
+}
+
+double vv_bench_time_per_iteration(const vv_bench_result* result) {
+    if (!result) return 0.0;
+    if (result->stats.samples > 0 && result->stats.median_ns > 0.0) {
+        return result->stats.median_ns;
+    }
+    if (result->iterations > 0 && result->elapsed_seconds > 0.0) {
+        return result->elapsed_seconds * 1e9 / (double)result->iterations;
+    }
+    return 0.0;
+}
+
+static const vv_bench_result* find_result(const vv_bench_suite* suite, const char* name) {
+    size_t i;
+    for (i = 0; i < suite->num_results; i++) {
+        if (strcmp(suite->results[i].name, name) == 0) return &suite->results[i];
+    }
+    return NULL;
+}
+
+int vv_bench_compare(const vv_bench_suite* baseline, const vv_bench_suite* current,
+                     double threshold, FILE* report) {
+    if (!baseline || !current || threshold < 0.0) return -1;
+
+    int regressions = 0;
+    size_t i;
+    for (i = 0; i < current->num_results; i++) {
+        const vv_bench_result* cur = &current->results[i];
+        const vv_bench_result* base = find_result(baseline, cur->name);
+        const double t_cur = vv_bench_time_per_iteration(cur);
+        const double t_base = base ? vv_bench_time_per_iteration(base) : 0.0;
+
+        if (!base || t_base <= 0.0 || t_cur <= 0.0) {
+            if (report) fprintf(report, "  %-32s no baseline\n", cur->name);
+            continue;
+        }
+
+        const double change = t_cur / t_base - 1.0;
+        const char* verdict = "ok";
+        if (change > threshold) {
+            /* Distributions that still overlap are treated as noise */
+            const int separated = !(cur->stats.samples > 0 && base->stats.samples > 0) ||
+                                  cur->stats.min_ns > base->stats.p95_ns;
+            if (separated) {
+                verdict = "REGRESSION";
+                regressions++;
+            } else {
+                verdict = "within noise";
+            }
+        } else if (change < -threshold) {
+            verdict = "faster";
+        }
+        if (report) {
+            fprintf(report, "  %-32s %12.1f ns -> %12.1f ns  %+7.1f%%  %s\n",
+                    cur->name, t_base, t_cur, change * 100.0, verdict);
+        }
+    }
+
+    if (report) {
+        for (i = 0; i < baseline->num_results; i++) {
+            if (!find_result(current, baseline->results[i].name)) {
+                fprintf(report, "  %-32s not run\n", baseline->results[i].name);
+            }
+        }
+    }
+    return regressions;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file bench_compare.h
+ * @brief Comparison of benchmark runs against stored profiles
+ * @ingroup benchmark
+ */
+
+#ifndef VV_DSP_BENCH_COMPARE_H
+#define VV_DSP_BENCH_COMPARE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "bench_framework.h"
+
+/**
+ * @brief Load results written by vv_bench_write_results() in JSON format
+ * @param path JSON file (e.g. docs/profiles/stft_profile.json)
+ * @param suite Suite to fill; release it with vv_bench_suite_free()
+ * @return 0 on success, non-zero if the file cannot be read or parsed
+ *
+ * @details Only the suite's own layout is understood: a top-level
+ * "results" array of objects with the fields vv_bench_write_results()
+ * emits. Other keys are skipped.
+ */
+int vv_bench_load_results(const char* path, vv_bench_suite* suite);
+
+/**
+ * @brief Time one iteration of a result took, in nanoseconds
+ * @return stats.median_ns for sampled results, elapsed_seconds / iterations
+ *         otherwise, 0 when neither is known
+ */
+double vv_bench_time_per_iteration(const vv_bench_result* result);
+
+/**
+ * @brief Compare current results with a baseline, matching them by name
+ * @param baseline Stored results
+ * @param current Results of this run
+ * @param threshold Allowed slowdown as a fraction (0.05 for 5%)
+ * @param report Where to print one line per compared benchmark (NULL for none)
+ * @return Number of regressions, or -1 on invalid arguments
+ *
+ * @details A benchmark regresses when its time per iteration grew by more
+ * than threshold. When both runs carry percentile data the slowdown must
+ * also stand out of the noise: the current run's fastest sample has to be
+ * slower than the baseline's p95, so overlapping distributions do not
+ * fail the comparison. Benchmarks missing from either side are reported
+ * but never count as regressions.
+ */
+int vv_bench_compare(const vv_bench_suite* baseline, const vv_bench_suite* current,
+                     double threshold, FILE* report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_BENCH_COMPARE_H */
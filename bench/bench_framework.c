@@ -5,6 +5,7 @@
  */
 
 #include "bench_framework.h"
+#include <math.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -16,17 +17,40 @@ int vv_bench_suite_init(vv_bench_suite* suite, FILE* output_file, int json_forma
     suite->json_format = json_format;
     suite->num_results = 0;
 
+    (void)vv_bench_timer_init();
+    suite->env.cpu = vv_bench_current_cpu();
+    suite->env.cpu_mhz = vv_bench_cpu_mhz();
+    suite->env.cpus_allowed = vv_bench_cpus_allowed();
+    suite->env.cycle_counter = vv_bench_cycle_source();
+
     return 0;
 }
 
+void vv_bench_suite_free(vv_bench_suite* suite) {
+    if (!suite) return;
+    free(suite->results);
+    suite->results = NULL;
+    suite->num_results = 0;
+    suite->capacity = 0;
+}
+
 int vv_bench_add_result(vv_bench_suite* suite, const char* name,
                         double elapsed_seconds, double samples_per_second,
                         double rtf, size_t iterations) {
-    if (!suite || !name || suite->num_results >= VV_BENCH_MAX_RESULTS) {
+    if (!suite || !name) {
         return -1;
     }
 
+    if (suite->num_results == suite->capacity) {
+        const size_t capacity = suite->capacity ? suite->capacity * 2 : 32;
+        vv_bench_result* grown = (vv_bench_result*)realloc(suite->results, capacity * sizeof(vv_bench_result));
+        if (!grown) return -1;
+        suite->results = grown;
+        suite->capacity = capacity;
+    }
+
     vv_bench_result* result = &suite->results[suite->num_results];
+    memset(result, 0, sizeof(*result));
 
     /* Copy name with bounds checking */
     strncpy(result->name, name, VV_BENCH_MAX_NAME_LEN - 1);
@@ -48,11 +72,16 @@ static void write_json_results(vv_bench_suite* suite) {
 
     fprintf(out, "{\n");
     fprintf(out, "  \"benchmark_suite\": \"vv-dsp\",\n");
+    fprintf(out, "  \"environment\": {\"cpu_mhz\": %.1f, \"cpu\": %d, \"cpus_allowed\": %zu, "
+                 "\"cycle_counter\": \"%s\"},\n",
+            suite->env.cpu_mhz, suite->env.cpu, suite->env.cpus_allowed,
+            suite->env.cycle_counter ? suite->env.cycle_counter : "none");
     fprintf(out, "  \"results\": [\n");
 
     for (i = 0; i < suite->num_results; i++) {
         const vv_bench_result* r = &suite->results[i];
         if (!r->valid) continue;
+        const int extra_fields = r->latency.deadline_ns > 0.0 || r->scaling.threads > 0;
 
         fprintf(out, "    {\n");
         fprintf(out, "      \"name\": \"%s\",\n", r->name);
@@ -66,7 +95,34 @@ static void write_json_results(vv_bench_suite* suite) {
             fprintf(out, "      \"real_time_factor\": %.6f,\n", r->real_time_factor);
         }
 
-        fprintf(out, "      \"iterations\": %zu\n", r->iterations);
+        if (r->stats.samples > 0) {
+            const vv_bench_stats* st = &r->stats;
+            fprintf(out, "      \"iterations\": %zu,\n", r->iterations);
+            fprintf(out, "      \"stats\": {\"samples\": %zu, \"iterations_per_sample\": %zu, "
+                         "\"min_ns\": %.3f, \"median_ns\": %.3f, \"p95_ns\": %.3f, \"p99_ns\": %.3f, "
+                         "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"cycles_per_iteration\": %.1f}%s\n",
+                    st->samples, st->iterations_per_sample, st->min_ns, st->median_ns, st->p95_ns,
+                    st->p99_ns, st->mean_ns, st->stddev_ns, st->cycles_per_iteration,
+                    extra_fields ? "," : "");
+        } else {
+            fprintf(out, "      \"iterations\": %zu%s\n", r->iterations, extra_fields ? "," : "");
+        }
+        if (r->latency.deadline_ns > 0.0) {
+            const vv_bench_latency* lat = &r->latency;
+            size_t b;
+            fprintf(out, "      \"latency\": {\"deadline_ns\": %.1f, \"max_ns\": %.1f, \"misses\": %zu, "
+                         "\"sched_fifo\": %s, \"histogram\": [",
+                    lat->deadline_ns, lat->max_ns, lat->misses, lat->sched_fifo ? "true" : "false");
+            for (b = 0; b < VV_BENCH_LATENCY_BUCKETS; b++) {
+                fprintf(out, "%s%zu", b ? ", " : "", lat->histogram[b]);
+            }
+            fprintf(out, "]}%s\n", r->scaling.threads > 0 ? "," : "");
+        }
+        if (r->scaling.threads > 0) {
+            fprintf(out, "      \"scaling\": {\"threads\": %zu, \"speedup\": %.3f, \"efficiency\": %.3f, "
+                         "\"bytes_per_second\": %.1f}\n",
+                    r->scaling.threads, r->scaling.speedup, r->scaling.efficiency, r->scaling.bytes_per_second);
+        }
         fprintf(out, "    }");
 
         if (i < suite->num_results - 1) {
@@ -85,6 +141,9 @@ static void write_text_results(vv_bench_suite* suite) {
 
     fprintf(out, "vv-dsp Benchmark Results\n");
     fprintf(out, "========================\n\n");
+    fprintf(out, "CPU %d at %.1f MHz, %zu CPU(s) allowed, cycle counter: %s\n\n",
+            suite->env.cpu, suite->env.cpu_mhz, suite->env.cpus_allowed,
+            suite->env.cycle_counter ? suite->env.cycle_counter : "none");
 
     for (i = 0; i < suite->num_results; i++) {
         const vv_bench_result* r = &suite->results[i];
@@ -103,6 +162,40 @@ static void write_text_results(vv_bench_suite* suite) {
                    (r->real_time_factor < 1.0) ? " (real-time capable)" : " (not real-time)");
         }
 
+        if (r->stats.samples > 0) {
+            const vv_bench_stats* st = &r->stats;
+            fprintf(out, "  Per iteration: min %.1f ns, median %.1f ns, p95 %.1f ns, p99 %.1f ns, "
+                         "stddev %.1f ns (%zu samples x %zu)\n",
+                    st->min_ns, st->median_ns, st->p95_ns, st->p99_ns, st->stddev_ns,
+                    st->samples, st->iterations_per_sample);
+            if (st->cycles_per_iteration > 0.0) {
+                fprintf(out, "  Cycles per iteration: %.1f\n", st->cycles_per_iteration);
+            }
+        }
+
+        if (r->latency.deadline_ns > 0.0) {
+            const vv_bench_latency* lat = &r->latency;
+            size_t b;
+            fprintf(out, "  Deadline %.1f us: %zu of %zu callbacks missed, worst %.1f us%s\n",
+                    lat->deadline_ns / 1e3, lat->misses, r->iterations, lat->max_ns / 1e3,
+                    lat->sched_fifo ? "" : " (no real-time priority)");
+            fprintf(out, "  Latency / deadline:");
+            for (b = 0; b < VV_BENCH_LATENCY_BUCKETS; b++) {
+                if (b < VV_BENCH_LATENCY_BUCKETS - 1) {
+                    fprintf(out, " <%g%%: %zu", vv_bench_latency_edges[b] * 100.0, lat->histogram[b]);
+                } else {
+                    fprintf(out, " >=%g%%: %zu", vv_bench_latency_edges[b - 1] * 100.0, lat->histogram[b]);
+                }
+            }
+            fprintf(out, "\n");
+        }
+
+        if (r->scaling.threads > 0) {
+            fprintf(out, "  Threads %zu: speedup %.2f, efficiency %.0f%%, %.1f MB/s\n",
+                    r->scaling.threads, r->scaling.speedup, r->scaling.efficiency * 100.0,
+                    r->scaling.bytes_per_second / 1e6);
+        }
+
         fprintf(out, "\n");
     }
 }
@@ -123,28 +216,157 @@ int vv_bench_write_results(vv_bench_suite* suite) {
     return 0;
 }
 
+static int compare_double(const void* a, const void* b) {
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static double percentile(const double* sorted, size_t n, double p) {
+    size_t rank = (size_t)ceil(p * (double)n);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+static double median(const double* sorted, size_t n) {
+    return (n % 2) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+/* Distribution of n per-iteration times; sorts ns */
+static void fill_stats(double* ns, size_t n, vv_bench_stats* st) {
+    double sum = 0.0, sq = 0.0;
+    size_t k;
+    memset(st, 0, sizeof(*st));
+    st->samples = n;
+    for (k = 0; k < n; k++) sum += ns[k];
+    st->mean_ns = sum / (double)n;
+    for (k = 0; k < n; k++) sq += (ns[k] - st->mean_ns) * (ns[k] - st->mean_ns);
+    st->stddev_ns = n > 1 ? sqrt(sq / (double)(n - 1)) : 0.0;
+    qsort(ns, n, sizeof(double), compare_double);
+    st->min_ns = ns[0];
+    st->median_ns = median(ns, n);
+    st->p95_ns = percentile(ns, n, 0.95);
+    st->p99_ns = percentile(ns, n, 0.99);
+}
+
+/* Time `samples` samples covering `iterations` calls (spread as evenly as possible) */
+static int run_samples(vv_bench_suite* suite, const char* name,
+                       void (*func)(void* ctx), void* ctx, size_t samples, size_t iterations,
+                       size_t warmup_iterations, double items_per_iteration) {
+    double* ns = (double*)malloc(2 * samples * sizeof(double));
+    if (!ns) return -1;
+    double* cycles = ns + samples;
+    const int have_cycles = vv_bench_read_cycles() != 0;
+    const size_t base = iterations / samples, extra = iterations % samples;
+    size_t i, k;
+
+    for (i = 0; i < warmup_iterations; i++) {
+        func(ctx);
+    }
+
+    double total_seconds = 0.0;
+    for (k = 0; k < samples; k++) {
+        const size_t count = base + (k < extra ? 1 : 0);
+        const uint64_t c0 = vv_bench_read_cycles();
+        const vv_bench_time start = vv_bench_get_time();
+        for (i = 0; i < count; i++) {
+            func(ctx);
+        }
+        const vv_bench_time end = vv_bench_get_time();
+        const uint64_t c1 = vv_bench_read_cycles();
+        total_seconds += vv_bench_elapsed_seconds(start, end);
+        ns[k] = (double)vv_bench_elapsed_ns(start, end) / (double)count;
+        cycles[k] = (double)(c1 - c0) / (double)count;
+    }
+
+    vv_bench_stats st;
+    fill_stats(ns, samples, &st);
+    st.iterations_per_sample = base;
+    if (have_cycles) {
+        qsort(cycles, samples, sizeof(double), compare_double);
+        st.cycles_per_iteration = median(cycles, samples);
+    }
+    free(ns);
+
+    const double throughput = (items_per_iteration > 0.0 && st.median_ns > 0.0)
+                                  ? items_per_iteration * 1e9 / st.median_ns : 0.0;
+    if (vv_bench_add_result(suite, name, total_seconds, throughput, 0.0, iterations) != 0) {
+        return -1;
+    }
+    suite->results[suite->num_results - 1].stats = st;
+    return 0;
+}
+
+int vv_bench_run_sampled(vv_bench_suite* suite, const char* name,
+                         void (*func)(void* ctx), void* ctx,
+                         size_t samples, size_t iterations_per_sample,
+                         size_t warmup_iterations, double items_per_iteration) {
+    if (!suite || !name || !func || samples == 0 || iterations_per_sample == 0 ||
+        iterations_per_sample > (size_t)-1 / samples) {
+        return -1;
+    }
+    return run_samples(suite, name, func, ctx, samples, samples * iterations_per_sample,
+                       warmup_iterations, items_per_iteration);
+}
+
+typedef struct {
+    void (*func)(void);
+} plain_call;
+
+static void call_plain(void* ctx) {
+    ((const plain_call*)ctx)->func();
+}
+
 int vv_bench_run_timed(vv_bench_suite* suite, const char* name,
                        void (*func)(void), size_t iterations, size_t warmup_iterations) {
     if (!suite || !name || !func || iterations == 0) {
         return -1;
     }
 
-    size_t i;
+    /* Split into samples so the result also carries the spread of the run */
+    plain_call call;
+    call.func = func;
+    const size_t samples = iterations < VV_BENCH_DEFAULT_SAMPLES ? iterations : VV_BENCH_DEFAULT_SAMPLES;
+    return run_samples(suite, name, call_plain, &call, samples, iterations, warmup_iterations, 0.0);
+}
 
-    /* Warmup iterations */
-    for (i = 0; i < warmup_iterations; i++) {
-        func();
-    }
+const double vv_bench_latency_edges[VV_BENCH_LATENCY_BUCKETS - 1] = {
+    0.01, 0.02, 0.05, 0.1, 0.25, 0.5, 1.0
+};
 
-    /* Timed iterations */
-    vv_bench_time start = vv_bench_get_time();
+int vv_bench_add_latency(vv_bench_suite* suite, const char* name,
+                         double* latency_ns, size_t count, size_t misses,
+                         double deadline_ns, int sched_fifo, double items_per_callback) {
+    if (!suite || !name || !latency_ns || count == 0 || deadline_ns <= 0.0) {
+        return -1;
+    }
 
-    for (i = 0; i < iterations; i++) {
-        func();
+    vv_bench_latency lat;
+    size_t i, b;
+    memset(&lat, 0, sizeof(lat));
+    lat.deadline_ns = deadline_ns;
+    lat.misses = misses;
+    lat.sched_fifo = sched_fifo;
+    double total = 0.0;
+    for (i = 0; i < count; i++) {
+        const double ratio = latency_ns[i] / deadline_ns;
+        for (b = 0; b < VV_BENCH_LATENCY_BUCKETS - 1 && ratio >= vv_bench_latency_edges[b]; b++) {
+        }
+        lat.histogram[b]++;
+        total += latency_ns[i];
     }
 
-    vv_bench_time end = vv_bench_get_time();
-    double elapsed = vv_bench_elapsed_seconds(start, end);
+    vv_bench_stats st;
+    fill_stats(latency_ns, count, &st);
+    st.iterations_per_sample = 1;
+    lat.max_ns = latency_ns[count - 1];
 
-    return vv_bench_add_result(suite, name, elapsed, 0.0, 0.0, iterations);
+    const double throughput = (items_per_callback > 0.0 && st.median_ns > 0.0)
+                                  ? items_per_callback * 1e9 / st.median_ns : 0.0;
+    if (vv_bench_add_result(suite, name, total / 1e9, throughput, st.mean_ns / deadline_ns, count) != 0) {
+        return -1;
+    }
+    suite->results[suite->num_results - 1].stats = st;
+    suite->results[suite->num_results - 1].latency = lat;
+    return 0;
 }
@@ -16,15 +16,69 @@ extern "C" {
 #include "bench_timer.h"
 
 /**
- * @brief Maximum number of benchmark results
+ * @brief Timed samples vv_bench_run_timed() splits its iterations into
  */
-#define VV_BENCH_MAX_RESULTS 100
+#define VV_BENCH_DEFAULT_SAMPLES 31
 
 /**
  * @brief Maximum length for benchmark names
  */
 #define VV_BENCH_MAX_NAME_LEN 64
 
+/**
+ * @brief Per-iteration time distribution of a sampled benchmark
+ *
+ * Each sample times iterations_per_sample back-to-back calls; the figures
+ * below are that sample's time divided by iterations_per_sample, taken over
+ * all samples. Percentiles use the nearest rank.
+ */
+typedef struct {
+    size_t samples;                ///< Timed samples, 0 when the result carries no distribution
+    size_t iterations_per_sample;  ///< Calls per sample
+    double min_ns;                 ///< Fastest sample
+    double median_ns;              ///< Median sample
+    double p95_ns;                 ///< 95th percentile
+    double p99_ns;                 ///< 99th percentile
+    double mean_ns;                ///< Mean over samples
+    double stddev_ns;              ///< Sample standard deviation
+    double cycles_per_iteration;   ///< Median counter ticks (see vv_bench_cycle_source()), 0 without a counter
+} vv_bench_stats;
+
+/**
+ * @brief Buckets of a latency histogram (see vv_bench_latency_edges)
+ */
+#define VV_BENCH_LATENCY_BUCKETS 8
+
+/**
+ * @brief Upper edges of the first VV_BENCH_LATENCY_BUCKETS - 1 histogram
+ *        buckets, as fractions of the deadline; the last bucket is open
+ */
+extern const double vv_bench_latency_edges[VV_BENCH_LATENCY_BUCKETS - 1];
+
+/**
+ * @brief Per-callback latency of a simulated audio callback loop
+ *
+ * Filled by vv_bench_add_latency(); the result's stats then describe single
+ * callbacks (iterations_per_sample == 1).
+ */
+typedef struct {
+    double deadline_ns;            ///< Callback period, 0 when the result is no latency run
+    double max_ns;                 ///< Slowest callback
+    size_t misses;                 ///< Callbacks that finished after their deadline
+    size_t histogram[VV_BENCH_LATENCY_BUCKETS]; ///< Callbacks by latency / deadline
+    int sched_fifo;                ///< 1 if the loop ran at real-time priority
+} vv_bench_latency;
+
+/**
+ * @brief Multi-core scaling of one workload at one thread count
+ */
+typedef struct {
+    size_t threads;                ///< Workers used, 0 when the result is no scaling run
+    double speedup;                ///< Single-thread median over this median
+    double efficiency;             ///< speedup / threads
+    double bytes_per_second;       ///< Input and output bytes moved per second at the median
+} vv_bench_scaling;
+
 /**
  * @brief Benchmark result data structure
  */
@@ -35,16 +89,31 @@ typedef struct {
     double real_time_factor;          ///< RTF for audio processing benchmarks
     size_t iterations;                 ///< Number of iterations performed
     int valid;                         ///< 1 if result is valid, 0 otherwise
+    vv_bench_stats stats;              ///< Distribution of sampled runs (stats.samples == 0 otherwise)
+    vv_bench_latency latency;          ///< Callback loop figures (latency.deadline_ns == 0 otherwise)
+    vv_bench_scaling scaling;          ///< Thread scaling figures (scaling.threads == 0 otherwise)
 } vv_bench_result;
 
+/**
+ * @brief Machine state captured by vv_bench_suite_init()
+ */
+typedef struct {
+    double cpu_mhz;                    ///< Clock of the benchmarking CPU, 0 if unknown
+    int cpu;                           ///< CPU the suite started on, -1 if unknown
+    size_t cpus_allowed;               ///< CPUs in the affinity mask (1 when pinned), 0 if unknown
+    const char* cycle_counter;         ///< "pmu", "tsc" or "none"
+} vv_bench_env;
+
 /**
  * @brief Benchmark suite context
  */
 typedef struct {
-    vv_bench_result results[VV_BENCH_MAX_RESULTS];
+    vv_bench_result* results;          ///< num_results entries, grown on demand
     size_t num_results;
+    size_t capacity;                   ///< Allocated entries of results
     FILE* output_file;                 ///< Output file for results (NULL for stdout)
     int json_format;                   ///< 1 for JSON output, 0 for text
+    vv_bench_env env;                  ///< Machine state, written to the output
 } vv_bench_suite;
 
 /**
@@ -53,9 +122,19 @@ typedef struct {
  * @param output_file Output file (NULL for stdout)
  * @param json_format 1 for JSON format, 0 for text format
  * @return 0 on success, non-zero on error
+ *
+ * @details Records the CPU, its clock, the affinity mask and the cycle
+ * counter in suite->env; pin the thread (vv_bench_pin_cpu()) before calling
+ * this to have the pinned state recorded.
  */
 int vv_bench_suite_init(vv_bench_suite* suite, FILE* output_file, int json_format);
 
+/**
+ * @brief Release the result storage of a suite
+ * @param suite Pointer to benchmark suite (NULL is ignored)
+ */
+void vv_bench_suite_free(vv_bench_suite* suite);
+
 /**
  * @brief Add a benchmark result to the suite
  * @param suite Pointer to benchmark suite
@@ -94,6 +173,47 @@ typedef void (*vv_bench_func)(vv_bench_suite* suite);
 int vv_bench_run_timed(vv_bench_suite* suite, const char* name,
                        void (*func)(void), size_t iterations, size_t warmup_iterations);
 
+/**
+ * @brief Run a benchmark as repeated timed samples and record their distribution
+ * @param suite Pointer to benchmark suite
+ * @param name Name of the benchmark
+ * @param func Function to benchmark, called with ctx
+ * @param ctx Argument passed to func
+ * @param samples Number of timed samples
+ * @param iterations_per_sample Calls per sample; raise it until one sample is
+ *        well above the timer resolution
+ * @param warmup_iterations Untimed calls before the first sample
+ * @param items_per_iteration Items (e.g. audio samples) one call processes, 0 for none;
+ *        the throughput is computed from the median
+ * @return 0 on success, non-zero on error
+ *
+ * @details elapsed_seconds and iterations cover all samples, as for
+ * vv_bench_run_timed().
+ */
+int vv_bench_run_sampled(vv_bench_suite* suite, const char* name,
+                         void (*func)(void* ctx), void* ctx,
+                         size_t samples, size_t iterations_per_sample,
+                         size_t warmup_iterations, double items_per_iteration);
+
+/**
+ * @brief Record the per-callback latencies of a callback loop
+ * @param suite Pointer to benchmark suite
+ * @param name Name of the benchmark
+ * @param latency_ns Time each callback took; sorted in place
+ * @param count Number of callbacks
+ * @param misses Callbacks that finished after their deadline
+ * @param deadline_ns Callback period
+ * @param sched_fifo 1 if the loop ran at real-time priority
+ * @param items_per_callback Samples one callback processes
+ * @return 0 on success, non-zero on error
+ *
+ * @details The real-time factor is the mean callback time over the
+ * deadline, i.e. the share of the period the callback occupies.
+ */
+int vv_bench_add_latency(vv_bench_suite* suite, const char* name,
+                         double* latency_ns, size_t count, size_t misses,
+                         double deadline_ns, int sched_fifo, double items_per_callback);
+
 #ifdef __cplusplus
 }
 #endif
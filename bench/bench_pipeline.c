@@ -161,6 +161,86 @@ static void benchmark_complete_audio_pipeline(vv_bench_suite* suite) {
     vv_dsp_stft_destroy(stft_handle);
 }
 
+/* Graph kernel: the same gate over the half spectrum (2 reals per bin) */
+static vv_dsp_status graph_gate_kernel(void* user, const vv_dsp_real* const* inputs, size_t num_inputs,
+                                       size_t num_items, size_t width, vv_dsp_real* out) {
+    size_t i;
+    (void)user;
+    (void)num_inputs;
+    memcpy(out, inputs[0], num_items * width * sizeof(vv_dsp_real));
+    for (i = 0; i < num_items; i++) {
+        spectral_processing_placeholder((vv_dsp_cpx*)(void*)(out + i * width), width / 2);
+    }
+    return VV_DSP_OK;
+}
+
+static void benchmark_graph_audio_pipeline(vv_bench_suite* suite) {
+    /*
+     * The complete pipeline as a vv_dsp_graph fed 256-sample blocks:
+     * Input -> Pre-emphasis FIR -> STFT -> Gate -> ISTFT -> Output.
+     * Buffers are planned once by prepare; process makes no allocations.
+     */
+
+    const size_t block = 256;
+    const vv_dsp_real preemph[2] = {1.0f, -0.95f};
+    const vv_dsp_graph_kernel gate = {graph_gate_kernel, NULL};
+    vv_dsp_stft_params stft_params = {
+        .fft_size = PIPELINE_FRAME_SIZE,
+        .hop_size = PIPELINE_HOP_SIZE,
+        .window = VV_DSP_STFT_WIN_HANN,
+        .spectrum = VV_DSP_STFT_SPECTRUM_HALF
+    };
+
+    vv_dsp_graph* graph = NULL;
+    vv_dsp_graph_node in, fir, stft, gated, istft;
+    size_t out_index;
+    vv_dsp_status status = vv_dsp_graph_create(&graph);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_input(graph, &in);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_fir(graph, in, preemph, 2, &fir);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_stft(graph, fir, &stft_params, &stft);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_custom(graph, &stft, 1, &gate, &gated);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_istft(graph, gated, &stft_params, &istft);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_add_output(graph, istft, &out_index);
+    if (status == VV_DSP_OK) status = vv_dsp_graph_prepare(graph, block, 48000.0);
+    if (status != VV_DSP_OK) {
+        fprintf(stderr, "Failed to build graph for pipeline benchmark\n");
+        vv_dsp_graph_destroy(graph);
+        return;
+    }
+
+    generate_test_audio(input_signal, PIPELINE_SIGNAL_LEN);
+
+    vv_bench_time start = vv_bench_get_time();
+
+    size_t iter;
+    for (iter = 0; iter < PIPELINE_NUM_ITERATIONS; iter++) {
+        size_t pos, written = 0;
+        (void)vv_dsp_graph_reset(graph);
+        for (pos = 0; pos + block <= PIPELINE_SIGNAL_LEN; pos += block) {
+            const vv_dsp_real* src = input_signal + pos;
+            const vv_dsp_real* data = NULL;
+            size_t items = 0;
+            if (vv_dsp_graph_process(graph, &src, block) != VV_DSP_OK) break;
+            if (vv_dsp_graph_output(graph, out_index, &data, &items) != VV_DSP_OK) break;
+            memcpy(processed_signal + written, data, items * sizeof(vv_dsp_real));
+            written += items;
+        }
+    }
+
+    vv_bench_time end = vv_bench_get_time();
+    double elapsed = vv_bench_elapsed_seconds(start, end);
+
+    double total_samples = (double)(PIPELINE_SIGNAL_LEN * PIPELINE_NUM_ITERATIONS);
+    double samples_per_second = total_samples / elapsed;
+    double audio_duration = (double)PIPELINE_SIGNAL_LEN / 48000.0;
+    double total_audio_duration = audio_duration * (double)PIPELINE_NUM_ITERATIONS;
+    double rtf = elapsed / total_audio_duration;
+
+    vv_bench_add_result(suite, "Graph_Audio_Pipeline", elapsed, samples_per_second, rtf, PIPELINE_NUM_ITERATIONS);
+
+    vv_dsp_graph_destroy(graph);
+}
+
 static void benchmark_realtime_processing_simulation(vv_bench_suite* suite) {
     /*
      * Simulate real-time processing with small frame buffers
@@ -306,6 +386,7 @@ void run_pipeline_benchmarks(vv_bench_suite* suite) {
 
     /* Run end-to-end pipeline benchmarks */
     benchmark_complete_audio_pipeline(suite);
+    benchmark_graph_audio_pipeline(suite);
     benchmark_realtime_processing_simulation(suite);
     benchmark_memory_intensive_pipeline(suite);
 }
@@ -0,0 +1,372 @@
+/**
+ * @file bench_realtime.c
+ * @brief Per-callback latency and deadline misses of the streaming modules
+ * @ingroup benchmark
+ *
+ * The throughput benchmarks process long buffers; an audio host instead calls
+ * the library once per 32-512 sample block and needs every call to finish
+ * within the block period. These loops drive each prepared streaming module,
+ * and a graph chaining several of them, the way a host callback would and
+ * record how long every call took.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+#include "vv_dsp/graph.h"
+#include "bench_realtime.h"
+#include "bench_timer.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+#define RT_SIGNAL_LEN       16384
+#define RT_MIN_CALLBACKS    64
+#define RT_COLD_CALLBACKS   32
+#define RT_EVICT_BYTES      (32u * 1024u * 1024u)  /* larger than the last-level cache */
+#define RT_CACHE_LINE       64
+
+/* Everything one module needs; each uses its own members */
+typedef struct {
+    vv_dsp_fir_state fir;
+    vv_dsp_real* taps;
+    vv_dsp_iir_plan* iir;
+    vv_dsp_resampler* rs;
+    vv_dsp_stft* stft;
+    size_t hop;
+    vv_dsp_graph* graph;
+    vv_dsp_cpx* spectrum;
+    vv_dsp_real* out;
+    size_t out_cap;
+} rt_object;
+
+typedef struct {
+    const char* name;
+    int (*create)(rt_object* obj, size_t max_block, double sample_rate);
+    int (*process)(rt_object* obj, const vv_dsp_real* in, size_t n);
+} rt_module;
+
+static vv_dsp_real rt_signal[RT_SIGNAL_LEN];
+static unsigned char* rt_evict_buffer;
+static volatile unsigned rt_evict_sink;
+
+/* ---- Modules ---- */
+
+static int fir_create(rt_object* obj, size_t max_block, double sample_rate) {
+    const size_t taps = 128;
+    (void)sample_rate;
+    obj->taps = (vv_dsp_real*)malloc(taps * sizeof(vv_dsp_real));
+    obj->out_cap = max_block;
+    obj->out = (vv_dsp_real*)malloc(obj->out_cap * sizeof(vv_dsp_real));
+    if (!obj->taps || !obj->out) return -1;
+    if (vv_dsp_fir_design_lowpass(obj->taps, taps, (vv_dsp_real)0.25, VV_DSP_WINDOW_HANNING) != VV_DSP_OK) return -1;
+    if (vv_dsp_fir_state_init(&obj->fir, taps) != VV_DSP_OK) return -1;
+    return vv_dsp_fir_state_prepare(&obj->fir, max_block) == VV_DSP_OK ? 0 : -1;
+}
+
+static int fir_process(rt_object* obj, const vv_dsp_real* in, size_t n) {
+    return vv_dsp_fir_apply(&obj->fir, obj->taps, in, obj->out, n) == VV_DSP_OK ? 0 : -1;
+}
+
+/* Four sections of a lowpass cascade */
+static int rt_biquads(vv_dsp_biquad* bq, size_t count) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        if (vv_dsp_biquad_init(&bq[i], (vv_dsp_real)0.0675, (vv_dsp_real)0.135, (vv_dsp_real)0.0675,
+                               (vv_dsp_real)-1.143, (vv_dsp_real)0.4128) != VV_DSP_OK) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int iir_create(rt_object* obj, size_t max_block, double sample_rate) {
+    vv_dsp_biquad bq[4];
+    (void)sample_rate;
+    obj->out_cap = max_block;
+    obj->out = (vv_dsp_real*)malloc(obj->out_cap * sizeof(vv_dsp_real));
+    if (!obj->out || rt_biquads(bq, 4) != 0) return -1;
+    return vv_dsp_iir_make_plan(bq, 4, VV_DSP_IIR_REALIZATION_BLOCK, &obj->iir) == VV_DSP_OK ? 0 : -1;
+}
+
+static int iir_process(rt_object* obj, const vv_dsp_real* in, size_t n) {
+    return vv_dsp_iir_plan_apply(obj->iir, in, obj->out, n) == VV_DSP_OK ? 0 : -1;
+}
+
+/* 44.1 kHz material to 48 kHz */
+static int resampler_create(rt_object* obj, size_t max_block, double sample_rate) {
+    (void)sample_rate;
+    obj->rs = vv_dsp_resampler_create(160, 147);
+    obj->out_cap = 2 * max_block + 64;
+    obj->out = (vv_dsp_real*)malloc(obj->out_cap * sizeof(vv_dsp_real));
+    if (!obj->rs || !obj->out) return -1;
+    if (vv_dsp_resampler_set_quality(obj->rs, 1, 32) != VV_DSP_OK) return -1;
+    return vv_dsp_resampler_prepare(obj->rs, max_block) == VV_DSP_OK ? 0 : -1;
+}
+
+static int resampler_process(rt_object* obj, const vv_dsp_real* in, size_t n) {
+    size_t produced = 0;
+    return vv_dsp_resampler_process_stream(obj->rs, in, n, obj->out, obj->out_cap, &produced) == VV_DSP_OK
+               ? 0 : -1;
+}
+
+/* Analysis and resynthesis of every frame the block completes */
+static int stft_create(rt_object* obj, size_t max_block, double sample_rate) {
+    vv_dsp_stft_params p;
+    (void)sample_rate;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = 1024;
+    p.hop_size = 256;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    obj->hop = p.hop_size;
+    obj->out_cap = (max_block / p.hop_size + 2) * p.hop_size;
+    obj->out = (vv_dsp_real*)malloc(obj->out_cap * sizeof(vv_dsp_real));
+    obj->spectrum = (vv_dsp_cpx*)malloc((p.fft_size / 2 + 1) * sizeof(vv_dsp_cpx));
+    if (!obj->out || !obj->spectrum) return -1;
+    if (vv_dsp_stft_create(&p, &obj->stft) != VV_DSP_OK) return -1;
+    return vv_dsp_stft_prepare(obj->stft, max_block) == VV_DSP_OK ? 0 : -1;
+}
+
+static int stft_process(rt_object* obj, const vv_dsp_real* in, size_t n) {
+    size_t pos = 0;
+    if (vv_dsp_stft_push(obj->stft, in, n) != VV_DSP_OK) return -1;
+    while (vv_dsp_stft_frames_ready(obj->stft) > 0) {
+        if (vv_dsp_stft_pop_frame(obj->stft, obj->spectrum) != VV_DSP_OK) return -1;
+        if (pos + obj->hop > obj->out_cap) pos = 0;
+        if (vv_dsp_stft_synth_frame(obj->stft, obj->spectrum, obj->out + pos) != VV_DSP_OK) return -1;
+        pos += obj->hop;
+    }
+    return 0;
+}
+
+/* input -> biquads -> STFT -> ISTFT -> output, and STFT -> power -> log-mel -> output */
+static int graph_create(rt_object* obj, size_t max_block, double sample_rate) {
+    vv_dsp_biquad bq[2];
+    vv_dsp_stft_params p;
+    vv_dsp_graph_node in, filt, spec, synth, power, mel;
+    size_t index;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = 512;
+    p.hop_size = 128;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    if (rt_biquads(bq, 2) != 0 || vv_dsp_graph_create(&obj->graph) != VV_DSP_OK) return -1;
+    if (vv_dsp_graph_add_input(obj->graph, &in) != VV_DSP_OK ||
+        vv_dsp_graph_add_biquad(obj->graph, in, bq, 2, &filt) != VV_DSP_OK ||
+        vv_dsp_graph_add_stft(obj->graph, filt, &p, &spec) != VV_DSP_OK ||
+        vv_dsp_graph_add_istft(obj->graph, spec, &p, &synth) != VV_DSP_OK ||
+        vv_dsp_graph_add_power(obj->graph, spec, &power) != VV_DSP_OK ||
+        vv_dsp_graph_add_log_mel(obj->graph, power, 40, 0, 0, VV_DSP_MEL_VARIANT_HTK, 0, &mel) != VV_DSP_OK ||
+        vv_dsp_graph_add_output(obj->graph, synth, &index) != VV_DSP_OK ||
+        vv_dsp_graph_add_output(obj->graph, mel, &index) != VV_DSP_OK) {
+        return -1;
+    }
+    return vv_dsp_graph_prepare(obj->graph, max_block, sample_rate) == VV_DSP_OK ? 0 : -1;
+}
+
+static int graph_process(rt_object* obj, const vv_dsp_real* in, size_t n) {
+    const vv_dsp_real* inputs[1];
+    inputs[0] = in;
+    return vv_dsp_graph_process(obj->graph, inputs, n) == VV_DSP_OK ? 0 : -1;
+}
+
+static void rt_object_free(rt_object* obj) {
+    vv_dsp_fir_state_free(&obj->fir);
+    free(obj->taps);
+    vv_dsp_iir_plan_destroy(obj->iir);
+    vv_dsp_resampler_destroy(obj->rs);
+    if (obj->stft) (void)vv_dsp_stft_destroy(obj->stft);
+    vv_dsp_graph_destroy(obj->graph);
+    free(obj->spectrum);
+    free(obj->out);
+    memset(obj, 0, sizeof(*obj));
+}
+
+static const rt_module rt_modules[] = {
+    {"fir", fir_create, fir_process},
+    {"iir", iir_create, iir_process},
+    {"resample", resampler_create, resampler_process},
+    {"stft", stft_create, stft_process},
+    {"graph", graph_create, graph_process},
+};
+
+/* ---- Callback loops ---- */
+
+/* Push code, tables and state out of the caches */
+static void evict_caches(void) {
+    size_t i;
+    unsigned sum = 0;
+    if (!rt_evict_buffer) return;
+    for (i = 0; i < RT_EVICT_BYTES; i += RT_CACHE_LINE) {
+        rt_evict_buffer[i]++;
+        sum += rt_evict_buffer[i];
+    }
+    rt_evict_sink = sum;
+}
+
+static const vv_dsp_real* block_input(size_t k, size_t block) {
+    return rt_signal + (k * block) % (RT_SIGNAL_LEN - block);
+}
+
+static void run_config(vv_bench_suite* suite, const rt_module* m, size_t block,
+                       const vv_bench_rt_config* config, int sched_fifo) {
+    const double deadline_ns = (double)block * 1e9 / config->sample_rate;
+    const uint64_t period_ns = (uint64_t)deadline_ns;
+    size_t steady = (size_t)(config->seconds * config->sample_rate / (double)block);
+    if (steady < RT_MIN_CALLBACKS) steady = RT_MIN_CALLBACKS;
+    const size_t warmup = steady / 8 + 1;
+    char name[VV_BENCH_MAX_NAME_LEN];
+    size_t k, misses = 0;
+
+    double* latency = (double*)malloc((steady > RT_COLD_CALLBACKS ? steady : RT_COLD_CALLBACKS) * sizeof(double));
+    rt_object obj;
+    memset(&obj, 0, sizeof(obj));
+    if (!latency || m->create(&obj, block, config->sample_rate) != 0) {
+        fprintf(stderr, "Error: Failed to set up the %s callback loop for %zu-sample blocks\n", m->name, block);
+        rt_object_free(&obj);
+        free(latency);
+        return;
+    }
+
+    /* Cold: the first call after preparation, then calls after a cache sweep */
+    for (k = 0; k < RT_COLD_CALLBACKS; k++) {
+        if (k > 0) evict_caches();
+        const vv_bench_time t0 = vv_bench_get_time();
+        const int rc = m->process(&obj, block_input(k, block), block);
+        const vv_bench_time t1 = vv_bench_get_time();
+        if (rc != 0) break;
+        latency[k] = (double)vv_bench_elapsed_ns(t0, t1);
+        if (latency[k] > deadline_ns) misses++;
+    }
+    snprintf(name, sizeof(name), "rt_%s_b%zu_cold", m->name, block);
+    if (k == RT_COLD_CALLBACKS) {
+        (void)vv_bench_add_latency(suite, name, latency, k, misses, deadline_ns, sched_fifo, (double)block);
+    }
+
+    /* Steady state: one call per block period, each due when the previous period ends */
+    misses = 0;
+    vv_bench_time due = vv_bench_get_time();
+    for (k = 0; k < warmup + steady; k++) {
+        vv_bench_sleep_until(due);
+        const vv_bench_time t0 = vv_bench_get_time();
+        const int rc = m->process(&obj, block_input(k, block), block);
+        const vv_bench_time t1 = vv_bench_get_time();
+        if (rc != 0) break;
+        const vv_bench_time deadline = vv_bench_time_add_ns(due, period_ns);
+        if (k >= warmup) {
+            latency[k - warmup] = (double)vv_bench_elapsed_ns(t0, t1);
+            if (t1.ticks > deadline.ticks) misses++;
+        }
+        /* An overrun restarts the schedule, as a host does after an xrun */
+        due = t1.ticks > deadline.ticks ? t1 : deadline;
+    }
+    snprintf(name, sizeof(name), "rt_%s_b%zu_steady", m->name, block);
+    if (k == warmup + steady) {
+        (void)vv_bench_add_latency(suite, name, latency, steady, misses, deadline_ns, sched_fifo, (double)block);
+    } else {
+        fprintf(stderr, "Error: %s failed during the callback loop\n", name);
+    }
+
+    rt_object_free(&obj);
+    free(latency);
+}
+
+typedef struct {
+    vv_bench_suite* suite;
+    const vv_bench_rt_config* config;
+    int cpu;
+} rt_job;
+
+static void* rt_thread(void* arg) {
+    const rt_job* job = (const rt_job*)arg;
+    size_t m, b;
+
+    if (job->cpu >= 0 && vv_bench_pin_cpu(job->cpu) != 0) {
+        fprintf(stderr, "Warning: Failed to pin the callback thread to CPU %d\n", job->cpu);
+    }
+    const int sched_fifo = vv_bench_set_realtime_priority() == 0;
+    if (!sched_fifo) {
+        fprintf(stderr, "Warning: No real-time priority for the callback thread; latencies include "
+                        "preemption by ordinary tasks\n");
+    }
+
+    for (m = 0; m < sizeof(rt_modules) / sizeof(rt_modules[0]); m++) {
+        for (b = 0; b < job->config->num_block_sizes; b++) {
+            run_config(job->suite, &rt_modules[m], job->config->block_sizes[b], job->config, sched_fifo);
+        }
+    }
+    return NULL;
+}
+
+void vv_bench_rt_config_default(vv_bench_rt_config* config) {
+    static const size_t blocks[] = {32, 64, 128, 256, 512};
+    size_t i;
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    for (i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        config->block_sizes[i] = blocks[i];
+    }
+    config->num_block_sizes = sizeof(blocks) / sizeof(blocks[0]);
+    config->sample_rate = 48000.0;
+    config->seconds = 0.5;
+    config->cpu = -1;
+}
+
+int vv_bench_rt_parse_blocks(vv_bench_rt_config* config, const char* list) {
+    size_t count = 0;
+    const char* p = list;
+    if (!config || !list) return -1;
+    while (*p) {
+        char* end = NULL;
+        const unsigned long v = strtoul(p, &end, 10);
+        if (end == p || v == 0 || count == VV_BENCH_RT_MAX_BLOCK_SIZES) return -1;
+        if (*end != ',' && *end != '\0') return -1;
+        config->block_sizes[count++] = (size_t)v;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    if (count == 0) return -1;
+    config->num_block_sizes = count;
+    return 0;
+}
+
+void run_realtime_benchmarks(vv_bench_suite* suite, const vv_bench_rt_config* config) {
+    size_t i;
+    if (!suite || !config || config->num_block_sizes == 0 || config->sample_rate <= 0.0) return;
+    for (i = 0; i < config->num_block_sizes; i++) {
+        if (config->block_sizes[i] == 0 || config->block_sizes[i] >= RT_SIGNAL_LEN) {
+            fprintf(stderr, "Error: Block size %zu out of range\n", config->block_sizes[i]);
+            return;
+        }
+    }
+
+    printf("Running real-time callback benchmarks...\n");
+    for (i = 0; i < RT_SIGNAL_LEN; i++) {
+        rt_signal[i] = (vv_dsp_real)(0.5 * sin(VV_DSP_TWO_PI_D * 440.0 * (double)i / config->sample_rate) +
+                                     0.1 * sin(VV_DSP_TWO_PI_D * 3100.0 * (double)i / config->sample_rate));
+    }
+    rt_evict_buffer = (unsigned char*)calloc(RT_EVICT_BYTES, 1);
+
+    rt_job job;
+    job.suite = suite;
+    job.config = config;
+    job.cpu = config->cpu >= 0 ? config->cpu : vv_bench_current_cpu();
+#ifndef _WIN32
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, rt_thread, &job) == 0) {
+        pthread_join(thread, NULL);
+    } else {
+        fprintf(stderr, "Warning: Failed to start the callback thread; running on the caller's\n");
+        rt_thread(&job);
+    }
+#else
+    /* Runs on the caller's thread, whose priority stays raised afterwards */
+    rt_thread(&job);
+#endif
+
+    free(rt_evict_buffer);
+    rt_evict_buffer = NULL;
+}
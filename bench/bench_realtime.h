@@ -0,0 +1,67 @@
+/**
+ * @file bench_realtime.h
+ * @brief Per-callback latency and deadline misses of the streaming modules
+ * @ingroup benchmark
+ */
+
+#ifndef VV_DSP_BENCH_REALTIME_H
+#define VV_DSP_BENCH_REALTIME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "bench_framework.h"
+
+/**
+ * @brief Most block sizes one run can cover
+ */
+#define VV_BENCH_RT_MAX_BLOCK_SIZES 16
+
+/**
+ * @brief Callback loop settings
+ */
+typedef struct {
+    size_t block_sizes[VV_BENCH_RT_MAX_BLOCK_SIZES]; ///< Samples per callback
+    size_t num_block_sizes;
+    double sample_rate;            ///< Hz; a callback's deadline is block / sample_rate
+    double seconds;                ///< Simulated audio per steady-state run
+    int cpu;                       ///< CPU for the callback thread, -1 for the CPU the caller runs on
+} vv_bench_rt_config;
+
+/**
+ * @brief Defaults: blocks of 32, 64, 128, 256 and 512 samples at 48 kHz,
+ *        half a second of audio per run
+ */
+void vv_bench_rt_config_default(vv_bench_rt_config* config);
+
+/**
+ * @brief Parse a comma-separated block size list such as "32,64,128"
+ * @return 0 on success, -1 on a malformed list, a zero size or too many sizes
+ */
+int vv_bench_rt_parse_blocks(vv_bench_rt_config* config, const char* list);
+
+/**
+ * @brief Run the FIR, IIR, resampler, STFT and graph callback loops
+ * @param suite Results are added as "rt_<module>_b<block>_cold" and "_steady"
+ * @param config Loop settings
+ *
+ * @details Every loop runs on its own thread, pinned to one CPU and at
+ * SCHED_FIFO priority where the OS grants it, as an audio callback would.
+ * Each configuration gives two results:
+ * - cold: the first callback after preparation, then callbacks that each
+ *   follow a pass over a buffer larger than the last-level cache, so code,
+ *   tables and state start out of cache;
+ * - steady: callbacks paced at the block period by sleeping until each
+ *   deadline, after a warm-up period that is not recorded.
+ * A callback misses its deadline when it finishes later than one block
+ * period after it was due to start, so wake-up lateness counts too.
+ */
+void run_realtime_benchmarks(vv_bench_suite* suite, const vv_bench_rt_config* config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_BENCH_REALTIME_H */
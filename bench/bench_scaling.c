@@ -0,0 +1,301 @@
+/**
+ * @file bench_scaling.c
+ * @brief Multi-core scaling of the parallel batch APIs
+ * @ingroup benchmark
+ *
+ * Runs each parallel workload at 1, 2, 4, ... threads up to a maximum and
+ * reports speedup and efficiency against the single-thread run, plus the
+ * bytes moved per second, so it shows where a workload stops scaling
+ * (memory bandwidth, shared caches, locks around plan creation).
+ *
+ * For every thread count a pool of exactly that many workers becomes the
+ * default pool, so the library's batch calls and the benchmark's own
+ * per-clip and per-stream loops see the same workers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+#include "bench_framework.h"
+#include "bench_timer.h"
+
+#define SCALE_RATE          16000.0
+#define SCALE_SIGNAL_LEN    (1u << 20)    /* about 65 s at 16 kHz */
+#define SCALE_FFT           1024
+#define SCALE_HOP           256
+#define SCALE_BINS          (SCALE_FFT / 2 + 1)
+#define SCALE_MELS          40
+#define SCALE_MFCC          13
+#define SCALE_MFCC_FRAMES   4096
+#define SCALE_LPC_FRAME     512
+#define SCALE_LPC_STRIDE    160
+#define SCALE_LPC_ORDER     24
+#define SCALE_CLIPS         64
+#define SCALE_CLIP_LEN      32000         /* 2 s clips */
+#define SCALE_STREAMS       512
+#define SCALE_STREAM_LEN    4096
+#define SCALE_STREAM_BLOCK  256
+#define SCALE_SAMPLES       5
+
+typedef struct {
+    const vv_dsp_real* signal;
+    vv_dsp_real* out;
+    size_t threads;
+    vv_dsp_status status;
+    /* spectrogram */
+    vv_dsp_stft* stft;
+    /* MFCC */
+    vv_dsp_mfcc_plan* mfcc;
+    const vv_dsp_real* power;
+    /* LPC */
+    vv_dsp_lpc_plan* lpc;
+    size_t lpc_frames;
+    /* corpus: one extractor per worker */
+    vv_dsp_feature_extractor** fx;
+    size_t fx_frames;
+    vv_dsp_status* clip_status;
+} scale_ctx;
+
+/* ---- Workloads ---- */
+
+static void run_spectrogram(void* arg) {
+    scale_ctx* c = (scale_ctx*)arg;
+    size_t frames = 0;
+    c->status = vv_dsp_stft_spectrogram_parallel(c->stft, c->signal, SCALE_SIGNAL_LEN, NULL, c->out, &frames,
+                                                 c->threads);
+}
+
+static void run_mfcc(void* arg) {
+    scale_ctx* c = (scale_ctx*)arg;
+    c->status = vv_dsp_mfcc_process_parallel(c->mfcc, c->power, SCALE_MFCC_FRAMES, c->out, c->threads);
+}
+
+static void run_lpc(void* arg) {
+    scale_ctx* c = (scale_ctx*)arg;
+    c->status = vv_dsp_lpc_plan_process(c->lpc, c->signal, c->lpc_frames, SCALE_LPC_STRIDE, c->out, NULL, NULL);
+}
+
+/* A corpus of clips, each streamed through the feature extractor of the worker that takes it */
+static void corpus_range(void* arg, size_t begin, size_t end, size_t worker) {
+    scale_ctx* c = (scale_ctx*)arg;
+    vv_dsp_feature_extractor* fx = c->fx[worker];
+    const size_t dim = vv_dsp_feature_extractor_frame_size(fx);
+    size_t k;
+    for (k = begin; k < end; k++) {
+        const vv_dsp_real* clip = c->signal + (k * SCALE_CLIP_LEN) % (SCALE_SIGNAL_LEN - SCALE_CLIP_LEN);
+        size_t frames = 0;
+        vv_dsp_status st = vv_dsp_feature_extractor_reset(fx);
+        if (st == VV_DSP_OK) {
+            st = vv_dsp_feature_extractor_process(fx, clip, SCALE_CLIP_LEN, c->out + k * c->fx_frames * dim,
+                                                  c->fx_frames, &frames);
+        }
+        c->clip_status[k] = st;
+    }
+}
+
+static void run_corpus(void* arg) {
+    scale_ctx* c = (scale_ctx*)arg;
+    size_t k;
+    c->status = vv_dsp_threadpool_parallel_for(NULL, SCALE_CLIPS, 1, corpus_range, c);
+    for (k = 0; k < SCALE_CLIPS && c->status == VV_DSP_OK; k++) c->status = c->clip_status[k];
+}
+
+/* Many short independent streams, each with its own STFT created, run and destroyed */
+static void stream_task(void* arg, size_t k) {
+    static const size_t sizes[] = {256, 384, 512};
+    scale_ctx* c = (scale_ctx*)arg;
+    vv_dsp_stft_params p;
+    vv_dsp_stft* h = NULL;
+    vv_dsp_cpx spectrum[512 / 2 + 1];
+    memset(&p, 0, sizeof(p));
+    p.fft_size = sizes[k % 3];
+    p.hop_size = p.fft_size / 4;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    const vv_dsp_real* x = c->signal + (k * SCALE_STREAM_LEN) % (SCALE_SIGNAL_LEN - SCALE_STREAM_LEN);
+    size_t pos;
+    vv_dsp_status st = vv_dsp_stft_create(&p, &h);
+    for (pos = 0; st == VV_DSP_OK && pos < SCALE_STREAM_LEN; pos += SCALE_STREAM_BLOCK) {
+        st = vv_dsp_stft_push(h, x + pos, SCALE_STREAM_BLOCK);
+        while (st == VV_DSP_OK && vv_dsp_stft_frames_ready(h) > 0) {
+            st = vv_dsp_stft_pop_frame(h, spectrum);
+        }
+    }
+    if (h) (void)vv_dsp_stft_destroy(h);
+    c->clip_status[k] = st;
+}
+
+static void run_streams(void* arg) {
+    scale_ctx* c = (scale_ctx*)arg;
+    size_t k;
+    c->status = vv_dsp_threadpool_run(NULL, SCALE_STREAMS, stream_task, c);
+    for (k = 0; k < SCALE_STREAMS && c->status == VV_DSP_OK; k++) c->status = c->clip_status[k];
+}
+
+typedef struct {
+    const char* name;
+    void (*run)(void* ctx);
+    double items;   /* samples or frames per run, for the throughput figure */
+    double bytes;   /* input and output bytes per run */
+    double base_ns; /* single-thread median, set by the first run */
+} scale_workload;
+
+/* ---- Driver ---- */
+
+static int setup(scale_ctx* c, vv_dsp_real* signal, size_t max_threads) {
+    vv_dsp_stft_params p;
+    vv_dsp_lpc_params lp;
+    vv_dsp_feature_params fp;
+    size_t i;
+
+    memset(&p, 0, sizeof(p));
+    p.fft_size = SCALE_FFT;
+    p.hop_size = SCALE_HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    if (vv_dsp_stft_create(&p, &c->stft) != VV_DSP_OK) return -1;
+    if (vv_dsp_mfcc_init(SCALE_FFT, SCALE_MELS, SCALE_MFCC, (vv_dsp_real)SCALE_RATE, 0, (vv_dsp_real)(SCALE_RATE / 2),
+                         VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22, (vv_dsp_real)1e-10, &c->mfcc) != VV_DSP_OK) {
+        return -1;
+    }
+
+    memset(&lp, 0, sizeof(lp));
+    lp.order = SCALE_LPC_ORDER;
+    lp.frame_len = SCALE_LPC_FRAME;
+    lp.preemphasis = (vv_dsp_real)0.97;
+    lp.num_threads = max_threads;
+    c->lpc_frames = (SCALE_SIGNAL_LEN - SCALE_LPC_FRAME) / SCALE_LPC_STRIDE + 1;
+    if (vv_dsp_lpc_plan_create(&lp, &c->lpc) != VV_DSP_OK) return -1;
+
+    memset(&fp, 0, sizeof(fp));
+    fp.sample_rate = (vv_dsp_real)SCALE_RATE;
+    fp.fft_size = 512;
+    fp.hop_size = 160;
+    fp.window = VV_DSP_STFT_WIN_HANN;
+    fp.n_mels = SCALE_MELS;
+    fp.kind = VV_DSP_FEATURE_LOG_MEL;
+    c->fx = (vv_dsp_feature_extractor**)calloc(max_threads, sizeof(vv_dsp_feature_extractor*));
+    if (!c->fx) return -1;
+    for (i = 0; i < max_threads; i++) {
+        if (vv_dsp_feature_extractor_create(&fp, &c->fx[i]) != VV_DSP_OK) return -1;
+    }
+    c->fx_frames = vv_dsp_feature_extractor_output_count(c->fx[0], SCALE_CLIP_LEN);
+
+    /* Largest output: the spectrogram's frames, the corpus' features or the LPC rows */
+    size_t out_len = (SCALE_SIGNAL_LEN / SCALE_HOP + 2) * SCALE_BINS;
+    const size_t corpus_len = SCALE_CLIPS * c->fx_frames * SCALE_MELS;
+    const size_t lpc_len = c->lpc_frames * (SCALE_LPC_ORDER + 1);
+    if (corpus_len > out_len) out_len = corpus_len;
+    if (lpc_len > out_len) out_len = lpc_len;
+    c->out = (vv_dsp_real*)malloc(out_len * sizeof(vv_dsp_real));
+    c->clip_status = (vv_dsp_status*)calloc(SCALE_STREAMS > SCALE_CLIPS ? SCALE_STREAMS : SCALE_CLIPS,
+                                            sizeof(vv_dsp_status));
+    if (!c->out || !c->clip_status) return -1;
+
+    /* The MFCC input is a power spectrogram of the signal's first frames */
+    vv_dsp_real* power = (vv_dsp_real*)malloc((size_t)SCALE_MFCC_FRAMES * SCALE_BINS * sizeof(vv_dsp_real));
+    if (!power) return -1;
+    for (i = 0; i < (size_t)SCALE_MFCC_FRAMES * SCALE_BINS; i++) {
+        power[i] = (vv_dsp_real)1e-3 + signal[i % SCALE_SIGNAL_LEN] * signal[i % SCALE_SIGNAL_LEN];
+    }
+    c->power = power;
+    c->signal = signal;
+    return 0;
+}
+
+static void teardown(scale_ctx* c, size_t max_threads) {
+    size_t i;
+    if (c->stft) (void)vv_dsp_stft_destroy(c->stft);
+    vv_dsp_mfcc_destroy(c->mfcc);
+    vv_dsp_lpc_plan_destroy(c->lpc);
+    if (c->fx) {
+        for (i = 0; i < max_threads; i++) vv_dsp_feature_extractor_destroy(c->fx[i]);
+    }
+    free(c->fx);
+    free(c->out);
+    free(c->clip_status);
+    free((void*)c->power);
+}
+
+static void run_at(vv_bench_suite* suite, scale_workload* w, scale_ctx* c, size_t threads) {
+    char name[VV_BENCH_MAX_NAME_LEN];
+    snprintf(name, sizeof(name), "scale_%s_t%zu", w->name, threads);
+    c->threads = threads;
+    c->status = VV_DSP_OK;
+    if (vv_bench_run_sampled(suite, name, w->run, c, SCALE_SAMPLES, 1, 1, w->items) != 0) return;
+    vv_bench_result* r = &suite->results[suite->num_results - 1];
+    if (c->status != VV_DSP_OK) {
+        fprintf(stderr, "Error: %s failed (status %d)\n", name, (int)c->status);
+        r->valid = 0;
+        return;
+    }
+    if (threads == 1) w->base_ns = r->stats.median_ns;
+    r->scaling.threads = threads;
+    r->scaling.speedup = (w->base_ns > 0.0 && r->stats.median_ns > 0.0) ? w->base_ns / r->stats.median_ns : 0.0;
+    r->scaling.efficiency = r->scaling.speedup / (double)threads;
+    r->scaling.bytes_per_second = r->stats.median_ns > 0.0 ? w->bytes * 1e9 / r->stats.median_ns : 0.0;
+}
+
+void run_scaling_benchmarks(vv_bench_suite* suite, size_t max_threads) {
+    const double real = (double)sizeof(vv_dsp_real);
+    scale_ctx c;
+    size_t i, t;
+
+    if (!suite) return;
+    if (max_threads == 0) max_threads = vv_bench_cpus_allowed();
+    if (max_threads == 0) max_threads = 1;
+    printf("Running multi-core scaling benchmarks (1..%zu threads)...\n", max_threads);
+
+    vv_dsp_real* signal = (vv_dsp_real*)malloc(SCALE_SIGNAL_LEN * sizeof(vv_dsp_real));
+    memset(&c, 0, sizeof(c));
+    if (!signal) return;
+    srand(7);
+    for (i = 0; i < SCALE_SIGNAL_LEN; i++) {
+        signal[i] = (vv_dsp_real)(0.4 * sin(VV_DSP_TWO_PI_D * 220.0 * (double)i / SCALE_RATE) +
+                                  0.1 * ((double)rand() / RAND_MAX - 0.5));
+    }
+    if (setup(&c, signal, max_threads) != 0) {
+        fprintf(stderr, "Error: Failed to set up the scaling benchmarks\n");
+        teardown(&c, max_threads);
+        free(signal);
+        return;
+    }
+
+    const double spec_frames = (double)vv_dsp_stft_spectrogram_frames(c.stft, SCALE_SIGNAL_LEN);
+    const double corpus_frames = (double)(SCALE_CLIPS * c.fx_frames);
+    scale_workload workloads[] = {
+        {"spectrogram", run_spectrogram, (double)SCALE_SIGNAL_LEN,
+         real * ((double)SCALE_SIGNAL_LEN + spec_frames * SCALE_BINS), 0.0},
+        {"mfcc", run_mfcc, (double)SCALE_MFCC_FRAMES,
+         real * (double)SCALE_MFCC_FRAMES * (SCALE_BINS + SCALE_MFCC), 0.0},
+        {"lpc", run_lpc, (double)c.lpc_frames,
+         real * (double)c.lpc_frames * (SCALE_LPC_FRAME + SCALE_LPC_ORDER + 1), 0.0},
+        {"corpus", run_corpus, (double)SCALE_CLIPS * SCALE_CLIP_LEN,
+         real * ((double)SCALE_CLIPS * SCALE_CLIP_LEN + corpus_frames * SCALE_MELS), 0.0},
+        /* Frames at a quarter-frame hop hold about four values per input sample */
+        {"small_streams", run_streams, (double)SCALE_STREAMS * SCALE_STREAM_LEN,
+         real * (double)SCALE_STREAMS * SCALE_STREAM_LEN * 5.0, 0.0},
+    };
+
+    for (t = 1; t <= max_threads; t = (t * 2 > max_threads && t < max_threads) ? max_threads : t * 2) {
+        vv_dsp_threadpool_params pp;
+        vv_dsp_threadpool* pool = NULL;
+        memset(&pp, 0, sizeof(pp));
+        pp.num_threads = t;
+        if (vv_dsp_threadpool_create(&pp, &pool) != VV_DSP_OK) {
+            fprintf(stderr, "Error: Failed to create a pool of %zu threads\n", t);
+            break;
+        }
+        vv_dsp_threadpool_set_default(pool);
+        for (i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+            run_at(suite, &workloads[i], &c, t);
+        }
+        vv_dsp_threadpool_set_default(NULL);
+        vv_dsp_threadpool_destroy(pool);
+    }
+
+    teardown(&c, max_threads);
+    free(signal);
+}
@@ -117,6 +117,19 @@ static void benchmark_stft_processing_loop(vv_bench_suite* suite) {
     printf("DEBUG: STFT handle destroyed\n");
 }
 
+/* One forward STFT frame per call */
+typedef struct {
+    vv_dsp_stft* handle;
+    const vv_dsp_real* frame;
+    vv_dsp_cpx* spectrum;
+    vv_dsp_status status;
+} stft_frame_ctx;
+
+static void stft_frame_once(void* ctx) {
+    stft_frame_ctx* c = (stft_frame_ctx*)ctx;
+    c->status = vv_dsp_stft_process(c->handle, c->frame, c->spectrum);
+}
+
 static void benchmark_stft_frame_rate(vv_bench_suite* suite) {
     vv_dsp_stft* stft_handle = NULL;
     vv_dsp_stft_params params = {
@@ -135,26 +148,10 @@ static void benchmark_stft_frame_rate(vv_bench_suite* suite) {
     /* Generate a single test frame */
     generate_test_signal(frame_buffer, STFT_FRAME_SIZE);
 
-    /* Benchmark single frame processing */
-    const size_t frame_iterations = 1000;
-
-    vv_bench_time start = vv_bench_get_time();
-
-    size_t i;
-    for (i = 0; i < frame_iterations; i++) {
-        status = vv_dsp_stft_process(stft_handle, frame_buffer, spectrum);
-        if (status != VV_DSP_OK) break;
-    }
-
-    vv_bench_time end = vv_bench_get_time();
-    double elapsed = vv_bench_elapsed_seconds(start, end);
-
-    /* Calculate frame rate metrics */
-    double frames_per_second = (double)frame_iterations / elapsed;
-    double samples_per_frame = (double)STFT_HOP_SIZE;  /* Real-time processing rate */
-    double max_sample_rate = frames_per_second * samples_per_frame;
-
-    vv_bench_add_result(suite, "STFT_frame_rate", elapsed, max_sample_rate, 0.0, frame_iterations);
+    /* 25 samples of 40 frames; throughput is hop samples per frame (real-time rate) */
+    stft_frame_ctx ctx = { stft_handle, frame_buffer, spectrum, VV_DSP_OK };
+    vv_bench_run_sampled(suite, "STFT_frame_rate", stft_frame_once, &ctx,
+                         25, 40, 40, (double)STFT_HOP_SIZE);
 
     /* Cleanup */
     vv_dsp_stft_destroy(stft_handle);
@@ -195,29 +192,14 @@ static void benchmark_stft_different_sizes(vv_bench_suite* suite) {
         /* Generate test frame */
         generate_test_signal(frame, fft_size);
 
-        /* Benchmark this size */
-        const size_t size_iterations = 200;
-
-        vv_bench_time start = vv_bench_get_time();
-
-        size_t i;
-        for (i = 0; i < size_iterations; i++) {
-            status = vv_dsp_stft_process(stft_handle, frame, spec);
-            if (status != VV_DSP_OK) break;
-        }
-
-        vv_bench_time end = vv_bench_get_time();
-        double elapsed = vv_bench_elapsed_seconds(start, end);
-
-        /* Calculate metrics */
-        double frames_per_second = (double)size_iterations / elapsed;
-        double max_sample_rate = frames_per_second * (double)hop_size;
-
         /* Create benchmark name */
         char bench_name[64];
         snprintf(bench_name, sizeof(bench_name), "STFT_size_%zu", fft_size);
 
-        vv_bench_add_result(suite, bench_name, elapsed, max_sample_rate, 0.0, size_iterations);
+        /* Benchmark this size: 20 samples of 10 frames */
+        stft_frame_ctx ctx = { stft_handle, frame, spec, VV_DSP_OK };
+        vv_bench_run_sampled(suite, bench_name, stft_frame_once, &ctx,
+                             20, 10, 10, (double)hop_size);
 
         /* Cleanup */
         free(frame);
@@ -4,7 +4,32 @@
  * @ingroup benchmark
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE  /* sched_getcpu, CPU_SET */
+#endif
+
 #include "bench_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define BENCH_HAVE_TSC 1
+#endif
+
+#ifdef __linux__
+    #include <sched.h>
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+    static int perf_fd = -1;  /* user-space core-cycle counter, -1 if unavailable */
+#endif
 
 /* Platform-specific includes and implementations */
 #ifdef _WIN32
@@ -44,6 +69,24 @@ int vv_bench_timer_init(void) {
     }
 #endif
 
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (perf_fd >= 0) {
+        uint64_t probe = 0;
+        if (read(perf_fd, &probe, sizeof(probe)) != (ssize_t)sizeof(probe)) {
+            close(perf_fd);
+            perf_fd = -1;
+        }
+    }
+#endif
+
     timer_initialized = 1;
     return 0;
 }
@@ -68,6 +111,32 @@ vv_bench_time vv_bench_get_time(void) {
     return result;
 }
 
+vv_bench_time vv_bench_time_add_ns(vv_bench_time t, uint64_t ns) {
+#ifdef _WIN32
+    t.ticks += (uint64_t)((double)ns * (double)frequency.QuadPart / 1e9);
+#elif defined(__APPLE__)
+    t.ticks += ns * (uint64_t)timebase.denom / (uint64_t)timebase.numer;
+#else
+    t.ticks += ns;
+#endif
+    return t;
+}
+
+void vv_bench_sleep_until(vv_bench_time t) {
+#if defined(__APPLE__)
+    mach_wait_until(t.ticks);
+#elif !defined(_WIN32)
+    struct timespec ts;
+    ts.tv_sec = (time_t)(t.ticks / 1000000000ULL);
+    ts.tv_nsec = (long)(t.ticks % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+#else
+    while (vv_bench_get_time().ticks < t.ticks) {
+    }
+#endif
+}
+
 double vv_bench_elapsed_seconds(vv_bench_time start, vv_bench_time end) {
     if (end.ticks < start.ticks) {
         return 0.0;  /* Invalid time range */
@@ -103,3 +172,133 @@ uint64_t vv_bench_elapsed_ns(vv_bench_time start, vv_bench_time end) {
     return delta;
 #endif
 }
+
+uint64_t vv_bench_read_cycles(void) {
+#ifdef __linux__
+    if (perf_fd >= 0) {
+        uint64_t count = 0;
+        if (read(perf_fd, &count, sizeof(count)) == (ssize_t)sizeof(count)) return count;
+    }
+#endif
+#ifdef BENCH_HAVE_TSC
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+const char* vv_bench_cycle_source(void) {
+#ifdef __linux__
+    if (perf_fd >= 0) return "pmu";
+#endif
+#ifdef BENCH_HAVE_TSC
+    return "tsc";
+#else
+    return "none";
+#endif
+}
+
+#ifdef __linux__
+/* cpufreq value of one CPU, else the first "cpu MHz" line of /proc/cpuinfo */
+static double linux_cpu_mhz(int cpu) {
+    char path[96];
+    double mhz = 0.0;
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", cpu < 0 ? 0 : cpu);
+    FILE* f = fopen(path, "r");
+    if (f) {
+        double khz = 0.0;
+        if (fscanf(f, "%lf", &khz) == 1) mhz = khz / 1000.0;
+        fclose(f);
+        if (mhz > 0.0) return mhz;
+    }
+    f = fopen("/proc/cpuinfo", "r");
+    if (!f) return 0.0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "cpu MHz", 7) == 0) {
+            const char* colon = strchr(line, ':');
+            if (colon) mhz = atof(colon + 1);
+            break;
+        }
+    }
+    fclose(f);
+    return mhz;
+}
+#endif
+
+double vv_bench_cpu_mhz(void) {
+#ifdef __linux__
+    const double mhz = linux_cpu_mhz(vv_bench_current_cpu());
+    if (mhz > 0.0) return mhz;
+#endif
+#ifdef BENCH_HAVE_TSC
+    /* TSC ticks over ~20 ms of wall time */
+    if (vv_bench_timer_init() != 0) return 0.0;
+    const vv_bench_time t0 = vv_bench_get_time();
+    const uint64_t c0 = (uint64_t)__rdtsc();
+    vv_bench_time t1 = t0;
+    while (vv_bench_elapsed_ns(t0, t1) < 20000000ULL) t1 = vv_bench_get_time();
+    const uint64_t c1 = (uint64_t)__rdtsc();
+    return (double)(c1 - c0) / (vv_bench_elapsed_seconds(t0, t1) * 1e6);
+#else
+    return 0.0;
+#endif
+}
+
+int vv_bench_pin_cpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#elif defined(_WIN32)
+    if (cpu < 0 || cpu >= (int)(sizeof(DWORD_PTR) * 8)) return -1;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) ? 0 : -1;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+int vv_bench_set_realtime_priority(void) {
+#if defined(_WIN32)
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) ? 0 : -1;
+#elif defined(__linux__)
+    /* Applies to the calling thread only; near the top of the range, which is
+       safe as long as the caller sleeps between callbacks */
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+    return sched_setscheduler(0, SCHED_FIFO, &param) == 0 ? 0 : -1;
+#else
+    return -1;
+#endif
+}
+
+int vv_bench_current_cpu(void) {
+#ifdef __linux__
+    return sched_getcpu();
+#elif defined(_WIN32)
+    return (int)GetCurrentProcessorNumber();
+#else
+    return -1;
+#endif
+}
+
+size_t vv_bench_cpus_allowed(void) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return 0;
+    return (size_t)CPU_COUNT(&set);
+#elif defined(_WIN32)
+    DWORD_PTR process_mask = 0, system_mask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) return 0;
+    size_t n = 0;
+    for (; process_mask; process_mask &= process_mask - 1) n++;
+    return n;
+#else
+    return 0;
+#endif
+}
@@ -14,6 +14,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -34,6 +35,19 @@ typedef struct {
  */
 vv_bench_time vv_bench_get_time(void);
 
+/**
+ * @brief Timestamp ns nanoseconds after t
+ */
+vv_bench_time vv_bench_time_add_ns(vv_bench_time t, uint64_t ns);
+
+/**
+ * @brief Block the calling thread until the clock reaches t
+ *
+ * @details Sleeps on an absolute deadline where the platform has one
+ * (clock_nanosleep on Linux, mach_wait_until on macOS), otherwise spins.
+ */
+void vv_bench_sleep_until(vv_bench_time t);
+
 /**
  * @brief Calculate elapsed time in seconds between two timestamps
  * @param start Start timestamp
@@ -59,6 +73,57 @@ uint64_t vv_bench_elapsed_ns(vv_bench_time start, vv_bench_time end);
  */
 int vv_bench_timer_init(void);
 
+/**
+ * @brief Read the cycle counter
+ * @return Current count, or 0 when no counter is available
+ *
+ * @details Uses the core-cycle PMU counter where the OS grants it (Linux
+ * perf_event_open, user-space cycles only), otherwise the x86 time-stamp
+ * counter, which ticks at a constant reference rate rather than the core
+ * clock. vv_bench_timer_init() picks the source.
+ */
+uint64_t vv_bench_read_cycles(void);
+
+/**
+ * @brief Name of the counter behind vv_bench_read_cycles()
+ * @return "pmu", "tsc" or "none"
+ */
+const char* vv_bench_cycle_source(void);
+
+/**
+ * @brief Current clock of the CPU running the caller, in MHz
+ * @return The OS-reported frequency, else an estimate from the TSC, else 0
+ */
+double vv_bench_cpu_mhz(void);
+
+/**
+ * @brief Pin the calling thread to one CPU
+ * @param cpu CPU index
+ * @return 0 on success, -1 on failure or where affinity is not supported
+ */
+int vv_bench_pin_cpu(int cpu);
+
+/**
+ * @brief CPU the caller is running on
+ * @return CPU index, or -1 when unknown
+ */
+int vv_bench_current_cpu(void);
+
+/**
+ * @brief Give the calling thread real-time priority
+ * @return 0 on success, -1 when the OS refuses (e.g. no CAP_SYS_NICE or
+ *         RLIMIT_RTPRIO on Linux) or has no such policy
+ *
+ * @details SCHED_FIFO on POSIX systems, time-critical priority on Windows.
+ */
+int vv_bench_set_realtime_priority(void);
+
+/**
+ * @brief Number of CPUs the calling thread may run on
+ * @return CPU count of the affinity mask, or 0 when unknown
+ */
+size_t vv_bench_cpus_allowed(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,9 +32,11 @@ int main(void) {
 
     if (vv_bench_write_results(&suite) != 0) {
         printf("Failed to write results\n");
+        vv_bench_suite_free(&suite);
         return 1;
     }
 
+    vv_bench_suite_free(&suite);
     printf("All done!\n");
     return 0;
 }
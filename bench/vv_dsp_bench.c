@@ -10,6 +10,8 @@
 #include <assert.h>
 #include "vv_dsp/vv_dsp.h"
 #include "bench_framework.h"
+#include "bench_compare.h"
+#include "bench_realtime.h"
 #include "bench_timer.h"
 
 /* Forward declarations for benchmark modules */
@@ -18,6 +20,7 @@ extern void run_filter_benchmarks(vv_bench_suite* suite);
 extern void run_resample_benchmarks(vv_bench_suite* suite);
 extern void run_pipeline_benchmarks(vv_bench_suite* suite);
 extern void run_denormal_benchmarks(vv_bench_suite* suite);
+extern void run_scaling_benchmarks(vv_bench_suite* suite, size_t max_threads);
 
 /* Global options */
 static struct {
@@ -26,7 +29,12 @@ static struct {
     char* filter_pattern;
     int show_help;
     int list_benchmarks;
-} options = {0, NULL, NULL, 0, 0};
+    int cpu;
+    char* compare_file;
+    double threshold;
+    vv_bench_rt_config rt;
+    size_t max_threads;
+} options = {0, NULL, NULL, 0, 0, -1, NULL, 0.05, {{0}, 0, 0.0, 0.0, -1}, 0};
 
 static void print_usage(const char* program_name) {
     printf("Usage: %s [OPTIONS]\n", program_name);
@@ -35,6 +43,13 @@ static void print_usage(const char* program_name) {
     printf("  --format=FORMAT     Output format: 'text' or 'json' (default: text)\n");
     printf("  --output=FILE       Output file (default: stdout)\n");
     printf("  --filter=PATTERN    Run only benchmarks matching pattern\n");
+    printf("  --cpu=N             Pin the benchmark thread to CPU N\n");
+    printf("  --compare=FILE      Compare against stored JSON results; exit 2 on regressions\n");
+    printf("  --threshold=PCT     Allowed slowdown for --compare, e.g. 5%% (default: 5%%)\n");
+    printf("  --rt-blocks=LIST    Block sizes of the realtime loops (default: 32,64,128,256,512)\n");
+    printf("  --rt-rate=HZ        Sample rate that sets the realtime deadlines (default: 48000)\n");
+    printf("  --rt-seconds=S      Audio simulated per steady-state realtime run (default: 0.5)\n");
+    printf("  --threads=N         Most threads of the scaling runs (default: CPUs allowed)\n");
     printf("  --list              List available benchmarks and exit\n");
     printf("  --help              Show this help message\n");
     printf("\n");
@@ -43,6 +58,9 @@ static void print_usage(const char* program_name) {
     printf("  %s --format=json             # JSON output to stdout\n", program_name);
     printf("  %s --output=results.json     # Save results to file\n", program_name);
     printf("  %s --filter=stft             # Run only STFT benchmarks\n", program_name);
+    printf("  %s --filter=stft --compare=docs/profiles/stft_profile.json --threshold=10%%\n",
+           program_name);
+    printf("  %s --filter=realtime --rt-blocks=64,128 --rt-rate=44100 --cpu=2\n", program_name);
 }
 
 static void list_benchmarks(void) {
@@ -52,6 +70,8 @@ static void list_benchmarks(void) {
     printf("  resample    - Audio resampling performance\n");
     printf("  pipeline    - End-to-end DSP pipeline performance\n");
     printf("  denormal    - Denormal number processing performance (FTZ/DAZ)\n");
+    printf("  realtime    - Per-callback latency and deadline misses of streaming modules\n");
+    printf("  scaling     - Speedup of the parallel batch APIs from 1 to N threads\n");
     printf("\n");
     printf("Use --filter=CATEGORY to run specific benchmark categories.\n");
 }
@@ -87,6 +107,58 @@ static int parse_arguments(int argc, char* argv[]) {
         else if (strncmp(arg, "--filter=", 9) == 0) {
             options.filter_pattern = (char*)(arg + 9);
         }
+        else if (strncmp(arg, "--cpu=", 6) == 0) {
+            char* end = NULL;
+            long cpu = strtol(arg + 6, &end, 10);
+            if (end == arg + 6 || *end != '\0' || cpu < 0) {
+                fprintf(stderr, "Error: Invalid CPU '%s'\n", arg + 6);
+                return -1;
+            }
+            options.cpu = (int)cpu;
+        }
+        else if (strncmp(arg, "--compare=", 10) == 0) {
+            options.compare_file = (char*)(arg + 10);
+        }
+        else if (strncmp(arg, "--threshold=", 12) == 0) {
+            char* end = NULL;
+            double pct = strtod(arg + 12, &end);
+            if (end == arg + 12 || (*end != '\0' && strcmp(end, "%") != 0) || pct < 0.0) {
+                fprintf(stderr, "Error: Invalid threshold '%s'\n", arg + 12);
+                return -1;
+            }
+            options.threshold = pct / 100.0;
+        }
+        else if (strncmp(arg, "--threads=", 10) == 0) {
+            char* end = NULL;
+            long threads = strtol(arg + 10, &end, 10);
+            if (end == arg + 10 || *end != '\0' || threads < 1) {
+                fprintf(stderr, "Error: Invalid thread count '%s'\n", arg + 10);
+                return -1;
+            }
+            options.max_threads = (size_t)threads;
+        }
+        else if (strncmp(arg, "--rt-blocks=", 12) == 0) {
+            if (vv_bench_rt_parse_blocks(&options.rt, arg + 12) != 0) {
+                fprintf(stderr, "Error: Invalid block size list '%s'\n", arg + 12);
+                return -1;
+            }
+        }
+        else if (strncmp(arg, "--rt-rate=", 10) == 0) {
+            char* end = NULL;
+            options.rt.sample_rate = strtod(arg + 10, &end);
+            if (end == arg + 10 || *end != '\0' || options.rt.sample_rate <= 0.0) {
+                fprintf(stderr, "Error: Invalid sample rate '%s'\n", arg + 10);
+                return -1;
+            }
+        }
+        else if (strncmp(arg, "--rt-seconds=", 13) == 0) {
+            char* end = NULL;
+            options.rt.seconds = strtod(arg + 13, &end);
+            if (end == arg + 13 || *end != '\0' || options.rt.seconds <= 0.0) {
+                fprintf(stderr, "Error: Invalid duration '%s'\n", arg + 13);
+                return -1;
+            }
+        }
         else {
             fprintf(stderr, "Error: Unknown option '%s'\n", arg);
             return -1;
@@ -108,6 +180,7 @@ int main(int argc, char* argv[]) {
     printf("DEBUG: Starting main function\n");
 
     /* Parse command line arguments */
+    vv_bench_rt_config_default(&options.rt);
     if (parse_arguments(argc, argv) != 0) {
         return 1;
     }
@@ -131,22 +204,40 @@ int main(int argc, char* argv[]) {
     }
     printf("DEBUG: Timer initialized\n");
 
+    /* Load the baseline first: it may be the file --output overwrites */
+    vv_bench_suite baseline;
+    memset(&baseline, 0, sizeof(baseline));
+    if (options.compare_file && vv_bench_load_results(options.compare_file, &baseline) != 0) {
+        fprintf(stderr, "Error: Failed to read baseline '%s'\n", options.compare_file);
+        return 1;
+    }
+
     /* Open output file if specified */
     FILE* output_file = NULL;
     if (options.output_file) {
         output_file = fopen(options.output_file, "w");
         if (!output_file) {
             fprintf(stderr, "Error: Failed to open output file '%s'\n", options.output_file);
+            vv_bench_suite_free(&baseline);
             return 1;
         }
     }
     printf("DEBUG: Output file handled\n");
 
+    /* Pin before the suite records its environment */
+    if (options.cpu >= 0 && vv_bench_pin_cpu(options.cpu) != 0) {
+        fprintf(stderr, "Error: Failed to pin to CPU %d\n", options.cpu);
+        if (output_file) fclose(output_file);
+        vv_bench_suite_free(&baseline);
+        return 1;
+    }
+
     /* Initialize benchmark suite */
     vv_bench_suite suite;
     if (vv_bench_suite_init(&suite, output_file, options.json_format) != 0) {
         fprintf(stderr, "Error: Failed to initialize benchmark suite\n");
         if (output_file) fclose(output_file);
+        vv_bench_suite_free(&baseline);
         return 1;
     }
     printf("DEBUG: Suite initialized\n");
@@ -179,18 +270,40 @@ int main(int argc, char* argv[]) {
         if (should_run_benchmark("denormal")) {
             run_denormal_benchmarks(&suite);
         }
+
+        if (should_run_benchmark("realtime")) {
+            options.rt.cpu = options.cpu;
+            run_realtime_benchmarks(&suite, &options.rt);
+        }
+
+        if (should_run_benchmark("scaling")) {
+            run_scaling_benchmarks(&suite, options.max_threads);
+        }
     }
 
     printf("DEBUG: Before write results\n");
     /* Write results */
     if (vv_bench_write_results(&suite) != 0) {
         fprintf(stderr, "Error: Failed to write benchmark results\n");
+        vv_bench_suite_free(&suite);
         if (output_file) fclose(output_file);
+        vv_bench_suite_free(&baseline);
         return 1;
     }
     printf("DEBUG: Results written\n");
 
+    /* Compare against the baseline; the report goes to stderr so JSON on stdout stays intact */
+    int regressions = 0;
+    if (options.compare_file) {
+        fprintf(stderr, "Comparison with %s (threshold %.1f%%):\n",
+                options.compare_file, options.threshold * 100.0);
+        regressions = vv_bench_compare(&baseline, &suite, options.threshold, stderr);
+        fprintf(stderr, "%d regression(s)\n", regressions);
+        vv_bench_suite_free(&baseline);
+    }
+
     /* Cleanup */
+    vv_bench_suite_free(&suite);
     if (output_file) {
         fclose(output_file);
     }
@@ -203,5 +316,5 @@ int main(int argc, char* argv[]) {
     }
 
     printf("DEBUG: Main function completed\n");
-    return 0;
+    return regressions != 0 ? 2 : 0;
 }
@@ -12,6 +12,10 @@ extern "C" {
 
 // Public sub-APIs
 #include "vv_dsp/audio/wav.h"
+#include "vv_dsp/audio/feature_store.h"
+#include "vv_dsp/audio/voicebank.h"
+#include "vv_dsp/audio/frq.h"
+#include "vv_dsp/audio/psola.h"
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,216 @@
+/*
+ * vv-dsp binary feature store
+ */
+#ifndef VV_DSP_AUDIO_FEATURE_STORE_H
+#define VV_DSP_AUDIO_FEATURE_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/quant.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Persisted feature matrices (spectrograms, log-mel, MFCC, F0 tracks).
+ *
+ * A store holds chunks of frames with dim values each, one chunk per keyed item
+ * (typically one per source file), plus the hop and sample rate they were
+ * computed with. Chunk data is stored as vv_dsp_real, frame-major and 64-byte
+ * aligned, after a fixed header; an index of chunk offsets and a key-sorted
+ * table follow the data. A reader maps the file and hands out pointers to frame
+ * ranges inside the mapping, so opening is O(1), lookups are binary searches
+ * and reading copies nothing.
+ *
+ * A store may instead hold its values in a compact storage type (core/quant.h),
+ * fixed per store: F16 and BF16 halve a float store, the 8-bit codes quarter it.
+ * Such chunks are read through vv_dsp_feature_store_read(), which widens them on
+ * the fly, or as raw codes; unlike vv_dsp_real stores they open in builds of
+ * either precision.
+ *
+ * Layout (little-endian): 64-byte header "VVFS", version, real_bytes, dim,
+ * sample_rate, hop, num_chunks, total_frames, index_offset; with version 2 a
+ * 64-byte storage block {u32 type, u32 reserved, f64 lo, f64 hi} follows; the
+ * chunks; then at index_offset num_chunks entries {u64 data_offset, u64 frames,
+ * u64 key_offset}, num_chunks u32 chunk indices sorted by key, and the
+ * NUL-terminated keys. vv_dsp_real stores are written as version 1.
+ */
+typedef struct vv_dsp_feature_store_writer vv_dsp_feature_store_writer;
+typedef struct vv_dsp_feature_store vv_dsp_feature_store;
+
+/**
+ * Shape and provenance of a store.
+ */
+typedef struct vv_dsp_feature_store_info {
+    size_t dim;             ///< Values per frame
+    size_t hop;             ///< Samples between frames (0 if not applicable)
+    double sample_rate;     ///< Rate the features were computed at in Hz (0 if not applicable)
+    size_t num_chunks;      ///< Chunks in the store
+    uint64_t total_frames;  ///< Frames over all chunks
+    vv_dsp_storage_type storage; ///< Element type of the chunk data
+    double lo;              ///< Range of the 8-bit storage types
+    double hi;
+} vv_dsp_feature_store_info;
+
+/**
+ * Create a store file.
+ *
+ * @param filepath Path of the store to write
+ * @param dim Values per frame (> 0)
+ * @param hop Samples between frames, recorded in the header
+ * @param sample_rate Analysis rate in Hz, recorded in the header
+ * @param out_writer Receives the writer; finish the file with vv_dsp_feature_store_writer_close()
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_writer_open(const char* filepath,
+                                               size_t dim,
+                                               size_t hop,
+                                               double sample_rate,
+                                               vv_dsp_feature_store_writer** out_writer);
+
+/**
+ * Create a store file whose values are encoded with quant (NULL or
+ * VV_DSP_STORAGE_REAL: as vv_dsp_feature_store_writer_open()).
+ *
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED for an unknown storage
+ *         type, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_writer_open_ex(const char* filepath,
+                                                  size_t dim,
+                                                  size_t hop,
+                                                  double sample_rate,
+                                                  const vv_dsp_quant* quant,
+                                                  vv_dsp_feature_store_writer** out_writer);
+
+/**
+ * Append one chunk, encoded in the store's storage type. A writer is not thread-safe; serialize calls from several threads.
+ *
+ * @param writer Writer
+ * @param key Name of the chunk (non-empty; keys should be unique for lookups)
+ * @param frames num_frames * dim values, frame-major
+ * @param num_frames Frames in the chunk (may be 0)
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_write_chunk(vv_dsp_feature_store_writer* writer,
+                                               const char* key,
+                                               const vv_dsp_real* frames,
+                                               size_t num_frames);
+
+/**
+ * Write the index, close the file and free the writer (NULL is ignored).
+ *
+ * @return VV_DSP_OK when the store is complete, error code otherwise
+ */
+vv_dsp_status vv_dsp_feature_store_writer_close(vv_dsp_feature_store_writer* writer);
+
+/**
+ * Map a store read-only.
+ *
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED for a vv_dsp_real store
+ *         written with another precision or an unknown storage type, VV_DSP_ERROR_INVALID_SIZE for a malformed file
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_open(const char* filepath,
+                                        vv_dsp_feature_store** out_store);
+
+/**
+ * Unmap a store (NULL is ignored). Pointers obtained from it become invalid.
+ */
+void vv_dsp_feature_store_close(vv_dsp_feature_store* store);
+
+/**
+ * Get the shape and provenance of a store.
+ */
+vv_dsp_status vv_dsp_feature_store_get_info(const vv_dsp_feature_store* store,
+                                            vv_dsp_feature_store_info* out_info);
+
+/**
+ * Get the key and frame count of chunk index (either output may be NULL).
+ *
+ * @return VV_DSP_OK, or VV_DSP_ERROR_OUT_OF_RANGE for index >= num_chunks
+ */
+vv_dsp_status vv_dsp_feature_store_chunk(const vv_dsp_feature_store* store,
+                                         size_t index,
+                                         const char** out_key,
+                                         size_t* out_frames);
+
+/**
+ * Index of the chunk with a key, or num_chunks if there is none. With duplicate
+ * keys any one of them is found.
+ */
+size_t vv_dsp_feature_store_find(const vv_dsp_feature_store* store, const char* key);
+
+/**
+ * Point at frames [first_frame, first_frame + num_frames) of a chunk inside the
+ * mapping, num_frames * dim values, frame-major; valid until the store is closed.
+ *
+ * @return VV_DSP_OK, VV_DSP_ERROR_OUT_OF_RANGE for a range outside the chunk, or
+ *         VV_DSP_ERROR_UNSUPPORTED for a store of another storage type
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_frames(const vv_dsp_feature_store* store,
+                                          size_t chunk,
+                                          size_t first_frame,
+                                          size_t num_frames,
+                                          const vv_dsp_real** out_frames);
+
+/**
+ * Like vv_dsp_feature_store_frames() for any storage type: point at the stored
+ * elements (num_frames * dim of vv_dsp_storage_bytes(info.storage) bytes each).
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_frames_raw(const vv_dsp_feature_store* store,
+                                              size_t chunk,
+                                              size_t first_frame,
+                                              size_t num_frames,
+                                              const void** out_frames);
+
+/**
+ * Copy frames [first_frame, first_frame + num_frames) of a chunk to out as
+ * vv_dsp_real (num_frames * dim values), widening compact storage types on the fly.
+ * Thread-safe on an open store.
+ *
+ * @return VV_DSP_OK, or VV_DSP_ERROR_OUT_OF_RANGE for a range outside the chunk
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_feature_store_read(const vv_dsp_feature_store* store,
+                                        size_t chunk,
+                                        size_t first_frame,
+                                        size_t num_frames,
+                                        vv_dsp_real* out);
+
+/**
+ * One chunk of a store as the backing source of a lazy spectrogram
+ * (vv_dsp_lazy_spectrogram_set_backing() with vv_dsp_feature_store_fetch()), e.g.
+ * the spectrogram of a file saved by an earlier session.
+ */
+typedef struct vv_dsp_feature_store_source {
+    const vv_dsp_feature_store* store;  ///< Open store
+    size_t chunk;                       ///< Chunk holding the rows
+} vv_dsp_feature_store_source;
+
+/**
+ * Copy frames [first_frame, first_frame + num_frames) of a source's chunk to out
+ * with vv_dsp_feature_store_read(). Matches vv_dsp_spectrogram_fetch_fn and is thread-safe on an open store.
+ *
+ * @param source A vv_dsp_feature_store_source
+ * @param row_size Values per frame expected by the caller
+ * @return 1 when the rows were copied, 0 when the range lies outside the chunk or
+ *         the store's dim is not row_size
+ */
+int vv_dsp_feature_store_fetch(void* source,
+                               size_t first_frame,
+                               size_t num_frames,
+                               size_t row_size,
+                               vv_dsp_real* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_AUDIO_FEATURE_STORE_H
@@ -0,0 +1,126 @@
+/*
+ * vv-dsp UTAU frequency map (.frq) files
+ */
+#ifndef VV_DSP_AUDIO_FRQ_H
+#define VV_DSP_AUDIO_FRQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Per-frame F0 and amplitude of one voicebank WAV, as UTAU resamplers read them
+ * from "name_wav.frq" next to "name.wav".
+ *
+ * Layout (little-endian): "FREQ0003", int32 samples per frame, float64 average F0,
+ * 16 reserved bytes, int32 frame count, then per frame float64 F0 in Hz (0 when
+ * unvoiced) and float64 amplitude. Frame i describes the signal around sample
+ * i * hop. vv-dsp keeps a hash of the source WAV in the first 8 reserved bytes
+ * (0 when unknown) so batch generation can tell stale maps from current ones;
+ * other tools leave them zero and ignore them.
+ */
+typedef struct vv_dsp_frq {
+    size_t hop;             ///< Samples per frame (256 in UTAU)
+    double average_f0;      ///< Average F0 of the voiced frames in Hz
+    uint64_t source_hash;   ///< vv_dsp_frq_file_hash() of the source WAV, 0 if unknown
+    size_t num_frames;
+    double* f0;             ///< num_frames F0 values in Hz, 0 when unvoiced
+    double* amplitude;      ///< num_frames amplitudes (16-bit full scale)
+} vv_dsp_frq;
+
+/**
+ * Read a .frq file.
+ *
+ * @param filepath Path of the file
+ * @param out_frq Receives the header and newly allocated frame arrays; free them
+ *                with vv_dsp_frq_free()
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for a file that is not a
+ *         complete FREQ0003 map, error code on other failures
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_frq_read(const char* filepath, vv_dsp_frq* out_frq);
+
+/**
+ * Write a .frq file.
+ *
+ * @param filepath Path of the file to write
+ * @param frq Map to write (hop > 0; the arrays may be NULL when num_frames is 0)
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_frq_write(const char* filepath, const vv_dsp_frq* frq);
+
+/**
+ * Free the frame arrays allocated by vv_dsp_frq_read() and clear the map (NULL is ignored).
+ */
+void vv_dsp_frq_free(vv_dsp_frq* frq);
+
+/**
+ * Hash the bytes of a file (64-bit FNV-1a, never 0), for vv_dsp_frq.source_hash.
+ *
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the file cannot be read
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_frq_file_hash(const char* filepath, uint64_t* out_hash);
+
+/**
+ * One pitch mark: the centre of a PSOLA grain (see audio/psola.h).
+ */
+typedef struct vv_dsp_pitch_mark {
+    size_t position;        ///< Sample index in the source WAV
+    double period;          ///< Local pitch period in samples (mark spacing when unvoiced)
+    int voiced;             ///< Nonzero on a glottal epoch, zero in unvoiced regions
+} vv_dsp_pitch_mark;
+
+/**
+ * Pitch marks of one voicebank WAV, cached as "name_wav.pmk" next to its .frq map
+ * so they are computed once per file, like the map itself.
+ *
+ * Layout (little-endian): "VVPMK001", float64 sample rate, uint64 source hash (as
+ * in vv_dsp_frq), int32 mark count, then per mark int32 position, int32 voiced flag
+ * and float64 period.
+ */
+typedef struct vv_dsp_pitch_marks {
+    double sample_rate;     ///< Sample rate of the source WAV in Hz
+    uint64_t source_hash;   ///< vv_dsp_frq_file_hash() of the source WAV, 0 if unknown
+    size_t num_marks;
+    vv_dsp_pitch_mark* marks; ///< num_marks marks in increasing position
+} vv_dsp_pitch_marks;
+
+/**
+ * Read a pitch-mark file.
+ *
+ * @param filepath Path of the file
+ * @param out_marks Receives the header and a newly allocated mark array; free it
+ *                  with vv_dsp_pitch_marks_free()
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for a file that is not a
+ *         complete VVPMK001 file, error code on other failures
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_pitch_marks_read(const char* filepath, vv_dsp_pitch_marks* out_marks);
+
+/**
+ * Write a pitch-mark file.
+ *
+ * @param filepath Path of the file to write
+ * @param marks Marks to write (the array may be NULL when num_marks is 0)
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_pitch_marks_write(const char* filepath, const vv_dsp_pitch_marks* marks);
+
+/**
+ * Free the mark array allocated by vv_dsp_pitch_marks_read() or
+ * vv_dsp_pitch_marks_compute() and clear the marks (NULL is ignored).
+ */
+void vv_dsp_pitch_marks_free(vv_dsp_pitch_marks* marks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_AUDIO_FRQ_H
@@ -0,0 +1,113 @@
+/*
+ * vv-dsp TD-PSOLA note rendering for voicebank samples
+ */
+#ifndef VV_DSP_AUDIO_PSOLA_H
+#define VV_DSP_AUDIO_PSOLA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/audio/frq.h"
+#include <stddef.h>
+
+/**
+ * Time-domain pitch-synchronous overlap-add (TD-PSOLA) over one voicebank sample.
+ *
+ * Pitch marks come from the sample's F0 track (its .frq map) once per WAV and are
+ * cached next to the map (vv_dsp_pitch_marks_write()). An engine cuts one grain per
+ * mark when it is created: the source around the mark under a Hann window spanning
+ * the neighbouring periods, so grains one period apart sum to the source. Rendering
+ * a note only places precomputed grains: each output grain takes the grain whose
+ * mark is nearest to the note's source position and lands one target period after
+ * the previous one. Grains are added with vv_dsp_overlap_add_frames(), and rendering
+ * never allocates. Unvoiced grains keep their spacing, so only voiced regions change
+ * pitch; voiced grains are scaled by sqrt(target period / source period), which keeps
+ * the level of a harmonic source.
+ *
+ * An engine is read-only after creation: any number of threads may render from one
+ * engine into their own buffers.
+ */
+typedef struct vv_dsp_psola vv_dsp_psola;
+
+/**
+ * One note to render.
+ */
+typedef struct vv_dsp_psola_note {
+    double source_start;         ///< Source position (samples from the start of the engine's samples) at output sample 0
+    double source_rate;          ///< Source samples per output sample: 1 keeps the speed, 0.5 doubles the length
+    double target_f0;            ///< F0 of voiced grains in Hz; 0 keeps the source pitch
+    const vv_dsp_real* f0_curve; ///< Optional F0 per output sample (pitch bends) replacing target_f0, 0 where
+                                 ///< the source pitch is kept; NULL for none
+} vv_dsp_psola_note;
+
+/**
+ * Place pitch marks from an F0 track.
+ *
+ * Voiced marks sit on the strongest peak of each period (of the polarity that
+ * dominates the first period of the voiced run), searched within a quarter period
+ * of one period after the previous mark. Unvoiced regions are marked every
+ * sample_rate / frq->average_f0 samples (200 Hz when the map has no average).
+ *
+ * @param samples Mono source WAV
+ * @param num_samples Number of samples
+ * @param sample_rate Sample rate in Hz
+ * @param frq F0 track of the samples (frame i centred on sample i * hop); its
+ *            source hash is copied to the marks
+ * @param out_marks Receives newly allocated marks; free them with vv_dsp_pitch_marks_free()
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for an empty signal or
+ *         map, VV_DSP_ERROR_OUT_OF_RANGE for a sample rate that is not positive
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_pitch_marks_compute(const vv_dsp_real* samples, size_t num_samples, double sample_rate,
+                                         const vv_dsp_frq* frq, vv_dsp_pitch_marks* out_marks);
+
+/**
+ * Create an engine over part of a source WAV, such as a vv_dsp_voicebank_segment.
+ *
+ * @param samples Mono samples, copied into the grains (not referenced later)
+ * @param num_samples Number of samples
+ * @param start_sample Position of samples[0] in the source WAV; marks outside
+ *                     the samples are skipped
+ * @param marks Pitch marks of the source WAV
+ * @param out_psola Receives the engine; free it with vv_dsp_psola_destroy()
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for no samples,
+ *         VV_DSP_ERROR_OUT_OF_RANGE for marks without a positive sample rate,
+ *         error code on other failures
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_psola_create(const vv_dsp_real* samples, size_t num_samples, size_t start_sample,
+                                  const vv_dsp_pitch_marks* marks, vv_dsp_psola** out_psola);
+
+/**
+ * Free an engine (NULL is ignored).
+ */
+void vv_dsp_psola_destroy(vv_dsp_psola* psola);
+
+/**
+ * Number of grains, one per mark within the samples.
+ */
+size_t vv_dsp_psola_num_grains(const vv_dsp_psola* psola);
+
+/**
+ * Render a note, adding it to out (which is not cleared first, so the notes of a
+ * song can share one buffer).
+ *
+ * @param psola Engine
+ * @param note Note to render
+ * @param out Buffer of out_len samples
+ * @param out_len Number of output samples
+ * @return VV_DSP_OK on success (silence when the engine has no grains),
+ *         VV_DSP_ERROR_INVALID_SIZE for out_len 0, VV_DSP_ERROR_OUT_OF_RANGE for a
+ *         negative or non-finite source rate or target F0
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_psola_render(const vv_dsp_psola* psola, const vv_dsp_psola_note* note,
+                                  vv_dsp_real* out, size_t out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_AUDIO_PSOLA_H
@@ -0,0 +1,128 @@
+/*
+ * vv-dsp UTAU voicebank access
+ */
+#ifndef VV_DSP_AUDIO_VOICEBANK_H
+#define VV_DSP_AUDIO_VOICEBANK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+/**
+ * UTAU voicebank: the alias index of a directory's oto.ini and its samples.
+ *
+ * Each oto.ini line "file.wav=alias,offset,consonant,cutoff,preutterance,overlap"
+ * (times in ms) becomes one entry; an empty alias stands for the file name without
+ * its extension. Opening parses only oto.ini. A segment, the part of a file the
+ * entry uses, is decoded on first use from a memory mapping of its WAV file, so
+ * only the pages it covers are read, and is kept in an LRU cache whose unpinned
+ * segments stay within a byte budget. Segments are mono; multi-channel files are
+ * mixed down. A voicebank is not thread-safe; use one per thread or serialize calls.
+ */
+typedef struct vv_dsp_voicebank vv_dsp_voicebank;
+
+/**
+ * One oto.ini entry. Strings are owned by the voicebank.
+ */
+typedef struct vv_dsp_oto_entry {
+    const char* filename;      ///< WAV file relative to the voicebank directory
+    const char* alias;         ///< Phoneme alias
+    double offset_ms;          ///< Segment start from the start of the file
+    double consonant_ms;       ///< Fixed (unstretched) region from the segment start
+    double cutoff_ms;          ///< >= 0: trimmed from the end of the file; < 0: segment length is -cutoff_ms
+    double preutterance_ms;    ///< Note-on point from the segment start
+    double overlap_ms;         ///< Crossfade with the previous note from the segment start
+} vv_dsp_oto_entry;
+
+/**
+ * A decoded segment, valid until released.
+ */
+typedef struct vv_dsp_voicebank_segment {
+    const vv_dsp_real* samples; ///< Mono samples from offset to cutoff
+    size_t num_samples;
+    double sample_rate;         ///< Sample rate of the source file in Hz
+    size_t start_sample;        ///< Position of samples[0] in the source file
+} vv_dsp_voicebank_segment;
+
+/**
+ * Cache counters.
+ */
+typedef struct vv_dsp_voicebank_stats {
+    size_t hits;                ///< Acquires served from the cache
+    size_t misses;              ///< Acquires that decoded their segment
+    size_t evictions;           ///< Segments dropped to stay within the budget
+    size_t cached_segments;     ///< Segments in the cache now
+    size_t cached_bytes;        ///< Sample bytes held now, pinned segments included
+} vv_dsp_voicebank_stats;
+
+/**
+ * Parse directory/oto.ini.
+ *
+ * @param directory Voicebank directory
+ * @param cache_budget_bytes Bytes of decoded samples to keep for reuse; pinned
+ *                           segments may exceed it
+ * @param out_voicebank Receives the voicebank; free it with vv_dsp_voicebank_close()
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for a malformed line,
+ *         error code on other failures
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_voicebank_open(const char* directory,
+                                    size_t cache_budget_bytes,
+                                    vv_dsp_voicebank** out_voicebank);
+
+/**
+ * Free a voicebank, its cache and its file mappings (NULL is ignored). Segments
+ * still acquired become invalid.
+ */
+void vv_dsp_voicebank_close(vv_dsp_voicebank* voicebank);
+
+/**
+ * Number of entries.
+ */
+size_t vv_dsp_voicebank_count(const vv_dsp_voicebank* voicebank);
+
+/**
+ * Get entry index in oto.ini order.
+ *
+ * @return VV_DSP_OK, or VV_DSP_ERROR_OUT_OF_RANGE for index >= count
+ */
+vv_dsp_status vv_dsp_voicebank_entry(const vv_dsp_voicebank* voicebank,
+                                     size_t index,
+                                     vv_dsp_oto_entry* out_entry);
+
+/**
+ * Index of the first entry with an alias, or the entry count if there is none.
+ */
+size_t vv_dsp_voicebank_find(const vv_dsp_voicebank* voicebank, const char* alias);
+
+/**
+ * Get the decoded segment of an entry, decoding it on a cache miss, and pin it
+ * until the matching vv_dsp_voicebank_release(). Acquires of one entry nest.
+ *
+ * @return VV_DSP_OK, VV_DSP_ERROR_OUT_OF_RANGE for a bad index, or the WAV error
+ *         of a file that cannot be mapped
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_voicebank_acquire(vv_dsp_voicebank* voicebank,
+                                       size_t index,
+                                       vv_dsp_voicebank_segment* out_segment);
+
+/**
+ * Unpin the segment of an entry; once no acquire holds it, it may be evicted.
+ */
+void vv_dsp_voicebank_release(vv_dsp_voicebank* voicebank, size_t index);
+
+/**
+ * Get the cache counters.
+ */
+vv_dsp_status vv_dsp_voicebank_get_stats(const vv_dsp_voicebank* voicebank,
+                                         vv_dsp_voicebank_stats* out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_AUDIO_VOICEBANK_H
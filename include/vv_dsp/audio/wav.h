@@ -9,7 +9,9 @@ extern "C" {
 #endif
 
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/buffer.h"
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * WAV audio file metadata structure
@@ -37,6 +39,21 @@ vv_dsp_status vv_dsp_wav_read(const char* filepath,
                               vv_dsp_real*** out_buffer,
                               vv_dsp_wav_info* out_info);
 
+/**
+ * Read a WAV file into one vv_dsp_buffer.
+ *
+ * @param filepath Path to the WAV file to read
+ * @param layout VV_DSP_BUFFER_PLANAR (SIMD-aligned channels) or VV_DSP_BUFFER_INTERLEAVED
+ * @param out_buffer Receives the samples; release it with vv_dsp_buffer_free()
+ * @param out_info Pointer to structure that will be filled with file metadata
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_read_buffer(const char* filepath,
+                                     vv_dsp_buffer_layout layout,
+                                     vv_dsp_buffer* out_buffer,
+                                     vv_dsp_wav_info* out_info);
+
 /**
  * Write planar vv_dsp_real buffers to a WAV file.
  *
@@ -69,6 +86,242 @@ vv_dsp_status vv_dsp_wav_info_get(const char* filepath,
  */
 void vv_dsp_wav_free_buffer(vv_dsp_real*** buffer, int num_channels);
 
+/**
+ * Streaming WAV reader.
+ *
+ * Decodes a file block by block into caller buffers through one small internal
+ * staging block, so a file of any length reads in constant memory. Positions count
+ * frames (one sample per channel). A reader is not thread-safe; use one per thread.
+ */
+typedef struct vv_dsp_wav_reader vv_dsp_wav_reader;
+
+/**
+ * Open a WAV file for streaming and parse its header; reading starts at frame 0.
+ *
+ * @param filepath Path to the WAV file to read
+ * @param out_reader Receives the reader; close it with vv_dsp_wav_reader_close()
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_reader_open(const char* filepath,
+                                     vv_dsp_wav_reader** out_reader);
+
+/**
+ * Close a reader and release its file and staging block (NULL is ignored).
+ */
+void vv_dsp_wav_reader_close(vv_dsp_wav_reader* reader);
+
+/**
+ * Get the metadata parsed at open.
+ */
+vv_dsp_status vv_dsp_wav_reader_info(const vv_dsp_wav_reader* reader,
+                                     vv_dsp_wav_info* out_info);
+
+/**
+ * Move the read position to a frame in [0, num_samples].
+ *
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE past the end
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_reader_seek(vv_dsp_wav_reader* reader, size_t frame);
+
+/**
+ * Current read position in frames.
+ */
+size_t vv_dsp_wav_reader_tell(const vv_dsp_wav_reader* reader);
+
+/**
+ * Decode up to max_frames frames into planar channel buffers.
+ *
+ * @param reader Reader
+ * @param channels num_channels buffers of at least max_frames samples each
+ * @param max_frames Frames requested
+ * @param frames_read Receives the frames decoded; fewer than max_frames only at the
+ *                    end of the data (0 once there)
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_reader_read_planar(vv_dsp_wav_reader* reader,
+                                            vv_dsp_real* const* channels,
+                                            size_t max_frames,
+                                            size_t* frames_read);
+
+/**
+ * Decode up to max_frames frames into one interleaved buffer of
+ * max_frames * num_channels samples; otherwise as vv_dsp_wav_reader_read_planar().
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_reader_read_interleaved(vv_dsp_wav_reader* reader,
+                                                 vv_dsp_real* out,
+                                                 size_t max_frames,
+                                                 size_t* frames_read);
+
+/**
+ * Memory-mapped WAV file.
+ *
+ * Maps the whole file read-only. Aligned 32-bit float data is exposed as a
+ * zero-copy interleaved view; other formats decode on demand from the mapping,
+ * so random access into a large file costs the page faults of the frames it
+ * touches instead of a full read. A map is immutable once open: reads may run
+ * concurrently from any number of threads.
+ */
+typedef struct vv_dsp_wav_map vv_dsp_wav_map;
+
+/**
+ * Map a WAV file and parse its header.
+ *
+ * A data chunk longer than the file is truncated to the frames present.
+ *
+ * @param filepath Path to the WAV file to map
+ * @param out_map Receives the map; close it with vv_dsp_wav_mmap_close()
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_mmap_open(const char* filepath,
+                                   vv_dsp_wav_map** out_map);
+
+/**
+ * Unmap the file and free the map (NULL is ignored). Views from
+ * vv_dsp_wav_mmap_float32() become invalid.
+ */
+void vv_dsp_wav_mmap_close(vv_dsp_wav_map* map);
+
+/**
+ * Get the metadata parsed at open.
+ */
+vv_dsp_status vv_dsp_wav_mmap_info(const vv_dsp_wav_map* map,
+                                   vv_dsp_wav_info* out_info);
+
+/**
+ * Zero-copy view of the samples: num_samples * num_channels interleaved floats.
+ *
+ * @param map Map
+ * @param out_interleaved Receives the view, valid until the map is closed
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED unless the file holds
+ *         32-bit float data at a 4-byte aligned offset
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_mmap_float32(const vv_dsp_wav_map* map,
+                                      const float** out_interleaved);
+
+/**
+ * Decode up to max_frames frames from start_frame into planar channel buffers.
+ *
+ * @param map Map
+ * @param start_frame First frame, in [0, num_samples]
+ * @param channels num_channels buffers of at least max_frames samples each
+ * @param max_frames Frames requested
+ * @param frames_read Receives the frames decoded (fewer only at the end of the data)
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE if start_frame is past the end
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_mmap_read_planar(const vv_dsp_wav_map* map,
+                                          size_t start_frame,
+                                          vv_dsp_real* const* channels,
+                                          size_t max_frames,
+                                          size_t* frames_read);
+
+/**
+ * Decode up to max_frames frames from start_frame into one interleaved buffer;
+ * otherwise as vv_dsp_wav_mmap_read_planar().
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_mmap_read_interleaved(const vv_dsp_wav_map* map,
+                                               size_t start_frame,
+                                               vv_dsp_real* out,
+                                               size_t max_frames,
+                                               size_t* frames_read);
+
+/**
+ * Streaming WAV writer.
+ *
+ * Frames are appended in any count, encoded into fixed-size blocks of a queue
+ * and written by a background I/O thread, so the appending thread never waits
+ * for the disk and takes no lock; a real-time audio callback may append. The
+ * RIFF sizes are patched when the writer is closed. Files past the 4 GB limit of
+ * RIFF are written as RF64 (EBU Tech 3306), which vv_dsp_wav_reader_open() and the
+ * other readers accept. Append and close must come from one thread.
+ */
+typedef struct vv_dsp_wav_writer vv_dsp_wav_writer;
+
+/**
+ * RF64 handling of the streaming writer.
+ */
+typedef enum vv_dsp_wav_rf64_mode {
+    VV_DSP_WAV_RF64_AUTO = 0,   ///< Reserve room for the ds64 chunk; switch to RF64 only past 4 GB
+    VV_DSP_WAV_RF64_ALWAYS = 1, ///< Always write RF64
+    VV_DSP_WAV_RF64_NEVER = 2   ///< Plain RIFF header; appends past 4 GB fail
+} vv_dsp_wav_rf64_mode;
+
+/**
+ * Streaming writer settings; zero fields take the defaults.
+ */
+typedef struct vv_dsp_wav_writer_config {
+    size_t block_frames;        ///< Frames per I/O block (default 4096)
+    size_t num_blocks;          ///< Blocks in the queue, at least 2 (default 8)
+    int synchronous;            ///< Non-zero writes each full block in the appending thread; no I/O thread
+    vv_dsp_wav_rf64_mode rf64;  ///< RF64 handling (default VV_DSP_WAV_RF64_AUTO)
+} vv_dsp_wav_writer_config;
+
+/**
+ * Streaming writer counters.
+ */
+typedef struct vv_dsp_wav_writer_stats {
+    uint64_t frames_appended;   ///< Frames accepted so far
+    size_t blocks_written;      ///< Blocks the I/O thread has written
+    size_t max_queued_blocks;   ///< Most blocks ever waiting for the I/O thread
+    size_t overruns;            ///< Appends rejected because the queue was full
+} vv_dsp_wav_writer_stats;
+
+/**
+ * Create a WAV file and start its writer.
+ *
+ * @param filepath Path to the WAV file to write
+ * @param format Channels (1 to 8), sample rate, bit depth and float flag of the
+ *               file; num_samples is ignored
+ * @param config Writer settings, or NULL for the defaults
+ * @param out_writer Receives the writer; finish the file with vv_dsp_wav_writer_close()
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_writer_open(const char* filepath,
+                                     const vv_dsp_wav_info* format,
+                                     const vv_dsp_wav_writer_config* config,
+                                     vv_dsp_wav_writer** out_writer);
+
+/**
+ * Append frames from planar channel buffers.
+ *
+ * The frames are encoded into the queue and written later. An append is taken
+ * whole or not at all: when the queue lacks room for all frames it returns
+ * VV_DSP_ERROR_OUT_OF_RANGE, counts an overrun and may be retried once the I/O
+ * thread has caught up. A failed write of the I/O thread is returned by the next
+ * append and by close.
+ *
+ * @param writer Writer
+ * @param channels num_channels buffers of frames samples each
+ * @param frames Frames to append
+ * @return VV_DSP_OK on success, error code on failure
+ */
+VV_DSP_NODISCARD
+vv_dsp_status vv_dsp_wav_writer_append_frames(vv_dsp_wav_writer* writer,
+                                              const vv_dsp_real* const* channels,
+                                              size_t frames);
+
+/**
+ * Get the writer's counters.
+ */
+vv_dsp_status vv_dsp_wav_writer_get_stats(const vv_dsp_wav_writer* writer,
+                                          vv_dsp_wav_writer_stats* out_stats);
+
+/**
+ * Write the queued frames, patch the header sizes, close the file and free the
+ * writer (NULL is ignored).
+ *
+ * @return VV_DSP_OK when every frame reached the file, error code otherwise
+ */
+vv_dsp_status vv_dsp_wav_writer_close(vv_dsp_wav_writer* writer);
+
 /**
  * Get human-readable error message for the last WAV I/O operation.
  * This is a thread-local error message that gets updated on each operation.
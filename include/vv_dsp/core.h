@@ -19,6 +19,20 @@ extern "C" {
 #include "vv_dsp/core/fp_env.h"
 #include "core/simd_utils.h"
 #include "core/simd_core.h"
+#include "core/split_complex.h"
+#include "vv_dsp/core/fixed_point.h"
+#include "vv_dsp/core/convert.h"
+#include "vv_dsp/core/quant.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/precision.h"
+#include "vv_dsp/core/typed.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+#include "vv_dsp/core/threadpool.h"
+#include "vv_dsp/core/context.h"
+#include "vv_dsp/core/ring.h"
+#include "vv_dsp/core/buffer.h"
 
 /** @addtogroup core_group
  * @{
@@ -126,6 +140,41 @@ vv_dsp_real vv_dsp_cpx_phase(vv_dsp_cpx z);
 vv_dsp_cpx vv_dsp_cpx_from_polar(vv_dsp_real r, vv_dsp_real theta);
 /** @} */
 
+/** @name Complex Array Operations
+ * @brief Element-wise kernels over spectra, run through the runtime SIMD dispatch
+ *
+ * n may be 0. Outputs may alias their input (a real output in place over the front
+ * of a complex array included), except that vv_dsp_cpx_polar_to_cpx_array() must
+ * not write over its inputs. Magnitudes are the square root of the power, without
+ * the rescaling of vv_dsp_cpx_abs(), so |z| beyond about 1e19 overflows in float
+ * builds. Phase and polar conversion take a vmath accuracy tier
+ * (vv_dsp_vmath_tier); VV_DSP_VMATH_EXACT matches vv_dsp_cpx_phase() and
+ * vv_dsp_cpx_from_polar() to the last bit of vv_dsp_real.
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER, or VV_DSP_ERROR_OUT_OF_RANGE for a
+ *         bad tier
+ * @{
+ */
+
+/** @brief out[i] = |z[i]| */
+vv_dsp_status vv_dsp_cpx_abs_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n);
+
+/** @brief out[i] = |z[i]|^2 */
+vv_dsp_status vv_dsp_cpx_power_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n);
+
+/** @brief out[i] = arg z[i] in [-pi, pi] */
+vv_dsp_status vv_dsp_cpx_phase_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, vv_dsp_vmath_tier tier);
+
+/** @brief out[i] = mag[i] * (cos phase[i] + i sin phase[i]) */
+vv_dsp_status vv_dsp_cpx_polar_to_cpx_array(const vv_dsp_real* mag, const vv_dsp_real* phase, vv_dsp_cpx* out,
+                                            size_t n, vv_dsp_vmath_tier tier);
+
+/** @brief out[i] = a[i] * conj(b[i]), the cross-spectrum of a and b */
+vv_dsp_status vv_dsp_cpx_conj_mul_array(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n);
+
+/** @brief out[i] = z[i] * g for a real gain g */
+vv_dsp_status vv_dsp_cpx_scale_array(const vv_dsp_cpx* z, vv_dsp_real g, vv_dsp_cpx* out, size_t n);
+/** @} */
+
 /** @name Array Statistics
  * @{
  */
@@ -416,7 +465,9 @@ vv_dsp_status vv_dsp_kurtosis(const vv_dsp_real* x, size_t n, vv_dsp_real* out);
  * @param biased Use biased (1) or unbiased (0) estimator
  * @return VV_DSP_OK on success, error code on failure
  *
- * @details Computes R[k] = sum(x[i] * x[i+k]) for k = 0, 1, ..., r_len-1
+ * @details Computes R[k] = sum(x[i] * x[i+k]) for k = 0, 1, ..., r_len-1, divided by n
+ * (biased) or n - k (unbiased); lags >= n are 0. Long lag ranges are computed as a
+ * zero-padded R2C / C2R correlation (cached plans), short ones directly.
  *
  * @code{.c}
  * vv_dsp_real signal[100];
@@ -437,7 +488,9 @@ vv_dsp_status vv_dsp_autocorrelation(const vv_dsp_real* x, size_t n, vv_dsp_real
  * @param r_len Length of output array
  * @return VV_DSP_OK on success, error code on failure
  *
- * @details Computes cross-correlation R_xy[k] = sum(x[i] * y[i+k])
+ * @details Computes cross-correlation R_xy[k] = sum(x[i] * y[i+k]), averaged over the
+ * overlap min(nx, ny - k); lags >= ny are 0. Switches to FFT correlation for long lag
+ * ranges, like vv_dsp_autocorrelation().
  * Useful for signal alignment, pattern matching, and delay estimation.
  *
  * @code{.c}
@@ -450,6 +503,54 @@ vv_dsp_status vv_dsp_autocorrelation(const vv_dsp_real* x, size_t n, vv_dsp_real
 vv_dsp_status vv_dsp_cross_correlation(const vv_dsp_real* x, size_t nx,
 									   const vv_dsp_real* y, size_t ny,
 									   vv_dsp_real* r, size_t r_len);
+
+/** Field selectors for vv_dsp_stats_all() */
+enum {
+    VV_DSP_STATS_MEAN     = 1u << 0,
+    VV_DSP_STATS_VAR      = 1u << 1,
+    VV_DSP_STATS_SKEWNESS = 1u << 2,
+    VV_DSP_STATS_KURTOSIS = 1u << 3,
+    VV_DSP_STATS_MIN      = 1u << 4,
+    VV_DSP_STATS_MAX      = 1u << 5,
+    VV_DSP_STATS_RMS      = 1u << 6,
+    VV_DSP_STATS_CREST    = 1u << 7,
+    VV_DSP_STATS_ALL      = 0xffu
+};
+
+/** Descriptive statistics of one buffer; definitions match the single-metric functions */
+typedef struct {
+    vv_dsp_real mean;
+    vv_dsp_real var;       ///< population variance, as vv_dsp_var()
+    vv_dsp_real skewness;
+    vv_dsp_real kurtosis;  ///< excess kurtosis, as vv_dsp_kurtosis()
+    vv_dsp_real min;
+    vv_dsp_real max;
+    vv_dsp_real rms;
+    vv_dsp_real crest;     ///< max(|x|) / rms, INFINITY for an all-zero buffer
+} vv_dsp_stats;
+
+/**
+ * @brief Compute several descriptive statistics in one pass over the buffer
+ * @param x Input signal array
+ * @param n Number of samples
+ * @param out Receives the requested fields; all others are set to 0
+ * @param mask OR of VV_DSP_STATS_* selectors
+ * @return VV_DSP_OK on success; VV_DSP_ERROR_INVALID_SIZE if a requested moment needs
+ *         more samples (variance 2, skewness 3, kurtosis 4), in which case that field
+ *         is 0 and the others are still filled
+ *
+ * @details Reads x once, block by block, and only does the work the mask asks for:
+ * extrema, power sums and central moments up to the highest requested order. Block
+ * moments are merged with the pairwise update of Chan et al. / Pebay, so the result
+ * is as stable as Welford's recurrence. vv_dsp_skewness(), vv_dsp_kurtosis() and
+ * vv_dsp_crest_factor() are thin wrappers around it.
+ *
+ * @code{.c}
+ * vv_dsp_stats st;
+ * vv_dsp_stats_all(frame, 1024, &st, VV_DSP_STATS_MEAN | VV_DSP_STATS_VAR | VV_DSP_STATS_CREST);
+ * @endcode
+ */
+vv_dsp_status vv_dsp_stats_all(const vv_dsp_real* x, size_t n, vv_dsp_stats* out, unsigned mask);
 /** @} */
 
 /** @name Signal Framing and Overlap-Add
@@ -503,6 +604,88 @@ vv_dsp_status vv_dsp_fetch_frame(const vv_dsp_real* signal, size_t signal_len,
                                  size_t hop_len, size_t frame_index, int center,
                                  const vv_dsp_real* window);
 
+/**
+ * @brief Extract a run of consecutive frames into a row-major frame matrix
+ * @param signal Pointer to the input signal buffer
+ * @param signal_len Total number of samples in the signal
+ * @param frame_len The length of each frame (row length of the matrix)
+ * @param hop_len The number of samples to advance between frames
+ * @param center If non-zero, use centered framing with reflection padding
+ * @param window Optional window of size frame_len, or NULL
+ * @param out_matrix Output of count * frame_len samples; frame first + r lands in row r
+ * @param first Index of the first frame to extract
+ * @param count Number of frames to extract
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details Produces the same rows as count calls to vv_dsp_fetch_frame(). Frames
+ * lying inside the signal are copied (or multiplied by the window) with the
+ * vector kernels; only the frames that reach past either end are padded sample
+ * by sample. An out_matrix from vv_dsp_aligned_malloc() with frame_len a
+ * multiple of the SIMD width keeps every row aligned, ready for a batched FFT
+ * plan (vv_dsp_fft_make_plan_many() with idist = frame_len).
+ *
+ * @code{.c}
+ * size_t nf = vv_dsp_get_num_frames(len, 512, 128, 1);
+ * vv_dsp_real* frames = (vv_dsp_real*)vv_dsp_aligned_malloc(nf * 512 * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+ * vv_dsp_status st = vv_dsp_fetch_frames(signal, len, 512, 128, 1, window, frames, 0, nf);
+ * @endcode
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fetch_frames(const vv_dsp_real* signal, size_t signal_len, size_t frame_len,
+                                                   size_t hop_len, int center, const vv_dsp_real* window,
+                                                   vv_dsp_real* out_matrix, size_t first, size_t count);
+
+/**
+ * @brief Zero-copy view of the frames of a signal
+ *
+ * @details Frames lying entirely inside the signal are read in place, at
+ * signal + f * hop_len (minus frame_len / 2 when centered); only the frames
+ * that need padding are materialized, once, into a side buffer. Frames are
+ * unwindowed: consumers apply the window as they read each frame, e.g.
+ * vv_dsp_stft_process() on vv_dsp_frame_view_frame() or
+ * vv_dsp_stft_spectrogram_view(). The interior frames are also a strided
+ * batch: vv_dsp_frame_view_frame(view, interior_first) with distance hop_len
+ * and interior_count transforms fits vv_dsp_fft_make_plan_many() as is.
+ * The signal must outlive the view. Fields are read-only.
+ */
+typedef struct vv_dsp_frame_view {
+    const vv_dsp_real* signal; /**< Viewed signal */
+    size_t signal_len;         /**< Samples in the signal */
+    size_t frame_len;          /**< Frame length */
+    size_t hop_len;            /**< Hop between frames */
+    int center;                /**< Centered framing with reflection padding */
+    size_t num_frames;         /**< vv_dsp_get_num_frames() of the above */
+    size_t interior_first;     /**< First frame read in place */
+    size_t interior_count;     /**< Number of consecutive frames read in place */
+    vv_dsp_real* edges;        /**< Padded frames before, then after, the interior (owned) */
+} vv_dsp_frame_view;
+
+/**
+ * @brief Build a frame view over a signal
+ * @param view View to fill
+ * @param signal Input signal (kept by reference)
+ * @param signal_len Total number of samples in the signal
+ * @param frame_len The length of each frame
+ * @param hop_len The number of samples to advance between frames
+ * @param center If non-zero, use centered framing with reflection padding
+ * @return VV_DSP_OK on success, error code on failure
+ * @note Only the padded edge frames are allocated and copied
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_frame_view_init(vv_dsp_frame_view* view, const vv_dsp_real* signal,
+                                                      size_t signal_len, size_t frame_len, size_t hop_len,
+                                                      int center);
+
+/**
+ * @brief Release the edge frames of a view (NULL is ignored)
+ */
+void vv_dsp_frame_view_free(vv_dsp_frame_view* view);
+
+/**
+ * @brief Pointer to frame frame_index of a view
+ * @return frame_len samples, equal to vv_dsp_fetch_frame() without a window,
+ * or NULL if frame_index >= num_frames
+ */
+const vv_dsp_real* vv_dsp_frame_view_frame(const vv_dsp_frame_view* view, size_t frame_index);
+
 /**
  * @brief Add a frame into an output buffer using overlap-add
  * @param frame The processed frame to be added back
@@ -528,6 +711,28 @@ vv_dsp_status vv_dsp_overlap_add(const vv_dsp_real* frame, vv_dsp_real* output_s
                                  size_t output_len, size_t frame_len, size_t hop_len,
                                  size_t frame_index);
 
+/**
+ * @brief Overlap-add a batch of frames with a synthesis window and gain
+ * @param frames count frames of frame_len samples, row-major (frame f at frames + f * frame_len)
+ * @param count Number of frames
+ * @param frame_len Length of each frame
+ * @param hop_len Samples between frame starts; frame f lands at f * hop_len
+ * @param synth_window frame_len synthesis window, or NULL for none
+ * @param gain Scale applied with the window, e.g. the overlap normalization
+ * @param output_signal Buffer accumulated into (not cleared first)
+ * @param output_len Length of output_signal; samples past it are dropped
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details Adds frames[f][i] * synth_window[i] * gain into
+ * output_signal[f * hop_len + i] in one vectorized pass per frame, clipping
+ * each frame once at the end of the buffer. Equivalent to windowing and
+ * scaling every frame, then calling vv_dsp_overlap_add() on each.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_overlap_add_frames(const vv_dsp_real* frames, size_t count,
+                                                         size_t frame_len, size_t hop_len,
+                                                         const vv_dsp_real* synth_window, vv_dsp_real gain,
+                                                         vv_dsp_real* output_signal, size_t output_len);
+
 /** @} */
 
 /** @} */ // End of core_group
@@ -0,0 +1,170 @@
+/**
+ * @file alloc.h
+ * @brief Library-wide allocator hooks and allocation counters
+ * @ingroup core_group
+ *
+ * Every allocation the library makes, vv_dsp_aligned_malloc() and the FFT
+ * backends' work arrays included, goes through the functions below, which
+ * forward to the installed allocator (malloc / realloc / free by default) and
+ * count calls and bytes. Memory FFTW and FFTS allocate inside their own plans
+ * is outside their reach.
+ *
+ * Install an allocator before the library allocates anything, or once every
+ * object has been destroyed and vv_dsp_fft_cache_clear() has run: a block
+ * must be freed by the allocator that produced it.
+ */
+
+#ifndef VV_DSP_CORE_ALLOC_H
+#define VV_DSP_CORE_ALLOC_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Allocate size bytes (size > 0) aligned at least as malloc() would */
+typedef void* (*vv_dsp_alloc_fn)(size_t size, void* user);
+/** Resize a block from the same allocator (ptr != NULL, size > 0) */
+typedef void* (*vv_dsp_realloc_fn)(void* ptr, size_t size, void* user);
+/** Release a block from the same allocator (ptr != NULL) */
+typedef void (*vv_dsp_free_fn)(void* ptr, void* user);
+
+/**
+ * @brief Snapshot of the allocation counters
+ */
+typedef struct vv_dsp_alloc_stats {
+    size_t allocations;    /**< Successful new blocks, calloc and realloc from NULL included */
+    size_t frees;          /**< Blocks released */
+    size_t reallocations;  /**< Successful resizes of existing blocks */
+    size_t failures;       /**< Requests the allocator refused */
+    size_t bytes_requested;/**< Bytes asked for by successful allocations and resizes */
+} vv_dsp_alloc_stats;
+
+/**
+ * @brief Route library allocations to a custom allocator
+ * @param alloc_fn Allocation function
+ * @param realloc_fn Resize function
+ * @param free_fn Release function
+ * @param user Passed through to the three functions
+ * @return VV_DSP_OK on success; VV_DSP_ERROR_NULL_POINTER if only some of the
+ * functions are NULL. All three NULL restores malloc / realloc / free.
+ * @note Not thread-safe: see the file notes for when it may be called
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_set_allocator(vv_dsp_alloc_fn alloc_fn,
+                                                    vv_dsp_realloc_fn realloc_fn,
+                                                    vv_dsp_free_fn free_fn,
+                                                    void* user);
+
+/**
+ * @brief Allocate through the installed allocator
+ * @return The block, or NULL on failure or when size is 0
+ */
+void* vv_dsp_malloc(size_t size);
+
+/**
+ * @brief Allocate a zeroed array of count elements of size bytes
+ * @return The block, or NULL on failure, overflow or a zero-sized request
+ */
+void* vv_dsp_calloc(size_t count, size_t size);
+
+/**
+ * @brief Resize a block from vv_dsp_malloc()
+ * @details NULL ptr allocates; size 0 frees ptr and returns NULL. On failure
+ * ptr is left untouched.
+ */
+void* vv_dsp_realloc(void* ptr, size_t size);
+
+/**
+ * @brief Free a block from vv_dsp_malloc(), vv_dsp_calloc() or vv_dsp_realloc() (NULL is ignored)
+ */
+void vv_dsp_free(void* ptr);
+
+/**
+ * @brief Read the allocation counters
+ * @param out Destination
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @note Thread-safe; counters are updated atomically but read one by one
+ */
+vv_dsp_status vv_dsp_get_alloc_stats(vv_dsp_alloc_stats* out);
+
+/**
+ * @brief Read the allocation counters of the calling thread alone
+ * @param out Destination
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @details Two reads around a region give the allocator calls made inside it
+ * by this thread, unaffected by other threads. These counters only grow;
+ * vv_dsp_reset_alloc_stats() leaves them alone.
+ */
+vv_dsp_status vv_dsp_get_thread_alloc_stats(vv_dsp_alloc_stats* out);
+
+/**
+ * @brief Zero the allocation counters
+ */
+void vv_dsp_reset_alloc_stats(void);
+
+/**
+ * @name Real-time sections
+ * The real-time contract of the stateful modules: once an object is prepared for
+ * a largest block (vv_dsp_fir_state_prepare(), vv_dsp_resampler_prepare(),
+ * vv_dsp_resampler_mc_prepare(), vv_dsp_stft_prepare(); biquads and IIR plans
+ * need no preparation), its process calls never allocate, take a lock or make a
+ * system call. Everything that does (buffers, FFT plans from the shared cache,
+ * tables) happens in create, prepare and the set functions.
+ *
+ * A real-time section marks the calling thread: inside one, every allocation,
+ * resize or free through the functions above (vv_dsp_aligned_malloc() included)
+ * calls the trap first. Builds with VV_DSP_RT_CHECKS defined (the CMake option of
+ * the same name, on in Debug configurations) run the process calls of prepared
+ * objects inside a section; a host can also open one around its own callback.
+ *
+ * Tests use the two halves of this layer to hold hot paths to zero
+ * allocations: vv_dsp_get_thread_alloc_stats() before and after a region counts
+ * what it allocated, and a section with a trap that records instead of
+ * aborting forbids it.
+ * @{
+ */
+
+/** Called on an allocator call inside a real-time section; operation is "malloc", "realloc" or "free" */
+typedef void (*vv_dsp_rt_trap_fn)(const char* operation, size_t size, void* user);
+
+/**
+ * @brief Install the trap (NULL restores the default, which reports the call on
+ *        stderr and aborts). When the trap returns, the call goes ahead.
+ * @note Not thread-safe: set it before any real-time section opens
+ */
+void vv_dsp_set_rt_trap(vv_dsp_rt_trap_fn trap, void* user);
+
+/** @brief Open a real-time section on the calling thread (sections nest) */
+void vv_dsp_rt_enter(void);
+
+/** @brief Close the innermost real-time section of the calling thread */
+void vv_dsp_rt_leave(void);
+
+/** @brief Nonzero inside a real-time section of the calling thread */
+int vv_dsp_rt_active(void);
+
+// Library process functions: `const int rt = VV_DSP_RT_ENTER(prepared); ...
+// VV_DSP_RT_LEAVE(rt);` opens a section for a prepared object in checked builds
+#if defined(VV_DSP_RT_CHECKS)
+#define VV_DSP_RT_ENTER(active) ((active) ? (vv_dsp_rt_enter(), 1) : 0)
+#define VV_DSP_RT_LEAVE(rt) do { if (rt) vv_dsp_rt_leave(); } while (0)
+#else
+#define VV_DSP_RT_ENTER(active) 0
+#define VV_DSP_RT_LEAVE(rt) ((void)(rt))
+#endif
+
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_ALLOC_H */
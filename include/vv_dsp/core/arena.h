@@ -0,0 +1,110 @@
+/**
+ * @file arena.h
+ * @brief Workspace arena: a bump allocator for per-call scratch
+ * @ingroup core_group
+ *
+ * An arena owns one SIMD-aligned block from vv_dsp_aligned_malloc() and hands
+ * out aligned slices of it by bumping an offset. Nothing is freed piecewise:
+ * a caller takes a mark, allocates, and resets to the mark when done. The
+ * one-shot functions with an _ex variant take an optional arena and draw all
+ * their scratch (plan structs included) from it, so a processing chain can
+ * run from one block preallocated at setup; each such function also reports
+ * the arena bytes it needs through a _scratch_size function. FFT plans are
+ * still taken from the plan cache, which stops allocating once warm (see
+ * vv_dsp_fft_prewarm()).
+ *
+ * An arena is not thread-safe: use one per thread.
+ */
+
+#ifndef VV_DSP_CORE_ARENA_H
+#define VV_DSP_CORE_ARENA_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Opaque workspace arena */
+typedef struct vv_dsp_arena vv_dsp_arena;
+
+/**
+ * @brief Create an arena with a block of capacity bytes
+ * @param capacity Block size in bytes (must be > 0)
+ * @param out Destination; NULL on failure
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_arena_create(size_t capacity, vv_dsp_arena** out);
+
+/**
+ * @brief Destroy an arena and its block (NULL is ignored)
+ */
+void vv_dsp_arena_destroy(vv_dsp_arena* arena);
+
+/**
+ * @brief Bytes of arena a request of the given size consumes
+ * @details Requests are rounded up to VV_DSP_SIMD_ALIGN_DEFAULT so every slice
+ * stays aligned; _scratch_size functions sum these.
+ */
+size_t vv_dsp_arena_request_size(size_t bytes);
+
+/**
+ * @brief Take an aligned slice of bytes from the arena
+ * @return The slice, or NULL if the arena is NULL or the request does not fit
+ */
+void* vv_dsp_arena_alloc(vv_dsp_arena* arena, size_t bytes);
+
+/**
+ * @brief Current offset, to be passed back to vv_dsp_arena_reset_to()
+ */
+size_t vv_dsp_arena_mark(const vv_dsp_arena* arena);
+
+/**
+ * @brief Release everything allocated since mark (a later mark is ignored)
+ */
+void vv_dsp_arena_reset_to(vv_dsp_arena* arena, size_t mark);
+
+/**
+ * @brief Release everything
+ */
+void vv_dsp_arena_reset(vv_dsp_arena* arena);
+
+/**
+ * @brief Block size in bytes
+ */
+size_t vv_dsp_arena_capacity(const vv_dsp_arena* arena);
+
+/**
+ * @brief Bytes in use
+ */
+size_t vv_dsp_arena_used(const vv_dsp_arena* arena);
+
+/**
+ * @brief Largest number of bytes in use since creation, for sizing the block
+ */
+size_t vv_dsp_arena_high_water(const vv_dsp_arena* arena);
+
+/**
+ * @brief Scratch from the arena, or from vv_dsp_aligned_malloc() when arena is NULL
+ * @details The helper behind the _ex variants: code allocates through it and
+ * frees with vv_dsp_scratch_free() whether or not an arena was passed.
+ */
+void* vv_dsp_scratch_alloc(vv_dsp_arena* arena, size_t bytes);
+
+/**
+ * @brief Free scratch from vv_dsp_scratch_alloc(): a no-op for arena memory
+ */
+void vv_dsp_scratch_free(vv_dsp_arena* arena, void* ptr);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_ARENA_H */
@@ -0,0 +1,122 @@
+/**
+ * @file buffer.h
+ * @brief Multichannel sample buffers with planar, interleaved and strided views
+ * @ingroup core_group
+ *
+ * A vv_dsp_buffer describes channels x frames samples in memory: sample
+ * (c, f) lives at data[c * channel_stride + f * frame_stride]. Planar
+ * storage has frame_stride 1 (each channel contiguous, channels
+ * channel_stride apart); interleaved storage has channel_stride 1 and
+ * frame_stride = channels. Any other pair of strides is a strided view, for
+ * instance a sub-range of channels of a wider interleaved stream.
+ *
+ * A descriptor never owns its samples unless it came from
+ * vv_dsp_buffer_create(). Multichannel entry points (here, in filter/fir.h,
+ * filter/iir.h and resample/resampler.h) pick their loop from the layout:
+ * frame-vectorized runs over contiguous channels, channel-vectorized runs
+ * over interleaved frames, where each coefficient is loaded once for all
+ * channels. None of them allocates.
+ */
+
+#ifndef VV_DSP_CORE_BUFFER_H
+#define VV_DSP_CORE_BUFFER_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Storage order of a buffer */
+typedef enum vv_dsp_buffer_layout {
+    VV_DSP_BUFFER_PLANAR = 0,      /**< frame_stride 1: one contiguous run per channel */
+    VV_DSP_BUFFER_INTERLEAVED = 1, /**< channel_stride 1, frame_stride = channels */
+    VV_DSP_BUFFER_STRIDED = 2      /**< Anything else */
+} vv_dsp_buffer_layout;
+
+/** Multichannel buffer descriptor; strides are in samples */
+typedef struct vv_dsp_buffer {
+    vv_dsp_real* data;      /**< Sample (0, 0) */
+    size_t channels;        /**< Number of channels */
+    size_t frames;          /**< Samples per channel */
+    size_t channel_stride;  /**< Distance between channel c and c + 1 at one frame */
+    size_t frame_stride;    /**< Distance between frame f and f + 1 of one channel */
+    size_t alignment;       /**< Bytes every channel start is aligned to (sizeof(vv_dsp_real) if unknown) */
+} vv_dsp_buffer;
+
+/**
+ * @brief Describe planar samples: channel c starts at data + c * channel_stride
+ * @param channel_stride Samples between channel starts (>= frames; 0 = frames)
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER, or VV_DSP_ERROR_INVALID_SIZE for
+ *         zero channels or a stride shorter than a channel
+ */
+vv_dsp_status vv_dsp_buffer_view_planar(vv_dsp_real* data, size_t channels, size_t frames,
+                                        size_t channel_stride, vv_dsp_buffer* out);
+
+/** @brief Describe interleaved samples: frame f starts at data + f * channels */
+vv_dsp_status vv_dsp_buffer_view_interleaved(vv_dsp_real* data, size_t channels, size_t frames,
+                                             vv_dsp_buffer* out);
+
+/**
+ * @brief View channels [first, first + count) and frames [offset, offset + frames)
+ *        of a buffer, with the same strides
+ * @return VV_DSP_OK, VV_DSP_ERROR_OUT_OF_RANGE when the range leaves the buffer
+ */
+vv_dsp_status vv_dsp_buffer_view_range(const vv_dsp_buffer* buf, size_t first, size_t count, size_t offset,
+                                       size_t frames, vv_dsp_buffer* out);
+
+/**
+ * @brief Allocate a zeroed buffer. Planar channels start on SIMD-aligned
+ *        boundaries (the stride is padded); interleaved frames are packed.
+ * @param out Filled in; release it with vv_dsp_buffer_free()
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE, or VV_DSP_ERROR_INTERNAL if allocation fails
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_buffer_create(size_t channels, size_t frames, vv_dsp_buffer_layout layout,
+                                                   vv_dsp_buffer* out);
+
+/** @brief Release a buffer from vv_dsp_buffer_create() and clear the descriptor (NULL is ignored) */
+void vv_dsp_buffer_free(vv_dsp_buffer* buf);
+
+/** @brief Layout of a descriptor; one channel, or one frame, counts as planar */
+vv_dsp_buffer_layout vv_dsp_buffer_get_layout(const vv_dsp_buffer* buf);
+
+/** @brief Pointer to sample (channel, 0), or NULL when out of range */
+vv_dsp_real* vv_dsp_buffer_channel(const vv_dsp_buffer* buf, size_t channel);
+
+/** @brief Zero every sample */
+vv_dsp_status vv_dsp_buffer_clear(vv_dsp_buffer* buf);
+
+/**
+ * @brief Copy src into dst, converting the layout
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE when the shapes differ. The buffers
+ *         must not overlap unless they are the same descriptor.
+ */
+vv_dsp_status vv_dsp_buffer_copy(const vv_dsp_buffer* src, vv_dsp_buffer* dst);
+
+/**
+ * @brief Scale the samples in place, channel c by gains[c]
+ * @param gains One gain per channel, or NULL to apply gain to every channel
+ */
+vv_dsp_status vv_dsp_buffer_gain(vv_dsp_buffer* buf, const vv_dsp_real* gains, vv_dsp_real gain);
+
+/**
+ * @brief Mix in into out through a matrix: out[o] = sum_i matrix[o * in->channels + i] * in[i]
+ * @param accumulate Nonzero adds the mix to out instead of replacing it
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE when the frame counts differ
+ * @note in and out must not overlap
+ */
+vv_dsp_status vv_dsp_buffer_mix(const vv_dsp_buffer* in, const vv_dsp_real* matrix, vv_dsp_buffer* out,
+                                int accumulate);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_BUFFER_H */
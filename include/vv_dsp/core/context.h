@@ -0,0 +1,97 @@
+/**
+ * @file context.h
+ * @brief Per-subsystem settings captured by plans at creation
+ * @ingroup core_group
+ *
+ * The FFT backend, NaN policy, precision mode, batch thread pool and denormal
+ * handling are otherwise process-wide (or, for the NaN policy and FTZ/DAZ, per
+ * thread) and read by every call. A vv_dsp_context gathers them so that plans
+ * created with it (the _ctx creators of FFT, STFT, MFCC and the resampler) carry
+ * their own copy: two subsystems, or two
+ * tenants of one server, can then run with different settings side by side, and the
+ * captured values replace the global lookups on the plan's hot path.
+ *
+ * The context is a plain value: it is copied at plan creation and may be changed or
+ * discarded afterwards. Fields left at VV_DSP_CONTEXT_DEFAULT (and a NULL pool)
+ * keep the process-wide behaviour, so vv_dsp_context_init() followed by a _ctx
+ * creator gives the same plan as the plain creator. A NULL context means the same.
+ */
+
+#ifndef VV_DSP_CORE_CONTEXT_H
+#define VV_DSP_CORE_CONTEXT_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/nan_policy.h"
+#include "vv_dsp/core/precision.h"
+#include "vv_dsp/core/threadpool.h"
+#include "vv_dsp/core/fp_env.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** @brief Field value that defers to the process-wide (or per-thread) setting */
+#define VV_DSP_CONTEXT_DEFAULT (-1)
+
+/** @brief Settings captured by plans created through a _ctx creator */
+typedef struct vv_dsp_context {
+    /** vv_dsp_fft_backend of the plan's transforms; DEFAULT = vv_dsp_fft_get_backend() */
+    int fft_backend;
+    /** vv_dsp_nan_policy_e applied by the plan; DEFAULT = the calling thread's policy per call */
+    int nan_policy;
+    /** Precision mode, as the plan's set_precision() would set it */
+    vv_dsp_precision_mode precision;
+    /** Pool of the plan's batch (_parallel) calls; NULL = the default pool at call time */
+    vv_dsp_threadpool* pool;
+    /** vv_dsp_denormal_mode around the plan's process calls; DEFAULT = the calling thread's mode */
+    int denormals;
+} vv_dsp_context;
+
+/** @brief Every field at its process-wide default */
+static VV_DSP_INLINE void vv_dsp_context_init(vv_dsp_context* ctx) {
+    ctx->fft_backend = VV_DSP_CONTEXT_DEFAULT;
+    ctx->nan_policy = VV_DSP_CONTEXT_DEFAULT;
+    ctx->precision = VV_DSP_PRECISION_EXACT;
+    ctx->pool = NULL;
+    ctx->denormals = VV_DSP_CONTEXT_DEFAULT;
+}
+
+/**
+ * @brief Check the fields every creator captures (the FFT backend is checked by spectral)
+ * @return VV_DSP_OK (also for NULL), or VV_DSP_ERROR_OUT_OF_RANGE for an unknown
+ * NaN policy, precision mode or denormal mode
+ */
+static VV_DSP_INLINE vv_dsp_status vv_dsp_context_check(const vv_dsp_context* ctx) {
+    if (!ctx) return VV_DSP_OK;
+    if (ctx->nan_policy != VV_DSP_CONTEXT_DEFAULT &&
+        (ctx->nan_policy < (int)VV_DSP_NAN_POLICY_PROPAGATE || ctx->nan_policy > (int)VV_DSP_NAN_POLICY_CLAMP)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    if (ctx->denormals != VV_DSP_CONTEXT_DEFAULT &&
+        ctx->denormals != (int)VV_DSP_DENORMALS_KEEP && ctx->denormals != (int)VV_DSP_DENORMALS_FLUSH) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    return vv_dsp_precision_mode_valid(ctx->precision) ? VV_DSP_OK : VV_DSP_ERROR_OUT_OF_RANGE;
+}
+
+/** @brief A captured NaN policy, or the calling thread's one for VV_DSP_CONTEXT_DEFAULT */
+static VV_DSP_INLINE vv_dsp_nan_policy_e vv_dsp_context_resolve_nan_policy(int captured) {
+    return captured == VV_DSP_CONTEXT_DEFAULT ? vv_dsp_get_nan_policy() : (vv_dsp_nan_policy_e)captured;
+}
+
+/** @brief The denormal mode a context asks for (KEEP for NULL or VV_DSP_CONTEXT_DEFAULT) */
+static VV_DSP_INLINE vv_dsp_denormal_mode vv_dsp_context_denormals(const vv_dsp_context* ctx) {
+    return (ctx && ctx->denormals == (int)VV_DSP_DENORMALS_FLUSH) ? VV_DSP_DENORMALS_FLUSH : VV_DSP_DENORMALS_KEEP;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_CONTEXT_H */
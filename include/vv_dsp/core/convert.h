@@ -0,0 +1,81 @@
+/**
+ * @file convert.h
+ * @brief Sample format conversion and (de)interleaving for audio I/O
+ * @ingroup core_group
+ *
+ * Integer and float sample streams as found in WAV files and audio device
+ * buffers, all little-endian: 16-bit, packed 24-bit (3 bytes) and 32-bit
+ * signed integers, and 32-bit IEEE float. Integer samples of b bits decode as
+ * v / 2^(b-1) and encode by clamping to [-1, 1] (NaN by its sign), scaling by
+ * 2^(b-1) - 1 and truncating; float samples pass through unscaled. Source and
+ * destination need no particular alignment.
+ *
+ * The kernels are runtime-dispatched like the rest of core, with the
+ * interleaved layouts of one and two channels specialized, and they allocate
+ * nothing, so they are safe on a real-time thread.
+ */
+
+#ifndef VV_DSP_CORE_CONVERT_H
+#define VV_DSP_CORE_CONVERT_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** @brief External sample formats (little-endian) */
+typedef enum vv_dsp_sample_format {
+    VV_DSP_SAMPLE_S16 = 0, /**< 16-bit signed integer */
+    VV_DSP_SAMPLE_S24 = 1, /**< 24-bit signed integer packed in 3 bytes */
+    VV_DSP_SAMPLE_S32 = 2, /**< 32-bit signed integer */
+    VV_DSP_SAMPLE_F32 = 3  /**< 32-bit IEEE float */
+} vv_dsp_sample_format;
+
+/**
+ * @brief Bytes per sample of a format
+ * @return 2, 3 or 4, or 0 for an unknown format
+ */
+size_t vv_dsp_sample_format_bytes(vv_dsp_sample_format format);
+
+/**
+ * @brief Decode count samples of src into out, keeping their order
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER for NULL buffers with count > 0,
+ * or VV_DSP_ERROR_UNSUPPORTED for an unknown format
+ */
+vv_dsp_status vv_dsp_convert_to_real(const void* src, vv_dsp_sample_format format, size_t count,
+                                     vv_dsp_real* out);
+
+/** @brief Encode count samples of in into dst, keeping their order */
+vv_dsp_status vv_dsp_convert_from_real(const vv_dsp_real* in, size_t count, vv_dsp_sample_format format,
+                                       void* dst);
+
+/**
+ * @brief Decode frames interleaved frames of channels samples into one buffer per channel
+ * @param src frames * channels samples
+ * @param format Format of src
+ * @param channels Channel count (> 0)
+ * @param frames Frame count
+ * @param out channels buffers of frames samples
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER, VV_DSP_ERROR_INVALID_SIZE for no
+ * channels, or VV_DSP_ERROR_UNSUPPORTED for an unknown format
+ */
+vv_dsp_status vv_dsp_convert_deinterleave(const void* src, vv_dsp_sample_format format, size_t channels,
+                                          size_t frames, vv_dsp_real* const* out);
+
+/** @brief Encode one buffer per channel into frames interleaved frames; the inverse of vv_dsp_convert_deinterleave() */
+vv_dsp_status vv_dsp_convert_interleave(const vv_dsp_real* const* in, size_t channels, size_t frames,
+                                        vv_dsp_sample_format format, void* dst);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_CORE_CONVERT_H
@@ -0,0 +1,69 @@
+/**
+ * @file fixed_point.h
+ * @brief Q15 / Q31 fixed-point types, saturation and conversions
+ * @ingroup core_group
+ *
+ * Fixed-point samples for targets without a fast FPU (Cortex-M, DSP-less ARM).
+ * A Q15 value v represents v / 2^15 and a Q31 value v / 2^31, so both span
+ * [-1, 1). The fixed-point kernels (vv_dsp/filter/fixed.h,
+ * vv_dsp/spectral/fft_fixed.h) are built when the CMake option
+ * VV_DSP_ENABLE_FIXED_POINT is on, which defines VV_DSP_FIXED_POINT_ENABLED.
+ * They do not depend on the precision of vv_dsp_real.
+ */
+
+#ifndef VV_DSP_CORE_FIXED_POINT_H
+#define VV_DSP_CORE_FIXED_POINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+typedef int16_t vv_dsp_q15; /**< Q1.15 sample */
+typedef int32_t vv_dsp_q31; /**< Q1.31 sample */
+
+/** @brief Complex Q15 sample */
+typedef struct vv_dsp_cpx_q15 {
+    vv_dsp_q15 re;
+    vv_dsp_q15 im;
+} vv_dsp_cpx_q15;
+
+/** @brief Saturate a 32-bit intermediate to Q15 */
+static VV_DSP_INLINE vv_dsp_q15 vv_dsp_sat_q15(int32_t x) {
+    return (vv_dsp_q15)(x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x));
+}
+
+/** @brief Saturate a 64-bit intermediate to Q31 */
+static VV_DSP_INLINE vv_dsp_q31 vv_dsp_sat_q31(int64_t x) {
+    return (vv_dsp_q31)(x > INT32_MAX ? INT32_MAX : (x < INT32_MIN ? INT32_MIN : x));
+}
+
+/**
+ * @brief Convert real samples to Q15 with rounding and saturation
+ * @return VV_DSP_OK, or VV_DSP_ERROR_NULL_POINTER for NULL buffers with n > 0
+ */
+vv_dsp_status vv_dsp_real_to_q15(const vv_dsp_real* in, vv_dsp_q15* out, size_t n);
+
+/** @brief Convert Q15 samples to real */
+vv_dsp_status vv_dsp_q15_to_real(const vv_dsp_q15* in, vv_dsp_real* out, size_t n);
+
+/** @brief Convert real samples to Q31 with rounding and saturation */
+vv_dsp_status vv_dsp_real_to_q31(const vv_dsp_real* in, vv_dsp_q31* out, size_t n);
+
+/** @brief Convert Q31 samples to real */
+vv_dsp_status vv_dsp_q31_to_real(const vv_dsp_q31* in, vv_dsp_real* out, size_t n);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_CORE_FIXED_POINT_H
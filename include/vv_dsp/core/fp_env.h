@@ -45,6 +45,50 @@ void vv_dsp_set_flush_denormals(bool enable);
  */
 bool vv_dsp_get_flush_denormals_mode(void);
 
+/**
+ * @brief Denormal handling a plan applies around its process calls.
+ *
+ * Plans that run recursive filters (biquad banks, the resampler, graphs) take a
+ * mode through their set_denormals() call or a context (core/context.h), so a
+ * decaying IIR tail never falls into subnormal arithmetic even when the host
+ * thread has not enabled FTZ/DAZ.
+ */
+typedef enum vv_dsp_denormal_mode {
+    VV_DSP_DENORMALS_KEEP = 0,  /**< Run in the calling thread's mode (default) */
+    VV_DSP_DENORMALS_FLUSH = 1  /**< FTZ/DAZ for the duration of each process call */
+} vv_dsp_denormal_mode;
+
+/**
+ * @brief Saved flush state of a scope opened by vv_dsp_fp_scope_enter().
+ */
+typedef struct vv_dsp_fp_scope {
+    unsigned long saved;  /**< Flush bits of the control register at entry */
+    bool changed;         /**< Whether entry wrote the register */
+} vv_dsp_fp_scope;
+
+/**
+ * @brief Opens a scope in which denormals are handled as mode asks.
+ *
+ * For VV_DSP_DENORMALS_FLUSH the flush bits are set unless they already are; the
+ * control register is only written when they change, so a thread that runs with
+ * FTZ/DAZ on pays one register read per scope. VV_DSP_DENORMALS_KEEP does nothing.
+ * Scopes nest.
+ *
+ * @param scope Receives the state vv_dsp_fp_scope_exit() restores
+ * @param mode Denormal handling inside the scope
+ */
+void vv_dsp_fp_scope_enter(vv_dsp_fp_scope* scope, vv_dsp_denormal_mode mode);
+
+/**
+ * @brief Closes a scope, restoring the flush bits it changed.
+ *
+ * Other bits of the control register, including floating-point status flags
+ * raised inside the scope, are left as they are.
+ *
+ * @param scope State filled by the matching vv_dsp_fp_scope_enter()
+ */
+void vv_dsp_fp_scope_exit(const vv_dsp_fp_scope* scope);
+
 #ifdef __cplusplus
 }
 #endif
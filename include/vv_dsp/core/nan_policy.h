@@ -15,6 +15,8 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <string.h>
 #include "vv_dsp/vv_dsp_types.h"
 
 /** @addtogroup core_group
@@ -101,6 +103,55 @@ vv_dsp_status vv_dsp_apply_nan_policy_inplace(vv_dsp_real* data, size_t len);
  */
 vv_dsp_status vv_dsp_apply_nan_policy_copy(const vv_dsp_real* data, size_t len, vv_dsp_real* output);
 
+/**
+ * @brief Index of the first NaN/Inf in an array
+ * @param data Pointer to the array data
+ * @param len Number of elements in the array
+ * @return Index of the first non-finite element, or len if all are finite
+ * @details Vectorized exponent-bit scan through the runtime dispatch table; it
+ * stops at the first block holding a non-finite value, so clean data costs one
+ * streaming read.
+ */
+size_t vv_dsp_find_nonfinite(const vv_dsp_real* data, size_t len);
+
+/**
+ * @brief Apply a given NaN/Inf policy to an array in-place
+ * @param policy Policy fetched once per call with vv_dsp_get_nan_policy()
+ * @param data Pointer to the array data
+ * @param len Number of elements in the array
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NAN_INF if policy is ERROR and NaN/Inf found
+ * @details Same effect as vv_dsp_apply_nan_policy_inplace() without the
+ * thread-local lookup. Kernels fold the check into their final store loop:
+ *
+ * @code{.c}
+ * const vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
+ * unsigned bad = 0;
+ * for (size_t i = 0; i < n; ++i) {
+ *     out[i] = ...;
+ *     bad |= vv_dsp_nonfinite_flag(out[i]);
+ * }
+ * if (bad) status = vv_dsp_nan_policy_fixup(policy, out, n);
+ * @endcode
+ */
+vv_dsp_status vv_dsp_nan_policy_fixup(vv_dsp_nan_policy_e policy, vv_dsp_real* data, size_t len);
+
+/**
+ * @brief 1 if v is NaN or +/-Inf, 0 otherwise
+ * @details A branch-free exponent-bit test, so a store loop that ORs it into a
+ * flag still vectorizes.
+ */
+static VV_DSP_INLINE unsigned vv_dsp_nonfinite_flag(vv_dsp_real v) {
+#if defined(VV_DSP_USE_DOUBLE)
+    uint64_t b;
+    memcpy(&b, &v, sizeof(b));
+    return (unsigned)((b & 0x7ff0000000000000ull) == 0x7ff0000000000000ull);
+#else
+    uint32_t b;
+    memcpy(&b, &v, sizeof(b));
+    return (unsigned)((b & 0x7f800000u) == 0x7f800000u);
+#endif
+}
+
 /** @} */
 
 /** @} */
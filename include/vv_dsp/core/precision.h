@@ -0,0 +1,58 @@
+/**
+ * @file precision.h
+ * @brief Per-plan accuracy/speed trade-off
+ * @ingroup core_group
+ *
+ * A precision mode set on an STFT handle, MFCC plan or resampler picks how that
+ * object trades accuracy for speed, so one binary can run a high-fidelity path
+ * next to a cheap monitoring path. Exact is the default everywhere and gives the
+ * same results as an object that never had a mode set. What each mode changes is
+ * documented with the setter of each object; callers of the vmath functions map
+ * a mode onto a tier with vv_dsp_precision_vmath_tier().
+ */
+
+#ifndef VV_DSP_CORE_PRECISION_H
+#define VV_DSP_CORE_PRECISION_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/vmath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/**
+ * @brief Accuracy/speed trade-off of a plan
+ */
+typedef enum vv_dsp_precision_mode {
+    VV_DSP_PRECISION_EXACT = 0,    /**< libm transcendentals, full-length kernels (default) */
+    VV_DSP_PRECISION_BALANCED = 1, /**< Vectorized transcendentals within a few float ulp, shorter kernels */
+    VV_DSP_PRECISION_FAST = 2      /**< Short-polynomial transcendentals (about 1e-4), shortest kernels */
+} vv_dsp_precision_mode;
+
+/**
+ * @brief Nonzero for a known mode
+ */
+static VV_DSP_INLINE int vv_dsp_precision_mode_valid(vv_dsp_precision_mode mode) {
+    return mode == VV_DSP_PRECISION_EXACT || mode == VV_DSP_PRECISION_BALANCED || mode == VV_DSP_PRECISION_FAST;
+}
+
+/**
+ * @brief vmath tier for a mode: exact, medium or fast
+ */
+static VV_DSP_INLINE vv_dsp_vmath_tier vv_dsp_precision_vmath_tier(vv_dsp_precision_mode mode) {
+    return mode == VV_DSP_PRECISION_FAST ? VV_DSP_VMATH_FAST
+         : (mode == VV_DSP_PRECISION_BALANCED ? VV_DSP_VMATH_MEDIUM : VV_DSP_VMATH_EXACT);
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_PRECISION_H */
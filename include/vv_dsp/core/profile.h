@@ -0,0 +1,158 @@
+/**
+ * @file profile.h
+ * @brief Per-entry-point timing and counters for profiling builds
+ * @ingroup core_group
+ *
+ * Builds with VV_DSP_ENABLE_PROFILING defined (the CMake option of the same
+ * name) time the library's hot entry points: FFT execute, STFT process,
+ * FIR and IIR apply, streaming resample and MFCC process. Each call adds
+ * to counters of the calling thread, so recording takes no lock; a
+ * snapshot sums the counters of all threads, including threads that have
+ * exited. Times are inclusive: an STFT frame also counts as one FFT
+ * execute. In other builds the entry points carry no instrumentation and
+ * every counter stays at zero; the functions below still link.
+ *
+ * Individual calls can also be recorded as events, either into a buffer
+ * written out in the Chrome trace format (which Perfetto and
+ * chrome://tracing open) or handed to a hook, e.g. to forward them to an
+ * application's own tracing.
+ */
+
+#ifndef VV_DSP_CORE_PROFILE_H
+#define VV_DSP_CORE_PROFILE_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Instrumented entry points */
+typedef enum {
+    VV_DSP_PROFILE_FFT_EXECUTE = 0,  /**< vv_dsp_fft_execute(); samples = transform size */
+    VV_DSP_PROFILE_STFT_PROCESS,     /**< vv_dsp_stft_process(); samples = frame size */
+    VV_DSP_PROFILE_FIR_APPLY,        /**< vv_dsp_fir_apply(); samples = block length */
+    VV_DSP_PROFILE_IIR_APPLY,        /**< vv_dsp_iir_apply(), vv_dsp_iir_plan_apply(); samples = block length */
+    VV_DSP_PROFILE_RESAMPLE,         /**< vv_dsp_resampler_process_real() and _stream(); samples = input samples */
+    VV_DSP_PROFILE_MFCC_PROCESS,     /**< vv_dsp_mfcc_process(); samples = frames */
+    VV_DSP_PROFILE_POINT_COUNT
+} vv_dsp_profile_point;
+
+/** Totals of one entry point */
+typedef struct vv_dsp_profile_entry {
+    const char* name;      /**< Entry point name, e.g. "fft_execute" */
+    uint64_t calls;        /**< Completed calls */
+    uint64_t samples;      /**< Samples processed (see vv_dsp_profile_point) */
+    uint64_t ns;           /**< Wall time spent inside, nanoseconds */
+    uint64_t allocations;  /**< Allocator calls made inside (see core/alloc.h) */
+} vv_dsp_profile_entry;
+
+/** Totals of every entry point, indexed by vv_dsp_profile_point */
+typedef struct vv_dsp_profile_report {
+    vv_dsp_profile_entry entries[VV_DSP_PROFILE_POINT_COUNT];
+} vv_dsp_profile_report;
+
+/** One recorded call */
+typedef struct vv_dsp_profile_event {
+    vv_dsp_profile_point point;
+    uint32_t thread;       /**< Small per-thread number, 1 for the first thread that recorded */
+    uint64_t start_ns;     /**< Monotonic clock at entry */
+    uint64_t duration_ns;
+    uint64_t samples;
+} vv_dsp_profile_event;
+
+/** Called at the end of every instrumented call while installed */
+typedef void (*vv_dsp_profile_hook_fn)(const vv_dsp_profile_event* event, void* user);
+
+/** @brief Nonzero if the library was built with VV_DSP_ENABLE_PROFILING */
+int vv_dsp_profile_enabled(void);
+
+/** @brief Name of an entry point ("fft_execute", ...), or NULL if point is out of range */
+const char* vv_dsp_profile_point_name(vv_dsp_profile_point point);
+
+/**
+ * @brief Sum the counters of all threads
+ * @param out Destination
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @note Thread-safe; calls still running on other threads are not included
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_profile_snapshot(vv_dsp_profile_report* out);
+
+/**
+ * @brief Zero the counters of all threads
+ * @note Calls running on other threads meanwhile may keep part of their old totals
+ */
+void vv_dsp_profile_reset(void);
+
+/**
+ * @brief Install the event hook (NULL removes it)
+ * @note Not thread-safe: set it while no instrumented call is running
+ */
+void vv_dsp_profile_set_hook(vv_dsp_profile_hook_fn hook, void* user);
+
+/**
+ * @brief Start recording events into a buffer of max_events entries
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE if max_events is 0,
+ *         VV_DSP_ERROR_INTERNAL if the buffer cannot be allocated
+ * @details Events past the end of the buffer are counted and dropped. An
+ * earlier buffer is released.
+ * @note Not thread-safe: start and stop while no instrumented call is running
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_profile_trace_start(size_t max_events);
+
+/** @brief Stop recording and release the event buffer (same caveat as start) */
+void vv_dsp_profile_trace_stop(void);
+
+/**
+ * @brief Write the events recorded so far as a Chrome trace JSON document
+ * @param file Destination stream
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER if file is NULL,
+ *         VV_DSP_ERROR_INTERNAL on a write error
+ * @details Without a started trace the document has no events. Dropped
+ * events are reported under "otherData".
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_profile_trace_write(FILE* file);
+
+/**
+ * @name Instrumentation
+ * Used by the library's entry points: `VV_DSP_PROFILE_BEGIN(prof, point); ...
+ * VV_DSP_PROFILE_END(prof, samples);` times the code between the two in
+ * profiling builds and expands to nothing otherwise.
+ * @{
+ */
+typedef struct vv_dsp_profile_scope {
+    vv_dsp_profile_point point;
+    uint64_t start_ns;
+    size_t allocations;
+} vv_dsp_profile_scope;
+
+void vv_dsp_profile_begin(vv_dsp_profile_scope* scope, vv_dsp_profile_point point);
+void vv_dsp_profile_end(const vv_dsp_profile_scope* scope, size_t samples);
+/** Counts an allocator call of the calling thread (called by core/alloc.c) */
+void vv_dsp_profile_note_allocation(void);
+
+#if defined(VV_DSP_ENABLE_PROFILING)
+#define VV_DSP_PROFILE_BEGIN(scope, point) \
+    vv_dsp_profile_scope scope;            \
+    vv_dsp_profile_begin(&scope, (point))
+#define VV_DSP_PROFILE_END(scope, samples) vv_dsp_profile_end(&scope, (samples))
+#else
+#define VV_DSP_PROFILE_BEGIN(scope, point) ((void)0)
+#define VV_DSP_PROFILE_END(scope, samples) ((void)0)
+#endif
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_PROFILE_H */
@@ -0,0 +1,87 @@
+/**
+ * @file quant.h
+ * @brief Compact storage types for spectrogram and feature matrices
+ * @ingroup core_group
+ *
+ * Long spectrograms and feature matrices held as vv_dsp_real cost gigabytes, and
+ * moving them dominates the stages that read them. These storage types trade
+ * precision for 2x to 8x less memory and bandwidth:
+ *
+ * - F16: IEEE binary16 (11-bit significand, range 6e-8 .. 65504), suits dB and
+ *   log-mel values and normalized features;
+ * - BF16: bfloat16 (8-bit significand, the float exponent range), suits raw power
+ *   and magnitude;
+ * - U8: 256 codes spread linearly over [lo, hi], e.g. a dB spectrogram for display;
+ * - U8_DB: 256 codes of 10 log10(v) over [lo, hi] dB, for power values stored in
+ *   the log domain.
+ *
+ * Encoding rounds to nearest (even for the 16-bit types, through float in double
+ * builds) and saturates: 16-bit types overflow to Inf, 8-bit codes clamp to
+ * [lo, hi] with NaN at lo. Decoding widens on the fly: the 16-bit types exactly, the
+ * 8-bit codes through a 256-entry table built by vv_dsp_quant_init(). Both run the
+ * runtime-dispatched core kernels, allocate nothing and need no alignment.
+ */
+
+#ifndef VV_DSP_CORE_QUANT_H
+#define VV_DSP_CORE_QUANT_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** @brief Element type of stored matrices */
+typedef enum vv_dsp_storage_type {
+    VV_DSP_STORAGE_REAL = 0,  /**< vv_dsp_real, unconverted */
+    VV_DSP_STORAGE_F16 = 1,   /**< IEEE binary16 */
+    VV_DSP_STORAGE_BF16 = 2,  /**< bfloat16 */
+    VV_DSP_STORAGE_U8 = 3,    /**< 8-bit codes, linear over [lo, hi] */
+    VV_DSP_STORAGE_U8_DB = 4  /**< 8-bit codes of 10 log10(v), linear over [lo, hi] dB */
+} vv_dsp_storage_type;
+
+/**
+ * @brief A storage type with its range, filled by vv_dsp_quant_init()
+ * @details Plain value (no resources); copy it freely. Fields are read-only.
+ */
+typedef struct vv_dsp_quant {
+    vv_dsp_storage_type type;
+    vv_dsp_real lo;          /**< First code's value (8-bit types) */
+    vv_dsp_real hi;          /**< Last code's value (8-bit types) */
+    float offset;            /**< Encoder: code = (v - offset) * scale, v in the code's domain */
+    float scale;
+    vv_dsp_real lut[256];    /**< Decoder table (8-bit types) */
+} vv_dsp_quant;
+
+/**
+ * @brief Bytes per element of a storage type
+ * @return sizeof(vv_dsp_real), 2 or 1, or 0 for an unknown type
+ */
+size_t vv_dsp_storage_bytes(vv_dsp_storage_type type);
+
+/**
+ * @brief Set up a storage type
+ * @param lo, hi Range of the 8-bit types (finite, lo < hi); ignored by the others
+ * @return VV_DSP_OK, VV_DSP_ERROR_UNSUPPORTED for an unknown type or
+ * VV_DSP_ERROR_OUT_OF_RANGE for a bad range
+ */
+vv_dsp_status vv_dsp_quant_init(vv_dsp_quant* q, vv_dsp_storage_type type, vv_dsp_real lo, vv_dsp_real hi);
+
+/** @brief Encode n values of x into dst (n * vv_dsp_storage_bytes() bytes) */
+vv_dsp_status vv_dsp_quant_encode(const vv_dsp_quant* q, const vv_dsp_real* x, size_t n, void* dst);
+
+/** @brief Widen n stored elements of src into out */
+vv_dsp_status vv_dsp_quant_decode(const vv_dsp_quant* q, const void* src, size_t n, vv_dsp_real* out);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_CORE_QUANT_H
@@ -0,0 +1,145 @@
+/**
+ * @file ring.h
+ * @brief Lock-free ring buffers for handing records between threads
+ * @ingroup core_group
+ *
+ * A ring holds a power-of-two number of fixed-size records: vv_dsp_real
+ * samples (record_size = sizeof(vv_dsp_real)) or whole frames, feature
+ * vectors or messages. One consumer thread reads them in order.
+ *
+ * - VV_DSP_RING_SPSC: one producer thread. Both sides are wait-free; each
+ *   keeps its position and a cached copy of the other side's on a cache line
+ *   of its own, so the audio callback never touches a line the other thread
+ *   writes unless the ring looks full (or empty).
+ * - VV_DSP_RING_MPSC: any number of producer threads. A producer claims its
+ *   records with a compare-and-swap (lock-free), fills them and publishes
+ *   them through per-record sequence numbers; the consumer stops at the
+ *   first record that is claimed but not yet published.
+ *
+ * The region functions give direct access to the ring's storage for
+ * zero-copy transfer: begin a region, fill or read up to its count records
+ * in place, end it. A region never wraps, so one transfer may take two
+ * regions. vv_dsp_ring_write() and vv_dsp_ring_read() copy through them.
+ * No function allocates after vv_dsp_ring_create().
+ */
+
+#ifndef VV_DSP_CORE_RING_H
+#define VV_DSP_CORE_RING_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Opaque ring buffer */
+typedef struct vv_dsp_ring vv_dsp_ring;
+
+/** Producer model of a ring */
+typedef enum vv_dsp_ring_mode {
+    VV_DSP_RING_SPSC = 0,  /**< One producer thread, one consumer thread */
+    VV_DSP_RING_MPSC = 1   /**< Any number of producer threads, one consumer thread */
+} vv_dsp_ring_mode;
+
+/** Contiguous run of records inside a ring */
+typedef struct vv_dsp_ring_region {
+    void* data;       /**< First record (SIMD-aligned when the region starts the buffer) */
+    size_t count;     /**< Records in the region; may be lowered before ending it (see below) */
+    size_t position;  /**< Ring position of data (internal) */
+    size_t claimed;   /**< Records the region was begun with (internal) */
+} vv_dsp_ring_region;
+
+/**
+ * @brief Create a ring
+ * @param mode SPSC or MPSC
+ * @param record_size Bytes per record (> 0)
+ * @param capacity Records the ring holds, rounded up to a power of two (> 0)
+ * @param out Destination; NULL on failure
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE for a zero or oversized
+ *         capacity or record size, VV_DSP_ERROR_INTERNAL if allocation fails
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_create(vv_dsp_ring_mode mode, size_t record_size,
+                                                 size_t capacity, vv_dsp_ring** out);
+
+/** @brief Destroy a ring (NULL is ignored); no thread may be using it */
+void vv_dsp_ring_destroy(vv_dsp_ring* ring);
+
+/** @brief Records the ring holds (0 for NULL) */
+size_t vv_dsp_ring_capacity(const vv_dsp_ring* ring);
+
+/** @brief Bytes per record (0 for NULL) */
+size_t vv_dsp_ring_record_size(const vv_dsp_ring* ring);
+
+/**
+ * @brief Records queued: written and not yet read. In MPSC mode this includes
+ *        records a producer has claimed but not yet published. Exact only on the
+ *        producer (SPSC) or consumer thread; a snapshot elsewhere.
+ */
+size_t vv_dsp_ring_size(const vv_dsp_ring* ring);
+
+/** @brief Records that can be written now: capacity minus vv_dsp_ring_size() */
+size_t vv_dsp_ring_space(const vv_dsp_ring* ring);
+
+/**
+ * @brief Producer: claim up to max_records contiguous free records to fill in place
+ * @param out Region; count 0 when the ring is full
+ * @details In SPSC mode the region can be ended with a lower count, returning the
+ * rest. In MPSC mode the claim is final: the producer must fill and end all of it,
+ * or the consumer waits at the first unpublished record.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_begin_write(vv_dsp_ring* ring, size_t max_records,
+                                                      vv_dsp_ring_region* out);
+
+/**
+ * @brief Producer: publish the first region->count records of a region from
+ *        vv_dsp_ring_begin_write()
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE if count exceeds the claim (or, in
+ *         MPSC mode, differs from it)
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_end_write(vv_dsp_ring* ring, const vv_dsp_ring_region* region);
+
+/**
+ * @brief Consumer: the next up to max_records contiguous readable records, in place
+ * @param out Region; count 0 when nothing is readable
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_begin_read(vv_dsp_ring* ring, size_t max_records,
+                                                     vv_dsp_ring_region* out);
+
+/**
+ * @brief Consumer: release the first region->count records of a region from
+ *        vv_dsp_ring_begin_read(); the rest stay queued
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE if count exceeds the region
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_end_read(vv_dsp_ring* ring, const vv_dsp_ring_region* region);
+
+/**
+ * @brief Producer: copy count records in
+ * @param out_written Records written. SPSC writes as many as fit; MPSC writes all
+ *        count records or none, so batches of different producers never interleave.
+ * @return VV_DSP_OK, VV_DSP_ERROR_INVALID_SIZE for an MPSC batch larger than the capacity
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_write(vv_dsp_ring* ring, const void* records, size_t count,
+                                                size_t* out_written);
+
+/**
+ * @brief Consumer: copy up to max_records readable records out
+ * @param out_read Records read
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_ring_read(vv_dsp_ring* ring, void* records, size_t max_records,
+                                               size_t* out_read);
+
+/** @brief Drop every queued record; no other thread may be using the ring */
+void vv_dsp_ring_reset(vv_dsp_ring* ring);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_RING_H */
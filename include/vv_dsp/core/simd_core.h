@@ -109,6 +109,85 @@ vv_dsp_status vv_dsp_stddev_optimized(const vv_dsp_real* x, size_t n, vv_dsp_rea
  */
 vv_dsp_status vv_dsp_population_stddev_optimized(const vv_dsp_real* x, size_t n, vv_dsp_real* out);
 
+/**
+ * @brief Summation order of the reductions (sum, mean, variance, RMS, stddev and the
+ *        FFT path of the correlation functions)
+ *
+ * Every mode gives the same bits at every SIMD level. FAST runs one pass of 16 lane
+ * sums, so its error grows with n. PAIRWISE cuts the input into fixed blocks of
+ * VV_DSP_REDUCTION_BLOCK samples, sums each block as FAST does and adds the block
+ * sums in a fixed pairwise tree, which bounds the error by the block length and
+ * the tree depth. COMPENSATED sums the blocks with Kahan lanes and carries the
+ * rounding error of every tree node as well, for about half the throughput. The blocks and the tree depend only on n, so the
+ * _parallel reductions return exactly the serial result for any thread count, and
+ * the correlation functions run their transforms on single-threaded KissFFT plans.
+ */
+typedef enum vv_dsp_reduction_mode {
+    VV_DSP_REDUCTION_FAST = 0,        /**< 16 lane sums (default) */
+    VV_DSP_REDUCTION_PAIRWISE = 1,    /**< Fixed blocks, fixed pairwise tree of block sums */
+    VV_DSP_REDUCTION_COMPENSATED = 2  /**< PAIRWISE with a compensated tree */
+} vv_dsp_reduction_mode;
+
+/** @brief Samples per leaf of the PAIRWISE / COMPENSATED tree */
+#define VV_DSP_REDUCTION_BLOCK 4096
+
+/**
+ * @brief Select the process-wide reduction mode
+ * @return VV_DSP_OK, or VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode
+ */
+vv_dsp_status vv_dsp_set_reduction_mode(vv_dsp_reduction_mode mode);
+
+/** @brief Current reduction mode */
+vv_dsp_reduction_mode vv_dsp_get_reduction_mode(void);
+
+/**
+ * @brief vv_dsp_sum_optimized() with the blocks spread over the default thread pool
+ * @param num_threads Workers, 0 for the pool's size
+ *
+ * Always sums in the PAIRWISE tree (COMPENSATED when that mode is set), so the
+ * result does not depend on num_threads and equals vv_dsp_sum_optimized() in
+ * those two modes.
+ */
+vv_dsp_status vv_dsp_sum_parallel(const vv_dsp_real* x, size_t n, vv_dsp_real* out, size_t num_threads);
+
+/**
+ * @brief vv_dsp_variance_optimized() (unbiased) on the thread pool; see vv_dsp_sum_parallel()
+ */
+vv_dsp_status vv_dsp_variance_parallel(const vv_dsp_real* x, size_t n, vv_dsp_real* out, size_t num_threads);
+
+/**
+ * @brief Branch-free natural logarithm approximation (auto-vectorizable)
+ *
+ * Splits each input into exponent and a mantissa in [sqrt(1/2), sqrt(2)) and
+ * evaluates a degree-9 odd series in s = (m - 1) / (m + 1) in single precision.
+ * For finite inputs >= FLT_MIN the abs error stays below (|ln x| + 1) * 6e-8,
+ * i.e. about half a float ulp of the result (5.7e-8 on [0.5, 2), 3.9e-6 near
+ * FLT_MIN). Smaller inputs, including 0 and negatives, are clamped to FLT_MIN
+ * (ln = -87.34); Inf and NaN give unspecified results.
+ * @param x Input array
+ * @param out Output array (can be same as x)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code on failure
+ */
+vv_dsp_status vv_dsp_log_real_fast(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+
+/**
+ * @brief Branch-free exponential approximation (auto-vectorizable)
+ *
+ * Reduces x = k ln2 + r with |r| <= ln2/2, evaluates a degree-7 Taylor series
+ * for e^r in single precision and scales by 2^k through the exponent bits.
+ * Relative error stays below 1.1e-7 (about one float ulp). Inputs are clamped
+ * to [-87.33654, 88.72283] first, so results stay within [FLT_MIN, FLT_MAX]:
+ * very negative inputs give FLT_MIN rather than 0 and no Inf is produced.
+ * The clamp is done on the ordered integer image of each float so the loop
+ * has no control flow; NaN gives unspecified results.
+ * @param x Input array
+ * @param out Output array (can be same as x)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code on failure
+ */
+vv_dsp_status vv_dsp_exp_real_fast(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -156,6 +156,7 @@ typedef float64x2_t vv_dsp_simd_f64x2;  ///< 2 double-precision floats (NEON)
  *
  * @note The returned pointer must be freed with vv_dsp_aligned_free()
  * @note Alignment must be a power of 2 and >= sizeof(void*)
+ * @note The block comes from vv_dsp_malloc(), so it follows vv_dsp_set_allocator()
  */
 void* vv_dsp_aligned_malloc(size_t size, size_t alignment);
 
@@ -165,6 +166,47 @@ void* vv_dsp_aligned_malloc(size_t size, size_t alignment);
  */
 void vv_dsp_aligned_free(void* ptr);
 
+/**
+ * @brief Counters of the aligned-block pool
+ */
+typedef struct vv_dsp_aligned_pool_stats {
+    size_t hits;           /**< Allocations served from a thread cache */
+    size_t misses;         /**< Pooled-size allocations that went to the allocator */
+    size_t cached;         /**< Frees kept in a thread cache */
+    size_t released;       /**< Frees of pooled blocks passed on because the cache was full or the pool off */
+    size_t cached_blocks;  /**< Blocks held by all thread caches */
+    size_t cached_bytes;   /**< Bytes held by all thread caches */
+} vv_dsp_aligned_pool_stats;
+
+/**
+ * @brief Turn the thread-caching pool behind vv_dsp_aligned_malloc() on or off
+ * @param max_bytes_per_thread Bytes each thread may keep cached; 0 turns the pool off (default)
+ * @return VV_DSP_OK
+ *
+ * @details With the pool on, requests of up to 1 MiB with alignment up to 64
+ * are rounded up to a power-of-two size class (64 B and up) and freed blocks
+ * are kept in a per-thread free list for the next request of the same class,
+ * up to max_bytes_per_thread; blocks beyond that go back to the allocator.
+ * A block may be freed on any thread. Turning the pool off stops caching;
+ * blocks already cached are released by vv_dsp_aligned_pool_trim() or when
+ * their thread exits.
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_aligned_pool_enable(size_t max_bytes_per_thread);
+
+/**
+ * @brief Release every block cached by the calling thread
+ */
+void vv_dsp_aligned_pool_trim(void);
+
+/**
+ * @brief Read the pool counters
+ * @param out Destination
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_aligned_pool_get_stats(vv_dsp_aligned_pool_stats* out);
+
 /**
  * @brief Allocate aligned memory using default SIMD alignment
  * @param size Number of bytes to allocate
@@ -289,13 +331,57 @@ VV_DSP_SIMD_FORCE_INLINE int vv_dsp_is_simd_aligned(const void* ptr) {
 #endif
 
 /**
- * @brief Get a human-readable string describing available SIMD features
- * @return Static string describing SIMD capabilities
+ * @brief Get a human-readable string describing the active SIMD level
+ * @return Static string naming the level the dispatched kernels run at
+ *         ("Scalar", "SSE2", "NEON", "AVX2" or "AVX512F")
  */
 const char* vv_dsp_simd_get_features(void);
 
 /**@}*/
 
+/** @name Runtime Dispatch */
+/**@{*/
+
+/**
+ * @brief Instruction-set levels of the runtime-dispatched kernels
+ *
+ * The core vector kernels (vv_dsp_add_real_simd(), vv_dsp_sum_optimized(),
+ * vv_dsp_log_real_fast(), ...) are compiled once per level in separate translation
+ * units and selected at first use from cpuid / HWCAP, so one binary built for the
+ * baseline ISA runs them at the host's best level. Every level produces bit-identical
+ * results (reductions use a fixed lane order and the variants are compiled without
+ * FMA contraction), except vv_dsp_vectorized_complex_multiply(), which may be fused
+ * at the AVX levels.
+ */
+typedef enum vv_dsp_simd_level {
+    VV_DSP_SIMD_LEVEL_SCALAR = 0,
+    VV_DSP_SIMD_LEVEL_SSE2 = 1,    ///< x86-64 baseline
+    VV_DSP_SIMD_LEVEL_NEON = 2,    ///< AArch64 baseline, or 32-bit ARM with NEON
+    VV_DSP_SIMD_LEVEL_AVX2 = 3,    ///< AVX2 + FMA
+    VV_DSP_SIMD_LEVEL_AVX512 = 4   ///< AVX-512F
+} vv_dsp_simd_level;
+
+/**
+ * @brief Best level both this build and the host CPU (and OS register state) support
+ */
+vv_dsp_simd_level vv_dsp_simd_detect_level(void);
+
+/**
+ * @brief Level the dispatched kernels currently run at (detected on first use)
+ */
+vv_dsp_simd_level vv_dsp_simd_get_level(void);
+
+/**
+ * @brief Force the dispatch level, e.g. to cap it fleet-wide or to compare levels
+ * @param level Level to run at; the build's baseline level is always available
+ * @return VV_DSP_ERROR_UNSUPPORTED if the level is above vv_dsp_simd_detect_level()
+ *         or has no variant in this build; the active level is then unchanged
+ * @note Not meant to race with kernels running on other threads
+ */
+vv_dsp_status vv_dsp_simd_set_level(vv_dsp_simd_level level);
+
+/**@}*/
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+/**
+ * @file split_complex.h
+ * @brief Split-complex (structure-of-arrays) buffers and kernels
+ * @ingroup core_group
+ *
+ * A split-complex buffer keeps the real and imaginary parts in two separate
+ * arrays instead of interleaving them as vv_dsp_cpx. Element-wise stages
+ * (products, magnitudes, power, real-valued masks) then map directly onto
+ * SIMD lanes without shuffles. The layout converters below move data between
+ * the two representations; vv_dsp_fft_execute_split() produces and consumes
+ * split buffers directly.
+ */
+
+#ifndef VV_DSP_CORE_SPLIT_COMPLEX_H
+#define VV_DSP_CORE_SPLIT_COMPLEX_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/**
+ * @brief Split-complex buffer: n real parts followed by n imaginary parts
+ * @details The two arrays never alias. Buffers from vv_dsp_split_alloc() are
+ * SIMD-aligned; any pair of caller arrays is accepted by the kernels.
+ */
+typedef struct vv_dsp_split_cpx {
+    vv_dsp_real* re; /**< Real parts */
+    vv_dsp_real* im; /**< Imaginary parts */
+} vv_dsp_split_cpx;
+
+/**
+ * @brief Allocate a SIMD-aligned split-complex buffer of n elements
+ * @param n Number of complex elements (must be > 0)
+ * @param out Destination; both pointers are set on success, NULL on failure
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_alloc(size_t n, vv_dsp_split_cpx* out);
+
+/**
+ * @brief Free a buffer from vv_dsp_split_alloc() and reset its pointers
+ * @param buf Buffer to free (NULL or already-freed buffers are ignored)
+ */
+void vv_dsp_split_free(vv_dsp_split_cpx* buf);
+
+/**
+ * @brief Convert interleaved complex samples to split layout
+ * @param in Interleaved input (n elements)
+ * @param re Real parts output (n elements)
+ * @param im Imaginary parts output (n elements)
+ * @param n Number of complex elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cpx_to_split(const vv_dsp_cpx* in,
+                                                   vv_dsp_real* re,
+                                                   vv_dsp_real* im,
+                                                   size_t n);
+
+/**
+ * @brief Convert split-complex samples to interleaved layout
+ * @param re Real parts (n elements)
+ * @param im Imaginary parts (n elements)
+ * @param out Interleaved output (n elements)
+ * @param n Number of complex elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_to_cpx(const vv_dsp_real* re,
+                                                   const vv_dsp_real* im,
+                                                   vv_dsp_cpx* out,
+                                                   size_t n);
+
+/**
+ * @brief Pointwise complex product of split buffers: out = a * b
+ * @details Outputs may alias either input element-for-element (in-place).
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_complex_multiply(const vv_dsp_real* a_re,
+                                                             const vv_dsp_real* a_im,
+                                                             const vv_dsp_real* b_re,
+                                                             const vv_dsp_real* b_im,
+                                                             vv_dsp_real* out_re,
+                                                             vv_dsp_real* out_im,
+                                                             size_t n);
+
+/**
+ * @brief Magnitude |z| of each split-complex element
+ * @param re Real parts
+ * @param im Imaginary parts
+ * @param out Magnitudes (may alias re or im)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_magnitude(const vv_dsp_real* re,
+                                                      const vv_dsp_real* im,
+                                                      vv_dsp_real* out,
+                                                      size_t n);
+
+/**
+ * @brief Power |z|^2 of each split-complex element
+ * @param re Real parts
+ * @param im Imaginary parts
+ * @param out Powers (may alias re or im)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_power(const vv_dsp_real* re,
+                                                  const vv_dsp_real* im,
+                                                  vv_dsp_real* out,
+                                                  size_t n);
+
+/**
+ * @brief Scale each element by a real gain in place: z[i] *= mask[i]
+ * @param re Real parts (modified)
+ * @param im Imaginary parts (modified)
+ * @param mask Real gains, e.g. a spectral mask
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_apply_mask(vv_dsp_real* re,
+                                                       vv_dsp_real* im,
+                                                       const vv_dsp_real* mask,
+                                                       size_t n);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_SPLIT_COMPLEX_H */
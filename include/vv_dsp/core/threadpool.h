@@ -0,0 +1,130 @@
+/**
+ * @file threadpool.h
+ * @brief Work-stealing thread pool shared by the parallel batch APIs
+ * @ingroup core_group
+ *
+ * A pool runs one job at a time over num_threads workers: worker 0 is the
+ * calling thread, the others are pool threads parked between jobs. A parallel
+ * for splits its index range evenly into one range deque per worker; a worker
+ * takes grain-sized chunks from the front of its own range and, once that is
+ * empty, steals the back half of a busy worker's range, so uneven chunks
+ * balance without a central queue.
+ *
+ * Every parallel batch function in the library (vv_dsp_stft_spectrogram_parallel(),
+ * vv_dsp_mfcc_process_parallel(), the pitch, LPC, CheapTrick and GCC-PHAT
+ * plans, ...) runs its workers on the default pool, created on first use with
+ * one worker per online processor. A host that already owns threads can wrap
+ * its executor in a pool and make it the default.
+ *
+ * A job started while the pool is busy (from a worker of the running job, or
+ * from another thread) runs inline on the calling thread instead of waiting.
+ */
+
+#ifndef VV_DSP_CORE_THREADPOOL_H
+#define VV_DSP_CORE_THREADPOOL_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** Opaque thread pool */
+typedef struct vv_dsp_threadpool vv_dsp_threadpool;
+
+/** Pool creation parameters (zero-initialize unused fields) */
+typedef struct vv_dsp_threadpool_params {
+    size_t num_threads;  /**< Workers including the caller; 0 = online processors */
+    int pin_threads;     /**< Nonzero: pin pool thread k to one CPU (Linux, Windows) */
+    int numa_aware;      /**< Nonzero: pin node by node and steal within a node first (implies pin_threads) */
+} vv_dsp_threadpool_params;
+
+/**
+ * @brief Host executor: run(user, num_tasks, task, task_ctx) must call task(task_ctx, k)
+ *        once for every k in [0, num_tasks), on any threads in any order, and return
+ *        when all calls have returned
+ */
+typedef struct vv_dsp_executor {
+    void (*run)(void* user, size_t num_tasks, void (*task)(void* task_ctx, size_t k), void* task_ctx);
+    void* user;
+    size_t concurrency;  /**< Tasks the executor runs at once (at least 1) */
+} vv_dsp_executor;
+
+/** Chunk [begin, end) of a parallel for, run by worker (< vv_dsp_threadpool_num_threads()) */
+typedef void (*vv_dsp_range_fn)(void* ctx, size_t begin, size_t end, size_t worker);
+
+/** Task k of a fork-join run */
+typedef void (*vv_dsp_task_fn)(void* ctx, size_t task);
+
+/**
+ * @brief Create a pool and start its threads
+ * @param params Parameters, NULL for the defaults
+ * @param out Destination; NULL on failure
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if a thread cannot be started
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_threadpool_create(const vv_dsp_threadpool_params* params,
+                                                        vv_dsp_threadpool** out);
+
+/**
+ * @brief Create a pool that runs its workers as tasks of a host executor; it owns no threads
+ * @param executor Executor, copied (run must be set)
+ * @param out Destination; NULL on failure
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_threadpool_create_with_executor(const vv_dsp_executor* executor,
+                                                                      vv_dsp_threadpool** out);
+
+/**
+ * @brief Stop and join the pool's threads and free it (NULL is ignored). The pool must
+ *        be idle and must not be the default pool.
+ */
+void vv_dsp_threadpool_destroy(vv_dsp_threadpool* pool);
+
+/** @brief Workers of a pool, the caller included (0 for NULL) */
+size_t vv_dsp_threadpool_num_threads(const vv_dsp_threadpool* pool);
+
+/**
+ * @brief Run fn over [0, count) in chunks of at most grain indices and return when
+ *        every chunk is done
+ * @param pool Pool, NULL for the default pool
+ * @param grain Largest chunk a worker takes at once (0 = 1)
+ * @return VV_DSP_OK, VV_DSP_ERROR_NULL_POINTER without fn, VV_DSP_ERROR_INTERNAL if the
+ *         default pool cannot be created
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_threadpool_parallel_for(vv_dsp_threadpool* pool, size_t count,
+                                                              size_t grain, vv_dsp_range_fn fn, void* ctx);
+
+/**
+ * @brief Fork-join: run fn(ctx, k) for k in [0, num_tasks), each task once, spread
+ *        over the pool's workers (tasks must not wait for each other)
+ * @param pool Pool, NULL for the default pool
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_threadpool_run(vv_dsp_threadpool* pool, size_t num_tasks,
+                                                     vv_dsp_task_fn fn, void* ctx);
+
+/**
+ * @brief The default pool, created on first use from the default parameters
+ * @return The pool, NULL if it cannot be created
+ * @note Thread-safe
+ */
+vv_dsp_threadpool* vv_dsp_threadpool_get_default(void);
+
+/**
+ * @brief Make pool the default for every later parallel call; NULL restores the
+ *        library's own pool. The caller keeps ownership and must not destroy the pool
+ *        while it is the default or while a call started on it is running.
+ * @note Thread-safe
+ */
+void vv_dsp_threadpool_set_default(vv_dsp_threadpool* pool);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_CORE_THREADPOOL_H
@@ -0,0 +1,69 @@
+/**
+ * @file typed.h
+ * @brief Explicit float / double sample types next to vv_dsp_real
+ * @ingroup core_group
+ *
+ * vv_dsp_real is fixed by VV_DSP_USE_DOUBLE at build time. The entry points of
+ * FFT, STFT, FIR, biquad cascade and MFCC also come as _f32 and _f64 variants that
+ * take float or double sample buffers in every build, as a convenience for callers
+ * whose data is in the other precision.
+ *
+ * The variant matching the build (_f32 in float builds, _f64 in double builds)
+ * is the vv_dsp_real entry point itself: same kernels, no copy, no allocation.
+ * The other variant is a conversion wrapper, not a second set of kernels: it
+ * converts its input to vv_dsp_real, runs the build's kernels and converts the
+ * result back, so it costs the conversions on top of the vv_dsp_real call and
+ * carries the build's rounding. FIR and biquad convert in fixed-size stack
+ * blocks. FFT, STFT and MFCC convert whole buffers through scratch drawn from a
+ * caller's arena (NULL = heap) and released before returning; their
+ * *_typed_scratch_size() functions give the bytes. Plans, filter states, coefficients and filterbanks stay in vv_dsp_real.
+ */
+
+#ifndef VV_DSP_CORE_TYPED_H
+#define VV_DSP_CORE_TYPED_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/** @brief Complex single-precision sample, laid out like vv_dsp_cpx */
+typedef struct vv_dsp_cpx_f32 {
+    float re;
+    float im;
+} vv_dsp_cpx_f32;
+
+/** @brief Complex double-precision sample, laid out like vv_dsp_cpx */
+typedef struct vv_dsp_cpx_f64 {
+    double re;
+    double im;
+} vv_dsp_cpx_f64;
+
+/**
+ * @brief Convert real samples to float (rounded to nearest in double builds)
+ * @return VV_DSP_OK, or VV_DSP_ERROR_NULL_POINTER for NULL buffers with n > 0
+ */
+vv_dsp_status vv_dsp_real_to_f32(const vv_dsp_real* in, float* out, size_t n);
+
+/** @brief Convert float samples to real */
+vv_dsp_status vv_dsp_f32_to_real(const float* in, vv_dsp_real* out, size_t n);
+
+/** @brief Convert real samples to double */
+vv_dsp_status vv_dsp_real_to_f64(const vv_dsp_real* in, double* out, size_t n);
+
+/** @brief Convert double samples to real (rounded to nearest in float builds) */
+vv_dsp_status vv_dsp_f64_to_real(const double* in, vv_dsp_real* out, size_t n);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_TYPED_H */
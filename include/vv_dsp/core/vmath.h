@@ -0,0 +1,157 @@
+/**
+ * @file vmath.h
+ * @brief Vectorized transcendental functions with accuracy tiers
+ * @ingroup core_group
+ *
+ * Array versions of sin, cos, exp, log, atan2 and sqrt. Each call picks an
+ * accuracy tier: the fast and medium tiers run branch-free single-precision
+ * kernels through the runtime dispatch table, so they vectorize at the host's
+ * best SIMD level; the exact tier loops over libm in vv_dsp_real precision.
+ * The fast and medium tiers compute in single precision in double builds too,
+ * so pick VV_DSP_VMATH_EXACT where a double build needs double accuracy.
+ * Phase wrapping and unwrapping are dispatched too, in vv_dsp_real precision.
+ * Outputs may alias inputs.
+ */
+
+#ifndef VV_DSP_CORE_VMATH_H
+#define VV_DSP_CORE_VMATH_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup core_group
+ * @{
+ */
+
+/**
+ * @brief Accuracy tier of the vmath functions
+ */
+typedef enum vv_dsp_vmath_tier {
+    VV_DSP_VMATH_FAST = 0,   /**< Short polynomials, about 1e-4 (abs or relative, see each function) */
+    VV_DSP_VMATH_MEDIUM = 1, /**< Within a few float ulp */
+    VV_DSP_VMATH_EXACT = 2   /**< libm in vv_dsp_real precision */
+} vv_dsp_vmath_tier;
+
+/**
+ * @brief Sine of each element
+ * @details Fast: abs error below 5e-5. Medium: within 2 ulp. |x| > 8192, Inf
+ * and NaN take libm in both.
+ * @param x Input array
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vsin(const vv_dsp_real* x, vv_dsp_real* y, size_t n,
+                                           vv_dsp_vmath_tier tier);
+
+/**
+ * @brief Cosine of each element (errors as vv_dsp_vsin())
+ * @param x Input array
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vcos(const vv_dsp_real* x, vv_dsp_real* y, size_t n,
+                                           vv_dsp_vmath_tier tier);
+
+/**
+ * @brief Sine and cosine of each element in one pass (errors as vv_dsp_vsin())
+ * @param x Input array
+ * @param s Sines (may alias x)
+ * @param c Cosines (may alias x, not s)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vsincos(const vv_dsp_real* x, vv_dsp_real* s, vv_dsp_real* c,
+                                              size_t n, vv_dsp_vmath_tier tier);
+
+/**
+ * @brief e^x of each element
+ * @details Fast: relative error below 6e-5. Medium: about one float ulp. Both
+ * clamp x to [-87.33654, 88.72283], so results stay within [FLT_MIN, FLT_MAX];
+ * NaN gives unspecified results.
+ * @param x Input array
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vexp(const vv_dsp_real* x, vv_dsp_real* y, size_t n,
+                                           vv_dsp_vmath_tier tier);
+
+/**
+ * @brief Natural logarithm of each element
+ * @details Fast: abs error below 7e-5. Medium: abs error below
+ * (|ln x| + 1) * 6e-8, about half a float ulp. Both clamp inputs below FLT_MIN,
+ * including 0 and negatives, to FLT_MIN (ln = -87.34); Inf and NaN give
+ * unspecified results.
+ * @param x Input array
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vlog(const vv_dsp_real* x, vv_dsp_real* y, size_t n,
+                                           vv_dsp_vmath_tier tier);
+
+/**
+ * @brief Four-quadrant arctangent atan2(y[i], x[i]) of each element pair
+ * @details Fast: abs error below 1.2e-5. Medium: within 3 ulp. Signed zeros
+ * follow C99 atan2 (atan2(+-0, -0) = +-pi); Inf and NaN take libm.
+ * @param y Ordinates
+ * @param x Abscissas
+ * @param out Angles in [-pi, pi] (may alias y or x)
+ * @param n Number of elements
+ * @param tier Accuracy tier
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vatan2(const vv_dsp_real* y, const vv_dsp_real* x, vv_dsp_real* out,
+                                             size_t n, vv_dsp_vmath_tier tier);
+
+/**
+ * @brief Square root of each element, correctly rounded in vv_dsp_real
+ * @param x Input array
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vsqrt(const vv_dsp_real* x, vv_dsp_real* y, size_t n);
+
+/**
+ * @brief Each phase wrapped to (-pi, pi]
+ * @details Branch-free and exact to a few ulp of the result for |x| up to
+ * 2^15 turns; larger values go through fmod. Inf and NaN give NaN.
+ * @param x Input phases (radians)
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vphase_wrap(const vv_dsp_real* x, vv_dsp_real* y, size_t n);
+
+/**
+ * @brief Unwrap a phase sequence
+ * @details y[0] = x[0] and y[i] = x[i] + 2 pi K[i], where K is the running sum of
+ * one turn down for every step x[i] - x[i-1] above pi and one turn up for every
+ * step below -pi. The turn counts come from a prefix sum, so the vectorized step
+ * and add passes carry no floating-point dependency.
+ * @param x Wrapped phases (radians)
+ * @param y Output array (may alias x)
+ * @param n Number of elements
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vphase_unwrap(const vv_dsp_real* x, vv_dsp_real* y, size_t n);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_CORE_VMATH_H */
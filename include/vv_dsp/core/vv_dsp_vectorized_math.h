@@ -1,11 +1,12 @@
 /**
  * @file vv_dsp_vectorized_math.h
- * @brief Vectorized math operations using Eigen library
+ * @brief Vectorized math operations on the runtime-dispatched core kernels
  * @ingroup core_group
  *
- * This module provides high-performance vectorized implementations of common
- * DSP math operations using the Eigen library when available. These functions
- * are designed to replace element-wise loops with SIMD-optimized operations.
+ * Vectorized implementations of common DSP math operations, designed to replace
+ * element-wise loops. They are plain C99 built per instruction set and selected
+ * at run time (see vv_dsp_simd_get_level()), so no C++ or Eigen dependency is
+ * involved.
  */
 
 #ifndef VV_DSP_VECTORIZED_MATH_H
@@ -31,9 +32,8 @@ extern "C" {
  * @param n Length of buffers
  * @return VV_DSP_OK on success, error code otherwise
  *
- * @details This function performs element-wise multiplication of input signal
- * with window coefficients using vectorized operations when Eigen is available,
- * falling back to scalar implementation otherwise.
+ * @details Element-wise multiplication of the input signal with the window
+ * coefficients.
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_window_apply(
     const vv_dsp_real* in,
@@ -51,8 +51,9 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_window_apply(
  * @param n Number of complex samples
  * @return VV_DSP_OK on success, error code otherwise
  *
- * @details Performs result[i] = a[i] * b[i] for complex numbers using
- * vectorized operations when available.
+ * @details Performs result[i] = a[i] * b[i] for complex numbers. At the AVX2
+ * and AVX-512 levels the compiler may fuse the products (vfmaddsub), so results
+ * can differ from the scalar product in the last bit.
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_complex_multiply(
     const vv_dsp_cpx* a,
@@ -70,8 +71,10 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_complex_multiply(
  * @param func_type Function type: 0=sin, 1=cos, 2=tan
  * @return VV_DSP_OK on success, error code otherwise
  *
- * @details Applies trigonometric functions element-wise using vectorized
- * operations when available, with math approximation support.
+ * @details In single precision, |x| <= 8192 is reduced by pi/2 in double and
+ * evaluated with minimax polynomials: sin and cos stay within 2 ulp of the exact
+ * result (about 1e-7 absolute), tan within 4 ulp. Larger inputs, Inf and NaN go
+ * through libm. Double builds use libm throughout.
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_trig_apply(
     const vv_dsp_real* in,
@@ -83,7 +86,7 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_trig_apply(
 /**
  * @brief Check if vectorized math operations are available
  *
- * @return 1 if Eigen vectorization is available, 0 otherwise
+ * @return 1 if the dispatched kernels run above the scalar level, 0 otherwise
  */
 int vv_dsp_vectorized_math_available(void);
 
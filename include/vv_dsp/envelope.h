@@ -24,6 +24,7 @@ extern "C" {
  * - **Cepstral Analysis**: Real cepstrum for envelope separation
  * - **Minimum-Phase Processing**: Signal reconstruction from envelope
  * - **Linear Predictive Coding (LPC)**: Parametric spectral envelope modeling
+ * - **CheapTrick**: F0-adaptive spectral envelope for vocoder analysis
  *
  * These techniques are fundamental in speech processing, audio analysis,
  * and system identification applications.
@@ -34,6 +35,7 @@ extern "C" {
 #include "vv_dsp/envelope/cepstrum.h"  ///< Real cepstrum analysis
 #include "vv_dsp/envelope/minphase.h"  ///< Minimum-phase signal reconstruction
 #include "vv_dsp/envelope/lpc.h"       ///< Linear Predictive Coding
+#include "vv_dsp/envelope/cheaptrick.h" ///< Pitch-adaptive spectral envelope
 
 /**
  * @brief Dummy function for basic envelope module testing
@@ -7,15 +7,59 @@ extern "C" {
 
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/arena.h"
 
 // Compute real cepstrum from real signal of length n using spectral log magnitude
-// out_cep length n (same length), simple naive implementation
+// out_cep length n (same length); one-shot wrapper around vv_dsp_cepstrum_plan
 vv_dsp_status vv_dsp_cepstrum_real(const vv_dsp_real* x, size_t n, vv_dsp_real* out_cep);
 
 // Inverse real cepstrum (minimum phase reconstruction) from cepstrum array
-// Writes a min-phase time-domain signal approximation into out_x (length n)
+// Writes a min-phase time-domain signal approximation into out_x (length n);
+// one-shot wrapper around vv_dsp_cepstrum_plan
 vv_dsp_status vv_dsp_icepstrum_minphase(const vv_dsp_real* c, size_t n, vv_dsp_real* out_x);
 
+// The two above with the plan drawn from arena (NULL = heap) and released before
+// returning; each needs vv_dsp_cepstrum_scratch_size(n) bytes of it
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_real_ex(const vv_dsp_real* x, size_t n, vv_dsp_real* out_cep,
+                                                       vv_dsp_arena* arena);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_icepstrum_minphase_ex(const vv_dsp_real* c, size_t n, vv_dsp_real* out_x,
+                                                            vv_dsp_arena* arena);
+size_t vv_dsp_cepstrum_scratch_size(size_t n);
+
+// Reusable cepstrum / minimum-phase plan for frames of length n: holds the R2C and
+// C2R transforms and all scratch, so the batch calls below do not allocate. The
+// log-magnitude and exponential stages run through vv_dsp_log_real_fast and
+// vv_dsp_exp_real_fast (float builds). Frames are contiguous rows of n samples
+// (n/2+1 bins for spectra). A plan serves one call at a time.
+typedef struct vv_dsp_cepstrum_plan vv_dsp_cepstrum_plan;
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_plan_create(size_t n, vv_dsp_cepstrum_plan** out);
+// Plan struct and scratch from arena (NULL = heap); destroy the plan before the
+// arena is reset below them
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_plan_create_ex(size_t n, vv_dsp_arena* arena,
+                                                              vv_dsp_cepstrum_plan** out);
+void vv_dsp_cepstrum_plan_destroy(vv_dsp_cepstrum_plan* plan);
+size_t vv_dsp_cepstrum_plan_size(const vv_dsp_cepstrum_plan* plan);
+
+// Real cepstra of num_frames frames: IFFT(log |FFT(x)|)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_plan_real(vv_dsp_cepstrum_plan* plan,
+                                                          const vv_dsp_real* x,
+                                                          size_t num_frames,
+                                                          vv_dsp_real* out_cep);
+
+// Minimum-phase spectra exp(FFT(fold(c))) from cepstra, n/2+1 bins per frame.
+// fold keeps c[0], doubles c[1..n/2-1] and zeroes the rest.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_plan_minphase_spectrum(vv_dsp_cepstrum_plan* plan,
+                                                                      const vv_dsp_real* c,
+                                                                      size_t num_frames,
+                                                                      vv_dsp_cpx* out_spec);
+
+// Minimum-phase time signals (inverse FFT of the spectra above), n samples per frame
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cepstrum_plan_minphase(vv_dsp_cepstrum_plan* plan,
+                                                             const vv_dsp_real* c,
+                                                             size_t num_frames,
+                                                             vv_dsp_real* out_x);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,58 @@
+#ifndef VV_DSP_ENVELOPE_CHEAPTRICK_H
+#define VV_DSP_ENVELOPE_CHEAPTRICK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Pitch-adaptive spectral envelope after CheapTrick (Morise, 2015): an F0-dependent
+// Hann window of three pitch periods, DC correction, rectangular smoothing over
+// 2/3 F0 and cepstral liftering with the q1 recovery term. One plan keeps per-worker
+// R2C/C2R plans and aligned scratch, so processing does not allocate.
+typedef struct vv_dsp_cheaptrick_plan vv_dsp_cheaptrick_plan;
+
+#define VV_DSP_CHEAPTRICK_DEFAULT_Q1 ((vv_dsp_real)-0.15)
+#define VV_DSP_CHEAPTRICK_DEFAULT_F0_FLOOR ((vv_dsp_real)71.0)
+#define VV_DSP_CHEAPTRICK_UNVOICED_F0 ((vv_dsp_real)500.0)
+
+typedef struct vv_dsp_cheaptrick_params {
+    vv_dsp_real sample_rate;
+    vv_dsp_real f0_floor;  // lowest F0 analysed (lower values are raised to it), 0 = 71 Hz
+    size_t fft_size;       // 0 = 2^(1 + floor(log2(3 * sample_rate / f0_floor)))
+    vv_dsp_real q1;        // spectral recovery weight, VV_DSP_CHEAPTRICK_DEFAULT_Q1 in CheapTrick
+    size_t num_threads;    // pool workers for process, 0 = one per pool thread
+} vv_dsp_cheaptrick_params;
+
+// VV_DSP_ERROR_OUT_OF_RANGE for a non-positive sample rate or f0_floor >= sample_rate / 4,
+// VV_DSP_ERROR_INVALID_SIZE if fft_size cannot hold the longest (f0_floor) window
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cheaptrick_plan_create(const vv_dsp_cheaptrick_params* params,
+                                                             vv_dsp_cheaptrick_plan** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_cheaptrick_plan_destroy(vv_dsp_cheaptrick_plan* plan);
+
+// FFT size in use; each envelope has fft_size / 2 + 1 bins
+size_t vv_dsp_cheaptrick_fft_size(const vv_dsp_cheaptrick_plan* plan);
+
+// Power spectral envelopes for num_frames frames centred on samples 0, hop, 2 hop, ...
+// of x (n samples; reads past either end clamp to the edge sample). f0 holds one value
+// in Hz per frame: values <= 0 mark unvoiced frames, analysed at
+// VV_DSP_CHEAPTRICK_UNVOICED_F0; others are clamped to [f0_floor, sample_rate / 4].
+// Writes num_frames rows of fft_size / 2 + 1 bins. Frames are split into contiguous
+// runs across the plan's workers; one plan serves one call at a time.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cheaptrick_process(vv_dsp_cheaptrick_plan* plan,
+                                                         const vv_dsp_real* x,
+                                                         size_t n,
+                                                         size_t hop,
+                                                         const vv_dsp_real* f0,
+                                                         size_t num_frames,
+                                                         vv_dsp_real* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_ENVELOPE_CHEAPTRICK_H
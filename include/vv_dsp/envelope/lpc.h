@@ -17,9 +17,53 @@ vv_dsp_status vv_dsp_levinson(const vv_dsp_real* r, size_t order, vv_dsp_real* a
 // Compute LPC coefficients and return prediction error
 vv_dsp_status vv_dsp_lpc(const vv_dsp_real* x, size_t n, size_t order, vv_dsp_real* a_out, vv_dsp_real* err_out);
 
-// From LPC coefficients compute magnitude spectrum envelope (simple dense sampling)
+// From LPC coefficients a[0..order] (a[0] taken as 1) compute the envelope
+// gain / |A(e^{j 2 pi k / nfft})| for k = 0..nfft/2, i.e. nfft/2+1 bins, with one
+// cached real FFT of a[] zero-padded to nfft
 vv_dsp_status vv_dsp_lpspec(const vv_dsp_real* a, size_t order, vv_dsp_real gain, size_t nfft, vv_dsp_real* mag_out);
 
+// vv_dsp_lpspec over num_frames rows of order+1 coefficients (as written by
+// vv_dsp_lpc_plan_process), sharing one FFT plan and buffer set. gains holds one
+// gain per frame (NULL = 1). Writes num_frames rows of nfft/2+1 bins.
+vv_dsp_status vv_dsp_lpspec_batch(const vv_dsp_real* a, size_t order, const vv_dsp_real* gains,
+                                  size_t num_frames, size_t nfft, vv_dsp_real* mag_out);
+
+// Batch LPC analysis plan: a fixed order, frame length, optional analysis window and
+// optional per-frame pre-emphasis, with all scratch allocated up front (aligned, one
+// set per worker thread). Each frame runs through the same autocorrelation and
+// Levinson-Durbin recursion as vv_dsp_lpc(), so results match it frame for frame.
+typedef struct vv_dsp_lpc_plan vv_dsp_lpc_plan;
+
+typedef struct vv_dsp_lpc_params {
+    size_t order;               // predictor order (>= 1, < frame_len)
+    size_t frame_len;           // samples per frame
+    const vv_dsp_real* window;  // frame_len taps copied into the plan, NULL = rectangular
+    vv_dsp_real preemphasis;    // y[n] = x[n] - preemphasis * x[n-1] inside each frame, 0 = off
+    size_t num_threads;         // pool workers for process, 0 = one per pool thread
+} vv_dsp_lpc_params;
+
+// VV_DSP_ERROR_INVALID_SIZE for order 0 or order >= frame_len
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lpc_plan_create(const vv_dsp_lpc_params* params,
+                                                      vv_dsp_lpc_plan** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_lpc_plan_destroy(vv_dsp_lpc_plan* plan);
+
+// Analyse num_frames frames starting stride samples apart in x (stride < frame_len
+// reads overlapping frames straight from a signal). Writes num_frames rows of
+// order + 1 coefficients (a[0] = 1) to a_out and, when non-NULL, order reflection
+// coefficients per frame to k_out and the final prediction error to err_out.
+// A frame with zero energy gives a = [1, 0, ...], k = 0 and error 0 instead of
+// failing. Frames are split into runs of at least 32 across the plan's workers; the
+// plan's scratch is reused, so one plan serves one call at a time.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lpc_plan_process(vv_dsp_lpc_plan* plan,
+                                                       const vv_dsp_real* x,
+                                                       size_t num_frames,
+                                                       size_t stride,
+                                                       vv_dsp_real* a_out,
+                                                       vv_dsp_real* k_out,
+                                                       vv_dsp_real* err_out);
+
 #ifdef __cplusplus
 }
 #endif
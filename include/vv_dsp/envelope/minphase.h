@@ -7,12 +7,18 @@ extern "C" {
 
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/arena.h"
 
 // Construct minimum-phase spectrum from real cepstrum using homomorphic processing
 // in: cepstrum c[n]
 // out: complex spectrum H[k] of length n (full complex C2C), consistent with STFT/FFT API
 vv_dsp_status vv_dsp_minphase_from_cepstrum(const vv_dsp_real* c, size_t n, vv_dsp_cpx* out_spec);
 
+// Same with its plan drawn from arena (NULL = heap); needs
+// vv_dsp_cepstrum_scratch_size(n) bytes of it
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_minphase_from_cepstrum_ex(const vv_dsp_real* c, size_t n,
+                                                                vv_dsp_cpx* out_spec, vv_dsp_arena* arena);
+
 #ifdef __cplusplus
 }
 #endif
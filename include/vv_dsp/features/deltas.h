@@ -0,0 +1,85 @@
+#ifndef VV_DSP_FEATURES_DELTAS_H
+#define VV_DSP_FEATURES_DELTAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Regression deltas over a +-N frame window (HTK):
+//   d[t] = sum_{n=1..N} n (c[t+n] - c[t-n]) / (2 sum_{n=1..N} n^2)
+// with the first and last frames repeated past the ends of the sequence.
+// Delta-deltas are the same regression applied to the deltas.
+
+/**
+ * Batch deltas of a num_frames x n_coeffs frame-major matrix into out (same shape).
+ * Each output row is a weighted sum of whole input rows, so the inner loop runs
+ * contiguously over the coefficients and vectorizes. in and out must not overlap.
+ * width (N) must be in 1..64 (VV_DSP_ERROR_OUT_OF_RANGE above).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_compute(const vv_dsp_real* in,
+                                                     size_t num_frames,
+                                                     size_t n_coeffs,
+                                                     size_t width,
+                                                     vv_dsp_real* out);
+
+// Streaming deltas: frames go in one n_coeffs vector at a time and come out stacked
+// as [c | delta] (order 1) or [c | delta | delta-delta] (order 2), order * width
+// frames late. A circular history of 2N+1 frames per order is the only state;
+// process never allocates. The output matches vv_dsp_deltas_compute() on the whole
+// sequence once vv_dsp_deltas_flush() has released the tail.
+typedef struct vv_dsp_deltas vv_dsp_deltas;
+
+/**
+ * Create a streaming delta computer for n_coeffs (>= 1) values per frame, order 1 or
+ * 2 and regression width (N) in 1..64.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_create(size_t n_coeffs,
+                                                    size_t order,
+                                                    size_t width,
+                                                    vv_dsp_deltas** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_deltas_destroy(vv_dsp_deltas* d);
+
+// Values per output frame: n_coeffs * (1 + order)
+size_t vv_dsp_deltas_frame_size(const vv_dsp_deltas* d);
+
+// Frames of delay between an input frame and its output: order * width
+size_t vv_dsp_deltas_latency(const vv_dsp_deltas* d);
+
+// Output frames the next process call with num_frames input frames will write
+size_t vv_dsp_deltas_output_count(const vv_dsp_deltas* d, size_t num_frames);
+
+/**
+ * Consume num_frames input frames (n_coeffs values each) and write the completed
+ * stacked frames to out; *out_frames receives their number. Returns
+ * VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than max_frames
+ * frames would be produced.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_process(vv_dsp_deltas* d,
+                                                     const vv_dsp_real* in,
+                                                     size_t num_frames,
+                                                     vv_dsp_real* out,
+                                                     size_t max_frames,
+                                                     size_t* out_frames);
+
+/**
+ * End of sequence: write the held-back frames (at most the latency) with the last
+ * frame repeated, then reset.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_flush(vv_dsp_deltas* d,
+                                                   vv_dsp_real* out,
+                                                   size_t max_frames,
+                                                   size_t* out_frames);
+
+// Drop the history; the next frame starts a new sequence
+vv_dsp_status vv_dsp_deltas_reset(vv_dsp_deltas* d);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FEATURES_DELTAS_H
@@ -0,0 +1,165 @@
+#ifndef VV_DSP_FEATURES_EXTRACTOR_H
+#define VV_DSP_FEATURES_EXTRACTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/stft.h"
+#include "vv_dsp/features/mel.h"
+#include "vv_dsp/features/deltas.h"
+#include "vv_dsp/features/spectral_features.h"
+
+// Streaming audio-to-features front end: raw PCM blocks in, one feature vector per
+// hop out. Each STFT frame is analysed with a real-input FFT straight out of the
+// streaming ring, turned into a power spectrum, projected onto a sparse mel
+// filterbank and logged (plus DCT and lifter for MFCC) before the next frame is
+// read, so nothing larger than one frame is ever materialized and processing never
+// allocates. Frame f covers stream samples [f*hop_size, f*hop_size + fft_size), as
+// with vv_dsp_stft_push() / vv_dsp_stft_pop_frame(); no padding is added.
+
+// Opaque extractor handle
+typedef struct vv_dsp_feature_extractor vv_dsp_feature_extractor;
+
+// Static feature computed per frame
+typedef enum vv_dsp_feature_kind {
+    VV_DSP_FEATURE_LOG_MEL = 0, // ln(mel energy + log_epsilon), n_mels values
+    VV_DSP_FEATURE_MFCC = 1     // DCT-II of the log-mel energies, num_mfcc_coeffs values
+} vv_dsp_feature_kind;
+
+// Extractor configuration (zero-initialize unused fields)
+typedef struct vv_dsp_feature_params {
+    vv_dsp_real sample_rate;     // Hz
+    size_t fft_size;             // STFT frame size
+    size_t hop_size;             // frame advance
+    vv_dsp_stft_window window;   // analysis window
+    size_t n_mels;               // mel bands (< fft_size/2+1)
+    vv_dsp_real fmin;            // lowest band edge in Hz
+    vv_dsp_real fmax;            // highest band edge in Hz, 0 = sample_rate/2
+    vv_dsp_mel_variant variant;  // mel scale variant
+    vv_dsp_feature_kind kind;
+    size_t num_mfcc_coeffs;      // MFCC only: coefficients kept (<= n_mels)
+    vv_dsp_real lifter_coeff;    // MFCC only: sinusoidal lifter, 0 = off
+    vv_dsp_real log_epsilon;     // added before the log, 0 = 1e-10
+    vv_dsp_log_accuracy log_accuracy; // libm log or the vectorized approximation
+    // Spectral descriptors (vv_dsp_spectral_feature_flags, 0 = none) appended to the
+    // static feature of each frame from the same spectrum; the flatness log follows
+    // log_accuracy. rolloff_percent as in vv_dsp_spectral_features_create().
+    unsigned int spectral_features;
+    vv_dsp_real rolloff_percent;
+    // Regression deltas appended to each frame by a vv_dsp_deltas stage: 0 = none,
+    // 1 = delta, 2 = delta and delta-delta, over +-delta_width frames (0 = 2, at most
+    // 64). Frames then leave delta_order * delta_width STFT frames late;
+    // vv_dsp_feature_extractor_flush() emits the held-back tail.
+    size_t delta_order;
+    size_t delta_width;
+} vv_dsp_feature_params;
+
+/**
+ * Create an extractor. VV_DSP_ERROR_INVALID_SIZE for zero sizes, hop_size > fft_size
+ * or too many mel bands, VV_DSP_ERROR_OUT_OF_RANGE for bad frequencies, kind,
+ * log_accuracy, delta_order, spectral_features or rolloff_percent, and the
+ * vv_dsp_mfcc_init() restrictions for MFCC.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_create(const vv_dsp_feature_params* params,
+                                                               vv_dsp_feature_extractor** out);
+
+// Destroy extractor (NULL is ignored)
+void vv_dsp_feature_extractor_destroy(vv_dsp_feature_extractor* fx);
+
+// Values per output frame: the static feature size (plus the selected spectral
+// descriptors) times (1 + delta_order)
+size_t vv_dsp_feature_extractor_frame_size(const vv_dsp_feature_extractor* fx);
+
+// Output frames the next process call with num_samples samples will write
+size_t vv_dsp_feature_extractor_output_count(const vv_dsp_feature_extractor* fx, size_t num_samples);
+
+/**
+ * Consume num_samples PCM samples of any block size and write every completed
+ * feature frame (frame_size values each, frame-major) to out; *out_frames receives
+ * their number. Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything if more
+ * than max_frames frames would be produced.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_process(vv_dsp_feature_extractor* fx,
+                                                                const vv_dsp_real* pcm,
+                                                                size_t num_samples,
+                                                                vv_dsp_real* out,
+                                                                size_t max_frames,
+                                                                size_t* out_frames);
+
+/**
+ * End of stream: write the frames still held back by the delta window (none when
+ * delta_order is 0), then reset. Writes at most delta_order * delta_width frames.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_flush(vv_dsp_feature_extractor* fx,
+                                                              vv_dsp_real* out,
+                                                              size_t max_frames,
+                                                              size_t* out_frames);
+
+/**
+ * vv_dsp_feature_extractor_process() and _flush() with each frame encoded in a
+ * compact storage type (core/quant.h) as soon as it is complete, so out holds
+ * frame_size * vv_dsp_storage_bytes(quant->type) bytes per frame. Frames stay
+ * bit-identical to the vv_dsp_real calls before encoding. VV_DSP_ERROR_UNSUPPORTED
+ * for an unknown storage type.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_process_quant(vv_dsp_feature_extractor* fx,
+                                                                      const vv_dsp_real* pcm,
+                                                                      size_t num_samples,
+                                                                      const vv_dsp_quant* quant,
+                                                                      void* out,
+                                                                      size_t max_frames,
+                                                                      size_t* out_frames);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_flush_quant(vv_dsp_feature_extractor* fx,
+                                                                    const vv_dsp_quant* quant,
+                                                                    void* out,
+                                                                    size_t max_frames,
+                                                                    size_t* out_frames);
+
+// Drop buffered samples and delta history; the next sample starts frame 0 again
+vv_dsp_status vv_dsp_feature_extractor_reset(vv_dsp_feature_extractor* fx);
+
+// ---------------- Incremental updates after edits ----------------
+// For a signal held in memory whose features were extracted in one pass (process over
+// all n samples, then flush), an edit to a few samples only changes the output frames
+// whose STFT frame overlaps them, the next frame through spectral flux, and
+// delta_order * delta_width frames on either side through the delta window. These
+// two calls find that range and recompute just those frames, so an edit costs work
+// proportional to its length rather than to the signal's.
+
+// Output frames of a one-pass extraction over n samples (with the flushed tail)
+size_t vv_dsp_feature_extractor_total_frames(const vv_dsp_feature_extractor* fx, size_t n);
+
+/**
+ * Output frames of a one-pass extraction over n samples that depend on samples
+ * [first_sample, first_sample + num_samples): *first_frame and *num_frames receive
+ * the range (0 frames when nothing depends on them).
+ */
+vv_dsp_status vv_dsp_feature_extractor_affected_frames(const vv_dsp_feature_extractor* fx,
+                                                       size_t n,
+                                                       size_t first_sample,
+                                                       size_t num_samples,
+                                                       size_t* first_frame,
+                                                       size_t* num_frames);
+
+/**
+ * Recompute output frames [first_frame, first_frame + num_frames) of a one-pass
+ * extraction over signal[0 .. n) into out, bit-identical to the one-pass values.
+ * Only the samples of those frames and of their flux and delta context are read.
+ * Resets the stream before and after. VV_DSP_ERROR_OUT_OF_RANGE for frames past
+ * vv_dsp_feature_extractor_total_frames().
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_recompute(vv_dsp_feature_extractor* fx,
+                                                                  const vv_dsp_real* signal,
+                                                                  size_t n,
+                                                                  size_t first_frame,
+                                                                  size_t num_frames,
+                                                                  vv_dsp_real* out);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FEATURES_EXTRACTOR_H
@@ -8,6 +8,9 @@ extern "C" {
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/spectral/dct.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/precision.h"
+#include "vv_dsp/core/context.h"
 
 // Mel scale variants
 typedef enum vv_dsp_mel_variant {
@@ -68,6 +71,109 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
  */
 void vv_dsp_mel_filterbank_free(vv_dsp_real* filterbank_weights, size_t n_mels);
 
+// --------------- Sparse Mel Filterbank ---------------
+
+/**
+ * Mel filterbank stored as one contiguous span of nonzero weights per band: band m
+ * covers FFT bins start[m] .. start[m] + length[m] - 1 with weights
+ * weights[offset[m] .. offset[m] + length[m] - 1]. Triangles only touch a few bins, so
+ * the projection and the storage shrink by roughly n_fft_bins / (average span).
+ */
+typedef struct vv_dsp_mel_sparse {
+    size_t n_mels;
+    size_t n_fft_bins;
+    size_t* start;           ///< First nonzero bin of each band
+    size_t* length;          ///< Number of bins in each band's span (0 for an empty band)
+    size_t* offset;          ///< Start of each band's span in weights
+    vv_dsp_real* weights;    ///< All spans back to back
+} vv_dsp_mel_sparse;
+
+/**
+ * Create the vv_dsp_mel_filterbank_create() filterbank in sparse form
+ * (same parameters and validation; the weights are identical)
+ * @param out_filterbank Receives the filterbank; free with vv_dsp_mel_sparse_destroy()
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create_sparse(
+    size_t n_fft,
+    size_t n_mels,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    vv_dsp_mel_sparse** out_filterbank
+);
+
+/**
+ * Compress a dense n_mels x n_fft_bins filterbank (each band's span runs from its first
+ * to its last nonzero weight)
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_from_dense(
+    const vv_dsp_real* filterbank_weights,
+    size_t n_mels,
+    size_t n_fft_bins,
+    vv_dsp_mel_sparse** out_filterbank
+);
+
+/**
+ * Free a sparse filterbank (NULL is ignored)
+ */
+void vv_dsp_mel_sparse_destroy(vv_dsp_mel_sparse* filterbank);
+
+// --------------- Shared Filterbank Cache ---------------
+
+/**
+ * Take a reference on the process-wide sparse filterbank for this configuration,
+ * building it on first use (same parameters and validation as
+ * vv_dsp_mel_filterbank_create_sparse()). Every holder of one configuration gets the
+ * same read-only filterbank; MFCC plans share it, and its DCT basis, the same way.
+ * @param out_filterbank Receives the filterbank; release with vv_dsp_mel_sparse_release()
+ * @return VV_DSP_OK on success, error code otherwise
+ * @note Thread-safe
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_acquire(
+    size_t n_fft,
+    size_t n_mels,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    const vv_dsp_mel_sparse** out_filterbank
+);
+
+/**
+ * Drop a reference taken by vv_dsp_mel_sparse_acquire(); the last one frees the
+ * filterbank (NULL is ignored)
+ * @note Thread-safe
+ */
+void vv_dsp_mel_sparse_release(const vv_dsp_mel_sparse* filterbank);
+
+// Snapshot of the shared filterbank cache counters
+typedef struct vv_dsp_mel_cache_stats {
+    size_t hits;     ///< Acquires (including MFCC plan inits) served by a live entry
+    size_t misses;   ///< Acquires that had to build the filterbank
+    size_t entries;  ///< Configurations currently held
+} vv_dsp_mel_cache_stats;
+
+/**
+ * Read the shared filterbank cache counters
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_mel_cache_get_stats(vv_dsp_mel_cache_stats* out);
+
+/**
+ * Project one power spectrum frame (n_fft_bins) onto the bands: out_mel[m] is the
+ * weighted sum over band m's span
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_project(
+    const vv_dsp_mel_sparse* filterbank,
+    const vv_dsp_real* power_frame,
+    vv_dsp_real* out_mel
+);
+
 // --------------- Log-Mel Spectrogram Computation ---------------
 
 /**
@@ -91,6 +197,36 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram(
     vv_dsp_real* out_log_mel_spectrogram
 );
 
+/**
+ * vv_dsp_compute_log_mel_spectrogram() with a sparse filterbank: only the nonzero spans
+ * are multiplied (power_spectrogram frames hold filterbank->n_fft_bins bins)
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram_sparse(
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    const vv_dsp_mel_sparse* filterbank,
+    vv_dsp_real log_epsilon,
+    vv_dsp_real* out_log_mel_spectrogram
+);
+
+/**
+ * vv_dsp_compute_log_mel_spectrogram_sparse() with frames split into cache-sized tiles
+ * across num_threads workers on the default thread pool (0 = one per pool thread).
+ * Rows are written straight into out_log_mel_spectrogram and match the serial call
+ * bit for bit.
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the default pool cannot be created,
+ *         error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram_parallel(
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    const vv_dsp_mel_sparse* filterbank,
+    vv_dsp_real log_epsilon,
+    vv_dsp_real* out_log_mel_spectrogram,
+    size_t num_threads
+);
+
 // --------------- MFCC Computation ---------------
 
 /**
@@ -114,10 +250,36 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
     vv_dsp_real* out_mfcc_coeffs
 );
 
+/**
+ * vv_dsp_mfcc() with its DCT output buffer drawn from arena (NULL = heap) and
+ * released before returning. The DCT plan itself still comes from the heap.
+ * @param arena Workspace arena with vv_dsp_mfcc_scratch_size(num_frames, n_mels) bytes free, or NULL
+ * @return VV_DSP_OK on success, error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_ex(
+    const vv_dsp_real* log_mel_spectrogram,
+    size_t num_frames,
+    size_t n_mels,
+    size_t num_mfcc_coeffs,
+    vv_dsp_dct_type dct_type,
+    vv_dsp_real lifter_coeff,
+    vv_dsp_real* out_mfcc_coeffs,
+    vv_dsp_arena* arena
+);
+
+/**
+ * Arena bytes vv_dsp_mfcc_ex() needs
+ */
+size_t vv_dsp_mfcc_scratch_size(size_t num_frames, size_t n_mels);
+
 // --------------- MFCC Context Management ---------------
 
 /**
  * Initialize MFCC plan/context with pre-computed resources
+ *
+ * The filterbank and DCT basis come from the process-wide cache, so plans with the
+ * same (n_fft, n_mels, sample_rate, fmin, fmax, variant) share one read-only copy
+ * and creating another one is a lookup plus the plan's own small buffers.
  * @param n_fft FFT size
  * @param n_mels Number of Mel filters
  * @param num_mfcc_coeffs Number of MFCC coefficients
@@ -129,7 +291,8 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
  * @param lifter_coeff Liftering coefficient
  * @param log_epsilon Small value for log computation
  * @param out_plan Pointer to created MFCC plan
- * @return VV_DSP_OK on success, error code otherwise
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE for a DCT type other than
+ *         VV_DSP_DCT_II or a negative lifter_coeff / log_epsilon, error code otherwise
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
     size_t n_fft,
@@ -145,8 +308,71 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
     vv_dsp_mfcc_plan** out_plan
 );
 
+/**
+ * vv_dsp_mfcc_init() capturing a context (see core/context.h; NULL = defaults)
+ *
+ * The plan starts in the context's precision mode, applies its NaN policy instead of
+ * the calling thread's (unless VV_DSP_CONTEXT_DEFAULT) and runs
+ * vv_dsp_mfcc_process_parallel() on its pool. The FFT backend is not used.
+ * @return As vv_dsp_mfcc_init(), or VV_DSP_ERROR_OUT_OF_RANGE for an invalid context
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init_ctx(
+    const vv_dsp_context* ctx,
+    size_t n_fft,
+    size_t n_mels,
+    size_t num_mfcc_coeffs,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    vv_dsp_dct_type dct_type,
+    vv_dsp_real lifter_coeff,
+    vv_dsp_real log_epsilon,
+    vv_dsp_mfcc_plan** out_plan
+);
+
+// Logarithm used for the log-mel energies
+typedef enum vv_dsp_log_accuracy {
+    VV_DSP_LOG_ACCURACY_EXACT = 0, // libm log (default)
+    VV_DSP_LOG_ACCURACY_FAST = 1   // vv_dsp_log_real_fast(): about half a float ulp of
+                                   // error, vectorized; energies below FLT_MIN give -87.34
+} vv_dsp_log_accuracy;
+
+/**
+ * Select the logarithm vv_dsp_mfcc_process() applies to the mel energies
+ * @param plan MFCC plan
+ * @param accuracy VV_DSP_LOG_ACCURACY_EXACT or VV_DSP_LOG_ACCURACY_FAST
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE for an unknown accuracy
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_set_log_accuracy(
+    vv_dsp_mfcc_plan* plan,
+    vv_dsp_log_accuracy accuracy
+);
+
+/**
+ * Select the accuracy of the plan's log-mel step (see core/precision.h)
+ *
+ * EXACT (default) takes libm; BALANCED vv_dsp_log_real_fast(), the same as
+ * VV_DSP_LOG_ACCURACY_FAST; FAST the fast vmath log, abs error below 7e-5 on each
+ * log-mel energy. Projection, DCT and lifter are unchanged. Supersedes
+ * vv_dsp_mfcc_set_log_accuracy(), which selects EXACT or BALANCED.
+ * @param plan MFCC plan
+ * @param mode Precision mode
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_set_precision(
+    vv_dsp_mfcc_plan* plan,
+    vv_dsp_precision_mode mode
+);
+
 /**
  * Process power spectrogram through complete MFCC pipeline
+ *
+ * Frames are processed one at a time through scratch owned by the plan, so this
+ * never allocates; results match vv_dsp_compute_log_mel_spectrogram() followed by
+ * vv_dsp_mfcc() to within rounding (and the log error under
+ * VV_DSP_LOG_ACCURACY_FAST). Only the kept DCT rows are evaluated. The
+ * scratch is written on every call: use one plan per thread.
  * @param plan MFCC plan/context
  * @param power_spectrogram Input power spectrogram (num_frames x n_fft_bins)
  * @param num_frames Number of time frames
@@ -160,6 +386,60 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process(
     vv_dsp_real* out_mfcc_coeffs
 );
 
+/**
+ * vv_dsp_mfcc_process() on float or double spectrograms in any build (see core/typed.h)
+ *
+ * The variant of the build's precision is vv_dsp_mfcc_process() and ignores arena.
+ * The other is a convenience wrapper that converts the spectrogram and the
+ * coefficients through scratch from arena (NULL = heap) around the vv_dsp_real call.
+ * For the mel spectrogram itself see vv_dsp_stft_spectrogram_ex_f32() / _f64() with
+ * mel weights.
+ * @param arena Workspace arena with vv_dsp_mfcc_process_typed_scratch_size(plan, num_frames) bytes free, or NULL
+ * @return As vv_dsp_mfcc_process(), or VV_DSP_ERROR_INTERNAL if the scratch cannot be allocated
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f32(
+    const vv_dsp_mfcc_plan* plan,
+    const float* power_spectrogram,
+    size_t num_frames,
+    float* out_mfcc_coeffs,
+    vv_dsp_arena* arena
+);
+
+/** As vv_dsp_mfcc_process_f32() on double buffers */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f64(
+    const vv_dsp_mfcc_plan* plan,
+    const double* power_spectrogram,
+    size_t num_frames,
+    double* out_mfcc_coeffs,
+    vv_dsp_arena* arena
+);
+
+/**
+ * Arena bytes the other-precision variant of vv_dsp_mfcc_process_f32() / _f64() needs
+ */
+size_t vv_dsp_mfcc_process_typed_scratch_size(const vv_dsp_mfcc_plan* plan, size_t num_frames);
+
+/**
+ * vv_dsp_mfcc_process() with frames split into cache-sized tiles across num_threads
+ * workers on the default thread pool (0 = one per pool thread). Each worker has its own scratch
+ * and the plan is only read, so any number of these calls may share one
+ * plan; results match vv_dsp_mfcc_process() bit for bit.
+ * @param plan MFCC plan/context
+ * @param power_spectrogram Input power spectrogram (num_frames x n_fft_bins)
+ * @param num_frames Number of time frames
+ * @param out_mfcc_coeffs Output MFCC coefficients (num_frames x num_mfcc_coeffs)
+ * @param num_threads Workers on the default thread pool, 0 = one per pool thread
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the default pool cannot be created,
+ *         error code otherwise
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_parallel(
+    const vv_dsp_mfcc_plan* plan,
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    vv_dsp_real* out_mfcc_coeffs,
+    size_t num_threads
+);
+
 /**
  * Destroy MFCC plan and free all resources
  * @param plan MFCC plan to destroy
@@ -0,0 +1,103 @@
+#ifndef VV_DSP_FEATURES_ONSET_H
+#define VV_DSP_FEATURES_ONSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/stft.h"
+
+// Onset detector over spectral flux with streaming peak picking. It takes HALF-layout
+// STFT frames (fft_size/2+1 bins), so a caller that already runs an STFT does not run
+// another one. The onset strength o[t] of frame t is the flux descriptor of
+// vv_dsp_spectral_features (0 for the first frame), and a vv_dsp_moving median over
+// the last median_window strengths gives the adaptive threshold. Frame t is an onset
+// when
+//   - o[t] > o[j] for the pre_max frames before it and o[t] >= o[j] for the post_max
+//     frames after it (a local maximum; the first frame of a plateau wins),
+//   - o[t] > delta + multiplier * median(o[t + post_max - median_window + 1 .. t + post_max]),
+//   - and at least min_gap frames follow the previous onset.
+// Frame t is therefore decided when frame t + post_max arrives: the look-ahead, and
+// so the latency, is post_max frames. Onsets are reported as the time of the frame
+// centre, (t * hop_size + fft_size / 2) / sample_rate seconds from the stream start.
+//
+// Processing never allocates. Not thread-safe per detector.
+
+typedef struct vv_dsp_onset vv_dsp_onset;
+
+typedef struct vv_dsp_onset_params {
+    size_t fft_size;              // frame size of the spectra (>= 2)
+    size_t hop_size;              // samples between frames (>= 1)
+    vv_dsp_real sample_rate;      // > 0
+    size_t median_window;         // strengths in the threshold median, 0 = 15
+    vv_dsp_real multiplier;       // weight of the median (> 0), 0 = 1.5
+    vv_dsp_real delta;            // absolute threshold offset (>= 0)
+    size_t pre_max;               // frames before a peak it must exceed, 0 = 3
+    size_t post_max;              // look-ahead frames; 0 = causal peaks
+    size_t min_gap;               // frames from one onset to the next, 0 = 1
+    vv_dsp_stft_window window;    // vv_dsp_onset_detect_batch() analysis window (periodic)
+    size_t num_threads;           // vv_dsp_onset_detect_batch() workers, 0 = one per pool thread
+} vv_dsp_onset_params;
+
+// VV_DSP_ERROR_INVALID_SIZE for fft_size < 2 or no hop; VV_DSP_ERROR_OUT_OF_RANGE for
+// a sample rate that is not positive, a negative multiplier or a negative delta
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_create(const vv_dsp_onset_params* params, vv_dsp_onset** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_onset_destroy(vv_dsp_onset* od);
+
+// Frames between the arrival of a frame and its decision (post_max)
+size_t vv_dsp_onset_latency(const vv_dsp_onset* od);
+
+/**
+ * Feed num_frames HALF spectra (frame-major). strength (may be NULL) receives the
+ * onset strength of each frame; every frame this call decides writes its time in
+ * seconds to onset_times when it is an onset, and *out_onsets (may be NULL) receives
+ * the count. A call decides at most num_frames frames and reports at most one onset
+ * per decided frame; VV_DSP_ERROR_INVALID_SIZE without consuming anything if
+ * max_onsets could be exceeded.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_process(vv_dsp_onset* od,
+                                                    const vv_dsp_cpx* spectra,
+                                                    size_t num_frames,
+                                                    vv_dsp_real* strength,
+                                                    vv_dsp_real* onset_times,
+                                                    size_t max_onsets,
+                                                    size_t* out_onsets);
+
+/**
+ * End of stream: decide the frames still waiting for their look-ahead (at most
+ * post_max) with the frames that exist, as vv_dsp_onset_process() reports onsets.
+ * The detector must be reset before it takes another stream.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_flush(vv_dsp_onset* od,
+                                                  vv_dsp_real* onset_times,
+                                                  size_t max_onsets,
+                                                  size_t* out_onsets);
+
+// Start a new stream at frame 0
+vv_dsp_status vv_dsp_onset_reset(vv_dsp_onset* od);
+
+/**
+ * Batch: detect the onsets of num_signals whole signals, spread over the workers one
+ * signal at a time. Signal i is framed from sample 0 every hop_size samples (frames
+ * that fit completely), analysed by an STFT with params->window and run through a
+ * detector, flush included, so the result equals streaming its frames. Up to
+ * max_onsets[i] times go to onset_times[i] (may be NULL when that is 0) and
+ * num_onsets[i] receives the total found, which may be larger.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_detect_batch(const vv_dsp_onset_params* params,
+                                                         const vv_dsp_real* const* signals,
+                                                         const size_t* lengths,
+                                                         size_t num_signals,
+                                                         vv_dsp_real* const* onset_times,
+                                                         const size_t* max_onsets,
+                                                         size_t* num_onsets);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FEATURES_ONSET_H
@@ -0,0 +1,81 @@
+#ifndef VV_DSP_FEATURES_PITCH_H
+#define VV_DSP_FEATURES_PITCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// YIN pitch tracker (de Cheveigne & Kawahara, 2002). The difference function
+//   d(tau) = sum_{j<W} (x[j] - x[j+tau])^2 = E(0) + E(tau) - 2 r(tau)
+// takes r from one R2C/C2R correlation per frame and the energies from a running sum,
+// so a frame costs O(N log N) instead of O(W tau_max). d is cumulative-mean
+// normalised, the first dip below the threshold (or else the global minimum) is
+// refined by parabolic interpolation, and F0 = sample_rate / tau.
+//
+// Frame t reads the span W + tau_max samples starting at t * hop. Each frame yields
+// an F0 in Hz (0 when unvoiced, as in UTAU .frq files) and a periodicity
+// 1 - d'(tau) in [0, 1]. Batch and streaming modes give identical frames.
+typedef struct vv_dsp_yin vv_dsp_yin;
+
+typedef struct vv_dsp_yin_params {
+    vv_dsp_real sample_rate;
+    vv_dsp_real f0_min;     // lowest F0 searched; tau_max = ceil(sample_rate / f0_min)
+    vv_dsp_real f0_max;     // highest F0 searched; tau_min = floor(sample_rate / f0_max) >= 2
+    size_t window;          // integration window W in samples, 0 = tau_max
+    size_t hop;             // samples between frames, 0 = 256 (.frq spacing)
+    vv_dsp_real threshold;  // absolute threshold on d', 0 = 0.1
+    size_t num_threads;     // workers for vv_dsp_yin_process, 0 = one per pool thread
+} vv_dsp_yin_params;
+
+// VV_DSP_ERROR_OUT_OF_RANGE unless 0 < f0_min < f0_max <= sample_rate / 2
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_create(const vv_dsp_yin_params* params, vv_dsp_yin** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_yin_destroy(vv_dsp_yin* y);
+
+// Samples each frame reads (W + tau_max) and the hop between frames
+size_t vv_dsp_yin_frame_span(const vv_dsp_yin* y);
+size_t vv_dsp_yin_hop(const vv_dsp_yin* y);
+
+// Frames in a signal of n samples: 1 + (n - span) / hop, or 0 if n < span
+size_t vv_dsp_yin_num_frames(const vv_dsp_yin* y, size_t n);
+
+/**
+ * Batch: analyse all vv_dsp_yin_num_frames(n) frames of x, split into contiguous
+ * runs across the workers. periodicity may be NULL. Uses the workers' scratch, so it
+ * must not overlap a streaming call on the same tracker.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_process(vv_dsp_yin* y,
+                                                  const vv_dsp_real* x,
+                                                  size_t n,
+                                                  vv_dsp_real* f0,
+                                                  vv_dsp_real* periodicity);
+
+// Streaming: frames the next push of n samples will complete
+size_t vv_dsp_yin_output_count(const vv_dsp_yin* y, size_t n);
+
+/**
+ * Streaming: append n samples to the internal frame ring and write each frame they
+ * complete to f0 / periodicity (may be NULL); *out_frames receives the number.
+ * Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than
+ * max_frames frames would be produced. Never allocates.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_push(vv_dsp_yin* y,
+                                               const vv_dsp_real* x,
+                                               size_t n,
+                                               vv_dsp_real* f0,
+                                               vv_dsp_real* periodicity,
+                                               size_t max_frames,
+                                               size_t* out_frames);
+
+// Drop buffered samples; the next push starts a new signal at frame 0
+vv_dsp_status vv_dsp_yin_reset(vv_dsp_yin* y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_FEATURES_PITCH_H
@@ -0,0 +1,77 @@
+#ifndef VV_DSP_FEATURES_SPECTRAL_FEATURES_H
+#define VV_DSP_FEATURES_SPECTRAL_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/precision.h"
+
+// Per-frame spectral descriptors of a half spectrum (fft_size/2+1 bins), with
+// m[k] = |X[k]|, p[k] = max(|X[k]|^2, 1e-10) and f[k] = k * sample_rate / fft_size:
+//   centroid   sum f m / sum m (Hz, 0 for a silent frame)
+//   bandwidth  sqrt(sum (f - centroid)^2 m / sum m) (Hz)
+//   rolloff    lowest f[k] with sum_{j<=k} m >= rolloff_percent * sum m (Hz)
+//   flux       sqrt(sum (m - m_prev)^2) against the previous frame (0 for the first)
+//   flatness   exp(mean ln p) / mean p, in (0, 1]
+// The power, magnitude and log stages run as vectorized kernels into preallocated
+// scratch, then a single fused loop accumulates every selected sum and stores the
+// magnitudes for the next frame's flux; rolloff rescans the magnitudes only up to
+// its bin. Processing never allocates.
+
+typedef struct vv_dsp_spectral_features vv_dsp_spectral_features;
+
+// Descriptor selection; values are written in this order, selected ones only
+typedef enum vv_dsp_spectral_feature_flags {
+    VV_DSP_SPECTRAL_CENTROID = 1 << 0,
+    VV_DSP_SPECTRAL_BANDWIDTH = 1 << 1,
+    VV_DSP_SPECTRAL_ROLLOFF = 1 << 2,
+    VV_DSP_SPECTRAL_FLUX = 1 << 3,
+    VV_DSP_SPECTRAL_FLATNESS = 1 << 4,
+    VV_DSP_SPECTRAL_ALL = 0x1F
+} vv_dsp_spectral_feature_flags;
+
+/**
+ * Create a plan for fft_size-point frames (>= 2) at sample_rate Hz computing the
+ * descriptors in the features mask. rolloff_percent in (0, 1], 0 = 0.85. EXACT
+ * precision. VV_DSP_ERROR_INVALID_SIZE for fft_size < 2, VV_DSP_ERROR_OUT_OF_RANGE
+ * for an empty or unknown mask, a sample rate that is not positive or a bad
+ * rolloff_percent.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_create(size_t fft_size,
+                                                               vv_dsp_real sample_rate,
+                                                               unsigned int features,
+                                                               vv_dsp_real rolloff_percent,
+                                                               vv_dsp_spectral_features** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_spectral_features_destroy(vv_dsp_spectral_features* sf);
+
+// Values per frame: the number of selected descriptors
+size_t vv_dsp_spectral_features_count(const vv_dsp_spectral_features* sf);
+
+// Accuracy of the flatness log (see core/precision.h): EXACT takes libm, BALANCED
+// and FAST the vmath tiers. VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_set_precision(vv_dsp_spectral_features* sf,
+                                                                      vv_dsp_precision_mode mode);
+
+/**
+ * Describe num_frames consecutive half spectra (fft_size/2+1 bins each, frame-major)
+ * into out, vv_dsp_spectral_features_count() values per frame. Flux carries over
+ * from the previous call.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_process(vv_dsp_spectral_features* sf,
+                                                                const vv_dsp_cpx* spectra,
+                                                                size_t num_frames,
+                                                                vv_dsp_real* out);
+
+// Forget the previous frame; the next frame's flux is 0 again
+vv_dsp_status vv_dsp_spectral_features_reset(vv_dsp_spectral_features* sf);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FEATURES_SPECTRAL_FEATURES_H
@@ -0,0 +1,83 @@
+#ifndef VV_DSP_FEATURES_VAD_H
+#define VV_DSP_FEATURES_VAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Streaming voice activity detector, cheap enough to gate MFCC, ASR or any other
+// costly stage. Each frame of frame_size samples yields one decision from
+//   - the frame energy (mean square of the input),
+//   - the zero-crossing rate (strict sign changes per sample, as
+//     vv_dsp_zero_crossing_rate()), and
+//   - the energies of four sub-bands around 300, 700, 1500 and 3000 Hz (RBJ
+//     band-passes, Q = 1, bands at or above 0.45 * sample_rate left out), run as one
+//     vv_dsp_biquad_bank over the four bands so each sample advances all of them in
+//     one SIMD step.
+// Every band has a noise floor that drops to the band energy at once, follows it
+// (5% per frame) on non-speech frames and rises at most 3 dB/s on speech frames. A
+// frame is speech when the mean over the bands of max(0, band SNR in dB) exceeds
+// threshold_db (twice that when the zero-crossing rate is above zcr_max, i.e. the
+// frame is noise-like) and its energy exceeds energy_floor_db. The decision stays
+// active for hangover frames after the last speech frame. The first frame only
+// seeds the floors, so a stream should start without speech.
+//
+// Work per sample is constant: the input is broadcast to the bank in short chunks
+// and the energy, crossing and band sums run as straight-line loops over them.
+// Never allocates after create. Not thread-safe per detector.
+
+typedef struct vv_dsp_vad vv_dsp_vad;
+
+typedef struct vv_dsp_vad_params {
+    vv_dsp_real sample_rate;
+    size_t frame_size;            // samples per decision, 0 = 10 ms
+    vv_dsp_real threshold_db;     // mean sub-band SNR of speech (> 0), 0 = 6
+    vv_dsp_real energy_floor_db;  // frames below this mean square (dBFS) are silence, 0 = -60
+    vv_dsp_real zcr_max;          // crossings per sample above which a frame is noise-like, 0 = 0.35
+    size_t hangover;              // frames kept active after the last speech frame, 0 = 15
+} vv_dsp_vad_params;
+
+// VV_DSP_ERROR_OUT_OF_RANGE for a sample rate below 1 kHz, a negative threshold_db,
+// a positive energy_floor_db or a zcr_max outside [0, 1]
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vad_create(const vv_dsp_vad_params* params, vv_dsp_vad** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_vad_destroy(vv_dsp_vad* vad);
+
+// Samples per decision
+size_t vv_dsp_vad_frame_size(const vv_dsp_vad* vad);
+
+/**
+ * Feed n samples. Each frame they complete writes its decision (1 = speech, after
+ * hangover) to flags, which may be NULL; *out_frames (may be NULL) receives the
+ * count. With flags, VV_DSP_ERROR_INVALID_SIZE without consuming anything if more
+ * than max_flags frames would complete.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vad_process(vv_dsp_vad* vad,
+                                                  const vv_dsp_real* x,
+                                                  size_t n,
+                                                  unsigned char* flags,
+                                                  size_t max_flags,
+                                                  size_t* out_frames);
+
+// Decision of the last completed frame (0 before the first)
+int vv_dsp_vad_active(const vv_dsp_vad* vad);
+
+// vv_dsp_vad_active() as a gate callback: pass it with the detector as user data to
+// vv_dsp_graph_set_gate() to skip nodes while nobody speaks
+int vv_dsp_vad_gate(void* vad);
+
+// Mean positive sub-band SNR of the last completed frame in dB
+vv_dsp_real vv_dsp_vad_snr_db(const vv_dsp_vad* vad);
+
+// Forget the noise floors, the partial frame and the hangover
+vv_dsp_status vv_dsp_vad_reset(vv_dsp_vad* vad);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FEATURES_VAD_H
@@ -36,8 +36,21 @@ extern "C" {
 // Include all filtering submodules
 #include "vv_dsp/filter/common.h"  ///< Common filtering utilities and helper functions
 #include "vv_dsp/filter/fir.h"     ///< Finite Impulse Response (FIR) filters
+#include "vv_dsp/filter/convolver.h" ///< Streaming and partitioned FFT convolution
+#include "vv_dsp/filter/adaptive.h" ///< Partitioned-block frequency-domain adaptive filter (MDF NLMS)
+#include "vv_dsp/filter/polyphase.h" ///< Polyphase FIR decimators and interpolators
+#include "vv_dsp/filter/cic.h"     ///< CIC decimators / interpolators and droop compensation
+#include "vv_dsp/filter/zoom_fft.h" ///< Zoom-FFT narrow-band analyzer (heterodyne + decimate + FFT)
+#include "vv_dsp/filter/subband.h" ///< PQMF / oversampled DFT sub-band analysis-synthesis filterbanks
+#include "vv_dsp/filter/cqt.h"      ///< Constant-Q transform and chroma (sparse spectral kernels)
 #include "vv_dsp/filter/iir.h"     ///< Infinite Impulse Response (IIR) filters
+#include "vv_dsp/filter/eq.h"      ///< Smoothed parametric EQ on the biquad bank, cached RBJ designs
 #include "vv_dsp/filter/savgol.h"  ///< Savitzky-Golay smoothing and differentiation filters
+#include "vv_dsp/filter/moving.h"  ///< Moving mean / RMS / min / max / median filters
+#include "vv_dsp/filter/dynamics.h" ///< Multiband compressor: LR4 crossovers, envelope followers, log-domain gain
+#ifdef VV_DSP_FIXED_POINT_ENABLED
+#include "vv_dsp/filter/fixed.h"   ///< Q15/Q31 fixed-point FIR and biquad kernels
+#endif
 
 /**
  * @brief Dummy function for basic filter module testing
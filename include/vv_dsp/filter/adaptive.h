@@ -0,0 +1,115 @@
+/*
+ * Partitioned-block frequency-domain adaptive filter (MDF / PBFDAF) API
+ */
+#ifndef VV_DSP_FILTER_ADAPTIVE_H
+#define VV_DSP_FILTER_ADAPTIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Acoustic echo cancellation and system identification with long filters. The
+// estimate of the echo path from each reference (far-end) channel to the microphone is
+// cut into block_size partitions, as in vv_dsp_partconv: every block of block_size
+// samples costs one R2C per reference channel into a frequency-domain delay line, a
+// spectrum multiply-accumulate per partition, one C2R for the echo estimate and one
+// R2C of the error. A time-domain NLMS over 4096 taps needs 8192 multiply-adds per
+// sample; at block_size 256 this costs a few hundred.
+//
+// The update is the multi-delay filter (MDF) form of NLMS:
+//   W_cp += step * E * conj(X_cp) / (sum_cp |X_cp|^2 + delta)
+// normalized per bin by the reference energy of the whole delay line, over all
+// channels, so step in (0, 1] behaves like the NLMS step on every bin. The gradient
+// constraint (zeroing the second half of each partition's gradient in time) keeps the
+// partitions linear convolutions; the default constrains one partition per block in
+// turn, as MDF does, which costs two extra FFTs per channel per block instead of two
+// per partition.
+//
+// Latency is block_size samples: error[t] and echo[t] belong to mic[t - block_size].
+// Not thread-safe per object.
+
+typedef enum {
+    VV_DSP_FDAF_CONSTRAIN_ROTATE = 0,  // one partition per block, round robin (MDF)
+    VV_DSP_FDAF_CONSTRAIN_ALL = 1,     // every partition every block
+    VV_DSP_FDAF_CONSTRAIN_NONE = 2     // unconstrained: cheapest, may converge to a biased filter
+} vv_dsp_fdaf_constraint;
+
+typedef struct {
+    size_t block_size;           // samples per block and partition size; power of two
+    size_t num_taps;             // filter length per reference channel (rounded up to partitions)
+    size_t num_channels;         // reference channels, 0 = 1
+    vv_dsp_real step;            // NLMS step, 0 = 0.5
+    vv_dsp_real regularization;  // delta as a per-sample reference power, 0 = 1e-6
+    vv_dsp_fdaf_constraint constraint;
+} vv_dsp_fdaf_params;
+
+// Block powers (means of squares over the block) handed to the step hook
+typedef struct {
+    size_t block;                // blocks processed before this one
+    vv_dsp_real ref_power;       // reference, summed over channels
+    vv_dsp_real mic_power;
+    vv_dsp_real echo_power;      // echo estimate
+    vv_dsp_real error_power;     // mic - echo estimate
+} vv_dsp_fdaf_block_stats;
+
+// Called once per block after filtering and before the update; returns the factor
+// applied to step for this block. Return 0 to freeze adaptation, e.g. while a
+// double-talk detector sees near-end speech, or a value in (0, 1) to slow it down.
+typedef vv_dsp_real (*vv_dsp_fdaf_step_fn)(const vv_dsp_fdaf_block_stats* stats, void* user);
+
+typedef struct vv_dsp_fdaf vv_dsp_fdaf;
+
+/**
+ * Create a filter with all-zero taps. VV_DSP_ERROR_INVALID_SIZE when block_size is not a
+ * power of two or num_taps is 0; VV_DSP_ERROR_OUT_OF_RANGE for step outside (0, 2) or
+ * a negative regularization.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fdaf_create(const vv_dsp_fdaf_params* params, vv_dsp_fdaf** out);
+
+// Destroy filter (NULL is ignored)
+void vv_dsp_fdaf_destroy(vv_dsp_fdaf* f);
+
+// Clear taps, delay line and pending output
+vv_dsp_status vv_dsp_fdaf_reset(vv_dsp_fdaf* f);
+
+/**
+ * Process num_samples samples: refs holds num_channels reference pointers, mic the
+ * microphone (desired) signal. error receives mic - echo estimate and echo (optional)
+ * the estimate itself, both delayed by block_size. error may alias mic.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fdaf_process(vv_dsp_fdaf* f,
+                                                   const vv_dsp_real* const* refs,
+                                                   const vv_dsp_real* mic,
+                                                   vv_dsp_real* error,
+                                                   vv_dsp_real* echo,
+                                                   size_t num_samples);
+
+// Change the base step for later blocks; VV_DSP_ERROR_OUT_OF_RANGE outside [0, 2)
+vv_dsp_status vv_dsp_fdaf_set_step(vv_dsp_fdaf* f, vv_dsp_real step);
+
+// Install (or with NULL remove) the per-block step hook
+vv_dsp_status vv_dsp_fdaf_set_step_callback(vv_dsp_fdaf* f, vv_dsp_fdaf_step_fn fn, void* user);
+
+/**
+ * Copy the first num_taps taps of the current estimate for one reference channel to
+ * taps (time domain; taps past the filter length read as 0).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fdaf_get_filter(const vv_dsp_fdaf* f,
+                                                      size_t channel,
+                                                      vv_dsp_real* taps,
+                                                      size_t num_taps);
+
+// Output delay in samples (= block_size); 0 for NULL
+size_t vv_dsp_fdaf_latency(const vv_dsp_fdaf* f);
+
+// Partitions per channel (num_taps / block_size rounded up); 0 for NULL
+size_t vv_dsp_fdaf_num_partitions(const vv_dsp_fdaf* f);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_ADAPTIVE_H
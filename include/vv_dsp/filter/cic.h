@@ -0,0 +1,125 @@
+/*
+ * Cascaded integrator-comb (CIC) decimator / interpolator API
+ */
+#ifndef VV_DSP_FILTER_CIC_H
+#define VV_DSP_FILTER_CIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/filter/common.h"
+
+// Multiplier-free rate change by rate R with num_stages N integrators and combs of
+// differential delay M: H(z) = ((1 - z^-RM) / (1 - z^-1))^N, DC gain G = (R M)^N.
+// Integrators and combs run in 64-bit two's-complement arithmetic that is allowed to
+// wrap; because the filter is linear modulo 2^64 the output is exact as long as the
+// output itself fits, so no integrator overflow handling is needed. The register
+// growth B = ceil(N log2(R M)) must not exceed 40 bits.
+//
+// Two entry points share one object (reset before switching between them):
+//  - real: inputs are quantized to 60 - B fractional bits (at most 48), and outputs
+//    are scaled to unity DC gain. |input| must stay below 8 (larger values saturate).
+//  - integer: int32 inputs, raw int64 outputs with gain G (decimator) or G / R
+//    (interpolator); requires B <= 32.
+// Follow a CIC decimator with a short compensation FIR (vv_dsp_cic_design_compensator())
+// at the low rate, usually as a final decimate-by-2 stage, to flatten the sinc^N droop.
+
+// Decimator: y[m] is the CIC output at inputs 0, R, 2R, ... (the first input
+// produces an output, as with vv_dsp_fir_decimator).
+typedef struct vv_dsp_cic_decimator vv_dsp_cic_decimator;
+
+// Interpolator: comb at the input rate, zero-stuff by R, integrate at the output rate
+typedef struct vv_dsp_cic_interpolator vv_dsp_cic_interpolator;
+
+/**
+ * Create a decimator by rate (>= 1) with num_stages (1..8) and diff_delay (1..8).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_create(size_t rate,
+                                                           size_t num_stages,
+                                                           size_t diff_delay,
+                                                           vv_dsp_cic_decimator** out_dec);
+
+// Outputs the next process call with num_samples inputs will write
+size_t vv_dsp_cic_decimator_output_count(const vv_dsp_cic_decimator* dec, size_t num_samples);
+
+/**
+ * Consume num_samples inputs and write the completed outputs; *out_count receives their
+ * number. Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than
+ * max_out outputs would be produced. input and output may be the same buffer.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_process(vv_dsp_cic_decimator* dec,
+                                                            const vv_dsp_real* input,
+                                                            size_t num_samples,
+                                                            vv_dsp_real* output,
+                                                            size_t max_out,
+                                                            size_t* out_count);
+
+// Integer variant of vv_dsp_cic_decimator_process(); VV_DSP_ERROR_OUT_OF_RANGE if B > 32
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_process_int(vv_dsp_cic_decimator* dec,
+                                                                const int32_t* input,
+                                                                size_t num_samples,
+                                                                int64_t* output,
+                                                                size_t max_out,
+                                                                size_t* out_count);
+
+// Clear state and restart the output phase
+vv_dsp_status vv_dsp_cic_decimator_reset(vv_dsp_cic_decimator* dec);
+
+// Destroy decimator (NULL is ignored)
+void vv_dsp_cic_decimator_destroy(vv_dsp_cic_decimator* dec);
+
+/**
+ * Create an interpolator by rate (>= 1) with num_stages (1..8) and diff_delay (1..8).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_create(size_t rate,
+                                                              size_t num_stages,
+                                                              size_t diff_delay,
+                                                              vv_dsp_cic_interpolator** out_interp);
+
+/**
+ * Consume num_samples inputs and write num_samples * rate outputs.
+ * output must not overlap input.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_process(vv_dsp_cic_interpolator* interp,
+                                                               const vv_dsp_real* input,
+                                                               size_t num_samples,
+                                                               vv_dsp_real* output);
+
+// Integer variant of vv_dsp_cic_interpolator_process(); VV_DSP_ERROR_OUT_OF_RANGE if B > 32
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_process_int(vv_dsp_cic_interpolator* interp,
+                                                                   const int32_t* input,
+                                                                   size_t num_samples,
+                                                                   int64_t* output);
+
+// Clear state
+vv_dsp_status vv_dsp_cic_interpolator_reset(vv_dsp_cic_interpolator* interp);
+
+// Destroy interpolator (NULL is ignored)
+void vv_dsp_cic_interpolator_destroy(vv_dsp_cic_interpolator* interp);
+
+/**
+ * Design a linear-phase FIR for the low-rate side of a CIC (rate, num_stages,
+ * diff_delay) whose passband response is the inverse of the CIC droop,
+ *   D(f) = [R M sin(pi f / R) / sin(pi f M)]^N  for f <= cutoff, 0 above,
+ * windowed with the vv_dsp_fir_design_lowpass() windows and normalized to unity DC gain.
+ * f and cutoff are in cycles per low-rate sample, the scale vv_dsp_fir_design_lowpass()
+ * uses for its cutoff (h = 2 fc sinc(2 fc m)); cutoff must be in (0, 0.5) and below
+ * the first CIC null 1 / diff_delay. num_taps must be >= 2.
+ */
+vv_dsp_status vv_dsp_cic_design_compensator(vv_dsp_real* coeffs,
+                                            size_t num_taps,
+                                            size_t rate,
+                                            size_t num_stages,
+                                            size_t diff_delay,
+                                            vv_dsp_real cutoff,
+                                            vv_dsp_window_type window_type);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_CIC_H
@@ -0,0 +1,146 @@
+/*
+ * Streaming FFT convolution API
+ */
+#ifndef VV_DSP_FILTER_CONVOLVER_H
+#define VV_DSP_FILTER_CONVOLVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Overlap-save FIR convolver for long filters. The impulse response is transformed
+// once at creation; each block then costs one R2C, one spectrum multiply and one C2R.
+// Output is identical (up to rounding) to vv_dsp_fir_apply() on the same stream, with
+// no added latency.
+//
+// Opaque object; owns its plans, buffers and history, so use one instance per stream
+// and do not share it between threads.
+typedef struct vv_dsp_fft_convolver vv_dsp_fft_convolver;
+
+/**
+ * Create a convolver for coeffs[num_taps] (copied and transformed).
+ * block_size is the expected number of samples per process call (0 = num_taps);
+ * the FFT size is the next power of two >= block_size + num_taps - 1.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_convolver_create(const vv_dsp_real* coeffs,
+                                                           size_t num_taps,
+                                                           size_t block_size,
+                                                           vv_dsp_fft_convolver** out_conv);
+
+/**
+ * Filter num_samples samples continuing the stream. Any size is accepted: calls
+ * longer than vv_dsp_fft_convolver_block_size() are split into several FFT blocks,
+ * shorter ones cost a full block, so deliver block_size samples where possible.
+ * input and output may be the same buffer.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_convolver_process(vv_dsp_fft_convolver* conv,
+                                                            const vv_dsp_real* input,
+                                                            vv_dsp_real* output,
+                                                            size_t num_samples);
+
+// New samples consumed per FFT block (fft_size - num_taps + 1); 0 for NULL
+size_t vv_dsp_fft_convolver_block_size(const vv_dsp_fft_convolver* conv);
+
+// FFT length used internally; 0 for NULL
+size_t vv_dsp_fft_convolver_fft_size(const vv_dsp_fft_convolver* conv);
+
+// Clear the input history (as if the stream restarted)
+vv_dsp_status vv_dsp_fft_convolver_reset(vv_dsp_fft_convolver* conv);
+
+// Destroy convolver (NULL is ignored)
+void vv_dsp_fft_convolver_destroy(vv_dsp_fft_convolver* conv);
+
+// Partitioned convolution for long impulse responses (reverbs of several seconds) at
+// small buffer sizes. The filter is cut into partitions; each stage is a uniformly
+// partitioned overlap-save convolver with a frequency-domain delay line, so a block
+// costs one FFT pair plus one spectrum multiply-accumulate per partition.
+//
+// Latency is exactly block_size samples: out[t] = (h * x)[t - block_size].
+//
+// Non-uniform schedule: when max_partition > block_size, stage k uses partitions of
+// block_size * 4^k. Stage 0 covers the first 7 partitions and every later stage covers
+// 6, except the last, which covers the rest of the filter. A stage of block B_k starts at
+// tap 2 * B_k - block_size, which leaves it one full B_k period to compute. With
+// background set, stages k >= 1 run on a worker thread owned by the engine. The audio
+// thread only waits when that worker falls behind, and the output is identical either
+// way.
+typedef struct vv_dsp_partconv vv_dsp_partconv;
+
+typedef struct vv_dsp_partconv_params {
+    size_t block_size;     // latency and smallest partition; power of two
+    size_t max_partition;  // largest partition (0 or <= block_size: uniform)
+    int background;        // nonzero: compute the larger stages on a worker thread
+} vv_dsp_partconv_params;
+
+/**
+ * Create an engine for coeffs[num_taps] (copied and transformed).
+ * Returns VV_DSP_ERROR_INVALID_SIZE when num_taps is 0 or block_size is not a power of
+ * two, and VV_DSP_ERROR_INTERNAL when allocation or the worker thread fails.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_partconv_create(const vv_dsp_real* coeffs,
+                                                      size_t num_taps,
+                                                      const vv_dsp_partconv_params* params,
+                                                      vv_dsp_partconv** out_conv);
+
+// Filter num_samples samples (any count); input and output may be the same buffer
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_partconv_process(vv_dsp_partconv* conv,
+                                                       const vv_dsp_real* input,
+                                                       vv_dsp_real* output,
+                                                       size_t num_samples);
+
+// Output delay in samples (= block_size); 0 for NULL
+size_t vv_dsp_partconv_latency(const vv_dsp_partconv* conv);
+
+// Number of partition stages in the schedule; 0 for NULL
+size_t vv_dsp_partconv_num_stages(const vv_dsp_partconv* conv);
+
+// Wait for background work, then clear all history and pending output
+vv_dsp_status vv_dsp_partconv_reset(vv_dsp_partconv* conv);
+
+// Stop the worker thread and destroy the engine (NULL is ignored)
+void vv_dsp_partconv_destroy(vv_dsp_partconv* conv);
+
+// Whole-buffer convolution and the direct / FFT dispatch shared by vv_dsp_fir_apply(),
+// vv_dsp_filtfilt_fir() and the Savitzky-Golay filters. Filters of at least the
+// crossover length (and outputs of at least one filter length) use FFT overlap-save,
+// shorter ones the SIMD direct kernel. The crossover is process-wide; change it before
+// other threads start filtering.
+typedef enum vv_dsp_conv_method {
+    VV_DSP_CONV_DIRECT = 0,
+    VV_DSP_CONV_FFT = 1
+} vv_dsp_conv_method;
+
+// Method used for num_outputs outputs of a num_taps filter
+vv_dsp_conv_method vv_dsp_conv_select(size_t num_taps, size_t num_outputs);
+
+// Current crossover in taps
+size_t vv_dsp_conv_get_crossover(void);
+
+// Set the crossover in taps (0 restores the built-in default)
+void vv_dsp_conv_set_crossover(size_t num_taps);
+
+/**
+ * Time both methods on this machine (a few tens of milliseconds) and store the
+ * measured crossover. out_crossover (optional) receives it.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_conv_calibrate(size_t* out_crossover);
+
+/**
+ * "Valid" convolution: output[i] = sum_k coeffs[k] * input[i + num_taps - 1 - k] for
+ * i < num_outputs, so input holds num_outputs + num_taps - 1 samples. output must not
+ * overlap input.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_convolve_valid(const vv_dsp_real* coeffs,
+                                                     size_t num_taps,
+                                                     const vv_dsp_real* input,
+                                                     size_t num_outputs,
+                                                     vv_dsp_real* output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_CONVOLVER_H
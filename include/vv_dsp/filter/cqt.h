@@ -0,0 +1,100 @@
+/*
+ * Constant-Q transform and chromagram via sparse spectral kernels
+ */
+#ifndef VV_DSP_FILTER_CQT_H
+#define VV_DSP_FILTER_CQT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Brown & Puckette's sparse-kernel CQT. Bin k is centred on
+// f_k = fmin * 2^(k / bins_per_octave) and correlates the signal with a Hann-windowed
+// complex exponential of N_k = ceil(Q * sample_rate / f_k) samples,
+// Q = 1 / (2^(1 / bins_per_octave) - 1), normalized by the window sum: a real cosine
+// of amplitude a on a bin centre reads |X| = a/2. The plan transforms each
+// temporal kernel once, keeps the half-spectrum entries above sparsity times the
+// kernel's peak, and stores them row by row; a frame then costs one R2C FFT and one
+// sparse matrix-vector product over the half spectrum.
+//
+// Direct mode sizes the FFT for the lowest bin and holds every bin's kernel.
+// Recursive mode (Schoerkhuber & Klapuri) holds only the top octave's kernel: after
+// each octave the signal is lowpassed and decimated by two with a
+// vv_dsp_fir_decimator, and the same kernel yields the next octave down from a frame
+// half as long in time, so the FFT stays the size of the top octave's. The
+// half-band filter attenuates the top of each lower octave, so keep the highest bin
+// below about 0.4 * sample_rate in recursive mode.
+//
+// Frame t is centred on input sample t * hop (zero outside the signal), so n samples
+// give n / hop + 1 frames. Not thread-safe per plan.
+
+#define VV_DSP_CQT_DEFAULT_SPARSITY 0.0054  // Brown & Puckette's threshold
+
+typedef struct {
+    vv_dsp_real sample_rate;
+    vv_dsp_real fmin;            // centre of bin 0 (Hz)
+    size_t bins_per_octave;      // >= 1; 12 for semitones
+    size_t num_bins;             // >= 1; the highest bin must lie below sample_rate / 2
+    size_t hop;                  // samples between frames; recursive: a multiple of 2^(octaves - 1)
+    vv_dsp_real sparsity;        // relative kernel magnitude dropped, 0 = VV_DSP_CQT_DEFAULT_SPARSITY
+    int recursive;               // nonzero: octave-wise decimation instead of one long FFT
+    size_t num_taps;             // recursive only: half-band lowpass length, 4m + 1; 0 = 65
+} vv_dsp_cqt_params;
+
+typedef struct vv_dsp_cqt vv_dsp_cqt;
+
+/**
+ * Build a plan. VV_DSP_ERROR_INVALID_SIZE for zero sizes, a recursive hop that is
+ * not a multiple of 2^(octaves - 1) or num_taps not of the form 4m + 1;
+ * VV_DSP_ERROR_OUT_OF_RANGE for a sample rate or fmin that is not positive, bins
+ * reaching Nyquist or a sparsity outside [0, 1).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cqt_create(const vv_dsp_cqt_params* params, vv_dsp_cqt** out);
+
+// Destroy plan (NULL is ignored)
+void vv_dsp_cqt_destroy(vv_dsp_cqt* cqt);
+
+size_t vv_dsp_cqt_num_bins(const vv_dsp_cqt* cqt);
+
+// Centre frequency of bin k (Hz)
+vv_dsp_real vv_dsp_cqt_bin_freq(const vv_dsp_cqt* cqt, size_t k);
+
+// FFT size per frame and stored kernel entries, for sizing and diagnostics
+size_t vv_dsp_cqt_fft_size(const vv_dsp_cqt* cqt);
+size_t vv_dsp_cqt_kernel_nonzeros(const vv_dsp_cqt* cqt);
+
+// Frames a signal of n samples yields: n / hop + 1 (0 for n = 0)
+size_t vv_dsp_cqt_output_count(const vv_dsp_cqt* cqt, size_t n);
+
+/**
+ * Transform a whole signal: each frame's num_bins coefficients (lowest bin first)
+ * go to a row of out. *out_frames receives the frame count; VV_DSP_ERROR_INVALID_SIZE
+ * without writing anything if it exceeds max_frames. Recursive mode allocates its
+ * decimated copies of the signal per call.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cqt_process(vv_dsp_cqt* cqt,
+                                                  const vv_dsp_real* input,
+                                                  size_t n,
+                                                  vv_dsp_cpx* out,
+                                                  size_t max_frames,
+                                                  size_t* out_frames);
+
+/**
+ * Fold num_frames CQT rows (as written by vv_dsp_cqt_process()) into 12 pitch
+ * classes per frame, C first: the energies |X_k|^2 of the bins nearest each
+ * equal-tempered pitch class (A4 = 440 Hz) are summed and each frame is scaled to a
+ * maximum of 1 (silent frames stay 0). chroma receives 12 values per frame.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cqt_chroma(const vv_dsp_cqt* cqt,
+                                                 const vv_dsp_cpx* cqt_frames,
+                                                 size_t num_frames,
+                                                 vv_dsp_real* chroma);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_CQT_H
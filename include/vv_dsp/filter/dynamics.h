@@ -0,0 +1,99 @@
+/*
+ * Multiband dynamics (compressor / limiter) API
+ */
+#ifndef VV_DSP_FILTER_DYNAMICS_H
+#define VV_DSP_FILTER_DYNAMICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Multichannel, multiband downward compressor. The input is split by a tree of
+// 4th-order Linkwitz-Riley crossovers (two Butterworth biquads per side, on
+// vv_dsp_biquad_bank), and every band except the top one also runs through the
+// LR4 allpass of the crossovers above it, so with unity band gains the bands sum to
+// an allpass of the input: flat magnitude, no notches at the crossovers.
+//
+// Per band, a peak (|x|) or RMS (x^2) detector is smoothed by a one-pole envelope
+// follower with separate attack and release times. The follower is branch-free and
+// runs across channels in SIMD lanes. Envelopes go through the fast vv_dsp_vlog tier,
+// the soft-knee gain computer works in dB, and gains come back through vv_dsp_vexp,
+// a block of frames at a time.
+//
+// With link_channels set, every band uses the loudest channel's envelope for all
+// channels, which keeps the stereo (or surround) image. Latency is 0. Not thread-safe
+// per object.
+
+// Maximum number of bands (num_bands - 1 crossovers)
+#define VV_DSP_DYNAMICS_MAX_BANDS 16
+
+typedef enum {
+    VV_DSP_DYNAMICS_PEAK = 0,  // smoothed |x|, level in dBFS of the peak
+    VV_DSP_DYNAMICS_RMS = 1    // smoothed x^2, level in dB of the RMS (a full-scale sine reads -3 dB)
+} vv_dsp_dynamics_detector;
+
+typedef struct {
+    vv_dsp_real sample_rate;
+    size_t num_channels;
+    size_t num_bands;                 // 1 .. VV_DSP_DYNAMICS_MAX_BANDS
+    const vv_dsp_real* crossover_hz;  // num_bands - 1 increasing frequencies in (0, sample_rate / 2)
+    vv_dsp_dynamics_detector detector;
+    int link_channels;                // nonzero: one gain per band for all channels
+} vv_dsp_dynamics_params;
+
+// Static curve and timing of one band. A band starts as 0 dB threshold, ratio 1
+// (no compression), hard knee, 0 dB makeup, 10 ms attack and 100 ms release.
+typedef struct {
+    vv_dsp_real threshold_db;
+    vv_dsp_real ratio;        // >= 1; large values limit
+    vv_dsp_real knee_db;      // soft-knee width centered on the threshold, 0 = hard
+    vv_dsp_real makeup_db;
+    vv_dsp_real attack_ms;    // time constants of the envelope follower; 0 = instant
+    vv_dsp_real release_ms;
+} vv_dsp_dynamics_band;
+
+typedef struct vv_dsp_dynamics vv_dsp_dynamics;
+
+/**
+ * Create a processor with every band at the defaults above. VV_DSP_ERROR_INVALID_SIZE
+ * for 0 channels or a band count outside 1..VV_DSP_DYNAMICS_MAX_BANDS;
+ * VV_DSP_ERROR_OUT_OF_RANGE for a non-positive sample rate, crossovers that are not
+ * increasing inside (0, sample_rate / 2), or an unknown detector.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_create(const vv_dsp_dynamics_params* params,
+                                                      vv_dsp_dynamics** out);
+
+// Destroy processor (NULL is ignored)
+void vv_dsp_dynamics_destroy(vv_dsp_dynamics* d);
+
+// Clear filter states and envelopes (band settings are kept)
+vv_dsp_status vv_dsp_dynamics_reset(vv_dsp_dynamics* d);
+
+// Set one band; VV_DSP_ERROR_OUT_OF_RANGE for ratio < 1 or negative knee or times.
+// Takes effect from the next processed frame; envelopes are kept.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_set_band(vv_dsp_dynamics* d,
+                                                        size_t band,
+                                                        const vv_dsp_dynamics_band* settings);
+
+// Process num_frames interleaved frames (sample c of frame t at [t * num_channels + c]),
+// streaming across calls. input and output may be the same buffer.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_process(vv_dsp_dynamics* d,
+                                                       const vv_dsp_real* input,
+                                                       vv_dsp_real* output,
+                                                       size_t num_frames);
+
+// Gain change in dB (<= 0, makeup excluded) of one band and channel at the last
+// processed frame, for metering
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_get_gain_reduction(const vv_dsp_dynamics* d,
+                                                                  size_t band,
+                                                                  size_t channel,
+                                                                  vv_dsp_real* gain_db);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_DYNAMICS_H
@@ -0,0 +1,86 @@
+/*
+ * Smoothed multichannel parametric equalizer API
+ */
+#ifndef VV_DSP_FILTER_EQ_H
+#define VV_DSP_FILTER_EQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/filter/iir.h"
+
+// num_bands RBJ sections (vv_dsp_biquad_design()) in series on each of num_channels
+// channels, run through one vv_dsp_biquad_bank with one stage per band, so the SIMD
+// bank advances many channels at once.
+//
+// Parameter changes glide instead of jumping. A new target's coefficients are reached
+// by linear steps, one step per VV_DSP_EQ_SUBBLOCK frames, over the smoothing time.
+// Linear steps between two stable sections stay stable, because the (a1, a2)
+// stability triangle is convex. The sub-block grid counts from the first processed
+// frame, so output does not depend on how the stream is chunked.
+//
+// Designs are cached per EQ, keyed by shape and quantized parameters: frequency and Q
+// to 1 cent (1/1200 octave), gain to 0.01 dB. The section is designed at the
+// quantized values, so a knob that returns to a position, or the same setting applied
+// to many channels, costs one trig-free table lookup. Not thread-safe per object.
+
+// Frames between coefficient steps while a band glides
+#define VV_DSP_EQ_SUBBLOCK 32
+
+// Channel argument that addresses every channel
+#define VV_DSP_EQ_ALL_CHANNELS ((size_t)-1)
+
+typedef struct vv_dsp_eq vv_dsp_eq;
+
+/**
+ * Create an EQ whose bands all start flat, with 20 ms smoothing.
+ * VV_DSP_ERROR_INVALID_SIZE for 0 channels or bands; VV_DSP_ERROR_OUT_OF_RANGE for a
+ * non-positive sample rate.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_create(vv_dsp_real sample_rate,
+                                                size_t num_channels,
+                                                size_t num_bands,
+                                                vv_dsp_eq** out);
+
+// Destroy EQ (NULL is ignored)
+void vv_dsp_eq_destroy(vv_dsp_eq* eq);
+
+// Glide time for later parameter changes (0 = jump); VV_DSP_ERROR_OUT_OF_RANGE if negative
+vv_dsp_status vv_dsp_eq_set_smoothing(vv_dsp_eq* eq, vv_dsp_real ms);
+
+/**
+ * Retarget one band of one channel (or of VV_DSP_EQ_ALL_CHANNELS) to an RBJ section;
+ * parameters as vv_dsp_biquad_design(), which also gives the errors.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_set_band(vv_dsp_eq* eq,
+                                                  size_t channel,
+                                                  size_t band,
+                                                  vv_dsp_biquad_type type,
+                                                  vv_dsp_real freq_hz,
+                                                  vv_dsp_real q,
+                                                  vv_dsp_real gain_db);
+
+// Glide one band of one channel (or of VV_DSP_EQ_ALL_CHANNELS) back to flat
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_bypass_band(vv_dsp_eq* eq, size_t channel, size_t band);
+
+// Filter num_frames interleaved frames (sample c of frame t at [t * num_channels + c]),
+// streaming across calls. input and output may be the same buffer.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_process(vv_dsp_eq* eq,
+                                                 const vv_dsp_real* input,
+                                                 vv_dsp_real* output,
+                                                 size_t num_frames);
+
+// Clear the filter states and finish every glide at its target
+vv_dsp_status vv_dsp_eq_reset(vv_dsp_eq* eq);
+
+// Design-cache lookups that were served from the cache (hits) or designed (misses)
+vv_dsp_status vv_dsp_eq_cache_stats(const vv_dsp_eq* eq, size_t* hits, size_t* misses);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_EQ_H
@@ -10,6 +10,8 @@ extern "C" {
 
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/filter/common.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/buffer.h"
 
 /**
  * Design a low-pass FIR using windowed-sinc.
@@ -24,24 +26,48 @@ vv_dsp_status vv_dsp_fir_design_lowpass(vv_dsp_real* coeffs,
                                         vv_dsp_real cutoff_norm, // 0..1 (1=Nyquist)
                                         vv_dsp_window_type window_type);
 
-// FIR streaming state
+// FIR streaming state. The history is linear, not a ring: history holds the last
+// history_size inputs (oldest first) followed by a staging block that each call fills
+// with new input, so every output is one contiguous dot product over
+// history[i .. i + num_taps).
 typedef struct {
-    vv_dsp_real* history;    // ring buffer of previous samples, size=num_taps-1
+    vv_dsp_real* history;    // history_size past samples + stage_size staging slots
     size_t history_size;     // equals num_taps-1 when initialized
-    size_t history_idx;      // write index
+    size_t stage_size;       // staging slots (at least history_size)
     size_t num_taps;         // number of coefficients
+    vv_dsp_real* coeffs_rev; // taps in reverse order, refreshed by every vv_dsp_fir_apply()
+    void* fft;               // overlap-save plan kept by vv_dsp_fir_state_prepare(), or NULL
+    size_t max_block;        // block size prepared for, 0 when not prepared
 } vv_dsp_fir_state;
 
 vv_dsp_status vv_dsp_fir_state_init(vv_dsp_fir_state* state, size_t num_taps);
 void vv_dsp_fir_state_free(vv_dsp_fir_state* state);
 
-// Apply FIR via direct convolution with state (overlap via history)
+// Real-time preparation (see core/alloc.h): keep the FFT overlap-save plan that
+// calls of up to max_block samples would otherwise build per call, so that
+// vv_dsp_fir_apply() never allocates afterwards. Its spectrum of the taps is
+// recomputed only when the coefficients change. Longer calls still run, on the
+// plan or the direct kernel. May be called again; vv_dsp_fir_state_free() releases it.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_state_prepare(vv_dsp_fir_state* state, size_t max_block);
+
+// Apply FIR with state (overlap via history). Short filters use direct convolution,
+// where SIMD builds compute several outputs per iteration (AVX-512, AVX2, SSE4.1,
+// NEON); filters past vv_dsp_conv_get_crossover() use FFT overlap-save.
+// input and output may be the same buffer.
 vv_dsp_status vv_dsp_fir_apply(vv_dsp_fir_state* state,
                                const vv_dsp_real* coeffs,
                                const vv_dsp_real* input,
                                vv_dsp_real* output,
                                size_t num_samples);
 
+// vv_dsp_fir_apply() on float or double samples in any build (see core/typed.h); the
+// state and coefficients stay in vv_dsp_real. The variant of the build's precision is
+// vv_dsp_fir_apply(); the other converts in stack blocks and never allocates.
+vv_dsp_status vv_dsp_fir_apply_f32(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const float* input,
+                                   float* output, size_t num_samples);
+vv_dsp_status vv_dsp_fir_apply_f64(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const double* input,
+                                   double* output, size_t num_samples);
+
 /**
  * Apply FIR via FFT-based convolution (single block, linear convolution).
  * Produces output length equal to num_samples (tail is truncated like time-domain apply with zero history).
@@ -52,6 +78,33 @@ vv_dsp_status vv_dsp_fir_apply_fft(vv_dsp_fir_state* state,
                                    vv_dsp_real* output,
                                    size_t num_samples);
 
+/**
+ * vv_dsp_fir_apply_fft() with its work buffers drawn from arena (NULL = heap)
+ * and released before returning; needs
+ * vv_dsp_fir_apply_fft_scratch_size(num_taps, num_samples) bytes of it.
+ * The R2C/C2R plans come from the shared plan cache (spectral/fft.h): the first
+ * call at an FFT size builds them and allocates, later calls with an arena
+ * allocate nothing while the plans stay cached.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_apply_fft_ex(vv_dsp_fir_state* state,
+                                                       const vv_dsp_real* coeffs,
+                                                       const vv_dsp_real* input,
+                                                       vv_dsp_real* output,
+                                                       size_t num_samples,
+                                                       vv_dsp_arena* arena);
+size_t vv_dsp_fir_apply_fft_scratch_size(size_t num_taps, size_t num_samples);
+
+// Multichannel FIR: filter every channel of in into out (same channel count, out->frames
+// >= in->frames) with the shared taps h, continuing the stream of states[c] for channel c.
+// All states need the same num_taps; in and out may be the same buffer. Planar buffers
+// run the single-channel path per channel. Interleaved and strided ones are staged a
+// chunk at a time and filtered frame by frame across channels, each tap loaded once per
+// frame; long filters share one tap spectrum across the channels.
+vv_dsp_status vv_dsp_fir_apply_buffer(vv_dsp_fir_state* states,
+                                      const vv_dsp_real* h,
+                                      const vv_dsp_buffer* in,
+                                      vv_dsp_buffer* out);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,109 @@
+/*
+ * Fixed-point (Q15 / Q31) FIR and biquad API
+ *
+ * Available when the library is built with VV_DSP_ENABLE_FIXED_POINT
+ * (VV_DSP_FIXED_POINT_ENABLED is defined). Outputs saturate instead of wrapping.
+ */
+#ifndef VV_DSP_FILTER_FIXED_H
+#define VV_DSP_FILTER_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/fixed_point.h"
+
+// Streaming FIR filters y[n] = sum_k h[k] * x[n - k] with the same linear history as
+// vv_dsp_fir_apply(). Both objects stream across calls of any length, accept
+// input == output, and are not thread-safe per object.
+//
+// Q15: products accumulate in 64 bits and the output is rounded and saturated to Q15,
+// so results do not depend on the coefficients' gain. When sum |coeffs| <= 1.0 (every
+// unity-gain lowpass) no 32-bit partial sum can overflow and the SIMD / dual-MAC path
+// (AVX2, SSE4.1, NEON, ARM SMLAD) is used; it gives bit-identical results.
+typedef struct vv_dsp_fir_q15 vv_dsp_fir_q15;
+
+// Q31: products accumulate in 64 bits (Q2.62), so partial sums must stay below 2.0 in
+// magnitude: sum |coeffs| < 2.0 is sufficient for any input.
+typedef struct vv_dsp_fir_q31 vv_dsp_fir_q31;
+
+/**
+ * Create a Q15 FIR for coeffs[num_taps] (copied).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q15_create(const vv_dsp_q15* coeffs,
+                                                     size_t num_taps,
+                                                     vv_dsp_fir_q15** out_fir);
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q15_process(vv_dsp_fir_q15* fir,
+                                                      const vv_dsp_q15* input,
+                                                      vv_dsp_q15* output,
+                                                      size_t num_samples);
+
+// Clear history
+vv_dsp_status vv_dsp_fir_q15_reset(vv_dsp_fir_q15* fir);
+
+// Destroy filter (NULL is ignored)
+void vv_dsp_fir_q15_destroy(vv_dsp_fir_q15* fir);
+
+/**
+ * Create a Q31 FIR for coeffs[num_taps] (copied).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q31_create(const vv_dsp_q31* coeffs,
+                                                     size_t num_taps,
+                                                     vv_dsp_fir_q31** out_fir);
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q31_process(vv_dsp_fir_q31* fir,
+                                                      const vv_dsp_q31* input,
+                                                      vv_dsp_q31* output,
+                                                      size_t num_samples);
+
+// Clear history
+vv_dsp_status vv_dsp_fir_q31_reset(vv_dsp_fir_q31* fir);
+
+// Destroy filter (NULL is ignored)
+void vv_dsp_fir_q31_destroy(vv_dsp_fir_q31* fir);
+
+// Cascade of Q31 biquads in direct form I, which keeps past inputs and (saturated)
+// outputs as state, so no internal node can overflow:
+//   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+// Headroom: coefficients are stored in Q(31 - post_shift), so they may reach
+// 2^post_shift in magnitude (post_shift = 1 covers every stable a1; use 2 or more for
+// peaking / shelving sections with gain). Each product keeps 2 guard bits in a 64-bit
+// accumulator, so the sum cannot overflow; the result is shifted back and saturated.
+typedef struct vv_dsp_biquad_q31 vv_dsp_biquad_q31;
+
+/**
+ * Create num_stages pass-through sections with headroom post_shift (0..8).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_q31_create(size_t num_stages,
+                                                        int post_shift,
+                                                        vv_dsp_biquad_q31** out_biquad);
+
+/**
+ * Quantize one section's coefficients (same convention as vv_dsp_biquad_init()).
+ * Returns VV_DSP_ERROR_OUT_OF_RANGE, leaving the section unchanged, when a
+ * coefficient does not fit in the headroom.
+ */
+vv_dsp_status vv_dsp_biquad_q31_set_stage(vv_dsp_biquad_q31* biquad, size_t stage,
+                                          vv_dsp_real b0, vv_dsp_real b1, vv_dsp_real b2,
+                                          vv_dsp_real a1, vv_dsp_real a2);
+
+// Run the cascade over num_samples samples; input and output may be the same buffer
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_q31_process(vv_dsp_biquad_q31* biquad,
+                                                         const vv_dsp_q31* input,
+                                                         vv_dsp_q31* output,
+                                                         size_t num_samples);
+
+// Clear the state of every section
+vv_dsp_status vv_dsp_biquad_q31_reset(vv_dsp_biquad_q31* biquad);
+
+// Destroy cascade (NULL is ignored)
+void vv_dsp_biquad_q31_destroy(vv_dsp_biquad_q31* biquad);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_FIXED_H
@@ -9,6 +9,8 @@ extern "C" {
 #endif
 
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/buffer.h"
+#include "vv_dsp/core/fp_env.h"
 
 /** Direct Form II Transposed biquad structure */
 typedef struct {
@@ -28,12 +30,175 @@ void vv_dsp_biquad_reset(vv_dsp_biquad* biquad);
 /** Process one sample through the biquad */
 vv_dsp_real vv_dsp_biquad_process(vv_dsp_biquad* biquad, vv_dsp_real input_sample);
 
+// Audio-EQ-cookbook (RBJ) section shapes for vv_dsp_biquad_design()
+typedef enum vv_dsp_biquad_type {
+    VV_DSP_BIQUAD_LOWPASS = 0,
+    VV_DSP_BIQUAD_HIGHPASS = 1,
+    VV_DSP_BIQUAD_BANDPASS = 2,   // constant 0 dB peak gain
+    VV_DSP_BIQUAD_NOTCH = 3,
+    VV_DSP_BIQUAD_ALLPASS = 4,
+    VV_DSP_BIQUAD_PEAKING = 5,    // gain_db at freq_hz, bandwidth set by q
+    VV_DSP_BIQUAD_LOWSHELF = 6,   // gain_db below freq_hz (q = 1/sqrt(2): steepest without overshoot)
+    VV_DSP_BIQUAD_HIGHSHELF = 7   // gain_db above freq_hz
+} vv_dsp_biquad_type;
+
+/**
+ * Design one RBJ cookbook section into biquad (coefficients normalized to a0 = 1,
+ * computed in double; state cleared). gain_db is used by the peaking and shelf shapes
+ * only. VV_DSP_ERROR_OUT_OF_RANGE unless sample_rate > 0, 0 < freq_hz < sample_rate / 2,
+ * q > 0 and type is known.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_design(vv_dsp_biquad* biquad,
+                                                    vv_dsp_biquad_type type,
+                                                    vv_dsp_real sample_rate,
+                                                    vv_dsp_real freq_hz,
+                                                    vv_dsp_real q,
+                                                    vv_dsp_real gain_db);
+
 vv_dsp_status vv_dsp_iir_apply(vv_dsp_biquad* biquads,
                                size_t num_stages,
                                const vv_dsp_real* input,
                                vv_dsp_real* output,
                                size_t num_samples);
 
+// vv_dsp_iir_apply() on float or double samples in any build (see core/typed.h); the
+// sections keep their vv_dsp_real coefficients and state. The variant of the build's
+// precision is vv_dsp_iir_apply(); the other converts per sample and never allocates.
+vv_dsp_status vv_dsp_iir_apply_f32(vv_dsp_biquad* biquads, size_t num_stages, const float* input, float* output,
+                                   size_t num_samples);
+vv_dsp_status vv_dsp_iir_apply_f64(vv_dsp_biquad* biquads, size_t num_stages, const double* input, double* output,
+                                   size_t num_samples);
+
+// Request the default edge padding of vv_dsp_filtfilt_iir(): 3 * (2 * num_stages + 1)
+#define VV_DSP_FILTFILT_DEFAULT_PAD ((size_t)-1)
+
+/**
+ * Zero-phase filtering with a biquad cascade (sosfiltfilt): forward pass, then the same
+ * cascade run backward in time, so the magnitude response is squared and the phase
+ * cancels. Both ends are padded by odd extension (2*x[0] - x[i]); each pass starts from
+ * the steady-state section states for its first sample (lfilter_zi applied per
+ * section), which removes the start-up transient.
+ *
+ * pad_len is clamped to num_samples - 1. Only the two pad_len-sample extensions are
+ * buffered: the signal itself is filtered directly in output, so input and output may
+ * be the same buffer. The coefficients of biquads are used; their state is ignored and
+ * left untouched.
+ */
+vv_dsp_status vv_dsp_filtfilt_iir(const vv_dsp_biquad* biquads,
+                                  size_t num_stages,
+                                  const vv_dsp_real* input,
+                                  vv_dsp_real* output,
+                                  size_t num_samples,
+                                  size_t pad_len);
+
+// Realization used by an IIR plan; both give the same response within rounding
+typedef enum vv_dsp_iir_realization {
+    // Direct cascade of DF2T sections, one sample at a time (vv_dsp_iir_apply())
+    VV_DSP_IIR_REALIZATION_CASCADE = 0,
+    // Block state-space form: each section computes a block of K outputs (K = SIMD lane
+    // count, 4 without SIMD) as one triangular Toeplitz product of the block input plus
+    // the free response of the two states, then refreshes the states from the last two
+    // inputs and outputs. Breaks the per-sample dependency in single-channel filtering.
+    VV_DSP_IIR_REALIZATION_BLOCK = 1
+} vv_dsp_iir_realization;
+
+// Opaque single-channel IIR plan over a biquad cascade; holds its own state
+typedef struct vv_dsp_iir_plan vv_dsp_iir_plan;
+
+// Build a plan from num_stages biquads (coefficients and current state are copied)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_make_plan(const vv_dsp_biquad* biquads,
+                                                    size_t num_stages,
+                                                    vv_dsp_iir_realization realization,
+                                                    vv_dsp_iir_plan** out_plan);
+
+// Filter num_samples samples, continuing the stream; input and output may alias
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_plan_apply(vv_dsp_iir_plan* plan,
+                                                     const vv_dsp_real* input,
+                                                     vv_dsp_real* output,
+                                                     size_t num_samples);
+
+// Clear the state of every stage
+vv_dsp_status vv_dsp_iir_plan_reset(vv_dsp_iir_plan* plan);
+
+// Denormal handling around vv_dsp_iir_plan_apply() (core/fp_env.h): with
+// VV_DSP_DENORMALS_FLUSH a decaying tail runs with FTZ/DAZ whatever the calling
+// thread's mode. Default VV_DSP_DENORMALS_KEEP; VV_DSP_ERROR_OUT_OF_RANGE for an
+// unknown mode.
+vv_dsp_status vv_dsp_iir_plan_set_denormals(vv_dsp_iir_plan* plan, vv_dsp_denormal_mode mode);
+
+// Destroy plan (NULL is ignored)
+void vv_dsp_iir_plan_destroy(vv_dsp_iir_plan* plan);
+
+// Multi-channel biquad bank: num_channels channels through the same cascade of num_stages
+// DF2T sections. Coefficients and state are stored channel-contiguous (SoA), so in float
+// SIMD builds one vector instruction advances a stage for 4/8/16 channels at once.
+// Channels left over after the last full vector, and double builds, use a scalar loop.
+typedef struct vv_dsp_biquad_bank vv_dsp_biquad_bank;
+
+// Create a bank; every stage starts as pass-through (b0 = 1) with zero state
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_create(size_t num_channels,
+                                                         size_t num_stages,
+                                                         vv_dsp_biquad_bank** out_bank);
+
+// Set one stage to the same coefficients on every channel (a0 assumed 1)
+vv_dsp_status vv_dsp_biquad_bank_set_stage(vv_dsp_biquad_bank* bank,
+                                           size_t stage,
+                                           vv_dsp_real b0,
+                                           vv_dsp_real b1,
+                                           vv_dsp_real b2,
+                                           vv_dsp_real a1,
+                                           vv_dsp_real a2);
+
+// Set one stage of one channel
+vv_dsp_status vv_dsp_biquad_bank_set_channel_stage(vv_dsp_biquad_bank* bank,
+                                                   size_t channel,
+                                                   size_t stage,
+                                                   vv_dsp_real b0,
+                                                   vv_dsp_real b1,
+                                                   vv_dsp_real b2,
+                                                   vv_dsp_real a1,
+                                                   vv_dsp_real a2);
+
+// Filter num_frames interleaved frames (sample c of frame t at [t * num_channels + c]).
+// input and output may be the same buffer.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_process(vv_dsp_biquad_bank* bank,
+                                                          const vv_dsp_real* input,
+                                                          vv_dsp_real* output,
+                                                          size_t num_frames);
+
+// Filter a multichannel buffer with the bank's channel count (out->frames >= in->frames).
+// Buffers whose channels are adjacent (interleaved, or a channel range of a wider
+// interleaved stream) take the vectorized channel loop above; planar and other strided
+// buffers run one channel at a time down its frames. in and out may be the same buffer.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_process_buffer(vv_dsp_biquad_bank* bank,
+                                                                 const vv_dsp_buffer* in,
+                                                                 vv_dsp_buffer* out);
+
+// Clear the state of every channel and stage
+vv_dsp_status vv_dsp_biquad_bank_reset(vv_dsp_biquad_bank* bank);
+
+// As vv_dsp_iir_plan_set_denormals(), around both process calls
+vv_dsp_status vv_dsp_biquad_bank_set_denormals(vv_dsp_biquad_bank* bank, vv_dsp_denormal_mode mode);
+
+// Destroy bank (NULL is ignored)
+void vv_dsp_biquad_bank_destroy(vv_dsp_biquad_bank* bank);
+
+// Batch of independent signals (e.g. dataset clips) through one cascade: signal i
+// (lengths[i] samples, in[i] -> out[i]) is filtered as vv_dsp_iir_apply() would filter
+// it on its own copy of biquads, starting from their z1 / z2; biquads is not modified.
+// The signals are sorted by length and packed 16 at a time into the channels of a
+// biquad bank, one per worker, so they advance together in the bank's vectorized
+// channel loop. The work is spread over num_threads workers of the default thread
+// pool (0 = one per pool thread). out[i] may equal in[i] but must not overlap another
+// signal. VV_DSP_ERROR_INVALID_SIZE without stages.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_apply_batch(const vv_dsp_biquad* biquads,
+                                                      size_t num_stages,
+                                                      const vv_dsp_real* const* in,
+                                                      vv_dsp_real* const* out,
+                                                      const size_t* lengths,
+                                                      size_t num_signals,
+                                                      size_t num_threads);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,62 @@
+/*
+ * Sliding-window statistic filters (moving mean / RMS / min / max / median)
+ */
+#ifndef VV_DSP_FILTER_MOVING_H
+#define VV_DSP_FILTER_MOVING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+/**
+ * Statistic computed over the trailing window
+ */
+typedef enum vv_dsp_moving_kind {
+    VV_DSP_MOVING_MEAN = 0,   /* running sum / count, O(1) per sample */
+    VV_DSP_MOVING_RMS = 1,    /* sqrt of the running sum of squares / count, O(1) */
+    VV_DSP_MOVING_MIN = 2,    /* monotonic deque, amortized O(1) */
+    VV_DSP_MOVING_MAX = 3,    /* monotonic deque, amortized O(1) */
+    VV_DSP_MOVING_MEDIAN = 4  /* indexed min/max double heap, O(log window) */
+} vv_dsp_moving_kind;
+
+// Streaming filter whose output at sample t is the statistic of the last
+// min(t + 1, window) inputs of the same channel (a causal, trailing window that
+// starts out partial), so
+//   vv_dsp_moving_process() over a whole signal == the statistic of every
+//   x[max(0, t - window + 1) .. t].
+// Running sums are kept in double and re-summed from the window every `window`
+// samples, so the mean and RMS do not drift on long streams. For an even number of
+// values the median is the mean of the two middle ones. MIN / MAX / MEDIAN order
+// values with <, so inputs must not contain NaN. Not thread-safe per object.
+typedef struct vv_dsp_moving vv_dsp_moving;
+
+/**
+ * Create a filter with window length window (>= 1) for num_channels (>= 1)
+ * independent channels.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_moving_create(vv_dsp_moving_kind kind,
+                                                    size_t window,
+                                                    size_t num_channels,
+                                                    vv_dsp_moving** out_filter);
+
+// Filter num_frames interleaved frames (sample c of frame t at [t * num_channels + c]),
+// streaming across calls. input and output may be the same buffer.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_moving_process(vv_dsp_moving* filter,
+                                                     const vv_dsp_real* input,
+                                                     vv_dsp_real* output,
+                                                     size_t num_frames);
+
+// Forget all past samples (the next output starts a new, partial window)
+vv_dsp_status vv_dsp_moving_reset(vv_dsp_moving* filter);
+
+// Destroy filter (NULL is ignored)
+void vv_dsp_moving_destroy(vv_dsp_moving* filter);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_MOVING_H
@@ -0,0 +1,85 @@
+/*
+ * Polyphase FIR decimator / interpolator API
+ */
+#ifndef VV_DSP_FILTER_POLYPHASE_H
+#define VV_DSP_FILTER_POLYPHASE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// The taps (e.g. from vv_dsp_fir_design_lowpass() with cutoff 1/factor) are split into
+// factor branches g_p[q] = h[q*factor + p], so only the kept outputs are ever computed.
+// Each branch runs the SIMD direct-form kernel of vv_dsp_fir_apply(). Both objects
+// stream: state carries over between calls of any length. Not thread-safe per object.
+
+// Decimator: y[m] = sum_k h[k] * x[m*factor - k], i.e. the full-rate filter output at
+// inputs 0, factor, 2*factor, ... (the first input produces an output).
+typedef struct vv_dsp_fir_decimator vv_dsp_fir_decimator;
+
+// Interpolator: zero-stuff by factor, then filter; y[r*factor + p] = sum_q h[q*factor + p]
+// * x[r - q]. The taps are used as given: scale a unity-gain lowpass by factor to keep
+// the passband level.
+typedef struct vv_dsp_fir_interpolator vv_dsp_fir_interpolator;
+
+/**
+ * Create a decimator by factor (>= 1) for coeffs[num_taps] (copied).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_decimator_create(const vv_dsp_real* coeffs,
+                                                           size_t num_taps,
+                                                           size_t factor,
+                                                           vv_dsp_fir_decimator** out_dec);
+
+// Outputs the next vv_dsp_fir_decimator_process() call with num_samples inputs will write
+size_t vv_dsp_fir_decimator_output_count(const vv_dsp_fir_decimator* dec, size_t num_samples);
+
+/**
+ * Consume num_samples inputs and write the completed outputs to output; *out_count
+ * receives their number. Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything
+ * if more than max_out outputs would be produced. input and output may be the same
+ * buffer.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_decimator_process(vv_dsp_fir_decimator* dec,
+                                                            const vv_dsp_real* input,
+                                                            size_t num_samples,
+                                                            vv_dsp_real* output,
+                                                            size_t max_out,
+                                                            size_t* out_count);
+
+// Clear history and restart the output phase
+vv_dsp_status vv_dsp_fir_decimator_reset(vv_dsp_fir_decimator* dec);
+
+// Destroy decimator (NULL is ignored)
+void vv_dsp_fir_decimator_destroy(vv_dsp_fir_decimator* dec);
+
+/**
+ * Create an interpolator by factor (>= 1) for coeffs[num_taps] (copied).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_interpolator_create(const vv_dsp_real* coeffs,
+                                                              size_t num_taps,
+                                                              size_t factor,
+                                                              vv_dsp_fir_interpolator** out_interp);
+
+/**
+ * Consume num_samples inputs and write num_samples * factor outputs.
+ * output must not overlap input.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_interpolator_process(vv_dsp_fir_interpolator* interp,
+                                                               const vv_dsp_real* input,
+                                                               size_t num_samples,
+                                                               vv_dsp_real* output);
+
+// Clear history
+vv_dsp_status vv_dsp_fir_interpolator_reset(vv_dsp_fir_interpolator* interp);
+
+// Destroy interpolator (NULL is ignored)
+void vv_dsp_fir_interpolator_destroy(vv_dsp_fir_interpolator* interp);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_POLYPHASE_H
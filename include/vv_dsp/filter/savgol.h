@@ -8,6 +8,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
 
 /**
@@ -44,6 +45,69 @@ vv_dsp_status vv_dsp_savgol(const vv_dsp_real* y,
                             vv_dsp_savgol_mode mode,
                             vv_dsp_real* output);
 
+/**
+ * Cached Savitzky–Golay kernel for repeated filtering with one parameter set.
+ *
+ * The least-squares kernel is designed once at creation. vv_dsp_savgol_plan_apply()
+ * matches vv_dsp_savgol() without re-designing the kernel or padding a copy of the
+ * signal. The streaming functions filter a signal arriving in blocks of any length
+ * with a fixed latency of window_length / 2 samples; the stream edges use
+ * VV_DSP_SAVGOL_MODE_NEAREST. A plan is not thread-safe while streaming.
+ */
+typedef struct vv_dsp_savgol_plan vv_dsp_savgol_plan;
+
+/**
+ * Create a plan; parameters are validated as in vv_dsp_savgol(). The window length
+ * is not limited by the stack kernel of vv_dsp_savgol().
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_create(int window_length,
+                                                         int polyorder,
+                                                         int deriv,
+                                                         vv_dsp_real delta,
+                                                         vv_dsp_savgol_plan** out_plan);
+
+/**
+ * Filter a whole signal of N >= window_length samples, as vv_dsp_savgol().
+ * Does not touch the streaming state; output may alias y.
+ */
+vv_dsp_status vv_dsp_savgol_plan_apply(const vv_dsp_savgol_plan* plan,
+                                       const vv_dsp_real* y,
+                                       size_t N,
+                                       vv_dsp_savgol_mode mode,
+                                       vv_dsp_real* output);
+
+// Streaming latency in samples (window_length / 2)
+size_t vv_dsp_savgol_plan_latency(const vv_dsp_savgol_plan* plan);
+
+/**
+ * Push num_samples inputs. Output j of the stream is complete once input
+ * j + latency has arrived; the completed outputs are written to output and
+ * *out_count receives their number. Returns VV_DSP_ERROR_INVALID_SIZE without
+ * consuming anything if more than max_out outputs would be produced (at most
+ * num_samples). input and output may be the same buffer.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_process(vv_dsp_savgol_plan* plan,
+                                                          const vv_dsp_real* input,
+                                                          size_t num_samples,
+                                                          vv_dsp_real* output,
+                                                          size_t max_out,
+                                                          size_t* out_count);
+
+/**
+ * End the stream: write the outputs still pending (at most latency), then reset
+ * so the plan can start a new stream.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_flush(vv_dsp_savgol_plan* plan,
+                                                        vv_dsp_real* output,
+                                                        size_t max_out,
+                                                        size_t* out_count);
+
+// Drop the streaming state without emitting the pending outputs
+vv_dsp_status vv_dsp_savgol_plan_reset(vv_dsp_savgol_plan* plan);
+
+// Destroy plan (NULL is ignored)
+void vv_dsp_savgol_plan_destroy(vv_dsp_savgol_plan* plan);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,109 @@
+/*
+ * Sub-band analysis / synthesis filterbanks (PQMF and oversampled DFT bank)
+ */
+#ifndef VV_DSP_FILTER_SUBBAND_H
+#define VV_DSP_FILTER_SUBBAND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Uniform modulated filterbanks for low-latency sub-band processing (echo cancellation,
+// multiband dynamics). All bands derive from one linear-phase lowpass prototype of
+// taps_per_band * num_bands taps, a Blackman design from vv_dsp_fir_design_lowpass()
+// whose cutoff is tuned so that adjacent bands are power complementary; analysis
+// followed by synthesis then reconstructs the input delayed by
+// vv_dsp_subband_latency() samples, up to the small residual of a near-perfect-
+// reconstruction design (about -60 dB with the default lengths).
+//
+// Each hop of decimation inputs is windowed by the time-reversed prototype and folded
+// into its polyphase components, and the folded vectors of a whole call are
+// transformed with one batched FFT; synthesis runs the same steps backwards and
+// overlap-adds the windowed result. The cost per input sample is
+// taps_per_band * num_bands / decimation multiply-adds plus the FFT share.
+//
+//  - PQMF: cosine-modulated, critically sampled (decimation = num_bands). Band k covers
+//    [k, k+1] * fs / (2 * num_bands) and each frame holds num_bands real samples. Aliasing
+//    between adjacent bands cancels in synthesis, so only moderate per-band gain changes
+//    keep the reconstruction clean. taps_per_band must be even.
+//  - DFT: complex exponential modulation with num_bands channels at a hop of decimation
+//    <= num_bands / 2 (2x or more oversampled, so aliasing stays out of the passbands and
+//    bands can be processed independently). Band k is centered on k * fs / num_bands;
+//    for real input only bands 0 .. num_bands/2 are kept and each frame holds
+//    num_bands/2 + 1 complex baseband samples (a steady tone at a band center gives a
+//    constant value there). num_bands must be even.
+//
+// Analysis and synthesis keep separate state in one object, so a processing chain runs
+// analyze -> modify frames -> synthesize. Not thread-safe per object.
+
+typedef enum {
+    VV_DSP_SUBBAND_PQMF = 0,  // pseudo-QMF cosine-modulated bank, real critically sampled bands
+    VV_DSP_SUBBAND_DFT = 1    // oversampled DFT bank, complex bands
+} vv_dsp_subband_type;
+
+typedef struct {
+    vv_dsp_subband_type type;
+    size_t num_bands;       // PQMF bands / DFT channels (>= 2)
+    size_t decimation;      // hop between frames; 0 = num_bands (PQMF) or num_bands / 2 (DFT)
+    size_t taps_per_band;   // prototype length / num_bands (>= 2), 0 = 16 (PQMF) or 8 (DFT)
+} vv_dsp_subband_params;
+
+typedef struct vv_dsp_subband vv_dsp_subband;
+
+/**
+ * Design the prototype and create a filterbank. VV_DSP_ERROR_INVALID_SIZE for
+ * num_bands < 2, an odd DFT num_bands or PQMF taps_per_band, a PQMF decimation other
+ * than num_bands, or a DFT decimation above num_bands / 2.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_subband_create(const vv_dsp_subband_params* params,
+                                                     vv_dsp_subband** out);
+
+// Destroy filterbank (NULL is ignored)
+void vv_dsp_subband_destroy(vv_dsp_subband* fb);
+
+// Clear analysis and synthesis history
+vv_dsp_status vv_dsp_subband_reset(vv_dsp_subband* fb);
+
+// Values per frame: num_bands (PQMF, real) or num_bands/2 + 1 (DFT, complex)
+size_t vv_dsp_subband_frame_size(const vv_dsp_subband* fb);
+
+// Input samples per frame (the hop) and output samples per synthesized frame
+size_t vv_dsp_subband_decimation(const vv_dsp_subband* fb);
+
+// Analysis + synthesis delay in samples: prototype length - decimation
+size_t vv_dsp_subband_latency(const vv_dsp_subband* fb);
+
+// Frames the next vv_dsp_subband_analyze() call with num_samples inputs will write
+size_t vv_dsp_subband_analysis_count(const vv_dsp_subband* fb, size_t num_samples);
+
+/**
+ * Consume num_samples real inputs and write each completed frame as a row of
+ * vv_dsp_subband_frame_size() values to frames (vv_dsp_real rows for PQMF,
+ * vv_dsp_cpx rows for DFT); *out_frames receives their number. Returns
+ * VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than max_frames
+ * frames would be produced. Chunk boundaries do not change the result.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_subband_analyze(vv_dsp_subband* fb,
+                                                      const vv_dsp_real* input,
+                                                      size_t num_samples,
+                                                      void* frames,
+                                                      size_t max_frames,
+                                                      size_t* out_frames);
+
+/**
+ * Synthesize num_frames rows laid out as vv_dsp_subband_analyze() writes them into
+ * num_frames * decimation output samples. frames and output must not overlap.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_subband_synthesize(vv_dsp_subband* fb,
+                                                         const void* frames,
+                                                         size_t num_frames,
+                                                         vv_dsp_real* output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_SUBBAND_H
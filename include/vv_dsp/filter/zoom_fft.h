@@ -0,0 +1,91 @@
+/*
+ * Zoom-FFT band analyzer: heterodyne + polyphase decimation + small FFT
+ */
+#ifndef VV_DSP_FILTER_ZOOM_FFT_H
+#define VV_DSP_FILTER_ZOOM_FFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/filter/common.h"
+
+// Narrow-band spectra of long real captures. Each input sample is mixed by a complex
+// NCO at -center_hz, the I/Q pair is lowpassed and decimated by factor with two
+// vv_dsp_fir_decimator objects, and every hop decimated samples the last fft_size
+// are windowed and transformed. The cost per input sample is two short polyphase
+// branches plus the mixer, independent of the zoom, while a CZT of the same band
+// costs O((N+M) log(N+M)) over the whole signal. Prefer it over
+// vv_dsp_czt_params_for_freq_range() once the factor reaches
+// VV_DSP_ZOOM_FFT_MIN_FACTOR.
+//
+// Output rows hold fft_size complex bins in ascending frequency,
+// f_k = center_hz + (k - fft_size/2) * sample_rate / (factor * fft_size), so bin
+// fft_size/2 is the center. Bins are normalized by the window sum: a complex tone of
+// amplitude a on a bin reads |X| = a, a real cosine a/2. The decimation filter leaves
+// the outer ~15% of the span on each side unreliable, and it delays the spectrum by
+// (num_taps - 1) / 2 input samples. Not thread-safe per object.
+
+#define VV_DSP_ZOOM_FFT_MIN_FACTOR 8
+
+typedef struct {
+    vv_dsp_real sample_rate;
+    vv_dsp_real center_hz;      // frequency mixed to DC
+    size_t factor;              // decimation (>= 1)
+    size_t fft_size;            // bins per frame (>= 2)
+    size_t hop;                 // decimated samples between frames, 0 = fft_size
+    size_t num_taps;            // decimation lowpass length, 0 = 20 * factor + 1 (unused for factor 1)
+    vv_dsp_window_type window;  // analysis window over the fft_size decimated samples
+} vv_dsp_zoom_fft_params;
+
+typedef struct vv_dsp_zoom_fft vv_dsp_zoom_fft;
+
+/**
+ * Fill params for the band [f_start, f_end] with at least num_bins bins of spacing no
+ * coarser than (f_end - f_start) / num_bins, the grid vv_dsp_czt_params_for_freq_range()
+ * would use. factor is the largest decimation that keeps the band inside the reliable
+ * span; fft_size is a power of two; hop = fft_size, Hanning window, default taps.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_zoom_fft_params_for_freq_range(vv_dsp_real f_start,
+                                                                     vv_dsp_real f_end,
+                                                                     size_t num_bins,
+                                                                     vv_dsp_real sample_rate,
+                                                                     vv_dsp_zoom_fft_params* params);
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_zoom_fft_create(const vv_dsp_zoom_fft_params* params,
+                                                      vv_dsp_zoom_fft** out);
+
+// Destroy analyzer (NULL is ignored)
+void vv_dsp_zoom_fft_destroy(vv_dsp_zoom_fft* z);
+
+// Clear filter and frame history and restart the NCO at phase 0
+vv_dsp_status vv_dsp_zoom_fft_reset(vv_dsp_zoom_fft* z);
+
+size_t vv_dsp_zoom_fft_size(const vv_dsp_zoom_fft* z);
+
+// Center frequency of output bin k (Hz)
+vv_dsp_real vv_dsp_zoom_fft_bin_freq(const vv_dsp_zoom_fft* z, size_t k);
+
+// Frames the next vv_dsp_zoom_fft_push() call with num_samples inputs will write
+size_t vv_dsp_zoom_fft_output_count(const vv_dsp_zoom_fft* z, size_t num_samples);
+
+/**
+ * Consume num_samples real inputs and write each completed frame as a row of
+ * fft_size bins to output; *out_frames receives their number. Returns
+ * VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than max_frames
+ * frames would be produced. Chunk boundaries do not change the result.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_zoom_fft_push(vv_dsp_zoom_fft* z,
+                                                    const vv_dsp_real* input,
+                                                    size_t num_samples,
+                                                    vv_dsp_cpx* output,
+                                                    size_t max_frames,
+                                                    size_t* out_frames);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_FILTER_ZOOM_FFT_H
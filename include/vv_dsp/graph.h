@@ -0,0 +1,219 @@
+/*
+ * vv-dsp block processing graph
+ */
+#ifndef VV_DSP_GRAPH_H
+#define VV_DSP_GRAPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/spectral/stft.h"
+#include "vv_dsp/features/mel.h"
+#include "vv_dsp/features/vad.h"
+
+// Block processing graph: the glue of a streaming application (framing, filters,
+// resampling, STFT analysis and resynthesis, mel projection) as a DAG of nodes that
+// wrap the library's streaming objects. Nodes take their inputs from nodes added
+// before them, so creation order is a valid schedule.
+//
+// vv_dsp_graph_prepare() fixes the largest input block and the sample rate, creates
+// every module object and sizes every edge for its worst case. A liveness planner
+// then assigns the edges to a few shared buffers: an edge's buffer returns to the
+// pool after its last consumer runs, and filters and gains work in place when they
+// are the last consumer of their input. vv_dsp_graph_process() never allocates.
+//
+// Each edge carries items of one kind: signal samples (one value each), STFT frames
+// (vv_dsp_cpx bins) or real frames (feature vectors). A block of n input samples
+// yields a varying number of items per edge (a resampler or an STFT emits what the
+// block completes), and the counts of a graph output are reported with its data.
+
+// Opaque graph handle
+typedef struct vv_dsp_graph vv_dsp_graph;
+
+// Node handle, the index of the node in creation order
+typedef size_t vv_dsp_graph_node;
+
+// What flows along an edge
+typedef enum vv_dsp_graph_stream {
+    VV_DSP_GRAPH_SIGNAL = 0,    // samples, one value per item
+    VV_DSP_GRAPH_SPECTRUM = 1,  // STFT frames of vv_dsp_cpx bins
+    VV_DSP_GRAPH_FRAMES = 2     // real vectors (power spectra, mel bands, ...)
+} vv_dsp_graph_stream;
+
+// Shape of an edge, known after vv_dsp_graph_prepare()
+typedef struct vv_dsp_graph_shape {
+    vv_dsp_graph_stream stream;
+    size_t width;          // vv_dsp_real values per item (2 per bin for SPECTRUM)
+    size_t max_items;      // most items one process call can produce
+    double item_rate;      // items per second
+} vv_dsp_graph_shape;
+
+// Buffer plan, known after vv_dsp_graph_prepare()
+typedef struct vv_dsp_graph_info {
+    size_t num_nodes;
+    size_t num_buffers;    // shared edge buffers after liveness planning
+    size_t buffer_bytes;   // bytes of those buffers
+    size_t edge_bytes;     // bytes one buffer per edge would take
+} vv_dsp_graph_info;
+
+/**
+ * Custom node: process() maps num_inputs inputs of num_items items each (all of
+ * the first input's shape) to num_items items of the same shape in out. It runs on
+ * the processing thread and must not block or allocate; out never aliases an input.
+ */
+typedef struct vv_dsp_graph_kernel {
+    vv_dsp_status (*process)(void* user,
+                             const vv_dsp_real* const* inputs,
+                             size_t num_inputs,
+                             size_t num_items,
+                             size_t width,
+                             vv_dsp_real* out);
+    void* user;
+} vv_dsp_graph_kernel;
+
+// Create an empty graph / destroy a graph and every module it owns (NULL is ignored)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_create(vv_dsp_graph** out);
+void vv_dsp_graph_destroy(vv_dsp_graph* g);
+
+// --------------- Nodes ---------------
+// Every add function copies its parameters and returns the new node in *out_node;
+// stream kinds, sizes and rates are checked by prepare. Adding a node drops an
+// earlier preparation.
+
+// The next graph input (a SIGNAL), fed by vv_dsp_graph_process()'s inputs[k] for the
+// k-th input added
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_input(vv_dsp_graph* g, vv_dsp_graph_node* out_node);
+
+// Scale any stream by gain
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_gain(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                     vv_dsp_real gain, vv_dsp_graph_node* out_node);
+
+// Element-wise sum of num_srcs streams of one shape and rate
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_sum(vv_dsp_graph* g, const vv_dsp_graph_node* srcs,
+                                                    size_t num_srcs, vv_dsp_graph_node* out_node);
+
+// FIR filter on a SIGNAL: direct form below vv_dsp_conv_get_crossover() taps, an
+// overlap-save vv_dsp_fft_convolver sized for the block above it
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_fir(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                    const vv_dsp_real* coeffs, size_t num_taps,
+                                                    vv_dsp_graph_node* out_node);
+
+// Biquad cascade on a SIGNAL (block state-space plan; the sections' state is the
+// initial state)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_biquad(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                       const vv_dsp_biquad* sections, size_t num_sections,
+                                                       vv_dsp_graph_node* out_node);
+
+// Streaming resampler on a SIGNAL, out_rate / in_rate = ratio_num / ratio_den;
+// sinc_taps 0 interpolates linearly
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_resampler(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                          unsigned int ratio_num, unsigned int ratio_den,
+                                                          unsigned int sinc_taps,
+                                                          vv_dsp_graph_node* out_node);
+
+// Streaming STFT analysis: SIGNAL -> SPECTRUM, one frame per hop as
+// vv_dsp_stft_push() / vv_dsp_stft_pop_frame()
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_stft(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                     const vv_dsp_stft_params* params,
+                                                     vv_dsp_graph_node* out_node);
+
+// Streaming overlap-add resynthesis: SPECTRUM -> SIGNAL, hop_size samples per frame
+// as vv_dsp_stft_synth_frame(); params must match the analysing STFT
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_istft(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                      const vv_dsp_stft_params* params,
+                                                      vv_dsp_graph_node* out_node);
+
+// Power spectrum: SPECTRUM -> FRAMES of |X|^2 per bin
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_power(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                      vv_dsp_graph_node* out_node);
+
+// Log-mel projection of a power spectrum of a HALF-layout STFT: FRAMES of
+// fft_size/2+1 bins -> FRAMES of n_mels values ln(mel + log_epsilon) (0 = 1e-10).
+// The filterbank comes from the shared cache at the rate of the analysed signal;
+// fmax 0 means half that rate.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_log_mel(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                        size_t n_mels, vv_dsp_real fmin, vv_dsp_real fmax,
+                                                        vv_dsp_mel_variant variant, vv_dsp_real log_epsilon,
+                                                        vv_dsp_graph_node* out_node);
+
+// User kernel over num_srcs streams of one shape and rate (see vv_dsp_graph_kernel)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_custom(vv_dsp_graph* g, const vv_dsp_graph_node* srcs,
+                                                       size_t num_srcs, const vv_dsp_graph_kernel* kernel,
+                                                       vv_dsp_graph_node* out_node);
+
+// Voice activity detection on a SIGNAL: passes it through unchanged and feeds it to
+// vad, which the graph does not own and which must outlive it. Nodes added after this
+// one and gated on vv_dsp_vad_gate() with the same detector follow the decision of
+// the block being processed.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_vad(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                    vv_dsp_vad* vad, vv_dsp_graph_node* out_node);
+
+// Expose a node's stream as graph output *out_index (0, 1, ... in call order); its
+// buffer stays valid until the next process call
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_add_output(vv_dsp_graph* g, vv_dsp_graph_node src,
+                                                       size_t* out_index);
+
+// Gate callback, asked once per process call right before the gated node would run
+typedef int (*vv_dsp_graph_gate_fn)(void* user);
+
+// Run node only while gate(user) returns nonzero (NULL removes the gate). A skipped
+// node produces no items and leaves its state alone, so a gated STFT or filter
+// resumes on the block it next runs. Every node reading a skipped node is skipped as
+// well: gating the first node of a branch (the STFT in front of an MFCC chain, say)
+// switches off the whole branch. Keeps the preparation.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_set_gate(vv_dsp_graph* g, vv_dsp_graph_node node,
+                                                     vv_dsp_graph_gate_fn gate, void* user);
+
+// --------------- Running ---------------
+
+/**
+ * Create the module objects and plan the buffers for input blocks of up to max_block
+ * samples at sample_rate Hz. May be called again to change either; resets all state.
+ * VV_DSP_ERROR_INVALID_SIZE for max_block 0, an empty graph or mismatched sizes
+ * (a sum of different widths, a mel node whose width is no HALF spectrum),
+ * VV_DSP_ERROR_OUT_OF_RANGE for streams of different rates meeting at a node.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_prepare(vv_dsp_graph* g, size_t max_block, double sample_rate);
+
+/**
+ * Run every node once over num_samples samples of each graph input (one pointer per
+ * input, num_samples <= max_block). Never allocates. VV_DSP_ERROR_INTERNAL before
+ * prepare, VV_DSP_ERROR_INVALID_SIZE for an oversized block; a failing node's status
+ * is returned as is.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_graph_process(vv_dsp_graph* g, const vv_dsp_real* const* inputs,
+                                                    size_t num_samples);
+
+// Denormal handling around vv_dsp_graph_process() (core/fp_env.h): with
+// VV_DSP_DENORMALS_FLUSH every node, custom kernels included, runs with FTZ/DAZ under
+// one save and restore per call, so filter tails in the graph never go subnormal.
+// Default VV_DSP_DENORMALS_KEEP; VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode.
+vv_dsp_status vv_dsp_graph_set_denormals(vv_dsp_graph* g, vv_dsp_denormal_mode mode);
+
+/**
+ * Items of graph output index written by the last process call (num_items * width
+ * values, item-major; SPECTRUM items are vv_dsp_cpx arrays)
+ */
+vv_dsp_status vv_dsp_graph_output(const vv_dsp_graph* g, size_t index,
+                                  const vv_dsp_real** out_data, size_t* out_items);
+
+// Shape of a node's stream after prepare
+vv_dsp_status vv_dsp_graph_node_shape(const vv_dsp_graph* g, vv_dsp_graph_node node,
+                                      vv_dsp_graph_shape* out_shape);
+
+// Buffer plan after prepare
+vv_dsp_status vv_dsp_graph_get_info(const vv_dsp_graph* g, vv_dsp_graph_info* out_info);
+
+// Clear every node's stream state (filter histories, STFT rings, resampler phase,
+// detectors)
+vv_dsp_status vv_dsp_graph_reset(vv_dsp_graph* g);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_GRAPH_H
@@ -34,6 +34,9 @@ extern "C" {
 
 #include "vv_dsp/resample/interpolate.h"  ///< Interpolation algorithms
 #include "vv_dsp/resample/resampler.h"    ///< Complete resampling systems
+#include "vv_dsp/resample/asrc.h"         ///< Variable-ratio asynchronous resampler
+#include "vv_dsp/resample/cascade.h"      ///< Multi-stage conversion for large ratios
+#include "vv_dsp/resample/fft_resample.h" ///< Offline FFT-domain resampling
 
 /**
  * @brief Dummy function for basic resample module testing
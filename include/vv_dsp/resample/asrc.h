@@ -0,0 +1,65 @@
+#ifndef VV_DSP_RESAMPLE_ASRC_H
+#define VV_DSP_RESAMPLE_ASRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Asynchronous sample-rate converter for clock-drift compensation: a streaming
+// windowed-sinc resampler whose ratio (out_rate / in_rate) is a double that may change
+// on every block, optionally ramped linearly over a number of outputs so the read
+// position never jumps. Kernels come from one oversampled table (512 fractional
+// positions, interpolated linearly) built at creation, so ratio changes never rebuild
+// anything. The anti-aliasing cutoff is fixed by the creation ratio (min(1, ratio)), so
+// the converter is meant for ratios that stay close to it (ppm-level drift).
+//
+// Like vv_dsp_resampler_process_stream(), output k is emitted once the taps / 2 - 1
+// samples after its input position have arrived; the left edge repeats the first
+// sample and vv_dsp_asrc_flush() pads the right edge with the last one.
+typedef struct vv_dsp_asrc vv_dsp_asrc; // opaque
+
+/**
+ * Create a converter with initial ratio out_rate / in_rate (finite, > 0) and taps
+ * windowed-sinc taps (clamped to 4..128 and rounded up to even).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_create(double ratio, unsigned int taps, vv_dsp_asrc** out_asrc);
+
+// Destroy converter (NULL is ignored)
+void vv_dsp_asrc_destroy(vv_dsp_asrc* asrc);
+
+/**
+ * Move to ratio (finite, > 0) linearly over the next ramp_outputs outputs (0 applies it
+ * from the next output). A new call starts its ramp from the current ratio.
+ */
+vv_dsp_status vv_dsp_asrc_set_ratio(vv_dsp_asrc* asrc, double ratio, size_t ramp_outputs);
+
+// Ratio used for the next output
+double vv_dsp_asrc_get_ratio(const vv_dsp_asrc* asrc);
+
+// Outputs the next vv_dsp_asrc_process() call with in_n inputs will write
+size_t vv_dsp_asrc_out_needed(const vv_dsp_asrc* asrc, size_t in_n);
+
+/**
+ * Consume in_n inputs and write the completed outputs (*out_n). Returns
+ * VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than out_cap outputs
+ * would be produced. out must not overlap in.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_process(vv_dsp_asrc* asrc,
+                                                   const vv_dsp_real* in, size_t in_n,
+                                                   vv_dsp_real* out, size_t out_cap,
+                                                   size_t* out_n);
+
+// End of stream: write the outputs up to the last input position, then restart
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_flush(vv_dsp_asrc* asrc, vv_dsp_real* out, size_t out_cap, size_t* out_n);
+
+// Discard the stream state; the current ratio is kept and any ramp is completed
+vv_dsp_status vv_dsp_asrc_reset(vv_dsp_asrc* asrc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_RESAMPLE_ASRC_H
@@ -0,0 +1,70 @@
+#ifndef VV_DSP_RESAMPLE_CASCADE_H
+#define VV_DSP_RESAMPLE_CASCADE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Multi-stage streaming sample-rate converter for large ratios. The planner factors
+// in_rate -> out_rate into half-band 2:1 stages plus at most one fractional
+// vv_dsp_resampler stage with a ratio in (1/2, 2): decimation runs the half-bands
+// first (192 kHz -> 8 kHz: four half-bands to 12 kHz, then 2/3), interpolation runs the
+// fractional stage first. Every stage is designed for the combined spec rather than
+// its own Nyquist: a half-band only has to keep the final passband (passband times
+// the lower Nyquist) and reject what would alias or image into it, so the early,
+// high-rate stages are very short. Half-bands are Kaiser-windowed for stopband_db
+// and skip their zero taps; the fractional stage uses the resampler's windowed sinc
+// with enough taps for the passband.
+//
+// Stages pass leading and trailing samples through like vv_dsp_resampler streaming:
+// output k sits at input position k * in_rate / out_rate, the left edge repeats the
+// first sample, and vv_dsp_resample_cascade_flush() pads with the last one.
+typedef struct vv_dsp_resample_cascade vv_dsp_resample_cascade; // opaque
+
+/**
+ * Plan and create a cascade from in_rate to out_rate (both > 0). passband is the kept
+ * fraction of the lower of the two Nyquist frequencies, in (0, 1) (e.g. 0.9);
+ * stopband_db is the half-band attenuation, in [20, 180].
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_create(unsigned int in_rate,
+                                                              unsigned int out_rate,
+                                                              double passband,
+                                                              double stopband_db,
+                                                              vv_dsp_resample_cascade** out_cascade);
+
+// Destroy cascade (NULL is ignored)
+void vv_dsp_resample_cascade_destroy(vv_dsp_resample_cascade* c);
+
+// Number of planned stages (0 when the rates are equal)
+size_t vv_dsp_resample_cascade_num_stages(const vv_dsp_resample_cascade* c);
+
+// Upper bound on the outputs of a process call with in_n inputs (in_n = 0: of a flush)
+size_t vv_dsp_resample_cascade_max_out(const vv_dsp_resample_cascade* c, size_t in_n);
+
+/**
+ * Consume in_n inputs and write the completed outputs (*out_n). out_cap must be at least
+ * vv_dsp_resample_cascade_max_out(c, in_n), otherwise VV_DSP_ERROR_INVALID_SIZE is
+ * returned without consuming anything. out must not overlap in.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_process(vv_dsp_resample_cascade* c,
+                                                               const vv_dsp_real* in, size_t in_n,
+                                                               vv_dsp_real* out, size_t out_cap,
+                                                               size_t* out_n);
+
+// End of stream: drain every stage (out_cap >= vv_dsp_resample_cascade_max_out(c, 0)),
+// then restart
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_flush(vv_dsp_resample_cascade* c,
+                                                             vv_dsp_real* out, size_t out_cap,
+                                                             size_t* out_n);
+
+// Discard the stream state of every stage
+vv_dsp_status vv_dsp_resample_cascade_reset(vv_dsp_resample_cascade* c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_RESAMPLE_CASCADE_H
@@ -0,0 +1,38 @@
+#ifndef VV_DSP_RESAMPLE_FFT_RESAMPLE_H
+#define VV_DSP_RESAMPLE_FFT_RESAMPLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Offline spectral resampling of a whole buffer: R2C of n_in samples, truncate or
+// zero-pad the spectrum to n_out / 2 + 1 bins, C2R of n_out samples. The signal is
+// treated as one period, so a band-limited periodic input is resampled exactly
+// (output k sits at input position k * n_in / n_out); other inputs see the wrap-around
+// at the edges. The Nyquist bin is split or folded as in scipy.signal.resample.
+
+// Resample in[0..n_in) to out[0..n_out); out must not overlap in
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_fft(const vv_dsp_real* in, size_t n_in,
+                                                   vv_dsp_real* out, size_t n_out);
+
+/**
+ * vv_dsp_resample_fft() with options:
+ *  - taper in [0, 1]: the top fraction of the kept band is rolled off with a raised
+ *    cosine to limit ringing from the spectral cut (0 = brick wall).
+ *  - chunk > 0: long inputs are transformed in blocks of about chunk samples, each
+ *    extended by overlap samples of context on both sides that are discarded again.
+ *    Block edges must fall on whole output samples, so blocks are multiples of
+ *    n_in / gcd(n_in, n_out) samples (coprime lengths fall back to one transform).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_fft_ex(const vv_dsp_real* in, size_t n_in,
+                                                      vv_dsp_real* out, size_t n_out,
+                                                      double taper, size_t chunk, size_t overlap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_RESAMPLE_FFT_RESAMPLE_H
@@ -28,6 +28,39 @@ vv_dsp_status vv_dsp_interpolate_cubic_real(const vv_dsp_real* x,
                                             vv_dsp_real pos,
                                             vv_dsp_real* out);
 
+// Batch forms: evaluate m query positions in one call with the edge handling of the
+// single-sample functions above and no per-sample argument checks. pos[] may be in any
+// order, but sorted positions walk x[] sequentially. out[] must not overlap x[] or pos[].
+vv_dsp_status vv_dsp_interpolate_linear_batch(const vv_dsp_real* x,
+                                              size_t n,
+                                              const vv_dsp_real* pos,
+                                              size_t m,
+                                              vv_dsp_real* out);
+
+vv_dsp_status vv_dsp_interpolate_cubic_batch(const vv_dsp_real* x,
+                                             size_t n,
+                                             const vv_dsp_real* pos,
+                                             size_t m,
+                                             vv_dsp_real* out);
+
+// Uniformly spaced queries at start + k * step (k = 0..m-1, step >= 0, positions formed
+// in double so long runs do not drift). The clamped edges are split off so the
+// interior is a branch-free counted loop the compiler can vectorize.
+// Returns VV_DSP_ERROR_OUT_OF_RANGE if start or step is not finite or step < 0.
+vv_dsp_status vv_dsp_interpolate_linear_uniform(const vv_dsp_real* x,
+                                                size_t n,
+                                                double start,
+                                                double step,
+                                                size_t m,
+                                                vv_dsp_real* out);
+
+vv_dsp_status vv_dsp_interpolate_cubic_uniform(const vv_dsp_real* x,
+                                               size_t n,
+                                               double start,
+                                               double step,
+                                               size_t m,
+                                               vv_dsp_real* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,9 @@ extern "C" {
 #endif
 
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/buffer.h"
+#include "vv_dsp/core/precision.h"
+#include "vv_dsp/core/context.h"
 
 typedef struct vv_dsp_resampler vv_dsp_resampler; // opaque
 
@@ -14,11 +17,18 @@ typedef struct vv_dsp_resampler vv_dsp_resampler; // opaque
 vv_dsp_resampler* vv_dsp_resampler_create(unsigned int ratio_num,
                                           unsigned int ratio_den);
 
+// The same starting in the context's precision mode and denormal handling
+// (core/context.h; NULL = defaults, the other fields are not used). NULL also for an
+// invalid context.
+vv_dsp_resampler* vv_dsp_resampler_create_ctx(const vv_dsp_context* ctx,
+                                              unsigned int ratio_num,
+                                              unsigned int ratio_den);
+
 // Destroy and free resources
 void vv_dsp_resampler_destroy(vv_dsp_resampler* rs);
 
 // Optionally change the fixed ratio after creation.
-// Returns VV_DSP_OK on success.
+// Returns VV_DSP_OK on success (VV_DSP_ERROR_INTERNAL if the sinc table cannot be rebuilt).
 int vv_dsp_resampler_set_ratio(vv_dsp_resampler* rs,
                                unsigned int ratio_num,
                                unsigned int ratio_den);
@@ -26,9 +36,26 @@ int vv_dsp_resampler_set_ratio(vv_dsp_resampler* rs,
 // Enable/disable sinc-based filtering and set taps (clamped to a sane range)
 // use_sinc: 0 -> linear interpolation, nonzero -> windowed-sinc
 // taps: preferred number of taps (even recommended). Returns VV_DSP_OK on success.
+// The windowed-sinc kernels are tabulated here and in set_ratio(), so processing is a
+// table lookup plus a dot product: one row per output phase when the reduced ratio
+// numerator is at most 1024 (e.g. 160 rows for 44.1k -> 48k), otherwise 256 rows that
+// are interpolated linearly.
 int vv_dsp_resampler_set_quality(vv_dsp_resampler* rs, int use_sinc, unsigned int taps);
 
-// Process real-valued input. For now, processes a whole contiguous buffer in one call.
+// Trade sinc accuracy for speed (see core/precision.h). EXACT (default) uses the taps
+// from set_quality(); BALANCED halves them and FAST quarters them, keeping at least 16
+// and 8 (or the set count when it is smaller). FAST also takes the nearest of the 256
+// interpolated rows instead of blending two. Linear interpolation is unaffected.
+// Restarts the stream like set_quality(); VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode.
+int vv_dsp_resampler_set_precision(vv_dsp_resampler* rs, vv_dsp_precision_mode mode);
+
+// Denormal handling around process_real(), process_stream() and flush() (core/fp_env.h):
+// VV_DSP_DENORMALS_FLUSH runs them with FTZ/DAZ and restores the thread's mode after.
+// Default VV_DSP_DENORMALS_KEEP; VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode.
+int vv_dsp_resampler_set_denormals(vv_dsp_resampler* rs, vv_dsp_denormal_mode mode);
+
+// Process real-valued input as one complete signal (edges clamped, endpoints mapped).
+// For chunked input use vv_dsp_resampler_process_stream() instead.
 // out_cap is the capacity of out[]; out_n receives the number of samples written.
 // Returns VV_DSP_OK on success or error codes on invalid args / insufficient capacity.
 int vv_dsp_resampler_process_real(vv_dsp_resampler* rs,
@@ -36,6 +63,119 @@ int vv_dsp_resampler_process_real(vv_dsp_resampler* rs,
                                   vv_dsp_real* out, size_t out_cap,
                                   size_t* out_n);
 
+// Batch of independent complete signals (e.g. dataset clips) with one resampler:
+// signal i (in_n[i] samples at in[i]) is resampled as vv_dsp_resampler_process_real()
+// would into out[i] (capacity out_cap[i]) and out_n[i] receives its length. All share
+// rs's ratio, quality, precision and kernel table; rs is only read (its stream state is
+// untouched) and must not be changed during the call. Signals of up to 16384 samples
+// are sorted by length and packed 8 at a time into one interleaved buffer with their
+// edges padded: each output position then fetches its kernel row once for the 8 and
+// the dot product runs across them. Longer signals run one at a time. The work is
+// spread over num_threads workers of the default thread pool (0 = one per pool thread),
+// each under rs's denormal mode. Packed outputs sum in another order than
+// process_real(), so they agree to rounding. Returns VV_DSP_ERROR_INVALID_SIZE before
+// writing anything if an out_cap is too small; empty signals give out_n[i] = 0.
+int vv_dsp_resampler_process_batch(const vv_dsp_resampler* rs,
+                                   const vv_dsp_real* const* in, const size_t* in_n,
+                                   vv_dsp_real* const* out, const size_t* out_cap,
+                                   size_t* out_n, size_t num_signals, size_t num_threads);
+
+// Streaming: the resampler keeps a history tail and the fractional output position
+// between calls, so consecutive chunks of any size produce the same samples as one
+// vv_dsp_resampler_process_real() call over their concatenation (after
+// vv_dsp_resampler_flush()), without clicks or drifting length. Output k sits at input
+// position k * ratio_den / ratio_num; it is emitted once the inputs its kernel reads
+// have arrived (taps / 2 - 1 samples of look-ahead for sinc, 1 for linear).
+// set_ratio() and set_quality() restart the stream.
+
+// Outputs the next vv_dsp_resampler_process_stream() call with in_n inputs will write
+size_t vv_dsp_resampler_out_needed(const vv_dsp_resampler* rs, size_t in_n);
+
+// Inputs still needed before the stream can write out_n more outputs
+size_t vv_dsp_resampler_in_needed(const vv_dsp_resampler* rs, size_t out_n);
+
+// Consume in_n inputs and write the completed outputs (*out_n). Returns
+// VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than out_cap outputs
+// would be produced. out must not overlap in.
+int vv_dsp_resampler_process_stream(vv_dsp_resampler* rs,
+                                    const vv_dsp_real* in, size_t in_n,
+                                    vv_dsp_real* out, size_t out_cap,
+                                    size_t* out_n);
+
+// End of stream: write the outputs up to the last input position (right edge padded
+// with the last sample), then restart the stream
+int vv_dsp_resampler_flush(vv_dsp_resampler* rs, vv_dsp_real* out, size_t out_cap, size_t* out_n);
+
+// Discard the stream state without producing output
+int vv_dsp_resampler_reset(vv_dsp_resampler* rs);
+
+// Real-time preparation (see core/alloc.h): allocate the stream buffer now instead of
+// on the first vv_dsp_resampler_process_stream() call, which then never allocates.
+// The buffer does not grow with the block, so max_block (> 0) only records the
+// preparation; set_ratio() and set_quality() keep a prepared stream's buffer large
+// enough for the new kernel.
+int vv_dsp_resampler_prepare(vv_dsp_resampler* rs, size_t max_block);
+
+// Multi-channel streaming: num_channels channels resampled in one pass with the same
+// positions and edges as the single-channel stream (each channel matches a
+// vv_dsp_resampler fed that channel alone). The phase bookkeeping and kernel fetch
+// happen once per output frame, and the dot product runs across the channels of a
+// frame, vectorized when there are at least 4 of them. Interleaved buffers hold
+// frames of num_channels samples; planar ones are arrays of num_channels pointers.
+// Counts and capacities are in frames.
+typedef struct vv_dsp_resampler_mc vv_dsp_resampler_mc; // opaque
+
+// Create with a fixed ratio as vv_dsp_resampler_create(); NULL on invalid params or OOM
+vv_dsp_resampler_mc* vv_dsp_resampler_mc_create(unsigned int ratio_num,
+                                                unsigned int ratio_den,
+                                                size_t num_channels);
+
+// Destroy and free resources
+void vv_dsp_resampler_mc_destroy(vv_dsp_resampler_mc* mc);
+
+// As vv_dsp_resampler_set_ratio() / _set_quality() / _set_precision(); all restart the stream
+int vv_dsp_resampler_mc_set_ratio(vv_dsp_resampler_mc* mc, unsigned int ratio_num, unsigned int ratio_den);
+int vv_dsp_resampler_mc_set_quality(vv_dsp_resampler_mc* mc, int use_sinc, unsigned int taps);
+int vv_dsp_resampler_mc_set_precision(vv_dsp_resampler_mc* mc, vv_dsp_precision_mode mode);
+
+// As vv_dsp_resampler_set_denormals(), around the process and flush calls
+int vv_dsp_resampler_mc_set_denormals(vv_dsp_resampler_mc* mc, vv_dsp_denormal_mode mode);
+
+// Output frames the next process call with in_frames input frames will write
+size_t vv_dsp_resampler_mc_out_needed(const vv_dsp_resampler_mc* mc, size_t in_frames);
+
+// Consume in_frames frames and write the completed output frames (*out_frames).
+// Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything if more than out_cap
+// frames would be produced. out must not overlap in.
+int vv_dsp_resampler_mc_process_interleaved(vv_dsp_resampler_mc* mc,
+                                            const vv_dsp_real* in, size_t in_frames,
+                                            vv_dsp_real* out, size_t out_cap,
+                                            size_t* out_frames);
+
+int vv_dsp_resampler_mc_process_planar(vv_dsp_resampler_mc* mc,
+                                       const vv_dsp_real* const* in, size_t in_frames,
+                                       vv_dsp_real* const* out, size_t out_cap,
+                                       size_t* out_frames);
+
+// Process a multichannel buffer (channels fixed at create); out->frames is the output
+// capacity. Interleaved buffers run the interleaved path directly; planar and strided
+// ones are read and written through their strides.
+int vv_dsp_resampler_mc_process_buffer(vv_dsp_resampler_mc* mc, const vv_dsp_buffer* in, vv_dsp_buffer* out,
+                                       size_t* out_frames);
+
+// End of stream as vv_dsp_resampler_flush()
+int vv_dsp_resampler_mc_flush_interleaved(vv_dsp_resampler_mc* mc, vv_dsp_real* out, size_t out_cap,
+                                          size_t* out_frames);
+int vv_dsp_resampler_mc_flush_planar(vv_dsp_resampler_mc* mc, vv_dsp_real* const* out, size_t out_cap,
+                                     size_t* out_frames);
+int vv_dsp_resampler_mc_flush_buffer(vv_dsp_resampler_mc* mc, vv_dsp_buffer* out, size_t* out_frames);
+
+// Discard the stream state without producing output
+int vv_dsp_resampler_mc_reset(vv_dsp_resampler_mc* mc);
+
+// As vv_dsp_resampler_prepare(), for max_block frames of the channels fixed at create
+int vv_dsp_resampler_mc_prepare(vv_dsp_resampler_mc* mc, size_t max_block);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,9 +21,14 @@ extern "C" {
  *
  * The spectral module provides comprehensive frequency domain analysis tools including:
  * - Fast Fourier Transform (FFT) with multiple backends
+ * - 2-D FFTs for modulation spectra and spectrogram image processing
  * - Short-Time Fourier Transform (STFT) for time-frequency analysis
+ * - Lazy spectrograms of long signals with an LRU tile cache
+ * - Phase vocoder time stretch and pitch shift on the streaming STFT
  * - Discrete Cosine Transform (DCT) for compression and analysis
  * - Chirp Z-Transform (CZT) for arbitrary frequency resolution
+ * - Bin banks evaluating a few selected DFT bins (Goertzel or pruned FFT)
+ * - Sliding DFT trackers updating selected bins on every sample
  * - Hilbert Transform for analytic signal generation
  * - Spectral utilities for phase manipulation and frequency shifting
  *
@@ -44,11 +49,24 @@ int vv_dsp_spectral_dummy(void);
 
 // Include all spectral analysis submodules
 #include "vv_dsp/spectral/fft.h"      ///< Fast Fourier Transform operations
+#include "vv_dsp/spectral/fft2d.h"    ///< 2-D FFT plans (row / column passes)
 #include "vv_dsp/spectral/utils.h"    ///< Spectral utilities (fftshift, ifftshift)
 #include "vv_dsp/spectral/stft.h"     ///< Short-Time Fourier Transform
+#include "vv_dsp/spectral/pvoc.h"     ///< Streaming phase vocoder (time stretch, pitch shift)
+#include "vv_dsp/spectral/denoise.h"  ///< Streaming spectral-gating noise reduction
+#include "vv_dsp/spectral/spectral_mask.h" ///< Fused streaming STFT -> mask -> ISTFT processor
+#include "vv_dsp/spectral/lazy_spectrogram.h" ///< Tiled, cached random-access spectrogram
 #include "vv_dsp/spectral/dct.h"      ///< Discrete Cosine Transform
 #include "vv_dsp/spectral/czt.h"      ///< Chirp Z-Transform
+#include "vv_dsp/spectral/bin_bank.h" ///< Goertzel / pruned-FFT evaluation of selected bins
+#include "vv_dsp/spectral/sdft.h"     ///< Sliding DFT (per-sample bin updates)
 #include "vv_dsp/spectral/hilbert.h"  ///< Hilbert Transform and analytic signals
+#include "vv_dsp/spectral/gcc_phat.h" ///< Batched GCC-PHAT time-delay estimation
+#include "vv_dsp/spectral/template_match.h" ///< Batched NCC template matching (direct / FFT numerators)
+#include "vv_dsp/spectral/fft_small.h" ///< Plan-free FFT / DCT-II kernels for sizes 8..64
+#ifdef VV_DSP_FIXED_POINT_ENABLED
+#include "vv_dsp/spectral/fft_fixed.h" ///< Block-floating-point Q15 FFT
+#endif
 
 #ifdef __cplusplus
 }
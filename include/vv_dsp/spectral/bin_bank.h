@@ -0,0 +1,77 @@
+#ifndef VV_DSP_SPECTRAL_BIN_BANK_H
+#define VV_DSP_SPECTRAL_BIN_BANK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Bin bank: evaluates a handful of DFT bins of n-sample blocks without a full FFT.
+// For each requested bin position f (in units of n-point FFT bins, fractional allowed):
+//   X[f] = sum_{j=0}^{n-1} x[j] * exp(-i*2*pi*f*j/n)
+// which equals vv_dsp_fft_execute() R2C output for integer f (forward, unscaled).
+// Typical use: tone/pilot detection needing 5-50 bins of a 4096-point spectrum.
+
+// Evaluation strategy; AUTO picks the cheapest one for (n, bins) at plan time
+typedef enum vv_dsp_bin_bank_method {
+    VV_DSP_BIN_BANK_AUTO = 0,
+    VV_DSP_BIN_BANK_GOERTZEL = 1,       // one Goertzel recurrence per bin
+    VV_DSP_BIN_BANK_GOERTZEL_SIMD = 2,  // recurrences of several bins per SIMD vector
+    VV_DSP_BIN_BANK_PRUNED_FFT = 3      // n = P*Q: Q small FFTs of size P, then only the wanted outputs
+} vv_dsp_bin_bank_method;
+
+// Opaque plan
+typedef struct vv_dsp_bin_bank_plan vv_dsp_bin_bank_plan;
+
+// Create a plan for blocks of n samples and num_bins bin positions (copied).
+// PRUNED_FFT requires every bin to be an integer in [0, n); otherwise it returns
+// VV_DSP_ERROR_OUT_OF_RANGE. GOERTZEL_SIMD degrades to GOERTZEL in builds without SIMD.
+// Goertzel states are kept in double precision. A plan owns its scratch and streaming
+// state: do not use one plan from several threads at once.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_make_plan(size_t n,
+                                                         const vv_dsp_real* bins,
+                                                         size_t num_bins,
+                                                         vv_dsp_bin_bank_method method,
+                                                         vv_dsp_bin_bank_plan** out_plan);
+
+// Same as vv_dsp_bin_bank_make_plan() with frequencies in Hz (bin = f * n / sample_rate)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_make_plan_hz(size_t n,
+                                                            const vv_dsp_real* freqs_hz,
+                                                            size_t num_freqs,
+                                                            vv_dsp_real sample_rate,
+                                                            vv_dsp_bin_bank_method method,
+                                                            vv_dsp_bin_bank_plan** out_plan);
+
+// Method chosen at plan time (never AUTO)
+vv_dsp_bin_bank_method vv_dsp_bin_bank_get_method(const vv_dsp_bin_bank_plan* plan);
+
+// Evaluate all bins of one block: in real[n], out complex[num_bins] in plan order.
+// Does not touch the streaming state.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_execute(const vv_dsp_bin_bank_plan* plan,
+                                                       const vv_dsp_real* in,
+                                                       vv_dsp_cpx* out);
+
+// Streaming: feed len samples of consecutive, non-overlapping n-sample blocks.
+// Every block completed by this call writes num_bins values to out; *out_frames
+// receives the number of blocks written. If more than max_frames blocks would be
+// completed, returns VV_DSP_ERROR_INVALID_SIZE without consuming anything.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_process(vv_dsp_bin_bank_plan* plan,
+                                                       const vv_dsp_real* in,
+                                                       size_t len,
+                                                       vv_dsp_cpx* out,
+                                                       size_t max_frames,
+                                                       size_t* out_frames);
+
+// Drop any partially accumulated block
+vv_dsp_status vv_dsp_bin_bank_reset(vv_dsp_bin_bank_plan* plan);
+
+// Destroy plan
+vv_dsp_status vv_dsp_bin_bank_destroy(vv_dsp_bin_bank_plan* plan);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_BIN_BANK_H
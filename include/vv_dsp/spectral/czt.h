@@ -7,6 +7,7 @@ extern "C" {
 
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/arena.h"
 
 // Chirp Z-Transform (CZT)
 // Evaluates X[k] = sum_{n=0}^{N-1} x[n] * A^{-n} * W^{n k},
@@ -24,7 +25,42 @@ vv_dsp_status vv_dsp_czt_params_for_freq_range(
     vv_dsp_real* W_real, vv_dsp_real* W_imag,
     vv_dsp_real* A_real, vv_dsp_real* A_imag);
 
-// CZT for complex input
+// Reusable CZT plan for fixed (N, M, W, A). Creation computes the chirps, the
+// spectrum of the Bluestein kernel and acquires the FFT plans, so each execute
+// is one forward FFT, one spectral multiply and one inverse FFT. A plan holds
+// its own work buffers: use one plan per thread.
+typedef struct vv_dsp_czt_plan vv_dsp_czt_plan;
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_plan_create(
+    size_t N,
+    size_t M,
+    vv_dsp_real W_real, vv_dsp_real W_imag,
+    vv_dsp_real A_real, vv_dsp_real A_imag,
+    vv_dsp_czt_plan** out);
+// Plan struct and buffers from arena (NULL = heap); destroy the plan before the
+// arena is reset below them
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_plan_create_ex(
+    size_t N,
+    size_t M,
+    vv_dsp_real W_real, vv_dsp_real W_imag,
+    vv_dsp_real A_real, vv_dsp_real A_imag,
+    vv_dsp_arena* arena,
+    vv_dsp_czt_plan** out);
+void vv_dsp_czt_plan_destroy(vv_dsp_czt_plan* plan);
+// Arena bytes a plan for (N, M) takes
+size_t vv_dsp_czt_scratch_size(size_t N, size_t M);
+size_t vv_dsp_czt_plan_input_size(const vv_dsp_czt_plan* plan);
+size_t vv_dsp_czt_plan_output_size(const vv_dsp_czt_plan* plan);
+
+// input: complex[N] / real[N], output: complex[M]
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_plan_execute_cpx(vv_dsp_czt_plan* plan,
+                                                           const vv_dsp_cpx* input,
+                                                           vv_dsp_cpx* output);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_plan_execute_real(vv_dsp_czt_plan* plan,
+                                                            const vv_dsp_real* input,
+                                                            vv_dsp_cpx* output);
+
+// CZT for complex input (one-shot wrapper around vv_dsp_czt_plan)
 vv_dsp_status vv_dsp_czt_exec_cpx(
     const vv_dsp_cpx* input,
     size_t N,
@@ -34,6 +70,7 @@ vv_dsp_status vv_dsp_czt_exec_cpx(
     vv_dsp_cpx* output);
 
 // Convenience CZT for real input (imag=0). Output is complex.
+// One-shot wrapper around vv_dsp_czt_plan.
 vv_dsp_status vv_dsp_czt_exec_real(
     const vv_dsp_real* input,
     size_t N,
@@ -42,6 +79,25 @@ vv_dsp_status vv_dsp_czt_exec_real(
     vv_dsp_real A_real, vv_dsp_real A_imag,
     vv_dsp_cpx* output);
 
+// The two one-shots above with the plan drawn from arena (NULL = heap) and
+// released before returning; each needs vv_dsp_czt_scratch_size(N, M) bytes
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_exec_cpx_ex(
+    const vv_dsp_cpx* input,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_real, vv_dsp_real W_imag,
+    vv_dsp_real A_real, vv_dsp_real A_imag,
+    vv_dsp_cpx* output,
+    vv_dsp_arena* arena);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_czt_exec_real_ex(
+    const vv_dsp_real* input,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_real, vv_dsp_real W_imag,
+    vv_dsp_real A_real, vv_dsp_real A_imag,
+    vv_dsp_cpx* output,
+    vv_dsp_arena* arena);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -29,6 +29,10 @@ typedef struct vv_dsp_dct_plan vv_dsp_dct_plan;
 // For type II: FORWARD computes DCT-II, BACKWARD computes the inverse (DCT-III scaling) that reconstructs x from DCT-II.
 // For type III: FORWARD computes DCT-III, BACKWARD computes its inverse (DCT-II scaling) that reconstructs x from DCT-III.
 // For type IV: FORWARD computes DCT-IV, BACKWARD computes the inverse (DCT-IV with 2/N scaling) that reconstructs x from DCT-IV.
+// Plans of length >= 8 precompute twiddles and an FFT plan (O(N log N) execute); plans of
+// length <= 64 also keep the transform as a precomputed basis matrix, used for shorter
+// single frames and for vv_dsp_dct_execute_batch(). A plan owns its scratch: do not
+// execute one plan from several threads at once.
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_make_plan(size_t n,
                                                     vv_dsp_dct_type type,
                                                     vv_dsp_dct_dir dir,
@@ -39,6 +43,15 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_execute(const vv_dsp_dct_plan* plan,
                                                   const vv_dsp_real* in,
                                                   vv_dsp_real* out);
 
+// Execute the plan on num_frames frames spaced stride elements apart (stride >= n) in both
+// in and out; out may equal in. Matrix-backed plans (n <= 64, e.g. MFCC-sized DCTs) run the
+// whole batch as one blocked SIMD matrix product; larger plans transform frame by frame.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_execute_batch(const vv_dsp_dct_plan* plan,
+                                                        const vv_dsp_real* in,
+                                                        vv_dsp_real* out,
+                                                        size_t num_frames,
+                                                        size_t stride);
+
 // Destroy plan
 vv_dsp_status vv_dsp_dct_destroy(vv_dsp_dct_plan* plan);
 
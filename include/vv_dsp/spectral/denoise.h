@@ -0,0 +1,86 @@
+#ifndef VV_DSP_SPECTRAL_DENOISE_H
+#define VV_DSP_SPECTRAL_DENOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/stft.h"
+
+// Streaming spectral-gating noise reduction on the STFT stream API, with one gain
+// mask shared by all channels.
+//
+// Every channel runs its own HALF-layout STFT handle on one shared config; frames
+// are popped in lockstep. Per frame the channels' powers are averaged per bin into
+// P, which drives a minimum-statistics noise floor (Martin): P is smoothed
+// recursively (S = 0.85 S + 0.15 P), the minimum of S is tracked over noise_window
+// frames in eight sub-windows, and the floor is 2.2 times that minimum (the
+// minimum's bias against the mean for the default window). Speech and other
+// non-stationary sound lifts S only briefly, so the floor follows the stationary
+// part. The per-bin gain is power spectral subtraction,
+// sqrt(max(1 - oversubtraction * floor / P, g_min^2)) with g_min = 10^(-reduction_db/20),
+// smoothed over frames (mask = a * mask + (1 - a) * gain), and scales every channel's
+// bins before synthesis. The mask stages run as branch-free loops over the bins on
+// split-complex scratch plus the vectorized square root.
+//
+// Latency is fixed at fft_size samples: output sample t is input sample t - fft_size
+// processed, for any block sizes. fft_size - hop_size zeros are fed ahead of the
+// stream, so the first real samples are already fully overlapped. With a mask of 1
+// everywhere (e.g. digital silence before an impulse) the output is the input delayed.
+//
+// Processing never allocates. A handle is not thread-safe.
+
+typedef struct vv_dsp_denoise vv_dsp_denoise;
+
+// Engine parameters (zero-initialize unused fields)
+typedef struct vv_dsp_denoise_params {
+    size_t fft_size;             // frame size and latency, even
+    size_t hop_size;             // at most fft_size / 2 (fft_size / 4 recommended)
+    vv_dsp_stft_window window;   // analysis/synthesis window, periodic; HANN recommended
+    size_t channels;             // >= 1, all gated by one mask
+    size_t max_block;            // largest block per process call; 0 = hop_size
+    vv_dsp_real reduction_db;    // deepest attenuation in dB (> 0); 0 = 18
+    vv_dsp_real oversubtraction; // multiple of the floor subtracted (> 0); 0 = 2
+    size_t noise_window;         // minimum-search span in frames (>= 8); 0 = 96
+    vv_dsp_real mask_smoothing;  // mask pole a in [0, 1); 0 = 0.5
+} vv_dsp_denoise_params;
+
+/**
+ * Create an engine with a noise floor of zero and a mask of one.
+ * VV_DSP_ERROR_INVALID_SIZE for an odd fft_size, a hop outside [1, fft_size / 2],
+ * no channels or a noise_window below 8; VV_DSP_ERROR_OUT_OF_RANGE for a negative
+ * reduction_db or oversubtraction or a mask_smoothing outside [0, 1).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_denoise_create(const vv_dsp_denoise_params* params, vv_dsp_denoise** out);
+vv_dsp_status vv_dsp_denoise_destroy(vv_dsp_denoise* dn);
+
+// Algorithmic latency in samples (fft_size)
+size_t vv_dsp_denoise_latency(const vv_dsp_denoise* dn);
+
+// Bins of the mask and the noise floor (fft_size / 2 + 1)
+size_t vv_dsp_denoise_num_bins(const vv_dsp_denoise* dn);
+
+/**
+ * Process n samples of every channel: in[c] and out[c] are the planar buffers of
+ * channel c, and out[c] may equal in[c]. VV_DSP_ERROR_INVALID_SIZE for n above
+ * max_block.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_denoise_process(vv_dsp_denoise* dn,
+                                                      const vv_dsp_real* const* in,
+                                                      vv_dsp_real* const* out,
+                                                      size_t n);
+
+// Copy the current mask or noise-floor power (vv_dsp_denoise_num_bins() values)
+vv_dsp_status vv_dsp_denoise_get_mask(const vv_dsp_denoise* dn, vv_dsp_real* mask);
+vv_dsp_status vv_dsp_denoise_get_noise(const vv_dsp_denoise* dn, vv_dsp_real* noise);
+
+// Drop buffered audio, the noise floor and the mask; parameters are kept
+vv_dsp_status vv_dsp_denoise_reset(vv_dsp_denoise* dn);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_DENOISE_H
@@ -17,6 +17,9 @@ extern "C" {
 #endif
 
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/typed.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/context.h"
 #include <stddef.h>
 
 /** @addtogroup spectral_group
@@ -29,12 +32,19 @@ extern "C" {
 
 /**
  * @brief FFT backend identifier
- * @details Specifies which FFT implementation to use for computations
+ * @details Specifies which FFT implementation to use for computations. cuFFT plans
+ * keep their cuFFT handles and device buffers for their lifetime, but every execute
+ * is still a host-device round trip: the backend pays off for batch plans
+ * (vv_dsp_fft_make_plan_many) and STFT spectrograms, which run entirely on the
+ * device, rather than for single short transforms.
  */
 typedef enum vv_dsp_fft_backend {
     VV_DSP_FFT_BACKEND_KISS = 0,  /**< KissFFT backend (built-in, always available) */
     VV_DSP_FFT_BACKEND_FFTW = 1,  /**< FFTW3 backend (requires FFTW3 library) */
-    VV_DSP_FFT_BACKEND_FFTS = 2   /**< FFTS backend (requires FFTS library) */
+    VV_DSP_FFT_BACKEND_FFTS = 2,  /**< FFTS backend (requires FFTS library) */
+    VV_DSP_FFT_BACKEND_CUFFT = 3, /**< cuFFT backend on the first CUDA device (requires the CUDA toolkit) */
+    VV_DSP_FFT_BACKEND_VDSP = 4,  /**< Apple Accelerate vDSP backend (Apple platforms; non-power-of-two lengths run on KissFFT) */
+    VV_DSP_FFT_BACKEND_POCKETFFT = 5 /**< PocketFFT backend (fetched at configure time; any length) */
 } vv_dsp_fft_backend;
 
 /**
@@ -99,6 +109,27 @@ vv_dsp_fft_backend vv_dsp_fft_get_backend(void);
  */
 int vv_dsp_fft_is_backend_available(vv_dsp_fft_backend backend);
 
+/**
+ * @brief Set the number of worker threads used by plans created afterwards
+ * @param nthreads Thread count (1 = single-threaded, the default)
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INVALID_SIZE if nthreads is 0
+ *
+ * @details With more than one thread, the built-in backend runs
+ * power-of-two transforms of 2^18 points or more (including the half-length
+ * engine behind even-size R2C/C2R and the convolution inside Bluestein) with
+ * a four-step algorithm whose transpose and row-FFT passes are split into
+ * nthreads chunks run on the default thread pool (core/threadpool.h). The FFTW backend forwards the count to FFTW's threaded
+ * planner when vv-dsp was built against libfftw3f_threads. Existing plans
+ * keep the count they were created with.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_num_threads(size_t nthreads);
+
+/**
+ * @brief Get the thread count applied to newly created plans
+ * @return Current thread count (at least 1)
+ */
+size_t vv_dsp_fft_get_num_threads(void);
+
 /**
  * @brief Configure FFTW planner behavior (FFTW backend only)
  * @param flag Planning strategy flag
@@ -117,12 +148,41 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag(vv_dsp_fftw_flag flag);
  * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED if FFTW not available
  *
  * @details Flushes all cached FFTW plans to reclaim memory. Future operations
- * may be slower until new plans are created and cached.
+ * may be slower until new plans are created and cached. Plans that still
+ * reference a flushed entry keep working; the entry is destroyed when the
+ * last of them is destroyed.
  *
- * @warning Should not be called while FFTW plans are being executed
+ * Cache lookups are lock-free (a per-thread recent-plan cache in front of a
+ * read-mostly hash table); only the FFTW planner calls themselves are
+ * serialized.
+ *
+ * @warning Should not be called while FFTW plans are being created
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_flush_fftw_cache(void);
 
+/**
+ * @brief Save accumulated FFTW wisdom to a file (FFTW backend only)
+ * @param path Destination file path
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the file cannot be
+ *         written, VV_DSP_ERROR_UNSUPPORTED if FFTW not available
+ *
+ * @details Wisdom records the planner measurements made under
+ * VV_DSP_FFTW_MEASURE or VV_DSP_FFTW_PATIENT, so a later process can load it
+ * with vv_dsp_fft_import_wisdom() and skip re-measuring.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_wisdom(const char* path);
+
+/**
+ * @brief Load FFTW wisdom previously saved with vv_dsp_fft_export_wisdom()
+ * @param path Source file path
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the file cannot be
+ *         read or parsed, VV_DSP_ERROR_UNSUPPORTED if FFTW not available
+ *
+ * @note Call before creating plans; plans created afterwards with the same
+ *       planner flag reuse the imported measurements
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_wisdom(const char* path);
+
 /** @} */ // End of FFT Backend Management
 
 /** @name FFT Planning and Execution
@@ -192,6 +252,24 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan(size_t n,
                                                     vv_dsp_fft_dir dir,
                                                     vv_dsp_fft_plan** out_plan);
 
+/**
+ * @brief vv_dsp_fft_make_plan() on the backend a context selects (see core/context.h)
+ * @param ctx Context (NULL = current settings); only fft_backend is used
+ * @param n Transform length
+ * @param type Transform type
+ * @param dir Transform direction
+ * @param out_plan Pointer to store the created plan
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_OUT_OF_RANGE for an unknown backend,
+ *         VV_DSP_ERROR_UNSUPPORTED for one not built in, error code otherwise
+ *
+ * @details The plan keeps that backend whatever vv_dsp_fft_set_backend() selects later.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_ctx(const vv_dsp_context* ctx,
+                                                        size_t n,
+                                                        vv_dsp_fft_type type,
+                                                        vv_dsp_fft_dir dir,
+                                                        vv_dsp_fft_plan** out_plan);
+
 /**
  * @brief Execute an FFT transform using a precomputed plan
  * @param plan FFT plan created with vv_dsp_fft_make_plan()
@@ -221,13 +299,104 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan(size_t n,
  * @endcode
  *
  * @warning Input and output buffers must not overlap unless explicitly supported
- * @note This function is thread-safe if the underlying FFT backend supports it
+ * @note Plans hold their own scratch buffers: distinct plans may be executed
+ *       concurrently, but a single plan must not be executed from several threads at once
  * @see vv_dsp_fft_make_plan(), vv_dsp_fft_destroy()
  */
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute(const vv_dsp_fft_plan* plan,
                                                   const void* in,
                                                   void* out);
 
+/**
+ * @brief vv_dsp_fft_execute() on float or double buffers in any build (see core/typed.h)
+ * @param plan FFT plan
+ * @param in Input, as for vv_dsp_fft_execute() with vv_dsp_real replaced by float
+ *           (_f32) or double (_f64) and vv_dsp_cpx by vv_dsp_cpx_f32 / vv_dsp_cpx_f64
+ * @param out Output, likewise
+ * @param arena Scratch for the conversion (NULL = heap), with
+ *              vv_dsp_fft_execute_typed_scratch_size(plan) bytes free
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details The variant of the build's precision is vv_dsp_fft_execute() and ignores
+ * arena. The other is a convenience wrapper: it converts the input into arena
+ * scratch, runs the build's transform and converts the result back, so it is slower
+ * than vv_dsp_fft_execute() and its results carry the build's rounding. With an
+ * arena it does not allocate. Transforms one contiguous vector, as
+ * vv_dsp_fft_execute() does.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f32(const vv_dsp_fft_plan* plan,
+                                                      const void* in,
+                                                      void* out,
+                                                      vv_dsp_arena* arena);
+
+/** @brief As vv_dsp_fft_execute_f32() on double / vv_dsp_cpx_f64 buffers */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f64(const vv_dsp_fft_plan* plan,
+                                                      const void* in,
+                                                      void* out,
+                                                      vv_dsp_arena* arena);
+
+/** @brief Arena bytes the other-precision variant of vv_dsp_fft_execute_f32() / _f64() needs for plan */
+size_t vv_dsp_fft_execute_typed_scratch_size(const vv_dsp_fft_plan* plan);
+
+/**
+ * @brief Query the caller workspace needed by vv_dsp_fft_execute_ws()
+ * @param plan FFT plan
+ * @param out_bytes Destination for the size in bytes (may be 0)
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED if the plan's
+ *         backend has no workspace entry point
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_workspace_size(const vv_dsp_fft_plan* plan,
+                                                         size_t* out_bytes);
+
+/**
+ * @brief Execute a transform using caller-provided scratch memory only
+ * @param plan FFT plan
+ * @param in Input buffer, as for vv_dsp_fft_execute()
+ * @param out Output buffer, as for vv_dsp_fft_execute()
+ * @param ws Workspace of at least vv_dsp_fft_workspace_size() bytes, aligned
+ *           for vv_dsp_cpx (any malloc result qualifies)
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details Performs no allocation and leaves the plan's own workspace
+ * untouched, so a single plan may be executed concurrently by threads that
+ * each pass their own @p ws. vv_dsp_fft_execute() is the single-threaded
+ * variant that uses the workspace owned by the plan.
+ *
+ * @code{.c}
+ * size_t bytes = 0;
+ * vv_dsp_fft_workspace_size(plan, &bytes);
+ * void* ws = malloc(bytes);                  // outside the audio callback
+ * vv_dsp_fft_execute_ws(plan, frame, spectrum, ws);  // inside it
+ * @endcode
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_ws(const vv_dsp_fft_plan* plan,
+                                                     const void* in,
+                                                     void* out,
+                                                     void* ws);
+
+/**
+ * @brief Execute a transform on split-complex (separate real/imaginary) buffers
+ * @param plan Single-vector FFT plan
+ * @param in_re Input real parts; the real signal itself for R2C
+ * @param in_im Input imaginary parts (ignored, may be NULL, for R2C)
+ * @param out_re Output real parts; the real signal itself for C2R
+ * @param out_im Output imaginary parts (ignored, may be NULL, for C2R)
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_UNSUPPORTED for batched plans,
+ *         error code otherwise
+ *
+ * @details Array lengths follow vv_dsp_fft_execute(): n for C2C, n/2+1 on
+ * the complex side of R2C/C2R. Scaling is identical. The FFTW backend runs a
+ * native split plan and the built-in backend converts through storage
+ * allocated with the plan; other backends convert through temporary
+ * interleaved buffers. Pair with the kernels in vv_dsp/core/split_complex.h
+ * to keep element-wise spectral stages in split layout.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_split(const vv_dsp_fft_plan* plan,
+                                                        const vv_dsp_real* in_re,
+                                                        const vv_dsp_real* in_im,
+                                                        vv_dsp_real* out_re,
+                                                        vv_dsp_real* out_im);
+
 /**
  * @brief Destroy an FFT plan and free associated resources
  * @param plan FFT plan to destroy (can be NULL)
@@ -251,8 +420,238 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute(const vv_dsp_fft_plan* plan,
  */
 vv_dsp_status vv_dsp_fft_destroy(vv_dsp_fft_plan* plan);
 
+/**
+ * @brief Create a plan that transforms many equally sized vectors in one call
+ * @param n Transform length of each vector
+ * @param type Transform type (C2C, R2C, or C2R)
+ * @param dir Transform direction (forward or backward)
+ * @param howmany Number of vectors transformed per vv_dsp_fft_execute_batch() call
+ * @param istride Distance between consecutive input elements of one vector
+ * @param idist Distance between the first input elements of consecutive vectors
+ * @param ostride Distance between consecutive output elements of one vector
+ * @param odist Distance between the first output elements of consecutive vectors
+ * @param out_plan Pointer to store the created plan
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details Strides and distances are counted in elements of the respective
+ * buffer type (vv_dsp_real for the real side of R2C/C2R, vv_dsp_cpx otherwise),
+ * following the FFTW "advanced interface" layout. Vector j, element i of the
+ * input lives at in[j*idist + i*istride]. Backends that support batching
+ * natively (FFTW) transform the whole batch with a single plan; the others
+ * loop over vectors inside the library without per-call dispatch overhead.
+ *
+ * @code{.c}
+ * // 64 frames of 512 real samples stored back to back, 257 bins per frame
+ * vv_dsp_fft_plan* plan;
+ * vv_dsp_fft_make_plan_many(512, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD,
+ *                           64, 1, 512, 1, 257, &plan);
+ * vv_dsp_fft_execute_batch(plan, frames, spectra);
+ * @endcode
+ *
+ * @note The plan also works with vv_dsp_fft_execute(), which transforms a
+ *       single contiguous vector
+ * @see vv_dsp_fft_execute_batch()
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_many(size_t n,
+                                                         vv_dsp_fft_type type,
+                                                         vv_dsp_fft_dir dir,
+                                                         size_t howmany,
+                                                         size_t istride, size_t idist,
+                                                         size_t ostride, size_t odist,
+                                                         vv_dsp_fft_plan** out_plan);
+
+/**
+ * @brief Execute all transforms described by a batched plan
+ * @param plan Plan created with vv_dsp_fft_make_plan_many() or vv_dsp_fft_make_plan()
+ * @param in Input buffer laid out as described by the plan's stride/distance
+ * @param out Output buffer laid out as described by the plan's stride/distance
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details Plans from vv_dsp_fft_make_plan() behave as a batch of one contiguous vector.
+ * @warning Input and output batches must not overlap
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_batch(const vv_dsp_fft_plan* plan,
+                                                        const void* in,
+                                                        void* out);
+
 /** @} */ // End of FFT Planning and Execution
 
+/** @name Process-wide Plan Cache
+ * @{
+ */
+
+/**
+ * @brief Snapshot of plan cache counters
+ */
+typedef struct vv_dsp_fft_cache_stats {
+    size_t hits;      /**< Acquires served from an idle cached plan */
+    size_t misses;    /**< Acquires that had to build a new plan */
+    size_t entries;   /**< Idle plans currently held by the cache */
+    size_t in_use;    /**< Plans handed out by acquire and not yet released */
+    size_t capacity;  /**< Maximum number of idle plans retained */
+} vv_dsp_fft_cache_stats;
+
+/**
+ * @brief Obtain a plan from the process-wide cache, building one on a miss
+ * @param n Transform length
+ * @param type Transform type (C2C, R2C, or C2R)
+ * @param dir Transform direction (forward or backward)
+ * @param out_plan Pointer to store the plan
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details The cache works with every backend and is keyed by (n, type, dir,
+ * backend), where backend is the one currently selected. Each acquired plan
+ * belongs to the caller until it is handed back with vv_dsp_fft_plan_release(),
+ * so it can be executed without coordinating with other threads.
+ *
+ * @code{.c}
+ * vv_dsp_fft_plan* plan;
+ * if (vv_dsp_fft_plan_acquire(512, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan) == VV_DSP_OK) {
+ *     vv_dsp_fft_execute(plan, frame, spectrum);
+ *     vv_dsp_fft_plan_release(plan);
+ * }
+ * @endcode
+ *
+ * @note Thread-safe
+ * @see vv_dsp_fft_plan_release(), vv_dsp_fft_cache_set_capacity()
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_plan_acquire(size_t n,
+                                                       vv_dsp_fft_type type,
+                                                       vv_dsp_fft_dir dir,
+                                                       vv_dsp_fft_plan** out_plan);
+
+/**
+ * @brief Return a plan obtained from vv_dsp_fft_plan_acquire() to the cache
+ * @param plan Plan to release (can be NULL)
+ * @return VV_DSP_OK on success
+ *
+ * @details The plan becomes idle and may be handed to a later acquire. If the
+ * cache is full, the least recently used idle plan is destroyed. Batched plans
+ * from vv_dsp_fft_make_plan_many() are destroyed rather than cached.
+ *
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_fft_plan_release(vv_dsp_fft_plan* plan);
+
+/**
+ * @brief Set the maximum number of idle plans kept by the cache
+ * @param capacity New capacity (0 disables caching; default 32)
+ * @return VV_DSP_OK on success
+ *
+ * @details Shrinking the capacity destroys the least recently used idle plans.
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_fft_cache_set_capacity(size_t capacity);
+
+/**
+ * @brief Read the cache counters
+ * @param out Destination for the counters
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NULL_POINTER if out is NULL
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_fft_cache_get_stats(vv_dsp_fft_cache_stats* out);
+
+/**
+ * @brief Destroy all idle cached plans and reset the hit/miss counters
+ * @return VV_DSP_OK on success
+ *
+ * @details Plans currently acquired stay valid and are still accepted by
+ * vv_dsp_fft_plan_release().
+ * @note Thread-safe
+ */
+vv_dsp_status vv_dsp_fft_cache_clear(void);
+
+/**
+ * @brief Build plans ahead of time so first use does not stall on planning
+ * @param sizes Transform lengths
+ * @param types Transform type for each entry of sizes
+ * @param count Number of entries
+ * @return VV_DSP_OK on success, error code from the first plan that fails
+ *
+ * @details Fills the process-wide plan cache for the current backend. R2C is
+ * planned forward, C2R backward, and C2C in both directions. Entries beyond
+ * the cache capacity are evicted again (the FFTW backend still keeps its
+ * planner results), so raise the capacity first when prewarming many sizes.
+ *
+ * @code{.c}
+ * const size_t sizes[] = {512, 1024, 2048};
+ * const vv_dsp_fft_type types[] = {VV_DSP_FFT_R2C, VV_DSP_FFT_R2C, VV_DSP_FFT_C2C};
+ * vv_dsp_fft_import_wisdom("fft.wisdom");        // optional, FFTW only
+ * vv_dsp_fft_prewarm(sizes, types, 3);
+ * @endcode
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_prewarm(const size_t* sizes,
+                                                 const vv_dsp_fft_type* types,
+                                                 size_t count);
+
+/** @} */ // End of Process-wide Plan Cache
+
+/** @name Backend Auto-tuning
+ * @{
+ */
+
+/**
+ * @brief Create a plan on the fastest available backend for this size
+ * @param n Transform length
+ * @param type Transform type (C2C, R2C, or C2R)
+ * @param dir Transform direction (forward or backward)
+ * @param out_plan Pointer to store the created plan
+ * @return VV_DSP_OK on success, error code on failure
+ *
+ * @details The first call for a given (n, type, dir) builds a plan on every
+ * available backend, times repeated executions, and keeps the fastest; this
+ * takes a few milliseconds per backend. The winner is remembered for the rest
+ * of the process (see vv_dsp_fft_export_tuning() to keep it across runs), so
+ * later calls cost the same as vv_dsp_fft_make_plan(). The global backend set
+ * by vv_dsp_fft_set_backend() is not changed.
+ *
+ * @note Thread-safe. Destroy the plan with vv_dsp_fft_destroy().
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_auto(size_t n,
+                                                         vv_dsp_fft_type type,
+                                                         vv_dsp_fft_dir dir,
+                                                         vv_dsp_fft_plan** out_plan);
+
+/**
+ * @brief Query the backend chosen by auto-tuning for a transform
+ * @param n Transform length
+ * @param type Transform type
+ * @param dir Transform direction
+ * @param out_backend Destination for the recorded backend
+ * @return VV_DSP_OK if a choice is recorded, VV_DSP_ERROR_OUT_OF_RANGE if the
+ *         transform has not been tuned yet
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_get_tuned_backend(size_t n,
+                                                            vv_dsp_fft_type type,
+                                                            vv_dsp_fft_dir dir,
+                                                            vv_dsp_fft_backend* out_backend);
+
+/**
+ * @brief Forget all auto-tuning results
+ * @return VV_DSP_OK
+ */
+vv_dsp_status vv_dsp_fft_clear_tuning(void);
+
+/**
+ * @brief Save auto-tuning results as a text file
+ * @param path Destination file path (for example next to the FFTW wisdom file)
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the file cannot be written
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_tuning(const char* path);
+
+/**
+ * @brief Load auto-tuning results saved by vv_dsp_fft_export_tuning()
+ * @param path Source file path
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_INTERNAL if the file is missing
+ *         or not a tuning file
+ *
+ * @details Entries naming a backend that is not available in this build are
+ * skipped, so files can be shared between differently configured builds.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_tuning(const char* path);
+
+/** @} */ // End of Backend Auto-tuning
+
 /** @} */ // End of spectral_group
 
 #ifdef __cplusplus
@@ -0,0 +1,59 @@
+#ifndef VV_DSP_SPECTRAL_FFT2D_H
+#define VV_DSP_SPECTRAL_FFT2D_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/context.h"
+
+// 2-D FFT of row-major rows x cols matrices, e.g. modulation spectra (an FFT over time
+// of every band of a spectrogram at once) and spectrogram image filtering.
+//   X[k1][k2] = sum_{r,c} x[r][c] * exp(-+i*2*pi*(k1*r/rows + k2*c/cols))
+// Buffer layouts follow the 1-D types along the rows:
+//  - C2C: in and out complex[rows * cols]
+//  - R2C: in real[rows * cols], out complex[rows * (cols/2+1)] (FORWARD only)
+//  - C2R: in complex[rows * (cols/2+1)], out real[rows * cols] (BACKWARD only)
+// Forward transforms are unscaled, backward ones scaled by 1/(rows*cols), as in 1-D.
+//
+// The FFTW backend runs a native 2-D plan. Other backends transform the rows with one
+// shared 1-D plan, then the columns in panels of a few columns, each moved through a
+// blocked transpose into contiguous rows, transformed and moved back. Both passes are
+// split across the thread pool for large matrices. A plan owns its scratch: do not
+// execute one plan from several threads at once.
+
+// Opaque plan
+typedef struct vv_dsp_fft2d_plan vv_dsp_fft2d_plan;
+
+// Create a plan on the current backend and the default thread pool.
+// VV_DSP_ERROR_OUT_OF_RANGE for R2C with BACKWARD or C2R with FORWARD.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_make_plan(size_t rows,
+                                                      size_t cols,
+                                                      vv_dsp_fft_type type,
+                                                      vv_dsp_fft_dir dir,
+                                                      vv_dsp_fft2d_plan** out_plan);
+
+// The same with the FFT backend and pool of a context (core/context.h; NULL = defaults)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_make_plan_ctx(const vv_dsp_context* ctx,
+                                                          size_t rows,
+                                                          size_t cols,
+                                                          vv_dsp_fft_type type,
+                                                          vv_dsp_fft_dir dir,
+                                                          vv_dsp_fft2d_plan** out_plan);
+
+// Transform one matrix; in and out must not overlap
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_execute(const vv_dsp_fft2d_plan* plan,
+                                                    const void* in,
+                                                    void* out);
+
+// Destroy plan (NULL is a no-op)
+vv_dsp_status vv_dsp_fft2d_destroy(vv_dsp_fft2d_plan* plan);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_FFT2D_H
@@ -0,0 +1,45 @@
+#ifndef VV_DSP_SPECTRAL_FFT_FIXED_H
+#define VV_DSP_SPECTRAL_FFT_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/fixed_point.h"
+#include "vv_dsp/spectral/fft.h"
+
+// Block-floating-point Q15 complex FFT (radix-2), available when the library is built
+// with VV_DSP_ENABLE_FIXED_POINT. Before each butterfly stage the block is checked for
+// headroom and halved only when a butterfly could overflow, so quiet signals keep
+// their precision instead of losing one bit per stage. The result satisfies
+//   X[k] = out[k] * 2^exponent
+// where X is the unscaled DFT (sum over n of x[n] e^(-+i 2 pi k n / N)) of the
+// Q15 input, e.g. exponent = log2(N) for a full-scale DC input.
+typedef struct vv_dsp_fft_q15_plan vv_dsp_fft_q15_plan;
+
+/**
+ * Create a plan for power-of-two n (2 .. 32768) in direction dir.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_q15_make_plan(size_t n,
+                                                        vv_dsp_fft_dir dir,
+                                                        vv_dsp_fft_q15_plan** out_plan);
+
+/**
+ * Transform n samples; input may equal output (in place). *out_exponent receives the
+ * block exponent (number of halvings applied).
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_q15_execute(const vv_dsp_fft_q15_plan* plan,
+                                                      const vv_dsp_cpx_q15* input,
+                                                      vv_dsp_cpx_q15* output,
+                                                      int* out_exponent);
+
+// Destroy plan (NULL is ignored)
+void vv_dsp_fft_q15_destroy(vv_dsp_fft_q15_plan* plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_SPECTRAL_FFT_FIXED_H
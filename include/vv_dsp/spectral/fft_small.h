@@ -0,0 +1,40 @@
+#ifndef VV_DSP_SPECTRAL_FFT_SMALL_H
+#define VV_DSP_SPECTRAL_FFT_SMALL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/fft.h"
+
+// Plan-free kernels for the power-of-two sizes 8 .. VV_DSP_FFT_SMALL_MAX, one function
+// per size with the twiddles compiled in as constants: no plan lookup, no backend
+// dispatch, no tables and no allocation. KissFFT plans of these sizes (and the even
+// R2C/C2R plans of twice these sizes, which run an n/2-point complex transform) use
+// the same kernels automatically; call these directly to also skip the plan layer
+// in block transforms. Scaling follows fft.h: forward unscaled, backward 1/n.
+#define VV_DSP_FFT_SMALL_MAX 64
+
+// Complex DFT of n points; in may equal out. VV_DSP_ERROR_UNSUPPORTED for other n.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_small(size_t n, vv_dsp_fft_dir dir,
+                                                const vv_dsp_cpx* in, vv_dsp_cpx* out);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_small_8(const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_fft_dir dir);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_small_16(const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_fft_dir dir);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_small_32(const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_fft_dir dir);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_small_64(const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_fft_dir dir);
+
+// DCT-II of n points as defined in dct.h (X[k] = sum x[j] cos(pi/n (j+0.5) k), unscaled);
+// in may equal out. Unlike vv_dsp_dct_execute() no NaN policy is applied.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct2_small(size_t n, const vv_dsp_real* in, vv_dsp_real* out);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct2_small_8(const vv_dsp_real* in, vv_dsp_real* out);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct2_small_16(const vv_dsp_real* in, vv_dsp_real* out);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct2_small_32(const vv_dsp_real* in, vv_dsp_real* out);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct2_small_64(const vv_dsp_real* in, vv_dsp_real* out);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_FFT_SMALL_H
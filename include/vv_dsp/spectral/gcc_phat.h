@@ -0,0 +1,68 @@
+#ifndef VV_DSP_SPECTRAL_GCC_PHAT_H
+#define VV_DSP_SPECTRAL_GCC_PHAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Batched GCC-PHAT time-delay estimation for every channel pair of a multichannel
+// frame. Each channel is R2C-transformed once per frame and whitened to unit
+// magnitude, so a pair's PHAT-weighted cross-spectrum is a plain conjugate product.
+// Only the lag window [-max_lag, max_lag] is inverse-transformed: by a partial real
+// inverse DFT against a precomputed table when the window is narrow, by a full C2R
+// otherwise. Frames are split into contiguous runs across the engine's workers, each
+// with its own FFT plans and aligned scratch; one engine serves one call at a time.
+//
+// Pairs are ordered (0,1), (0,2), ..., (0,C-1), (1,2), ..., (C-2,C-1). For pair (a,b)
+// the correlation at lag t is sum_n x_a[n] x_b[n + t] (whitened), so a positive delay
+// means channel b lags channel a.
+typedef struct vv_dsp_gcc_phat vv_dsp_gcc_phat;
+
+typedef struct vv_dsp_gcc_phat_params {
+    size_t num_channels;  // >= 2
+    size_t frame_len;     // samples per channel and frame
+    size_t max_lag;       // lag window half-width, < frame_len
+    size_t fft_size;      // 0 = next power of two >= frame_len + max_lag
+    size_t num_threads;   // pool workers for process, 0 = one per pool thread
+} vv_dsp_gcc_phat_params;
+
+// VV_DSP_ERROR_INVALID_SIZE for fewer than two channels, frame_len 0, max_lag >=
+// frame_len or an fft_size below frame_len + max_lag (the window would wrap)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_gcc_phat_create(const vv_dsp_gcc_phat_params* params,
+                                                      vv_dsp_gcc_phat** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_gcc_phat_destroy(vv_dsp_gcc_phat* g);
+
+// num_channels * (num_channels - 1) / 2
+size_t vv_dsp_gcc_phat_num_pairs(const vv_dsp_gcc_phat* g);
+
+// 2 * max_lag + 1 correlation values per pair, lag -max_lag first
+size_t vv_dsp_gcc_phat_lag_count(const vv_dsp_gcc_phat* g);
+
+/**
+ * Analyse num_frames frames of planar input: channel c of frame f starts at
+ * x + f * hop + c * channel_stride and holds frame_len samples. Any output may be
+ * NULL; each receives num_frames rows of num_pairs entries:
+ *  - corr:  lag_count values per pair (the whitened cross-correlation)
+ *  - delay: peak lag in samples, refined by a parabola through the peak and its
+ *           neighbours (not refined at the window edges)
+ *  - peak:  correlation value at the integer peak (at most 1 in magnitude)
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_gcc_phat_process(vv_dsp_gcc_phat* g,
+                                                       const vv_dsp_real* x,
+                                                       size_t num_frames,
+                                                       size_t hop,
+                                                       size_t channel_stride,
+                                                       vv_dsp_real* corr,
+                                                       vv_dsp_real* delay,
+                                                       vv_dsp_real* peak);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_SPECTRAL_GCC_PHAT_H
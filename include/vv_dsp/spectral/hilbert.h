@@ -7,13 +7,40 @@ extern "C" {
 
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/arena.h"
 
 // Compute analytic signal of a real-valued input using FFT-based Hilbert transform.
 // input: real[N]
 // analytic_output: complex[N]
 // Returns VV_DSP_OK on success; error code otherwise.
+// One-shot wrapper that builds and discards a vv_dsp_hilbert_plan.
 vv_dsp_status vv_dsp_hilbert_analytic(const vv_dsp_real* input, size_t N, vv_dsp_cpx* analytic_output);
 
+// Same with the plan and its buffer drawn from arena (NULL = heap) and released
+// before returning; needs vv_dsp_hilbert_scratch_size(N) bytes of it.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_analytic_ex(const vv_dsp_real* input, size_t N,
+                                                          vv_dsp_cpx* analytic_output, vv_dsp_arena* arena);
+size_t vv_dsp_hilbert_scratch_size(size_t N);
+
+// Reusable analytic-signal plan for length N: an R2C transform writes the half
+// spectrum into the plan's single N-point buffer, which is turned into the analytic
+// spectrum in place and inverse-transformed (C2C) straight into analytic_output.
+// Execution allocates nothing; a plan serves one call at a time.
+typedef struct vv_dsp_hilbert_plan vv_dsp_hilbert_plan;
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_plan_create(size_t N, vv_dsp_hilbert_plan** out);
+// Plan struct and buffer from arena (NULL = heap); destroy the plan before the
+// arena is reset below them
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_plan_create_ex(size_t N, vv_dsp_arena* arena,
+                                                             vv_dsp_hilbert_plan** out);
+void vv_dsp_hilbert_plan_destroy(vv_dsp_hilbert_plan* plan);
+size_t vv_dsp_hilbert_plan_size(const vv_dsp_hilbert_plan* plan);
+
+// input: real[N], analytic_output: complex[N] (must not alias the plan's buffer)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_plan_execute(vv_dsp_hilbert_plan* plan,
+                                                           const vv_dsp_real* input,
+                                                           vv_dsp_cpx* analytic_output);
+
 // Compute instantaneous phase (radians) from analytic signal and unwrap it.
 // analytic_input: complex[N]
 // phase_output: real[N] (unwrapped phase)
@@ -27,6 +54,45 @@ vv_dsp_status vv_dsp_instantaneous_frequency(const vv_dsp_real* unwrapped_phase_
                                              double sample_rate,
                                              vv_dsp_real* freq_output);
 
+// Streaming analytic signal through a windowed (Blackman) FIR Hilbert transformer
+// of num_taps = 2M + 1 taps. Only odd offsets from the centre are nonzero and the
+// taps are antisymmetric, so each output needs (M + 1) / 2 multiplies:
+//   imag[t] = sum_{n odd} h[n] (x[t - M - n] - x[t - M + n])
+// The real branch is x delayed by the same M samples, so output t is the analytic
+// sample for input t - M (fixed latency M; the first M outputs come from the zero
+// history). Block sizes are free and results do not depend on them; processing
+// never allocates.
+typedef struct vv_dsp_hilbert_fir vv_dsp_hilbert_fir;
+
+// num_taps odd and >= 3 (VV_DSP_ERROR_INVALID_SIZE otherwise)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_fir_create(size_t num_taps, vv_dsp_hilbert_fir** out);
+void vv_dsp_hilbert_fir_destroy(vv_dsp_hilbert_fir* h);
+
+// Samples of delay between input and output (M)
+size_t vv_dsp_hilbert_fir_latency(const vv_dsp_hilbert_fir* h);
+
+// Analytic samples for n new inputs
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_fir_process(vv_dsp_hilbert_fir* h,
+                                                          const vv_dsp_real* input,
+                                                          size_t n,
+                                                          vv_dsp_cpx* analytic_output);
+
+// As vv_dsp_hilbert_fir_process, reduced to amplitude envelope, unwrapped phase
+// (radians) and instantaneous frequency (Hz) with the same conjugate-product
+// unwrapping as vv_dsp_instantaneous_phase/frequency, carried across calls so
+// block boundaries leave no seams (the very first frequency is 0). Any output
+// may be NULL.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_hilbert_fir_track(vv_dsp_hilbert_fir* h,
+                                                        const vv_dsp_real* input,
+                                                        size_t n,
+                                                        double sample_rate,
+                                                        vv_dsp_real* amplitude_output,
+                                                        vv_dsp_real* phase_output,
+                                                        vv_dsp_real* freq_output);
+
+// Clear the history and the phase tracker
+vv_dsp_status vv_dsp_hilbert_fir_reset(vv_dsp_hilbert_fir* h);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
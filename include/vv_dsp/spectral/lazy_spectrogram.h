@@ -0,0 +1,118 @@
+#ifndef VV_DSP_SPECTRAL_LAZY_SPECTROGRAM_H
+#define VV_DSP_SPECTRAL_LAZY_SPECTROGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/stft.h"
+
+// Lazy, random-access spectrogram of a long signal for viewers and editors. Rows are
+// exactly those of vv_dsp_stft_spectrogram_ex() on the whole signal (same framing,
+// zero padding at the end, scale and mel projection), but nothing is computed until
+// a frame range is requested.
+//
+// Frames are grouped into tiles of tile_frames rows. A request computes the tiles it
+// touches that are not cached, plus up to `prefetch` uncached neighbours on each side
+// (following tiles first), in one fork-join over the thread pool with one STFT handle
+// per worker on a shared config. Tiles live in a fixed set of slots sized by
+// cache_bytes and are evicted least recently used first. Editing the signal only
+// drops the tiles whose frames overlap the edited samples.
+//
+// A backing source (for instance a binary feature store written in an earlier
+// session, see vv_dsp_feature_store_fetch() in audio/feature_store.h) is asked for a
+// tile before it is computed. Tiles touched by an invalidation are never taken from
+// it again, since it describes the signal before the edit.
+//
+// The signal is kept by reference. Not thread-safe per object; the backing source is
+// called from the pool's workers and must be thread-safe.
+
+typedef struct vv_dsp_lazy_spectrogram vv_dsp_lazy_spectrogram;
+
+/**
+ * Backing source: fill num_frames rows of row_size values starting at first_frame
+ * into out and return nonzero, or return 0 to have the rows computed.
+ */
+typedef int (*vv_dsp_spectrogram_fetch_fn)(void* user,
+                                           size_t first_frame,
+                                           size_t num_frames,
+                                           size_t row_size,
+                                           vv_dsp_real* out);
+
+// Parameters (zero-initialize unused fields)
+typedef struct vv_dsp_lazy_spectrogram_params {
+    vv_dsp_stft_params stft;       // framing, window and row layout
+    vv_dsp_spectrogram_opts opts;  // row transform; mel weights are kept by reference
+    size_t tile_frames;            // frames per tile, 0 = 64
+    size_t cache_bytes;            // budget of the tile slots (at least one slot), 0 = 64 MiB
+    size_t prefetch;               // uncached neighbour tiles computed per side; 0 = none
+    size_t num_threads;            // workers on the default pool, 0 = one per pool thread
+} vv_dsp_lazy_spectrogram_params;
+
+// Cache counters since creation
+typedef struct vv_dsp_lazy_spectrogram_stats {
+    size_t hits;           // requested tiles found cached
+    size_t computed;       // tiles computed (requested or prefetched)
+    size_t fetched;        // tiles served by the backing source
+    size_t evicted;        // tiles dropped to make room
+    size_t invalidated;    // cached tiles dropped by edits
+    size_t cached;         // tiles cached now
+} vv_dsp_lazy_spectrogram_stats;
+
+/**
+ * Create over n samples of signal (kept by reference). VV_DSP_ERROR_INVALID_SIZE for
+ * a zero fft_size or hop, the errors of vv_dsp_stft_config_create() and of the opts
+ * as vv_dsp_stft_spectrogram_ex() reports them.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_create(const vv_dsp_lazy_spectrogram_params* params,
+                                                              const vv_dsp_real* signal,
+                                                              size_t n,
+                                                              vv_dsp_lazy_spectrogram** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_lazy_spectrogram_destroy(vv_dsp_lazy_spectrogram* ls);
+
+// Rows of the whole signal (vv_dsp_stft_spectrogram_frames()) and values per row
+size_t vv_dsp_lazy_spectrogram_num_frames(const vv_dsp_lazy_spectrogram* ls);
+size_t vv_dsp_lazy_spectrogram_row_size(const vv_dsp_lazy_spectrogram* ls);
+
+// Set the backing source (NULL fetch removes it)
+vv_dsp_status vv_dsp_lazy_spectrogram_set_backing(vv_dsp_lazy_spectrogram* ls,
+                                                  vv_dsp_spectrogram_fetch_fn fetch,
+                                                  void* user);
+
+/**
+ * Copy rows [first_frame, first_frame + num_frames) into out (row-major), computing
+ * what is not cached. A range larger than the cache is served in slices.
+ * VV_DSP_ERROR_OUT_OF_RANGE for rows past the end.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_get(vv_dsp_lazy_spectrogram* ls,
+                                                           size_t first_frame,
+                                                           size_t num_frames,
+                                                           vv_dsp_real* out);
+
+// Samples [first_sample, first_sample + num_samples) changed in place: drop the tiles
+// with a frame overlapping them
+vv_dsp_status vv_dsp_lazy_spectrogram_invalidate(vv_dsp_lazy_spectrogram* ls,
+                                                 size_t first_sample,
+                                                 size_t num_samples);
+
+/**
+ * Point at a new buffer of n samples, e.g. after an insertion or a reallocation.
+ * Samples from min(old n, n) on count as edited; an edit that moves earlier samples
+ * must be invalidated by the caller as well.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_set_signal(vv_dsp_lazy_spectrogram* ls,
+                                                                  const vv_dsp_real* signal,
+                                                                  size_t n);
+
+vv_dsp_status vv_dsp_lazy_spectrogram_get_stats(const vv_dsp_lazy_spectrogram* ls,
+                                                vv_dsp_lazy_spectrogram_stats* stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_LAZY_SPECTROGRAM_H
@@ -0,0 +1,79 @@
+#ifndef VV_DSP_SPECTRAL_PVOC_H
+#define VV_DSP_SPECTRAL_PVOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/precision.h"
+#include "vv_dsp/spectral/stft.h"
+
+// Streaming phase vocoder: time stretch and pitch shift at arbitrary, changeable
+// ratios with fixed latency, on a HALF-layout STFT handle.
+//
+// The vocoder stretches time by stretch * pitch: synthesis frames advance by hop_size
+// while analysis frames advance by hop_size / (stretch * pitch) on average (integer
+// hops, the fraction carried over). Each bin's instantaneous frequency comes from its
+// phase advance over the actual analysis hop against the precomputed nominal advance.
+// Identity phase locking (Laroche & Dolson): spectral peaks advance their synthesis
+// phase by their own frequency, and the other bins of a peak's region keep their
+// analysis phase offset to it. The stretched stream is then read pitch samples per
+// output sample with cubic interpolation, which restores the duration to stretch times
+// the input and scales every frequency by pitch; for pitch > 1 the synthesis spectrum
+// is band-limited first so nothing folds over. At stretch 1 and pitch 1 the output
+// reproduces the input.
+//
+// Push, pull and ratio changes never allocate. A handle is one voice and is not
+// thread-safe; independent voices may run on different threads.
+
+typedef struct vv_dsp_pvoc vv_dsp_pvoc;
+
+// Engine parameters (zero-initialize unused fields)
+typedef struct vv_dsp_pvoc_params {
+    size_t fft_size;             // frame size, even
+    size_t hop_size;             // synthesis hop, at most fft_size / 2 (fft_size / 4 recommended)
+    vv_dsp_stft_window window;   // analysis/synthesis window, periodic; HANN recommended
+    size_t max_block;            // largest push; 0 = hop_size
+} vv_dsp_pvoc_params;
+
+// Create with stretch 1, pitch 1 and the EXACT precision mode.
+// VV_DSP_ERROR_INVALID_SIZE for an odd fft_size or a hop outside [1, fft_size / 2].
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_create(const vv_dsp_pvoc_params* params, vv_dsp_pvoc** out);
+vv_dsp_status vv_dsp_pvoc_destroy(vv_dsp_pvoc* pv);
+
+// Time ratio stretch (output duration / input duration) and frequency ratio pitch in
+// [0.25, 4]; stretch * pitch must be at least hop_size / fft_size. Applies from the next pulled
+// hop on; VV_DSP_ERROR_OUT_OF_RANGE otherwise.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_set_ratio(vv_dsp_pvoc* pv, double stretch, double pitch);
+
+// Accuracy of the phase (atan2) and resynthesis (sin / cos) steps (see
+// core/precision.h): EXACT takes libm, BALANCED and FAST the vmath tiers.
+// VV_DSP_ERROR_OUT_OF_RANGE for an unknown mode.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_set_precision(vv_dsp_pvoc* pv, vv_dsp_precision_mode mode);
+
+// Append n input samples. VV_DSP_ERROR_INVALID_SIZE without consuming anything when
+// they do not fit (vv_dsp_pvoc_input_space()); pushes of up to max_block always fit
+// once every ready hop has been pulled.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_push(vv_dsp_pvoc* pv, const vv_dsp_real* samples, size_t n);
+
+// Free input space in samples
+size_t vv_dsp_pvoc_input_space(const vv_dsp_pvoc* pv);
+
+// Output hops that can be pulled at the current ratios with the input buffered
+size_t vv_dsp_pvoc_hops_ready(const vv_dsp_pvoc* pv);
+
+// Write the next hop_size output samples. Output sample t lines up with input sample
+// t / stretch; the first fft_size - hop_size samples ramp in. VV_DSP_ERROR_INVALID_SIZE
+// when no hop is ready.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_pull(vv_dsp_pvoc* pv, vv_dsp_real* out_hop);
+
+// Drop buffered input and all phase state; ratios and precision are kept
+vv_dsp_status vv_dsp_pvoc_reset(vv_dsp_pvoc* pv);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_PVOC_H
@@ -0,0 +1,69 @@
+#ifndef VV_DSP_SPECTRAL_SDFT_H
+#define VV_DSP_SPECTRAL_SDFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Sliding DFT: K selected bins of an N-sample window, updated on every sample (hop 1)
+// in O(1) per bin. After sample t the tracker holds
+//   X_k[t] = sum_{j=0}^{N-1} x[t-N+1+j] * exp(-i*2*pi*k*j/N)
+// i.e. the unscaled forward DFT of the most recent N samples (zeros before the first
+// sample), matching vv_dsp_fft_execute() on that window.
+
+typedef enum vv_dsp_sdft_variant {
+    // Classic resonator X = exp(i*2*pi*k/N) * (X + x[t] - x[t-N]). Poles sit on the unit
+    // circle, so rounding errors are never forgotten; fine for moderate run lengths.
+    VV_DSP_SDFT_STANDARD = 0,
+    // Damped resonator X = exp(i*2*pi*k/N) * (r*X + x[t] - r^N*x[t-N]) with 0 < r < 1:
+    // unconditionally stable, but the window becomes exponentially weighted, each sample
+    // scaled by r^(age), age = t - tau in [0, N).
+    VV_DSP_SDFT_DAMPED = 1,
+    // Modulated SDFT (mSDFT): the recursion runs on a modulated signal with a unit
+    // coefficient and table twiddles, so there is no accumulated twiddle error and the
+    // output is the plain rectangular-window DFT. Bins are updated with table lookups
+    // (scalar loop) instead of SIMD.
+    VV_DSP_SDFT_MODULATED = 2
+} vv_dsp_sdft_variant;
+
+// Opaque plan; not safe to share between threads
+typedef struct vv_dsp_sdft_plan vv_dsp_sdft_plan;
+
+// Create a tracker for window length n and num_bins integer bins (each < n, copied).
+// damping is r for VV_DSP_SDFT_DAMPED (0 < r < 1) and ignored by the other variants.
+// Recursive state is kept in double precision.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_make_plan(size_t n,
+                                                     const size_t* bins,
+                                                     size_t num_bins,
+                                                     vv_dsp_sdft_variant variant,
+                                                     vv_dsp_real damping,
+                                                     vv_dsp_sdft_plan** out_plan);
+
+// Push one sample
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_update(vv_dsp_sdft_plan* plan, vv_dsp_real sample);
+
+// Push len samples. When out is non-NULL it receives len * num_bins values:
+// the bins after each sample, sample-major (out[t * num_bins + b]).
+// The standard and damped variants update all bins with SIMD across bins.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_process(vv_dsp_sdft_plan* plan,
+                                                   const vv_dsp_real* in,
+                                                   size_t len,
+                                                   vv_dsp_cpx* out);
+
+// Current value of every bin, in plan order (num_bins values)
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_get_bins(const vv_dsp_sdft_plan* plan, vv_dsp_cpx* out);
+
+// Clear the window and all bins
+vv_dsp_status vv_dsp_sdft_reset(vv_dsp_sdft_plan* plan);
+
+// Destroy plan
+vv_dsp_status vv_dsp_sdft_destroy(vv_dsp_sdft_plan* plan);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_SDFT_H
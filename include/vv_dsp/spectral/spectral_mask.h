@@ -0,0 +1,94 @@
+#ifndef VV_DSP_SPECTRAL_SPECTRAL_MASK_H
+#define VV_DSP_SPECTRAL_SPECTRAL_MASK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/stft.h"
+
+// Streaming STFT -> mask -> ISTFT processor for spectral effects (gates, separation
+// masks), fused on the STFT stream API.
+//
+// Every channel runs its own HALF-layout STFT handle on one shared config. Per frame
+// and channel the R2C output lands in one aligned buffer of fft_size / 2 + 1 bins,
+// the mask is applied there in place and the C2R plus overlap-add reads it back, so
+// a hop costs one pass over the bins and no full-spectrum copies. The buffer is
+// shared by the channels, which are processed one after the other.
+//
+// The mask is one of:
+//  - a real gain per bin (the default, all ones),
+//  - a complex gain per bin,
+//  - a callback that rewrites the bins of each channel's frame in place.
+// Real and complex masks are copied at set time and shared by all channels; a
+// callback sees the channel index and can apply per-channel or per-frame masks
+// (e.g. from a model run on the frame). Masks are applied as given: the analysis
+// and synthesis windows are the STFT's, so a mask of one reconstructs the input.
+//
+// Latency is fixed at fft_size samples: output sample t is input sample t - fft_size
+// processed, for any block sizes (fft_size - hop_size zeros are fed ahead of the
+// stream, as in denoise.h).
+//
+// Processing never allocates. A handle is not thread-safe.
+
+typedef struct vv_dsp_spectral_mask vv_dsp_spectral_mask;
+
+/**
+ * Per-frame mask callback: rewrite bins[0 .. num_bins) of channel's current frame
+ * in place. A status other than VV_DSP_OK stops the process call and is returned
+ * by it.
+ */
+typedef vv_dsp_status (*vv_dsp_spectral_mask_fn)(void* user, size_t channel, vv_dsp_cpx* bins, size_t num_bins);
+
+// Processor parameters (zero-initialize unused fields)
+typedef struct vv_dsp_spectral_mask_params {
+    size_t fft_size;             // frame size and latency, even
+    size_t hop_size;             // at most fft_size / 2
+    vv_dsp_stft_window window;   // analysis/synthesis window, periodic; HANN recommended
+    size_t channels;             // >= 1
+    size_t max_block;            // largest block per process call; 0 = hop_size
+} vv_dsp_spectral_mask_params;
+
+/**
+ * Create a processor with a real mask of one.
+ * VV_DSP_ERROR_INVALID_SIZE for an odd fft_size or one below 4, a hop outside
+ * [1, fft_size / 2] or no channels.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_mask_create(const vv_dsp_spectral_mask_params* params,
+                                                           vv_dsp_spectral_mask** out);
+vv_dsp_status vv_dsp_spectral_mask_destroy(vv_dsp_spectral_mask* sm);
+
+// Algorithmic latency in samples (fft_size)
+size_t vv_dsp_spectral_mask_latency(const vv_dsp_spectral_mask* sm);
+
+// Bins per frame (fft_size / 2 + 1)
+size_t vv_dsp_spectral_mask_num_bins(const vv_dsp_spectral_mask* sm);
+
+// Switch to a real or complex per-bin mask (vv_dsp_spectral_mask_num_bins() values,
+// copied). May be called between process calls to change the mask.
+vv_dsp_status vv_dsp_spectral_mask_set_real(vv_dsp_spectral_mask* sm, const vv_dsp_real* mask);
+vv_dsp_status vv_dsp_spectral_mask_set_complex(vv_dsp_spectral_mask* sm, const vv_dsp_cpx* mask);
+
+// Switch to a callback run on every frame of every channel
+vv_dsp_status vv_dsp_spectral_mask_set_callback(vv_dsp_spectral_mask* sm, vv_dsp_spectral_mask_fn fn, void* user);
+
+/**
+ * Process n samples of every channel: in[c] and out[c] are the planar buffers of
+ * channel c, and out[c] may equal in[c]. VV_DSP_ERROR_INVALID_SIZE for n above
+ * max_block.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_mask_process(vv_dsp_spectral_mask* sm,
+                                                            const vv_dsp_real* const* in,
+                                                            vv_dsp_real* const* out,
+                                                            size_t n);
+
+// Drop buffered audio; parameters and the mask are kept
+vv_dsp_status vv_dsp_spectral_mask_reset(vv_dsp_spectral_mask* sm);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // VV_DSP_SPECTRAL_SPECTRAL_MASK_H
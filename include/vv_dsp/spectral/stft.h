@@ -8,37 +8,99 @@ extern "C" {
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core.h"
 
 // Opaque STFT handle
 typedef struct vv_dsp_stft vv_dsp_stft;
 
-// Window type for STFT analysis/synthesis
+// Window type for STFT analysis/synthesis (the window.h family)
 typedef enum vv_dsp_stft_window {
     VV_DSP_STFT_WIN_BOXCAR = 0,
     VV_DSP_STFT_WIN_HANN   = 1,
-    VV_DSP_STFT_WIN_HAMMING= 2
+    VV_DSP_STFT_WIN_HAMMING= 2,
+    VV_DSP_STFT_WIN_BLACKMAN = 3,
+    VV_DSP_STFT_WIN_BLACKMAN_HARRIS = 4,
+    VV_DSP_STFT_WIN_NUTTALL = 5,
+    VV_DSP_STFT_WIN_FLATTOP = 6,
+    VV_DSP_STFT_WIN_KAISER = 7,        // window_param = beta
+    VV_DSP_STFT_WIN_TUKEY = 8,         // window_param = alpha
+    VV_DSP_STFT_WIN_BARTLETT = 9,
+    VV_DSP_STFT_WIN_BOHMAN = 10,
+    VV_DSP_STFT_WIN_COSINE = 11,
+    VV_DSP_STFT_WIN_PLANCK_TAPER = 12
 } vv_dsp_stft_window;
 
-// STFT configuration parameters
+// Spectrum layout exchanged by process/reconstruct/spectrogram
+typedef enum vv_dsp_stft_spectrum {
+    VV_DSP_STFT_SPECTRUM_FULL = 0, // fft_size complex bins
+    VV_DSP_STFT_SPECTRUM_HALF = 1  // fft_size/2+1 Hermitian bins (R2C/C2R, half the FFT work)
+} vv_dsp_stft_spectrum;
+
+// STFT configuration parameters (zero-initialize unused fields)
 typedef struct vv_dsp_stft_params {
     size_t fft_size;   // FFT size (frame size)
     size_t hop_size;   // Hop size (frame advance)
     vv_dsp_stft_window window; // analysis/synthesis window
+    vv_dsp_stft_spectrum spectrum; // spectrum layout, FULL by default
+    int periodic;              // nonzero: periodic (DFT-even) window, else symmetric
+    vv_dsp_real window_param;  // Kaiser beta / Tukey alpha, ignored by other windows
+    // Nonzero: FULL spectra are exchanged fftshifted (DC at bin fft_size/2) by process,
+    // spectrogram and streaming analysis, and reconstruct takes them so. Needs the FULL
+    // layout and an even fft_size; costs nothing, since the window carries a (-1)^i
+    // modulation that moves the spectrum by half its length.
+    int fftshift;
 } vv_dsp_stft_params;
 
 // Create/destroy
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create(const vv_dsp_stft_params* params, vv_dsp_stft** out);
 vv_dsp_status vv_dsp_stft_destroy(vv_dsp_stft* h);
 
+// Create with settings captured from a context (core/context.h; NULL = defaults): the
+// FFT backend of every plan the handle makes or borrows, the initial precision mode
+// and the pool of vv_dsp_stft_spectrogram_parallel()
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create_ctx(const vv_dsp_context* ctx,
+                                                      const vv_dsp_stft_params* params,
+                                                      vv_dsp_stft** out);
+
+// Shared configuration: the window, synthesis window and FFT plans of one parameter set,
+// immutable after creation and reference-counted. Any number of handles, on any threads,
+// can be created from one config; each handle is then only per-stream state (scratch,
+// ring, overlap-add accumulator, FFT workspace) and runs the shared plans through
+// vv_dsp_fft_execute_ws(). A handle keeps its config alive, so the creator may release
+// its reference right after creating handles. vv_dsp_stft_create() builds a private
+// config per handle. All handle functions apply to both kinds of handle.
+typedef struct vv_dsp_stft_config vv_dsp_stft_config;
+
+// Create a config with one reference held by the caller
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_config_create(const vv_dsp_stft_params* params,
+                                                         vv_dsp_stft_config** out);
+// The same capturing a context; handles created from the config inherit it
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_config_create_ctx(const vv_dsp_context* ctx,
+                                                             const vv_dsp_stft_params* params,
+                                                             vv_dsp_stft_config** out);
+// Reference counting (thread-safe); the last release frees the config
+vv_dsp_status vv_dsp_stft_config_retain(vv_dsp_stft_config* cfg);
+vv_dsp_status vv_dsp_stft_config_release(vv_dsp_stft_config* cfg);
+
+// Create a lightweight per-stream handle on a shared config (thread-safe).
+// The streaming ring is allocated by the first push unless
+// vv_dsp_stft_stream_reserve() is called beforehand.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create_from_config(vv_dsp_stft_config* cfg, vv_dsp_stft** out);
+
+// Number of complex bins per frame: fft_size (FULL) or fft_size/2+1 (HALF)
+size_t vv_dsp_stft_num_bins(const vv_dsp_stft* h);
+
 // Process a single frame (analysis):
 //  - in: real time-domain frame of length fft_size (will be windowed internally)
-//  - out: complex spectrum of length fft_size (full complex). For real-input efficient path use R2C via params->fft_size constraints in future.
+//  - out: complex spectrum of vv_dsp_stft_num_bins() bins. Both layouts run a real-input
+//    (R2C) FFT; FULL mirrors the Hermitian half into the upper bins.
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process(vv_dsp_stft* h,
                                                    const vv_dsp_real* in,
                                                    vv_dsp_cpx* out);
 
 // Reconstruct a single frame (synthesis):
-//  - in: complex spectrum of length fft_size
+//  - in: complex spectrum of vv_dsp_stft_num_bins() bins. HALF runs a C2R inverse, so the
+//    spectrum is treated as Hermitian; FULL runs a C2C inverse and keeps the real part.
 //  - out_add: overlap-add into an output buffer of at least fft_size samples beginning at current synthesis position
 // Reconstruct frame with overlap-add and optional normalization accumulation:
 //  - out_add[i] += time[i] * w[i]
@@ -48,13 +110,212 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_reconstruct(vv_dsp_stft* h,
                                                        vv_dsp_real* out_add,
                                                        vv_dsp_real* norm_add);
 
-// Convenience: process entire signal into magnitude spectrogram (rows=time frames, cols=fft_size)
+// Reconstruct a frame already normalized for overlap-add: out_add[i] += time[i] * ws[i]
+// with ws the synthesis window of vv_dsp_stft_synth_frame(), so no norm_add buffer or
+// division pass is needed. Samples covered by a full set of overlapping frames come out
+// exactly normalized; the first and last fft_size - hop_size samples ramp.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_reconstruct_normalized(vv_dsp_stft* h,
+                                                                  const vv_dsp_cpx* in,
+                                                                  vv_dsp_real* out_add);
+
+// Overlap-add gain of the (window, hop_size) pair. When the window squares overlap-add
+// to a constant C (COLA for weighted overlap-add, e.g. a periodic Hann at hop fft_size/4),
+// *gain = 1 / C and synthesis is the analysis window times that scalar; otherwise
+// *gain = 0 and synthesis divides by the per-phase window-square sum. Detected at create.
+vv_dsp_status vv_dsp_stft_cola_gain(const vv_dsp_stft* h, vv_dsp_real* gain);
+
+// Accuracy of the spectrogram's LOG, LOG1P and DB step (see core/precision.h). EXACT
+// (default) takes libm per bin; BALANCED the medium vmath log, within half a float ulp;
+// FAST the fast vmath log, abs error below 7e-5 (0.0003 dB). Both vectorized tiers
+// compute in single precision and clamp values below FLT_MIN. FFTs, windows, magnitude
+// and power are exact in every mode. Per handle; VV_DSP_ERROR_OUT_OF_RANGE for an
+// unknown mode.
+vv_dsp_status vv_dsp_stft_set_precision(vv_dsp_stft* h, vv_dsp_precision_mode mode);
+
+// Rows the spectrogram calls below write for a signal of n samples
+size_t vv_dsp_stft_spectrogram_frames(const vv_dsp_stft* h, size_t n);
+
+// Convenience: process entire signal into magnitude spectrogram
+// (rows=time frames, cols=vv_dsp_stft_num_bins())
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram(vv_dsp_stft* h,
                                                        const vv_dsp_real* signal,
                                                        size_t n,
-                                                       vv_dsp_real* out_mag, // size: n_frames * fft_size
+                                                       vv_dsp_real* out_mag, // size: n_frames * num_bins
                                                        size_t* out_frames);
 
+// Per-bin value written by vv_dsp_stft_spectrogram_ex()
+typedef enum vv_dsp_spectrogram_scale {
+    VV_DSP_SPECTROGRAM_MAGNITUDE = 0, // |X|
+    VV_DSP_SPECTROGRAM_POWER = 1,     // |X|^2
+    VV_DSP_SPECTROGRAM_LOG = 2,       // ln(|X|^2 + floor)
+    VV_DSP_SPECTROGRAM_LOG1P = 3,     // ln(1 + |X|^2)
+    VV_DSP_SPECTROGRAM_DB = 4         // 10*log10(max(|X|^2, floor)), floor > 0
+} vv_dsp_spectrogram_scale;
+
+// Spectrogram output options (zero-initialize unused fields; zero = magnitude)
+typedef struct vv_dsp_spectrogram_opts {
+    vv_dsp_spectrogram_scale scale;
+    vv_dsp_real floor;              // LOG epsilon / DB power floor
+    // Optional mel projection: n_mels x (fft_size/2+1) row-major weights, as returned
+    // by vv_dsp_mel_filterbank_create(). Applied to |X| (MAGNITUDE) or |X|^2 (other
+    // scales) before the log/dB step; rows then hold n_mels values. Works with either
+    // spectrum layout and with fftshift: only the non-negative bins are projected.
+    const vv_dsp_real* mel_weights;
+    size_t n_mels;
+} vv_dsp_spectrogram_opts;
+
+// Spectrogram with the output transform fused into the per-frame loop: each frame's
+// bins are scaled (and mel-projected) right after its FFT, so no full-resolution
+// intermediate is created. Rows hold n_mels values with mel_weights, otherwise
+// vv_dsp_stft_num_bins(). opts == NULL gives the magnitude spectrogram.
+// On the cuFFT backend (set globally or captured from a context) the whole call
+// runs on the device: the signal is uploaded once and only finished rows come back.
+// Results then match the host path to float rounding rather than bit for bit, and
+// the precision mode does not apply.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex(vv_dsp_stft* h,
+                                                          const vv_dsp_real* signal,
+                                                          size_t n,
+                                                          const vv_dsp_spectrogram_opts* opts,
+                                                          vv_dsp_real* out,
+                                                          size_t* out_frames);
+
+// vv_dsp_stft_spectrogram_ex() written in a compact storage type (core/quant.h):
+// blocks of rows are computed into a small scratch and encoded while in cache, so
+// out holds frames * row width * vv_dsp_storage_bytes(quant->type) bytes and no
+// full-precision spectrogram is ever materialized. Runs on the host whatever the
+// FFT backend. VV_DSP_ERROR_UNSUPPORTED for an unknown storage type.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_quant(vv_dsp_stft* h,
+                                                             const vv_dsp_real* signal,
+                                                             size_t n,
+                                                             const vv_dsp_spectrogram_opts* opts,
+                                                             const vv_dsp_quant* quant,
+                                                             void* out,
+                                                             size_t* out_frames);
+
+// vv_dsp_stft_process() and vv_dsp_stft_spectrogram_ex() on float or double sample
+// buffers in any build (see core/typed.h). The variants of the build's precision are
+// the vv_dsp_real calls and ignore arena. The others are convenience wrappers that
+// convert the whole input and output through scratch from arena (NULL = heap), on
+// top of the vv_dsp_real call; the _typed_scratch_size() functions below give the
+// bytes. opts, the handle and the mel weights stay in vv_dsp_real.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f32(vv_dsp_stft* h, const float* in, vv_dsp_cpx_f32* out,
+                                                       vv_dsp_arena* arena);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f64(vv_dsp_stft* h, const double* in, vv_dsp_cpx_f64* out,
+                                                       vv_dsp_arena* arena);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f32(vv_dsp_stft* h, const float* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, float* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f64(vv_dsp_stft* h, const double* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, double* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena);
+size_t vv_dsp_stft_process_typed_scratch_size(const vv_dsp_stft* h);
+size_t vv_dsp_stft_spectrogram_typed_scratch_size(const vv_dsp_stft* h, size_t n,
+                                                  const vv_dsp_spectrogram_opts* opts);
+
+// vv_dsp_stft_spectrogram_ex() over the frames of a vv_dsp_frame_view, whose
+// frame_len must equal fft_size. Interior frames are windowed straight out of the
+// signal and edge frames out of the view, so no frame is copied before windowing.
+// Row f is frame f of the view; *out_frames = view->num_frames.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_view(vv_dsp_stft* h,
+                                                            const vv_dsp_frame_view* view,
+                                                            const vv_dsp_spectrogram_opts* opts,
+                                                            vv_dsp_real* out,
+                                                            size_t* out_frames);
+
+// Same as vv_dsp_stft_spectrogram_ex() with frames partitioned across num_threads
+// workers on the default thread pool (0 = one per pool thread); on the cuFFT
+// backend the same device call as vv_dsp_stft_spectrogram_ex(). Each worker has its
+// own FFT plan and scratch; the window is shared. The output is bit-identical to the serial call. The handle is
+// only read, but must not be used by another call concurrently.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_parallel(vv_dsp_stft* h,
+                                                                const vv_dsp_real* signal,
+                                                                size_t n,
+                                                                const vv_dsp_spectrogram_opts* opts,
+                                                                vv_dsp_real* out,
+                                                                size_t* out_frames,
+                                                                size_t num_threads);
+
+// Multi-resolution STFT: spectrograms at several FFT sizes (e.g. 256, 512, 1024 and
+// 2048) of one signal in a single traversal. Every hop must be a multiple of the
+// smallest one, the step. At step s the signal span [s*step, s*step + max fft_size)
+// is read once and each resolution whose hop divides s*step windows its frame out of
+// it, centred in the span: resolution r starts at s*step + (max fft_size - fft_size)/2.
+// Frames of all resolutions are therefore aligned on their centres, and row j of
+// resolution r is centred at sample j*hop_r + max fft_size/2. Windowed frames are
+// staged per resolution and transformed by one batched R2C plan
+// (vv_dsp_fft_make_plan_many) every few frames.
+typedef struct vv_dsp_stft_multires vv_dsp_stft_multires;
+
+// num_res parameter sets, one per resolution; spectrum selects each one's row layout.
+// The FFT backend is the global one at creation. VV_DSP_ERROR_INVALID_SIZE when a hop
+// is zero, exceeds its fft_size or is not a multiple of the smallest hop.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_multires_create(const vv_dsp_stft_params* res, size_t num_res,
+                                                           vv_dsp_stft_multires** out);
+vv_dsp_status vv_dsp_stft_multires_destroy(vv_dsp_stft_multires* m);
+
+// Rows that vv_dsp_stft_multires_spectrogram() writes for resolution r and a signal
+// of n samples (0 for an invalid r)
+size_t vv_dsp_stft_multires_frames(const vv_dsp_stft_multires* m, size_t r, size_t n);
+
+// Spectrograms of all resolutions: out[r] receives vv_dsp_stft_multires_frames(m, r, n)
+// rows of fft_size/2+1 (HALF) or fft_size (FULL) values and out_frames[r] their count.
+// opts as for vv_dsp_stft_spectrogram_ex() except mel_weights, which depend on the FFT
+// size and give VV_DSP_ERROR_UNSUPPORTED. The log / dB step is EXACT. Does not allocate;
+// the handle must not be used by another call concurrently.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_multires_spectrogram(vv_dsp_stft_multires* m,
+                                                                const vv_dsp_real* signal,
+                                                                size_t n,
+                                                                const vv_dsp_spectrogram_opts* opts,
+                                                                vv_dsp_real* const* out,
+                                                                size_t* out_frames);
+
+// Streaming analysis: push arbitrary-sized blocks, pop hop-aligned frames.
+// Samples are buffered in a ring owned by the handle; frame f covers stream samples
+// [f*hop_size, f*hop_size + fft_size), so popped spectra equal vv_dsp_stft_process() on
+// those frames. Push and pop never allocate; frames are windowed straight out of the ring
+// (one pass when a frame is contiguous, two when it wraps) with no staging copy.
+
+// Size the ring so that pushes of up to max_block samples always fit as long as every
+// ready frame is popped after each push. Drops buffered samples. The default after
+// vv_dsp_stft_create() is max_block = fft_size.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_stream_reserve(vv_dsp_stft* h, size_t max_block);
+
+// Real-time preparation (see core/alloc.h): reserve the ring for max_block and clear the
+// overlap-add accumulator. Push, pop and synth never allocate afterwards; in builds with
+// VV_DSP_RT_CHECKS the FFTs they run are checked for that.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_prepare(vv_dsp_stft* h, size_t max_block);
+
+// Append n samples. Returns VV_DSP_ERROR_INVALID_SIZE without consuming anything when
+// they do not fit in the free ring space (vv_dsp_stft_stream_space()).
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_push(vv_dsp_stft* h, const vv_dsp_real* samples, size_t n);
+
+// Number of complete frames buffered and ready to pop
+size_t vv_dsp_stft_frames_ready(const vv_dsp_stft* h);
+
+// Free ring space in samples
+size_t vv_dsp_stft_stream_space(const vv_dsp_stft* h);
+
+// Analyze the oldest ready frame into out (vv_dsp_stft_num_bins() bins) and advance by
+// hop_size. Returns VV_DSP_ERROR_INVALID_SIZE when no frame is ready.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_pop_frame(vv_dsp_stft* h, vv_dsp_cpx* out);
+
+// Drop all buffered samples; the next pushed sample starts frame 0 again
+vv_dsp_status vv_dsp_stft_stream_reset(vv_dsp_stft* h);
+
+// Streaming synthesis: the handle owns the overlap-add accumulator. The window-square
+// sum of (window, hop_size) is folded into the synthesis window at create time, so no
+// normalization buffer or division pass is needed. Each call inverse-transforms one
+// spectrum (vv_dsp_stft_num_bins() bins), overlap-adds it and writes the hop_size
+// samples that no later frame can touch. Feeding the frames popped by
+// vv_dsp_stft_pop_frame() reproduces the input stream sample-aligned; the first
+// fft_size - hop_size samples lack earlier frames and ramp in.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_synth_frame(vv_dsp_stft* h,
+                                                       const vv_dsp_cpx* in,
+                                                       vv_dsp_real* out_hop);
+
+// Clear the overlap-add accumulator
+vv_dsp_status vv_dsp_stft_synth_reset(vv_dsp_stft* h);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,96 @@
+#ifndef VV_DSP_SPECTRAL_TEMPLATE_MATCH_H
+#define VV_DSP_SPECTRAL_TEMPLATE_MATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+// Normalized cross-correlation (NCC) template matching of a set of short templates
+// against one long signal. The score at offset k is the Pearson correlation of a
+// template t with the window x[k .. k + len):
+//   sum_i (t_i - mean t)(x_{k+i} - mean x_k) / (|t - mean t| * |x_k - mean x_k|)
+// which is in [-1, 1] and ignores the gain and DC offset of the window.
+//
+// Templates are stored zero-mean with unit norm, so the numerator is a plain
+// correlation with the window. The denominator comes from running sums of x and x^2
+// (in double) per template. Long templates take the correlation from overlap-save FFT
+// blocks: each block of the signal is transformed once and shared by every template
+// (one conjugate product and one C2R per template and block). Short templates, at
+// most VV_DSP_TEMPLATE_DIRECT_MAX samples, use direct dot products.
+//
+// Windows whose variance is (numerically) zero, such as digital silence, score 0.
+// Not thread-safe per object.
+typedef struct vv_dsp_template_matcher vv_dsp_template_matcher;
+
+// Longest max_template_len that VV_DSP_TEMPLATE_AUTO computes directly
+#define VV_DSP_TEMPLATE_DIRECT_MAX 32
+
+typedef enum {
+    VV_DSP_TEMPLATE_AUTO = 0,
+    VV_DSP_TEMPLATE_DIRECT = 1,
+    VV_DSP_TEMPLATE_FFT = 2
+} vv_dsp_template_method;
+
+typedef struct vv_dsp_template_match_params {
+    size_t num_templates;
+    size_t max_template_len;  // longest template that will be set
+    size_t top_k;             // matches kept per template, >= 1
+    size_t min_separation;    // offsets of kept matches differ by at least this; 0 = template length / 2
+    size_t fft_size;          // FFT block, 0 = next power of two >= 4 * max_template_len (at least 256)
+    vv_dsp_template_method method;
+} vv_dsp_template_match_params;
+
+typedef struct {
+    size_t offset;            // start of the matching window in the signal
+    vv_dsp_real score;        // NCC in [-1, 1]
+} vv_dsp_template_match;
+
+/**
+ * Create a matcher with no templates set. VV_DSP_ERROR_INVALID_SIZE for zero
+ * templates, template length or top_k, or an fft_size <= max_template_len;
+ * VV_DSP_ERROR_OUT_OF_RANGE for an unknown method.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_create(const vv_dsp_template_match_params* params,
+                                                              vv_dsp_template_matcher** out);
+
+// Destroy (NULL is ignored)
+void vv_dsp_template_matcher_destroy(vv_dsp_template_matcher* m);
+
+// Set template index (copied, mean removed and normalized; the FFT path transforms it
+// once). VV_DSP_ERROR_INVALID_SIZE for len 0 or above max_template_len;
+// VV_DSP_ERROR_OUT_OF_RANGE for a bad index or a constant template.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_set(vv_dsp_template_matcher* m,
+                                                           size_t index,
+                                                           const vv_dsp_real* templ,
+                                                           size_t len);
+
+/**
+ * Match every set template against x[0 .. n). matches receives num_templates rows of
+ * top_k entries, best first. counts (optional) receives the number of valid entries
+ * per row: below top_k for signals with few separated offsets, and 0 for unset
+ * templates or templates longer than the signal. Matches are chosen greedily in
+ * signal order: a candidate within min_separation of kept matches replaces them only
+ * when it scores higher than all of them.
+ */
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_match(vv_dsp_template_matcher* m,
+                                                             const vv_dsp_real* x,
+                                                             size_t n,
+                                                             vv_dsp_template_match* matches,
+                                                             size_t* counts);
+
+// The full NCC curve of one template: n - len + 1 scores, offset 0 first.
+// VV_DSP_ERROR_INVALID_SIZE when the template is longer than the signal.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_scores(vv_dsp_template_matcher* m,
+                                                              size_t index,
+                                                              const vv_dsp_real* x,
+                                                              size_t n,
+                                                              vv_dsp_real* scores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VV_DSP_SPECTRAL_TEMPLATE_MATCH_H
@@ -8,22 +8,26 @@ extern "C" {
 #include <stddef.h>
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/vv_dsp_math.h"
-#include "vv_dsp/vv_dsp_math.h"
 
-// Out-of-place fftshift/ifftshift utilities (1D)
+// fftshift/ifftshift utilities (1D). in == out shifts in place; other overlaps are
+// not allowed.
 vv_dsp_status vv_dsp_fftshift_real(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
 vv_dsp_status vv_dsp_ifftshift_real(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
 vv_dsp_status vv_dsp_fftshift_cpx(const vv_dsp_cpx* in, vv_dsp_cpx* out, size_t n);
 vv_dsp_status vv_dsp_ifftshift_cpx(const vv_dsp_cpx* in, vv_dsp_cpx* out, size_t n);
 
-// Phase wrapping/unwrapping helpers
-vv_dsp_status vv_dsp_phase_wrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
-vv_dsp_status vv_dsp_phase_unwrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
+// In-place shifts: a swap of the halves for even n, a rotation by reversals for odd n.
+// No scratch memory.
+vv_dsp_status vv_dsp_fftshift_inplace_real(vv_dsp_real* x, size_t n);
+vv_dsp_status vv_dsp_ifftshift_inplace_real(vv_dsp_real* x, size_t n);
+vv_dsp_status vv_dsp_fftshift_inplace_cpx(vv_dsp_cpx* x, size_t n);
+vv_dsp_status vv_dsp_ifftshift_inplace_cpx(vv_dsp_cpx* x, size_t n);
 
-// Phase wrap to (-pi, pi]
+// Phase wrap to (-pi, pi] (vv_dsp_vphase_wrap(); out may alias in)
 vv_dsp_status vv_dsp_phase_wrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
 
 // Phase unwrap (simple 1D): reconstruct continuous phase from wrapped input
+// (vv_dsp_vphase_unwrap(); out may alias in)
 vv_dsp_status vv_dsp_phase_unwrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n);
 
 #ifdef __cplusplus
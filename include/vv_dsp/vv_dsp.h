@@ -28,6 +28,7 @@
  * - @ref envelope_group "Envelope": Signal envelope extraction
  * - @ref window_group "Window": Various windowing functions
  * - @ref features_group "Features": MFCC and other feature extraction
+ * - Graph: block processing graphs over the streaming modules
  * - @ref audio_group "Audio": Audio I/O operations (optional)
  * - @ref adapters_group "Adapters": External library integration
  *
@@ -93,6 +94,13 @@ extern "C" {
 #include "vv_dsp/window.h"
 #include "vv_dsp/adapters.h"
 #include "vv_dsp/features/mel.h"
+#include "vv_dsp/features/deltas.h"
+#include "vv_dsp/features/pitch.h"
+#include "vv_dsp/features/extractor.h"
+#include "vv_dsp/features/spectral_features.h"
+#include "vv_dsp/features/vad.h"
+#include "vv_dsp/features/onset.h"
+#include "vv_dsp/graph.h"
 
 #ifdef VV_DSP_AUDIO_ENABLED
 #include "vv_dsp/audio.h"
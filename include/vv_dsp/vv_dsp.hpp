@@ -0,0 +1,740 @@
+/**
+ * @file vv_dsp.hpp
+ * @brief Header-only C++17 layer over the C API: move-only owners and span calls
+ *
+ * Every type here owns exactly one C handle and forwards to the C functions
+ * without copying samples: process calls take spans over caller storage and
+ * check their lengths before the call. Nothing throws; creation and process
+ * calls return vv_dsp_status as the C API does, and a moved-from owner is
+ * empty. Under C++20 vv_dsp::span is std::span.
+ *
+ * aligned_allocator puts standard containers on vv_dsp_aligned_malloc(), so
+ * their storage meets the SIMD alignment the kernels prefer and shows up in
+ * the allocation statistics and real-time checks of core/alloc.h.
+ */
+
+#ifndef VV_DSP_VV_DSP_HPP
+#define VV_DSP_VV_DSP_HPP
+
+#include "vv_dsp/vv_dsp.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+#    define VV_DSP_CPLUSPLUS _MSVC_LANG
+#else
+#    define VV_DSP_CPLUSPLUS __cplusplus
+#endif
+
+#if VV_DSP_CPLUSPLUS < 201703L
+#    error "vv_dsp.hpp needs C++17 or later"
+#endif
+
+#if VV_DSP_CPLUSPLUS >= 202002L && __has_include(<span>)
+#    include <span>
+#endif
+
+namespace vv_dsp {
+
+using real = vv_dsp_real;
+using cpx = vv_dsp_cpx;
+using status = vv_dsp_status;
+
+#if defined(__cpp_lib_span)
+template <class T>
+using span = std::span<T>;
+#else
+/** Contiguous non-owning view; the subset of std::span the wrappers use */
+template <class T>
+class span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using iterator = T*;
+
+    constexpr span() noexcept = default;
+    constexpr span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+    template <std::size_t N>
+    constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+    // Any contiguous container whose elements convert, e.g. std::vector or span<U>
+    template <class C,
+              class = std::enable_if_t<!std::is_same_v<std::remove_cv_t<C>, span> &&
+                                       std::is_convertible_v<std::remove_pointer_t<decltype(std::declval<C&>().data())> (*)[], T (*)[]>>>
+    constexpr span(C& c) noexcept : data_(c.data()), size_(c.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+    constexpr span first(std::size_t n) const noexcept { return span(data_, n); }
+    constexpr span subspan(std::size_t offset, std::size_t n) const noexcept { return span(data_ + offset, n); }
+    constexpr span subspan(std::size_t offset) const noexcept { return span(data_ + offset, size_ - offset); }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+#endif
+
+/**
+ * Standard allocator on vv_dsp_aligned_malloc(), aligned to at least Align
+ * bytes. Exhaustion throws std::bad_alloc when exceptions are enabled and
+ * aborts otherwise, as operator new does under -fno-exceptions.
+ */
+template <class T, std::size_t Align = VV_DSP_SIMD_ALIGN_DEFAULT>
+class aligned_allocator {
+public:
+    using value_type = T;
+    static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Align>;
+    };
+
+    aligned_allocator() noexcept = default;
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        void* p = n <= static_cast<std::size_t>(-1) / sizeof(T) ? vv_dsp_aligned_malloc(n * sizeof(T), alignment)
+                                                                : nullptr;
+        if (!p && n) {
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, std::size_t) noexcept { vv_dsp_aligned_free(p); }
+
+    template <class U>
+    bool operator==(const aligned_allocator<U, Align>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const aligned_allocator<U, Align>&) const noexcept { return false; }
+};
+
+/** std::vector with SIMD-aligned storage from the library allocator */
+template <class T>
+using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+namespace detail {
+
+// Move-only owner of one C handle; Destroy releases it
+template <class T, void (*Destroy)(T*)>
+class handle {
+public:
+    handle() noexcept = default;
+    explicit handle(T* p) noexcept : p_(p) {}
+    handle(handle&& other) noexcept : p_(other.release()) {}
+    handle& operator=(handle&& other) noexcept {
+        if (this != &other) reset(other.release());
+        return *this;
+    }
+    handle(const handle&) = delete;
+    handle& operator=(const handle&) = delete;
+    ~handle() { reset(); }
+
+    T* get() const noexcept { return p_; }
+    T* release() noexcept {
+        T* p = p_;
+        p_ = nullptr;
+        return p;
+    }
+    void reset(T* p = nullptr) noexcept {
+        T* old = p_;
+        p_ = p;
+        if (old) Destroy(old);
+    }
+
+private:
+    T* p_ = nullptr;
+};
+
+inline void destroy_fft(vv_dsp_fft_plan* p) { (void)vv_dsp_fft_destroy(p); }
+inline void destroy_stft(vv_dsp_stft* p) { (void)vv_dsp_stft_destroy(p); }
+
+// The int-returning resampler calls carry vv_dsp_status values
+inline status to_status(int rc) noexcept { return static_cast<status>(rc); }
+
+}  // namespace detail
+
+/** FFT plan of one size, type and direction */
+class fft_plan {
+public:
+    [[nodiscard]] static status create(std::size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                       fft_plan& out) noexcept {
+        vv_dsp_fft_plan* p = nullptr;
+        const status st = vv_dsp_fft_make_plan(n, type, dir, &p);
+        if (st != VV_DSP_OK) return st;
+        out.h_.reset(p);
+        out.n_ = n;
+        out.type_ = type;
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_fft_plan* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+    std::size_t size() const noexcept { return n_; }
+
+    /** C2C: n bins in, n bins out */
+    [[nodiscard]] status execute(span<const cpx> in, span<cpx> out) const noexcept {
+        if (type_ != VV_DSP_FFT_C2C) return VV_DSP_ERROR_UNSUPPORTED;
+        if (in.size() < n_ || out.size() < n_) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_fft_execute(h_.get(), in.data(), out.data());
+    }
+    /** R2C: n samples in, n/2+1 bins out */
+    [[nodiscard]] status execute(span<const real> in, span<cpx> out) const noexcept {
+        if (type_ != VV_DSP_FFT_R2C) return VV_DSP_ERROR_UNSUPPORTED;
+        if (in.size() < n_ || out.size() < n_ / 2 + 1) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_fft_execute(h_.get(), in.data(), out.data());
+    }
+    /** C2R: n/2+1 bins in, n samples out */
+    [[nodiscard]] status execute(span<const cpx> in, span<real> out) const noexcept {
+        if (type_ != VV_DSP_FFT_C2R) return VV_DSP_ERROR_UNSUPPORTED;
+        if (in.size() < n_ / 2 + 1 || out.size() < n_) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_fft_execute(h_.get(), in.data(), out.data());
+    }
+
+private:
+    detail::handle<vv_dsp_fft_plan, detail::destroy_fft> h_;
+    std::size_t n_ = 0;
+    vv_dsp_fft_type type_ = VV_DSP_FFT_C2C;
+};
+
+/** Plan-free complex FFT of compile-time size N (spectral/fft_small.h) */
+template <std::size_t N>
+class small_fft {
+    static_assert(N == 8 || N == 16 || N == 32 || N == 64, "small kernels cover 8, 16, 32 and 64 points");
+
+public:
+    [[nodiscard]] static status forward(span<const cpx> in, span<cpx> out) noexcept {
+        return run(in, out, VV_DSP_FFT_FORWARD);
+    }
+    /** Scaled by 1/N as the plan-based inverse */
+    [[nodiscard]] static status backward(span<const cpx> in, span<cpx> out) noexcept {
+        return run(in, out, VV_DSP_FFT_BACKWARD);
+    }
+
+private:
+    static status run(span<const cpx> in, span<cpx> out, vv_dsp_fft_dir dir) noexcept {
+        if (in.size() < N || out.size() < N) return VV_DSP_ERROR_INVALID_SIZE;
+        if constexpr (N == 8) return vv_dsp_fft_small_8(in.data(), out.data(), dir);
+        else if constexpr (N == 16) return vv_dsp_fft_small_16(in.data(), out.data(), dir);
+        else if constexpr (N == 32) return vv_dsp_fft_small_32(in.data(), out.data(), dir);
+        else return vv_dsp_fft_small_64(in.data(), out.data(), dir);
+    }
+};
+
+/** Plan-free DCT-II of compile-time size N (spectral/fft_small.h) */
+template <std::size_t N>
+class small_dct2 {
+    static_assert(N == 8 || N == 16 || N == 32 || N == 64, "small kernels cover 8, 16, 32 and 64 points");
+
+public:
+    [[nodiscard]] static status forward(span<const real> in, span<real> out) noexcept {
+        if (in.size() < N || out.size() < N) return VV_DSP_ERROR_INVALID_SIZE;
+        if constexpr (N == 8) return vv_dsp_dct2_small_8(in.data(), out.data());
+        else if constexpr (N == 16) return vv_dsp_dct2_small_16(in.data(), out.data());
+        else if constexpr (N == 32) return vv_dsp_dct2_small_32(in.data(), out.data());
+        else return vv_dsp_dct2_small_64(in.data(), out.data());
+    }
+};
+
+/** STFT handle: frame-at-a-time analysis and the push/pop/synth stream */
+class stft {
+public:
+    [[nodiscard]] static status create(const vv_dsp_stft_params& params, stft& out) noexcept {
+        vv_dsp_stft* p = nullptr;
+        const status st = vv_dsp_stft_create(&params, &p);
+        if (st != VV_DSP_OK) return st;
+        out.h_.reset(p);
+        out.fft_size_ = params.fft_size;
+        out.hop_size_ = params.hop_size;
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_stft* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+    std::size_t num_bins() const noexcept { return vv_dsp_stft_num_bins(h_.get()); }
+    std::size_t frames_ready() const noexcept { return vv_dsp_stft_frames_ready(h_.get()); }
+
+    [[nodiscard]] status prepare(std::size_t max_block) noexcept { return vv_dsp_stft_prepare(h_.get(), max_block); }
+
+    /** Analyze one fft_size frame into num_bins() bins */
+    [[nodiscard]] status process(span<const real> frame, span<cpx> out) noexcept {
+        if (frame.size() < fft_size_ || out.size() < num_bins()) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_stft_process(h_.get(), frame.data(), out.data());
+    }
+    [[nodiscard]] status push(span<const real> samples) noexcept {
+        return vv_dsp_stft_push(h_.get(), samples.data(), samples.size());
+    }
+    [[nodiscard]] status pop_frame(span<cpx> out) noexcept {
+        if (out.size() < num_bins()) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_stft_pop_frame(h_.get(), out.data());
+    }
+    /** Overlap-add one spectrum and write hop_size finished samples */
+    [[nodiscard]] status synth_frame(span<const cpx> in, span<real> out_hop) noexcept {
+        if (in.size() < num_bins() || out_hop.size() < hop_size_) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_stft_synth_frame(h_.get(), in.data(), out_hop.data());
+    }
+
+private:
+    detail::handle<vv_dsp_stft, detail::destroy_stft> h_;
+    std::size_t fft_size_ = 0;
+    std::size_t hop_size_ = 0;
+};
+
+/** Streaming FIR state; the taps are passed on every call as in the C API */
+class fir {
+public:
+    fir() noexcept : st_() {}
+    fir(fir&& other) noexcept : st_(other.st_) { other.st_ = vv_dsp_fir_state(); }
+    fir& operator=(fir&& other) noexcept {
+        if (this != &other) {
+            vv_dsp_fir_state_free(&st_);
+            st_ = other.st_;
+            other.st_ = vv_dsp_fir_state();
+        }
+        return *this;
+    }
+    fir(const fir&) = delete;
+    fir& operator=(const fir&) = delete;
+    ~fir() { vv_dsp_fir_state_free(&st_); }
+
+    [[nodiscard]] static status create(std::size_t num_taps, fir& out) noexcept {
+        fir f;
+        const status st = vv_dsp_fir_state_init(&f.st_, num_taps);
+        if (st != VV_DSP_OK) return st;
+        out = static_cast<fir&&>(f);
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_fir_state* get() noexcept { return &st_; }
+    explicit operator bool() const noexcept { return st_.num_taps != 0; }
+    std::size_t num_taps() const noexcept { return st_.num_taps; }
+
+    [[nodiscard]] status prepare(std::size_t max_block) noexcept { return vv_dsp_fir_state_prepare(&st_, max_block); }
+
+    [[nodiscard]] status apply(span<const real> taps, span<const real> in, span<real> out) noexcept {
+        if (taps.size() != st_.num_taps || out.size() < in.size()) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_fir_apply(&st_, taps.data(), in.data(), out.data(), in.size());
+    }
+
+private:
+    vv_dsp_fir_state st_;
+};
+
+/** Biquad cascade compiled into an IIR plan */
+class iir_plan {
+public:
+    [[nodiscard]] static status create(span<const vv_dsp_biquad> sections, vv_dsp_iir_realization realization,
+                                       iir_plan& out) noexcept {
+        vv_dsp_iir_plan* p = nullptr;
+        const status st = vv_dsp_iir_make_plan(sections.data(), sections.size(), realization, &p);
+        if (st != VV_DSP_OK) return st;
+        out.h_.reset(p);
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_iir_plan* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+
+    [[nodiscard]] status apply(span<const real> in, span<real> out) noexcept {
+        if (out.size() < in.size()) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_iir_plan_apply(h_.get(), in.data(), out.data(), in.size());
+    }
+    status reset() noexcept { return vv_dsp_iir_plan_reset(h_.get()); }
+
+private:
+    detail::handle<vv_dsp_iir_plan, vv_dsp_iir_plan_destroy> h_;
+};
+
+/** Multichannel biquad bank over interleaved spans or buffer descriptors */
+class biquad_bank {
+public:
+    [[nodiscard]] static status create(std::size_t channels, std::size_t stages, biquad_bank& out) noexcept {
+        vv_dsp_biquad_bank* p = nullptr;
+        const status st = vv_dsp_biquad_bank_create(channels, stages, &p);
+        if (st != VV_DSP_OK) return st;
+        out.h_.reset(p);
+        out.channels_ = channels;
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_biquad_bank* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+    std::size_t channels() const noexcept { return channels_; }
+
+    status set_stage(std::size_t stage, real b0, real b1, real b2, real a1, real a2) noexcept {
+        return vv_dsp_biquad_bank_set_stage(h_.get(), stage, b0, b1, b2, a1, a2);
+    }
+    /** Interleaved frames; in.size() must be a multiple of channels() */
+    [[nodiscard]] status process(span<const real> in, span<real> out) noexcept {
+        if (!channels_ || in.size() % channels_ || out.size() < in.size()) return VV_DSP_ERROR_INVALID_SIZE;
+        return vv_dsp_biquad_bank_process(h_.get(), in.data(), out.data(), in.size() / channels_);
+    }
+    [[nodiscard]] status process(const vv_dsp_buffer& in, vv_dsp_buffer& out) noexcept {
+        return vv_dsp_biquad_bank_process_buffer(h_.get(), &in, &out);
+    }
+    status reset() noexcept { return vv_dsp_biquad_bank_reset(h_.get()); }
+
+private:
+    detail::handle<vv_dsp_biquad_bank, vv_dsp_biquad_bank_destroy> h_;
+    std::size_t channels_ = 0;
+};
+
+/** Single-channel streaming resampler */
+class resampler {
+public:
+    /** VV_DSP_ERROR_INVALID_SIZE for a zero ratio term, VV_DSP_ERROR_INTERNAL otherwise */
+    [[nodiscard]] static status create(unsigned int num, unsigned int den, resampler& out) noexcept {
+        if (num == 0 || den == 0) return VV_DSP_ERROR_INVALID_SIZE;
+        vv_dsp_resampler* p = vv_dsp_resampler_create(num, den);
+        if (!p) return VV_DSP_ERROR_INTERNAL;
+        out.h_.reset(p);
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_resampler* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+
+    status set_quality(bool use_sinc, unsigned int taps) noexcept {
+        return detail::to_status(vv_dsp_resampler_set_quality(h_.get(), use_sinc ? 1 : 0, taps));
+    }
+    [[nodiscard]] status prepare(std::size_t max_block) noexcept {
+        return detail::to_status(vv_dsp_resampler_prepare(h_.get(), max_block));
+    }
+    std::size_t out_needed(std::size_t in_n) const noexcept { return vv_dsp_resampler_out_needed(h_.get(), in_n); }
+
+    /** Consume in and write produced samples to the front of out */
+    [[nodiscard]] status process(span<const real> in, span<real> out, std::size_t& produced) noexcept {
+        produced = 0;
+        return detail::to_status(
+            vv_dsp_resampler_process_stream(h_.get(), in.data(), in.size(), out.data(), out.size(), &produced));
+    }
+    [[nodiscard]] status flush(span<real> out, std::size_t& produced) noexcept {
+        produced = 0;
+        return detail::to_status(vv_dsp_resampler_flush(h_.get(), out.data(), out.size(), &produced));
+    }
+    status reset() noexcept { return detail::to_status(vv_dsp_resampler_reset(h_.get())); }
+
+private:
+    detail::handle<vv_dsp_resampler, vv_dsp_resampler_destroy> h_;
+};
+
+/** Multichannel streaming resampler over interleaved spans or buffer descriptors */
+class resampler_mc {
+public:
+    [[nodiscard]] static status create(unsigned int num, unsigned int den, std::size_t channels,
+                                       resampler_mc& out) noexcept {
+        if (num == 0 || den == 0 || channels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+        vv_dsp_resampler_mc* p = vv_dsp_resampler_mc_create(num, den, channels);
+        if (!p) return VV_DSP_ERROR_INTERNAL;
+        out.h_.reset(p);
+        out.channels_ = channels;
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_resampler_mc* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+    std::size_t channels() const noexcept { return channels_; }
+
+    status set_quality(bool use_sinc, unsigned int taps) noexcept {
+        return detail::to_status(vv_dsp_resampler_mc_set_quality(h_.get(), use_sinc ? 1 : 0, taps));
+    }
+    [[nodiscard]] status prepare(std::size_t max_block) noexcept {
+        return detail::to_status(vv_dsp_resampler_mc_prepare(h_.get(), max_block));
+    }
+
+    /** Interleaved frames in and out; frames counts output frames */
+    [[nodiscard]] status process(span<const real> in, span<real> out, std::size_t& frames) noexcept {
+        frames = 0;
+        if (!channels_ || in.size() % channels_) return VV_DSP_ERROR_INVALID_SIZE;
+        return detail::to_status(vv_dsp_resampler_mc_process_interleaved(
+            h_.get(), in.data(), in.size() / channels_, out.data(), out.size() / channels_, &frames));
+    }
+    [[nodiscard]] status process(const vv_dsp_buffer& in, vv_dsp_buffer& out, std::size_t& frames) noexcept {
+        frames = 0;
+        return detail::to_status(vv_dsp_resampler_mc_process_buffer(h_.get(), &in, &out, &frames));
+    }
+    [[nodiscard]] status flush(span<real> out, std::size_t& frames) noexcept {
+        frames = 0;
+        return detail::to_status(
+            vv_dsp_resampler_mc_flush_interleaved(h_.get(), out.data(), out.size() / channels_, &frames));
+    }
+    status reset() noexcept { return detail::to_status(vv_dsp_resampler_mc_reset(h_.get())); }
+
+private:
+    detail::handle<vv_dsp_resampler_mc, vv_dsp_resampler_mc_destroy> h_;
+    std::size_t channels_ = 0;
+};
+
+/** Lock-free ring of trivially copyable records of type T */
+template <class T>
+class ring {
+    static_assert(std::is_trivially_copyable_v<T>, "ring records are copied bytewise");
+
+public:
+    [[nodiscard]] static status create(vv_dsp_ring_mode mode, std::size_t capacity, ring& out) noexcept {
+        vv_dsp_ring* p = nullptr;
+        const status st = vv_dsp_ring_create(mode, sizeof(T), capacity, &p);
+        if (st != VV_DSP_OK) return st;
+        out.h_.reset(p);
+        return VV_DSP_OK;
+    }
+
+    vv_dsp_ring* get() const noexcept { return h_.get(); }
+    explicit operator bool() const noexcept { return h_.get() != nullptr; }
+    std::size_t capacity() const noexcept { return vv_dsp_ring_capacity(h_.get()); }
+    std::size_t size() const noexcept { return vv_dsp_ring_size(h_.get()); }
+
+    [[nodiscard]] status write(span<const T> records, std::size_t& written) noexcept {
+        written = 0;
+        return vv_dsp_ring_write(h_.get(), records.data(), records.size(), &written);
+    }
+    [[nodiscard]] status read(span<T> records, std::size_t& read_count) noexcept {
+        read_count = 0;
+        return vv_dsp_ring_read(h_.get(), records.data(), records.size(), &read_count);
+    }
+
+private:
+    detail::handle<vv_dsp_ring, vv_dsp_ring_destroy> h_;
+};
+
+/** Owned multichannel buffer from vv_dsp_buffer_create() */
+class buffer {
+public:
+    buffer() noexcept : b_() {}
+    buffer(buffer&& other) noexcept : b_(other.b_) { other.b_ = vv_dsp_buffer(); }
+    buffer& operator=(buffer&& other) noexcept {
+        if (this != &other) {
+            vv_dsp_buffer_free(&b_);
+            b_ = other.b_;
+            other.b_ = vv_dsp_buffer();
+        }
+        return *this;
+    }
+    buffer(const buffer&) = delete;
+    buffer& operator=(const buffer&) = delete;
+    ~buffer() { vv_dsp_buffer_free(&b_); }
+
+    [[nodiscard]] static status create(std::size_t channels, std::size_t frames, vv_dsp_buffer_layout layout,
+                                       buffer& out) noexcept {
+        buffer b;
+        const status st = vv_dsp_buffer_create(channels, frames, layout, &b.b_);
+        if (st != VV_DSP_OK) return st;
+        out = static_cast<buffer&&>(b);
+        return VV_DSP_OK;
+    }
+
+    /** The descriptor, for the C entry points and the process(buffer) overloads */
+    vv_dsp_buffer& view() noexcept { return b_; }
+    const vv_dsp_buffer& view() const noexcept { return b_; }
+    explicit operator bool() const noexcept { return b_.data != nullptr; }
+    std::size_t channels() const noexcept { return b_.channels; }
+    std::size_t frames() const noexcept { return b_.frames; }
+
+    /** Samples of one planar channel; empty for interleaved storage or an out-of-range channel */
+    span<real> channel(std::size_t c) const noexcept {
+        if (c >= b_.channels || (b_.frame_stride != 1 && b_.frames > 1)) return span<real>();
+        return span<real>(b_.data + c * b_.channel_stride, b_.frames);
+    }
+    /** All samples of an interleaved (or single-channel) buffer; empty otherwise */
+    span<real> interleaved() const noexcept {
+        if (vv_dsp_buffer_get_layout(&b_) != VV_DSP_BUFFER_INTERLEAVED && b_.channels != 1) return span<real>();
+        return span<real>(b_.data, b_.channels * b_.frames);
+    }
+
+private:
+    vv_dsp_buffer b_;
+};
+
+/**
+ * Lazy element-wise expressions over real spans.
+ *
+ * `eval((lazy(a) * lazy(win) + lazy(b)) * gain, out)` runs one loop that
+ * reads each input once and writes out once, where the equivalent chain of
+ * vv_dsp_mul_real_simd() / vv_dsp_add_real_simd() calls makes a pass per
+ * operator. sum() folds any expression in the same way, so
+ * `sum(sq(lazy(x) * lazy(win)), e)` is a single pass too. The loop bodies
+ * are plain scalar code that the compiler vectorizes for the target the
+ * caller is built for; the runtime-dispatched kernels stay in the C API.
+ *
+ * Expressions hold spans, not copies, and are meant to be evaluated in the
+ * statement that builds them. The output of eval() may be one of the
+ * operands but not a shifted view of one.
+ */
+namespace expr {
+
+// Length of a scalar operand, and of an expression whose operands disagree
+inline constexpr std::size_t broadcast = static_cast<std::size_t>(-1);
+inline constexpr std::size_t mismatch = static_cast<std::size_t>(-2);
+
+template <class E>
+struct node {};
+
+template <class E>
+inline constexpr bool is_node_v = std::is_base_of_v<node<E>, E>;
+
+class leaf : public node<leaf> {
+public:
+    explicit leaf(span<const real> s) noexcept : p_(s.data()), n_(s.size()) {}
+    real operator[](std::size_t i) const noexcept { return p_[i]; }
+    std::size_t size() const noexcept { return n_; }
+
+private:
+    const real* p_;
+    std::size_t n_;
+};
+
+class scalar : public node<scalar> {
+public:
+    explicit scalar(real v) noexcept : v_(v) {}
+    real operator[](std::size_t) const noexcept { return v_; }
+    std::size_t size() const noexcept { return broadcast; }
+
+private:
+    real v_;
+};
+
+struct add_op { static real apply(real a, real b) noexcept { return a + b; } };
+struct sub_op { static real apply(real a, real b) noexcept { return a - b; } };
+struct mul_op { static real apply(real a, real b) noexcept { return a * b; } };
+struct neg_op { static real apply(real a) noexcept { return -a; } };
+struct sq_op { static real apply(real a) noexcept { return a * a; } };
+struct abs_op { static real apply(real a) noexcept { return a < 0 ? -a : a; } };
+
+template <class Op, class L, class R>
+class binary : public node<binary<Op, L, R>> {
+public:
+    binary(const L& l, const R& r) noexcept : l_(l), r_(r) {}
+    real operator[](std::size_t i) const noexcept { return Op::apply(l_[i], r_[i]); }
+    std::size_t size() const noexcept {
+        const std::size_t a = l_.size(), b = r_.size();
+        if (a == b || b == broadcast) return a;
+        return a == broadcast ? b : mismatch;
+    }
+
+private:
+    L l_;
+    R r_;
+};
+
+template <class Op, class A>
+class unary : public node<unary<Op, A>> {
+public:
+    explicit unary(const A& a) noexcept : a_(a) {}
+    real operator[](std::size_t i) const noexcept { return Op::apply(a_[i]); }
+    std::size_t size() const noexcept { return a_.size(); }
+
+private:
+    A a_;
+};
+
+// An expression stays as is; an arithmetic value becomes a broadcast scalar
+template <class T>
+auto as_node(const T& v) noexcept {
+    if constexpr (is_node_v<T>) {
+        return v;
+    } else {
+        return scalar(static_cast<real>(v));
+    }
+}
+
+template <class L, class R>
+inline constexpr bool operands_v =
+    (is_node_v<L> && (is_node_v<R> || std::is_arithmetic_v<R>)) || (std::is_arithmetic_v<L> && is_node_v<R>);
+
+template <class L, class R, std::enable_if_t<operands_v<L, R>, int> = 0>
+auto operator+(const L& l, const R& r) noexcept {
+    return binary<add_op, decltype(as_node(l)), decltype(as_node(r))>(as_node(l), as_node(r));
+}
+template <class L, class R, std::enable_if_t<operands_v<L, R>, int> = 0>
+auto operator-(const L& l, const R& r) noexcept {
+    return binary<sub_op, decltype(as_node(l)), decltype(as_node(r))>(as_node(l), as_node(r));
+}
+template <class L, class R, std::enable_if_t<operands_v<L, R>, int> = 0>
+auto operator*(const L& l, const R& r) noexcept {
+    return binary<mul_op, decltype(as_node(l)), decltype(as_node(r))>(as_node(l), as_node(r));
+}
+template <class A, std::enable_if_t<is_node_v<A>, int> = 0>
+auto operator-(const A& a) noexcept {
+    return unary<neg_op, A>(a);
+}
+template <class A, std::enable_if_t<is_node_v<A>, int> = 0>
+auto sq(const A& a) noexcept {
+    return unary<sq_op, A>(a);
+}
+template <class A, std::enable_if_t<is_node_v<A>, int> = 0>
+auto abs(const A& a) noexcept {
+    return unary<abs_op, A>(a);
+}
+
+}  // namespace expr
+
+/** Leaf of an expression over caller samples */
+inline expr::leaf lazy(span<const real> s) noexcept { return expr::leaf(s); }
+
+/**
+ * Write e[i] to out[i] in one pass
+ * @return VV_DSP_ERROR_INVALID_SIZE when the operands, or out, differ in length
+ */
+template <class E, std::enable_if_t<expr::is_node_v<E>, int> = 0>
+[[nodiscard]] status eval(const E& e, span<real> out) noexcept {
+    const std::size_t n = e.size();
+    if (n == expr::mismatch || (n != expr::broadcast && n != out.size())) return VV_DSP_ERROR_INVALID_SIZE;
+    // A local copy keeps the operand pointers in registers across the stores; each
+    // block of eight is read before it is written, so the block vectorizes without
+    // a runtime overlap check
+    const E x = e;
+    real* o = out.data();
+    const std::size_t len = out.size();
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        real t[8];
+        for (std::size_t k = 0; k < 8; ++k) t[k] = x[i + k];
+        for (std::size_t k = 0; k < 8; ++k) o[i + k] = t[k];
+    }
+    for (; i < len; ++i) o[i] = x[i];
+    return VV_DSP_OK;
+}
+
+/**
+ * Sum of e[i] in one pass, over eight partial sums so the fold vectorizes
+ * without reassociation flags
+ * @return VV_DSP_ERROR_INVALID_SIZE when the operands differ in length, or
+ *         when e has no span operand
+ */
+template <class E, std::enable_if_t<expr::is_node_v<E>, int> = 0>
+[[nodiscard]] status sum(const E& e, real& total) noexcept {
+    total = 0;
+    const std::size_t n = e.size();
+    if (n == expr::mismatch || n == expr::broadcast) return VV_DSP_ERROR_INVALID_SIZE;
+    const E x = e;
+    real acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        real t[8];
+        for (std::size_t k = 0; k < 8; ++k) t[k] = x[i + k];
+        for (std::size_t k = 0; k < 8; ++k) acc[k] += t[k];
+    }
+    real tail = 0;
+    for (; i < n; ++i) tail += x[i];
+    total = ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7])) + tail;
+    return VV_DSP_OK;
+}
+
+}  // namespace vv_dsp
+
+#endif /* VV_DSP_VV_DSP_HPP */
@@ -135,6 +135,51 @@ vv_dsp_status vv_dsp_window_kaiser(size_t N, vv_dsp_real beta, vv_dsp_real* out)
 // alpha=0: rectangular, alpha=1: Hann window
 vv_dsp_status vv_dsp_window_tukey(size_t N, vv_dsp_real alpha, vv_dsp_real* out);
 
+// Window selector for vv_dsp_window_fill() and the shared window cache
+typedef enum vv_dsp_window_kind {
+    VV_DSP_WINDOW_KIND_BOXCAR = 0,
+    VV_DSP_WINDOW_KIND_HANN,
+    VV_DSP_WINDOW_KIND_HAMMING,
+    VV_DSP_WINDOW_KIND_BLACKMAN,
+    VV_DSP_WINDOW_KIND_BLACKMAN_HARRIS,
+    VV_DSP_WINDOW_KIND_NUTTALL,
+    VV_DSP_WINDOW_KIND_BARTLETT,
+    VV_DSP_WINDOW_KIND_BOHMAN,
+    VV_DSP_WINDOW_KIND_COSINE,
+    VV_DSP_WINDOW_KIND_PLANCK_TAPER,
+    VV_DSP_WINDOW_KIND_FLATTOP,
+    VV_DSP_WINDOW_KIND_KAISER,  // param = beta
+    VV_DSP_WINDOW_KIND_TUKEY    // param = alpha
+} vv_dsp_window_kind;
+
+// Fill out[0..N-1] with the window of the given kind. param is used by Kaiser
+// and Tukey only. periodic != 0 gives the DFT-even form: the first N points of
+// the symmetric window of length N + 1.
+vv_dsp_status vv_dsp_window_fill(vv_dsp_window_kind kind, size_t N, vv_dsp_real param, int periodic,
+                                 vv_dsp_real* out);
+
+// Shared window cache:
+// Take a reference on the process-wide coefficients for (kind, N, param,
+// periodic), generating them on first use. Every holder of one configuration
+// gets the same read-only, SIMD-aligned array; release it with
+// vv_dsp_window_release(). Thread-safe.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_window_acquire(vv_dsp_window_kind kind, size_t N, vv_dsp_real param,
+                                                     int periodic, const vv_dsp_real** out);
+
+// Drop a reference taken by vv_dsp_window_acquire(); the last one frees the
+// array (NULL is ignored). Thread-safe.
+void vv_dsp_window_release(const vv_dsp_real* window);
+
+// Snapshot of the shared window cache counters
+typedef struct vv_dsp_window_cache_stats {
+    size_t hits;     // Acquires served by a live entry
+    size_t misses;   // Acquires that had to generate the window
+    size_t entries;  // Configurations currently held
+} vv_dsp_window_cache_stats;
+
+// Read the shared window cache counters. Thread-safe.
+vv_dsp_status vv_dsp_window_cache_get_stats(vv_dsp_window_cache_stats* out);
+
 #ifdef __cplusplus
 }
 #endif
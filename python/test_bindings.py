@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Checks the native vv_dsp module on array.array buffers (and NumPy when present)."""
+import array
+import cmath
+import math
+import sys
+import threading
+
+from common import SKIP_CODE
+
+try:
+    import vv_dsp
+except ImportError as e:
+    print(f"Skip: vv_dsp module not importable: {e}")
+    sys.exit(SKIP_CODE)
+
+fmt = vv_dsp.sample_format
+tol = 1e-4 if fmt == "f" else 1e-10
+
+
+def close(a, b, scale=1.0):
+    return all(abs(x - y) <= tol * scale for x, y in zip(a, b)) and len(a) == len(b)
+
+
+def dft(z, sign=-1):
+    n = len(z)
+    return [sum(z[j] * cmath.exp(sign * 2j * math.pi * j * k / n) for j in range(n)) for k in range(n)]
+
+
+# FFT: complex data as interleaved re/im samples, written in place into out
+n = 16
+z = [complex(math.sin(0.3 * i), math.cos(0.7 * i)) for i in range(n)]
+buf = array.array(fmt, [v for c in z for v in (c.real, c.imag)])
+out = array.array(fmt, [0.0] * (2 * n))
+vv_dsp.Fft(n).execute(buf, out)
+ref = dft(z)
+assert close(out[0::2], [c.real for c in ref], n) and close(out[1::2], [c.imag for c in ref], n)
+back = array.array(fmt, [0.0] * (2 * n))
+vv_dsp.Fft(n, inverse=True).execute(out, back)
+assert close(back, buf, n)
+
+x = array.array(fmt, [math.sin(0.2 * i) + 0.1 * i for i in range(n)])
+half = array.array(fmt, [0.0] * (n + 2))
+vv_dsp.Fft(n, "r2c").execute(x, half)
+ref = dft([complex(v) for v in x])[: n // 2 + 1]
+assert close(half[0::2], [c.real for c in ref], n) and close(half[1::2], [c.imag for c in ref], n)
+
+# Errors: wrong sample type, short outputs, bad arguments
+other = "d" if fmt == "f" else "f"
+for call, exc in [
+    (lambda: vv_dsp.Fft(n).execute(array.array(other, [0.0] * 2 * n), out), TypeError),
+    (lambda: vv_dsp.Fft(n).execute(buf, array.array(fmt, [0.0] * n)), ValueError),
+    (lambda: vv_dsp.Fft(n).execute(buf, bytearray(8 * n)), TypeError),
+    (lambda: vv_dsp.Fft(0), ValueError),
+    (lambda: vv_dsp.Fft(n, "dct"), ValueError),
+]:
+    try:
+        call()
+    except exc:
+        pass
+    else:
+        raise AssertionError(f"expected {exc.__name__}")
+
+# FIR: chunked and in-place processing match one call
+taps = array.array(fmt, [0.25, 0.5, 0.25, -0.1, 0.05])
+sig = array.array(fmt, [math.sin(0.05 * i) + (i % 7) * 0.1 for i in range(1000)])
+whole = array.array(fmt, [0.0] * len(sig))
+vv_dsp.Fir(taps).process(sig, whole)
+fir = vv_dsp.Fir(taps)
+parts = array.array(fmt, sig)
+view = memoryview(parts)
+for lo in range(0, len(sig), 300):
+    fir.process(view[lo : lo + 300], view[lo : lo + 300])
+assert close(parts, whole)
+direct = [sum(taps[k] * sig[i - k] for k in range(len(taps)) if i >= k) for i in range(len(sig))]
+assert close(whole, direct, 4)
+
+# Independent objects on Python threads run with the GIL released
+blocks = [array.array(fmt, [math.sin(0.01 * (i + t)) for i in range(1 << 14)]) for t in range(4)]
+expected = []
+for b in blocks:
+    y = array.array(fmt, [0.0] * len(b))
+    vv_dsp.Fir(taps).process(b, y)
+    expected.append(y)
+results = [array.array(fmt, [0.0] * len(b)) for b in blocks]
+
+
+def worker(t):
+    for _ in range(20):
+        vv_dsp.Fir(taps).process(blocks[t], results[t])
+
+
+threads = [threading.Thread(target=worker, args=(t,)) for t in range(4)]
+for th in threads:
+    th.start()
+for th in threads:
+    th.join()
+assert all(r == e for r, e in zip(results, expected))
+
+# Resampler: streamed chunks plus the flush cover the whole signal
+rs = vv_dsp.Resampler(2, 1)
+total = 0
+for lo in range(0, len(sig), 256):
+    chunk = sig[lo : lo + 256]
+    dst = array.array(fmt, [0.0] * rs.out_needed(len(chunk)))
+    total += rs.process(chunk, dst)
+tail = array.array(fmt, [0.0] * 256)
+total += rs.flush(tail)
+assert abs(total - 2 * len(sig)) <= 2, total
+
+# STFT: spectrogram rows and a single frame
+st = vv_dsp.Stft(64, 16)
+assert st.num_bins == 33
+rows = st.num_frames(len(sig))
+mag = array.array(fmt, [0.0] * (rows * st.num_bins))
+assert st.spectrogram(sig, mag) == rows
+spec = array.array(fmt, [0.0] * (2 * st.num_bins))
+st.process(array.array(fmt, [1.0] * 64), spec)
+assert abs(spec[0] - 32.0) < 1e-3 and abs(spec[2] + 16.0) < 1e-3 and abs(spec[4]) < 1e-3  # periodic Hann
+
+# MFCC over power-spectrogram rows
+mf = vv_dsp.Mfcc(64, 20, 13, 16000.0)
+power = array.array(fmt, [v * v for v in mag[: 4 * 33]])
+coeffs = array.array(fmt, [0.0] * (4 * 13))
+assert mf.process(power, coeffs) == 4
+assert all(math.isfinite(c) for c in coeffs) and any(c != 0 for c in coeffs)
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+if np is not None:
+    dt = np.float32 if fmt == "f" else np.float64
+    ct = np.complex64 if fmt == "f" else np.complex128
+    zx = np.asarray(z, dtype=ct)
+    zy = np.empty_like(zx)
+    vv_dsp.Fft(n).execute(zx, zy)
+    assert np.allclose(zy, np.fft.fft(zx), atol=tol * n)
+    xr = np.asarray(x, dtype=dt)
+    hy = np.empty(n // 2 + 1, dtype=ct)
+    vv_dsp.Fft(n, "r2c").execute(xr, hy)
+    assert np.allclose(hy, np.fft.rfft(xr), atol=tol * n)
+
+print("test_bindings: OK")
@@ -0,0 +1,735 @@
+/**
+ * @file vv_dsp_module.c
+ * @brief Native Python module over the FFT, STFT, FIR, resampler and MFCC plans
+ *
+ * Every process call takes its arrays through the buffer protocol (NumPy
+ * arrays, array.array, memoryview, ...) and reads and writes them in place:
+ * nothing is copied and nothing is allocated per call. Inputs and outputs
+ * must be C-contiguous with the library's sample format, float32 ('f') or
+ * float64 ('d') under VV_DSP_USE_DOUBLE. Complex data is either complex
+ * ('Zf' / 'Zd', e.g. numpy.complex64) or interleaved re/im real samples.
+ * Output arrays are caller-provided, like the C API, so a hot loop reuses
+ * them.
+ *
+ * The GIL is released for the duration of the C call, so Python threads
+ * running separate objects execute in parallel. Each object serializes its
+ * own calls with a lock, because the C handles keep per-call scratch or
+ * stream state; give every thread its own object to scale.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <pythread.h>
+
+#include <string.h>
+#include "vv_dsp/vv_dsp.h"
+
+#ifdef VV_DSP_USE_DOUBLE
+#define REAL_FORMAT 'd'
+#else
+#define REAL_FORMAT 'f'
+#endif
+
+static PyObject* vv_error; // vv_dsp.Error, carries the vv_dsp_status as .status
+
+static const char* status_name(vv_dsp_status st) {
+    switch (st) {
+        case VV_DSP_ERROR_NULL_POINTER: return "null pointer";
+        case VV_DSP_ERROR_INVALID_SIZE: return "invalid size";
+        case VV_DSP_ERROR_OUT_OF_RANGE: return "argument out of range";
+        case VV_DSP_ERROR_INTERNAL: return "internal error";
+        case VV_DSP_ERROR_NAN_INF: return "NaN or Inf in input";
+        case VV_DSP_ERROR_UNSUPPORTED: return "unsupported";
+        default: return "unknown error";
+    }
+}
+
+static PyObject* raise_status(vv_dsp_status st) {
+    PyObject* exc = PyObject_CallFunction(vv_error, "s", status_name(st));
+    if (!exc) return NULL;
+    PyObject* code = PyLong_FromLong((long)st);
+    if (code) {
+        PyObject_SetAttrString(exc, "status", code);
+        Py_DECREF(code);
+    }
+    PyErr_SetObject(vv_error, exc);
+    Py_DECREF(exc);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Buffers
+
+enum { BUF_REAL = 0, BUF_CPX = 1 };
+
+// Sample format of a view: 'f'/'d' for real, 'F'/'D' for complex, 0 otherwise
+static char buffer_kind(const Py_buffer* v) {
+    const char* f = v->format ? v->format : "B";
+    if (*f == '@' || *f == '=') ++f;
+#if PY_LITTLE_ENDIAN
+    else if (*f == '<') ++f;
+#else
+    else if (*f == '>') ++f;
+#endif
+    if (f[0] == 'Z' && (f[1] == 'f' || f[1] == 'd') && f[2] == '\0') return f[1] == 'f' ? 'F' : 'D';
+    if ((f[0] == 'f' || f[0] == 'd') && f[1] == '\0') return f[0];
+    return 0;
+}
+
+// Borrow a C-contiguous view of obj holding *count samples of the requested kind.
+// A real view of even length is accepted as interleaved complex.
+static int get_samples(PyObject* obj, Py_buffer* v, int writable, int kind, size_t* count, const char* what) {
+    const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, v, flags) != 0) return -1;
+    const char k = buffer_kind(v);
+    const char real_k = REAL_FORMAT, cpx_k = REAL_FORMAT == 'f' ? 'F' : 'D';
+    const size_t bytes = (size_t)v->len;
+    if (k == (kind == BUF_CPX ? cpx_k : real_k)) {
+        *count = bytes / (kind == BUF_CPX ? sizeof(vv_dsp_cpx) : sizeof(vv_dsp_real));
+        return 0;
+    }
+    if (kind == BUF_CPX && k == real_k && bytes % sizeof(vv_dsp_cpx) == 0) {
+        *count = bytes / sizeof(vv_dsp_cpx);
+        return 0;
+    }
+    PyErr_Format(PyExc_TypeError, "%s must be a contiguous %s buffer of %s samples", what,
+                 kind == BUF_CPX ? "complex (or interleaved real)" : "real",
+                 REAL_FORMAT == 'f' ? "float32" : "float64");
+    PyBuffer_Release(v);
+    return -1;
+}
+
+static int check_count(size_t have, size_t need, const char* what) {
+    if (have >= need) return 0;
+    PyErr_Format(PyExc_ValueError, "%s holds %zu samples, %zu needed", what, have, need);
+    return -1;
+}
+
+// Common head of every object: the per-object lock taken with the GIL released
+typedef struct {
+    PyObject_HEAD
+    PyThread_type_lock lock;
+} locked_object;
+
+static int lock_init(locked_object* o) {
+    o->lock = PyThread_allocate_lock();
+    if (!o->lock) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+static void lock_free(locked_object* o) {
+    if (o->lock) PyThread_free_lock(o->lock);
+    o->lock = NULL;
+}
+
+#define RUN_UNLOCKED(self, stmt)                                                \
+    do {                                                                        \
+        Py_BEGIN_ALLOW_THREADS                                                  \
+        PyThread_acquire_lock(((locked_object*)(self))->lock, WAIT_LOCK);       \
+        stmt;                                                                   \
+        PyThread_release_lock(((locked_object*)(self))->lock);                  \
+        Py_END_ALLOW_THREADS                                                    \
+    } while (0)
+
+// ---------------------------------------------------------------------------
+// Fft
+
+typedef struct {
+    locked_object base;
+    vv_dsp_fft_plan* plan;
+    size_t n;
+    vv_dsp_fft_type type;
+} FftObject;
+
+static int Fft_init(FftObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"n", "kind", "inverse", NULL};
+    Py_ssize_t n = 0;
+    const char* kind = "c2c";
+    int inverse = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|sp", kwlist, &n, &kind, &inverse)) return -1;
+    vv_dsp_fft_type type;
+    if (!strcmp(kind, "c2c")) type = VV_DSP_FFT_C2C;
+    else if (!strcmp(kind, "r2c")) type = VV_DSP_FFT_R2C;
+    else if (!strcmp(kind, "c2r")) type = VV_DSP_FFT_C2R;
+    else {
+        PyErr_SetString(PyExc_ValueError, "kind must be 'c2c', 'r2c' or 'c2r'");
+        return -1;
+    }
+    if (n <= 0) {
+        PyErr_SetString(PyExc_ValueError, "n must be positive");
+        return -1;
+    }
+    if (self->plan || (!self->base.lock && lock_init(&self->base) != 0)) {
+        if (self->plan) PyErr_SetString(PyExc_RuntimeError, "Fft is already initialized");
+        return -1;
+    }
+    const vv_dsp_status st = vv_dsp_fft_make_plan((size_t)n, type,
+                                                  inverse ? VV_DSP_FFT_BACKWARD : VV_DSP_FFT_FORWARD,
+                                                  &self->plan);
+    if (st != VV_DSP_OK) {
+        raise_status(st);
+        return -1;
+    }
+    self->n = (size_t)n;
+    self->type = type;
+    return 0;
+}
+
+static void Fft_dealloc(FftObject* self) {
+    if (self->plan) (void)vv_dsp_fft_destroy(self->plan);
+    lock_free(&self->base);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Fft_execute(FftObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->plan) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    const size_t half = self->n / 2 + 1;
+    const int in_kind = self->type == VV_DSP_FFT_R2C ? BUF_REAL : BUF_CPX;
+    const int out_kind = self->type == VV_DSP_FFT_C2R ? BUF_REAL : BUF_CPX;
+    const size_t in_need = self->type == VV_DSP_FFT_C2R ? half : self->n;
+    const size_t out_need = self->type == VV_DSP_FFT_R2C ? half : self->n;
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0;
+    if (get_samples(in_obj, &in, 0, in_kind, &in_n, "input") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, out_kind, &out_n, "output") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    vv_dsp_status st = VV_DSP_ERROR_INVALID_SIZE;
+    if (check_count(in_n, in_need, "input") == 0 && check_count(out_n, out_need, "output") == 0) {
+        RUN_UNLOCKED(self, st = vv_dsp_fft_execute(self->plan, in.buf, out.buf));
+    }
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (PyErr_Occurred()) return NULL;
+    if (st != VV_DSP_OK) return raise_status(st);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Fft_get_n(FftObject* self, void* closure) {
+    (void)closure;
+    return PyLong_FromSize_t(self->n);
+}
+
+static PyMethodDef Fft_methods[] = {
+    {"execute", (PyCFunction)Fft_execute, METH_VARARGS,
+     "execute(input, output): transform input into output (backward transforms are scaled by 1/n)"},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef Fft_getset[] = {{"n", (getter)Fft_get_n, NULL, "Transform size", NULL},
+                                   {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject FftType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vv_dsp.Fft",
+    .tp_basicsize = sizeof(FftObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Fft(n, kind='c2c', inverse=False): FFT plan; kind is 'c2c', 'r2c' or 'c2r'",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Fft_init,
+    .tp_dealloc = (destructor)Fft_dealloc,
+    .tp_methods = Fft_methods,
+    .tp_getset = Fft_getset,
+};
+
+// ---------------------------------------------------------------------------
+// Stft
+
+typedef struct {
+    locked_object base;
+    vv_dsp_stft* h;
+    size_t fft_size;
+    size_t bins;
+} StftObject;
+
+static int stft_window(const char* name, vv_dsp_stft_window* out) {
+    static const struct {
+        const char* name;
+        vv_dsp_stft_window w;
+    } table[] = {{"boxcar", VV_DSP_STFT_WIN_BOXCAR}, {"hann", VV_DSP_STFT_WIN_HANN},
+                 {"hamming", VV_DSP_STFT_WIN_HAMMING}, {"blackman", VV_DSP_STFT_WIN_BLACKMAN}};
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); ++i) {
+        if (!strcmp(name, table[i].name)) {
+            *out = table[i].w;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int Stft_init(StftObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"fft_size", "hop_size", "window", "half", NULL};
+    Py_ssize_t fft_size = 0, hop = 0;
+    const char* window = "hann";
+    int half = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "nn|sp", kwlist, &fft_size, &hop, &window, &half)) return -1;
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    if (stft_window(window, &p.window) != 0) {
+        PyErr_SetString(PyExc_ValueError, "window must be 'boxcar', 'hann', 'hamming' or 'blackman'");
+        return -1;
+    }
+    if (fft_size <= 0 || hop <= 0) {
+        PyErr_SetString(PyExc_ValueError, "fft_size and hop_size must be positive");
+        return -1;
+    }
+    if (self->h || (!self->base.lock && lock_init(&self->base) != 0)) {
+        if (self->h) PyErr_SetString(PyExc_RuntimeError, "Stft is already initialized");
+        return -1;
+    }
+    p.fft_size = (size_t)fft_size;
+    p.hop_size = (size_t)hop;
+    p.spectrum = half ? VV_DSP_STFT_SPECTRUM_HALF : VV_DSP_STFT_SPECTRUM_FULL;
+    p.periodic = 1;
+    const vv_dsp_status st = vv_dsp_stft_create(&p, &self->h);
+    if (st != VV_DSP_OK) {
+        raise_status(st);
+        return -1;
+    }
+    self->fft_size = p.fft_size;
+    self->bins = vv_dsp_stft_num_bins(self->h);
+    return 0;
+}
+
+static void Stft_dealloc(StftObject* self) {
+    if (self->h) (void)vv_dsp_stft_destroy(self->h);
+    lock_free(&self->base);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Stft_process(StftObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->h) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0;
+    if (get_samples(in_obj, &in, 0, BUF_REAL, &in_n, "frame") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, BUF_CPX, &out_n, "spectrum") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    vv_dsp_status st = VV_DSP_ERROR_INVALID_SIZE;
+    if (check_count(in_n, self->fft_size, "frame") == 0 && check_count(out_n, self->bins, "spectrum") == 0) {
+        RUN_UNLOCKED(self, st = vv_dsp_stft_process(self->h, (const vv_dsp_real*)in.buf, (vv_dsp_cpx*)out.buf));
+    }
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (PyErr_Occurred()) return NULL;
+    if (st != VV_DSP_OK) return raise_status(st);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Stft_num_frames(StftObject* self, PyObject* arg) {
+    const Py_ssize_t n = PyLong_AsSsize_t(arg);
+    if (n < 0) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "n must not be negative");
+        return NULL;
+    }
+    return PyLong_FromSize_t(vv_dsp_stft_spectrogram_frames(self->h, (size_t)n));
+}
+
+static PyObject* Stft_spectrogram(StftObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->h) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0, frames = 0;
+    if (get_samples(in_obj, &in, 0, BUF_REAL, &in_n, "signal") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, BUF_REAL, &out_n, "output") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    vv_dsp_status st = VV_DSP_ERROR_INVALID_SIZE;
+    const size_t rows = vv_dsp_stft_spectrogram_frames(self->h, in_n);
+    if (check_count(out_n, rows * self->bins, "output") == 0) {
+        RUN_UNLOCKED(self, st = vv_dsp_stft_spectrogram(self->h, (const vv_dsp_real*)in.buf, in_n,
+                                                        (vv_dsp_real*)out.buf, &frames));
+    }
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (PyErr_Occurred()) return NULL;
+    if (st != VV_DSP_OK) return raise_status(st);
+    return PyLong_FromSize_t(frames);
+}
+
+static PyObject* Stft_get_bins(StftObject* self, void* closure) {
+    (void)closure;
+    return PyLong_FromSize_t(self->bins);
+}
+
+static PyMethodDef Stft_methods[] = {
+    {"process", (PyCFunction)Stft_process, METH_VARARGS,
+     "process(frame, spectrum): window and transform one frame of fft_size samples"},
+    {"num_frames", (PyCFunction)Stft_num_frames, METH_O,
+     "num_frames(n): rows spectrogram() writes for n samples"},
+    {"spectrogram", (PyCFunction)Stft_spectrogram, METH_VARARGS,
+     "spectrogram(signal, output): magnitude rows of num_bins values; returns the row count"},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef Stft_getset[] = {{"num_bins", (getter)Stft_get_bins, NULL, "Complex bins per frame", NULL},
+                                    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject StftType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vv_dsp.Stft",
+    .tp_basicsize = sizeof(StftObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Stft(fft_size, hop_size, window='hann', half=True): STFT with a periodic window;\n"
+              "half selects the fft_size/2+1 bin layout",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Stft_init,
+    .tp_dealloc = (destructor)Stft_dealloc,
+    .tp_methods = Stft_methods,
+    .tp_getset = Stft_getset,
+};
+
+// ---------------------------------------------------------------------------
+// Fir
+
+typedef struct {
+    locked_object base;
+    vv_dsp_fir_state state;
+    vv_dsp_real* taps;
+    int ready;
+} FirObject;
+
+static int Fir_init(FirObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"taps", NULL};
+    PyObject* taps_obj;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &taps_obj)) return -1;
+    if (self->ready) {
+        PyErr_SetString(PyExc_RuntimeError, "Fir is already initialized");
+        return -1;
+    }
+    if (!self->base.lock && lock_init(&self->base) != 0) return -1;
+    Py_buffer v;
+    size_t n = 0;
+    if (get_samples(taps_obj, &v, 0, BUF_REAL, &n, "taps") != 0) return -1;
+    if (n == 0) {
+        PyBuffer_Release(&v);
+        PyErr_SetString(PyExc_ValueError, "taps must not be empty");
+        return -1;
+    }
+    self->taps = (vv_dsp_real*)PyMem_Malloc(n * sizeof(vv_dsp_real));
+    if (!self->taps) {
+        PyBuffer_Release(&v);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(self->taps, v.buf, n * sizeof(vv_dsp_real));
+    PyBuffer_Release(&v);
+    const vv_dsp_status st = vv_dsp_fir_state_init(&self->state, n);
+    if (st != VV_DSP_OK) {
+        PyMem_Free(self->taps);
+        self->taps = NULL;
+        raise_status(st);
+        return -1;
+    }
+    self->ready = 1;
+    return 0;
+}
+
+static void Fir_dealloc(FirObject* self) {
+    if (self->ready) vv_dsp_fir_state_free(&self->state);
+    PyMem_Free(self->taps);
+    lock_free(&self->base);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Fir_process(FirObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->ready) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0;
+    if (get_samples(in_obj, &in, 0, BUF_REAL, &in_n, "input") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, BUF_REAL, &out_n, "output") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    vv_dsp_status st = VV_DSP_ERROR_INVALID_SIZE;
+    if (check_count(out_n, in_n, "output") == 0) {
+        RUN_UNLOCKED(self, st = vv_dsp_fir_apply(&self->state, self->taps, (const vv_dsp_real*)in.buf,
+                                                 (vv_dsp_real*)out.buf, in_n));
+    }
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (PyErr_Occurred()) return NULL;
+    if (st != VV_DSP_OK) return raise_status(st);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Fir_prepare(FirObject* self, PyObject* arg) {
+    const Py_ssize_t n = PyLong_AsSsize_t(arg);
+    if (n < 0) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "max_block must not be negative");
+        return NULL;
+    }
+    if (!self->ready) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    vv_dsp_status st;
+    RUN_UNLOCKED(self, st = vv_dsp_fir_state_prepare(&self->state, (size_t)n));
+    if (st != VV_DSP_OK) return raise_status(st);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef Fir_methods[] = {
+    {"process", (PyCFunction)Fir_process, METH_VARARGS,
+     "process(input, output): filter the next block; output may be input"},
+    {"prepare", (PyCFunction)Fir_prepare, METH_O,
+     "prepare(max_block): keep the FFT plan blocks up to max_block would build per call"},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject FirType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vv_dsp.Fir",
+    .tp_basicsize = sizeof(FirObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Fir(taps): streaming FIR filter; the taps are copied",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Fir_init,
+    .tp_dealloc = (destructor)Fir_dealloc,
+    .tp_methods = Fir_methods,
+};
+
+// ---------------------------------------------------------------------------
+// Resampler
+
+typedef struct {
+    locked_object base;
+    vv_dsp_resampler* rs;
+} ResamplerObject;
+
+static int Resampler_init(ResamplerObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"ratio_num", "ratio_den", "sinc", "taps", NULL};
+    unsigned int num = 0, den = 0, taps = 32;
+    int sinc = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "II|pI", kwlist, &num, &den, &sinc, &taps)) return -1;
+    if (self->rs) {
+        PyErr_SetString(PyExc_RuntimeError, "Resampler is already initialized");
+        return -1;
+    }
+    if (!self->base.lock && lock_init(&self->base) != 0) return -1;
+    self->rs = vv_dsp_resampler_create(num, den);
+    if (!self->rs) {
+        PyErr_SetString(PyExc_ValueError, "invalid ratio");
+        return -1;
+    }
+    const int rc = vv_dsp_resampler_set_quality(self->rs, sinc, taps);
+    if (rc != VV_DSP_OK) {
+        raise_status((vv_dsp_status)rc);
+        return -1;
+    }
+    return 0;
+}
+
+static void Resampler_dealloc(ResamplerObject* self) {
+    if (self->rs) vv_dsp_resampler_destroy(self->rs);
+    lock_free(&self->base);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Resampler_process(ResamplerObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->rs) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0, written = 0;
+    if (get_samples(in_obj, &in, 0, BUF_REAL, &in_n, "input") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, BUF_REAL, &out_n, "output") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    int rc;
+    RUN_UNLOCKED(self, rc = vv_dsp_resampler_process_stream(self->rs, (const vv_dsp_real*)in.buf, in_n,
+                                                            (vv_dsp_real*)out.buf, out_n, &written));
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (rc != VV_DSP_OK) return raise_status((vv_dsp_status)rc);
+    return PyLong_FromSize_t(written);
+}
+
+static PyObject* Resampler_flush(ResamplerObject* self, PyObject* arg) {
+    if (!self->rs) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer out;
+    size_t out_n = 0, written = 0;
+    if (get_samples(arg, &out, 1, BUF_REAL, &out_n, "output") != 0) return NULL;
+    int rc;
+    RUN_UNLOCKED(self, rc = vv_dsp_resampler_flush(self->rs, (vv_dsp_real*)out.buf, out_n, &written));
+    PyBuffer_Release(&out);
+    if (rc != VV_DSP_OK) return raise_status((vv_dsp_status)rc);
+    return PyLong_FromSize_t(written);
+}
+
+static PyObject* Resampler_out_needed(ResamplerObject* self, PyObject* arg) {
+    const Py_ssize_t n = PyLong_AsSsize_t(arg);
+    if (n < 0) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "n must not be negative");
+        return NULL;
+    }
+    size_t need;
+    RUN_UNLOCKED(self, need = vv_dsp_resampler_out_needed(self->rs, (size_t)n));
+    return PyLong_FromSize_t(need);
+}
+
+static PyMethodDef Resampler_methods[] = {
+    {"process", (PyCFunction)Resampler_process, METH_VARARGS,
+     "process(input, output): consume a chunk of the stream; returns the samples written"},
+    {"flush", (PyCFunction)Resampler_flush, METH_O,
+     "flush(output): write the tail of the stream; returns the samples written"},
+    {"out_needed", (PyCFunction)Resampler_out_needed, METH_O,
+     "out_needed(n): samples the next process() call with n inputs writes"},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject ResamplerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vv_dsp.Resampler",
+    .tp_basicsize = sizeof(ResamplerObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Resampler(ratio_num, ratio_den, sinc=True, taps=32): streaming resampler,\n"
+              "out_rate / in_rate = ratio_num / ratio_den",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Resampler_init,
+    .tp_dealloc = (destructor)Resampler_dealloc,
+    .tp_methods = Resampler_methods,
+};
+
+// ---------------------------------------------------------------------------
+// Mfcc
+
+typedef struct {
+    locked_object base;
+    vv_dsp_mfcc_plan* plan;
+    size_t bins;
+    size_t coeffs;
+} MfccObject;
+
+static int Mfcc_init(MfccObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"n_fft", "n_mels", "n_coeffs", "sample_rate", "fmin", "fmax", "lifter", "log_epsilon",
+                             NULL};
+    Py_ssize_t n_fft = 0, n_mels = 0, n_coeffs = 0;
+    double sr = 0, fmin = 0, fmax = 0, lifter = 0, eps = 1e-10;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "nnnd|dddd", kwlist, &n_fft, &n_mels, &n_coeffs, &sr, &fmin,
+                                     &fmax, &lifter, &eps)) {
+        return -1;
+    }
+    if (n_fft <= 0 || n_mels <= 0 || n_coeffs <= 0) {
+        PyErr_SetString(PyExc_ValueError, "n_fft, n_mels and n_coeffs must be positive");
+        return -1;
+    }
+    if (self->plan || (!self->base.lock && lock_init(&self->base) != 0)) {
+        if (self->plan) PyErr_SetString(PyExc_RuntimeError, "Mfcc is already initialized");
+        return -1;
+    }
+    if (fmax <= 0) fmax = sr / 2;
+    const vv_dsp_status st = vv_dsp_mfcc_init((size_t)n_fft, (size_t)n_mels, (size_t)n_coeffs, (vv_dsp_real)sr,
+                                              (vv_dsp_real)fmin, (vv_dsp_real)fmax, VV_DSP_MEL_VARIANT_HTK,
+                                              VV_DSP_DCT_II, (vv_dsp_real)lifter, (vv_dsp_real)eps, &self->plan);
+    if (st != VV_DSP_OK) {
+        raise_status(st);
+        return -1;
+    }
+    self->bins = (size_t)n_fft / 2 + 1;
+    self->coeffs = (size_t)n_coeffs;
+    return 0;
+}
+
+static void Mfcc_dealloc(MfccObject* self) {
+    if (self->plan) (void)vv_dsp_mfcc_destroy(self->plan);
+    lock_free(&self->base);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Mfcc_process(MfccObject* self, PyObject* args) {
+    PyObject *in_obj, *out_obj;
+    if (!PyArg_ParseTuple(args, "OO", &in_obj, &out_obj)) return NULL;
+    if (!self->plan) return raise_status(VV_DSP_ERROR_NULL_POINTER);
+    Py_buffer in, out;
+    size_t in_n = 0, out_n = 0;
+    if (get_samples(in_obj, &in, 0, BUF_REAL, &in_n, "power spectrogram") != 0) return NULL;
+    if (get_samples(out_obj, &out, 1, BUF_REAL, &out_n, "output") != 0) {
+        PyBuffer_Release(&in);
+        return NULL;
+    }
+    const size_t frames = in_n / self->bins;
+    vv_dsp_status st = VV_DSP_ERROR_INVALID_SIZE;
+    if (in_n % self->bins != 0) {
+        PyErr_Format(PyExc_ValueError, "power spectrogram length is not a multiple of %zu bins", self->bins);
+    } else if (check_count(out_n, frames * self->coeffs, "output") == 0) {
+        RUN_UNLOCKED(self, st = vv_dsp_mfcc_process(self->plan, (const vv_dsp_real*)in.buf, frames,
+                                                    (vv_dsp_real*)out.buf));
+    }
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&out);
+    if (PyErr_Occurred()) return NULL;
+    if (st != VV_DSP_OK) return raise_status(st);
+    return PyLong_FromSize_t(frames);
+}
+
+static PyMethodDef Mfcc_methods[] = {
+    {"process", (PyCFunction)Mfcc_process, METH_VARARGS,
+     "process(power, output): MFCCs of power-spectrogram rows of n_fft/2+1 bins; returns the row count"},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject MfccType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "vv_dsp.Mfcc",
+    .tp_basicsize = sizeof(MfccObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Mfcc(n_fft, n_mels, n_coeffs, sample_rate, fmin=0, fmax=sample_rate/2, lifter=0,\n"
+              "log_epsilon=1e-10): MFCC plan over HTK mel filters and a DCT-II",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Mfcc_init,
+    .tp_dealloc = (destructor)Mfcc_dealloc,
+    .tp_methods = Mfcc_methods,
+};
+
+// ---------------------------------------------------------------------------
+// Module
+
+static struct PyModuleDef vv_dsp_module = {
+    PyModuleDef_HEAD_INIT,
+    "vv_dsp",
+    "Zero-copy bindings for vv-dsp plans over buffer-protocol arrays",
+    -1,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+};
+
+PyMODINIT_FUNC PyInit_vv_dsp(void) {
+    PyTypeObject* types[] = {&FftType, &StftType, &FirType, &ResamplerType, &MfccType};
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+        if (PyType_Ready(types[i]) < 0) return NULL;
+    }
+    PyObject* m = PyModule_Create(&vv_dsp_module);
+    if (!m) return NULL;
+    vv_error = PyErr_NewExceptionWithDoc("vv_dsp.Error", "vv-dsp call failed; .status holds the vv_dsp_status",
+                                         PyExc_RuntimeError, NULL);
+    if (!vv_error || PyModule_AddObject(m, "Error", vv_error) < 0) {
+        Py_XDECREF(vv_error);
+        Py_DECREF(m);
+        return NULL;
+    }
+    Py_INCREF(vv_error);
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+        const char* name = strchr(types[i]->tp_name, '.') + 1;
+        Py_INCREF(types[i]);
+        if (PyModule_AddObject(m, name, (PyObject*)types[i]) < 0) {
+            Py_DECREF(types[i]);
+            Py_DECREF(m);
+            return NULL;
+        }
+    }
+    if (PyModule_AddStringConstant(m, "sample_format", REAL_FORMAT == 'f' ? "f" : "d") < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
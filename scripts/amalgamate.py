@@ -0,0 +1,490 @@
+#!/usr/bin/env python3
+"""Generate the single-file build of vv-dsp: vv_dsp.h and vv_dsp.c.
+
+Usage: scripts/amalgamate.py [--out DIR] [--pocketfft DIR] [--no-audio]
+
+vv_dsp.h holds every public header. vv_dsp.c holds every library source and is
+the only file to compile; as one translation unit it lets the compiler inline
+across modules. It also carries what the module build only gets from CMake:
+
+  - the AVX2 / AVX-512 (x86-64) and NEON (32-bit ARM) copies of the core vector
+    kernels, each compiled under a target pragma next to the baseline copy, with
+    the runtime CPU dispatch tables that choose between them;
+  - the PocketFFT backend, when --pocketfft points at a pocketfft checkout
+    (pocketfft.c and pocketfft.h);
+  - the audio I/O module, unless --no-audio is given (it is then still only
+    compiled when VV_DSP_AUDIO_ENABLED is defined, as in the module build).
+
+Sources are taken from the module CMakeLists.txt files. File-scope names that
+two sources both define (static helpers, local types) are renamed per source
+with #define / #undef pairs, and each source's own macros are #undef'd after it,
+so the sources need no changes to be combined.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+INCLUDE = os.path.join(ROOT, "include")
+SRC = os.path.join(ROOT, "src")
+
+# Module order of the top-level CMakeLists.txt
+MODULES = ["core", "spectral", "filter", "resample", "envelope", "window", "adapters", "features", "graph"]
+
+# Sources that need a library the amalgamation does not bundle
+EXTERNAL_BACKENDS = {"fft_fftw.c", "fft_ffts.c", "fft_vdsp.c"}
+
+# Sources the module build only compiles with VV_DSP_ENABLE_FIXED_POINT
+FIXED_POINT_SOURCES = {"fir_fixed.c", "iir_fixed.c", "fft_fixed.c"}
+
+# Opening condition of each optional source group
+GROUP_CONDITION = {
+    "fixed": "defined(VV_DSP_FIXED_POINT_ENABLED)",
+    "audio": "defined(VV_DSP_AUDIO_ENABLED)",
+    "pocketfft": "defined(VV_DSP_BACKEND_FFT_pocketfft)",
+}
+
+# Kernel variants: source, dispatch macro, GCC target, clang target
+KERNEL_VARIANTS = [
+    ("simd_kernels_avx2.c", "VV_DSP_DISPATCH_AVX2", "avx2,fma", "avx2,fma"),
+    ("simd_kernels_avx512.c", "VV_DSP_DISPATCH_AVX512", "avx512f,avx2,fma", "avx512f,avx2,fma"),
+    ("simd_kernels_neon.c", "VV_DSP_DISPATCH_NEON", "fpu=neon", "neon"),
+]
+KERNEL_HEADER = os.path.join(SRC, "core", "simd_kernels.h")
+
+FEATURE_MACRO = re.compile(r"^\s*#\s*define\s+(_\w+_SOURCE|_FILE_OFFSET_BITS)\b")
+INCLUDE_LINE = re.compile(r'^\s*#\s*include\s*([<"])([^>"]+)[>"]')
+DEFINE_LINE = re.compile(r"^\s*#\s*define\s+(\w+)")
+IDENT = re.compile(r"[A-Za-z_]\w*")
+KEYWORDS = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum", "extern",
+    "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return", "short", "signed",
+    "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while",
+    "_Bool", "_Complex", "_Alignas", "_Alignof", "_Atomic", "_Static_assert", "_Thread_local", "__attribute__",
+    "__declspec", "__inline", "__inline__", "__restrict", "__restrict__", "__thread",
+}
+
+
+def rel(path):
+    return os.path.relpath(path, ROOT).replace(os.sep, "/")
+
+
+def read(path):
+    with open(path, encoding="utf-8") as f:
+        return f.read()
+
+
+def module_sources(module):
+    """The .c files a module's CMakeLists.txt names, in order."""
+    d = os.path.join(SRC, module)
+    names = []
+    for name in re.findall(r"[\w./${}]+\.c\b", read(os.path.join(d, "CMakeLists.txt"))):
+        if "$" in name or "/" in name or name in names:
+            continue
+        if os.path.exists(os.path.join(d, name)):
+            names.append(name)
+    return [os.path.join(d, n) for n in names]
+
+
+def strip_code(text):
+    """Text with comments, string and character literals and preprocessor lines blanked."""
+    out = []
+    i, n = 0, len(text)
+    line_start = True
+    while i < n:
+        c = text[i]
+        if line_start and c in " \t":
+            out.append(c)
+            i += 1
+            continue
+        if line_start and c == "#":
+            # preprocessor line, with continuations
+            while i < n and text[i] != "\n":
+                if text[i] == "\\" and i + 1 < n and text[i + 1] == "\n":
+                    i += 1
+                i += 1
+            continue
+        line_start = c == "\n"
+        if text.startswith("//", i):
+            while i < n and text[i] != "\n":
+                i += 1
+        elif text.startswith("/*", i):
+            j = text.find("*/", i + 2)
+            j = n if j < 0 else j + 2
+            out.append("\n" * text.count("\n", i, j))
+            i = j
+        elif c in "\"'":
+            j = i + 1
+            while j < n and text[j] != c:
+                j += 2 if text[j] == "\\" else 1
+            out.append(" ")
+            i = j + 1
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def file_scope_names(text):
+    """Identifiers a source defines at file scope with internal visibility: static
+    functions and variables, typedef names, struct/union/enum tags and enum constants."""
+    tokens = re.findall(r"[A-Za-z_]\w*|\d[\w.]*|\S", strip_code(text))
+    names = set()
+    depth = 0
+    stmt = []
+    enum_body = None
+    fn_body = False
+    for t in tokens:
+        if t == "{":
+            if depth == 0:
+                fn_body = bool(stmt) and stmt[-1] == ")"
+                enum_body = [] if "enum" in stmt and "=" not in stmt else None
+            depth += 1
+            continue
+        if t == "}":
+            depth -= 1
+            if depth == 0:
+                if enum_body is not None:
+                    names.update(enum_constants(enum_body))
+                    enum_body = None
+                stmt.append("{}")
+                if fn_body:
+                    names.update(statement_names(stmt))
+                    stmt = []
+            continue
+        if depth > 0:
+            if enum_body is not None and depth == 1:
+                enum_body.append(t)
+            continue
+        stmt.append(t)
+        if t == ";":
+            names.update(statement_names(stmt))
+            stmt = []
+    return names
+
+
+def enum_constants(body):
+    """First identifier of each comma-separated enumerator (at paren depth 0)."""
+    out, expect, level = set(), True, 0
+    for t in body:
+        if t == "(":
+            level += 1
+        elif t == ")":
+            level -= 1
+        elif t == "," and level == 0:
+            expect = True
+        elif expect and IDENT.fullmatch(t) and t not in KEYWORDS:
+            out.add(t)
+            expect = False
+    return out
+
+
+def statement_names(stmt):
+    """Names a file-scope declaration or function definition introduces (static ones
+    and typedef / tag names; names with external linkage cannot collide)."""
+    found = set()
+    for k in range(len(stmt) - 2):
+        if stmt[k] in ("struct", "union", "enum") and stmt[k + 2] == "{}" and IDENT.fullmatch(stmt[k + 1]):
+            found.add(stmt[k + 1])
+    if stmt and stmt[0] == "typedef":
+        if "(" in stmt and stmt[stmt.index("(") + 1] == "*":
+            found.add(stmt[stmt.index("(") + 2])  # typedef R (*name)(args);
+        else:
+            ids = [t for t in stmt if IDENT.fullmatch(t) and t not in KEYWORDS]
+            if ids:
+                found.add(ids[-1])
+    elif "static" in stmt:
+        # each declarator's name: the identifier right before '(' '[' '=' ',' ';' or a body
+        level, prev, in_init = 0, None, False
+        for t in stmt[stmt.index("static") + 1:]:
+            if level == 0 and t in ("(", "[", "=", ",", ";", "{}") and prev and not in_init:
+                found.add(prev)
+            if t in ("(", "["):
+                level += 1
+            elif t in (")", "]"):
+                level -= 1
+            elif level == 0 and t in ("=", ","):
+                in_init = t == "="
+            prev = t if level == 0 and IDENT.fullmatch(t) and t not in KEYWORDS else None
+    return {n for n in found if not n.startswith("__")}
+
+
+class Amalgamator:
+    def __init__(self, pocketfft):
+        self.pocketfft = pocketfft
+        self.seen = set()
+
+    def resolve(self, name, here, angle):
+        cands = []
+        if angle:
+            if self.pocketfft and name == "pocketfft.h":
+                cands.append(os.path.join(self.pocketfft, name))
+        else:
+            cands += [os.path.join(here, name), os.path.join(INCLUDE, name), os.path.join(SRC, "core", name)]
+        for c in cands:
+            if os.path.isfile(c):
+                return os.path.realpath(c)
+        return None
+
+    def inline(self, path, out, conditional=False, strip_guard=False):
+        """Append path to out with its project includes inlined at first use. Headers
+        reached inside a conditional block are inlined again at later uses (their
+        include guards keep that harmless)."""
+        here = os.path.dirname(path)
+        depth = 0
+        out.append(f"/* ---- {self.label(path)} ---- */\n")
+        lines = read(path).splitlines(keepends=True)
+        if strip_guard:
+            lines = self.without_guard(lines)
+        for line in lines:
+            s = line.lstrip()
+            if s.startswith("#"):
+                d = s[1:].lstrip()
+                if d.startswith("if"):
+                    depth += 1
+                elif d.startswith("endif"):
+                    depth -= 1
+            m = INCLUDE_LINE.match(line)
+            target = m and self.resolve(m.group(2), here, m.group(1) == "<")
+            if not target:
+                out.append(line)
+                continue
+            if target in self.seen:
+                continue
+            # inside a header, depth 1 is its include guard
+            cond = conditional or depth > (1 if path.endswith(".h") and not strip_guard else 0)
+            if not cond:
+                self.seen.add(target)
+            self.inline(target, out, cond)
+            out.append(f"/* ---- {self.label(path)} (continued) ---- */\n")
+        if not out[-1].endswith("\n"):
+            out.append("\n")
+
+    def label(self, path):
+        if self.pocketfft and path.startswith(os.path.realpath(self.pocketfft)):
+            return "pocketfft/" + os.path.basename(path)
+        return rel(path)
+
+    @staticmethod
+    def without_guard(lines):
+        """Lines of a header minus its #ifndef/#define/#endif include guard."""
+        idx = [i for i, l in enumerate(lines) if l.lstrip().startswith("#")]
+        if len(idx) < 3 or not lines[idx[0]].lstrip().startswith("#ifndef"):
+            return lines
+        return lines[:idx[0]] + lines[idx[1] + 1:idx[-1]] + lines[idx[-1] + 1:]
+
+
+def feature_prologue(path):
+    """The leading '#if ... #define _X_SOURCE ... #endif' blocks of a source."""
+    blocks, block = [], []
+    for line in read(path).splitlines(keepends=True):
+        s = line.strip()
+        if block:
+            block.append(line)
+            if s.startswith("#endif"):
+                if any(FEATURE_MACRO.match(b) for b in block):
+                    blocks.append("".join(block))
+                block = []
+        elif s.startswith("#if"):
+            block = [line]
+        elif FEATURE_MACRO.match(line):
+            blocks.append(line)
+        elif s.startswith("#include") or (s and not s.startswith(("/", "*")) and not s.startswith("#")):
+            break
+    return blocks
+
+
+def unit_macros(text):
+    """Macros a source defines for itself. Fallbacks under '#ifndef NAME' (M_PI and the
+    like) stay defined: undefining them would also drop a system header's definition."""
+    fallback = set(re.findall(r"^\s*#\s*(?:ifndef\s+|if\s+!\s*defined\s*\(?\s*)(\w+)", text, re.M))
+    return {m.group(1) for m in map(DEFINE_LINE.match, text.splitlines())
+            if m and not FEATURE_MACRO.match(m.group(0)) and m.group(1) not in fallback}
+
+
+def tag_of(path):
+    return re.sub(r"\W", "_", os.path.splitext(os.path.relpath(path, SRC) if path.startswith(SRC) else
+                                              "pocketfft_" + os.path.basename(path))[0])
+
+
+def generate(out_dir, pocketfft, audio):
+    if pocketfft and not os.path.isfile(os.path.join(pocketfft, "pocketfft.c")):
+        sys.exit(f"amalgamate: no pocketfft.c in {pocketfft}")
+    am = Amalgamator(pocketfft)
+    variant_files = {v[0] for v in KERNEL_VARIANTS}
+
+    # ---- header: the umbrella header, then every other public header
+    header = []
+    umbrella = os.path.realpath(os.path.join(INCLUDE, "vv_dsp", "vv_dsp.h"))
+    am.seen.add(umbrella)
+    am.inline(umbrella, header)
+    for dirpath, _, files in sorted(os.walk(os.path.join(INCLUDE, "vv_dsp"))):
+        for f in sorted(files):
+            p = os.path.realpath(os.path.join(dirpath, f))
+            if not f.endswith(".h") or p in am.seen or "/audio" in rel(p):
+                continue
+            am.seen.add(p)
+            am.inline(p, header)
+
+    # ---- sources
+    units = []  # (path, group) in build order; group is None or a GROUP_CONDITION key
+    for module in MODULES:
+        for p in module_sources(module):
+            b = os.path.basename(p)
+            if b in EXTERNAL_BACKENDS or b in variant_files:
+                continue
+            units.append((os.path.realpath(p), "fixed" if b in FIXED_POINT_SOURCES else None))
+    if audio:
+        units += [(os.path.realpath(p), "audio") for p in module_sources("audio")]
+    if pocketfft:
+        units.append((os.path.realpath(os.path.join(pocketfft, "pocketfft.c")), "pocketfft"))
+
+    texts = {p: read(p) for p, _ in units}
+    defined = {p: file_scope_names(t) for p, t in texts.items()}
+    counts = {}
+    for names in defined.values():
+        for n in names:
+            counts[n] = counts.get(n, 0) + 1
+
+    prologue, hoisted = [], set()
+    for p, _ in units:
+        for b in feature_prologue(p):
+            names = {m.group(1) for m in map(FEATURE_MACRO.match, b.splitlines()) if m}
+            if not names <= hoisted:
+                prologue.append(b)
+                hoisted |= names
+
+    body = []
+    for p, group in units:
+        renames = sorted(n for n in defined[p] if counts[n] > 1)
+        macros = sorted(unit_macros(texts[p]))
+        if group:
+            body.append(f"#if {GROUP_CONDITION[group]}\n")
+        tag = tag_of(p)
+        body += [f"#define {n} vv_dsp__{tag}__{n}\n" for n in renames]
+        am.inline(p, body)
+        body += [f"#undef {n}\n" for n in renames + macros]
+        if group:
+            body.append("#endif\n")
+        if os.path.basename(p) == "simd_kernels_base.c":
+            body += kernel_variants(am)
+
+    write(os.path.join(out_dir, "vv_dsp.h"), header_text(header))
+    write(os.path.join(out_dir, "vv_dsp.c"), source_text(prologue, body, pocketfft, audio))
+
+
+def kernel_variants(am):
+    """The kernel header and each variant source again, under the variant's target and
+    with the kernel names suffixed, right after the baseline copy."""
+    out = []
+    names = file_scope_names(read(KERNEL_HEADER))
+    for src, macro, gcc_target, clang_target in KERNEL_VARIANTS:
+        path = os.path.join(SRC, "core", src)
+        suffix = macro.rsplit("_", 1)[1].lower()
+        text = read(path)
+        macros = sorted(unit_macros(read(KERNEL_HEADER)) - {"VV_DSP_CORE_SIMD_KERNELS_H"})
+        out.append(f"#if defined({macro})\n"
+                   f"#if defined(__clang__)\n"
+                   f"#pragma clang attribute push(__attribute__((target(\"{clang_target}\"))), apply_to = function)\n"
+                   f"#elif defined(__GNUC__)\n#pragma GCC push_options\n#pragma GCC target(\"{gcc_target}\")\n#endif\n")
+        out += [f"#define {n} {n}_{suffix}\n" for n in sorted(names)]
+        am.inline(KERNEL_HEADER, out, conditional=True, strip_guard=True)
+        out.append(f"/* ---- {rel(path)} ---- */\n")
+        # the ISA check is the pragma's job here; the include was inlined above
+        out += [l for l in variant_body(text)]
+        out += [f"#undef {n}\n" for n in sorted(names) + macros]
+        out.append("#if defined(__clang__)\n#pragma clang attribute pop\n"
+                   "#elif defined(__GNUC__)\n#pragma GCC pop_options\n#endif\n#endif\n")
+    return out
+
+
+def variant_body(text):
+    lines = text.splitlines(keepends=True)
+    out, skip = [], False
+    for line in lines:
+        s = line.strip()
+        if s.startswith("#if !defined(__"):
+            skip = True
+            continue
+        if skip:
+            skip = not s.startswith("#endif")
+            continue
+        if INCLUDE_LINE.match(line):
+            continue
+        out.append(line)
+    return out
+
+
+def header_text(body):
+    return ("/*\n"
+            "This file is part of vv-dsp\n\n"
+            "Single-file build, public half: every vv-dsp header. Generated by\n"
+            "scripts/amalgamate.py; do not edit. Compile vv_dsp.c next to it.\n"
+            "*/\n\n"
+            "#ifndef VV_DSP_AMALGAMATION_H\n#define VV_DSP_AMALGAMATION_H\n\n"
+            "#ifndef VV_DSP_SINGLE_FILE\n#define VV_DSP_SINGLE_FILE 1\n#endif\n"
+            "// As the VV_DSP_ENABLE_FIXED_POINT default of the module build\n"
+            "#if !defined(VV_DSP_FIXED_POINT_ENABLED) && !defined(VV_DSP_NO_FIXED_POINT)\n"
+            "#define VV_DSP_FIXED_POINT_ENABLED 1\n#endif\n\n"
+            + "".join(body) +
+            "\n#endif /* VV_DSP_AMALGAMATION_H */\n")
+
+
+def source_text(prologue, body, pocketfft, audio):
+    cfg = ["/*\n",
+           "This file is part of vv-dsp\n\n",
+           "Single-file build, implementation half: every vv-dsp source in one translation\n",
+           "unit. Generated by scripts/amalgamate.py; do not edit.\n\n",
+           "Configuration macros (define before compiling this file):\n",
+           "  VV_DSP_NO_RUNTIME_DISPATCH  baseline kernels only, as VV_DSP_RUNTIME_DISPATCH=OFF\n",
+           "  VV_DSP_USE_DOUBLE           double-precision vv_dsp_real\n",
+           "  VV_DSP_NO_FIXED_POINT       leave out the Q15/Q31 kernels\n",
+           ]
+    if pocketfft:
+        cfg.append("  VV_DSP_NO_POCKETFFT         leave out the bundled PocketFFT backend\n")
+    if audio:
+        cfg.append("  VV_DSP_AUDIO_ENABLED        compile the audio I/O module\n")
+    cfg.append("Link libm and pthreads. -fno-math-errno, which the module build gives the\n"
+               "kernel files, lets the square-root kernel vectorize; results are the same.\n*/\n\n")
+    cfg += ["// Feature-test macros of the sources, ahead of every system header\n"] + prologue
+    cfg.append("\n// No FMA contraction in the whole file, as the module build compiles the kernel\n"
+               "// files: every dispatch level then returns the same bits\n"
+               "#if defined(__clang__)\n#pragma STDC FP_CONTRACT OFF\n"
+               "#elif defined(__GNUC__)\n#pragma GCC optimize(\"fp-contract=off\")\n#endif\n")
+    cfg.append("\n#include \"vv_dsp.h\"\n\n"
+               "#ifndef VV_DSP_BACKEND_FFT_kissfft\n#define VV_DSP_BACKEND_FFT_kissfft\n#endif\n")
+    if pocketfft:
+        cfg.append("#if !defined(VV_DSP_NO_POCKETFFT) && !defined(VV_DSP_BACKEND_FFT_pocketfft)\n"
+                   "#define VV_DSP_BACKEND_FFT_pocketfft\n#endif\n")
+    cfg.append("\n// Kernel variants the compiler can target from one translation unit: x86-64\n"
+               "// GCC/clang get AVX2 and AVX-512, 32-bit ARM GCC/clang NEON (AArch64 has NEON\n"
+               "// in its baseline). Other compilers keep the baseline table.\n"
+               "#if !defined(VV_DSP_NO_RUNTIME_DISPATCH) && (defined(__GNUC__) || defined(__clang__))\n"
+               "#if defined(__x86_64__)\n"
+               "#ifndef VV_DSP_DISPATCH_AVX2\n#define VV_DSP_DISPATCH_AVX2 1\n#endif\n"
+               "#ifndef VV_DSP_DISPATCH_AVX512\n#define VV_DSP_DISPATCH_AVX512 1\n#endif\n"
+               "#elif defined(__arm__) && defined(__linux__) && !defined(__ARM_NEON)\n"
+               "#ifndef VV_DSP_DISPATCH_NEON\n#define VV_DSP_DISPATCH_NEON 1\n#endif\n"
+               "#endif\n#endif\n\n")
+    return "".join(cfg + body)
+
+
+def write(path, text):
+    os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+    with open(path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--out", default=os.path.join(ROOT, "amalgamation"), help="output directory")
+    ap.add_argument("--pocketfft", help="pocketfft checkout to bundle as an FFT backend")
+    ap.add_argument("--no-audio", action="store_true", help="leave out the audio I/O module")
+    args = ap.parse_args()
+    generate(args.out, args.pocketfft and os.path.realpath(args.pocketfft), not args.no_audio)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,464 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  // mmap
+#endif
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64  // stores past 2 GB on 32-bit hosts
+#endif
+
+#include "vv_dsp/audio/feature_store.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define FS_MAGIC    0x53465656  // 'VVFS' in little-endian
+#define FS_VERSION  1           // vv_dsp_real data
+#define FS_VERSION_STORAGE 2    // storage block after the header
+#define FS_ALIGN    64          // chunk data and index alignment
+
+// File header
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t real_bytes;      // sizeof(vv_dsp_real) of the writer
+    uint32_t dim;
+    double sample_rate;
+    uint64_t hop;
+    uint64_t num_chunks;
+    uint64_t total_frames;
+    uint64_t index_offset;    // 0 until the writer is closed
+    uint64_t reserved;
+} fs_header;
+
+// Version 2 storage block, right after the header
+typedef struct {
+    uint32_t type;            // vv_dsp_storage_type
+    uint32_t reserved0;
+    double lo;
+    double hi;
+    uint64_t reserved[5];
+} fs_storage;
+
+// Values encoded per fwrite of a converted chunk
+#define FS_ENCODE_BLOCK 4096
+
+// Index entry
+typedef struct {
+    uint64_t data_offset;
+    uint64_t frames;
+    uint64_t key_offset;      // into the key blob
+} fs_entry;
+
+struct vv_dsp_feature_store_writer {
+    FILE* fp;
+    fs_header header;
+    vv_dsp_quant quant;
+    uint8_t* encoded;         // FS_ENCODE_BLOCK elements, NULL for vv_dsp_real data
+    uint64_t offset;          // bytes written so far
+    fs_entry* entries;
+    size_t num_entries;
+    size_t entries_cap;
+    char* keys;               // NUL-terminated keys back to back
+    size_t keys_bytes;
+    size_t keys_cap;
+};
+
+// Checks that need the whole index (offsets, key terminators) run when a chunk is
+// touched, so opening costs the same for any number of chunks
+struct vv_dsp_feature_store {
+    const uint8_t* base;
+    size_t size;
+    fs_header header;
+    vv_dsp_quant quant;
+    size_t elem_bytes;        // bytes per stored value
+    size_t data_start;        // header and storage block bytes
+    const fs_entry* entries;
+    const uint32_t* sorted;   // chunk indices in key order
+    const char* keys;
+    size_t keys_bytes;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+typedef struct {
+    const char* key;
+    uint32_t index;
+} fs_sort_item;
+
+static int fs_compare_keys(const void* a, const void* b) {
+    const fs_sort_item* x = (const fs_sort_item*)a;
+    const fs_sort_item* y = (const fs_sort_item*)b;
+    const int c = strcmp(x->key, y->key);
+    if (c) return c;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// Write zeros up to the next multiple of FS_ALIGN
+static int fs_pad(vv_dsp_feature_store_writer* w) {
+    static const uint8_t zeros[FS_ALIGN] = { 0 };
+    const size_t pad = (size_t)((FS_ALIGN - w->offset % FS_ALIGN) % FS_ALIGN);
+    if (pad && fwrite(zeros, 1, pad, w->fp) != pad) return 0;
+    w->offset += pad;
+    return 1;
+}
+
+static void fs_writer_free(vv_dsp_feature_store_writer* w) {
+    if (w->fp) fclose(w->fp);
+    vv_dsp_free(w->entries);
+    vv_dsp_free(w->keys);
+    vv_dsp_free(w->encoded);
+    vv_dsp_free(w);
+}
+
+vv_dsp_status vv_dsp_feature_store_writer_open(const char* filepath,
+                                               size_t dim,
+                                               size_t hop,
+                                               double sample_rate,
+                                               vv_dsp_feature_store_writer** out_writer) {
+    return vv_dsp_feature_store_writer_open_ex(filepath, dim, hop, sample_rate, NULL, out_writer);
+}
+
+vv_dsp_status vv_dsp_feature_store_writer_open_ex(const char* filepath,
+                                                  size_t dim,
+                                                  size_t hop,
+                                                  double sample_rate,
+                                                  const vv_dsp_quant* quant,
+                                                  vv_dsp_feature_store_writer** out_writer) {
+    if (!filepath || !out_writer) return VV_DSP_ERROR_NULL_POINTER;
+    *out_writer = NULL;
+    if (dim == 0 || dim > UINT32_MAX || sample_rate < 0.0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (quant && !vv_dsp_storage_bytes(quant->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    const int encoded = quant && quant->type != VV_DSP_STORAGE_REAL;
+
+    vv_dsp_feature_store_writer* w = (vv_dsp_feature_store_writer*)vv_dsp_calloc(1, sizeof(*w));
+    if (!w) return VV_DSP_ERROR_INTERNAL;
+    if (encoded) {
+        w->quant = *quant;
+        w->encoded = (uint8_t*)vv_dsp_malloc(FS_ENCODE_BLOCK * vv_dsp_storage_bytes(quant->type));
+    } else {
+        (void)vv_dsp_quant_init(&w->quant, VV_DSP_STORAGE_REAL, 0, 0);
+    }
+    w->header.magic = FS_MAGIC;
+    w->header.version = encoded ? FS_VERSION_STORAGE : FS_VERSION;
+    w->header.real_bytes = (uint32_t)sizeof(vv_dsp_real);
+    w->header.dim = (uint32_t)dim;
+    w->header.sample_rate = sample_rate;
+    w->header.hop = hop;
+    fs_storage block;
+    memset(&block, 0, sizeof(block));
+    block.type = (uint32_t)w->quant.type;
+    block.lo = (double)w->quant.lo;
+    block.hi = (double)w->quant.hi;
+    w->fp = (encoded && !w->encoded) ? NULL : fopen(filepath, "wb");
+    if (!w->fp || fwrite(&w->header, sizeof(w->header), 1, w->fp) != 1 ||
+        (encoded && fwrite(&block, sizeof(block), 1, w->fp) != 1)) {
+        fs_writer_free(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    w->offset = sizeof(w->header) + (encoded ? sizeof(block) : 0);
+    *out_writer = w;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_feature_store_write_chunk(vv_dsp_feature_store_writer* writer,
+                                               const char* key,
+                                               const vv_dsp_real* frames,
+                                               size_t num_frames) {
+    if (!writer || !key || (num_frames && !frames)) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t key_bytes = strlen(key) + 1;
+    const size_t dim = writer->header.dim;
+    const size_t elem_bytes = vv_dsp_storage_bytes(writer->quant.type);
+    if (key_bytes == 1 || writer->num_entries >= UINT32_MAX ||
+        num_frames > (size_t)-1 / sizeof(vv_dsp_real) / dim) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    // Grow the index and key blob first so a failure leaves the file consistent
+    if (writer->num_entries == writer->entries_cap) {
+        const size_t cap = writer->entries_cap ? writer->entries_cap * 2 : 64;
+        fs_entry* e = (fs_entry*)vv_dsp_realloc(writer->entries, cap * sizeof(fs_entry));
+        if (!e) return VV_DSP_ERROR_INTERNAL;
+        writer->entries = e;
+        writer->entries_cap = cap;
+    }
+    if (writer->keys_bytes + key_bytes > writer->keys_cap) {
+        size_t cap = writer->keys_cap ? writer->keys_cap : 1024;
+        while (cap < writer->keys_bytes + key_bytes) cap *= 2;
+        char* k = (char*)vv_dsp_realloc(writer->keys, cap);
+        if (!k) return VV_DSP_ERROR_INTERNAL;
+        writer->keys = k;
+        writer->keys_cap = cap;
+    }
+
+    const size_t bytes = num_frames * dim * elem_bytes;
+    if (!fs_pad(writer)) return VV_DSP_ERROR_INTERNAL;
+    fs_entry* e = &writer->entries[writer->num_entries];
+    e->data_offset = writer->offset;
+    e->frames = num_frames;
+    e->key_offset = writer->keys_bytes;
+    if (!writer->encoded) {
+        if (bytes && fwrite(frames, 1, bytes, writer->fp) != bytes) return VV_DSP_ERROR_INTERNAL;
+    } else {
+        // Encode through a block buffer so the chunk is never held converted in full
+        const size_t total = num_frames * dim;
+        for (size_t i = 0; i < total; i += FS_ENCODE_BLOCK) {
+            const size_t m = (total - i < FS_ENCODE_BLOCK) ? total - i : FS_ENCODE_BLOCK;
+            if (vv_dsp_quant_encode(&writer->quant, frames + i, m, writer->encoded) != VV_DSP_OK ||
+                fwrite(writer->encoded, elem_bytes, m, writer->fp) != m) {
+                return VV_DSP_ERROR_INTERNAL;
+            }
+        }
+    }
+    writer->offset += bytes;
+    memcpy(writer->keys + writer->keys_bytes, key, key_bytes);
+    writer->keys_bytes += key_bytes;
+    writer->num_entries++;
+    writer->header.total_frames += num_frames;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_feature_store_writer_close(vv_dsp_feature_store_writer* writer) {
+    if (!writer) return VV_DSP_OK;
+    const size_t n = writer->num_entries;
+
+    // Key order for binary search; ties keep insertion order
+    fs_sort_item* items = n ? (fs_sort_item*)vv_dsp_malloc(n * sizeof(fs_sort_item)) : NULL;
+    uint32_t* sorted = n ? (uint32_t*)vv_dsp_malloc(n * sizeof(uint32_t)) : NULL;
+    int ok = n == 0 || (items && sorted);
+    if (ok && n) {
+        for (size_t i = 0; i < n; i++) {
+            items[i].key = writer->keys + writer->entries[i].key_offset;
+            items[i].index = (uint32_t)i;
+        }
+        qsort(items, n, sizeof(fs_sort_item), fs_compare_keys);
+        for (size_t i = 0; i < n; i++) sorted[i] = items[i].index;
+    }
+
+    ok = ok && fs_pad(writer);
+    writer->header.index_offset = writer->offset;
+    writer->header.num_chunks = n;
+    ok = ok && (n == 0 || (fwrite(writer->entries, sizeof(fs_entry), n, writer->fp) == n &&
+                           fwrite(sorted, sizeof(uint32_t), n, writer->fp) == n &&
+                           fwrite(writer->keys, 1, writer->keys_bytes, writer->fp) == writer->keys_bytes));
+    ok = ok && fseek(writer->fp, 0, SEEK_SET) == 0 &&
+         fwrite(&writer->header, sizeof(writer->header), 1, writer->fp) == 1;
+    if (fclose(writer->fp) != 0) ok = 0;
+    writer->fp = NULL;
+
+    vv_dsp_free(items);
+    vv_dsp_free(sorted);
+    fs_writer_free(writer);
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+vv_dsp_status vv_dsp_feature_store_open(const char* filepath, vv_dsp_feature_store** out_store) {
+    if (!filepath || !out_store) return VV_DSP_ERROR_NULL_POINTER;
+    *out_store = NULL;
+
+    vv_dsp_feature_store* s = (vv_dsp_feature_store*)vv_dsp_calloc(1, sizeof(*s));
+    if (!s) return VV_DSP_ERROR_INTERNAL;
+    uint64_t file_size = 0;
+#if defined(_WIN32)
+    s->file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER sz;
+    if (s->file != INVALID_HANDLE_VALUE && GetFileSizeEx(s->file, &sz) && sz.QuadPart > 0 &&
+        (uint64_t)sz.QuadPart <= (uint64_t)SIZE_MAX) {
+        file_size = (uint64_t)sz.QuadPart;
+        s->mapping = CreateFileMappingA(s->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (s->mapping) {
+            s->base = (const uint8_t*)MapViewOfFile(s->mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+#else
+    int fd = open(filepath, O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= (uint64_t)SIZE_MAX) {
+        file_size = (uint64_t)st.st_size;
+        void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) s->base = (const uint8_t*)p;
+    }
+    if (fd >= 0) close(fd);  // the mapping keeps its own reference
+#endif
+    if (!s->base) {
+        vv_dsp_feature_store_close(s);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    s->size = (size_t)file_size;
+
+    // Header and index bounds; the last byte of the file must end a key so that
+    // no key comparison can run off the mapping
+    vv_dsp_status status = VV_DSP_OK;
+    fs_header* h = &s->header;
+    fs_storage block;
+    memset(&block, 0, sizeof(block));
+    if (s->size < sizeof(fs_header)) {
+        status = VV_DSP_ERROR_INVALID_SIZE;
+    } else {
+        memcpy(h, s->base, sizeof(*h));
+        s->data_start = sizeof(fs_header);
+        if (h->version == FS_VERSION_STORAGE && s->size >= sizeof(fs_header) + sizeof(fs_storage)) {
+            memcpy(&block, s->base + sizeof(fs_header), sizeof(block));
+            s->data_start += sizeof(fs_storage);
+        }
+        const uint64_t index_room = s->size - (h->index_offset < s->size ? h->index_offset : s->size);
+        if (h->magic != FS_MAGIC || (h->version != FS_VERSION && h->version != FS_VERSION_STORAGE) ||
+            (h->version == FS_VERSION_STORAGE && s->data_start == sizeof(fs_header)) || h->dim == 0 ||
+            h->index_offset < s->data_start || h->index_offset % FS_ALIGN != 0 || h->index_offset > s->size ||
+            h->num_chunks > index_room / (sizeof(fs_entry) + sizeof(uint32_t)) || s->base[s->size - 1] != 0) {
+            status = VV_DSP_ERROR_INVALID_SIZE;
+        } else {
+            status = vv_dsp_quant_init(&s->quant, (vv_dsp_storage_type)block.type, (vv_dsp_real)block.lo,
+                                       (vv_dsp_real)block.hi);
+            if (status == VV_DSP_ERROR_OUT_OF_RANGE) status = VV_DSP_ERROR_INVALID_SIZE;
+            if (status == VV_DSP_OK && s->quant.type == VV_DSP_STORAGE_REAL && h->real_bytes != sizeof(vv_dsp_real)) {
+                status = VV_DSP_ERROR_UNSUPPORTED;
+            }
+            s->elem_bytes = vv_dsp_storage_bytes(s->quant.type);
+        }
+    }
+    if (status != VV_DSP_OK) {
+        vv_dsp_feature_store_close(s);
+        return status;
+    }
+    const size_t n = (size_t)h->num_chunks;
+    s->entries = (const fs_entry*)(s->base + h->index_offset);
+    s->sorted = (const uint32_t*)(s->entries + n);
+    s->keys = (const char*)(s->sorted + n);
+    s->keys_bytes = s->size - (size_t)((const uint8_t*)s->keys - s->base);
+
+    *out_store = s;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_feature_store_close(vv_dsp_feature_store* store) {
+    if (!store) return;
+#if defined(_WIN32)
+    if (store->base) UnmapViewOfFile(store->base);
+    if (store->mapping) CloseHandle(store->mapping);
+    if (store->file && store->file != INVALID_HANDLE_VALUE) CloseHandle(store->file);
+#else
+    if (store->base) munmap((void*)store->base, store->size);
+#endif
+    vv_dsp_free(store);
+}
+
+vv_dsp_status vv_dsp_feature_store_get_info(const vv_dsp_feature_store* store,
+                                            vv_dsp_feature_store_info* out_info) {
+    if (!store || !out_info) return VV_DSP_ERROR_NULL_POINTER;
+    out_info->dim = store->header.dim;
+    out_info->hop = (size_t)store->header.hop;
+    out_info->sample_rate = store->header.sample_rate;
+    out_info->num_chunks = (size_t)store->header.num_chunks;
+    out_info->total_frames = store->header.total_frames;
+    out_info->storage = store->quant.type;
+    out_info->lo = (double)store->quant.lo;
+    out_info->hi = (double)store->quant.hi;
+    return VV_DSP_OK;
+}
+
+// Key of chunk index, or NULL for an offset outside the key blob
+static const char* fs_key(const vv_dsp_feature_store* s, size_t index) {
+    const uint64_t off = s->entries[index].key_offset;
+    return off < s->keys_bytes ? s->keys + off : NULL;
+}
+
+vv_dsp_status vv_dsp_feature_store_chunk(const vv_dsp_feature_store* store,
+                                         size_t index,
+                                         const char** out_key,
+                                         size_t* out_frames) {
+    if (!store) return VV_DSP_ERROR_NULL_POINTER;
+    if (index >= store->header.num_chunks) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const char* key = fs_key(store, index);
+    if (!key) return VV_DSP_ERROR_INVALID_SIZE;
+    if (out_key) *out_key = key;
+    if (out_frames) *out_frames = (size_t)store->entries[index].frames;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_feature_store_find(const vv_dsp_feature_store* store, const char* key) {
+    if (!store) return 0;
+    const size_t n = (size_t)store->header.num_chunks;
+    if (!key) return n;
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const uint32_t index = store->sorted[mid];
+        const char* k = index < n ? fs_key(store, index) : NULL;
+        if (!k) return n;
+        const int c = strcmp(k, key);
+        if (c == 0) return index;
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return n;
+}
+
+vv_dsp_status vv_dsp_feature_store_frames_raw(const vv_dsp_feature_store* store,
+                                              size_t chunk,
+                                              size_t first_frame,
+                                              size_t num_frames,
+                                              const void** out_frames) {
+    if (!store || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (chunk >= store->header.num_chunks) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const fs_entry* e = &store->entries[chunk];
+    if (first_frame > e->frames || num_frames > e->frames - first_frame) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    // The chunk must lie between the header and the index
+    const uint64_t frame_bytes = (uint64_t)store->header.dim * store->elem_bytes;
+    const uint64_t room = store->header.index_offset;
+    if (e->data_offset < store->data_start || e->data_offset % store->elem_bytes != 0 ||
+        e->data_offset > room || e->frames > (room - e->data_offset) / frame_bytes) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    *out_frames = store->base + e->data_offset + first_frame * frame_bytes;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_feature_store_frames(const vv_dsp_feature_store* store,
+                                          size_t chunk,
+                                          size_t first_frame,
+                                          size_t num_frames,
+                                          const vv_dsp_real** out_frames) {
+    if (!store || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (store->quant.type != VV_DSP_STORAGE_REAL) return VV_DSP_ERROR_UNSUPPORTED;
+    const void* p = NULL;
+    const vv_dsp_status s = vv_dsp_feature_store_frames_raw(store, chunk, first_frame, num_frames, &p);
+    if (s == VV_DSP_OK) *out_frames = (const vv_dsp_real*)p;
+    return s;
+}
+
+vv_dsp_status vv_dsp_feature_store_read(const vv_dsp_feature_store* store,
+                                        size_t chunk,
+                                        size_t first_frame,
+                                        size_t num_frames,
+                                        vv_dsp_real* out) {
+    if (!store || (num_frames && !out)) return VV_DSP_ERROR_NULL_POINTER;
+    const void* p = NULL;
+    const vv_dsp_status s = vv_dsp_feature_store_frames_raw(store, chunk, first_frame, num_frames, &p);
+    if (s != VV_DSP_OK) return s;
+    return vv_dsp_quant_decode(&store->quant, p, num_frames * store->header.dim, out);
+}
+
+int vv_dsp_feature_store_fetch(void* source,
+                               size_t first_frame,
+                               size_t num_frames,
+                               size_t row_size,
+                               vv_dsp_real* out) {
+    const vv_dsp_feature_store_source* src = (const vv_dsp_feature_store_source*)source;
+    if (!src || !src->store || !out || src->store->header.dim != row_size) return 0;
+    return vv_dsp_feature_store_read(src->store, src->chunk, first_frame, num_frames, out) == VV_DSP_OK;
+}
@@ -0,0 +1,259 @@
+#include "vv_dsp/audio/frq.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRQ_MAGIC        "FREQ0003"
+#define FRQ_HEADER_SIZE  40
+#define FRQ_BLOCK_FRAMES 256  // frames converted per read or write
+
+#define FRQ_FNV_OFFSET 0xCBF29CE484222325ull
+#define FRQ_FNV_PRIME  0x00000100000001B3ull
+
+// Little-endian fields, whatever the host order
+
+static uint32_t frq_get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t frq_get_u64(const unsigned char* p) {
+    return (uint64_t)frq_get_u32(p) | ((uint64_t)frq_get_u32(p + 4) << 32);
+}
+
+static double frq_get_f64(const unsigned char* p) {
+    const uint64_t bits = frq_get_u64(p);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static void frq_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static void frq_put_u64(unsigned char* p, uint64_t v) {
+    frq_put_u32(p, (uint32_t)v);
+    frq_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static void frq_put_f64(unsigned char* p, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    frq_put_u64(p, bits);
+}
+
+vv_dsp_status vv_dsp_frq_read(const char* filepath, vv_dsp_frq* out_frq) {
+    if (!filepath || !out_frq) return VV_DSP_ERROR_NULL_POINTER;
+    memset(out_frq, 0, sizeof(*out_frq));
+
+    FILE* fp = fopen(filepath, "rb");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+
+    unsigned char header[FRQ_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, FRQ_MAGIC, 8) != 0) {
+        fclose(fp);
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    const uint32_t hop = frq_get_u32(header + 8);
+    const uint32_t num_frames = frq_get_u32(header + 36);
+    if (hop == 0 || hop > INT32_MAX || num_frames > INT32_MAX) {
+        fclose(fp);
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    // One allocation holds both arrays
+    double* data = NULL;
+    if (num_frames) {
+        data = (double*)vv_dsp_calloc(num_frames, 2 * sizeof(double));  // calloc checks the product
+        if (!data) {
+            fclose(fp);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
+    unsigned char block[FRQ_BLOCK_FRAMES * 16];
+    for (size_t done = 0; done < num_frames;) {
+        size_t n = num_frames - done;
+        if (n > FRQ_BLOCK_FRAMES) n = FRQ_BLOCK_FRAMES;
+        if (fread(block, 16, n, fp) != n) {
+            vv_dsp_free(data);
+            fclose(fp);
+            return VV_DSP_ERROR_INVALID_SIZE;
+        }
+        for (size_t i = 0; i < n; i++) {
+            data[done + i] = frq_get_f64(block + 16 * i);
+            data[num_frames + done + i] = frq_get_f64(block + 16 * i + 8);
+        }
+        done += n;
+    }
+    fclose(fp);
+
+    out_frq->hop = hop;
+    out_frq->average_f0 = frq_get_f64(header + 12);
+    out_frq->source_hash = frq_get_u64(header + 20);
+    out_frq->num_frames = num_frames;
+    out_frq->f0 = data;
+    out_frq->amplitude = data ? data + num_frames : NULL;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_frq_write(const char* filepath, const vv_dsp_frq* frq) {
+    if (!filepath || !frq) return VV_DSP_ERROR_NULL_POINTER;
+    if (frq->num_frames && (!frq->f0 || !frq->amplitude)) return VV_DSP_ERROR_NULL_POINTER;
+    if (frq->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (frq->hop > INT32_MAX || frq->num_frames > INT32_MAX) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    unsigned char header[FRQ_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, FRQ_MAGIC, 8);
+    frq_put_u32(header + 8, (uint32_t)frq->hop);
+    frq_put_f64(header + 12, frq->average_f0);
+    frq_put_u64(header + 20, frq->source_hash);
+    frq_put_u32(header + 36, (uint32_t)frq->num_frames);
+
+    FILE* fp = fopen(filepath, "wb");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+    int ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+
+    unsigned char block[FRQ_BLOCK_FRAMES * 16];
+    for (size_t done = 0; ok && done < frq->num_frames;) {
+        size_t n = frq->num_frames - done;
+        if (n > FRQ_BLOCK_FRAMES) n = FRQ_BLOCK_FRAMES;
+        for (size_t i = 0; i < n; i++) {
+            frq_put_f64(block + 16 * i, frq->f0[done + i]);
+            frq_put_f64(block + 16 * i + 8, frq->amplitude[done + i]);
+        }
+        ok = fwrite(block, 16, n, fp) == n;
+        done += n;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+void vv_dsp_frq_free(vv_dsp_frq* frq) {
+    if (!frq) return;
+    vv_dsp_free(frq->f0);  // amplitude shares the allocation
+    memset(frq, 0, sizeof(*frq));
+}
+
+vv_dsp_status vv_dsp_frq_file_hash(const char* filepath, uint64_t* out_hash) {
+    if (!filepath || !out_hash) return VV_DSP_ERROR_NULL_POINTER;
+    FILE* fp = fopen(filepath, "rb");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+
+    uint64_t h = FRQ_FNV_OFFSET;
+    unsigned char block[65536];
+    size_t n;
+    while ((n = fread(block, 1, sizeof(block), fp)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            h ^= block[i];
+            h *= FRQ_FNV_PRIME;
+        }
+    }
+    const int ok = !ferror(fp);
+    fclose(fp);
+    if (!ok) return VV_DSP_ERROR_INTERNAL;
+    *out_hash = h ? h : 1;  // 0 means "unknown" in a map
+    return VV_DSP_OK;
+}
+
+#define PMK_MAGIC        "VVPMK001"
+#define PMK_HEADER_SIZE  28
+#define PMK_BLOCK_MARKS  256  // marks converted per read or write
+
+vv_dsp_status vv_dsp_pitch_marks_read(const char* filepath, vv_dsp_pitch_marks* out_marks) {
+    if (!filepath || !out_marks) return VV_DSP_ERROR_NULL_POINTER;
+    memset(out_marks, 0, sizeof(*out_marks));
+
+    FILE* fp = fopen(filepath, "rb");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+
+    unsigned char header[PMK_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, PMK_MAGIC, 8) != 0) {
+        fclose(fp);
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    const uint32_t num_marks = frq_get_u32(header + 24);
+    if (num_marks > INT32_MAX) {
+        fclose(fp);
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_pitch_mark* marks = NULL;
+    if (num_marks) {
+        marks = (vv_dsp_pitch_mark*)vv_dsp_calloc(num_marks, sizeof(vv_dsp_pitch_mark));
+        if (!marks) {
+            fclose(fp);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
+    unsigned char block[PMK_BLOCK_MARKS * 16];
+    for (size_t done = 0; done < num_marks;) {
+        size_t n = num_marks - done;
+        if (n > PMK_BLOCK_MARKS) n = PMK_BLOCK_MARKS;
+        if (fread(block, 16, n, fp) != n) {
+            vv_dsp_free(marks);
+            fclose(fp);
+            return VV_DSP_ERROR_INVALID_SIZE;
+        }
+        for (size_t i = 0; i < n; i++) {
+            marks[done + i].position = frq_get_u32(block + 16 * i);
+            marks[done + i].voiced = frq_get_u32(block + 16 * i + 4) != 0;
+            marks[done + i].period = frq_get_f64(block + 16 * i + 8);
+        }
+        done += n;
+    }
+    fclose(fp);
+
+    out_marks->sample_rate = frq_get_f64(header + 8);
+    out_marks->source_hash = frq_get_u64(header + 16);
+    out_marks->num_marks = num_marks;
+    out_marks->marks = marks;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_pitch_marks_write(const char* filepath, const vv_dsp_pitch_marks* marks) {
+    if (!filepath || !marks) return VV_DSP_ERROR_NULL_POINTER;
+    if (marks->num_marks && !marks->marks) return VV_DSP_ERROR_NULL_POINTER;
+    if (marks->num_marks > INT32_MAX) return VV_DSP_ERROR_OUT_OF_RANGE;
+    for (size_t i = 0; i < marks->num_marks; i++) {
+        if (marks->marks[i].position > INT32_MAX) return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    unsigned char header[PMK_HEADER_SIZE];
+    memcpy(header, PMK_MAGIC, 8);
+    frq_put_f64(header + 8, marks->sample_rate);
+    frq_put_u64(header + 16, marks->source_hash);
+    frq_put_u32(header + 24, (uint32_t)marks->num_marks);
+
+    FILE* fp = fopen(filepath, "wb");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+    int ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+
+    unsigned char block[PMK_BLOCK_MARKS * 16];
+    for (size_t done = 0; ok && done < marks->num_marks;) {
+        size_t n = marks->num_marks - done;
+        if (n > PMK_BLOCK_MARKS) n = PMK_BLOCK_MARKS;
+        for (size_t i = 0; i < n; i++) {
+            const vv_dsp_pitch_mark* m = &marks->marks[done + i];
+            frq_put_u32(block + 16 * i, (uint32_t)m->position);
+            frq_put_u32(block + 16 * i + 4, m->voiced ? 1u : 0u);
+            frq_put_f64(block + 16 * i + 8, m->period);
+        }
+        ok = fwrite(block, 16, n, fp) == n;
+        done += n;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+void vv_dsp_pitch_marks_free(vv_dsp_pitch_marks* marks) {
+    if (!marks) return;
+    vv_dsp_free(marks->marks);
+    memset(marks, 0, sizeof(*marks));
+}
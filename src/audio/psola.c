@@ -0,0 +1,256 @@
+#include "vv_dsp/audio/psola.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PSOLA_UNVOICED_F0 200.0  // unvoiced mark rate when the map has no average F0
+#define PSOLA_MIN_PERIOD  2.0    // shortest period (and target spacing) in samples
+
+typedef struct {
+    size_t offset;          // first sample in the pool
+    size_t half;            // rounded period; the grain spans 2 * half - 1 samples
+    double position;        // mark in the engine's samples
+    double period;
+    int voiced;
+} psola_grain;
+
+struct vv_dsp_psola {
+    double sample_rate;
+    size_t num_grains;
+    size_t max_half;
+    psola_grain* grains;
+    vv_dsp_real* pool;      // windowed grains, back to back
+};
+
+// F0 at sample t: voiced when the nearest frame is, linear between two voiced frames
+static double marks_f0_at(const vv_dsp_frq* frq, size_t t) {
+    const size_t i = t / frq->hop;
+    const double frac = (double)(t - i * frq->hop) / (double)frq->hop;
+    if (i + 1 >= frq->num_frames) return frq->f0[frq->num_frames - 1];
+    const double a = frq->f0[i], b = frq->f0[i + 1];
+    if (a > 0.0 && b > 0.0) return a + (b - a) * frac;
+    return frac < 0.5 ? a : b;
+}
+
+static int marks_push(vv_dsp_pitch_marks* m, size_t* cap, size_t position, double period, int voiced) {
+    if (m->num_marks == *cap) {
+        const size_t n = *cap ? *cap * 2 : 256;
+        vv_dsp_pitch_mark* p = (vv_dsp_pitch_mark*)vv_dsp_realloc(m->marks, n * sizeof(vv_dsp_pitch_mark));
+        if (!p) return 0;
+        m->marks = p;
+        *cap = n;
+    }
+    vv_dsp_pitch_mark* mk = &m->marks[m->num_marks++];
+    mk->position = position;
+    mk->period = period;
+    mk->voiced = voiced;
+    return 1;
+}
+
+vv_dsp_status vv_dsp_pitch_marks_compute(const vv_dsp_real* samples, size_t num_samples, double sample_rate,
+                                         const vv_dsp_frq* frq, vv_dsp_pitch_marks* out_marks) {
+    if (!samples || !frq || !out_marks) return VV_DSP_ERROR_NULL_POINTER;
+    memset(out_marks, 0, sizeof(*out_marks));
+    if (num_samples == 0 || frq->num_frames == 0 || frq->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!frq->f0) return VV_DSP_ERROR_NULL_POINTER;
+    if (!(sample_rate > 0.0) || !isfinite(sample_rate)) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    double unvoiced = sample_rate / (frq->average_f0 > 0.0 ? frq->average_f0 : PSOLA_UNVOICED_F0);
+    if (unvoiced < PSOLA_MIN_PERIOD) unvoiced = PSOLA_MIN_PERIOD;
+    const size_t unvoiced_step = (size_t)(unvoiced + 0.5);
+
+    vv_dsp_pitch_marks m;
+    memset(&m, 0, sizeof(m));
+    m.sample_rate = sample_rate;
+    m.source_hash = frq->source_hash;
+    size_t cap = 0;
+
+    // next: where the next mark is expected, one period after the last voiced mark
+    // or one unvoiced step after the last unvoiced one
+    size_t next = 0, last = 0;
+    int run = 0, have_last = 0;
+    vv_dsp_real polarity = 1;
+    while (next < num_samples) {
+        const double f0 = marks_f0_at(frq, next);
+        if (!(f0 > 0.0)) {
+            if (!marks_push(&m, &cap, next, unvoiced, 0)) goto oom;
+            last = next;
+            have_last = 1;
+            run = 0;
+            next += unvoiced_step;
+            continue;
+        }
+        double period = sample_rate / f0;
+        if (period < PSOLA_MIN_PERIOD) period = PSOLA_MIN_PERIOD;
+        size_t lo, hi;
+        if (!run) {
+            // First period of a voiced run: the peak of the dominant polarity
+            lo = next;
+            hi = next + (size_t)period;
+            if (hi > num_samples) hi = num_samples;
+            vv_dsp_real mx = samples[lo], mn = samples[lo];
+            for (size_t t = lo + 1; t < hi; t++) {
+                if (samples[t] > mx) mx = samples[t];
+                if (samples[t] < mn) mn = samples[t];
+            }
+            polarity = mx >= -mn ? (vv_dsp_real)1 : (vv_dsp_real)-1;
+        } else {
+            const size_t q = (size_t)(period * 0.25);
+            lo = next > q ? next - q : 0;
+            hi = next + q + 1;
+            if (hi > num_samples) hi = num_samples;
+        }
+        if (have_last && lo <= last) lo = last + 1;
+        if (lo >= hi) break;
+        size_t pos = lo;
+        for (size_t t = lo + 1; t < hi; t++) {
+            if (polarity * samples[t] > polarity * samples[pos]) pos = t;
+        }
+        if (!marks_push(&m, &cap, pos, period, 1)) goto oom;
+        last = pos;
+        have_last = 1;
+        run = 1;
+        next = pos + (size_t)(period + 0.5);
+    }
+
+    *out_marks = m;
+    return VV_DSP_OK;
+
+oom:
+    vv_dsp_free(m.marks);
+    return VV_DSP_ERROR_INTERNAL;
+}
+
+vv_dsp_status vv_dsp_psola_create(const vv_dsp_real* samples, size_t num_samples, size_t start_sample,
+                                  const vv_dsp_pitch_marks* marks, vv_dsp_psola** out_psola) {
+    if (!samples || !marks || !out_psola) return VV_DSP_ERROR_NULL_POINTER;
+    *out_psola = NULL;
+    if (num_samples == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (marks->num_marks && !marks->marks) return VV_DSP_ERROR_NULL_POINTER;
+    if (!(marks->sample_rate > 0.0) || !isfinite(marks->sample_rate)) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    // Marks within the samples, and the pool they need
+    size_t count = 0, pool_len = 0;
+    for (size_t i = 0; i < marks->num_marks; i++) {
+        const vv_dsp_pitch_mark* mk = &marks->marks[i];
+        if (mk->position < start_sample || mk->position - start_sample >= num_samples) continue;
+        const double p = mk->period > PSOLA_MIN_PERIOD ? mk->period : PSOLA_MIN_PERIOD;
+        size_t half = (size_t)(p + 0.5);
+        if (half > num_samples) half = num_samples;
+        count++;
+        pool_len += 2 * half - 1;
+    }
+
+    vv_dsp_psola* ps = (vv_dsp_psola*)vv_dsp_calloc(1, sizeof(vv_dsp_psola));
+    if (!ps) return VV_DSP_ERROR_INTERNAL;
+    ps->sample_rate = marks->sample_rate;
+    if (count) {
+        ps->grains = (psola_grain*)vv_dsp_malloc(count * sizeof(psola_grain));
+        ps->pool = (vv_dsp_real*)vv_dsp_malloc(pool_len * sizeof(vv_dsp_real));
+        if (!ps->grains || !ps->pool) {
+            vv_dsp_psola_destroy(ps);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
+    // Grain k: the source around its mark under a Hann window of half-width half
+    // (zero at +-half), so grains half samples apart sum to one
+    size_t offset = 0;
+    for (size_t i = 0; i < marks->num_marks; i++) {
+        const vv_dsp_pitch_mark* mk = &marks->marks[i];
+        if (mk->position < start_sample || mk->position - start_sample >= num_samples) continue;
+        const size_t centre = mk->position - start_sample;
+        const double p = mk->period > PSOLA_MIN_PERIOD ? mk->period : PSOLA_MIN_PERIOD;
+        size_t half = (size_t)(p + 0.5);
+        if (half > num_samples) half = num_samples;
+        psola_grain* g = &ps->grains[ps->num_grains++];
+        g->offset = offset;
+        g->half = half;
+        g->position = (double)centre;
+        g->period = p;
+        g->voiced = mk->voiced;
+        vv_dsp_real* dst = ps->pool + offset;
+        for (size_t j = 0; j + 1 < 2 * half; j++) {
+            // Source index centre + j - (half - 1)
+            const size_t s = centre + j;
+            vv_dsp_real x = 0;
+            if (s >= half - 1 && s - (half - 1) < num_samples) x = samples[s - (half - 1)];
+            const double u = ((double)j - (double)(half - 1)) / (double)half;
+            dst[j] = (vv_dsp_real)(0.5 + 0.5 * cos(VV_DSP_PI_D * u)) * x;
+        }
+        offset += 2 * half - 1;
+        if (half > ps->max_half) ps->max_half = half;
+    }
+
+    *out_psola = ps;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_psola_destroy(vv_dsp_psola* psola) {
+    if (!psola) return;
+    vv_dsp_free(psola->grains);
+    vv_dsp_free(psola->pool);
+    vv_dsp_free(psola);
+}
+
+size_t vv_dsp_psola_num_grains(const vv_dsp_psola* psola) {
+    return psola ? psola->num_grains : 0;
+}
+
+// Grain whose mark is nearest to source position s
+static size_t psola_nearest(const vv_dsp_psola* ps, double s) {
+    size_t lo = 0, hi = ps->num_grains;  // first grain at or after s in [lo, hi]
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (ps->grains[mid].position < s) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == ps->num_grains) return lo - 1;
+    if (lo > 0 && s - ps->grains[lo - 1].position < ps->grains[lo].position - s) return lo - 1;
+    return lo;
+}
+
+vv_dsp_status vv_dsp_psola_render(const vv_dsp_psola* psola, const vv_dsp_psola_note* note,
+                                  vv_dsp_real* out, size_t out_len) {
+    if (!psola || !note || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_len == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(note->source_rate >= 0.0) || !isfinite(note->source_rate) || !isfinite(note->source_start) ||
+        !(note->target_f0 >= 0.0) || !isfinite(note->target_f0)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    if (psola->num_grains == 0) return VV_DSP_OK;
+
+    // t: output position of the next grain's mark; grains past the end of out
+    // by more than the longest half-width contribute nothing
+    const double end = (double)out_len + (double)psola->max_half;
+    for (double t = 0.0; t < end;) {
+        const psola_grain* g = &psola->grains[psola_nearest(psola, note->source_start + t * note->source_rate)];
+        const size_t at = (size_t)t;
+        double f0 = note->target_f0;
+        if (note->f0_curve) f0 = at < out_len ? (double)note->f0_curve[at] : (double)note->f0_curve[out_len - 1];
+
+        double spacing = g->period;
+        vv_dsp_real gain = 1;
+        if (g->voiced && f0 > 0.0 && isfinite(f0)) {
+            spacing = psola->sample_rate / f0;
+            if (spacing < PSOLA_MIN_PERIOD) spacing = PSOLA_MIN_PERIOD;
+            gain = (vv_dsp_real)sqrt(spacing / (double)g->half);
+        }
+
+        // The grain spans [centre - half + 1, centre + half - 1], clipped to out
+        const size_t centre = (size_t)(t + 0.5);
+        const size_t len = 2 * g->half - 1;
+        const size_t skip = centre + 1 < g->half ? g->half - 1 - centre : 0;
+        const size_t start = centre + skip + 1 - g->half;
+        if (start < out_len && skip < len) {
+            const vv_dsp_status st = vv_dsp_overlap_add_frames(psola->pool + g->offset + skip, 1, len - skip,
+                                                               len - skip, NULL, gain, out + start,
+                                                               out_len - start);
+            if (st != VV_DSP_OK) return st;
+        }
+        t += spacing;
+    }
+    return VV_DSP_OK;
+}
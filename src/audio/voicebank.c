@@ -0,0 +1,438 @@
+#include "vv_dsp/audio/voicebank.h"
+#include "vv_dsp/audio/wav.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define VB_NONE ((size_t)-1)
+#define VB_MIX_FRAMES 1024  // frames mixed down per read for multi-channel files
+
+// oto.ini entry and its cache slot. Cached segments with no acquire outstanding
+// sit on the LRU list, most recent first; pinned ones are off the list.
+typedef struct {
+    size_t filename;       // offsets into the string pool
+    size_t alias;
+    size_t file;           // index into files
+    double offset, consonant, cutoff, preutterance, overlap;
+    vv_dsp_real* samples;  // NULL while not cached
+    size_t num_samples;
+    size_t start;
+    double sample_rate;
+    size_t refs;
+    size_t prev, next;
+} vb_entry;
+
+// WAV file, mapped on first use
+typedef struct {
+    size_t name;
+    size_t path;
+    vv_dsp_wav_map* map;
+} vb_file;
+
+typedef struct {
+    const char* key;
+    size_t index;
+} vb_sort_item;
+
+struct vv_dsp_voicebank {
+    char* strings;         // NUL-terminated strings back to back
+    size_t strings_bytes, strings_cap;
+    vb_entry* entries;
+    size_t num_entries, entries_cap;
+    vb_file* files;
+    size_t num_files, files_cap;
+    size_t* sorted;        // entry indices in alias order
+    size_t budget;
+    size_t lru_head, lru_tail;
+    size_t unpinned_bytes;
+    vv_dsp_voicebank_stats stats;
+};
+
+// Append a string of len bytes to the pool; returns its offset or VB_NONE
+static size_t vb_add_string(vv_dsp_voicebank* vb, const char* s, size_t len) {
+    if (vb->strings_bytes + len + 1 > vb->strings_cap) {
+        size_t cap = vb->strings_cap ? vb->strings_cap : 4096;
+        while (cap < vb->strings_bytes + len + 1) cap *= 2;
+        char* p = (char*)vv_dsp_realloc(vb->strings, cap);
+        if (!p) return VB_NONE;
+        vb->strings = p;
+        vb->strings_cap = cap;
+    }
+    const size_t off = vb->strings_bytes;
+    memcpy(vb->strings + off, s, len);
+    vb->strings[off + len] = '\0';
+    vb->strings_bytes += len + 1;
+    return off;
+}
+
+static int vb_compare_alias(const void* a, const void* b) {
+    const vb_sort_item* x = (const vb_sort_item*)a;
+    const vb_sort_item* y = (const vb_sort_item*)b;
+    const int c = strcmp(x->key, y->key);
+    if (c) return c;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// Index of a file name, registering it on first sight; entries of one file are
+// usually adjacent, so the last file is tried first
+static size_t vb_file_index(vv_dsp_voicebank* vb, const char* dir, const char* name, size_t len) {
+    if (vb->num_files) {
+        const char* last = vb->strings + vb->files[vb->num_files - 1].name;
+        if (strlen(last) == len && memcmp(last, name, len) == 0) return vb->num_files - 1;
+    }
+    for (size_t i = 0; i < vb->num_files; i++) {
+        const char* f = vb->strings + vb->files[i].name;
+        if (strlen(f) == len && memcmp(f, name, len) == 0) return i;
+    }
+    if (vb->num_files == vb->files_cap) {
+        const size_t cap = vb->files_cap ? vb->files_cap * 2 : 64;
+        vb_file* p = (vb_file*)vv_dsp_realloc(vb->files, cap * sizeof(vb_file));
+        if (!p) return VB_NONE;
+        vb->files = p;
+        vb->files_cap = cap;
+    }
+    const size_t dir_len = strlen(dir);
+    char* path = (char*)vv_dsp_malloc(dir_len + len + 2);
+    if (!path) return VB_NONE;
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    memcpy(path + dir_len + 1, name, len);
+    vb_file* f = &vb->files[vb->num_files];
+    f->name = vb_add_string(vb, name, len);
+    f->path = f->name == VB_NONE ? VB_NONE : vb_add_string(vb, path, dir_len + len + 1);
+    f->map = NULL;
+    vv_dsp_free(path);
+    if (f->path == VB_NONE) return VB_NONE;
+    return vb->num_files++;
+}
+
+// Parse one non-empty line "file=alias,offset,consonant,cutoff,preutterance,overlap"
+static vv_dsp_status vb_parse_line(vv_dsp_voicebank* vb, const char* dir, char* line) {
+    char* eq = strchr(line, '=');
+    if (!eq || eq == line) return VV_DSP_ERROR_INVALID_SIZE;
+    *eq = '\0';
+    char* fields[6] = { NULL };
+    size_t num_fields = 0;
+    for (char* p = eq + 1; num_fields < 6;) {
+        fields[num_fields++] = p;
+        char* comma = strchr(p, ',');
+        if (!comma) break;
+        *comma = '\0';
+        p = comma + 1;
+    }
+
+    if (vb->num_entries == vb->entries_cap) {
+        const size_t cap = vb->entries_cap ? vb->entries_cap * 2 : 256;
+        vb_entry* p = (vb_entry*)vv_dsp_realloc(vb->entries, cap * sizeof(vb_entry));
+        if (!p) return VV_DSP_ERROR_INTERNAL;
+        vb->entries = p;
+        vb->entries_cap = cap;
+    }
+    vb_entry* e = &vb->entries[vb->num_entries];
+    memset(e, 0, sizeof(*e));
+    e->prev = e->next = VB_NONE;
+
+    // Missing times are 0; present ones must be numbers
+    double* times[5] = { &e->offset, &e->consonant, &e->cutoff, &e->preutterance, &e->overlap };
+    for (size_t i = 1; i < num_fields; i++) {
+        char* end = NULL;
+        const double v = strtod(fields[i], &end);
+        while (*end == ' ' || *end == '\t') end++;
+        if (end == fields[i] || *end != '\0') return VV_DSP_ERROR_INVALID_SIZE;
+        *times[i - 1] = v;
+    }
+
+    const size_t name_len = strlen(line);
+    e->file = vb_file_index(vb, dir, line, name_len);
+    if (e->file == VB_NONE) return VV_DSP_ERROR_INTERNAL;
+    // An empty alias stands for the file name without its extension
+    const char* alias = fields[0];
+    size_t alias_len = strlen(alias);
+    if (alias_len == 0) {
+        alias = line;
+        const char* dot = strrchr(line, '.');
+        alias_len = dot ? (size_t)(dot - line) : name_len;
+    }
+    e->filename = vb->files[e->file].name;
+    e->alias = vb_add_string(vb, alias, alias_len);
+    if (e->alias == VB_NONE) return VV_DSP_ERROR_INTERNAL;
+    vb->num_entries++;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_voicebank_open(const char* directory,
+                                    size_t cache_budget_bytes,
+                                    vv_dsp_voicebank** out_voicebank) {
+    if (!directory || !out_voicebank) return VV_DSP_ERROR_NULL_POINTER;
+    *out_voicebank = NULL;
+
+    // Read oto.ini whole
+    const size_t dir_len = strlen(directory);
+    char* path = (char*)vv_dsp_malloc(dir_len + sizeof("/oto.ini"));
+    if (!path) return VV_DSP_ERROR_INTERNAL;
+    memcpy(path, directory, dir_len);
+    memcpy(path + dir_len, "/oto.ini", sizeof("/oto.ini"));
+    FILE* fp = fopen(path, "rb");
+    vv_dsp_free(path);
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+    char* text = NULL;
+    size_t len = 0, cap = 0;
+    for (;;) {
+        if (len + 4096 + 1 > cap) {
+            cap = cap ? cap * 2 : 65536;
+            char* p = (char*)vv_dsp_realloc(text, cap);
+            if (!p) {
+                vv_dsp_free(text);
+                fclose(fp);
+                return VV_DSP_ERROR_INTERNAL;
+            }
+            text = p;
+        }
+        const size_t got = fread(text + len, 1, 4096, fp);
+        len += got;
+        if (got < 4096) break;
+    }
+    const int read_error = ferror(fp);
+    fclose(fp);
+    if (read_error || !text) {
+        vv_dsp_free(text);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    text[len] = '\0';
+
+    vv_dsp_voicebank* vb = (vv_dsp_voicebank*)vv_dsp_calloc(1, sizeof(*vb));
+    if (!vb) {
+        vv_dsp_free(text);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    vb->budget = cache_budget_bytes;
+    vb->lru_head = vb->lru_tail = VB_NONE;
+
+    // One entry per line; CR LF endings, a UTF-8 BOM and blank lines are accepted
+    vv_dsp_status status = VV_DSP_OK;
+    char* line = text;
+    if (len >= 3 && memcmp(line, "\xEF\xBB\xBF", 3) == 0) line += 3;
+    while (status == VV_DSP_OK && *line) {
+        char* eol = strchr(line, '\n');
+        char* next = eol ? eol + 1 : line + strlen(line);
+        if (eol) *eol = '\0';
+        size_t n = strlen(line);
+        while (n && (line[n - 1] == '\r' || line[n - 1] == ' ' || line[n - 1] == '\t')) line[--n] = '\0';
+        if (n) status = vb_parse_line(vb, directory, line);
+        line = next;
+    }
+    vv_dsp_free(text);
+
+    // Alias order for lookups, ties in oto.ini order
+    if (status == VV_DSP_OK && vb->num_entries) {
+        vb_sort_item* items = (vb_sort_item*)vv_dsp_malloc(vb->num_entries * sizeof(vb_sort_item));
+        vb->sorted = (size_t*)vv_dsp_malloc(vb->num_entries * sizeof(size_t));
+        if (items && vb->sorted) {
+            for (size_t i = 0; i < vb->num_entries; i++) {
+                items[i].key = vb->strings + vb->entries[i].alias;
+                items[i].index = i;
+            }
+            qsort(items, vb->num_entries, sizeof(vb_sort_item), vb_compare_alias);
+            for (size_t i = 0; i < vb->num_entries; i++) vb->sorted[i] = items[i].index;
+        } else {
+            status = VV_DSP_ERROR_INTERNAL;
+        }
+        vv_dsp_free(items);
+    }
+    if (status != VV_DSP_OK) {
+        vv_dsp_voicebank_close(vb);
+        return status;
+    }
+    *out_voicebank = vb;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_voicebank_close(vv_dsp_voicebank* voicebank) {
+    if (!voicebank) return;
+    for (size_t i = 0; i < voicebank->num_entries; i++) vv_dsp_free(voicebank->entries[i].samples);
+    for (size_t i = 0; i < voicebank->num_files; i++) vv_dsp_wav_mmap_close(voicebank->files[i].map);
+    vv_dsp_free(voicebank->entries);
+    vv_dsp_free(voicebank->files);
+    vv_dsp_free(voicebank->sorted);
+    vv_dsp_free(voicebank->strings);
+    vv_dsp_free(voicebank);
+}
+
+size_t vv_dsp_voicebank_count(const vv_dsp_voicebank* voicebank) {
+    return voicebank ? voicebank->num_entries : 0;
+}
+
+vv_dsp_status vv_dsp_voicebank_entry(const vv_dsp_voicebank* voicebank,
+                                     size_t index,
+                                     vv_dsp_oto_entry* out_entry) {
+    if (!voicebank || !out_entry) return VV_DSP_ERROR_NULL_POINTER;
+    if (index >= voicebank->num_entries) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const vb_entry* e = &voicebank->entries[index];
+    out_entry->filename = voicebank->strings + e->filename;
+    out_entry->alias = voicebank->strings + e->alias;
+    out_entry->offset_ms = e->offset;
+    out_entry->consonant_ms = e->consonant;
+    out_entry->cutoff_ms = e->cutoff;
+    out_entry->preutterance_ms = e->preutterance;
+    out_entry->overlap_ms = e->overlap;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_voicebank_find(const vv_dsp_voicebank* voicebank, const char* alias) {
+    if (!voicebank) return 0;
+    const size_t n = voicebank->num_entries;
+    if (!alias) return n;
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(voicebank->strings + voicebank->entries[voicebank->sorted[mid]].alias, alias) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < n && strcmp(voicebank->strings + voicebank->entries[voicebank->sorted[lo]].alias, alias) == 0) {
+        return voicebank->sorted[lo];
+    }
+    return n;
+}
+
+static void vb_lru_unlink(vv_dsp_voicebank* vb, size_t index) {
+    vb_entry* e = &vb->entries[index];
+    if (e->prev != VB_NONE) vb->entries[e->prev].next = e->next; else vb->lru_head = e->next;
+    if (e->next != VB_NONE) vb->entries[e->next].prev = e->prev; else vb->lru_tail = e->prev;
+    e->prev = e->next = VB_NONE;
+}
+
+// Milliseconds to a sample count, negative times clamped to 0
+static size_t vb_ms_to_samples(double ms, double sample_rate) {
+    const double n = ms * sample_rate / 1000.0 + 0.5;
+    if (n >= (double)SIZE_MAX) return SIZE_MAX;
+    return n > 0.0 ? (size_t)n : 0;
+}
+
+// Decode the segment of entry e: [offset, cutoff) of its file, mixed to mono
+static vv_dsp_status vb_decode(vv_dsp_voicebank* vb, vb_entry* e) {
+    vb_file* f = &vb->files[e->file];
+    if (!f->map) {
+        vv_dsp_status status = vv_dsp_wav_mmap_open(vb->strings + f->path, &f->map);
+        if (status != VV_DSP_OK) return status;
+    }
+    vv_dsp_wav_info info;
+    vv_dsp_status status = vv_dsp_wav_mmap_info(f->map, &info);
+    if (status != VV_DSP_OK) return status;
+
+    const size_t total = info.num_samples;
+    size_t start = vb_ms_to_samples(e->offset, info.sample_rate);
+    if (start > total) start = total;
+    size_t end;
+    if (e->cutoff >= 0.0) {
+        const size_t trim = vb_ms_to_samples(e->cutoff, info.sample_rate);
+        end = trim < total ? total - trim : 0;
+    } else {
+        const size_t length = vb_ms_to_samples(-e->cutoff, info.sample_rate);
+        end = length < total - start ? start + length : total;
+    }
+    if (end < start) end = start;
+    const size_t n = end - start;
+
+    vv_dsp_real* samples = (vv_dsp_real*)vv_dsp_malloc((n ? n : 1) * sizeof(vv_dsp_real));
+    if (!samples) return VV_DSP_ERROR_INTERNAL;
+    size_t got = 0;
+    if (info.num_channels == 1) {
+        status = vv_dsp_wav_mmap_read_planar(f->map, start, &samples, n, &got);
+    } else {
+        // Mix down block by block
+        const size_t channels = (size_t)info.num_channels;
+        vv_dsp_real* block = (vv_dsp_real*)vv_dsp_malloc(VB_MIX_FRAMES * channels * sizeof(vv_dsp_real));
+        const vv_dsp_real gain = (vv_dsp_real)1 / (vv_dsp_real)channels;
+        status = block ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+        while (status == VV_DSP_OK && got < n) {
+            const size_t want = n - got < VB_MIX_FRAMES ? n - got : VB_MIX_FRAMES;
+            size_t frames = 0;
+            status = vv_dsp_wav_mmap_read_interleaved(f->map, start + got, block, want, &frames);
+            if (status != VV_DSP_OK || frames == 0) break;
+            for (size_t i = 0; i < frames; i++) {
+                vv_dsp_real s = 0;
+                for (size_t ch = 0; ch < channels; ch++) s += block[i * channels + ch];
+                samples[got + i] = s * gain;
+            }
+            got += frames;
+        }
+        vv_dsp_free(block);
+    }
+    if (status == VV_DSP_OK && got != n) status = VV_DSP_ERROR_INTERNAL;
+    if (status != VV_DSP_OK) {
+        vv_dsp_free(samples);
+        return status;
+    }
+    e->samples = samples;
+    e->num_samples = n;
+    e->start = start;
+    e->sample_rate = info.sample_rate;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_voicebank_acquire(vv_dsp_voicebank* voicebank,
+                                       size_t index,
+                                       vv_dsp_voicebank_segment* out_segment) {
+    if (!voicebank || !out_segment) return VV_DSP_ERROR_NULL_POINTER;
+    if (index >= voicebank->num_entries) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vb_entry* e = &voicebank->entries[index];
+    const size_t bytes_of = sizeof(vv_dsp_real);
+    if (e->samples) {
+        voicebank->stats.hits++;
+        if (e->refs == 0) {
+            vb_lru_unlink(voicebank, index);
+            voicebank->unpinned_bytes -= e->num_samples * bytes_of;
+        }
+    } else {
+        vv_dsp_status status = vb_decode(voicebank, e);
+        if (status != VV_DSP_OK) return status;
+        voicebank->stats.misses++;
+        voicebank->stats.cached_segments++;
+        voicebank->stats.cached_bytes += e->num_samples * bytes_of;
+    }
+    e->refs++;
+    out_segment->samples = e->samples;
+    out_segment->num_samples = e->num_samples;
+    out_segment->sample_rate = e->sample_rate;
+    out_segment->start_sample = e->start;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_voicebank_release(vv_dsp_voicebank* voicebank, size_t index) {
+    if (!voicebank || index >= voicebank->num_entries) return;
+    vb_entry* e = &voicebank->entries[index];
+    if (e->refs == 0 || --e->refs > 0) return;
+
+    // Now reusable: most recent on the LRU list, then trim the list to the budget
+    e->prev = VB_NONE;
+    e->next = voicebank->lru_head;
+    if (voicebank->lru_head != VB_NONE) voicebank->entries[voicebank->lru_head].prev = index;
+    voicebank->lru_head = index;
+    if (voicebank->lru_tail == VB_NONE) voicebank->lru_tail = index;
+    voicebank->unpinned_bytes += e->num_samples * sizeof(vv_dsp_real);
+
+    while (voicebank->unpinned_bytes > voicebank->budget && voicebank->lru_tail != VB_NONE) {
+        const size_t victim = voicebank->lru_tail;
+        vb_entry* v = &voicebank->entries[victim];
+        const size_t bytes = v->num_samples * sizeof(vv_dsp_real);
+        vb_lru_unlink(voicebank, victim);
+        vv_dsp_free(v->samples);
+        v->samples = NULL;
+        voicebank->unpinned_bytes -= bytes;
+        voicebank->stats.cached_bytes -= bytes;
+        voicebank->stats.cached_segments--;
+        voicebank->stats.evictions++;
+    }
+}
+
+vv_dsp_status vv_dsp_voicebank_get_stats(const vv_dsp_voicebank* voicebank,
+                                         vv_dsp_voicebank_stats* out_stats) {
+    if (!voicebank || !out_stats) return VV_DSP_ERROR_NULL_POINTER;
+    *out_stats = voicebank->stats;
+    return VV_DSP_OK;
+}
@@ -1,9 +1,53 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  // fseeko, ftello
+#endif
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64  // files past 2 GB on 32-bit hosts
+#endif
+
 #include "vv_dsp/audio/wav.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/convert.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+// 64-bit file offsets
+#if defined(_MSC_VER)
+#define WAV_FSEEK(fp, off, whence) _fseeki64((fp), (__int64)(off), (whence))
+#define WAV_FTELL(fp) ((int64_t)_ftelli64(fp))
+#else
+#define WAV_FSEEK(fp, off, whence) fseeko((fp), (off_t)(off), (whence))
+#define WAV_FTELL(fp) ((int64_t)ftello(fp))
+#endif
+
+// Block queue of the streaming writer: release stores and acquire loads of its indices
+#if defined(_MSC_VER)
+#define WAV_LOAD(p) InterlockedExchangeAddSizeT((p), 0)
+#define WAV_STORE(p, v) ((void)InterlockedExchangePointer((PVOID volatile*)(p), (PVOID)(v)))
+#else
+#define WAV_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define WAV_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
+#if defined(_WIN32)
+typedef HANDLE wav_thread;
+#else
+typedef pthread_t wav_thread;
+#endif
+
 // Thread-local error storage (fallback to global if not supported)
 #if defined(__GNUC__) || defined(__clang__)
   static __thread char s_error_buffer[256] = {0};
@@ -15,6 +59,9 @@
 
 // WAV format constants
 #define WAV_FOURCC_RIFF  0x46464952  // 'RIFF' in little-endian
+#define WAV_FOURCC_RF64  0x34364652  // 'RF64' in little-endian
+#define WAV_FOURCC_DS64  0x34367364  // 'ds64' in little-endian
+#define WAV_FOURCC_JUNK  0x4B4E554A  // 'JUNK' in little-endian
 #define WAV_FOURCC_WAVE  0x45564157  // 'WAVE' in little-endian
 #define WAV_FOURCC_FMT   0x20746D66  // 'fmt ' in little-endian
 #define WAV_FOURCC_DATA  0x61746164  // 'data' in little-endian
@@ -23,6 +70,13 @@
 #define WAV_FORMAT_FLOAT      3
 #define WAV_FORMAT_EXTENSIBLE 0xFFFE
 
+// Staging block of the streaming reader, which vv_dsp_wav_read() also goes through
+#define WAV_STAGING_BYTES 65536
+
+// Streaming writer queue defaults
+#define WAV_WRITER_BLOCK_FRAMES 4096
+#define WAV_WRITER_BLOCKS 8
+
 // RIFF chunk header
 typedef struct {
     uint32_t fourcc;
@@ -36,6 +90,16 @@ typedef struct {
     uint32_t wave_fourcc;    // 'WAVE'
 } wav_riff_header;
 
+// Leading fields of the RF64 ds64 chunk, followed by a 32-bit table length
+typedef struct {
+    uint64_t riff_size;
+    uint64_t data_size;
+    uint64_t sample_count;
+} wav_ds64_chunk;
+
+#define WAV_DS64_SIZE 28     // ds64 payload with an empty table
+#define WAV_SIZE_IN_DS64 0xFFFFFFFFu  // 32-bit size field deferring to ds64
+
 // WAV format chunk (basic WAVEFORMATEX subset)
 typedef struct {
     uint16_t format_tag;        // Format type
@@ -46,22 +110,83 @@ typedef struct {
     uint16_t bits_per_sample;   // Bits per sample
 } wav_format_chunk;
 
+// Streaming reader: the parsed header, the data chunk's place in the file and one
+// staging block of raw frames
+struct vv_dsp_wav_reader {
+    FILE* fp;
+    vv_dsp_wav_info info;
+    int64_t data_offset;   // file offset of frame 0
+    size_t frame_bytes;    // bytes per interleaved frame
+    size_t position;       // next frame to read
+    uint8_t* staging;
+    size_t staging_frames;
+};
+
+// Memory-mapped file: the whole file is mapped read-only and frames decode
+// straight from the mapping, so only the pages a read touches are faulted in
+struct vv_dsp_wav_map {
+    const uint8_t* base;   // start of the mapping
+    size_t size;           // bytes mapped
+    const uint8_t* data;   // frame 0
+    vv_dsp_wav_info info;  // num_samples clamped to the frames present in the file
+    size_t frame_bytes;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+// Streaming writer: a single-producer ring of encoded blocks. Blocks [tail, head)
+// wait for the I/O thread and block head % num_blocks is being filled; only the
+// appending thread advances head and only the I/O thread advances tail, so
+// neither side ever locks.
+struct vv_dsp_wav_writer {
+    FILE* fp;
+    vv_dsp_wav_info info;
+    vv_dsp_sample_format format;
+    vv_dsp_wav_rf64_mode rf64;
+    int64_t data_offset;   // file offset of frame 0
+    size_t frame_bytes;
+    size_t block_frames;
+    size_t num_blocks;
+    uint8_t* blocks;       // num_blocks * block_frames frames
+    size_t* block_fill;    // frames held by each queued block
+    size_t fill;           // frames in the block being filled
+    size_t head;           // blocks queued
+    size_t tail;           // blocks written
+    size_t io_failed;      // set by the I/O thread when a write fails
+    size_t quit;
+    uint64_t frames;       // frames appended
+    uint64_t max_frames;   // 32-bit RIFF limit, or unbounded with RF64
+    size_t max_queued;
+    size_t overruns;
+    int threaded;
+    wav_thread thread;
+};
+
 // Forward declarations for internal functions
 static vv_dsp_status wav_parse_header(FILE* fp, vv_dsp_wav_info* info);
+static vv_dsp_status wav_parse_layout(FILE* fp, vv_dsp_wav_info* info, int64_t* data_offset);
 static vv_dsp_status wav_write_header(FILE* fp, const vv_dsp_wav_info* info);
-static vv_dsp_status wav_read_samples(FILE* fp, const vv_dsp_wav_info* info, vv_dsp_real*** buffer);
+static void wav_fill_format(const vv_dsp_wav_info* info, wav_format_chunk* fmt_chunk);
+static vv_dsp_status wav_write_stream_header(FILE* fp, const vv_dsp_wav_info* info, int reserve_ds64,
+                                             int64_t* data_offset);
+static void writer_submit(vv_dsp_wav_writer* w);
+static void writer_drain(vv_dsp_wav_writer* w);
+static vv_dsp_status writer_finish(vv_dsp_wav_writer* w);
+static void writer_free(vv_dsp_wav_writer* w);
+static vv_dsp_status wav_read_samples(vv_dsp_wav_reader* r, vv_dsp_real*** buffer);
 static vv_dsp_status wav_write_samples(FILE* fp, const vv_dsp_wav_info* info, const vv_dsp_real* const* buffer);
 static void set_error(const char* msg);
-static vv_dsp_status skip_chunk(FILE* fp, uint32_t size);
+static vv_dsp_status skip_chunk(FILE* fp, uint64_t size);
 static vv_dsp_status find_chunk(FILE* fp, uint32_t target_fourcc, uint32_t* out_size);
-static vv_dsp_status deinterleave_float32(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info);
-static vv_dsp_status deinterleave_pcm16(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info);
-static vv_dsp_status deinterleave_pcm24(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info);
-static vv_dsp_status deinterleave_pcm32(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info);
-static vv_dsp_status interleave_float32(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info);
-static vv_dsp_status interleave_pcm16(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info);
-static vv_dsp_status interleave_pcm24(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info);
-static vv_dsp_status interleave_pcm32(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info);
+static vv_dsp_status wav_sample_format(const vv_dsp_wav_info* info, vv_dsp_sample_format* format);
+static vv_dsp_status wav_decode(const uint8_t* src, size_t frames, const vv_dsp_wav_info* info,
+                                vv_dsp_real* const* planar, vv_dsp_real* interleaved);
+static vv_dsp_status map_read(const vv_dsp_wav_map* map, size_t start_frame, vv_dsp_real* const* planar,
+                              vv_dsp_real* interleaved, size_t max_frames, size_t* frames_read);
+static vv_dsp_status reader_read(vv_dsp_wav_reader* r, vv_dsp_real* const* planar, vv_dsp_real* interleaved,
+                                 size_t max_frames, size_t* frames_read);
 
 vv_dsp_status vv_dsp_wav_read(const char* filepath,
                               vv_dsp_real*** out_buffer,
@@ -74,20 +199,16 @@ vv_dsp_status vv_dsp_wav_read(const char* filepath,
     *out_buffer = NULL;
     memset(out_info, 0, sizeof(*out_info));
 
-    FILE* fp = fopen(filepath, "rb");
-    if (!fp) {
-        set_error("Failed to open file for reading");
-        return VV_DSP_ERROR_INTERNAL;
-    }
-
-    vv_dsp_status status = wav_parse_header(fp, out_info);
+    // Decode block by block straight into the channel buffers
+    vv_dsp_wav_reader* r = NULL;
+    vv_dsp_status status = vv_dsp_wav_reader_open(filepath, &r);
     if (status != VV_DSP_OK) {
-        fclose(fp);
         return status;
     }
+    *out_info = r->info;
 
-    status = wav_read_samples(fp, out_info, out_buffer);
-    fclose(fp);
+    status = wav_read_samples(r, out_buffer);
+    vv_dsp_wav_reader_close(r);
 
     if (status != VV_DSP_OK && *out_buffer) {
         vv_dsp_wav_free_buffer(out_buffer, out_info->num_channels);
@@ -96,6 +217,62 @@ vv_dsp_status vv_dsp_wav_read(const char* filepath,
     return status;
 }
 
+vv_dsp_status vv_dsp_wav_read_buffer(const char* filepath,
+                                     vv_dsp_buffer_layout layout,
+                                     vv_dsp_buffer* out_buffer,
+                                     vv_dsp_wav_info* out_info) {
+    if (!filepath || !out_buffer || !out_info) {
+        set_error("NULL pointer passed to vv_dsp_wav_read_buffer");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    memset(out_buffer, 0, sizeof(*out_buffer));
+    memset(out_info, 0, sizeof(*out_info));
+
+    vv_dsp_wav_reader* r = NULL;
+    vv_dsp_status status = vv_dsp_wav_reader_open(filepath, &r);
+    if (status != VV_DSP_OK) {
+        return status;
+    }
+    *out_info = r->info;
+    const size_t channels = (size_t)r->info.num_channels;
+    const size_t frames = r->info.num_samples;
+
+    status = vv_dsp_buffer_create(channels, frames ? frames : 1, layout, out_buffer);
+    if (status != VV_DSP_OK) {
+        set_error("Failed to allocate sample buffer");
+        vv_dsp_wav_reader_close(r);
+        return status;
+    }
+    out_buffer->frames = frames;
+
+    // Decode straight into the buffer: one pass for interleaved frames, channel
+    // pointers into the strided block for planar ones
+    size_t got = 0;
+    if (layout == VV_DSP_BUFFER_INTERLEAVED) {
+        status = reader_read(r, NULL, out_buffer->data, frames, &got);
+    } else {
+        vv_dsp_real** planar = (vv_dsp_real**)vv_dsp_malloc(sizeof(vv_dsp_real*) * channels);
+        if (planar) {
+            for (size_t ch = 0; ch < channels; ++ch) planar[ch] = vv_dsp_buffer_channel(out_buffer, ch);
+            status = reader_read(r, planar, NULL, frames, &got);
+            vv_dsp_free(planar);
+        } else {
+            set_error("Failed to allocate channel buffer array");
+            status = VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    vv_dsp_wav_reader_close(r);
+    if (status == VV_DSP_OK && got != frames) {
+        set_error("Failed to read audio data");
+        status = VV_DSP_ERROR_INTERNAL;
+    }
+    if (status != VV_DSP_OK) {
+        vv_dsp_buffer_free(out_buffer);
+    }
+    return status;
+}
+
 vv_dsp_status vv_dsp_wav_write(const char* filepath,
                                const vv_dsp_real* const* in_buffer,
                                const vv_dsp_wav_info* info) {
@@ -148,13 +325,450 @@ vv_dsp_status vv_dsp_wav_info_get(const char* filepath,
     return status;
 }
 
+vv_dsp_status vv_dsp_wav_reader_open(const char* filepath, vv_dsp_wav_reader** out_reader) {
+    if (!filepath || !out_reader) {
+        set_error("NULL pointer passed to vv_dsp_wav_reader_open");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_reader = NULL;
+
+    vv_dsp_wav_reader* r = (vv_dsp_wav_reader*)vv_dsp_calloc(1, sizeof(*r));
+    if (!r) {
+        set_error("Failed to allocate WAV reader");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    r->fp = fopen(filepath, "rb");
+    if (!r->fp) {
+        set_error("Failed to open file for reading");
+        vv_dsp_free(r);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    vv_dsp_status status = wav_parse_layout(r->fp, &r->info, &r->data_offset);
+    if (status == VV_DSP_OK) {
+        r->frame_bytes = (size_t)(r->info.bit_depth / 8) * (size_t)r->info.num_channels;
+        r->staging_frames = WAV_STAGING_BYTES / r->frame_bytes;
+        r->staging = (uint8_t*)vv_dsp_malloc(r->staging_frames * r->frame_bytes);
+        if (!r->staging) {
+            set_error("Failed to allocate staging buffer");
+            status = VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    if (status != VV_DSP_OK) {
+        vv_dsp_wav_reader_close(r);
+        return status;
+    }
+
+    *out_reader = r;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_wav_reader_close(vv_dsp_wav_reader* reader) {
+    if (!reader) return;
+    if (reader->fp) fclose(reader->fp);
+    vv_dsp_free(reader->staging);
+    vv_dsp_free(reader);
+}
+
+vv_dsp_status vv_dsp_wav_reader_info(const vv_dsp_wav_reader* reader, vv_dsp_wav_info* out_info) {
+    if (!reader || !out_info) {
+        set_error("NULL pointer passed to vv_dsp_wav_reader_info");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_info = reader->info;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_reader_seek(vv_dsp_wav_reader* reader, size_t frame) {
+    if (!reader) {
+        set_error("NULL pointer passed to vv_dsp_wav_reader_seek");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (frame > reader->info.num_samples) {
+        set_error("Seek past the end of the data chunk");
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    if (WAV_FSEEK(reader->fp, reader->data_offset + (int64_t)frame * (int64_t)reader->frame_bytes, SEEK_SET) != 0) {
+        set_error("Failed to seek in WAV file");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    reader->position = frame;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_wav_reader_tell(const vv_dsp_wav_reader* reader) {
+    return reader ? reader->position : 0;
+}
+
+vv_dsp_status vv_dsp_wav_reader_read_planar(vv_dsp_wav_reader* reader,
+                                            vv_dsp_real* const* channels,
+                                            size_t max_frames,
+                                            size_t* frames_read) {
+    if (!reader || !channels || !frames_read) {
+        set_error("NULL pointer passed to vv_dsp_wav_reader_read_planar");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    for (int ch = 0; ch < reader->info.num_channels; ch++) {
+        if (!channels[ch]) {
+            set_error("NULL channel buffer passed to vv_dsp_wav_reader_read_planar");
+            return VV_DSP_ERROR_NULL_POINTER;
+        }
+    }
+    return reader_read(reader, channels, NULL, max_frames, frames_read);
+}
+
+vv_dsp_status vv_dsp_wav_reader_read_interleaved(vv_dsp_wav_reader* reader,
+                                                 vv_dsp_real* out,
+                                                 size_t max_frames,
+                                                 size_t* frames_read) {
+    if (!reader || !out || !frames_read) {
+        set_error("NULL pointer passed to vv_dsp_wav_reader_read_interleaved");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    return reader_read(reader, NULL, out, max_frames, frames_read);
+}
+
+vv_dsp_status vv_dsp_wav_mmap_open(const char* filepath, vv_dsp_wav_map** out_map) {
+    if (!filepath || !out_map) {
+        set_error("NULL pointer passed to vv_dsp_wav_mmap_open");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_map = NULL;
+
+    // Parse the chunks through stdio, then map
+    FILE* fp = fopen(filepath, "rb");
+    if (!fp) {
+        set_error("Failed to open file for reading");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    vv_dsp_wav_info info;
+    int64_t data_offset = 0;
+    vv_dsp_status status = wav_parse_layout(fp, &info, &data_offset);
+    fclose(fp);
+    if (status != VV_DSP_OK) {
+        return status;
+    }
+
+    vv_dsp_wav_map* map = (vv_dsp_wav_map*)vv_dsp_calloc(1, sizeof(*map));
+    if (!map) {
+        set_error("Failed to allocate WAV map");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    int64_t file_size = -1;
+#if defined(_WIN32)
+    map->file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER sz;
+    if (map->file != INVALID_HANDLE_VALUE && GetFileSizeEx(map->file, &sz)) {
+        file_size = (int64_t)sz.QuadPart;
+        map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (map->mapping) {
+            map->base = (const uint8_t*)MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+#else
+    int fd = open(filepath, O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && (uint64_t)st.st_size <= (uint64_t)SIZE_MAX) {
+        file_size = (int64_t)st.st_size;
+        void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) map->base = (const uint8_t*)p;
+    }
+    if (fd >= 0) close(fd);  // the mapping keeps its own reference
+#endif
+    if (!map->base || file_size < data_offset) {
+        set_error("Failed to map WAV file");
+        vv_dsp_wav_mmap_close(map);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    map->size = (size_t)file_size;
+    map->data = map->base + data_offset;
+    map->frame_bytes = (size_t)(info.bit_depth / 8) * (size_t)info.num_channels;
+    const size_t present = (size_t)(file_size - data_offset) / map->frame_bytes;
+    if (info.num_samples > present) {
+        info.num_samples = present;  // truncated file: expose the frames that exist
+    }
+    map->info = info;
+
+    *out_map = map;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_wav_mmap_close(vv_dsp_wav_map* map) {
+    if (!map) return;
+#if defined(_WIN32)
+    if (map->base) UnmapViewOfFile(map->base);
+    if (map->mapping) CloseHandle(map->mapping);
+    if (map->file && map->file != INVALID_HANDLE_VALUE) CloseHandle(map->file);
+#else
+    if (map->base) munmap((void*)map->base, map->size);
+#endif
+    vv_dsp_free(map);
+}
+
+vv_dsp_status vv_dsp_wav_mmap_info(const vv_dsp_wav_map* map, vv_dsp_wav_info* out_info) {
+    if (!map || !out_info) {
+        set_error("NULL pointer passed to vv_dsp_wav_mmap_info");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_info = map->info;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_mmap_float32(const vv_dsp_wav_map* map, const float** out_interleaved) {
+    if (!map || !out_interleaved) {
+        set_error("NULL pointer passed to vv_dsp_wav_mmap_float32");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_interleaved = NULL;
+    // The mapping starts page-aligned, so the data offset decides alignment
+    if (!map->info.is_float || map->info.bit_depth != 32 ||
+        ((size_t)(map->data - map->base) % sizeof(float)) != 0) {
+        set_error("WAV data is not aligned 32-bit float");
+        return VV_DSP_ERROR_UNSUPPORTED;
+    }
+    *out_interleaved = (const float*)(const void*)map->data;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_mmap_read_planar(const vv_dsp_wav_map* map,
+                                          size_t start_frame,
+                                          vv_dsp_real* const* channels,
+                                          size_t max_frames,
+                                          size_t* frames_read) {
+    if (!map || !channels || !frames_read) {
+        set_error("NULL pointer passed to vv_dsp_wav_mmap_read_planar");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    for (int ch = 0; ch < map->info.num_channels; ch++) {
+        if (!channels[ch]) {
+            set_error("NULL channel buffer passed to vv_dsp_wav_mmap_read_planar");
+            return VV_DSP_ERROR_NULL_POINTER;
+        }
+    }
+    return map_read(map, start_frame, channels, NULL, max_frames, frames_read);
+}
+
+vv_dsp_status vv_dsp_wav_mmap_read_interleaved(const vv_dsp_wav_map* map,
+                                               size_t start_frame,
+                                               vv_dsp_real* out,
+                                               size_t max_frames,
+                                               size_t* frames_read) {
+    if (!map || !out || !frames_read) {
+        set_error("NULL pointer passed to vv_dsp_wav_mmap_read_interleaved");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    return map_read(map, start_frame, NULL, out, max_frames, frames_read);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI writer_thread(LPVOID arg) {
+#else
+static void* writer_thread(void* arg) {
+#endif
+    vv_dsp_wav_writer* w = (vv_dsp_wav_writer*)arg;
+    for (;;) {
+        // quit is read before draining so the blocks queued ahead of it are written
+        const int quit = WAV_LOAD(&w->quit) != 0;
+        writer_drain(w);
+        if (quit) break;
+        if (WAV_LOAD(&w->head) == w->tail) {
+            // Nothing queued: poll again shortly, so appending never has to signal
+#if defined(_WIN32)
+            Sleep(1);
+#else
+            struct timespec idle = { 0, 1000000 };
+            nanosleep(&idle, NULL);
+#endif
+        }
+    }
+    return 0;
+}
+
+vv_dsp_status vv_dsp_wav_writer_open(const char* filepath,
+                                     const vv_dsp_wav_info* format,
+                                     const vv_dsp_wav_writer_config* config,
+                                     vv_dsp_wav_writer** out_writer) {
+    if (!filepath || !format || !out_writer) {
+        set_error("NULL pointer passed to vv_dsp_wav_writer_open");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_writer = NULL;
+
+    vv_dsp_wav_writer_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    if (config) cfg = *config;
+    if (cfg.block_frames == 0) cfg.block_frames = WAV_WRITER_BLOCK_FRAMES;
+    if (cfg.num_blocks == 0) cfg.num_blocks = WAV_WRITER_BLOCKS;
+
+    if (format->num_channels <= 0 || format->num_channels > 8 || format->sample_rate <= 0 ||
+        cfg.num_blocks < 2 || (unsigned)cfg.rf64 > (unsigned)VV_DSP_WAV_RF64_NEVER) {
+        set_error("Invalid WAV writer parameters");
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    vv_dsp_sample_format sample_format;
+    vv_dsp_status status = wav_sample_format(format, &sample_format);
+    if (status != VV_DSP_OK) return status;
+    const size_t frame_bytes = (size_t)(format->bit_depth / 8) * (size_t)format->num_channels;
+    if (cfg.block_frames > SIZE_MAX / frame_bytes / cfg.num_blocks) {
+        set_error("WAV writer queue too large");
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_wav_writer* w = (vv_dsp_wav_writer*)vv_dsp_calloc(1, sizeof(*w));
+    if (!w) {
+        set_error("Failed to allocate WAV writer");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    w->info = *format;
+    w->info.num_samples = 0;
+    w->format = sample_format;
+    w->rf64 = cfg.rf64;
+    w->frame_bytes = frame_bytes;
+    w->block_frames = cfg.block_frames;
+    w->num_blocks = cfg.num_blocks;
+    w->blocks = (uint8_t*)vv_dsp_malloc(cfg.num_blocks * cfg.block_frames * frame_bytes);
+    w->block_fill = (size_t*)vv_dsp_calloc(cfg.num_blocks, sizeof(size_t));
+    if (!w->blocks || !w->block_fill) {
+        set_error("Failed to allocate WAV writer queue");
+        writer_free(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    w->fp = fopen(filepath, "wb");
+    if (!w->fp) {
+        set_error("Failed to open file for writing");
+        writer_free(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    status = wav_write_stream_header(w->fp, &w->info, w->rf64 != VV_DSP_WAV_RF64_NEVER, &w->data_offset);
+    if (status != VV_DSP_OK) {
+        writer_free(w);
+        return status;
+    }
+    // Plain RIFF stops where its 32-bit size field (and a pad byte) would overflow
+    w->max_frames = w->rf64 == VV_DSP_WAV_RF64_NEVER
+                        ? (0xFFFFFFFFu - (uint64_t)(w->data_offset - 8) - 1) / frame_bytes
+                        : UINT64_MAX;
+
+    if (!cfg.synchronous) {
+#if defined(_WIN32)
+        w->thread = CreateThread(NULL, 0, writer_thread, w, 0, NULL);
+        w->threaded = w->thread != NULL;
+#else
+        w->threaded = pthread_create(&w->thread, NULL, writer_thread, w) == 0;
+#endif
+        if (!w->threaded) {
+            set_error("Failed to start WAV writer thread");
+            writer_free(w);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
+    *out_writer = w;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_writer_append_frames(vv_dsp_wav_writer* writer,
+                                              const vv_dsp_real* const* channels,
+                                              size_t frames) {
+    if (!writer || !channels) {
+        set_error("NULL pointer passed to vv_dsp_wav_writer_append_frames");
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    const size_t num_channels = (size_t)writer->info.num_channels;
+    for (size_t ch = 0; ch < num_channels; ch++) {
+        if (!channels[ch]) {
+            set_error("NULL channel buffer passed to vv_dsp_wav_writer_append_frames");
+            return VV_DSP_ERROR_NULL_POINTER;
+        }
+    }
+    if (WAV_LOAD(&writer->io_failed)) {
+        set_error("Failed to write audio data");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    if (frames == 0) return VV_DSP_OK;
+    if (frames > writer->max_frames - writer->frames) {
+        set_error("WAV file size limit reached (RF64 disabled)");
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    // Room left: the free blocks, less what the block being filled already holds
+    const size_t free_blocks = writer->num_blocks - (writer->head - WAV_LOAD(&writer->tail));
+    if (frames > free_blocks * writer->block_frames - writer->fill) {
+        writer->overruns++;
+        set_error("WAV writer queue full");
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    const vv_dsp_real* src[8];
+    size_t done = 0;
+    while (done < frames) {
+        size_t n = writer->block_frames - writer->fill;
+        if (n > frames - done) n = frames - done;
+        for (size_t ch = 0; ch < num_channels; ch++) {
+            src[ch] = channels[ch] + done;
+        }
+        uint8_t* dst = writer->blocks +
+                       ((writer->head % writer->num_blocks) * writer->block_frames + writer->fill) * writer->frame_bytes;
+        vv_dsp_status status = vv_dsp_convert_interleave(src, num_channels, n, writer->format, dst);
+        if (status != VV_DSP_OK) return status;
+        writer->fill += n;
+        done += n;
+        if (writer->fill == writer->block_frames) writer_submit(writer);
+    }
+    writer->frames += frames;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_writer_get_stats(const vv_dsp_wav_writer* writer,
+                                          vv_dsp_wav_writer_stats* out_stats) {
+    if (!writer || !out_stats) return VV_DSP_ERROR_NULL_POINTER;
+    out_stats->frames_appended = writer->frames;
+    out_stats->blocks_written = WAV_LOAD((size_t*)&writer->tail);
+    out_stats->max_queued_blocks = writer->max_queued;
+    out_stats->overruns = writer->overruns;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_wav_writer_close(vv_dsp_wav_writer* writer) {
+    if (!writer) return VV_DSP_OK;
+
+    if (writer->fill) writer_submit(writer);
+    if (writer->threaded) {
+        WAV_STORE(&writer->quit, (size_t)1);
+#if defined(_WIN32)
+        WaitForSingleObject(writer->thread, INFINITE);
+        CloseHandle(writer->thread);
+#else
+        pthread_join(writer->thread, NULL);
+#endif
+        writer->threaded = 0;
+    }
+
+    vv_dsp_status status = VV_DSP_OK;
+    if (writer->io_failed) {
+        set_error("Failed to write audio data");
+        status = VV_DSP_ERROR_INTERNAL;
+    } else {
+        status = writer_finish(writer);
+    }
+    if (fclose(writer->fp) != 0 && status == VV_DSP_OK) {
+        set_error("Failed to close WAV file");
+        status = VV_DSP_ERROR_INTERNAL;
+    }
+    writer->fp = NULL;
+    writer_free(writer);
+    return status;
+}
+
 void vv_dsp_wav_free_buffer(vv_dsp_real*** buffer, int num_channels) {
     if (!buffer || !*buffer) return;
 
     for (int ch = 0; ch < num_channels; ch++) {
-        free((*buffer)[ch]);
+        vv_dsp_free((*buffer)[ch]);
     }
-    free(*buffer);
+    vv_dsp_free(*buffer);
     *buffer = NULL;
 }
 
@@ -162,11 +776,18 @@ const char* vv_dsp_wav_get_error_string(void) {
     return s_error_buffer[0] ? s_error_buffer : "No error";
 }
 
-// Internal helper functions (stubs for now)
+// Internal helper functions
 static vv_dsp_status wav_parse_header(FILE* fp, vv_dsp_wav_info* info) {
+    int64_t data_offset;
+    return wav_parse_layout(fp, info, &data_offset);
+}
+
+// Parse the header and leave fp at frame 0, whose file offset goes to data_offset
+static vv_dsp_status wav_parse_layout(FILE* fp, vv_dsp_wav_info* info, int64_t* data_offset) {
     wav_riff_header riff_header;
     wav_format_chunk fmt_chunk;
     uint32_t data_size = 0;
+    uint64_t data_size64 = 0;
 
     // Read RIFF header
     if (fread(&riff_header, sizeof(riff_header), 1, fp) != 1) {
@@ -175,7 +796,8 @@ static vv_dsp_status wav_parse_header(FILE* fp, vv_dsp_wav_info* info) {
     }
 
     // Validate RIFF header
-    if (riff_header.riff_fourcc != WAV_FOURCC_RIFF) {
+    const int is_rf64 = riff_header.riff_fourcc == WAV_FOURCC_RF64;
+    if (riff_header.riff_fourcc != WAV_FOURCC_RIFF && !is_rf64) {
         set_error("File is not a RIFF file");
         return VV_DSP_ERROR_INVALID_SIZE;
     }
@@ -185,6 +807,20 @@ static vv_dsp_status wav_parse_header(FILE* fp, vv_dsp_wav_info* info) {
         return VV_DSP_ERROR_INVALID_SIZE;
     }
 
+    // RF64 carries the sizes that overflow their 32-bit fields in a leading ds64 chunk
+    if (is_rf64) {
+        wav_chunk_header ds64_header;
+        wav_ds64_chunk ds64;
+        if (fread(&ds64_header, sizeof(ds64_header), 1, fp) != 1 || ds64_header.fourcc != WAV_FOURCC_DS64 ||
+            ds64_header.size < sizeof(ds64) || fread(&ds64, sizeof(ds64), 1, fp) != 1) {
+            set_error("RF64 file without a valid ds64 chunk");
+            return VV_DSP_ERROR_INVALID_SIZE;
+        }
+        vv_dsp_status status = skip_chunk(fp, (uint64_t)(ds64_header.size - sizeof(ds64)) + (ds64_header.size & 1));
+        if (status != VV_DSP_OK) return status;
+        data_size64 = ds64.data_size;
+    }
+
     // Find fmt chunk
     uint32_t fmt_size;
     vv_dsp_status status = find_chunk(fp, WAV_FOURCC_FMT, &fmt_size);
@@ -233,12 +869,23 @@ static vv_dsp_status wav_parse_header(FILE* fp, vv_dsp_wav_info* info) {
         return status;
     }
 
+    *data_offset = WAV_FTELL(fp);
+    if (*data_offset < 0) {
+        set_error("Failed to locate data chunk");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
     // Calculate number of samples
+    uint64_t data_bytes = (is_rf64 && data_size == WAV_SIZE_IN_DS64) ? data_size64 : data_size;
     uint32_t bytes_per_sample = fmt_chunk.bits_per_sample / 8;
-    uint32_t total_samples = data_size / (bytes_per_sample * fmt_chunk.channels);
+    uint64_t total_samples = data_bytes / (bytes_per_sample * fmt_chunk.channels);
+    if (total_samples > (uint64_t)SIZE_MAX) {
+        set_error("data chunk too large for this platform");
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
 
     // Fill output info structure
-    info->num_samples = total_samples;
+    info->num_samples = (size_t)total_samples;
     info->num_channels = fmt_chunk.channels;
     info->sample_rate = fmt_chunk.sample_rate;
     info->bit_depth = fmt_chunk.bits_per_sample;
@@ -278,12 +925,7 @@ static vv_dsp_status wav_write_header(FILE* fp, const vv_dsp_wav_info* info) {
     }
 
     // Write fmt chunk data
-    fmt_chunk.format_tag = info->is_float ? WAV_FORMAT_FLOAT : WAV_FORMAT_PCM;
-    fmt_chunk.channels = (uint16_t)info->num_channels;
-    fmt_chunk.sample_rate = (uint32_t)info->sample_rate;
-    fmt_chunk.byte_rate = (uint32_t)(info->sample_rate * (double)info->num_channels * (double)bytes_per_sample);
-    fmt_chunk.block_align = (uint16_t)((uint32_t)info->num_channels * bytes_per_sample);
-    fmt_chunk.bits_per_sample = (uint16_t)info->bit_depth;
+    wav_fill_format(info, &fmt_chunk);
 
     if (fwrite(&fmt_chunk, sizeof(fmt_chunk), 1, fp) != 1) {
         set_error("Failed to write fmt chunk data");
@@ -302,9 +944,48 @@ static vv_dsp_status wav_write_header(FILE* fp, const vv_dsp_wav_info* info) {
     return VV_DSP_OK;
 }
 
-static vv_dsp_status wav_read_samples(FILE* fp, const vv_dsp_wav_info* info, vv_dsp_real*** buffer) {
+static void wav_fill_format(const vv_dsp_wav_info* info, wav_format_chunk* fmt_chunk) {
+    uint32_t bytes_per_sample = (uint32_t)(info->bit_depth / 8);
+    fmt_chunk->format_tag = info->is_float ? WAV_FORMAT_FLOAT : WAV_FORMAT_PCM;
+    fmt_chunk->channels = (uint16_t)info->num_channels;
+    fmt_chunk->sample_rate = (uint32_t)info->sample_rate;
+    fmt_chunk->byte_rate = (uint32_t)(info->sample_rate * (double)info->num_channels * (double)bytes_per_sample);
+    fmt_chunk->block_align = (uint16_t)((uint32_t)info->num_channels * bytes_per_sample);
+    fmt_chunk->bits_per_sample = (uint16_t)info->bit_depth;
+}
+
+// Header of the streaming writer with zero sizes, patched by writer_finish(). Unless
+// plain RIFF is asked for, a JUNK chunk holds the place of the RF64 ds64 chunk.
+static vv_dsp_status wav_write_stream_header(FILE* fp, const vv_dsp_wav_info* info, int reserve_ds64,
+                                             int64_t* data_offset) {
+    wav_riff_header riff_header = { WAV_FOURCC_RIFF, 0, WAV_FOURCC_WAVE };
+    wav_chunk_header junk_header = { WAV_FOURCC_JUNK, WAV_DS64_SIZE };
+    uint8_t junk[WAV_DS64_SIZE] = { 0 };
+    wav_chunk_header fmt_chunk_header = { WAV_FOURCC_FMT, sizeof(wav_format_chunk) };
+    wav_format_chunk fmt_chunk;
+    wav_chunk_header data_chunk_header = { WAV_FOURCC_DATA, 0 };
+
+    wav_fill_format(info, &fmt_chunk);
+    int ok = fwrite(&riff_header, sizeof(riff_header), 1, fp) == 1;
+    if (ok && reserve_ds64) {
+        ok = fwrite(&junk_header, sizeof(junk_header), 1, fp) == 1 && fwrite(junk, sizeof(junk), 1, fp) == 1;
+    }
+    ok = ok && fwrite(&fmt_chunk_header, sizeof(fmt_chunk_header), 1, fp) == 1 &&
+         fwrite(&fmt_chunk, sizeof(fmt_chunk), 1, fp) == 1 &&
+         fwrite(&data_chunk_header, sizeof(data_chunk_header), 1, fp) == 1;
+    *data_offset = ok ? WAV_FTELL(fp) : -1;
+    if (*data_offset < 0) {
+        set_error("Failed to write WAV header");
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status wav_read_samples(vv_dsp_wav_reader* r, vv_dsp_real*** buffer) {
+    const vv_dsp_wav_info* info = &r->info;
+
     // Allocate planar buffer array
-    vv_dsp_real** planar_buffer = (vv_dsp_real**)malloc(sizeof(vv_dsp_real*) * (size_t)info->num_channels);
+    vv_dsp_real** planar_buffer = (vv_dsp_real**)vv_dsp_malloc(sizeof(vv_dsp_real*) * (size_t)info->num_channels);
     if (!planar_buffer) {
         set_error("Failed to allocate channel buffer array");
         return VV_DSP_ERROR_INTERNAL;
@@ -317,7 +998,7 @@ static vv_dsp_status wav_read_samples(FILE* fp, const vv_dsp_wav_info* info, vv_
 
     // Allocate individual channel buffers
     for (int ch = 0; ch < info->num_channels; ch++) {
-        planar_buffer[ch] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * info->num_samples);
+        planar_buffer[ch] = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * info->num_samples);
         if (!planar_buffer[ch]) {
             set_error("Failed to allocate channel buffer");
             vv_dsp_wav_free_buffer(&planar_buffer, info->num_channels);
@@ -325,43 +1006,14 @@ static vv_dsp_status wav_read_samples(FILE* fp, const vv_dsp_wav_info* info, vv_
         }
     }
 
-    // Calculate bytes per sample
-    int bytes_per_sample = info->bit_depth / 8;
-    size_t interleaved_buffer_size = info->num_samples * (size_t)info->num_channels * (size_t)bytes_per_sample;
-
-    // Allocate temporary interleaved buffer
-    uint8_t* interleaved_buffer = (uint8_t*)malloc(interleaved_buffer_size);
-    if (!interleaved_buffer) {
-        set_error("Failed to allocate interleaved buffer");
-        vv_dsp_wav_free_buffer(&planar_buffer, info->num_channels);
-        return VV_DSP_ERROR_INTERNAL;
-    }
-
-    // Read all interleaved data
-    if (fread(interleaved_buffer, 1, interleaved_buffer_size, fp) != interleaved_buffer_size) {
+    // Decode through the reader's staging block
+    size_t got = 0;
+    vv_dsp_status status = reader_read(r, planar_buffer, NULL, info->num_samples, &got);
+    if (status == VV_DSP_OK && got != info->num_samples) {
         set_error("Failed to read audio data");
-        free(interleaved_buffer);
-        vv_dsp_wav_free_buffer(&planar_buffer, info->num_channels);
-        return VV_DSP_ERROR_INTERNAL;
-    }
-
-    // Deinterleave and convert samples
-    vv_dsp_status status = VV_DSP_OK;
-    if (info->is_float && info->bit_depth == 32) {
-        status = deinterleave_float32(interleaved_buffer, planar_buffer, info);
-    } else if (info->bit_depth == 16) {
-        status = deinterleave_pcm16(interleaved_buffer, planar_buffer, info);
-    } else if (info->bit_depth == 24) {
-        status = deinterleave_pcm24(interleaved_buffer, planar_buffer, info);
-    } else if (info->bit_depth == 32) {
-        status = deinterleave_pcm32(interleaved_buffer, planar_buffer, info);
-    } else {
-        set_error("Unsupported bit depth");
-        status = VV_DSP_ERROR_INVALID_SIZE;
+        status = VV_DSP_ERROR_INTERNAL;
     }
 
-    free(interleaved_buffer);
-
     if (status != VV_DSP_OK) {
         vv_dsp_wav_free_buffer(&planar_buffer, info->num_channels);
         return status;
@@ -371,46 +1023,92 @@ static vv_dsp_status wav_read_samples(FILE* fp, const vv_dsp_wav_info* info, vv_
     return VV_DSP_OK;
 }
 
+// Decode up to max_frames from the current position one staging block at a time,
+// into planar or (planar NULL) interleaved. A short count means the data ran out.
+static vv_dsp_status reader_read(vv_dsp_wav_reader* r, vv_dsp_real* const* planar, vv_dsp_real* interleaved,
+                                 size_t max_frames, size_t* frames_read) {
+    const int channels = r->info.num_channels;
+    const size_t left = r->info.num_samples - r->position;
+    if (max_frames > left) max_frames = left;
+
+    size_t done = 0;
+    *frames_read = 0;
+    while (done < max_frames) {
+        size_t n = max_frames - done;
+        if (n > r->staging_frames) n = r->staging_frames;
+        const size_t got = fread(r->staging, r->frame_bytes, n, r->fp);
+        if (got == 0 && ferror(r->fp)) {
+            set_error("Failed to read audio data");
+            return VV_DSP_ERROR_INTERNAL;
+        }
+
+        vv_dsp_real* dst[8];
+        if (planar) {
+            for (int ch = 0; ch < channels; ch++) dst[ch] = planar[ch] + done;
+        }
+        vv_dsp_status status = wav_decode(r->staging, got, &r->info, planar ? dst : NULL,
+                                          interleaved ? interleaved + done * (size_t)channels : NULL);
+        if (status != VV_DSP_OK) return status;
+
+        done += got;
+        r->position += got;
+        *frames_read = done;
+        if (got < n) break;  // data chunk shorter than the header claims
+    }
+    return VV_DSP_OK;
+}
+
+// Decode frames [start_frame, start_frame + max_frames) straight from the mapping
+static vv_dsp_status map_read(const vv_dsp_wav_map* map, size_t start_frame, vv_dsp_real* const* planar,
+                              vv_dsp_real* interleaved, size_t max_frames, size_t* frames_read) {
+    *frames_read = 0;
+    if (start_frame > map->info.num_samples) {
+        set_error("Read starts past the end of the data chunk");
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const size_t left = map->info.num_samples - start_frame;
+    if (max_frames > left) max_frames = left;
+
+    vv_dsp_status status = wav_decode(map->data + start_frame * map->frame_bytes, max_frames, &map->info,
+                                      planar, interleaved);
+    if (status != VV_DSP_OK) return status;
+    *frames_read = max_frames;
+    return VV_DSP_OK;
+}
+
 static vv_dsp_status wav_write_samples(FILE* fp, const vv_dsp_wav_info* info, const vv_dsp_real* const* buffer) {
     // Calculate buffer size
     int bytes_per_sample = info->bit_depth / 8;
     size_t interleaved_buffer_size = info->num_samples * (size_t)info->num_channels * (size_t)bytes_per_sample;
 
     // Allocate temporary interleaved buffer
-    uint8_t* interleaved_buffer = (uint8_t*)malloc(interleaved_buffer_size);
+    uint8_t* interleaved_buffer = (uint8_t*)vv_dsp_malloc(interleaved_buffer_size);
     if (!interleaved_buffer) {
         set_error("Failed to allocate interleaved buffer");
         return VV_DSP_ERROR_INTERNAL;
     }
 
     // Interleave and convert samples
-    vv_dsp_status status = VV_DSP_OK;
-    if (info->is_float && info->bit_depth == 32) {
-        status = interleave_float32(buffer, interleaved_buffer, info);
-    } else if (info->bit_depth == 16) {
-        status = interleave_pcm16(buffer, interleaved_buffer, info);
-    } else if (info->bit_depth == 24) {
-        status = interleave_pcm24(buffer, interleaved_buffer, info);
-    } else if (info->bit_depth == 32) {
-        status = interleave_pcm32(buffer, interleaved_buffer, info);
-    } else {
-        set_error("Unsupported bit depth");
-        status = VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_sample_format format;
+    vv_dsp_status status = wav_sample_format(info, &format);
+    if (status == VV_DSP_OK) {
+        status = vv_dsp_convert_interleave(buffer, (size_t)info->num_channels, info->num_samples, format,
+                                           interleaved_buffer);
     }
 
     if (status != VV_DSP_OK) {
-        free(interleaved_buffer);
+        vv_dsp_free(interleaved_buffer);
         return status;
     }
 
     // Write interleaved data to file
     if (fwrite(interleaved_buffer, 1, interleaved_buffer_size, fp) != interleaved_buffer_size) {
         set_error("Failed to write audio data");
-        free(interleaved_buffer);
+        vv_dsp_free(interleaved_buffer);
         return VV_DSP_ERROR_INTERNAL;
     }
 
-    free(interleaved_buffer);
+    vv_dsp_free(interleaved_buffer);
     return VV_DSP_OK;
 }
 
@@ -421,8 +1119,8 @@ static void set_error(const char* msg) {
     }
 }
 
-static vv_dsp_status skip_chunk(FILE* fp, uint32_t size) {
-    if (fseek(fp, (long)size, SEEK_CUR) != 0) {
+static vv_dsp_status skip_chunk(FILE* fp, uint64_t size) {
+    if (WAV_FSEEK(fp, size, SEEK_CUR) != 0) {
         set_error("Failed to skip chunk data");
         return VV_DSP_ERROR_INTERNAL;
     }
@@ -455,150 +1153,94 @@ static vv_dsp_status find_chunk(FILE* fp, uint32_t target_fourcc, uint32_t* out_
     return VV_DSP_ERROR_INTERNAL;
 }
 
-static vv_dsp_status deinterleave_float32(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info) {
-    const float* float_data = (const float*)interleaved;
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-            planar[ch][sample] = (vv_dsp_real)float_data[interleaved_idx];
-        }
-    }
-
-    return VV_DSP_OK;
-}
-
-static vv_dsp_status deinterleave_pcm16(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info) {
-    const int16_t* pcm_data = (const int16_t*)interleaved;
-    const vv_dsp_real scale = (vv_dsp_real)(1.0 / 32768.0); // Scale from [-32768, 32767] to [-1.0, 1.0)
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-            planar[ch][sample] = (vv_dsp_real)pcm_data[interleaved_idx] * scale;
-        }
+static vv_dsp_status wav_sample_format(const vv_dsp_wav_info* info, vv_dsp_sample_format* format) {
+    if (info->is_float && info->bit_depth == 32) {
+        *format = VV_DSP_SAMPLE_F32;
+    } else if (!info->is_float && info->bit_depth == 16) {
+        *format = VV_DSP_SAMPLE_S16;
+    } else if (!info->is_float && info->bit_depth == 24) {
+        *format = VV_DSP_SAMPLE_S24;
+    } else if (!info->is_float && info->bit_depth == 32) {
+        *format = VV_DSP_SAMPLE_S32;
+    } else {
+        set_error("Unsupported bit depth");
+        return VV_DSP_ERROR_INVALID_SIZE;
     }
-
     return VV_DSP_OK;
 }
 
-static vv_dsp_status deinterleave_pcm24(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info) {
-    const vv_dsp_real scale = (vv_dsp_real)(1.0 / 8388608.0); // Scale from [-8388608, 8388607] to [-1.0, 1.0)
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t byte_idx = (sample * (size_t)info->num_channels + (size_t)ch) * 3;
-
-            // Read 24-bit little-endian signed value
-            int32_t pcm_value = (int32_t)interleaved[byte_idx] |
-                               ((int32_t)interleaved[byte_idx + 1] << 8) |
-                               ((int32_t)interleaved[byte_idx + 2] << 16);
-
-            // Sign extend from 24-bit to 32-bit
-            if (pcm_value & 0x800000) {
-                pcm_value |= 0xFF000000;
-            }
-
-            planar[ch][sample] = (vv_dsp_real)pcm_value * scale;
-        }
+// Decode frames interleaved frames from src into planar channel buffers or, with
+// planar NULL, into one interleaved buffer
+static vv_dsp_status wav_decode(const uint8_t* src, size_t frames, const vv_dsp_wav_info* info,
+                                vv_dsp_real* const* planar, vv_dsp_real* interleaved) {
+    vv_dsp_sample_format format;
+    vv_dsp_status status = wav_sample_format(info, &format);
+    if (status != VV_DSP_OK) return status;
+    if (planar) {
+        return vv_dsp_convert_deinterleave(src, format, (size_t)info->num_channels, frames, planar);
     }
-
-    return VV_DSP_OK;
+    return vv_dsp_convert_to_real(src, format, frames * (size_t)info->num_channels, interleaved);
 }
 
-static vv_dsp_status deinterleave_pcm32(const uint8_t* interleaved, vv_dsp_real** planar, const vv_dsp_wav_info* info) {
-    const int32_t* pcm_data = (const int32_t*)interleaved;
-    const vv_dsp_real scale = (vv_dsp_real)(1.0 / 2147483648.0); // Scale from [-2^31, 2^31-1] to [-1.0, 1.0)
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-            planar[ch][sample] = (vv_dsp_real)pcm_data[interleaved_idx] * scale;
-        }
-    }
-
-    return VV_DSP_OK;
+// Queue the block being filled; written inline when there is no I/O thread
+static void writer_submit(vv_dsp_wav_writer* w) {
+    w->block_fill[w->head % w->num_blocks] = w->fill;
+    w->fill = 0;
+    WAV_STORE(&w->head, w->head + 1);
+    const size_t queued = w->head - WAV_LOAD(&w->tail);
+    if (queued > w->max_queued) w->max_queued = queued;
+    if (!w->threaded) writer_drain(w);
 }
 
-static vv_dsp_status interleave_float32(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info) {
-    float* float_data = (float*)interleaved;
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-            float_data[interleaved_idx] = (float)planar[ch][sample];
+// Write every queued block. After a failed write the blocks are still consumed,
+// so appending keeps going until it reports the failure.
+static void writer_drain(vv_dsp_wav_writer* w) {
+    const size_t head = WAV_LOAD(&w->head);
+    for (size_t tail = w->tail; tail != head; tail++) {
+        const size_t slot = tail % w->num_blocks;
+        const size_t bytes = w->block_fill[slot] * w->frame_bytes;
+        const uint8_t* block = w->blocks + slot * w->block_frames * w->frame_bytes;
+        if (!w->io_failed && fwrite(block, 1, bytes, w->fp) != bytes) {
+            WAV_STORE(&w->io_failed, (size_t)1);
         }
+        WAV_STORE(&w->tail, tail + 1);
     }
-
-    return VV_DSP_OK;
 }
 
-static vv_dsp_status interleave_pcm16(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info) {
-    int16_t* pcm_data = (int16_t*)interleaved;
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-
-            // Clamp and scale from [-1.0, 1.0] to [-32768, 32767]
-            vv_dsp_real clamped = planar[ch][sample];
-            if (clamped > (vv_dsp_real)1.0) clamped = (vv_dsp_real)1.0;
-            if (clamped < (vv_dsp_real)-1.0) clamped = (vv_dsp_real)-1.0;
-
-            int32_t scaled = (int32_t)(clamped * (vv_dsp_real)32767.0);
-            if (scaled > 32767) scaled = 32767;
-            if (scaled < -32768) scaled = -32768;
-
-            pcm_data[interleaved_idx] = (int16_t)scaled;
-        }
+// Patch the header sizes once all data is written. RIFF keeps the JUNK chunk;
+// RF64 turns it into ds64 and sets the 32-bit size fields to 0xFFFFFFFF.
+static vv_dsp_status writer_finish(vv_dsp_wav_writer* w) {
+    const uint64_t data_bytes = w->frames * w->frame_bytes;
+    const uint64_t pad = data_bytes & 1;
+    const uint64_t riff_size = (uint64_t)w->data_offset - 8 + data_bytes + pad;
+    const int rf64 = w->rf64 == VV_DSP_WAV_RF64_ALWAYS ||
+                     (w->rf64 == VV_DSP_WAV_RF64_AUTO && riff_size > 0xFFFFFFFFu);
+
+    wav_riff_header riff_header = { rf64 ? WAV_FOURCC_RF64 : WAV_FOURCC_RIFF,
+                                    rf64 ? WAV_SIZE_IN_DS64 : (uint32_t)riff_size, WAV_FOURCC_WAVE };
+    const uint32_t data_size = rf64 ? WAV_SIZE_IN_DS64 : (uint32_t)data_bytes;
+
+    int ok = !pad || fputc(0, w->fp) != EOF;
+    ok = ok && WAV_FSEEK(w->fp, 0, SEEK_SET) == 0 && fwrite(&riff_header, sizeof(riff_header), 1, w->fp) == 1;
+    if (ok && rf64) {
+        wav_chunk_header ds64_header = { WAV_FOURCC_DS64, WAV_DS64_SIZE };
+        wav_ds64_chunk ds64 = { riff_size, data_bytes, w->frames };
+        const uint32_t table_length = 0;
+        ok = fwrite(&ds64_header, sizeof(ds64_header), 1, w->fp) == 1 && fwrite(&ds64, sizeof(ds64), 1, w->fp) == 1 &&
+             fwrite(&table_length, sizeof(table_length), 1, w->fp) == 1;
     }
-
-    return VV_DSP_OK;
-}
-
-static vv_dsp_status interleave_pcm24(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info) {
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t byte_idx = (sample * (size_t)info->num_channels + (size_t)ch) * 3;
-
-            // Clamp and scale from [-1.0, 1.0] to [-8388608, 8388607]
-            vv_dsp_real clamped = planar[ch][sample];
-            if (clamped > (vv_dsp_real)1.0) clamped = (vv_dsp_real)1.0;
-            if (clamped < (vv_dsp_real)-1.0) clamped = (vv_dsp_real)-1.0;
-
-            int32_t scaled = (int32_t)(clamped * (vv_dsp_real)8388607.0);
-            if (scaled > 8388607) scaled = 8388607;
-            if (scaled < -8388608) scaled = -8388608;
-
-            // Write 24-bit little-endian value
-            interleaved[byte_idx] = (uint8_t)(scaled & 0xFF);
-            interleaved[byte_idx + 1] = (uint8_t)((scaled >> 8) & 0xFF);
-            interleaved[byte_idx + 2] = (uint8_t)((scaled >> 16) & 0xFF);
-        }
+    ok = ok && WAV_FSEEK(w->fp, w->data_offset - 4, SEEK_SET) == 0 &&
+         fwrite(&data_size, sizeof(data_size), 1, w->fp) == 1 && fflush(w->fp) == 0;
+    if (!ok) {
+        set_error("Failed to finalize WAV header");
+        return VV_DSP_ERROR_INTERNAL;
     }
-
     return VV_DSP_OK;
 }
 
-static vv_dsp_status interleave_pcm32(const vv_dsp_real* const* planar, uint8_t* interleaved, const vv_dsp_wav_info* info) {
-    int32_t* pcm_data = (int32_t*)interleaved;
-
-    for (size_t sample = 0; sample < info->num_samples; sample++) {
-        for (int ch = 0; ch < info->num_channels; ch++) {
-            size_t interleaved_idx = sample * (size_t)info->num_channels + (size_t)ch;
-
-            // Clamp and scale from [-1.0, 1.0] to [-2^31, 2^31-1]
-            vv_dsp_real clamped = planar[ch][sample];
-            if (clamped > (vv_dsp_real)1.0) clamped = (vv_dsp_real)1.0;
-            if (clamped < (vv_dsp_real)-1.0) clamped = (vv_dsp_real)-1.0;
-
-            int64_t scaled = (int64_t)(clamped * (vv_dsp_real)2147483647.0);
-            if (scaled > 2147483647LL) scaled = 2147483647LL;
-            if (scaled < -2147483648LL) scaled = -2147483648LL;
-
-            pcm_data[interleaved_idx] = (int32_t)scaled;
-        }
-    }
-
-    return VV_DSP_OK;
+static void writer_free(vv_dsp_wav_writer* w) {
+    if (w->fp) fclose(w->fp);
+    vv_dsp_free(w->blocks);
+    vv_dsp_free(w->block_fill);
+    vv_dsp_free(w);
 }
@@ -0,0 +1,192 @@
+/**
+ * @file alloc.c
+ * @brief Allocator hooks and counters behind every library allocation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define AL_ADD(p, v) ((void)InterlockedExchangeAddSizeT((p), (v)))
+#define AL_LOAD(p) InterlockedExchangeAddSizeT((p), 0)
+#define AL_STORE(p, v) ((void)InterlockedExchangePointer((PVOID volatile*)(p), (PVOID)(v)))
+#else
+#define AL_ADD(p, v) ((void)__atomic_add_fetch((p), (v), __ATOMIC_RELAXED))
+#define AL_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define AL_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#endif
+
+#if defined(_MSC_VER)
+#define AL_TLS __declspec(thread)
+#else
+#define AL_TLS __thread
+#endif
+
+static void* al_default_alloc(size_t size, void* user) {
+    (void)user;
+    return malloc(size);
+}
+
+static void* al_default_realloc(void* ptr, size_t size, void* user) {
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void al_default_free(void* ptr, void* user) {
+    (void)user;
+    free(ptr);
+}
+
+static struct {
+    vv_dsp_alloc_fn alloc;
+    vv_dsp_realloc_fn realloc;
+    vv_dsp_free_fn free;
+    void* user;
+} g_alloc = { al_default_alloc, al_default_realloc, al_default_free, NULL };
+
+static size_t g_allocations, g_frees, g_reallocations, g_failures, g_bytes;
+
+// The same counters for the calling thread alone
+static AL_TLS vv_dsp_alloc_stats t_stats;
+
+// Real-time section depth of this thread and the trap for allocator calls inside one
+static AL_TLS unsigned t_rt_depth;
+
+static void al_default_trap(const char* operation, size_t size, void* user) {
+    (void)user;
+    fprintf(stderr, "vv-dsp: %s of %zu bytes inside a real-time section\n", operation, size);
+    abort();
+}
+
+static vv_dsp_rt_trap_fn g_rt_trap = al_default_trap;
+static void* g_rt_trap_user;
+
+#define AL_RT_CHECK(operation, size) \
+    do { if (t_rt_depth) g_rt_trap((operation), (size), g_rt_trap_user); } while (0)
+
+// Profiling builds charge allocator calls to the entry point running on this thread
+#if defined(VV_DSP_ENABLE_PROFILING)
+#define AL_PROFILE_NOTE() vv_dsp_profile_note_allocation()
+#else
+#define AL_PROFILE_NOTE() ((void)0)
+#endif
+
+vv_dsp_status vv_dsp_set_allocator(vv_dsp_alloc_fn alloc_fn, vv_dsp_realloc_fn realloc_fn, vv_dsp_free_fn free_fn,
+                                   void* user) {
+    if (!alloc_fn && !realloc_fn && !free_fn) {
+        g_alloc.alloc = al_default_alloc;
+        g_alloc.realloc = al_default_realloc;
+        g_alloc.free = al_default_free;
+        g_alloc.user = NULL;
+        return VV_DSP_OK;
+    }
+    if (!alloc_fn || !realloc_fn || !free_fn) return VV_DSP_ERROR_NULL_POINTER;
+    g_alloc.alloc = alloc_fn;
+    g_alloc.realloc = realloc_fn;
+    g_alloc.free = free_fn;
+    g_alloc.user = user;
+    return VV_DSP_OK;
+}
+
+void* vv_dsp_malloc(size_t size) {
+    if (size == 0) return NULL;
+    AL_RT_CHECK("malloc", size);
+    AL_PROFILE_NOTE();
+    void* p = g_alloc.alloc(size, g_alloc.user);
+    if (!p) {
+        AL_ADD(&g_failures, 1);
+        t_stats.failures++;
+        return NULL;
+    }
+    AL_ADD(&g_allocations, 1);
+    AL_ADD(&g_bytes, size);
+    t_stats.allocations++;
+    t_stats.bytes_requested += size;
+    return p;
+}
+
+void* vv_dsp_calloc(size_t count, size_t size) {
+    if (count == 0 || size == 0) return NULL;
+    if (count > (size_t)-1 / size) {
+        AL_ADD(&g_failures, 1);
+        t_stats.failures++;
+        return NULL;
+    }
+    void* p = vv_dsp_malloc(count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+void* vv_dsp_realloc(void* ptr, size_t size) {
+    if (!ptr) return vv_dsp_malloc(size);
+    if (size == 0) {
+        vv_dsp_free(ptr);
+        return NULL;
+    }
+    AL_RT_CHECK("realloc", size);
+    AL_PROFILE_NOTE();
+    void* p = g_alloc.realloc(ptr, size, g_alloc.user);
+    if (!p) {
+        AL_ADD(&g_failures, 1);
+        t_stats.failures++;
+        return NULL;
+    }
+    AL_ADD(&g_reallocations, 1);
+    AL_ADD(&g_bytes, size);
+    t_stats.reallocations++;
+    t_stats.bytes_requested += size;
+    return p;
+}
+
+void vv_dsp_free(void* ptr) {
+    if (!ptr) return;
+    AL_RT_CHECK("free", 0);
+    g_alloc.free(ptr, g_alloc.user);
+    AL_ADD(&g_frees, 1);
+    t_stats.frees++;
+}
+
+vv_dsp_status vv_dsp_get_alloc_stats(vv_dsp_alloc_stats* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    out->allocations = AL_LOAD(&g_allocations);
+    out->frees = AL_LOAD(&g_frees);
+    out->reallocations = AL_LOAD(&g_reallocations);
+    out->failures = AL_LOAD(&g_failures);
+    out->bytes_requested = AL_LOAD(&g_bytes);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_get_thread_alloc_stats(vv_dsp_alloc_stats* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = t_stats;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_reset_alloc_stats(void) {
+    AL_STORE(&g_allocations, 0);
+    AL_STORE(&g_frees, 0);
+    AL_STORE(&g_reallocations, 0);
+    AL_STORE(&g_failures, 0);
+    AL_STORE(&g_bytes, 0);
+}
+
+void vv_dsp_set_rt_trap(vv_dsp_rt_trap_fn trap, void* user) {
+    g_rt_trap = trap ? trap : al_default_trap;
+    g_rt_trap_user = trap ? user : NULL;
+}
+
+void vv_dsp_rt_enter(void) {
+    t_rt_depth++;
+}
+
+void vv_dsp_rt_leave(void) {
+    if (t_rt_depth) t_rt_depth--;
+}
+
+int vv_dsp_rt_active(void) {
+    return t_rt_depth != 0;
+}
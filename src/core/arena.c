@@ -0,0 +1,86 @@
+/**
+ * @file arena.c
+ * @brief Bump allocator over one aligned block
+ */
+
+#include <stdlib.h>
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+
+struct vv_dsp_arena {
+    unsigned char* base;  // VV_DSP_SIMD_ALIGN_DEFAULT-aligned
+    size_t capacity;
+    size_t top;
+    size_t high_water;
+};
+
+vv_dsp_status vv_dsp_arena_create(size_t capacity, vv_dsp_arena** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (capacity == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_arena* a = (vv_dsp_arena*)vv_dsp_calloc(1, sizeof(*a));
+    if (!a) return VV_DSP_ERROR_INTERNAL;
+    a->base = (unsigned char*)vv_dsp_aligned_malloc(capacity, VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (!a->base) {
+        vv_dsp_free(a);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    a->capacity = capacity;
+    *out = a;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_arena_destroy(vv_dsp_arena* arena) {
+    if (!arena) return;
+    vv_dsp_aligned_free(arena->base);
+    vv_dsp_free(arena);
+}
+
+size_t vv_dsp_arena_request_size(size_t bytes) {
+    const size_t align = VV_DSP_SIMD_ALIGN_DEFAULT;
+    return (bytes + align - 1) / align * align;
+}
+
+void* vv_dsp_arena_alloc(vv_dsp_arena* arena, size_t bytes) {
+    if (!arena) return NULL;
+    const size_t need = vv_dsp_arena_request_size(bytes);
+    if (need < bytes || need > arena->capacity - arena->top) return NULL;
+    void* p = arena->base + arena->top;
+    arena->top += need;
+    if (arena->top > arena->high_water) arena->high_water = arena->top;
+    return p;
+}
+
+size_t vv_dsp_arena_mark(const vv_dsp_arena* arena) {
+    return arena ? arena->top : 0;
+}
+
+void vv_dsp_arena_reset_to(vv_dsp_arena* arena, size_t mark) {
+    if (arena && mark < arena->top) arena->top = mark;
+}
+
+void vv_dsp_arena_reset(vv_dsp_arena* arena) {
+    if (arena) arena->top = 0;
+}
+
+size_t vv_dsp_arena_capacity(const vv_dsp_arena* arena) {
+    return arena ? arena->capacity : 0;
+}
+
+size_t vv_dsp_arena_used(const vv_dsp_arena* arena) {
+    return arena ? arena->top : 0;
+}
+
+size_t vv_dsp_arena_high_water(const vv_dsp_arena* arena) {
+    return arena ? arena->high_water : 0;
+}
+
+void* vv_dsp_scratch_alloc(vv_dsp_arena* arena, size_t bytes) {
+    if (arena) return vv_dsp_arena_alloc(arena, bytes);
+    return vv_dsp_aligned_malloc(bytes ? bytes : 1, VV_DSP_SIMD_ALIGN_DEFAULT);
+}
+
+void vv_dsp_scratch_free(vv_dsp_arena* arena, void* ptr) {
+    if (!arena) vv_dsp_aligned_free(ptr);
+}
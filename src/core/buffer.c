@@ -0,0 +1,225 @@
+/**
+ * @file buffer.c
+ * @brief Multichannel buffer descriptors, layout conversion, gain and mix
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "vv_dsp/core/buffer.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+
+static int buffer_valid(const vv_dsp_buffer* b) {
+    return b && (b->data || b->channels == 0 || b->frames == 0);
+}
+
+vv_dsp_status vv_dsp_buffer_view_planar(vv_dsp_real* data, size_t channels, size_t frames,
+                                        size_t channel_stride, vv_dsp_buffer* out) {
+    if (!data || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (channel_stride == 0) channel_stride = frames;
+    if (channels == 0 || (channels > 1 && channel_stride < frames)) return VV_DSP_ERROR_INVALID_SIZE;
+    out->data = data;
+    out->channels = channels;
+    out->frames = frames;
+    out->channel_stride = channel_stride;
+    out->frame_stride = 1;
+    out->alignment = sizeof(vv_dsp_real);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_view_interleaved(vv_dsp_real* data, size_t channels, size_t frames,
+                                             vv_dsp_buffer* out) {
+    if (!data || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (channels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    out->data = data;
+    out->channels = channels;
+    out->frames = frames;
+    out->channel_stride = 1;
+    out->frame_stride = channels;
+    out->alignment = sizeof(vv_dsp_real);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_view_range(const vv_dsp_buffer* buf, size_t first, size_t count, size_t offset,
+                                       size_t frames, vv_dsp_buffer* out) {
+    if (!buffer_valid(buf) || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (first > buf->channels || count > buf->channels - first || offset > buf->frames ||
+        frames > buf->frames - offset) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    *out = *buf;
+    out->channels = count;
+    out->frames = frames;
+    const size_t skip = first * buf->channel_stride + offset * buf->frame_stride;
+    if (buf->data) out->data = buf->data + skip;
+    if (!buf->alignment || (skip * sizeof(vv_dsp_real)) % buf->alignment) out->alignment = sizeof(vv_dsp_real);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_create(size_t channels, size_t frames, vv_dsp_buffer_layout layout,
+                                   vv_dsp_buffer* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    memset(out, 0, sizeof(*out));
+    if (channels == 0 || frames == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (layout != VV_DSP_BUFFER_PLANAR && layout != VV_DSP_BUFFER_INTERLEAVED) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const size_t lane = VV_DSP_SIMD_ALIGN_DEFAULT / sizeof(vv_dsp_real);
+    const size_t stride = layout == VV_DSP_BUFFER_PLANAR ? (frames + lane - 1) / lane * lane : frames;
+    if (stride < frames || stride > SIZE_MAX / sizeof(vv_dsp_real) / channels) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t bytes = stride * channels * sizeof(vv_dsp_real);
+    vv_dsp_real* data = (vv_dsp_real*)vv_dsp_aligned_malloc(bytes, VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (!data) return VV_DSP_ERROR_INTERNAL;
+    memset(data, 0, bytes);
+    out->data = data;
+    out->channels = channels;
+    out->frames = frames;
+    if (layout == VV_DSP_BUFFER_PLANAR) {
+        out->channel_stride = stride;
+        out->frame_stride = 1;
+        out->alignment = VV_DSP_SIMD_ALIGN_DEFAULT;
+    } else {
+        out->channel_stride = 1;
+        out->frame_stride = channels;
+        out->alignment = channels == 1 ? VV_DSP_SIMD_ALIGN_DEFAULT : sizeof(vv_dsp_real);
+    }
+    return VV_DSP_OK;
+}
+
+void vv_dsp_buffer_free(vv_dsp_buffer* buf) {
+    if (!buf) return;
+    vv_dsp_aligned_free(buf->data);
+    memset(buf, 0, sizeof(*buf));
+}
+
+vv_dsp_buffer_layout vv_dsp_buffer_get_layout(const vv_dsp_buffer* buf) {
+    if (!buf || buf->channels <= 1 || buf->frames <= 1 || buf->frame_stride == 1) return VV_DSP_BUFFER_PLANAR;
+    if (buf->channel_stride == 1 && buf->frame_stride == buf->channels) return VV_DSP_BUFFER_INTERLEAVED;
+    return VV_DSP_BUFFER_STRIDED;
+}
+
+vv_dsp_real* vv_dsp_buffer_channel(const vv_dsp_buffer* buf, size_t channel) {
+    if (!buf || !buf->data || channel >= buf->channels) return NULL;
+    return buf->data + channel * buf->channel_stride;
+}
+
+// Frames of one channel are contiguous, or all samples are one contiguous run
+static int buffer_dense(const vv_dsp_buffer* b) {
+    return b->channels == 1 ? b->frame_stride == 1
+                            : b->channel_stride == 1 && b->frame_stride == b->channels;
+}
+
+vv_dsp_status vv_dsp_buffer_clear(vv_dsp_buffer* buf) {
+    if (!buffer_valid(buf)) return VV_DSP_ERROR_NULL_POINTER;
+    if (buf->channels == 0 || buf->frames == 0) return VV_DSP_OK;
+    if (buffer_dense(buf)) {
+        memset(buf->data, 0, buf->channels * buf->frames * sizeof(vv_dsp_real));
+        return VV_DSP_OK;
+    }
+    for (size_t c = 0; c < buf->channels; ++c) {
+        vv_dsp_real* p = buf->data + c * buf->channel_stride;
+        if (buf->frame_stride == 1) {
+            memset(p, 0, buf->frames * sizeof(vv_dsp_real));
+            continue;
+        }
+        for (size_t f = 0; f < buf->frames; ++f) p[f * buf->frame_stride] = 0;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_copy(const vv_dsp_buffer* src, vv_dsp_buffer* dst) {
+    if (!buffer_valid(src) || !buffer_valid(dst)) return VV_DSP_ERROR_NULL_POINTER;
+    if (src->channels != dst->channels || src->frames != dst->frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (src->data == dst->data && src->channel_stride == dst->channel_stride &&
+        src->frame_stride == dst->frame_stride) {
+        return VV_DSP_OK;
+    }
+    const size_t C = src->channels, N = src->frames;
+    if (C == 0 || N == 0) return VV_DSP_OK;
+    if (buffer_dense(src) && buffer_dense(dst)) {
+        memcpy(dst->data, src->data, C * N * sizeof(vv_dsp_real));
+        return VV_DSP_OK;
+    }
+    if (dst->frame_stride == 1 || (src->frame_stride == 1 && dst->channel_stride != 1)) {
+        // Channel at a time: contiguous writes (or reads) along the frames
+        for (size_t c = 0; c < C; ++c) {
+            const vv_dsp_real* s = src->data + c * src->channel_stride;
+            vv_dsp_real* d = dst->data + c * dst->channel_stride;
+            if (src->frame_stride == 1 && dst->frame_stride == 1) {
+                memcpy(d, s, N * sizeof(vv_dsp_real));
+                continue;
+            }
+            for (size_t f = 0; f < N; ++f) d[f * dst->frame_stride] = s[f * src->frame_stride];
+        }
+        return VV_DSP_OK;
+    }
+    // Frame at a time: contiguous writes across the channels of each frame
+    for (size_t f = 0; f < N; ++f) {
+        const vv_dsp_real* s = src->data + f * src->frame_stride;
+        vv_dsp_real* d = dst->data + f * dst->frame_stride;
+        for (size_t c = 0; c < C; ++c) d[c * dst->channel_stride] = s[c * src->channel_stride];
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_gain(vv_dsp_buffer* buf, const vv_dsp_real* gains, vv_dsp_real gain) {
+    if (!buffer_valid(buf)) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t C = buf->channels, N = buf->frames;
+    if (C == 0 || N == 0) return VV_DSP_OK;
+    if (!gains && buffer_dense(buf)) {
+        vv_dsp_real* p = buf->data;
+        for (size_t i = 0; i < C * N; ++i) p[i] *= gain;
+        return VV_DSP_OK;
+    }
+    if (buf->frame_stride == 1) {
+        // Frame-vectorized: one gain over each contiguous channel
+        for (size_t c = 0; c < C; ++c) {
+            vv_dsp_real* p = buf->data + c * buf->channel_stride;
+            const vv_dsp_real g = gains ? gains[c] : gain;
+            for (size_t f = 0; f < N; ++f) p[f] *= g;
+        }
+        return VV_DSP_OK;
+    }
+    // Channel-vectorized: the gain row is applied to each frame
+    for (size_t f = 0; f < N; ++f) {
+        vv_dsp_real* p = buf->data + f * buf->frame_stride;
+        if (buf->channel_stride == 1) {
+            for (size_t c = 0; c < C; ++c) p[c] *= gains ? gains[c] : gain;
+        } else {
+            for (size_t c = 0; c < C; ++c) p[c * buf->channel_stride] *= gains ? gains[c] : gain;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_buffer_mix(const vv_dsp_buffer* in, const vv_dsp_real* matrix, vv_dsp_buffer* out,
+                                int accumulate) {
+    if (!buffer_valid(in) || !buffer_valid(out) || !matrix) return VV_DSP_ERROR_NULL_POINTER;
+    if (in->frames != out->frames) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t CI = in->channels, CO = out->channels, N = in->frames;
+    if (CO == 0 || N == 0) return VV_DSP_OK;
+    if (in->frame_stride == 1 && out->frame_stride == 1) {
+        // Frame-vectorized: each output channel accumulates whole input channels
+        for (size_t o = 0; o < CO; ++o) {
+            vv_dsp_real* d = out->data + o * out->channel_stride;
+            if (!accumulate) memset(d, 0, N * sizeof(vv_dsp_real));
+            for (size_t i = 0; i < CI; ++i) {
+                const vv_dsp_real m = matrix[o * CI + i];
+                if (m == 0) continue;
+                const vv_dsp_real* s = in->data + i * in->channel_stride;
+                for (size_t f = 0; f < N; ++f) d[f] += m * s[f];
+            }
+        }
+        return VV_DSP_OK;
+    }
+    // Channel-vectorized: one matrix-vector product per frame
+    for (size_t f = 0; f < N; ++f) {
+        const vv_dsp_real* s = in->data + f * in->frame_stride;
+        vv_dsp_real* d = out->data + f * out->frame_stride;
+        for (size_t o = 0; o < CO; ++o) {
+            const vv_dsp_real* row = matrix + o * CI;
+            vv_dsp_real acc = accumulate ? d[o * out->channel_stride] : 0;
+            for (size_t i = 0; i < CI; ++i) acc += row[i] * s[i * in->channel_stride];
+            d[o * out->channel_stride] = acc;
+        }
+    }
+    return VV_DSP_OK;
+}
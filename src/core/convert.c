@@ -0,0 +1,58 @@
+/**
+ * @file convert.c
+ * @brief Sample format conversion entry points over the dispatched kernels
+ */
+
+#include <stdint.h>
+#include "vv_dsp/core/convert.h"
+#include "simd_dispatch.h"
+
+size_t vv_dsp_sample_format_bytes(vv_dsp_sample_format format) {
+    switch (format) {
+    case VV_DSP_SAMPLE_S16: return 2;
+    case VV_DSP_SAMPLE_S24: return 3;
+    case VV_DSP_SAMPLE_S32:
+    case VV_DSP_SAMPLE_F32: return 4;
+    }
+    return 0;
+}
+
+vv_dsp_status vv_dsp_convert_to_real(const void* src, vv_dsp_sample_format format, size_t count,
+                                     vv_dsp_real* out) {
+    if (count && (!src || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_sample_format_bytes(format)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (count) vv_dsp_simd_kernels_get()->pcm_decode((const uint8_t*)src, format, count, out);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_convert_from_real(const vv_dsp_real* in, size_t count, vv_dsp_sample_format format,
+                                       void* dst) {
+    if (count && (!in || !dst)) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_sample_format_bytes(format)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (count) vv_dsp_simd_kernels_get()->pcm_encode(in, format, count, (uint8_t*)dst);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_convert_deinterleave(const void* src, vv_dsp_sample_format format, size_t channels,
+                                          size_t frames, vv_dsp_real* const* out) {
+    if (!out || (frames && !src)) return VV_DSP_ERROR_NULL_POINTER;
+    if (channels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!vv_dsp_sample_format_bytes(format)) return VV_DSP_ERROR_UNSUPPORTED;
+    for (size_t ch = 0; ch < channels; ++ch) {
+        if (frames && !out[ch]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (frames) vv_dsp_simd_kernels_get()->pcm_deinterleave((const uint8_t*)src, format, channels, frames, out);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_convert_interleave(const vv_dsp_real* const* in, size_t channels, size_t frames,
+                                        vv_dsp_sample_format format, void* dst) {
+    if (!in || (frames && !dst)) return VV_DSP_ERROR_NULL_POINTER;
+    if (channels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!vv_dsp_sample_format_bytes(format)) return VV_DSP_ERROR_UNSUPPORTED;
+    for (size_t ch = 0; ch < channels; ++ch) {
+        if (frames && !in[ch]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (frames) vv_dsp_simd_kernels_get()->pcm_interleave(in, channels, frames, format, (uint8_t*)dst);
+    return VV_DSP_OK;
+}
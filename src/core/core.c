@@ -1,6 +1,7 @@
 #include "vv_dsp/core.h"
 #include <math.h>
 #include <float.h>
+#include "simd_dispatch.h"
 
 int vv_dsp_add_int(int a, int b) {
     return a + b;
@@ -34,6 +35,62 @@ vv_dsp_cpx vv_dsp_cpx_from_polar(vv_dsp_real r, vv_dsp_real theta) {
     vv_dsp_cpx z; z.re = (vv_dsp_real)(ct * (double)r); z.im = (vv_dsp_real)(st * (double)r); return z;
 }
 
+// ---------- Complex arrays ----------
+static vv_dsp_status cpx_tier_check(vv_dsp_vmath_tier tier) {
+    return ((int)tier < (int)VV_DSP_VMATH_FAST || (int)tier > (int)VV_DSP_VMATH_EXACT) ? VV_DSP_ERROR_OUT_OF_RANGE
+                                                                                      : VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_abs_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n) {
+    if (!z || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->cpx_mag(z, out, n, 0);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_power_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n) {
+    if (!z || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->cpx_mag(z, out, n, 1);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_phase_array(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, vv_dsp_vmath_tier tier) {
+    if (!z || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status st = cpx_tier_check(tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; ++i) out[i] = vv_dsp_cpx_phase(z[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->cpx_phase(z, out, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_polar_to_cpx_array(const vv_dsp_real* mag, const vv_dsp_real* phase, vv_dsp_cpx* out,
+                                            size_t n, vv_dsp_vmath_tier tier) {
+    if (!mag || !phase || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status st = cpx_tier_check(tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; ++i) out[i] = vv_dsp_cpx_from_polar(mag[i], phase[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->polar(mag, phase, out, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_conj_mul_array(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    if (!a || !b || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->cpx_conj_mul(a, b, out, n);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cpx_scale_array(const vv_dsp_cpx* z, vv_dsp_real g, vv_dsp_cpx* out, size_t n) {
+    if (!z || !out) return VV_DSP_ERROR_NULL_POINTER;
+    // A complex array is 2n interleaved reals (vv_dsp_types.h asserts the layout)
+    vv_dsp_simd_kernels_get()->scale((const vv_dsp_real*)(const void*)z, g, (vv_dsp_real*)(void*)out, 2 * n);
+    return VV_DSP_OK;
+}
+
 // ---------- Basic math (real) ----------
 static VV_DSP_INLINE int vv_dsp_is_invalid_input(const vv_dsp_real* x, size_t n) {
     return (x == NULL || n == 0);
@@ -0,0 +1,41 @@
+/**
+ * @file fixed_point.c
+ * @brief Conversions between vv_dsp_real and Q15 / Q31 samples
+ */
+
+#include <math.h>
+#include "vv_dsp/core/fixed_point.h"
+
+// Round half away from zero, saturate, and map NaN to 0
+static int64_t to_fixed(double v, double scale, int64_t lo, int64_t hi) {
+    if (!(v == v)) return 0;
+    v *= scale;
+    v = (v >= 0.0) ? floor(v + 0.5) : ceil(v - 0.5);
+    if (v >= (double)hi) return hi;
+    if (v <= (double)lo) return lo;
+    return (int64_t)v;
+}
+
+vv_dsp_status vv_dsp_real_to_q15(const vv_dsp_real* in, vv_dsp_q15* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_q15)to_fixed((double)in[i], 32768.0, INT16_MIN, INT16_MAX);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_q15_to_real(const vv_dsp_q15* in, vv_dsp_real* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_real)((double)in[i] * (1.0 / 32768.0));
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_real_to_q31(const vv_dsp_real* in, vv_dsp_q31* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_q31)to_fixed((double)in[i], 2147483648.0, INT32_MIN, INT32_MAX);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_q31_to_real(const vv_dsp_q31* in, vv_dsp_real* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_real)((double)in[i] * (1.0 / 2147483648.0));
+    return VV_DSP_OK;
+}
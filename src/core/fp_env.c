@@ -5,7 +5,8 @@
 
 #include "vv_dsp/core/fp_env.h"
 
-// Platform detection and implementation
+// Platform detection: each branch reads and writes the control register that holds
+// the flush bits (VV_DSP_FP_FLUSH_BITS); the API below is written against those
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
     // x86/x64 implementation using SSE intrinsics
     #include <xmmintrin.h>
@@ -14,24 +15,14 @@
     // MXCSR register bit definitions
     #define VV_DSP_MXCSR_FTZ  (1U << 15)  // Flush to Zero (bit 15)
     #define VV_DSP_MXCSR_DAZ  (1U << 6)   // Denormals Are Zero (bit 6)
+    #define VV_DSP_FP_FLUSH_BITS (VV_DSP_MXCSR_FTZ | VV_DSP_MXCSR_DAZ)
 
-    void vv_dsp_set_flush_denormals(bool enable) {
-        unsigned int mxcsr = _mm_getcsr();
-        if (enable) {
-            // Set FZ (Flush to Zero, bit 15) and DAZ (Denormals Are Zero, bit 6)
-            mxcsr |= (VV_DSP_MXCSR_FTZ | VV_DSP_MXCSR_DAZ);
-        } else {
-            // Clear FZ and DAZ bits to restore normal IEEE 754 behavior
-            mxcsr &= ~(VV_DSP_MXCSR_FTZ | VV_DSP_MXCSR_DAZ);
-        }
-        _mm_setcsr(mxcsr);
+    static unsigned long fp_ctrl_read(void) {
+        return (unsigned long)_mm_getcsr();
     }
 
-    bool vv_dsp_get_flush_denormals_mode(void) {
-        unsigned int mxcsr = _mm_getcsr();
-        // Both FZ and DAZ must be set for full denormal handling
-        return (mxcsr & (VV_DSP_MXCSR_FTZ | VV_DSP_MXCSR_DAZ)) ==
-               (VV_DSP_MXCSR_FTZ | VV_DSP_MXCSR_DAZ);
+    static void fp_ctrl_write(unsigned long v) {
+        _mm_setcsr((unsigned int)v);
     }
 
 #elif defined(__aarch64__)
@@ -39,28 +30,19 @@
     #include <stdint.h>
     #define VV_DSP_HAS_FTZ_SUPPORT 1
 
-    void vv_dsp_set_flush_denormals(bool enable) {
+    // FZ bit (bit 24) - Flush to Zero
+    #define VV_DSP_FP_FLUSH_BITS (1UL << 24)
+
+    static unsigned long fp_ctrl_read(void) {
         uint64_t fpcr;
         // Read FPCR (Floating-Point Control Register)
         __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
-
-        if (enable) {
-            // Set FZ bit (bit 24) - Flush to Zero
-            fpcr |= (1UL << 24);
-        } else {
-            // Clear FZ bit to restore normal IEEE 754 behavior
-            fpcr &= ~(1UL << 24);
-        }
-
-        // Write back to FPCR
-        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+        return (unsigned long)fpcr;
     }
 
-    bool vv_dsp_get_flush_denormals_mode(void) {
-        uint64_t fpcr;
-        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
-        // Check if FZ bit (bit 24) is set
-        return (fpcr & (1UL << 24)) != 0;
+    static void fp_ctrl_write(unsigned long v) {
+        const uint64_t fpcr = (uint64_t)v;
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
     }
 
 #elif defined(__arm__) && defined(__ARM_ARCH) && (__ARM_ARCH >= 7)
@@ -68,42 +50,70 @@
     #include <stdint.h>
     #define VV_DSP_HAS_FTZ_SUPPORT 1
 
-    void vv_dsp_set_flush_denormals(bool enable) {
+    // FZ bit (bit 24) - Flush to Zero
+    #define VV_DSP_FP_FLUSH_BITS (1UL << 24)
+
+    static unsigned long fp_ctrl_read(void) {
         uint32_t fpscr;
         // Read FPSCR (Floating-Point Status and Control Register)
         __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
-
-        if (enable) {
-            // Set FZ bit (bit 24) - Flush to Zero
-            fpscr |= (1UL << 24);
-        } else {
-            // Clear FZ bit to restore normal IEEE 754 behavior
-            fpscr &= ~(1UL << 24);
-        }
-
-        // Write back to FPSCR
-        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr));
+        return (unsigned long)fpscr;
     }
 
-    bool vv_dsp_get_flush_denormals_mode(void) {
-        uint32_t fpscr;
-        __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
-        // Check if FZ bit (bit 24) is set
-        return (fpscr & (1UL << 24)) != 0;
+    static void fp_ctrl_write(unsigned long v) {
+        const uint32_t fpscr = (uint32_t)v;
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr));
     }
 
 #else
-    // Fallback implementation for unsupported platforms
+    // Fallback implementation for unsupported platforms: no flush bits, so every
+    // call below is a no-op and the mode always reads as disabled
     #define VV_DSP_HAS_FTZ_SUPPORT 0
+    #define VV_DSP_FP_FLUSH_BITS 0UL
 
-    void vv_dsp_set_flush_denormals(bool enable) {
-        // No-op for unsupported platforms
-        (void)enable; // Suppress unused parameter warning
+    static unsigned long fp_ctrl_read(void) {
+        return 0;
     }
 
-    bool vv_dsp_get_flush_denormals_mode(void) {
-        // Always return false for unsupported platforms
-        return false;
+    static void fp_ctrl_write(unsigned long v) {
+        (void)v;
     }
 
 #endif
+
+void vv_dsp_set_flush_denormals(bool enable) {
+    if (!VV_DSP_HAS_FTZ_SUPPORT) return;
+    unsigned long ctrl = fp_ctrl_read();
+    if (enable) {
+        ctrl |= VV_DSP_FP_FLUSH_BITS;
+    } else {
+        // Clear the flush bits to restore normal IEEE 754 behavior
+        ctrl &= ~(unsigned long)VV_DSP_FP_FLUSH_BITS;
+    }
+    fp_ctrl_write(ctrl);
+}
+
+bool vv_dsp_get_flush_denormals_mode(void) {
+    if (!VV_DSP_HAS_FTZ_SUPPORT) return false;
+    // All flush bits (FZ and DAZ on x86) must be set for full denormal handling
+    return (fp_ctrl_read() & VV_DSP_FP_FLUSH_BITS) == VV_DSP_FP_FLUSH_BITS;
+}
+
+void vv_dsp_fp_scope_enter(vv_dsp_fp_scope* scope, vv_dsp_denormal_mode mode) {
+    scope->saved = 0;
+    scope->changed = false;
+    if (!VV_DSP_HAS_FTZ_SUPPORT || mode != VV_DSP_DENORMALS_FLUSH) return;
+    const unsigned long ctrl = fp_ctrl_read();
+    if ((ctrl & VV_DSP_FP_FLUSH_BITS) == VV_DSP_FP_FLUSH_BITS) return;
+    scope->saved = ctrl & VV_DSP_FP_FLUSH_BITS;
+    scope->changed = true;
+    fp_ctrl_write(ctrl | VV_DSP_FP_FLUSH_BITS);
+}
+
+void vv_dsp_fp_scope_exit(const vv_dsp_fp_scope* scope) {
+    if (!scope->changed) return;
+    // Only the flush bits go back: status flags raised inside the scope (kept in the
+    // same register on x86 and ARMv7) stay visible to the caller
+    const unsigned long ctrl = fp_ctrl_read() & ~(unsigned long)VV_DSP_FP_FLUSH_BITS;
+    fp_ctrl_write(ctrl | scope->saved);
+}
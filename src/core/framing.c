@@ -9,6 +9,7 @@
 #include "vv_dsp/core.h"
 #include "vv_dsp/vv_dsp_types.h"
 #include <string.h>
+#include "simd_dispatch.h"
 
 // Helper function to clamp a value between bounds
 static VV_DSP_INLINE long clamp_long(long value, long min_val, long max_val) {
@@ -68,6 +69,45 @@ size_t vv_dsp_get_num_frames(size_t signal_len, size_t frame_len, size_t hop_len
     }
 }
 
+// One frame starting at frame_start. Frames inside the signal are a straight
+// copy or a vector multiply by the window; only frames that cross an edge take
+// the per-sample padding path.
+static void frame_fill(const vv_dsp_real* signal, size_t signal_len, vv_dsp_real* out, size_t frame_len,
+                       long frame_start, int center, const vv_dsp_real* window,
+                       const vv_dsp_simd_kernels* k) {
+    if (frame_start >= 0 && (size_t)frame_start + frame_len <= signal_len) {
+        const vv_dsp_real* src = signal + frame_start;
+        if (window) {
+            k->mul(src, window, out, frame_len);
+        } else {
+            memcpy(out, src, frame_len * sizeof(vv_dsp_real));
+        }
+        return;
+    }
+    for (size_t i = 0; i < frame_len; i++) {
+        long sample_idx = frame_start + (long)i;
+        vv_dsp_real sample_value;
+
+        if (sample_idx >= 0 && sample_idx < (long)signal_len) {
+            sample_value = signal[sample_idx];
+        } else if (center != 0) {
+            // Use reflection padding for centered framing
+            sample_value = signal[reflect_index(sample_idx, signal_len)];
+        } else {
+            // For non-centered framing, use zero padding outside signal bounds
+            sample_value = 0.0;
+        }
+
+        // Apply window if provided
+        out[i] = window != NULL ? sample_value * window[i] : sample_value;
+    }
+}
+
+static VV_DSP_INLINE long frame_start_of(size_t frame_index, size_t frame_len, size_t hop_len, int center) {
+    // Centered frames are centered at frame_index * hop_len
+    return (long)(frame_index * hop_len) - (center != 0 ? (long)(frame_len / 2) : 0);
+}
+
 vv_dsp_status vv_dsp_fetch_frame(const vv_dsp_real* signal, size_t signal_len,
                                  vv_dsp_real* frame_buffer, size_t frame_len,
                                  size_t hop_len, size_t frame_index, int center,
@@ -81,45 +121,97 @@ vv_dsp_status vv_dsp_fetch_frame(const vv_dsp_real* signal, size_t signal_len,
         return VV_DSP_ERROR_INVALID_SIZE;
     }
 
-    // Calculate frame start position
-    long frame_start;
-    if (center != 0) {
-        // Centered framing: frame is centered at frame_index * hop_len
-        frame_start = (long)(frame_index * hop_len) - (long)(frame_len / 2);
-    } else {
-        // Non-centered framing: frame starts at frame_index * hop_len
-        frame_start = (long)(frame_index * hop_len);
+    frame_fill(signal, signal_len, frame_buffer, frame_len, frame_start_of(frame_index, frame_len, hop_len, center),
+               center, window, vv_dsp_simd_kernels_get());
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fetch_frames(const vv_dsp_real* signal, size_t signal_len, size_t frame_len,
+                                  size_t hop_len, int center, const vv_dsp_real* window,
+                                  vv_dsp_real* out_matrix, size_t first, size_t count) {
+    if (!signal || !out_matrix) {
+        return VV_DSP_ERROR_NULL_POINTER;
     }
 
-    // Fill frame buffer
-    for (size_t i = 0; i < frame_len; i++) {
-        long sample_idx = frame_start + (long)i;
-        vv_dsp_real sample_value;
+    if (signal_len == 0 || frame_len == 0 || hop_len == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
 
-        if (center != 0) {
-            // Use reflection padding for centered framing
-            size_t reflected_idx = reflect_index(sample_idx, signal_len);
-            sample_value = signal[reflected_idx];
-        } else {
-            // For non-centered framing, use zero padding outside signal bounds
-            if (sample_idx < 0 || sample_idx >= (long)signal_len) {
-                sample_value = 0.0;
-            } else {
-                sample_value = signal[sample_idx];
-            }
-        }
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    long start = frame_start_of(first, frame_len, hop_len, center);
+    for (size_t f = 0; f < count; f++, start += (long)hop_len) {
+        frame_fill(signal, signal_len, out_matrix + f * frame_len, frame_len, start, center, window, k);
+    }
+    return VV_DSP_OK;
+}
 
-        // Apply window if provided
-        if (window != NULL) {
-            frame_buffer[i] = sample_value * window[i];
-        } else {
-            frame_buffer[i] = sample_value;
-        }
+vv_dsp_status vv_dsp_frame_view_init(vv_dsp_frame_view* view, const vv_dsp_real* signal, size_t signal_len,
+                                     size_t frame_len, size_t hop_len, int center) {
+    if (!view || !signal) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    memset(view, 0, sizeof(*view));
+
+    if (signal_len == 0 || frame_len == 0 || hop_len == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
     }
 
+    const size_t frames = vv_dsp_get_num_frames(signal_len, frame_len, hop_len, center);
+    // Starts and ends both grow with the frame index, so the frames starting
+    // before the signal, the interior and the frames running past its end are
+    // three consecutive runs
+    size_t head = 0;
+    while (head < frames && frame_start_of(head, frame_len, hop_len, center) < 0) head++;
+    size_t interior_end = head;
+    while (interior_end < frames &&
+           (size_t)frame_start_of(interior_end, frame_len, hop_len, center) + frame_len <= signal_len) {
+        interior_end++;
+    }
+    const size_t edges = frames - (interior_end - head);
+
+    view->signal = signal;
+    view->signal_len = signal_len;
+    view->frame_len = frame_len;
+    view->hop_len = hop_len;
+    view->center = center;
+    view->num_frames = frames;
+    view->interior_first = head;
+    view->interior_count = interior_end - head;
+    if (edges > 0) {
+        view->edges = (vv_dsp_real*)vv_dsp_aligned_malloc(edges * frame_len * sizeof(vv_dsp_real),
+                                                          VV_DSP_SIMD_ALIGN_DEFAULT);
+        if (!view->edges) {
+            memset(view, 0, sizeof(*view));
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+        for (size_t f = 0, row = 0; f < frames; f++) {
+            if (f == head) f = interior_end;
+            if (f >= frames) break;
+            frame_fill(signal, signal_len, view->edges + row * frame_len, frame_len,
+                       frame_start_of(f, frame_len, hop_len, center), center, NULL, k);
+            row++;
+        }
+    }
     return VV_DSP_OK;
 }
 
+void vv_dsp_frame_view_free(vv_dsp_frame_view* view) {
+    if (!view) return;
+    vv_dsp_aligned_free(view->edges);
+    memset(view, 0, sizeof(*view));
+}
+
+const vv_dsp_real* vv_dsp_frame_view_frame(const vv_dsp_frame_view* view, size_t frame_index) {
+    if (!view || frame_index >= view->num_frames) return NULL;
+    const size_t head = view->interior_first;
+    if (frame_index < head) return view->edges + frame_index * view->frame_len;
+    if (frame_index - head < view->interior_count) {
+        return view->signal + frame_start_of(frame_index, view->frame_len, view->hop_len, view->center);
+    }
+    return view->edges + (frame_index - view->interior_count) * view->frame_len;
+}
+
 vv_dsp_status vv_dsp_overlap_add(const vv_dsp_real* frame, vv_dsp_real* output_signal,
                                  size_t output_len, size_t frame_len, size_t hop_len,
                                  size_t frame_index) {
@@ -135,13 +227,34 @@ vv_dsp_status vv_dsp_overlap_add(const vv_dsp_real* frame, vv_dsp_real* output_s
     // Calculate starting position in output signal
     size_t start_pos = frame_index * hop_len;
 
-    // Add frame samples to output signal with bounds checking
-    for (size_t i = 0; i < frame_len; i++) {
-        size_t output_idx = start_pos + i;
-        if (output_idx < output_len) {
-            output_signal[output_idx] += frame[i];
-        }
-        // If output_idx >= output_len, silently ignore (bounds protection)
+    // Add frame samples to output signal; samples past output_len are ignored
+    if (start_pos < output_len) {
+        const size_t n = output_len - start_pos < frame_len ? output_len - start_pos : frame_len;
+        vv_dsp_simd_kernels_get()->add(output_signal + start_pos, frame, output_signal + start_pos, n);
+    }
+
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_overlap_add_frames(const vv_dsp_real* frames, size_t count, size_t frame_len,
+                                        size_t hop_len, const vv_dsp_real* synth_window, vv_dsp_real gain,
+                                        vv_dsp_real* output_signal, size_t output_len) {
+    if (!frames || !output_signal) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    if (output_len == 0 || frame_len == 0 || hop_len == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    // Frames are clipped once against output_len; window and gain are applied
+    // in the accumulating pass
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    for (size_t f = 0; f < count; f++) {
+        if (f > (output_len - 1) / hop_len) break;  // this and later frames start past the end
+        const size_t start = f * hop_len;
+        const size_t n = output_len - start < frame_len ? output_len - start : frame_len;
+        k->mul_acc(frames + f * frame_len, synth_window, gain, output_signal + start, n);
     }
 
     return VV_DSP_OK;
@@ -6,6 +6,8 @@
 #include "vv_dsp/core/nan_policy.h"
 #include <math.h>
 #include <float.h>
+#include <string.h>
+#include "simd_dispatch.h"
 
 // Thread-local storage for the NaN policy
 // For MSVC, use __declspec(thread)
@@ -82,29 +84,25 @@ static inline vv_dsp_status vv_dsp_apply_nan_policy_single(vv_dsp_real* value, v
     }
 }
 
+size_t vv_dsp_find_nonfinite(const vv_dsp_real* data, size_t len) {
+    if (!data) return len;
+    return vv_dsp_simd_kernels_get()->find_nonfinite(data, len);
+}
+
 /**
- * @brief Apply the current NaN/Inf policy to an array in-place
- * @param data Pointer to the array data
- * @param len Number of elements in the array
- * @return VV_DSP_OK on success, VV_DSP_ERROR_NAN_INF if policy is ERROR and NaN/Inf found
+ * @brief Apply a policy in-place, jumping between non-finite values with the vector scan
  */
-vv_dsp_status vv_dsp_apply_nan_policy_inplace(vv_dsp_real* data, size_t len) {
+vv_dsp_status vv_dsp_nan_policy_fixup(vv_dsp_nan_policy_e policy, vv_dsp_real* data, size_t len) {
     if (!data) {
         return VV_DSP_ERROR_NULL_POINTER;
     }
 
-    if (len == 0) {
-        return VV_DSP_OK;
-    }
-
-    vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
-
-    // For PROPAGATE policy, we can skip the entire check
     if (policy == VV_DSP_NAN_POLICY_PROPAGATE) {
         return VV_DSP_OK;
     }
 
-    for (size_t i = 0; i < len; i++) {
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    for (size_t i = k->find_nonfinite(data, len); i < len; i += 1 + k->find_nonfinite(data + i + 1, len - i - 1)) {
         vv_dsp_status status = vv_dsp_apply_nan_policy_single(&data[i], policy);
         if (status != VV_DSP_OK) {
             return status;  // Early return on error
@@ -114,6 +112,20 @@ vv_dsp_status vv_dsp_apply_nan_policy_inplace(vv_dsp_real* data, size_t len) {
     return VV_DSP_OK;
 }
 
+/**
+ * @brief Apply the current NaN/Inf policy to an array in-place
+ * @param data Pointer to the array data
+ * @param len Number of elements in the array
+ * @return VV_DSP_OK on success, VV_DSP_ERROR_NAN_INF if policy is ERROR and NaN/Inf found
+ */
+vv_dsp_status vv_dsp_apply_nan_policy_inplace(vv_dsp_real* data, size_t len) {
+    if (!data) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    return vv_dsp_nan_policy_fixup(vv_dsp_get_nan_policy(), data, len);
+}
+
 /**
  * @brief Check array for NaN/Inf values and apply policy (const version)
  * @param data Pointer to the input array data (const)
@@ -132,59 +144,19 @@ vv_dsp_status vv_dsp_apply_nan_policy_copy(const vv_dsp_real* data, size_t len,
 
     vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
 
-    // For PROPAGATE policy, we can skip processing if output is provided
+    if (output && output != data) {
+        memmove(output, data, len * sizeof(vv_dsp_real));
+    }
     if (policy == VV_DSP_NAN_POLICY_PROPAGATE) {
-        if (output) {
-            // Just copy the data as-is
-            for (size_t i = 0; i < len; i++) {
-                output[i] = data[i];
-            }
-        }
         return VV_DSP_OK;
     }
-
-    for (size_t i = 0; i < len; i++) {
-        vv_dsp_real value = data[i];
-
-        if (isnan(value) || isinf(value)) {
-            switch (policy) {
-                case VV_DSP_NAN_POLICY_IGNORE:
-                    value = (vv_dsp_real)0.0;
-                    break;
-
-                case VV_DSP_NAN_POLICY_ERROR:
-                    return VV_DSP_ERROR_NAN_INF;
-
-                case VV_DSP_NAN_POLICY_CLAMP:
-                    if (isnan(value)) {
-                        value = (vv_dsp_real)0.0;
-                    } else if (isinf(value)) {
-                        if (value > 0) {
-#ifdef VV_DSP_USE_DOUBLE
-                            value = DBL_MAX;
-#else
-                            value = FLT_MAX;
-#endif
-                        } else {
-#ifdef VV_DSP_USE_DOUBLE
-                            value = -DBL_MAX;
-#else
-                            value = -FLT_MAX;
-#endif
-                        }
-                    }
-                    break;
-
-                default:
-                    // Unknown policy, leave value unchanged
-                    break;
-            }
-        }
-
-        if (output) {
-            output[i] = value;
-        }
+    if (output) {
+        return vv_dsp_nan_policy_fixup(policy, output, len);
     }
 
+    // Check only: only ERROR has an observable effect
+    if (policy == VV_DSP_NAN_POLICY_ERROR && vv_dsp_find_nonfinite(data, len) < len) {
+        return VV_DSP_ERROR_NAN_INF;
+    }
     return VV_DSP_OK;
 }
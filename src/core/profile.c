@@ -0,0 +1,299 @@
+/**
+ * @file profile.c
+ * @brief Per-thread entry-point counters, snapshots and trace export
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "vv_dsp/core/profile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define PR_TLS __declspec(thread)
+typedef SRWLOCK pr_mutex;
+#define PR_MUTEX_INIT SRWLOCK_INIT
+#define PR_LOCK(m) AcquireSRWLockExclusive(m)
+#define PR_UNLOCK(m) ReleaseSRWLockExclusive(m)
+// 64-bit loads and stores are single instructions on the 64-bit targets
+#define PR_LOAD(p) (*(volatile uint64_t*)(p))
+#define PR_STORE(p, v) (*(volatile uint64_t*)(p) = (v))
+#define PR_FETCH_ADD(p, v) ((size_t)InterlockedExchangeAddSizeT((p), (v)))
+#define PR_LOAD_SIZE(p) ((size_t)InterlockedExchangeAddSizeT((p), 0))
+#define PR_READY_STORE(p) InterlockedExchange((volatile LONG*)(p), 1)
+#define PR_READY_LOAD(p) InterlockedCompareExchange((volatile LONG*)(p), 0, 0)
+#else
+#include <pthread.h>
+#define PR_TLS __thread
+typedef pthread_mutex_t pr_mutex;
+#define PR_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define PR_LOCK(m) pthread_mutex_lock(m)
+#define PR_UNLOCK(m) pthread_mutex_unlock(m)
+#define PR_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PR_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define PR_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define PR_LOAD_SIZE(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PR_READY_STORE(p) __atomic_store_n((p), 1, __ATOMIC_RELEASE)
+#define PR_READY_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#endif
+
+#define PR_POINTS VV_DSP_PROFILE_POINT_COUNT
+
+static const char* const g_point_names[PR_POINTS] = {
+    "fft_execute", "stft_process", "fir_apply", "iir_apply", "resample", "mfcc_process",
+};
+
+typedef struct pr_counters {
+    uint64_t calls[PR_POINTS];
+    uint64_t samples[PR_POINTS];
+    uint64_t ns[PR_POINTS];
+    uint64_t allocations[PR_POINTS];
+} pr_counters;
+
+// Counters of one thread: only that thread writes them, the snapshot reads them.
+// Blocks come from malloc(), not the library allocator, so they neither show in
+// its counters nor trip the real-time checks on a thread's first profiled call.
+typedef struct pr_thread {
+    pr_counters c;
+    uint32_t id;
+    struct pr_thread* prev;
+    struct pr_thread* next;
+} pr_thread;
+
+static pr_mutex g_mutex = PR_MUTEX_INIT;
+static pr_thread* g_threads;      // live threads, under g_mutex
+static pr_counters g_retired;     // totals of exited threads, under g_mutex
+static uint32_t g_next_id;        // under g_mutex
+static PR_TLS pr_thread* t_thread;
+static PR_TLS size_t t_allocations;
+
+static vv_dsp_profile_hook_fn g_hook;
+static void* g_hook_user;
+
+typedef struct pr_slot {
+    vv_dsp_profile_event event;
+    int ready;
+} pr_slot;
+
+static pr_slot* g_trace;
+static size_t g_trace_cap, g_trace_next, g_trace_dropped;
+
+static uint64_t pr_now_ns(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    const uint64_t q = (uint64_t)c.QuadPart, hz = (uint64_t)f.QuadPart;
+    return q / hz * 1000000000ull + q % hz * 1000000000ull / hz;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void pr_add_counters(pr_counters* dst, const pr_counters* src) {
+    for (size_t k = 0; k < PR_POINTS; ++k) {
+        dst->calls[k] += PR_LOAD(&src->calls[k]);
+        dst->samples[k] += PR_LOAD(&src->samples[k]);
+        dst->ns[k] += PR_LOAD(&src->ns[k]);
+        dst->allocations[k] += PR_LOAD(&src->allocations[k]);
+    }
+}
+
+// Thread exit: fold the counters into the retired totals
+static void pr_thread_exit(void* arg) {
+    pr_thread* t = (pr_thread*)arg;
+    if (!t) return;
+    PR_LOCK(&g_mutex);
+    pr_add_counters(&g_retired, &t->c);
+    if (t->prev) t->prev->next = t->next;
+    else g_threads = t->next;
+    if (t->next) t->next->prev = t->prev;
+    PR_UNLOCK(&g_mutex);
+    free(t);
+    t_thread = NULL;
+}
+
+#if defined(_WIN32)
+static DWORD g_pr_fls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_pr_once = INIT_ONCE_STATIC_INIT;
+static void NTAPI pr_fls_exit(PVOID arg) { pr_thread_exit(arg); }
+static BOOL CALLBACK pr_key_init(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once; (void)param; (void)ctx;
+    g_pr_fls = FlsAlloc(pr_fls_exit);
+    return TRUE;
+}
+static int pr_register_exit(pr_thread* t) {
+    InitOnceExecuteOnce(&g_pr_once, pr_key_init, NULL, NULL);
+    return g_pr_fls != FLS_OUT_OF_INDEXES && FlsSetValue(g_pr_fls, t);
+}
+#else
+static pthread_key_t g_pr_key;
+static int g_pr_key_ok;
+static pthread_once_t g_pr_once = PTHREAD_ONCE_INIT;
+static void pr_key_init(void) {
+    g_pr_key_ok = pthread_key_create(&g_pr_key, pr_thread_exit) == 0;
+}
+static int pr_register_exit(pr_thread* t) {
+    pthread_once(&g_pr_once, pr_key_init);
+    return g_pr_key_ok && pthread_setspecific(g_pr_key, t) == 0;
+}
+#endif
+
+// The calling thread's counters, created on first use; NULL if that fails
+static pr_thread* pr_get(void) {
+    pr_thread* t = t_thread;
+    if (t) return t;
+    t = (pr_thread*)calloc(1, sizeof(pr_thread));
+    if (!t) return NULL;
+    if (!pr_register_exit(t)) {
+        free(t);
+        return NULL;
+    }
+    PR_LOCK(&g_mutex);
+    t->id = ++g_next_id;
+    t->next = g_threads;
+    if (g_threads) g_threads->prev = t;
+    g_threads = t;
+    PR_UNLOCK(&g_mutex);
+    t_thread = t;
+    return t;
+}
+
+int vv_dsp_profile_enabled(void) {
+#if defined(VV_DSP_ENABLE_PROFILING)
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+const char* vv_dsp_profile_point_name(vv_dsp_profile_point point) {
+    return ((unsigned)point < PR_POINTS) ? g_point_names[point] : NULL;
+}
+
+vv_dsp_status vv_dsp_profile_snapshot(vv_dsp_profile_report* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    pr_counters sum;
+    memset(&sum, 0, sizeof(sum));
+    PR_LOCK(&g_mutex);
+    pr_add_counters(&sum, &g_retired);
+    for (const pr_thread* t = g_threads; t; t = t->next) pr_add_counters(&sum, &t->c);
+    PR_UNLOCK(&g_mutex);
+    for (size_t k = 0; k < PR_POINTS; ++k) {
+        vv_dsp_profile_entry* e = &out->entries[k];
+        e->name = g_point_names[k];
+        e->calls = sum.calls[k];
+        e->samples = sum.samples[k];
+        e->ns = sum.ns[k];
+        e->allocations = sum.allocations[k];
+    }
+    return VV_DSP_OK;
+}
+
+void vv_dsp_profile_reset(void) {
+    PR_LOCK(&g_mutex);
+    memset(&g_retired, 0, sizeof(g_retired));
+    for (pr_thread* t = g_threads; t; t = t->next) {
+        for (size_t k = 0; k < PR_POINTS; ++k) {
+            PR_STORE(&t->c.calls[k], 0);
+            PR_STORE(&t->c.samples[k], 0);
+            PR_STORE(&t->c.ns[k], 0);
+            PR_STORE(&t->c.allocations[k], 0);
+        }
+    }
+    PR_UNLOCK(&g_mutex);
+}
+
+void vv_dsp_profile_set_hook(vv_dsp_profile_hook_fn hook, void* user) {
+    g_hook = hook;
+    g_hook_user = hook ? user : NULL;
+}
+
+vv_dsp_status vv_dsp_profile_trace_start(size_t max_events) {
+    if (max_events == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_profile_trace_stop();
+    if (max_events > (size_t)-1 / sizeof(pr_slot)) return VV_DSP_ERROR_INTERNAL;
+    pr_slot* slots = (pr_slot*)calloc(max_events, sizeof(pr_slot));
+    if (!slots) return VV_DSP_ERROR_INTERNAL;
+    g_trace_next = 0;
+    g_trace_dropped = 0;
+    g_trace_cap = max_events;
+    g_trace = slots;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_profile_trace_stop(void) {
+    free(g_trace);
+    g_trace = NULL;
+    g_trace_cap = 0;
+    g_trace_next = 0;
+}
+
+vv_dsp_status vv_dsp_profile_trace_write(FILE* file) {
+    if (!file) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t used = g_trace ? PR_LOAD_SIZE(&g_trace_next) : 0;
+    const size_t n = used < g_trace_cap ? used : g_trace_cap;
+    int first = 1;
+    fprintf(file, "{\"traceEvents\": [");
+    for (size_t i = 0; i < n; ++i) {
+        if (!PR_READY_LOAD(&g_trace[i].ready)) continue;
+        const vv_dsp_profile_event* e = &g_trace[i].event;
+        fprintf(file,
+                "%s\n  {\"name\": \"%s\", \"cat\": \"vv-dsp\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+                "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"samples\": %llu}}",
+                first ? "" : ",", g_point_names[e->point], (unsigned)e->thread, (double)e->start_ns / 1000.0,
+                (double)e->duration_ns / 1000.0, (unsigned long long)e->samples);
+        first = 0;
+    }
+    fprintf(file, "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": %llu}}\n",
+            (unsigned long long)(g_trace ? PR_LOAD_SIZE(&g_trace_dropped) : 0));
+    return ferror(file) ? VV_DSP_ERROR_INTERNAL : VV_DSP_OK;
+}
+
+void vv_dsp_profile_note_allocation(void) {
+    t_allocations++;
+}
+
+void vv_dsp_profile_begin(vv_dsp_profile_scope* scope, vv_dsp_profile_point point) {
+    (void)pr_get();
+    scope->point = point;
+    scope->allocations = t_allocations;
+    scope->start_ns = pr_now_ns();
+}
+
+void vv_dsp_profile_end(const vv_dsp_profile_scope* scope, size_t samples) {
+    const uint64_t duration = pr_now_ns() - scope->start_ns;
+    pr_thread* t = t_thread;
+    const unsigned k = (unsigned)scope->point;
+    if (!t || k >= PR_POINTS) return;
+
+    pr_counters* c = &t->c;
+    PR_STORE(&c->calls[k], PR_LOAD(&c->calls[k]) + 1);
+    PR_STORE(&c->samples[k], PR_LOAD(&c->samples[k]) + (uint64_t)samples);
+    PR_STORE(&c->ns[k], PR_LOAD(&c->ns[k]) + duration);
+    PR_STORE(&c->allocations[k], PR_LOAD(&c->allocations[k]) + (uint64_t)(t_allocations - scope->allocations));
+
+    if (!g_trace && !g_hook) return;
+    vv_dsp_profile_event ev;
+    ev.point = scope->point;
+    ev.thread = t->id;
+    ev.start_ns = scope->start_ns;
+    ev.duration_ns = duration;
+    ev.samples = (uint64_t)samples;
+    if (g_trace) {
+        const size_t slot = PR_FETCH_ADD(&g_trace_next, 1);
+        if (slot < g_trace_cap) {
+            g_trace[slot].event = ev;
+            PR_READY_STORE(&g_trace[slot].ready);
+        } else {
+            (void)PR_FETCH_ADD(&g_trace_dropped, 1);
+        }
+    }
+    if (g_hook) g_hook(&ev, g_hook_user);
+}
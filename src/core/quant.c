@@ -0,0 +1,75 @@
+/**
+ * @file quant.c
+ * @brief Storage type entry points over the dispatched kernels
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "vv_dsp/core/quant.h"
+#include "simd_dispatch.h"
+
+size_t vv_dsp_storage_bytes(vv_dsp_storage_type type) {
+    switch (type) {
+    case VV_DSP_STORAGE_REAL: return sizeof(vv_dsp_real);
+    case VV_DSP_STORAGE_F16:
+    case VV_DSP_STORAGE_BF16: return 2;
+    case VV_DSP_STORAGE_U8:
+    case VV_DSP_STORAGE_U8_DB: return 1;
+    }
+    return 0;
+}
+
+vv_dsp_status vv_dsp_quant_init(vv_dsp_quant* q, vv_dsp_storage_type type, vv_dsp_real lo, vv_dsp_real hi) {
+    if (!q) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_storage_bytes(type)) return VV_DSP_ERROR_UNSUPPORTED;
+    const int u8 = type == VV_DSP_STORAGE_U8 || type == VV_DSP_STORAGE_U8_DB;
+    if (u8 && !(isfinite((double)lo) && isfinite((double)hi) && lo < hi)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    memset(q, 0, sizeof(*q));
+    q->type = type;
+    q->lo = lo;
+    q->hi = hi;
+    if (!u8) return VV_DSP_OK;
+
+    // Codes are spaced (hi - lo) / 255 apart; U8_DB encodes ln v, so its range is
+    // converted from dB to nepers of power
+    const double step = ((double)hi - (double)lo) / 255.0;
+    const double to_ln = (type == VV_DSP_STORAGE_U8_DB) ? 0.230258509299404568 : 1.0;  // ln(10) / 10
+    q->offset = (float)((double)lo * to_ln);
+    q->scale = (float)(1.0 / (step * to_ln));
+    for (int k = 0; k < 256; ++k) {
+        const double v = (double)lo + step * k;
+        q->lut[k] = (vv_dsp_real)((type == VV_DSP_STORAGE_U8_DB) ? pow(10.0, v / 10.0) : v);
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_quant_encode(const vv_dsp_quant* q, const vv_dsp_real* x, size_t n, void* dst) {
+    if (!q || (n && (!x || !dst))) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_storage_bytes(q->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (!n) return VV_DSP_OK;
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    switch (q->type) {
+    case VV_DSP_STORAGE_REAL: memmove(dst, x, n * sizeof(vv_dsp_real)); break;
+    case VV_DSP_STORAGE_F16: k->half_encode(x, n, 0, (uint8_t*)dst); break;
+    case VV_DSP_STORAGE_BF16: k->half_encode(x, n, 1, (uint8_t*)dst); break;
+    case VV_DSP_STORAGE_U8: k->u8_encode(x, n, q->offset, q->scale, 0, (uint8_t*)dst); break;
+    case VV_DSP_STORAGE_U8_DB: k->u8_encode(x, n, q->offset, q->scale, 1, (uint8_t*)dst); break;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_quant_decode(const vv_dsp_quant* q, const void* src, size_t n, vv_dsp_real* out) {
+    if (!q || (n && (!src || !out))) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_storage_bytes(q->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (!n) return VV_DSP_OK;
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    switch (q->type) {
+    case VV_DSP_STORAGE_REAL: memmove(out, src, n * sizeof(vv_dsp_real)); break;
+    case VV_DSP_STORAGE_F16: k->half_decode((const uint8_t*)src, n, 0, out); break;
+    case VV_DSP_STORAGE_BF16: k->half_decode((const uint8_t*)src, n, 1, out); break;
+    case VV_DSP_STORAGE_U8:
+    case VV_DSP_STORAGE_U8_DB: k->u8_decode((const uint8_t*)src, n, q->lut, out); break;
+    }
+    return VV_DSP_OK;
+}
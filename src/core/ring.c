@@ -0,0 +1,256 @@
+/**
+ * @file ring.c
+ * @brief SPSC and MPSC ring buffers of fixed-size records
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "vv_dsp/core/ring.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define RING_LOAD(p) InterlockedExchangeAddSizeT((p), 0)
+#define RING_STORE(p, v) ((void)InterlockedExchangePointer((PVOID volatile*)(p), (PVOID)(v)))
+#define RING_CAS(p, expected, desired) \
+    (InterlockedCompareExchangePointer((PVOID volatile*)(p), (PVOID)(desired), (PVOID)(expected)) == (PVOID)(expected))
+#else
+#define RING_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define RING_CAS(p, expected, desired) \
+    __atomic_compare_exchange_n((p), &(expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#endif
+
+#define RING_LINE 64
+
+// One side of the ring on a cache line of its own: the next position it writes
+// (producer) or reads (consumer), and its last view of the other side's position
+typedef struct {
+    size_t position;
+    size_t cached;
+    unsigned char pad[RING_LINE - 2 * sizeof(size_t)];
+} ring_cursor;
+
+// Positions grow without bound; record p lives in slot p & mask. In MPSC mode
+// producer.position is the claim counter shared by all producers and slot s
+// holds a published record at position p once published[s] == p + 1.
+struct vv_dsp_ring {
+    ring_cursor producer;
+    ring_cursor consumer;
+    vv_dsp_ring_mode mode;
+    size_t record_size;
+    size_t capacity;
+    size_t mask;
+    unsigned char* data;
+    size_t* published;  // MPSC only
+};
+
+static size_t ring_min(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+vv_dsp_status vv_dsp_ring_create(vv_dsp_ring_mode mode, size_t record_size, size_t capacity,
+                                 vv_dsp_ring** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (mode != VV_DSP_RING_SPSC && mode != VV_DSP_RING_MPSC) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (record_size == 0 || capacity == 0 || capacity > SIZE_MAX / 4) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    if (cap > SIZE_MAX / record_size) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_ring* ring = (vv_dsp_ring*)vv_dsp_aligned_malloc(sizeof(*ring), RING_LINE);
+    if (!ring) return VV_DSP_ERROR_INTERNAL;
+    memset(ring, 0, sizeof(*ring));
+    ring->mode = mode;
+    ring->record_size = record_size;
+    ring->capacity = cap;
+    ring->mask = cap - 1;
+    ring->data = (unsigned char*)vv_dsp_aligned_malloc(cap * record_size, VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (mode == VV_DSP_RING_MPSC) ring->published = (size_t*)vv_dsp_calloc(cap, sizeof(size_t));
+    if (!ring->data || (mode == VV_DSP_RING_MPSC && !ring->published)) {
+        vv_dsp_ring_destroy(ring);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = ring;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_ring_destroy(vv_dsp_ring* ring) {
+    if (!ring) return;
+    vv_dsp_aligned_free(ring->data);
+    vv_dsp_free(ring->published);
+    vv_dsp_aligned_free(ring);
+}
+
+size_t vv_dsp_ring_capacity(const vv_dsp_ring* ring) {
+    return ring ? ring->capacity : 0;
+}
+
+size_t vv_dsp_ring_record_size(const vv_dsp_ring* ring) {
+    return ring ? ring->record_size : 0;
+}
+
+size_t vv_dsp_ring_size(const vv_dsp_ring* ring) {
+    if (!ring) return 0;
+    vv_dsp_ring* r = (vv_dsp_ring*)ring;
+    // Consumer first: the producer position read after it is never behind it
+    const size_t head = RING_LOAD(&r->consumer.position);
+    const size_t tail = RING_LOAD(&r->producer.position);
+    return tail - head;
+}
+
+size_t vv_dsp_ring_space(const vv_dsp_ring* ring) {
+    return ring ? ring->capacity - vv_dsp_ring_size(ring) : 0;
+}
+
+static void* ring_slot(const vv_dsp_ring* ring, size_t position) {
+    return ring->data + (position & ring->mask) * ring->record_size;
+}
+
+static void ring_region(const vv_dsp_ring* ring, size_t position, size_t count, vv_dsp_ring_region* out) {
+    out->data = ring_slot(ring, position);
+    out->count = count;
+    out->position = position;
+    out->claimed = count;
+}
+
+// MPSC: claim up to count records at the claim counter (when contiguous, not past
+// the end of the buffer); all_or_nothing claims count or none
+static size_t ring_claim(vv_dsp_ring* ring, size_t count, int contiguous, int all_or_nothing, size_t* out_position) {
+    size_t tail = RING_LOAD(&ring->producer.position);
+    for (;;) {
+        const size_t head = RING_LOAD(&ring->consumer.position);
+        const size_t used = tail - head;
+        if (used > ring->capacity) {
+            // tail is stale and the consumer has passed it
+            tail = RING_LOAD(&ring->producer.position);
+            continue;
+        }
+        size_t n = ring_min(count, ring->capacity - used);
+        if (contiguous) n = ring_min(n, ring->capacity - (tail & ring->mask));
+        if (n == 0 || (all_or_nothing && n < count)) return 0;
+        size_t expected = tail;
+        if (RING_CAS(&ring->producer.position, expected, tail + n)) {
+            *out_position = tail;
+            return n;
+        }
+        tail = RING_LOAD(&ring->producer.position);
+    }
+}
+
+static void ring_publish(vv_dsp_ring* ring, size_t position, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        RING_STORE(&ring->published[(position + i) & ring->mask], position + i + 1);
+    }
+}
+
+vv_dsp_status vv_dsp_ring_begin_write(vv_dsp_ring* ring, size_t max_records, vv_dsp_ring_region* out) {
+    if (!ring || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (ring->mode == VV_DSP_RING_MPSC) {
+        size_t position = 0;
+        const size_t n = ring_claim(ring, max_records, 1, 0, &position);
+        ring_region(ring, position, n, out);
+        return VV_DSP_OK;
+    }
+    const size_t tail = ring->producer.position;
+    const size_t want = ring_min(max_records, ring->capacity - (tail & ring->mask));
+    size_t space = ring->capacity - (tail - ring->producer.cached);
+    if (space < want) {
+        ring->producer.cached = RING_LOAD(&ring->consumer.position);
+        space = ring->capacity - (tail - ring->producer.cached);
+    }
+    ring_region(ring, tail, ring_min(want, space), out);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_ring_end_write(vv_dsp_ring* ring, const vv_dsp_ring_region* region) {
+    if (!ring || !region) return VV_DSP_ERROR_NULL_POINTER;
+    if (region->count > region->claimed) return VV_DSP_ERROR_INVALID_SIZE;
+    if (ring->mode == VV_DSP_RING_MPSC) {
+        if (region->count != region->claimed) return VV_DSP_ERROR_INVALID_SIZE;
+        ring_publish(ring, region->position, region->count);
+        return VV_DSP_OK;
+    }
+    RING_STORE(&ring->producer.position, region->position + region->count);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_ring_begin_read(vv_dsp_ring* ring, size_t max_records, vv_dsp_ring_region* out) {
+    if (!ring || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t head = ring->consumer.position;
+    const size_t want = ring_min(max_records, ring->capacity - (head & ring->mask));
+    size_t n = 0;
+    if (ring->mode == VV_DSP_RING_MPSC) {
+        while (n < want && RING_LOAD(&ring->published[(head + n) & ring->mask]) == head + n + 1) n++;
+    } else {
+        size_t avail = ring->consumer.cached - head;
+        if (avail < want) {
+            ring->consumer.cached = RING_LOAD(&ring->producer.position);
+            avail = ring->consumer.cached - head;
+        }
+        n = ring_min(want, avail);
+    }
+    ring_region(ring, head, n, out);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_ring_end_read(vv_dsp_ring* ring, const vv_dsp_ring_region* region) {
+    if (!ring || !region) return VV_DSP_ERROR_NULL_POINTER;
+    if (region->count > region->claimed) return VV_DSP_ERROR_INVALID_SIZE;
+    RING_STORE(&ring->consumer.position, region->position + region->count);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_ring_write(vv_dsp_ring* ring, const void* records, size_t count, size_t* out_written) {
+    if (!ring || !out_written || (!records && count)) return VV_DSP_ERROR_NULL_POINTER;
+    *out_written = 0;
+    if (count == 0) return VV_DSP_OK;
+    const unsigned char* src = (const unsigned char*)records;
+    if (ring->mode == VV_DSP_RING_MPSC) {
+        if (count > ring->capacity) return VV_DSP_ERROR_INVALID_SIZE;
+        size_t position = 0;
+        if (!ring_claim(ring, count, 0, 1, &position)) return VV_DSP_OK;
+        // The claim may wrap: copy up to the end of the buffer, then from its start
+        const size_t first = ring_min(count, ring->capacity - (position & ring->mask));
+        memcpy(ring_slot(ring, position), src, first * ring->record_size);
+        memcpy(ring_slot(ring, position + first), src + first * ring->record_size,
+               (count - first) * ring->record_size);
+        ring_publish(ring, position, count);
+        *out_written = count;
+        return VV_DSP_OK;
+    }
+    size_t done = 0;
+    for (int pass = 0; pass < 2 && done < count; ++pass) {
+        vv_dsp_ring_region region;
+        if (vv_dsp_ring_begin_write(ring, count - done, &region) != VV_DSP_OK || region.count == 0) break;
+        memcpy(region.data, src + done * ring->record_size, region.count * ring->record_size);
+        if (vv_dsp_ring_end_write(ring, &region) != VV_DSP_OK) break;
+        done += region.count;
+    }
+    *out_written = done;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_ring_read(vv_dsp_ring* ring, void* records, size_t max_records, size_t* out_read) {
+    if (!ring || !out_read || (!records && max_records)) return VV_DSP_ERROR_NULL_POINTER;
+    unsigned char* dst = (unsigned char*)records;
+    size_t done = 0;
+    for (int pass = 0; pass < 2 && done < max_records; ++pass) {
+        vv_dsp_ring_region region;
+        if (vv_dsp_ring_begin_read(ring, max_records - done, &region) != VV_DSP_OK || region.count == 0) break;
+        memcpy(dst + done * ring->record_size, region.data, region.count * ring->record_size);
+        if (vv_dsp_ring_end_read(ring, &region) != VV_DSP_OK) break;
+        done += region.count;
+    }
+    *out_read = done;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_ring_reset(vv_dsp_ring* ring) {
+    if (!ring) return;
+    memset(&ring->producer, 0, sizeof(ring->producer));
+    memset(&ring->consumer, 0, sizeof(ring->consumer));
+    if (ring->published) memset(ring->published, 0, ring->capacity * sizeof(size_t));
+}
@@ -1,20 +1,122 @@
 /**
  * @file simd_core.c
  * @brief SIMD optimized DSP functions implementation
+ *
+ * Argument checks live here; the loops run through the runtime dispatch table
+ * (simd_dispatch.h), which picks the widest variant the host supports.
  */
 
 #include "../../include/vv_dsp/core/simd_core.h"
 #include "../../include/vv_dsp/core/simd_utils.h"
+#include "../../include/vv_dsp/core/threadpool.h"
+#include "../../include/vv_dsp/core/alloc.h"
+#include "simd_dispatch.h"
 #include <math.h>
 
-// Fallback implementations (always available)
+static vv_dsp_reduction_mode g_reduction_mode = VV_DSP_REDUCTION_FAST;
+
+vv_dsp_status vv_dsp_set_reduction_mode(vv_dsp_reduction_mode mode) {
+    if ((int)mode < (int)VV_DSP_REDUCTION_FAST || (int)mode > (int)VV_DSP_REDUCTION_COMPENSATED) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    g_reduction_mode = mode;
+    return VV_DSP_OK;
+}
+
+vv_dsp_reduction_mode vv_dsp_get_reduction_mode(void) {
+    return g_reduction_mode;
+}
+
+// PAIRWISE / COMPENSATED: each block of VV_DSP_REDUCTION_BLOCK samples gives a
+// (hi, lo) leaf, and the leaves meet in a tree that halves the block range at
+// every node. Neither depends on who computed a leaf, hence on the thread count.
+typedef struct {
+    vv_dsp_real hi, lo;
+} reduce_pair;
+
+typedef struct {
+    const vv_dsp_real* x;
+    size_t n;
+    vv_dsp_real mean;
+    int sq;              // sum (x - mean)^2 rather than x
+    int comp;            // Kahan lanes and TwoSum nodes
+    reduce_pair* leaves; // precomputed leaves (parallel path), or NULL
+} reduce_ctx;
+
+static size_t reduce_blocks(size_t n) {
+    return n ? (n + VV_DSP_REDUCTION_BLOCK - 1) / VV_DSP_REDUCTION_BLOCK : 1;
+}
+
+static reduce_pair reduce_leaf(const reduce_ctx* c, size_t b) {
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    const vv_dsp_real* x = c->x + b * VV_DSP_REDUCTION_BLOCK;
+    const size_t rest = c->n - b * VV_DSP_REDUCTION_BLOCK;
+    const size_t len = rest < VV_DSP_REDUCTION_BLOCK ? rest : VV_DSP_REDUCTION_BLOCK;
+    reduce_pair p = {0, 0};
+    if (c->comp) {
+        p.hi = c->sq ? k->sum_sq_dev_comp(x, len, c->mean, &p.lo) : k->sum_comp(x, len, &p.lo);
+    } else {
+        p.hi = c->sq ? k->sum_sq_dev(x, len, c->mean) : k->sum(x, len);
+    }
+    return p;
+}
+
+static reduce_pair reduce_tree(const reduce_ctx* c, size_t lo, size_t hi) {
+    if (hi - lo == 1) return c->leaves ? c->leaves[lo] : reduce_leaf(c, lo);
+    const size_t mid = lo + (hi - lo) / 2;
+    const reduce_pair a = reduce_tree(c, lo, mid);
+    const reduce_pair b = reduce_tree(c, mid, hi);
+    reduce_pair r;
+    r.hi = a.hi + b.hi;
+    r.lo = 0;
+    if (c->comp) {
+        const vv_dsp_real bp = r.hi - a.hi;
+        r.lo = a.lo + b.lo + ((a.hi - (r.hi - bp)) + (b.hi - bp));
+    }
+    return r;
+}
+
+static void reduce_range(void* ctx, size_t begin, size_t end, size_t worker) {
+    (void)worker;
+    const reduce_ctx* c = (const reduce_ctx*)ctx;
+    for (size_t b = begin; b < end; ++b) c->leaves[b] = reduce_leaf(c, b);
+}
+
+static vv_dsp_real reduce_run(const vv_dsp_real* x, size_t n, vv_dsp_real mean, int sq, int comp,
+                              size_t num_threads) {
+    reduce_ctx c = {x, n, mean, sq, comp, NULL};
+    const size_t nb = reduce_blocks(n);
+    if (nb > 1 && num_threads > 1) {
+        c.leaves = (reduce_pair*)vv_dsp_malloc(nb * sizeof(reduce_pair));
+        const size_t grain = (nb + num_threads - 1) / num_threads;
+        if (c.leaves && vv_dsp_threadpool_parallel_for(NULL, nb, grain, reduce_range, &c) == VV_DSP_OK) {
+            const reduce_pair r = reduce_tree(&c, 0, nb);
+            vv_dsp_free(c.leaves);
+            return r.hi + r.lo;
+        }
+        // no memory or no pool: the serial tree gives the same result
+        vv_dsp_free(c.leaves);
+        c.leaves = NULL;
+    }
+    const reduce_pair r = reduce_tree(&c, 0, nb);
+    return r.hi + r.lo;
+}
+
+// Sum of x (sq = 0) or of (x - mean)^2 in the current mode
+static vv_dsp_real reduce_mode(const vv_dsp_real* x, size_t n, vv_dsp_real mean, int sq) {
+    const vv_dsp_reduction_mode mode = g_reduction_mode;
+    if (mode == VV_DSP_REDUCTION_FAST) {
+        const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+        return sq ? k->sum_sq_dev(x, n, mean) : k->sum(x, n);
+    }
+    return reduce_run(x, n, mean, sq, mode == VV_DSP_REDUCTION_COMPENSATED, 1);
+}
+
 vv_dsp_status vv_dsp_add_real_simd(const vv_dsp_real* a, const vv_dsp_real* b,
                                    vv_dsp_real* out, size_t n) {
     if (!a || !b || !out) return VV_DSP_ERROR_NULL_POINTER;
 
-    for (size_t i = 0; i < n; i++) {
-        out[i] = a[i] + b[i];
-    }
+    vv_dsp_simd_kernels_get()->add(a, b, out, n);
     return VV_DSP_OK;
 }
 
@@ -22,20 +124,14 @@ vv_dsp_status vv_dsp_mul_real_simd(const vv_dsp_real* a, const vv_dsp_real* b,
                                    vv_dsp_real* out, size_t n) {
     if (!a || !b || !out) return VV_DSP_ERROR_NULL_POINTER;
 
-    for (size_t i = 0; i < n; i++) {
-        out[i] = a[i] * b[i];
-    }
+    vv_dsp_simd_kernels_get()->mul(a, b, out, n);
     return VV_DSP_OK;
 }
 
 vv_dsp_status vv_dsp_sum_optimized(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
     if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
 
-    vv_dsp_real sum = 0.0f;
-    for (size_t i = 0; i < n; i++) {
-        sum += x[i];
-    }
-    *out = sum;
+    *out = reduce_mode(x, n, 0, 0);
     return VV_DSP_OK;
 }
 
@@ -46,10 +142,7 @@ vv_dsp_status vv_dsp_rms_optimized(const vv_dsp_real* x, size_t n, vv_dsp_real*
         return VV_DSP_OK;
     }
 
-    vv_dsp_real sum_sq = 0.0f;
-    for (size_t i = 0; i < n; i++) {
-        sum_sq += x[i] * x[i];
-    }
+    const vv_dsp_real sum_sq = reduce_mode(x, n, 0, 1);
     *out = sqrtf(sum_sq / (vv_dsp_real)n);
     return VV_DSP_OK;
 }
@@ -91,11 +184,7 @@ vv_dsp_status vv_dsp_variance_optimized(const vv_dsp_real* x, size_t n, vv_dsp_r
     vv_dsp_status status = vv_dsp_mean_optimized(x, n, &mean);
     if (status != VV_DSP_OK) return status;
 
-    vv_dsp_real sum_sq_dev = 0.0f;
-    for (size_t i = 0; i < n; i++) {
-        vv_dsp_real diff = x[i] - mean;
-        sum_sq_dev += diff * diff;
-    }
+    const vv_dsp_real sum_sq_dev = reduce_mode(x, n, mean, 1);
 
     *out = sum_sq_dev / (vv_dsp_real)(n - 1);
     return VV_DSP_OK;
@@ -109,16 +198,35 @@ vv_dsp_status vv_dsp_population_variance_optimized(const vv_dsp_real* x, size_t
     vv_dsp_status status = vv_dsp_mean_optimized(x, n, &mean);
     if (status != VV_DSP_OK) return status;
 
-    vv_dsp_real sum_sq_dev = 0.0f;
-    for (size_t i = 0; i < n; i++) {
-        vv_dsp_real diff = x[i] - mean;
-        sum_sq_dev += diff * diff;
-    }
+    const vv_dsp_real sum_sq_dev = reduce_mode(x, n, mean, 1);
 
     *out = sum_sq_dev / (vv_dsp_real)n;
     return VV_DSP_OK;
 }
 
+static size_t reduce_workers(size_t num_threads) {
+    return num_threads ? num_threads : vv_dsp_threadpool_num_threads(vv_dsp_threadpool_get_default());
+}
+
+vv_dsp_status vv_dsp_sum_parallel(const vv_dsp_real* x, size_t n, vv_dsp_real* out, size_t num_threads) {
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    const int comp = g_reduction_mode == VV_DSP_REDUCTION_COMPENSATED;
+    *out = reduce_run(x, n, 0, 0, comp, reduce_workers(num_threads));
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_variance_parallel(const vv_dsp_real* x, size_t n, vv_dsp_real* out, size_t num_threads) {
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n <= 1) return VV_DSP_ERROR_INVALID_SIZE;
+
+    const int comp = g_reduction_mode == VV_DSP_REDUCTION_COMPENSATED;
+    const size_t workers = reduce_workers(num_threads);
+    const vv_dsp_real mean = reduce_run(x, n, 0, 0, comp, workers) / (vv_dsp_real)n;
+    *out = reduce_run(x, n, mean, 1, comp, workers) / (vv_dsp_real)(n - 1);
+    return VV_DSP_OK;
+}
+
 vv_dsp_status vv_dsp_stddev_optimized(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
     if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
 
@@ -140,3 +248,17 @@ vv_dsp_status vv_dsp_population_stddev_optimized(const vv_dsp_real* x, size_t n,
     *out = sqrtf(variance);
     return VV_DSP_OK;
 }
+
+vv_dsp_status vv_dsp_log_real_fast(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    vv_dsp_simd_kernels_get()->log(x, out, n, 0);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_exp_real_fast(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    vv_dsp_simd_kernels_get()->exp(x, out, n, 0);
+    return VV_DSP_OK;
+}
@@ -0,0 +1,133 @@
+/*
+This file is part of vv-dsp
+
+Runtime CPU feature detection and selection of the core kernel table. x86 reads
+cpuid and checks with xgetbv that the OS saves the YMM / ZMM state; 32-bit ARM
+Linux reads HWCAP_NEON. The chosen table is published once through an atomic
+pointer, so concurrent first calls agree on it.
+*/
+
+#include <stdint.h>
+#include "simd_dispatch.h"
+
+#if defined(VV_DSP_DISPATCH_AVX2) || defined(VV_DSP_DISPATCH_AVX512)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#    include <immintrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+#if defined(VV_DSP_DISPATCH_NEON) && defined(__linux__)
+#  include <sys/auxv.h>
+#  define SD_HWCAP_NEON (1ul << 12)
+#endif
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define SD_LOAD(p) InterlockedCompareExchangePointer((PVOID volatile*)(p), NULL, NULL)
+#define SD_STORE(p, v) InterlockedExchangePointer((PVOID volatile*)(p), (PVOID)(v))
+#define SD_PUBLISH(p, v) InterlockedCompareExchangePointer((PVOID volatile*)(p), (PVOID)(v), NULL)
+#else
+#define SD_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SD_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+static const vv_dsp_simd_kernels* sd_publish(const vv_dsp_simd_kernels** p, const vv_dsp_simd_kernels* v) {
+    const vv_dsp_simd_kernels* expected = NULL;
+    __atomic_compare_exchange_n(p, &expected, v, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return expected;  // NULL if v was published, else the table that won
+}
+#define SD_PUBLISH(p, v) sd_publish((p), (v))
+#endif
+
+static const vv_dsp_simd_kernels* g_kernels = NULL;
+
+#if defined(VV_DSP_DISPATCH_AVX2) || defined(VV_DSP_DISPATCH_AVX512)
+static void sd_cpuid(unsigned leaf, unsigned sub, unsigned r[4]) {
+#if defined(_MSC_VER)
+    int v[4];
+    __cpuidex(v, (int)leaf, (int)sub);
+    for (int i = 0; i < 4; ++i) r[i] = (unsigned)v[i];
+#else
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+static uint64_t sd_xgetbv0(void) {
+#if defined(_MSC_VER)
+    return (uint64_t)_xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+static vv_dsp_simd_level sd_detect_x86(void) {
+    unsigned r[4];
+    sd_cpuid(0, 0, r);
+    const unsigned max_leaf = r[0];
+    if (max_leaf < 7) return VV_DSP_SIMD_LEVEL_SSE2;
+    sd_cpuid(1, 0, r);
+    const int osxsave = (r[2] >> 27) & 1, avx = (r[2] >> 28) & 1, fma = (r[2] >> 12) & 1;
+    if (!osxsave || !avx) return VV_DSP_SIMD_LEVEL_SSE2;
+    const uint64_t xcr0 = sd_xgetbv0();
+    if ((xcr0 & 0x6) != 0x6) return VV_DSP_SIMD_LEVEL_SSE2;  // XMM and YMM state
+    sd_cpuid(7, 0, r);
+    const int avx2 = (r[1] >> 5) & 1, avx512f = (r[1] >> 16) & 1;
+    vv_dsp_simd_level level = VV_DSP_SIMD_LEVEL_SSE2;
+#if defined(VV_DSP_DISPATCH_AVX2)
+    if (avx2 && fma) level = VV_DSP_SIMD_LEVEL_AVX2;
+#endif
+#if defined(VV_DSP_DISPATCH_AVX512)
+    if (avx512f && (xcr0 & 0xe6) == 0xe6) level = VV_DSP_SIMD_LEVEL_AVX512;  // + opmask, ZMM
+#else
+    (void)avx512f;
+#endif
+    return level;
+}
+#endif
+
+vv_dsp_simd_level vv_dsp_simd_detect_level(void) {
+#if defined(VV_DSP_DISPATCH_AVX2) || defined(VV_DSP_DISPATCH_AVX512)
+    return sd_detect_x86();
+#elif defined(VV_DSP_DISPATCH_NEON) && defined(__linux__)
+    return (getauxval(AT_HWCAP) & SD_HWCAP_NEON) ? VV_DSP_SIMD_LEVEL_NEON : vv_dsp_simd_kernels_base.level;
+#else
+    return vv_dsp_simd_kernels_base.level;
+#endif
+}
+
+// Table compiled for exactly this level, or NULL
+static const vv_dsp_simd_kernels* sd_table(vv_dsp_simd_level level) {
+    if (level == vv_dsp_simd_kernels_base.level) return &vv_dsp_simd_kernels_base;
+#if defined(VV_DSP_DISPATCH_AVX2)
+    if (level == VV_DSP_SIMD_LEVEL_AVX2) return &vv_dsp_simd_kernels_avx2;
+#endif
+#if defined(VV_DSP_DISPATCH_AVX512)
+    if (level == VV_DSP_SIMD_LEVEL_AVX512) return &vv_dsp_simd_kernels_avx512;
+#endif
+#if defined(VV_DSP_DISPATCH_NEON)
+    if (level == VV_DSP_SIMD_LEVEL_NEON) return &vv_dsp_simd_kernels_neon;
+#endif
+    return NULL;
+}
+
+const vv_dsp_simd_kernels* vv_dsp_simd_kernels_get(void) {
+    const vv_dsp_simd_kernels* k = (const vv_dsp_simd_kernels*)SD_LOAD(&g_kernels);
+    if (k) return k;
+    k = sd_table(vv_dsp_simd_detect_level());
+    if (!k) k = &vv_dsp_simd_kernels_base;
+    const vv_dsp_simd_kernels* winner = (const vv_dsp_simd_kernels*)SD_PUBLISH(&g_kernels, k);
+    return winner ? winner : k;
+}
+
+vv_dsp_simd_level vv_dsp_simd_get_level(void) {
+    return vv_dsp_simd_kernels_get()->level;
+}
+
+vv_dsp_status vv_dsp_simd_set_level(vv_dsp_simd_level level) {
+    const vv_dsp_simd_kernels* k = sd_table(level);
+    if (!k || (int)level > (int)vv_dsp_simd_detect_level()) return VV_DSP_ERROR_UNSUPPORTED;
+    SD_STORE(&g_kernels, k);
+    return VV_DSP_OK;
+}
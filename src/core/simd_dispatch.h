@@ -0,0 +1,81 @@
+/*
+This file is part of vv-dsp
+
+Private runtime dispatch table for the core vector kernels. Each variant
+translation unit compiles the kernel bodies of simd_kernels.h with its own
+instruction-set flags and exports one const table; vv_dsp_simd_kernels_get()
+returns the table picked for the host on first use.
+*/
+
+#ifndef VV_DSP_CORE_SIMD_DISPATCH_H
+#define VV_DSP_CORE_SIMD_DISPATCH_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include <stdint.h>
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/convert.h"
+
+typedef struct vv_dsp_simd_kernels {
+    vv_dsp_simd_level level;
+    void (*add)(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real* out, size_t n);
+    void (*mul)(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real* out, size_t n);
+    // out[i] += a[i] * b[i] * g; b may be NULL
+    void (*mul_acc)(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real g, vv_dsp_real* out, size_t n);
+    void (*cpx_mul)(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n);
+    vv_dsp_real (*sum)(const vv_dsp_real* x, size_t n);
+    // sum of (x[i] - mean)^2; mean 0 gives the sum of squares
+    vv_dsp_real (*sum_sq_dev)(const vv_dsp_real* x, size_t n, vv_dsp_real mean);
+    // Compensated forms of the two above; the low part of the result goes to *err
+    vv_dsp_real (*sum_comp)(const vv_dsp_real* x, size_t n, vv_dsp_real* err);
+    vv_dsp_real (*sum_sq_dev_comp)(const vv_dsp_real* x, size_t n, vv_dsp_real mean, vv_dsp_real* err);
+    // index of the first NaN / Inf, or n
+    size_t (*find_nonfinite)(const vv_dsp_real* x, size_t n);
+    void (*sqrt)(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+    // Transcendentals compute in single precision; fast selects the ~1e-4 tier
+    void (*log)(const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast);
+    void (*exp)(const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast);
+    // s or c may be NULL
+    void (*sincos)(const vv_dsp_real* x, vv_dsp_real* s, vv_dsp_real* c, size_t n, int fast);
+    void (*tan)(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+    void (*atan2)(const vv_dsp_real* y, const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast);
+    // External samples (convert.h); count samples in order, or frames of channels
+    void (*pcm_decode)(const uint8_t* src, vv_dsp_sample_format format, size_t count, vv_dsp_real* out);
+    void (*pcm_encode)(const vv_dsp_real* x, vv_dsp_sample_format format, size_t count, uint8_t* dst);
+    void (*pcm_deinterleave)(const uint8_t* src, vv_dsp_sample_format format, size_t channels, size_t frames,
+                             vv_dsp_real* const* out);
+    void (*pcm_interleave)(const vv_dsp_real* const* x, size_t channels, size_t frames, vv_dsp_sample_format format,
+                           uint8_t* dst);
+    // Storage codes (quant.h): binary16 or bfloat16, and 8-bit codes of
+    // (x - offset) * scale, or of (ln x - offset) * scale with log, decoded through a table
+    void (*half_encode)(const vv_dsp_real* x, size_t n, int bf16, uint8_t* dst);
+    void (*half_decode)(const uint8_t* src, size_t n, int bf16, vv_dsp_real* out);
+    void (*u8_encode)(const vv_dsp_real* x, size_t n, float offset, float scale, int log, uint8_t* dst);
+    void (*u8_decode)(const uint8_t* src, size_t n, const vv_dsp_real* lut, vv_dsp_real* out);
+    // Phase wrapped to (-pi, pi], and unwrapped by whole turns from x[0]
+    void (*phase_wrap)(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+    void (*phase_unwrap)(const vv_dsp_real* x, vv_dsp_real* out, size_t n);
+    // Complex arrays (core.h): |z| or |z|^2 with power, a * conj(b), x * g, arg z and
+    // mag (cos ph, sin ph); phase and polar compute in single precision like atan2 / sincos
+    void (*cpx_mag)(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, int power);
+    void (*cpx_conj_mul)(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n);
+    void (*scale)(const vv_dsp_real* x, vv_dsp_real g, vv_dsp_real* out, size_t n);
+    void (*cpx_phase)(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, int fast);
+    void (*polar)(const vv_dsp_real* mag, const vv_dsp_real* ph, vv_dsp_cpx* out, size_t n, int fast);
+} vv_dsp_simd_kernels;
+
+// Baseline build flags: SSE2 on x86-64, NEON on AArch64, scalar elsewhere
+extern const vv_dsp_simd_kernels vv_dsp_simd_kernels_base;
+#if defined(VV_DSP_DISPATCH_AVX2)
+extern const vv_dsp_simd_kernels vv_dsp_simd_kernels_avx2;
+#endif
+#if defined(VV_DSP_DISPATCH_AVX512)
+extern const vv_dsp_simd_kernels vv_dsp_simd_kernels_avx512;
+#endif
+#if defined(VV_DSP_DISPATCH_NEON)
+extern const vv_dsp_simd_kernels vv_dsp_simd_kernels_neon;
+#endif
+
+const vv_dsp_simd_kernels* vv_dsp_simd_kernels_get(void);
+
+#endif // VV_DSP_CORE_SIMD_DISPATCH_H
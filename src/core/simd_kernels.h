@@ -0,0 +1,800 @@
+/*
+This file is part of vv-dsp
+
+Kernel bodies behind the runtime dispatch table (simd_dispatch.h). Included once
+by each variant translation unit, whose instruction-set flags decide how wide the
+compiler vectorizes them; nothing here names an intrinsic. Reductions keep
+SK_LANES independent partial sums in a fixed order and the variants are built
+with FMA contraction off, so every level returns the same bits. The one
+exception is sk_cpx_mul: GCC matches the complex product to vfmaddsub at the
+AVX2 and AVX-512 levels regardless of -ffp-contract (one rounding fewer).
+
+The transcendental kernels compute in single precision whatever vv_dsp_real is
+and take a fast flag for the ~1e-4 tier of vmath.h; each loop body is a forced-
+inline core with the flag as a constant, and selects go through bit masks since
+float ternaries are not if-converted under the default trapping-math rules.
+*/
+
+#ifndef VV_DSP_CORE_SIMD_KERNELS_H
+#define VV_DSP_CORE_SIMD_KERNELS_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "simd_dispatch.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/nan_policy.h"
+
+#define SK_LANES 16  // one AVX-512 register, two AVX2, four SSE2 / NEON
+#define SK_BLOCK 256 // block of the libm fix-up kernels; inputs are copied so outputs may alias them
+
+static uint32_t sk_f2u(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static float sk_u2f(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// mask all ones -> a, all zeros -> b
+static float sk_sel(uint32_t mask, float a, float b) {
+    return sk_u2f((sk_f2u(a) & mask) | (sk_f2u(b) & ~mask));
+}
+
+static void sk_add(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = a[i] + b[i];
+}
+
+static void sk_mul(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = a[i] * b[i];
+}
+
+static void sk_mul_acc(const vv_dsp_real* a, const vv_dsp_real* b, vv_dsp_real g, vv_dsp_real* out, size_t n) {
+    if (b) {
+        for (size_t i = 0; i < n; i++) out[i] += a[i] * b[i] * g;
+    } else {
+        for (size_t i = 0; i < n; i++) out[i] += a[i] * g;
+    }
+}
+
+static void sk_cpx_mul(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const vv_dsp_real ar = a[i].re, ai = a[i].im, br = b[i].re, bi = b[i].im;
+        out[i].re = ar * br - ai * bi;
+        out[i].im = ar * bi + ai * br;
+    }
+}
+
+static vv_dsp_real sk_sum(const vv_dsp_real* x, size_t n) {
+    vv_dsp_real acc[SK_LANES] = {0};
+    size_t i = 0;
+    for (; i + SK_LANES <= n; i += SK_LANES)
+        for (size_t l = 0; l < SK_LANES; ++l) acc[l] += x[i + l];
+    vv_dsp_real s = 0;
+    for (size_t l = 0; l < SK_LANES; ++l) s += acc[l];
+    for (; i < n; ++i) s += x[i];
+    return s;
+}
+
+static vv_dsp_real sk_sum_sq_dev(const vv_dsp_real* x, size_t n, vv_dsp_real mean) {
+    vv_dsp_real acc[SK_LANES] = {0};
+    size_t i = 0;
+    for (; i + SK_LANES <= n; i += SK_LANES) {
+        for (size_t l = 0; l < SK_LANES; ++l) {
+            const vv_dsp_real d = x[i + l] - mean;
+            acc[l] += d * d;
+        }
+    }
+    vv_dsp_real s = 0;
+    for (size_t l = 0; l < SK_LANES; ++l) s += acc[l];
+    for (; i < n; ++i) {
+        const vv_dsp_real d = x[i] - mean;
+        s += d * d;
+    }
+    return s;
+}
+
+// Kahan-compensated form of sk_sum / sk_sum_sq_dev for the PAIRWISE and
+// COMPENSATED reduction modes: the same lane order, with each lane's lost low
+// part kept in c[l]. The lanes are then merged with TwoSum; their rounding errors
+// and the lane corrections come back in *err (the sum is return value + *err).
+static VV_DSP_SIMD_FORCE_INLINE vv_dsp_real sk_sum_comp_core(const vv_dsp_real* x, size_t n, vv_dsp_real mean,
+                                                              vv_dsp_real* err, const int sq) {
+    vv_dsp_real acc[SK_LANES] = {0}, c[SK_LANES] = {0};
+    size_t i = 0;
+    for (; i + SK_LANES <= n; i += SK_LANES) {
+        for (size_t l = 0; l < SK_LANES; ++l) {
+            const vv_dsp_real d = x[i + l] - mean;
+            const vv_dsp_real y = (sq ? d * d : x[i + l]) - c[l];
+            const vv_dsp_real t = acc[l] + y;
+            c[l] = (t - acc[l]) - y;
+            acc[l] = t;
+        }
+    }
+    for (size_t l = 0; i < n; ++i, ++l) {
+        const vv_dsp_real d = x[i] - mean;
+        const vv_dsp_real y = (sq ? d * d : x[i]) - c[l];
+        const vv_dsp_real t = acc[l] + y;
+        c[l] = (t - acc[l]) - y;
+        acc[l] = t;
+    }
+    vv_dsp_real s = 0, e = 0;
+    for (size_t l = 0; l < SK_LANES; ++l) {
+        const vv_dsp_real t = s + acc[l];
+        const vv_dsp_real bp = t - s;
+        e += (s - (t - bp)) + (acc[l] - bp) - c[l];
+        s = t;
+    }
+    *err = e;
+    return s;
+}
+
+static vv_dsp_real sk_sum_comp(const vv_dsp_real* x, size_t n, vv_dsp_real* err) {
+    return sk_sum_comp_core(x, n, 0, err, 0);
+}
+
+static vv_dsp_real sk_sum_sq_dev_comp(const vv_dsp_real* x, size_t n, vv_dsp_real mean, vv_dsp_real* err) {
+    return sk_sum_comp_core(x, n, mean, err, 1);
+}
+
+// Index of the first NaN / Inf, or n. Each block is OR-reduced without branches and
+// only a flagged block is searched element by element.
+static size_t sk_find_nonfinite(const vv_dsp_real* x, size_t n) {
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        unsigned bad = 0;
+        for (size_t j = 0; j < m; j++) bad |= vv_dsp_nonfinite_flag(x[i0 + j]);
+        if (!bad) continue;
+        for (size_t j = 0; j < m; j++) {
+            if (vv_dsp_nonfinite_flag(x[i0 + j])) return i0 + j;
+        }
+    }
+    return n;
+}
+
+static void sk_sqrt(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    // Correctly rounded at every level; the variants build without errno so it vectorizes
+    for (size_t i = 0; i < n; i++) out[i] = VV_DSP_SQRT(x[i]);
+}
+
+// ln x. Medium: degree-9 odd series in s = (m - 1) / (m + 1), about half a float ulp.
+// Fast: degree 3, abs error below 7e-5.
+static VV_DSP_SIMD_FORCE_INLINE void sk_log_core(const vv_dsp_real* x, vv_dsp_real* out, size_t n, const int fast) {
+    // ln 2 split so e * LN2_HI is exact for every float exponent
+    const float LN2_HI = 0.693145751953125f;
+    const float LN2_LO = 1.42860677e-06f;
+    for (size_t i = 0; i < n; i++) {
+        const int32_t ibits = (int32_t)sk_f2u((float)x[i]);
+        // Clamp on the bit pattern (negatives and subnormals to FLT_MIN) so the
+        // loop stays branch-free
+        const uint32_t bits = (uint32_t)(ibits > 0x00800000 ? ibits : 0x00800000);
+        // Exponent chosen so the mantissa lands in [sqrt(1/2), sqrt(2))
+        const int32_t e = (int32_t)(bits - 0x3f3504f3u) >> 23;
+        const float m = sk_u2f(bits - ((uint32_t)e << 23));
+        // ln m = 2 (s + s^3/3 + ... + s^9/9), |s| <= 0.1716
+        const float s = (m - 1.0f) / (m + 1.0f);
+        const float s2 = s * s;
+        const float p = fast ? s2 * (1.0f / 3.0f)
+                             : s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f + s2 * (1.0f / 9.0f))));
+        const float fe = (float)e;
+        out[i] = (vv_dsp_real)(fe * LN2_HI + ((2.0f * s + 2.0f * s * p) + fe * LN2_LO));
+    }
+}
+
+static void sk_log(const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast) {
+    if (fast) sk_log_core(x, out, n, 1);
+    else sk_log_core(x, out, n, 0);
+}
+
+// Float bit pattern -> int32 with the same ordering as the float (and back: the map
+// is its own inverse)
+static int32_t sk_exp_order_key(int32_t bits) {
+    return bits ^ ((bits >> 31) & 0x7fffffff);
+}
+
+// e^x. Medium: degree-7 Taylor series of e^r, |r| <= ln2/2, about one float ulp.
+// Fast: degree 4, relative error below 6e-5.
+static VV_DSP_SIMD_FORCE_INLINE void sk_exp_core(const vv_dsp_real* x, vv_dsp_real* out, size_t n, const int fast) {
+    const float LOG2E = 1.44269504088896341f;
+    const float LN2_HI = 0.693145751953125f;
+    const float LN2_LO = 1.42860677e-06f;
+    const float ROUND = 12582912.0f;  // 1.5 * 2^23: adding it rounds to an integer
+    const int32_t key_lo = sk_exp_order_key((int32_t)sk_f2u(-87.33654f));
+    const int32_t key_hi = sk_exp_order_key((int32_t)sk_f2u(88.72283f));
+    for (size_t i = 0; i < n; i++) {
+        // Integer clamp keeps the loop branch-free
+        int32_t key = sk_exp_order_key((int32_t)sk_f2u((float)x[i]));
+        key = key < key_lo ? key_lo : key;
+        key = key > key_hi ? key_hi : key;
+        const float v = sk_u2f((uint32_t)sk_exp_order_key(key));
+
+        const float t = v * LOG2E + ROUND;
+        const float k = t - ROUND;
+        const int32_t ki = (int32_t)sk_f2u(t) - 0x4b400000;  // bit pattern of ROUND: leaves the rounded integer
+        const float r = (v - k * LN2_HI) - k * LN2_LO;
+        const float p = fast ? 1.0f + r * (1.0f + r * (1.0f / 2.0f + r * (1.0f / 6.0f + r * (1.0f / 24.0f))))
+                             : 1.0f + r * (1.0f + r * (1.0f / 2.0f + r * (1.0f / 6.0f + r * (1.0f / 24.0f +
+                               r * (1.0f / 120.0f + r * (1.0f / 720.0f + r * (1.0f / 5040.0f)))))));
+        // k reaches 128 at the top of the range, so scale in two halves
+        const int32_t k1 = ki >> 1, k2 = ki - k1;
+        const float s1 = sk_u2f((uint32_t)(k1 + 127) << 23), s2 = sk_u2f((uint32_t)(k2 + 127) << 23);
+        out[i] = (vv_dsp_real)(p * s1 * s2);
+    }
+}
+
+static void sk_exp(const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast) {
+    if (fast) sk_exp_core(x, out, n, 1);
+    else sk_exp_core(x, out, n, 0);
+}
+
+// sin and cos of |x| <= 8192. Medium: x = q pi/2 + r is reduced in double (two-part
+// pi/2, exact for these q) and Cephes minimax polynomials give sin r and cos r on
+// [-pi/4, pi/4], within 2 ulp. Fast: three-part float reduction and Taylor
+// polynomials of degree 5 / 6, abs error below 5e-5. The quadrant picks and signs
+// the two through the bit patterns.
+static VV_DSP_SIMD_FORCE_INLINE void sk_sincos_core(const float* x, float* so, float* co, size_t n, const int fast) {
+    const float TWO_OVER_PI = 0.636619772367581343f;
+    const float ROUND = 12582912.0f;
+    const double PIO2_HI = 1.57079632673412561417e+00, PIO2_LO = 6.07710050650619224932e-11;
+    const float P1 = 1.5703125f, P2 = 4.837512969970703125e-4f, P3 = 7.54978995489188216e-8f;
+    for (size_t i = 0; i < n; i++) {
+        const float v = x[i];
+        const float t = v * TWO_OVER_PI + ROUND;
+        const float k = t - ROUND;
+        const uint32_t q = sk_f2u(t) - 0x4b400000u;
+        const float r = fast ? ((v - k * P1) - k * P2) - k * P3
+                             : (float)(((double)v - (double)k * PIO2_HI) - (double)k * PIO2_LO);
+        const float z = r * r;
+        const float s = fast ? r + r * z * (-1.0f / 6.0f + z * (1.0f / 120.0f))
+                             : r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+        const float c = fast ? 1.0f - 0.5f * z + z * z * (1.0f / 24.0f + z * (-1.0f / 720.0f))
+                             : 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f +
+                               z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+        const uint32_t odd = 0u - (q & 1u);
+        // s carries the sign of r explicitly: r + r z p rounds -0 to +0
+        const uint32_t sb = sk_f2u(s) | (sk_f2u(r) & 0x80000000u), cb = sk_f2u(c);
+        // sin x = (s, c, -s, -c), cos x = (c, -s, -c, s) for q = 0..3
+        so[i] = sk_u2f(((cb & odd) | (sb & ~odd)) ^ ((q & 2u) << 30));
+        co[i] = sk_u2f(((sb & odd) | (cb & ~odd)) ^ (((q + 1u) & 2u) << 30));
+    }
+}
+
+// Nonzero if any of m float bit patterns has |x| > limit (or is Inf / NaN)
+static uint32_t sk_any_above(const float* x, size_t m, uint32_t limit_bits) {
+    uint32_t wide = 0;
+    for (size_t j = 0; j < m; j++) wide |= (uint32_t)((sk_f2u(x[j]) & 0x7fffffffu) > limit_bits);
+    return wide;
+}
+
+#define SK_TRIG_LIMIT 0x46000000u  // 8192.0f: beyond it, and for Inf / NaN, libm takes over
+
+static void sk_sincos(const vv_dsp_real* x, vv_dsp_real* s, vv_dsp_real* c, size_t n, int fast) {
+    float xb[SK_BLOCK], sb[SK_BLOCK], cb[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        for (size_t j = 0; j < m; j++) xb[j] = (float)x[i0 + j];
+        if (fast) sk_sincos_core(xb, sb, cb, m, 1);
+        else sk_sincos_core(xb, sb, cb, m, 0);
+        if (sk_any_above(xb, m, SK_TRIG_LIMIT)) {
+            for (size_t j = 0; j < m; j++) {
+                if (fabsf(xb[j]) <= 8192.0f) continue;
+                sb[j] = sinf(xb[j]);
+                cb[j] = cosf(xb[j]);
+            }
+        }
+        if (s) for (size_t j = 0; j < m; j++) s[i0 + j] = (vv_dsp_real)sb[j];
+        if (c) for (size_t j = 0; j < m; j++) c[i0 + j] = (vv_dsp_real)cb[j];
+    }
+}
+
+// tan x = sin x / cos x at the medium tier, within 4 ulp
+static void sk_tan(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    float xb[SK_BLOCK], sb[SK_BLOCK], cb[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        for (size_t j = 0; j < m; j++) xb[j] = (float)x[i0 + j];
+        sk_sincos_core(xb, sb, cb, m, 0);
+        for (size_t j = 0; j < m; j++) out[i0 + j] = (vv_dsp_real)(sb[j] / cb[j]);
+        if (!sk_any_above(xb, m, SK_TRIG_LIMIT)) continue;
+        for (size_t j = 0; j < m; j++) {
+            if (fabsf(xb[j]) > 8192.0f) out[i0 + j] = (vv_dsp_real)tanf(xb[j]);
+        }
+    }
+}
+
+// atan2(y, x) for finite inputs. t = min(|x|, |y|) / max(|x|, |y|) in [0, 1] and
+// atan t is mapped to the octant afterwards. Medium: t > tan(pi/8) is moved to
+// pi/4 + atan((t - 1) / (t + 1)) and Cephes' atanf polynomial takes over, within
+// 3 ulp. Fast: Abramowitz & Stegun 4.4.49 on [0, 1], abs error below 1.2e-5.
+static VV_DSP_SIMD_FORCE_INLINE void sk_atan2_core(const float* y, const float* x, float* out, size_t n,
+                                                   const int fast) {
+    const float PI = 3.14159265358979324f, PIO2 = 1.57079632679489662f, PIO4 = 0.785398163397448310f;
+    const uint32_t TAN_PIO8 = 0x3ed413cdu;  // 0.41421356f
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t yb = sk_f2u(y[i]), xb = sk_f2u(x[i]);
+        const uint32_t ayb = yb & 0x7fffffffu, axb = xb & 0x7fffffffu;
+        const uint32_t swap = 0u - (uint32_t)(ayb > axb);
+        const uint32_t mnb = (ayb & ~swap) | (axb & swap), mxb = (axb & ~swap) | (ayb & swap);
+        // 0 / 0 when both are zero: t = 0 then gives atan2's signed zeros and pi
+        const float t = sk_sel(0u - (uint32_t)(mxb == 0), 0.0f, sk_u2f(mnb) / sk_u2f(mxb));
+        float a;
+        if (fast) {
+            const float z = t * t;
+            a = t * (0.9998660f + z * (-0.3302995f + z * (0.1801410f + z * (-0.0851330f + z * 0.0208351f))));
+        } else {
+            const uint32_t big = 0u - (uint32_t)(sk_f2u(t) > TAN_PIO8);
+            const float u = sk_sel(big, (t - 1.0f) / (t + 1.0f), t);
+            const float z = u * u;
+            const float p = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z -
+                             3.33329491539e-1f) * z * u + u;
+            a = sk_sel(big, PIO4, 0.0f) + p;
+        }
+        a = sk_sel(swap, PIO2 - a, a);
+        a = sk_sel(0u - (xb >> 31), PI - a, a);
+        out[i] = sk_u2f(sk_f2u(a) | (yb & 0x80000000u));
+    }
+}
+
+// One block of m <= SK_BLOCK float pairs, Inf / NaN through libm
+static void sk_atan2_block(const float* yb, const float* xb, float* ob, size_t m, int fast) {
+    if (fast) sk_atan2_core(yb, xb, ob, m, 1);
+    else sk_atan2_core(yb, xb, ob, m, 0);
+    if (sk_any_above(yb, m, 0x7f7fffffu) | sk_any_above(xb, m, 0x7f7fffffu)) {
+        for (size_t j = 0; j < m; j++) {
+            if (!isfinite(yb[j]) || !isfinite(xb[j])) ob[j] = atan2f(yb[j], xb[j]);
+        }
+    }
+}
+
+static void sk_atan2(const vv_dsp_real* y, const vv_dsp_real* x, vv_dsp_real* out, size_t n, int fast) {
+    float yb[SK_BLOCK], xb[SK_BLOCK], ob[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        for (size_t j = 0; j < m; j++) {
+            yb[j] = (float)y[i0 + j];
+            xb[j] = (float)x[i0 + j];
+        }
+        sk_atan2_block(yb, xb, ob, m, fast);
+        for (size_t j = 0; j < m; j++) out[i0 + j] = (vv_dsp_real)ob[j];
+    }
+}
+
+// Complex arrays: the deinterleaving loads vectorize as strided loads, and the
+// blocked kernels copy their inputs, so every output may alias its input
+static VV_DSP_SIMD_FORCE_INLINE void sk_cpx_mag_core(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, const int power) {
+    for (size_t i = 0; i < n; i++) {
+        const vv_dsp_real p = z[i].re * z[i].re + z[i].im * z[i].im;
+        out[i] = power ? p : VV_DSP_SQRT(p);
+    }
+}
+
+// |z|^2, or |z| as the root of it (no hypot rescaling)
+static void sk_cpx_mag(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, int power) {
+    if (power) sk_cpx_mag_core(z, out, n, 1);
+    else sk_cpx_mag_core(z, out, n, 0);
+}
+
+static void sk_cpx_conj_mul(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const vv_dsp_real ar = a[i].re, ai = a[i].im, br = b[i].re, bi = b[i].im;
+        out[i].re = ar * br + ai * bi;
+        out[i].im = ai * br - ar * bi;
+    }
+}
+
+static void sk_scale(const vv_dsp_real* x, vv_dsp_real g, vv_dsp_real* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = x[i] * g;
+}
+
+static void sk_cpx_phase(const vv_dsp_cpx* z, vv_dsp_real* out, size_t n, int fast) {
+    float yb[SK_BLOCK], xb[SK_BLOCK], ob[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        for (size_t j = 0; j < m; j++) {
+            yb[j] = (float)z[i0 + j].im;
+            xb[j] = (float)z[i0 + j].re;
+        }
+        sk_atan2_block(yb, xb, ob, m, fast);
+        for (size_t j = 0; j < m; j++) out[i0 + j] = (vv_dsp_real)ob[j];
+    }
+}
+
+// mag (cos ph, sin ph); out must not overlap mag or ph
+static void sk_polar(const vv_dsp_real* mag, const vv_dsp_real* ph, vv_dsp_cpx* out, size_t n, int fast) {
+    vv_dsp_real sb[SK_BLOCK], cb[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        sk_sincos(ph + i0, sb, cb, m, fast);
+        for (size_t j = 0; j < m; j++) {
+            out[i0 + j].re = mag[i0 + j] * cb[j];
+            out[i0 + j].im = mag[i0 + j] * sb[j];
+        }
+    }
+}
+
+// v clamped to [-1, 1], NaN to the bound of its sign. The clamp runs on the integer
+// order of the bit pattern (as in sk_exp_core) so the encoders vectorize.
+static VV_DSP_SIMD_FORCE_INLINE vv_dsp_real sk_clamp_unit(vv_dsp_real v) {
+#if defined(VV_DSP_USE_DOUBLE)
+    int64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    int64_t key = bits ^ ((bits >> 63) & INT64_MAX);
+    const int64_t one = 0x3ff0000000000000;
+    key = key < -one - 1 ? -one - 1 : key;  // key of -1.0
+    key = key > one ? one : key;
+    bits = key ^ ((key >> 63) & INT64_MAX);
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+#else
+    int32_t key = sk_exp_order_key((int32_t)sk_f2u(v));
+    const int32_t one = 0x3f800000;
+    key = key < -one - 1 ? -one - 1 : key;
+    key = key > one ? one : key;
+    return sk_u2f((uint32_t)sk_exp_order_key(key));
+#endif
+}
+
+static VV_DSP_SIMD_FORCE_INLINE size_t sk_pcm_bytes(const vv_dsp_sample_format format) {
+    return format == VV_DSP_SAMPLE_S16 ? 2 : format == VV_DSP_SAMPLE_S24 ? 3 : 4;
+}
+
+// One sample at p; byte loads and memcpy keep unaligned sources legal
+static VV_DSP_SIMD_FORCE_INLINE vv_dsp_real sk_pcm_load(const uint8_t* p, const vv_dsp_sample_format format) {
+    if (format == VV_DSP_SAMPLE_S16) {
+        int16_t v;
+        memcpy(&v, p, sizeof(v));
+        return (vv_dsp_real)v * (vv_dsp_real)(1.0 / 32768.0);
+    }
+    if (format == VV_DSP_SAMPLE_S24) {
+        const uint32_t w = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+        return (vv_dsp_real)((int32_t)(w << 8) >> 8) * (vv_dsp_real)(1.0 / 8388608.0);
+    }
+    if (format == VV_DSP_SAMPLE_S32) {
+        int32_t v;
+        memcpy(&v, p, sizeof(v));
+        return (vv_dsp_real)v * (vv_dsp_real)(1.0 / 2147483648.0);
+    }
+    float v;
+    memcpy(&v, p, sizeof(v));
+    return (vv_dsp_real)v;
+}
+
+static VV_DSP_SIMD_FORCE_INLINE void sk_pcm_store(uint8_t* p, vv_dsp_real x, const vv_dsp_sample_format format) {
+    if (format == VV_DSP_SAMPLE_S16) {
+        const int16_t v = (int16_t)(int32_t)(sk_clamp_unit(x) * (vv_dsp_real)32767.0);
+        memcpy(p, &v, sizeof(v));
+    } else if (format == VV_DSP_SAMPLE_S24) {
+        const int32_t v = (int32_t)(sk_clamp_unit(x) * (vv_dsp_real)8388607.0);
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+        p[2] = (uint8_t)(v >> 16);
+    } else if (format == VV_DSP_SAMPLE_S32) {
+        // In double: 2^31 - 1 has no float representation
+        const int32_t v = (int32_t)((double)sk_clamp_unit(x) * 2147483647.0);
+        memcpy(p, &v, sizeof(v));
+    } else {
+        const float v = (float)x;
+        memcpy(p, &v, sizeof(v));
+    }
+}
+
+// The cores take the format as a constant; one and two channels get their own loops
+static VV_DSP_SIMD_FORCE_INLINE void sk_pcm_decode_core(const uint8_t* src, size_t count, vv_dsp_real* out,
+                                                        const vv_dsp_sample_format format) {
+    const size_t w = sk_pcm_bytes(format);
+    for (size_t i = 0; i < count; i++) out[i] = sk_pcm_load(src + i * w, format);
+}
+
+static VV_DSP_SIMD_FORCE_INLINE void sk_pcm_encode_core(const vv_dsp_real* x, size_t count, uint8_t* dst,
+                                                        const vv_dsp_sample_format format) {
+    const size_t w = sk_pcm_bytes(format);
+    for (size_t i = 0; i < count; i++) sk_pcm_store(dst + i * w, x[i], format);
+}
+
+// Wider layouts go frame block by frame block so the block stays in cache while
+// each channel is gathered from it
+static VV_DSP_SIMD_FORCE_INLINE void sk_pcm_deinterleave_core(const uint8_t* src, size_t channels, size_t frames,
+                                                              vv_dsp_real* const* out,
+                                                              const vv_dsp_sample_format format) {
+    const size_t w = sk_pcm_bytes(format);
+    if (channels == 1) {
+        sk_pcm_decode_core(src, frames, out[0], format);
+    } else if (channels == 2 && format == VV_DSP_SAMPLE_S24) {
+        // 6-byte frames do not vectorize in place: decode a block as one run, then split it
+        vv_dsp_real buf[2 * SK_BLOCK];
+        for (size_t f0 = 0; f0 < frames; f0 += SK_BLOCK) {
+            const size_t m = (frames - f0 < SK_BLOCK) ? frames - f0 : SK_BLOCK;
+            sk_pcm_decode_core(src + 2 * f0 * w, 2 * m, buf, format);
+            vv_dsp_real* l = out[0] + f0;
+            vv_dsp_real* r = out[1] + f0;
+            for (size_t j = 0; j < m; j++) {
+                l[j] = buf[2 * j];
+                r[j] = buf[2 * j + 1];
+            }
+        }
+    } else if (channels == 2) {
+        vv_dsp_real* l = out[0];
+        vv_dsp_real* r = out[1];
+        for (size_t i = 0; i < frames; i++) {
+            l[i] = sk_pcm_load(src + 2 * i * w, format);
+            r[i] = sk_pcm_load(src + (2 * i + 1) * w, format);
+        }
+    } else {
+        const size_t stride = channels * w;
+        for (size_t f0 = 0; f0 < frames; f0 += SK_BLOCK) {
+            const size_t m = (frames - f0 < SK_BLOCK) ? frames - f0 : SK_BLOCK;
+            for (size_t ch = 0; ch < channels; ch++) {
+                const uint8_t* p = src + f0 * stride + ch * w;
+                vv_dsp_real* o = out[ch] + f0;
+                for (size_t j = 0; j < m; j++) o[j] = sk_pcm_load(p + j * stride, format);
+            }
+        }
+    }
+}
+
+static VV_DSP_SIMD_FORCE_INLINE void sk_pcm_interleave_core(const vv_dsp_real* const* x, size_t channels,
+                                                            size_t frames, uint8_t* dst,
+                                                            const vv_dsp_sample_format format) {
+    const size_t w = sk_pcm_bytes(format);
+    if (channels == 1) {
+        sk_pcm_encode_core(x[0], frames, dst, format);
+    } else if (channels == 2 && format == VV_DSP_SAMPLE_S24) {
+        vv_dsp_real buf[2 * SK_BLOCK];
+        for (size_t f0 = 0; f0 < frames; f0 += SK_BLOCK) {
+            const size_t m = (frames - f0 < SK_BLOCK) ? frames - f0 : SK_BLOCK;
+            const vv_dsp_real* l = x[0] + f0;
+            const vv_dsp_real* r = x[1] + f0;
+            for (size_t j = 0; j < m; j++) {
+                buf[2 * j] = l[j];
+                buf[2 * j + 1] = r[j];
+            }
+            sk_pcm_encode_core(buf, 2 * m, dst + 2 * f0 * w, format);
+        }
+    } else if (channels == 2) {
+        const vv_dsp_real* l = x[0];
+        const vv_dsp_real* r = x[1];
+        for (size_t i = 0; i < frames; i++) {
+            sk_pcm_store(dst + 2 * i * w, l[i], format);
+            sk_pcm_store(dst + (2 * i + 1) * w, r[i], format);
+        }
+    } else {
+        const size_t stride = channels * w;
+        for (size_t f0 = 0; f0 < frames; f0 += SK_BLOCK) {
+            const size_t m = (frames - f0 < SK_BLOCK) ? frames - f0 : SK_BLOCK;
+            for (size_t ch = 0; ch < channels; ch++) {
+                uint8_t* p = dst + f0 * stride + ch * w;
+                const vv_dsp_real* in = x[ch] + f0;
+                for (size_t j = 0; j < m; j++) sk_pcm_store(p + j * stride, in[j], format);
+            }
+        }
+    }
+}
+
+static void sk_pcm_decode(const uint8_t* src, vv_dsp_sample_format format, size_t count, vv_dsp_real* out) {
+    switch (format) {
+    case VV_DSP_SAMPLE_S16: sk_pcm_decode_core(src, count, out, VV_DSP_SAMPLE_S16); break;
+    case VV_DSP_SAMPLE_S24: sk_pcm_decode_core(src, count, out, VV_DSP_SAMPLE_S24); break;
+    case VV_DSP_SAMPLE_S32: sk_pcm_decode_core(src, count, out, VV_DSP_SAMPLE_S32); break;
+    case VV_DSP_SAMPLE_F32: sk_pcm_decode_core(src, count, out, VV_DSP_SAMPLE_F32); break;
+    }
+}
+
+static void sk_pcm_encode(const vv_dsp_real* x, vv_dsp_sample_format format, size_t count, uint8_t* dst) {
+    switch (format) {
+    case VV_DSP_SAMPLE_S16: sk_pcm_encode_core(x, count, dst, VV_DSP_SAMPLE_S16); break;
+    case VV_DSP_SAMPLE_S24: sk_pcm_encode_core(x, count, dst, VV_DSP_SAMPLE_S24); break;
+    case VV_DSP_SAMPLE_S32: sk_pcm_encode_core(x, count, dst, VV_DSP_SAMPLE_S32); break;
+    case VV_DSP_SAMPLE_F32: sk_pcm_encode_core(x, count, dst, VV_DSP_SAMPLE_F32); break;
+    }
+}
+
+static void sk_pcm_deinterleave(const uint8_t* src, vv_dsp_sample_format format, size_t channels, size_t frames,
+                                vv_dsp_real* const* out) {
+    switch (format) {
+    case VV_DSP_SAMPLE_S16: sk_pcm_deinterleave_core(src, channels, frames, out, VV_DSP_SAMPLE_S16); break;
+    case VV_DSP_SAMPLE_S24: sk_pcm_deinterleave_core(src, channels, frames, out, VV_DSP_SAMPLE_S24); break;
+    case VV_DSP_SAMPLE_S32: sk_pcm_deinterleave_core(src, channels, frames, out, VV_DSP_SAMPLE_S32); break;
+    case VV_DSP_SAMPLE_F32: sk_pcm_deinterleave_core(src, channels, frames, out, VV_DSP_SAMPLE_F32); break;
+    }
+}
+
+static void sk_pcm_interleave(const vv_dsp_real* const* x, size_t channels, size_t frames,
+                              vv_dsp_sample_format format, uint8_t* dst) {
+    switch (format) {
+    case VV_DSP_SAMPLE_S16: sk_pcm_interleave_core(x, channels, frames, dst, VV_DSP_SAMPLE_S16); break;
+    case VV_DSP_SAMPLE_S24: sk_pcm_interleave_core(x, channels, frames, dst, VV_DSP_SAMPLE_S24); break;
+    case VV_DSP_SAMPLE_S32: sk_pcm_interleave_core(x, channels, frames, dst, VV_DSP_SAMPLE_S32); break;
+    case VV_DSP_SAMPLE_F32: sk_pcm_interleave_core(x, channels, frames, dst, VV_DSP_SAMPLE_F32); break;
+    }
+}
+
+// IEEE binary16 bits of v, round to nearest even without branches (after F. Giesen's
+// float_to_half_fast3_rtne): normals are rebiased and rounded on the 13 dropped bits,
+// letting the carry overflow into Inf; values below 2^-14 are rounded by the FPU in
+// one add of 0.5f, whose ulp is the binary16 subnormal step; NaN becomes 0x7e00.
+static VV_DSP_SIMD_FORCE_INLINE uint32_t sk_f16_bits(float v) {
+    const uint32_t u = sk_f2u(v);
+    const uint32_t a = u & 0x7fffffffu;
+    const uint32_t normal = (a + 0xc8000fffu + ((a >> 13) & 1u)) >> 13;
+    const uint32_t sub = sk_f2u(sk_u2f(a) + 0.5f) - 0x3f000000u;
+    const uint32_t special = 0x7c00u | ((0u - (uint32_t)(a > 0x7f800000u)) & 0x0200u);
+    const uint32_t big = 0u - (uint32_t)(a >= 0x47800000u);
+    const uint32_t small = 0u - (uint32_t)(a < 0x38800000u);
+    return (big & special) | (small & sub) | (~big & ~small & normal) | ((u >> 16) & 0x8000u);
+}
+
+// Exact float of binary16 bits: rebias, with Inf / NaN moved to exponent 255 and
+// zeros / subnormals rebuilt by one exact subtraction of 2^-14
+static VV_DSP_SIMD_FORCE_INLINE float sk_f16_value(uint32_t h) {
+    const uint32_t a = (h & 0x7fffu) << 13;
+    const uint32_t e = a & 0x0f800000u;
+    const uint32_t special = 0u - (uint32_t)(e == 0x0f800000u);
+    const uint32_t zero = 0u - (uint32_t)(e == 0);
+    const uint32_t sub = sk_f2u(sk_u2f(a + 0x38800000u) - 6.103515625e-05f);
+    const uint32_t bits = (special & (a + 0x70000000u)) | (zero & sub) | (~special & ~zero & (a + 0x38000000u));
+    return sk_u2f(bits | ((h & 0x8000u) << 16));
+}
+
+// bfloat16 bits of v, round to nearest even; NaNs keep their top bits and are quieted
+static VV_DSP_SIMD_FORCE_INLINE uint32_t sk_bf16_bits(float v) {
+    const uint32_t u = sk_f2u(v);
+    const uint32_t nan = 0u - (uint32_t)((u & 0x7fffffffu) > 0x7f800000u);
+    return (nan & ((u >> 16) | 0x40u)) | (~nan & ((u + 0x7fffu + ((u >> 16) & 1u)) >> 16));
+}
+
+// 16-bit codes go through memcpy so the storage needs no alignment; doubles round
+// to float first
+static VV_DSP_SIMD_FORCE_INLINE void sk_half_encode_core(const vv_dsp_real* x, size_t n, uint8_t* dst,
+                                                         const int bf16) {
+    for (size_t i = 0; i < n; i++) {
+        const uint16_t h = (uint16_t)(bf16 ? sk_bf16_bits((float)x[i]) : sk_f16_bits((float)x[i]));
+        memcpy(dst + 2 * i, &h, sizeof(h));
+    }
+}
+
+static VV_DSP_SIMD_FORCE_INLINE void sk_half_decode_core(const uint8_t* src, size_t n, vv_dsp_real* out,
+                                                         const int bf16) {
+    for (size_t i = 0; i < n; i++) {
+        uint16_t h;
+        memcpy(&h, src + 2 * i, sizeof(h));
+        out[i] = (vv_dsp_real)(bf16 ? sk_u2f((uint32_t)h << 16) : sk_f16_value(h));
+    }
+}
+
+static void sk_half_encode(const vv_dsp_real* x, size_t n, int bf16, uint8_t* dst) {
+    if (bf16) sk_half_encode_core(x, n, dst, 1);
+    else sk_half_encode_core(x, n, dst, 0);
+}
+
+static void sk_half_decode(const uint8_t* src, size_t n, int bf16, vv_dsp_real* out) {
+    if (bf16) sk_half_decode_core(src, n, out, 1);
+    else sk_half_decode_core(src, n, out, 0);
+}
+
+// Nearest code of (v - offset) * scale in [0, 255]; v is x, or ln x with the medium
+// log of sk_log_core (non-positive x clamp to FLT_MIN). NaN gives code 0.
+static VV_DSP_SIMD_FORCE_INLINE void sk_u8_encode_core(const vv_dsp_real* x, size_t n, float offset, float scale,
+                                                       uint8_t* dst, const int log) {
+    vv_dsp_real lb[SK_BLOCK];
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        const vv_dsp_real* v = x + i0;
+        if (log) {
+            sk_log_core(v, lb, m, 0);
+            v = lb;
+        }
+        for (size_t j = 0; j < m; j++) {
+            const float xj = (float)x[i0 + j];
+            float q = ((float)v[j] - offset) * scale;
+            q = sk_sel(0u - (uint32_t)((q >= 0.0f) & (xj == xj)), q, 0.0f);
+            q = sk_sel(0u - (uint32_t)(q <= 255.0f), q, 255.0f);
+            dst[i0 + j] = (uint8_t)(int32_t)(q + 0.5f);
+        }
+    }
+}
+
+static void sk_u8_encode(const vv_dsp_real* x, size_t n, float offset, float scale, int log, uint8_t* dst) {
+    if (log) sk_u8_encode_core(x, n, offset, scale, dst, 1);
+    else sk_u8_encode_core(x, n, offset, scale, dst, 0);
+}
+
+static void sk_u8_decode(const uint8_t* src, size_t n, const vv_dsp_real* lut, vv_dsp_real* out) {
+    for (size_t i = 0; i < n; i++) out[i] = lut[src[i]];
+}
+
+// Phase wrapping runs in vv_dsp_real: x - k 2pi with k rounded by the add-and-subtract
+// of 1.5 * 2^(mantissa bits), and 2pi split so k * SK_TWO_PI_HI is exact for |k| <= 2^15.
+// Blocks with a larger |x| (or Inf / NaN) take the fmod path.
+#if defined(VV_DSP_USE_DOUBLE)
+#define SK_ROUND_MAGIC 6755399441055744.0
+#else
+#define SK_ROUND_MAGIC 12582912.0f
+#endif
+#define SK_TWO_PI_HI ((vv_dsp_real)6.28125)
+#define SK_TWO_PI_LO ((vv_dsp_real)(VV_DSP_TWO_PI_D - 6.28125))
+#define SK_WRAP_LIMIT ((vv_dsp_real)205887.0)  // 2^15 turns
+
+#if defined(VV_DSP_USE_DOUBLE)
+typedef uint64_t sk_real_bits;
+#else
+typedef uint32_t sk_real_bits;
+#endif
+
+// cond ? a : b on the bit patterns
+static VV_DSP_SIMD_FORCE_INLINE vv_dsp_real sk_real_sel(int cond, vv_dsp_real a, vv_dsp_real b) {
+    sk_real_bits ua, ub;
+    memcpy(&ua, &a, sizeof(ua));
+    memcpy(&ub, &b, sizeof(ub));
+    const sk_real_bits mask = (sk_real_bits)0 - (sk_real_bits)cond;
+    ua = (ua & mask) | (ub & ~mask);
+    memcpy(&a, &ua, sizeof(a));
+    return a;
+}
+
+// v moved into (-pi, pi] by at most one turn each way
+static VV_DSP_SIMD_FORCE_INLINE vv_dsp_real sk_wrap_fix(vv_dsp_real v) {
+    v -= sk_real_sel(v > VV_DSP_PI, VV_DSP_TWO_PI, 0);
+    return v + sk_real_sel(v <= -VV_DSP_PI, VV_DSP_TWO_PI, 0);
+}
+
+static void sk_phase_wrap(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    const vv_dsp_real inv_two_pi = (vv_dsp_real)(1.0 / VV_DSP_TWO_PI_D);
+    const vv_dsp_real magic = (vv_dsp_real)SK_ROUND_MAGIC;
+    for (size_t i0 = 0; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        const vv_dsp_real* xb = x + i0;
+        vv_dsp_real* ob = out + i0;
+        int wide = 0;
+        for (size_t j = 0; j < m; j++) wide |= !((xb[j] <= SK_WRAP_LIMIT) & (xb[j] >= -SK_WRAP_LIMIT));
+        if (!wide) {
+            for (size_t j = 0; j < m; j++) {
+                const vv_dsp_real v = xb[j];
+                const vv_dsp_real k = (v * inv_two_pi + magic) - magic;
+                // Values already in range pass through unchanged
+                ob[j] = sk_real_sel((v > -VV_DSP_PI) & (v <= VV_DSP_PI), v,
+                                    sk_wrap_fix((v - k * SK_TWO_PI_HI) - k * SK_TWO_PI_LO));
+            }
+        } else {
+            for (size_t j = 0; j < m; j++) ob[j] = sk_wrap_fix((vv_dsp_real)fmod((double)xb[j], VV_DSP_TWO_PI_D));  // Inf / NaN give NaN
+        }
+    }
+}
+
+// Unwrap as x plus a prefix sum of whole turns: each step contributes -1 when the
+// difference exceeds pi and +1 when it is below -pi. The steps and the final add
+// vectorize; only the integer scan is serial.
+static void sk_phase_unwrap(const vv_dsp_real* x, vv_dsp_real* out, size_t n) {
+    int32_t turns[SK_BLOCK];
+    if (n == 0) return;
+    vv_dsp_real prev = x[0];
+    int32_t acc = 0;
+    out[0] = prev;
+    for (size_t i0 = 1; i0 < n; i0 += SK_BLOCK) {
+        const size_t m = (n - i0 < SK_BLOCK) ? n - i0 : SK_BLOCK;
+        const vv_dsp_real* xb = x + i0;
+        const vv_dsp_real d0 = xb[0] - prev;
+        turns[0] = (int32_t)(d0 < -VV_DSP_PI) - (int32_t)(d0 > VV_DSP_PI);
+        for (size_t j = 1; j < m; j++) {
+            const vv_dsp_real d = xb[j] - xb[j - 1];
+            turns[j] = (int32_t)(d < -VV_DSP_PI) - (int32_t)(d > VV_DSP_PI);
+        }
+        prev = xb[m - 1];  // read before out, which may alias x, is written
+        for (size_t j = 0; j < m; j++) {
+            acc += turns[j];
+            turns[j] = acc;
+        }
+        for (size_t j = 0; j < m; j++) out[i0 + j] = xb[j] + VV_DSP_TWO_PI * (vv_dsp_real)turns[j];
+    }
+}
+
+#define SK_TABLE(lvl) \
+    { (lvl), sk_add, sk_mul, sk_mul_acc, sk_cpx_mul, sk_sum, sk_sum_sq_dev, sk_sum_comp, sk_sum_sq_dev_comp, sk_find_nonfinite, sk_sqrt, sk_log, sk_exp, sk_sincos, \
+      sk_tan, sk_atan2, sk_pcm_decode, sk_pcm_encode, sk_pcm_deinterleave, sk_pcm_interleave, \
+      sk_half_encode, sk_half_decode, sk_u8_encode, sk_u8_decode, sk_phase_wrap, sk_phase_unwrap, \
+      sk_cpx_mag, sk_cpx_conj_mul, sk_scale, sk_cpx_phase, sk_polar }
+
+#endif // VV_DSP_CORE_SIMD_KERNELS_H
@@ -0,0 +1,14 @@
+/*
+This file is part of vv-dsp
+
+Core vector kernels built with AVX2 + FMA (selected at run time only on hosts
+that report both).
+*/
+
+#if !defined(__AVX2__)
+#error "simd_kernels_avx2.c must be compiled with AVX2 enabled"
+#endif
+
+#include "simd_kernels.h"
+
+const vv_dsp_simd_kernels vv_dsp_simd_kernels_avx2 = SK_TABLE(VV_DSP_SIMD_LEVEL_AVX2);
@@ -0,0 +1,14 @@
+/*
+This file is part of vv-dsp
+
+Core vector kernels built with AVX-512F (selected at run time only on hosts whose
+OS saves the ZMM state).
+*/
+
+#if !defined(__AVX512F__)
+#error "simd_kernels_avx512.c must be compiled with AVX-512F enabled"
+#endif
+
+#include "simd_kernels.h"
+
+const vv_dsp_simd_kernels vv_dsp_simd_kernels_avx512 = SK_TABLE(VV_DSP_SIMD_LEVEL_AVX512);
@@ -0,0 +1,18 @@
+/*
+This file is part of vv-dsp
+
+Core vector kernels at the baseline build flags; always present, and the only
+table on targets without a higher dispatch level.
+*/
+
+#include "simd_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SK_BASE_LEVEL VV_DSP_SIMD_LEVEL_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SK_BASE_LEVEL VV_DSP_SIMD_LEVEL_NEON
+#else
+#define SK_BASE_LEVEL VV_DSP_SIMD_LEVEL_SCALAR
+#endif
+
+const vv_dsp_simd_kernels vv_dsp_simd_kernels_base = SK_TABLE(SK_BASE_LEVEL);
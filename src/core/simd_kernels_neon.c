@@ -0,0 +1,14 @@
+/*
+This file is part of vv-dsp
+
+Core vector kernels built with NEON for 32-bit ARM, where it is optional and
+reported through HWCAP (AArch64 gets NEON from the baseline table).
+*/
+
+#if !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+#error "simd_kernels_neon.c must be compiled with NEON enabled"
+#endif
+
+#include "simd_kernels.h"
+
+const vv_dsp_simd_kernels vv_dsp_simd_kernels_neon = SK_TABLE(VV_DSP_SIMD_LEVEL_NEON);
@@ -5,92 +5,57 @@
  */
 
 #include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
-/* Platform-specific includes for aligned allocation */
-#ifdef _WIN32
-    #include <malloc.h>
-#elif defined(__APPLE__)
-    #include <sys/malloc.h>
+#if defined(_WIN32)
+#include <windows.h>
+#define POOL_TLS __declspec(thread)
+#define POOL_ADD(p, v) ((void)InterlockedExchangeAddSizeT((p), (v)))
+#define POOL_SUB(p, v) ((void)InterlockedExchangeAddSizeT((p), (size_t)0 - (v)))
+#define POOL_LOAD(p) InterlockedExchangeAddSizeT((p), 0)
 #else
-    #include <malloc.h>
-#endif
-
-/* C11 aligned_alloc availability check */
-#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
-    !defined(__APPLE__) && !defined(_WIN32)
-    #define VV_DSP_HAS_ALIGNED_ALLOC 1
+#include <pthread.h>
+#define POOL_TLS __thread
+#define POOL_ADD(p, v) ((void)__atomic_add_fetch((p), (v), __ATOMIC_RELAXED))
+#define POOL_SUB(p, v) ((void)__atomic_sub_fetch((p), (v), __ATOMIC_RELAXED))
+#define POOL_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
 #endif
 
 /**
  * @brief Internal structure for tracking allocated memory metadata
  *
  * We store metadata before the returned pointer to track the original
- * allocation for proper cleanup. This approach works across all platforms.
+ * allocation for proper cleanup. Blocks come from vv_dsp_malloc(), so the
+ * same over-allocate-and-align scheme serves every platform and every
+ * installed allocator.
  */
 typedef struct {
-    void* original_ptr;     ///< Original unaligned pointer from malloc
+    void* original_ptr;     ///< Original unaligned pointer from vv_dsp_malloc()
     size_t original_size;   ///< Original allocation size
     size_t alignment;       ///< Requested alignment
+    uint32_t size_class;    ///< Pool size class + 1, or 0 for an unpooled block
     uint32_t magic;         ///< Magic number for corruption detection
 } vv_dsp_aligned_header;
 
 #define VV_DSP_ALIGNED_MAGIC 0xABCD1234
 
-void* vv_dsp_aligned_malloc(size_t size, size_t alignment) {
-    if (size == 0) {
-        return NULL;
-    }
-
-    /* Validate alignment requirement */
-    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
-        /* Alignment must be power of 2 */
-        return NULL;
-    }
-
-    if (alignment < sizeof(void*)) {
-        alignment = sizeof(void*);
-    }
-
-#ifdef _WIN32
-    /* Use _aligned_malloc on Windows */
-    void* ptr = _aligned_malloc(size, alignment);
-    if (!ptr) {
-        return NULL;
-    }
-
-    /* Windows doesn't need header tracking since _aligned_free handles it */
-    return ptr;
-
-#elif defined(VV_DSP_HAS_ALIGNED_ALLOC)
-    /* Use C11 aligned_alloc where available */
-    /* Note: aligned_alloc requires size to be multiple of alignment */
-    size_t padded_size = ((size + alignment - 1) / alignment) * alignment;
-    return aligned_alloc(alignment, padded_size);
-
-#elif defined(__APPLE__)
-    /* Use posix_memalign on Apple platforms */
-    void* ptr = NULL;
-    if (posix_memalign(&ptr, alignment, size) != 0) {
-        return NULL;
-    }
-    return ptr;
-
-#else
-    /* Generic implementation using malloc + manual alignment */
-
+static void* aligned_block(size_t size, size_t alignment, uint32_t size_class) {
     /* Calculate total allocation size:
      * - Space for requested size
      * - Space for header metadata
      * - Extra space for alignment adjustment (worst case: alignment - 1)
      */
     size_t header_size = sizeof(vv_dsp_aligned_header);
+    if (size > (size_t)-1 - header_size - alignment) {
+        return NULL;
+    }
     size_t total_size = size + header_size + alignment - 1;
 
     /* Allocate raw memory */
-    void* raw_ptr = malloc(total_size);
+    void* raw_ptr = vv_dsp_malloc(total_size);
     if (!raw_ptr) {
         return NULL;
     }
@@ -98,7 +63,7 @@ void* vv_dsp_aligned_malloc(size_t size, size_t alignment) {
     /* Calculate aligned address for user data */
     uintptr_t raw_addr = (uintptr_t)raw_ptr;
     uintptr_t header_addr = raw_addr + sizeof(vv_dsp_aligned_header);
-    uintptr_t aligned_addr = (header_addr + alignment - 1) & ~(alignment - 1);
+    uintptr_t aligned_addr = (header_addr + alignment - 1) & ~(uintptr_t)(alignment - 1);
     uintptr_t header_final = aligned_addr - sizeof(vv_dsp_aligned_header);
 
     /* Store metadata in header */
@@ -106,6 +71,7 @@ void* vv_dsp_aligned_malloc(size_t size, size_t alignment) {
     header->original_ptr = raw_ptr;
     header->original_size = total_size;
     header->alignment = alignment;
+    header->size_class = size_class;
     header->magic = VV_DSP_ALIGNED_MAGIC;
 
     void* aligned_ptr = (void*)aligned_addr;
@@ -114,25 +80,166 @@ void* vv_dsp_aligned_malloc(size_t size, size_t alignment) {
     assert(vv_dsp_is_aligned(aligned_ptr, alignment));
 
     return aligned_ptr;
-#endif
 }
 
-void vv_dsp_aligned_free(void* ptr) {
-    if (!ptr) {
-        return;
+/* ---- Size-class pool ----
+ * Class c holds blocks of 2^(POOL_MIN_SHIFT + c) bytes aligned to POOL_ALIGN.
+ * Each thread keeps a singly linked free list per class, threaded through the
+ * first bytes of the cached blocks, and a byte count bounded by g_pool_limit.
+ * The cache is flushed back to the allocator when its thread exits. */
+#define POOL_MIN_SHIFT 6
+#define POOL_MAX_SHIFT 20
+#define POOL_CLASSES (POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1)
+#define POOL_ALIGN 64
+
+typedef struct pool_cache {
+    void* head[POOL_CLASSES];
+    size_t bytes;
+} pool_cache;
+
+static size_t g_pool_limit;  /* 0: pool off */
+static size_t g_pool_hits, g_pool_misses, g_pool_cached, g_pool_released;
+static size_t g_pool_cached_blocks, g_pool_cached_bytes;
+static POOL_TLS pool_cache* t_pool;
+
+static void pool_flush(pool_cache* c) {
+    for (unsigned k = 0; k < POOL_CLASSES; ++k) {
+        const size_t bs = (size_t)1 << (POOL_MIN_SHIFT + k);
+        while (c->head[k]) {
+            void* p = c->head[k];
+            c->head[k] = *(void**)p;
+            vv_dsp_aligned_header* h = (vv_dsp_aligned_header*)((uintptr_t)p - sizeof(vv_dsp_aligned_header));
+            vv_dsp_free(h->original_ptr);
+            POOL_SUB(&g_pool_cached_blocks, 1);
+            POOL_SUB(&g_pool_cached_bytes, bs);
+        }
     }
+    c->bytes = 0;
+}
+
+static void pool_thread_exit(void* arg) {
+    pool_cache* c = (pool_cache*)arg;
+    if (!c) return;
+    pool_flush(c);
+    vv_dsp_free(c);
+    t_pool = NULL;
+}
+
+#if defined(_WIN32)
+static DWORD g_pool_fls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_pool_once = INIT_ONCE_STATIC_INIT;
+static void NTAPI pool_fls_exit(PVOID arg) { pool_thread_exit(arg); }
+static BOOL CALLBACK pool_key_init(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void)once; (void)param; (void)ctx;
+    g_pool_fls = FlsAlloc(pool_fls_exit);
+    return TRUE;
+}
+static int pool_register(pool_cache* c) {
+    InitOnceExecuteOnce(&g_pool_once, pool_key_init, NULL, NULL);
+    return g_pool_fls != FLS_OUT_OF_INDEXES && FlsSetValue(g_pool_fls, c);
+}
+#else
+static pthread_key_t g_pool_key;
+static int g_pool_key_ok;
+static pthread_once_t g_pool_once = PTHREAD_ONCE_INIT;
+static void pool_key_init(void) {
+    g_pool_key_ok = pthread_key_create(&g_pool_key, pool_thread_exit) == 0;
+}
+static int pool_register(pool_cache* c) {
+    pthread_once(&g_pool_once, pool_key_init);
+    return g_pool_key_ok && pthread_setspecific(g_pool_key, c) == 0;
+}
+#endif
 
-#ifdef _WIN32
-    /* Use _aligned_free on Windows */
-    _aligned_free(ptr);
+/* The calling thread's cache, created on first use; NULL if that fails */
+static pool_cache* pool_get(void) {
+    pool_cache* c = t_pool;
+    if (c) return c;
+    c = (pool_cache*)vv_dsp_calloc(1, sizeof(pool_cache));
+    if (!c) return NULL;
+    if (!pool_register(c)) {
+        /* Without an exit hook the cache would leak with its thread */
+        vv_dsp_free(c);
+        return NULL;
+    }
+    t_pool = c;
+    return c;
+}
 
-#elif defined(VV_DSP_HAS_ALIGNED_ALLOC) || defined(__APPLE__)
-    /* Standard free works for aligned_alloc and posix_memalign */
-    free(ptr);
+static unsigned pool_class(size_t size) {
+    unsigned k = 0;
+    while (((size_t)1 << (POOL_MIN_SHIFT + k)) < size) ++k;
+    return k;
+}
 
+vv_dsp_status vv_dsp_aligned_pool_enable(size_t max_bytes_per_thread) {
+#if defined(_WIN32)
+    InterlockedExchangePointer((PVOID volatile*)&g_pool_limit, (PVOID)max_bytes_per_thread);
 #else
-    /* Generic implementation - retrieve original pointer from header */
+    __atomic_store_n(&g_pool_limit, max_bytes_per_thread, __ATOMIC_RELAXED);
+#endif
+    return VV_DSP_OK;
+}
+
+void vv_dsp_aligned_pool_trim(void) {
+    if (t_pool) pool_flush(t_pool);
+}
+
+vv_dsp_status vv_dsp_aligned_pool_get_stats(vv_dsp_aligned_pool_stats* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    out->hits = POOL_LOAD(&g_pool_hits);
+    out->misses = POOL_LOAD(&g_pool_misses);
+    out->cached = POOL_LOAD(&g_pool_cached);
+    out->released = POOL_LOAD(&g_pool_released);
+    out->cached_blocks = POOL_LOAD(&g_pool_cached_blocks);
+    out->cached_bytes = POOL_LOAD(&g_pool_cached_bytes);
+    return VV_DSP_OK;
+}
+
+void* vv_dsp_aligned_malloc(size_t size, size_t alignment) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* Validate alignment requirement */
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        /* Alignment must be power of 2 */
+        return NULL;
+    }
 
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+
+    // Inside a real-time section the pool is bypassed, so the allocator trap sees the call
+    if (POOL_LOAD(&g_pool_limit) != 0 && !vv_dsp_rt_active() && alignment <= POOL_ALIGN &&
+        size <= ((size_t)1 << POOL_MAX_SHIFT)) {
+        const unsigned k = pool_class(size);
+        const size_t bs = (size_t)1 << (POOL_MIN_SHIFT + k);
+        pool_cache* c = pool_get();
+        if (c && c->head[k]) {
+            void* p = c->head[k];
+            c->head[k] = *(void**)p;
+            c->bytes -= bs;
+            POOL_ADD(&g_pool_hits, 1);
+            POOL_SUB(&g_pool_cached_blocks, 1);
+            POOL_SUB(&g_pool_cached_bytes, bs);
+            return p;
+        }
+        if (c) {
+            POOL_ADD(&g_pool_misses, 1);
+            return aligned_block(bs, POOL_ALIGN, k + 1);
+        }
+    }
+    return aligned_block(size, alignment, 0);
+}
+
+void vv_dsp_aligned_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    /* Retrieve original pointer from header */
     uintptr_t aligned_addr = (uintptr_t)ptr;
     uintptr_t header_addr = aligned_addr - sizeof(vv_dsp_aligned_header);
     vv_dsp_aligned_header* header = (vv_dsp_aligned_header*)header_addr;
@@ -144,27 +251,36 @@ void vv_dsp_aligned_free(void* ptr) {
         return;
     }
 
+    if (header->size_class != 0) {
+        const unsigned k = header->size_class - 1;
+        const size_t bs = (size_t)1 << (POOL_MIN_SHIFT + k);
+        const size_t limit = POOL_LOAD(&g_pool_limit);
+        pool_cache* c = limit && !vv_dsp_rt_active() ? pool_get() : NULL;
+        if (c && c->bytes + bs <= limit) {
+            *(void**)ptr = c->head[k];
+            c->head[k] = ptr;
+            c->bytes += bs;
+            POOL_ADD(&g_pool_cached, 1);
+            POOL_ADD(&g_pool_cached_blocks, 1);
+            POOL_ADD(&g_pool_cached_bytes, bs);
+            return;
+        }
+        POOL_ADD(&g_pool_released, 1);
+    }
+
     /* Free the original allocation */
-    free(header->original_ptr);
-#endif
+    vv_dsp_free(header->original_ptr);
 }
 
 const char* vv_dsp_simd_get_features(void) {
-    static const char* features =
-#ifdef VV_DSP_SIMD_AVX512
-        "AVX512F"
-#elif defined(VV_DSP_SIMD_AVX2)
-        "AVX2"
-#elif defined(VV_DSP_SIMD_SSE41)
-        "SSE4.1"
-#elif defined(VV_DSP_SIMD_NEON)
-        "NEON"
-#else
-        "Scalar"
-#endif
-        ;
-
-    return features;
+    /* Report the level the dispatched kernels actually run at, not the build flags */
+    switch (vv_dsp_simd_get_level()) {
+        case VV_DSP_SIMD_LEVEL_AVX512: return "AVX512F";
+        case VV_DSP_SIMD_LEVEL_AVX2: return "AVX2";
+        case VV_DSP_SIMD_LEVEL_NEON: return "NEON";
+        case VV_DSP_SIMD_LEVEL_SSE2: return "SSE2";
+        default: return "Scalar";
+    }
 }
 
 /* Unit test function for aligned memory allocator */
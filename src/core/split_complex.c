@@ -0,0 +1,256 @@
+/**
+ * @file split_complex.c
+ * @brief Split-complex layout conversion and element-wise kernels
+ *
+ * Single-precision SIMD builds use AVX2 / SSE4.1 / NEON for the layout
+ * converters and the multiply / magnitude / power / mask kernels; every
+ * kernel finishes with (or falls back to) a scalar loop.
+ */
+
+#include <math.h>
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/core/simd_utils.h"
+
+#if !defined(VV_DSP_USE_DOUBLE)
+#  if defined(VV_DSP_SIMD_AVX2)
+#    define SPLIT_SIMD_AVX2 1
+#  elif defined(VV_DSP_SIMD_SSE41)
+#    define SPLIT_SIMD_SSE41 1
+#  elif defined(VV_DSP_SIMD_NEON)
+#    define SPLIT_SIMD_NEON 1
+#  endif
+#endif
+
+static vv_dsp_real split_sqrt(vv_dsp_real x) {
+#if defined(VV_DSP_USE_DOUBLE)
+    return sqrt(x);
+#else
+    return sqrtf(x);
+#endif
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_alloc(size_t n, vv_dsp_split_cpx* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    out->re = NULL;
+    out->im = NULL;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    out->re = (vv_dsp_real*)vv_dsp_aligned_malloc_default(n * sizeof(vv_dsp_real));
+    out->im = (vv_dsp_real*)vv_dsp_aligned_malloc_default(n * sizeof(vv_dsp_real));
+    if (!out->re || !out->im) {
+        vv_dsp_split_free(out);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    return VV_DSP_OK;
+}
+
+void vv_dsp_split_free(vv_dsp_split_cpx* buf) {
+    if (!buf) return;
+    vv_dsp_aligned_free(buf->re);
+    vv_dsp_aligned_free(buf->im);
+    buf->re = NULL;
+    buf->im = NULL;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cpx_to_split(const vv_dsp_cpx* in,
+                                                   vv_dsp_real* re,
+                                                   vv_dsp_real* im,
+                                                   size_t n) {
+    if (!in || !re || !im) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2) || defined(SPLIT_SIMD_SSE41) || defined(SPLIT_SIMD_NEON)
+    const vv_dsp_real* src = (const vv_dsp_real*)in;
+#endif
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        // a = r0 i0 r1 i1 | r2 i2 r3 i3, b = r4 i4 r5 i5 | r6 i6 r7 i7
+        __m256 a = _mm256_loadu_ps(src + 2 * i);
+        __m256 b = _mm256_loadu_ps(src + 2 * i + 8);
+        // Per-lane shuffle gives r0 r1 r4 r5 | r2 r3 r6 r7; fix the 64-bit order
+        __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 m = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), 0xD8));
+        m = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(m), 0xD8));
+        _mm256_storeu_ps(re + i, r);
+        _mm256_storeu_ps(im + i, m);
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 a = _mm_loadu_ps(src + 2 * i);
+        __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+        _mm_storeu_ps(re + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(im + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+#elif defined(SPLIT_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t v = vld2q_f32(src + 2 * i);
+        vst1q_f32(re + i, v.val[0]);
+        vst1q_f32(im + i, v.val[1]);
+    }
+#endif
+    for (; i < n; ++i) {
+        re[i] = in[i].re;
+        im[i] = in[i].im;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_to_cpx(const vv_dsp_real* re,
+                                                   const vv_dsp_real* im,
+                                                   vv_dsp_cpx* out,
+                                                   size_t n) {
+    if (!re || !im || !out) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2) || defined(SPLIT_SIMD_SSE41) || defined(SPLIT_SIMD_NEON)
+    vv_dsp_real* dst = (vv_dsp_real*)out;
+#endif
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256 r = _mm256_loadu_ps(re + i);
+        __m256 m = _mm256_loadu_ps(im + i);
+        // lo = r0 i0 r1 i1 | r4 i4 r5 i5, hi = r2 i2 r3 i3 | r6 i6 r7 i7
+        __m256 lo = _mm256_unpacklo_ps(r, m);
+        __m256 hi = _mm256_unpackhi_ps(r, m);
+        _mm256_storeu_ps(dst + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 r = _mm_loadu_ps(re + i);
+        __m128 m = _mm_loadu_ps(im + i);
+        _mm_storeu_ps(dst + 2 * i, _mm_unpacklo_ps(r, m));
+        _mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(r, m));
+    }
+#elif defined(SPLIT_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t v;
+        v.val[0] = vld1q_f32(re + i);
+        v.val[1] = vld1q_f32(im + i);
+        vst2q_f32(dst + 2 * i, v);
+    }
+#endif
+    for (; i < n; ++i) out[i] = vv_dsp_cpx_make(re[i], im[i]);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_complex_multiply(const vv_dsp_real* a_re,
+                                                             const vv_dsp_real* a_im,
+                                                             const vv_dsp_real* b_re,
+                                                             const vv_dsp_real* b_im,
+                                                             vv_dsp_real* out_re,
+                                                             vv_dsp_real* out_im,
+                                                             size_t n) {
+    if (!a_re || !a_im || !b_re || !b_im || !out_re || !out_im) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256 ar = _mm256_loadu_ps(a_re + i), ai = _mm256_loadu_ps(a_im + i);
+        __m256 br = _mm256_loadu_ps(b_re + i), bi = _mm256_loadu_ps(b_im + i);
+        _mm256_storeu_ps(out_re + i, _mm256_sub_ps(_mm256_mul_ps(ar, br), _mm256_mul_ps(ai, bi)));
+        _mm256_storeu_ps(out_im + i, _mm256_add_ps(_mm256_mul_ps(ar, bi), _mm256_mul_ps(ai, br)));
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 ar = _mm_loadu_ps(a_re + i), ai = _mm_loadu_ps(a_im + i);
+        __m128 br = _mm_loadu_ps(b_re + i), bi = _mm_loadu_ps(b_im + i);
+        _mm_storeu_ps(out_re + i, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+        _mm_storeu_ps(out_im + i, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+    }
+#elif defined(SPLIT_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t ar = vld1q_f32(a_re + i), ai = vld1q_f32(a_im + i);
+        float32x4_t br = vld1q_f32(b_re + i), bi = vld1q_f32(b_im + i);
+        vst1q_f32(out_re + i, vsubq_f32(vmulq_f32(ar, br), vmulq_f32(ai, bi)));
+        vst1q_f32(out_im + i, vaddq_f32(vmulq_f32(ar, bi), vmulq_f32(ai, br)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const vv_dsp_real ar = a_re[i], ai = a_im[i], br = b_re[i], bi = b_im[i];
+        out_re[i] = ar * br - ai * bi;
+        out_im[i] = ar * bi + ai * br;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_power(const vv_dsp_real* re,
+                                                  const vv_dsp_real* im,
+                                                  vv_dsp_real* out,
+                                                  size_t n) {
+    if (!re || !im || !out) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256 r = _mm256_loadu_ps(re + i), m = _mm256_loadu_ps(im + i);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(r, r), _mm256_mul_ps(m, m)));
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m)));
+    }
+#elif defined(SPLIT_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+        vst1q_f32(out + i, vaddq_f32(vmulq_f32(r, r), vmulq_f32(m, m)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = re[i] * re[i] + im[i] * im[i];
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_magnitude(const vv_dsp_real* re,
+                                                      const vv_dsp_real* im,
+                                                      vv_dsp_real* out,
+                                                      size_t n) {
+    if (!re || !im || !out) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256 r = _mm256_loadu_ps(re + i), m = _mm256_loadu_ps(im + i);
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(r, r), _mm256_mul_ps(m, m))));
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+        _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m))));
+    }
+#elif defined(SPLIT_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+        vst1q_f32(out + i, vsqrtq_f32(vaddq_f32(vmulq_f32(r, r), vmulq_f32(m, m))));
+    }
+#endif
+    for (; i < n; ++i) out[i] = split_sqrt(re[i] * re[i] + im[i] * im[i]);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_split_apply_mask(vv_dsp_real* re,
+                                                       vv_dsp_real* im,
+                                                       const vv_dsp_real* mask,
+                                                       size_t n) {
+    if (!re || !im || !mask) return VV_DSP_ERROR_NULL_POINTER;
+    size_t i = 0;
+#if defined(SPLIT_SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256 g = _mm256_loadu_ps(mask + i);
+        _mm256_storeu_ps(re + i, _mm256_mul_ps(_mm256_loadu_ps(re + i), g));
+        _mm256_storeu_ps(im + i, _mm256_mul_ps(_mm256_loadu_ps(im + i), g));
+    }
+#elif defined(SPLIT_SIMD_SSE41)
+    for (; i + 4 <= n; i += 4) {
+        __m128 g = _mm_loadu_ps(mask + i);
+        _mm_storeu_ps(re + i, _mm_mul_ps(_mm_loadu_ps(re + i), g));
+        _mm_storeu_ps(im + i, _mm_mul_ps(_mm_loadu_ps(im + i), g));
+    }
+#elif defined(SPLIT_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t g = vld1q_f32(mask + i);
+        vst1q_f32(re + i, vmulq_f32(vld1q_f32(re + i), g));
+        vst1q_f32(im + i, vmulq_f32(vld1q_f32(im + i), g));
+    }
+#endif
+    for (; i < n; ++i) {
+        re[i] *= mask[i];
+        im[i] *= mask[i];
+    }
+    return VV_DSP_OK;
+}
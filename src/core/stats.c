@@ -2,6 +2,7 @@
 #include <math.h>
 #include <float.h>
 #include <stddef.h>
+#include <string.h>
 
 static VV_DSP_INLINE int invalid_in(const vv_dsp_real* x, size_t n) {
     return (x == NULL || n == 0);
@@ -33,16 +34,10 @@ vv_dsp_status vv_dsp_peak(const vv_dsp_real* x, size_t n, vv_dsp_real* min_val,
 
 vv_dsp_status vv_dsp_crest_factor(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
     if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
-    vv_dsp_real mn, mx;
-    vv_dsp_status st = vv_dsp_peak(x, n, &mn, &mx);
-    if (st != VV_DSP_OK) return st;
-    vv_dsp_real peak = (mx > -mn) ? mx : -mn; // max absolute
-    vv_dsp_real r;
-    st = vv_dsp_rms(x, n, &r);
-    if (st != VV_DSP_OK) return st;
-    if (r == (vv_dsp_real)0) { *out = INFINITY; return VV_DSP_OK; }
-    *out = peak / r;
-    return VV_DSP_OK;
+    vv_dsp_stats st;
+    vv_dsp_status s = vv_dsp_stats_all(x, n, &st, VV_DSP_STATS_CREST);
+    if (s == VV_DSP_OK) *out = st.crest;
+    return s;
 }
 
 vv_dsp_status vv_dsp_zero_crossing_rate(const vv_dsp_real* x, size_t n, size_t* count_out) {
@@ -57,83 +52,163 @@ vv_dsp_status vv_dsp_zero_crossing_rate(const vv_dsp_real* x, size_t n, size_t*
     return VV_DSP_OK;
 }
 
-// One-pass computation for mean, variance, skewness (m3), kurtosis (m4)
-vv_dsp_status vv_dsp_skewness(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
-    if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
-    if (n < 3) { *out = 0; return VV_DSP_ERROR_INVALID_SIZE; }
-    double mean = 0.0, m2 = 0.0, m3 = 0.0; size_t k = 0;
-    for (size_t i = 0; i < n; ++i) {
-        double xi = (double)x[i];
-        size_t k1 = ++k;
-        double delta = xi - mean;
-        double delta_n = delta / (double)k1;
-        double term1 = delta * delta_n * (double)(k - 1);
-        m3 += term1 * delta_n * (double)(k - 2) - 3.0 * delta_n * m2;
-        m2 += term1;
-        mean += delta_n;
+// ---------- Fused descriptive statistics ----------
+//
+// Blocks of STATS_BLOCK samples are read once from memory: a first sweep gathers
+// the sum, the sum of squares and the extrema, a second sweep over the (cached)
+// block forms central moments about the block mean. Independent lanes keep both
+// sweeps vectorizable without reassociation, and block moments are merged into the
+// running totals with the pairwise update of Chan et al. / Pebay (Terriberry's
+// extension to the third and fourth moments).
+
+#define STATS_BLOCK 256
+#define STATS_LANES 8
+
+typedef struct {
+    double n, mean, m2, m3, m4;
+} stats_moments;
+
+// Merge moments b into a (central sums M2..M4 up to the requested order)
+static void stats_merge(stats_moments* a, const stats_moments* b, int order) {
+    if (a->n == 0.0) { *a = *b; return; }
+    const double na = a->n, nb = b->n, n = na + nb;
+    const double d = b->mean - a->mean, dn = d / n;
+    if (order >= 4) {
+        a->m4 += b->m4 + d * dn * dn * dn * na * nb * (na * na - na * nb + nb * nb)
+               + 6.0 * dn * dn * (na * na * b->m2 + nb * nb * a->m2)
+               + 4.0 * dn * (na * b->m3 - nb * a->m3);
     }
-    double var = m2 / (double)n;
-    if (var <= 0.0) { *out = 0; return VV_DSP_OK; }
-    double s = m3 / (double)n;
-    *out = (vv_dsp_real)(s / pow(var, 1.5));
-    return VV_DSP_OK;
+    if (order >= 3) {
+        a->m3 += b->m3 + d * dn * dn * na * nb * (na - nb) + 3.0 * dn * (na * b->m2 - nb * a->m2);
+    }
+    if (order >= 2) a->m2 += b->m2 + d * dn * na * nb;
+    a->mean += dn * nb;
+    a->n = n;
 }
 
-vv_dsp_status vv_dsp_kurtosis(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
-    if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
-    if (n < 4) { *out = 0; return VV_DSP_ERROR_INVALID_SIZE; }
-    double mean = 0.0, m2 = 0.0, m3 = 0.0, m4 = 0.0; size_t k = 0;
-    for (size_t i = 0; i < n; ++i) {
-        double xi = (double)x[i];
-        size_t k1 = ++k;
-        double delta = xi - mean;
-        double delta_n = delta / (double)k1;
-        double delta_n2 = delta_n * delta_n;
-        double term1 = delta * delta_n * (double)(k - 1);
-        m4 += term1 * delta_n2 * ((double)k * (double)k - 3.0*(double)k + 3.0)
-              + 6.0 * delta_n2 * m2 - 4.0 * delta_n * m3;
-        m3 += term1 * delta_n * (double)(k - 2) - 3.0 * delta_n * m2;
-        m2 += term1;
-        mean += delta_n;
-    }
-    double var = m2 / (double)n;
-    if (var <= 0.0) { *out = 0; return VV_DSP_OK; }
-    double k_excess = (m4 / (double)n) / (var * var) - 3.0; // excess kurtosis
-    *out = (vv_dsp_real)k_excess;
-    return VV_DSP_OK;
+static double lanes_sum(const double* v) {
+    double s = 0.0;
+    for (int j = 0; j < STATS_LANES; ++j) s += v[j];
+    return s;
 }
 
-vv_dsp_status vv_dsp_autocorrelation(const vv_dsp_real* x, size_t n, vv_dsp_real* r, size_t r_len, int biased) {
-    if (!r || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
-    if (r_len == 0) return VV_DSP_ERROR_INVALID_SIZE;
-    size_t maxlag = r_len - 1;
-    for (size_t lag = 0; lag <= maxlag; ++lag) {
-        double acc = 0.0;
-        size_t count = 0;
-        for (size_t i = 0; i + lag < n; ++i) {
-            acc += (double)x[i] * (double)x[i + lag];
-            count++;
+vv_dsp_status vv_dsp_stats_all(const vv_dsp_real* x, size_t n, vv_dsp_stats* out, unsigned mask) {
+    if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
+    memset(out, 0, sizeof(*out));
+    const int order = (mask & VV_DSP_STATS_KURTOSIS) ? 4
+                    : (mask & VV_DSP_STATS_SKEWNESS) ? 3
+                    : (mask & VV_DSP_STATS_VAR) ? 2
+                    : (mask & VV_DSP_STATS_MEAN) ? 1 : 0;
+    const int want_sq = (mask & (VV_DSP_STATS_RMS | VV_DSP_STATS_CREST)) != 0;
+    const int want_ext = (mask & (VV_DSP_STATS_MIN | VV_DSP_STATS_MAX | VV_DSP_STATS_CREST)) != 0;
+
+    stats_moments tot = {0.0, 0.0, 0.0, 0.0, 0.0};
+    double sumsq = 0.0;
+    vv_dsp_real mn = x[0], mx = x[0];
+
+    for (size_t b0 = 0; b0 < n; b0 += STATS_BLOCK) {
+        const size_t m = (n - b0 < STATS_BLOCK) ? n - b0 : STATS_BLOCK;
+        const vv_dsp_real* xb = x + b0;
+        const size_t mv = m - m % STATS_LANES;
+
+        double s1[STATS_LANES] = {0}, s2[STATS_LANES] = {0};
+        vv_dsp_real lo[STATS_LANES], hi[STATS_LANES];
+        for (int j = 0; j < STATS_LANES; ++j) lo[j] = hi[j] = xb[0];
+        for (size_t i = 0; i < mv; i += STATS_LANES) {
+            for (int j = 0; j < STATS_LANES; ++j) {
+                const double v = (double)xb[i + (size_t)j];
+                s1[j] += v;
+                if (want_sq) s2[j] += v * v;
+            }
+            if (want_ext) {
+                for (int j = 0; j < STATS_LANES; ++j) {
+                    const vv_dsp_real v = xb[i + (size_t)j];
+                    lo[j] = (v < lo[j]) ? v : lo[j];
+                    hi[j] = (v > hi[j]) ? v : hi[j];
+                }
+            }
         }
-        if (count == 0) { r[lag] = 0; continue; }
-        if (biased) r[lag] = (vv_dsp_real)(acc / (double)n);
-        else r[lag] = (vv_dsp_real)(acc / (double)count);
-    }
-    return VV_DSP_OK;
-}
+        for (size_t i = mv; i < m; ++i) {
+            const double v = (double)xb[i];
+            s1[0] += v;
+            s2[0] += v * v;
+            if (xb[i] < lo[0]) lo[0] = xb[i];
+            if (xb[i] > hi[0]) hi[0] = xb[i];
+        }
+        if (want_ext) {
+            for (int j = 0; j < STATS_LANES; ++j) {
+                if (lo[j] < mn) mn = lo[j];
+                if (hi[j] > mx) mx = hi[j];
+            }
+        }
+        sumsq += lanes_sum(s2);
+        if (order == 0) continue;
 
-vv_dsp_status vv_dsp_cross_correlation(const vv_dsp_real* x, size_t nx,
-                                       const vv_dsp_real* y, size_t ny,
-                                       vv_dsp_real* r, size_t r_len) {
-    if (!r || invalid_in(x, nx) || invalid_in(y, ny)) return VV_DSP_ERROR_NULL_POINTER;
-    if (r_len == 0) return VV_DSP_ERROR_INVALID_SIZE;
-    // Define r[k] for k = 0..r_len-1 as correlation with lag k (y delayed by k)
-    for (size_t lag = 0; lag < r_len; ++lag) {
-        double acc = 0.0; size_t count = 0;
-        for (size_t i = 0; i < nx; ++i) {
-            size_t j = i + lag;
-            if (j < ny) { acc += (double)x[i] * (double)y[j]; count++; }
+        stats_moments blk = {(double)m, lanes_sum(s1) / (double)m, 0.0, 0.0, 0.0};
+        if (order >= 2) {
+            // Central moments about the block mean, read back from cache
+            const double mu = blk.mean;
+            double c2[STATS_LANES] = {0}, c3[STATS_LANES] = {0}, c4[STATS_LANES] = {0};
+            for (size_t i = 0; i < mv; i += STATS_LANES) {
+                for (int j = 0; j < STATS_LANES; ++j) {
+                    const double d = (double)xb[i + (size_t)j] - mu, d2 = d * d;
+                    c2[j] += d2;
+                    if (order >= 3) c3[j] += d2 * d;
+                    if (order >= 4) c4[j] += d2 * d2;
+                }
+            }
+            for (size_t i = mv; i < m; ++i) {
+                const double d = (double)xb[i] - mu, d2 = d * d;
+                c2[0] += d2;
+                c3[0] += d2 * d;
+                c4[0] += d2 * d2;
+            }
+            blk.m2 = lanes_sum(c2);
+            if (order >= 3) blk.m3 = lanes_sum(c3);
+            if (order >= 4) blk.m4 = lanes_sum(c4);
         }
-        r[lag] = (count > 0) ? (vv_dsp_real)(acc / (double)count) : (vv_dsp_real)0;
+        stats_merge(&tot, &blk, order);
     }
-    return VV_DSP_OK;
+
+    const double dn = (double)n;
+    const double var = tot.m2 / dn;
+    const double rms = sqrt(sumsq / dn);
+    vv_dsp_status st = VV_DSP_OK;
+    if (mask & VV_DSP_STATS_MEAN) out->mean = (vv_dsp_real)tot.mean;
+    if (mask & VV_DSP_STATS_VAR) {
+        if (n < 2) st = VV_DSP_ERROR_INVALID_SIZE;
+        else out->var = (vv_dsp_real)var;
+    }
+    if (mask & VV_DSP_STATS_SKEWNESS) {
+        if (n < 3) st = VV_DSP_ERROR_INVALID_SIZE;
+        else if (var > 0.0) out->skewness = (vv_dsp_real)((tot.m3 / dn) / pow(var, 1.5));
+    }
+    if (mask & VV_DSP_STATS_KURTOSIS) {
+        if (n < 4) st = VV_DSP_ERROR_INVALID_SIZE;
+        else if (var > 0.0) out->kurtosis = (vv_dsp_real)((tot.m4 / dn) / (var * var) - 3.0);
+    }
+    if (mask & VV_DSP_STATS_MIN) out->min = mn;
+    if (mask & VV_DSP_STATS_MAX) out->max = mx;
+    if (mask & VV_DSP_STATS_RMS) out->rms = (vv_dsp_real)rms;
+    if (mask & VV_DSP_STATS_CREST) {
+        const vv_dsp_real peak = (mx > -mn) ? mx : -mn;
+        out->crest = (rms == 0.0) ? (vv_dsp_real)INFINITY : (vv_dsp_real)((double)peak / rms);
+    }
+    return st;
+}
+
+vv_dsp_status vv_dsp_skewness(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
+    if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_stats st;
+    vv_dsp_status s = vv_dsp_stats_all(x, n, &st, VV_DSP_STATS_SKEWNESS);
+    *out = st.skewness;
+    return s;
+}
+
+vv_dsp_status vv_dsp_kurtosis(const vv_dsp_real* x, size_t n, vv_dsp_real* out) {
+    if (!out || invalid_in(x, n)) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_stats st;
+    vv_dsp_status s = vv_dsp_stats_all(x, n, &st, VV_DSP_STATS_KURTOSIS);
+    *out = st.kurtosis;
+    return s;
 }
@@ -0,0 +1,482 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // CPU_SET, pthread_setaffinity_np
+#endif
+
+#include "vv_dsp/core/threadpool.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef SRWLOCK tp_mutex;
+typedef CONDITION_VARIABLE tp_cond;
+typedef HANDLE tp_thread;
+#define TP_MUTEX_INIT        SRWLOCK_INIT
+#define TP_MUTEX_SETUP(m)    InitializeSRWLock(m)
+#define TP_MUTEX_TEARDOWN(m) ((void)(m))
+#define TP_COND_SETUP(c)     InitializeConditionVariable(c)
+#define TP_COND_TEARDOWN(c)  ((void)(c))
+#define TP_LOCK(m)           AcquireSRWLockExclusive(m)
+#define TP_UNLOCK(m)         ReleaseSRWLockExclusive(m)
+#define TP_WAIT(c, m)        SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define TP_SIGNAL(c)         WakeConditionVariable(c)
+#define TP_BROADCAST(c)      WakeAllConditionVariable(c)
+#define TP_TRY_ACQUIRE(p)    (InterlockedExchange((p), 1) == 0)
+#define TP_RELEASE(p)        InterlockedExchange((p), 0)
+typedef volatile LONG tp_flag;
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_mutex_t tp_mutex;
+typedef pthread_cond_t tp_cond;
+typedef pthread_t tp_thread;
+#define TP_MUTEX_INIT        PTHREAD_MUTEX_INITIALIZER
+#define TP_MUTEX_SETUP(m)    pthread_mutex_init((m), NULL)
+#define TP_MUTEX_TEARDOWN(m) pthread_mutex_destroy(m)
+#define TP_COND_SETUP(c)     pthread_cond_init((c), NULL)
+#define TP_COND_TEARDOWN(c)  pthread_cond_destroy(c)
+#define TP_LOCK(m)           pthread_mutex_lock(m)
+#define TP_UNLOCK(m)         pthread_mutex_unlock(m)
+#define TP_WAIT(c, m)        pthread_cond_wait((c), (m))
+#define TP_SIGNAL(c)         pthread_cond_signal(c)
+#define TP_BROADCAST(c)      pthread_cond_broadcast(c)
+#define TP_TRY_ACQUIRE(p)    (__atomic_exchange_n((p), 1, __ATOMIC_ACQUIRE) == 0)
+#define TP_RELEASE(p)        __atomic_store_n((p), 0, __ATOMIC_RELEASE)
+typedef int tp_flag;
+#endif
+
+#define TP_MAX_NODES 64
+
+// One worker's share of the running parallel for: the owner takes chunks from lo,
+// thieves cut from hi. Padded so neighbouring ranges do not share a cache line.
+typedef struct {
+    tp_mutex lock;
+    size_t lo;
+    size_t hi;
+    unsigned char pad[64];
+} tp_range;
+
+typedef struct {
+    vv_dsp_threadpool* pool;
+    size_t index;       // worker index (pool threads are 1..num_threads-1)
+    int cpu;            // CPU to pin to, -1 for none
+} tp_thread_arg;
+
+struct vv_dsp_threadpool {
+    size_t num_threads;
+    int has_executor;
+    vv_dsp_executor executor;
+    tp_range* ranges;           // num_threads
+    size_t* victims;            // num_threads rows of num_threads - 1, in steal order
+    tp_thread* threads;         // num_threads - 1
+    tp_thread_arg* args;
+    size_t started;
+
+    tp_mutex mu;
+    tp_cond wake;               // a job was posted or the pool is stopping
+    tp_cond idle;               // the last pool thread left the job
+    unsigned long generation;
+    size_t running;             // pool threads still inside the current job
+    int stop;
+    tp_flag busy;               // a job is running
+
+    // Current job
+    vv_dsp_range_fn fn;
+    void* ctx;
+    size_t grain;
+};
+
+// --------------- Topology ---------------
+
+static size_t tp_online_cpus(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors > 0 ? (size_t)si.dwNumberOfProcessors : 1;
+#else
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+// CPUs listed node by node (cpus[i] on node nodes[i]); returns the count, 0 when the
+// topology is unknown
+static size_t tp_numa_cpus(int* cpus, int* nodes, size_t cap) {
+    size_t count = 0;
+#if defined(_WIN32)
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) return 0;
+    for (ULONG node = 0; node <= highest && node < TP_MAX_NODES; ++node) {
+        ULONGLONG mask = 0;
+        if (!GetNumaNodeProcessorMask((UCHAR)node, &mask)) continue;
+        for (int c = 0; c < 64 && count < cap; ++c) {
+            if (mask & (1ull << c)) {
+                cpus[count] = c;
+                nodes[count++] = (int)node;
+            }
+        }
+    }
+#elif defined(__linux__)
+    for (int node = 0; node < TP_MAX_NODES; ++node) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* fp = fopen(path, "r");
+        if (!fp) continue;
+        // "0-7,16-23"
+        int a, b;
+        while (count < cap && fscanf(fp, "%d", &a) == 1) {
+            b = a;
+            int c = fgetc(fp);
+            if (c == '-') {
+                if (fscanf(fp, "%d", &b) != 1) break;
+                c = fgetc(fp);
+            }
+            for (int k = a; k <= b && count < cap; ++k) {
+                cpus[count] = k;
+                nodes[count++] = node;
+            }
+            if (c != ',') break;
+        }
+        fclose(fp);
+    }
+#else
+    (void)cpus;
+    (void)nodes;
+    (void)cap;
+#endif
+    return count;
+}
+
+static void tp_pin_self(int cpu) {
+    if (cpu < 0) return;
+#if defined(_WIN32)
+    if (cpu < (int)(8 * sizeof(DWORD_PTR))) (void)SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+#elif defined(__linux__)
+    if (cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((size_t)cpu, &set);
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+}
+
+// --------------- Work stealing ---------------
+
+// Next chunk of the worker's own range
+static int tp_take(tp_range* r, size_t grain, size_t* lo, size_t* hi) {
+    int got = 0;
+    TP_LOCK(&r->lock);
+    if (r->lo < r->hi) {
+        *lo = r->lo;
+        *hi = (r->hi - r->lo > grain) ? r->lo + grain : r->hi;
+        r->lo = *hi;
+        got = 1;
+    }
+    TP_UNLOCK(&r->lock);
+    return got;
+}
+
+// Cut the back half off the first victim with work left; the first chunk is returned
+// and the rest becomes the thief's own range. Only the owner refills a range, and it
+// only steals once its own is empty, so no range ever gains work it could lose.
+static int tp_steal(vv_dsp_threadpool* pool, size_t w, size_t* lo, size_t* hi) {
+    const size_t* order = pool->victims + w * (pool->num_threads - 1);
+    for (size_t k = 0; k + 1 < pool->num_threads; ++k) {
+        tp_range* v = &pool->ranges[order[k]];
+        size_t a = 0, b = 0;
+        TP_LOCK(&v->lock);
+        if (v->lo < v->hi) {
+            const size_t n = v->hi - v->lo;
+            b = v->hi;
+            a = b - (n - n / 2);
+            v->hi = a;
+        }
+        TP_UNLOCK(&v->lock);
+        if (a == b) continue;
+        *lo = a;
+        *hi = (b - a > pool->grain) ? a + pool->grain : b;
+        if (*hi < b) {
+            tp_range* own = &pool->ranges[w];
+            TP_LOCK(&own->lock);
+            own->lo = *hi;
+            own->hi = b;
+            TP_UNLOCK(&own->lock);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+static void tp_work(vv_dsp_threadpool* pool, size_t w) {
+    size_t lo, hi;
+    while (tp_take(&pool->ranges[w], pool->grain, &lo, &hi) || tp_steal(pool, w, &lo, &hi)) {
+        pool->fn(pool->ctx, lo, hi, w);
+    }
+}
+
+static void tp_executor_task(void* ctx, size_t k) {
+    vv_dsp_threadpool* pool = (vv_dsp_threadpool*)ctx;
+    if (k < pool->num_threads) tp_work(pool, k);
+}
+
+static void tp_thread_main(tp_thread_arg* arg) {
+    vv_dsp_threadpool* pool = arg->pool;
+    tp_pin_self(arg->cpu);
+    unsigned long seen = 0;
+    TP_LOCK(&pool->mu);
+    for (;;) {
+        while (!pool->stop && pool->generation == seen) TP_WAIT(&pool->wake, &pool->mu);
+        if (pool->stop) break;
+        seen = pool->generation;
+        TP_UNLOCK(&pool->mu);
+        tp_work(pool, arg->index);
+        TP_LOCK(&pool->mu);
+        if (--pool->running == 0) TP_SIGNAL(&pool->idle);
+    }
+    TP_UNLOCK(&pool->mu);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI tp_entry(LPVOID arg) {
+    tp_thread_main((tp_thread_arg*)arg);
+    return 0;
+}
+#else
+static void* tp_entry(void* arg) {
+    tp_thread_main((tp_thread_arg*)arg);
+    return NULL;
+}
+#endif
+
+// --------------- Creation ---------------
+
+static vv_dsp_threadpool* tp_alloc(size_t num_threads) {
+    vv_dsp_threadpool* pool = (vv_dsp_threadpool*)vv_dsp_calloc(1, sizeof(vv_dsp_threadpool));
+    if (!pool) return NULL;
+    pool->num_threads = num_threads;
+    pool->ranges = (tp_range*)vv_dsp_calloc(num_threads, sizeof(tp_range));
+    pool->victims = (size_t*)vv_dsp_calloc(num_threads * (num_threads - 1) + 1, sizeof(size_t));
+    if (!pool->ranges || !pool->victims) {
+        vv_dsp_free(pool->ranges);
+        vv_dsp_free(pool->victims);
+        vv_dsp_free(pool);
+        return NULL;
+    }
+    for (size_t w = 0; w < num_threads; ++w) {
+        TP_MUTEX_SETUP(&pool->ranges[w].lock);
+        // Round robin from the next worker
+        for (size_t k = 0; k + 1 < num_threads; ++k) pool->victims[w * (num_threads - 1) + k] = (w + 1 + k) % num_threads;
+    }
+    return pool;
+}
+
+// Same-node victims first, each group in round-robin order
+static void tp_order_by_node(vv_dsp_threadpool* pool, const int* node_of) {
+    const size_t T = pool->num_threads;
+    for (size_t w = 0; w < T; ++w) {
+        size_t* row = pool->victims + w * (T - 1);
+        size_t n = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t k = 1; k < T; ++k) {
+                const size_t v = (w + k) % T;
+                if ((node_of[v] == node_of[w]) == (pass == 0)) row[n++] = v;
+            }
+        }
+    }
+}
+
+vv_dsp_status vv_dsp_threadpool_create(const vv_dsp_threadpool_params* params, vv_dsp_threadpool** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    vv_dsp_threadpool_params p;
+    memset(&p, 0, sizeof(p));
+    if (params) p = *params;
+    if (p.numa_aware) p.pin_threads = 1;
+    const size_t ncpu = tp_online_cpus();
+    const size_t T = p.num_threads ? p.num_threads : ncpu;
+
+    vv_dsp_threadpool* pool = tp_alloc(T);
+    if (!pool) return VV_DSP_ERROR_INTERNAL;
+    TP_MUTEX_SETUP(&pool->mu);
+    TP_COND_SETUP(&pool->wake);
+    TP_COND_SETUP(&pool->idle);
+    pool->threads = (tp_thread*)vv_dsp_calloc(T, sizeof(tp_thread));
+    pool->args = (tp_thread_arg*)vv_dsp_calloc(T, sizeof(tp_thread_arg));
+    int* cpus = (int*)vv_dsp_calloc(2 * ncpu, sizeof(int));
+    if (!pool->threads || !pool->args || !cpus) {
+        vv_dsp_free(cpus);
+        vv_dsp_threadpool_destroy(pool);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    // Worker k sits on CPU order[k mod n]; with NUMA awareness the order runs node by
+    // node, so neighbouring workers (which hold neighbouring index ranges) share a node
+    int* nodes = cpus + ncpu;
+    size_t n = p.numa_aware ? tp_numa_cpus(cpus, nodes, ncpu) : 0;
+    if (n == 0) {
+        for (size_t c = 0; c < ncpu; ++c) {
+            cpus[c] = (int)c;
+            nodes[c] = 0;
+        }
+        n = ncpu;
+    }
+    if (p.numa_aware) {
+        int* node_of = (int*)vv_dsp_malloc(T * sizeof(int));
+        if (node_of) {
+            for (size_t w = 0; w < T; ++w) node_of[w] = nodes[w % n];
+            tp_order_by_node(pool, node_of);
+            vv_dsp_free(node_of);
+        }
+    }
+
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t k = 1; k < T; ++k) {
+        tp_thread_arg* a = &pool->args[k];
+        a->pool = pool;
+        a->index = k;
+        a->cpu = p.pin_threads ? cpus[k % n] : -1;
+#if defined(_WIN32)
+        pool->threads[k - 1] = CreateThread(NULL, 0, tp_entry, a, 0, NULL);
+        if (!pool->threads[k - 1]) s = VV_DSP_ERROR_INTERNAL;
+#else
+        if (pthread_create(&pool->threads[k - 1], NULL, tp_entry, a) != 0) s = VV_DSP_ERROR_INTERNAL;
+#endif
+        if (s != VV_DSP_OK) break;
+        pool->started++;
+    }
+    vv_dsp_free(cpus);
+    if (s != VV_DSP_OK) {
+        vv_dsp_threadpool_destroy(pool);
+        return s;
+    }
+    *out = pool;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_threadpool_create_with_executor(const vv_dsp_executor* executor, vv_dsp_threadpool** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!executor || !executor->run) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_threadpool* pool = tp_alloc(executor->concurrency ? executor->concurrency : 1);
+    if (!pool) return VV_DSP_ERROR_INTERNAL;
+    TP_MUTEX_SETUP(&pool->mu);
+    TP_COND_SETUP(&pool->wake);
+    TP_COND_SETUP(&pool->idle);
+    pool->has_executor = 1;
+    pool->executor = *executor;
+    *out = pool;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_threadpool_destroy(vv_dsp_threadpool* pool) {
+    if (!pool) return;
+    TP_LOCK(&pool->mu);
+    pool->stop = 1;
+    TP_BROADCAST(&pool->wake);
+    TP_UNLOCK(&pool->mu);
+    for (size_t k = 0; k < pool->started; ++k) {
+#if defined(_WIN32)
+        WaitForSingleObject(pool->threads[k], INFINITE);
+        CloseHandle(pool->threads[k]);
+#else
+        pthread_join(pool->threads[k], NULL);
+#endif
+    }
+    for (size_t w = 0; w < pool->num_threads; ++w) TP_MUTEX_TEARDOWN(&pool->ranges[w].lock);
+    TP_COND_TEARDOWN(&pool->idle);
+    TP_COND_TEARDOWN(&pool->wake);
+    TP_MUTEX_TEARDOWN(&pool->mu);
+    vv_dsp_free(pool->threads);
+    vv_dsp_free(pool->args);
+    vv_dsp_free(pool->ranges);
+    vv_dsp_free(pool->victims);
+    vv_dsp_free(pool);
+}
+
+size_t vv_dsp_threadpool_num_threads(const vv_dsp_threadpool* pool) {
+    return pool ? pool->num_threads : 0;
+}
+
+// --------------- Jobs ---------------
+
+vv_dsp_status vv_dsp_threadpool_parallel_for(vv_dsp_threadpool* pool, size_t count, size_t grain,
+                                             vv_dsp_range_fn fn, void* ctx) {
+    if (!fn) return VV_DSP_ERROR_NULL_POINTER;
+    if (!pool) pool = vv_dsp_threadpool_get_default();
+    if (!pool) return VV_DSP_ERROR_INTERNAL;
+    if (count == 0) return VV_DSP_OK;
+    if (grain == 0) grain = 1;
+    const size_t T = pool->num_threads;
+
+    // One worker, one chunk or a busy pool: run here
+    if (T == 1 || count <= grain || !TP_TRY_ACQUIRE(&pool->busy)) {
+        for (size_t lo = 0; lo < count; lo += grain) fn(ctx, lo, (count - lo > grain) ? lo + grain : count, 0);
+        return VV_DSP_OK;
+    }
+
+    // Even split; the workers that run it are all idle, so no range lock is held
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->grain = grain;
+    for (size_t w = 0; w < T; ++w) {
+        pool->ranges[w].lo = count * w / T;
+        pool->ranges[w].hi = count * (w + 1) / T;
+    }
+
+    if (pool->has_executor) {
+        pool->executor.run(pool->executor.user, T, tp_executor_task, pool);
+    } else {
+        TP_LOCK(&pool->mu);
+        pool->running = T - 1;
+        pool->generation++;
+        TP_BROADCAST(&pool->wake);
+        TP_UNLOCK(&pool->mu);
+        tp_work(pool, 0);
+        TP_LOCK(&pool->mu);
+        while (pool->running) TP_WAIT(&pool->idle, &pool->mu);
+        TP_UNLOCK(&pool->mu);
+    }
+    TP_RELEASE(&pool->busy);
+    return VV_DSP_OK;
+}
+
+typedef struct {
+    vv_dsp_task_fn fn;
+    void* ctx;
+} tp_tasks;
+
+static void tp_task_range(void* ctx, size_t begin, size_t end, size_t worker) {
+    const tp_tasks* t = (const tp_tasks*)ctx;
+    (void)worker;
+    for (size_t k = begin; k < end; ++k) t->fn(t->ctx, k);
+}
+
+vv_dsp_status vv_dsp_threadpool_run(vv_dsp_threadpool* pool, size_t num_tasks, vv_dsp_task_fn fn, void* ctx) {
+    if (!fn) return VV_DSP_ERROR_NULL_POINTER;
+    tp_tasks t = {fn, ctx};
+    return vv_dsp_threadpool_parallel_for(pool, num_tasks, 1, tp_task_range, &t);
+}
+
+// --------------- Default pool ---------------
+
+static tp_mutex g_default_lock = TP_MUTEX_INIT;
+static vv_dsp_threadpool* g_default_user;  // set by the host
+static vv_dsp_threadpool* g_default_own;   // created on first use, lives to process exit
+
+vv_dsp_threadpool* vv_dsp_threadpool_get_default(void) {
+    TP_LOCK(&g_default_lock);
+    if (!g_default_user && !g_default_own) {
+        if (vv_dsp_threadpool_create(NULL, &g_default_own) != VV_DSP_OK) g_default_own = NULL;
+    }
+    vv_dsp_threadpool* pool = g_default_user ? g_default_user : g_default_own;
+    TP_UNLOCK(&g_default_lock);
+    return pool;
+}
+
+void vv_dsp_threadpool_set_default(vv_dsp_threadpool* pool) {
+    TP_LOCK(&g_default_lock);
+    g_default_user = pool;
+    TP_UNLOCK(&g_default_lock);
+}
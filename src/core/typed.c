@@ -0,0 +1,30 @@
+/**
+ * @file typed.c
+ * @brief Conversions between vv_dsp_real and explicit float / double buffers
+ */
+
+#include "vv_dsp/core/typed.h"
+
+vv_dsp_status vv_dsp_real_to_f32(const vv_dsp_real* in, float* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (float)in[i];
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_f32_to_real(const float* in, vv_dsp_real* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_real)in[i];
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_real_to_f64(const vv_dsp_real* in, double* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (double)in[i];
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_f64_to_real(const double* in, vv_dsp_real* out, size_t n) {
+    if (n && (!in || !out)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; ++i) out[i] = (vv_dsp_real)in[i];
+    return VV_DSP_OK;
+}
@@ -0,0 +1,30 @@
+/*
+This file is part of vv-dsp
+
+Private helpers for the _f32 / _f64 entry points (vv_dsp/core/typed.h). The
+variant whose sample type is not vv_dsp_real (float in double builds, double in
+float builds) is the "foreign" one: it converts through vv_dsp_real scratch and
+runs the build's kernels. VV_FOREIGN_BLOCK is the stack block of the streaming
+filters, which convert in pieces instead of allocating.
+*/
+
+#ifndef VV_DSP_CORE_TYPED_FOREIGN_H
+#define VV_DSP_CORE_TYPED_FOREIGN_H
+
+#include "vv_dsp/core/typed.h"
+
+#ifdef VV_DSP_USE_DOUBLE
+typedef float vv_foreign_real;
+typedef vv_dsp_cpx_f32 vv_foreign_cpx;
+#  define VV_FOREIGN_TO_REAL vv_dsp_f32_to_real
+#  define VV_REAL_TO_FOREIGN vv_dsp_real_to_f32
+#else
+typedef double vv_foreign_real;
+typedef vv_dsp_cpx_f64 vv_foreign_cpx;
+#  define VV_FOREIGN_TO_REAL vv_dsp_f64_to_real
+#  define VV_REAL_TO_FOREIGN vv_dsp_real_to_f64
+#endif
+
+#define VV_FOREIGN_BLOCK 256
+
+#endif /* VV_DSP_CORE_TYPED_FOREIGN_H */
@@ -0,0 +1,109 @@
+/**
+ * @file vmath.c
+ * @brief Tiered vectorized transcendentals
+ *
+ * The fast and medium tiers go through the dispatch table (simd_dispatch.h);
+ * the exact tier is a libm loop here.
+ */
+
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "simd_dispatch.h"
+
+static vv_dsp_status vm_check(const void* a, const void* b, vv_dsp_vmath_tier tier) {
+    if (!a || !b) return VV_DSP_ERROR_NULL_POINTER;
+    if ((int)tier < (int)VV_DSP_VMATH_FAST || (int)tier > (int)VV_DSP_VMATH_EXACT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vsincos(const vv_dsp_real* x, vv_dsp_real* s, vv_dsp_real* c, size_t n,
+                             vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(x, s, tier);
+    if (st != VV_DSP_OK) return st;
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) {
+            const vv_dsp_real v = x[i];
+            s[i] = VV_DSP_SIN(v);
+            c[i] = VV_DSP_COS(v);
+        }
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->sincos(x, s, c, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vsin(const vv_dsp_real* x, vv_dsp_real* y, size_t n, vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(x, y, tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) y[i] = VV_DSP_SIN(x[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->sincos(x, y, NULL, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vcos(const vv_dsp_real* x, vv_dsp_real* y, size_t n, vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(x, y, tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) y[i] = VV_DSP_COS(x[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->sincos(x, NULL, y, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vexp(const vv_dsp_real* x, vv_dsp_real* y, size_t n, vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(x, y, tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) y[i] = VV_DSP_EXP(x[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->exp(x, y, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vlog(const vv_dsp_real* x, vv_dsp_real* y, size_t n, vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(x, y, tier);
+    if (st != VV_DSP_OK) return st;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) y[i] = VV_DSP_LOG(x[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->log(x, y, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vatan2(const vv_dsp_real* y, const vv_dsp_real* x, vv_dsp_real* out, size_t n,
+                            vv_dsp_vmath_tier tier) {
+    vv_dsp_status st = vm_check(y, x, tier);
+    if (st != VV_DSP_OK) return st;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    if (tier == VV_DSP_VMATH_EXACT) {
+        for (size_t i = 0; i < n; i++) out[i] = VV_DSP_ATAN2(y[i], x[i]);
+        return VV_DSP_OK;
+    }
+    vv_dsp_simd_kernels_get()->atan2(y, x, out, n, tier == VV_DSP_VMATH_FAST);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vsqrt(const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->sqrt(x, y, n);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vphase_wrap(const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->phase_wrap(x, y, n);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_vphase_unwrap(const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_simd_kernels_get()->phase_unwrap(x, y, n);
+    return VV_DSP_OK;
+}
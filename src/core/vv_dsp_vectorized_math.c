@@ -0,0 +1,69 @@
+/**
+ * @file vv_dsp_vectorized_math.c
+ * @brief Vectorized math operations on the runtime-dispatched core kernels
+ *
+ * Argument checks live here; the loops run through the dispatch table
+ * (simd_dispatch.h), so they are vectorized at the host's best level in plain C99.
+ */
+
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "simd_dispatch.h"
+
+int vv_dsp_vectorized_math_available(void) {
+    return vv_dsp_simd_get_level() != VV_DSP_SIMD_LEVEL_SCALAR;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_window_apply(
+    const vv_dsp_real* in,
+    const vv_dsp_real* window,
+    vv_dsp_real* out,
+    size_t n
+) {
+    if (!in || !window || !out || n == 0) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    vv_dsp_simd_kernels_get()->mul(in, window, out, n);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_complex_multiply(
+    const vv_dsp_cpx* a,
+    const vv_dsp_cpx* b,
+    vv_dsp_cpx* result,
+    size_t n
+) {
+    if (!a || !b || !result || n == 0) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    vv_dsp_simd_kernels_get()->cpx_mul(a, b, result, n);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vectorized_trig_apply(
+    const vv_dsp_real* in,
+    vv_dsp_real* out,
+    size_t n,
+    int func_type
+) {
+    if (!in || !out || n == 0) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+
+    if (func_type < 0 || func_type > 2) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+#if defined(VV_DSP_USE_DOUBLE)
+    // The kernels compute in single precision; double builds keep libm here
+    for (size_t i = 0; i < n; i++)
+        out[i] = (func_type == 0) ? VV_DSP_SIN(in[i]) : (func_type == 1) ? VV_DSP_COS(in[i]) : VV_DSP_TAN(in[i]);
+#else
+    const vv_dsp_simd_kernels* k = vv_dsp_simd_kernels_get();
+    if (func_type == 2) k->tan(in, out, n);
+    else k->sincos(in, func_type == 0 ? out : NULL, func_type == 1 ? out : NULL, n, 0);
+#endif
+    return VV_DSP_OK;
+}
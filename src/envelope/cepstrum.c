@@ -1,78 +1,179 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
 #include "vv_dsp/envelope/cepstrum.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/simd_utils.h"
 #include "vv_dsp/spectral/fft.h"
 
-vv_dsp_status vv_dsp_cepstrum_real(const vv_dsp_real* x, size_t n, vv_dsp_real* out_cep) {
-    if (!x || !out_cep) return VV_DSP_ERROR_NULL_POINTER;
-    vv_dsp_fft_plan* pf = NULL; vv_dsp_fft_plan* pb = NULL;
-    if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &pf) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
-    if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &pb) != VV_DSP_OK) { vv_dsp_fft_destroy(pf); return VV_DSP_ERROR_INTERNAL; }
+struct vv_dsp_cepstrum_plan {
+    size_t n;
+    size_t nbins;             // n/2 + 1
+    vv_dsp_arena* arena;      // owner of the struct and buffers, or NULL for the heap
+    vv_dsp_fft_plan* fwd;     // R2C
+    vv_dsp_fft_plan* bwd;     // C2R
+    vv_dsp_real* buf;         // n
+    vv_dsp_cpx* spec;         // nbins
+    vv_dsp_real* tmp;         // 2 * nbins: log / exp argument, then the phase
+};
 
-    vv_dsp_cpx* xin = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    vv_dsp_cpx* X = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    vv_dsp_cpx* Y = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    if (!xin || !X || !Y) { free(xin); free(X); free(Y); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return VV_DSP_ERROR_INTERNAL; }
-    for (size_t i=0;i<n;++i) { xin[i].re = x[i]; xin[i].im = 0; }
-    vv_dsp_status s = vv_dsp_fft_execute(pf, xin, X);
-    if (s != VV_DSP_OK) { free(xin); free(X); free(Y); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return s; }
-    for (size_t k=0;k<n;++k) {
-        vv_dsp_real mag;
-        #if defined(VV_DSP_USE_DOUBLE)
-        mag = (vv_dsp_real)sqrt(X[k].re*X[k].re + X[k].im*X[k].im);
-        vv_dsp_real lm = (vv_dsp_real)log(mag + (vv_dsp_real)1e-12);
-        #else
-        mag = (vv_dsp_real)sqrtf(X[k].re*X[k].re + X[k].im*X[k].im);
-        vv_dsp_real lm = (vv_dsp_real)logf(mag + (vv_dsp_real)1e-12f);
-        #endif
-        Y[k].re = lm; Y[k].im = 0;
+void vv_dsp_cepstrum_plan_destroy(vv_dsp_cepstrum_plan* plan) {
+    if (!plan) return;
+    vv_dsp_fft_plan_release(plan->fwd);
+    vv_dsp_fft_plan_release(plan->bwd);
+    vv_dsp_scratch_free(plan->arena, plan->buf);
+    vv_dsp_scratch_free(plan->arena, plan->spec);
+    vv_dsp_scratch_free(plan->arena, plan->tmp);
+    vv_dsp_scratch_free(plan->arena, plan);
+}
+
+size_t vv_dsp_cepstrum_scratch_size(size_t n) {
+    const size_t nbins = n / 2 + 1;
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_cepstrum_plan)) +
+           vv_dsp_arena_request_size(n * sizeof(vv_dsp_real)) +
+           vv_dsp_arena_request_size(nbins * sizeof(vv_dsp_cpx)) +
+           vv_dsp_arena_request_size(2 * nbins * sizeof(vv_dsp_real));
+}
+
+vv_dsp_status vv_dsp_cepstrum_plan_create_ex(size_t n, vv_dsp_arena* arena, vv_dsp_cepstrum_plan** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_cepstrum_plan* p = (vv_dsp_cepstrum_plan*)vv_dsp_scratch_alloc(arena, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    memset(p, 0, sizeof(*p));
+    p->n = n;
+    p->nbins = n / 2 + 1;
+    p->arena = arena;
+    if (vv_dsp_fft_plan_acquire(n, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &p->fwd) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(n, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &p->bwd) != VV_DSP_OK) {
+        vv_dsp_cepstrum_plan_destroy(p);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    p->buf = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, n * sizeof(vv_dsp_real));
+    p->spec = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, p->nbins * sizeof(vv_dsp_cpx));
+    p->tmp = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, 2 * p->nbins * sizeof(vv_dsp_real));
+    if (!p->buf || !p->spec || !p->tmp) {
+        vv_dsp_cepstrum_plan_destroy(p);
+        return VV_DSP_ERROR_INTERNAL;
     }
-    vv_dsp_cpx* cpx = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    if (!cpx) { free(xin); free(X); free(Y); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return VV_DSP_ERROR_INTERNAL; }
-    s = vv_dsp_fft_execute(pb, Y, cpx);
-    if (s != VV_DSP_OK) { free(xin); free(X); free(Y); free(cpx); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return s; }
-    for (size_t i=0;i<n;++i) out_cep[i] = cpx[i].re; // imag ~ 0
-    free(xin); free(X); free(Y); free(cpx);
-    vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb);
+    *out = p;
     return VV_DSP_OK;
 }
 
-vv_dsp_status vv_dsp_icepstrum_minphase(const vv_dsp_real* c, size_t n, vv_dsp_real* out_x) {
-    if (!c || !out_x) return VV_DSP_ERROR_NULL_POINTER;
-    // Build minimum-phase spectrum via real cepstrum homomorphic property:
-    // H(z) = exp( FFT( windowed_cepstrum ) ), then IFFT to time domain
-    vv_dsp_fft_plan* pf = NULL; vv_dsp_fft_plan* pb = NULL;
-    if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &pf) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
-    if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &pb) != VV_DSP_OK) { vv_dsp_fft_destroy(pf); return VV_DSP_ERROR_INTERNAL; }
+vv_dsp_status vv_dsp_cepstrum_plan_create(size_t n, vv_dsp_cepstrum_plan** out) {
+    return vv_dsp_cepstrum_plan_create_ex(n, NULL, out);
+}
+
+size_t vv_dsp_cepstrum_plan_size(const vv_dsp_cepstrum_plan* plan) {
+    return plan ? plan->n : 0;
+}
 
-    vv_dsp_cpx* C = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    vv_dsp_cpx* H = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    vv_dsp_cpx* h = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*n);
-    if (!C || !H || !h) { free(C); free(H); free(h); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return VV_DSP_ERROR_INTERNAL; }
+// Double builds keep libm: the vector kernels are single precision
+#if defined(VV_DSP_USE_DOUBLE)
+#define CEP_TIER VV_DSP_VMATH_EXACT
+#else
+#define CEP_TIER VV_DSP_VMATH_MEDIUM
+#endif
+
+vv_dsp_status vv_dsp_cepstrum_plan_real(vv_dsp_cepstrum_plan* plan, const vv_dsp_real* x, size_t num_frames,
+                                        vv_dsp_real* out_cep) {
+    if (!plan || !x || !out_cep) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t n = plan->n, nbins = plan->nbins;
+    for (size_t f = 0; f < num_frames; ++f) {
+        vv_dsp_status s = vv_dsp_fft_execute(plan->fwd, &x[f * n], plan->spec);
+        if (s != VV_DSP_OK) return s;
+        // log |X| = 0.5 log(|X|^2 + eps^2); the squared floor is the old 1e-12 on |X|
+        s = vv_dsp_cpx_power_array(plan->spec, plan->tmp, nbins);
+        if (s != VV_DSP_OK) return s;
+        for (size_t k = 0; k < nbins; ++k) plan->tmp[k] += (vv_dsp_real)1e-24;
+        s = vv_dsp_vlog(plan->tmp, plan->tmp, nbins, CEP_TIER);
+        if (s != VV_DSP_OK) return s;
+        for (size_t k = 0; k < nbins; ++k) {
+            plan->spec[k].re = (vv_dsp_real)0.5 * plan->tmp[k];
+            plan->spec[k].im = 0;
+        }
+        s = vv_dsp_fft_execute(plan->bwd, plan->spec, &out_cep[f * n]);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
+
+// exp(FFT(fold(c))) for one frame into spec
+static vv_dsp_status cep_minphase_frame(vv_dsp_cepstrum_plan* plan, const vv_dsp_real* c, vv_dsp_cpx* spec) {
+    const size_t n = plan->n, nh = n / 2, nbins = plan->nbins;
+    vv_dsp_real* C = plan->buf;
+    memset(C, 0, n * sizeof(vv_dsp_real));
+    C[0] = c[0];
+    for (size_t i = 1; i < nh; ++i) C[i] = 2 * c[i];
+    vv_dsp_status s = vv_dsp_fft_execute(plan->fwd, C, spec);
+    if (s != VV_DSP_OK) return s;
+    vv_dsp_real* mag = plan->tmp;
+    vv_dsp_real* ph = plan->tmp + nbins;
+    for (size_t k = 0; k < nbins; ++k) {
+        mag[k] = spec[k].re;
+        ph[k] = spec[k].im;
+    }
+    s = vv_dsp_vexp(mag, mag, nbins, CEP_TIER);
+    if (s == VV_DSP_OK) s = vv_dsp_cpx_polar_to_cpx_array(mag, ph, spec, nbins, CEP_TIER);
+    return s;
+}
 
-    // Window cepstrum to keep only causal (min-phase) part: c[0], c[1..n/2-1]*2, c[n/2]=0, rest 0
-    size_t nh = n/2;
-    for (size_t i=0;i<n;++i) { C[i].re = 0; C[i].im = 0; }
-    if (n>0) C[0].re = c[0];
-    for (size_t i=1;i<nh; ++i) C[i].re = 2*c[i];
-    if (n%2==0 && nh < n) C[nh].re = 0; // Nyquist set to 0
+vv_dsp_status vv_dsp_cepstrum_plan_minphase_spectrum(vv_dsp_cepstrum_plan* plan, const vv_dsp_real* c,
+                                                     size_t num_frames, vv_dsp_cpx* out_spec) {
+    if (!plan || !c || !out_spec) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t f = 0; f < num_frames; ++f) {
+        vv_dsp_status s = cep_minphase_frame(plan, &c[f * plan->n], &out_spec[f * plan->nbins]);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
 
-    vv_dsp_status s = vv_dsp_fft_execute(pf, C, H);
-    if (s != VV_DSP_OK) { free(C); free(H); free(h); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return s; }
-    // Exponentiate: exp of complex H -> magnitude envelope; but here H is real (imag 0)
-    for (size_t k=0;k<n;++k) {
-        #if defined(VV_DSP_USE_DOUBLE)
-        vv_dsp_real er = (vv_dsp_real)exp(H[k].re);
-        #else
-        vv_dsp_real er = (vv_dsp_real)expf(H[k].re);
-        #endif
-        H[k].re = er; H[k].im = 0;
+vv_dsp_status vv_dsp_cepstrum_plan_minphase(vv_dsp_cepstrum_plan* plan, const vv_dsp_real* c, size_t num_frames,
+                                            vv_dsp_real* out_x) {
+    if (!plan || !c || !out_x) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t f = 0; f < num_frames; ++f) {
+        vv_dsp_status s = cep_minphase_frame(plan, &c[f * plan->n], plan->spec);
+        if (s != VV_DSP_OK) return s;
+        s = vv_dsp_fft_execute(plan->bwd, plan->spec, &out_x[f * plan->n]);
+        if (s != VV_DSP_OK) return s;
     }
-    s = vv_dsp_fft_execute(pb, H, h);
-    if (s != VV_DSP_OK) { free(C); free(H); free(h); vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb); return s; }
-    for (size_t i=0;i<n;++i) out_x[i] = h[i].re; // min-phase time signal
-    free(C); free(H); free(h);
-    vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pb);
     return VV_DSP_OK;
 }
+
+vv_dsp_status vv_dsp_cepstrum_real_ex(const vv_dsp_real* x, size_t n, vv_dsp_real* out_cep, vv_dsp_arena* arena) {
+    if (!x || !out_cep) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_cepstrum_plan* plan = NULL;
+    vv_dsp_status s = VV_DSP_ERROR_INTERNAL;
+    if (vv_dsp_cepstrum_plan_create_ex(n, arena, &plan) == VV_DSP_OK) {
+        s = vv_dsp_cepstrum_plan_real(plan, x, 1, out_cep);
+        vv_dsp_cepstrum_plan_destroy(plan);
+    }
+    vv_dsp_arena_reset_to(arena, mark);
+    return s;
+}
+
+vv_dsp_status vv_dsp_cepstrum_real(const vv_dsp_real* x, size_t n, vv_dsp_real* out_cep) {
+    return vv_dsp_cepstrum_real_ex(x, n, out_cep, NULL);
+}
+
+vv_dsp_status vv_dsp_icepstrum_minphase_ex(const vv_dsp_real* c, size_t n, vv_dsp_real* out_x,
+                                           vv_dsp_arena* arena) {
+    if (!c || !out_x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_cepstrum_plan* plan = NULL;
+    vv_dsp_status s = VV_DSP_ERROR_INTERNAL;
+    if (vv_dsp_cepstrum_plan_create_ex(n, arena, &plan) == VV_DSP_OK) {
+        s = vv_dsp_cepstrum_plan_minphase(plan, c, 1, out_x);
+        vv_dsp_cepstrum_plan_destroy(plan);
+    }
+    vv_dsp_arena_reset_to(arena, mark);
+    return s;
+}
+
+vv_dsp_status vv_dsp_icepstrum_minphase(const vv_dsp_real* c, size_t n, vv_dsp_real* out_x) {
+    return vv_dsp_icepstrum_minphase_ex(c, n, out_x, NULL);
+}
@@ -0,0 +1,304 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/envelope/cheaptrick.h"
+#include "vv_dsp/core/simd_core.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/alloc.h"
+#include "../spectral/parallel.h"
+
+#define CT_MIN_RUN 4          // frames per worker before another worker is worth waking
+#define CT_POWER_FLOOR 1e-30  // keeps the log finite where smoothing cancels to zero
+
+typedef struct {
+    vv_dsp_fft_plan* fwd;  // R2C, private to the worker
+    vv_dsp_fft_plan* bwd;  // C2R
+    vv_dsp_real* wave;     // fft_size: windowed frame, later the cepstrum
+    vv_dsp_real* win;      // longest window
+    vv_dsp_real* tmp;      // nbins
+    vv_dsp_cpx* spec;      // nbins
+    double* power;         // nbins
+    double* seg;           // nbins + 2 * max boundary: DC replica, then cumulative spectrum
+} ct_scratch;
+
+struct vv_dsp_cheaptrick_plan {
+    double fs;
+    double f0_floor;
+    double f0_ceil;
+    double q1;
+    size_t fft_size;
+    size_t nbins;
+    size_t num_workers;
+    ct_scratch* scratch;    // one per worker
+    vv_dsp_status* status;  // one per worker
+
+    // Current process call
+    const vv_dsp_real* x;
+    size_t n;
+    size_t hop;
+    const vv_dsp_real* f0;
+    size_t num_frames;
+    size_t run;
+    vv_dsp_real* out;
+};
+
+static long ct_round(double v) {
+    return (long)floor(v + 0.5);
+}
+
+// Double builds keep libm: the fast kernels are single precision
+static void ct_log(vv_dsp_real* x, size_t n) {
+#if defined(VV_DSP_USE_DOUBLE)
+    for (size_t i = 0; i < n; ++i) x[i] = VV_DSP_LOG(x[i]);
+#else
+    (void)vv_dsp_log_real_fast(x, x, n);
+#endif
+}
+
+static void ct_exp(vv_dsp_real* x, size_t n) {
+#if defined(VV_DSP_USE_DOUBLE)
+    for (size_t i = 0; i < n; ++i) x[i] = VV_DSP_EXP(x[i]);
+#else
+    (void)vv_dsp_exp_real_fast(x, x, n);
+#endif
+}
+
+// Linear interpolation of y (ny >= 2 points at x0 + i * dx) at xi, clamped to the ends
+static double ct_interp(const double* y, size_t ny, double x0, double dx, double xi) {
+    const double pos = (xi - x0) / dx;
+    double fl = floor(pos);
+    if (fl < 0) fl = 0;
+    if (fl > (double)(ny - 2)) fl = (double)(ny - 2);
+    const size_t i = (size_t)fl;
+    return y[i] + (y[i + 1] - y[i]) * (pos - fl);
+}
+
+void vv_dsp_cheaptrick_plan_destroy(vv_dsp_cheaptrick_plan* plan) {
+    if (!plan) return;
+    if (plan->scratch) {
+        for (size_t w = 0; w < plan->num_workers; ++w) {
+            ct_scratch* s = &plan->scratch[w];
+            vv_dsp_fft_plan_release(s->fwd);
+            vv_dsp_fft_plan_release(s->bwd);
+            vv_dsp_aligned_free(s->wave);
+            vv_dsp_aligned_free(s->win);
+            vv_dsp_aligned_free(s->tmp);
+            vv_dsp_aligned_free(s->spec);
+            vv_dsp_aligned_free(s->power);
+            vv_dsp_aligned_free(s->seg);
+        }
+        vv_dsp_free(plan->scratch);
+    }
+    vv_dsp_free(plan->status);
+    vv_dsp_free(plan);
+}
+
+static void* ct_alloc(size_t bytes) {
+    return vv_dsp_aligned_malloc(bytes, VV_DSP_SIMD_ALIGN_DEFAULT);
+}
+
+vv_dsp_status vv_dsp_cheaptrick_plan_create(const vv_dsp_cheaptrick_params* params, vv_dsp_cheaptrick_plan** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const double fs = (double)params->sample_rate;
+    const double floor_hz = params->f0_floor > 0 ? (double)params->f0_floor : (double)VV_DSP_CHEAPTRICK_DEFAULT_F0_FLOOR;
+    if (!(fs > 0) || floor_hz >= fs / 4) return VV_DSP_ERROR_OUT_OF_RANGE;
+    size_t fft_size = params->fft_size;
+    if (fft_size == 0) {
+        fft_size = (size_t)1 << (1 + (int)floor(log2(3.0 * fs / floor_hz)));
+    }
+    const size_t max_win = 2 * (size_t)ct_round(1.5 * fs / floor_hz) + 1;
+    if (fft_size < max_win || fft_size < 8) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_cheaptrick_plan* p = (vv_dsp_cheaptrick_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->fs = fs;
+    p->f0_floor = floor_hz;
+    p->f0_ceil = fs / 4;
+    p->q1 = (double)params->q1;
+    p->fft_size = fft_size;
+    p->nbins = fft_size / 2 + 1;
+    p->num_workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+    if (p->num_workers == 0) p->num_workers = 1;
+    p->scratch = (ct_scratch*)vv_dsp_calloc(p->num_workers, sizeof(ct_scratch));
+    p->status = (vv_dsp_status*)vv_dsp_malloc(p->num_workers * sizeof(vv_dsp_status));
+    if (!p->scratch || !p->status) { vv_dsp_cheaptrick_plan_destroy(p); return VV_DSP_ERROR_INTERNAL; }
+
+    // Smoothing boundary at the F0 ceiling: (2/3 * fs/4) / (fs / fft_size) + 1
+    const size_t max_boundary = fft_size / 6 + 1;
+    for (size_t w = 0; w < p->num_workers; ++w) {
+        ct_scratch* s = &p->scratch[w];
+        if (vv_dsp_fft_plan_acquire(fft_size, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &s->fwd) != VV_DSP_OK ||
+            vv_dsp_fft_plan_acquire(fft_size, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &s->bwd) != VV_DSP_OK) {
+            vv_dsp_cheaptrick_plan_destroy(p);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        s->wave = (vv_dsp_real*)ct_alloc(fft_size * sizeof(vv_dsp_real));
+        s->win = (vv_dsp_real*)ct_alloc(max_win * sizeof(vv_dsp_real));
+        s->tmp = (vv_dsp_real*)ct_alloc(p->nbins * sizeof(vv_dsp_real));
+        s->spec = (vv_dsp_cpx*)ct_alloc(p->nbins * sizeof(vv_dsp_cpx));
+        s->power = (double*)ct_alloc(p->nbins * sizeof(double));
+        s->seg = (double*)ct_alloc((p->nbins + 2 * max_boundary) * sizeof(double));
+        if (!s->wave || !s->win || !s->tmp || !s->spec || !s->power || !s->seg) {
+            vv_dsp_cheaptrick_plan_destroy(p);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    *out = p;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_cheaptrick_fft_size(const vv_dsp_cheaptrick_plan* plan) {
+    return plan ? plan->fft_size : 0;
+}
+
+// Hann window over three periods (normalised to unit energy) with the window-weighted
+// mean removed, zero-padded to fft_size
+static void ct_windowed_frame(const vv_dsp_cheaptrick_plan* p, ct_scratch* s, size_t center, double f0) {
+    const size_t half = (size_t)ct_round(1.5 * p->fs / f0);
+    const size_t len = 2 * half + 1;
+    // cos(b * beta) by rotation; double keeps the drift far below float resolution
+    const double beta = VV_DSP_PI_D * f0 / (1.5 * p->fs);
+    const double cb = cos(beta), sb = sin(beta);
+    double c = 1.0, sn = 0.0, energy = 0.0;
+    for (size_t b = 0; b <= half; ++b) {
+        const double wv = 0.5 * c + 0.5;
+        s->win[half + b] = (vv_dsp_real)wv;
+        s->win[half - b] = (vv_dsp_real)wv;
+        energy += (b ? 2.0 : 1.0) * wv * wv;
+        const double c2 = c * cb - sn * sb;
+        sn = sn * cb + c * sb;
+        c = c2;
+    }
+    const double norm = 1.0 / sqrt(energy);
+    double sum_x = 0.0, sum_w = 0.0;
+    for (size_t i = 0; i < len; ++i) {
+        const vv_dsp_real wv = (vv_dsp_real)((double)s->win[i] * norm);
+        s->win[i] = wv;
+        long idx = (long)center + (long)i - (long)half;
+        if (idx < 0) idx = 0;
+        if (idx >= (long)p->n) idx = (long)p->n - 1;
+        s->wave[i] = p->x[idx] * wv;
+        sum_x += (double)s->wave[i];
+        sum_w += (double)wv;
+    }
+    const vv_dsp_real mean = (vv_dsp_real)(sum_x / sum_w);
+    for (size_t i = 0; i < len; ++i) s->wave[i] -= s->win[i] * mean;
+    memset(&s->wave[len], 0, (p->fft_size - len) * sizeof(vv_dsp_real));
+}
+
+// Fold the spectrum below F0 back onto itself: P(f) += P(f0 - f) for f < f0
+static void ct_dc_correction(const vv_dsp_cheaptrick_plan* p, ct_scratch* s, double f0) {
+    const double df = p->fs / (double)p->fft_size;
+    const size_t count = 1 + (size_t)(f0 / df);
+    for (size_t i = 0; i < count; ++i) s->seg[i] = ct_interp(s->power, p->nbins, 0.0, df, f0 - (double)i * df);
+    for (size_t i = 0; i < count; ++i) s->power[i] += s->seg[i];
+}
+
+// Rectangular smoothing of width 2/3 F0 via the cumulative spectrum, mirrored at both ends
+static void ct_smooth(const vv_dsp_cheaptrick_plan* p, ct_scratch* s, double f0) {
+    const size_t N = p->fft_size, nh = N / 2;
+    const double df = p->fs / (double)N;
+    const double width = 2.0 * f0 / 3.0;
+    const size_t boundary = (size_t)(width / df) + 1;
+    const size_t len = nh + 2 * boundary + 1;
+    double acc = 0.0;
+    for (size_t j = 0; j < len; ++j) {
+        double v;
+        if (j < boundary) v = s->power[boundary - j];
+        else if (j < nh + boundary) v = s->power[j - boundary];
+        else v = s->power[nh - (j - (nh + boundary))];
+        acc += v * df;
+        s->seg[j] = acc;
+    }
+    const double origin = -((double)boundary - 0.5) * df;
+    for (size_t k = 0; k <= nh; ++k) {
+        const double f = (double)k * df - width / 2.0;
+        const double lo = ct_interp(s->seg, len, origin, df, f);
+        const double hi = ct_interp(s->seg, len, origin, df, f + width);
+        const double v = (hi - lo) / width;
+        s->tmp[k] = (vv_dsp_real)(v > CT_POWER_FLOOR ? v : CT_POWER_FLOOR);
+    }
+}
+
+// log -> cepstrum -> smoothing and recovery lifters -> spectrum -> exp, into out
+static vv_dsp_status ct_recover(const vv_dsp_cheaptrick_plan* p, ct_scratch* s, double f0, vv_dsp_real* out) {
+    const size_t N = p->fft_size, nh = N / 2, nbins = p->nbins;
+    ct_log(s->tmp, nbins);
+    for (size_t k = 0; k < nbins; ++k) {
+        s->spec[k].re = s->tmp[k];
+        s->spec[k].im = 0;
+    }
+    vv_dsp_status st = vv_dsp_fft_execute(s->bwd, s->spec, s->wave);
+    if (st != VV_DSP_OK) return st;
+
+    // sin(i a) / (i a) * ((1 - 2 q1) + 2 q1 cos(2 i a)), a = pi f0 / fs
+    const double a = VV_DSP_PI_D * f0 / p->fs;
+    const double ca = cos(a), sa = sin(a);
+    double c = 1.0, sn = 0.0;
+    for (size_t i = 1; i <= nh; ++i) {
+        const double c2 = c * ca - sn * sa;
+        sn = sn * ca + c * sa;
+        c = c2;
+        const double lift = sn / ((double)i * a) * ((1.0 - 2.0 * p->q1) + 2.0 * p->q1 * (2.0 * c * c - 1.0));
+        s->wave[i] *= (vv_dsp_real)lift;
+        if (i < N - i) s->wave[N - i] *= (vv_dsp_real)lift;
+    }
+
+    st = vv_dsp_fft_execute(s->fwd, s->wave, s->spec);
+    if (st != VV_DSP_OK) return st;
+    for (size_t k = 0; k < nbins; ++k) out[k] = s->spec[k].re;
+    ct_exp(out, nbins);
+    return VV_DSP_OK;
+}
+
+static void ct_worker(void* ctx, size_t w) {
+    vv_dsp_cheaptrick_plan* p = (vv_dsp_cheaptrick_plan*)ctx;
+    ct_scratch* s = &p->scratch[w];
+    const size_t f_begin = w * p->run;
+    const size_t f_end = (f_begin + p->run < p->num_frames) ? f_begin + p->run : p->num_frames;
+    vv_dsp_status st = VV_DSP_OK;
+    for (size_t f = f_begin; st == VV_DSP_OK && f < f_end; ++f) {
+        double f0 = (double)p->f0[f];
+        if (!(f0 > 0)) f0 = (double)VV_DSP_CHEAPTRICK_UNVOICED_F0;
+        if (f0 < p->f0_floor) f0 = p->f0_floor;
+        if (f0 > p->f0_ceil) f0 = p->f0_ceil;
+
+        ct_windowed_frame(p, s, f * p->hop, f0);
+        st = vv_dsp_fft_execute(s->fwd, s->wave, s->spec);
+        if (st != VV_DSP_OK) break;
+        for (size_t k = 0; k < p->nbins; ++k) {
+            s->power[k] = (double)s->spec[k].re * (double)s->spec[k].re + (double)s->spec[k].im * (double)s->spec[k].im;
+        }
+        ct_dc_correction(p, s, f0);
+        ct_smooth(p, s, f0);
+        st = ct_recover(p, s, f0, &p->out[f * p->nbins]);
+    }
+    p->status[w] = st;
+}
+
+vv_dsp_status vv_dsp_cheaptrick_process(vv_dsp_cheaptrick_plan* plan, const vv_dsp_real* x, size_t n, size_t hop,
+                                        const vv_dsp_real* f0, size_t num_frames, vv_dsp_real* out) {
+    if (!plan || !x || !f0 || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0 || num_frames == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    size_t run = (num_frames + plan->num_workers - 1) / plan->num_workers;
+    if (run < CT_MIN_RUN) run = CT_MIN_RUN;
+    const size_t workers = (num_frames + run - 1) / run;
+
+    plan->x = x;
+    plan->n = n;
+    plan->hop = hop;
+    plan->f0 = f0;
+    plan->num_frames = num_frames;
+    plan->run = run;
+    plan->out = out;
+    vv_dsp_status s = vv_dsp_parallel_run(workers, ct_worker, plan);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; ++w) s = plan->status[w];
+    plan->x = NULL;
+    plan->f0 = NULL;
+    plan->out = NULL;
+    return s;
+}
@@ -3,6 +3,11 @@
 #include <math.h>
 #include "vv_dsp/vv_dsp_math.h"
 #include "vv_dsp/envelope/lpc.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/alloc.h"
+#include "../spectral/parallel.h"
 
 vv_dsp_status vv_dsp_autocorr(const vv_dsp_real* x, size_t n, size_t order, vv_dsp_real* r_out) {
     if (!x || !r_out) return VV_DSP_ERROR_NULL_POINTER;
@@ -18,11 +23,11 @@ vv_dsp_status vv_dsp_autocorr(const vv_dsp_real* x, size_t n, size_t order, vv_d
 vv_dsp_status vv_dsp_levinson(const vv_dsp_real* r, size_t order, vv_dsp_real* a_out, vv_dsp_real* err_out) {
     if (!r || !a_out || !err_out) return VV_DSP_ERROR_NULL_POINTER;
     // Levinson-Durbin recursion
-    vv_dsp_real* a = (vv_dsp_real*)calloc(order+1, sizeof(vv_dsp_real));
-    vv_dsp_real* a_prev = (vv_dsp_real*)calloc(order+1, sizeof(vv_dsp_real));
-    if (!a || !a_prev) { free(a); free(a_prev); return VV_DSP_ERROR_INTERNAL; }
+    vv_dsp_real* a = (vv_dsp_real*)vv_dsp_calloc(order+1, sizeof(vv_dsp_real));
+    vv_dsp_real* a_prev = (vv_dsp_real*)vv_dsp_calloc(order+1, sizeof(vv_dsp_real));
+    if (!a || !a_prev) { vv_dsp_free(a); vv_dsp_free(a_prev); return VV_DSP_ERROR_INTERNAL; }
     vv_dsp_real e = r[0];
-    if (e <= 0) { free(a); free(a_prev); return VV_DSP_ERROR_INTERNAL; }
+    if (e <= 0) { vv_dsp_free(a); vv_dsp_free(a_prev); return VV_DSP_ERROR_INTERNAL; }
     for (size_t m=1; m<=order; ++m) {
         vv_dsp_real acc = r[m];
         for (size_t i=1;i<m;++i) acc += a_prev[i]*r[m-i];
@@ -36,37 +41,240 @@ vv_dsp_status vv_dsp_levinson(const vv_dsp_real* r, size_t order, vv_dsp_real* a
     }
     for (size_t i=0;i<=order;++i) a_out[i] = a_prev[i];
     *err_out = e;
-    free(a); free(a_prev);
+    vv_dsp_free(a); vv_dsp_free(a_prev);
     return VV_DSP_OK;
 }
 
 vv_dsp_status vv_dsp_lpc(const vv_dsp_real* x, size_t n, size_t order, vv_dsp_real* a_out, vv_dsp_real* err_out) {
     if (!x || !a_out || !err_out) return VV_DSP_ERROR_NULL_POINTER;
     if (order+1 > n) return VV_DSP_ERROR_INVALID_SIZE;
-    vv_dsp_real* r = (vv_dsp_real*)malloc(sizeof(vv_dsp_real)*(order+1));
+    vv_dsp_real* r = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real)*(order+1));
     if (!r) return VV_DSP_ERROR_INTERNAL;
     vv_dsp_status s = vv_dsp_autocorr(x, n, order, r);
-    if (s != VV_DSP_OK) { free(r); return s; }
+    if (s != VV_DSP_OK) { vv_dsp_free(r); return s; }
     s = vv_dsp_levinson(r, order, a_out, err_out);
-    free(r);
+    vv_dsp_free(r);
+    return s;
+}
+
+// A(e^{jw}) at nfft points is the DFT of a[] zero-padded to nfft; taps past nfft
+// alias onto i mod nfft, which is exactly what sampling the polynomial gives.
+static vv_dsp_status lpspec_frame(const vv_dsp_fft_plan* plan, const vv_dsp_real* a, size_t order,
+                                  vv_dsp_real gain, size_t nfft, vv_dsp_real* buf, vv_dsp_cpx* spec,
+                                  vv_dsp_real* mag_out) {
+    memset(buf, 0, nfft * sizeof(vv_dsp_real));
+    buf[0] = 1;
+    for (size_t m = 1; m <= order; ++m) buf[m % nfft] += a[m];
+    vv_dsp_status s = vv_dsp_fft_execute(plan, buf, spec);
+    if (s != VV_DSP_OK) return s;
+    s = vv_dsp_cpx_abs_array(spec, mag_out, nfft / 2 + 1);
+    if (s != VV_DSP_OK) return s;
+    for (size_t k = 0; k <= nfft / 2; ++k) {
+        mag_out[k] = (mag_out[k] > (vv_dsp_real)0) ? (gain / mag_out[k]) : (vv_dsp_real)0;
+    }
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status lpspec_run(const vv_dsp_real* a, size_t order, const vv_dsp_real* gains,
+                                vv_dsp_real gain, size_t num_frames, size_t nfft, vv_dsp_real* mag_out) {
+    vv_dsp_fft_plan* plan = NULL;
+    if (vv_dsp_fft_plan_acquire(nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_real* buf = (vv_dsp_real*)vv_dsp_malloc(nfft * sizeof(vv_dsp_real));
+    vv_dsp_cpx* spec = (vv_dsp_cpx*)vv_dsp_malloc((nfft / 2 + 1) * sizeof(vv_dsp_cpx));
+    vv_dsp_status s = (buf && spec) ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    for (size_t f = 0; s == VV_DSP_OK && f < num_frames; ++f) {
+        s = lpspec_frame(plan, &a[f * (order + 1)], order, gains ? gains[f] : gain, nfft, buf, spec,
+                         &mag_out[f * (nfft / 2 + 1)]);
+    }
+    vv_dsp_free(buf); vv_dsp_free(spec);
+    vv_dsp_fft_plan_release(plan);
     return s;
 }
 
 vv_dsp_status vv_dsp_lpspec(const vv_dsp_real* a, size_t order, vv_dsp_real gain, size_t nfft, vv_dsp_real* mag_out) {
     if (!a || !mag_out) return VV_DSP_ERROR_NULL_POINTER;
-    for (size_t k=0;k<nfft;++k) {
-        // Evaluate A(e^{j*2pi*k/nfft}) magnitude
-        vv_dsp_real theta = (vv_dsp_real)(VV_DSP_TWO_PI * (vv_dsp_real)k / (vv_dsp_real)nfft);
-        vv_dsp_real re = (vv_dsp_real)1.0, im = (vv_dsp_real)0.0;
-        for (size_t m=1; m<=order; ++m) {
-            vv_dsp_real ang = (vv_dsp_real)m * theta;
-            vv_dsp_real cr = VV_DSP_COS(ang);
-            vv_dsp_real sr = VV_DSP_SIN(ang);
-            re += a[m]*(-cr);
-            im += a[m]*(-sr);
+    if (nfft == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    return lpspec_run(a, order, NULL, gain, 1, nfft, mag_out);
+}
+
+vv_dsp_status vv_dsp_lpspec_batch(const vv_dsp_real* a, size_t order, const vv_dsp_real* gains,
+                                  size_t num_frames, size_t nfft, vv_dsp_real* mag_out) {
+    if (!a || !mag_out) return VV_DSP_ERROR_NULL_POINTER;
+    if (nfft == 0 || num_frames == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    return lpspec_run(a, order, gains, (vv_dsp_real)1, num_frames, nfft, mag_out);
+}
+
+// ---- Batch plan ----
+
+#define LPC_PLAN_MIN_RUN 32  // frames per worker before another worker is worth waking
+
+typedef struct {
+    vv_dsp_real* frame;   // frame_len + order, tail kept at zero so every lag reads the same range
+    vv_dsp_real* r;       // order + 1
+    vv_dsp_real* a;       // order + 1
+    vv_dsp_real* a_prev;  // order + 1
+} lpc_scratch;
+
+struct vv_dsp_lpc_plan {
+    size_t order;
+    size_t frame_len;
+    vv_dsp_real preemphasis;
+    vv_dsp_real* window;  // NULL = rectangular
+    size_t num_workers;
+    lpc_scratch* scratch;  // one per worker
+    vv_dsp_status* status; // one per worker
+
+    // Current process call
+    const vv_dsp_real* x;
+    size_t num_frames;
+    size_t stride;
+    size_t run;
+    vv_dsp_real* a_out;
+    vv_dsp_real* k_out;
+    vv_dsp_real* err_out;
+};
+
+void vv_dsp_lpc_plan_destroy(vv_dsp_lpc_plan* plan) {
+    if (!plan) return;
+    if (plan->scratch) {
+        for (size_t w = 0; w < plan->num_workers; ++w) {
+            vv_dsp_aligned_free(plan->scratch[w].frame);
+            vv_dsp_aligned_free(plan->scratch[w].r);
+            vv_dsp_aligned_free(plan->scratch[w].a);
+            vv_dsp_aligned_free(plan->scratch[w].a_prev);
         }
-        vv_dsp_real den = (vv_dsp_real)sqrt((double)(re*re + im*im));
-        mag_out[k] = (den > (vv_dsp_real)0) ? (gain/den) : (vv_dsp_real)0;
+        vv_dsp_free(plan->scratch);
+    }
+    vv_dsp_aligned_free(plan->window);
+    vv_dsp_free(plan->status);
+    vv_dsp_free(plan);
+}
+
+static vv_dsp_real* lpc_alloc(size_t n) {
+    vv_dsp_real* p = (vv_dsp_real*)vv_dsp_aligned_malloc(n * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (p) memset(p, 0, n * sizeof(vv_dsp_real));
+    return p;
+}
+
+vv_dsp_status vv_dsp_lpc_plan_create(const vv_dsp_lpc_params* params, vv_dsp_lpc_plan** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (params->order == 0 || params->order >= params->frame_len) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_lpc_plan* p = (vv_dsp_lpc_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->order = params->order;
+    p->frame_len = params->frame_len;
+    p->preemphasis = params->preemphasis;
+    p->num_workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+    if (p->num_workers == 0) p->num_workers = 1;
+
+    p->scratch = (lpc_scratch*)vv_dsp_calloc(p->num_workers, sizeof(lpc_scratch));
+    p->status = (vv_dsp_status*)vv_dsp_malloc(p->num_workers * sizeof(vv_dsp_status));
+    if (!p->scratch || !p->status) { vv_dsp_lpc_plan_destroy(p); return VV_DSP_ERROR_INTERNAL; }
+    if (params->window) {
+        p->window = lpc_alloc(p->frame_len);
+        if (!p->window) { vv_dsp_lpc_plan_destroy(p); return VV_DSP_ERROR_INTERNAL; }
+        memcpy(p->window, params->window, p->frame_len * sizeof(vv_dsp_real));
+    }
+    for (size_t w = 0; w < p->num_workers; ++w) {
+        lpc_scratch* s = &p->scratch[w];
+        s->frame = lpc_alloc(p->frame_len + p->order);
+        s->r = lpc_alloc(p->order + 1);
+        s->a = lpc_alloc(p->order + 1);
+        s->a_prev = lpc_alloc(p->order + 1);
+        if (!s->frame || !s->r || !s->a || !s->a_prev) { vv_dsp_lpc_plan_destroy(p); return VV_DSP_ERROR_INTERNAL; }
     }
+    *out = p;
     return VV_DSP_OK;
 }
+
+// One frame: condition into scratch, autocorrelate, Levinson-Durbin. Arithmetic
+// matches vv_dsp_autocorr/vv_dsp_levinson term for term; the zero tail only adds
+// exact zeros past each lag's last product.
+static void lpc_plan_frame(const vv_dsp_lpc_plan* p, lpc_scratch* s, const vv_dsp_real* in,
+                           vv_dsp_real* a_out, vv_dsp_real* k_out, vv_dsp_real* err_out) {
+    const size_t n = p->frame_len, order = p->order;
+    vv_dsp_real* x = s->frame;
+    if (p->preemphasis != (vv_dsp_real)0) {
+        x[0] = in[0];
+        for (size_t i = 1; i < n; ++i) x[i] = in[i] - p->preemphasis * in[i - 1];
+    } else {
+        memcpy(x, in, n * sizeof(vv_dsp_real));
+    }
+    if (p->window) {
+        for (size_t i = 0; i < n; ++i) x[i] *= p->window[i];
+    }
+
+    // Lags in the inner loop: independent accumulators, contiguous reads.
+    vv_dsp_real* r = s->r;
+    memset(r, 0, (order + 1) * sizeof(vv_dsp_real));
+    for (size_t i = 0; i < n; ++i) {
+        const vv_dsp_real xi = x[i];
+        const vv_dsp_real* xk = &x[i];
+        for (size_t k = 0; k <= order; ++k) r[k] += xi * xk[k];
+    }
+
+    vv_dsp_real* a = s->a;
+    vv_dsp_real* a_prev = s->a_prev;
+    memset(a, 0, (order + 1) * sizeof(vv_dsp_real));
+    memset(a_prev, 0, (order + 1) * sizeof(vv_dsp_real));
+    vv_dsp_real e = r[0];
+    if (!(e > 0)) {
+        a_out[0] = 1;
+        for (size_t i = 1; i <= order; ++i) a_out[i] = 0;
+        if (k_out) memset(k_out, 0, order * sizeof(vv_dsp_real));
+        if (err_out) *err_out = 0;
+        return;
+    }
+    for (size_t m = 1; m <= order; ++m) {
+        vv_dsp_real acc = r[m];
+        for (size_t i = 1; i < m; ++i) acc += a_prev[i] * r[m - i];
+        vv_dsp_real k = -acc / e;
+        a[0] = 1;
+        a[m] = k;
+        for (size_t i = 1; i < m; ++i) a[i] = a_prev[i] + k * a_prev[m - i];
+        e *= (1 - k * k);
+        memcpy(a_prev, a, (m + 1) * sizeof(vv_dsp_real));
+        if (k_out) k_out[m - 1] = k;
+    }
+    memcpy(a_out, a_prev, (order + 1) * sizeof(vv_dsp_real));
+    if (err_out) *err_out = e;
+}
+
+static void lpc_plan_worker(void* ctx, size_t w) {
+    vv_dsp_lpc_plan* p = (vv_dsp_lpc_plan*)ctx;
+    const size_t order = p->order;
+    const size_t f0 = w * p->run;
+    const size_t f1 = (f0 + p->run < p->num_frames) ? f0 + p->run : p->num_frames;
+    for (size_t f = f0; f < f1; ++f) {
+        lpc_plan_frame(p, &p->scratch[w], &p->x[f * p->stride], &p->a_out[f * (order + 1)],
+                       p->k_out ? &p->k_out[f * order] : NULL,
+                       p->err_out ? &p->err_out[f] : NULL);
+    }
+    p->status[w] = VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_lpc_plan_process(vv_dsp_lpc_plan* plan, const vv_dsp_real* x, size_t num_frames,
+                                      size_t stride, vv_dsp_real* a_out, vv_dsp_real* k_out,
+                                      vv_dsp_real* err_out) {
+    if (!plan || !x || !a_out) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0 || stride == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    size_t run = (num_frames + plan->num_workers - 1) / plan->num_workers;
+    if (run < LPC_PLAN_MIN_RUN) run = LPC_PLAN_MIN_RUN;
+    const size_t workers = (num_frames + run - 1) / run;
+
+    plan->x = x;
+    plan->num_frames = num_frames;
+    plan->stride = stride;
+    plan->run = run;
+    plan->a_out = a_out;
+    plan->k_out = k_out;
+    plan->err_out = err_out;
+    vv_dsp_status s = vv_dsp_parallel_run(workers, lpc_plan_worker, plan);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; ++w) s = plan->status[w];
+    plan->x = NULL;
+    plan->a_out = plan->k_out = plan->err_out = NULL;
+    return s;
+}
@@ -0,0 +1,246 @@
+#include "vv_dsp/features/deltas.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Row pointers live on the stack, which bounds the regression width
+#define DELTAS_MAX_WIDTH 64
+
+// One regression stage: a ring of 2N+1 frames of `width` values, left-padded with
+// copies of the first frame. Once full, each push emits the centre frame followed by
+// the delta of its [off, off + dim) slice. The delta-delta stage runs the same code
+// on [c | delta] frames, so the centre carries the matching static values.
+typedef struct {
+    size_t width;
+    size_t off;
+    size_t dim;
+    size_t len;          // 2N + 1
+    size_t head;         // oldest slot
+    size_t filled;       // frames in the ring
+    vv_dsp_real* ring;   // len x width
+} delta_stage;
+
+struct vv_dsp_deltas {
+    size_t n_coeffs;
+    size_t order;
+    size_t N;
+    vv_dsp_real norm;    // 1 / (2 sum n^2)
+    uint64_t frames;     // pushed since the last reset
+    delta_stage stage[2];
+    vv_dsp_real* mid;    // 2 * n_coeffs, first stage output feeding the second
+};
+
+static vv_dsp_real delta_norm(size_t N) {
+    double s = 0.0;
+    for (size_t n = 1; n <= N; ++n) s += (double)n * (double)n;
+    return (vv_dsp_real)(1.0 / (2.0 * s));
+}
+
+// d = norm * sum_n n (plus[n-1] - minus[n-1]) over dim values; the rows are whatever
+// frames sit n steps either side, so batch and ring share the kernel
+static void regress(const vv_dsp_real* const* plus, const vv_dsp_real* const* minus, size_t N, size_t dim,
+                    vv_dsp_real norm, vv_dsp_real* d) {
+    for (size_t j = 0; j < dim; ++j) d[j] = 0;
+    for (size_t n = 1; n <= N; ++n) {
+        const vv_dsp_real* xp = plus[n - 1];
+        const vv_dsp_real* xm = minus[n - 1];
+        const vv_dsp_real g = (vv_dsp_real)n;
+        for (size_t j = 0; j < dim; ++j) d[j] += g * (xp[j] - xm[j]);
+    }
+    for (size_t j = 0; j < dim; ++j) d[j] *= norm;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_compute(const vv_dsp_real* in,
+                                                     size_t num_frames,
+                                                     size_t n_coeffs,
+                                                     size_t width,
+                                                     vv_dsp_real* out) {
+    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0 || n_coeffs == 0 || width == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (width > DELTAS_MAX_WIDTH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const vv_dsp_real* plus[DELTAS_MAX_WIDTH];
+    const vv_dsp_real* minus[DELTAS_MAX_WIDTH];
+    const vv_dsp_real norm = delta_norm(width);
+    const size_t T = num_frames, C = n_coeffs;
+    for (size_t t = 0; t < T; ++t) {
+        for (size_t n = 1; n <= width; ++n) {
+            plus[n - 1] = in + ((t + n < T) ? t + n : T - 1) * C;
+            minus[n - 1] = in + ((t >= n) ? t - n : 0) * C;
+        }
+        regress(plus, minus, width, C, norm, out + t * C);
+    }
+    return VV_DSP_OK;
+}
+
+static int stage_init(delta_stage* st, size_t width, size_t off, size_t dim, size_t N) {
+    st->width = width;
+    st->off = off;
+    st->dim = dim;
+    st->len = 2 * N + 1;
+    st->head = 0;
+    st->filled = 0;
+    st->ring = (vv_dsp_real*)vv_dsp_malloc(st->len * width * sizeof(vv_dsp_real));
+    return st->ring != NULL;
+}
+
+static void stage_append(delta_stage* st, const vv_dsp_real* frame) {
+    size_t slot;
+    if (st->filled < st->len) {
+        slot = st->head + st->filled++;
+        if (slot >= st->len) slot -= st->len;
+    } else {
+        slot = st->head;
+        if (++st->head == st->len) st->head = 0;
+    }
+    memcpy(st->ring + slot * st->width, frame, st->width * sizeof(vv_dsp_real));
+}
+
+static const vv_dsp_real* stage_row(const delta_stage* st, size_t slot) {
+    if (slot >= st->len) slot -= st->len;
+    return st->ring + slot * st->width;
+}
+
+// Push one frame; returns 1 when out (width + dim values) was written
+static int stage_push(const vv_dsp_deltas* d, delta_stage* st, const vv_dsp_real* frame, vv_dsp_real* out) {
+    const size_t N = d->N;
+    if (st->filled == 0) {
+        for (size_t i = 0; i < N; ++i) stage_append(st, frame);
+    }
+    stage_append(st, frame);
+    if (st->filled < st->len) return 0;
+
+    const vv_dsp_real* plus[DELTAS_MAX_WIDTH];
+    const vv_dsp_real* minus[DELTAS_MAX_WIDTH];
+    size_t c = st->head + N;
+    if (c >= st->len) c -= st->len;
+    for (size_t n = 1; n <= N; ++n) {
+        plus[n - 1] = stage_row(st, c + n) + st->off;
+        minus[n - 1] = stage_row(st, c + st->len - n) + st->off;
+    }
+    memcpy(out, stage_row(st, c), st->width * sizeof(vv_dsp_real));
+    regress(plus, minus, N, st->dim, d->norm, out + st->width);
+    return 1;
+}
+
+// Most recent frame; only valid when filled > 0
+static const vv_dsp_real* stage_last(const delta_stage* st) {
+    return stage_row(st, st->head + st->filled - 1);
+}
+
+void vv_dsp_deltas_destroy(vv_dsp_deltas* d) {
+    if (!d) return;
+    vv_dsp_free(d->stage[0].ring);
+    vv_dsp_free(d->stage[1].ring);
+    vv_dsp_free(d->mid);
+    vv_dsp_free(d);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_create(size_t n_coeffs,
+                                                    size_t order,
+                                                    size_t width,
+                                                    vv_dsp_deltas** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (n_coeffs == 0 || width == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (order < 1 || order > 2 || width > DELTAS_MAX_WIDTH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (n_coeffs > SIZE_MAX / sizeof(vv_dsp_real) / (2 * width + 1) / 3) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_deltas* d = (vv_dsp_deltas*)vv_dsp_calloc(1, sizeof(*d));
+    if (!d) return VV_DSP_ERROR_INTERNAL;
+    d->n_coeffs = n_coeffs;
+    d->order = order;
+    d->N = width;
+    d->norm = delta_norm(width);
+    int ok = stage_init(&d->stage[0], n_coeffs, 0, n_coeffs, width);
+    if (ok && order == 2) {
+        d->mid = (vv_dsp_real*)vv_dsp_malloc(2 * n_coeffs * sizeof(vv_dsp_real));
+        ok = d->mid && stage_init(&d->stage[1], 2 * n_coeffs, n_coeffs, n_coeffs, width);
+    }
+    if (!ok) {
+        vv_dsp_deltas_destroy(d);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = d;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_deltas_frame_size(const vv_dsp_deltas* d) {
+    return d ? d->n_coeffs * (1 + d->order) : 0;
+}
+
+size_t vv_dsp_deltas_latency(const vv_dsp_deltas* d) {
+    return d ? d->order * d->N : 0;
+}
+
+static uint64_t emitted_after(const vv_dsp_deltas* d, uint64_t frames) {
+    const uint64_t L = (uint64_t)vv_dsp_deltas_latency(d);
+    return frames > L ? frames - L : 0;
+}
+
+size_t vv_dsp_deltas_output_count(const vv_dsp_deltas* d, size_t num_frames) {
+    if (!d) return 0;
+    return (size_t)(emitted_after(d, d->frames + num_frames) - emitted_after(d, d->frames));
+}
+
+// Route a frame entering at `level` (0 = input, 1 = padding for the second stage)
+// through the remaining stages; returns the number of output frames written
+static size_t route(vv_dsp_deltas* d, const vv_dsp_real* frame, size_t level, vv_dsp_real* out) {
+    if (d->order == level + 1) return (size_t)stage_push(d, &d->stage[level], frame, out);
+    if (!stage_push(d, &d->stage[0], frame, d->mid)) return 0;
+    return (size_t)stage_push(d, &d->stage[1], d->mid, out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_process(vv_dsp_deltas* d,
+                                                     const vv_dsp_real* in,
+                                                     size_t num_frames,
+                                                     vv_dsp_real* out,
+                                                     size_t max_frames,
+                                                     size_t* out_frames) {
+    if (!d || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t count = vv_dsp_deltas_output_count(d, num_frames);
+    if (count > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (count && !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t dim = vv_dsp_deltas_frame_size(d);
+    size_t written = 0;
+    for (size_t f = 0; f < num_frames; ++f) {
+        written += route(d, in + f * d->n_coeffs, 0, out + written * dim);
+    }
+    d->frames += num_frames;
+    *out_frames = written;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_deltas_flush(vv_dsp_deltas* d,
+                                                   vv_dsp_real* out,
+                                                   size_t max_frames,
+                                                   size_t* out_frames) {
+    if (!d || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    const size_t held = (size_t)(d->frames - emitted_after(d, d->frames));
+    if (held > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (held && !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    // Repeat the last frame of each stage N times, first stage first so its tail
+    // reaches the next one before that is drained
+    const size_t dim = vv_dsp_deltas_frame_size(d);
+    size_t written = 0;
+    for (size_t level = 0; level < d->order; ++level) {
+        delta_stage* st = &d->stage[level];
+        for (size_t i = 0; st->filled && i < d->N; ++i) {
+            written += route(d, stage_last(st), level, out + written * dim);
+        }
+    }
+    *out_frames = written;
+    return vv_dsp_deltas_reset(d);
+}
+
+vv_dsp_status vv_dsp_deltas_reset(vv_dsp_deltas* d) {
+    if (!d) return VV_DSP_ERROR_NULL_POINTER;
+    d->frames = 0;
+    d->stage[0].head = d->stage[0].filled = 0;
+    d->stage[1].head = d->stage[1].filled = 0;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,364 @@
+#include "vv_dsp/features/extractor.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/simd_core.h"
+#include "vv_dsp/core/alloc.h"
+
+struct vv_dsp_feature_extractor {
+    vv_dsp_feature_kind kind;
+    size_t fft_size;
+    size_t hop_size;
+    size_t n_bins;
+    size_t feat_dim;       // static values per frame, descriptors included
+    size_t band_dim;       // mel or MFCC values, ahead of the descriptors
+    size_t frame_size;     // output values per frame
+    size_t latency;        // frames held back by the delta window
+    size_t lead;           // earlier frames a static frame reads (1 with flux)
+    uint64_t samples;      // pushed since the last reset
+    vv_dsp_real log_epsilon;
+    vv_dsp_log_accuracy log_accuracy;
+
+    vv_dsp_stft* stft;                   // HALF spectrum, streaming ring
+    const vv_dsp_mel_sparse* filterbank; // LOG_MEL, from the shared cache
+    vv_dsp_mfcc_plan* mfcc;              // MFCC
+    vv_dsp_deltas* deltas;               // NULL without deltas
+    vv_dsp_spectral_features* descriptors; // NULL without spectral descriptors
+
+    vv_dsp_cpx* spec;      // n_bins
+    vv_dsp_real* power;    // n_bins
+    vv_dsp_real* feat;     // feat_dim
+    vv_dsp_real* staged;   // max(latency, 1) frames awaiting a storage encoder
+};
+
+// STFT frames available after `samples` pushed samples
+static uint64_t frames_after(const vv_dsp_feature_extractor* fx, uint64_t samples) {
+    if (samples < fx->fft_size) return 0;
+    return (samples - fx->fft_size) / fx->hop_size + 1;
+}
+
+static uint64_t emitted_after(const vv_dsp_feature_extractor* fx, uint64_t frames) {
+    return frames > fx->latency ? frames - fx->latency : 0;
+}
+
+void vv_dsp_feature_extractor_destroy(vv_dsp_feature_extractor* fx) {
+    if (!fx) return;
+    if (fx->stft) (void)vv_dsp_stft_destroy(fx->stft);
+    vv_dsp_mel_sparse_release(fx->filterbank);
+    if (fx->mfcc) (void)vv_dsp_mfcc_destroy(fx->mfcc);
+    vv_dsp_deltas_destroy(fx->deltas);
+    vv_dsp_spectral_features_destroy(fx->descriptors);
+    vv_dsp_free(fx->spec);
+    vv_dsp_free(fx->power);
+    vv_dsp_free(fx->feat);
+    vv_dsp_free(fx->staged);
+    vv_dsp_free(fx);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_create(const vv_dsp_feature_params* params,
+                                                               vv_dsp_feature_extractor** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const vv_dsp_feature_params* p = params;
+    if (p->fft_size == 0 || p->hop_size == 0 || p->hop_size > p->fft_size || p->n_mels == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    if (p->kind != VV_DSP_FEATURE_LOG_MEL && p->kind != VV_DSP_FEATURE_MFCC) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (p->delta_order > 2 || p->log_epsilon < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (p->log_accuracy != VV_DSP_LOG_ACCURACY_EXACT && p->log_accuracy != VV_DSP_LOG_ACCURACY_FAST) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const vv_dsp_real fmax = (p->fmax > 0) ? p->fmax : p->sample_rate / 2;
+    const vv_dsp_real eps = (p->log_epsilon > 0) ? p->log_epsilon : (vv_dsp_real)1e-10;
+    const size_t width = p->delta_width ? p->delta_width : 2;
+
+    vv_dsp_feature_extractor* fx = (vv_dsp_feature_extractor*)vv_dsp_calloc(1, sizeof(*fx));
+    if (!fx) return VV_DSP_ERROR_INTERNAL;
+    fx->kind = p->kind;
+    fx->fft_size = p->fft_size;
+    fx->hop_size = p->hop_size;
+    fx->n_bins = p->fft_size / 2 + 1;
+    fx->log_epsilon = eps;
+    fx->log_accuracy = p->log_accuracy;
+
+    vv_dsp_status s;
+    if (p->kind == VV_DSP_FEATURE_MFCC) {
+        fx->feat_dim = p->num_mfcc_coeffs;
+        s = vv_dsp_mfcc_init(p->fft_size, p->n_mels, p->num_mfcc_coeffs, p->sample_rate, p->fmin, fmax,
+                             p->variant, VV_DSP_DCT_II, p->lifter_coeff, eps, &fx->mfcc);
+        if (s == VV_DSP_OK) s = vv_dsp_mfcc_set_log_accuracy(fx->mfcc, p->log_accuracy);
+    } else {
+        fx->feat_dim = p->n_mels;
+        s = vv_dsp_mel_sparse_acquire(p->fft_size, p->n_mels, p->sample_rate, p->fmin, fmax, p->variant,
+                                      &fx->filterbank);
+    }
+    fx->band_dim = fx->feat_dim;
+    if (s == VV_DSP_OK && p->spectral_features) {
+        s = vv_dsp_spectral_features_create(p->fft_size, p->sample_rate, p->spectral_features, p->rolloff_percent,
+                                            &fx->descriptors);
+        if (s == VV_DSP_OK && p->log_accuracy == VV_DSP_LOG_ACCURACY_FAST) {
+            s = vv_dsp_spectral_features_set_precision(fx->descriptors, VV_DSP_PRECISION_FAST);
+        }
+        if (s == VV_DSP_OK) fx->feat_dim += vv_dsp_spectral_features_count(fx->descriptors);
+    }
+    if (s == VV_DSP_OK && p->delta_order) {
+        s = vv_dsp_deltas_create(fx->feat_dim, p->delta_order, width, &fx->deltas);
+    }
+    if (s == VV_DSP_OK) {
+        vv_dsp_stft_params sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.fft_size = p->fft_size;
+        sp.hop_size = p->hop_size;
+        sp.window = p->window;
+        sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+        s = vv_dsp_stft_create(&sp, &fx->stft);
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_feature_extractor_destroy(fx);
+        return s;
+    }
+
+    fx->frame_size = fx->feat_dim * (1 + p->delta_order);
+    fx->latency = vv_dsp_deltas_latency(fx->deltas);
+    fx->lead = (p->spectral_features & VV_DSP_SPECTRAL_FLUX) ? 1 : 0;
+    fx->spec = (vv_dsp_cpx*)vv_dsp_malloc(fx->n_bins * sizeof(vv_dsp_cpx));
+    fx->power = (vv_dsp_real*)vv_dsp_malloc(fx->n_bins * sizeof(vv_dsp_real));
+    fx->feat = (vv_dsp_real*)vv_dsp_malloc(fx->feat_dim * sizeof(vv_dsp_real));
+    fx->staged = (vv_dsp_real*)vv_dsp_malloc((fx->latency ? fx->latency : 1) * fx->frame_size * sizeof(vv_dsp_real));
+    if (!fx->spec || !fx->power || !fx->feat || !fx->staged) {
+        vv_dsp_feature_extractor_destroy(fx);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = fx;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_feature_extractor_frame_size(const vv_dsp_feature_extractor* fx) {
+    return fx ? fx->frame_size : 0;
+}
+
+size_t vv_dsp_feature_extractor_output_count(const vv_dsp_feature_extractor* fx, size_t num_samples) {
+    if (!fx) return 0;
+    const uint64_t before = emitted_after(fx, frames_after(fx, fx->samples));
+    const uint64_t after = emitted_after(fx, frames_after(fx, fx->samples + num_samples));
+    return (size_t)(after - before);
+}
+
+// Mel or MFCC values of the spectrum in fx->spec
+static vv_dsp_status compute_bands(vv_dsp_feature_extractor* fx) {
+    const vv_dsp_cpx* X = fx->spec;
+    vv_dsp_real* P = fx->power;
+    vv_dsp_status s = vv_dsp_cpx_power_array(X, P, fx->n_bins);
+    if (s != VV_DSP_OK) return s;
+    if (fx->kind == VV_DSP_FEATURE_MFCC) return vv_dsp_mfcc_process(fx->mfcc, P, 1, fx->feat);
+    s = vv_dsp_mel_sparse_project(fx->filterbank, P, fx->feat);
+    if (s != VV_DSP_OK) return s;
+    if (fx->log_accuracy == VV_DSP_LOG_ACCURACY_FAST) {
+        for (size_t m = 0; m < fx->band_dim; ++m) fx->feat[m] += fx->log_epsilon;
+        return vv_dsp_log_real_fast(fx->feat, fx->feat, fx->band_dim);
+    }
+    for (size_t m = 0; m < fx->band_dim; ++m) fx->feat[m] = VV_DSP_LOG(fx->feat[m] + fx->log_epsilon);
+    return VV_DSP_OK;
+}
+
+// Static feature: the bands, then the descriptors of the same spectrum
+static vv_dsp_status compute_static(vv_dsp_feature_extractor* fx) {
+    vv_dsp_status s = compute_bands(fx);
+    if (s != VV_DSP_OK || !fx->descriptors) return s;
+    return vv_dsp_spectral_features_process(fx->descriptors, fx->spec, 1, fx->feat + fx->band_dim);
+}
+
+// Frames go to out as vv_dsp_real, or encoded with q through fx->staged
+static vv_dsp_status extract(vv_dsp_feature_extractor* fx, const vv_dsp_real* pcm, size_t num_samples,
+                             const vv_dsp_quant* q, void* out, size_t max_frames, size_t* out_frames) {
+    if (!fx || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (num_samples == 0) return VV_DSP_OK;
+    if (!pcm) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t count = vv_dsp_feature_extractor_output_count(fx, num_samples);
+    if (count > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (count && !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    const size_t dim = vv_dsp_feature_extractor_frame_size(fx);
+    const size_t row_bytes = dim * (q ? vv_dsp_storage_bytes(q->type) : sizeof(vv_dsp_real));
+    size_t written = 0;
+    while (num_samples) {
+        // The ring always has room for a hop once every ready frame is popped
+        size_t take = vv_dsp_stft_stream_space(fx->stft);
+        if (take > num_samples) take = num_samples;
+        vv_dsp_status s = vv_dsp_stft_push(fx->stft, pcm, take);
+        if (s != VV_DSP_OK) return s;
+        fx->samples += take;
+        pcm += take;
+        num_samples -= take;
+        while (vv_dsp_stft_frames_ready(fx->stft)) {
+            uint8_t* dst = (uint8_t*)out + written * row_bytes;
+            const vv_dsp_real* frame = fx->feat;
+            size_t n = 1;
+            s = vv_dsp_stft_pop_frame(fx->stft, fx->spec);
+            if (s == VV_DSP_OK) s = compute_static(fx);
+            if (s == VV_DSP_OK && fx->deltas) {
+                vv_dsp_real* stacked = q ? fx->staged : (vv_dsp_real*)(void*)dst;
+                s = vv_dsp_deltas_process(fx->deltas, fx->feat, 1, stacked, 1, &n);
+                frame = stacked;
+            } else if (s == VV_DSP_OK && !q) {
+                memcpy(dst, fx->feat, dim * sizeof(vv_dsp_real));
+            }
+            if (s == VV_DSP_OK && q && n) s = vv_dsp_quant_encode(q, frame, dim, dst);
+            if (s != VV_DSP_OK) {
+                *out_frames = written;
+                return s;
+            }
+            written += n;
+        }
+    }
+    *out_frames = written;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_process(vv_dsp_feature_extractor* fx,
+                                                                const vv_dsp_real* pcm,
+                                                                size_t num_samples,
+                                                                vv_dsp_real* out,
+                                                                size_t max_frames,
+                                                                size_t* out_frames) {
+    return extract(fx, pcm, num_samples, NULL, out, max_frames, out_frames);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_process_quant(vv_dsp_feature_extractor* fx,
+                                                                      const vv_dsp_real* pcm,
+                                                                      size_t num_samples,
+                                                                      const vv_dsp_quant* quant,
+                                                                      void* out,
+                                                                      size_t max_frames,
+                                                                      size_t* out_frames) {
+    if (!quant) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_storage_bytes(quant->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    return extract(fx, pcm, num_samples, quant->type == VV_DSP_STORAGE_REAL ? NULL : quant, out, max_frames,
+                   out_frames);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_flush(vv_dsp_feature_extractor* fx,
+                                                              vv_dsp_real* out,
+                                                              size_t max_frames,
+                                                              size_t* out_frames) {
+    if (!fx || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (fx->deltas) {
+        vv_dsp_status s = vv_dsp_deltas_flush(fx->deltas, out, max_frames, out_frames);
+        if (s != VV_DSP_OK) return s;
+    }
+    return vv_dsp_feature_extractor_reset(fx);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_flush_quant(vv_dsp_feature_extractor* fx,
+                                                                    const vv_dsp_quant* quant,
+                                                                    void* out,
+                                                                    size_t max_frames,
+                                                                    size_t* out_frames) {
+    if (!fx || !quant || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_storage_bytes(quant->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (quant->type == VV_DSP_STORAGE_REAL) return vv_dsp_feature_extractor_flush(fx, (vv_dsp_real*)out, max_frames, out_frames);
+    *out_frames = 0;
+    if (fx->deltas) {
+        // The tail (at most the latency) goes through the staging buffer; check the
+        // room first so that nothing is dropped
+        const uint64_t frames = frames_after(fx, fx->samples);
+        const size_t held = (size_t)(frames - emitted_after(fx, frames));
+        if (held > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+        if (held && !out) return VV_DSP_ERROR_NULL_POINTER;
+        size_t n = 0;
+        vv_dsp_status s = vv_dsp_deltas_flush(fx->deltas, fx->staged, fx->latency, &n);
+        if (s == VV_DSP_OK) s = vv_dsp_quant_encode(quant, fx->staged, n * fx->frame_size, out);
+        if (s != VV_DSP_OK) return s;
+        *out_frames = n;
+    }
+    return vv_dsp_feature_extractor_reset(fx);
+}
+
+vv_dsp_status vv_dsp_feature_extractor_reset(vv_dsp_feature_extractor* fx) {
+    if (!fx) return VV_DSP_ERROR_NULL_POINTER;
+    fx->samples = 0;
+    if (fx->deltas) (void)vv_dsp_deltas_reset(fx->deltas);
+    if (fx->descriptors) (void)vv_dsp_spectral_features_reset(fx->descriptors);
+    return vv_dsp_stft_stream_reset(fx->stft);
+}
+
+// ---------------- Incremental updates ----------------
+
+size_t vv_dsp_feature_extractor_total_frames(const vv_dsp_feature_extractor* fx, size_t n) {
+    return fx ? (size_t)frames_after(fx, n) : 0;
+}
+
+vv_dsp_status vv_dsp_feature_extractor_affected_frames(const vv_dsp_feature_extractor* fx,
+                                                       size_t n,
+                                                       size_t first_sample,
+                                                       size_t num_samples,
+                                                       size_t* first_frame,
+                                                       size_t* num_frames) {
+    if (!fx || !first_frame || !num_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *first_frame = 0;
+    *num_frames = 0;
+    const size_t frames = (size_t)frames_after(fx, n);
+    if (num_samples == 0 || frames == 0) return VV_DSP_OK;
+    // STFT frame f reads [f * hop, f * hop + fft_size)
+    const size_t end = num_samples > SIZE_MAX - first_sample ? SIZE_MAX : first_sample + num_samples;
+    size_t lo = first_sample >= fx->fft_size ? (first_sample - fx->fft_size) / fx->hop_size + 1 : 0;
+    if (lo >= frames) return VV_DSP_OK;
+    size_t hi = (end - 1) / fx->hop_size;
+    if (hi >= frames) hi = frames - 1;
+    hi += fx->lead + fx->latency;
+    if (hi >= frames) hi = frames - 1;
+    lo = lo > fx->latency ? lo - fx->latency : 0;
+    *first_frame = lo;
+    *num_frames = hi - lo + 1;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_feature_extractor_recompute(vv_dsp_feature_extractor* fx,
+                                                                  const vv_dsp_real* signal,
+                                                                  size_t n,
+                                                                  size_t first_frame,
+                                                                  size_t num_frames,
+                                                                  vv_dsp_real* out) {
+    if (!fx) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = (size_t)frames_after(fx, n);
+    if (first_frame > frames || num_frames > frames - first_frame) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!signal || !out) return VV_DSP_ERROR_NULL_POINTER;
+    // Static frames [s, e) cover the requested frames and their context; a run started
+    // at frame s is exact from frame s + lead + latency on, and one that ends before the
+    // last frame is exact up to e - 1 - latency
+    const size_t back = fx->lead + fx->latency;
+    const size_t s = first_frame > back ? first_frame - back : 0;
+    const size_t e = frames - first_frame - num_frames > fx->latency ? first_frame + num_frames + fx->latency : frames;
+    const size_t dim = fx->frame_size;
+    vv_dsp_status st = vv_dsp_feature_extractor_reset(fx);
+    const vv_dsp_real* pcm = signal + s * fx->hop_size;
+    size_t left = (e - 1 - s) * fx->hop_size + fx->fft_size;
+    size_t frame = s;  // output frame the next emitted one is
+    while (st == VV_DSP_OK && left) {
+        // A hop of samples completes at most one frame; frames ahead of the requested
+        // range land in the staging buffer
+        const size_t take = left < fx->hop_size ? left : fx->hop_size;
+        const int keep = frame >= first_frame;
+        size_t got = 0;
+        st = vv_dsp_feature_extractor_process(fx, pcm, take, keep ? out + (frame - first_frame) * dim : fx->staged,
+                                              1, &got);
+        frame += got;
+        pcm += take;
+        left -= take;
+    }
+    if (st == VV_DSP_OK && e == frames && fx->deltas) {
+        size_t got = 0;
+        st = vv_dsp_deltas_flush(fx->deltas, fx->staged, fx->latency, &got);
+        for (size_t i = 0; st == VV_DSP_OK && i < got; ++i, ++frame) {
+            if (frame >= first_frame && frame < first_frame + num_frames) {
+                memcpy(out + (frame - first_frame) * dim, fx->staged + i * dim, dim * sizeof(vv_dsp_real));
+            }
+        }
+    }
+    const vv_dsp_status r = vv_dsp_feature_extractor_reset(fx);
+    return st != VV_DSP_OK ? st : r;
+}
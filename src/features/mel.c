@@ -1,9 +1,31 @@
 #include "vv_dsp/features/mel.h"
 #include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/simd_core.h"
+#include "../spectral/parallel.h"
+#include "../core/typed_foreign.h"
+#include "vv_dsp/core/nan_policy.h"
+#include "vv_dsp/core/context.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+typedef SRWLOCK mel_mutex;
+#define MEL_MUTEX_INIT SRWLOCK_INIT
+#define MEL_LOCK(m)   AcquireSRWLockExclusive(m)
+#define MEL_UNLOCK(m) ReleaseSRWLockExclusive(m)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t mel_mutex;
+#define MEL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define MEL_LOCK(m)   pthread_mutex_lock(m)
+#define MEL_UNLOCK(m) pthread_mutex_unlock(m)
+#endif
+
 // Math constants if not defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -98,7 +120,7 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
     }
 
     // Allocate filterbank weights matrix (flattened: n_mels * n_fft_bins)
-    vv_dsp_real* filterbank = (vv_dsp_real*)calloc(n_mels * n_fft_bins, sizeof(vv_dsp_real));
+    vv_dsp_real* filterbank = (vv_dsp_real*)vv_dsp_calloc(n_mels * n_fft_bins, sizeof(vv_dsp_real));
     if (!filterbank) {
         return VV_DSP_ERROR_INTERNAL;
     }
@@ -109,19 +131,19 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
 
     // Create n_mels+2 equally spaced points in Mel scale (include fmin and fmax)
     size_t n_mel_points = n_mels + 2;
-    vv_dsp_real* mel_points = (vv_dsp_real*)malloc(n_mel_points * sizeof(vv_dsp_real));
+    vv_dsp_real* mel_points = (vv_dsp_real*)vv_dsp_malloc(n_mel_points * sizeof(vv_dsp_real));
     if (!mel_points) {
-        free(filterbank);
+        vv_dsp_free(filterbank);
         return VV_DSP_ERROR_INTERNAL;
     }
 
     linspace(mel_min, mel_max, n_mel_points, mel_points);
 
     // Convert Mel points back to Hz
-    vv_dsp_real* hz_points = (vv_dsp_real*)malloc(n_mel_points * sizeof(vv_dsp_real));
+    vv_dsp_real* hz_points = (vv_dsp_real*)vv_dsp_malloc(n_mel_points * sizeof(vv_dsp_real));
     if (!hz_points) {
-        free(filterbank);
-        free(mel_points);
+        vv_dsp_free(filterbank);
+        vv_dsp_free(mel_points);
         return VV_DSP_ERROR_INTERNAL;
     }
 
@@ -130,11 +152,11 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
     }
 
     // Create frequency bins for FFT
-    vv_dsp_real* fft_freqs = (vv_dsp_real*)malloc(n_fft_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* fft_freqs = (vv_dsp_real*)vv_dsp_malloc(n_fft_bins * sizeof(vv_dsp_real));
     if (!fft_freqs) {
-        free(filterbank);
-        free(mel_points);
-        free(hz_points);
+        vv_dsp_free(filterbank);
+        vv_dsp_free(mel_points);
+        vv_dsp_free(hz_points);
         return VV_DSP_ERROR_INTERNAL;
     }
 
@@ -180,9 +202,9 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
     }
 
     // Clean up temporary arrays
-    free(mel_points);
-    free(hz_points);
-    free(fft_freqs);
+    vv_dsp_free(mel_points);
+    vv_dsp_free(hz_points);
+    vv_dsp_free(fft_freqs);
 
     // Set output parameters
     *out_filterbank_weights = filterbank;
@@ -195,8 +217,374 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create(
 void vv_dsp_mel_filterbank_free(vv_dsp_real* filterbank_weights, size_t n_mels) {
     (void)n_mels;  // Unused parameter
     if (filterbank_weights) {
-        free(filterbank_weights);
+        vv_dsp_free(filterbank_weights);
+    }
+}
+
+// --------------- Sparse Mel Filterbank ---------------
+
+void vv_dsp_mel_sparse_destroy(vv_dsp_mel_sparse* filterbank) {
+    if (!filterbank) {
+        return;
+    }
+    vv_dsp_free(filterbank->start);
+    vv_dsp_free(filterbank->length);
+    vv_dsp_free(filterbank->offset);
+    vv_dsp_free(filterbank->weights);
+    vv_dsp_free(filterbank);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_from_dense(
+    const vv_dsp_real* filterbank_weights,
+    size_t n_mels,
+    size_t n_fft_bins,
+    vv_dsp_mel_sparse** out_filterbank
+) {
+    if (!filterbank_weights || !out_filterbank) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_filterbank = NULL;
+    if (n_mels == 0 || n_fft_bins == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_mel_sparse* fb = (vv_dsp_mel_sparse*)vv_dsp_calloc(1, sizeof(vv_dsp_mel_sparse));
+    if (!fb) {
+        return VV_DSP_ERROR_INTERNAL;
     }
+    fb->n_mels = n_mels;
+    fb->n_fft_bins = n_fft_bins;
+    fb->start = (size_t*)vv_dsp_malloc(n_mels * sizeof(size_t));
+    fb->length = (size_t*)vv_dsp_malloc(n_mels * sizeof(size_t));
+    fb->offset = (size_t*)vv_dsp_malloc(n_mels * sizeof(size_t));
+    if (!fb->start || !fb->length || !fb->offset) {
+        vv_dsp_mel_sparse_destroy(fb);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    // First pass: span of each band
+    size_t total = 0;
+    for (size_t m = 0; m < n_mels; m++) {
+        const vv_dsp_real* row = &filterbank_weights[m * n_fft_bins];
+        size_t lo = 0, hi = n_fft_bins;
+        while (lo < n_fft_bins && row[lo] == 0.0f) lo++;
+        while (hi > lo && row[hi - 1] == 0.0f) hi--;
+        fb->start[m] = (lo < hi) ? lo : 0;
+        fb->length[m] = hi - lo;
+        fb->offset[m] = total;
+        total += hi - lo;
+    }
+
+    // Second pass: copy the spans
+    fb->weights = (vv_dsp_real*)vv_dsp_malloc((total ? total : 1) * sizeof(vv_dsp_real));
+    if (!fb->weights) {
+        vv_dsp_mel_sparse_destroy(fb);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t m = 0; m < n_mels; m++) {
+        memcpy(&fb->weights[fb->offset[m]], &filterbank_weights[m * n_fft_bins + fb->start[m]],
+               fb->length[m] * sizeof(vv_dsp_real));
+    }
+
+    *out_filterbank = fb;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_filterbank_create_sparse(
+    size_t n_fft,
+    size_t n_mels,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    vv_dsp_mel_sparse** out_filterbank
+) {
+    if (!out_filterbank) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_filterbank = NULL;
+
+    // Build the dense triangles once and keep only their spans
+    vv_dsp_real* dense = NULL;
+    size_t num_filters = 0, filter_len = 0;
+    vv_dsp_status status = vv_dsp_mel_filterbank_create(
+        n_fft, n_mels, sample_rate, fmin, fmax, variant, &dense, &num_filters, &filter_len
+    );
+    if (status != VV_DSP_OK) {
+        return status;
+    }
+    status = vv_dsp_mel_sparse_from_dense(dense, num_filters, filter_len, out_filterbank);
+    vv_dsp_mel_filterbank_free(dense, num_filters);
+    return status;
+}
+
+// Weighted sums over each band's span
+static void mel_sparse_project(const vv_dsp_mel_sparse* fb, const vv_dsp_real* power, vv_dsp_real* out) {
+    for (size_t m = 0; m < fb->n_mels; m++) {
+        const vv_dsp_real* w = &fb->weights[fb->offset[m]];
+        const vv_dsp_real* p = &power[fb->start[m]];
+        const size_t len = fb->length[m];
+        vv_dsp_real mel_energy = 0.0f;
+        for (size_t k = 0; k < len; k++) {
+            mel_energy += p[k] * w[k];
+        }
+        out[m] = mel_energy;
+    }
+}
+
+// Frames projected together by the batch paths. Each band's span of weights is loaded
+// once per tile and applied to MEL_FRAME_TILE spectra, whose sums are independent
+// accumulator chains; the DCT reuses each basis row across the tile the same way.
+#define MEL_FRAME_TILE 8
+
+// One band of weights w (len bins from power + start) applied to num_frames spectra
+// `stride` values apart. The sums run over the bins in the same order as
+// mel_sparse_project(), so every value matches the single-frame projection exactly.
+static void mel_band_tile(const vv_dsp_real* w, size_t len, const vv_dsp_real* power, size_t stride,
+                          size_t num_frames, vv_dsp_real* out, size_t out_stride) {
+    if (num_frames == MEL_FRAME_TILE) {
+        vv_dsp_real acc[MEL_FRAME_TILE] = {0};
+        for (size_t k = 0; k < len; k++) {
+            const vv_dsp_real wk = w[k];
+            for (size_t t = 0; t < MEL_FRAME_TILE; t++) {
+                acc[t] += power[t * stride + k] * wk;
+            }
+        }
+        for (size_t t = 0; t < MEL_FRAME_TILE; t++) {
+            out[t * out_stride] = acc[t];
+        }
+        return;
+    }
+    for (size_t t = 0; t < num_frames; t++) {
+        const vv_dsp_real* p = &power[t * stride];
+        vv_dsp_real mel_energy = 0.0f;
+        for (size_t k = 0; k < len; k++) {
+            mel_energy += p[k] * w[k];
+        }
+        out[t * out_stride] = mel_energy;
+    }
+}
+
+// mel_sparse_project() on up to MEL_FRAME_TILE consecutive frames, band-major
+static void mel_sparse_project_tile(const vv_dsp_mel_sparse* fb, const vv_dsp_real* power, size_t num_frames,
+                                    vv_dsp_real* out) {
+    for (size_t m = 0; m < fb->n_mels; m++) {
+        mel_band_tile(&fb->weights[fb->offset[m]], fb->length[m], &power[fb->start[m]], fb->n_fft_bins, num_frames,
+                      &out[m], fb->n_mels);
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_project(
+    const vv_dsp_mel_sparse* filterbank,
+    const vv_dsp_real* power_frame,
+    vv_dsp_real* out_mel
+) {
+    if (!filterbank || !power_frame || !out_mel) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    mel_sparse_project(filterbank, power_frame, out_mel);
+    return VV_DSP_OK;
+}
+
+// --------------- Shared Filterbank Cache ---------------
+
+// One entry per (n_fft, n_mels, sample_rate, fmin, fmax, variant). The filterbank and
+// DCT basis are read-only once published, so every holder reads them without locking;
+// the entry is freed when its last holder releases it.
+typedef struct mel_cache_entry {
+    size_t n_fft;
+    size_t n_mels;
+    vv_dsp_real sample_rate;
+    vv_dsp_real fmin;
+    vv_dsp_real fmax;
+    vv_dsp_mel_variant variant;
+    vv_dsp_mel_sparse* filterbank;
+    vv_dsp_real* dct_basis;     // n_mels x n_mels DCT-II rows, built on first MFCC use
+    size_t refs;
+    struct mel_cache_entry* next;
+} mel_cache_entry;
+
+static void mel_cache_release(mel_cache_entry* e);
+
+static mel_mutex g_mel_cache_mutex = MEL_MUTEX_INIT;
+static mel_cache_entry* g_mel_cache = NULL;
+static size_t g_mel_cache_hits = 0;
+static size_t g_mel_cache_misses = 0;
+
+// Called with the lock held
+static mel_cache_entry* mel_cache_find(size_t n_fft, size_t n_mels, vv_dsp_real sample_rate,
+                                       vv_dsp_real fmin, vv_dsp_real fmax, vv_dsp_mel_variant variant) {
+    for (mel_cache_entry* e = g_mel_cache; e; e = e->next) {
+        if (e->n_fft == n_fft && e->n_mels == n_mels && e->sample_rate == sample_rate &&
+            e->fmin == fmin && e->fmax == fmax && e->variant == variant) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// Unnormalized DCT-II as in vv_dsp_mfcc(): X[k] = sum_n x[n] cos(pi/N (n + 0.5) k)
+static vv_dsp_real* dct2_basis_create(size_t N) {
+    vv_dsp_real* basis = (vv_dsp_real*)vv_dsp_malloc(N * N * sizeof(vv_dsp_real));
+    if (!basis) {
+        return NULL;
+    }
+    const double step = VV_DSP_PI_D / (double)N;
+    for (size_t k = 0; k < N; k++) {
+        for (size_t n = 0; n < N; n++) {
+            basis[k * N + n] = (vv_dsp_real)cos(step * ((double)n + 0.5) * (double)k);
+        }
+    }
+    return basis;
+}
+
+// Take a reference on the entry for this configuration, building it (and with
+// want_basis its DCT basis) outside the lock on a miss
+static vv_dsp_status mel_cache_acquire(size_t n_fft, size_t n_mels, vv_dsp_real sample_rate,
+                                       vv_dsp_real fmin, vv_dsp_real fmax, vv_dsp_mel_variant variant,
+                                       int want_basis, mel_cache_entry** out) {
+    MEL_LOCK(&g_mel_cache_mutex);
+    mel_cache_entry* e = mel_cache_find(n_fft, n_mels, sample_rate, fmin, fmax, variant);
+    if (e) {
+        e->refs++;
+        g_mel_cache_hits++;
+    } else {
+        g_mel_cache_misses++;
+    }
+    MEL_UNLOCK(&g_mel_cache_mutex);
+
+    if (!e) {
+        vv_dsp_mel_sparse* fb = NULL;
+        vv_dsp_status status = vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, sample_rate, fmin, fmax,
+                                                                   variant, &fb);
+        if (status != VV_DSP_OK) {
+            return status;
+        }
+        mel_cache_entry* fresh = (mel_cache_entry*)vv_dsp_calloc(1, sizeof(mel_cache_entry));
+        if (!fresh) {
+            vv_dsp_mel_sparse_destroy(fb);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        fresh->n_fft = n_fft;
+        fresh->n_mels = n_mels;
+        fresh->sample_rate = sample_rate;
+        fresh->fmin = fmin;
+        fresh->fmax = fmax;
+        fresh->variant = variant;
+        fresh->filterbank = fb;
+        fresh->refs = 1;
+
+        // Another thread may have published the same configuration meanwhile
+        MEL_LOCK(&g_mel_cache_mutex);
+        e = mel_cache_find(n_fft, n_mels, sample_rate, fmin, fmax, variant);
+        if (e) {
+            e->refs++;
+        } else {
+            fresh->next = g_mel_cache;
+            g_mel_cache = fresh;
+            e = fresh;
+            fresh = NULL;
+        }
+        MEL_UNLOCK(&g_mel_cache_mutex);
+        if (fresh) {
+            vv_dsp_mel_sparse_destroy(fresh->filterbank);
+            vv_dsp_free(fresh);
+        }
+    }
+
+    if (want_basis) {
+        MEL_LOCK(&g_mel_cache_mutex);
+        const int missing = (e->dct_basis == NULL);
+        MEL_UNLOCK(&g_mel_cache_mutex);
+        if (missing) {
+            vv_dsp_real* basis = dct2_basis_create(n_mels);
+            MEL_LOCK(&g_mel_cache_mutex);
+            if (basis && !e->dct_basis) {
+                e->dct_basis = basis;
+                basis = NULL;
+            }
+            const int ok = (e->dct_basis != NULL);
+            MEL_UNLOCK(&g_mel_cache_mutex);
+            vv_dsp_free(basis);
+            if (!ok) {
+                mel_cache_release(e);
+                return VV_DSP_ERROR_INTERNAL;
+            }
+        }
+    }
+
+    *out = e;
+    return VV_DSP_OK;
+}
+
+static void mel_cache_release(mel_cache_entry* e) {
+    if (!e) {
+        return;
+    }
+    MEL_LOCK(&g_mel_cache_mutex);
+    int last = (--e->refs == 0);
+    if (last) {
+        mel_cache_entry** link = &g_mel_cache;
+        while (*link != e) {
+            link = &(*link)->next;
+        }
+        *link = e->next;
+    }
+    MEL_UNLOCK(&g_mel_cache_mutex);
+    if (last) {
+        vv_dsp_mel_sparse_destroy(e->filterbank);
+        vv_dsp_free(e->dct_basis);
+        vv_dsp_free(e);
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mel_sparse_acquire(
+    size_t n_fft,
+    size_t n_mels,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    const vv_dsp_mel_sparse** out_filterbank
+) {
+    if (!out_filterbank) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    *out_filterbank = NULL;
+    mel_cache_entry* e = NULL;
+    vv_dsp_status status = mel_cache_acquire(n_fft, n_mels, sample_rate, fmin, fmax, variant, 0, &e);
+    if (status == VV_DSP_OK) {
+        *out_filterbank = e->filterbank;
+    }
+    return status;
+}
+
+void vv_dsp_mel_sparse_release(const vv_dsp_mel_sparse* filterbank) {
+    if (!filterbank) {
+        return;
+    }
+    MEL_LOCK(&g_mel_cache_mutex);
+    mel_cache_entry* e = g_mel_cache;
+    while (e && e->filterbank != filterbank) {
+        e = e->next;
+    }
+    MEL_UNLOCK(&g_mel_cache_mutex);
+    mel_cache_release(e);
+}
+
+vv_dsp_status vv_dsp_mel_cache_get_stats(vv_dsp_mel_cache_stats* out) {
+    if (!out) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    MEL_LOCK(&g_mel_cache_mutex);
+    out->hits = g_mel_cache_hits;
+    out->misses = g_mel_cache_misses;
+    out->entries = 0;
+    for (const mel_cache_entry* e = g_mel_cache; e; e = e->next) {
+        out->entries++;
+    }
+    MEL_UNLOCK(&g_mel_cache_mutex);
+    return VV_DSP_OK;
 }
 
 // --------------- Log-Mel Spectrogram Computation ---------------
@@ -221,23 +609,48 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram(
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
 
-    // Process each frame
-    for (size_t frame = 0; frame < num_frames; frame++) {
-        const vv_dsp_real* frame_power = &power_spectrogram[frame * n_fft_bins];
-        vv_dsp_real* frame_log_mel = &out_log_mel_spectrogram[frame * n_mels];
-
-        // Apply each Mel filter
+    // Tiles of frames, band by band: each filter row is streamed once per tile
+    for (size_t f0 = 0; f0 < num_frames; f0 += MEL_FRAME_TILE) {
+        const size_t nf = (num_frames - f0 < MEL_FRAME_TILE) ? num_frames - f0 : MEL_FRAME_TILE;
+        vv_dsp_real* tile_log_mel = &out_log_mel_spectrogram[f0 * n_mels];
         for (size_t m = 0; m < n_mels; m++) {
-            vv_dsp_real mel_energy = 0.0f;
-            const vv_dsp_real* filter_weights = &filterbank_weights[m * n_fft_bins];
+            mel_band_tile(&filterbank_weights[m * n_fft_bins], n_fft_bins, &power_spectrogram[f0 * n_fft_bins],
+                          n_fft_bins, nf, &tile_log_mel[m], n_mels);
+        }
+        // Apply logarithm with epsilon to avoid log(0)
+        for (size_t i = 0; i < nf * n_mels; i++) {
+            tile_log_mel[i] = VV_DSP_LOG(tile_log_mel[i] + log_epsilon);
+        }
+    }
 
-            // Weighted sum (matrix multiplication)
-            for (size_t k = 0; k < n_fft_bins; k++) {
-                mel_energy += frame_power[k] * filter_weights[k];
-            }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram_sparse(
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    const vv_dsp_mel_sparse* filterbank,
+    vv_dsp_real log_epsilon,
+    vv_dsp_real* out_log_mel_spectrogram
+) {
+    // Input validation
+    if (!power_spectrogram || !filterbank || !out_log_mel_spectrogram) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (num_frames == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    if (log_epsilon < 0.0f) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
 
-            // Apply logarithm with epsilon to avoid log(0)
-            frame_log_mel[m] = VV_DSP_LOG(mel_energy + log_epsilon);
+    const size_t n_fft_bins = filterbank->n_fft_bins, n_mels = filterbank->n_mels;
+    for (size_t f0 = 0; f0 < num_frames; f0 += MEL_FRAME_TILE) {
+        const size_t nf = (num_frames - f0 < MEL_FRAME_TILE) ? num_frames - f0 : MEL_FRAME_TILE;
+        vv_dsp_real* tile_log_mel = &out_log_mel_spectrogram[f0 * n_mels];
+        mel_sparse_project_tile(filterbank, &power_spectrogram[f0 * n_fft_bins], nf, tile_log_mel);
+        for (size_t i = 0; i < nf * n_mels; i++) {
+            tile_log_mel[i] = VV_DSP_LOG(tile_log_mel[i] + log_epsilon);
         }
     }
 
@@ -246,14 +659,19 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram(
 
 // --------------- MFCC Computation ---------------
 
-VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
+size_t vv_dsp_mfcc_scratch_size(size_t num_frames, size_t n_mels) {
+    return vv_dsp_arena_request_size(num_frames * n_mels * sizeof(vv_dsp_real));
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_ex(
     const vv_dsp_real* log_mel_spectrogram,
     size_t num_frames,
     size_t n_mels,
     size_t num_mfcc_coeffs,
     vv_dsp_dct_type dct_type,
     vv_dsp_real lifter_coeff,
-    vv_dsp_real* out_mfcc_coeffs
+    vv_dsp_real* out_mfcc_coeffs,
+    vv_dsp_arena* arena
 ) {
     // Input validation
     if (!log_mel_spectrogram || !out_mfcc_coeffs) {
@@ -272,27 +690,31 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
 
-    // Allocate temporary buffer for DCT output
-    vv_dsp_real* dct_output = (vv_dsp_real*)malloc(n_mels * sizeof(vv_dsp_real));
+    // One plan for all frames: small n_mels run the batch as a single matrix product
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* dct_output = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, num_frames * n_mels * sizeof(vv_dsp_real));
     if (!dct_output) {
         return VV_DSP_ERROR_INTERNAL;
     }
+    vv_dsp_dct_plan* dct_plan = NULL;
+    vv_dsp_status status = vv_dsp_dct_make_plan(n_mels, dct_type, VV_DSP_DCT_FORWARD, &dct_plan);
+    if (status == VV_DSP_OK) {
+        status = vv_dsp_dct_execute_batch(dct_plan, log_mel_spectrogram, dct_output, num_frames, n_mels);
+        vv_dsp_dct_destroy(dct_plan);
+    }
+    if (status != VV_DSP_OK) {
+        vv_dsp_scratch_free(arena, dct_output);
+        vv_dsp_arena_reset_to(arena, mark);
+        return status;
+    }
 
-    // Process each frame
     for (size_t frame = 0; frame < num_frames; frame++) {
-        const vv_dsp_real* frame_log_mel = &log_mel_spectrogram[frame * n_mels];
+        const vv_dsp_real* frame_dct = &dct_output[frame * n_mels];
         vv_dsp_real* frame_mfcc = &out_mfcc_coeffs[frame * num_mfcc_coeffs];
 
-        // Apply DCT-II
-        vv_dsp_status status = vv_dsp_dct_forward(n_mels, dct_type, frame_log_mel, dct_output);
-        if (status != VV_DSP_OK) {
-            free(dct_output);
-            return status;
-        }
-
         // Copy only the requested number of coefficients
         for (size_t i = 0; i < num_mfcc_coeffs; i++) {
-            frame_mfcc[i] = dct_output[i];
+            frame_mfcc[i] = frame_dct[i];
         }
 
         // Apply liftering if requested
@@ -304,13 +726,26 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
         }
     }
 
-    free(dct_output);
+    vv_dsp_scratch_free(arena, dct_output);
+    vv_dsp_arena_reset_to(arena, mark);
     return VV_DSP_OK;
 }
 
-// --------------- MFCC Context Management (Placeholder for Subtask 20.5) ---------------
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc(
+    const vv_dsp_real* log_mel_spectrogram,
+    size_t num_frames,
+    size_t n_mels,
+    size_t num_mfcc_coeffs,
+    vv_dsp_dct_type dct_type,
+    vv_dsp_real lifter_coeff,
+    vv_dsp_real* out_mfcc_coeffs
+) {
+    return vv_dsp_mfcc_ex(log_mel_spectrogram, num_frames, n_mels, num_mfcc_coeffs, dct_type, lifter_coeff,
+                          out_mfcc_coeffs, NULL);
+}
+
+// --------------- MFCC Context Management ---------------
 
-// MFCC plan structure (will be implemented in Subtask 20.5)
 struct vv_dsp_mfcc_plan {
     size_t n_fft;
     size_t n_mels;
@@ -323,11 +758,16 @@ struct vv_dsp_mfcc_plan {
     vv_dsp_dct_type dct_type;
     vv_dsp_real lifter_coeff;
     vv_dsp_real log_epsilon;
-
-    // Pre-computed resources
-    vv_dsp_real* filterbank_weights;
-    vv_dsp_real* temp_log_mel;   // Temporary buffer for log-mel spectrogram
-    vv_dsp_real* temp_dct;       // Temporary buffer for DCT output
+    vv_dsp_precision_mode precision;  // log-mel step
+    int nan_policy;                   // captured policy, or VV_DSP_CONTEXT_DEFAULT
+    vv_dsp_threadpool* pool;          // batch pool, NULL = default
+
+    // Pre-computed resources; the filterbank and DCT basis are shared through the cache
+    mel_cache_entry* shared;
+    const vv_dsp_mel_sparse* filterbank;  // Only the nonzero span of each triangle
+    const vv_dsp_real* dct_basis;         // n_mels x n_mels DCT-II, first num_mfcc_coeffs rows used
+    vv_dsp_real* lifter;                  // num_mfcc_coeffs gains (1 when liftering is off)
+    vv_dsp_real* temp_log_mel;            // One tile (MEL_FRAME_TILE frames) of log-mel energies
 };
 
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
@@ -343,9 +783,6 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
     vv_dsp_real log_epsilon,
     vv_dsp_mfcc_plan** out_plan
 ) {
-    // This will be fully implemented in Subtask 20.5
-    // For now, provide a basic implementation
-
     if (!out_plan) {
         return VV_DSP_ERROR_NULL_POINTER;
     }
@@ -357,9 +794,13 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
     if (num_mfcc_coeffs > n_mels || fmin < 0.0f || fmax <= fmin || fmax > sample_rate / 2.0f) {
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
+    // Same restrictions as vv_dsp_mfcc() and vv_dsp_compute_log_mel_spectrogram()
+    if (dct_type != VV_DSP_DCT_II || lifter_coeff < 0.0f || log_epsilon < 0.0f) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
 
     // Allocate plan structure
-    vv_dsp_mfcc_plan* plan = (vv_dsp_mfcc_plan*)malloc(sizeof(vv_dsp_mfcc_plan));
+    vv_dsp_mfcc_plan* plan = (vv_dsp_mfcc_plan*)vv_dsp_calloc(1, sizeof(vv_dsp_mfcc_plan));
     if (!plan) {
         return VV_DSP_ERROR_INTERNAL;
     }
@@ -376,35 +817,137 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init(
     plan->dct_type = dct_type;
     plan->lifter_coeff = lifter_coeff;
     plan->log_epsilon = log_epsilon;
+    plan->nan_policy = VV_DSP_CONTEXT_DEFAULT;
 
-    // Create filterbank
-    size_t num_filters, filter_len;
-    vv_dsp_status status = vv_dsp_mel_filterbank_create(
-        n_fft, n_mels, sample_rate, fmin, fmax, variant,
-        &plan->filterbank_weights, &num_filters, &filter_len
-    );
-
+    // Filterbank and DCT basis come from the shared cache; process only touches the
+    // buffers below
+    vv_dsp_status status = mel_cache_acquire(n_fft, n_mels, sample_rate, fmin, fmax, variant, 1,
+                                             &plan->shared);
     if (status != VV_DSP_OK) {
-        free(plan);
+        vv_dsp_mfcc_destroy(plan);
         return status;
     }
+    plan->filterbank = plan->shared->filterbank;
+    plan->dct_basis = plan->shared->dct_basis;
 
-    // Allocate temporary buffers (will be used in vv_dsp_mfcc_process)
-    plan->temp_log_mel = (vv_dsp_real*)malloc(n_mels * sizeof(vv_dsp_real));
-    plan->temp_dct = (vv_dsp_real*)malloc(n_mels * sizeof(vv_dsp_real));
-
-    if (!plan->temp_log_mel || !plan->temp_dct) {
-        vv_dsp_mel_filterbank_free(plan->filterbank_weights, n_mels);
-        free(plan->temp_log_mel);
-        free(plan->temp_dct);
-        free(plan);
+    plan->lifter = (vv_dsp_real*)vv_dsp_malloc(num_mfcc_coeffs * sizeof(vv_dsp_real));
+    plan->temp_log_mel = (vv_dsp_real*)vv_dsp_malloc(MEL_FRAME_TILE * n_mels * sizeof(vv_dsp_real));
+    if (!plan->lifter || !plan->temp_log_mel) {
+        vv_dsp_mfcc_destroy(plan);
         return VV_DSP_ERROR_INTERNAL;
     }
 
+    // Lifter gains as in vv_dsp_mfcc(): c[0] is left alone
+    for (size_t i = 0; i < num_mfcc_coeffs; i++) {
+        plan->lifter[i] = 1.0f;
+        if (lifter_coeff > 0.0f && i > 0) {
+            plan->lifter[i] = 1.0f + (lifter_coeff / 2.0f) * VV_DSP_SIN((vv_dsp_real)M_PI * (vv_dsp_real)i / lifter_coeff);
+        }
+    }
+
     *out_plan = plan;
     return VV_DSP_OK;
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_init_ctx(
+    const vv_dsp_context* ctx,
+    size_t n_fft,
+    size_t n_mels,
+    size_t num_mfcc_coeffs,
+    vv_dsp_real sample_rate,
+    vv_dsp_real fmin,
+    vv_dsp_real fmax,
+    vv_dsp_mel_variant variant,
+    vv_dsp_dct_type dct_type,
+    vv_dsp_real lifter_coeff,
+    vv_dsp_real log_epsilon,
+    vv_dsp_mfcc_plan** out_plan
+) {
+    const vv_dsp_status status = vv_dsp_context_check(ctx);
+    if (status != VV_DSP_OK) {
+        return status;
+    }
+    vv_dsp_mfcc_plan* plan = NULL;
+    const vv_dsp_status s = vv_dsp_mfcc_init(n_fft, n_mels, num_mfcc_coeffs, sample_rate, fmin, fmax, variant,
+                                             dct_type, lifter_coeff, log_epsilon, &plan);
+    if (s != VV_DSP_OK) {
+        return s;
+    }
+    if (ctx) {
+        plan->precision = ctx->precision;
+        plan->nan_policy = ctx->nan_policy;
+        plan->pool = ctx->pool;
+    }
+    *out_plan = plan;
+    return VV_DSP_OK;
+}
+
+// Log of one frame of mel energies in place, with the NaN/Inf policy applied to the
+// DCT input as vv_dsp_dct_execute() applies it
+static vv_dsp_status mfcc_log_row(const vv_dsp_mfcc_plan* plan, vv_dsp_nan_policy_e policy, vv_dsp_real* log_mel) {
+    const size_t n_mels = plan->n_mels;
+    vv_dsp_status status = VV_DSP_OK;
+    if (plan->precision != VV_DSP_PRECISION_EXACT) {
+        for (size_t m = 0; m < n_mels; m++) {
+            log_mel[m] += plan->log_epsilon;
+        }
+        if (plan->precision == VV_DSP_PRECISION_FAST) {
+            status = vv_dsp_vlog(log_mel, log_mel, n_mels, VV_DSP_VMATH_FAST);
+        } else {
+            (void)vv_dsp_log_real_fast(log_mel, log_mel, n_mels);
+        }
+        if (status == VV_DSP_OK) {
+            status = vv_dsp_nan_policy_fixup(policy, log_mel, n_mels);
+        }
+    } else {
+        unsigned bad = 0;
+        for (size_t m = 0; m < n_mels; m++) {
+            log_mel[m] = VV_DSP_LOG(log_mel[m] + plan->log_epsilon);
+            bad |= vv_dsp_nonfinite_flag(log_mel[m]);
+        }
+        if (bad) {
+            status = vv_dsp_nan_policy_fixup(policy, log_mel, n_mels);
+        }
+    }
+    return status;
+}
+
+// Up to MEL_FRAME_TILE frames through projection, log, DCT and lifter, using
+// MEL_FRAME_TILE * n_mels values of log_mel scratch. The tile is projected band-major,
+// and each kept DCT row of the cached basis is applied to every frame of the tile
+// while it is in registers and L1. Per frame, every sum runs in the same order as a
+// one-frame tile, so results do not depend on how frames fall into tiles. The NaN/Inf
+// policy is fetched once per call by the caller and checked in the store loops.
+static vv_dsp_status mfcc_tile(const vv_dsp_mfcc_plan* plan, vv_dsp_nan_policy_e policy, const vv_dsp_real* power,
+                               size_t num_frames, vv_dsp_real* log_mel, vv_dsp_real* out) {
+    const size_t n_mels = plan->n_mels, num_coeffs = plan->num_mfcc_coeffs;
+    mel_sparse_project_tile(plan->filterbank, power, num_frames, log_mel);
+    for (size_t t = 0; t < num_frames; t++) {
+        const vv_dsp_status status = mfcc_log_row(plan, policy, &log_mel[t * n_mels]);
+        if (status != VV_DSP_OK) {
+            return status;
+        }
+    }
+    for (size_t i = 0; i < num_coeffs; i++) {
+        mel_band_tile(&plan->dct_basis[i * n_mels], n_mels, log_mel, n_mels, num_frames, &out[i], num_coeffs);
+    }
+    for (size_t t = 0; t < num_frames; t++) {
+        vv_dsp_real* row = &out[t * num_coeffs];
+        unsigned bad = 0;
+        for (size_t i = 0; i < num_coeffs; i++) {
+            row[i] *= plan->lifter[i];
+            bad |= vv_dsp_nonfinite_flag(row[i]);
+        }
+        if (bad) {
+            const vv_dsp_status status = vv_dsp_nan_policy_fixup(policy, row, num_coeffs);
+            if (status != VV_DSP_OK) {
+                return status;
+            }
+        }
+    }
+    return VV_DSP_OK;
+}
+
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process(
     const vv_dsp_mfcc_plan* plan,
     const vv_dsp_real* power_spectrogram,
@@ -418,35 +961,248 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process(
         return VV_DSP_ERROR_INVALID_SIZE;
     }
 
-    // This will be optimized in Subtask 20.5
-    // For now, use the existing functions
+    // Tile by tile through the plan's scratch: projection, log, DCT and lifter all
+    // run while the tile is still in cache, and nothing is allocated. The scratch
+    // is written through the const plan, so one plan must not be shared between
+    // threads.
+    const size_t n_fft_bins = plan->n_fft_bins, num_coeffs = plan->num_mfcc_coeffs;
+    const vv_dsp_nan_policy_e policy = vv_dsp_context_resolve_nan_policy(plan->nan_policy);
+    vv_dsp_status status = VV_DSP_OK;
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_MFCC_PROCESS);
+    for (size_t f0 = 0; f0 < num_frames && status == VV_DSP_OK; f0 += MEL_FRAME_TILE) {
+        const size_t nf = (num_frames - f0 < MEL_FRAME_TILE) ? num_frames - f0 : MEL_FRAME_TILE;
+        status = mfcc_tile(plan, policy, &power_spectrogram[f0 * n_fft_bins], nf, plan->temp_log_mel,
+                           &out_mfcc_coeffs[f0 * num_coeffs]);
+    }
+    VV_DSP_PROFILE_END(prof, num_frames);
+
+    return status;
+}
+
+// --------------- Frame-Parallel Batches ---------------
 
-    // Allocate temporary log-mel spectrogram for all frames
-    vv_dsp_real* temp_log_mel_all = (vv_dsp_real*)malloc(num_frames * plan->n_mels * sizeof(vv_dsp_real));
-    if (!temp_log_mel_all) {
+// Frames per tile: about 64 KiB of power spectrum, so a tile's input stays in L2
+// while it is being projected
+#define MEL_TILE_BYTES (64u * 1024u)
+
+typedef struct mel_batch_job {
+    const vv_dsp_mfcc_plan* plan;         // NULL for a log-mel batch
+    const vv_dsp_mel_sparse* filterbank;
+    vv_dsp_real log_epsilon;
+    vv_dsp_nan_policy_e nan_policy;       // resolved on the calling thread (thread-local)
+    vv_dsp_threadpool* pool;              // NULL = default
+    const vv_dsp_real* power;
+    size_t num_frames;
+    size_t tile;                          // frames per tile
+    size_t num_tiles;
+    size_t workers;
+    vv_dsp_real* out;
+    vv_dsp_status* status;                // one per worker
+} mel_batch_job;
+
+// Worker w takes tiles w, w + workers, ... and writes its rows straight into out.
+// MFCC workers own one frame tile of scratch; the shared plan is only read.
+static void mel_batch_worker(void* ctx, size_t w) {
+    const mel_batch_job* job = (const mel_batch_job*)ctx;
+    const vv_dsp_mfcc_plan* plan = job->plan;
+    const vv_dsp_mel_sparse* fb = job->filterbank;
+    const size_t n_fft_bins = fb->n_fft_bins, n_mels = fb->n_mels;
+    vv_dsp_real* scratch = NULL;
+    vv_dsp_status s = VV_DSP_OK;
+    if (plan) {
+        scratch = (vv_dsp_real*)vv_dsp_malloc(MEL_FRAME_TILE * n_mels * sizeof(vv_dsp_real));
+        if (!scratch) {
+            s = VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    for (size_t t = w; s == VV_DSP_OK && t < job->num_tiles; t += job->workers) {
+        const size_t f0 = t * job->tile;
+        const size_t f1 = (f0 + job->tile < job->num_frames) ? f0 + job->tile : job->num_frames;
+        for (size_t f = f0; f < f1 && s == VV_DSP_OK; f += MEL_FRAME_TILE) {
+            const vv_dsp_real* power = &job->power[f * n_fft_bins];
+            const size_t nf = (f1 - f < MEL_FRAME_TILE) ? f1 - f : MEL_FRAME_TILE;
+            if (plan) {
+                s = mfcc_tile(plan, job->nan_policy, power, nf, scratch, &job->out[f * plan->num_mfcc_coeffs]);
+            } else {
+                vv_dsp_real* rows = &job->out[f * n_mels];
+                mel_sparse_project_tile(fb, power, nf, rows);
+                for (size_t i = 0; i < nf * n_mels; i++) {
+                    rows[i] = VV_DSP_LOG(rows[i] + job->log_epsilon);
+                }
+            }
+        }
+    }
+    vv_dsp_free(scratch);
+    job->status[w] = s;
+}
+
+static vv_dsp_status mel_batch_run(mel_batch_job* job, size_t num_threads) {
+    size_t tile = MEL_TILE_BYTES / (job->filterbank->n_fft_bins * sizeof(vv_dsp_real));
+    if (tile == 0) {
+        tile = 1;
+    }
+    job->tile = tile;
+    job->num_tiles = (job->num_frames + tile - 1) / tile;
+    size_t workers = num_threads ? num_threads : vv_dsp_parallel_pool_workers(job->pool);
+    if (workers > job->num_tiles) {
+        workers = job->num_tiles;
+    }
+    job->workers = workers;
+    job->status = (vv_dsp_status*)vv_dsp_malloc(workers * sizeof(vv_dsp_status));
+    if (!job->status) {
         return VV_DSP_ERROR_INTERNAL;
     }
+    vv_dsp_status s = vv_dsp_parallel_run_on(job->pool, workers, mel_batch_worker, job);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; w++) {
+        s = job->status[w];
+    }
+    vv_dsp_free(job->status);
+    return s;
+}
 
-    // Compute log-mel spectrogram
-    vv_dsp_status status = vv_dsp_compute_log_mel_spectrogram(
-        power_spectrogram, num_frames, plan->n_fft_bins,
-        plan->filterbank_weights, plan->n_mels, plan->log_epsilon,
-        temp_log_mel_all
-    );
+size_t vv_dsp_mfcc_process_typed_scratch_size(const vv_dsp_mfcc_plan* plan, size_t num_frames) {
+    if (!plan) {
+        return 0;
+    }
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_real) * num_frames *
+                                     (plan->n_fft_bins + plan->num_mfcc_coeffs));
+}
 
-    if (status != VV_DSP_OK) {
-        free(temp_log_mel_all);
-        return status;
+// Foreign-precision spectrogram: one scratch block from the arena holds the converted input and output
+static vv_dsp_status mfcc_process_foreign(const vv_dsp_mfcc_plan* plan, const vv_foreign_real* power,
+                                          size_t num_frames, vv_foreign_real* out, vv_dsp_arena* arena) {
+    if (!plan || !power || !out) {
+        return VV_DSP_ERROR_NULL_POINTER;
     }
+    if (num_frames == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    const size_t in_len = num_frames * plan->n_fft_bins, out_len = num_frames * plan->num_mfcc_coeffs;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* scratch = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, sizeof(vv_dsp_real) * (in_len + out_len));
+    if (!scratch) {
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    vv_dsp_status status = VV_FOREIGN_TO_REAL(power, scratch, in_len);
+    if (status == VV_DSP_OK) {
+        status = vv_dsp_mfcc_process(plan, scratch, num_frames, scratch + in_len);
+    }
+    if (status == VV_DSP_OK) {
+        status = VV_REAL_TO_FOREIGN(scratch + in_len, out, out_len);
+    }
+    vv_dsp_scratch_free(arena, scratch);
+    vv_dsp_arena_reset_to(arena, mark);
+    return status;
+}
 
-    // Compute MFCC
-    status = vv_dsp_mfcc(
-        temp_log_mel_all, num_frames, plan->n_mels, plan->num_mfcc_coeffs,
-        plan->dct_type, plan->lifter_coeff, out_mfcc_coeffs
-    );
+#ifdef VV_DSP_USE_DOUBLE
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f32(const vv_dsp_mfcc_plan* plan, const float* power_spectrogram,
+                                                       size_t num_frames, float* out_mfcc_coeffs,
+                                                       vv_dsp_arena* arena) {
+    return mfcc_process_foreign(plan, power_spectrogram, num_frames, out_mfcc_coeffs, arena);
+}
 
-    free(temp_log_mel_all);
-    return status;
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f64(const vv_dsp_mfcc_plan* plan, const double* power_spectrogram,
+                                                       size_t num_frames, double* out_mfcc_coeffs,
+                                                       vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_mfcc_process(plan, power_spectrogram, num_frames, out_mfcc_coeffs);
+}
+#else
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f32(const vv_dsp_mfcc_plan* plan, const float* power_spectrogram,
+                                                       size_t num_frames, float* out_mfcc_coeffs,
+                                                       vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_mfcc_process(plan, power_spectrogram, num_frames, out_mfcc_coeffs);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_f64(const vv_dsp_mfcc_plan* plan, const double* power_spectrogram,
+                                                       size_t num_frames, double* out_mfcc_coeffs,
+                                                       vv_dsp_arena* arena) {
+    return mfcc_process_foreign(plan, power_spectrogram, num_frames, out_mfcc_coeffs, arena);
+}
+#endif
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_process_parallel(
+    const vv_dsp_mfcc_plan* plan,
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    vv_dsp_real* out_mfcc_coeffs,
+    size_t num_threads
+) {
+    if (!plan || !power_spectrogram || !out_mfcc_coeffs) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (num_frames == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    mel_batch_job job;
+    memset(&job, 0, sizeof(job));
+    job.plan = plan;
+    job.filterbank = plan->filterbank;
+    job.nan_policy = vv_dsp_context_resolve_nan_policy(plan->nan_policy);
+    job.pool = plan->pool;
+    job.power = power_spectrogram;
+    job.num_frames = num_frames;
+    job.out = out_mfcc_coeffs;
+    return mel_batch_run(&job, num_threads);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_compute_log_mel_spectrogram_parallel(
+    const vv_dsp_real* power_spectrogram,
+    size_t num_frames,
+    const vv_dsp_mel_sparse* filterbank,
+    vv_dsp_real log_epsilon,
+    vv_dsp_real* out_log_mel_spectrogram,
+    size_t num_threads
+) {
+    if (!power_spectrogram || !filterbank || !out_log_mel_spectrogram) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (num_frames == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    if (log_epsilon < 0.0f) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    mel_batch_job job;
+    memset(&job, 0, sizeof(job));
+    job.filterbank = filterbank;
+    job.log_epsilon = log_epsilon;
+    job.power = power_spectrogram;
+    job.num_frames = num_frames;
+    job.out = out_log_mel_spectrogram;
+    return mel_batch_run(&job, num_threads);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_set_log_accuracy(
+    vv_dsp_mfcc_plan* plan,
+    vv_dsp_log_accuracy accuracy
+) {
+    if (!plan) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (accuracy != VV_DSP_LOG_ACCURACY_EXACT && accuracy != VV_DSP_LOG_ACCURACY_FAST) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    plan->precision = accuracy == VV_DSP_LOG_ACCURACY_FAST ? VV_DSP_PRECISION_BALANCED : VV_DSP_PRECISION_EXACT;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_mfcc_set_precision(
+    vv_dsp_mfcc_plan* plan,
+    vv_dsp_precision_mode mode
+) {
+    if (!plan) {
+        return VV_DSP_ERROR_NULL_POINTER;
+    }
+    if (!vv_dsp_precision_mode_valid(mode)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    plan->precision = mode;
+    return VV_DSP_OK;
 }
 
 vv_dsp_status vv_dsp_mfcc_destroy(vv_dsp_mfcc_plan* plan) {
@@ -454,10 +1210,10 @@ vv_dsp_status vv_dsp_mfcc_destroy(vv_dsp_mfcc_plan* plan) {
         return VV_DSP_ERROR_NULL_POINTER;
     }
 
-    vv_dsp_mel_filterbank_free(plan->filterbank_weights, plan->n_mels);
-    free(plan->temp_log_mel);
-    free(plan->temp_dct);
-    free(plan);
+    mel_cache_release(plan->shared);
+    vv_dsp_free(plan->lifter);
+    vv_dsp_free(plan->temp_log_mel);
+    vv_dsp_free(plan);
 
     return VV_DSP_OK;
 }
@@ -0,0 +1,282 @@
+#include "vv_dsp/features/onset.h"
+#include "vv_dsp/features/spectral_features.h"
+#include "vv_dsp/filter/moving.h"
+#include "vv_dsp/core/alloc.h"
+#include "../spectral/parallel.h"
+#include <string.h>
+
+#define ONSET_DEFAULT_MEDIAN 15
+#define ONSET_DEFAULT_MULTIPLIER 1.5
+#define ONSET_DEFAULT_PRE_MAX 3
+
+struct vv_dsp_onset {
+    size_t fft_size;
+    size_t hop;
+    size_t bins;
+    double fs;
+    double multiplier;
+    double delta;
+    size_t pre_max;
+    size_t post_max;
+    size_t min_gap;
+    vv_dsp_spectral_features* flux;
+    vv_dsp_moving* median;
+
+    vv_dsp_real* ring;       // strengths of the last pre_max + post_max + 1 frames
+    size_t ring_len;
+    size_t arrived;          // frames fed
+    size_t decided;          // next frame to decide
+    vv_dsp_real threshold;   // median of the latest window
+    size_t last_onset;
+    int has_onset;
+};
+
+void vv_dsp_onset_destroy(vv_dsp_onset* od) {
+    if (!od) return;
+    vv_dsp_spectral_features_destroy(od->flux);
+    vv_dsp_moving_destroy(od->median);
+    vv_dsp_free(od->ring);
+    vv_dsp_free(od);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_create(const vv_dsp_onset_params* params, vv_dsp_onset** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (params->fft_size < 2 || params->hop_size == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    // Written so that NaN fails too
+    if (!(params->sample_rate > 0) || !(params->multiplier >= 0) || !(params->delta >= 0)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    vv_dsp_onset* od = (vv_dsp_onset*)vv_dsp_calloc(1, sizeof(*od));
+    if (!od) return VV_DSP_ERROR_INTERNAL;
+    od->fft_size = params->fft_size;
+    od->hop = params->hop_size;
+    od->bins = params->fft_size / 2 + 1;
+    od->fs = (double)params->sample_rate;
+    od->multiplier = params->multiplier > 0 ? (double)params->multiplier : ONSET_DEFAULT_MULTIPLIER;
+    od->delta = (double)params->delta;
+    od->pre_max = params->pre_max ? params->pre_max : ONSET_DEFAULT_PRE_MAX;
+    od->post_max = params->post_max;
+    od->min_gap = params->min_gap ? params->min_gap : 1;
+    od->ring_len = od->pre_max + od->post_max + 1;
+    od->ring = (vv_dsp_real*)vv_dsp_calloc(od->ring_len, sizeof(vv_dsp_real));
+
+    vv_dsp_status s = od->ring ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    if (s == VV_DSP_OK) {
+        s = vv_dsp_spectral_features_create(params->fft_size, params->sample_rate, VV_DSP_SPECTRAL_FLUX, 0,
+                                            &od->flux);
+    }
+    if (s == VV_DSP_OK) {
+        s = vv_dsp_moving_create(VV_DSP_MOVING_MEDIAN,
+                                 params->median_window ? params->median_window : ONSET_DEFAULT_MEDIAN, 1,
+                                 &od->median);
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_onset_destroy(od);
+        return s;
+    }
+    *out = od;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_onset_latency(const vv_dsp_onset* od) {
+    return od ? od->post_max : 0;
+}
+
+// Decide frame od->decided against the frames that have arrived; 1 for an onset
+static int onset_decide(vv_dsp_onset* od) {
+    const size_t t = od->decided++;
+    const vv_dsp_real o = od->ring[t % od->ring_len];
+    const size_t first = t > od->pre_max ? t - od->pre_max : 0;
+    for (size_t j = first; j < t; ++j) {
+        if (!(o > od->ring[j % od->ring_len])) return 0;
+    }
+    for (size_t j = t + 1; j < od->arrived && j <= t + od->post_max; ++j) {
+        if (!(o >= od->ring[j % od->ring_len])) return 0;
+    }
+    if (!((double)o > od->delta + od->multiplier * (double)od->threshold)) return 0;
+    if (od->has_onset && t - od->last_onset < od->min_gap) return 0;
+    od->last_onset = t;
+    od->has_onset = 1;
+    return 1;
+}
+
+static vv_dsp_real onset_time(const vv_dsp_onset* od, size_t t) {
+    return (vv_dsp_real)(((double)t * (double)od->hop + (double)(od->fft_size / 2)) / od->fs);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_process(vv_dsp_onset* od,
+                                                    const vv_dsp_cpx* spectra,
+                                                    size_t num_frames,
+                                                    vv_dsp_real* strength,
+                                                    vv_dsp_real* onset_times,
+                                                    size_t max_onsets,
+                                                    size_t* out_onsets) {
+    if (!od) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_onsets) *out_onsets = 0;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!spectra) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t total = od->arrived + num_frames;
+    const size_t decisions = total > od->post_max ? total - od->post_max - od->decided : 0;
+    if (onset_times && decisions > max_onsets) return VV_DSP_ERROR_INVALID_SIZE;
+
+    size_t found = 0;
+    for (size_t f = 0; f < num_frames; ++f) {
+        vv_dsp_real o;
+        vv_dsp_status s = vv_dsp_spectral_features_process(od->flux, spectra + f * od->bins, 1, &o);
+        if (s == VV_DSP_OK) s = vv_dsp_moving_process(od->median, &o, &od->threshold, 1);
+        if (s != VV_DSP_OK) return s;
+        od->ring[od->arrived % od->ring_len] = o;
+        od->arrived++;
+        if (strength) strength[f] = o;
+        if (od->arrived > od->post_max && onset_decide(od)) {
+            if (onset_times) onset_times[found] = onset_time(od, od->last_onset);
+            found++;
+        }
+    }
+    if (out_onsets) *out_onsets = found;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_flush(vv_dsp_onset* od,
+                                                  vv_dsp_real* onset_times,
+                                                  size_t max_onsets,
+                                                  size_t* out_onsets) {
+    if (!od) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_onsets) *out_onsets = 0;
+    if (onset_times && od->arrived - od->decided > max_onsets) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t found = 0;
+    while (od->decided < od->arrived) {
+        if (onset_decide(od)) {
+            if (onset_times) onset_times[found] = onset_time(od, od->last_onset);
+            found++;
+        }
+    }
+    if (out_onsets) *out_onsets = found;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_onset_reset(vv_dsp_onset* od) {
+    if (!od) return VV_DSP_ERROR_NULL_POINTER;
+    memset(od->ring, 0, od->ring_len * sizeof(vv_dsp_real));
+    od->arrived = 0;
+    od->decided = 0;
+    od->threshold = 0;
+    od->last_onset = 0;
+    od->has_onset = 0;
+    vv_dsp_status s = vv_dsp_spectral_features_reset(od->flux);
+    vv_dsp_status s2 = vv_dsp_moving_reset(od->median);
+    return s != VV_DSP_OK ? s : s2;
+}
+
+// ---------------- Batch ----------------
+
+typedef struct onset_batch {
+    const vv_dsp_onset_params* params;
+    vv_dsp_stft_config* cfg;
+    const vv_dsp_real* const* signals;
+    const size_t* lengths;
+    size_t num_signals;
+    vv_dsp_real* const* onset_times;
+    const size_t* max_onsets;
+    size_t* num_onsets;
+    size_t workers;
+    vv_dsp_status* status;
+} onset_batch;
+
+// Keep the first max times of one signal, count them all
+static void onset_store(const onset_batch* b, size_t i, const vv_dsp_real* times, size_t k) {
+    const size_t max = b->max_onsets ? b->max_onsets[i] : 0;
+    for (size_t j = 0; j < k; ++j) {
+        if (b->num_onsets[i] < max) b->onset_times[i][b->num_onsets[i]] = times[j];
+        b->num_onsets[i]++;
+    }
+}
+
+static vv_dsp_status onset_batch_signal(const onset_batch* b, size_t i, vv_dsp_stft* h, vv_dsp_onset* od,
+                                        vv_dsp_cpx* spec, vv_dsp_real* times) {
+    const vv_dsp_real* x = b->signals[i];
+    const size_t n = b->lengths[i];
+    const size_t N = b->params->fft_size;
+    b->num_onsets[i] = 0;
+    vv_dsp_status s = vv_dsp_onset_reset(od);
+    if (s != VV_DSP_OK || n < N) return s;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = 1 + (n - N) / b->params->hop_size;
+    size_t k = 0;
+    for (size_t f = 0; s == VV_DSP_OK && f < frames; ++f) {
+        s = vv_dsp_stft_process(h, x + f * b->params->hop_size, spec);
+        if (s == VV_DSP_OK) s = vv_dsp_onset_process(od, spec, 1, NULL, times, 1, &k);
+        if (s == VV_DSP_OK) onset_store(b, i, times, k);
+    }
+    if (s == VV_DSP_OK) s = vv_dsp_onset_flush(od, times, od->post_max, &k);
+    if (s == VV_DSP_OK) onset_store(b, i, times, k);
+    return s;
+}
+
+// Worker w takes signals w, w + workers, ...
+static void onset_batch_worker(void* ctx, size_t w) {
+    onset_batch* b = (onset_batch*)ctx;
+    vv_dsp_stft* h = NULL;
+    vv_dsp_onset* od = NULL;
+    vv_dsp_cpx* spec = (vv_dsp_cpx*)vv_dsp_malloc((b->params->fft_size / 2 + 1) * sizeof(vv_dsp_cpx));
+    vv_dsp_real* times = (vv_dsp_real*)vv_dsp_malloc((b->params->post_max + 1) * sizeof(vv_dsp_real));
+    vv_dsp_status s = spec && times ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    if (s == VV_DSP_OK) s = vv_dsp_stft_create_from_config(b->cfg, &h);
+    if (s == VV_DSP_OK) s = vv_dsp_onset_create(b->params, &od);
+    for (size_t i = w; s == VV_DSP_OK && i < b->num_signals; i += b->workers) {
+        s = onset_batch_signal(b, i, h, od, spec, times);
+    }
+    vv_dsp_onset_destroy(od);
+    if (h) (void)vv_dsp_stft_destroy(h);
+    vv_dsp_free(times);
+    vv_dsp_free(spec);
+    b->status[w] = s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_onset_detect_batch(const vv_dsp_onset_params* params,
+                                                         const vv_dsp_real* const* signals,
+                                                         const size_t* lengths,
+                                                         size_t num_signals,
+                                                         vv_dsp_real* const* onset_times,
+                                                         const size_t* max_onsets,
+                                                         size_t* num_onsets) {
+    if (!params) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_signals == 0) return VV_DSP_OK;
+    if (!signals || !lengths || !num_onsets || (max_onsets && !onset_times)) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; max_onsets && i < num_signals; ++i) {
+        if (max_onsets[i] && !onset_times[i]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    // Validates the parameters before any worker starts
+    vv_dsp_onset* probe = NULL;
+    vv_dsp_status s = vv_dsp_onset_create(params, &probe);
+    vv_dsp_onset_destroy(probe);
+    if (s != VV_DSP_OK) return s;
+
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = params->fft_size;
+    sp.hop_size = params->hop_size;
+    sp.window = params->window;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    sp.periodic = 1;
+    onset_batch b;
+    memset(&b, 0, sizeof(b));
+    s = vv_dsp_stft_config_create(&sp, &b.cfg);
+    if (s != VV_DSP_OK) return s;
+    b.params = params;
+    b.signals = signals;
+    b.lengths = lengths;
+    b.num_signals = num_signals;
+    b.onset_times = onset_times;
+    b.max_onsets = max_onsets;
+    b.num_onsets = num_onsets;
+    b.workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+    if (b.workers > num_signals) b.workers = num_signals;
+    b.status = (vv_dsp_status*)vv_dsp_malloc(b.workers * sizeof(vv_dsp_status));
+    s = b.status ? vv_dsp_parallel_run(b.workers, onset_batch_worker, &b) : VV_DSP_ERROR_INTERNAL;
+    for (size_t w = 0; s == VV_DSP_OK && w < b.workers; ++w) s = b.status[w];
+    vv_dsp_free(b.status);
+    (void)vv_dsp_stft_config_release(b.cfg);
+    return s;
+}
@@ -0,0 +1,298 @@
+#include "vv_dsp/features/pitch.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/alloc.h"
+#include "../spectral/parallel.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define YIN_DEFAULT_HOP 256
+#define YIN_DEFAULT_THRESHOLD 0.1
+#define YIN_MIN_RUN 16  // frames per worker before another worker is worth waking
+
+typedef struct {
+    vv_dsp_fft_plan* fwd;  // R2C, private to the worker
+    vv_dsp_fft_plan* bwd;  // C2R
+    vv_dsp_real* seg;      // nfft: the span, zero-padded
+    vv_dsp_real* head;     // nfft: first W samples, zero-padded; later r(tau)
+    vv_dsp_cpx* A;         // nfft/2 + 1
+    vv_dsp_cpx* B;         // nfft/2 + 1
+    double* energy;        // span + 1 prefix sums of x^2
+    double* d;             // tau_max + 1: d'(tau)
+} yin_scratch;
+
+struct vv_dsp_yin {
+    double fs;
+    size_t tau_min;
+    size_t tau_max;
+    size_t W;
+    size_t span;           // W + tau_max
+    size_t hop;
+    double threshold;
+    size_t nfft;           // power of two >= span: r(tau) never wraps
+    size_t num_workers;
+    yin_scratch* scratch;  // one per worker; streaming uses worker 0
+    vv_dsp_status* status; // one per worker
+
+    // Streaming ring
+    vv_dsp_real* ring;
+    size_t ring_mask;
+    uint64_t pushed;
+    uint64_t emitted;
+
+    // Current batch call
+    const vv_dsp_real* x;
+    size_t num_frames;
+    size_t run;
+    vv_dsp_real* f0;
+    vv_dsp_real* periodicity;
+};
+
+static void* yin_alloc(size_t bytes) {
+    return vv_dsp_aligned_malloc(bytes, VV_DSP_SIMD_ALIGN_DEFAULT);
+}
+
+void vv_dsp_yin_destroy(vv_dsp_yin* y) {
+    if (!y) return;
+    if (y->scratch) {
+        for (size_t w = 0; w < y->num_workers; ++w) {
+            yin_scratch* s = &y->scratch[w];
+            vv_dsp_fft_plan_release(s->fwd);
+            vv_dsp_fft_plan_release(s->bwd);
+            vv_dsp_aligned_free(s->seg);
+            vv_dsp_aligned_free(s->head);
+            vv_dsp_aligned_free(s->A);
+            vv_dsp_aligned_free(s->B);
+            vv_dsp_aligned_free(s->energy);
+            vv_dsp_aligned_free(s->d);
+        }
+        vv_dsp_free(y->scratch);
+    }
+    vv_dsp_aligned_free(y->ring);
+    vv_dsp_free(y->status);
+    vv_dsp_free(y);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_create(const vv_dsp_yin_params* params, vv_dsp_yin** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const double fs = (double)params->sample_rate;
+    const double lo = (double)params->f0_min, hi = (double)params->f0_max;
+    if (!(fs > 0) || !(lo > 0) || !(hi > lo) || hi > fs / 2) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_yin* y = (vv_dsp_yin*)vv_dsp_calloc(1, sizeof(*y));
+    if (!y) return VV_DSP_ERROR_INTERNAL;
+    y->fs = fs;
+    y->tau_min = (size_t)floor(fs / hi);
+    if (y->tau_min < 2) y->tau_min = 2;
+    y->tau_max = (size_t)ceil(fs / lo);
+    if (y->tau_max <= y->tau_min) y->tau_max = y->tau_min + 1;
+    y->W = params->window ? params->window : y->tau_max;
+    y->span = y->W + y->tau_max;
+    y->hop = params->hop ? params->hop : YIN_DEFAULT_HOP;
+    y->threshold = params->threshold > 0 ? (double)params->threshold : YIN_DEFAULT_THRESHOLD;
+    y->nfft = 1;
+    while (y->nfft < y->span) y->nfft <<= 1;
+    size_t ring_len = 1;
+    while (ring_len < y->span) ring_len <<= 1;
+    y->ring_mask = ring_len - 1;
+    y->num_workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+    if (y->num_workers == 0) y->num_workers = 1;
+
+    y->scratch = (yin_scratch*)vv_dsp_calloc(y->num_workers, sizeof(yin_scratch));
+    y->status = (vv_dsp_status*)vv_dsp_malloc(y->num_workers * sizeof(vv_dsp_status));
+    y->ring = (vv_dsp_real*)yin_alloc(ring_len * sizeof(vv_dsp_real));
+    if (!y->scratch || !y->status || !y->ring) { vv_dsp_yin_destroy(y); return VV_DSP_ERROR_INTERNAL; }
+    const size_t nbins = y->nfft / 2 + 1;
+    for (size_t w = 0; w < y->num_workers; ++w) {
+        yin_scratch* s = &y->scratch[w];
+        if (vv_dsp_fft_plan_acquire(y->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &s->fwd) != VV_DSP_OK ||
+            vv_dsp_fft_plan_acquire(y->nfft, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &s->bwd) != VV_DSP_OK) {
+            vv_dsp_yin_destroy(y);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        s->seg = (vv_dsp_real*)yin_alloc(y->nfft * sizeof(vv_dsp_real));
+        s->head = (vv_dsp_real*)yin_alloc(y->nfft * sizeof(vv_dsp_real));
+        s->A = (vv_dsp_cpx*)yin_alloc(nbins * sizeof(vv_dsp_cpx));
+        s->B = (vv_dsp_cpx*)yin_alloc(nbins * sizeof(vv_dsp_cpx));
+        s->energy = (double*)yin_alloc((y->span + 1) * sizeof(double));
+        s->d = (double*)yin_alloc((y->tau_max + 1) * sizeof(double));
+        if (!s->seg || !s->head || !s->A || !s->B || !s->energy || !s->d) {
+            vv_dsp_yin_destroy(y);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    *out = y;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_yin_frame_span(const vv_dsp_yin* y) {
+    return y ? y->span : 0;
+}
+
+size_t vv_dsp_yin_hop(const vv_dsp_yin* y) {
+    return y ? y->hop : 0;
+}
+
+static uint64_t yin_frames_after(const vv_dsp_yin* y, uint64_t n) {
+    return n < y->span ? 0 : 1 + (n - y->span) / y->hop;
+}
+
+size_t vv_dsp_yin_num_frames(const vv_dsp_yin* y, size_t n) {
+    return y ? (size_t)yin_frames_after(y, n) : 0;
+}
+
+// Analyse the span already copied to s->seg[0..span)
+static vv_dsp_status yin_frame(const vv_dsp_yin* y, yin_scratch* s, vv_dsp_real* f0_out, vv_dsp_real* per_out) {
+    const size_t W = y->W, span = y->span, nfft = y->nfft, nbins = nfft / 2 + 1;
+    memset(&s->seg[span], 0, (nfft - span) * sizeof(vv_dsp_real));
+    memcpy(s->head, s->seg, W * sizeof(vv_dsp_real));
+    memset(&s->head[W], 0, (nfft - W) * sizeof(vv_dsp_real));
+
+    // r(tau) = sum_{j<W} x[j] x[j+tau] = IFFT(conj(A) B); nfft >= span keeps it linear
+    vv_dsp_status st = vv_dsp_fft_execute(s->fwd, s->head, s->A);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_execute(s->fwd, s->seg, s->B);
+    if (st != VV_DSP_OK) return st;
+    for (size_t k = 0; k < nbins; ++k) {
+        const vv_dsp_real ar = s->A[k].re, ai = s->A[k].im, br = s->B[k].re, bi = s->B[k].im;
+        s->A[k].re = ar * br + ai * bi;
+        s->A[k].im = ar * bi - ai * br;
+    }
+    st = vv_dsp_fft_execute(s->bwd, s->A, s->head);
+    if (st != VV_DSP_OK) return st;
+    const vv_dsp_real* r = s->head;
+
+    double acc = 0.0;
+    s->energy[0] = 0.0;
+    for (size_t i = 0; i < span; ++i) {
+        acc += (double)s->seg[i] * (double)s->seg[i];
+        s->energy[i + 1] = acc;
+    }
+
+    // Cumulative mean normalised difference d'(tau)
+    const double e0 = s->energy[W];
+    double* dn = s->d;
+    double running = 0.0;
+    dn[0] = 1.0;
+    for (size_t tau = 1; tau <= y->tau_max; ++tau) {
+        double d = e0 + (s->energy[tau + W] - s->energy[tau]) - 2.0 * (double)r[tau];
+        if (d < 0.0) d = 0.0;
+        running += d;
+        dn[tau] = running > 0.0 ? d * (double)tau / running : 1.0;
+    }
+
+    // First dip below the threshold, followed down to its minimum; else the global minimum
+    size_t best = 0;
+    for (size_t tau = y->tau_min; tau <= y->tau_max; ++tau) {
+        if (dn[tau] < y->threshold) {
+            while (tau + 1 <= y->tau_max && dn[tau + 1] < dn[tau]) ++tau;
+            best = tau;
+            break;
+        }
+    }
+    const int voiced = best != 0;
+    if (!voiced) {
+        best = y->tau_min;
+        for (size_t tau = y->tau_min + 1; tau <= y->tau_max; ++tau) {
+            if (dn[tau] < dn[best]) best = tau;
+        }
+    }
+
+    double tau_f = (double)best, dmin = dn[best];
+    if (best > y->tau_min && best < y->tau_max) {
+        const double a = dn[best - 1], b = dn[best], c = dn[best + 1];
+        const double den = a - 2.0 * b + c;
+        if (den > 0.0) {
+            const double shift = 0.5 * (a - c) / den;
+            tau_f += shift;
+            dmin = b - 0.25 * (a - c) * shift;
+        }
+    }
+    double per = 1.0 - dmin;
+    if (per < 0.0) per = 0.0;
+    if (per > 1.0) per = 1.0;
+    *f0_out = voiced ? (vv_dsp_real)(y->fs / tau_f) : (vv_dsp_real)0;
+    if (per_out) *per_out = (vv_dsp_real)per;
+    return VV_DSP_OK;
+}
+
+static void yin_worker(void* ctx, size_t w) {
+    vv_dsp_yin* y = (vv_dsp_yin*)ctx;
+    yin_scratch* s = &y->scratch[w];
+    const size_t f_begin = w * y->run;
+    const size_t f_end = (f_begin + y->run < y->num_frames) ? f_begin + y->run : y->num_frames;
+    vv_dsp_status st = VV_DSP_OK;
+    for (size_t f = f_begin; st == VV_DSP_OK && f < f_end; ++f) {
+        memcpy(s->seg, &y->x[f * y->hop], y->span * sizeof(vv_dsp_real));
+        st = yin_frame(y, s, &y->f0[f], y->periodicity ? &y->periodicity[f] : NULL);
+    }
+    y->status[w] = st;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_process(vv_dsp_yin* y, const vv_dsp_real* x, size_t n, vv_dsp_real* f0,
+                                                  vv_dsp_real* periodicity) {
+    if (!y || !x || !f0) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = vv_dsp_yin_num_frames(y, n);
+    if (frames == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    size_t run = (frames + y->num_workers - 1) / y->num_workers;
+    if (run < YIN_MIN_RUN) run = YIN_MIN_RUN;
+    const size_t workers = (frames + run - 1) / run;
+    y->x = x;
+    y->num_frames = frames;
+    y->run = run;
+    y->f0 = f0;
+    y->periodicity = periodicity;
+    vv_dsp_status s = vv_dsp_parallel_run(workers, yin_worker, y);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; ++w) s = y->status[w];
+    y->x = NULL;
+    y->f0 = y->periodicity = NULL;
+    return s;
+}
+
+size_t vv_dsp_yin_output_count(const vv_dsp_yin* y, size_t n) {
+    if (!y) return 0;
+    return (size_t)(yin_frames_after(y, y->pushed + n) - y->emitted);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_yin_push(vv_dsp_yin* y, const vv_dsp_real* x, size_t n, vv_dsp_real* f0,
+                                               vv_dsp_real* periodicity, size_t max_frames, size_t* out_frames) {
+    if (!y || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t count = vv_dsp_yin_output_count(y, n);
+    if (count > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (count && !f0) return VV_DSP_ERROR_NULL_POINTER;
+
+    yin_scratch* s = &y->scratch[0];
+    size_t written = 0, i = 0;
+    while (i < n) {
+        // Copy up to the end of the next frame's span, then analyse it if complete
+        const uint64_t frame_end = y->emitted * y->hop + y->span;
+        size_t take = n - i;
+        if (frame_end > y->pushed && frame_end - y->pushed < take) take = (size_t)(frame_end - y->pushed);
+        for (size_t k = 0; k < take; ++k) y->ring[(size_t)(y->pushed + k) & y->ring_mask] = x[i + k];
+        y->pushed += take;
+        i += take;
+        if (y->pushed == frame_end) {
+            const uint64_t start = frame_end - y->span;
+            for (size_t k = 0; k < y->span; ++k) s->seg[k] = y->ring[(size_t)(start + k) & y->ring_mask];
+            vv_dsp_status st = yin_frame(y, s, &f0[written], periodicity ? &periodicity[written] : NULL);
+            if (st != VV_DSP_OK) return st;
+            ++written;
+            ++y->emitted;
+        }
+    }
+    *out_frames = written;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_yin_reset(vv_dsp_yin* y) {
+    if (!y) return VV_DSP_ERROR_NULL_POINTER;
+    y->pushed = 0;
+    y->emitted = 0;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,158 @@
+#include "vv_dsp/features/spectral_features.h"
+#include <math.h>
+#include <string.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/vmath.h"
+
+#define SF_POWER_FLOOR ((vv_dsp_real)1e-10)  // flatness floor on the power
+
+struct vv_dsp_spectral_features {
+    unsigned int features;
+    size_t n_bins;
+    size_t count;
+    double bin_hz;             // sample_rate / fft_size
+    double rolloff_percent;
+    vv_dsp_precision_mode precision;
+    int has_prev;
+
+    vv_dsp_real* power;        // n_bins, then the log power for flatness
+    vv_dsp_real* mag;          // n_bins
+    vv_dsp_real* prev;         // n_bins, the previous frame's magnitudes
+};
+
+void vv_dsp_spectral_features_destroy(vv_dsp_spectral_features* sf) {
+    if (!sf) return;
+    vv_dsp_free(sf->power);
+    vv_dsp_free(sf->mag);
+    vv_dsp_free(sf->prev);
+    vv_dsp_free(sf);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_create(size_t fft_size,
+                                                               vv_dsp_real sample_rate,
+                                                               unsigned int features,
+                                                               vv_dsp_real rolloff_percent,
+                                                               vv_dsp_spectral_features** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (fft_size < 2) return VV_DSP_ERROR_INVALID_SIZE;
+    if (features == 0 || (features & ~(unsigned int)VV_DSP_SPECTRAL_ALL) != 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!(sample_rate > 0) || !(rolloff_percent >= 0 && rolloff_percent <= 1)) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_spectral_features* sf = (vv_dsp_spectral_features*)vv_dsp_calloc(1, sizeof(*sf));
+    if (!sf) return VV_DSP_ERROR_INTERNAL;
+    sf->features = features;
+    sf->n_bins = fft_size / 2 + 1;
+    sf->bin_hz = (double)sample_rate / (double)fft_size;
+    sf->rolloff_percent = rolloff_percent > 0 ? (double)rolloff_percent : 0.85;
+    sf->precision = VV_DSP_PRECISION_EXACT;
+    for (unsigned int f = features; f; f &= f - 1) sf->count++;
+
+    sf->power = (vv_dsp_real*)vv_dsp_malloc(sf->n_bins * sizeof(vv_dsp_real));
+    sf->mag = (vv_dsp_real*)vv_dsp_malloc(sf->n_bins * sizeof(vv_dsp_real));
+    sf->prev = (vv_dsp_real*)vv_dsp_calloc(sf->n_bins, sizeof(vv_dsp_real));
+    if (!sf->power || !sf->mag || !sf->prev) {
+        vv_dsp_spectral_features_destroy(sf);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = sf;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_spectral_features_count(const vv_dsp_spectral_features* sf) {
+    return sf ? sf->count : 0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_set_precision(vv_dsp_spectral_features* sf,
+                                                                      vv_dsp_precision_mode mode) {
+    if (!sf) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_precision_mode_valid(mode)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    sf->precision = mode;
+    return VV_DSP_OK;
+}
+
+// Descriptors of one half spectrum
+static vv_dsp_status describe_frame(vv_dsp_spectral_features* sf, const vv_dsp_cpx* X, vv_dsp_real* out) {
+    const size_t nb = sf->n_bins;
+    const unsigned int want = sf->features;
+    vv_dsp_real* P = sf->power;
+    vv_dsp_real* M = sf->mag;
+    vv_dsp_real* prev = sf->prev;
+
+    vv_dsp_status s = vv_dsp_cpx_power_array(X, P, nb);
+    if (s == VV_DSP_OK) s = vv_dsp_vsqrt(P, M, nb);
+    if (s != VV_DSP_OK) return s;
+    double sum_p = 0.0, sum_logp = 0.0;
+    if (want & VV_DSP_SPECTRAL_FLATNESS) {
+        for (size_t k = 0; k < nb; ++k) {
+            if (P[k] < SF_POWER_FLOOR) P[k] = SF_POWER_FLOOR;
+            sum_p += (double)P[k];
+        }
+        s = vv_dsp_vlog(P, P, nb, vv_dsp_precision_vmath_tier(sf->precision));
+        if (s != VV_DSP_OK) return s;
+    }
+
+    // The fused pass: magnitude moments in bin units, flux, log power
+    double sum_m = 0.0, sum_mk = 0.0, sum_mk2 = 0.0, sum_d2 = 0.0;
+    for (size_t k = 0; k < nb; ++k) {
+        const double m = (double)M[k], kk = (double)k;
+        const double d = m - (double)prev[k];
+        sum_m += m;
+        sum_mk += m * kk;
+        sum_mk2 += m * kk * kk;
+        sum_d2 += d * d;
+        sum_logp += (double)P[k];
+        prev[k] = M[k];
+    }
+
+    const double centroid = sum_m > 0.0 ? sum_mk / sum_m : 0.0;  // in bins
+    size_t o = 0;
+    if (want & VV_DSP_SPECTRAL_CENTROID) out[o++] = (vv_dsp_real)(centroid * sf->bin_hz);
+    if (want & VV_DSP_SPECTRAL_BANDWIDTH) {
+        double var = sum_m > 0.0 ? sum_mk2 / sum_m - centroid * centroid : 0.0;
+        if (var < 0.0) var = 0.0;
+        out[o++] = (vv_dsp_real)(sqrt(var) * sf->bin_hz);
+    }
+    if (want & VV_DSP_SPECTRAL_ROLLOFF) {
+        size_t k = 0;
+        if (sum_m > 0.0) {
+            const double target = sf->rolloff_percent * sum_m;
+            double acc = 0.0;
+            for (k = 0; k + 1 < nb; ++k) {
+                acc += (double)M[k];
+                if (acc >= target) break;
+            }
+        }
+        out[o++] = (vv_dsp_real)((double)k * sf->bin_hz);
+    }
+    if (want & VV_DSP_SPECTRAL_FLUX) out[o++] = sf->has_prev ? (vv_dsp_real)sqrt(sum_d2) : (vv_dsp_real)0;
+    if (want & VV_DSP_SPECTRAL_FLATNESS) {
+        const double n = (double)nb;
+        out[o++] = (vv_dsp_real)(exp(sum_logp / n) / (sum_p / n));
+    }
+    sf->has_prev = 1;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_features_process(vv_dsp_spectral_features* sf,
+                                                                const vv_dsp_cpx* spectra,
+                                                                size_t num_frames,
+                                                                vv_dsp_real* out) {
+    if (!sf) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!spectra || !out) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t f = 0; f < num_frames; ++f) {
+        vv_dsp_status s = describe_frame(sf, spectra + f * sf->n_bins, out + f * sf->count);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_spectral_features_reset(vv_dsp_spectral_features* sf) {
+    if (!sf) return VV_DSP_ERROR_NULL_POINTER;
+    sf->has_prev = 0;
+    memset(sf->prev, 0, sf->n_bins * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
@@ -0,0 +1,208 @@
+#include "vv_dsp/features/vad.h"
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <string.h>
+
+#define VAD_MAX_BANDS 4
+#define VAD_CHUNK 64                   // samples broadcast to the bank at a time
+#define VAD_ADAPT 0.05                 // floor tracking on non-speech frames
+#define VAD_RISE_DB_PER_S 3.0          // floor rise on speech frames
+#define VAD_TINY 1e-20
+
+static const double vad_centres[VAD_MAX_BANDS] = { 300.0, 700.0, 1500.0, 3000.0 };
+
+struct vv_dsp_vad {
+    size_t frame_size;
+    size_t num_bands;
+    double threshold_db;
+    double energy_floor;       // mean square
+    double zcr_max;
+    size_t hangover;
+    double rise;               // per-frame floor growth factor on speech frames
+    vv_dsp_biquad_bank* bank;
+
+    // Current frame
+    size_t pos;
+    double energy;
+    double band[VAD_MAX_BANDS];
+    size_t crossings;
+    vv_dsp_real prev;          // last sample, for crossings across chunks
+
+    // Decisions
+    int primed;
+    double floor[VAD_MAX_BANDS];
+    size_t hang;
+    int active;
+    double snr_db;
+
+    vv_dsp_real scratch[VAD_CHUNK * VAD_MAX_BANDS];
+};
+
+void vv_dsp_vad_destroy(vv_dsp_vad* vad) {
+    if (!vad) return;
+    vv_dsp_biquad_bank_destroy(vad->bank);
+    vv_dsp_free(vad);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vad_create(const vv_dsp_vad_params* params, vv_dsp_vad** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    // Written so that NaN fails too
+    if (!(params->sample_rate >= 1000) || !(params->threshold_db >= 0) || !(params->energy_floor_db <= 0) ||
+        !(params->zcr_max >= 0 && params->zcr_max <= 1)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const double fs = (double)params->sample_rate;
+    vv_dsp_vad* vad = (vv_dsp_vad*)vv_dsp_calloc(1, sizeof(*vad));
+    if (!vad) return VV_DSP_ERROR_INTERNAL;
+    vad->frame_size = params->frame_size ? params->frame_size : (size_t)(0.01 * fs + 0.5);
+    vad->threshold_db = params->threshold_db > 0 ? (double)params->threshold_db : 6.0;
+    vad->energy_floor = pow(10.0, (params->energy_floor_db < 0 ? (double)params->energy_floor_db : -60.0) / 10.0);
+    vad->zcr_max = params->zcr_max > 0 ? (double)params->zcr_max : 0.35;
+    vad->hangover = params->hangover ? params->hangover : 15;
+    vad->rise = pow(10.0, VAD_RISE_DB_PER_S * (double)vad->frame_size / fs / 10.0);
+    while (vad->num_bands < VAD_MAX_BANDS && vad_centres[vad->num_bands] < 0.45 * fs) vad->num_bands++;
+
+    vv_dsp_status s = vv_dsp_biquad_bank_create(vad->num_bands, 1, &vad->bank);
+    // RBJ band-pass, constant 0 dB peak gain
+    for (size_t b = 0; s == VV_DSP_OK && b < vad->num_bands; ++b) {
+        const double w0 = VV_DSP_TWO_PI_D * vad_centres[b] / fs;
+        const double alpha = sin(w0) / 2.0;  // Q = 1
+        const double a0 = 1.0 + alpha;
+        s = vv_dsp_biquad_bank_set_channel_stage(vad->bank, b, 0, (vv_dsp_real)(alpha / a0), 0,
+                                                 (vv_dsp_real)(-alpha / a0), (vv_dsp_real)(-2.0 * cos(w0) / a0),
+                                                 (vv_dsp_real)((1.0 - alpha) / a0));
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_vad_destroy(vad);
+        return s;
+    }
+    *out = vad;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_vad_frame_size(const vv_dsp_vad* vad) {
+    return vad ? vad->frame_size : 0;
+}
+
+// Accumulate m samples (m <= VAD_CHUNK) into the current frame
+static vv_dsp_status vad_accumulate(vv_dsp_vad* vad, const vv_dsp_real* x, size_t m) {
+    const size_t nb = vad->num_bands;
+    vv_dsp_real* s = vad->scratch;
+    vv_dsp_real e = 0;
+    size_t zc = (vad->prev > 0 && x[0] < 0) || (vad->prev < 0 && x[0] > 0);
+    for (size_t i = 0; i < m; ++i) e += x[i] * x[i];
+    for (size_t i = 1; i < m; ++i) zc += (size_t)((x[i - 1] > 0 && x[i] < 0) | (x[i - 1] < 0 && x[i] > 0));
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t b = 0; b < nb; ++b) s[i * nb + b] = x[i];
+    }
+    vv_dsp_status st = vv_dsp_biquad_bank_process(vad->bank, s, s, m);
+    if (st != VV_DSP_OK) return st;
+    vv_dsp_real be[VAD_MAX_BANDS] = { 0 };
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t b = 0; b < nb; ++b) be[b] += s[i * nb + b] * s[i * nb + b];
+    }
+    vad->energy += (double)e;
+    for (size_t b = 0; b < nb; ++b) vad->band[b] += (double)be[b];
+    vad->crossings += zc;
+    vad->prev = x[m - 1];
+    return VV_DSP_OK;
+}
+
+// Decide the completed frame and update the floors
+static int vad_decide(vv_dsp_vad* vad) {
+    const size_t nb = vad->num_bands;
+    const double inv = 1.0 / (double)vad->frame_size;
+    double e[VAD_MAX_BANDS];
+    for (size_t b = 0; b < nb; ++b) e[b] = vad->band[b] * inv + VAD_TINY;
+    if (!vad->primed) {
+        for (size_t b = 0; b < nb; ++b) vad->floor[b] = e[b];
+        vad->primed = 1;
+    }
+    double snr = 0.0;
+    for (size_t b = 0; b < nb; ++b) {
+        const double d = 10.0 * log10(e[b] / vad->floor[b]);
+        snr += d > 0.0 ? d : 0.0;
+    }
+    snr /= (double)nb;
+    const double zcr = (double)vad->crossings * inv;
+    const double threshold = zcr > vad->zcr_max ? 2.0 * vad->threshold_db : vad->threshold_db;
+    const int speech = snr > threshold && vad->energy * inv > vad->energy_floor;
+
+    for (size_t b = 0; b < nb; ++b) {
+        double f = vad->floor[b];
+        if (e[b] < f) f = e[b];
+        else if (!speech) f += VAD_ADAPT * (e[b] - f);
+        else f = f * vad->rise < e[b] ? f * vad->rise : e[b];
+        vad->floor[b] = f;
+    }
+    if (speech) vad->hang = vad->hangover;
+    else if (vad->hang) vad->hang--;
+    vad->active = speech || vad->hang > 0;
+    vad->snr_db = snr;
+
+    vad->pos = 0;
+    vad->energy = 0.0;
+    memset(vad->band, 0, sizeof(vad->band));
+    vad->crossings = 0;
+    return vad->active;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_vad_process(vv_dsp_vad* vad,
+                                                  const vv_dsp_real* x,
+                                                  size_t n,
+                                                  unsigned char* flags,
+                                                  size_t max_flags,
+                                                  size_t* out_frames) {
+    if (!vad) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_frames) *out_frames = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    if (flags && (vad->pos + n) / vad->frame_size > max_flags) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t frames = 0;
+    while (n > 0) {
+        size_t m = vad->frame_size - vad->pos;
+        if (m > VAD_CHUNK) m = VAD_CHUNK;
+        if (m > n) m = n;
+        vv_dsp_status s = vad_accumulate(vad, x, m);
+        if (s != VV_DSP_OK) return s;
+        x += m;
+        n -= m;
+        vad->pos += m;
+        if (vad->pos == vad->frame_size) {
+            const int active = vad_decide(vad);
+            if (flags) flags[frames] = (unsigned char)active;
+            frames++;
+        }
+    }
+    if (out_frames) *out_frames = frames;
+    return VV_DSP_OK;
+}
+
+int vv_dsp_vad_active(const vv_dsp_vad* vad) {
+    return vad ? vad->active : 0;
+}
+
+int vv_dsp_vad_gate(void* vad) {
+    return vv_dsp_vad_active((const vv_dsp_vad*)vad);
+}
+
+vv_dsp_real vv_dsp_vad_snr_db(const vv_dsp_vad* vad) {
+    return vad ? (vv_dsp_real)vad->snr_db : 0;
+}
+
+vv_dsp_status vv_dsp_vad_reset(vv_dsp_vad* vad) {
+    if (!vad) return VV_DSP_ERROR_NULL_POINTER;
+    vad->pos = 0;
+    vad->energy = 0.0;
+    memset(vad->band, 0, sizeof(vad->band));
+    vad->crossings = 0;
+    vad->prev = 0;
+    vad->primed = 0;
+    vad->hang = 0;
+    vad->active = 0;
+    vad->snr_db = 0.0;
+    return vv_dsp_biquad_bank_reset(vad->bank);
+}
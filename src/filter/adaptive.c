@@ -0,0 +1,307 @@
+#include "vv_dsp/filter/adaptive.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FDAF_DEFAULT_STEP ((vv_dsp_real)0.5)
+#define FDAF_DEFAULT_REG ((vv_dsp_real)1e-6)
+
+struct vv_dsp_fdaf {
+    size_t B;                // block and partition size
+    size_t nc;               // B + 1 bins of the 2B-point FFT
+    size_t P;                // partitions per channel
+    size_t C;                // reference channels
+    vv_dsp_fdaf_constraint constraint;
+    vv_dsp_real step;
+    vv_dsp_real delta;       // per-bin regularization: reg * 2B * P * C
+    vv_dsp_fdaf_step_fn hook;
+    void* hook_user;
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2r;
+    vv_dsp_cpx* W;           // C * P partition spectra
+    vv_dsp_cpx* fdl;         // C * P input spectra; slot head is the newest of every channel
+    vv_dsp_real* pw;         // C * P |X|^2 matching fdl
+    size_t head;
+    vv_dsp_real* inbuf;      // C * 2B: previous block | current block
+    vv_dsp_real* fill_ref;   // C * B samples being gathered
+    vv_dsp_real* fill_mic;   // B
+    size_t fill_n;
+    vv_dsp_real* out_err;    // B errors of the last block, read out during the next one
+    vv_dsp_real* out_echo;   // B
+    vv_dsp_real* norm;       // nc per-bin step
+    vv_dsp_cpx* Y;           // nc
+    vv_dsp_cpx* E;           // nc
+    vv_dsp_cpx* G;           // nc
+    vv_dsp_real* time;       // 2B
+    size_t next_constrained; // ROTATE: partition constrained in the next block
+    size_t blocks;
+};
+
+void vv_dsp_fdaf_destroy(vv_dsp_fdaf* f) {
+    if (!f) return;
+    if (f->r2c) (void)vv_dsp_fft_plan_release(f->r2c);
+    if (f->c2r) (void)vv_dsp_fft_plan_release(f->c2r);
+    vv_dsp_free(f->W); vv_dsp_free(f->fdl); vv_dsp_free(f->pw); vv_dsp_free(f->inbuf);
+    vv_dsp_free(f->fill_ref); vv_dsp_free(f->fill_mic); vv_dsp_free(f->out_err); vv_dsp_free(f->out_echo);
+    vv_dsp_free(f->norm); vv_dsp_free(f->Y); vv_dsp_free(f->E); vv_dsp_free(f->G); vv_dsp_free(f->time);
+    vv_dsp_free(f);
+}
+
+vv_dsp_status vv_dsp_fdaf_create(const vv_dsp_fdaf_params* prm, vv_dsp_fdaf** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!prm) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t B = prm->block_size;
+    if (prm->num_taps == 0 || B == 0 || (B & (B - 1)) != 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const vv_dsp_real step = (prm->step == (vv_dsp_real)0) ? FDAF_DEFAULT_STEP : prm->step;
+    const vv_dsp_real reg = (prm->regularization == (vv_dsp_real)0) ? FDAF_DEFAULT_REG : prm->regularization;
+    if (!(step > (vv_dsp_real)0 && step < (vv_dsp_real)2) || !(reg > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (prm->constraint != VV_DSP_FDAF_CONSTRAIN_ROTATE && prm->constraint != VV_DSP_FDAF_CONSTRAIN_ALL &&
+        prm->constraint != VV_DSP_FDAF_CONSTRAIN_NONE)
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_fdaf* f = (vv_dsp_fdaf*)vv_dsp_calloc(1, sizeof(*f));
+    if (!f) return VV_DSP_ERROR_INTERNAL;
+    f->B = B;
+    f->nc = B + 1;
+    f->P = (prm->num_taps + B - 1) / B;
+    f->C = prm->num_channels ? prm->num_channels : 1;
+    f->constraint = prm->constraint;
+    f->step = step;
+    // An unscaled 2B-point transform of samples of power s has E|X_k|^2 = 2B s
+    f->delta = reg * (vv_dsp_real)(2 * B * f->P * f->C);
+    const size_t CP = f->C * f->P, nc = f->nc;
+    f->W = (vv_dsp_cpx*)vv_dsp_calloc(CP * nc, sizeof(vv_dsp_cpx));
+    f->fdl = (vv_dsp_cpx*)vv_dsp_calloc(CP * nc, sizeof(vv_dsp_cpx));
+    f->pw = (vv_dsp_real*)vv_dsp_calloc(CP * nc, sizeof(vv_dsp_real));
+    f->inbuf = (vv_dsp_real*)vv_dsp_calloc(f->C * 2 * B, sizeof(vv_dsp_real));
+    f->fill_ref = (vv_dsp_real*)vv_dsp_calloc(f->C * B, sizeof(vv_dsp_real));
+    f->fill_mic = (vv_dsp_real*)vv_dsp_calloc(B, sizeof(vv_dsp_real));
+    f->out_err = (vv_dsp_real*)vv_dsp_calloc(B, sizeof(vv_dsp_real));
+    f->out_echo = (vv_dsp_real*)vv_dsp_calloc(B, sizeof(vv_dsp_real));
+    f->norm = (vv_dsp_real*)vv_dsp_malloc(nc * sizeof(vv_dsp_real));
+    f->Y = (vv_dsp_cpx*)vv_dsp_malloc(nc * sizeof(vv_dsp_cpx));
+    f->E = (vv_dsp_cpx*)vv_dsp_malloc(nc * sizeof(vv_dsp_cpx));
+    f->G = (vv_dsp_cpx*)vv_dsp_malloc(nc * sizeof(vv_dsp_cpx));
+    f->time = (vv_dsp_real*)vv_dsp_calloc(2 * B, sizeof(vv_dsp_real));
+    if (!f->W || !f->fdl || !f->pw || !f->inbuf || !f->fill_ref || !f->fill_mic || !f->out_err || !f->out_echo ||
+        !f->norm || !f->Y || !f->E || !f->G || !f->time ||
+        vv_dsp_fft_plan_acquire(2 * B, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &f->r2c) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(2 * B, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &f->c2r) != VV_DSP_OK) {
+        vv_dsp_fdaf_destroy(f);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = f;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fdaf_reset(vv_dsp_fdaf* f) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t CP = f->C * f->P, B = f->B;
+    memset(f->W, 0, CP * f->nc * sizeof(vv_dsp_cpx));
+    memset(f->fdl, 0, CP * f->nc * sizeof(vv_dsp_cpx));
+    memset(f->pw, 0, CP * f->nc * sizeof(vv_dsp_real));
+    memset(f->inbuf, 0, f->C * 2 * B * sizeof(vv_dsp_real));
+    memset(f->out_err, 0, B * sizeof(vv_dsp_real));
+    memset(f->out_echo, 0, B * sizeof(vv_dsp_real));
+    f->head = 0;
+    f->fill_n = 0;
+    f->next_constrained = 0;
+    f->blocks = 0;
+    return VV_DSP_OK;
+}
+
+static void spectrum_multiply(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    if (vv_dsp_vectorized_complex_multiply(a, b, out, n) == VV_DSP_OK) return;
+    for (size_t k = 0; k < n; ++k) {
+        const vv_dsp_real ar = a[k].re, ai = a[k].im;
+        out[k].re = ar * b[k].re - ai * b[k].im;
+        out[k].im = ar * b[k].im + ai * b[k].re;
+    }
+}
+
+static vv_dsp_real mean_square(const vv_dsp_real* x, size_t n) {
+    vv_dsp_real s = 0;
+    for (size_t i = 0; i < n; ++i) s += x[i] * x[i];
+    return s / (vv_dsp_real)n;
+}
+
+// Zero the second half of a partition (gradient or weights) in time so it stays a B-tap filter
+static vv_dsp_status constrain(vv_dsp_fdaf* f, vv_dsp_cpx* G) {
+    vv_dsp_status s = vv_dsp_fft_execute(f->c2r, G, f->time);
+    if (s != VV_DSP_OK) return s;
+    memset(f->time + f->B, 0, f->B * sizeof(vv_dsp_real));
+    return vv_dsp_fft_execute(f->r2c, f->time, G);
+}
+
+// One block of B staged samples: filter, write the outputs, then adapt
+static vv_dsp_status fdaf_block(vv_dsp_fdaf* f) {
+    const size_t B = f->B, nc = f->nc, P = f->P, C = f->C;
+    vv_dsp_fdaf_block_stats st;
+    memset(&st, 0, sizeof(st));
+    st.block = f->blocks;
+
+    // New input spectra into the delay line of every channel
+    for (size_t c = 0; c < C; ++c) {
+        vv_dsp_real* in = f->inbuf + c * 2 * B;
+        memcpy(in + B, f->fill_ref + c * B, B * sizeof(vv_dsp_real));
+        st.ref_power += mean_square(in + B, B);
+        const size_t slot = (c * P + f->head) * nc;
+        vv_dsp_status s = vv_dsp_fft_execute(f->r2c, in, f->fdl + slot);
+        if (s != VV_DSP_OK) return s;
+        (void)vv_dsp_cpx_power_array(f->fdl + slot, f->pw + slot, nc);
+        memcpy(in, in + B, B * sizeof(vv_dsp_real));
+    }
+
+    // Echo estimate: sum over channels and partitions of X(delay p) * W_p
+    memset(f->Y, 0, nc * sizeof(vv_dsp_cpx));
+    for (size_t c = 0; c < C; ++c) {
+        size_t slot = f->head;
+        for (size_t p = 0; p < P; ++p) {
+            spectrum_multiply(f->fdl + (c * P + slot) * nc, f->W + (c * P + p) * nc, f->G, nc);
+            for (size_t k = 0; k < nc; ++k) {
+                f->Y[k].re += f->G[k].re;
+                f->Y[k].im += f->G[k].im;
+            }
+            slot = slot ? slot - 1 : P - 1;
+        }
+    }
+    // Backend inverse already scales by 1/(2B); the last B samples are the linear part
+    vv_dsp_status s = vv_dsp_fft_execute(f->c2r, f->Y, f->time);
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_real* yhat = f->time + B;
+    for (size_t i = 0; i < B; ++i) {
+        f->out_echo[i] = yhat[i];
+        f->out_err[i] = f->fill_mic[i] - yhat[i];
+    }
+    st.mic_power = mean_square(f->fill_mic, B);
+    st.echo_power = mean_square(f->out_echo, B);
+    st.error_power = mean_square(f->out_err, B);
+
+    vv_dsp_real mu = f->step;
+    if (f->hook) mu *= f->hook(&st, f->hook_user);
+    const size_t constrained = f->next_constrained;
+    if (++f->next_constrained == P) f->next_constrained = 0;
+    if (++f->head == P) f->head = 0;
+    ++f->blocks;
+    if (!(mu > (vv_dsp_real)0)) return VV_DSP_OK;
+
+    // Error spectrum of [0 | e]
+    memset(f->time, 0, B * sizeof(vv_dsp_real));
+    memcpy(f->time + B, f->out_err, B * sizeof(vv_dsp_real));
+    s = vv_dsp_fft_execute(f->r2c, f->time, f->E);
+    if (s != VV_DSP_OK) return s;
+
+    // Per-bin step: mu over the reference energy of the whole delay line
+    for (size_t k = 0; k < nc; ++k) f->norm[k] = f->delta;
+    for (size_t q = 0; q < C * P; ++q) {
+        const vv_dsp_real* pw = f->pw + q * nc;
+        for (size_t k = 0; k < nc; ++k) f->norm[k] += pw[k];
+    }
+    for (size_t k = 0; k < nc; ++k) f->norm[k] = mu / f->norm[k];
+
+    // The newest slot was already advanced past: partition p pairs with slot head-1-p
+    const size_t newest = f->head ? f->head - 1 : P - 1;
+    for (size_t c = 0; c < C; ++c) {
+        size_t slot = newest;
+        for (size_t p = 0; p < P; ++p) {
+            (void)vv_dsp_cpx_conj_mul_array(f->E, f->fdl + (c * P + slot) * nc, f->G, nc);
+            for (size_t k = 0; k < nc; ++k) {
+                f->G[k].re *= f->norm[k];
+                f->G[k].im *= f->norm[k];
+            }
+            if (f->constraint == VV_DSP_FDAF_CONSTRAIN_ALL) {
+                s = constrain(f, f->G);
+                if (s != VV_DSP_OK) return s;
+            }
+            vv_dsp_cpx* w = f->W + (c * P + p) * nc;
+            for (size_t k = 0; k < nc; ++k) {
+                w[k].re += f->G[k].re;
+                w[k].im += f->G[k].im;
+            }
+            // MDF: constraining the accumulated weights also drops the wrap-around that
+            // the unconstrained updates of the other blocks left in this partition
+            if (f->constraint == VV_DSP_FDAF_CONSTRAIN_ROTATE && p == constrained) {
+                s = constrain(f, w);
+                if (s != VV_DSP_OK) return s;
+            }
+            slot = slot ? slot - 1 : P - 1;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fdaf_process(vv_dsp_fdaf* f,
+                                  const vv_dsp_real* const* refs,
+                                  const vv_dsp_real* mic,
+                                  vv_dsp_real* error,
+                                  vv_dsp_real* echo,
+                                  size_t n) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!refs || !mic || !error) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t c = 0; c < f->C; ++c) {
+        if (!refs[c]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    const size_t B = f->B;
+    for (size_t pos = 0; pos < n;) {
+        const size_t m = (n - pos < B - f->fill_n) ? n - pos : B - f->fill_n;
+        for (size_t c = 0; c < f->C; ++c) {
+            memcpy(f->fill_ref + c * B + f->fill_n, refs[c] + pos, m * sizeof(vv_dsp_real));
+        }
+        memcpy(f->fill_mic + f->fill_n, mic + pos, m * sizeof(vv_dsp_real));
+        // Input is staged, so error may overwrite mic
+        memcpy(error + pos, f->out_err + f->fill_n, m * sizeof(vv_dsp_real));
+        if (echo) memcpy(echo + pos, f->out_echo + f->fill_n, m * sizeof(vv_dsp_real));
+        f->fill_n += m;
+        pos += m;
+        if (f->fill_n == B) {
+            f->fill_n = 0;
+            const vv_dsp_status s = fdaf_block(f);
+            if (s != VV_DSP_OK) return s;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fdaf_set_step(vv_dsp_fdaf* f, vv_dsp_real step) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    if (!(step >= (vv_dsp_real)0 && step < (vv_dsp_real)2)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    f->step = step;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fdaf_set_step_callback(vv_dsp_fdaf* f, vv_dsp_fdaf_step_fn fn, void* user) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    f->hook = fn;
+    f->hook_user = fn ? user : NULL;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fdaf_get_filter(const vv_dsp_fdaf* f, size_t channel, vv_dsp_real* taps, size_t num_taps) {
+    if (!f || !taps) return VV_DSP_ERROR_NULL_POINTER;
+    if (channel >= f->C) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const size_t B = f->B;
+    vv_dsp_real* t = (vv_dsp_real*)vv_dsp_malloc(2 * B * sizeof(vv_dsp_real));
+    if (!t) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t p = 0; p < f->P && p * B < num_taps && s == VV_DSP_OK; ++p) {
+        s = vv_dsp_fft_execute(f->c2r, f->W + (channel * f->P + p) * f->nc, t);
+        const size_t cnt = (num_taps - p * B < B) ? num_taps - p * B : B;
+        if (s == VV_DSP_OK) memcpy(taps + p * B, t, cnt * sizeof(vv_dsp_real));
+    }
+    if (s == VV_DSP_OK && f->P * B < num_taps) memset(taps + f->P * B, 0, (num_taps - f->P * B) * sizeof(vv_dsp_real));
+    vv_dsp_free(t);
+    return s;
+}
+
+size_t vv_dsp_fdaf_latency(const vv_dsp_fdaf* f) {
+    return f ? f->B : 0;
+}
+
+size_t vv_dsp_fdaf_num_partitions(const vv_dsp_fdaf* f) {
+    return f ? f->P : 0;
+}
@@ -0,0 +1,349 @@
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include "filter_simd.h"
+#include "../spectral/parallel.h"
+
+// Per stage, BQ_ROWS rows of num_channels values; a1/a2 are stored negated so the
+// update is multiply-accumulates only
+enum { BQ_B0, BQ_B1, BQ_B2, BQ_NA1, BQ_NA2, BQ_Z1, BQ_Z2, BQ_ROWS };
+
+struct vv_dsp_biquad_bank {
+    size_t channels;
+    size_t stages;
+    vv_dsp_real* rows;       // stages * BQ_ROWS * channels
+    vv_dsp_denormal_mode denormals;
+};
+
+static vv_dsp_real* bank_row(const vv_dsp_biquad_bank* b, size_t stage, int row) {
+    return b->rows + (stage * BQ_ROWS + (size_t)row) * b->channels;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_create(size_t C, size_t S, vv_dsp_biquad_bank** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (C == 0 || S == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_biquad_bank* b = (vv_dsp_biquad_bank*)vv_dsp_calloc(1, sizeof(*b));
+    if (!b) return VV_DSP_ERROR_INTERNAL;
+    b->channels = C;
+    b->stages = S;
+    b->rows = (vv_dsp_real*)vv_dsp_calloc(S * BQ_ROWS * C, sizeof(vv_dsp_real));
+    if (!b->rows) {
+        vv_dsp_free(b);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t s = 0; s < S; ++s) {
+        vv_dsp_real* b0 = bank_row(b, s, BQ_B0);
+        for (size_t c = 0; c < C; ++c) b0[c] = (vv_dsp_real)1;
+    }
+    *out = b;
+    return VV_DSP_OK;
+}
+
+static void bank_set(vv_dsp_biquad_bank* b, size_t s, size_t c,
+                     vv_dsp_real b0, vv_dsp_real b1, vv_dsp_real b2, vv_dsp_real a1, vv_dsp_real a2) {
+    bank_row(b, s, BQ_B0)[c] = b0;
+    bank_row(b, s, BQ_B1)[c] = b1;
+    bank_row(b, s, BQ_B2)[c] = b2;
+    bank_row(b, s, BQ_NA1)[c] = -a1;
+    bank_row(b, s, BQ_NA2)[c] = -a2;
+}
+
+vv_dsp_status vv_dsp_biquad_bank_set_stage(vv_dsp_biquad_bank* b, size_t stage,
+                                           vv_dsp_real b0, vv_dsp_real b1, vv_dsp_real b2,
+                                           vv_dsp_real a1, vv_dsp_real a2) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (stage >= b->stages) return VV_DSP_ERROR_OUT_OF_RANGE;
+    for (size_t c = 0; c < b->channels; ++c) bank_set(b, stage, c, b0, b1, b2, a1, a2);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_biquad_bank_set_channel_stage(vv_dsp_biquad_bank* b, size_t channel, size_t stage,
+                                                   vv_dsp_real b0, vv_dsp_real b1, vv_dsp_real b2,
+                                                   vv_dsp_real a1, vv_dsp_real a2) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (stage >= b->stages || channel >= b->channels) return VV_DSP_ERROR_OUT_OF_RANGE;
+    bank_set(b, stage, channel, b0, b1, b2, a1, a2);
+    return VV_DSP_OK;
+}
+
+// Channels [c0, C) of one stage over frames xs (ys) samples apart; the channel loop
+// is innermost so it stays free of loop-carried dependencies
+static void bank_stage_scalar(vv_dsp_biquad_bank* b, size_t s, size_t c0,
+                              const vv_dsp_real* x, size_t xs, vv_dsp_real* y, size_t ys, size_t n) {
+    const size_t C = b->channels;
+    const vv_dsp_real* b0 = bank_row(b, s, BQ_B0);
+    const vv_dsp_real* b1 = bank_row(b, s, BQ_B1);
+    const vv_dsp_real* b2 = bank_row(b, s, BQ_B2);
+    const vv_dsp_real* na1 = bank_row(b, s, BQ_NA1);
+    const vv_dsp_real* na2 = bank_row(b, s, BQ_NA2);
+    vv_dsp_real* z1 = bank_row(b, s, BQ_Z1);
+    vv_dsp_real* z2 = bank_row(b, s, BQ_Z2);
+    for (size_t t = 0; t < n; ++t) {
+        const vv_dsp_real* xt = x + t * xs;
+        vv_dsp_real* yt = y + t * ys;
+        for (size_t c = c0; c < C; ++c) {
+            const vv_dsp_real v = xt[c];
+            const vv_dsp_real o = b0[c] * v + z1[c];
+            z1[c] = b1[c] * v + na1[c] * o + z2[c];
+            z2[c] = b2[c] * v + na2[c] * o;
+            yt[c] = o;
+        }
+    }
+}
+
+// Frames of contiguous channels, xs (ys) samples apart
+static void bank_run(vv_dsp_biquad_bank* b, const vv_dsp_real* x, size_t xs, vv_dsp_real* y, size_t ys,
+                     size_t n) {
+    const size_t C = b->channels;
+    size_t c0 = 0;
+#if defined(VF_W)
+    // One vector of channels at a time, keeping its coefficients and state in registers
+    // while the stage runs across the block
+    for (; c0 + VF_W <= C; c0 += VF_W) {
+        for (size_t s = 0; s < b->stages; ++s) {
+            const vf_vec b0 = VF_LOAD(bank_row(b, s, BQ_B0) + c0);
+            const vf_vec b1 = VF_LOAD(bank_row(b, s, BQ_B1) + c0);
+            const vf_vec b2 = VF_LOAD(bank_row(b, s, BQ_B2) + c0);
+            const vf_vec na1 = VF_LOAD(bank_row(b, s, BQ_NA1) + c0);
+            const vf_vec na2 = VF_LOAD(bank_row(b, s, BQ_NA2) + c0);
+            vf_vec z1 = VF_LOAD(bank_row(b, s, BQ_Z1) + c0);
+            vf_vec z2 = VF_LOAD(bank_row(b, s, BQ_Z2) + c0);
+            const vv_dsp_real* src = (s == 0) ? x : y;
+            const size_t ss = (s == 0) ? xs : ys;
+            for (size_t t = 0; t < n; ++t) {
+                const vf_vec v = VF_LOAD(src + t * ss + c0);
+                const vf_vec o = VF_MAC(z1, b0, v);
+                z1 = VF_MAC(VF_MAC(z2, b1, v), na1, o);
+                z2 = VF_MAC(VF_MUL(b2, v), na2, o);
+                VF_STORE(y + t * ys + c0, o);
+            }
+            VF_STORE(bank_row(b, s, BQ_Z1) + c0, z1);
+            VF_STORE(bank_row(b, s, BQ_Z2) + c0, z2);
+        }
+    }
+#endif
+    if (c0 < C) {
+        for (size_t s = 0; s < b->stages; ++s) {
+            bank_stage_scalar(b, s, c0, (s == 0) ? x : y, (s == 0) ? xs : ys, y, ys, n);
+        }
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_process(vv_dsp_biquad_bank* b,
+                                                          const vv_dsp_real* x,
+                                                          vv_dsp_real* y,
+                                                          size_t n) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, b->denormals);
+    bank_run(b, x, b->channels, y, b->channels, n);
+    vv_dsp_fp_scope_exit(&fp);
+    return VV_DSP_OK;
+}
+
+// One channel through every stage, its coefficients and state held in locals
+// across the frames (planar and strided buffers)
+static void bank_channel(vv_dsp_biquad_bank* b, size_t c, const vv_dsp_real* x, size_t xs, vv_dsp_real* y,
+                         size_t ys, size_t n) {
+    for (size_t s = 0; s < b->stages; ++s) {
+        const vv_dsp_real b0 = bank_row(b, s, BQ_B0)[c], b1 = bank_row(b, s, BQ_B1)[c];
+        const vv_dsp_real b2 = bank_row(b, s, BQ_B2)[c];
+        const vv_dsp_real na1 = bank_row(b, s, BQ_NA1)[c], na2 = bank_row(b, s, BQ_NA2)[c];
+        vv_dsp_real z1 = bank_row(b, s, BQ_Z1)[c], z2 = bank_row(b, s, BQ_Z2)[c];
+        const vv_dsp_real* src = (s == 0) ? x : y;
+        const size_t ss = (s == 0) ? xs : ys;
+        for (size_t t = 0; t < n; ++t) {
+            const vv_dsp_real v = src[t * ss];
+            const vv_dsp_real o = b0 * v + z1;
+            z1 = b1 * v + na1 * o + z2;
+            z2 = b2 * v + na2 * o;
+            y[t * ys] = o;
+        }
+        bank_row(b, s, BQ_Z1)[c] = z1;
+        bank_row(b, s, BQ_Z2)[c] = z2;
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_bank_process_buffer(vv_dsp_biquad_bank* b,
+                                                                 const vv_dsp_buffer* in,
+                                                                 vv_dsp_buffer* out) {
+    if (!b || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (in->channels != b->channels || out->channels != b->channels || out->frames < in->frames) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    const size_t n = in->frames;
+    if (n == 0) return VV_DSP_OK;
+    if (!in->data || !out->data) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, b->denormals);
+    if (b->channels == 1 || (in->channel_stride == 1 && out->channel_stride == 1)) {
+        // Channel-vectorized across the frames
+        bank_run(b, in->data, in->frame_stride, out->data, out->frame_stride, n);
+    } else {
+        // Frame-vectorized: one channel at a time down its frames
+        for (size_t c = 0; c < b->channels; ++c) {
+            bank_channel(b, c, in->data + c * in->channel_stride, in->frame_stride,
+                         out->data + c * out->channel_stride, out->frame_stride, n);
+        }
+    }
+    vv_dsp_fp_scope_exit(&fp);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_biquad_bank_reset(vv_dsp_biquad_bank* b) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t s = 0; s < b->stages; ++s) {
+        memset(bank_row(b, s, BQ_Z1), 0, 2 * b->channels * sizeof(vv_dsp_real));
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_biquad_bank_set_denormals(vv_dsp_biquad_bank* b, vv_dsp_denormal_mode mode) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (mode != VV_DSP_DENORMALS_KEEP && mode != VV_DSP_DENORMALS_FLUSH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    b->denormals = mode;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_biquad_bank_destroy(vv_dsp_biquad_bank* b) {
+    if (!b) return;
+    vv_dsp_free(b->rows);
+    vv_dsp_free(b);
+}
+
+// ---- batch ----------------------------------------------------------------------
+
+// Signals packed per group (channels of a worker's bank) and frames staged per pass
+#define BQ_BATCH_LANES 16u
+#define BQ_BATCH_CHUNK 256u
+
+typedef struct {
+    size_t len;
+    size_t idx;
+} bq_batch_item;
+
+static int bq_batch_by_length(const void* a, const void* b) {
+    const bq_batch_item* x = (const bq_batch_item*)a;
+    const bq_batch_item* y = (const bq_batch_item*)b;
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    return x->idx < y->idx ? -1 : (x->idx > y->idx);
+}
+
+typedef struct {
+    const vv_dsp_biquad* biquads;
+    size_t stages;
+    const vv_dsp_real* const* in;
+    vv_dsp_real* const* out;
+    const bq_batch_item* items; // non-empty signals, shortest first
+    size_t num_items;
+    size_t num_groups;
+    size_t workers;
+    vv_dsp_status* status;
+} bq_batch;
+
+// G signals through the bank's first G channels, started from the sections' state.
+// A chunk stages every still-running signal interleaved (finished ones feed zeros,
+// whose outputs are dropped) and runs the channel-vectorized cascade over it in place.
+static void bq_batch_group(const bq_batch* b, vv_dsp_biquad_bank* bank, const bq_batch_item* it, size_t G,
+                           vv_dsp_real* stage) {
+    const size_t L = bank->channels;
+    for (size_t s = 0; s < b->stages; ++s) {
+        vv_dsp_real* z1 = bank_row(bank, s, BQ_Z1);
+        vv_dsp_real* z2 = bank_row(bank, s, BQ_Z2);
+        for (size_t c = 0; c < L; ++c) {
+            z1[c] = c < G ? b->biquads[s].z1 : (vv_dsp_real)0;
+            z2[c] = c < G ? b->biquads[s].z2 : (vv_dsp_real)0;
+        }
+    }
+    memset(stage, 0, BQ_BATCH_CHUNK * L * sizeof(vv_dsp_real));
+    const size_t longest = it[G - 1].len;
+    for (size_t pos = 0; pos < longest; pos += BQ_BATCH_CHUNK) {
+        const size_t n = longest - pos < BQ_BATCH_CHUNK ? longest - pos : BQ_BATCH_CHUNK;
+        for (size_t c = 0; c < G; ++c) {
+            const size_t len = it[c].len;
+            const size_t m = len > pos ? (len - pos < n ? len - pos : n) : 0;
+            const vv_dsp_real* x = b->in[it[c].idx] + pos;
+            for (size_t t = 0; t < m; ++t) stage[t * L + c] = x[t];
+            for (size_t t = m; t < n; ++t) stage[t * L + c] = 0;
+        }
+        bank_run(bank, stage, L, stage, L, n);
+        for (size_t c = 0; c < G; ++c) {
+            const size_t len = it[c].len;
+            const size_t m = len > pos ? (len - pos < n ? len - pos : n) : 0;
+            vv_dsp_real* y = b->out[it[c].idx] + pos;
+            for (size_t t = 0; t < m; ++t) y[t] = stage[t * L + c];
+        }
+    }
+}
+
+// Worker w takes groups w, w + workers, ... on its own bank and staging block
+static void bq_batch_worker(void* ctx, size_t w) {
+    const bq_batch* b = (const bq_batch*)ctx;
+    vv_dsp_biquad_bank* bank = NULL;
+    vv_dsp_status s = vv_dsp_biquad_bank_create(BQ_BATCH_LANES, b->stages, &bank);
+    vv_dsp_real* stage = (vv_dsp_real*)vv_dsp_malloc(BQ_BATCH_CHUNK * BQ_BATCH_LANES * sizeof(vv_dsp_real));
+    if (s == VV_DSP_OK && !stage) s = VV_DSP_ERROR_INTERNAL;
+    for (size_t st = 0; s == VV_DSP_OK && st < b->stages; ++st) {
+        const vv_dsp_biquad* q = &b->biquads[st];
+        s = vv_dsp_biquad_bank_set_stage(bank, st, q->b0, q->b1, q->b2, q->a1, q->a2);
+    }
+    for (size_t g = w; s == VV_DSP_OK && g < b->num_groups; g += b->workers) {
+        const size_t first = g * BQ_BATCH_LANES;
+        const size_t G = b->num_items - first < BQ_BATCH_LANES ? b->num_items - first : BQ_BATCH_LANES;
+        bq_batch_group(b, bank, b->items + first, G, stage);
+    }
+    vv_dsp_free(stage);
+    vv_dsp_biquad_bank_destroy(bank);
+    b->status[w] = s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_apply_batch(const vv_dsp_biquad* biquads,
+                                                      size_t num_stages,
+                                                      const vv_dsp_real* const* in,
+                                                      vv_dsp_real* const* out,
+                                                      const size_t* lengths,
+                                                      size_t num_signals,
+                                                      size_t num_threads) {
+    if (num_signals == 0) return VV_DSP_OK;
+    if (!biquads || !in || !out || !lengths) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_stages == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t active = 0;
+    for (size_t i = 0; i < num_signals; ++i) {
+        if (lengths[i] == 0) continue;
+        if (!in[i] || !out[i]) return VV_DSP_ERROR_NULL_POINTER;
+        ++active;
+    }
+    if (active == 0) return VV_DSP_OK;
+
+    bq_batch b;
+    memset(&b, 0, sizeof(b));
+    bq_batch_item* items = (bq_batch_item*)vv_dsp_malloc(active * sizeof(bq_batch_item));
+    if (!items) return VV_DSP_ERROR_INTERNAL;
+    for (size_t i = 0, j = 0; i < num_signals; ++i) {
+        if (lengths[i] == 0) continue;
+        items[j].len = lengths[i];
+        items[j].idx = i;
+        ++j;
+    }
+    // Neighbours in length share a group, so little of a chunk is padding
+    qsort(items, active, sizeof(bq_batch_item), bq_batch_by_length);
+    b.biquads = biquads;
+    b.stages = num_stages;
+    b.in = in;
+    b.out = out;
+    b.items = items;
+    b.num_items = active;
+    b.num_groups = (active + BQ_BATCH_LANES - 1) / BQ_BATCH_LANES;
+    b.workers = num_threads ? num_threads : vv_dsp_parallel_default_workers();
+    if (b.workers > b.num_groups) b.workers = b.num_groups;
+    b.status = (vv_dsp_status*)vv_dsp_malloc(b.workers * sizeof(vv_dsp_status));
+    vv_dsp_status s = b.status ? vv_dsp_parallel_run(b.workers, bq_batch_worker, &b) : VV_DSP_ERROR_INTERNAL;
+    for (size_t w = 0; s == VV_DSP_OK && w < b.workers; ++w) s = b.status[w];
+    vv_dsp_free(b.status);
+    vv_dsp_free(items);
+    return s;
+}
@@ -0,0 +1,296 @@
+#include "vv_dsp/filter/cic.h"
+#include "fir_design.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CIC_MAX_STAGES 8
+#define CIC_MAX_DELAY 8
+#define CIC_MAX_GROWTH 40        // register growth bits for the real path
+#define CIC_MAX_GROWTH_INT 32    // int32 input + growth must fit in int64
+#define CIC_MAX_FRAC 48
+#define CIC_COMP_NODES 1024      // Simpson intervals for the compensator design
+
+// Shared configuration; all arithmetic is modulo 2^64 (unsigned wrap is well defined)
+typedef struct {
+    size_t rate, stages, delay;
+    int growth;              // ceil(N log2(R M))
+    int frac;                // fractional bits of quantized real input
+    double gain;             // (R M)^N
+    uint64_t integ[CIC_MAX_STAGES];
+    uint64_t comb[CIC_MAX_STAGES * CIC_MAX_DELAY];
+    size_t cpos;             // comb delay-line position
+} cic_core;
+
+struct vv_dsp_cic_decimator {
+    cic_core c;
+    size_t phase;            // inputs since the last output, modulo rate
+};
+
+struct vv_dsp_cic_interpolator {
+    cic_core c;
+};
+
+static vv_dsp_status cic_init(cic_core* c, size_t R, size_t N, size_t M) {
+    if (R == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (N == 0 || N > CIC_MAX_STAGES || M == 0 || M > CIC_MAX_DELAY) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (R > ((uint64_t)1 << CIC_MAX_GROWTH)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    // Exact G = (R M)^N while it stays within the growth limit
+    const uint64_t rm = (uint64_t)R * M, lim = (uint64_t)1 << CIC_MAX_GROWTH;
+    uint64_t g = 1;
+    for (size_t k = 0; k < N; ++k) {
+        if (g > lim / rm) return VV_DSP_ERROR_OUT_OF_RANGE;
+        g *= rm;
+    }
+    int b = 0;
+    while (((uint64_t)1 << b) < g) ++b;
+    memset(c, 0, sizeof(*c));
+    c->rate = R;
+    c->stages = N;
+    c->delay = M;
+    c->growth = b;
+    c->frac = (60 - b < CIC_MAX_FRAC) ? 60 - b : CIC_MAX_FRAC;
+    c->gain = (double)g;
+    return VV_DSP_OK;
+}
+
+static void cic_clear(cic_core* c) {
+    memset(c->integ, 0, sizeof(c->integ));
+    memset(c->comb, 0, sizeof(c->comb));
+    c->cpos = 0;
+}
+
+// Round x * 2^frac to the register, saturating where the output could no longer fit
+static uint64_t cic_quantize(const cic_core* c, vv_dsp_real x) {
+    const double lim = ldexp(1.0, 63 - c->growth) - 1.0;
+    double v = floor(ldexp((double)x, c->frac) + 0.5);
+    if (!(v == v)) v = 0.0;
+    if (v > lim) v = lim;
+    if (v < -lim) v = -lim;
+    return (uint64_t)(int64_t)v;
+}
+
+static uint64_t cic_integrate(cic_core* c, uint64_t v) {
+    for (size_t k = 0; k < c->stages; ++k) {
+        c->integ[k] += v;
+        v = c->integ[k];
+    }
+    return v;
+}
+
+static uint64_t cic_comb(cic_core* c, uint64_t v) {
+    const size_t M = c->delay;
+    for (size_t k = 0; k < c->stages; ++k) {
+        uint64_t* d = &c->comb[k * CIC_MAX_DELAY + c->cpos];
+        const uint64_t out = v - *d;
+        *d = v;
+        v = out;
+    }
+    if (++c->cpos == M) c->cpos = 0;
+    return v;
+}
+
+// ---- decimator ----------------------------------------------------------------
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_create(size_t R, size_t N, size_t M,
+                                                           vv_dsp_cic_decimator** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    vv_dsp_cic_decimator* d = (vv_dsp_cic_decimator*)vv_dsp_calloc(1, sizeof(*d));
+    if (!d) return VV_DSP_ERROR_INTERNAL;
+    const vv_dsp_status s = cic_init(&d->c, R, N, M);
+    if (s != VV_DSP_OK) {
+        vv_dsp_free(d);
+        return s;
+    }
+    *out = d;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_cic_decimator_output_count(const vv_dsp_cic_decimator* d, size_t n) {
+    if (!d || n == 0) return 0;
+    const size_t R = d->c.rate;
+    const size_t first = (R - d->phase) % R;   // offset of the next input that emits
+    return (n > first) ? (n - 1 - first) / R + 1 : 0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_process(vv_dsp_cic_decimator* d,
+                                                            const vv_dsp_real* x,
+                                                            size_t n,
+                                                            vv_dsp_real* y,
+                                                            size_t max_out,
+                                                            size_t* out_count) {
+    if (!d || !out_count) return VV_DSP_ERROR_NULL_POINTER;
+    *out_count = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t want = vv_dsp_cic_decimator_output_count(d, n);
+    if (want > max_out) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !y) return VV_DSP_ERROR_NULL_POINTER;
+    cic_core* c = &d->c;
+    const double scale = 1.0 / ldexp(c->gain, c->frac);
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = cic_integrate(c, cic_quantize(c, x[i]));
+        if (d->phase == 0) y[k++] = (vv_dsp_real)((double)(int64_t)cic_comb(c, v) * scale);
+        if (++d->phase == c->rate) d->phase = 0;
+    }
+    *out_count = k;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_decimator_process_int(vv_dsp_cic_decimator* d,
+                                                                const int32_t* x,
+                                                                size_t n,
+                                                                int64_t* y,
+                                                                size_t max_out,
+                                                                size_t* out_count) {
+    if (!d || !out_count) return VV_DSP_ERROR_NULL_POINTER;
+    *out_count = 0;
+    if (d->c.growth > CIC_MAX_GROWTH_INT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t want = vv_dsp_cic_decimator_output_count(d, n);
+    if (want > max_out) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !y) return VV_DSP_ERROR_NULL_POINTER;
+    cic_core* c = &d->c;
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = cic_integrate(c, (uint64_t)(int64_t)x[i]);
+        if (d->phase == 0) y[k++] = (int64_t)cic_comb(c, v);
+        if (++d->phase == c->rate) d->phase = 0;
+    }
+    *out_count = k;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cic_decimator_reset(vv_dsp_cic_decimator* d) {
+    if (!d) return VV_DSP_ERROR_NULL_POINTER;
+    cic_clear(&d->c);
+    d->phase = 0;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_cic_decimator_destroy(vv_dsp_cic_decimator* d) {
+    vv_dsp_free(d);
+}
+
+// ---- interpolator -------------------------------------------------------------
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_create(size_t R, size_t N, size_t M,
+                                                              vv_dsp_cic_interpolator** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    vv_dsp_cic_interpolator* p = (vv_dsp_cic_interpolator*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    const vv_dsp_status s = cic_init(&p->c, R, N, M);
+    if (s != VV_DSP_OK) {
+        vv_dsp_free(p);
+        return s;
+    }
+    *out = p;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_process(vv_dsp_cic_interpolator* p,
+                                                               const vv_dsp_real* x,
+                                                               size_t n,
+                                                               vv_dsp_real* y) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    cic_core* c = &p->c;
+    const size_t R = c->rate;
+    const double scale = (double)R / ldexp(c->gain, c->frac);
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = cic_comb(c, cic_quantize(c, x[i]));
+        for (size_t r = 0; r < R; ++r)
+            y[i * R + r] = (vv_dsp_real)((double)(int64_t)cic_integrate(c, r ? 0 : v) * scale);
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_cic_interpolator_process_int(vv_dsp_cic_interpolator* p,
+                                                                   const int32_t* x,
+                                                                   size_t n,
+                                                                   int64_t* y) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    if (p->c.growth > CIC_MAX_GROWTH_INT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    cic_core* c = &p->c;
+    const size_t R = c->rate;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = cic_comb(c, (uint64_t)(int64_t)x[i]);
+        for (size_t r = 0; r < R; ++r) y[i * R + r] = (int64_t)cic_integrate(c, r ? 0 : v);
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cic_interpolator_reset(vv_dsp_cic_interpolator* p) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    cic_clear(&p->c);
+    return VV_DSP_OK;
+}
+
+void vv_dsp_cic_interpolator_destroy(vv_dsp_cic_interpolator* p) {
+    vv_dsp_free(p);
+}
+
+// ---- compensator ----------------------------------------------------------------
+
+// Inverse CIC droop at f cycles per low-rate sample
+static double cic_inverse_droop(double f, size_t R, size_t N, size_t M) {
+    if (f == 0.0) return 1.0;
+    const double num = (double)R * (double)M * sin(VV_DSP_PI_D * f / (double)R);
+    const double den = sin(VV_DSP_PI_D * f * (double)M);
+    return pow(num / den, (double)N);
+}
+
+vv_dsp_status vv_dsp_cic_design_compensator(vv_dsp_real* h,
+                                            size_t L,
+                                            size_t R,
+                                            size_t N,
+                                            size_t M,
+                                            vv_dsp_real cutoff,
+                                            vv_dsp_window_type wt) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L < 2 || R == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (N == 0 || N > CIC_MAX_STAGES || M == 0 || M > CIC_MAX_DELAY) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const double fc = (double)cutoff;
+    if (!(fc > 0.0 && fc < 0.5 && fc * (double)M < 1.0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    double* D = (double*)vv_dsp_malloc((CIC_COMP_NODES + 1) * sizeof(double));
+    if (!D) return VV_DSP_ERROR_INTERNAL;
+    const vv_dsp_real* w = NULL;
+    const vv_dsp_status s = vv_dsp_fir_window_acquire(L, wt, &w);
+    if (s != VV_DSP_OK) {
+        vv_dsp_free(D);
+        return s;
+    }
+    // Simpson weights folded into the sampled response
+    const double df = fc / CIC_COMP_NODES;
+    for (size_t k = 0; k <= CIC_COMP_NODES; ++k) {
+        const double wk = (k == 0 || k == CIC_COMP_NODES) ? 1.0 : ((k & 1) ? 4.0 : 2.0);
+        D[k] = wk * df / 3.0 * cic_inverse_droop((double)k * df, R, N, M);
+    }
+    // Ideal response h_d[n] = 2 * integral_0^fc D(f) cos(2 pi f m) df, then windowed
+    const double alpha = (double)(L - 1) / 2.0;
+    double sum = 0.0;
+    for (size_t n = 0; n < L; ++n) {
+        const double m = (double)n - alpha;
+        double acc = 0.0;
+        for (size_t k = 0; k <= CIC_COMP_NODES; ++k) acc += D[k] * cos(VV_DSP_TWO_PI_D * (double)k * df * m);
+        const double v = 2.0 * acc * (double)w[n];
+        h[n] = (vv_dsp_real)v;
+        sum += v;
+    }
+    if (sum != 0.0) {
+        for (size_t n = 0; n < L; ++n) h[n] = (vv_dsp_real)((double)h[n] / sum);
+    }
+    vv_dsp_free(D);
+    vv_dsp_window_release(w);
+    return VV_DSP_OK;
+}
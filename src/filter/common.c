@@ -1,7 +1,9 @@
 #include "vv_dsp/filter/common.h"
 #include "vv_dsp/filter/fir.h"
+#include "vv_dsp/core/alloc.h"
 #include <stdlib.h>
 #include <string.h>
+#include "conv_dispatch.h"
 
 // Simple reflection padding helper
 static void reflect_pad(const vv_dsp_real* in, size_t n, size_t pad, vv_dsp_real* out) {
@@ -28,53 +30,38 @@ vv_dsp_status vv_dsp_filtfilt_fir(const vv_dsp_real* coeffs,
     if (!coeffs || !input || !output) return VV_DSP_ERROR_NULL_POINTER;
     if (num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
 
+    if (num_samples == 0) return VV_DSP_OK;
+
     // Minimal padding = num_taps-1
     const size_t pad = (num_taps > 1) ? (num_taps - 1) : 0;
     const size_t ext_n = num_samples + 2 * pad;
+    const size_t H = num_taps - 1;
 
-    vv_dsp_real* ext = (vv_dsp_real*)malloc(ext_n * sizeof(vv_dsp_real));
-    if (!ext) return VV_DSP_ERROR_INTERNAL;
-
-    reflect_pad(input, num_samples, pad, ext);
-
-    // Forward filter (stateless direct convolution)
-    vv_dsp_real* tmp = (vv_dsp_real*)malloc(ext_n * sizeof(vv_dsp_real));
-    if (!tmp) { free(ext); return VV_DSP_ERROR_INTERNAL; }
-    // y = h (*) x with zero-padding
-    for (size_t i = 0; i < ext_n; ++i) {
-        vv_dsp_real acc = 0;
-        size_t maxk = (i + 1 < num_taps) ? (i + 1) : num_taps;
-        for (size_t k = 0; k < maxk; ++k) acc += coeffs[k] * ext[i - k];
-        tmp[i] = acc;
+    // Each pass is a valid convolution over [H zeros | signal], i.e. a causal filter
+    // from rest; the zeros stay in place for the backward pass
+    vv_dsp_real* ext = (vv_dsp_real*)vv_dsp_calloc(H + ext_n, sizeof(vv_dsp_real));
+    vv_dsp_real* tmp = (vv_dsp_real*)vv_dsp_malloc(ext_n * sizeof(vv_dsp_real));
+    vv_dsp_real* hr = (vv_dsp_real*)vv_dsp_malloc(num_taps * sizeof(vv_dsp_real));
+    if (!ext || !tmp || !hr) {
+        vv_dsp_free(ext); vv_dsp_free(tmp); vv_dsp_free(hr);
+        return VV_DSP_ERROR_INTERNAL;
     }
+    for (size_t k = 0; k < num_taps; ++k) hr[k] = coeffs[num_taps - 1 - k];
+    reflect_pad(input, num_samples, pad, ext + H);
 
-    // Reverse
-    for (size_t i = 0; i < ext_n / 2; ++i) {
-        vv_dsp_real t = tmp[i];
-        tmp[i] = tmp[ext_n - 1 - i];
-        tmp[ext_n - 1 - i] = t;
+    // Forward filter, then run the reversed result through the filter again
+    vv_dsp_status s = vv_dsp_conv_valid_rev(hr, num_taps, ext, tmp, ext_n);
+    if (s == VV_DSP_OK) {
+        for (size_t i = 0; i < ext_n; ++i) ext[H + i] = tmp[ext_n - 1 - i];
+        s = vv_dsp_conv_valid_rev(hr, num_taps, ext, tmp, ext_n);
     }
-
-    // Backward filter (stateless direct convolution)
-    vv_dsp_real* tmp2 = (vv_dsp_real*)malloc(ext_n * sizeof(vv_dsp_real));
-    if (!tmp2) { free(tmp); free(ext); return VV_DSP_ERROR_INTERNAL; }
-    for (size_t i = 0; i < ext_n; ++i) {
-        vv_dsp_real acc = 0;
-        size_t maxk = (i + 1 < num_taps) ? (i + 1) : num_taps;
-        for (size_t k = 0; k < maxk; ++k) acc += coeffs[k] * tmp[i - k];
-        tmp2[i] = acc;
-    }
-
     // Reverse back and extract center
-    for (size_t i = 0; i < ext_n / 2; ++i) {
-        vv_dsp_real t = tmp2[i];
-        tmp2[i] = tmp2[ext_n - 1 - i];
-        tmp2[ext_n - 1 - i] = t;
+    if (s == VV_DSP_OK) {
+        for (size_t i = 0; i < num_samples; ++i) output[i] = tmp[ext_n - 1 - pad - i];
     }
-    memcpy(output, tmp2 + pad, num_samples * sizeof(vv_dsp_real));
 
-    free(tmp2);
-    free(tmp);
-    free(ext);
-    return VV_DSP_OK;
+    vv_dsp_free(hr);
+    vv_dsp_free(tmp);
+    vv_dsp_free(ext);
+    return s;
 }
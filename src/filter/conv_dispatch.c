@@ -0,0 +1,232 @@
+/*
+This file is part of vv-dsp
+
+Direct / FFT convolution dispatch. The crossover is a tap count: filters at
+least that long run through FFT overlap-save, shorter ones through the SIMD
+direct kernel. The built-in default was measured on x86-64 with AVX2;
+vv_dsp_conv_calibrate() re-measures it on the running machine.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include "vv_dsp/filter/convolver.h"
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/alloc.h"
+#include "conv_dispatch.h"
+#include "fir_kernel.h"
+
+// The direct kernel only vectorizes in float SIMD builds
+#if defined(VF_W)
+#  define CONV_DEFAULT_CROSSOVER 192
+#else
+#  define CONV_DEFAULT_CROSSOVER 48
+#endif
+#define CONV_CAL_MAX_TAPS 2048
+#define CONV_CAL_LEN (8192 + CONV_CAL_MAX_TAPS)  // input samples; every length sees all of them
+#define CONV_CAL_MIN_SECONDS 2e-3  // per timing trial
+#define CONV_CAL_TRIALS 3
+
+static size_t g_conv_crossover = CONV_DEFAULT_CROSSOVER;
+
+size_t vv_dsp_conv_get_crossover(void) {
+    return g_conv_crossover;
+}
+
+void vv_dsp_conv_set_crossover(size_t num_taps) {
+    g_conv_crossover = num_taps ? num_taps : CONV_DEFAULT_CROSSOVER;
+}
+
+vv_dsp_conv_method vv_dsp_conv_select(size_t num_taps, size_t num_outputs) {
+    // Below one filter length of output the FFT set-up is never repaid
+    return (num_taps >= g_conv_crossover && num_outputs >= num_taps) ? VV_DSP_CONV_FFT : VV_DSP_CONV_DIRECT;
+}
+
+static void spectrum_multiply(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    if (vv_dsp_vectorized_complex_multiply(a, b, out, n) == VV_DSP_OK) return;
+    for (size_t k = 0; k < n; ++k) {
+        const vv_dsp_real ar = a[k].re, ai = a[k].im;
+        out[k].re = ar * b[k].re - ai * b[k].im;
+        out[k].im = ar * b[k].im + ai * b[k].re;
+    }
+}
+
+void vv_dsp_conv_fft_free(vv_dsp_conv_fft* c) {
+    if (!c) return;
+    if (c->r2c) (void)vv_dsp_fft_plan_release(c->r2c);
+    if (c->c2r) (void)vv_dsp_fft_plan_release(c->c2r);
+    vv_dsp_free(c->H); vv_dsp_free(c->X); vv_dsp_free(c->buf); vv_dsp_free(c->y);
+    memset(c, 0, sizeof(*c));
+}
+
+vv_dsp_status vv_dsp_conv_fft_init(vv_dsp_conv_fft* c, const vv_dsp_real* hr, size_t L, size_t max_count) {
+    memset(c, 0, sizeof(*c));
+    if (L == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    // About 4 L per FFT keeps the overlap overhead low; no point going past one block
+    const size_t cap = (max_count ? max_count : 1) + L - 1;
+    const size_t want = (4 * L < cap) ? 4 * L : cap;
+    size_t nfft = 2;
+    while (nfft < want) nfft <<= 1;
+    c->taps = L;
+    c->nfft = nfft;
+    c->block = nfft - L + 1;
+    c->nc = nfft / 2 + 1;
+    c->H = (vv_dsp_cpx*)vv_dsp_malloc(c->nc * sizeof(vv_dsp_cpx));
+    c->X = (vv_dsp_cpx*)vv_dsp_malloc(c->nc * sizeof(vv_dsp_cpx));
+    c->buf = (vv_dsp_real*)vv_dsp_calloc(nfft, sizeof(vv_dsp_real));
+    c->y = (vv_dsp_real*)vv_dsp_malloc(nfft * sizeof(vv_dsp_real));
+    if (!c->H || !c->X || !c->buf || !c->y ||
+        vv_dsp_fft_plan_acquire(nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &c->r2c) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(nfft, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &c->c2r) != VV_DSP_OK) {
+        vv_dsp_conv_fft_free(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    const vv_dsp_status s = vv_dsp_conv_fft_set_taps(c, hr);
+    if (s != VV_DSP_OK) vv_dsp_conv_fft_free(c);
+    return s;
+}
+
+vv_dsp_status vv_dsp_conv_fft_set_taps(vv_dsp_conv_fft* c, const vv_dsp_real* hr) {
+    const size_t L = c->taps;
+    // Correlating with hr is convolving with its reverse
+    for (size_t j = 0; j < L; ++j) c->buf[j] = hr[L - 1 - j];
+    memset(c->buf + L, 0, (c->nfft - L) * sizeof(vv_dsp_real));
+    return vv_dsp_fft_execute(c->r2c, c->buf, c->H);
+}
+
+vv_dsp_status vv_dsp_conv_fft_run(vv_dsp_conv_fft* c, const vv_dsp_real* xs, vv_dsp_real* y, size_t count) {
+    const size_t H = c->taps - 1;
+    for (size_t pos = 0; pos < count;) {
+        const size_t m = (count - pos < c->block) ? count - pos : c->block;
+        memcpy(c->buf, xs + pos, (H + m) * sizeof(vv_dsp_real));
+        if (m < c->block) memset(c->buf + H + m, 0, (c->block - m) * sizeof(vv_dsp_real));
+        vv_dsp_status s = vv_dsp_fft_execute(c->r2c, c->buf, c->X);
+        if (s != VV_DSP_OK) return s;
+        spectrum_multiply(c->X, c->H, c->X, c->nc);
+        // Backend inverse already scales by 1/nfft
+        s = vv_dsp_fft_execute(c->c2r, c->X, c->y);
+        if (s != VV_DSP_OK) return s;
+        memcpy(y + pos, c->y + H, m * sizeof(vv_dsp_real));
+        pos += m;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_conv_valid_rev(const vv_dsp_real* hr, size_t L, const vv_dsp_real* xs,
+                                    vv_dsp_real* y, size_t count) {
+    if (vv_dsp_conv_select(L, count) == VV_DSP_CONV_DIRECT) {
+        fir_kernel(hr, L, xs, y, count, 0);
+        return VV_DSP_OK;
+    }
+    vv_dsp_conv_fft c;
+    vv_dsp_status s = vv_dsp_conv_fft_init(&c, hr, L, count);
+    if (s != VV_DSP_OK) return s;
+    s = vv_dsp_conv_fft_run(&c, xs, y, count);
+    vv_dsp_conv_fft_free(&c);
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_convolve_valid(const vv_dsp_real* coeffs,
+                                                     size_t num_taps,
+                                                     const vv_dsp_real* input,
+                                                     size_t num_outputs,
+                                                     vv_dsp_real* output) {
+    if (!coeffs || !input || !output) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (num_outputs == 0) return VV_DSP_OK;
+    vv_dsp_real* hr = (vv_dsp_real*)vv_dsp_malloc(num_taps * sizeof(vv_dsp_real));
+    if (!hr) return VV_DSP_ERROR_INTERNAL;
+    for (size_t j = 0; j < num_taps; ++j) hr[j] = coeffs[num_taps - 1 - j];
+    const vv_dsp_status s = vv_dsp_conv_valid_rev(hr, num_taps, input, output, num_outputs);
+    vv_dsp_free(hr);
+    return s;
+}
+
+static double conv_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Seconds per filtering of count samples, best of CONV_CAL_TRIALS; negative on failure
+static double time_method(vv_dsp_conv_method m, const vv_dsp_real* hr, size_t L,
+                          const vv_dsp_real* xs, vv_dsp_real* y, size_t count) {
+    double best = -1.0;
+    for (int t = 0; t < CONV_CAL_TRIALS; ++t) {
+        size_t reps = 0;
+        const double t0 = conv_now();
+        double el = 0.0;
+        do {
+            if (m == VV_DSP_CONV_DIRECT) {
+                fir_kernel(hr, L, xs, y, count, 0);
+            } else {
+                vv_dsp_conv_fft c;
+                if (vv_dsp_conv_fft_init(&c, hr, L, count) != VV_DSP_OK) return -1.0;
+                const vv_dsp_status s = vv_dsp_conv_fft_run(&c, xs, y, count);
+                vv_dsp_conv_fft_free(&c);
+                if (s != VV_DSP_OK) return -1.0;
+            }
+            ++reps;
+            el = conv_now() - t0;
+        } while (el < CONV_CAL_MIN_SECONDS);
+        const double per = el / (double)reps;
+        if (best < 0.0 || per < best) best = per;
+    }
+    return best;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_conv_calibrate(size_t* out_crossover) {
+    vv_dsp_real* hr = (vv_dsp_real*)vv_dsp_malloc(CONV_CAL_MAX_TAPS * sizeof(vv_dsp_real));
+    vv_dsp_real* xs = (vv_dsp_real*)vv_dsp_malloc(CONV_CAL_LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)vv_dsp_malloc(CONV_CAL_LEN * sizeof(vv_dsp_real));
+    if (!hr || !xs || !y) {
+        vv_dsp_free(hr); vv_dsp_free(xs); vv_dsp_free(y);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t i = 0; i < CONV_CAL_MAX_TAPS; ++i) hr[i] = (vv_dsp_real)(1.0 / (double)(i + 1));
+    for (size_t i = 0; i < CONV_CAL_LEN; ++i) {
+        xs[i] = (vv_dsp_real)((double)((i * 7919u) % 1024u) / 512.0 - 1.0);
+    }
+    // Smallest power-of-two length from which FFT wins for it and the next length up,
+    // then refined halfway down; past the largest length tried, direct never lost
+    size_t crossover = 2 * CONV_CAL_MAX_TAPS;
+    vv_dsp_status status = VV_DSP_OK;
+    int prev_fft_wins = 0;
+    for (size_t L = 8; L <= CONV_CAL_MAX_TAPS; L <<= 1) {
+        const double td = time_method(VV_DSP_CONV_DIRECT, hr, L, xs, y, CONV_CAL_LEN - L);
+        const double tf = time_method(VV_DSP_CONV_FFT, hr, L, xs, y, CONV_CAL_LEN - L);
+        if (td < 0.0 || tf < 0.0) {
+            status = VV_DSP_ERROR_INTERNAL;
+            break;
+        }
+        const int fft_wins = tf < td;
+        if (fft_wins && prev_fft_wins) {
+            crossover = L / 2;
+            const size_t mid = L / 4 + L / 8;
+            const double md = time_method(VV_DSP_CONV_DIRECT, hr, mid, xs, y, CONV_CAL_LEN - mid);
+            const double mf = time_method(VV_DSP_CONV_FFT, hr, mid, xs, y, CONV_CAL_LEN - mid);
+            if (md >= 0.0 && mf >= 0.0 && mf < md) crossover = mid;
+            break;
+        }
+        prev_fft_wins = fft_wins;
+    }
+    vv_dsp_free(hr); vv_dsp_free(xs); vv_dsp_free(y);
+    if (status != VV_DSP_OK) return status;
+    g_conv_crossover = crossover;
+    if (out_crossover) *out_crossover = crossover;
+    return VV_DSP_OK;
+}
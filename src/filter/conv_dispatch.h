@@ -0,0 +1,50 @@
+/*
+This file is part of vv-dsp
+
+Private whole-buffer convolution shared by the FIR, filtfilt and Savitzky-Golay
+code. vv_dsp_conv_select() decides between the SIMD direct kernel of
+fir_kernel.h and FFT overlap-save, so every module switches at the same
+crossover.
+*/
+
+#ifndef VV_DSP_FILTER_CONV_DISPATCH_H
+#define VV_DSP_FILTER_CONV_DISPATCH_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/filter/convolver.h"
+
+// Overlap-save state for one filter: the spectrum of the taps plus scratch. Lets a
+// caller that filters several chunks with the same taps transform them only once.
+typedef struct vv_dsp_conv_fft {
+    size_t taps;
+    size_t nfft;
+    size_t block;            // outputs per FFT, nfft - taps + 1
+    size_t nc;               // nfft / 2 + 1 bins
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2r;
+    vv_dsp_cpx* H;
+    vv_dsp_cpx* X;
+    vv_dsp_real* buf;
+    vv_dsp_real* y;
+} vv_dsp_conv_fft;
+
+// Prepare for hr[L] (taps in correlation order, see below) and chunks of up to
+// max_count outputs
+vv_dsp_status vv_dsp_conv_fft_init(vv_dsp_conv_fft* c, const vv_dsp_real* hr, size_t L, size_t max_count);
+
+// Replace the taps (same L) without allocating
+vv_dsp_status vv_dsp_conv_fft_set_taps(vv_dsp_conv_fft* c, const vv_dsp_real* hr);
+
+// y[i] = sum_j hr[j] * xs[i + j] for i < count; xs holds count + L - 1 samples and
+// must not overlap y
+vv_dsp_status vv_dsp_conv_fft_run(vv_dsp_conv_fft* c, const vv_dsp_real* xs, vv_dsp_real* y, size_t count);
+
+void vv_dsp_conv_fft_free(vv_dsp_conv_fft* c);
+
+// Same sums as vv_dsp_conv_fft_run(), on the path vv_dsp_conv_select() picks
+vv_dsp_status vv_dsp_conv_valid_rev(const vv_dsp_real* hr, size_t L, const vv_dsp_real* xs,
+                                    vv_dsp_real* y, size_t count);
+
+#endif // VV_DSP_FILTER_CONV_DISPATCH_H
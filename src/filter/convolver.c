@@ -0,0 +1,119 @@
+#include "vv_dsp/filter/convolver.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct vv_dsp_fft_convolver {
+    size_t num_taps;
+    size_t nfft;
+    size_t block;            // nfft - num_taps + 1 new samples per FFT
+    size_t nc;               // nfft/2 + 1 bins
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2r;
+    vv_dsp_cpx* H;           // filter spectrum, nc bins
+    vv_dsp_cpx* X;           // block spectrum scratch
+    vv_dsp_real* buf;        // nfft: num_taps-1 history samples, then the new block
+    vv_dsp_real* y;          // nfft time-domain result
+};
+
+static void spectrum_multiply(const vv_dsp_cpx* a, const vv_dsp_cpx* b, vv_dsp_cpx* out, size_t n) {
+    if (vv_dsp_vectorized_complex_multiply(a, b, out, n) == VV_DSP_OK) return;
+    for (size_t k = 0; k < n; ++k) {
+        const vv_dsp_real ar = a[k].re, ai = a[k].im;
+        out[k].re = ar * b[k].re - ai * b[k].im;
+        out[k].im = ar * b[k].im + ai * b[k].re;
+    }
+}
+
+void vv_dsp_fft_convolver_destroy(vv_dsp_fft_convolver* c) {
+    if (!c) return;
+    if (c->r2c) (void)vv_dsp_fft_plan_release(c->r2c);
+    if (c->c2r) (void)vv_dsp_fft_plan_release(c->c2r);
+    vv_dsp_free(c->H); vv_dsp_free(c->X); vv_dsp_free(c->buf); vv_dsp_free(c->y);
+    vv_dsp_free(c);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_convolver_create(const vv_dsp_real* h,
+                                                           size_t L,
+                                                           size_t block_size,
+                                                           vv_dsp_fft_convolver** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t want = (block_size ? block_size : L) + L - 1;
+    size_t nfft = 2;
+    while (nfft < want) nfft <<= 1;
+
+    vv_dsp_fft_convolver* c = (vv_dsp_fft_convolver*)vv_dsp_calloc(1, sizeof(*c));
+    if (!c) return VV_DSP_ERROR_INTERNAL;
+    c->num_taps = L;
+    c->nfft = nfft;
+    c->block = nfft - L + 1;
+    c->nc = nfft / 2 + 1;
+    c->H = (vv_dsp_cpx*)vv_dsp_malloc(c->nc * sizeof(vv_dsp_cpx));
+    c->X = (vv_dsp_cpx*)vv_dsp_malloc(c->nc * sizeof(vv_dsp_cpx));
+    c->buf = (vv_dsp_real*)vv_dsp_calloc(nfft, sizeof(vv_dsp_real));
+    c->y = (vv_dsp_real*)vv_dsp_malloc(nfft * sizeof(vv_dsp_real));
+    if (!c->H || !c->X || !c->buf || !c->y ||
+        vv_dsp_fft_plan_acquire(nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &c->r2c) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(nfft, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &c->c2r) != VV_DSP_OK) {
+        vv_dsp_fft_convolver_destroy(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    // Transform the zero-padded taps once; buf is still all zeros apart from them
+    memcpy(c->buf, h, L * sizeof(vv_dsp_real));
+    vv_dsp_status s = vv_dsp_fft_execute(c->r2c, c->buf, c->H);
+    memset(c->buf, 0, nfft * sizeof(vv_dsp_real));
+    if (s != VV_DSP_OK) {
+        vv_dsp_fft_convolver_destroy(c);
+        return s;
+    }
+    *out = c;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_convolver_process(vv_dsp_fft_convolver* c,
+                                                            const vv_dsp_real* x,
+                                                            vv_dsp_real* y,
+                                                            size_t n) {
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t H = c->num_taps - 1;
+    for (size_t pos = 0; pos < n; ) {
+        const size_t m = (n - pos < c->block) ? n - pos : c->block;
+        // buf = [H history | m new | stale]; the first H + m outputs of the circular
+        // convolution never reach the stale tail, but clear it so a short block cannot
+        // pick up old non-finite input
+        memcpy(c->buf + H, x + pos, m * sizeof(vv_dsp_real));
+        if (m < c->block) memset(c->buf + H + m, 0, (c->block - m) * sizeof(vv_dsp_real));
+        vv_dsp_status s = vv_dsp_fft_execute(c->r2c, c->buf, c->X);
+        if (s != VV_DSP_OK) return s;
+        spectrum_multiply(c->X, c->H, c->X, c->nc);
+        // Backend inverse already scales by 1/nfft
+        s = vv_dsp_fft_execute(c->c2r, c->X, c->y);
+        if (s != VV_DSP_OK) return s;
+        // Keep the last H inputs as the next history before writing output (in place)
+        memmove(c->buf, c->buf + m, H * sizeof(vv_dsp_real));
+        memcpy(y + pos, c->y + H, m * sizeof(vv_dsp_real));
+        pos += m;
+    }
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_fft_convolver_block_size(const vv_dsp_fft_convolver* c) {
+    return c ? c->block : 0;
+}
+
+size_t vv_dsp_fft_convolver_fft_size(const vv_dsp_fft_convolver* c) {
+    return c ? c->nfft : 0;
+}
+
+vv_dsp_status vv_dsp_fft_convolver_reset(vv_dsp_fft_convolver* c) {
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    memset(c->buf, 0, c->nfft * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
@@ -0,0 +1,312 @@
+#include "vv_dsp/filter/cqt.h"
+#include "vv_dsp/filter/fir.h"
+#include "vv_dsp/filter/polyphase.h"
+#include "vv_dsp/spectral/fft.h"
+#include "fir_design.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CQT_DEFAULT_TAPS 65
+
+struct vv_dsp_cqt {
+    vv_dsp_cqt_params p;
+    size_t octaves;            // decimation levels (1 in direct mode)
+    size_t rows;               // kernel rows: every bin, or the top octave
+    size_t nfft;
+    size_t nnz;
+    size_t* row_start;         // rows + 1 offsets into col / val
+    size_t* col;               // half-spectrum bin of each entry
+    vv_dsp_cpx* val;           // conj(T[col]) / nfft
+    vv_dsp_fft_plan* fft;      // R2C, nfft
+    vv_dsp_fir_decimator* dec; // recursive only
+    size_t delay;              // half-band group delay, (num_taps - 1) / 2
+    vv_dsp_real* frame;        // nfft
+    vv_dsp_cpx* spec;          // nfft / 2 + 1
+    unsigned char* pitch_class; // num_bins, 0 = C
+};
+
+static size_t next_pow2(size_t v) {
+    size_t n = 1;
+    while (n < v) n <<= 1;
+    return n;
+}
+
+static double cqt_freq(const vv_dsp_cqt_params* p, double k) {
+    return (double)p->fmin * pow(2.0, k / (double)p->bins_per_octave);
+}
+
+// Temporal kernel length of a bin at frequency f
+static size_t cqt_kernel_len(const vv_dsp_cqt_params* p, double f) {
+    const double Q = 1.0 / (pow(2.0, 1.0 / (double)p->bins_per_octave) - 1.0);
+    const size_t len = (size_t)ceil(Q * (double)p->sample_rate / f);
+    return len ? len : 1;
+}
+
+void vv_dsp_cqt_destroy(vv_dsp_cqt* cqt) {
+    if (!cqt) return;
+    vv_dsp_free(cqt->row_start);
+    vv_dsp_free(cqt->col);
+    vv_dsp_free(cqt->val);
+    vv_dsp_fft_plan_release(cqt->fft);
+    vv_dsp_fir_decimator_destroy(cqt->dec);
+    vv_dsp_free(cqt->frame);
+    vv_dsp_free(cqt->spec);
+    vv_dsp_free(cqt->pitch_class);
+    vv_dsp_free(cqt);
+}
+
+// Spectral kernels of the rows, whose first bin is first_bin, with the entries
+// above the sparsity threshold appended row by row
+static vv_dsp_status cqt_build_kernels(vv_dsp_cqt* q, size_t first_bin) {
+    const size_t N = q->nfft, nh = N / 2 + 1;
+    const double sparsity = q->p.sparsity > 0 ? (double)q->p.sparsity : VV_DSP_CQT_DEFAULT_SPARSITY;
+    vv_dsp_fft_plan* c2c = NULL;
+    vv_dsp_status s = vv_dsp_fft_plan_acquire(N, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &c2c);
+    if (s != VV_DSP_OK) return s;
+    vv_dsp_cpx* t = (vv_dsp_cpx*)vv_dsp_malloc(N * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* T = (vv_dsp_cpx*)vv_dsp_malloc(N * sizeof(vv_dsp_cpx));
+    vv_dsp_real* w = (vv_dsp_real*)vv_dsp_malloc(N * sizeof(vv_dsp_real));
+    q->row_start = (size_t*)vv_dsp_calloc(q->rows + 1, sizeof(size_t));
+    size_t cap = 0;
+    if (!t || !T || !w || !q->row_start) s = VV_DSP_ERROR_INTERNAL;
+
+    for (size_t r = 0; s == VV_DSP_OK && r < q->rows; ++r) {
+        // Hann-windowed exponential centred on sample N/2, phase 0 at the centre
+        const double f = cqt_freq(&q->p, (double)(first_bin + r));
+        const size_t len = cqt_kernel_len(&q->p, f);
+        s = vv_dsp_fir_window_fill(w, len, VV_DSP_WINDOW_HANNING);
+        if (s != VV_DSP_OK) break;
+        double wsum = 0.0;
+        for (size_t j = 0; j < len; ++j) wsum += (double)w[j];
+        memset(t, 0, N * sizeof(vv_dsp_cpx));
+        const size_t n0 = N / 2 - len / 2;
+        const double omega = VV_DSP_TWO_PI_D * f / (double)q->p.sample_rate;
+        for (size_t j = 0; j < len; ++j) {
+            const double ph = omega * ((double)(n0 + j) - (double)(N / 2));
+            const double a = (double)w[j] / wsum;
+            t[n0 + j].re = (vv_dsp_real)(a * cos(ph));
+            t[n0 + j].im = (vv_dsp_real)(a * sin(ph));
+        }
+        s = vv_dsp_fft_execute(c2c, t, T);
+        if (s != VV_DSP_OK) break;
+
+        double peak = 0.0;
+        for (size_t j = 0; j < nh; ++j) {
+            const double m = hypot((double)T[j].re, (double)T[j].im);
+            if (m > peak) peak = m;
+        }
+        const double floor_m = sparsity * peak;
+        for (size_t j = 0; j < nh; ++j) {
+            if (hypot((double)T[j].re, (double)T[j].im) <= floor_m) continue;
+            if (q->nnz == cap) {
+                const size_t ncap = cap ? 2 * cap : 256;
+                size_t* nc = (size_t*)vv_dsp_realloc(q->col, ncap * sizeof(size_t));
+                if (nc) q->col = nc;
+                vv_dsp_cpx* nv = nc ? (vv_dsp_cpx*)vv_dsp_realloc(q->val, ncap * sizeof(vv_dsp_cpx)) : NULL;
+                if (!nv) {
+                    s = VV_DSP_ERROR_INTERNAL;
+                    break;
+                }
+                q->val = nv;
+                cap = ncap;
+            }
+            q->col[q->nnz] = j;
+            q->val[q->nnz].re = (vv_dsp_real)((double)T[j].re / (double)N);
+            q->val[q->nnz].im = (vv_dsp_real)(-(double)T[j].im / (double)N);
+            q->nnz++;
+        }
+        q->row_start[r + 1] = q->nnz;
+    }
+    vv_dsp_free(t);
+    vv_dsp_free(T);
+    vv_dsp_free(w);
+    vv_dsp_fft_plan_release(c2c);
+    return s;
+}
+
+vv_dsp_status vv_dsp_cqt_create(const vv_dsp_cqt_params* params, vv_dsp_cqt** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!params) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_cqt_params* p = params;
+    if (p->bins_per_octave == 0 || p->num_bins == 0 || p->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(p->sample_rate > 0) || !(p->fmin > 0) || !(p->sparsity >= 0 && p->sparsity < 1)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    if (!(cqt_freq(p, (double)(p->num_bins - 1)) < 0.5 * (double)p->sample_rate)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const size_t taps = p->num_taps ? p->num_taps : CQT_DEFAULT_TAPS;
+    const size_t octaves = p->recursive ? (p->num_bins + p->bins_per_octave - 1) / p->bins_per_octave : 1;
+    if (octaves > 8 * sizeof(size_t) - 2) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (p->recursive && (taps % 4 != 1 || p->hop % ((size_t)1 << (octaves - 1)) != 0)) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_cqt* q = (vv_dsp_cqt*)vv_dsp_calloc(1, sizeof(*q));
+    if (!q) return VV_DSP_ERROR_INTERNAL;
+    q->p = *p;
+    q->p.num_taps = taps;
+    q->octaves = octaves;
+    q->rows = p->recursive && p->num_bins > p->bins_per_octave ? p->bins_per_octave : p->num_bins;
+    const size_t first_bin = p->num_bins - q->rows;
+    q->nfft = next_pow2(cqt_kernel_len(p, cqt_freq(p, (double)first_bin)));
+    if (q->nfft < 2) q->nfft = 2;
+
+    vv_dsp_status s = cqt_build_kernels(q, first_bin);
+    if (s == VV_DSP_OK) s = vv_dsp_fft_plan_acquire(q->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &q->fft);
+    if (s == VV_DSP_OK && octaves > 1) {
+        // The designer's cutoff is in cycles per sample: a quarter of the rate is the
+        // half band
+        vv_dsp_real* h = (vv_dsp_real*)vv_dsp_malloc(taps * sizeof(vv_dsp_real));
+        s = h ? vv_dsp_fir_design_lowpass(h, taps, (vv_dsp_real)0.25, VV_DSP_WINDOW_BLACKMAN) : VV_DSP_ERROR_INTERNAL;
+        if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_create(h, taps, 2, &q->dec);
+        vv_dsp_free(h);
+        q->delay = (taps - 1) / 2;
+    }
+    if (s == VV_DSP_OK) {
+        q->frame = (vv_dsp_real*)vv_dsp_malloc(q->nfft * sizeof(vv_dsp_real));
+        q->spec = (vv_dsp_cpx*)vv_dsp_malloc((q->nfft / 2 + 1) * sizeof(vv_dsp_cpx));
+        q->pitch_class = (unsigned char*)vv_dsp_malloc(p->num_bins);
+        if (!q->frame || !q->spec || !q->pitch_class) s = VV_DSP_ERROR_INTERNAL;
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_cqt_destroy(q);
+        return s;
+    }
+
+    // Nearest equal-tempered pitch: 69 + 12 log2(f / 440) is the MIDI note, C = 0 mod 12
+    for (size_t k = 0; k < p->num_bins; ++k) {
+        const double midi = 69.0 + 12.0 * log2(cqt_freq(p, (double)k) / 440.0);
+        long note = (long)floor(midi + 0.5) % 12;
+        if (note < 0) note += 12;
+        q->pitch_class[k] = (unsigned char)note;
+    }
+    *out = q;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_cqt_num_bins(const vv_dsp_cqt* cqt) {
+    return cqt ? cqt->p.num_bins : 0;
+}
+
+vv_dsp_real vv_dsp_cqt_bin_freq(const vv_dsp_cqt* cqt, size_t k) {
+    return cqt ? (vv_dsp_real)cqt_freq(&cqt->p, (double)k) : (vv_dsp_real)0;
+}
+
+size_t vv_dsp_cqt_fft_size(const vv_dsp_cqt* cqt) {
+    return cqt ? cqt->nfft : 0;
+}
+
+size_t vv_dsp_cqt_kernel_nonzeros(const vv_dsp_cqt* cqt) {
+    return cqt ? cqt->nnz : 0;
+}
+
+size_t vv_dsp_cqt_output_count(const vv_dsp_cqt* cqt, size_t n) {
+    if (!cqt || n == 0) return 0;
+    return n / cqt->p.hop + 1;
+}
+
+// Rows of every frame from one level's signal x[n], frames centred on t * hop;
+// row r lands in bin first_bin + r, rows below bin 0 are skipped
+static vv_dsp_status cqt_level(vv_dsp_cqt* q, const vv_dsp_real* x, size_t n, size_t hop, size_t frames,
+                               long first_bin, vv_dsp_cpx* out) {
+    const size_t N = q->nfft, half = N / 2, B = q->p.num_bins;
+    for (size_t t = 0; t < frames; ++t) {
+        // Frame [c - N/2, c + N/2) around c = t * hop, zero outside the signal
+        const size_t c = t * hop;
+        const size_t lead = c < half ? half - c : 0;
+        const size_t start = c + lead - half;
+        size_t avail = start < n ? n - start : 0;
+        if (avail > N - lead) avail = N - lead;
+        memset(q->frame, 0, lead * sizeof(vv_dsp_real));
+        if (avail) memcpy(q->frame + lead, x + start, avail * sizeof(vv_dsp_real));
+        memset(q->frame + lead + avail, 0, (N - lead - avail) * sizeof(vv_dsp_real));
+        vv_dsp_status s = vv_dsp_fft_execute(q->fft, q->frame, q->spec);
+        if (s != VV_DSP_OK) return s;
+
+        vv_dsp_cpx* row = out + t * B;
+        for (size_t r = 0; r < q->rows; ++r) {
+            const long bin = first_bin + (long)r;
+            if (bin < 0) continue;
+            vv_dsp_real re = 0, im = 0;
+            for (size_t e = q->row_start[r]; e < q->row_start[r + 1]; ++e) {
+                const vv_dsp_cpx X = q->spec[q->col[e]], K = q->val[e];
+                re += X.re * K.re - X.im * K.im;
+                im += X.re * K.im + X.im * K.re;
+            }
+            row[bin].re = re;
+            row[bin].im = im;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cqt_process(vv_dsp_cqt* cqt, const vv_dsp_real* input, size_t n, vv_dsp_cpx* out,
+                                 size_t max_frames, size_t* out_frames) {
+    if (!cqt || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!input || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = vv_dsp_cqt_output_count(cqt, n);
+    if (frames > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+
+    long first_bin = (long)(cqt->p.num_bins - cqt->rows);
+    vv_dsp_status s = cqt_level(cqt, input, n, cqt->p.hop, frames, first_bin, out);
+    if (s != VV_DSP_OK || cqt->octaves == 1) {
+        if (s == VV_DSP_OK) *out_frames = frames;
+        return s;
+    }
+
+    // Lower octaves: halve the rate, compensating the half-band delay, and reuse the kernel.
+    // Level l + 1 comes from level l plus delay zeros, dropping the first delay / 2 outputs.
+    const size_t D = cqt->delay;
+    vv_dsp_real* buf = (vv_dsp_real*)vv_dsp_malloc((n + D + 2) * sizeof(vv_dsp_real));
+    vv_dsp_real* zeros = (vv_dsp_real*)vv_dsp_calloc(D ? D : 1, sizeof(vv_dsp_real));
+    if (!buf || !zeros) s = VV_DSP_ERROR_INTERNAL;
+    const vv_dsp_real* cur = input;
+    size_t len = n, hop = cqt->p.hop;
+    for (size_t l = 1; s == VV_DSP_OK && l < cqt->octaves; ++l) {
+        size_t got = 0, more = 0;
+        s = vv_dsp_fir_decimator_reset(cqt->dec);
+        // In place is allowed: outputs never overtake the inputs they come from
+        if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_process(cqt->dec, cur, len, buf, n + D + 2, &got);
+        if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_process(cqt->dec, zeros, D, buf + got, n + D + 2 - got, &more);
+        if (s != VV_DSP_OK) break;
+        got += more;
+        const size_t skip = D / 2 < got ? D / 2 : got;
+        memmove(buf, buf + skip, (got - skip) * sizeof(vv_dsp_real));
+        len = got - skip;
+        cur = buf;
+        hop /= 2;
+        first_bin -= (long)cqt->p.bins_per_octave;
+        s = cqt_level(cqt, cur, len, hop, frames, first_bin, out);
+    }
+    vv_dsp_free(buf);
+    vv_dsp_free(zeros);
+    if (s == VV_DSP_OK) *out_frames = frames;
+    return s;
+}
+
+vv_dsp_status vv_dsp_cqt_chroma(const vv_dsp_cqt* cqt, const vv_dsp_cpx* cqt_frames, size_t num_frames,
+                                vv_dsp_real* chroma) {
+    if (!cqt) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!cqt_frames || !chroma) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t B = cqt->p.num_bins;
+    for (size_t t = 0; t < num_frames; ++t) {
+        const vv_dsp_cpx* row = cqt_frames + t * B;
+        double e[12] = {0};
+        for (size_t k = 0; k < B; ++k) {
+            e[cqt->pitch_class[k]] += (double)row[k].re * (double)row[k].re + (double)row[k].im * (double)row[k].im;
+        }
+        double peak = 0.0;
+        for (size_t c = 0; c < 12; ++c) {
+            if (e[c] > peak) peak = e[c];
+        }
+        const double g = peak > 0.0 ? 1.0 / peak : 0.0;
+        for (size_t c = 0; c < 12; ++c) chroma[t * 12 + c] = (vv_dsp_real)(e[c] * g);
+    }
+    return VV_DSP_OK;
+}
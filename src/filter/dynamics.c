@@ -0,0 +1,279 @@
+#include "vv_dsp/filter/dynamics.h"
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include <stdlib.h>
+#include <string.h>
+#include "filter_simd.h"
+
+// Frames per inner block: the crossover, follower and gain passes each sweep a block of
+// DYN_BLOCK * channels samples before the next one starts
+#define DYN_BLOCK 64
+
+#define DYN_LN10 2.302585092994045684
+
+typedef struct {
+    vv_dsp_dynamics_band cfg;
+    vv_dsp_real att;        // follower coefficients 1 - exp(-1 / (tau * fs))
+    vv_dsp_real rel;
+    vv_dsp_real slope;      // 1 / ratio - 1
+    vv_dsp_real half_knee;
+    vv_dsp_real inv_2knee;  // 1 / (2 * knee), 0 for a hard knee
+} dyn_band;
+
+struct vv_dsp_dynamics {
+    size_t C;
+    size_t N;                   // bands
+    vv_dsp_real fs;
+    vv_dsp_dynamics_detector detector;
+    int link;
+    vv_dsp_biquad_bank* lp[VV_DSP_DYNAMICS_MAX_BANDS - 1];  // LR4 low side + allpasses of the crossovers above
+    vv_dsp_biquad_bank* hp[VV_DSP_DYNAMICS_MAX_BANDS - 1];  // LR4 high side
+    dyn_band bands[VV_DSP_DYNAMICS_MAX_BANDS];
+    vv_dsp_real* env;           // N * C follower states
+    vv_dsp_real* gr_db;         // N * C gain change at the last frame
+    vv_dsp_real* split;         // N * DYN_BLOCK * C band signals
+    vv_dsp_real* lvl;           // DYN_BLOCK * C envelope -> gain
+};
+
+// Butterworth (Q = 1/sqrt(2)) section at fc: two lowpass (highpass) sections make the
+// LR4 low (high) side, and their sum is the allpass of the same Q
+static vv_dsp_status set_section(vv_dsp_biquad_bank* b, size_t stage, vv_dsp_biquad_type type, double fc,
+                                 double fs) {
+    vv_dsp_biquad q;
+    vv_dsp_status s = vv_dsp_biquad_design(&q, type, (vv_dsp_real)fs, (vv_dsp_real)fc,
+                                           (vv_dsp_real)0.70710678118654752440, 0);
+    if (s != VV_DSP_OK) return s;
+    return vv_dsp_biquad_bank_set_stage(b, stage, q.b0, q.b1, q.b2, q.a1, q.a2);
+}
+
+static vv_dsp_real follower_coef(vv_dsp_real ms, vv_dsp_real fs) {
+    if (!(ms > (vv_dsp_real)0)) return (vv_dsp_real)1;
+    return (vv_dsp_real)(1.0 - exp(-1000.0 / ((double)ms * (double)fs)));
+}
+
+static void band_apply(dyn_band* b, const vv_dsp_dynamics_band* s, vv_dsp_real fs) {
+    b->cfg = *s;
+    b->att = follower_coef(s->attack_ms, fs);
+    b->rel = follower_coef(s->release_ms, fs);
+    b->slope = (vv_dsp_real)1 / s->ratio - (vv_dsp_real)1;
+    b->half_knee = (vv_dsp_real)0.5 * s->knee_db;
+    b->inv_2knee = (s->knee_db > (vv_dsp_real)0) ? (vv_dsp_real)0.5 / s->knee_db : (vv_dsp_real)0;
+}
+
+void vv_dsp_dynamics_destroy(vv_dsp_dynamics* d) {
+    if (!d) return;
+    for (size_t i = 0; i + 1 < d->N; ++i) {
+        vv_dsp_biquad_bank_destroy(d->lp[i]);
+        vv_dsp_biquad_bank_destroy(d->hp[i]);
+    }
+    vv_dsp_free(d->env);
+    vv_dsp_free(d->gr_db);
+    vv_dsp_free(d->split);
+    vv_dsp_free(d->lvl);
+    vv_dsp_free(d);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_create(const vv_dsp_dynamics_params* prm, vv_dsp_dynamics** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!prm) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t C = prm->num_channels, N = prm->num_bands;
+    if (C == 0 || N == 0 || N > VV_DSP_DYNAMICS_MAX_BANDS) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(prm->sample_rate > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (prm->detector != VV_DSP_DYNAMICS_PEAK && prm->detector != VV_DSP_DYNAMICS_RMS) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (N > 1 && !prm->crossover_hz) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i + 1 < N; ++i) {
+        const vv_dsp_real f = prm->crossover_hz[i];
+        const vv_dsp_real lo = i ? prm->crossover_hz[i - 1] : (vv_dsp_real)0;
+        if (!(f > lo && f < (vv_dsp_real)0.5 * prm->sample_rate)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    vv_dsp_dynamics* d = (vv_dsp_dynamics*)vv_dsp_calloc(1, sizeof(*d));
+    if (!d) return VV_DSP_ERROR_INTERNAL;
+    d->C = C;
+    d->N = N;
+    d->fs = prm->sample_rate;
+    d->detector = prm->detector;
+    d->link = prm->link_channels != 0;
+    d->env = (vv_dsp_real*)vv_dsp_calloc(N * C, sizeof(vv_dsp_real));
+    d->gr_db = (vv_dsp_real*)vv_dsp_calloc(N * C, sizeof(vv_dsp_real));
+    d->split = (vv_dsp_real*)vv_dsp_malloc(N * DYN_BLOCK * C * sizeof(vv_dsp_real));
+    d->lvl = (vv_dsp_real*)vv_dsp_malloc(DYN_BLOCK * C * sizeof(vv_dsp_real));
+    vv_dsp_status s = (d->env && d->gr_db && d->split && d->lvl) ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+
+    // Split i takes the remainder above crossover i-1 apart at crossover i; its low
+    // side also carries the allpasses of crossovers i+1 .. N-2
+    const double fs = (double)prm->sample_rate;
+    for (size_t i = 0; i + 1 < N && s == VV_DSP_OK; ++i) {
+        const double fc = (double)prm->crossover_hz[i];
+        s = vv_dsp_biquad_bank_create(C, 2 + (N - 2 - i), &d->lp[i]);
+        if (s == VV_DSP_OK) s = vv_dsp_biquad_bank_create(C, 2, &d->hp[i]);
+        for (size_t k = 0; k < 2 && s == VV_DSP_OK; ++k) {
+            s = set_section(d->lp[i], k, VV_DSP_BIQUAD_LOWPASS, fc, fs);
+            if (s == VV_DSP_OK) s = set_section(d->hp[i], k, VV_DSP_BIQUAD_HIGHPASS, fc, fs);
+        }
+        for (size_t j = i + 1; j + 1 < N && s == VV_DSP_OK; ++j) {
+            s = set_section(d->lp[i], 2 + (j - i - 1), VV_DSP_BIQUAD_ALLPASS, (double)prm->crossover_hz[j], fs);
+        }
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_dynamics_destroy(d);
+        return s;
+    }
+    vv_dsp_dynamics_band def;
+    def.threshold_db = 0;
+    def.ratio = 1;
+    def.knee_db = 0;
+    def.makeup_db = 0;
+    def.attack_ms = 10;
+    def.release_ms = 100;
+    for (size_t b = 0; b < N; ++b) band_apply(&d->bands[b], &def, d->fs);
+    *out = d;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_dynamics_reset(vv_dsp_dynamics* d) {
+    if (!d) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i + 1 < d->N; ++i) {
+        (void)vv_dsp_biquad_bank_reset(d->lp[i]);
+        (void)vv_dsp_biquad_bank_reset(d->hp[i]);
+    }
+    memset(d->env, 0, d->N * d->C * sizeof(vv_dsp_real));
+    memset(d->gr_db, 0, d->N * d->C * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_set_band(vv_dsp_dynamics* d,
+                                                        size_t band,
+                                                        const vv_dsp_dynamics_band* s) {
+    if (!d || !s) return VV_DSP_ERROR_NULL_POINTER;
+    if (band >= d->N) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!(s->ratio >= (vv_dsp_real)1) || !(s->knee_db >= (vv_dsp_real)0) || !(s->attack_ms >= (vv_dsp_real)0) ||
+        !(s->release_ms >= (vv_dsp_real)0)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    band_apply(&d->bands[band], s, d->fs);
+    return VV_DSP_OK;
+}
+
+// Envelope follower of one band over n frames: e += att * max(x - e, 0) + rel * min(x - e, 0)
+// on the detector signal, channels innermost so the recursion runs C lanes wide
+static void follow(vv_dsp_real* env, const vv_dsp_real* x, vv_dsp_real* lvl, size_t C, size_t n, vv_dsp_real att,
+                   vv_dsp_real rel, int rms) {
+    size_t c0 = 0;
+#if defined(VF_W)
+    const vf_vec va = VF_SET1(att), vr = VF_SET1(rel), z = VF_ZERO();
+    for (; c0 + VF_W <= C; c0 += VF_W) {
+        vf_vec e = VF_LOAD(env + c0);
+        for (size_t t = 0; t < n; ++t) {
+            const vf_vec v = VF_LOAD(x + t * C + c0);
+            const vf_vec diff = VF_SUB(rms ? VF_MUL(v, v) : VF_ABS(v), e);
+            e = VF_MAC(VF_MAC(e, va, VF_MAX(diff, z)), vr, VF_MIN(diff, z));
+            VF_STORE(lvl + t * C + c0, e);
+        }
+        VF_STORE(env + c0, e);
+    }
+#endif
+    for (size_t t = 0; t < n; ++t) {
+        const vv_dsp_real* xt = x + t * C;
+        vv_dsp_real* lt = lvl + t * C;
+        for (size_t c = c0; c < C; ++c) {
+            const vv_dsp_real v = xt[c];
+            const vv_dsp_real diff = (rms ? v * v : (v < 0 ? -v : v)) - env[c];
+            const vv_dsp_real up = diff > 0 ? diff : 0;
+            const vv_dsp_real down = diff < 0 ? diff : 0;
+            env[c] += att * up + rel * down;
+            lt[c] = env[c];
+        }
+    }
+}
+
+// Soft-knee curve on ln(envelope), in place: lvl becomes the gain change in dB
+//   over = L - T;  gr = slope * (q^2 / (2W) + max(over - W/2, 0)),  q = clamp(over + W/2, 0, W)
+// which is 0 below the knee, quadratic inside it and slope * over above it
+static void gain_curve(const dyn_band* b, vv_dsp_real db_per_np, vv_dsp_real* lvl, size_t n) {
+    const vv_dsp_real T = b->cfg.threshold_db, hk = b->half_knee, ik = b->inv_2knee, sl = b->slope;
+    const vv_dsp_real W = b->cfg.knee_db;
+    for (size_t i = 0; i < n; ++i) {
+        const vv_dsp_real over = lvl[i] * db_per_np - T;
+        vv_dsp_real q = over + hk;
+        q = q < 0 ? 0 : q;
+        q = q > W ? W : q;
+        const vv_dsp_real above = over - hk;
+        lvl[i] = sl * (q * q * ik + (above > 0 ? above : 0));
+    }
+}
+
+static vv_dsp_status dyn_block(vv_dsp_dynamics* d, const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    const size_t C = d->C, N = d->N, stride = DYN_BLOCK * C;
+    vv_dsp_status s = VV_DSP_OK;
+    // Crossover tree; the top band's buffer carries the remainder down the splits
+    vv_dsp_real* rest = d->split + (N - 1) * stride;
+    if (N == 1) memcpy(rest, x, n * C * sizeof(vv_dsp_real));
+    for (size_t i = 0; i + 1 < N && s == VV_DSP_OK; ++i) {
+        const vv_dsp_real* src = i ? rest : x;
+        s = vv_dsp_biquad_bank_process(d->lp[i], src, d->split + i * stride, n);
+        if (s == VV_DSP_OK) s = vv_dsp_biquad_bank_process(d->hp[i], src, rest, n);
+    }
+    if (s != VV_DSP_OK) return s;
+
+    // x is consumed: y may alias it from here on
+    const int rms = d->detector == VV_DSP_DYNAMICS_RMS;
+    const vv_dsp_real db_per_np = (vv_dsp_real)((rms ? 10.0 : 20.0) / DYN_LN10);
+    const vv_dsp_real np_per_db = (vv_dsp_real)(DYN_LN10 / 20.0);
+    vv_dsp_real* lvl = d->lvl;
+    for (size_t b = 0; b < N; ++b) {
+        const dyn_band* bd = &d->bands[b];
+        const vv_dsp_real* sig = d->split + b * stride;
+        follow(d->env + b * C, sig, lvl, C, n, bd->att, bd->rel, rms);
+        if (d->link && C > 1) {
+            for (size_t t = 0; t < n; ++t) {
+                vv_dsp_real* lt = lvl + t * C;
+                vv_dsp_real m = lt[0];
+                for (size_t c = 1; c < C; ++c) m = lt[c] > m ? lt[c] : m;
+                for (size_t c = 0; c < C; ++c) lt[c] = m;
+            }
+        }
+        s = vv_dsp_vlog(lvl, lvl, n * C, VV_DSP_VMATH_FAST);
+        if (s != VV_DSP_OK) return s;
+        gain_curve(bd, db_per_np, lvl, n * C);
+        memcpy(d->gr_db + b * C, lvl + (n - 1) * C, C * sizeof(vv_dsp_real));
+        const vv_dsp_real makeup = bd->cfg.makeup_db;
+        for (size_t i = 0; i < n * C; ++i) lvl[i] = (lvl[i] + makeup) * np_per_db;
+        s = vv_dsp_vexp(lvl, lvl, n * C, VV_DSP_VMATH_FAST);
+        if (s != VV_DSP_OK) return s;
+        if (b == 0) {
+            for (size_t i = 0; i < n * C; ++i) y[i] = sig[i] * lvl[i];
+        } else {
+            for (size_t i = 0; i < n * C; ++i) y[i] += sig[i] * lvl[i];
+        }
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_process(vv_dsp_dynamics* d,
+                                                       const vv_dsp_real* x,
+                                                       vv_dsp_real* y,
+                                                       size_t n) {
+    if (!d) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t pos = 0; pos < n; pos += DYN_BLOCK) {
+        const size_t m = (n - pos < DYN_BLOCK) ? n - pos : DYN_BLOCK;
+        const vv_dsp_status s = dyn_block(d, x + pos * d->C, y + pos * d->C, m);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dynamics_get_gain_reduction(const vv_dsp_dynamics* d,
+                                                                  size_t band,
+                                                                  size_t channel,
+                                                                  vv_dsp_real* gain_db) {
+    if (!d || !gain_db) return VV_DSP_ERROR_NULL_POINTER;
+    if (band >= d->N || channel >= d->C) return VV_DSP_ERROR_OUT_OF_RANGE;
+    *gain_db = d->gr_db[band * d->C + channel];
+    return VV_DSP_OK;
+}
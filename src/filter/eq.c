@@ -0,0 +1,225 @@
+#include "vv_dsp/filter/eq.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define EQ_DEFAULT_SMOOTHING_MS ((vv_dsp_real)20)
+#define EQ_CACHE_SIZE 64  // direct-mapped, power of two
+
+// Coefficients in vv_dsp_biquad_bank_set_channel_stage() order: b0 b1 b2 a1 a2
+typedef struct {
+    vv_dsp_real cur[5];
+    vv_dsp_real tgt[5];
+    vv_dsp_real inc[5];
+    size_t left;             // sub-blocks until cur reaches tgt
+} eq_slot;
+
+typedef struct {
+    int valid;
+    int type;
+    long freq_cents, q_cents, gain_cdb;
+    vv_dsp_real c[5];
+} eq_cache_entry;
+
+struct vv_dsp_eq {
+    size_t C;
+    size_t S;                // bands = bank stages
+    vv_dsp_real fs;
+    size_t ramp;             // sub-blocks per glide, 0 = jump
+    vv_dsp_biquad_bank* bank;
+    eq_slot* slots;          // S * C, band-major
+    size_t gliding;          // slots with left > 0
+    size_t phase;            // frames into the current sub-block
+    eq_cache_entry cache[EQ_CACHE_SIZE];
+    size_t hits, misses;
+};
+
+static const vv_dsp_real eq_flat[5] = {1, 0, 0, 0, 0};
+
+static vv_dsp_status slot_push(vv_dsp_eq* eq, size_t s, size_t c) {
+    const vv_dsp_real* k = eq->slots[s * eq->C + c].cur;
+    return vv_dsp_biquad_bank_set_channel_stage(eq->bank, c, s, k[0], k[1], k[2], k[3], k[4]);
+}
+
+void vv_dsp_eq_destroy(vv_dsp_eq* eq) {
+    if (!eq) return;
+    vv_dsp_biquad_bank_destroy(eq->bank);
+    vv_dsp_free(eq->slots);
+    vv_dsp_free(eq);
+}
+
+vv_dsp_status vv_dsp_eq_set_smoothing(vv_dsp_eq* eq, vv_dsp_real ms) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    if (!(ms >= (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const double frames = (double)ms * 1e-3 * (double)eq->fs;
+    eq->ramp = (size_t)ceil(frames / (double)VV_DSP_EQ_SUBBLOCK);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_create(vv_dsp_real sample_rate, size_t C, size_t S, vv_dsp_eq** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (C == 0 || S == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(sample_rate > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_eq* eq = (vv_dsp_eq*)vv_dsp_calloc(1, sizeof(*eq));
+    if (!eq) return VV_DSP_ERROR_INTERNAL;
+    eq->C = C;
+    eq->S = S;
+    eq->fs = sample_rate;
+    eq->slots = (eq_slot*)vv_dsp_calloc(S * C, sizeof(eq_slot));
+    vv_dsp_status s = eq->slots ? vv_dsp_biquad_bank_create(C, S, &eq->bank) : VV_DSP_ERROR_INTERNAL;
+    if (s != VV_DSP_OK) {
+        vv_dsp_eq_destroy(eq);
+        return s;
+    }
+    for (size_t i = 0; i < S * C; ++i) {
+        memcpy(eq->slots[i].cur, eq_flat, sizeof(eq_flat));
+        memcpy(eq->slots[i].tgt, eq_flat, sizeof(eq_flat));
+    }
+    (void)vv_dsp_eq_set_smoothing(eq, EQ_DEFAULT_SMOOTHING_MS);
+    *out = eq;
+    return VV_DSP_OK;
+}
+
+// Coefficients for the quantized parameters, from the cache or designed into it
+static vv_dsp_status eq_lookup(vv_dsp_eq* eq, vv_dsp_biquad_type type, vv_dsp_real freq, vv_dsp_real q,
+                               vv_dsp_real gain_db, vv_dsp_real* c) {
+    if (!(freq > (vv_dsp_real)0) || !(q > (vv_dsp_real)0) || !(gain_db == gain_db)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const long fk = lround(1200.0 * log2((double)freq));
+    const long qk = lround(1200.0 * log2((double)q));
+    const long gk = lround(100.0 * (double)gain_db);
+    const unsigned long h = ((unsigned long)fk * 2654435761ul) ^ ((unsigned long)qk * 40503ul) ^
+                            ((unsigned long)gk * 97ul) ^ ((unsigned long)type << 5);
+    eq_cache_entry* e = &eq->cache[(h ^ (h >> 7)) & (EQ_CACHE_SIZE - 1)];
+    if (e->valid && e->type == (int)type && e->freq_cents == fk && e->q_cents == qk && e->gain_cdb == gk) {
+        ++eq->hits;
+        memcpy(c, e->c, sizeof(e->c));
+        return VV_DSP_OK;
+    }
+    vv_dsp_biquad bq;
+    const vv_dsp_status s = vv_dsp_biquad_design(&bq, type, eq->fs, (vv_dsp_real)pow(2.0, (double)fk / 1200.0),
+                                                 (vv_dsp_real)pow(2.0, (double)qk / 1200.0),
+                                                 (vv_dsp_real)((double)gk / 100.0));
+    if (s != VV_DSP_OK) return s;
+    ++eq->misses;
+    e->valid = 1;
+    e->type = (int)type;
+    e->freq_cents = fk;
+    e->q_cents = qk;
+    e->gain_cdb = gk;
+    e->c[0] = bq.b0;
+    e->c[1] = bq.b1;
+    e->c[2] = bq.b2;
+    e->c[3] = bq.a1;
+    e->c[4] = bq.a2;
+    memcpy(c, e->c, sizeof(e->c));
+    return VV_DSP_OK;
+}
+
+// Start the glide of one slot from where it is now towards c
+static vv_dsp_status eq_retarget(vv_dsp_eq* eq, size_t s, size_t ch, const vv_dsp_real* c) {
+    eq_slot* sl = &eq->slots[s * eq->C + ch];
+    memcpy(sl->tgt, c, sizeof(sl->tgt));
+    if (sl->left) --eq->gliding;
+    sl->left = eq->ramp;
+    if (sl->left == 0) {
+        memcpy(sl->cur, c, sizeof(sl->cur));
+        return slot_push(eq, s, ch);
+    }
+    for (int i = 0; i < 5; ++i) sl->inc[i] = (sl->tgt[i] - sl->cur[i]) / (vv_dsp_real)sl->left;
+    ++eq->gliding;
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status eq_apply(vv_dsp_eq* eq, size_t ch, size_t band, const vv_dsp_real* c) {
+    if (ch != VV_DSP_EQ_ALL_CHANNELS) return eq_retarget(eq, band, ch, c);
+    for (size_t i = 0; i < eq->C; ++i) {
+        const vv_dsp_status s = eq_retarget(eq, band, i, c);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_set_band(vv_dsp_eq* eq,
+                                                  size_t ch,
+                                                  size_t band,
+                                                  vv_dsp_biquad_type type,
+                                                  vv_dsp_real freq_hz,
+                                                  vv_dsp_real q,
+                                                  vv_dsp_real gain_db) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    if (band >= eq->S || (ch != VV_DSP_EQ_ALL_CHANNELS && ch >= eq->C)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_real c[5];
+    const vv_dsp_status s = eq_lookup(eq, type, freq_hz, q, gain_db, c);
+    if (s != VV_DSP_OK) return s;
+    return eq_apply(eq, ch, band, c);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_bypass_band(vv_dsp_eq* eq, size_t ch, size_t band) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    if (band >= eq->S || (ch != VV_DSP_EQ_ALL_CHANNELS && ch >= eq->C)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    return eq_apply(eq, ch, band, eq_flat);
+}
+
+// One coefficient step for every gliding slot, at a sub-block boundary
+static vv_dsp_status eq_step(vv_dsp_eq* eq) {
+    for (size_t i = 0; i < eq->S * eq->C && eq->gliding; ++i) {
+        eq_slot* sl = &eq->slots[i];
+        if (!sl->left) continue;
+        if (--sl->left == 0) {
+            memcpy(sl->cur, sl->tgt, sizeof(sl->cur));
+            --eq->gliding;
+        } else {
+            for (int k = 0; k < 5; ++k) sl->cur[k] += sl->inc[k];
+        }
+        const vv_dsp_status s = slot_push(eq, i / eq->C, i % eq->C);
+        if (s != VV_DSP_OK) return s;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_eq_process(vv_dsp_eq* eq,
+                                                 const vv_dsp_real* x,
+                                                 vv_dsp_real* y,
+                                                 size_t n) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    if (!eq->gliding) {
+        eq->phase = (eq->phase + n) % VV_DSP_EQ_SUBBLOCK;
+        return vv_dsp_biquad_bank_process(eq->bank, x, y, n);
+    }
+    for (size_t pos = 0; pos < n;) {
+        vv_dsp_status s = VV_DSP_OK;
+        if (eq->phase == 0 && eq->gliding) s = eq_step(eq);
+        const size_t room = VV_DSP_EQ_SUBBLOCK - eq->phase;
+        const size_t m = (n - pos < room) ? n - pos : room;
+        if (s == VV_DSP_OK) s = vv_dsp_biquad_bank_process(eq->bank, x + pos * eq->C, y + pos * eq->C, m);
+        if (s != VV_DSP_OK) return s;
+        eq->phase = (eq->phase + m) % VV_DSP_EQ_SUBBLOCK;
+        pos += m;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_eq_reset(vv_dsp_eq* eq) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < eq->S * eq->C; ++i) {
+        eq_slot* sl = &eq->slots[i];
+        if (!sl->left) continue;
+        sl->left = 0;
+        memcpy(sl->cur, sl->tgt, sizeof(sl->cur));
+        (void)slot_push(eq, i / eq->C, i % eq->C);
+    }
+    eq->gliding = 0;
+    eq->phase = 0;
+    return vv_dsp_biquad_bank_reset(eq->bank);
+}
+
+vv_dsp_status vv_dsp_eq_cache_stats(const vv_dsp_eq* eq, size_t* hits, size_t* misses) {
+    if (!eq) return VV_DSP_ERROR_NULL_POINTER;
+    if (hits) *hits = eq->hits;
+    if (misses) *misses = eq->misses;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,83 @@
+/*
+This file is part of vv-dsp
+
+Private float vector layer for the filter kernels: VF_W lanes of vf_vec with
+unaligned load/store, broadcast, add, subtract, multiply, multiply-accumulate, min, max
+and abs, picked from the
+AVX-512, AVX2, SSE4.1 or NEON build flags. VF_SMAC is the scalar operation of
+one VF_MAC lane (fused where VF_MAC is), for tails that must round alike. VF_W is left undefined in double
+builds and builds without SIMD, where the kernels use their scalar loops.
+*/
+
+#ifndef VV_DSP_FILTER_SIMD_H
+#define VV_DSP_FILTER_SIMD_H
+
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/simd_utils.h"
+#include <math.h>
+
+#if !defined(VV_DSP_USE_DOUBLE)
+#  if defined(VV_DSP_SIMD_AVX512)
+#    define VF_W 16
+typedef __m512 vf_vec;
+#    define VF_LOAD(p) _mm512_loadu_ps(p)
+#    define VF_STORE(p, v) _mm512_storeu_ps((p), (v))
+#    define VF_SET1(x) _mm512_set1_ps(x)
+#    define VF_ZERO() _mm512_setzero_ps()
+#    define VF_MUL(a, b) _mm512_mul_ps((a), (b))
+#    define VF_ADD(a, b) _mm512_add_ps((a), (b))
+#    define VF_SUB(a, b) _mm512_sub_ps((a), (b))
+#    define VF_MIN(a, b) _mm512_min_ps((a), (b))
+#    define VF_MAX(a, b) _mm512_max_ps((a), (b))
+#    define VF_ABS(a) _mm512_abs_ps(a)
+#    define VF_MAC(acc, a, b) _mm512_fmadd_ps((a), (b), (acc))
+#    define VF_SMAC(acc, a, b) fmaf((a), (b), (acc))
+#  elif defined(VV_DSP_SIMD_AVX2)
+#    define VF_W 8
+typedef __m256 vf_vec;
+#    define VF_LOAD(p) _mm256_loadu_ps(p)
+#    define VF_STORE(p, v) _mm256_storeu_ps((p), (v))
+#    define VF_SET1(x) _mm256_set1_ps(x)
+#    define VF_ZERO() _mm256_setzero_ps()
+#    define VF_MUL(a, b) _mm256_mul_ps((a), (b))
+#    define VF_ADD(a, b) _mm256_add_ps((a), (b))
+#    define VF_SUB(a, b) _mm256_sub_ps((a), (b))
+#    define VF_MIN(a, b) _mm256_min_ps((a), (b))
+#    define VF_MAX(a, b) _mm256_max_ps((a), (b))
+#    define VF_ABS(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+#    define VF_MAC(acc, a, b) _mm256_add_ps((acc), _mm256_mul_ps((a), (b)))
+#    define VF_SMAC(acc, a, b) ((acc) + (a) * (b))
+#  elif defined(VV_DSP_SIMD_SSE41)
+#    define VF_W 4
+typedef __m128 vf_vec;
+#    define VF_LOAD(p) _mm_loadu_ps(p)
+#    define VF_STORE(p, v) _mm_storeu_ps((p), (v))
+#    define VF_SET1(x) _mm_set1_ps(x)
+#    define VF_ZERO() _mm_setzero_ps()
+#    define VF_MUL(a, b) _mm_mul_ps((a), (b))
+#    define VF_ADD(a, b) _mm_add_ps((a), (b))
+#    define VF_SUB(a, b) _mm_sub_ps((a), (b))
+#    define VF_MIN(a, b) _mm_min_ps((a), (b))
+#    define VF_MAX(a, b) _mm_max_ps((a), (b))
+#    define VF_ABS(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+#    define VF_MAC(acc, a, b) _mm_add_ps((acc), _mm_mul_ps((a), (b)))
+#    define VF_SMAC(acc, a, b) ((acc) + (a) * (b))
+#  elif defined(VV_DSP_SIMD_NEON)
+#    define VF_W 4
+typedef float32x4_t vf_vec;
+#    define VF_LOAD(p) vld1q_f32(p)
+#    define VF_STORE(p, v) vst1q_f32((p), (v))
+#    define VF_SET1(x) vdupq_n_f32(x)
+#    define VF_ZERO() vdupq_n_f32(0.0f)
+#    define VF_MUL(a, b) vmulq_f32((a), (b))
+#    define VF_ADD(a, b) vaddq_f32((a), (b))
+#    define VF_SUB(a, b) vsubq_f32((a), (b))
+#    define VF_MIN(a, b) vminq_f32((a), (b))
+#    define VF_MAX(a, b) vmaxq_f32((a), (b))
+#    define VF_ABS(a) vabsq_f32(a)
+#    define VF_MAC(acc, a, b) vmlaq_f32((acc), (a), (b))
+#    define VF_SMAC(acc, a, b) ((acc) + (a) * (b))
+#  endif
+#endif
+
+#endif // VV_DSP_FILTER_SIMD_H
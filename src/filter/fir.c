@@ -1,9 +1,16 @@
 #include "vv_dsp/filter/fir.h"
 #include "vv_dsp/vv_dsp_math.h"
 #include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/arena.h"
 #include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
 #include <stdlib.h>
 #include <string.h>
+#include "fir_kernel.h"
+#include "conv_dispatch.h"
+#include "fir_design.h"
+#include "../core/typed_foreign.h"
 
 static vv_dsp_real sinc_r(vv_dsp_real x) {
     if (x == (vv_dsp_real)0) return (vv_dsp_real)1;
@@ -14,34 +21,32 @@ static vv_dsp_real sinc_r(vv_dsp_real x) {
 #endif
 }
 
-static vv_dsp_status apply_window(vv_dsp_real* w, size_t N, vv_dsp_window_type type) {
-    if (!w) return VV_DSP_ERROR_NULL_POINTER;
-    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+static vv_dsp_status fir_window_kind(vv_dsp_window_type type, vv_dsp_window_kind* kind) {
     switch (type) {
-        case VV_DSP_WINDOW_RECTANGULAR:
-            for (size_t n = 0; n < N; ++n) w[n] = (vv_dsp_real)1;
-            break;
-        case VV_DSP_WINDOW_HAMMING:
-            for (size_t n = 0; n < N; ++n)
-                w[n] = (vv_dsp_real)((vv_dsp_real)0.54 - (vv_dsp_real)0.46 * VV_DSP_COS(VV_DSP_TWO_PI * (vv_dsp_real)n / (vv_dsp_real)(N - 1)));
-            break;
-        case VV_DSP_WINDOW_HANNING:
-            for (size_t n = 0; n < N; ++n)
-                w[n] = (vv_dsp_real)((vv_dsp_real)0.5 - (vv_dsp_real)0.5 * VV_DSP_COS(VV_DSP_TWO_PI * (vv_dsp_real)n / (vv_dsp_real)(N - 1)));
-            break;
-        case VV_DSP_WINDOW_BLACKMAN: {
-            const double a0 = 0.42, a1 = 0.5, a2 = 0.08;
-            for (size_t n = 0; n < N; ++n) {
-                double c1 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)(VV_DSP_TWO_PI_D * (double)n / (double)(N - 1)));
-                double c2 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)(2.0 * VV_DSP_TWO_PI_D * (double)n / (double)(N - 1)));
-                w[n] = (vv_dsp_real)(a0 - a1 * c1 + a2 * c2);
-            }
-            break;
-        }
-        default:
-            return VV_DSP_ERROR_INTERNAL;
+        case VV_DSP_WINDOW_RECTANGULAR: *kind = VV_DSP_WINDOW_KIND_BOXCAR; return VV_DSP_OK;
+        case VV_DSP_WINDOW_HAMMING: *kind = VV_DSP_WINDOW_KIND_HAMMING; return VV_DSP_OK;
+        case VV_DSP_WINDOW_HANNING: *kind = VV_DSP_WINDOW_KIND_HANN; return VV_DSP_OK;
+        case VV_DSP_WINDOW_BLACKMAN: *kind = VV_DSP_WINDOW_KIND_BLACKMAN; return VV_DSP_OK;
+        default: return VV_DSP_ERROR_INTERNAL;
     }
-    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_window_fill(vv_dsp_real* w, size_t N, vv_dsp_window_type type) {
+    if (!w) return VV_DSP_ERROR_NULL_POINTER;
+    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_window_kind kind;
+    vv_dsp_status s = fir_window_kind(type, &kind);
+    if (s != VV_DSP_OK) return s;
+    return vv_dsp_window_fill(kind, N, 0, 0, w);
+}
+
+vv_dsp_status vv_dsp_fir_window_acquire(size_t N, vv_dsp_window_type type, const vv_dsp_real** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    vv_dsp_window_kind kind;
+    vv_dsp_status s = fir_window_kind(type, &kind);
+    if (s != VV_DSP_OK) return s;
+    return vv_dsp_window_acquire(kind, N, 0, 0, out);
 }
 
 vv_dsp_status vv_dsp_fir_design_lowpass(vv_dsp_real* h,
@@ -62,51 +67,63 @@ vv_dsp_status vv_dsp_fir_design_lowpass(vv_dsp_real* h,
     }
 
     // Apply window
-    vv_dsp_real* w = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
-    if (!w) return VV_DSP_ERROR_INTERNAL;
-    vv_dsp_status s = apply_window(w, N, wt);
-    if (s != VV_DSP_OK) { free(w); return s; }
+    const vv_dsp_real* w = NULL;
+    vv_dsp_status s = vv_dsp_fir_window_acquire(N, wt, &w);
+    if (s != VV_DSP_OK) return s;
     for (size_t n = 0; n < N; ++n) h[n] *= w[n];
-    free(w);
+    vv_dsp_window_release(w);
 
     return VV_DSP_OK;
 }
 
-vv_dsp_status vv_dsp_fir_apply_fft(vv_dsp_fir_state* st,
-                                   const vv_dsp_real* h,
-                                   const vv_dsp_real* x,
-                                   vv_dsp_real* y,
-                                   size_t n) {
-    if (!st || !h || !x || !y) return VV_DSP_ERROR_NULL_POINTER;
-    if (st->num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
-    // Choose FFT size >= n + L -1, next power of two
-    size_t L = st->num_taps;
-    size_t lin_len = n + L - 1;
+static size_t fir_fft_size(size_t num_taps, size_t n) {
+    // FFT size >= n + L - 1, next power of two
+    const size_t lin_len = n + num_taps - 1;
     size_t Nfft = 1; while (Nfft < lin_len) Nfft <<= 1;
+    return Nfft;
+}
 
-    // Allocate buffers
-    vv_dsp_real* xb = (vv_dsp_real*)calloc(Nfft, sizeof(vv_dsp_real));
-    vv_dsp_real* hb = (vv_dsp_real*)calloc(Nfft, sizeof(vv_dsp_real));
-    if (!xb || !hb) { free(xb); free(hb); return VV_DSP_ERROR_INTERNAL; }
-    memcpy(xb, x, n * sizeof(vv_dsp_real));
-    memcpy(hb, h, L * sizeof(vv_dsp_real));
+size_t vv_dsp_fir_apply_fft_scratch_size(size_t num_taps, size_t n) {
+    if (num_taps == 0) return 0;
+    const size_t Nfft = fir_fft_size(num_taps, n);
+    const size_t Nc = Nfft / 2 + 1;
+    return 2 * vv_dsp_arena_request_size(Nfft * sizeof(vv_dsp_real)) +
+           3 * vv_dsp_arena_request_size(Nc * sizeof(vv_dsp_cpx));
+}
 
+vv_dsp_status vv_dsp_fir_apply_fft_ex(vv_dsp_fir_state* st,
+                                      const vv_dsp_real* h,
+                                      const vv_dsp_real* x,
+                                      vv_dsp_real* y,
+                                      size_t n,
+                                      vv_dsp_arena* arena) {
+    if (!st || !h || !x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    if (st->num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t L = st->num_taps;
+    const size_t Nfft = fir_fft_size(L, n);
     // R2C FFT sizes: Nfft -> Nfft/2+1 complex
-    size_t Nc = Nfft / 2 + 1;
-    vv_dsp_cpx* X = (vv_dsp_cpx*)calloc(Nc, sizeof(vv_dsp_cpx));
-    vv_dsp_cpx* H = (vv_dsp_cpx*)calloc(Nc, sizeof(vv_dsp_cpx));
-    vv_dsp_cpx* Y = (vv_dsp_cpx*)calloc(Nc, sizeof(vv_dsp_cpx));
-    if (!X || !H || !Y) { free(xb); free(hb); free(X); free(H); free(Y); return VV_DSP_ERROR_INTERNAL; }
+    const size_t Nc = Nfft / 2 + 1;
 
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* xb = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, Nfft * sizeof(vv_dsp_real));
+    vv_dsp_real* hb = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, Nfft * sizeof(vv_dsp_real));
+    vv_dsp_cpx* X = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, Nc * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* H = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, Nc * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* Y = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, Nc * sizeof(vv_dsp_cpx));
     vv_dsp_fft_plan* p_r2c = NULL; vv_dsp_fft_plan* p_c2r = NULL;
-    if (vv_dsp_fft_make_plan(Nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &p_r2c) != VV_DSP_OK) {
-        free(xb); free(hb); free(X); free(H); free(Y); return VV_DSP_ERROR_INTERNAL;
-    }
-    if (vv_dsp_fft_make_plan(Nfft, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &p_c2r) != VV_DSP_OK) {
-        vv_dsp_fft_destroy(p_r2c); free(xb); free(hb); free(X); free(H); free(Y); return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_status s = VV_DSP_ERROR_INTERNAL;
+    if (!xb || !hb || !X || !H || !Y) goto cleanup;
+    memcpy(xb, x, n * sizeof(vv_dsp_real));
+    memset(xb + n, 0, (Nfft - n) * sizeof(vv_dsp_real));
+    memcpy(hb, h, L * sizeof(vv_dsp_real));
+    memset(hb + L, 0, (Nfft - L) * sizeof(vv_dsp_real));
+
+    if (vv_dsp_fft_plan_acquire(Nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &p_r2c) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(Nfft, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &p_c2r) != VV_DSP_OK) {
+        s = VV_DSP_ERROR_INTERNAL;
+        goto cleanup;
     }
 
-    vv_dsp_status s;
     s = vv_dsp_fft_execute(p_r2c, xb, X); if (s!=VV_DSP_OK) goto cleanup;
     s = vv_dsp_fft_execute(p_r2c, hb, H); if (s!=VV_DSP_OK) goto cleanup;
 
@@ -128,33 +145,153 @@ vv_dsp_status vv_dsp_fir_apply_fft(vv_dsp_fir_state* st,
     for (size_t i = 0; i < n; ++i) y[i] = xb[i];
 
 cleanup:
-    vv_dsp_fft_destroy(p_r2c);
-    vv_dsp_fft_destroy(p_c2r);
-    free(xb); free(hb); free(X); free(H); free(Y);
+    vv_dsp_fft_plan_release(p_r2c);
+    vv_dsp_fft_plan_release(p_c2r);
+    vv_dsp_scratch_free(arena, xb); vv_dsp_scratch_free(arena, hb);
+    vv_dsp_scratch_free(arena, X); vv_dsp_scratch_free(arena, H); vv_dsp_scratch_free(arena, Y);
+    vv_dsp_arena_reset_to(arena, mark);
     return s;
 }
 
+vv_dsp_status vv_dsp_fir_apply_fft(vv_dsp_fir_state* st,
+                                   const vv_dsp_real* h,
+                                   const vv_dsp_real* x,
+                                   vv_dsp_real* y,
+                                   size_t n) {
+    return vv_dsp_fir_apply_fft_ex(st, h, x, y, n, NULL);
+}
+
+// Staging block of at least this many samples keeps the multi-output kernels busy
+// even for short filters
+#define FIR_MIN_STAGE 512
+
+// Overlap-save plan of a prepared state; taps holds the reversed taps conv.H was
+// computed from, so a call with the same coefficients reuses it
+typedef struct {
+    vv_dsp_conv_fft conv;
+    vv_dsp_real* taps;
+} fir_fft_plan;
+
+static void fir_plan_free(vv_dsp_fir_state* st) {
+    fir_fft_plan* plan = (fir_fft_plan*)st->fft;
+    if (!plan) return;
+    vv_dsp_conv_fft_free(&plan->conv);
+    vv_dsp_free(plan->taps);
+    vv_dsp_free(plan);
+    st->fft = NULL;
+}
+
 vv_dsp_status vv_dsp_fir_state_init(vv_dsp_fir_state* st, size_t num_taps) {
     if (!st) return VV_DSP_ERROR_NULL_POINTER;
     if (num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
     memset(st, 0, sizeof(*st));
     st->num_taps = num_taps;
-    st->history_size = (num_taps > 0) ? (num_taps - 1) : 0;
-    if (st->history_size) {
-        st->history = (vv_dsp_real*)calloc(st->history_size, sizeof(vv_dsp_real));
-        if (!st->history) return VV_DSP_ERROR_INTERNAL;
+    st->history_size = num_taps - 1;
+    st->stage_size = (st->history_size > FIR_MIN_STAGE) ? st->history_size : FIR_MIN_STAGE;
+    st->history = (vv_dsp_real*)vv_dsp_calloc(st->history_size + st->stage_size, sizeof(vv_dsp_real));
+    st->coeffs_rev = (vv_dsp_real*)vv_dsp_malloc(num_taps * sizeof(vv_dsp_real));
+    if (!st->history || !st->coeffs_rev) {
+        vv_dsp_fir_state_free(st);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_state_prepare(vv_dsp_fir_state* st, size_t max_block) {
+    if (!st) return VV_DSP_ERROR_NULL_POINTER;
+    if (!st->history || !st->coeffs_rev) return VV_DSP_ERROR_NULL_POINTER;
+    if (max_block == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    fir_plan_free(st);
+    st->max_block = 0;
+    if (vv_dsp_conv_select(st->num_taps, max_block) == VV_DSP_CONV_FFT) {
+        // Sized for the staging block, like the per-call plan of an unprepared state;
+        // zero taps until the first call brings the real ones
+        fir_fft_plan* plan = (fir_fft_plan*)vv_dsp_calloc(1, sizeof(*plan));
+        if (!plan) return VV_DSP_ERROR_INTERNAL;
+        plan->taps = (vv_dsp_real*)vv_dsp_calloc(st->num_taps, sizeof(vv_dsp_real));
+        vv_dsp_status s = plan->taps ? vv_dsp_conv_fft_init(&plan->conv, plan->taps, st->num_taps, st->stage_size)
+                                     : VV_DSP_ERROR_INTERNAL;
+        if (s != VV_DSP_OK) {
+            vv_dsp_free(plan->taps);
+            vv_dsp_free(plan);
+            return s;
+        }
+        st->fft = plan;
     }
-    st->history_idx = 0;
+    st->max_block = max_block;
     return VV_DSP_OK;
 }
 
 void vv_dsp_fir_state_free(vv_dsp_fir_state* st) {
     if (!st) return;
-    free(st->history);
+    fir_plan_free(st);
+    vv_dsp_free(st->history);
+    vv_dsp_free(st->coeffs_rev);
     st->history = NULL;
+    st->coeffs_rev = NULL;
     st->history_size = 0;
-    st->history_idx = 0;
+    st->stage_size = 0;
     st->num_taps = 0;
+    st->max_block = 0;
+}
+
+// Load the reversed taps and pick the FFT engine for calls of n samples: the
+// state's plan (its tap spectrum refreshed when the taps changed), a per-call plan
+// in *local for an unprepared state, or NULL for the direct kernel
+static vv_dsp_status fir_load(vv_dsp_fir_state* st, const vv_dsp_real* h, size_t n, vv_dsp_conv_fft* local,
+                              vv_dsp_conv_fft** out_fft) {
+    const size_t L = st->num_taps;
+    // h[k] multiplies the sample k steps ago; the linear window runs oldest to newest
+    for (size_t j = 0; j < L; ++j) st->coeffs_rev[j] = h[L - 1 - j];
+
+    // Long filters over long calls go through FFT overlap-save, with the taps
+    // transformed once per call. A prepared state keeps its plan and transforms
+    // only changed taps; without a plan it stays on the direct kernel rather than
+    // allocate one.
+    *out_fft = NULL;
+    if (vv_dsp_conv_select(L, n) != VV_DSP_CONV_FFT) return VV_DSP_OK;
+    fir_fft_plan* plan = (fir_fft_plan*)st->fft;
+    if (plan) {
+        if (memcmp(plan->taps, st->coeffs_rev, L * sizeof(vv_dsp_real)) != 0) {
+            const vv_dsp_status s = vv_dsp_conv_fft_set_taps(&plan->conv, st->coeffs_rev);
+            if (s != VV_DSP_OK) return s;
+            memcpy(plan->taps, st->coeffs_rev, L * sizeof(vv_dsp_real));
+        }
+        *out_fft = &plan->conv;
+    } else if (st->max_block == 0) {
+        const vv_dsp_status s = vv_dsp_conv_fft_init(local, st->coeffs_rev, L, st->stage_size);
+        if (s != VV_DSP_OK) return s;
+        *out_fft = local;
+    }
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status fir_run(vv_dsp_fir_state* st, const vv_dsp_real* h, const vv_dsp_real* x, vv_dsp_real* y,
+                             size_t n) {
+    const size_t L = st->num_taps;
+    const size_t H = st->history_size;
+    vv_dsp_conv_fft local;
+    vv_dsp_conv_fft* fft = NULL;
+    vv_dsp_status s = fir_load(st, h, n, &local, &fft);
+    if (s != VV_DSP_OK) return s;
+
+    // Stage each chunk behind the history, filter it, then slide the newest H
+    // samples to the front. Input is copied before any output is written.
+    vv_dsp_real* lin = st->history;
+    for (size_t pos = 0; pos < n;) {
+        const size_t c = (n - pos < st->stage_size) ? n - pos : st->stage_size;
+        memcpy(lin + H, x + pos, c * sizeof(vv_dsp_real));
+        if (fft) {
+            s = vv_dsp_conv_fft_run(fft, lin, y + pos, c);
+            if (s != VV_DSP_OK) break;
+        } else {
+            fir_kernel(st->coeffs_rev, L, lin, y + pos, c, 0);
+        }
+        if (H) memmove(lin, lin + c, H * sizeof(vv_dsp_real));
+        pos += c;
+    }
+    if (fft == &local) vv_dsp_conv_fft_free(&local);
+    return s;
 }
 
 vv_dsp_status vv_dsp_fir_apply(vv_dsp_fir_state* st,
@@ -164,33 +301,133 @@ vv_dsp_status vv_dsp_fir_apply(vv_dsp_fir_state* st,
                                size_t n) {
     if (!st || !h || !x || !y) return VV_DSP_ERROR_NULL_POINTER;
     if (st->num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!st->history || !st->coeffs_rev) return VV_DSP_ERROR_NULL_POINTER;
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_FIR_APPLY);
+    const int rt = VV_DSP_RT_ENTER(st->max_block != 0);
+    const vv_dsp_status s = fir_run(st, h, x, y, n);
+    VV_DSP_RT_LEAVE(rt);
+    VV_DSP_PROFILE_END(prof, n);
+    return s;
+}
+
+// Foreign-precision samples stream through stack blocks; the state carries across blocks
+static vv_dsp_status fir_apply_foreign(vv_dsp_fir_state* st, const vv_dsp_real* h, const vv_foreign_real* x,
+                                       vv_foreign_real* y, size_t n) {
+    if (!st || !h || !x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_real block[VV_FOREIGN_BLOCK];
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t pos = 0; pos < n && s == VV_DSP_OK; pos += VV_FOREIGN_BLOCK) {
+        const size_t c = (n - pos < VV_FOREIGN_BLOCK) ? n - pos : VV_FOREIGN_BLOCK;
+        s = VV_FOREIGN_TO_REAL(x + pos, block, c);
+        if (s == VV_DSP_OK) s = vv_dsp_fir_apply(st, h, block, block, c);
+        if (s == VV_DSP_OK) s = VV_REAL_TO_FOREIGN(block, y + pos, c);
+    }
+    return s;
+}
+
+#ifdef VV_DSP_USE_DOUBLE
+vv_dsp_status vv_dsp_fir_apply_f32(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const float* input,
+                                   float* output, size_t num_samples) {
+    return fir_apply_foreign(state, coeffs, input, output, num_samples);
+}
+
+vv_dsp_status vv_dsp_fir_apply_f64(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const double* input,
+                                   double* output, size_t num_samples) {
+    return vv_dsp_fir_apply(state, coeffs, input, output, num_samples);
+}
+#else
+vv_dsp_status vv_dsp_fir_apply_f32(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const float* input,
+                                   float* output, size_t num_samples) {
+    return vv_dsp_fir_apply(state, coeffs, input, output, num_samples);
+}
+
+vv_dsp_status vv_dsp_fir_apply_f64(vv_dsp_fir_state* state, const vv_dsp_real* coeffs, const double* input,
+                                   double* output, size_t num_samples) {
+    return fir_apply_foreign(state, coeffs, input, output, num_samples);
+}
+#endif
+
+#define FIR_FRAME_CHUNK 256
+#define FIR_CHANNEL_BLOCK 8
 
-    size_t L = st->num_taps;
-    // For each sample, we convolve using history + current input window
-    for (size_t i = 0; i < n; ++i) {
-        vv_dsp_real acc = 0;
-        // h[0] multiplies current sample, h[k] multiplies sample k steps ago
-        // Compose a virtual window: [x[i], x[i-1], ..., history]
-        // Start with current input and previous history (do not push x[i] yet)
-        size_t tap = 0;
-        acc += h[tap++] * x[i];
-        // Pull from history newest->oldest
-        if (st->history_size) {
-            size_t idx = (st->history_idx == 0) ? (st->history_size - 1) : (st->history_idx - 1);
-            for (; tap < L; ++tap) {
-                vv_dsp_real v = st->history[idx];
-                acc += h[tap] * v;
-                if (idx == 0) idx = st->history_size - 1; else idx--;
+// Interleaved or strided channels: stage a chunk of every channel behind its
+// history, then compute the outputs frame by frame across a block of channels so
+// that each tap is loaded once for all of them. Long filters share one tap spectrum
+// (the first state's) and run channel by channel through a small bounce buffer.
+static vv_dsp_status fir_run_frames(vv_dsp_fir_state* st, size_t C, const vv_dsp_real* h,
+                                    const vv_dsp_buffer* in, vv_dsp_buffer* out) {
+    const size_t L = st[0].num_taps;
+    const size_t H = st[0].history_size;
+    const size_t N = in->frames;
+    // Outputs bounce through the stack, so chunks are short and pick the engine
+    const size_t chunk = st[0].stage_size < FIR_FRAME_CHUNK ? st[0].stage_size : FIR_FRAME_CHUNK;
+    vv_dsp_conv_fft local;
+    vv_dsp_conv_fft* fft = NULL;
+    vv_dsp_status s = fir_load(&st[0], h, N < chunk ? N : chunk, &local, &fft);
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_real* rev = st[0].coeffs_rev;
+    vv_dsp_real bounce[FIR_FRAME_CHUNK];
+
+    for (size_t pos = 0; pos < N && s == VV_DSP_OK;) {
+        const size_t c = (N - pos < chunk) ? N - pos : chunk;
+        for (size_t ch = 0; ch < C; ++ch) {
+            const vv_dsp_real* x = in->data + ch * in->channel_stride + pos * in->frame_stride;
+            vv_dsp_real* stage = st[ch].history + H;
+            for (size_t i = 0; i < c; ++i) stage[i] = x[i * in->frame_stride];
+        }
+        if (fft) {
+            for (size_t ch = 0; ch < C && s == VV_DSP_OK; ++ch) {
+                s = vv_dsp_conv_fft_run(fft, st[ch].history, bounce, c);
+                vv_dsp_real* y = out->data + ch * out->channel_stride + pos * out->frame_stride;
+                for (size_t i = 0; s == VV_DSP_OK && i < c; ++i) y[i * out->frame_stride] = bounce[i];
+            }
+        } else {
+            for (size_t c0 = 0; c0 < C; c0 += FIR_CHANNEL_BLOCK) {
+                const size_t nb = (C - c0 < FIR_CHANNEL_BLOCK) ? C - c0 : FIR_CHANNEL_BLOCK;
+                const vv_dsp_real* lin[FIR_CHANNEL_BLOCK];
+                for (size_t b = 0; b < nb; ++b) lin[b] = st[c0 + b].history;
+                for (size_t i = 0; i < c; ++i) {
+                    vv_dsp_real acc[FIR_CHANNEL_BLOCK] = {0};
+                    for (size_t k = 0; k < L; ++k) {
+                        const vv_dsp_real t = rev[k];
+                        for (size_t b = 0; b < nb; ++b) acc[b] += t * lin[b][i + k];
+                    }
+                    vv_dsp_real* y = out->data + c0 * out->channel_stride + (pos + i) * out->frame_stride;
+                    for (size_t b = 0; b < nb; ++b) y[b * out->channel_stride] = acc[b];
+                }
             }
         }
-        y[i] = acc;
+        for (size_t ch = 0; H && ch < C; ++ch) memmove(st[ch].history, st[ch].history + c, H * sizeof(vv_dsp_real));
+        pos += c;
+    }
+    if (fft == &local) vv_dsp_conv_fft_free(&local);
+    return s;
+}
 
-        // Now push current input into history for future samples
-        if (st->history_size) {
-            st->history[st->history_idx] = x[i];
-            st->history_idx = (st->history_idx + 1) % st->history_size;
+vv_dsp_status vv_dsp_fir_apply_buffer(vv_dsp_fir_state* states,
+                                      const vv_dsp_real* h,
+                                      const vv_dsp_buffer* in,
+                                      vv_dsp_buffer* out) {
+    if (!states || !h || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t C = in->channels;
+    if (out->channels != C || out->frames < in->frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (C == 0 || in->frames == 0) return VV_DSP_OK;
+    if (!in->data || !out->data) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t ch = 0; ch < C; ++ch) {
+        if (!states[ch].history || !states[ch].coeffs_rev) return VV_DSP_ERROR_NULL_POINTER;
+        if (states[ch].num_taps == 0 || states[ch].num_taps != states[0].num_taps) return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    const int rt = VV_DSP_RT_ENTER(states[0].max_block != 0);
+    vv_dsp_status s = VV_DSP_OK;
+    if (in->frame_stride == 1 && out->frame_stride == 1) {
+        // Planar: the single-channel path, one contiguous run per channel
+        for (size_t ch = 0; ch < C && s == VV_DSP_OK; ++ch) {
+            s = fir_run(&states[ch], h, in->data + ch * in->channel_stride, out->data + ch * out->channel_stride,
+                        in->frames);
         }
+    } else {
+        s = fir_run_frames(states, C, h, in, out);
     }
-
-    return VV_DSP_OK;
+    VV_DSP_RT_LEAVE(rt);
+    return s;
 }
@@ -0,0 +1,22 @@
+/*
+This file is part of vv-dsp
+
+Private windowed FIR design helpers shared by vv_dsp_fir_design_lowpass() and
+the CIC compensator design.
+*/
+
+#ifndef VV_DSP_FILTER_FIR_DESIGN_H
+#define VV_DSP_FILTER_FIR_DESIGN_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/filter/common.h"
+#include "vv_dsp/window.h"
+
+// Fill w[N] with the design window of the given type
+vv_dsp_status vv_dsp_fir_window_fill(vv_dsp_real* w, size_t N, vv_dsp_window_type type);
+
+// Take a reference on the cached design window; release with vv_dsp_window_release()
+vv_dsp_status vv_dsp_fir_window_acquire(size_t N, vv_dsp_window_type type, const vv_dsp_real** out);
+
+#endif // VV_DSP_FILTER_FIR_DESIGN_H
@@ -0,0 +1,217 @@
+#include "vv_dsp/filter/fixed.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#if !defined(VV_DSP_SIMD_NEON) && defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+// Q15 taps are zero-padded to a multiple of this so the dot product needs no tail loop
+#define FQ_PAD 16
+// Staging block of at least this many samples, as in vv_dsp_fir_apply()
+#define FQ_MIN_STAGE 512
+
+struct vv_dsp_fir_q15 {
+    size_t taps;
+    size_t tpad;             // taps rounded up to FQ_PAD
+    size_t hist;             // taps - 1
+    size_t stage;
+    vv_dsp_q15* hr;          // reversed taps, tpad (zero tail)
+    vv_dsp_q15* lin;         // hist past samples, stage staging slots, tpad slack
+    int fast;                // sum |h| <= 1.0: 32-bit partial sums are exact
+};
+
+struct vv_dsp_fir_q31 {
+    size_t taps;
+    size_t hist;
+    size_t stage;
+    vv_dsp_q31* hr;          // reversed taps
+    vv_dsp_q31* lin;         // hist past samples, then stage staging slots
+};
+
+// sum_j h[j] * x[j] over n (multiple of FQ_PAD) terms, exact in 32 bits by the caller's
+// gain bound (see fast)
+static int32_t dot_q15_fast(const vv_dsp_q15* h, const vv_dsp_q15* x, size_t n) {
+#if defined(VV_DSP_SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t j = 0; j < n; j += 16) {
+        const __m256i hv = _mm256_loadu_si256((const __m256i*)(const void*)(h + j));
+        const __m256i xv = _mm256_loadu_si256((const __m256i*)(const void*)(x + j));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(hv, xv));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+#elif defined(VV_DSP_SIMD_SSE41)
+    __m128i acc = _mm_setzero_si128();
+    for (size_t j = 0; j < n; j += 8) {
+        const __m128i hv = _mm_loadu_si128((const __m128i*)(const void*)(h + j));
+        const __m128i xv = _mm_loadu_si128((const __m128i*)(const void*)(x + j));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(hv, xv));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+    return _mm_cvtsi128_si32(acc);
+#elif defined(VV_DSP_SIMD_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (size_t j = 0; j < n; j += 8) {
+        acc = vmlal_s16(acc, vld1_s16(h + j), vld1_s16(x + j));
+        acc = vmlal_s16(acc, vld1_s16(h + j + 4), vld1_s16(x + j + 4));
+    }
+#  if defined(__aarch64__)
+    return vaddvq_s32(acc);
+#  else
+    int32x2_t s = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    s = vpadd_s32(s, s);
+    return vget_lane_s32(s, 0);
+#  endif
+#elif defined(__ARM_FEATURE_DSP)
+    // Dual 16-bit MAC on packed pairs
+    int32_t acc = 0;
+    for (size_t j = 0; j < n; j += 2) {
+        uint32_t hw, xw;
+        memcpy(&hw, h + j, sizeof(hw));
+        memcpy(&xw, x + j, sizeof(xw));
+        acc = (int32_t)__smlad(hw, xw, (uint32_t)acc);
+    }
+    return acc;
+#else
+    int32_t acc = 0;
+    for (size_t j = 0; j < n; ++j) acc += (int32_t)h[j] * (int32_t)x[j];
+    return acc;
+#endif
+}
+
+// Q30 sum rounded and saturated to Q15
+static vv_dsp_q15 round_q30(int64_t acc) {
+    const int64_t v = (acc + (1 << 14)) >> 15;
+    return (vv_dsp_q15)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+static int64_t dot_q15_wide(const vv_dsp_q15* h, const vv_dsp_q15* x, size_t n) {
+    int64_t acc = 0;
+    for (size_t j = 0; j < n; ++j) acc += (int32_t)h[j] * (int32_t)x[j];
+    return acc;
+}
+
+void vv_dsp_fir_q15_destroy(vv_dsp_fir_q15* f) {
+    if (!f) return;
+    vv_dsp_free(f->hr);
+    vv_dsp_free(f->lin);
+    vv_dsp_free(f);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q15_create(const vv_dsp_q15* h, size_t L, vv_dsp_fir_q15** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fir_q15* f = (vv_dsp_fir_q15*)vv_dsp_calloc(1, sizeof(*f));
+    if (!f) return VV_DSP_ERROR_INTERNAL;
+    f->taps = L;
+    f->tpad = (L + FQ_PAD - 1) / FQ_PAD * FQ_PAD;
+    f->hist = L - 1;
+    f->stage = (f->hist > FQ_MIN_STAGE) ? f->hist : FQ_MIN_STAGE;
+    f->hr = (vv_dsp_q15*)vv_dsp_calloc(f->tpad, sizeof(vv_dsp_q15));
+    f->lin = (vv_dsp_q15*)vv_dsp_calloc(f->hist + f->stage + f->tpad, sizeof(vv_dsp_q15));
+    if (!f->hr || !f->lin) {
+        vv_dsp_fir_q15_destroy(f);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    int64_t gain = 0;
+    for (size_t j = 0; j < L; ++j) {
+        f->hr[j] = h[L - 1 - j];
+        gain += (h[j] < 0) ? -(int64_t)h[j] : (int64_t)h[j];
+    }
+    f->fast = gain <= 32768;
+    *out = f;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q15_process(vv_dsp_fir_q15* f,
+                                                      const vv_dsp_q15* x,
+                                                      vv_dsp_q15* y,
+                                                      size_t n) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t H = f->hist;
+    for (size_t pos = 0; pos < n;) {
+        const size_t c = (n - pos < f->stage) ? n - pos : f->stage;
+        memcpy(f->lin + H, x + pos, c * sizeof(vv_dsp_q15));
+        if (f->fast) {
+            for (size_t i = 0; i < c; ++i) y[pos + i] = round_q30(dot_q15_fast(f->hr, f->lin + i, f->tpad));
+        } else {
+            for (size_t i = 0; i < c; ++i) y[pos + i] = round_q30(dot_q15_wide(f->hr, f->lin + i, f->taps));
+        }
+        if (H) memmove(f->lin, f->lin + c, H * sizeof(vv_dsp_q15));
+        pos += c;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_q15_reset(vv_dsp_fir_q15* f) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    memset(f->lin, 0, (f->hist + f->stage + f->tpad) * sizeof(vv_dsp_q15));
+    return VV_DSP_OK;
+}
+
+void vv_dsp_fir_q31_destroy(vv_dsp_fir_q31* f) {
+    if (!f) return;
+    vv_dsp_free(f->hr);
+    vv_dsp_free(f->lin);
+    vv_dsp_free(f);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q31_create(const vv_dsp_q31* h, size_t L, vv_dsp_fir_q31** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fir_q31* f = (vv_dsp_fir_q31*)vv_dsp_calloc(1, sizeof(*f));
+    if (!f) return VV_DSP_ERROR_INTERNAL;
+    f->taps = L;
+    f->hist = L - 1;
+    f->stage = (f->hist > FQ_MIN_STAGE) ? f->hist : FQ_MIN_STAGE;
+    f->hr = (vv_dsp_q31*)vv_dsp_malloc(L * sizeof(vv_dsp_q31));
+    f->lin = (vv_dsp_q31*)vv_dsp_calloc(f->hist + f->stage, sizeof(vv_dsp_q31));
+    if (!f->hr || !f->lin) {
+        vv_dsp_fir_q31_destroy(f);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t j = 0; j < L; ++j) f->hr[j] = h[L - 1 - j];
+    *out = f;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_q31_process(vv_dsp_fir_q31* f,
+                                                      const vv_dsp_q31* x,
+                                                      vv_dsp_q31* y,
+                                                      size_t n) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t H = f->hist, L = f->taps;
+    for (size_t pos = 0; pos < n;) {
+        const size_t c = (n - pos < f->stage) ? n - pos : f->stage;
+        memcpy(f->lin + H, x + pos, c * sizeof(vv_dsp_q31));
+        for (size_t i = 0; i < c; ++i) {
+            // Q2.62 sum (64-bit MAC, SMLAL on ARM), rounded to Q31
+            const vv_dsp_q31* w = f->lin + i;
+            int64_t acc = 0;
+            for (size_t j = 0; j < L; ++j) acc += (int64_t)f->hr[j] * (int64_t)w[j];
+            y[pos + i] = vv_dsp_sat_q31((acc >> 31) + ((acc >> 30) & 1));
+        }
+        if (H) memmove(f->lin, f->lin + c, H * sizeof(vv_dsp_q31));
+        pos += c;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_q31_reset(vv_dsp_fir_q31* f) {
+    if (!f) return VV_DSP_ERROR_NULL_POINTER;
+    memset(f->lin, 0, (f->hist + f->stage) * sizeof(vv_dsp_q31));
+    return VV_DSP_OK;
+}
@@ -0,0 +1,82 @@
+/*
+This file is part of vv-dsp
+
+Private direct-form FIR kernel shared by the streaming FIR and the polyphase
+decimator/interpolator branches. Float builds vectorize across consecutive
+outputs using the vector macros of filter_simd.h.
+*/
+
+#ifndef VV_DSP_FILTER_FIR_KERNEL_H
+#define VV_DSP_FILTER_FIR_KERNEL_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "filter_simd.h"
+
+// y[i] (+)= sum_j hr[j] * xs[i + j] for i < count; xs holds count + L - 1 samples.
+// With accumulate nonzero the sums are added to y instead of overwriting it.
+// Vector lanes run across consecutive outputs, so each tap is one broadcast
+// shared by 4 vectors of outputs.
+static inline void fir_kernel(const vv_dsp_real* hr, size_t L, const vv_dsp_real* xs,
+                              vv_dsp_real* y, size_t count, int accumulate) {
+    size_t i = 0;
+#if defined(VF_W)
+    for (; i + 4 * VF_W <= count; i += 4 * VF_W) {
+        vf_vec a0, a1, a2, a3;
+        if (accumulate) {
+            a0 = VF_LOAD(y + i); a1 = VF_LOAD(y + i + VF_W);
+            a2 = VF_LOAD(y + i + 2 * VF_W); a3 = VF_LOAD(y + i + 3 * VF_W);
+        } else {
+            a0 = VF_ZERO(); a1 = VF_ZERO(); a2 = VF_ZERO(); a3 = VF_ZERO();
+        }
+        const vv_dsp_real* p = xs + i;
+        for (size_t j = 0; j < L; ++j) {
+            const vf_vec c = VF_SET1(hr[j]);
+            a0 = VF_MAC(a0, c, VF_LOAD(p + j));
+            a1 = VF_MAC(a1, c, VF_LOAD(p + j + VF_W));
+            a2 = VF_MAC(a2, c, VF_LOAD(p + j + 2 * VF_W));
+            a3 = VF_MAC(a3, c, VF_LOAD(p + j + 3 * VF_W));
+        }
+        VF_STORE(y + i, a0);
+        VF_STORE(y + i + VF_W, a1);
+        VF_STORE(y + i + 2 * VF_W, a2);
+        VF_STORE(y + i + 3 * VF_W, a3);
+    }
+    for (; i + VF_W <= count; i += VF_W) {
+        vf_vec a0 = accumulate ? VF_LOAD(y + i) : VF_ZERO();
+        for (size_t j = 0; j < L; ++j) a0 = VF_MAC(a0, VF_SET1(hr[j]), VF_LOAD(xs + i + j));
+        VF_STORE(y + i, a0);
+    }
+    // Outputs past the last vector take the same operations as one lane, so an
+    // output does not depend on where the call's count ends
+    for (; i < count; ++i) {
+        vv_dsp_real acc = accumulate ? y[i] : (vv_dsp_real)0;
+        for (size_t j = 0; j < L; ++j) acc = VF_SMAC(acc, hr[j], xs[i + j]);
+        y[i] = acc;
+    }
+#else
+    for (; i + 4 <= count; i += 4) {
+        vv_dsp_real a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        const vv_dsp_real* p = xs + i;
+        for (size_t j = 0; j < L; ++j) {
+            const vv_dsp_real c = hr[j];
+            a0 += c * p[j];
+            a1 += c * p[j + 1];
+            a2 += c * p[j + 2];
+            a3 += c * p[j + 3];
+        }
+        if (accumulate) {
+            y[i] += a0; y[i + 1] += a1; y[i + 2] += a2; y[i + 3] += a3;
+        } else {
+            y[i] = a0; y[i + 1] = a1; y[i + 2] = a2; y[i + 3] = a3;
+        }
+    }
+    for (; i < count; ++i) {
+        vv_dsp_real acc = 0;
+        for (size_t j = 0; j < L; ++j) acc += hr[j] * xs[i + j];
+        y[i] = accumulate ? y[i] + acc : acc;
+    }
+#endif
+}
+
+#endif // VV_DSP_FILTER_FIR_KERNEL_H
@@ -1,4 +1,11 @@
 #include "vv_dsp/filter/iir.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "../core/typed_foreign.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 vv_dsp_status vv_dsp_biquad_init(vv_dsp_biquad* bq,
                                  vv_dsp_real b0,
@@ -13,6 +20,69 @@ vv_dsp_status vv_dsp_biquad_init(vv_dsp_biquad* bq,
     return VV_DSP_OK;
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_design(vv_dsp_biquad* bq,
+                                                    vv_dsp_biquad_type type,
+                                                    vv_dsp_real sample_rate,
+                                                    vv_dsp_real freq_hz,
+                                                    vv_dsp_real q,
+                                                    vv_dsp_real gain_db) {
+    if (!bq) return VV_DSP_ERROR_NULL_POINTER;
+    if (!(sample_rate > (vv_dsp_real)0) || !(freq_hz > (vv_dsp_real)0) ||
+        !(freq_hz < (vv_dsp_real)0.5 * sample_rate) || !(q > (vv_dsp_real)0)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const double w0 = VV_DSP_TWO_PI_D * (double)freq_hz / (double)sample_rate;
+    const double cw = cos(w0), alpha = sin(w0) / (2.0 * (double)q);
+    const double A = pow(10.0, (double)gain_db / 40.0), sa = 2.0 * sqrt(A) * alpha;
+    double b0, b1, b2, a0, a1, a2;
+    switch (type) {
+    case VV_DSP_BIQUAD_LOWPASS:
+        b0 = b2 = 0.5 * (1.0 - cw); b1 = 1.0 - cw;
+        a0 = 1.0 + alpha; a1 = -2.0 * cw; a2 = 1.0 - alpha;
+        break;
+    case VV_DSP_BIQUAD_HIGHPASS:
+        b0 = b2 = 0.5 * (1.0 + cw); b1 = -(1.0 + cw);
+        a0 = 1.0 + alpha; a1 = -2.0 * cw; a2 = 1.0 - alpha;
+        break;
+    case VV_DSP_BIQUAD_BANDPASS:
+        b0 = alpha; b1 = 0.0; b2 = -alpha;
+        a0 = 1.0 + alpha; a1 = -2.0 * cw; a2 = 1.0 - alpha;
+        break;
+    case VV_DSP_BIQUAD_NOTCH:
+        b0 = b2 = 1.0; b1 = -2.0 * cw;
+        a0 = 1.0 + alpha; a1 = -2.0 * cw; a2 = 1.0 - alpha;
+        break;
+    case VV_DSP_BIQUAD_ALLPASS:
+        b0 = 1.0 - alpha; b1 = -2.0 * cw; b2 = 1.0 + alpha;
+        a0 = 1.0 + alpha; a1 = -2.0 * cw; a2 = 1.0 - alpha;
+        break;
+    case VV_DSP_BIQUAD_PEAKING:
+        b0 = 1.0 + alpha * A; b1 = -2.0 * cw; b2 = 1.0 - alpha * A;
+        a0 = 1.0 + alpha / A; a1 = -2.0 * cw; a2 = 1.0 - alpha / A;
+        break;
+    case VV_DSP_BIQUAD_LOWSHELF:
+        b0 = A * ((A + 1.0) - (A - 1.0) * cw + sa);
+        b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cw);
+        b2 = A * ((A + 1.0) - (A - 1.0) * cw - sa);
+        a0 = (A + 1.0) + (A - 1.0) * cw + sa;
+        a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cw);
+        a2 = (A + 1.0) + (A - 1.0) * cw - sa;
+        break;
+    case VV_DSP_BIQUAD_HIGHSHELF:
+        b0 = A * ((A + 1.0) + (A - 1.0) * cw + sa);
+        b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cw);
+        b2 = A * ((A + 1.0) + (A - 1.0) * cw - sa);
+        a0 = (A + 1.0) - (A - 1.0) * cw + sa;
+        a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cw);
+        a2 = (A + 1.0) - (A - 1.0) * cw - sa;
+        break;
+    default:
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    return vv_dsp_biquad_init(bq, (vv_dsp_real)(b0 / a0), (vv_dsp_real)(b1 / a0), (vv_dsp_real)(b2 / a0),
+                              (vv_dsp_real)(a1 / a0), (vv_dsp_real)(a2 / a0));
+}
+
 void vv_dsp_biquad_reset(vv_dsp_biquad* bq) {
     if (!bq) return;
     bq->z1 = 0; bq->z2 = 0;
@@ -32,6 +102,9 @@ vv_dsp_status vv_dsp_iir_apply(vv_dsp_biquad* biquads,
                                vv_dsp_real* output,
                                size_t n) {
     if (!input || !output || (!biquads && num_stages>0)) return VV_DSP_ERROR_NULL_POINTER;
+    // Biquads hold all their state: always real-time, no preparation
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_IIR_APPLY);
+    const int rt = VV_DSP_RT_ENTER(1);
     for (size_t i = 0; i < n; ++i) {
         vv_dsp_real v = input[i];
         for (size_t s = 0; s < num_stages; ++s) {
@@ -39,5 +112,122 @@ vv_dsp_status vv_dsp_iir_apply(vv_dsp_biquad* biquads,
         }
         output[i] = v;
     }
+    VV_DSP_RT_LEAVE(rt);
+    VV_DSP_PROFILE_END(prof, n);
+    return VV_DSP_OK;
+}
+
+// Foreign-precision samples are converted one at a time around the cascade
+static vv_dsp_status iir_apply_foreign(vv_dsp_biquad* biquads, size_t num_stages, const vv_foreign_real* input,
+                                       vv_foreign_real* output, size_t n) {
+    if (!input || !output || (!biquads && num_stages>0)) return VV_DSP_ERROR_NULL_POINTER;
+    const int rt = VV_DSP_RT_ENTER(1);
+    for (size_t i = 0; i < n; ++i) {
+        vv_dsp_real v = (vv_dsp_real)input[i];
+        for (size_t s = 0; s < num_stages; ++s) {
+            v = vv_dsp_biquad_process(&biquads[s], v);
+        }
+        output[i] = (vv_foreign_real)v;
+    }
+    VV_DSP_RT_LEAVE(rt);
+    return VV_DSP_OK;
+}
+
+#ifdef VV_DSP_USE_DOUBLE
+vv_dsp_status vv_dsp_iir_apply_f32(vv_dsp_biquad* biquads, size_t num_stages, const float* input, float* output,
+                                   size_t num_samples) {
+    return iir_apply_foreign(biquads, num_stages, input, output, num_samples);
+}
+
+vv_dsp_status vv_dsp_iir_apply_f64(vv_dsp_biquad* biquads, size_t num_stages, const double* input, double* output,
+                                   size_t num_samples) {
+    return vv_dsp_iir_apply(biquads, num_stages, input, output, num_samples);
+}
+#else
+vv_dsp_status vv_dsp_iir_apply_f32(vv_dsp_biquad* biquads, size_t num_stages, const float* input, float* output,
+                                   size_t num_samples) {
+    return vv_dsp_iir_apply(biquads, num_stages, input, output, num_samples);
+}
+
+vv_dsp_status vv_dsp_iir_apply_f64(vv_dsp_biquad* biquads, size_t num_stages, const double* input, double* output,
+                                   size_t num_samples) {
+    return iir_apply_foreign(biquads, num_stages, input, output, num_samples);
+}
+#endif
+
+// Steady-state DF2T states of every section for a constant input of 1 into the
+// cascade; section s sees the DC gain of the sections before it
+static void cascade_zi(vv_dsp_biquad* bq, size_t S, vv_dsp_real* zi) {
+    double level = 1.0;
+    for (size_t s = 0; s < S; ++s) {
+        const double b0 = (double)bq[s].b0, b1 = (double)bq[s].b1, b2 = (double)bq[s].b2;
+        const double a1 = (double)bq[s].a1, a2 = (double)bq[s].a2;
+        const double den = 1.0 + a1 + a2;
+        // A pole at DC has no steady state; start that section (and the rest) from rest
+        if (den == 0.0) {
+            for (; s < S; ++s) zi[2 * s] = zi[2 * s + 1] = 0;
+            return;
+        }
+        const double g = (b0 + b1 + b2) / den;
+        zi[2 * s + 1] = (vv_dsp_real)(level * (b2 - a2 * g));
+        zi[2 * s] = (vv_dsp_real)(level * (b1 + b2 - (a1 + a2) * g));
+        level *= g;
+    }
+}
+
+static void cascade_start(vv_dsp_biquad* bq, size_t S, const vv_dsp_real* zi, vv_dsp_real x0) {
+    for (size_t s = 0; s < S; ++s) {
+        bq[s].z1 = zi[2 * s] * x0;
+        bq[s].z2 = zi[2 * s + 1] * x0;
+    }
+}
+
+static vv_dsp_real cascade_step(vv_dsp_biquad* bq, size_t S, vv_dsp_real v) {
+    for (size_t s = 0; s < S; ++s) v = vv_dsp_biquad_process(&bq[s], v);
+    return v;
+}
+
+vv_dsp_status vv_dsp_filtfilt_iir(const vv_dsp_biquad* biquads,
+                                  size_t S,
+                                  const vv_dsp_real* x,
+                                  vv_dsp_real* y,
+                                  size_t n,
+                                  size_t pad) {
+    if (!x || !y || !biquads) return VV_DSP_ERROR_NULL_POINTER;
+    if (S == 0 || n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (pad == VV_DSP_FILTFILT_DEFAULT_PAD) pad = 3 * (2 * S + 1);
+    if (pad > n - 1) pad = n - 1;
+
+    // S working sections, 2*S steady-state states, then the two edge extensions
+    const size_t bytes = S * sizeof(vv_dsp_biquad) + (2 * S + 2 * pad) * sizeof(vv_dsp_real);
+    vv_dsp_biquad* bq = (vv_dsp_biquad*)vv_dsp_malloc(bytes);
+    if (!bq) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_real* zi = (vv_dsp_real*)(bq + S);
+    vv_dsp_real* left = zi + 2 * S;
+    vv_dsp_real* right = left + pad;
+    memcpy(bq, biquads, S * sizeof(vv_dsp_biquad));
+    cascade_zi(bq, S, zi);
+
+    // Odd extensions: left[i] is sample i of the padded signal, right[i] follows x[n-1]
+    const vv_dsp_real x0 = x[0], xn = x[n - 1];
+    for (size_t i = 0; i < pad; ++i) {
+        left[i] = 2 * x0 - x[pad - i];
+        right[i] = 2 * xn - x[n - 2 - i];
+    }
+
+    // Forward pass over left | x | right; x is read before y[i] is written
+    cascade_start(bq, S, zi, pad ? left[0] : x0);
+    for (size_t i = 0; i < pad; ++i) (void)cascade_step(bq, S, left[i]);
+    for (size_t i = 0; i < n; ++i) y[i] = cascade_step(bq, S, x[i]);
+    for (size_t i = 0; i < pad; ++i) right[i] = cascade_step(bq, S, right[i]);
+
+    // Backward pass from the far end of the right extension, in place in y; the left
+    // extension only affects samples that are discarded
+    const vv_dsp_real last = pad ? right[pad - 1] : y[n - 1];
+    cascade_start(bq, S, zi, last);
+    for (size_t i = pad; i-- > 0;) (void)cascade_step(bq, S, right[i]);
+    for (size_t i = n; i-- > 0;) y[i] = cascade_step(bq, S, y[i]);
+
+    vv_dsp_free(bq);
     return VV_DSP_OK;
 }
@@ -0,0 +1,107 @@
+#include "vv_dsp/filter/fixed.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BQ_MAX_POST_SHIFT 8
+// Guard bits dropped from every product: five terms of magnitude < 2^62 then sum to
+// less than 2^63
+#define BQ_GUARD 2
+
+typedef struct bq_q31_stage {
+    vv_dsp_q31 b0, b1, b2, a1, a2; // Q(31 - post_shift)
+    vv_dsp_q31 x1, x2, y1, y2;     // direct form I state
+} bq_q31_stage;
+
+struct vv_dsp_biquad_q31 {
+    size_t stages;
+    int post_shift;
+    bq_q31_stage* st;
+};
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_q31_create(size_t S, int post_shift, vv_dsp_biquad_q31** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (S == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (post_shift < 0 || post_shift > BQ_MAX_POST_SHIFT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_biquad_q31* b = (vv_dsp_biquad_q31*)vv_dsp_calloc(1, sizeof(*b));
+    if (!b) return VV_DSP_ERROR_INTERNAL;
+    b->stages = S;
+    b->post_shift = post_shift;
+    b->st = (bq_q31_stage*)vv_dsp_calloc(S, sizeof(bq_q31_stage));
+    if (!b->st) {
+        vv_dsp_free(b);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    // Pass-through: b0 = 1.0 (the largest value below 1.0 when there is no headroom)
+    for (size_t s = 0; s < S; ++s) b->st[s].b0 = post_shift ? (vv_dsp_q31)1 << (31 - post_shift) : INT32_MAX;
+    *out = b;
+    return VV_DSP_OK;
+}
+
+// Round c * 2^(31 - post_shift) to Q31 storage; nonzero if it does not fit
+static int quantize(vv_dsp_real c, int post_shift, vv_dsp_q31* out) {
+    const double v = floor((double)c * ldexp(1.0, 31 - post_shift) + 0.5);
+    if (!(v >= (double)INT32_MIN && v <= (double)INT32_MAX)) return 1;
+    *out = (vv_dsp_q31)v;
+    return 0;
+}
+
+vv_dsp_status vv_dsp_biquad_q31_set_stage(vv_dsp_biquad_q31* b, size_t stage,
+                                          vv_dsp_real b0, vv_dsp_real b1, vv_dsp_real b2,
+                                          vv_dsp_real a1, vv_dsp_real a2) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (stage >= b->stages) return VV_DSP_ERROR_OUT_OF_RANGE;
+    bq_q31_stage q = b->st[stage];
+    if (quantize(b0, b->post_shift, &q.b0) || quantize(b1, b->post_shift, &q.b1) ||
+        quantize(b2, b->post_shift, &q.b2) || quantize(a1, b->post_shift, &q.a1) ||
+        quantize(a2, b->post_shift, &q.a2)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    b->st[stage] = q;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_biquad_q31_process(vv_dsp_biquad_q31* b,
+                                                         const vv_dsp_q31* x,
+                                                         vv_dsp_q31* y,
+                                                         size_t n) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    // Products are Q(62 - post_shift); after the guard shift the sum is brought back to Q31
+    const int out_shift = 31 - b->post_shift - BQ_GUARD;
+    for (size_t s = 0; s < b->stages; ++s) {
+        bq_q31_stage* q = &b->st[s];
+        const int64_t b0 = q->b0, b1 = q->b1, b2 = q->b2, a1 = q->a1, a2 = q->a2;
+        vv_dsp_q31 x1 = q->x1, x2 = q->x2, y1 = q->y1, y2 = q->y2;
+        const vv_dsp_q31* src = (s == 0) ? x : y;
+        for (size_t i = 0; i < n; ++i) {
+            const vv_dsp_q31 x0 = src[i];
+            const int64_t acc = ((b0 * x0) >> BQ_GUARD) + ((b1 * x1) >> BQ_GUARD) + ((b2 * x2) >> BQ_GUARD)
+                              - ((a1 * y1) >> BQ_GUARD) - ((a2 * y2) >> BQ_GUARD);
+            const vv_dsp_q31 y0 = vv_dsp_sat_q31((acc >> out_shift) + ((acc >> (out_shift - 1)) & 1));
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            y[i] = y0;
+        }
+        q->x1 = x1; q->x2 = x2; q->y1 = y1; q->y2 = y2;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_biquad_q31_reset(vv_dsp_biquad_q31* b) {
+    if (!b) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t s = 0; s < b->stages; ++s) {
+        b->st[s].x1 = b->st[s].x2 = 0;
+        b->st[s].y1 = b->st[s].y2 = 0;
+    }
+    return VV_DSP_OK;
+}
+
+void vv_dsp_biquad_q31_destroy(vv_dsp_biquad_q31* b) {
+    if (!b) return;
+    vv_dsp_free(b->st);
+    vv_dsp_free(b);
+}
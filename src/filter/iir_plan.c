@@ -0,0 +1,185 @@
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+#include <stdlib.h>
+#include <string.h>
+#include "filter_simd.h"
+
+#if defined(VF_W)
+#  define IIR_K VF_W
+#else
+#  define IIR_K 4
+#endif
+
+// One section in block state-space form. For a block u[0..K) starting from state
+// (z1, z2):
+//   y[k] = sum_{j<=k} h[k-j] u[j] + z1 * f1[k] + z2 * f2[k]
+// where h is the impulse response and f1/f2 the free responses to a unit z1/z2. The
+// state after the block is A^K (z1, z2) plus a term of the input alone, so the only
+// dependency between blocks is one 2x2 multiply.
+typedef struct iir_block_stage {
+    vv_dsp_real T[IIR_K * IIR_K];  // column j (= input j) at [j*K .. j*K + K): h[k - j]
+    vv_dsp_real f1[IIR_K];
+    vv_dsp_real f2[IIR_K];
+    vv_dsp_real m11, m12, m21, m22; // A^K
+} iir_block_stage;
+
+struct vv_dsp_iir_plan {
+    vv_dsp_iir_realization realization;
+    vv_dsp_denormal_mode denormals;
+    size_t stages;
+    vv_dsp_biquad* bq;         // coefficients and state of every section
+    iir_block_stage* blk;      // BLOCK only
+};
+
+// Run the DF2T recursion of bq in double from state (z1, z2) over K samples of u
+static void section_response(const vv_dsp_biquad* bq, double z1, double z2,
+                             const double* u, vv_dsp_real* y) {
+    for (size_t k = 0; k < IIR_K; ++k) {
+        const double o = (double)bq->b0 * u[k] + z1;
+        z1 = (double)bq->b1 * u[k] - (double)bq->a1 * o + z2;
+        z2 = (double)bq->b2 * u[k] - (double)bq->a2 * o;
+        y[k] = (vv_dsp_real)o;
+    }
+}
+
+static void block_stage_init(iir_block_stage* s, const vv_dsp_biquad* bq) {
+    double u[IIR_K] = {0};
+    vv_dsp_real h[IIR_K];
+    u[0] = 1.0;
+    section_response(bq, 0.0, 0.0, u, h);
+    u[0] = 0.0;
+    section_response(bq, 1.0, 0.0, u, s->f1);
+    section_response(bq, 0.0, 1.0, u, s->f2);
+    for (size_t j = 0; j < IIR_K; ++j) {
+        for (size_t k = 0; k < IIR_K; ++k) s->T[j * IIR_K + k] = (k >= j) ? h[k - j] : (vv_dsp_real)0;
+    }
+    // Free response of the states, read off the last two free outputs (see block_section)
+    const double a1 = (double)bq->a1, a2 = (double)bq->a2;
+    s->m11 = (vv_dsp_real)(-a1 * (double)s->f1[IIR_K - 1] - a2 * (double)s->f1[IIR_K - 2]);
+    s->m12 = (vv_dsp_real)(-a1 * (double)s->f2[IIR_K - 1] - a2 * (double)s->f2[IIR_K - 2]);
+    s->m21 = (vv_dsp_real)(-a2 * (double)s->f1[IIR_K - 1]);
+    s->m22 = (vv_dsp_real)(-a2 * (double)s->f2[IIR_K - 1]);
+}
+
+void vv_dsp_iir_plan_destroy(vv_dsp_iir_plan* p) {
+    if (!p) return;
+    vv_dsp_free(p->bq);
+    vv_dsp_free(p->blk);
+    vv_dsp_free(p);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_make_plan(const vv_dsp_biquad* biquads,
+                                                    size_t num_stages,
+                                                    vv_dsp_iir_realization realization,
+                                                    vv_dsp_iir_plan** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!biquads) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_stages == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (realization != VV_DSP_IIR_REALIZATION_CASCADE && realization != VV_DSP_IIR_REALIZATION_BLOCK) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    vv_dsp_iir_plan* p = (vv_dsp_iir_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->realization = realization;
+    p->stages = num_stages;
+    p->bq = (vv_dsp_biquad*)vv_dsp_malloc(num_stages * sizeof(vv_dsp_biquad));
+    if (!p->bq) {
+        vv_dsp_iir_plan_destroy(p);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    memcpy(p->bq, biquads, num_stages * sizeof(vv_dsp_biquad));
+    if (realization == VV_DSP_IIR_REALIZATION_BLOCK) {
+        p->blk = (iir_block_stage*)vv_dsp_malloc(num_stages * sizeof(iir_block_stage));
+        if (!p->blk) {
+            vv_dsp_iir_plan_destroy(p);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        for (size_t s = 0; s < num_stages; ++s) block_stage_init(&p->blk[s], &p->bq[s]);
+    }
+    *out = p;
+    return VV_DSP_OK;
+}
+
+// One section over n samples in blocks of K. The DF2T states after a block follow
+// from its last two inputs u1 = u[K-1], u2 = u[K-2] and outputs:
+//   z2' = b2 u1 - a2 y[K-1]
+//   z1' = b1 u1 - a1 y[K-1] + b2 u2 - a2 y[K-2]
+// Splitting y into the zero-state part yz (input only) and the free part gives
+// z' = A^K z + c, with c computed from u and yz alone.
+static void block_section(const iir_block_stage* s, vv_dsp_biquad* bq,
+                          const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    vv_dsp_real z1 = bq->z1, z2 = bq->z2;
+    const vv_dsp_real b1 = bq->b1, b2 = bq->b2, a1 = bq->a1, a2 = bq->a2;
+    vv_dsp_real yz[IIR_K];
+    size_t i = 0;
+    for (; i + IIR_K <= n; i += IIR_K) {
+        const vv_dsp_real* u = x + i;
+        const vv_dsp_real u1 = u[IIR_K - 1], u2 = u[IIR_K - 2];  // before an in-place store
+#if defined(VF_W)
+        // Two accumulators keep the input product off a single dependency chain
+        vf_vec e = VF_MUL(VF_SET1(u[0]), VF_LOAD(s->T));
+        vf_vec o = VF_MUL(VF_SET1(u[1]), VF_LOAD(s->T + IIR_K));
+        for (size_t j = 2; j < IIR_K; j += 2) {
+            e = VF_MAC(e, VF_SET1(u[j]), VF_LOAD(s->T + j * IIR_K));
+            o = VF_MAC(o, VF_SET1(u[j + 1]), VF_LOAD(s->T + (j + 1) * IIR_K));
+        }
+        const vf_vec zs = VF_ADD(e, o);
+        VF_STORE(yz, zs);
+        VF_STORE(y + i, VF_MAC(VF_MAC(zs, VF_SET1(z1), VF_LOAD(s->f1)), VF_SET1(z2), VF_LOAD(s->f2)));
+#else
+        for (size_t k = 0; k < IIR_K; ++k) yz[k] = 0;
+        for (size_t j = 0; j < IIR_K; ++j) {
+            const vv_dsp_real uj = u[j];
+            for (size_t k = j; k < IIR_K; ++k) yz[k] += uj * s->T[j * IIR_K + k];
+        }
+        for (size_t k = 0; k < IIR_K; ++k) y[i + k] = yz[k] + z1 * s->f1[k] + z2 * s->f2[k];
+#endif
+        const vv_dsp_real y1 = yz[IIR_K - 1], y2 = yz[IIR_K - 2];
+        const vv_dsp_real c2 = b2 * u1 - a2 * y1;
+        const vv_dsp_real c1 = b1 * u1 - a1 * y1 + b2 * u2 - a2 * y2;
+        const vv_dsp_real n1 = s->m11 * z1 + s->m12 * z2 + c1;
+        z2 = s->m21 * z1 + s->m22 * z2 + c2;
+        z1 = n1;
+    }
+    bq->z1 = z1;
+    bq->z2 = z2;
+    for (; i < n; ++i) y[i] = vv_dsp_biquad_process(bq, x[i]);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_iir_plan_apply(vv_dsp_iir_plan* p,
+                                                     const vv_dsp_real* x,
+                                                     vv_dsp_real* y,
+                                                     size_t n) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, p->denormals);
+    if (p->realization == VV_DSP_IIR_REALIZATION_CASCADE) {
+        const vv_dsp_status st = vv_dsp_iir_apply(p->bq, p->stages, x, y, n);
+        vv_dsp_fp_scope_exit(&fp);
+        return st;
+    }
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_IIR_APPLY);
+    const int rt = VV_DSP_RT_ENTER(1);
+    for (size_t s = 0; s < p->stages; ++s) block_section(&p->blk[s], &p->bq[s], (s == 0) ? x : y, y, n);
+    VV_DSP_RT_LEAVE(rt);
+    VV_DSP_PROFILE_END(prof, n);
+    vv_dsp_fp_scope_exit(&fp);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_iir_plan_set_denormals(vv_dsp_iir_plan* p, vv_dsp_denormal_mode mode) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    if (mode != VV_DSP_DENORMALS_KEEP && mode != VV_DSP_DENORMALS_FLUSH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    p->denormals = mode;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_iir_plan_reset(vv_dsp_iir_plan* p) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t s = 0; s < p->stages; ++s) vv_dsp_biquad_reset(&p->bq[s]);
+    return VV_DSP_OK;
+}
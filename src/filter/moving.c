@@ -0,0 +1,280 @@
+#include "vv_dsp/filter/moving.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct vv_dsp_moving {
+    vv_dsp_moving_kind kind;
+    size_t window;
+    size_t channels;
+    size_t idx;              // next ring slot (shared by all channels)
+    size_t count;            // values in the window, <= window
+    vv_dsp_real* ring;       // channels x window past values (squares for RMS)
+    double* sum;             // MEAN / RMS: running sum per channel
+    size_t* dq;              // MIN / MAX: channels x window ring slots, values monotonic
+    size_t* dq_head;
+    size_t* dq_len;
+    int32_t* pos;            // MEDIAN: channels x window heap position of each ring slot
+    int32_t* heap;           // MEDIAN: channels x window ring slots; max heap < 0 <= min heap
+};
+
+void vv_dsp_moving_destroy(vv_dsp_moving* m) {
+    if (!m) return;
+    vv_dsp_free(m->ring);
+    vv_dsp_free(m->sum);
+    vv_dsp_free(m->dq);
+    vv_dsp_free(m->dq_head);
+    vv_dsp_free(m->dq_len);
+    vv_dsp_free(m->pos);
+    vv_dsp_free(m->heap);
+    vv_dsp_free(m);
+}
+
+// Initial heap layout slot 0 -> median, 1 -> max heap, 2 -> min heap, ...: the k-th
+// value to arrive lands where a partial window needs it
+static void median_layout(int32_t* pos, int32_t* heap, size_t W) {
+    int32_t* h = heap + W / 2;
+    for (size_t i = 0; i < W; ++i) {
+        const int32_t p = (int32_t)((i + 1) / 2) * ((i & 1) ? -1 : 1);
+        pos[i] = p;
+        h[p] = (int32_t)i;
+    }
+}
+
+vv_dsp_status vv_dsp_moving_reset(vv_dsp_moving* m) {
+    if (!m) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t W = m->window, C = m->channels;
+    m->idx = 0;
+    m->count = 0;
+    memset(m->ring, 0, C * W * sizeof(vv_dsp_real));
+    if (m->sum) memset(m->sum, 0, C * sizeof(double));
+    if (m->dq_len) memset(m->dq_len, 0, C * sizeof(size_t));
+    if (m->dq_head) memset(m->dq_head, 0, C * sizeof(size_t));
+    if (m->pos) {
+        for (size_t c = 0; c < C; ++c) median_layout(m->pos + c * W, m->heap + c * W, W);
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_moving_create(vv_dsp_moving_kind kind,
+                                                    size_t W,
+                                                    size_t C,
+                                                    vv_dsp_moving** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (W == 0 || C == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (kind < VV_DSP_MOVING_MEAN || kind > VV_DSP_MOVING_MEDIAN) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (kind == VV_DSP_MOVING_MEDIAN && W > (size_t)INT32_MAX) return VV_DSP_ERROR_INVALID_SIZE;
+    if (C > SIZE_MAX / W / sizeof(double)) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_moving* m = (vv_dsp_moving*)vv_dsp_calloc(1, sizeof(*m));
+    if (!m) return VV_DSP_ERROR_INTERNAL;
+    m->kind = kind;
+    m->window = W;
+    m->channels = C;
+    m->ring = (vv_dsp_real*)vv_dsp_malloc(C * W * sizeof(vv_dsp_real));
+    int ok = m->ring != NULL;
+    switch (kind) {
+        case VV_DSP_MOVING_MEAN:
+        case VV_DSP_MOVING_RMS:
+            m->sum = (double*)vv_dsp_malloc(C * sizeof(double));
+            ok = ok && m->sum;
+            break;
+        case VV_DSP_MOVING_MIN:
+        case VV_DSP_MOVING_MAX:
+            m->dq = (size_t*)vv_dsp_malloc(C * W * sizeof(size_t));
+            m->dq_head = (size_t*)vv_dsp_malloc(C * sizeof(size_t));
+            m->dq_len = (size_t*)vv_dsp_malloc(C * sizeof(size_t));
+            ok = ok && m->dq && m->dq_head && m->dq_len;
+            break;
+        case VV_DSP_MOVING_MEDIAN:
+            m->pos = (int32_t*)vv_dsp_malloc(C * W * sizeof(int32_t));
+            m->heap = (int32_t*)vv_dsp_malloc(C * W * sizeof(int32_t));
+            ok = ok && m->pos && m->heap;
+            break;
+    }
+    if (!ok) {
+        vv_dsp_moving_destroy(m);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    (void)vv_dsp_moving_reset(m);
+    *out = m;
+    return VV_DSP_OK;
+}
+
+// ---- mean / RMS -------------------------------------------------------------
+
+static void run_sum(const vv_dsp_moving* m, size_t c, const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    const size_t W = m->window, C = m->channels;
+    const int rms = m->kind == VV_DSP_MOVING_RMS;
+    vv_dsp_real* ring = m->ring + c * W;
+    double s = m->sum[c];
+    size_t slot = m->idx, cnt = m->count;
+    for (size_t t = 0; t < n; ++t) {
+        const vv_dsp_real v = x[t * C];
+        const vv_dsp_real d = rms ? v * v : v;
+        s += (double)d - (double)ring[slot];
+        ring[slot] = d;
+        if (++slot == W) {
+            // Re-sum once per window so rounding in the running update cannot accumulate
+            slot = 0;
+            s = 0.0;
+            for (size_t j = 0; j < W; ++j) s += (double)ring[j];
+        }
+        if (cnt < W) ++cnt;
+        const double mean = s / (double)cnt;
+        y[t * C] = rms ? (vv_dsp_real)sqrt(mean > 0.0 ? mean : 0.0) : (vv_dsp_real)mean;
+    }
+    m->sum[c] = s;
+}
+
+// ---- min / max ----------------------------------------------------------------
+
+static void run_extremum(const vv_dsp_moving* m, size_t c, const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    const size_t W = m->window, C = m->channels;
+    const int want_max = m->kind == VV_DSP_MOVING_MAX;
+    vv_dsp_real* ring = m->ring + c * W;
+    size_t* dq = m->dq + c * W;
+    size_t head = m->dq_head[c], len = m->dq_len[c];
+    size_t slot = m->idx, cnt = m->count;
+    for (size_t t = 0; t < n; ++t) {
+        const vv_dsp_real v = x[t * C];
+        // The value leaving the window is the oldest one, so it can only be at the front
+        if (cnt == W && len && dq[head] == slot) {
+            if (++head == W) head = 0;
+            --len;
+        }
+        ring[slot] = v;
+        while (len) {
+            size_t back = head + len - 1;
+            if (back >= W) back -= W;
+            const vv_dsp_real b = ring[dq[back]];
+            if (want_max ? (b > v) : (b < v)) break;
+            --len;
+        }
+        size_t tail = head + len;
+        if (tail >= W) tail -= W;
+        dq[tail] = slot;
+        ++len;
+        y[t * C] = ring[dq[head]];
+        if (++slot == W) slot = 0;
+        if (cnt < W) ++cnt;
+    }
+    m->dq_head[c] = head;
+    m->dq_len[c] = len;
+}
+
+// ---- median -------------------------------------------------------------------
+// One array holds a max heap of the lower half at negative indices, the median at 0
+// and a min heap of the upper half at positive indices (children of i at 2i, 2i +- 1);
+// pos[] maps every ring slot to its heap index so the outgoing value is replaced in
+// place and sifted either way.
+
+typedef struct {
+    const vv_dsp_real* d;
+    int32_t* pos;
+    int32_t* h;              // centred: valid from -max_ct to min_ct
+    int32_t ct;
+} med_heap;
+
+#define MED_MIN_CT(m) (((m)->ct - 1) / 2)
+#define MED_MAX_CT(m) ((m)->ct / 2)
+
+static int med_less(const med_heap* m, int32_t i, int32_t j) {
+    return m->d[m->h[i]] < m->d[m->h[j]];
+}
+
+// Swap heap entries i and j when entry i is smaller; returns whether they were swapped
+static int med_cmp_exch(med_heap* m, int32_t i, int32_t j) {
+    if (!med_less(m, i, j)) return 0;
+    const int32_t t = m->h[i];
+    m->h[i] = m->h[j];
+    m->h[j] = t;
+    m->pos[m->h[i]] = i;
+    m->pos[m->h[j]] = j;
+    return 1;
+}
+
+// Sift entry i (and what it displaces) away from the median; i = 1 / -1 first restores
+// the order between the median and the top of that heap
+static void med_min_down(med_heap* m, int32_t i) {
+    for (; i <= MED_MIN_CT(m); i *= 2) {
+        if (i > 1 && i < MED_MIN_CT(m) && med_less(m, i + 1, i)) ++i;
+        if (!med_cmp_exch(m, i, i / 2)) break;
+    }
+}
+
+static void med_max_down(med_heap* m, int32_t i) {
+    for (; i >= -MED_MAX_CT(m); i *= 2) {
+        if (i < -1 && i > -MED_MAX_CT(m) && med_less(m, i, i - 1)) --i;
+        if (!med_cmp_exch(m, i / 2, i)) break;
+    }
+}
+
+// Sift up towards the median; returns whether the entry reached index 0
+static int med_min_up(med_heap* m, int32_t i) {
+    while (i > 0 && med_cmp_exch(m, i, i / 2)) i /= 2;
+    return i == 0;
+}
+
+static int med_max_up(med_heap* m, int32_t i) {
+    while (i < 0 && med_cmp_exch(m, i / 2, i)) i /= 2;
+    return i == 0;
+}
+
+static void run_median(const vv_dsp_moving* m, size_t c, const vv_dsp_real* x, vv_dsp_real* y, size_t n) {
+    const size_t W = m->window, C = m->channels;
+    vv_dsp_real* ring = m->ring + c * W;
+    med_heap mh;
+    mh.d = ring;
+    mh.pos = m->pos + c * W;
+    mh.h = m->heap + c * W + W / 2;
+    mh.ct = (int32_t)m->count;
+    size_t slot = m->idx;
+    for (size_t t = 0; t < n; ++t) {
+        const vv_dsp_real v = x[t * C];
+        const int is_new = (size_t)mh.ct < W;
+        const int32_t p = mh.pos[slot];
+        const vv_dsp_real old = ring[slot];
+        ring[slot] = v;
+        if (is_new) ++mh.ct;
+        if (p > 0) {
+            if (!is_new && old < v) med_min_down(&mh, p * 2);
+            else if (med_min_up(&mh, p)) med_max_down(&mh, -1);
+        } else if (p < 0) {
+            if (!is_new && v < old) med_max_down(&mh, p * 2);
+            else if (med_max_up(&mh, p)) med_min_down(&mh, 1);
+        } else {
+            if (MED_MAX_CT(&mh)) med_max_down(&mh, -1);
+            if (MED_MIN_CT(&mh)) med_min_down(&mh, 1);
+        }
+        vv_dsp_real med = ring[mh.h[0]];
+        if ((mh.ct & 1) == 0) med = (vv_dsp_real)(0.5 * ((double)med + (double)ring[mh.h[-1]]));
+        y[t * C] = med;
+        if (++slot == W) slot = 0;
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_moving_process(vv_dsp_moving* m,
+                                                     const vv_dsp_real* x,
+                                                     vv_dsp_real* y,
+                                                     size_t n) {
+    if (!m) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    // Channel by channel over the strided frames keeps one channel's state hot; every
+    // sample is read before its output is written, so in-place is safe
+    for (size_t c = 0; c < m->channels; ++c) {
+        switch (m->kind) {
+            case VV_DSP_MOVING_MEAN:
+            case VV_DSP_MOVING_RMS: run_sum(m, c, x + c, y + c, n); break;
+            case VV_DSP_MOVING_MIN:
+            case VV_DSP_MOVING_MAX: run_extremum(m, c, x + c, y + c, n); break;
+            case VV_DSP_MOVING_MEDIAN: run_median(m, c, x + c, y + c, n); break;
+        }
+    }
+    m->idx = (size_t)(((uint64_t)m->idx + n) % m->window);
+    m->count = (n >= m->window - m->count) ? m->window : m->count + n;
+    return VV_DSP_OK;
+}
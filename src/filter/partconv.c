@@ -0,0 +1,405 @@
+#include "vv_dsp/filter/convolver.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef CRITICAL_SECTION pc_mutex;
+typedef CONDITION_VARIABLE pc_cond;
+typedef HANDLE pc_thread;
+#define PC_LOCK(m)        EnterCriticalSection(m)
+#define PC_UNLOCK(m)      LeaveCriticalSection(m)
+#define PC_WAIT(c, m)     SleepConditionVariableCS((c), (m), INFINITE)
+#define PC_BROADCAST(c)   WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t pc_mutex;
+typedef pthread_cond_t pc_cond;
+typedef pthread_t pc_thread;
+#define PC_LOCK(m)        pthread_mutex_lock(m)
+#define PC_UNLOCK(m)      pthread_mutex_unlock(m)
+#define PC_WAIT(c, m)     pthread_cond_wait((c), (m))
+#define PC_BROADCAST(c)   pthread_cond_broadcast(c)
+#endif
+
+// Stage k partitions are block_size * PC_GROWTH^k samples
+#define PC_GROWTH 4
+
+typedef enum { PC_IDLE = 0, PC_QUEUED, PC_RUNNING, PC_DONE } pc_job_state;
+
+typedef struct pc_stage {
+    size_t B;                // partition size = new samples per block
+    size_t nc;               // B + 1 bins of the 2B-point FFT
+    size_t P;                // partitions in this stage
+    size_t off;              // first tap covered by the stage
+    int async;               // computed on the worker thread
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2r;
+    vv_dsp_cpx* H;           // P partition spectra
+    vv_dsp_cpx* fdl;         // frequency-domain delay line, P input spectra (ring)
+    size_t head;             // fdl slot of the newest spectrum
+    vv_dsp_cpx* acc;
+    vv_dsp_cpx* tmp;
+    vv_dsp_real* inbuf;      // 2B: previous block | current block
+    vv_dsp_real* time;       // 2B inverse transform
+    vv_dsp_real* fill;       // B samples being gathered by the caller
+    size_t fill_n;
+    size_t next_block;       // index of the block being gathered
+    size_t job_block;        // index of the block last handed to compute
+    pc_job_state state;      // async stages only, guarded by the engine mutex
+} pc_stage;
+
+struct vv_dsp_partconv {
+    size_t B;
+    size_t num_stages;
+    pc_stage* st;
+    vv_dsp_real* ring;       // pending output, indexed by output time - B
+    size_t mask;
+    size_t t;                // samples processed
+    int has_worker;
+    int quit;
+    pc_mutex mu;
+    pc_cond work;            // worker: a stage was queued or quit was set
+    pc_cond done;            // caller: a stage finished
+    pc_thread thread;
+};
+
+static size_t ceil_div(size_t a, size_t b) { return (a + b - 1) / b; }
+
+// Transform the staged block into the delay line and sum all partitions; leaves the
+// B valid outputs in time[B .. 2B)
+static vv_dsp_status stage_compute(pc_stage* s) {
+    const size_t nc = s->nc;
+    vv_dsp_cpx* X = s->fdl + s->head * nc;
+    vv_dsp_status st = vv_dsp_fft_execute(s->r2c, s->inbuf, X);
+    if (st != VV_DSP_OK) return st;
+    memcpy(s->inbuf, s->inbuf + s->B, s->B * sizeof(vv_dsp_real));
+    size_t slot = s->head;
+    for (size_t p = 0; p < s->P; ++p) {
+        vv_dsp_cpx* dst = p ? s->tmp : s->acc;
+        const vv_dsp_cpx* a = s->fdl + slot * nc;
+        const vv_dsp_cpx* b = s->H + p * nc;
+        if (vv_dsp_vectorized_complex_multiply(a, b, dst, nc) != VV_DSP_OK) {
+            for (size_t k = 0; k < nc; ++k) {
+                dst[k].re = a[k].re * b[k].re - a[k].im * b[k].im;
+                dst[k].im = a[k].re * b[k].im + a[k].im * b[k].re;
+            }
+        }
+        if (p) {
+            for (size_t k = 0; k < nc; ++k) {
+                s->acc[k].re += dst[k].re;
+                s->acc[k].im += dst[k].im;
+            }
+        }
+        slot = slot ? slot - 1 : s->P - 1;
+    }
+    if (++s->head == s->P) s->head = 0;
+    // Backend inverse already scales by 1/(2B)
+    return vv_dsp_fft_execute(s->c2r, s->acc, s->time);
+}
+
+// Block j of a stage yields (h_stage * x)[j*B + i], i.e. output y[j*B + off + i]
+static void stage_emit(vv_dsp_partconv* c, const pc_stage* s) {
+    const size_t base = s->job_block * s->B + s->off;
+    const vv_dsp_real* r = s->time + s->B;
+    for (size_t i = 0; i < s->B; ++i) c->ring[(base + i) & c->mask] += r[i];
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI pc_worker(LPVOID arg)
+#else
+static void* pc_worker(void* arg)
+#endif
+{
+    vv_dsp_partconv* c = (vv_dsp_partconv*)arg;
+    PC_LOCK(&c->mu);
+    for (;;) {
+        // Smallest queued stage first: it has the nearest deadline
+        pc_stage* s = NULL;
+        for (size_t k = 1; k < c->num_stages && !s; ++k) {
+            if (c->st[k].state == PC_QUEUED) s = &c->st[k];
+        }
+        if (!s) {
+            if (c->quit) break;
+            PC_WAIT(&c->work, &c->mu);
+            continue;
+        }
+        s->state = PC_RUNNING;
+        PC_UNLOCK(&c->mu);
+        (void)stage_compute(s);
+        PC_LOCK(&c->mu);
+        s->state = PC_DONE;
+        PC_BROADCAST(&c->done);
+    }
+    PC_UNLOCK(&c->mu);
+#if defined(_WIN32)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+// Caller side of an async stage: collect the previous block, if any (mutex held)
+static void stage_join(vv_dsp_partconv* c, pc_stage* s) {
+    if (s->state == PC_IDLE) return;
+    while (s->state != PC_DONE) PC_WAIT(&c->done, &c->mu);
+    stage_emit(c, s);
+    s->state = PC_IDLE;
+}
+
+static vv_dsp_status stage_boundary(vv_dsp_partconv* c, pc_stage* s) {
+    s->fill_n = 0;
+    if (!s->async) {
+        memcpy(s->inbuf + s->B, s->fill, s->B * sizeof(vv_dsp_real));
+        s->job_block = s->next_block++;
+        const vv_dsp_status st = stage_compute(s);
+        if (st != VV_DSP_OK) return st;
+        stage_emit(c, s);
+        return VV_DSP_OK;
+    }
+    PC_LOCK(&c->mu);
+    stage_join(c, s);
+    memcpy(s->inbuf + s->B, s->fill, s->B * sizeof(vv_dsp_real));
+    s->job_block = s->next_block++;
+    s->state = PC_QUEUED;
+    PC_BROADCAST(&c->work);
+    PC_UNLOCK(&c->mu);
+    return VV_DSP_OK;
+}
+
+static void stage_free(pc_stage* s) {
+    if (s->r2c) (void)vv_dsp_fft_plan_release(s->r2c);
+    if (s->c2r) (void)vv_dsp_fft_plan_release(s->c2r);
+    vv_dsp_free(s->H); vv_dsp_free(s->fdl); vv_dsp_free(s->acc); vv_dsp_free(s->tmp);
+    vv_dsp_free(s->inbuf); vv_dsp_free(s->time); vv_dsp_free(s->fill);
+}
+
+static vv_dsp_status stage_init(pc_stage* s, const vv_dsp_real* h, size_t L) {
+    const size_t B = s->B, nc = s->nc, n = 2 * B;
+    s->H = (vv_dsp_cpx*)vv_dsp_malloc(s->P * nc * sizeof(vv_dsp_cpx));
+    s->fdl = (vv_dsp_cpx*)vv_dsp_calloc(s->P * nc, sizeof(vv_dsp_cpx));
+    s->acc = (vv_dsp_cpx*)vv_dsp_malloc(nc * sizeof(vv_dsp_cpx));
+    s->tmp = (vv_dsp_cpx*)vv_dsp_malloc(nc * sizeof(vv_dsp_cpx));
+    s->inbuf = (vv_dsp_real*)vv_dsp_calloc(n, sizeof(vv_dsp_real));
+    s->time = (vv_dsp_real*)vv_dsp_calloc(n, sizeof(vv_dsp_real));
+    s->fill = (vv_dsp_real*)vv_dsp_calloc(B, sizeof(vv_dsp_real));
+    if (!s->H || !s->fdl || !s->acc || !s->tmp || !s->inbuf || !s->time || !s->fill) return VV_DSP_ERROR_INTERNAL;
+    if (vv_dsp_fft_plan_acquire(n, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &s->r2c) != VV_DSP_OK ||
+        vv_dsp_fft_plan_acquire(n, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &s->c2r) != VV_DSP_OK) {
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    // Partition p holds taps [off + p*B, off + (p+1)*B), zero-padded to 2B
+    for (size_t p = 0; p < s->P; ++p) {
+        const size_t first = s->off + p * B;
+        const size_t cnt = (first < L) ? ((L - first < B) ? L - first : B) : 0;
+        memset(s->time, 0, n * sizeof(vv_dsp_real));
+        if (cnt) memcpy(s->time, h + first, cnt * sizeof(vv_dsp_real));
+        const vv_dsp_status st = vv_dsp_fft_execute(s->r2c, s->time, s->H + p * nc);
+        if (st != VV_DSP_OK) return st;
+    }
+    memset(s->time, 0, n * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+// Fill st[] (may be NULL to count only) and return the number of stages
+static size_t build_schedule(size_t L, size_t B, size_t max_part, pc_stage* st) {
+    size_t count = 0, off = 0, Bs = B;
+    for (;;) {
+        const size_t Bn = Bs * PC_GROWTH;
+        // The next stage must start at 2*Bn - B to have a full period of slack
+        const size_t end = 2 * Bn - B;
+        const int last = (Bn > max_part) || (L <= end);
+        const size_t P = last ? ceil_div(L - off, Bs) : (end - off) / Bs;
+        if (st) {
+            pc_stage* s = &st[count];
+            memset(s, 0, sizeof(*s));
+            s->B = Bs;
+            s->nc = Bs + 1;
+            s->P = P;
+            s->off = off;
+        }
+        ++count;
+        if (last) break;
+        off = end;
+        Bs = Bn;
+    }
+    return count;
+}
+
+void vv_dsp_partconv_destroy(vv_dsp_partconv* c) {
+    if (!c) return;
+    if (c->has_worker) {
+        PC_LOCK(&c->mu);
+        c->quit = 1;
+        PC_BROADCAST(&c->work);
+        PC_UNLOCK(&c->mu);
+#if defined(_WIN32)
+        WaitForSingleObject(c->thread, INFINITE);
+        CloseHandle(c->thread);
+        DeleteCriticalSection(&c->mu);
+#else
+        pthread_join(c->thread, NULL);
+        pthread_cond_destroy(&c->work);
+        pthread_cond_destroy(&c->done);
+        pthread_mutex_destroy(&c->mu);
+#endif
+    }
+    if (c->st) {
+        for (size_t k = 0; k < c->num_stages; ++k) stage_free(&c->st[k]);
+    }
+    vv_dsp_free(c->st);
+    vv_dsp_free(c->ring);
+    vv_dsp_free(c);
+}
+
+static vv_dsp_status start_worker(vv_dsp_partconv* c) {
+#if defined(_WIN32)
+    InitializeCriticalSection(&c->mu);
+    InitializeConditionVariable(&c->work);
+    InitializeConditionVariable(&c->done);
+    c->thread = CreateThread(NULL, 0, pc_worker, c, 0, NULL);
+    if (!c->thread) {
+        DeleteCriticalSection(&c->mu);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+#else
+    if (pthread_mutex_init(&c->mu, NULL) != 0) return VV_DSP_ERROR_INTERNAL;
+    if (pthread_cond_init(&c->work, NULL) != 0) {
+        pthread_mutex_destroy(&c->mu);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    if (pthread_cond_init(&c->done, NULL) != 0) {
+        pthread_cond_destroy(&c->work);
+        pthread_mutex_destroy(&c->mu);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    if (pthread_create(&c->thread, NULL, pc_worker, c) != 0) {
+        pthread_cond_destroy(&c->done);
+        pthread_cond_destroy(&c->work);
+        pthread_mutex_destroy(&c->mu);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+#endif
+    c->has_worker = 1;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_partconv_create(const vv_dsp_real* h,
+                                                      size_t L,
+                                                      const vv_dsp_partconv_params* prm,
+                                                      vv_dsp_partconv** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h || !prm) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t B = prm->block_size;
+    if (L == 0 || B == 0 || (B & (B - 1)) != 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_partconv* c = (vv_dsp_partconv*)vv_dsp_calloc(1, sizeof(*c));
+    if (!c) return VV_DSP_ERROR_INTERNAL;
+    c->B = B;
+    c->num_stages = build_schedule(L, B, prm->max_partition, NULL);
+    c->st = (pc_stage*)vv_dsp_calloc(c->num_stages, sizeof(pc_stage));
+    if (!c->st) {
+        vv_dsp_free(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    (void)build_schedule(L, B, prm->max_partition, c->st);
+
+    // Pending output reaches at most off + 2*B_k beyond the read position
+    const pc_stage* last = &c->st[c->num_stages - 1];
+    const size_t span = last->off + 2 * last->B + 2 * B;
+    size_t R = 1;
+    while (R < span) R <<= 1;
+    c->mask = R - 1;
+    c->ring = (vv_dsp_real*)vv_dsp_calloc(R, sizeof(vv_dsp_real));
+    if (!c->ring) {
+        vv_dsp_partconv_destroy(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t k = 0; k < c->num_stages; ++k) {
+        pc_stage* s = &c->st[k];
+        s->async = prm->background && k > 0;
+        const vv_dsp_status st = stage_init(s, h, L);
+        if (st != VV_DSP_OK) {
+            vv_dsp_partconv_destroy(c);
+            return st;
+        }
+    }
+    if (c->num_stages > 1 && prm->background && start_worker(c) != VV_DSP_OK) {
+        vv_dsp_partconv_destroy(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = c;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_partconv_process(vv_dsp_partconv* c,
+                                                       const vv_dsp_real* x,
+                                                       vv_dsp_real* y,
+                                                       size_t n) {
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t B = c->B;
+    for (size_t pos = 0; pos < n; ) {
+        // Every stage block is a multiple of B, so no chunk crosses a stage boundary
+        const size_t m = (n - pos < B - c->st[0].fill_n) ? n - pos : B - c->st[0].fill_n;
+        for (size_t k = 0; k < c->num_stages; ++k) {
+            pc_stage* s = &c->st[k];
+            memcpy(s->fill + s->fill_n, x + pos, m * sizeof(vv_dsp_real));
+            s->fill_n += m;
+        }
+        // Input is staged, so the output may overwrite it
+        const size_t rd = c->t - B;  // wraps below zero; the ring starts out zero
+        for (size_t i = 0; i < m; ++i) {
+            vv_dsp_real* slot = &c->ring[(rd + i) & c->mask];
+            y[pos + i] = *slot;
+            *slot = 0;
+        }
+        c->t += m;
+        pos += m;
+        for (size_t k = 0; k < c->num_stages; ++k) {
+            pc_stage* s = &c->st[k];
+            if (s->fill_n < s->B) break;  // larger stages end on a subset of stage 0 boundaries
+            const vv_dsp_status st = stage_boundary(c, s);
+            if (st != VV_DSP_OK) return st;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_partconv_latency(const vv_dsp_partconv* c) {
+    return c ? c->B : 0;
+}
+
+size_t vv_dsp_partconv_num_stages(const vv_dsp_partconv* c) {
+    return c ? c->num_stages : 0;
+}
+
+vv_dsp_status vv_dsp_partconv_reset(vv_dsp_partconv* c) {
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    if (c->has_worker) {
+        PC_LOCK(&c->mu);
+        for (size_t k = 1; k < c->num_stages; ++k) {
+            pc_stage* s = &c->st[k];
+            while (s->state == PC_QUEUED || s->state == PC_RUNNING) PC_WAIT(&c->done, &c->mu);
+            s->state = PC_IDLE;
+        }
+        PC_UNLOCK(&c->mu);
+    }
+    for (size_t k = 0; k < c->num_stages; ++k) {
+        pc_stage* s = &c->st[k];
+        memset(s->fdl, 0, s->P * s->nc * sizeof(vv_dsp_cpx));
+        memset(s->inbuf, 0, 2 * s->B * sizeof(vv_dsp_real));
+        s->head = 0;
+        s->fill_n = 0;
+        s->next_block = 0;
+        s->job_block = 0;
+    }
+    memset(c->ring, 0, (c->mask + 1) * sizeof(vv_dsp_real));
+    c->t = 0;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,200 @@
+#include "vv_dsp/filter/polyphase.h"
+#include "vv_dsp/core/alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include "fir_kernel.h"
+
+// Outputs per kernel pass; large enough to keep the multi-output kernels busy
+#define PP_MIN_STAGE 256
+
+struct vv_dsp_fir_decimator {
+    size_t factor;
+    size_t taps;             // taps per branch, ceil(num_taps / factor)
+    size_t hist;             // taps - 1
+    size_t stage;            // complete output slots per kernel pass
+    size_t stride;           // branch buffer length: hist + stage + 1 partial slot
+    vv_dsp_real* gr;         // factor branches of reversed taps
+    vv_dsp_real* buf;        // factor branch buffers of stride samples
+    size_t slot;             // complete slots staged
+    size_t fill;             // samples of the partial slot (branches M-1, M-2, ...)
+};
+
+struct vv_dsp_fir_interpolator {
+    size_t factor;
+    size_t taps;
+    size_t hist;
+    size_t stage;
+    vv_dsp_real* gr;         // factor branches of reversed taps
+    vv_dsp_real* lin;        // hist + stage
+    vv_dsp_real* tmp;        // stage branch outputs
+};
+
+// gr[p * taps + j] = h[(taps - 1 - j) * factor + p], zero past the end
+static vv_dsp_real* split_branches(const vv_dsp_real* h, size_t L, size_t M, size_t taps) {
+    vv_dsp_real* gr = (vv_dsp_real*)vv_dsp_calloc(M * taps, sizeof(vv_dsp_real));
+    if (!gr) return NULL;
+    for (size_t p = 0; p < M; ++p) {
+        for (size_t q = 0; q < taps; ++q) {
+            const size_t k = q * M + p;
+            if (k < L) gr[p * taps + (taps - 1 - q)] = h[k];
+        }
+    }
+    return gr;
+}
+
+void vv_dsp_fir_decimator_destroy(vv_dsp_fir_decimator* d) {
+    if (!d) return;
+    vv_dsp_free(d->gr);
+    vv_dsp_free(d->buf);
+    vv_dsp_free(d);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_decimator_create(const vv_dsp_real* h,
+                                                           size_t L,
+                                                           size_t M,
+                                                           vv_dsp_fir_decimator** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L == 0 || M == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fir_decimator* d = (vv_dsp_fir_decimator*)vv_dsp_calloc(1, sizeof(*d));
+    if (!d) return VV_DSP_ERROR_INTERNAL;
+    d->factor = M;
+    d->taps = (L + M - 1) / M;
+    d->hist = d->taps - 1;
+    d->stage = (d->hist > PP_MIN_STAGE) ? d->hist : PP_MIN_STAGE;
+    d->stride = d->hist + d->stage + 1;
+    d->gr = split_branches(h, L, M, d->taps);
+    d->buf = (vv_dsp_real*)vv_dsp_calloc(M * d->stride, sizeof(vv_dsp_real));
+    if (!d->gr || !d->buf) {
+        vv_dsp_fir_decimator_destroy(d);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    // Slot 0 pairs x[0] with x[-M+1 .. -1]: those are already zero, so the first input
+    // completes the first output
+    d->fill = M - 1;
+    *out = d;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_fir_decimator_output_count(const vv_dsp_fir_decimator* d, size_t n) {
+    return d ? (d->fill + n) / d->factor : 0;
+}
+
+// Run every branch over the complete slots, then keep the history and the partial slot
+static void decimator_flush(vv_dsp_fir_decimator* d, vv_dsp_real* y) {
+    const size_t M = d->factor, n = d->slot;
+    for (size_t p = 0; p < M; ++p) {
+        fir_kernel(d->gr + p * d->taps, d->taps, d->buf + p * d->stride, y, n, p > 0);
+    }
+    for (size_t p = 0; p < M; ++p) {
+        vv_dsp_real* b = d->buf + p * d->stride;
+        memmove(b, b + n, (d->hist + 1) * sizeof(vv_dsp_real));
+    }
+    d->slot = 0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_decimator_process(vv_dsp_fir_decimator* d,
+                                                            const vv_dsp_real* x,
+                                                            size_t n,
+                                                            vv_dsp_real* y,
+                                                            size_t max_out,
+                                                            size_t* out_count) {
+    if (!d || !out_count) return VV_DSP_ERROR_NULL_POINTER;
+    *out_count = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t total = vv_dsp_fir_decimator_output_count(d, n);
+    if (total > max_out) return VV_DSP_ERROR_INVALID_SIZE;
+    if (total && !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t M = d->factor;
+    size_t produced = 0;
+    // Commutator: sample f of a slot belongs to branch M-1-f. Outputs are written only
+    // after all their inputs were read, so in-place use is safe.
+    for (size_t i = 0; i < n; ++i) {
+        d->buf[(M - 1 - d->fill) * d->stride + d->hist + d->slot] = x[i];
+        if (++d->fill < M) continue;
+        d->fill = 0;
+        if (++d->slot == d->stage) {
+            decimator_flush(d, y + produced);
+            produced += d->stage;
+        }
+    }
+    if (d->slot) {
+        const size_t c = d->slot;
+        decimator_flush(d, y + produced);
+        produced += c;
+    }
+    *out_count = produced;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_decimator_reset(vv_dsp_fir_decimator* d) {
+    if (!d) return VV_DSP_ERROR_NULL_POINTER;
+    memset(d->buf, 0, d->factor * d->stride * sizeof(vv_dsp_real));
+    d->slot = 0;
+    d->fill = d->factor - 1;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_fir_interpolator_destroy(vv_dsp_fir_interpolator* it) {
+    if (!it) return;
+    vv_dsp_free(it->gr);
+    vv_dsp_free(it->lin);
+    vv_dsp_free(it->tmp);
+    vv_dsp_free(it);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_interpolator_create(const vv_dsp_real* h,
+                                                              size_t L,
+                                                              size_t M,
+                                                              vv_dsp_fir_interpolator** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (L == 0 || M == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fir_interpolator* it = (vv_dsp_fir_interpolator*)vv_dsp_calloc(1, sizeof(*it));
+    if (!it) return VV_DSP_ERROR_INTERNAL;
+    it->factor = M;
+    it->taps = (L + M - 1) / M;
+    it->hist = it->taps - 1;
+    it->stage = (it->hist > PP_MIN_STAGE) ? it->hist : PP_MIN_STAGE;
+    it->gr = split_branches(h, L, M, it->taps);
+    it->lin = (vv_dsp_real*)vv_dsp_calloc(it->hist + it->stage, sizeof(vv_dsp_real));
+    it->tmp = (vv_dsp_real*)vv_dsp_malloc(it->stage * sizeof(vv_dsp_real));
+    if (!it->gr || !it->lin || !it->tmp) {
+        vv_dsp_fir_interpolator_destroy(it);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = it;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fir_interpolator_process(vv_dsp_fir_interpolator* it,
+                                                               const vv_dsp_real* x,
+                                                               size_t n,
+                                                               vv_dsp_real* y) {
+    if (!it) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!x || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t M = it->factor, H = it->hist;
+    for (size_t pos = 0; pos < n;) {
+        const size_t c = (n - pos < it->stage) ? n - pos : it->stage;
+        memcpy(it->lin + H, x + pos, c * sizeof(vv_dsp_real));
+        // Branch p fills output phase p of every input sample
+        for (size_t p = 0; p < M; ++p) {
+            fir_kernel(it->gr + p * it->taps, it->taps, it->lin, it->tmp, c, 0);
+            vv_dsp_real* dst = y + pos * M + p;
+            for (size_t i = 0; i < c; ++i) dst[i * M] = it->tmp[i];
+        }
+        if (H) memmove(it->lin, it->lin + c, H * sizeof(vv_dsp_real));
+        pos += c;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fir_interpolator_reset(vv_dsp_fir_interpolator* it) {
+    if (!it) return VV_DSP_ERROR_NULL_POINTER;
+    memset(it->lin, 0, (it->hist + it->stage) * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
@@ -3,10 +3,14 @@
 #include <stddef.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/filter/savgol.h"
 #include "vv_dsp/core/nan_policy.h"
+#include "vv_dsp/core/alloc.h"
+#include "fir_kernel.h"
+#include "conv_dispatch.h"
 
 static VV_DSP_INLINE int is_odd(int x) { return (x & 1) != 0; }
 
@@ -161,59 +165,89 @@ static vv_dsp_status sg_derivative_kernel(int window_length, int polyorder, int
     return VV_DSP_OK;
 }
 
-static void pad_signal(const vv_dsp_real* x, size_t N, int pad, vv_dsp_savgol_mode mode, vv_dsp_real* xp) {
-    // xp length = N + 2*pad, indices [0..pad-1] left pad, [pad .. pad+N-1] data, [pad+N .. pad+N+pad-1] right pad
-    size_t L = (size_t)pad;
-    // center copy
-    for (size_t i=0;i<N;++i) xp[L+i]=x[i];
-    // left
-    for (int i=0;i<pad;++i) {
-        size_t src_idx = 0;
+// Validate the parameters shared by vv_dsp_savgol() and plans (N == 0 skips the
+// signal length check), then build the kernel into h if given
+static vv_dsp_status sg_kernel(int window_length, int polyorder, int deriv, vv_dsp_real delta,
+                               size_t N, vv_dsp_real* h) {
+    if (window_length <= 0 || !is_odd(window_length)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (polyorder < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (deriv < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (deriv > polyorder) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (N && (size_t)window_length > N) return VV_DSP_ERROR_INVALID_SIZE;
+    if (deriv > 0 && !(delta > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!h) return VV_DSP_OK;
+    if (deriv == 0) return sg_smoothing_kernel(window_length, polyorder, h);
+    return sg_derivative_kernel(window_length, polyorder, deriv, delta, h);
+}
+
+// Sample idx of the padded signal, idx in [-pad, N + pad) with pad <= (N - 1) / 2
+static vv_dsp_real pad_value(const vv_dsp_real* x, size_t N, ptrdiff_t idx, vv_dsp_savgol_mode mode) {
+    if (idx >= 0 && (size_t)idx < N) return x[idx];
+    if (idx < 0) {
+        const size_t i = (size_t)(-idx) - 1;  // 0 for the sample next to x[0]
         switch (mode) {
-            case VV_DSP_SAVGOL_MODE_REFLECT:
-                src_idx = (size_t)(i+1); // reflect about first sample: x[1], x[2], ...
-                if (src_idx >= N) src_idx = N-1; // clamp if tiny N
-                xp[(size_t)(L-1 - (size_t)i)] = x[src_idx];
-                break;
+            case VV_DSP_SAVGOL_MODE_REFLECT: return x[(i + 1 < N) ? i + 1 : N - 1];
+            case VV_DSP_SAVGOL_MODE_WRAP: return x[(N - (i % N) - 1) % N];
             case VV_DSP_SAVGOL_MODE_CONSTANT:
             case VV_DSP_SAVGOL_MODE_NEAREST:
-                xp[(size_t)(L-1 - (size_t)i)] = x[0];
-                break;
-            case VV_DSP_SAVGOL_MODE_WRAP:
-                xp[(size_t)(L-1 - (size_t)i)] = x[(N - ((size_t)i % N) - 1) % N];
-                break;
+            default: return x[0];
         }
     }
-    // right
-    for (int i=0;i<pad;++i) {
-        size_t src_idx = N-2 - (size_t)i;
-        switch (mode) {
-            case VV_DSP_SAVGOL_MODE_REFLECT:
-                if (N>=2) xp[L+N + (size_t)i] = x[src_idx]; else xp[L+N+(size_t)i]=x[N-1];
-                break;
-            case VV_DSP_SAVGOL_MODE_CONSTANT:
-            case VV_DSP_SAVGOL_MODE_NEAREST:
-                xp[L+N + (size_t)i] = x[N-1];
-                break;
-            case VV_DSP_SAVGOL_MODE_WRAP:
-                xp[L+N + (size_t)i] = x[((size_t)i) % N];
-                break;
-        }
+    const size_t i = (size_t)idx - N;  // 0 for the sample next to x[N-1]
+    switch (mode) {
+        case VV_DSP_SAVGOL_MODE_REFLECT: return (N >= 2) ? x[N - 2 - i] : x[N - 1];
+        case VV_DSP_SAVGOL_MODE_WRAP: return x[i % N];
+        case VV_DSP_SAVGOL_MODE_CONSTANT:
+        case VV_DSP_SAVGOL_MODE_NEAREST:
+        default: return x[N - 1];
     }
 }
 
-static void convolve_valid(const vv_dsp_real* x, size_t N, const vv_dsp_real* h, int m, vv_dsp_real* y) {
-    int half = m/2;
-    size_t padN = N + 2*(size_t)half;
-    // x is already padded in our use; here assume x points to padded buffer, and N is original N
-    const vv_dsp_real* xp = x; (void)padN;
-    for (size_t n=0;n<N;++n) {
+// y[n] = sum_k h[k] * x[n - half + k]. Only the half outputs at each end read padding,
+// so there is no padded copy of the signal: the interior is one valid convolution over
+// x itself through the shared direct / FFT dispatch. output must not overlap x.
+static vv_dsp_status sg_filter(const vv_dsp_real* h, int m, const vv_dsp_real* x, size_t N,
+                               vv_dsp_savgol_mode mode, vv_dsp_real* y) {
+    const size_t half = (size_t)(m / 2);
+    const vv_dsp_status s = vv_dsp_conv_valid_rev(h, (size_t)m, x, y + half, N - 2 * half);
+    if (s != VV_DSP_OK) return s;
+    for (size_t e = 0; e < 2 * half; ++e) {
+        const size_t n = (e < half) ? e : N - 2 * half + e;
         double acc = 0.0;
-        for (int k=0;k<m;++k) {
-            acc += (double)h[k] * (double)xp[n + (size_t)k];
+        for (int k = 0; k < m; ++k) {
+            acc += (double)h[k] * (double)pad_value(x, N, (ptrdiff_t)n - (ptrdiff_t)half + k, mode);
         }
         y[n] = (vv_dsp_real)acc;
     }
+    return VV_DSP_OK;
+}
+
+// Filter y into output with the global NaN policy on both sides. The input is copied
+// only when output overlaps it or when the policy has a non-finite value to rewrite;
+// the policy is fetched once and clean data costs one vector scan per side.
+static vv_dsp_status sg_apply(const vv_dsp_real* h, int m, const vv_dsp_real* y, size_t N,
+                              vv_dsp_savgol_mode mode, vv_dsp_real* output) {
+    const int overlap = (output < y + N) && (y < output + N);
+    const vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
+    const int dirty = policy != VV_DSP_NAN_POLICY_PROPAGATE && vv_dsp_find_nonfinite(y, N) < N;
+    const vv_dsp_real* src = y;
+    vv_dsp_real* copy = NULL;
+    if (overlap || dirty) {
+        copy = (vv_dsp_real*)vv_dsp_malloc(N * sizeof(vv_dsp_real));
+        if (!copy) return VV_DSP_ERROR_INTERNAL;
+        memcpy(copy, y, N * sizeof(vv_dsp_real));
+        const vv_dsp_status ps = dirty ? vv_dsp_nan_policy_fixup(policy, copy, N) : VV_DSP_OK;
+        if (ps != VV_DSP_OK) {
+            vv_dsp_free(copy);
+            return ps;
+        }
+        src = copy;
+    }
+    const vv_dsp_status fs = sg_filter(h, m, src, N, mode, output);
+    vv_dsp_free(copy);
+    if (fs != VV_DSP_OK) return fs;
+    // Apply NaN/Inf policy to output as well (in case computations generated non-finite values)
+    return vv_dsp_nan_policy_fixup(policy, output, N);
 }
 
 vv_dsp_status vv_dsp_savgol(const vv_dsp_real* y,
@@ -227,61 +261,153 @@ vv_dsp_status vv_dsp_savgol(const vv_dsp_real* y,
 {
     if (!y || !output) return VV_DSP_ERROR_NULL_POINTER;
     if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
-    if (window_length <= 0 || !is_odd(window_length)) return VV_DSP_ERROR_OUT_OF_RANGE;
-    if (polyorder < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
-    if (deriv < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
-    if (deriv > polyorder) return VV_DSP_ERROR_OUT_OF_RANGE;
-    if ((size_t)window_length > N) return VV_DSP_ERROR_INVALID_SIZE;
-    if (deriv > 0 && !(delta > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_status st = sg_kernel(window_length, polyorder, deriv, delta, N, NULL);
+    if (st != VV_DSP_OK) return st;
 
-    // Apply NaN/Inf policy to input data
-    // We need to create a copy of the input for policy processing since the input is const
-    vv_dsp_real* y_processed = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
-    if (!y_processed) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_real kernel_stack[257]; // supports up to m<=257; plans have no limit
+    if (window_length > (int)(sizeof(kernel_stack)/sizeof(kernel_stack[0]))) return VV_DSP_ERROR_OUT_OF_RANGE;
+    st = sg_kernel(window_length, polyorder, deriv, delta, N, kernel_stack);
+    if (st != VV_DSP_OK) return st;
+    return sg_apply(kernel_stack, window_length, y, N, mode, output);
+}
 
-    // Apply NaN/Inf policy using the copy variant
-    vv_dsp_status policy_status = vv_dsp_apply_nan_policy_copy(y, N, y_processed);
-    if (policy_status != VV_DSP_OK) {
-        free(y_processed);
-        return policy_status;
-    }
+// Streaming chunk of at least this many samples keeps the multi-output kernel busy
+#define SG_MIN_STAGE 256
 
-    int m = window_length;
-    int half = m/2;
-    vv_dsp_real kernel_stack[257]; // supports up to m<=257; can extend if needed
-    if (m > (int)(sizeof(kernel_stack)/sizeof(kernel_stack[0]))) {
-        free(y_processed);
-        return VV_DSP_ERROR_OUT_OF_RANGE;
+struct vv_dsp_savgol_plan {
+    int m;                   // window length
+    size_t half;             // latency, m / 2
+    vv_dsp_real* h;          // kernel, m taps
+    vv_dsp_real* lin;        // stream: m-1 history samples, then the staged chunk
+    size_t stage;            // staging slots
+    size_t seen;             // samples pushed since the stream started
+};
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_create(int window_length,
+                                                         int polyorder,
+                                                         int deriv,
+                                                         vv_dsp_real delta,
+                                                         vv_dsp_savgol_plan** out_plan) {
+    if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    vv_dsp_status st = sg_kernel(window_length, polyorder, deriv, delta, 0, NULL);
+    if (st != VV_DSP_OK) return st;
+    vv_dsp_savgol_plan* p = (vv_dsp_savgol_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->m = window_length;
+    p->half = (size_t)(window_length / 2);
+    const size_t H = (size_t)window_length - 1;
+    p->stage = (H > SG_MIN_STAGE) ? H : SG_MIN_STAGE;
+    p->h = (vv_dsp_real*)vv_dsp_malloc((size_t)window_length * sizeof(vv_dsp_real));
+    p->lin = (vv_dsp_real*)vv_dsp_calloc(H + p->stage, sizeof(vv_dsp_real));
+    if (!p->h || !p->lin) {
+        vv_dsp_savgol_plan_destroy(p);
+        return VV_DSP_ERROR_INTERNAL;
     }
-    vv_dsp_status st;
-    if (deriv == 0) st = sg_smoothing_kernel(m, polyorder, kernel_stack);
-    else st = sg_derivative_kernel(m, polyorder, deriv, delta, kernel_stack);
+    st = sg_kernel(window_length, polyorder, deriv, delta, 0, p->h);
     if (st != VV_DSP_OK) {
-        free(y_processed);
+        vv_dsp_savgol_plan_destroy(p);
         return st;
     }
+    *out_plan = p;
+    return VV_DSP_OK;
+}
 
-    // Prepare padded input (using processed data)
-    vv_dsp_real* xp = (vv_dsp_real*)malloc((size_t)(N + 2*(size_t)half) * sizeof(vv_dsp_real));
-    if (!xp) {
-        free(y_processed);
-        return VV_DSP_ERROR_INTERNAL;
-    }
-    pad_signal(y_processed, N, half, mode, xp);
+vv_dsp_status vv_dsp_savgol_plan_apply(const vv_dsp_savgol_plan* p,
+                                       const vv_dsp_real* y,
+                                       size_t N,
+                                       vv_dsp_savgol_mode mode,
+                                       vv_dsp_real* output) {
+    if (!p || !y || !output) return VV_DSP_ERROR_NULL_POINTER;
+    if (N == 0 || (size_t)p->m > N) return VV_DSP_ERROR_INVALID_SIZE;
+    return sg_apply(p->h, p->m, y, N, mode, output);
+}
 
-    // Convolution (valid)
-    convolve_valid(xp, N, kernel_stack, m, output);
+size_t vv_dsp_savgol_plan_latency(const vv_dsp_savgol_plan* p) {
+    return p ? p->half : 0;
+}
 
-    // Apply NaN/Inf policy to output as well (in case computations generated non-finite values)
-    vv_dsp_status output_policy_status = vv_dsp_apply_nan_policy_inplace(output, N);
+// Outputs completed by pushing n more samples
+static size_t sg_stream_outputs(const vv_dsp_savgol_plan* p, size_t n) {
+    const size_t before = (p->seen > p->half) ? p->seen - p->half : 0;
+    const size_t after = (p->seen + n > p->half) ? p->seen + n - p->half : 0;
+    return after - before;
+}
 
-    free(xp);
-    free(y_processed);
+// Filter c samples already staged at lin[m-1 ..]; sample t of the stream completes
+// output t - half once t >= half
+static size_t sg_stream_chunk(vv_dsp_savgol_plan* p, size_t c, vv_dsp_real* out) {
+    const size_t H = (size_t)p->m - 1;
+    if (p->seen == 0) {
+        // Nearest-sample padding before the first sample
+        for (size_t i = 0; i < H; ++i) p->lin[i] = p->lin[H];
+    }
+    const size_t skip = (p->seen >= p->half) ? 0 : ((p->half - p->seen < c) ? p->half - p->seen : c);
+    if (c > skip) fir_kernel(p->h, (size_t)p->m, p->lin + skip, out, c - skip, 0);
+    if (H) memmove(p->lin, p->lin + c, H * sizeof(vv_dsp_real));
+    p->seen += c;
+    return c - skip;
+}
 
-    // Return the more critical error if there was one
-    if (output_policy_status != VV_DSP_OK) {
-        return output_policy_status;
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_process(vv_dsp_savgol_plan* p,
+                                                          const vv_dsp_real* in,
+                                                          size_t n,
+                                                          vv_dsp_real* out,
+                                                          size_t max_out,
+                                                          size_t* out_count) {
+    if (!p || !out_count) return VV_DSP_ERROR_NULL_POINTER;
+    *out_count = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t total = sg_stream_outputs(p, n);
+    if (total > max_out) return VV_DSP_ERROR_INVALID_SIZE;
+    if (total && !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t H = (size_t)p->m - 1;
+    const vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
+    size_t produced = 0;
+    for (size_t pos = 0; pos < n;) {
+        const size_t c = (n - pos < p->stage) ? n - pos : p->stage;
+        memcpy(p->lin + H, in + pos, c * sizeof(vv_dsp_real));
+        const vv_dsp_status ps = vv_dsp_nan_policy_fixup(policy, p->lin + H, c);
+        if (ps != VV_DSP_OK) {
+            *out_count = produced;
+            return ps;
+        }
+        produced += sg_stream_chunk(p, c, out + produced);
+        pos += c;
     }
+    *out_count = produced;
+    return produced ? vv_dsp_nan_policy_fixup(policy, out, produced) : VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_savgol_plan_flush(vv_dsp_savgol_plan* p,
+                                                        vv_dsp_real* out,
+                                                        size_t max_out,
+                                                        size_t* out_count) {
+    if (!p || !out_count) return VV_DSP_ERROR_NULL_POINTER;
+    *out_count = 0;
+    if (p->seen == 0 || p->half == 0) return vv_dsp_savgol_plan_reset(p);
+    const size_t total = sg_stream_outputs(p, p->half);
+    if (total > max_out) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    // Nearest-sample padding after the last sample; half <= stage, so one chunk
+    const size_t H = (size_t)p->m - 1;
+    const vv_dsp_real last = p->lin[H - 1];
+    for (size_t i = 0; i < p->half; ++i) p->lin[H + i] = last;
+    *out_count = sg_stream_chunk(p, p->half, out);
+    (void)vv_dsp_savgol_plan_reset(p);
+    return vv_dsp_apply_nan_policy_inplace(out, *out_count);
+}
 
+vv_dsp_status vv_dsp_savgol_plan_reset(vv_dsp_savgol_plan* p) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    p->seen = 0;
     return VV_DSP_OK;
 }
+
+void vv_dsp_savgol_plan_destroy(vv_dsp_savgol_plan* p) {
+    if (!p) return;
+    vv_dsp_free(p->h);
+    vv_dsp_free(p->lin);
+    vv_dsp_free(p);
+}
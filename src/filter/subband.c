@@ -0,0 +1,417 @@
+#include "vv_dsp/filter/subband.h"
+#include "vv_dsp/filter/fir.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SB_BATCH 16            // frames per batched FFT
+#define SB_GRID 32             // frequencies checked per power-complementarity estimate
+#define SB_SEARCH_ITERS 40
+
+struct vv_dsp_subband {
+    vv_dsp_subband_type type;
+    size_t M;                  // bands / channels
+    size_t D;                  // decimation
+    size_t N;                  // prototype length
+    size_t P;                  // fold period: 2M (PQMF, sign flip per period) or M (DFT)
+    size_t bands;              // values per frame
+    vv_dsp_real* ha;           // N analysis taps over the history, oldest first (time reversed)
+    vv_dsp_real* hs;           // N synthesis taps with the reconstruction gain
+    vv_dsp_cpx* tw;            // PQMF: P twiddles e^{-i pi j / 2M}
+    vv_dsp_cpx* ana_post;      // PQMF: M analysis output rotations
+    vv_dsp_cpx* syn_pre;       // PQMF: M synthesis input rotations (with the 2M of the inverse FFT)
+    vv_dsp_fft_plan* fwd;      // SB_BATCH frames: R2C M (DFT) or C2C 2M (PQMF)
+    vv_dsp_fft_plan* bwd;      // SB_BATCH frames: C2R M (DFT) or C2C 2M (PQMF)
+    vv_dsp_real* fold;         // P folded samples of one frame
+    vv_dsp_real* wr;           // SB_BATCH * P real staging
+    vv_dsp_cpx* wc;            // SB_BATCH * P complex staging (PQMF)
+    vv_dsp_cpx* wc2;           // SB_BATCH * P complex FFT output (PQMF)
+    vv_dsp_real* lin;          // analysis history: N - D + SB_BATCH * D
+    size_t have;               // valid samples in lin
+    size_t ana_rot;            // DFT: (frames analyzed * D) mod M
+    vv_dsp_real* acc;          // synthesis overlap-add: N - D + SB_BATCH * D
+    size_t syn_rot;            // DFT: (frames synthesized * D) mod M, likewise
+};
+
+// Zero-phase amplitude of h at w relative to DC (h is symmetric)
+static double proto_amp(const vv_dsp_real* h, size_t N, double w, double dc) {
+    const double c = 0.5 * (double)(N - 1);
+    double a = 0.0;
+    for (size_t n = 0; n < N; ++n) a += (double)h[n] * cos(w * ((double)n - c));
+    return a / dc;
+}
+
+// Worst deviation of |H(w)|^2 + |H(2 wx - w)|^2 from 1 over [0, wx] for cutoff fc
+static double proto_error(vv_dsp_real* h, size_t N, double fc, double wx, vv_dsp_status* s) {
+    *s = vv_dsp_fir_design_lowpass(h, N, (vv_dsp_real)fc, VV_DSP_WINDOW_BLACKMAN);
+    if (*s != VV_DSP_OK) return 0.0;
+    double dc = 0.0;
+    for (size_t n = 0; n < N; ++n) dc += (double)h[n];
+    double worst = 0.0;
+    for (size_t g = 0; g <= SB_GRID; ++g) {
+        const double w = wx * (double)g / (double)SB_GRID;
+        const double a = proto_amp(h, N, w, dc), b = proto_amp(h, N, 2.0 * wx - w, dc);
+        const double e = fabs(a * a + b * b - 1.0);
+        if (e > worst) worst = e;
+    }
+    return worst;
+}
+
+// Prototype with crossover wx (half the band spacing): golden-section search of the
+// windowed-sinc cutoff for the best power complementarity, then unit DC gain. The
+// cutoff of vv_dsp_fir_design_lowpass() is in cycles per sample (h = 2 fc sinc(2 fc n)),
+// and the -3 dB point sits above the -6 dB cutoff by under a transition width.
+static vv_dsp_status design_prototype(vv_dsp_real* h, size_t N, double wx) {
+    const double gr = 0.5 * (sqrt(5.0) - 1.0);
+    const double fx = wx / VV_DSP_TWO_PI_D;
+    double lo = fx, hi = fx + 4.0 / (double)N;
+    if (hi > 0.49) hi = 0.49;
+    vv_dsp_status s = VV_DSP_OK;
+    double c = hi - gr * (hi - lo), d = lo + gr * (hi - lo);
+    double ec = proto_error(h, N, c, wx, &s), ed = 0.0;
+    if (s == VV_DSP_OK) ed = proto_error(h, N, d, wx, &s);
+    for (int it = 0; it < SB_SEARCH_ITERS && s == VV_DSP_OK; ++it) {
+        if (ec < ed) {
+            hi = d;
+            d = c;
+            ed = ec;
+            c = hi - gr * (hi - lo);
+            ec = proto_error(h, N, c, wx, &s);
+        } else {
+            lo = c;
+            c = d;
+            ec = ed;
+            d = lo + gr * (hi - lo);
+            ed = proto_error(h, N, d, wx, &s);
+        }
+    }
+    if (s == VV_DSP_OK) s = vv_dsp_fir_design_lowpass(h, N, (vv_dsp_real)(0.5 * (lo + hi)), VV_DSP_WINDOW_BLACKMAN);
+    if (s != VV_DSP_OK) return s;
+    double dc = 0.0;
+    for (size_t n = 0; n < N; ++n) dc += (double)h[n];
+    for (size_t n = 0; n < N; ++n) h[n] = (vv_dsp_real)((double)h[n] / dc);
+    return VV_DSP_OK;
+}
+
+void vv_dsp_subband_destroy(vv_dsp_subband* fb) {
+    if (!fb) return;
+    vv_dsp_fft_destroy(fb->fwd);
+    vv_dsp_fft_destroy(fb->bwd);
+    vv_dsp_free(fb->ha);
+    vv_dsp_free(fb->hs);
+    vv_dsp_free(fb->tw);
+    vv_dsp_free(fb->ana_post);
+    vv_dsp_free(fb->syn_pre);
+    vv_dsp_free(fb->fold);
+    vv_dsp_free(fb->wr);
+    vv_dsp_free(fb->wc);
+    vv_dsp_free(fb->wc2);
+    vv_dsp_free(fb->lin);
+    vv_dsp_free(fb->acc);
+    vv_dsp_free(fb);
+}
+
+static vv_dsp_status subband_make_plans(vv_dsp_subband* fb) {
+    const size_t M = fb->M, P = fb->P;
+    if (fb->type == VV_DSP_SUBBAND_DFT) {
+        const size_t nh = M / 2 + 1;
+        vv_dsp_status s = vv_dsp_fft_make_plan_many(M, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, SB_BATCH, 1, M, 1, nh,
+                                                    &fb->fwd);
+        if (s == VV_DSP_OK)
+            s = vv_dsp_fft_make_plan_many(M, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, SB_BATCH, 1, nh, 1, M, &fb->bwd);
+        return s;
+    }
+    vv_dsp_status s = vv_dsp_fft_make_plan_many(P, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, SB_BATCH, 1, P, 1, P, &fb->fwd);
+    if (s == VV_DSP_OK)
+        s = vv_dsp_fft_make_plan_many(P, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, SB_BATCH, 1, P, 1, P, &fb->bwd);
+    return s;
+}
+
+// Analysis / synthesis taps and the PQMF modulation tables from the prototype h
+static void subband_init_tables(vv_dsp_subband* fb, const vv_dsp_real* h) {
+    const size_t M = fb->M, N = fb->N, P = fb->P;
+    double energy = 0.0;
+    for (size_t n = 0; n < N; ++n) energy += (double)h[n] * (double)h[n];
+    if (fb->type == VV_DSP_SUBBAND_DFT) {
+        // Overlapping frames sum h^2 to energy / D per output sample; hs undoes it
+        const double g = (double)fb->D / energy;
+        for (size_t i = 0; i < N; ++i) {
+            fb->ha[i] = h[N - 1 - i];
+            fb->hs[i] = (vv_dsp_real)((double)h[i] * g);
+        }
+        return;
+    }
+    // h_k[n] = 2 h[n] cos(a_k (n - c) + t_k), f_k[n] = 2 h[n] cos(a_k (n - c) - t_k) with
+    // a_k = (k + 1/2) pi / M, c = (N - 1) / 2, t_k = (-1)^k pi / 4. Shifting n by 2M flips
+    // every modulator's sign, so the taps carry (-1)^(n / 2M) and the folds keep period 2M.
+    // With a unit-DC prototype the bank's gain is 1/M, restored in hs.
+    const double g = (double)M;
+    const double c = 0.5 * (double)(N - 1);
+    for (size_t i = 0; i < N; ++i) {
+        const double sg = ((i / P) & 1u) ? -1.0 : 1.0;
+        fb->ha[i] = (vv_dsp_real)(sg * (double)h[N - 1 - i]);
+        fb->hs[i] = (vv_dsp_real)(sg * (double)h[i] * g);
+    }
+    for (size_t j = 0; j < P; ++j) {
+        const double ph = -VV_DSP_PI_D * (double)j / (double)P;
+        fb->tw[j].re = (vv_dsp_real)cos(ph);
+        fb->tw[j].im = (vv_dsp_real)sin(ph);
+    }
+    for (size_t k = 0; k < M; ++k) {
+        const double a = VV_DSP_PI_D * ((double)k + 0.5) / (double)M;
+        const double t = (k & 1u) ? -0.25 * VV_DSP_PI_D : 0.25 * VV_DSP_PI_D;
+        const double gk = -a * c - t;
+        fb->ana_post[k].re = (vv_dsp_real)(2.0 * cos(gk));
+        fb->ana_post[k].im = (vv_dsp_real)(-2.0 * sin(gk));
+        fb->syn_pre[k].re = (vv_dsp_real)(2.0 * (double)P * cos(gk));
+        fb->syn_pre[k].im = (vv_dsp_real)(2.0 * (double)P * sin(gk));
+    }
+}
+
+vv_dsp_status vv_dsp_subband_create(const vv_dsp_subband_params* params, vv_dsp_subband** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!params) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_subband_type type = params->type;
+    if (type != VV_DSP_SUBBAND_PQMF && type != VV_DSP_SUBBAND_DFT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const size_t M = params->num_bands;
+    const int pqmf = type == VV_DSP_SUBBAND_PQMF;
+    const size_t D = params->decimation ? params->decimation : (pqmf ? M : M / 2);
+    const size_t K = params->taps_per_band ? params->taps_per_band : (pqmf ? 16 : 8);
+    if (M < 2 || K < 2) return VV_DSP_ERROR_INVALID_SIZE;
+    if (pqmf ? (D != M || (K & 1u)) : ((M & 1u) || D == 0 || D > M / 2)) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_subband* fb = (vv_dsp_subband*)vv_dsp_calloc(1, sizeof(*fb));
+    if (!fb) return VV_DSP_ERROR_INTERNAL;
+    fb->type = type;
+    fb->M = M;
+    fb->D = D;
+    fb->N = K * M;
+    fb->P = pqmf ? 2 * M : M;
+    fb->bands = pqmf ? M : M / 2 + 1;
+    const size_t N = fb->N, P = fb->P, span = N - D + SB_BATCH * D;
+
+    vv_dsp_real* h = (vv_dsp_real*)vv_dsp_malloc(N * sizeof(vv_dsp_real));
+    fb->ha = (vv_dsp_real*)vv_dsp_malloc(N * sizeof(vv_dsp_real));
+    fb->hs = (vv_dsp_real*)vv_dsp_malloc(N * sizeof(vv_dsp_real));
+    fb->fold = (vv_dsp_real*)vv_dsp_malloc(P * sizeof(vv_dsp_real));
+    fb->wr = (vv_dsp_real*)vv_dsp_malloc(SB_BATCH * P * sizeof(vv_dsp_real));
+    fb->lin = (vv_dsp_real*)vv_dsp_calloc(span, sizeof(vv_dsp_real));
+    fb->acc = (vv_dsp_real*)vv_dsp_calloc(span, sizeof(vv_dsp_real));
+    int ok = h && fb->ha && fb->hs && fb->fold && fb->wr && fb->lin && fb->acc;
+    if (ok && pqmf) {
+        fb->tw = (vv_dsp_cpx*)vv_dsp_malloc(P * sizeof(vv_dsp_cpx));
+        fb->ana_post = (vv_dsp_cpx*)vv_dsp_malloc(M * sizeof(vv_dsp_cpx));
+        fb->syn_pre = (vv_dsp_cpx*)vv_dsp_malloc(M * sizeof(vv_dsp_cpx));
+        fb->wc = (vv_dsp_cpx*)vv_dsp_malloc(SB_BATCH * P * sizeof(vv_dsp_cpx));
+        fb->wc2 = (vv_dsp_cpx*)vv_dsp_malloc(SB_BATCH * P * sizeof(vv_dsp_cpx));
+        ok = fb->tw && fb->ana_post && fb->syn_pre && fb->wc && fb->wc2;
+    }
+    vv_dsp_status s = ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    // Crossover at half the band spacing: pi / 2M (PQMF) or pi / M (DFT)
+    if (s == VV_DSP_OK) s = design_prototype(h, N, VV_DSP_PI_D / (double)P);
+    if (s == VV_DSP_OK) s = subband_make_plans(fb);
+    if (s == VV_DSP_OK) subband_init_tables(fb, h);
+    vv_dsp_free(h);
+    if (s != VV_DSP_OK) {
+        vv_dsp_subband_destroy(fb);
+        return s;
+    }
+    fb->have = N - D;
+    *out = fb;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_subband_reset(vv_dsp_subband* fb) {
+    if (!fb) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t span = fb->N - fb->D + SB_BATCH * fb->D;
+    memset(fb->lin, 0, span * sizeof(vv_dsp_real));
+    memset(fb->acc, 0, span * sizeof(vv_dsp_real));
+    fb->have = fb->N - fb->D;
+    fb->ana_rot = 0;
+    fb->syn_rot = 0;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_subband_frame_size(const vv_dsp_subband* fb) {
+    return fb ? fb->bands : 0;
+}
+
+size_t vv_dsp_subband_decimation(const vv_dsp_subband* fb) {
+    return fb ? fb->D : 0;
+}
+
+size_t vv_dsp_subband_latency(const vv_dsp_subband* fb) {
+    return fb ? fb->N - fb->D : 0;
+}
+
+size_t vv_dsp_subband_analysis_count(const vv_dsp_subband* fb, size_t n) {
+    if (!fb) return 0;
+    return (fb->have - (fb->N - fb->D) + n) / fb->D;
+}
+
+// Window the N samples at x by the analysis taps and sum them into one period:
+// fold[j] = sum_l ha[j + l P] * x[j + l P]
+static void subband_fold(const vv_dsp_subband* fb, const vv_dsp_real* x, vv_dsp_real* fold) {
+    const size_t N = fb->N, P = fb->P;
+    const vv_dsp_real* ha = fb->ha;
+    for (size_t j = 0; j < P; ++j) fold[j] = ha[j] * x[j];
+    for (size_t l = P; l < N; l += P) {
+        for (size_t j = 0; j < P; ++j) fold[j] += ha[l + j] * x[l + j];
+    }
+}
+
+static vv_dsp_status run_batch(const vv_dsp_fft_plan* plan, size_t count, const void* in, size_t in_step,
+                               size_t in_size, void* out, size_t out_step, size_t out_size) {
+    if (count == SB_BATCH) return vv_dsp_fft_execute_batch(plan, in, out);
+    // The last, partial batch: the plan also runs single vectors
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t i = 0; i < count && s == VV_DSP_OK; ++i) {
+        s = vv_dsp_fft_execute(plan, (const char*)in + i * in_step * in_size, (char*)out + i * out_step * out_size);
+    }
+    return s;
+}
+
+// Analyze the first count frames staged in lin into rows
+static vv_dsp_status analyze_staged(vv_dsp_subband* fb, size_t count, void* rows) {
+    const size_t M = fb->M, D = fb->D, P = fb->P;
+    vv_dsp_status s;
+    if (fb->type == VV_DSP_SUBBAND_DFT) {
+        // X_k = sum_n h[n] x[t-n] e^{-i w_k (t-n)}: the fold starts at t - N + 1, so it
+        // is rotated by (t - N + 1) mod M = (frame + 1) D mod M before the DFT
+        for (size_t f = 0; f < count; ++f) {
+            subband_fold(fb, fb->lin + f * D, fb->fold);
+            fb->ana_rot = (fb->ana_rot + D) % M;
+            vv_dsp_real* u = fb->wr + f * M;
+            const size_t r = fb->ana_rot;
+            memcpy(u + r, fb->fold, (M - r) * sizeof(vv_dsp_real));
+            memcpy(u, fb->fold + (M - r), r * sizeof(vv_dsp_real));
+        }
+        return run_batch(fb->fwd, count, fb->wr, M, sizeof(vv_dsp_real), rows, fb->bands, sizeof(vv_dsp_cpx));
+    }
+    // PQMF: s_k = sum_j fold[j] 2 cos(a_k j + g_k) = Re{2 e^{-i g_k} W_k} with
+    // W = DFT_2M(fold[j] e^{-i pi j / 2M})
+    for (size_t f = 0; f < count; ++f) {
+        subband_fold(fb, fb->lin + f * D, fb->fold);
+        vv_dsp_cpx* w = fb->wc + f * P;
+        for (size_t j = 0; j < P; ++j) {
+            w[j].re = fb->fold[j] * fb->tw[j].re;
+            w[j].im = fb->fold[j] * fb->tw[j].im;
+        }
+    }
+    s = run_batch(fb->fwd, count, fb->wc, P, sizeof(vv_dsp_cpx), fb->wc2, P, sizeof(vv_dsp_cpx));
+    if (s != VV_DSP_OK) return s;
+    for (size_t f = 0; f < count; ++f) {
+        const vv_dsp_cpx* W = fb->wc2 + f * P;
+        vv_dsp_real* row = (vv_dsp_real*)rows + f * M;
+        for (size_t k = 0; k < M; ++k) row[k] = fb->ana_post[k].re * W[k].re - fb->ana_post[k].im * W[k].im;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_subband_analyze(vv_dsp_subband* fb,
+                                     const vv_dsp_real* x,
+                                     size_t n,
+                                     void* frames,
+                                     size_t max_frames,
+                                     size_t* out_frames) {
+    if (!fb || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t total = vv_dsp_subband_analysis_count(fb, n);
+    if (total > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (total && !frames) return VV_DSP_ERROR_NULL_POINTER;
+
+    const size_t D = fb->D, hist = fb->N - D, cap = hist + SB_BATCH * D;
+    const size_t row_bytes = fb->bands * (fb->type == VV_DSP_SUBBAND_DFT ? sizeof(vv_dsp_cpx) : sizeof(vv_dsp_real));
+    size_t done = 0;
+    for (size_t i = 0; i < n;) {
+        const size_t c = (n - i < cap - fb->have) ? n - i : cap - fb->have;
+        memcpy(fb->lin + fb->have, x + i, c * sizeof(vv_dsp_real));
+        fb->have += c;
+        i += c;
+        const size_t ready = (fb->have - hist) / D;
+        if (ready == 0 || (ready < SB_BATCH && i < n)) continue;
+        vv_dsp_status s = analyze_staged(fb, ready, (char*)frames + done * row_bytes);
+        if (s != VV_DSP_OK) return s;
+        done += ready;
+        fb->have -= ready * D;
+        memmove(fb->lin, fb->lin + ready * D, fb->have * sizeof(vv_dsp_real));
+    }
+    *out_frames = done;
+    return VV_DSP_OK;
+}
+
+// Overlap-add count frames of one-period signals v (stride P) into acc at hops of D
+static void overlap_add(vv_dsp_subband* fb, const vv_dsp_real* v, size_t count) {
+    const size_t N = fb->N, D = fb->D, P = fb->P;
+    for (size_t f = 0; f < count; ++f) {
+        vv_dsp_real* y = fb->acc + f * D;
+        const vv_dsp_real* vf = v + f * P;
+        // DFT frames re-modulate by e^{i w_k (n - latency)}, the analysis rotation of the
+        // same frame; PQMF modulators are local to the frame
+        if (fb->type == VV_DSP_SUBBAND_DFT) fb->syn_rot = (fb->syn_rot + D) % fb->M;
+        size_t idx = fb->syn_rot;
+        for (size_t a = 0; a < N;) {
+            const size_t len = (P - idx < N - a) ? P - idx : N - a;
+            const vv_dsp_real* hs = fb->hs + a;
+            const vv_dsp_real* vs = vf + idx;
+            vv_dsp_real* ys = y + a;
+            for (size_t t = 0; t < len; ++t) ys[t] += hs[t] * vs[t];
+            a += len;
+            idx = 0;
+        }
+    }
+}
+
+static vv_dsp_status synthesize_batch(vv_dsp_subband* fb, const void* rows, size_t count) {
+    const size_t M = fb->M, P = fb->P;
+    if (fb->type == VV_DSP_SUBBAND_DFT) {
+        // The inverse transform's 1/M is part of the synthesis gain in hs
+        vv_dsp_status s = run_batch(fb->bwd, count, rows, fb->bands, sizeof(vv_dsp_cpx), fb->wr, M, sizeof(vv_dsp_real));
+        if (s == VV_DSP_OK) overlap_add(fb, fb->wr, count);
+        return s;
+    }
+    // PQMF: v[j] = sum_k s_k 2 cos(a_k j + g_k) = Re{e^{i pi j / 2M} IDFT_2M(2M * 2 s_k e^{i g_k})}
+    for (size_t f = 0; f < count; ++f) {
+        const vv_dsp_real* row = (const vv_dsp_real*)rows + f * M;
+        vv_dsp_cpx* q = fb->wc + f * P;
+        for (size_t k = 0; k < M; ++k) {
+            q[k].re = row[k] * fb->syn_pre[k].re;
+            q[k].im = row[k] * fb->syn_pre[k].im;
+        }
+        memset(q + M, 0, (P - M) * sizeof(vv_dsp_cpx));
+    }
+    vv_dsp_status s = run_batch(fb->bwd, count, fb->wc, P, sizeof(vv_dsp_cpx), fb->wc2, P, sizeof(vv_dsp_cpx));
+    if (s != VV_DSP_OK) return s;
+    for (size_t f = 0; f < count; ++f) {
+        const vv_dsp_cpx* V = fb->wc2 + f * P;
+        vv_dsp_real* v = fb->wr + f * P;
+        for (size_t j = 0; j < P; ++j) v[j] = fb->tw[j].re * V[j].re + fb->tw[j].im * V[j].im;
+    }
+    overlap_add(fb, fb->wr, count);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_subband_synthesize(vv_dsp_subband* fb, const void* frames, size_t num_frames, vv_dsp_real* y) {
+    if (!fb) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!frames || !y) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t D = fb->D, keep = fb->N - D;
+    const size_t row_bytes = fb->bands * (fb->type == VV_DSP_SUBBAND_DFT ? sizeof(vv_dsp_cpx) : sizeof(vv_dsp_real));
+    for (size_t f = 0; f < num_frames;) {
+        const size_t c = (num_frames - f < SB_BATCH) ? num_frames - f : SB_BATCH;
+        vv_dsp_status s = synthesize_batch(fb, (const char*)frames + f * row_bytes, c);
+        if (s != VV_DSP_OK) return s;
+        // The first c hops are complete: no later frame reaches them
+        memcpy(y + f * D, fb->acc, c * D * sizeof(vv_dsp_real));
+        memmove(fb->acc, fb->acc + c * D, keep * sizeof(vv_dsp_real));
+        memset(fb->acc + keep, 0, c * D * sizeof(vv_dsp_real));
+        f += c;
+    }
+    return VV_DSP_OK;
+}
@@ -0,0 +1,263 @@
+#include "vv_dsp/filter/zoom_fft.h"
+#include "vv_dsp/filter/fir.h"
+#include "vv_dsp/filter/polyphase.h"
+#include "vv_dsp/spectral/fft.h"
+#include "fir_design.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ZF_BLOCK 256           // NCO table length and mixer block
+#define ZF_TAPS_PER_FACTOR 20
+#define ZF_RELIABLE 0.85       // usable fraction of the decimated Nyquist band
+
+struct vv_dsp_zoom_fft {
+    vv_dsp_zoom_fft_params p;
+    vv_dsp_fir_decimator* dec_i;
+    vv_dsp_fir_decimator* dec_q;
+    vv_dsp_fft_plan* fft;
+    vv_dsp_real* tab_re;       // ZF_BLOCK: cos(w i)
+    vv_dsp_real* tab_im;       // ZF_BLOCK: -sin(w i)
+    double rot_re, rot_im;     // NCO phasor at the start of the current block
+    double step_re, step_im;   // e^{-j w ZF_BLOCK}
+    size_t pos;                // position in the current NCO block
+    vv_dsp_real* mix_i;        // ZF_BLOCK mixed / decimated I
+    vv_dsp_real* mix_q;        // ZF_BLOCK mixed Q
+    vv_dsp_real* dec_buf;      // ZF_BLOCK decimated Q (I decimates in place)
+    vv_dsp_real* win;          // fft_size window / sum(window)
+    vv_dsp_cpx* frame;         // fft_size decimated history, oldest first
+    size_t have;               // valid samples in frame
+    vv_dsp_cpx* fin;           // fft_size
+    vv_dsp_cpx* fout;          // fft_size
+};
+
+static size_t next_pow2(size_t v) {
+    size_t n = 1;
+    while (n < v) n <<= 1;
+    return n;
+}
+
+vv_dsp_status vv_dsp_zoom_fft_params_for_freq_range(vv_dsp_real f_start,
+                                                    vv_dsp_real f_end,
+                                                    size_t num_bins,
+                                                    vv_dsp_real fs,
+                                                    vv_dsp_zoom_fft_params* p) {
+    if (!p) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_bins == 0 || !(fs > (vv_dsp_real)0)) return VV_DSP_ERROR_INVALID_SIZE;
+    const double bw = (double)f_end - (double)f_start;
+    if (!(bw > 0.0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    // Reliable span ZF_RELIABLE * fs / factor must cover the band
+    double d = floor(ZF_RELIABLE * (double)fs / bw);
+    if (d < 1.0) d = 1.0;
+    memset(p, 0, sizeof(*p));
+    p->sample_rate = fs;
+    p->center_hz = (vv_dsp_real)(0.5 * ((double)f_start + (double)f_end));
+    p->factor = (size_t)d;
+    p->fft_size = next_pow2((size_t)ceil((double)num_bins * (double)fs / (d * bw)));
+    if (p->fft_size < 2) p->fft_size = 2;
+    p->window = VV_DSP_WINDOW_HANNING;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_zoom_fft_destroy(vv_dsp_zoom_fft* z) {
+    if (!z) return;
+    vv_dsp_fir_decimator_destroy(z->dec_i);
+    vv_dsp_fir_decimator_destroy(z->dec_q);
+    vv_dsp_fft_plan_release(z->fft);
+    vv_dsp_free(z->tab_re);
+    vv_dsp_free(z->tab_im);
+    vv_dsp_free(z->mix_i);
+    vv_dsp_free(z->mix_q);
+    vv_dsp_free(z->dec_buf);
+    vv_dsp_free(z->win);
+    vv_dsp_free(z->frame);
+    vv_dsp_free(z->fin);
+    vv_dsp_free(z->fout);
+    vv_dsp_free(z);
+}
+
+// Lowpass at the decimated Nyquist; factor 1 passes through a single unit tap
+static vv_dsp_status zoom_create_decimators(vv_dsp_zoom_fft* z) {
+    const size_t D = z->p.factor;
+    size_t L = 1;
+    vv_dsp_real one = (vv_dsp_real)1;
+    vv_dsp_real* h = &one;
+    if (D > 1) {
+        L = z->p.num_taps ? z->p.num_taps : ZF_TAPS_PER_FACTOR * D + 1;
+        h = (vv_dsp_real*)vv_dsp_malloc(L * sizeof(vv_dsp_real));
+        if (!h) return VV_DSP_ERROR_INTERNAL;
+        vv_dsp_status s = vv_dsp_fir_design_lowpass(h, L, (vv_dsp_real)(1.0 / (double)D), VV_DSP_WINDOW_BLACKMAN);
+        if (s != VV_DSP_OK) {
+            vv_dsp_free(h);
+            return s;
+        }
+    }
+    vv_dsp_status s = vv_dsp_fir_decimator_create(h, L, D, &z->dec_i);
+    if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_create(h, L, D, &z->dec_q);
+    if (h != &one) vv_dsp_free(h);
+    return s;
+}
+
+vv_dsp_status vv_dsp_zoom_fft_create(const vv_dsp_zoom_fft_params* params, vv_dsp_zoom_fft** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!params) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t K = params->fft_size;
+    if (params->factor == 0 || K < 2 || params->hop > K) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(params->sample_rate > (vv_dsp_real)0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_zoom_fft* z = (vv_dsp_zoom_fft*)vv_dsp_calloc(1, sizeof(*z));
+    if (!z) return VV_DSP_ERROR_INTERNAL;
+    z->p = *params;
+    if (z->p.hop == 0) z->p.hop = K;
+
+    vv_dsp_status s = zoom_create_decimators(z);
+    if (s == VV_DSP_OK) s = vv_dsp_fft_plan_acquire(K, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &z->fft);
+    if (s == VV_DSP_OK) {
+        z->tab_re = (vv_dsp_real*)vv_dsp_malloc(ZF_BLOCK * sizeof(vv_dsp_real));
+        z->tab_im = (vv_dsp_real*)vv_dsp_malloc(ZF_BLOCK * sizeof(vv_dsp_real));
+        z->mix_i = (vv_dsp_real*)vv_dsp_malloc(ZF_BLOCK * sizeof(vv_dsp_real));
+        z->mix_q = (vv_dsp_real*)vv_dsp_malloc(ZF_BLOCK * sizeof(vv_dsp_real));
+        z->dec_buf = (vv_dsp_real*)vv_dsp_malloc(ZF_BLOCK * sizeof(vv_dsp_real));
+        z->win = (vv_dsp_real*)vv_dsp_malloc(K * sizeof(vv_dsp_real));
+        z->frame = (vv_dsp_cpx*)vv_dsp_calloc(K, sizeof(vv_dsp_cpx));
+        z->fin = (vv_dsp_cpx*)vv_dsp_malloc(K * sizeof(vv_dsp_cpx));
+        z->fout = (vv_dsp_cpx*)vv_dsp_malloc(K * sizeof(vv_dsp_cpx));
+        if (!z->tab_re || !z->tab_im || !z->mix_i || !z->mix_q || !z->dec_buf || !z->win || !z->frame ||
+            !z->fin || !z->fout)
+            s = VV_DSP_ERROR_INTERNAL;
+    }
+    if (s == VV_DSP_OK) s = vv_dsp_fir_window_fill(z->win, K, z->p.window);
+    if (s != VV_DSP_OK) {
+        vv_dsp_zoom_fft_destroy(z);
+        return s;
+    }
+
+    double wsum = 0.0;
+    for (size_t k = 0; k < K; ++k) wsum += (double)z->win[k];
+    if (!(wsum > 0.0)) {
+        vv_dsp_zoom_fft_destroy(z);
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    for (size_t k = 0; k < K; ++k) z->win[k] = (vv_dsp_real)((double)z->win[k] / wsum);
+
+    // NCO table for one block; the block phasor advances in double between blocks
+    const double w = VV_DSP_TWO_PI_D * (double)z->p.center_hz / (double)z->p.sample_rate;
+    for (size_t i = 0; i < ZF_BLOCK; ++i) {
+        z->tab_re[i] = (vv_dsp_real)cos(w * (double)i);
+        z->tab_im[i] = (vv_dsp_real)-sin(w * (double)i);
+    }
+    z->step_re = cos(w * (double)ZF_BLOCK);
+    z->step_im = -sin(w * (double)ZF_BLOCK);
+    z->rot_re = 1.0;
+    z->rot_im = 0.0;
+    *out = z;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_zoom_fft_reset(vv_dsp_zoom_fft* z) {
+    if (!z) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status s = vv_dsp_fir_decimator_reset(z->dec_i);
+    if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_reset(z->dec_q);
+    z->rot_re = 1.0;
+    z->rot_im = 0.0;
+    z->pos = 0;
+    z->have = 0;
+    return s;
+}
+
+size_t vv_dsp_zoom_fft_size(const vv_dsp_zoom_fft* z) {
+    return z ? z->p.fft_size : 0;
+}
+
+vv_dsp_real vv_dsp_zoom_fft_bin_freq(const vv_dsp_zoom_fft* z, size_t k) {
+    if (!z) return (vv_dsp_real)0;
+    const double K = (double)z->p.fft_size;
+    const double df = (double)z->p.sample_rate / ((double)z->p.factor * K);
+    return (vv_dsp_real)((double)z->p.center_hz + ((double)k - (double)(z->p.fft_size / 2)) * df);
+}
+
+size_t vv_dsp_zoom_fft_output_count(const vv_dsp_zoom_fft* z, size_t n) {
+    if (!z) return 0;
+    const size_t total = z->have + vv_dsp_fir_decimator_output_count(z->dec_i, n);
+    return (total < z->p.fft_size) ? 0 : (total - z->p.fft_size) / z->p.hop + 1;
+}
+
+// Window the full history, transform, and rotate bins so the center lands at K/2
+static vv_dsp_status zoom_emit(vv_dsp_zoom_fft* z, vv_dsp_cpx* row) {
+    const size_t K = z->p.fft_size, half = K / 2;
+    for (size_t k = 0; k < K; ++k) {
+        z->fin[k].re = z->frame[k].re * z->win[k];
+        z->fin[k].im = z->frame[k].im * z->win[k];
+    }
+    vv_dsp_status s = vv_dsp_fft_execute(z->fft, z->fin, z->fout);
+    if (s != VV_DSP_OK) return s;
+    memcpy(row, z->fout + (K - half), half * sizeof(vv_dsp_cpx));
+    memcpy(row + half, z->fout, (K - half) * sizeof(vv_dsp_cpx));
+    const size_t H = z->p.hop;
+    memmove(z->frame, z->frame + H, (K - H) * sizeof(vv_dsp_cpx));
+    z->have = K - H;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_zoom_fft_push(vv_dsp_zoom_fft* z,
+                                   const vv_dsp_real* x,
+                                   size_t n,
+                                   vv_dsp_cpx* out,
+                                   size_t max_frames,
+                                   size_t* out_frames) {
+    if (!z || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (!x) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t total = vv_dsp_zoom_fft_output_count(z, n);
+    if (total > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (total && !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    const size_t K = z->p.fft_size;
+    size_t frames = 0;
+    for (size_t i = 0; i < n;) {
+        const size_t len = (n - i < ZF_BLOCK - z->pos) ? n - i : ZF_BLOCK - z->pos;
+        // Mixer: x * e^{-j w (block + pos + t)}, one complex multiply per sample
+        const vv_dsp_real rr = (vv_dsp_real)z->rot_re, ri = (vv_dsp_real)z->rot_im;
+        const vv_dsp_real* tr = z->tab_re + z->pos;
+        const vv_dsp_real* ti = z->tab_im + z->pos;
+        const vv_dsp_real* xs = x + i;
+        vv_dsp_real* mi = z->mix_i;
+        vv_dsp_real* mq = z->mix_q;
+        for (size_t t = 0; t < len; ++t) {
+            const vv_dsp_real c = tr[t] * rr - ti[t] * ri;
+            const vv_dsp_real s = tr[t] * ri + ti[t] * rr;
+            mi[t] = xs[t] * c;
+            mq[t] = xs[t] * s;
+        }
+        z->pos += len;
+        i += len;
+        if (z->pos == ZF_BLOCK) {
+            const double nr = z->rot_re * z->step_re - z->rot_im * z->step_im;
+            const double ni = z->rot_re * z->step_im + z->rot_im * z->step_re;
+            const double g = 1.0 / sqrt(nr * nr + ni * ni);
+            z->rot_re = nr * g;
+            z->rot_im = ni * g;
+            z->pos = 0;
+        }
+
+        size_t ci = 0, cq = 0;
+        vv_dsp_status s = vv_dsp_fir_decimator_process(z->dec_i, mi, len, mi, ZF_BLOCK, &ci);
+        if (s == VV_DSP_OK) s = vv_dsp_fir_decimator_process(z->dec_q, mq, len, z->dec_buf, ZF_BLOCK, &cq);
+        if (s != VV_DSP_OK) return s;
+        for (size_t t = 0; t < ci; ++t) {
+            z->frame[z->have].re = mi[t];
+            z->frame[z->have].im = z->dec_buf[t];
+            if (++z->have == K) {
+                s = zoom_emit(z, out + frames * K);
+                if (s != VV_DSP_OK) return s;
+                ++frames;
+            }
+        }
+    }
+    *out_frames = frames;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,718 @@
+#include "vv_dsp/graph.h"
+#include "vv_dsp/filter/fir.h"
+#include "vv_dsp/filter/convolver.h"
+#include "vv_dsp/resample/resampler.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/simd_utils.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define GRAPH_NONE     SIZE_MAX  // no buffer slot (graph inputs) / never released (outputs)
+#define GRAPH_ALIGN_REALS (64 / sizeof(vv_dsp_real))  // slots start on 64-byte boundaries
+
+typedef enum {
+    GN_INPUT,
+    GN_GAIN,
+    GN_SUM,
+    GN_FIR,
+    GN_BIQUAD,
+    GN_RESAMPLER,
+    GN_STFT,
+    GN_ISTFT,
+    GN_POWER,
+    GN_LOG_MEL,
+    GN_CUSTOM,
+    GN_VAD
+} gn_kind;
+
+typedef struct {
+    gn_kind kind;
+    size_t* srcs;
+    size_t num_srcs;
+
+    // Parameters, copied at add time
+    size_t input_index;         // INPUT
+    vv_dsp_real gain;           // GAIN
+    vv_dsp_real* coeffs;        // FIR
+    size_t num_taps;
+    vv_dsp_biquad* sections;    // BIQUAD
+    size_t num_sections;
+    unsigned int ratio_num;     // RESAMPLER
+    unsigned int ratio_den;
+    unsigned int sinc_taps;
+    vv_dsp_stft_params stft;    // STFT, ISTFT
+    size_t n_mels;              // LOG_MEL
+    vv_dsp_real fmin;
+    vv_dsp_real fmax;
+    vv_dsp_real log_epsilon;
+    vv_dsp_mel_variant variant;
+    vv_dsp_graph_kernel kernel; // CUSTOM
+    vv_dsp_vad* vad;            // VAD, not owned
+    vv_dsp_graph_gate_fn gate;  // any node, NULL = always runs
+    void* gate_user;
+
+    // Set by prepare
+    vv_dsp_graph_shape shape;
+    double signal_rate;         // rate of the audio the stream was derived from
+    size_t fft_size;            // SPECTRUM and the FRAMES made from it: analysing STFT size
+    int half;                   // ... and whether its spectrum is HALF
+    size_t last_use;            // last consumer, GRAPH_NONE for graph outputs
+    size_t slot;                // buffer slot, GRAPH_NONE for graph inputs
+    vv_dsp_fir_state fir;       // FIR below the crossover
+    vv_dsp_fft_convolver* conv; // FIR above it
+    vv_dsp_iir_plan* iir;
+    vv_dsp_resampler* rs;
+    vv_dsp_stft* st;
+    const vv_dsp_mel_sparse* fb;
+    const vv_dsp_real** src_data; // num_srcs, SUM and CUSTOM
+
+    // Per process call
+    vv_dsp_real* data;
+    size_t items;
+    int skipped;
+} gn_node;
+
+typedef struct {
+    size_t capacity;            // vv_dsp_real values
+    size_t busy_until;          // last consumer of the edge held now
+    size_t offset;              // into the arena, after planning
+} gn_slot;
+
+struct vv_dsp_graph {
+    gn_node* nodes;
+    size_t num_nodes;
+    size_t nodes_cap;
+    size_t num_inputs;
+    size_t* outputs;
+    size_t num_outputs;
+
+    int prepared;
+    size_t max_block;
+    gn_slot* slots;
+    size_t num_slots;
+    vv_dsp_real* arena;
+    size_t arena_reals;
+    size_t edge_reals;
+    vv_dsp_denormal_mode denormals;  // FP scope around each process call
+};
+
+// --------------- Construction ---------------
+
+static void node_release(gn_node* n) {
+    if (n->fir.history) vv_dsp_fir_state_free(&n->fir);
+    memset(&n->fir, 0, sizeof(n->fir));
+    vv_dsp_fft_convolver_destroy(n->conv);
+    n->conv = NULL;
+    vv_dsp_iir_plan_destroy(n->iir);
+    n->iir = NULL;
+    vv_dsp_resampler_destroy(n->rs);
+    n->rs = NULL;
+    if (n->st) (void)vv_dsp_stft_destroy(n->st);
+    n->st = NULL;
+    vv_dsp_mel_sparse_release(n->fb);
+    n->fb = NULL;
+    vv_dsp_free((void*)n->src_data);
+    n->src_data = NULL;
+}
+
+static void graph_unprepare(vv_dsp_graph* g) {
+    for (size_t i = 0; i < g->num_nodes; ++i) node_release(&g->nodes[i]);
+    vv_dsp_aligned_free(g->arena);
+    g->arena = NULL;
+    vv_dsp_free(g->slots);
+    g->slots = NULL;
+    g->num_slots = 0;
+    g->prepared = 0;
+}
+
+vv_dsp_status vv_dsp_graph_create(vv_dsp_graph** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = (vv_dsp_graph*)vv_dsp_calloc(1, sizeof(vv_dsp_graph));
+    return *out ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+void vv_dsp_graph_destroy(vv_dsp_graph* g) {
+    if (!g) return;
+    graph_unprepare(g);
+    for (size_t i = 0; i < g->num_nodes; ++i) {
+        vv_dsp_free(g->nodes[i].srcs);
+        vv_dsp_free(g->nodes[i].coeffs);
+        vv_dsp_free(g->nodes[i].sections);
+    }
+    vv_dsp_free(g->nodes);
+    vv_dsp_free(g->outputs);
+    vv_dsp_free(g);
+}
+
+// Append a node reading srcs; the caller fills in its parameters
+static vv_dsp_status graph_append(vv_dsp_graph* g, gn_kind kind, const vv_dsp_graph_node* srcs, size_t num_srcs,
+                                  gn_node** out) {
+    for (size_t k = 0; k < num_srcs; ++k) {
+        if (srcs[k] >= g->num_nodes) return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    if (g->num_nodes == g->nodes_cap) {
+        const size_t cap = g->nodes_cap ? g->nodes_cap * 2 : 16;
+        gn_node* p = (gn_node*)vv_dsp_realloc(g->nodes, cap * sizeof(gn_node));
+        if (!p) return VV_DSP_ERROR_INTERNAL;
+        g->nodes = p;
+        g->nodes_cap = cap;
+    }
+    gn_node* n = &g->nodes[g->num_nodes];
+    memset(n, 0, sizeof(*n));
+    if (num_srcs) {
+        n->srcs = (size_t*)vv_dsp_malloc(num_srcs * sizeof(size_t));
+        if (!n->srcs) return VV_DSP_ERROR_INTERNAL;
+        memcpy(n->srcs, srcs, num_srcs * sizeof(size_t));
+    }
+    n->kind = kind;
+    n->num_srcs = num_srcs;
+    graph_unprepare(g);
+    *out = n;
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status graph_commit(vv_dsp_graph* g, vv_dsp_graph_node* out_node) {
+    *out_node = g->num_nodes++;
+    return VV_DSP_OK;
+}
+
+// Drop a node appended but not committed
+static vv_dsp_status graph_abandon(vv_dsp_graph* g, vv_dsp_status s) {
+    gn_node* n = &g->nodes[g->num_nodes];
+    vv_dsp_free(n->srcs);
+    vv_dsp_free(n->coeffs);
+    vv_dsp_free(n->sections);
+    return s;
+}
+
+vv_dsp_status vv_dsp_graph_add_input(vv_dsp_graph* g, vv_dsp_graph_node* out_node) {
+    if (!g || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_INPUT, NULL, 0, &n);
+    if (s != VV_DSP_OK) return s;
+    n->input_index = g->num_inputs++;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_gain(vv_dsp_graph* g, vv_dsp_graph_node src, vv_dsp_real gain,
+                                    vv_dsp_graph_node* out_node) {
+    if (!g || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_GAIN, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->gain = gain;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_sum(vv_dsp_graph* g, const vv_dsp_graph_node* srcs, size_t num_srcs,
+                                   vv_dsp_graph_node* out_node) {
+    if (!g || !srcs || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_srcs == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_SUM, srcs, num_srcs, &n);
+    if (s != VV_DSP_OK) return s;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_fir(vv_dsp_graph* g, vv_dsp_graph_node src, const vv_dsp_real* coeffs,
+                                   size_t num_taps, vv_dsp_graph_node* out_node) {
+    if (!g || !coeffs || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_taps == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_FIR, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->coeffs = (vv_dsp_real*)vv_dsp_malloc(num_taps * sizeof(vv_dsp_real));
+    if (!n->coeffs) return graph_abandon(g, VV_DSP_ERROR_INTERNAL);
+    memcpy(n->coeffs, coeffs, num_taps * sizeof(vv_dsp_real));
+    n->num_taps = num_taps;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_biquad(vv_dsp_graph* g, vv_dsp_graph_node src, const vv_dsp_biquad* sections,
+                                      size_t num_sections, vv_dsp_graph_node* out_node) {
+    if (!g || !sections || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_sections == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_BIQUAD, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->sections = (vv_dsp_biquad*)vv_dsp_malloc(num_sections * sizeof(vv_dsp_biquad));
+    if (!n->sections) return graph_abandon(g, VV_DSP_ERROR_INTERNAL);
+    memcpy(n->sections, sections, num_sections * sizeof(vv_dsp_biquad));
+    n->num_sections = num_sections;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_resampler(vv_dsp_graph* g, vv_dsp_graph_node src, unsigned int ratio_num,
+                                         unsigned int ratio_den, unsigned int sinc_taps,
+                                         vv_dsp_graph_node* out_node) {
+    if (!g || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (ratio_num == 0 || ratio_den == 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_RESAMPLER, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->ratio_num = ratio_num;
+    n->ratio_den = ratio_den;
+    n->sinc_taps = sinc_taps;
+    return graph_commit(g, out_node);
+}
+
+static vv_dsp_status graph_add_stft_kind(vv_dsp_graph* g, gn_kind kind, vv_dsp_graph_node src,
+                                         const vv_dsp_stft_params* params, vv_dsp_graph_node* out_node) {
+    if (!g || !params || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (params->fft_size == 0 || params->hop_size == 0 || params->hop_size > params->fft_size) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, kind, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->stft = *params;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_stft(vv_dsp_graph* g, vv_dsp_graph_node src, const vv_dsp_stft_params* params,
+                                    vv_dsp_graph_node* out_node) {
+    return graph_add_stft_kind(g, GN_STFT, src, params, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_istft(vv_dsp_graph* g, vv_dsp_graph_node src, const vv_dsp_stft_params* params,
+                                     vv_dsp_graph_node* out_node) {
+    return graph_add_stft_kind(g, GN_ISTFT, src, params, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_power(vv_dsp_graph* g, vv_dsp_graph_node src, vv_dsp_graph_node* out_node) {
+    if (!g || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_POWER, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_log_mel(vv_dsp_graph* g, vv_dsp_graph_node src, size_t n_mels, vv_dsp_real fmin,
+                                       vv_dsp_real fmax, vv_dsp_mel_variant variant, vv_dsp_real log_epsilon,
+                                       vv_dsp_graph_node* out_node) {
+    if (!g || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (n_mels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (fmin < 0 || fmax < 0 || log_epsilon < 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_LOG_MEL, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->n_mels = n_mels;
+    n->fmin = fmin;
+    n->fmax = fmax;
+    n->variant = variant;
+    n->log_epsilon = log_epsilon > 0 ? log_epsilon : (vv_dsp_real)1e-10;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_custom(vv_dsp_graph* g, const vv_dsp_graph_node* srcs, size_t num_srcs,
+                                      const vv_dsp_graph_kernel* kernel, vv_dsp_graph_node* out_node) {
+    if (!g || !srcs || !kernel || !kernel->process || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_srcs == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_CUSTOM, srcs, num_srcs, &n);
+    if (s != VV_DSP_OK) return s;
+    n->kernel = *kernel;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_add_vad(vv_dsp_graph* g, vv_dsp_graph_node src, vv_dsp_vad* vad,
+                                   vv_dsp_graph_node* out_node) {
+    if (!g || !vad || !out_node) return VV_DSP_ERROR_NULL_POINTER;
+    gn_node* n;
+    vv_dsp_status s = graph_append(g, GN_VAD, &src, 1, &n);
+    if (s != VV_DSP_OK) return s;
+    n->vad = vad;
+    return graph_commit(g, out_node);
+}
+
+vv_dsp_status vv_dsp_graph_set_gate(vv_dsp_graph* g, vv_dsp_graph_node node, vv_dsp_graph_gate_fn gate,
+                                    void* user) {
+    if (!g) return VV_DSP_ERROR_NULL_POINTER;
+    if (node >= g->num_nodes) return VV_DSP_ERROR_OUT_OF_RANGE;
+    g->nodes[node].gate = gate;
+    g->nodes[node].gate_user = user;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_add_output(vv_dsp_graph* g, vv_dsp_graph_node src, size_t* out_index) {
+    if (!g || !out_index) return VV_DSP_ERROR_NULL_POINTER;
+    if (src >= g->num_nodes) return VV_DSP_ERROR_OUT_OF_RANGE;
+    size_t* p = (size_t*)vv_dsp_realloc(g->outputs, (g->num_outputs + 1) * sizeof(size_t));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    g->outputs = p;
+    graph_unprepare(g);
+    *out_index = g->num_outputs;
+    g->outputs[g->num_outputs++] = src;
+    return VV_DSP_OK;
+}
+
+// --------------- Preparation ---------------
+
+static int same_rate(double a, double b) {
+    return fabs(a - b) <= 1e-9 * (a > b ? a : b);
+}
+
+// Derive a node's shape from its sources and create its module objects
+static vv_dsp_status node_prepare(vv_dsp_graph* g, gn_node* n, double sample_rate) {
+    const gn_node* in = n->num_srcs ? &g->nodes[n->srcs[0]] : NULL;
+    if (in) {
+        n->shape = in->shape;
+        n->signal_rate = in->signal_rate;
+        n->fft_size = in->fft_size;
+        n->half = in->half;
+    }
+    const int needs_signal = n->kind == GN_FIR || n->kind == GN_BIQUAD || n->kind == GN_RESAMPLER ||
+                             n->kind == GN_STFT || n->kind == GN_VAD;
+    if (needs_signal && in->shape.stream != VV_DSP_GRAPH_SIGNAL) return VV_DSP_ERROR_INVALID_SIZE;
+    if ((n->kind == GN_ISTFT || n->kind == GN_POWER) && in->shape.stream != VV_DSP_GRAPH_SPECTRUM) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_status s = VV_DSP_OK;
+    switch (n->kind) {
+    case GN_INPUT:
+        n->shape.stream = VV_DSP_GRAPH_SIGNAL;
+        n->shape.width = 1;
+        n->shape.max_items = g->max_block;
+        n->shape.item_rate = sample_rate;
+        n->signal_rate = sample_rate;
+        break;
+    case GN_SUM:
+    case GN_CUSTOM:
+        for (size_t k = 1; k < n->num_srcs; ++k) {
+            const gn_node* other = &g->nodes[n->srcs[k]];
+            if (other->shape.stream != in->shape.stream || other->shape.width != in->shape.width) {
+                return VV_DSP_ERROR_INVALID_SIZE;
+            }
+            if (!same_rate(other->shape.item_rate, in->shape.item_rate)) return VV_DSP_ERROR_OUT_OF_RANGE;
+            if (other->shape.max_items > n->shape.max_items) n->shape.max_items = other->shape.max_items;
+        }
+        n->src_data = (const vv_dsp_real**)vv_dsp_calloc(n->num_srcs, sizeof(vv_dsp_real*));
+        if (!n->src_data) return VV_DSP_ERROR_INTERNAL;
+        break;
+    case GN_GAIN:
+    case GN_VAD:
+        break;
+    case GN_FIR:
+        if (n->num_taps < vv_dsp_conv_get_crossover()) {
+            s = vv_dsp_fir_state_init(&n->fir, n->num_taps);
+            if (s == VV_DSP_OK) s = vv_dsp_fir_state_prepare(&n->fir, in->shape.max_items);
+        } else {
+            s = vv_dsp_fft_convolver_create(n->coeffs, n->num_taps, in->shape.max_items, &n->conv);
+        }
+        break;
+    case GN_BIQUAD:
+        s = vv_dsp_iir_make_plan(n->sections, n->num_sections, VV_DSP_IIR_REALIZATION_BLOCK, &n->iir);
+        break;
+    case GN_RESAMPLER:
+        n->rs = vv_dsp_resampler_create(n->ratio_num, n->ratio_den);
+        if (!n->rs) return VV_DSP_ERROR_INTERNAL;
+        s = (vv_dsp_status)vv_dsp_resampler_set_quality(n->rs, n->sinc_taps != 0, n->sinc_taps);
+        if (s == VV_DSP_OK) s = (vv_dsp_status)vv_dsp_resampler_prepare(n->rs, in->shape.max_items);
+        // Worst case: every input completes ratio outputs, plus the fractional carry
+        n->shape.max_items = (size_t)(((uint64_t)in->shape.max_items * n->ratio_num + n->ratio_den - 1) /
+                                      n->ratio_den) + 2;
+        n->shape.item_rate = in->shape.item_rate * n->ratio_num / n->ratio_den;
+        n->signal_rate = n->shape.item_rate;
+        break;
+    case GN_STFT:
+        s = vv_dsp_stft_create(&n->stft, &n->st);
+        if (s == VV_DSP_OK) s = vv_dsp_stft_prepare(n->st, in->shape.max_items);
+        if (s != VV_DSP_OK) break;
+        // Fewer than fft_size samples stay buffered once every ready frame is popped
+        n->shape.stream = VV_DSP_GRAPH_SPECTRUM;
+        n->shape.width = 2 * vv_dsp_stft_num_bins(n->st);
+        n->shape.max_items = (in->shape.max_items + n->stft.hop_size - 1) / n->stft.hop_size;
+        n->shape.item_rate = in->shape.item_rate / (double)n->stft.hop_size;
+        n->fft_size = n->stft.fft_size;
+        n->half = n->stft.spectrum == VV_DSP_STFT_SPECTRUM_HALF;
+        break;
+    case GN_ISTFT:
+        s = vv_dsp_stft_create(&n->stft, &n->st);
+        if (s == VV_DSP_OK) s = vv_dsp_stft_prepare(n->st, n->stft.hop_size);
+        if (s != VV_DSP_OK) break;
+        if (in->shape.width != 2 * vv_dsp_stft_num_bins(n->st)) return VV_DSP_ERROR_INVALID_SIZE;
+        n->shape.stream = VV_DSP_GRAPH_SIGNAL;
+        n->shape.width = 1;
+        n->shape.max_items = in->shape.max_items * n->stft.hop_size;
+        n->shape.item_rate = in->shape.item_rate * (double)n->stft.hop_size;
+        break;
+    case GN_POWER:
+        n->shape.stream = VV_DSP_GRAPH_FRAMES;
+        n->shape.width = in->shape.width / 2;
+        break;
+    case GN_LOG_MEL: {
+        if (in->shape.stream != VV_DSP_GRAPH_FRAMES || !in->half || in->shape.width != in->fft_size / 2 + 1) {
+            return VV_DSP_ERROR_INVALID_SIZE;
+        }
+        const vv_dsp_real rate = (vv_dsp_real)in->signal_rate;
+        const vv_dsp_real fmax = n->fmax > 0 ? n->fmax : rate / 2;
+        s = vv_dsp_mel_sparse_acquire(in->fft_size, n->n_mels, rate, n->fmin, fmax, n->variant, &n->fb);
+        n->shape.width = n->n_mels;
+        break;
+    }
+    }
+    return s;
+}
+
+// Liveness planning: each edge takes a slot that no live edge holds, preferring the
+// smallest one that already fits; in-place nodes take over their input's slot when
+// they are its last reader. Graph outputs are never released.
+static vv_dsp_status graph_plan(vv_dsp_graph* g) {
+    for (size_t i = 0; i < g->num_nodes; ++i) g->nodes[i].last_use = i;
+    for (size_t i = 0; i < g->num_nodes; ++i) {
+        const gn_node* n = &g->nodes[i];
+        for (size_t k = 0; k < n->num_srcs; ++k) g->nodes[n->srcs[k]].last_use = i;
+    }
+    for (size_t o = 0; o < g->num_outputs; ++o) g->nodes[g->outputs[o]].last_use = GRAPH_NONE;
+
+    g->slots = (gn_slot*)vv_dsp_calloc(g->num_nodes, sizeof(gn_slot));
+    if (!g->slots) return VV_DSP_ERROR_INTERNAL;
+    g->edge_reals = 0;
+    for (size_t i = 0; i < g->num_nodes; ++i) {
+        gn_node* n = &g->nodes[i];
+        n->slot = GRAPH_NONE;
+        if (n->kind == GN_INPUT) continue;
+        const size_t need = n->shape.max_items * n->shape.width;
+        g->edge_reals += need;
+
+        const gn_node* in = &g->nodes[n->srcs[0]];
+        const int in_place = (n->kind == GN_GAIN || n->kind == GN_FIR || n->kind == GN_BIQUAD ||
+                              n->kind == GN_POWER || n->kind == GN_VAD) &&
+                             in->slot != GRAPH_NONE && in->last_use == i;
+        size_t best = GRAPH_NONE;
+        if (in_place) {
+            best = in->slot;
+        } else {
+            // Smallest free slot that fits, else the largest free one (grown), else a new one
+            size_t largest = GRAPH_NONE;
+            for (size_t k = 0; k < g->num_slots; ++k) {
+                const gn_slot* sl = &g->slots[k];
+                if (sl->busy_until >= i) continue;  // still read by node busy_until or later
+                if (sl->capacity >= need && (best == GRAPH_NONE || sl->capacity < g->slots[best].capacity)) best = k;
+                if (largest == GRAPH_NONE || sl->capacity > g->slots[largest].capacity) largest = k;
+            }
+            if (best == GRAPH_NONE) best = largest;
+            if (best == GRAPH_NONE) best = g->num_slots++;
+        }
+        gn_slot* sl = &g->slots[best];
+        if (sl->capacity < need) sl->capacity = need;
+        sl->busy_until = n->last_use;
+        n->slot = best;
+    }
+
+    g->arena_reals = 0;
+    for (size_t k = 0; k < g->num_slots; ++k) {
+        g->slots[k].offset = g->arena_reals;
+        g->arena_reals += (g->slots[k].capacity + GRAPH_ALIGN_REALS - 1) / GRAPH_ALIGN_REALS * GRAPH_ALIGN_REALS;
+    }
+    if (g->arena_reals) {
+        g->arena = (vv_dsp_real*)vv_dsp_aligned_malloc(g->arena_reals * sizeof(vv_dsp_real), 64);
+        if (!g->arena) return VV_DSP_ERROR_INTERNAL;
+        memset(g->arena, 0, g->arena_reals * sizeof(vv_dsp_real));
+    }
+    for (size_t i = 0; i < g->num_nodes; ++i) {
+        gn_node* n = &g->nodes[i];
+        n->data = n->slot != GRAPH_NONE ? g->arena + g->slots[n->slot].offset : NULL;
+        n->items = 0;
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_prepare(vv_dsp_graph* g, size_t max_block, double sample_rate) {
+    if (!g) return VV_DSP_ERROR_NULL_POINTER;
+    if (max_block == 0 || g->num_nodes == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(sample_rate > 0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    graph_unprepare(g);
+    g->max_block = max_block;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t i = 0; i < g->num_nodes && s == VV_DSP_OK; ++i) s = node_prepare(g, &g->nodes[i], sample_rate);
+    if (s == VV_DSP_OK) s = graph_plan(g);
+    if (s != VV_DSP_OK) {
+        graph_unprepare(g);
+        return s;
+    }
+    g->prepared = 1;
+    return VV_DSP_OK;
+}
+
+// --------------- Processing ---------------
+
+static vv_dsp_status node_process(vv_dsp_graph* g, gn_node* n, const vv_dsp_real* const* inputs,
+                                  size_t num_samples) {
+    const gn_node* in = n->num_srcs ? &g->nodes[n->srcs[0]] : NULL;
+    const size_t items = in ? in->items : 0;
+    const size_t width = n->shape.width;
+    vv_dsp_real* out = n->data;
+    vv_dsp_status s = VV_DSP_OK;
+
+    switch (n->kind) {
+    case GN_INPUT:
+        // Never written: in-place nodes skip graph inputs
+        n->data = (vv_dsp_real*)(uintptr_t)inputs[n->input_index];
+        n->items = num_samples;
+        return VV_DSP_OK;
+    case GN_GAIN: {
+        const size_t count = items * width;
+        for (size_t j = 0; j < count; ++j) out[j] = in->data[j] * n->gain;
+        n->items = items;
+        return VV_DSP_OK;
+    }
+    case GN_SUM:
+    case GN_CUSTOM:
+        for (size_t k = 0; k < n->num_srcs; ++k) {
+            const gn_node* src = &g->nodes[n->srcs[k]];
+            if (src->items != items) return VV_DSP_ERROR_INVALID_SIZE;
+            n->src_data[k] = src->data;
+        }
+        n->items = items;
+        if (n->kind == GN_CUSTOM) {
+            return n->kernel.process(n->kernel.user, n->src_data, n->num_srcs, items, width, out);
+        }
+        memcpy(out, n->src_data[0], items * width * sizeof(vv_dsp_real));
+        for (size_t k = 1; k < n->num_srcs; ++k) {
+            const vv_dsp_real* x = n->src_data[k];
+            for (size_t j = 0; j < items * width; ++j) out[j] += x[j];
+        }
+        return VV_DSP_OK;
+    case GN_FIR:
+        n->items = items;
+        if (!items) return VV_DSP_OK;
+        if (n->conv) return vv_dsp_fft_convolver_process(n->conv, in->data, out, items);
+        return vv_dsp_fir_apply(&n->fir, n->coeffs, in->data, out, items);
+    case GN_BIQUAD:
+        n->items = items;
+        return items ? vv_dsp_iir_plan_apply(n->iir, in->data, out, items) : VV_DSP_OK;
+    case GN_RESAMPLER: {
+        size_t got = 0;
+        n->items = 0;
+        s = (vv_dsp_status)vv_dsp_resampler_process_stream(n->rs, in->data, items, out, n->shape.max_items, &got);
+        n->items = got;
+        return s;
+    }
+    case GN_STFT: {
+        n->items = 0;
+        if (items) s = vv_dsp_stft_push(n->st, in->data, items);
+        while (s == VV_DSP_OK && vv_dsp_stft_frames_ready(n->st) > 0) {
+            if (n->items == n->shape.max_items) return VV_DSP_ERROR_INTERNAL;
+            s = vv_dsp_stft_pop_frame(n->st, (vv_dsp_cpx*)(void*)(out + n->items * width));
+            if (s == VV_DSP_OK) n->items++;
+        }
+        return s;
+    }
+    case GN_ISTFT:
+        n->items = 0;
+        for (size_t f = 0; f < items && s == VV_DSP_OK; ++f) {
+            s = vv_dsp_stft_synth_frame(n->st, (const vv_dsp_cpx*)(const void*)(in->data + f * in->shape.width),
+                                        out + f * n->stft.hop_size);
+        }
+        if (s == VV_DSP_OK) n->items = items * n->stft.hop_size;
+        return s;
+    case GN_POWER:
+        // The power kernel may run in place over the front of its complex input
+        s = vv_dsp_cpx_power_array((const vv_dsp_cpx*)(const void*)in->data, out, items * width);
+        if (s == VV_DSP_OK) n->items = items;
+        return s;
+    case GN_LOG_MEL:
+        for (size_t f = 0; f < items && s == VV_DSP_OK; ++f) {
+            vv_dsp_real* m = out + f * width;
+            s = vv_dsp_mel_sparse_project(n->fb, in->data + f * in->shape.width, m);
+            for (size_t b = 0; b < width; ++b) m[b] = VV_DSP_LOG(m[b] + n->log_epsilon);
+        }
+        n->items = s == VV_DSP_OK ? items : 0;
+        return s;
+    case GN_VAD:
+        n->items = 0;
+        s = vv_dsp_vad_process(n->vad, in->data, items, NULL, 0, NULL);
+        if (s != VV_DSP_OK) return s;
+        if (out != in->data) memcpy(out, in->data, items * sizeof(vv_dsp_real));
+        n->items = items;
+        return VV_DSP_OK;
+    }
+    return VV_DSP_ERROR_INTERNAL;
+}
+
+vv_dsp_status vv_dsp_graph_process(vv_dsp_graph* g, const vv_dsp_real* const* inputs, size_t num_samples) {
+    if (!g) return VV_DSP_ERROR_NULL_POINTER;
+    if (!g->prepared) return VV_DSP_ERROR_INTERNAL;
+    if (g->num_inputs && !inputs) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_samples > g->max_block) return VV_DSP_ERROR_INVALID_SIZE;
+    for (size_t k = 0; k < g->num_inputs; ++k) {
+        if (!inputs[k]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    // One scope for the whole schedule: nodes with their own mode then find it set
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, g->denormals);
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t i = 0; i < g->num_nodes && s == VV_DSP_OK; ++i) {
+        gn_node* n = &g->nodes[i];
+        if (n->slot != GRAPH_NONE) n->data = g->arena + g->slots[n->slot].offset;
+        // Skipped: gated off, or reading a skipped node
+        n->skipped = n->gate && !n->gate(n->gate_user);
+        for (size_t k = 0; k < n->num_srcs && !n->skipped; ++k) n->skipped = g->nodes[n->srcs[k]].skipped;
+        if (n->skipped) {
+            n->items = 0;
+            continue;
+        }
+        s = node_process(g, n, inputs, num_samples);
+    }
+    vv_dsp_fp_scope_exit(&fp);
+    return s;
+}
+
+vv_dsp_status vv_dsp_graph_set_denormals(vv_dsp_graph* g, vv_dsp_denormal_mode mode) {
+    if (!g) return VV_DSP_ERROR_NULL_POINTER;
+    if (mode != VV_DSP_DENORMALS_KEEP && mode != VV_DSP_DENORMALS_FLUSH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    g->denormals = mode;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_output(const vv_dsp_graph* g, size_t index, const vv_dsp_real** out_data,
+                                  size_t* out_items) {
+    if (!g || !out_data || !out_items) return VV_DSP_ERROR_NULL_POINTER;
+    if (index >= g->num_outputs) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!g->prepared) return VV_DSP_ERROR_INTERNAL;
+    const gn_node* n = &g->nodes[g->outputs[index]];
+    *out_data = n->data;
+    *out_items = n->items;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_node_shape(const vv_dsp_graph* g, vv_dsp_graph_node node, vv_dsp_graph_shape* out_shape) {
+    if (!g || !out_shape) return VV_DSP_ERROR_NULL_POINTER;
+    if (node >= g->num_nodes) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!g->prepared) return VV_DSP_ERROR_INTERNAL;
+    *out_shape = g->nodes[node].shape;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_get_info(const vv_dsp_graph* g, vv_dsp_graph_info* out_info) {
+    if (!g || !out_info) return VV_DSP_ERROR_NULL_POINTER;
+    if (!g->prepared) return VV_DSP_ERROR_INTERNAL;
+    out_info->num_nodes = g->num_nodes;
+    out_info->num_buffers = g->num_slots;
+    out_info->buffer_bytes = g->arena_reals * sizeof(vv_dsp_real);
+    out_info->edge_bytes = g->edge_reals * sizeof(vv_dsp_real);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_graph_reset(vv_dsp_graph* g) {
+    if (!g) return VV_DSP_ERROR_NULL_POINTER;
+    if (!g->prepared) return VV_DSP_OK;
+    for (size_t i = 0; i < g->num_nodes; ++i) {
+        gn_node* n = &g->nodes[i];
+        if (n->fir.history) {
+            memset(n->fir.history, 0, (n->fir.history_size + n->fir.stage_size) * sizeof(vv_dsp_real));
+        }
+        if (n->conv) (void)vv_dsp_fft_convolver_reset(n->conv);
+        if (n->iir) (void)vv_dsp_iir_plan_reset(n->iir);
+        if (n->rs) (void)vv_dsp_resampler_reset(n->rs);
+        if (n->st && n->kind == GN_STFT) (void)vv_dsp_stft_stream_reset(n->st);
+        if (n->st && n->kind == GN_ISTFT) (void)vv_dsp_stft_synth_reset(n->st);
+        if (n->vad) (void)vv_dsp_vad_reset(n->vad);
+        n->items = 0;
+    }
+    return VV_DSP_OK;
+}
@@ -0,0 +1,248 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/resample/asrc.h"
+#include "vv_dsp/core/alloc.h"
+#include "resample_kernel.h"
+
+// Fractional positions in the kernel table (rows = ASRC_PHASES + 1 so position 1.0
+// has its own row for the interpolation)
+#define ASRC_PHASES 512u
+// Input samples appended to the stream buffer per pass
+#define ASRC_CHUNK 1024u
+
+// Read position and ratio ramp; the next output sits at center + frac
+typedef struct {
+    int64_t center;
+    double frac;             // [0, 1)
+    double ratio;            // ratio of the next output
+    double target;
+    double inc;              // per-output ratio increment while ramping
+    size_t ramp;             // outputs left in the ramp
+} asrc_pos;
+
+struct vv_dsp_asrc {
+    unsigned int taps;
+    vv_dsp_real* table;      // (ASRC_PHASES + 1) x taps
+    // buf holds inputs from absolute index buf_start (negative while the left edge is
+    // padded with the first sample) up to n_in
+    vv_dsp_real* buf;
+    size_t buf_len;
+    size_t buf_cap;
+    int64_t buf_start;
+    uint64_t n_in;
+    asrc_pos pos;
+    vv_dsp_real last;        // most recent input (right-edge padding at flush)
+};
+
+static int valid_ratio(double r) { return isfinite(r) && r > 0.0; }
+
+static void pos_advance(asrc_pos* p) {
+    p->frac += 1.0 / p->ratio;
+    const double whole = floor(p->frac);
+    p->center += (int64_t)whole;
+    p->frac -= whole;
+    if (p->ramp) {
+        if (--p->ramp == 0) p->ratio = p->target;
+        else p->ratio += p->inc;
+    }
+}
+
+static void finish_ramp(asrc_pos* p) {
+    p->ratio = p->target;
+    p->inc = 0.0;
+    p->ramp = 0;
+}
+
+static void stream_reset(vv_dsp_asrc* a) {
+    a->buf_len = 0;
+    a->buf_start = 0;
+    a->n_in = 0;
+    a->pos.center = 0;
+    a->pos.frac = 0.0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_create(double ratio, unsigned int taps, vv_dsp_asrc** out_asrc) {
+    if (!out_asrc) return VV_DSP_ERROR_NULL_POINTER;
+    *out_asrc = NULL;
+    if (!valid_ratio(ratio)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (taps < 4) taps = 4;
+    if (taps > 128) taps = 128;
+    if (taps % 2) ++taps;
+    vv_dsp_asrc* a = (vv_dsp_asrc*)vv_dsp_calloc(1, sizeof(*a));
+    if (!a) return VV_DSP_ERROR_INTERNAL;
+    a->taps = taps;
+    a->table = (vv_dsp_real*)vv_dsp_malloc((size_t)(ASRC_PHASES + 1) * taps * sizeof(vv_dsp_real));
+    a->buf_cap = (size_t)taps + ASRC_CHUNK;
+    a->buf = (vv_dsp_real*)vv_dsp_malloc(a->buf_cap * sizeof(vv_dsp_real));
+    if (!a->table || !a->buf) {
+        vv_dsp_asrc_destroy(a);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    const vv_dsp_real* win = NULL;
+    if (vv_dsp_resample_window_acquire(taps, &win) != VV_DSP_OK) {
+        vv_dsp_asrc_destroy(a);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    const double cutoff = fmin(1.0, ratio);
+    for (unsigned int p = 0; p <= ASRC_PHASES; ++p)
+        vv_dsp_resample_sinc_row(a->table + (size_t)p * taps, taps, cutoff, (double)p / (double)ASRC_PHASES, win);
+    vv_dsp_window_release(win);
+    a->pos.target = ratio;
+    finish_ramp(&a->pos);
+    stream_reset(a);
+    *out_asrc = a;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_asrc_destroy(vv_dsp_asrc* a) {
+    if (!a) return;
+    vv_dsp_free(a->table);
+    vv_dsp_free(a->buf);
+    vv_dsp_free(a);
+}
+
+vv_dsp_status vv_dsp_asrc_set_ratio(vv_dsp_asrc* a, double ratio, size_t ramp_outputs) {
+    if (!a) return VV_DSP_ERROR_NULL_POINTER;
+    if (!valid_ratio(ratio)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    a->pos.target = ratio;
+    if (ramp_outputs == 0) {
+        finish_ramp(&a->pos);
+    } else {
+        a->pos.inc = (ratio - a->pos.ratio) / (double)ramp_outputs;
+        a->pos.ramp = ramp_outputs;
+    }
+    return VV_DSP_OK;
+}
+
+double vv_dsp_asrc_get_ratio(const vv_dsp_asrc* a) {
+    return a ? a->pos.ratio : 0.0;
+}
+
+// Outputs that can be completed with extra more inputs (flushing: every output at an
+// input position <= the last sample, with the right edge padded)
+static size_t asrc_ready(const vv_dsp_asrc* a, size_t extra, int flushing) {
+    const uint64_t avail = a->n_in + extra;
+    if (avail == 0) return 0;
+    const int64_t half = (int64_t)(a->taps / 2);
+    asrc_pos p = a->pos;
+    size_t count = 0;
+    if (flushing) {
+        const double last = (double)(avail - 1);
+        while ((double)p.center + p.frac <= last) {
+            ++count;
+            pos_advance(&p);
+        }
+    } else {
+        while (p.center + half <= (int64_t)avail) {
+            ++count;
+            pos_advance(&p);
+        }
+    }
+    return count;
+}
+
+size_t vv_dsp_asrc_out_needed(const vv_dsp_asrc* a, size_t in_n) {
+    if (!a) return 0;
+    return asrc_ready(a, in_n, 0);
+}
+
+// Write count outputs from the buffer, advancing the read position
+static void asrc_produce(vv_dsp_asrc* a, size_t count, vv_dsp_real* out) {
+    const unsigned int taps = a->taps;
+    const int64_t half = (int64_t)(taps / 2);
+    for (size_t k = 0; k < count; ++k) {
+        const vv_dsp_real* b = a->buf + (a->pos.center - half - a->buf_start);
+        const double fp = a->pos.frac * (double)ASRC_PHASES;
+        unsigned int p = (unsigned int)fp;
+        if (p >= ASRC_PHASES) p = ASRC_PHASES - 1;
+        const vv_dsp_real* r0 = a->table + (size_t)p * taps;
+        // Interpolating the two dot products equals the dot with the interpolated row
+        const double y0 = rs_dot(r0, b, taps);
+        const double y1 = rs_dot(r0 + taps, b, taps);
+        out[k] = (vv_dsp_real)(y0 + (fp - (double)p) * (y1 - y0));
+        pos_advance(&a->pos);
+    }
+    // Drop the samples no later output reads
+    const int64_t keep = a->pos.center - half;
+    if (keep > a->buf_start) {
+        const int64_t drop = keep - a->buf_start;
+        if ((uint64_t)drop >= a->buf_len) {
+            a->buf_len = 0;
+        } else {
+            memmove(a->buf, a->buf + drop, (a->buf_len - (size_t)drop) * sizeof(vv_dsp_real));
+            a->buf_len -= (size_t)drop;
+        }
+        a->buf_start = keep;
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_process(vv_dsp_asrc* a,
+                                                   const vv_dsp_real* in, size_t in_n,
+                                                   vv_dsp_real* out, size_t out_cap,
+                                                   size_t* out_n) {
+    if (!a || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    if (in_n == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t want = asrc_ready(a, in_n, 0);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !out) return VV_DSP_ERROR_NULL_POINTER;
+    const unsigned int half = a->taps / 2;
+    size_t pos = 0, k = 0;
+    while (pos < in_n) {
+        if (a->n_in == 0) {
+            // Left edge: the first sample repeats
+            for (unsigned int j = 0; j < half; ++j) a->buf[j] = in[0];
+            a->buf_len = half;
+            a->buf_start = -(int64_t)half;
+        }
+        size_t c = a->buf_cap - a->buf_len;
+        if (c > in_n - pos) c = in_n - pos;
+        if (a->buf_len == 0 && a->buf_start > (int64_t)a->n_in) {
+            // Strong downsampling: the next output does not read these samples
+            const uint64_t gap = (uint64_t)a->buf_start - a->n_in;
+            const size_t skip = (gap < c) ? (size_t)gap : c;
+            a->n_in += skip;
+            pos += skip;
+            c -= skip;
+            if (c == 0) continue;
+        }
+        memcpy(a->buf + a->buf_len, in + pos, c * sizeof(vv_dsp_real));
+        a->buf_len += c;
+        a->n_in += c;
+        pos += c;
+        a->last = in[pos - 1];
+        const size_t r = asrc_ready(a, 0, 0);
+        asrc_produce(a, r, out + k);
+        k += r;
+    }
+    *out_n = k;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_asrc_flush(vv_dsp_asrc* a, vv_dsp_real* out, size_t out_cap, size_t* out_n) {
+    if (!a || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    const size_t want = asrc_ready(a, 0, 1);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want) {
+        if (!out) return VV_DSP_ERROR_NULL_POINTER;
+        // Right edge: pad with the last sample so every remaining window is complete
+        const unsigned int la = a->taps / 2 - 1;
+        for (unsigned int j = 0; j < la; ++j) a->buf[a->buf_len + j] = a->last;
+        a->buf_len += la;
+        asrc_produce(a, want, out);
+    }
+    *out_n = want;
+    stream_reset(a);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_asrc_reset(vv_dsp_asrc* a) {
+    if (!a) return VV_DSP_ERROR_NULL_POINTER;
+    finish_ramp(&a->pos);
+    stream_reset(a);
+    return VV_DSP_OK;
+}
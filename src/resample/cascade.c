@@ -0,0 +1,381 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/resample/cascade.h"
+#include "vv_dsp/resample/resampler.h"
+#include "vv_dsp/core/alloc.h"
+
+// Input samples fed to the first stage per pass
+#define CASCADE_CHUNK 4096u
+// 32 half-bands cover any unsigned ratio, plus the fractional stage
+#define CASCADE_MAX_STAGES 34u
+#define CASCADE_MAX_HALF_TAPS 256u
+
+typedef enum { STAGE_HB_DOWN, STAGE_HB_UP, STAGE_FRAC } stage_kind;
+
+typedef struct {
+    stage_kind kind;
+    double ratio;            // output rate / input rate
+    unsigned int look;       // inputs after an output's position that it reads
+    size_t max_in;           // largest input block
+    // Half-band: nonzero taps g[j] at offsets +-(2j + 1) around the 0.5 center tap
+    vv_dsp_real* g;
+    unsigned int K;
+    // Half-band stream: buf holds inputs from absolute index buf_start (negative while
+    // the left edge is padded) up to n_in; next is the next output's input position
+    vv_dsp_real* buf;
+    size_t buf_len;
+    size_t buf_cap;
+    int64_t buf_start;
+    uint64_t n_in;
+    int64_t next;
+    vv_dsp_real last;
+    vv_dsp_resampler* rs;    // fractional stage
+    vv_dsp_real* out;        // outputs handed to the next stage
+    size_t out_cap;
+} cascade_stage;
+
+struct vv_dsp_resample_cascade {
+    size_t num_stages;
+    cascade_stage st[CASCADE_MAX_STAGES];
+};
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    while (b) {
+        const uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function of the first kind (Kaiser window)
+static double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0;
+    const double q = 0.25 * x * x;
+    for (int k = 1; k < 64; ++k) {
+        term *= q / ((double)k * (double)k);
+        sum += term;
+        if (term < 1e-17 * sum) break;
+    }
+    return sum;
+}
+
+// Half-band keeping [0, fp] and rejecting [0.5 - fp, 0.5] (cycles per sample at the
+// high rate) by atten_db: Kaiser-windowed 0.5 sinc(n / 2), odd taps only
+static int design_halfband(cascade_stage* s, double fp, double atten_db) {
+    const double df = 0.5 - 2.0 * fp;
+    const double order = (atten_db - 8.0) / (2.285 * VV_DSP_TWO_PI_D * df);
+    unsigned int K = (unsigned int)ceil((order + 2.0) / 4.0);
+    if (K < 1) K = 1;
+    if (K > CASCADE_MAX_HALF_TAPS) K = CASCADE_MAX_HALF_TAPS;
+    double beta = 0.0;
+    if (atten_db > 50.0) beta = 0.1102 * (atten_db - 8.7);
+    else if (atten_db > 21.0) beta = 0.5842 * pow(atten_db - 21.0, 0.4) + 0.07886 * (atten_db - 21.0);
+    s->g = (vv_dsp_real*)vv_dsp_malloc(K * sizeof(vv_dsp_real));
+    if (!s->g) return 0;
+    const double M = 2.0 * (double)K, i0b = bessel_i0(beta);
+    double w[CASCADE_MAX_HALF_TAPS], sum = 0.0;
+    for (unsigned int j = 0; j < K; ++j) {
+        const double n = 2.0 * (double)j + 1.0, r = n / M;
+        const double sinc = ((j & 1) ? -1.0 : 1.0) / (VV_DSP_PI_D * (double)j + 0.5 * VV_DSP_PI_D);
+        w[j] = 0.5 * sinc * bessel_i0(beta * sqrt(1.0 - r * r)) / i0b;
+        sum += w[j];
+    }
+    // Pin the DC gain: 0.5 + 2 * sum(g) = 1
+    const double scale = (sum != 0.0) ? 0.25 / sum : 1.0;
+    for (unsigned int j = 0; j < K; ++j) s->g[j] = (vv_dsp_real)(w[j] * scale);
+    s->K = K;
+    return 1;
+}
+
+// Outputs of a stage for L new inputs, counting the ones pending from earlier calls
+static size_t stage_bound(const cascade_stage* s, size_t L) {
+    return (size_t)ceil((double)(L + s->look + 2) * s->ratio) + 2;
+}
+
+static void stage_reset(cascade_stage* s) {
+    s->buf_len = 0;
+    s->buf_start = 0;
+    s->n_in = 0;
+    s->next = 0;
+    if (s->rs) (void)vv_dsp_resampler_reset(s->rs);
+}
+
+// ---- half-band stages -------------------------------------------------------------
+
+// Samples before an output's position that it reads
+static unsigned int hb_back(const cascade_stage* s) {
+    return (s->kind == STAGE_HB_DOWN) ? 2 * s->K - 1 : s->K - 1;
+}
+
+static void hb_append(cascade_stage* s, const vv_dsp_real* in, size_t n) {
+    if (s->n_in == 0) {
+        const unsigned int back = hb_back(s);
+        for (unsigned int j = 0; j < back; ++j) s->buf[j] = in[0];
+        s->buf_len = back;
+        s->buf_start = -(int64_t)back;
+    }
+    memcpy(s->buf + s->buf_len, in, n * sizeof(vv_dsp_real));
+    s->buf_len += n;
+    s->n_in += n;
+    s->last = in[n - 1];
+}
+
+// Write the outputs whose look-ahead has arrived (flushing: every output at an input
+// position up to the last sample, with the right edge padded), then drop the samples
+// no later output reads
+static size_t hb_run(cascade_stage* s, int flushing, vv_dsp_real* out) {
+    const unsigned int K = s->K;
+    const vv_dsp_real* g = s->g;
+    const int64_t end = (int64_t)s->n_in - 1;
+    const int64_t last_pos = flushing ? end : end - (int64_t)s->look;
+    size_t k = 0;
+    if (s->kind == STAGE_HB_DOWN) {
+        for (; s->next <= last_pos; s->next += 2) {
+            const vv_dsp_real* x = s->buf + (s->next - s->buf_start);
+            double acc = 0.5 * (double)x[0];
+            for (unsigned int j = 0; j < K; ++j) {
+                const ptrdiff_t d = 2 * (ptrdiff_t)j + 1;
+                acc += (double)g[j] * ((double)x[-d] + (double)x[d]);
+            }
+            out[k++] = (vv_dsp_real)acc;
+        }
+    } else {
+        // Output 2m is input m itself; 2m + 1 sits half-way to input m + 1
+        for (; s->next <= last_pos; ++s->next) {
+            const vv_dsp_real* x = s->buf + (s->next - s->buf_start);
+            out[k++] = x[0];
+            if (s->next == end && flushing) continue;
+            double acc = 0.0;
+            for (unsigned int j = 0; j < K; ++j) acc += (double)g[j] * ((double)x[-(ptrdiff_t)j] + (double)x[j + 1]);
+            out[k++] = (vv_dsp_real)(2.0 * acc);
+        }
+    }
+    const int64_t keep = s->next - hb_back(s);
+    if (keep > s->buf_start) {
+        const int64_t drop = keep - s->buf_start;
+        if ((uint64_t)drop >= s->buf_len) {
+            s->buf_len = 0;
+        } else {
+            memmove(s->buf, s->buf + drop, (s->buf_len - (size_t)drop) * sizeof(vv_dsp_real));
+            s->buf_len -= (size_t)drop;
+        }
+        s->buf_start = keep;
+    }
+    return k;
+}
+
+// Process n inputs of stage s into dst (capacity cap); *got receives the outputs
+static vv_dsp_status stage_process(cascade_stage* s, const vv_dsp_real* in, size_t n, vv_dsp_real* dst,
+                                   size_t cap, size_t* got) {
+    *got = 0;
+    if (n == 0) return VV_DSP_OK;
+    if (s->kind == STAGE_FRAC) return (vv_dsp_status)vv_dsp_resampler_process_stream(s->rs, in, n, dst, cap, got);
+    if (n > s->max_in || stage_bound(s, n) > cap) return VV_DSP_ERROR_INTERNAL;
+    hb_append(s, in, n);
+    *got = hb_run(s, 0, dst);
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status stage_flush(cascade_stage* s, vv_dsp_real* dst, size_t cap, size_t* got) {
+    *got = 0;
+    if (s->kind == STAGE_FRAC) return (vv_dsp_status)vv_dsp_resampler_flush(s->rs, dst, cap, got);
+    if (s->n_in) {
+        if (stage_bound(s, 0) > cap) return VV_DSP_ERROR_INTERNAL;
+        for (unsigned int j = 0; j < s->look; ++j) s->buf[s->buf_len + j] = s->last;
+        s->buf_len += s->look;
+        *got = hb_run(s, 1, dst);
+    }
+    stage_reset(s);
+    return VV_DSP_OK;
+}
+
+// ---- cascade ------------------------------------------------------------------------
+
+static void stage_free(cascade_stage* s) {
+    vv_dsp_free(s->g);
+    vv_dsp_free(s->buf);
+    vv_dsp_free(s->out);
+    vv_dsp_resampler_destroy(s->rs);
+}
+
+void vv_dsp_resample_cascade_destroy(vv_dsp_resample_cascade* c) {
+    if (!c) return;
+    for (size_t i = 0; i < c->num_stages; ++i) stage_free(&c->st[i]);
+    vv_dsp_free(c);
+}
+
+static int add_halfband(vv_dsp_resample_cascade* c, stage_kind kind, double fp, double atten_db) {
+    cascade_stage* s = &c->st[c->num_stages++];
+    s->kind = kind;
+    s->ratio = (kind == STAGE_HB_DOWN) ? 0.5 : 2.0;
+    if (!design_halfband(s, fp, atten_db)) return 0;
+    s->look = (kind == STAGE_HB_DOWN) ? 2 * s->K - 1 : s->K;
+    return 1;
+}
+
+static int add_fractional(vv_dsp_resample_cascade* c, uint64_t num, uint64_t den, double passband) {
+    const uint64_t g = gcd_u64(num, den);
+    num /= g;
+    den /= g;
+    if (num > UINT32_MAX || den > UINT32_MAX) return 0;
+    cascade_stage* s = &c->st[c->num_stages++];
+    s->kind = STAGE_FRAC;
+    s->ratio = (double)num / (double)den;
+    // Transition of 4 / taps cycles per input sample inside the (1 - passband) margin
+    // around the cutoff min(1, ratio)
+    unsigned int taps = (unsigned int)ceil(4.0 / ((1.0 - passband) * fmin(1.0, s->ratio)));
+    if (taps < 8) taps = 8;
+    if (taps > 128) taps = 128;
+    taps += taps & 1u;
+    s->rs = vv_dsp_resampler_create((unsigned int)num, (unsigned int)den);
+    if (!s->rs || vv_dsp_resampler_set_quality(s->rs, 1, taps) != VV_DSP_OK) return 0;
+    s->look = taps / 2;
+    return 1;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_create(unsigned int in_rate,
+                                                              unsigned int out_rate,
+                                                              double passband,
+                                                              double stopband_db,
+                                                              vv_dsp_resample_cascade** out_cascade) {
+    if (!out_cascade) return VV_DSP_ERROR_NULL_POINTER;
+    *out_cascade = NULL;
+    if (in_rate == 0 || out_rate == 0) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!(passband > 0.0 && passband < 1.0) || !(stopband_db >= 20.0 && stopband_db <= 180.0))
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_resample_cascade* c = (vv_dsp_resample_cascade*)vv_dsp_calloc(1, sizeof(*c));
+    if (!c) return VV_DSP_ERROR_INTERNAL;
+    int ok = 1;
+    if (in_rate > out_rate) {
+        // Half-bands while the rate stays at least twice the target, then the rest
+        const double fp = 0.5 * passband * (double)out_rate;
+        uint64_t rate_num = in_rate, shift = 0;
+        while (ok && (double)rate_num >= 2.0 * (double)out_rate * (double)(1ull << shift)) {
+            ok = add_halfband(c, STAGE_HB_DOWN, fp * (double)(1ull << shift) / (double)rate_num, stopband_db);
+            ++shift;
+        }
+        const uint64_t num = (uint64_t)out_rate << shift;
+        if (ok && num != rate_num) ok = add_fractional(c, num, rate_num, passband);
+    } else if (out_rate > in_rate) {
+        // The fractional stage to out_rate / 2^s in [in_rate, 2 in_rate), then half-bands
+        unsigned int shift = 0;
+        while ((uint64_t)in_rate << (shift + 1) <= out_rate) ++shift;
+        const uint64_t den = (uint64_t)in_rate << shift;
+        if (den != out_rate) ok = add_fractional(c, out_rate, den, passband);
+        const double fp = 0.5 * passband * (double)in_rate;
+        for (unsigned int i = 0; ok && i < shift; ++i)
+            ok = add_halfband(c, STAGE_HB_UP, fp * (double)(1ull << (shift - i)) / (2.0 * (double)out_rate),
+                              stopband_db);
+    }
+    // Block sizes through the chain, then the stream buffers
+    size_t L = CASCADE_CHUNK;
+    for (size_t i = 0; ok && i < c->num_stages; ++i) {
+        cascade_stage* s = &c->st[i];
+        s->max_in = L;
+        L = stage_bound(s, L);
+        if (i + 1 < c->num_stages) {
+            s->out_cap = L;
+            s->out = (vv_dsp_real*)vv_dsp_malloc(L * sizeof(vv_dsp_real));
+            ok = s->out != NULL;
+        }
+        if (ok && s->kind != STAGE_FRAC) {
+            s->buf_cap = s->max_in + 3 * (size_t)s->look + 2;
+            s->buf = (vv_dsp_real*)vv_dsp_malloc(s->buf_cap * sizeof(vv_dsp_real));
+            ok = s->buf != NULL;
+        }
+    }
+    if (!ok) {
+        vv_dsp_resample_cascade_destroy(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out_cascade = c;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_resample_cascade_num_stages(const vv_dsp_resample_cascade* c) {
+    return c ? c->num_stages : 0;
+}
+
+size_t vv_dsp_resample_cascade_max_out(const vv_dsp_resample_cascade* c, size_t in_n) {
+    if (!c) return 0;
+    size_t x = in_n;
+    for (size_t i = 0; i < c->num_stages; ++i)
+        x = stage_bound(&c->st[i], x) + (in_n == 0 ? stage_bound(&c->st[i], 0) : 0);
+    return x;
+}
+
+// Feed n samples through stages i.. and append the result to out[*k]
+static vv_dsp_status push(vv_dsp_resample_cascade* c, size_t i, const vv_dsp_real* in, size_t n,
+                          vv_dsp_real* out, size_t cap, size_t* k) {
+    for (; i < c->num_stages && n; ++i) {
+        cascade_stage* s = &c->st[i];
+        const int last = i + 1 == c->num_stages;
+        vv_dsp_real* dst = last ? out + *k : s->out;
+        vv_dsp_status st = stage_process(s, in, n, dst, last ? cap - *k : s->out_cap, &n);
+        if (st != VV_DSP_OK) return st;
+        in = dst;
+    }
+    if (i == c->num_stages && n) {
+        // The last stage wrote in place; with no stages at all the samples pass through
+        if (c->num_stages == 0) memcpy(out + *k, in, n * sizeof(vv_dsp_real));
+        *k += n;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_process(vv_dsp_resample_cascade* c,
+                                                               const vv_dsp_real* in, size_t in_n,
+                                                               vv_dsp_real* out, size_t out_cap,
+                                                               size_t* out_n) {
+    if (!c || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    if (in_n == 0) return VV_DSP_OK;
+    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_cap < vv_dsp_resample_cascade_max_out(c, in_n)) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t k = 0;
+    for (size_t pos = 0; pos < in_n; pos += CASCADE_CHUNK) {
+        const size_t n = (in_n - pos < CASCADE_CHUNK) ? in_n - pos : CASCADE_CHUNK;
+        vv_dsp_status st = push(c, 0, in + pos, n, out, out_cap, &k);
+        if (st != VV_DSP_OK) return st;
+    }
+    *out_n = k;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_cascade_flush(vv_dsp_resample_cascade* c,
+                                                             vv_dsp_real* out, size_t out_cap,
+                                                             size_t* out_n) {
+    if (!c || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    if (out_cap < vv_dsp_resample_cascade_max_out(c, 0)) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t k = 0;
+    // Drain front to back: each stage's tail runs through the stages after it first
+    for (size_t i = 0; i < c->num_stages; ++i) {
+        cascade_stage* s = &c->st[i];
+        const int last = i + 1 == c->num_stages;
+        vv_dsp_real* dst = last ? out + k : s->out;
+        size_t n = 0;
+        vv_dsp_status st = stage_flush(s, dst, last ? out_cap - k : s->out_cap, &n);
+        if (st == VV_DSP_OK) {
+            if (last) k += n;
+            else st = push(c, i + 1, dst, n, out, out_cap, &k);
+        }
+        if (st != VV_DSP_OK) {
+            (void)vv_dsp_resample_cascade_reset(c);
+            return st;
+        }
+    }
+    *out_n = k;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_resample_cascade_reset(vv_dsp_resample_cascade* c) {
+    if (!c) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < c->num_stages; ++i) stage_reset(&c->st[i]);
+    return VV_DSP_OK;
+}
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/resample/fft_resample.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/alloc.h"
+
+static size_t gcd_size(size_t a, size_t b) {
+    while (b) {
+        const size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// One transform: in[0..n_in) -> out[0..n_out) with spectrum buffers X (n_in / 2 + 1)
+// and Y (n_out / 2 + 1)
+static vv_dsp_status resample_block(const vv_dsp_real* in, size_t n_in, vv_dsp_real* out, size_t n_out,
+                                    double taper, vv_dsp_cpx* X, vv_dsp_cpx* Y) {
+    if (n_in == 1 || n_out == 1) {
+        // A single sample carries only the mean
+        double mean = 0.0;
+        for (size_t i = 0; i < n_in; ++i) mean += (double)in[i];
+        mean /= (double)n_in;
+        for (size_t k = 0; k < n_out; ++k) out[k] = (vv_dsp_real)mean;
+        return VV_DSP_OK;
+    }
+    vv_dsp_fft_plan* fwd = NULL;
+    vv_dsp_fft_plan* inv = NULL;
+    vv_dsp_status st = vv_dsp_fft_make_plan(n_in, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &fwd);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_make_plan(n_out, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &inv);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_execute(fwd, in, X);
+    if (st == VV_DSP_OK) {
+        const size_t N = (n_out < n_in) ? n_out : n_in;  // bins 0..N/2 survive
+        const size_t bins_out = n_out / 2 + 1, keep = N / 2 + 1;
+        const vv_dsp_real g = (vv_dsp_real)((double)n_out / (double)n_in);
+        (void)vv_dsp_cpx_scale_array(X, g, Y, keep);
+        for (size_t k = keep; k < bins_out; ++k) Y[k].re = Y[k].im = 0;
+        if (N % 2 == 0) {
+            // Even N: the kept Nyquist bin stands for X[N/2] and X[-N/2] together
+            const vv_dsp_real f = (n_out < n_in) ? (vv_dsp_real)2.0 : (n_out > n_in) ? (vv_dsp_real)0.5 : (vv_dsp_real)1.0;
+            Y[N / 2].re *= f;
+            Y[N / 2].im *= f;
+        }
+        if (taper > 0.0) {
+            // Raised-cosine roll-off over the top taper fraction of bins 0..N/2
+            const double top = (double)(N / 2), k0 = top * (1.0 - taper);
+            for (size_t k = (size_t)ceil(k0); k < keep; ++k) {
+                const double w = (top > k0) ? 0.5 * (1.0 + cos(VV_DSP_PI_D * ((double)k - k0) / (top - k0 + 1.0))) : 1.0;
+                Y[k].re *= (vv_dsp_real)w;
+                Y[k].im *= (vv_dsp_real)w;
+            }
+        }
+        st = vv_dsp_fft_execute(inv, Y, out);
+    }
+    if (fwd) (void)vv_dsp_fft_destroy(fwd);
+    if (inv) (void)vv_dsp_fft_destroy(inv);
+    return st;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_fft_ex(const vv_dsp_real* in, size_t n_in,
+                                                      vv_dsp_real* out, size_t n_out,
+                                                      double taper, size_t chunk, size_t overlap) {
+    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n_in == 0 || n_out == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(taper >= 0.0 && taper <= 1.0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    // Blocks are multiples of M inputs, which map to L outputs exactly
+    const size_t g = gcd_size(n_in, n_out), M = n_in / g, L = n_out / g;
+    size_t block = n_in, margin = 0;
+    if (chunk > 0 && chunk < n_in) {
+        block = (chunk + M - 1) / M * M;
+        margin = (overlap + M - 1) / M * M;
+    }
+    if (block >= n_in) {
+        block = n_in;
+        margin = 0;
+    }
+    // Largest segment: a block plus both margins
+    size_t seg_max = block + 2 * margin;
+    if (seg_max > n_in) seg_max = n_in;
+    const size_t seg_out_max = seg_max / M * L;
+    vv_dsp_cpx* X = (vv_dsp_cpx*)vv_dsp_malloc((seg_max / 2 + 1) * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* Y = (vv_dsp_cpx*)vv_dsp_malloc((seg_out_max / 2 + 1) * sizeof(vv_dsp_cpx));
+    vv_dsp_real* tmp = (margin > 0) ? (vv_dsp_real*)vv_dsp_malloc(seg_out_max * sizeof(vv_dsp_real)) : NULL;
+    vv_dsp_status st = (X && Y && (margin == 0 || tmp)) ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    for (size_t s = 0; st == VV_DSP_OK && s < n_in; s += block) {
+        const size_t e = (s + block < n_in) ? s + block : n_in;
+        const size_t lo = (s > margin) ? s - margin : 0;
+        const size_t hi = (e + margin < n_in) ? e + margin : n_in;
+        const size_t seg_out = (hi - lo) / M * L;
+        if (margin == 0) {
+            st = resample_block(in + lo, hi - lo, out + s / M * L, seg_out, taper, X, Y);
+        } else {
+            st = resample_block(in + lo, hi - lo, tmp, seg_out, taper, X, Y);
+            if (st == VV_DSP_OK)
+                memcpy(out + s / M * L, tmp + (s - lo) / M * L, (e - s) / M * L * sizeof(vv_dsp_real));
+        }
+    }
+    vv_dsp_free(X);
+    vv_dsp_free(Y);
+    vv_dsp_free(tmp);
+    return st;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_resample_fft(const vv_dsp_real* in, size_t n_in,
+                                                   vv_dsp_real* out, size_t n_out) {
+    return vv_dsp_resample_fft_ex(in, n_in, out, n_out, 0.0, 0, 0);
+}
@@ -1,6 +1,24 @@
 #include <math.h>
 #include "vv_dsp/resample/interpolate.h"
 
+// Catmull-Rom spline basis (uniform):
+// Interpolate between p1 and p2 with tangent m1=(p2-p0)/2, m2=(p3-p1)/2
+static VV_DSP_INLINE vv_dsp_real catmull_rom(vv_dsp_real p0, vv_dsp_real p1, vv_dsp_real p2, vv_dsp_real p3,
+                                             vv_dsp_real t) {
+    vv_dsp_real m1 = (vv_dsp_real)0.5 * (p2 - p0);
+    vv_dsp_real m2 = (vv_dsp_real)0.5 * (p3 - p1);
+
+    vv_dsp_real t2 = t * t;
+    vv_dsp_real t3 = t2 * t;
+
+    vv_dsp_real h00 = (vv_dsp_real)((vv_dsp_real)2.0 * t3 - (vv_dsp_real)3.0 * t2 + (vv_dsp_real)1.0);
+    vv_dsp_real h10 = (vv_dsp_real)(t3 - (vv_dsp_real)2.0 * t2 + t);
+    vv_dsp_real h01 = (vv_dsp_real)(-(vv_dsp_real)2.0 * t3 + (vv_dsp_real)3.0 * t2);
+    vv_dsp_real h11 = (vv_dsp_real)(t3 - t2);
+
+    return (vv_dsp_real)(h00 * p1 + h10 * m1 + h01 * p2 + h11 * m2);
+}
+
 vv_dsp_status vv_dsp_interpolate_linear_real(const vv_dsp_real* x,
                                              size_t n,
                                              vv_dsp_real pos,
@@ -46,19 +64,140 @@ vv_dsp_status vv_dsp_interpolate_cubic_real(const vv_dsp_real* x,
     vv_dsp_real p2 = x[i2];
     vv_dsp_real p3 = x[i3];
 
-    // Catmull-Rom spline basis (uniform):
-    // Interpolate between p1 and p2 with tangent m1=(p2-p0)/2, m2=(p3-p1)/2
-    vv_dsp_real m1 = (vv_dsp_real)0.5 * (p2 - p0);
-    vv_dsp_real m2 = (vv_dsp_real)0.5 * (p3 - p1);
+    *out = catmull_rom(p0, p1, p2, p3, t);
+    return VV_DSP_OK;
+}
 
-    vv_dsp_real t2 = t * t;
-    vv_dsp_real t3 = t2 * t;
+// ---- batch -------------------------------------------------------------------------
 
-    vv_dsp_real h00 = (vv_dsp_real)((vv_dsp_real)2.0 * t3 - (vv_dsp_real)3.0 * t2 + (vv_dsp_real)1.0);
-    vv_dsp_real h10 = (vv_dsp_real)(t3 - (vv_dsp_real)2.0 * t2 + t);
-    vv_dsp_real h01 = (vv_dsp_real)(-(vv_dsp_real)2.0 * t3 + (vv_dsp_real)3.0 * t2);
-    vv_dsp_real h11 = (vv_dsp_real)(t3 - t2);
+// Cubic at i + t (0 <= i < n - 1) with the neighbours clamped to the sequence
+static VV_DSP_INLINE vv_dsp_real cubic_clamped(const vv_dsp_real* x, size_t n, size_t i, vv_dsp_real t) {
+    const size_t i0 = (i == 0) ? 0 : (i - 1);
+    const size_t i3 = (i + 2 < n) ? (i + 2) : (n - 1);
+    return catmull_rom(x[i0], x[i], x[i + 1], x[i3], t);
+}
 
-    *out = (vv_dsp_real)(h00 * p1 + h10 * m1 + h01 * p2 + h11 * m2);
+vv_dsp_status vv_dsp_interpolate_linear_batch(const vv_dsp_real* x,
+                                              size_t n,
+                                              const vv_dsp_real* pos,
+                                              size_t m,
+                                              vv_dsp_real* out) {
+    if (m == 0) return VV_DSP_OK;
+    if (!x || !pos || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const vv_dsp_real max_index = (vv_dsp_real)(n - 1);
+    for (size_t k = 0; k < m; ++k) {
+        const vv_dsp_real p = pos[k];
+        if (p <= 0) { out[k] = x[0]; continue; }
+        if (p >= max_index) { out[k] = x[n - 1]; continue; }
+        const size_t i = (size_t)p;
+        const vv_dsp_real t = p - (vv_dsp_real)i;
+        out[k] = (vv_dsp_real)(((vv_dsp_real)1.0 - t) * x[i] + t * x[i + 1]);
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_interpolate_cubic_batch(const vv_dsp_real* x,
+                                             size_t n,
+                                             const vv_dsp_real* pos,
+                                             size_t m,
+                                             vv_dsp_real* out) {
+    if (m == 0) return VV_DSP_OK;
+    if (!x || !pos || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const vv_dsp_real max_index = (vv_dsp_real)(n - 1);
+    for (size_t k = 0; k < m; ++k) {
+        const vv_dsp_real p = pos[k];
+        if (n < 2 || p <= 0) { out[k] = x[0]; continue; }
+        if (p >= max_index) { out[k] = x[n - 1]; continue; }
+        const size_t i = (size_t)p;
+        out[k] = cubic_clamped(x, n, i, p - (vv_dsp_real)i);
+    }
+    return VV_DSP_OK;
+}
+
+static VV_DSP_INLINE double uniform_pos(double start, double step, size_t k) {
+    return start + (double)k * step;
+}
+
+// First k in [from, m] whose position is >= limit (positions are non-decreasing in k)
+static size_t uniform_until(double start, double step, size_t from, size_t m, double limit) {
+    size_t k = m;
+    if (step > 0.0) {
+        const double est = ceil((limit - start) / step);
+        k = (est <= (double)from) ? from : (est >= (double)m) ? m : (size_t)est;
+    } else if (start >= limit) {
+        k = from;
+    }
+    // The estimate can be one off after rounding; settle it on the exact positions
+    while (k > from && uniform_pos(start, step, k - 1) >= limit) --k;
+    while (k < m && uniform_pos(start, step, k) < limit) ++k;
+    return k;
+}
+
+static int uniform_args_ok(double start, double step) {
+    return isfinite(start) && isfinite(step) && step >= 0.0;
+}
+
+vv_dsp_status vv_dsp_interpolate_linear_uniform(const vv_dsp_real* x,
+                                                size_t n,
+                                                double start,
+                                                double step,
+                                                size_t m,
+                                                vv_dsp_real* out) {
+    if (m == 0) return VV_DSP_OK;
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!uniform_args_ok(start, step)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    // Positions <= 0 clamp to x[0]; [k0, k1) is the interior (0, n - 1)
+    size_t k0 = 0;
+    while (k0 < m && uniform_pos(start, step, k0) <= 0.0) out[k0++] = x[0];
+    const size_t k1 = uniform_until(start, step, k0, m, (double)(n - 1));
+    for (size_t k = k0; k < k1; ++k) {
+        const double p = uniform_pos(start, step, k);
+        const size_t i = (size_t)p;
+        const vv_dsp_real t = (vv_dsp_real)(p - (double)i);
+        out[k] = (vv_dsp_real)(((vv_dsp_real)1.0 - t) * x[i] + t * x[i + 1]);
+    }
+    for (size_t k = k1; k < m; ++k) out[k] = x[n - 1];
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_interpolate_cubic_uniform(const vv_dsp_real* x,
+                                               size_t n,
+                                               double start,
+                                               double step,
+                                               size_t m,
+                                               vv_dsp_real* out) {
+    if (m == 0) return VV_DSP_OK;
+    if (!x || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!uniform_args_ok(start, step)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (n < 2) {
+        for (size_t k = 0; k < m; ++k) out[k] = x[0];
+        return VV_DSP_OK;
+    }
+    size_t k = 0;
+    while (k < m && uniform_pos(start, step, k) <= 0.0) out[k++] = x[0];
+    // Segments below 1 and from n - 2 read clamped neighbours; the rest read x[i-1..i+2]
+    const size_t lo = uniform_until(start, step, k, m, 1.0);
+    const size_t hi = (n >= 3) ? uniform_until(start, step, lo, m, (double)(n - 2)) : lo;
+    const size_t end = uniform_until(start, step, hi, m, (double)(n - 1));
+    for (; k < lo; ++k) {
+        const double p = uniform_pos(start, step, k);
+        out[k] = cubic_clamped(x, n, 0, (vv_dsp_real)p);
+    }
+    for (; k < hi; ++k) {
+        const double p = uniform_pos(start, step, k);
+        const size_t i = (size_t)p;
+        const vv_dsp_real* q = x + i - 1;
+        out[k] = catmull_rom(q[0], q[1], q[2], q[3], (vv_dsp_real)(p - (double)i));
+    }
+    for (; k < end; ++k) {
+        const double p = uniform_pos(start, step, k);
+        const size_t i = (size_t)p;
+        out[k] = cubic_clamped(x, n, i, (vv_dsp_real)(p - (double)i));
+    }
+    for (; k < m; ++k) out[k] = x[n - 1];
     return VV_DSP_OK;
 }
@@ -0,0 +1,110 @@
+/*
+This file is part of vv-dsp
+
+Private dot-product kernel for the resampler's polyphase sinc convolution. Every
+output uses its own kernel row, so float builds vectorize along the taps
+(AVX-512, AVX2, SSE4.1 or NEON from core/simd_utils.h) and reduce horizontally;
+double builds and builds without SIMD use a scalar double accumulator.
+*/
+
+#ifndef VV_DSP_RESAMPLE_KERNEL_H
+#define VV_DSP_RESAMPLE_KERNEL_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/window.h"
+
+// Windowed sinc kernel of taps (even, <= 128) weights for fractional position
+// frac in [0, 1] and normalized cutoff, normalized by its sum; weight j applies to the
+// sample at center - taps / 2 + j. win is the taps-point symmetric Hann window from
+// vv_dsp_resample_window_acquire(), shared by every row.
+void vv_dsp_resample_sinc_row(vv_dsp_real* row, unsigned int taps, double cutoff, double frac,
+                              const vv_dsp_real* win);
+
+// Cached Hann window for vv_dsp_resample_sinc_row(); release with vv_dsp_window_release()
+static inline vv_dsp_status vv_dsp_resample_window_acquire(unsigned int taps, const vv_dsp_real** out) {
+    return vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_HANN, taps, 0, 0, out);
+}
+
+// sum_j h[j] * x[j] over n taps; x must hold n samples (no clamping)
+static inline double rs_dot(const vv_dsp_real* h, const vv_dsp_real* x, unsigned int n) {
+    unsigned int j = 0;
+    double acc = 0.0;
+#if !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_AVX512)
+    __m512 a0 = _mm512_setzero_ps();
+    for (; j + 16 <= n; j += 16) a0 = _mm512_fmadd_ps(_mm512_loadu_ps(h + j), _mm512_loadu_ps(x + j), a0);
+    acc = (double)_mm512_reduce_add_ps(a0);
+#elif !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_AVX2)
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    for (; j + 16 <= n; j += 16) {
+        a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(h + j), _mm256_loadu_ps(x + j)));
+        a1 = _mm256_add_ps(a1, _mm256_mul_ps(_mm256_loadu_ps(h + j + 8), _mm256_loadu_ps(x + j + 8)));
+    }
+    for (; j + 8 <= n; j += 8) a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(h + j), _mm256_loadu_ps(x + j)));
+    a0 = _mm256_add_ps(a0, a1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(a0), _mm256_extractf128_ps(a0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    acc = (double)_mm_cvtss_f32(s);
+#elif !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_SSE41)
+    __m128 a0 = _mm_setzero_ps();
+    for (; j + 4 <= n; j += 4) a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(h + j), _mm_loadu_ps(x + j)));
+    a0 = _mm_add_ps(a0, _mm_movehl_ps(a0, a0));
+    a0 = _mm_add_ss(a0, _mm_shuffle_ps(a0, a0, 0x55));
+    acc = (double)_mm_cvtss_f32(a0);
+#elif !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_NEON)
+    float32x4_t a0 = vdupq_n_f32(0.0f);
+    for (; j + 4 <= n; j += 4) a0 = vmlaq_f32(a0, vld1q_f32(h + j), vld1q_f32(x + j));
+#  if defined(__aarch64__)
+    acc = (double)vaddvq_f32(a0);
+#  else
+    float32x2_t s = vadd_f32(vget_low_f32(a0), vget_high_f32(a0));
+    acc = (double)vget_lane_f32(vpadd_f32(s, s), 0);
+#  endif
+#endif
+    for (; j < n; ++j) acc += (double)x[j] * (double)h[j];
+    return acc;
+}
+
+// y[c] = sum_j h[j] * x[j * C + c] for c < C: one kernel applied to n interleaved
+// frames, vectorized across channels (the taps stay scalar broadcasts)
+static inline void rs_dot_frames(const vv_dsp_real* h, const vv_dsp_real* x, unsigned int n, size_t C,
+                                 vv_dsp_real* y) {
+    size_t c = 0;
+#if !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_AVX512)
+    for (; c + 16 <= C; c += 16) {
+        __m512 a = _mm512_setzero_ps();
+        for (unsigned int j = 0; j < n; ++j) a = _mm512_fmadd_ps(_mm512_set1_ps(h[j]), _mm512_loadu_ps(x + j * C + c), a);
+        _mm512_storeu_ps(y + c, a);
+    }
+#endif
+#if !defined(VV_DSP_USE_DOUBLE) && (defined(VV_DSP_SIMD_AVX2) || defined(VV_DSP_SIMD_AVX512))
+    for (; c + 8 <= C; c += 8) {
+        __m256 a = _mm256_setzero_ps();
+        for (unsigned int j = 0; j < n; ++j)
+            a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_set1_ps(h[j]), _mm256_loadu_ps(x + j * C + c)));
+        _mm256_storeu_ps(y + c, a);
+    }
+#endif
+#if !defined(VV_DSP_USE_DOUBLE) && (defined(VV_DSP_SIMD_SSE41) || defined(VV_DSP_SIMD_AVX2) || defined(VV_DSP_SIMD_AVX512))
+    for (; c + 4 <= C; c += 4) {
+        __m128 a = _mm_setzero_ps();
+        for (unsigned int j = 0; j < n; ++j) a = _mm_add_ps(a, _mm_mul_ps(_mm_set1_ps(h[j]), _mm_loadu_ps(x + j * C + c)));
+        _mm_storeu_ps(y + c, a);
+    }
+#elif !defined(VV_DSP_USE_DOUBLE) && defined(VV_DSP_SIMD_NEON)
+    for (; c + 4 <= C; c += 4) {
+        float32x4_t a = vdupq_n_f32(0.0f);
+        for (unsigned int j = 0; j < n; ++j) a = vmlaq_n_f32(a, vld1q_f32(x + j * C + c), h[j]);
+        vst1q_f32(y + c, a);
+    }
+#endif
+    for (; c < C; ++c) {
+        double acc = 0.0;
+        for (unsigned int j = 0; j < n; ++j) acc += (double)x[j * C + c] * (double)h[j];
+        y[c] = (vv_dsp_real)acc;
+    }
+}
+
+#endif // VV_DSP_RESAMPLE_KERNEL_H
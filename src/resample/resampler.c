@@ -1,34 +1,179 @@
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
 #include "vv_dsp/vv_dsp_math.h"
 #include "vv_dsp/resample/resampler.h"
 #include "vv_dsp/resample/interpolate.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+#include "resample_kernel.h"
+#include "../spectral/parallel.h"
+
+// Ratios whose reduced numerator is at most this get one table row per output phase;
+// others use RS_INTERP_PHASES rows and interpolate linearly between adjacent rows
+#define RS_MAX_EXACT_PHASES 1024u
+#define RS_INTERP_PHASES 256u
+// Input samples appended to the stream buffer per pass
+#define RS_STREAM_CHUNK 1024u
 
 struct vv_dsp_resampler {
     unsigned int ratio_num;
     unsigned int ratio_den;
     int use_sinc;
     unsigned int taps;
+    vv_dsp_precision_mode precision;
+    vv_dsp_denormal_mode denormals;  // FP scope around processing
     double cutoff; // normalized (0..1], auto-set from ratio
-    // TODO: polyphase filter coeffs, state buffers, phase index, etc.
+    // Polyphase table: rows x ktaps normalized windowed-sinc weights; row p is the
+    // kernel for fractional position p / phases (row phases = position 1.0 when
+    // interpolating)
+    uint64_t step_num;       // reduced ratio: input advances step_den / step_num per output
+    uint64_t step_den;
+    unsigned int ktaps;      // even tap count actually used
+    unsigned int phases;
+    int interp;              // table rows are interpolated (phases != step_num)
+    vv_dsp_real* table;
+    // Streaming state: buf holds inputs from absolute index buf_start (negative while
+    // the left edge is padded with the first sample) up to n_in; the next output sits
+    // at center + phase / step_num
+    vv_dsp_real* buf;
+    size_t buf_len;
+    size_t buf_cap;
+    int64_t buf_start;
+    uint64_t n_in;
+    int64_t center;
+    uint64_t phase;
+    vv_dsp_real last;        // most recent input (right-edge padding at flush)
+    size_t max_block;        // block size prepared for, 0 when not prepared
 };
 
+static uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    while (b) {
+        const uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static VV_DSP_INLINE vv_dsp_real sinc_fn(double x) {
+    if (x == 0.0) return (vv_dsp_real)1.0;
+    double pix = VV_DSP_PI_D * x;
+    return (vv_dsp_real)(sin(pix) / pix);
+}
+
+void vv_dsp_resample_sinc_row(vv_dsp_real* row, unsigned int taps, double cutoff, double frac,
+                              const vv_dsp_real* win) {
+    const int half = (int)(taps / 2);
+    double wsum = 0.0;
+    double w[128];
+    for (unsigned int j = 0; j < taps; ++j) {
+        const double t = (double)((int)j - half) - frac; // distance from fractional center
+        w[j] = (double)sinc_fn(t * cutoff) * (double)win[j];
+        wsum += w[j];
+    }
+    const double g = (wsum != 0.0) ? 1.0 / wsum : 1.0;
+    for (unsigned int j = 0; j < taps; ++j) row[j] = (vv_dsp_real)(w[j] * g);
+}
+
+static void stream_reset(vv_dsp_resampler* rs) {
+    rs->buf_len = 0;
+    rs->buf_start = 0;
+    rs->n_in = 0;
+    rs->center = 0;
+    rs->phase = 0;
+}
+
+// Samples before the output center (back) and the window length each output reads
+static unsigned int window_back(const vv_dsp_resampler* rs) { return rs->use_sinc ? rs->ktaps / 2 : 0; }
+static unsigned int window_len(const vv_dsp_resampler* rs) { return rs->use_sinc ? rs->ktaps : 2; }
+
+static int ensure_stream_buffer(vv_dsp_resampler* rs);
+
+// (Re)build the table and stream buffer for the current ratio and quality
+static int build_table(vv_dsp_resampler* rs) {
+    const uint64_t g = gcd_u64(rs->ratio_num, rs->ratio_den);
+    rs->step_num = rs->ratio_num / g;
+    rs->step_den = rs->ratio_den / g;
+    stream_reset(rs);
+    if (!rs->use_sinc) return rs->max_block ? ensure_stream_buffer(rs) : VV_DSP_OK;
+    unsigned int taps = rs->taps;
+    if (rs->precision != VV_DSP_PRECISION_EXACT) {
+        // Shorter kernels: half (at least 16) or a quarter (at least 8) of the set taps
+        const unsigned int floor_taps = rs->precision == VV_DSP_PRECISION_FAST ? 8u : 16u;
+        const unsigned int reduced = taps >> (rs->precision == VV_DSP_PRECISION_FAST ? 2 : 1);
+        taps = reduced > floor_taps ? reduced : (taps < floor_taps ? taps : floor_taps);
+    }
+    if (taps < 4) taps = 4;
+    if ((taps % 2) == 1) taps += 1; // ensure even taps for symmetry
+    const int interp = rs->step_num > RS_MAX_EXACT_PHASES;
+    const unsigned int phases = interp ? RS_INTERP_PHASES : (unsigned int)rs->step_num;
+    const size_t rows = (size_t)phases + (interp ? 1u : 0u);
+    const vv_dsp_real* win = NULL;
+    vv_dsp_status s = vv_dsp_resample_window_acquire(taps, &win);
+    if (s != VV_DSP_OK) return s;
+    vv_dsp_real* t = (vv_dsp_real*)vv_dsp_malloc(rows * taps * sizeof(vv_dsp_real));
+    if (!t) {
+        vv_dsp_window_release(win);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t p = 0; p < rows; ++p)
+        vv_dsp_resample_sinc_row(t + p * taps, taps, rs->cutoff, (double)p / (double)phases, win);
+    vv_dsp_window_release(win);
+    vv_dsp_free(rs->table);
+    rs->table = t;
+    rs->ktaps = taps;
+    rs->phases = phases;
+    rs->interp = interp;
+    return rs->max_block ? ensure_stream_buffer(rs) : VV_DSP_OK;
+}
+
+// Stream buffer for the current window; allocated by prepare, on first streaming use
+// otherwise, and again by set_ratio() / set_quality() of a prepared stream that needs more
+static int ensure_stream_buffer(vv_dsp_resampler* rs) {
+    const size_t need = (size_t)window_len(rs) + window_back(rs) + RS_STREAM_CHUNK;
+    if (rs->buf && rs->buf_cap >= need) return VV_DSP_OK;
+    vv_dsp_real* b = (vv_dsp_real*)vv_dsp_realloc(rs->buf, need * sizeof(vv_dsp_real));
+    if (!b) return VV_DSP_ERROR_INTERNAL;
+    rs->buf = b;
+    rs->buf_cap = need;
+    return VV_DSP_OK;
+}
+
 vv_dsp_resampler* vv_dsp_resampler_create(unsigned int ratio_num,
                                           unsigned int ratio_den) {
     if (ratio_num == 0 || ratio_den == 0) return NULL;
-    vv_dsp_resampler* rs = (vv_dsp_resampler*)malloc(sizeof(vv_dsp_resampler));
+    vv_dsp_resampler* rs = (vv_dsp_resampler*)vv_dsp_calloc(1, sizeof(vv_dsp_resampler));
     if (!rs) return NULL;
     rs->ratio_num = ratio_num;
     rs->ratio_den = ratio_den;
     rs->use_sinc = 0;
     rs->taps = 32;
     rs->cutoff = fmin(1.0, (double)ratio_num / (double)ratio_den);
+    (void)build_table(rs);
+    return rs;
+}
+
+vv_dsp_resampler* vv_dsp_resampler_create_ctx(const vv_dsp_context* ctx,
+                                              unsigned int ratio_num,
+                                              unsigned int ratio_den) {
+    if (vv_dsp_context_check(ctx) != VV_DSP_OK) return NULL;
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(ratio_num, ratio_den);
+    if (rs) rs->denormals = vv_dsp_context_denormals(ctx);
+    if (rs && ctx && ctx->precision != VV_DSP_PRECISION_EXACT &&
+        vv_dsp_resampler_set_precision(rs, ctx->precision) != VV_DSP_OK) {
+        vv_dsp_resampler_destroy(rs);
+        return NULL;
+    }
     return rs;
 }
 
 void vv_dsp_resampler_destroy(vv_dsp_resampler* rs) {
     if (!rs) return;
-    free(rs);
+    vv_dsp_free(rs->table);
+    vv_dsp_free(rs->buf);
+    vv_dsp_free(rs);
 }
 
 int vv_dsp_resampler_set_ratio(vv_dsp_resampler* rs,
@@ -39,7 +184,7 @@ int vv_dsp_resampler_set_ratio(vv_dsp_resampler* rs,
     rs->ratio_num = ratio_num;
     rs->ratio_den = ratio_den;
     rs->cutoff = fmin(1.0, (double)ratio_num / (double)ratio_den);
-    return VV_DSP_OK;
+    return build_table(rs);
 }
 
 int vv_dsp_resampler_set_quality(vv_dsp_resampler* rs, int use_sinc, unsigned int taps) {
@@ -48,73 +193,710 @@ int vv_dsp_resampler_set_quality(vv_dsp_resampler* rs, int use_sinc, unsigned in
     if (taps < 4) taps = 4;
     if (taps > 128) taps = 128;
     rs->taps = taps;
-    return VV_DSP_OK;
+    return build_table(rs);
 }
 
-static VV_DSP_INLINE vv_dsp_real sinc_fn(double x) {
-    if (x == 0.0) return (vv_dsp_real)1.0;
-    double pix = VV_DSP_PI_D * x;
-    return (vv_dsp_real)(sin(pix) / pix);
+int vv_dsp_resampler_set_precision(vv_dsp_resampler* rs, vv_dsp_precision_mode mode) {
+    if (!rs) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_precision_mode_valid(mode)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    rs->precision = mode;
+    return build_table(rs);
 }
 
-static VV_DSP_INLINE double hann_window(unsigned int m, unsigned int N) {
-    if (N <= 1) return 1.0;
-    return 0.5 - 0.5 * cos((VV_DSP_TWO_PI_D * (double)m) / (double)(N - 1));
+// Same dot product with indices clamped to the signal (edge samples repeat)
+static double dot_row_clamped(const vv_dsp_real* h, const vv_dsp_real* in, size_t in_n,
+                              int64_t first, unsigned int n) {
+    double acc = 0.0;
+    for (unsigned int j = 0; j < n; ++j) {
+        int64_t idx = first + (int64_t)j;
+        if (idx < 0) idx = 0;
+        if (idx >= (int64_t)in_n) idx = (int64_t)in_n - 1;
+        acc += (double)in[idx] * (double)h[j];
+    }
+    return acc;
 }
 
-int vv_dsp_resampler_process_real(vv_dsp_resampler* rs,
+// Kernel for output phase phase / step_num (interpolated into scratch when needed)
+static const vv_dsp_real* kernel_row(const vv_dsp_resampler* rs, uint64_t phase, vv_dsp_real* scratch) {
+    const unsigned int taps = rs->ktaps;
+    if (!rs->interp) return rs->table + (size_t)phase * taps;
+    const double pos = (double)phase / (double)rs->step_num * (double)rs->phases;
+    // The table has phases + 1 rows, so the nearest row always exists
+    if (rs->precision == VV_DSP_PRECISION_FAST) return rs->table + (size_t)(pos + 0.5) * taps;
+    unsigned int p = (unsigned int)pos;
+    if (p >= rs->phases) p = rs->phases - 1;
+    const vv_dsp_real a = (vv_dsp_real)(pos - (double)p);
+    const vv_dsp_real* r0 = rs->table + (size_t)p * taps;
+    const vv_dsp_real* r1 = r0 + taps;
+    for (unsigned int j = 0; j < taps; ++j) scratch[j] = r0[j] + a * (r1[j] - r0[j]);
+    return scratch;
+}
+
+// Output length of a complete signal of in_n > 0 samples (endpoints mapped)
+static size_t resampler_out_len(const vv_dsp_resampler* rs, size_t in_n) {
+    const double ratio = (double)rs->ratio_num / (double)rs->ratio_den;
+    return (size_t)floor((double)(in_n - 1) * ratio) + 1;
+}
+
+static int resampler_process_real(const vv_dsp_resampler* rs,
                                   const vv_dsp_real* in, size_t in_n,
                                   vv_dsp_real* out, size_t out_cap,
                                   size_t* out_n) {
-    if (!rs || !in || !out || !out_n) return VV_DSP_ERROR_NULL_POINTER;
     if (in_n == 0) { *out_n = 0; return VV_DSP_OK; }
-    // Compute expected output length for fixed ratio (nearest floor)
-    double ratio = (double)rs->ratio_num / (double)rs->ratio_den;
-    size_t expect = (size_t)floor((in_n - 1) * ratio) + 1; // map endpoints
+    const size_t expect = resampler_out_len(rs, in_n);
     if (expect > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
 
     *out_n = expect;
     if (!rs->use_sinc) {
-        // Linear interpolation path
-        for (size_t k = 0; k < expect; ++k) {
-            double in_pos = (double)k / ratio; // position in input domain
-            vv_dsp_real y = 0;
-            vv_dsp_interpolate_linear_real(in, in_n, (vv_dsp_real)in_pos, &y);
-            out[k] = y;
+        // Linear interpolation path: output k sits at input position k * den / num
+        return vv_dsp_interpolate_linear_uniform(in, in_n, 0.0, (double)rs->step_den / (double)rs->step_num,
+                                                 expect, out);
+    }
+    if (!rs->table) return VV_DSP_ERROR_INTERNAL;
+
+    // Windowed-sinc path: output k sits at input position k * den / num, split exactly
+    // into an integer center and a phase that selects the precomputed kernel
+    const unsigned int taps = rs->ktaps;
+    const int64_t half = (int64_t)(taps / 2);
+    const uint64_t num = rs->step_num, den = rs->step_den;
+    vv_dsp_real scratch[128];
+    uint64_t center = 0, phase = 0;
+    size_t k = 0;
+#define RS_ADVANCE()                     \
+    do {                                 \
+        phase += den;                    \
+        if (phase >= num) {              \
+            center += phase / num;       \
+            phase %= num;                \
+        }                                \
+    } while (0)
+    // Prologue: kernels that reach before the first sample
+    for (; k < expect && (int64_t)center < half; ++k) {
+        out[k] = (vv_dsp_real)dot_row_clamped(kernel_row(rs, phase, scratch), in, in_n, (int64_t)center - half, taps);
+        RS_ADVANCE();
+    }
+    // Interior: contiguous kernels, no clamping
+    for (; k < expect && center - (uint64_t)half + taps <= in_n; ++k) {
+        out[k] = (vv_dsp_real)rs_dot(kernel_row(rs, phase, scratch), in + (center - (uint64_t)half), taps);
+        RS_ADVANCE();
+    }
+    // Epilogue: kernels that reach past the last sample
+    for (; k < expect; ++k) {
+        out[k] = (vv_dsp_real)dot_row_clamped(kernel_row(rs, phase, scratch), in, in_n, (int64_t)center - half, taps);
+        RS_ADVANCE();
+    }
+#undef RS_ADVANCE
+    return VV_DSP_OK;
+}
+
+int vv_dsp_resampler_process_real(vv_dsp_resampler* rs,
+                                  const vv_dsp_real* in, size_t in_n,
+                                  vv_dsp_real* out, size_t out_cap,
+                                  size_t* out_n) {
+    if (!rs || !in || !out || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_RESAMPLE);
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, rs->denormals);
+    const int s = resampler_process_real(rs, in, in_n, out, out_cap, out_n);
+    vv_dsp_fp_scope_exit(&fp);
+    VV_DSP_PROFILE_END(prof, in_n);
+    return s;
+}
+
+// ---- batch ----------------------------------------------------------------------
+
+// Signals packed per group (the channels of rs_dot_frames()) and the longest one packed
+#define RS_BATCH_LANES 8u
+#define RS_BATCH_PACK_MAX 16384u
+
+typedef struct {
+    size_t len;
+    size_t idx;
+} rs_batch_item;
+
+static int rs_batch_by_length(const void* a, const void* b) {
+    const rs_batch_item* x = (const rs_batch_item*)a;
+    const rs_batch_item* y = (const rs_batch_item*)b;
+    if (x->len != y->len) return x->len < y->len ? -1 : 1;
+    return x->idx < y->idx ? -1 : (x->idx > y->idx);
+}
+
+typedef struct {
+    const vv_dsp_resampler* rs;
+    const vv_dsp_real* const* in;
+    vv_dsp_real* const* out;
+    const size_t* out_cap;
+    size_t* out_n;
+    const rs_batch_item* items; // non-empty signals, shortest first
+    size_t num_packed;          // leading items packed into groups
+    size_t num_groups;
+    size_t num_units;           // groups, then the remaining items one each
+    size_t pack_frames;         // padded frames of the longest packed signal
+    size_t workers;
+    vv_dsp_status* status;
+} rs_batch;
+
+// G signals of at most RS_BATCH_LANES, lane c of frame f holding sample f - back of
+// item c, with the first and last samples repeated past the ends exactly as
+// dot_row_clamped() clamps. Every signal starts at phase 0, so output k reads the same
+// kernel row in all lanes: it is fetched once and applied across the lanes.
+static void rs_batch_group(const rs_batch* b, const rs_batch_item* it, size_t G, vv_dsp_real* x) {
+    const vv_dsp_resampler* rs = b->rs;
+    const size_t back = window_back(rs);
+    const size_t frames = back + it[G - 1].len + window_len(rs);
+    size_t expect[RS_BATCH_LANES], kmax = 0;
+    for (size_t c = 0; c < G; ++c) {
+        const vv_dsp_real* s = b->in[it[c].idx];
+        const size_t n = it[c].len;
+        for (size_t f = 0; f < frames; ++f) {
+            const size_t i = f < back ? 0 : (f - back < n ? f - back : n - 1);
+            x[f * G + c] = s[i];
+        }
+        expect[c] = resampler_out_len(rs, n);
+        if (expect[c] > kmax) kmax = expect[c];
+        b->out_n[it[c].idx] = expect[c];
+    }
+    const uint64_t num = rs->step_num, den = rs->step_den;
+    vv_dsp_real scratch[128], y[RS_BATCH_LANES];
+    uint64_t center = 0, phase = 0;
+    for (size_t k = 0; k < kmax; ++k) {
+        // Frame center holds the kernel's first sample (center - back)
+        const vv_dsp_real* f = x + (size_t)center * G;
+        if (rs->use_sinc) {
+            rs_dot_frames(kernel_row(rs, phase, scratch), f, rs->ktaps, G, y);
+        } else {
+            const double t = (double)phase / (double)num;
+            for (size_t c = 0; c < G; ++c) y[c] = (vv_dsp_real)((double)f[c] + t * ((double)f[G + c] - (double)f[c]));
+        }
+        for (size_t c = 0; c < G; ++c) {
+            if (k < expect[c]) b->out[it[c].idx][k] = y[c];
+        }
+        phase += den;
+        if (phase >= num) {
+            center += phase / num;
+            phase %= num;
         }
-        return VV_DSP_OK;
     }
+}
 
-    // Windowed-sinc path with automatic cutoff for anti-aliasing
-    unsigned int taps = rs->taps;
-    if (taps < 4) taps = 4;
-    if ((taps % 2) == 1) taps += 1; // ensure even taps for symmetry
-    int half = (int)(taps / 2);
-    double cutoff = rs->cutoff; // 0..1
-
-    for (size_t k = 0; k < expect; ++k) {
-        double in_pos = (double)k / ratio; // fractional index
-        double acc = 0.0;
-        double wsum = 0.0;
-        int center = (int)floor(in_pos);
-        for (int m = -half; m < (int)taps - half; ++m) {
-            int idx = center + m;
-            double t = (double)idx - in_pos; // distance from fractional center
-            // Sinc with cutoff scaling
-            double s = (double)sinc_fn(t * cutoff);
-            // Hann window (0..taps-1)
-            unsigned int mi = (unsigned int)(m + half);
-            double w = hann_window(mi, taps);
-            double weight = s * w;
-            // Sample with clamping at edges
-            if (idx < 0) idx = 0;
-            if (idx >= (int)in_n) idx = (int)in_n - 1;
-            acc += (double)in[idx] * weight;
-            wsum += weight;
+// Worker w takes units w, w + workers, ...
+static void rs_batch_worker(void* ctx, size_t w) {
+    const rs_batch* b = (const rs_batch*)ctx;
+    vv_dsp_real* x = NULL;
+    vv_dsp_status s = VV_DSP_OK;
+    if (w < b->num_groups) {
+        x = (vv_dsp_real*)vv_dsp_malloc(b->pack_frames * RS_BATCH_LANES * sizeof(vv_dsp_real));
+        if (!x) s = VV_DSP_ERROR_INTERNAL;
+    }
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, b->rs->denormals);
+    for (size_t u = w; s == VV_DSP_OK && u < b->num_units; u += b->workers) {
+        if (u < b->num_groups) {
+            const size_t first = u * RS_BATCH_LANES;
+            const size_t G = b->num_packed - first < RS_BATCH_LANES ? b->num_packed - first : RS_BATCH_LANES;
+            rs_batch_group(b, b->items + first, G, x);
+        } else {
+            const rs_batch_item* it = b->items + b->num_packed + (u - b->num_groups);
+            s = resampler_process_real(b->rs, b->in[it->idx], it->len, b->out[it->idx], b->out_cap[it->idx],
+                                       &b->out_n[it->idx]);
+        }
+    }
+    vv_dsp_fp_scope_exit(&fp);
+    vv_dsp_free(x);
+    b->status[w] = s;
+}
+
+int vv_dsp_resampler_process_batch(const vv_dsp_resampler* rs,
+                                   const vv_dsp_real* const* in, const size_t* in_n,
+                                   vv_dsp_real* const* out, const size_t* out_cap,
+                                   size_t* out_n, size_t num_signals, size_t num_threads) {
+    if (!rs) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_signals == 0) return VV_DSP_OK;
+    if (!in || !in_n || !out || !out_cap || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    if (rs->use_sinc && !rs->table) return VV_DSP_ERROR_INTERNAL;
+    // Every signal is checked before any is written
+    size_t active = 0;
+    for (size_t i = 0; i < num_signals; ++i) {
+        if (in_n[i] == 0) continue;
+        if (!in[i] || !out[i]) return VV_DSP_ERROR_NULL_POINTER;
+        if (resampler_out_len(rs, in_n[i]) > out_cap[i]) return VV_DSP_ERROR_INVALID_SIZE;
+        ++active;
+    }
+    for (size_t i = 0; i < num_signals; ++i) out_n[i] = 0;
+    if (active == 0) return VV_DSP_OK;
+
+    rs_batch b;
+    memset(&b, 0, sizeof(b));
+    rs_batch_item* items = (rs_batch_item*)vv_dsp_malloc(active * sizeof(rs_batch_item));
+    if (!items) return VV_DSP_ERROR_INTERNAL;
+    for (size_t i = 0, j = 0; i < num_signals; ++i) {
+        if (in_n[i] == 0) continue;
+        items[j].len = in_n[i];
+        items[j].idx = i;
+        ++j;
+    }
+    qsort(items, active, sizeof(rs_batch_item), rs_batch_by_length);
+    while (b.num_packed < active && items[b.num_packed].len <= RS_BATCH_PACK_MAX) ++b.num_packed;
+    b.rs = rs;
+    b.in = in;
+    b.out = out;
+    b.out_cap = out_cap;
+    b.out_n = out_n;
+    b.items = items;
+    b.num_groups = (b.num_packed + RS_BATCH_LANES - 1) / RS_BATCH_LANES;
+    b.num_units = b.num_groups + (active - b.num_packed);
+    if (b.num_packed) b.pack_frames = window_back(rs) + items[b.num_packed - 1].len + window_len(rs);
+    b.workers = num_threads ? num_threads : vv_dsp_parallel_default_workers();
+    if (b.workers > b.num_units) b.workers = b.num_units;
+    b.status = (vv_dsp_status*)vv_dsp_malloc(b.workers * sizeof(vv_dsp_status));
+    vv_dsp_status s = b.status ? vv_dsp_parallel_run(b.workers, rs_batch_worker, &b) : VV_DSP_ERROR_INTERNAL;
+    for (size_t w = 0; s == VV_DSP_OK && w < b.workers; ++w) s = b.status[w];
+    vv_dsp_free(b.status);
+    vv_dsp_free(items);
+    return s;
+}
+
+// ---- streaming ------------------------------------------------------------------
+
+// floor((a * step_num - p) / step_den) for a >= 0 and p <= step_num, without forming
+// the product (a can be a sample count, step_num up to 2^32)
+static int64_t floor_affine(const vv_dsp_resampler* rs, uint64_t a, uint64_t p) {
+    const uint64_t num = rs->step_num, den = rs->step_den;
+    const uint64_t q = a / den, v = (a % den) * num;
+    if (v >= p) return (int64_t)(q * num + (v - p) / den);
+    return (int64_t)(q * num) - (int64_t)((p - v + den - 1) / den);
+}
+
+// Outputs that can be completed with extra more inputs (flushing: every output at an
+// input position <= the last sample, with the right edge padded)
+static size_t stream_ready(const vv_dsp_resampler* rs, size_t extra, int flushing) {
+    const unsigned int la = window_len(rs) - window_back(rs) - 1;   // samples after center
+    const int64_t avail = (int64_t)(rs->n_in + extra);
+    if (flushing) {
+        const int64_t D = avail - 1 - rs->center;
+        if (avail == 0 || D < 0) return 0;
+        const int64_t j = floor_affine(rs, (uint64_t)D, rs->phase);
+        return (j < 0) ? 0 : (size_t)j + 1;
+    }
+    const int64_t D = avail - 1 - (int64_t)la - rs->center;
+    if (D < 0) return 0;
+    return (size_t)(floor_affine(rs, (uint64_t)D + 1, rs->phase + 1) + 1);
+}
+
+size_t vv_dsp_resampler_out_needed(const vv_dsp_resampler* rs, size_t in_n) {
+    if (!rs) return 0;
+    return stream_ready(rs, in_n, 0);
+}
+
+size_t vv_dsp_resampler_in_needed(const vv_dsp_resampler* rs, size_t out_n) {
+    if (!rs || out_n == 0) return 0;
+    const uint64_t num = rs->step_num, den = rs->step_den, a = (uint64_t)out_n - 1;
+    // Center of the last requested output, then its look-ahead
+    const uint64_t adv = (a / num) * den + ((a % num) * den + rs->phase) / num;
+    const int64_t la = (int64_t)(window_len(rs) - window_back(rs) - 1);
+    const int64_t need = rs->center + (int64_t)adv + la + 1 - (int64_t)rs->n_in;
+    return (need > 0) ? (size_t)need : 0;
+}
+
+static VV_DSP_INLINE void stream_advance(vv_dsp_resampler* rs) {
+    rs->phase += rs->step_den;
+    if (rs->phase >= rs->step_num) {
+        rs->center += (int64_t)(rs->phase / rs->step_num);
+        rs->phase %= rs->step_num;
+    }
+}
+
+// Drop the frames (of C samples) in buf that no later output reads
+static void stream_drop(vv_dsp_resampler* rs, vv_dsp_real* buf, size_t C) {
+    const int64_t keep = rs->center - (int64_t)window_back(rs);
+    if (keep <= rs->buf_start) return;
+    const int64_t drop = keep - rs->buf_start;
+    if ((uint64_t)drop >= rs->buf_len) {
+        rs->buf_len = 0;
+    } else {
+        memmove(buf, buf + (size_t)drop * C, (rs->buf_len - (size_t)drop) * C * sizeof(vv_dsp_real));
+        rs->buf_len -= (size_t)drop;
+    }
+    rs->buf_start = keep;
+}
+
+// Frames in or out of the stream: interleaved (il), planar (pl, one pointer per
+// channel) or any vv_dsp_buffer layout (buf)
+typedef struct {
+    const vv_dsp_real* il;
+    const vv_dsp_real* const* pl;
+    const vv_dsp_buffer* buf;
+} rs_src;
+
+typedef struct {
+    vv_dsp_real* il;
+    vv_dsp_real* const* pl;
+    const vv_dsp_buffer* buf;
+} rs_dst;
+
+// Write count output frames of C channels from buf to out frames k0.., advancing the
+// output position; the phase and kernel row are shared by all channels
+static void stream_produce(vv_dsp_resampler* rs, vv_dsp_real* buf, size_t C, size_t count, rs_dst out,
+                           size_t k0, vv_dsp_real* tmp) {
+    const int64_t back = (int64_t)window_back(rs);
+    vv_dsp_real scratch[128];
+    for (size_t k = k0; k < k0 + count; ++k) {
+        const vv_dsp_real* b = buf + (size_t)(rs->center - back - rs->buf_start) * C;
+        vv_dsp_real* y = out.il ? out.il + k * C : tmp;
+        if (rs->use_sinc) {
+            const vv_dsp_real* h = kernel_row(rs, rs->phase, scratch);
+            if (C == 1) y[0] = (vv_dsp_real)rs_dot(h, b, rs->ktaps);
+            else rs_dot_frames(h, b, rs->ktaps, C, y);
+        } else {
+            const double t = (double)rs->phase / (double)rs->step_num;
+            for (size_t c = 0; c < C; ++c)
+                y[c] = (vv_dsp_real)((double)b[c] + t * ((double)b[C + c] - (double)b[c]));
+        }
+        if (out.pl) {
+            for (size_t c = 0; c < C; ++c) out.pl[c][k] = y[c];
+        } else if (out.buf) {
+            vv_dsp_real* d = out.buf->data + k * out.buf->frame_stride;
+            for (size_t c = 0; c < C; ++c) d[c * out.buf->channel_stride] = y[c];
+        }
+        stream_advance(rs);
+    }
+    stream_drop(rs, buf, C);
+}
+
+static void copy_frames(vv_dsp_real* dst, rs_src in, size_t from, size_t count, size_t C) {
+    if (in.il) {
+        memcpy(dst, in.il + from * C, count * C * sizeof(vv_dsp_real));
+        return;
+    }
+    if (in.buf) {
+        const vv_dsp_buffer* b = in.buf;
+        for (size_t f = 0; f < count; ++f) {
+            const vv_dsp_real* s = b->data + (from + f) * b->frame_stride;
+            for (size_t c = 0; c < C; ++c) dst[f * C + c] = s[c * b->channel_stride];
+        }
+        return;
+    }
+    for (size_t f = 0; f < count; ++f) {
+        for (size_t c = 0; c < C; ++c) dst[f * C + c] = in.pl[c][from + f];
+    }
+}
+
+// Streaming core shared by the single- and multi-channel objects: buf holds buf_cap
+// frames of C channels, last[] the most recent frame. Arguments are checked by callers
+static void stream_run(vv_dsp_resampler* rs, vv_dsp_real* buf, size_t buf_cap, size_t C, rs_src in, size_t in_n,
+                       rs_dst out, vv_dsp_real* last, vv_dsp_real* tmp, size_t* out_n) {
+    const unsigned int back = window_back(rs);
+    size_t pos = 0, k = 0;
+    while (pos < in_n) {
+        if (rs->n_in == 0) {
+            // Left edge: the first frame repeats, as in vv_dsp_resampler_process_real()
+            for (unsigned int j = 0; j < back; ++j) copy_frames(buf + (size_t)j * C, in, 0, 1, C);
+            rs->buf_len = back;
+            rs->buf_start = -(int64_t)back;
+        }
+        size_t n = buf_cap - rs->buf_len;
+        if (n > in_n - pos) n = in_n - pos;
+        if (rs->buf_len == 0 && rs->buf_start > (int64_t)rs->n_in) {
+            // Strong downsampling: the next output does not read these frames
+            const uint64_t gap = (uint64_t)rs->buf_start - rs->n_in;
+            const size_t skip = (gap < n) ? (size_t)gap : n;
+            rs->n_in += skip;
+            pos += skip;
+            n -= skip;
+            if (n == 0) continue;
         }
-        // Normalize by windowed kernel sum to reduce amplitude bias
-        if (wsum != 0.0) acc /= wsum;
-        out[k] = (vv_dsp_real)acc;
+        copy_frames(buf + rs->buf_len * C, in, pos, n, C);
+        rs->buf_len += n;
+        rs->n_in += n;
+        pos += n;
+        copy_frames(last, in, pos - 1, 1, C);
+        const size_t r = stream_ready(rs, 0, 0);
+        stream_produce(rs, buf, C, r, out, k, tmp);
+        k += r;
+    }
+    *out_n = k;
+}
+
+// End of stream for the streaming core: pad the right edge with last[] and drain
+static size_t stream_drain(vv_dsp_resampler* rs, vv_dsp_real* buf, size_t C, rs_dst out, const vv_dsp_real* last,
+                           vv_dsp_real* tmp) {
+    const size_t want = stream_ready(rs, 0, 1);
+    if (want) {
+        const unsigned int la = window_len(rs) - window_back(rs) - 1;
+        for (unsigned int j = 0; j < la; ++j) memcpy(buf + (rs->buf_len + j) * C, last, C * sizeof(vv_dsp_real));
+        rs->buf_len += la;
+        stream_produce(rs, buf, C, want, out, 0, tmp);
+    }
+    stream_reset(rs);
+    return want;
+}
+
+int vv_dsp_resampler_process_stream(vv_dsp_resampler* rs,
+                                    const vv_dsp_real* in, size_t in_n,
+                                    vv_dsp_real* out, size_t out_cap,
+                                    size_t* out_n) {
+    if (!rs || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    if (in_n == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    if (rs->use_sinc && !rs->table) return VV_DSP_ERROR_INTERNAL;
+    const size_t want = stream_ready(rs, in_n, 0);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (ensure_stream_buffer(rs) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
+    const rs_src src = {in, NULL, NULL};
+    const rs_dst dst = {out, NULL, NULL};
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_RESAMPLE);
+    const int rt = VV_DSP_RT_ENTER(rs->max_block != 0);
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, rs->denormals);
+    stream_run(rs, rs->buf, rs->buf_cap, 1, src, in_n, dst, &rs->last, NULL, out_n);
+    vv_dsp_fp_scope_exit(&fp);
+    VV_DSP_RT_LEAVE(rt);
+    VV_DSP_PROFILE_END(prof, in_n);
+    return VV_DSP_OK;
+}
+
+int vv_dsp_resampler_prepare(vv_dsp_resampler* rs, size_t max_block) {
+    if (!rs) return VV_DSP_ERROR_NULL_POINTER;
+    if (max_block == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (ensure_stream_buffer(rs) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
+    rs->max_block = max_block;
+    return VV_DSP_OK;
+}
+
+int vv_dsp_resampler_flush(vv_dsp_resampler* rs, vv_dsp_real* out, size_t out_cap, size_t* out_n) {
+    if (!rs || !out_n) return VV_DSP_ERROR_NULL_POINTER;
+    *out_n = 0;
+    const size_t want = stream_ready(rs, 0, 1);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !out) return VV_DSP_ERROR_NULL_POINTER;
+    const rs_dst dst = {out, NULL, NULL};
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, rs->denormals);
+    *out_n = stream_drain(rs, rs->buf, 1, dst, &rs->last, NULL);
+    vv_dsp_fp_scope_exit(&fp);
+    return VV_DSP_OK;
+}
+
+int vv_dsp_resampler_set_denormals(vv_dsp_resampler* rs, vv_dsp_denormal_mode mode) {
+    if (!rs) return VV_DSP_ERROR_NULL_POINTER;
+    if (mode != VV_DSP_DENORMALS_KEEP && mode != VV_DSP_DENORMALS_FLUSH) return VV_DSP_ERROR_OUT_OF_RANGE;
+    rs->denormals = mode;
+    return VV_DSP_OK;
+}
+
+int vv_dsp_resampler_reset(vv_dsp_resampler* rs) {
+    if (!rs) return VV_DSP_ERROR_NULL_POINTER;
+    stream_reset(rs);
+    return VV_DSP_OK;
+}
+
+// ---- multi-channel ----------------------------------------------------------------
+
+struct vv_dsp_resampler_mc {
+    vv_dsp_resampler* rs;    // table, ratio and stream position (its buf stays unused)
+    size_t channels;
+    vv_dsp_real* buf;        // interleaved frames
+    size_t buf_cap;          // in frames
+    vv_dsp_real* last;       // most recent frame
+    vv_dsp_real* tmp;        // one output frame for planar output
+    size_t max_block;        // block size prepared for, 0 when not prepared
+};
+
+// Frame buffer for the current window of mc->rs
+static int mc_ensure_buffer(vv_dsp_resampler_mc* mc) {
+    const vv_dsp_resampler* rs = mc->rs;
+    const size_t need = (size_t)window_len(rs) + window_back(rs) + RS_STREAM_CHUNK;
+    if (mc->buf && mc->buf_cap >= need) return VV_DSP_OK;
+    vv_dsp_real* b = (vv_dsp_real*)vv_dsp_realloc(mc->buf, need * mc->channels * sizeof(vv_dsp_real));
+    if (!b) return VV_DSP_ERROR_INTERNAL;
+    mc->buf = b;
+    mc->buf_cap = need;
+    return VV_DSP_OK;
+}
+
+vv_dsp_resampler_mc* vv_dsp_resampler_mc_create(unsigned int ratio_num,
+                                                unsigned int ratio_den,
+                                                size_t num_channels) {
+    if (num_channels == 0 || num_channels > SIZE_MAX / sizeof(vv_dsp_real) / (128u + 64u + RS_STREAM_CHUNK))
+        return NULL;
+    vv_dsp_resampler_mc* mc = (vv_dsp_resampler_mc*)vv_dsp_calloc(1, sizeof(*mc));
+    if (!mc) return NULL;
+    mc->channels = num_channels;
+    mc->rs = vv_dsp_resampler_create(ratio_num, ratio_den);
+    mc->last = (vv_dsp_real*)vv_dsp_calloc(num_channels, sizeof(vv_dsp_real));
+    mc->tmp = (vv_dsp_real*)vv_dsp_calloc(num_channels, sizeof(vv_dsp_real));
+    if (!mc->rs || !mc->last || !mc->tmp) {
+        vv_dsp_resampler_mc_destroy(mc);
+        return NULL;
+    }
+    return mc;
+}
+
+void vv_dsp_resampler_mc_destroy(vv_dsp_resampler_mc* mc) {
+    if (!mc) return;
+    vv_dsp_resampler_destroy(mc->rs);
+    vv_dsp_free(mc->buf);
+    vv_dsp_free(mc->last);
+    vv_dsp_free(mc->tmp);
+    vv_dsp_free(mc);
+}
+
+int vv_dsp_resampler_mc_set_ratio(vv_dsp_resampler_mc* mc, unsigned int ratio_num, unsigned int ratio_den) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    const int s = vv_dsp_resampler_set_ratio(mc->rs, ratio_num, ratio_den);
+    return (s == VV_DSP_OK && mc->max_block) ? mc_ensure_buffer(mc) : s;
+}
+
+int vv_dsp_resampler_mc_set_quality(vv_dsp_resampler_mc* mc, int use_sinc, unsigned int taps) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    const int s = vv_dsp_resampler_set_quality(mc->rs, use_sinc, taps);
+    return (s == VV_DSP_OK && mc->max_block) ? mc_ensure_buffer(mc) : s;
+}
+
+int vv_dsp_resampler_mc_set_precision(vv_dsp_resampler_mc* mc, vv_dsp_precision_mode mode) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    const int s = vv_dsp_resampler_set_precision(mc->rs, mode);
+    return (s == VV_DSP_OK && mc->max_block) ? mc_ensure_buffer(mc) : s;
+}
+
+int vv_dsp_resampler_mc_set_denormals(vv_dsp_resampler_mc* mc, vv_dsp_denormal_mode mode) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    return vv_dsp_resampler_set_denormals(mc->rs, mode);
+}
+
+int vv_dsp_resampler_mc_prepare(vv_dsp_resampler_mc* mc, size_t max_block) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    if (max_block == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (mc_ensure_buffer(mc) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
+    mc->max_block = max_block;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_resampler_mc_out_needed(const vv_dsp_resampler_mc* mc, size_t in_frames) {
+    return mc ? stream_ready(mc->rs, in_frames, 0) : 0;
+}
+
+static int mc_process(vv_dsp_resampler_mc* mc, rs_src in, size_t in_frames, rs_dst out, size_t out_cap,
+                      size_t* out_frames) {
+    vv_dsp_resampler* rs = mc->rs;
+    if (rs->use_sinc && !rs->table) return VV_DSP_ERROR_INTERNAL;
+    const size_t want = stream_ready(rs, in_frames, 0);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    if (want && !out.il && !out.pl && !out.buf) return VV_DSP_ERROR_NULL_POINTER;
+    if (mc_ensure_buffer(mc) != VV_DSP_OK) return VV_DSP_ERROR_INTERNAL;
+    const int rt = VV_DSP_RT_ENTER(mc->max_block != 0);
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, rs->denormals);
+    stream_run(rs, mc->buf, mc->buf_cap, mc->channels, in, in_frames, out, mc->last, mc->tmp, out_frames);
+    vv_dsp_fp_scope_exit(&fp);
+    VV_DSP_RT_LEAVE(rt);
+    return VV_DSP_OK;
+}
+
+// Planar pointer arrays must hold a non-NULL pointer per channel
+static int planar_ok(const vv_dsp_real* const* p, size_t C) {
+    if (!p) return 0;
+    for (size_t c = 0; c < C; ++c) {
+        if (!p[c]) return 0;
     }
+    return 1;
+}
+
+int vv_dsp_resampler_mc_process_interleaved(vv_dsp_resampler_mc* mc,
+                                            const vv_dsp_real* in, size_t in_frames,
+                                            vv_dsp_real* out, size_t out_cap,
+                                            size_t* out_frames) {
+    if (!mc || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (in_frames == 0) return VV_DSP_OK;
+    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const rs_src src = {in, NULL, NULL};
+    const rs_dst dst = {out, NULL, NULL};
+    return mc_process(mc, src, in_frames, dst, out_cap, out_frames);
+}
+
+int vv_dsp_resampler_mc_process_planar(vv_dsp_resampler_mc* mc,
+                                       const vv_dsp_real* const* in, size_t in_frames,
+                                       vv_dsp_real* const* out, size_t out_cap,
+                                       size_t* out_frames) {
+    if (!mc || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (in_frames == 0) return VV_DSP_OK;
+    if (!planar_ok(in, mc->channels) || !planar_ok((const vv_dsp_real* const*)out, mc->channels))
+        return VV_DSP_ERROR_NULL_POINTER;
+    const rs_src src = {NULL, in, NULL};
+    const rs_dst dst = {NULL, out, NULL};
+    return mc_process(mc, src, in_frames, dst, out_cap, out_frames);
+}
+
+// Interleaved buffers take the interleaved path; the others copy through their strides
+static void mc_buffer_ends(const vv_dsp_resampler_mc* mc, const vv_dsp_buffer* b, const vv_dsp_real** il,
+                           const vv_dsp_buffer** buf) {
+    const int packed = mc->channels == 1 ? b->frame_stride == 1
+                                         : b->channel_stride == 1 && b->frame_stride == mc->channels;
+    *il = packed ? b->data : NULL;
+    *buf = packed ? NULL : b;
+}
+
+int vv_dsp_resampler_mc_process_buffer(vv_dsp_resampler_mc* mc, const vv_dsp_buffer* in, vv_dsp_buffer* out,
+                                       size_t* out_frames) {
+    if (!mc || !in || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (in->channels != mc->channels || out->channels != mc->channels) return VV_DSP_ERROR_INVALID_SIZE;
+    if (in->frames == 0) return VV_DSP_OK;
+    if (!in->data || !out->data) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_real* il = NULL;
+    const vv_dsp_buffer* buf = NULL;
+    mc_buffer_ends(mc, in, &il, &buf);
+    const rs_src src = {il, NULL, buf};
+    mc_buffer_ends(mc, out, &il, &buf);
+    const rs_dst dst = {(vv_dsp_real*)(uintptr_t)il, NULL, buf};
+    return mc_process(mc, src, in->frames, dst, out->frames, out_frames);
+}
+
+static int mc_flush(vv_dsp_resampler_mc* mc, rs_dst out, size_t out_cap, size_t* out_frames) {
+    const size_t want = stream_ready(mc->rs, 0, 1);
+    if (want > out_cap) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fp_scope fp;
+    vv_dsp_fp_scope_enter(&fp, mc->rs->denormals);
+    *out_frames = stream_drain(mc->rs, mc->buf, mc->channels, out, mc->last, mc->tmp);
+    vv_dsp_fp_scope_exit(&fp);
     return VV_DSP_OK;
 }
+
+int vv_dsp_resampler_mc_flush_interleaved(vv_dsp_resampler_mc* mc, vv_dsp_real* out, size_t out_cap,
+                                          size_t* out_frames) {
+    if (!mc || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    const rs_dst dst = {out, NULL, NULL};
+    return mc_flush(mc, dst, out_cap, out_frames);
+}
+
+int vv_dsp_resampler_mc_flush_buffer(vv_dsp_resampler_mc* mc, vv_dsp_buffer* out, size_t* out_frames) {
+    if (!mc || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (out->channels != mc->channels) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!out->data) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_real* il = NULL;
+    const vv_dsp_buffer* buf = NULL;
+    mc_buffer_ends(mc, out, &il, &buf);
+    const rs_dst dst = {(vv_dsp_real*)(uintptr_t)il, NULL, buf};
+    return mc_flush(mc, dst, out->frames, out_frames);
+}
+
+int vv_dsp_resampler_mc_flush_planar(vv_dsp_resampler_mc* mc, vv_dsp_real* const* out, size_t out_cap,
+                                     size_t* out_frames) {
+    if (!mc || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (!planar_ok((const vv_dsp_real* const*)out, mc->channels)) return VV_DSP_ERROR_NULL_POINTER;
+    const rs_dst dst = {NULL, out, NULL};
+    return mc_flush(mc, dst, out_cap, out_frames);
+}
+
+int vv_dsp_resampler_mc_reset(vv_dsp_resampler_mc* mc) {
+    if (!mc) return VV_DSP_ERROR_NULL_POINTER;
+    return vv_dsp_resampler_reset(mc->rs);
+}
@@ -0,0 +1,378 @@
+/*
+This file is part of vv-dsp
+
+Bin bank: a small set of DFT bins of n-sample blocks, evaluated with
+Goertzel recurrences (scalar or several bins per SIMD vector) or with an
+output-pruned FFT, whichever the plan-time cost estimate favours.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/spectral/bin_bank.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/alloc.h"
+#include "simd_f64.h"
+
+// Goertzel states are double in every build, so the kernels use double lanes.
+// Bins advanced together in one pass over the samples (vector or scalar interleave)
+#if VV_F64_LANES > 1
+#  define BB_PASS_WIDTH (4 * VV_F64_LANES)
+#else
+#  define BB_PASS_WIDTH 4
+#endif
+
+// Rough per-block costs used by the AUTO choice, in units of about a quarter cycle
+#define BB_COST_GOERTZEL_PASS 32.0  // per sample and pass of BB_PASS_WIDTH bins (latency bound)
+#define BB_COST_FFT 2.5             // times P*log2(P) per real FFT of size P
+#define BB_COST_FFT_CALL 400.0      // per sub-FFT
+#define BB_COST_COMBINE 8.0         // per complex multiply-add when combining sub-FFTs
+
+struct vv_dsp_bin_bank_plan {
+    size_t n;
+    size_t num_bins;
+    size_t padded;  // num_bins rounded up to a multiple of BB_PASS_WIDTH
+    vv_dsp_bin_bank_method method;
+
+    // Goertzel: X = exp(-i*w*n) * ((cos w * s1 - s2) + i * sin w * s1)
+    double* coef;            // padded: 2*cos(w); padding lanes are zero
+    double* cw;              // cos(w)
+    double* sw;              // sin(w)
+    vv_dsp_cpx* rot;         // exp(-i*w*n), 1 for integer bins
+    double* ex_s1;           // execute() states (padded)
+    double* ex_s2;
+    double* st_s1;           // streaming states (padded)
+    double* st_s2;
+
+    // Pruned FFT: n = P*Q, X[k] = sum_q W_n^{qk} * FFT_P(x[p*Q + q])[k mod P]
+    size_t P, Q;
+    size_t* bin_index;       // integer bins
+    vv_dsp_fft_plan* fft;    // Q real FFTs of size P
+    vv_dsp_real* deint;      // n: the Q decimated sequences back to back
+    vv_dsp_cpx* spec;        // Q * (P/2+1)
+    vv_dsp_cpx* tw;          // num_bins * Q combining twiddles
+
+    // Streaming
+    vv_dsp_real* block;      // n samples (pruned FFT only)
+    size_t pos;              // samples of the current block seen so far
+};
+
+static void* bb_calloc(size_t count, size_t size) {
+    return count ? vv_dsp_calloc(count, size) : NULL;
+}
+
+static void bb_free(vv_dsp_bin_bank_plan* p) {
+    if (!p) return;
+    vv_dsp_free(p->coef); vv_dsp_free(p->cw); vv_dsp_free(p->sw); vv_dsp_free(p->rot);
+    vv_dsp_free(p->ex_s1); vv_dsp_free(p->ex_s2); vv_dsp_free(p->st_s1); vv_dsp_free(p->st_s2);
+    vv_dsp_free(p->bin_index);
+    if (p->fft) (void)vv_dsp_fft_destroy(p->fft);
+    vv_dsp_free(p->deint); vv_dsp_free(p->spec); vv_dsp_free(p->tw); vv_dsp_free(p->block);
+    vv_dsp_free(p);
+}
+
+static int bins_are_integer(const vv_dsp_real* bins, size_t num_bins, size_t n) {
+    for (size_t b = 0; b < num_bins; ++b) {
+        const double f = (double)bins[b];
+        if (f < 0.0 || f >= (double)n || f != floor(f)) return 0;
+    }
+    return 1;
+}
+
+// Cheapest factor P of n for the pruned FFT; returns the estimated cost
+static double pruned_best_factor(size_t n, size_t num_bins, size_t* out_p) {
+    double best = -1.0;
+    *out_p = n;
+    for (size_t P = 2; P <= n; ++P) {
+        if (n % P != 0) continue;
+        const size_t Q = n / P;
+        const double cost = BB_COST_FFT * (double)n * log2((double)P)
+                          + (BB_COST_COMBINE * (double)num_bins + BB_COST_FFT_CALL) * (double)Q
+                          + 2.0 * (double)n;
+        if (best < 0.0 || cost < best) {
+            best = cost;
+            *out_p = P;
+        }
+    }
+    return best;
+}
+
+static vv_dsp_status init_goertzel(vv_dsp_bin_bank_plan* p, const vv_dsp_real* bins) {
+    const size_t nb = p->num_bins, np = p->padded;
+    p->coef = (double*)bb_calloc(np, sizeof(double));
+    p->cw = (double*)bb_calloc(nb, sizeof(double));
+    p->sw = (double*)bb_calloc(nb, sizeof(double));
+    p->rot = (vv_dsp_cpx*)bb_calloc(nb, sizeof(vv_dsp_cpx));
+    p->ex_s1 = (double*)bb_calloc(np, sizeof(double));
+    p->ex_s2 = (double*)bb_calloc(np, sizeof(double));
+    p->st_s1 = (double*)bb_calloc(np, sizeof(double));
+    p->st_s2 = (double*)bb_calloc(np, sizeof(double));
+    if (!p->coef || !p->cw || !p->sw || !p->rot || !p->ex_s1 || !p->ex_s2 || !p->st_s1 || !p->st_s2) {
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t b = 0; b < nb; ++b) {
+        const double f = (double)bins[b];
+        const double w = 2.0 * VV_DSP_PI_D * f / (double)p->n;
+        p->cw[b] = cos(w);
+        p->sw[b] = sin(w);
+        p->coef[b] = 2.0 * p->cw[b];
+        // exp(-i*w*n) = exp(-i*2*pi*frac(f)); exact 1 for integer bins
+        const double frac = f - floor(f);
+        p->rot[b] = vv_dsp_cpx_make((vv_dsp_real)cos(-2.0 * VV_DSP_PI_D * frac),
+                                    (vv_dsp_real)sin(-2.0 * VV_DSP_PI_D * frac));
+    }
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status init_pruned(vv_dsp_bin_bank_plan* p, const vv_dsp_real* bins) {
+    const size_t n = p->n, nb = p->num_bins;
+    (void)pruned_best_factor(n, nb, &p->P);
+    p->Q = n / p->P;
+    const size_t P = p->P, Q = p->Q, nh = P / 2 + 1;
+    vv_dsp_status s = vv_dsp_fft_make_plan_many(P, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD,
+                                                Q, 1, P, 1, nh, &p->fft);
+    if (s != VV_DSP_OK) return s;
+    p->bin_index = (size_t*)bb_calloc(nb, sizeof(size_t));
+    p->deint = (vv_dsp_real*)bb_calloc(n, sizeof(vv_dsp_real));
+    p->spec = (vv_dsp_cpx*)bb_calloc(Q * nh, sizeof(vv_dsp_cpx));
+    p->tw = (vv_dsp_cpx*)bb_calloc(nb * Q, sizeof(vv_dsp_cpx));
+    p->block = (vv_dsp_real*)bb_calloc(n, sizeof(vv_dsp_real));
+    if (!p->bin_index || !p->deint || !p->spec || !p->tw || !p->block) return VV_DSP_ERROR_INTERNAL;
+    for (size_t b = 0; b < nb; ++b) {
+        const size_t k = (size_t)bins[b];
+        p->bin_index[b] = k;
+        for (size_t q = 0; q < Q; ++q) {
+            const double ang = -2.0 * VV_DSP_PI_D * (double)((q * k) % n) / (double)n;
+            p->tw[b * Q + q] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
+        }
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_make_plan(size_t n,
+                                                         const vv_dsp_real* bins,
+                                                         size_t num_bins,
+                                                         vv_dsp_bin_bank_method method,
+                                                         vv_dsp_bin_bank_plan** out_plan) {
+    if (!out_plan || !bins) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (n == 0 || num_bins == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (method < VV_DSP_BIN_BANK_AUTO || method > VV_DSP_BIN_BANK_PRUNED_FFT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    for (size_t b = 0; b < num_bins; ++b) {
+        if (!isfinite((double)bins[b])) return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const int integer_bins = bins_are_integer(bins, num_bins, n);
+    if (method == VV_DSP_BIN_BANK_PRUNED_FFT && !integer_bins) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (method == VV_DSP_BIN_BANK_PRUNED_FFT && n < 2) return VV_DSP_ERROR_INVALID_SIZE;
+
+    if (method == VV_DSP_BIN_BANK_AUTO) {
+        const double passes = (double)((num_bins + BB_PASS_WIDTH - 1) / BB_PASS_WIDTH);
+        const double goertzel = BB_COST_GOERTZEL_PASS * (double)n * passes;
+        method = VV_F64_LANES > 1 ? VV_DSP_BIN_BANK_GOERTZEL_SIMD : VV_DSP_BIN_BANK_GOERTZEL;
+        size_t P = 0;
+        if (integer_bins && n >= 2 && pruned_best_factor(n, num_bins, &P) < goertzel) {
+            method = VV_DSP_BIN_BANK_PRUNED_FFT;
+        }
+    }
+    if (method == VV_DSP_BIN_BANK_GOERTZEL_SIMD && VV_F64_LANES == 1) method = VV_DSP_BIN_BANK_GOERTZEL;
+
+    vv_dsp_bin_bank_plan* p = (vv_dsp_bin_bank_plan*)vv_dsp_calloc(1, sizeof(vv_dsp_bin_bank_plan));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->n = n;
+    p->num_bins = num_bins;
+    p->padded = (num_bins + BB_PASS_WIDTH - 1) / BB_PASS_WIDTH * BB_PASS_WIDTH;
+    p->method = method;
+    vv_dsp_status s = (method == VV_DSP_BIN_BANK_PRUNED_FFT) ? init_pruned(p, bins) : init_goertzel(p, bins);
+    if (s != VV_DSP_OK) {
+        bb_free(p);
+        return s;
+    }
+    *out_plan = p;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_make_plan_hz(size_t n,
+                                                            const vv_dsp_real* freqs_hz,
+                                                            size_t num_freqs,
+                                                            vv_dsp_real sample_rate,
+                                                            vv_dsp_bin_bank_method method,
+                                                            vv_dsp_bin_bank_plan** out_plan) {
+    if (!out_plan || !freqs_hz) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (num_freqs == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(sample_rate > 0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_real* bins = (vv_dsp_real*)vv_dsp_malloc(num_freqs * sizeof(vv_dsp_real));
+    if (!bins) return VV_DSP_ERROR_INTERNAL;
+    for (size_t i = 0; i < num_freqs; ++i) {
+        bins[i] = (vv_dsp_real)((double)freqs_hz[i] * (double)n / (double)sample_rate);
+    }
+    vv_dsp_status s = vv_dsp_bin_bank_make_plan(n, bins, num_freqs, method, out_plan);
+    vv_dsp_free(bins);
+    return s;
+}
+
+vv_dsp_bin_bank_method vv_dsp_bin_bank_get_method(const vv_dsp_bin_bank_plan* plan) {
+    return plan ? plan->method : VV_DSP_BIN_BANK_AUTO;
+}
+
+// Advance every bin's recurrence s = x + 2cos(w)*s1 - s2 over m samples.
+// Written as (x - s2) + c*s1 so only the multiply-add sits on the s1 chain.
+static void goertzel_update(const vv_dsp_bin_bank_plan* p, double* s1, double* s2,
+                            const vv_dsp_real* x, size_t m) {
+    size_t b = 0;
+#if VV_F64_LANES > 1
+    if (p->method == VV_DSP_BIN_BANK_GOERTZEL_SIMD) {
+        // Four vectors per pass hide the latency of the recurrence; padded covers whole passes
+        for (; b < p->padded; b += BB_PASS_WIDTH) {
+            vv_f64_vec c[4], a[4], z[4];
+            for (int v = 0; v < 4; ++v) {
+                c[v] = VV_F64_LOAD(p->coef + b + v * VV_F64_LANES);
+                a[v] = VV_F64_LOAD(s1 + b + v * VV_F64_LANES);
+                z[v] = VV_F64_LOAD(s2 + b + v * VV_F64_LANES);
+            }
+            for (size_t j = 0; j < m; ++j) {
+                const vv_f64_vec xv = VV_F64_SET1((double)x[j]);
+                for (int v = 0; v < 4; ++v) {
+                    const vv_f64_vec t = VV_F64_MULADD(VV_F64_SUB(xv, z[v]), c[v], a[v]);
+                    z[v] = a[v];
+                    a[v] = t;
+                }
+            }
+            for (int v = 0; v < 4; ++v) {
+                VV_F64_STORE(s1 + b + v * VV_F64_LANES, a[v]);
+                VV_F64_STORE(s2 + b + v * VV_F64_LANES, z[v]);
+            }
+        }
+    }
+#endif
+    // Scalar: four independent recurrences per pass
+    for (; b + 4 <= p->num_bins; b += 4) {
+        const double c0 = p->coef[b], c1 = p->coef[b + 1], c2 = p->coef[b + 2], c3 = p->coef[b + 3];
+        double a0 = s1[b], a1 = s1[b + 1], a2 = s1[b + 2], a3 = s1[b + 3];
+        double z0 = s2[b], z1 = s2[b + 1], z2 = s2[b + 2], z3 = s2[b + 3];
+        for (size_t j = 0; j < m; ++j) {
+            const double xv = (double)x[j];
+            const double t0 = (xv - z0) + c0 * a0, t1 = (xv - z1) + c1 * a1;
+            const double t2 = (xv - z2) + c2 * a2, t3 = (xv - z3) + c3 * a3;
+            z0 = a0; a0 = t0; z1 = a1; a1 = t1;
+            z2 = a2; a2 = t2; z3 = a3; a3 = t3;
+        }
+        s1[b] = a0; s1[b + 1] = a1; s1[b + 2] = a2; s1[b + 3] = a3;
+        s2[b] = z0; s2[b + 1] = z1; s2[b + 2] = z2; s2[b + 3] = z3;
+    }
+    for (; b < p->num_bins; ++b) {
+        const double c = p->coef[b];
+        double a = s1[b], z = s2[b];
+        for (size_t j = 0; j < m; ++j) {
+            const double t = ((double)x[j] - z) + c * a;
+            z = a;
+            a = t;
+        }
+        s1[b] = a;
+        s2[b] = z;
+    }
+}
+
+// Turn the states after a full block into bin values and clear them
+static void goertzel_finish(const vv_dsp_bin_bank_plan* p, double* s1, double* s2, vv_dsp_cpx* out) {
+    for (size_t b = 0; b < p->num_bins; ++b) {
+        const double yr = p->cw[b] * s1[b] - s2[b];
+        const double yi = p->sw[b] * s1[b];
+        const double rr = (double)p->rot[b].re, ri = (double)p->rot[b].im;
+        out[b] = vv_dsp_cpx_make((vv_dsp_real)(yr * rr - yi * ri), (vv_dsp_real)(yr * ri + yi * rr));
+    }
+    memset(s1, 0, p->padded * sizeof(double));
+    memset(s2, 0, p->padded * sizeof(double));
+}
+
+static vv_dsp_status pruned_execute(const vv_dsp_bin_bank_plan* p, const vv_dsp_real* x, vv_dsp_cpx* out) {
+    const size_t P = p->P, Q = p->Q, nh = P / 2 + 1;
+    for (size_t q = 0; q < Q; ++q) {
+        vv_dsp_real* d = p->deint + q * P;
+        for (size_t k = 0; k < P; ++k) d[k] = x[k * Q + q];
+    }
+    vv_dsp_status s = vv_dsp_fft_execute_batch(p->fft, p->deint, p->spec);
+    if (s != VV_DSP_OK) return s;
+    for (size_t b = 0; b < p->num_bins; ++b) {
+        const size_t m = p->bin_index[b] % P;
+        // Bins above P/2 come from the conjugate-symmetric half
+        const size_t idx = (m < nh) ? m : P - m;
+        const vv_dsp_real sign = (m < nh) ? (vv_dsp_real)1 : (vv_dsp_real)-1;
+        const vv_dsp_cpx* tw = p->tw + b * Q;
+        vv_dsp_real acc_re = 0, acc_im = 0;
+        for (size_t q = 0; q < Q; ++q) {
+            const vv_dsp_cpx y = p->spec[q * nh + idx];
+            const vv_dsp_real yi = sign * y.im;
+            acc_re += tw[q].re * y.re - tw[q].im * yi;
+            acc_im += tw[q].re * yi + tw[q].im * y.re;
+        }
+        out[b] = vv_dsp_cpx_make(acc_re, acc_im);
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_execute(const vv_dsp_bin_bank_plan* plan,
+                                                       const vv_dsp_real* in,
+                                                       vv_dsp_cpx* out) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (plan->method == VV_DSP_BIN_BANK_PRUNED_FFT) return pruned_execute(plan, in, out);
+    memset(plan->ex_s1, 0, plan->padded * sizeof(double));
+    memset(plan->ex_s2, 0, plan->padded * sizeof(double));
+    goertzel_update(plan, plan->ex_s1, plan->ex_s2, in, plan->n);
+    goertzel_finish(plan, plan->ex_s1, plan->ex_s2, out);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_bin_bank_process(vv_dsp_bin_bank_plan* plan,
+                                                       const vv_dsp_real* in,
+                                                       size_t len,
+                                                       vv_dsp_cpx* out,
+                                                       size_t max_frames,
+                                                       size_t* out_frames) {
+    if (!plan || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    *out_frames = 0;
+    if (len == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = (plan->pos + len) / plan->n;
+    if (frames > max_frames) return VV_DSP_ERROR_INVALID_SIZE;
+    if (frames > 0 && !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    while (len > 0) {
+        const size_t take = (plan->n - plan->pos < len) ? plan->n - plan->pos : len;
+        if (plan->method == VV_DSP_BIN_BANK_PRUNED_FFT) {
+            memcpy(plan->block + plan->pos, in, take * sizeof(vv_dsp_real));
+        } else {
+            goertzel_update(plan, plan->st_s1, plan->st_s2, in, take);
+        }
+        plan->pos += take;
+        in += take;
+        len -= take;
+        if (plan->pos == plan->n) {
+            vv_dsp_cpx* dst = out + *out_frames * plan->num_bins;
+            if (plan->method == VV_DSP_BIN_BANK_PRUNED_FFT) {
+                vv_dsp_status s = pruned_execute(plan, plan->block, dst);
+                if (s != VV_DSP_OK) return s;
+            } else {
+                goertzel_finish(plan, plan->st_s1, plan->st_s2, dst);
+            }
+            plan->pos = 0;
+            ++*out_frames;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_bin_bank_reset(vv_dsp_bin_bank_plan* plan) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    plan->pos = 0;
+    if (plan->st_s1) memset(plan->st_s1, 0, plan->padded * sizeof(double));
+    if (plan->st_s2) memset(plan->st_s2, 0, plan->padded * sizeof(double));
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_bin_bank_destroy(vv_dsp_bin_bank_plan* plan) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    bb_free(plan);
+    return VV_DSP_OK;
+}
@@ -0,0 +1,140 @@
+/*
+This file is part of vv-dsp
+
+vv_dsp_autocorrelation() and vv_dsp_cross_correlation() (declared in core.h).
+They live in the spectral module because long lag ranges run as zero-padded
+R2C / C2R correlation through the plan cache; the direct O(N L) loops remain
+for short lag ranges, where the transforms are never repaid. The direct loops
+accumulate sequentially in double, so they are reproducible as they stand; in the
+PAIRWISE and COMPENSATED reduction modes the transforms run on single-threaded
+KissFFT plans for the same reason.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/spectral/fft.h"
+#include "fft_backend.h"
+
+// Direct cost ~ n * lags, FFT cost ~ P log2 P with P >= n + lags: the FFT wins once
+// lags exceeds CORR_LAGS_PER_LOG2 * log2(P). Measured on x86-64 (SSE2 and AVX2
+// builds agree to within a factor of two around it).
+#define CORR_LAGS_PER_LOG2 4
+#define CORR_MIN_FFT 64
+
+static size_t next_pow2(size_t v) {
+    size_t n = 1;
+    while (n < v) n <<= 1;
+    return n;
+}
+
+static int corr_use_fft(size_t lags, size_t P) {
+    if (P < CORR_MIN_FFT) return 0;
+    size_t lg = 0;
+    while (((size_t)1 << lg) < P) ++lg;
+    return lags > CORR_LAGS_PER_LOG2 * lg;
+}
+
+// r[lag] = sum_i x[i] * y[i + lag] / norm(lag) for lag < num_lags, computed as
+// IFFT(conj(X) Y). P >= max(ny, nx + num_lags - 1) keeps the negative lags of the
+// linear correlation from wrapping onto the ones we read. y == x (and ny == nx)
+// for autocorrelation skips the second transform.
+static vv_dsp_status corr_fft(const vv_dsp_real* x, size_t nx, const vv_dsp_real* y, size_t ny,
+                              size_t P, size_t num_lags, int biased, vv_dsp_real* r) {
+    const size_t nc = P / 2 + 1;
+    const int autoc = (x == y && nx == ny);
+    vv_dsp_fft_plan *fwd = NULL, *inv = NULL;
+    vv_dsp_real* buf = (vv_dsp_real*)vv_dsp_aligned_malloc(P * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+    vv_dsp_cpx* X = (vv_dsp_cpx*)vv_dsp_aligned_malloc(2 * nc * sizeof(vv_dsp_cpx), VV_DSP_SIMD_ALIGN_DEFAULT);
+    vv_dsp_status st = (buf && X) ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+    if (vv_dsp_get_reduction_mode() != VV_DSP_REDUCTION_FAST) {
+        if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire_reproducible(P, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &fwd);
+        if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire_reproducible(P, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &inv);
+    } else {
+        if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &fwd);
+        if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &inv);
+    }
+    vv_dsp_cpx* Y = X + nc;
+
+    if (st == VV_DSP_OK) {
+        memcpy(buf, x, nx * sizeof(vv_dsp_real));
+        memset(buf + nx, 0, (P - nx) * sizeof(vv_dsp_real));
+        st = vv_dsp_fft_execute(fwd, buf, X);
+    }
+    if (st == VV_DSP_OK && !autoc) {
+        memcpy(buf, y, ny * sizeof(vv_dsp_real));
+        memset(buf + ny, 0, (P - ny) * sizeof(vv_dsp_real));
+        st = vv_dsp_fft_execute(fwd, buf, Y);
+    }
+    if (st == VV_DSP_OK) {
+        if (autoc) {
+            for (size_t k = 0; k < nc; ++k) {
+                Y[k].re = X[k].re * X[k].re + X[k].im * X[k].im;
+                Y[k].im = (vv_dsp_real)0;
+            }
+        } else {
+            // Y conj(X): the spectrum of r[lag] = sum x[n] y[n + lag]
+            (void)vv_dsp_cpx_conj_mul_array(Y, X, Y, nc);
+        }
+        st = vv_dsp_fft_execute(inv, Y, buf);
+    }
+    if (st == VV_DSP_OK) {
+        // Normalization is folded into the copy-out (C2R already scaled by 1/P)
+        for (size_t lag = 0; lag < num_lags; ++lag) {
+            const size_t count = (ny - lag < nx) ? ny - lag : nx;
+            const double norm = (autoc && biased) ? (double)nx : (double)count;
+            r[lag] = (vv_dsp_real)((double)buf[lag] / norm);
+        }
+    }
+    vv_dsp_fft_plan_release(fwd);
+    vv_dsp_fft_plan_release(inv);
+    vv_dsp_aligned_free(buf);
+    vv_dsp_aligned_free(X);
+    return st;
+}
+
+vv_dsp_status vv_dsp_autocorrelation(const vv_dsp_real* x, size_t n, vv_dsp_real* r, size_t r_len, int biased) {
+    if (!r || !x || n == 0) return VV_DSP_ERROR_NULL_POINTER;
+    if (r_len == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t lags = (r_len < n) ? r_len : n;
+    for (size_t lag = lags; lag < r_len; ++lag) r[lag] = 0;
+
+    const size_t P = next_pow2(n + lags - 1);
+    if (corr_use_fft(lags, P)) {
+        vv_dsp_status st = corr_fft(x, n, x, n, P, lags, biased, r);
+        if (st != VV_DSP_ERROR_INTERNAL) return st;
+        // allocation failure: fall back to the direct loop
+    }
+    for (size_t lag = 0; lag < lags; ++lag) {
+        double acc = 0.0;
+        for (size_t i = 0; i + lag < n; ++i) acc += (double)x[i] * (double)x[i + lag];
+        r[lag] = (vv_dsp_real)(acc / (biased ? (double)n : (double)(n - lag)));
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_cross_correlation(const vv_dsp_real* x, size_t nx,
+                                       const vv_dsp_real* y, size_t ny,
+                                       vv_dsp_real* r, size_t r_len) {
+    if (!r || !x || nx == 0 || !y || ny == 0) return VV_DSP_ERROR_NULL_POINTER;
+    if (r_len == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    // Define r[k] for k = 0..r_len-1 as correlation with lag k (y delayed by k),
+    // averaged over the overlap; lags without overlap are 0
+    const size_t lags = (r_len < ny) ? r_len : ny;
+    for (size_t lag = lags; lag < r_len; ++lag) r[lag] = 0;
+
+    size_t P = next_pow2(nx + lags - 1);
+    if (P < ny) P = next_pow2(ny);
+    if (corr_use_fft(lags, P)) {
+        vv_dsp_status st = corr_fft(x, nx, y, ny, P, lags, 0, r);
+        if (st != VV_DSP_ERROR_INTERNAL) return st;
+    }
+    for (size_t lag = 0; lag < lags; ++lag) {
+        const size_t count = (ny - lag < nx) ? ny - lag : nx;
+        double acc = 0.0;
+        for (size_t i = 0; i < count; ++i) acc += (double)x[i] * (double)y[i + lag];
+        r[lag] = (vv_dsp_real)(acc / (double)count);
+    }
+    return VV_DSP_OK;
+}
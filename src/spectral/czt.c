@@ -3,20 +3,38 @@
 #include <math.h>
 #include "vv_dsp/spectral.h"
 #include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/arena.h"
 #include "vv_dsp/vv_dsp_math.h"
 
 // simple helpers
 static VV_DSP_INLINE vv_dsp_cpx cpx_mul(vv_dsp_cpx a, vv_dsp_cpx b){
     vv_dsp_cpx r; r.re = a.re*b.re - a.im*b.im; r.im = a.re*b.im + a.im*b.re; return r;
 }
-/* Removed unused helper to silence -Wunused-function and keep TU minimal */
-/* static VV_DSP_INLINE vv_dsp_cpx cpx_conj(vv_dsp_cpx a){ vv_dsp_cpx r; r.re=a.re; r.im=-a.im; return r; } */
-static VV_DSP_INLINE vv_dsp_cpx cpx_from(vv_dsp_real re, vv_dsp_real im){ vv_dsp_cpx z; z.re=re; z.im=im; return z; }
 
 static size_t next_pow2(size_t v){
     size_t n = 1; while(n < v) n <<= 1; return n;
 }
 
+struct vv_dsp_czt_plan {
+    size_t N, M, P;
+    vv_dsp_arena* arena;  // owner of the struct and buffers, or NULL for the heap
+    vv_dsp_fft_plan* fwd;
+    vv_dsp_fft_plan* inv;
+    vv_dsp_cpx* g;     // N: A^{-n} * W^{+n^2/2}
+    vv_dsp_cpx* post;  // M: W^{+k^2/2}
+    vv_dsp_cpx* Bf;    // P: FFT of the chirp kernel W^{-m^2/2}, m = -(N-1)..M-1
+    vv_dsp_cpx* buf;   // P: time-domain work buffer
+    vv_dsp_cpx* spec;  // P: frequency-domain work buffer
+};
+
+// W^{e} for real exponent e, evaluated in double via magnitude/angle
+static vv_dsp_cpx w_pow(double magW, double argW, double e){
+    double mag = pow(magW, e), ang = e * argW;
+    vv_dsp_cpx z; z.re = (vv_dsp_real)(mag * cos(ang)); z.im = (vv_dsp_real)(mag * sin(ang));
+    return z;
+}
+
 vv_dsp_status vv_dsp_czt_params_for_freq_range(
     vv_dsp_real f_start,
     vv_dsp_real f_end,
@@ -37,142 +55,204 @@ vv_dsp_status vv_dsp_czt_params_for_freq_range(
     return VV_DSP_OK;
 }
 
-vv_dsp_status vv_dsp_czt_exec_real(
-    const vv_dsp_real* x,
-    size_t N,
-    size_t M,
-    vv_dsp_real W_re, vv_dsp_real W_im,
-    vv_dsp_real A_re, vv_dsp_real A_im,
-    vv_dsp_cpx* X)
-{
-    if (!x || !X) return VV_DSP_ERROR_NULL_POINTER;
-    // pack to complex and call complex variant
-    vv_dsp_cpx* xc = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
-    if (!xc) return VV_DSP_ERROR_INTERNAL;
-    for (size_t n=0;n<N;++n){ xc[n].re = x[n]; xc[n].im = (vv_dsp_real)0; }
-    vv_dsp_status st = vv_dsp_czt_exec_cpx(xc, N, M, W_re, W_im, A_re, A_im, X);
-    free(xc);
-    return st;
+void vv_dsp_czt_plan_destroy(vv_dsp_czt_plan* plan){
+    if (!plan) return;
+    vv_dsp_fft_plan_release(plan->fwd);
+    vv_dsp_fft_plan_release(plan->inv);
+    vv_dsp_scratch_free(plan->arena, plan->g);
+    vv_dsp_scratch_free(plan->arena, plan->post);
+    vv_dsp_scratch_free(plan->arena, plan->Bf);
+    vv_dsp_scratch_free(plan->arena, plan->buf);
+    vv_dsp_scratch_free(plan->arena, plan->spec);
+    vv_dsp_scratch_free(plan->arena, plan);
 }
 
-vv_dsp_status vv_dsp_czt_exec_cpx(
-    const vv_dsp_cpx* x,
+size_t vv_dsp_czt_scratch_size(size_t N, size_t M){
+    if (N == 0 || M == 0) return 0;
+    const size_t P = next_pow2(N + M - 1);
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_czt_plan)) +
+           vv_dsp_arena_request_size(N * sizeof(vv_dsp_cpx)) +
+           vv_dsp_arena_request_size(M * sizeof(vv_dsp_cpx)) +
+           3 * vv_dsp_arena_request_size(P * sizeof(vv_dsp_cpx));
+}
+
+vv_dsp_status vv_dsp_czt_plan_create_ex(
     size_t N,
     size_t M,
     vv_dsp_real W_re, vv_dsp_real W_im,
     vv_dsp_real A_re, vv_dsp_real A_im,
-    vv_dsp_cpx* X)
+    vv_dsp_arena* arena,
+    vv_dsp_czt_plan** out)
 {
-    if (!x || !X) return VV_DSP_ERROR_NULL_POINTER;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
     if (N == 0 || M == 0) return VV_DSP_ERROR_INVALID_SIZE;
 
-    // Precompute chirp sequences (Bluestein):
-    // g[n] = A^{-n} * W^{+n^2/2}
-    // h[m] = W^{-m^2/2}
-    vv_dsp_cpx A = cpx_from(A_re, A_im);
-
-    vv_dsp_cpx *g = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
-    vv_dsp_cpx *h = (vv_dsp_cpx*)malloc(M * sizeof(vv_dsp_cpx));
-    if (!g || !h) { free(g); free(h); return VV_DSP_ERROR_INTERNAL; }
-
-    // powers via recurrence for stability/speed
-    vv_dsp_cpx A_inv = cpx_from(A.re, -A.im);
-    // compute A^{-1}
-    vv_dsp_real denom = (A.re*A.re + A.im*A.im);
-    if (denom != (vv_dsp_real)0) { A_inv.re =  A.re/denom; A_inv.im = -A.im/denom; }
-
-    // Precompute W^(n^2/2) and W^(-k^2/2) using magnitude/angle decomposition
-    vv_dsp_real argW = (vv_dsp_real)VV_DSP_ATAN2((double)W_im, (double)W_re);
-    vv_dsp_real magW = (vv_dsp_real)hypot((double)W_re, (double)W_im);
-
-    vv_dsp_cpx A_pow = cpx_from(1,0);
-    vv_dsp_cpx A_inv_pow = cpx_from(1,0);
-
-    for (size_t n=0;n<N;++n){
-    // exponent e = +0.5 * n^2
-    vv_dsp_real e = (vv_dsp_real)0.5 * (vv_dsp_real)((double)n*(double)n);
-    vv_dsp_real ang = e * argW;
-    vv_dsp_real mag = (vv_dsp_real)VV_DSP_POW((double)magW, e);
-    vv_dsp_cpx W_n2 = cpx_from(mag * (vv_dsp_real)VV_DSP_COS(ang), mag * (vv_dsp_real)VV_DSP_SIN(ang));
-        if (n==0){ A_pow = cpx_from(1,0); A_inv_pow = cpx_from(1,0); }
-        else {
-            // A_pow = A_pow * A
-            vv_dsp_cpx t = A_pow; A_pow = cpx_mul(t, A);
-            t = A_inv_pow; A_inv_pow = cpx_mul(t, A_inv);
-        }
-        // g[n] = A^{-n} * W^{n^2/2}
-        g[n] = cpx_mul(A_inv_pow, W_n2);
-    }
-    for (size_t k=0;k<M;++k){
-        vv_dsp_real e = (vv_dsp_real)0.5 * (vv_dsp_real)((double)k*(double)k);
-        vv_dsp_real ang = -e * argW;
-        vv_dsp_real mag = (vv_dsp_real)VV_DSP_POW((double)magW, -e);
-        h[k] = cpx_from(mag * (vv_dsp_real)VV_DSP_COS(ang), mag * (vv_dsp_real)VV_DSP_SIN(ang));
+    vv_dsp_czt_plan* p = (vv_dsp_czt_plan*)vv_dsp_scratch_alloc(arena, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    memset(p, 0, sizeof(*p));
+    p->arena = arena;
+    // Convolution length L = N+M-1; use FFT length P >= next_pow2(L)
+    const size_t L = N + M - 1;
+    p->N = N; p->M = M; p->P = next_pow2(L);
+    const size_t P = p->P;
+
+    vv_dsp_status st = vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &p->fwd);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &p->inv);
+    if (st == VV_DSP_OK) {
+        p->g    = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, N * sizeof(vv_dsp_cpx));
+        p->post = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, M * sizeof(vv_dsp_cpx));
+        p->Bf   = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, P * sizeof(vv_dsp_cpx));
+        p->buf  = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, P * sizeof(vv_dsp_cpx));
+        p->spec = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, P * sizeof(vv_dsp_cpx));
+        if (!p->g || !p->post || !p->Bf || !p->buf || !p->spec) st = VV_DSP_ERROR_INTERNAL;
     }
+    if (st != VV_DSP_OK) { vv_dsp_czt_plan_destroy(p); return st; }
 
-    // Convolution length L = N+M-1; use FFT length P >= next_pow2(L)
-    size_t L = N + M - 1;
-    size_t P = next_pow2(L);
-
-    // Prepare buffers
-    vv_dsp_cpx *a = (vv_dsp_cpx*)calloc(P, sizeof(vv_dsp_cpx)); // a[n] = x[n]*g[n]
-    vv_dsp_cpx *b = (vv_dsp_cpx*)calloc(P, sizeof(vv_dsp_cpx)); // b = h with zero-pad
-    vv_dsp_cpx *A_fft = (vv_dsp_cpx*)malloc(P * sizeof(vv_dsp_cpx));
-    vv_dsp_cpx *B_fft = (vv_dsp_cpx*)malloc(P * sizeof(vv_dsp_cpx));
-    vv_dsp_cpx *C_fft = (vv_dsp_cpx*)malloc(P * sizeof(vv_dsp_cpx));
-    if (!a || !b || !A_fft || !B_fft || !C_fft){
-        free(g); free(h); free(a); free(b); free(A_fft); free(B_fft); free(C_fft);
-        return VV_DSP_ERROR_INTERNAL;
+    // Chirps in double: n^2/2 grows quickly and single-precision phase would
+    // drift long before the FFT error does.
+    const double argW = atan2((double)W_im, (double)W_re);
+    const double magW = hypot((double)W_re, (double)W_im);
+    double Ainv_re = 1.0, Ainv_im = 0.0;
+    const double denom = (double)A_re*(double)A_re + (double)A_im*(double)A_im;
+    if (denom != 0.0) { Ainv_re = (double)A_re/denom; Ainv_im = -(double)A_im/denom; }
+
+    // g[n] = A^{-n} * W^{n^2/2}, A^{-n} by recurrence
+    double ap_re = 1.0, ap_im = 0.0;
+    for (size_t n = 0; n < N; ++n){
+        vv_dsp_cpx w = w_pow(magW, argW, 0.5 * (double)n * (double)n);
+        p->g[n].re = (vv_dsp_real)(ap_re * (double)w.re - ap_im * (double)w.im);
+        p->g[n].im = (vv_dsp_real)(ap_re * (double)w.im + ap_im * (double)w.re);
+        const double t = ap_re * Ainv_re - ap_im * Ainv_im;
+        ap_im = ap_re * Ainv_im + ap_im * Ainv_re;
+        ap_re = t;
     }
+    for (size_t k = 0; k < M; ++k) p->post[k] = w_pow(magW, argW, 0.5 * (double)k * (double)k);
 
-    for (size_t n=0;n<N;++n) a[n] = cpx_mul(x[n], g[n]);
-    // Build b[i] = v[i-(N-1)] for i=0..L-1, where v[m] = W^{-m^2/2}
-    for (size_t i=0; i<L; ++i){
-        long m = (long)i - (long)(N - 1);
-        vv_dsp_real dm = (vv_dsp_real)m;
-        vv_dsp_real e = (vv_dsp_real)0.5 * dm * dm;
-        vv_dsp_real ang = -e * argW;
-        vv_dsp_real mag = (vv_dsp_real)VV_DSP_POW((double)magW, -e);
-        b[i] = cpx_from(mag * (vv_dsp_real)VV_DSP_COS(ang), mag * (vv_dsp_real)VV_DSP_SIN(ang));
+    // Kernel b[i] = v[i-(N-1)] for i=0..L-1, where v[m] = W^{-m^2/2}; its
+    // spectrum is fixed for the plan's lifetime
+    for (size_t i = 0; i < L; ++i){
+        const double m = (double)i - (double)(N - 1);
+        p->buf[i] = w_pow(magW, argW, -0.5 * m * m);
     }
+    memset(&p->buf[L], 0, (P - L) * sizeof(vv_dsp_cpx));
+    st = vv_dsp_fft_execute(p->fwd, p->buf, p->Bf);
+    if (st != VV_DSP_OK) { vv_dsp_czt_plan_destroy(p); return st; }
+
+    *out = p;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_czt_plan_create(
+    size_t N,
+    size_t M,
+    vv_dsp_real W_re, vv_dsp_real W_im,
+    vv_dsp_real A_re, vv_dsp_real A_im,
+    vv_dsp_czt_plan** out)
+{
+    return vv_dsp_czt_plan_create_ex(N, M, W_re, W_im, A_re, A_im, NULL, out);
+}
+
+size_t vv_dsp_czt_plan_input_size(const vv_dsp_czt_plan* plan){
+    return plan ? plan->N : 0;
+}
+
+size_t vv_dsp_czt_plan_output_size(const vv_dsp_czt_plan* plan){
+    return plan ? plan->M : 0;
+}
 
-    // FFT(a), FFT(b)
-    vv_dsp_fft_plan *pf = NULL, *pg = NULL, *pi = NULL;
-    if (vv_dsp_fft_make_plan(P, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &pf) != VV_DSP_OK) goto cleanup_err;
-    if (vv_dsp_fft_make_plan(P, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &pg) != VV_DSP_OK) goto cleanup_err;
-    if (vv_dsp_fft_make_plan(P, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &pi) != VV_DSP_OK) goto cleanup_err;
+// Shared tail: buf[0..N) holds x*g, the rest is cleared here
+static vv_dsp_status czt_plan_finish(vv_dsp_czt_plan* p, vv_dsp_cpx* X){
+    const size_t N = p->N, M = p->M, P = p->P;
+    memset(&p->buf[N], 0, (P - N) * sizeof(vv_dsp_cpx));
+    vv_dsp_status st = vv_dsp_fft_execute(p->fwd, p->buf, p->spec);
+    if (st != VV_DSP_OK) return st;
+    vv_dsp_cpx* S = p->spec;
+    const vv_dsp_cpx* B = p->Bf;
+    for (size_t i = 0; i < P; ++i) S[i] = cpx_mul(S[i], B[i]);
+    st = vv_dsp_fft_execute(p->inv, p->spec, p->buf);
+    if (st != VV_DSP_OK) return st;
+    // Extract k=0..M-1 from indices (N-1) .. (N-1 + M-1), final multiply by W^{+k^2/2}
+    const vv_dsp_cpx* c = p->buf + (N - 1);
+    for (size_t k = 0; k < M; ++k) X[k] = cpx_mul(c[k], p->post[k]);
+    return VV_DSP_OK;
+}
 
-    if (vv_dsp_fft_execute(pf, a, A_fft) != VV_DSP_OK) goto cleanup_err;
-    if (vv_dsp_fft_execute(pg, b, B_fft) != VV_DSP_OK) goto cleanup_err;
+vv_dsp_status vv_dsp_czt_plan_execute_cpx(vv_dsp_czt_plan* plan, const vv_dsp_cpx* x, vv_dsp_cpx* X){
+    if (!plan || !x || !X) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t n = 0; n < plan->N; ++n) plan->buf[n] = cpx_mul(x[n], plan->g[n]);
+    return czt_plan_finish(plan, X);
+}
 
-    // element-wise multiply in freq domain
-    for (size_t i=0;i<P;++i){
-        C_fft[i] = cpx_mul(A_fft[i], B_fft[i]);
+vv_dsp_status vv_dsp_czt_plan_execute_real(vv_dsp_czt_plan* plan, const vv_dsp_real* x, vv_dsp_cpx* X){
+    if (!plan || !x || !X) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t n = 0; n < plan->N; ++n){
+        plan->buf[n].re = x[n] * plan->g[n].re;
+        plan->buf[n].im = x[n] * plan->g[n].im;
     }
+    return czt_plan_finish(plan, X);
+}
 
-    // IFFT to get convolution result c = a (*) b
-    if (vv_dsp_fft_execute(pi, C_fft, a) != VV_DSP_OK) goto cleanup_err; // reuse a as time-domain buffer
-
-    // Extract k=0..M-1 from indices n = (N-1) .. (N-1 + M-1)
-    for (size_t k=0;k<M;++k){
-        size_t idx = (N - 1) + k;
-        // Final multiply by W^{+k^2/2}
-        vv_dsp_real e = (vv_dsp_real)0.5 * (vv_dsp_real)(k*(double)k);
-        vv_dsp_real ang = e * argW;
-        vv_dsp_real mag = (vv_dsp_real)VV_DSP_POW((double)magW, e);
-        vv_dsp_cpx wk = cpx_from(mag * VV_DSP_COS(ang), mag * VV_DSP_SIN(ang));
-        vv_dsp_cpx yk = cpx_mul(a[idx], wk);
-        X[k] = yk;
+vv_dsp_status vv_dsp_czt_exec_real_ex(
+    const vv_dsp_real* x,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_re, vv_dsp_real W_im,
+    vv_dsp_real A_re, vv_dsp_real A_im,
+    vv_dsp_cpx* X,
+    vv_dsp_arena* arena)
+{
+    if (!x || !X) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_czt_plan* plan = NULL;
+    vv_dsp_status st = vv_dsp_czt_plan_create_ex(N, M, W_re, W_im, A_re, A_im, arena, &plan);
+    if (st == VV_DSP_OK) {
+        st = vv_dsp_czt_plan_execute_real(plan, x, X);
+        vv_dsp_czt_plan_destroy(plan);
     }
+    vv_dsp_arena_reset_to(arena, mark);
+    return st;
+}
 
-    vv_dsp_fft_destroy(pf); vv_dsp_fft_destroy(pg); vv_dsp_fft_destroy(pi);
-    free(g); free(h); free(a); free(b); free(A_fft); free(B_fft); free(C_fft);
-    return VV_DSP_OK;
+vv_dsp_status vv_dsp_czt_exec_real(
+    const vv_dsp_real* x,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_re, vv_dsp_real W_im,
+    vv_dsp_real A_re, vv_dsp_real A_im,
+    vv_dsp_cpx* X)
+{
+    return vv_dsp_czt_exec_real_ex(x, N, M, W_re, W_im, A_re, A_im, X, NULL);
+}
+
+vv_dsp_status vv_dsp_czt_exec_cpx_ex(
+    const vv_dsp_cpx* x,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_re, vv_dsp_real W_im,
+    vv_dsp_real A_re, vv_dsp_real A_im,
+    vv_dsp_cpx* X,
+    vv_dsp_arena* arena)
+{
+    if (!x || !X) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_czt_plan* plan = NULL;
+    vv_dsp_status st = vv_dsp_czt_plan_create_ex(N, M, W_re, W_im, A_re, A_im, arena, &plan);
+    if (st == VV_DSP_OK) {
+        st = vv_dsp_czt_plan_execute_cpx(plan, x, X);
+        vv_dsp_czt_plan_destroy(plan);
+    }
+    vv_dsp_arena_reset_to(arena, mark);
+    return st;
+}
 
-cleanup_err:
-    if (pf) vv_dsp_fft_destroy(pf);
-    if (pg) vv_dsp_fft_destroy(pg);
-    if (pi) vv_dsp_fft_destroy(pi);
-    free(g); free(h); free(a); free(b); free(A_fft); free(B_fft); free(C_fft);
-    return VV_DSP_ERROR_INTERNAL;
+vv_dsp_status vv_dsp_czt_exec_cpx(
+    const vv_dsp_cpx* x,
+    size_t N,
+    size_t M,
+    vv_dsp_real W_re, vv_dsp_real W_im,
+    vv_dsp_real A_re, vv_dsp_real A_im,
+    vv_dsp_cpx* X)
+{
+    return vv_dsp_czt_exec_cpx_ex(x, N, M, W_re, W_im, A_re, A_im, X, NULL);
 }
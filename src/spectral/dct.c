@@ -4,67 +4,324 @@
 #include "vv_dsp/vv_dsp_math.h"
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/spectral/dct.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/spectral/fft_small.h"
 #include "vv_dsp/core/nan_policy.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
 
+// Plans up to this size keep an n x n basis matrix for vv_dsp_dct_execute_batch()
+#define VV_DSP_DCT_MATRIX_MAX_N 64
+// Single-frame execution below this size multiplies by the basis; FFT setup does not pay off
+#define VV_DSP_DCT_FFT_MIN_N 8
+#if !defined(VV_DSP_USE_DOUBLE)
+#  if defined(VV_DSP_SIMD_AVX2)
+#    define DCT_SIMD_AVX2 1
+#  elif defined(VV_DSP_SIMD_SSE41)
+#    define DCT_SIMD_SSE41 1
+#  elif defined(VV_DSP_SIMD_NEON)
+#    define DCT_SIMD_NEON 1
+#  endif
+#endif
+
+// Frames per block in the batched matrix product: two vectors per basis row
+#if defined(DCT_SIMD_AVX2)
+#define VV_DSP_DCT_BLOCK 16
+#else
+#define VV_DSP_DCT_BLOCK 8
+#endif
+
+// FFT-based plans:
+//  - DCT-II / DCT-III forward: N-point R2C on the even/odd reordered input
+//    with a post-twiddle (Makhoul)
+//  - Inverses (DCT-III with 2/N scaling): pre-twiddle into a Hermitian
+//    spectrum, N-point C2R, undo the reordering
+//  - DCT-IV: N/2-point C2C with pre/post twiddles for even N, a zero-padded
+//    2N-point C2C for odd N
+// Plans up to VV_DSP_DCT_MATRIX_MAX_N also keep the transform as a basis matrix;
+// batches then run as one blocked matrix product over the frames.
+// Buffers are owned by the plan, so one plan must not be executed from
+// several threads at once (same rule as FFT plans).
 struct vv_dsp_dct_plan {
     size_t n;
     vv_dsp_dct_type type;
     vv_dsp_dct_dir dir;
+    vv_dsp_fft_plan* fft;  // NULL below VV_DSP_DCT_FFT_MIN_N
+    vv_dsp_real* basis;    // n x n row-major, NULL above VV_DSP_DCT_MATRIX_MAX_N
+    vv_dsp_real* xt;       // n x VV_DSP_DCT_BLOCK transposed frame block (matrix plans)
+    vv_dsp_cpx* tw;        // twiddles, layout depends on the transform
+    vv_dsp_real* rbuf;     // n reals: NaN-policy copy of the input
+    vv_dsp_real* vbuf;     // n reals: reordered sequence (II/III)
+    vv_dsp_cpx* cbuf;      // complex FFT input/output
 };
 
 static VV_DSP_INLINE vv_dsp_real vv_pi(void) { return VV_DSP_PI; }
 
-// Naive O(N^2) DCT implementations (reference-correct, SIMD-friendly loops)
-// Canonical unnormalized pair:
+// Basis matrix for small plans: out[k] = sum_j basis[k*n + j] * in[j], with the
+// scaling of each definition in dct.h folded in:
 // DCT-II (forward): X[k] = sum_{n=0}^{N-1} x[n] * cos(pi/N * (n+0.5) * k)
 // Inverse (DCT-III): x[n] = (2/N) * [ 0.5*X[0] + sum_{k=1}^{N-1} X[k] * cos(pi/N * k * (n+0.5)) ]
-static void dct2_forward(const vv_dsp_real* x, vv_dsp_real* X, size_t N) {
+// DCT-III forward:   Y[k] = x[0] + 2 * sum_{n=1}^{N-1} x[n] * cos(pi/N * k * (n+0.5))
+// DCT-IV:            X[k] = sum_{n=0}^{N-1} x[n] * cos(pi/N * (n+0.5) * (k+0.5)), times 2/N when inverse
+static void fill_basis(vv_dsp_real* basis, size_t N, vv_dsp_dct_type type, vv_dsp_dct_dir dir) {
+    const double step = VV_DSP_PI_D / (double)N;
     for (size_t k = 0; k < N; ++k) {
-        vv_dsp_real sum = 0;
-        for (size_t n = 0; n < N; ++n) {
-            vv_dsp_real ang = vv_pi() * ((vv_dsp_real)n + (vv_dsp_real)0.5) * (vv_dsp_real)k / (vv_dsp_real)N;
-            sum += x[n] * VV_DSP_COS(ang);
+        for (size_t j = 0; j < N; ++j) {
+            double w;
+            if (type == VV_DSP_DCT_IV) {
+                w = cos(step * ((double)j + 0.5) * ((double)k + 0.5));
+                if (dir == VV_DSP_DCT_BACKWARD) w *= 2.0 / (double)N;
+            } else if (dir == VV_DSP_DCT_BACKWARD) {
+                // Row k reconstructs sample k from coefficient j
+                w = (2.0 / (double)N) * (j == 0 ? 0.5 : cos(step * (double)j * ((double)k + 0.5)));
+            } else if (type == VV_DSP_DCT_II) {
+                w = cos(step * ((double)j + 0.5) * (double)k);
+            } else {
+                w = j == 0 ? 1.0 : 2.0 * cos(step * (double)k * ((double)j + 0.5));
+            }
+            basis[k * N + j] = (vv_dsp_real)w;
         }
+    }
+}
+
+// Returns nonzero if any output is NaN / Inf (folded into the store for the NaN policy)
+static unsigned dct_matvec(const vv_dsp_real* basis, const vv_dsp_real* x, vv_dsp_real* X, size_t N) {
+    unsigned bad = 0;
+    for (size_t k = 0; k < N; ++k) {
+        const vv_dsp_real* row = basis + k * N;
+        vv_dsp_real sum = 0;
+        for (size_t j = 0; j < N; ++j) sum += row[j] * x[j];
         X[k] = sum;
+        bad |= vv_dsp_nonfinite_flag(sum);
     }
+    return bad;
 }
 
-static void dct3_inverse_from_ii(const vv_dsp_real* X, vv_dsp_real* x, size_t N) {
-    const vv_dsp_real scale = (vv_dsp_real)2.0 / (vv_dsp_real)N;
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real sum = (vv_dsp_real)0.5 * X[0];
-        for (size_t k = 1; k < N; ++k) {
-            vv_dsp_real ang = vv_pi() * (vv_dsp_real)k * ((vv_dsp_real)n + (vv_dsp_real)0.5) / (vv_dsp_real)N;
-            sum += X[k] * VV_DSP_COS(ang);
+// Blocked product for up to VV_DSP_DCT_BLOCK frames. xt holds the block
+// transposed (xt[j*BLOCK + f] = frame f, sample j; unused lanes zero), so every
+// basis coefficient multiplies a full vector of frames.
+static void dct_block(const vv_dsp_real* basis, const vv_dsp_real* xt, size_t N,
+                      vv_dsp_real* out, size_t stride, size_t count) {
+    vv_dsp_real acc[4][VV_DSP_DCT_BLOCK];
+    size_t k = 0;
+    for (; k + 4 <= N; k += 4) {
+        const vv_dsp_real* r0 = basis + k * N;
+        const vv_dsp_real* r1 = r0 + N;
+        const vv_dsp_real* r2 = r1 + N;
+        const vv_dsp_real* r3 = r2 + N;
+#if defined(DCT_SIMD_AVX2)
+        __m256 a0l = _mm256_setzero_ps(), a0h = _mm256_setzero_ps(), a1l = _mm256_setzero_ps(), a1h = _mm256_setzero_ps();
+        __m256 a2l = _mm256_setzero_ps(), a2h = _mm256_setzero_ps(), a3l = _mm256_setzero_ps(), a3h = _mm256_setzero_ps();
+        for (size_t j = 0; j < N; ++j) {
+            const __m256 vl = _mm256_loadu_ps(xt + j * VV_DSP_DCT_BLOCK);
+            const __m256 vh = _mm256_loadu_ps(xt + j * VV_DSP_DCT_BLOCK + 8);
+            __m256 c = _mm256_set1_ps(r0[j]);
+            a0l = _mm256_add_ps(a0l, _mm256_mul_ps(c, vl)); a0h = _mm256_add_ps(a0h, _mm256_mul_ps(c, vh));
+            c = _mm256_set1_ps(r1[j]);
+            a1l = _mm256_add_ps(a1l, _mm256_mul_ps(c, vl)); a1h = _mm256_add_ps(a1h, _mm256_mul_ps(c, vh));
+            c = _mm256_set1_ps(r2[j]);
+            a2l = _mm256_add_ps(a2l, _mm256_mul_ps(c, vl)); a2h = _mm256_add_ps(a2h, _mm256_mul_ps(c, vh));
+            c = _mm256_set1_ps(r3[j]);
+            a3l = _mm256_add_ps(a3l, _mm256_mul_ps(c, vl)); a3h = _mm256_add_ps(a3h, _mm256_mul_ps(c, vh));
+        }
+        _mm256_storeu_ps(acc[0], a0l); _mm256_storeu_ps(acc[0] + 8, a0h);
+        _mm256_storeu_ps(acc[1], a1l); _mm256_storeu_ps(acc[1] + 8, a1h);
+        _mm256_storeu_ps(acc[2], a2l); _mm256_storeu_ps(acc[2] + 8, a2h);
+        _mm256_storeu_ps(acc[3], a3l); _mm256_storeu_ps(acc[3] + 8, a3h);
+#elif defined(DCT_SIMD_SSE41)
+        __m128 a0l = _mm_setzero_ps(), a0h = _mm_setzero_ps(), a1l = _mm_setzero_ps(), a1h = _mm_setzero_ps();
+        __m128 a2l = _mm_setzero_ps(), a2h = _mm_setzero_ps(), a3l = _mm_setzero_ps(), a3h = _mm_setzero_ps();
+        for (size_t j = 0; j < N; ++j) {
+            const __m128 vl = _mm_loadu_ps(xt + j * VV_DSP_DCT_BLOCK);
+            const __m128 vh = _mm_loadu_ps(xt + j * VV_DSP_DCT_BLOCK + 4);
+            __m128 c = _mm_set1_ps(r0[j]);
+            a0l = _mm_add_ps(a0l, _mm_mul_ps(c, vl)); a0h = _mm_add_ps(a0h, _mm_mul_ps(c, vh));
+            c = _mm_set1_ps(r1[j]);
+            a1l = _mm_add_ps(a1l, _mm_mul_ps(c, vl)); a1h = _mm_add_ps(a1h, _mm_mul_ps(c, vh));
+            c = _mm_set1_ps(r2[j]);
+            a2l = _mm_add_ps(a2l, _mm_mul_ps(c, vl)); a2h = _mm_add_ps(a2h, _mm_mul_ps(c, vh));
+            c = _mm_set1_ps(r3[j]);
+            a3l = _mm_add_ps(a3l, _mm_mul_ps(c, vl)); a3h = _mm_add_ps(a3h, _mm_mul_ps(c, vh));
+        }
+        _mm_storeu_ps(acc[0], a0l); _mm_storeu_ps(acc[0] + 4, a0h);
+        _mm_storeu_ps(acc[1], a1l); _mm_storeu_ps(acc[1] + 4, a1h);
+        _mm_storeu_ps(acc[2], a2l); _mm_storeu_ps(acc[2] + 4, a2h);
+        _mm_storeu_ps(acc[3], a3l); _mm_storeu_ps(acc[3] + 4, a3h);
+#elif defined(DCT_SIMD_NEON)
+        float32x4_t a0l = vdupq_n_f32(0), a0h = vdupq_n_f32(0), a1l = vdupq_n_f32(0), a1h = vdupq_n_f32(0);
+        float32x4_t a2l = vdupq_n_f32(0), a2h = vdupq_n_f32(0), a3l = vdupq_n_f32(0), a3h = vdupq_n_f32(0);
+        for (size_t j = 0; j < N; ++j) {
+            const float32x4_t vl = vld1q_f32(xt + j * VV_DSP_DCT_BLOCK);
+            const float32x4_t vh = vld1q_f32(xt + j * VV_DSP_DCT_BLOCK + 4);
+            a0l = vmlaq_n_f32(a0l, vl, r0[j]); a0h = vmlaq_n_f32(a0h, vh, r0[j]);
+            a1l = vmlaq_n_f32(a1l, vl, r1[j]); a1h = vmlaq_n_f32(a1h, vh, r1[j]);
+            a2l = vmlaq_n_f32(a2l, vl, r2[j]); a2h = vmlaq_n_f32(a2h, vh, r2[j]);
+            a3l = vmlaq_n_f32(a3l, vl, r3[j]); a3h = vmlaq_n_f32(a3h, vh, r3[j]);
+        }
+        vst1q_f32(acc[0], a0l); vst1q_f32(acc[0] + 4, a0h);
+        vst1q_f32(acc[1], a1l); vst1q_f32(acc[1] + 4, a1h);
+        vst1q_f32(acc[2], a2l); vst1q_f32(acc[2] + 4, a2h);
+        vst1q_f32(acc[3], a3l); vst1q_f32(acc[3] + 4, a3h);
+#else
+        memset(acc, 0, sizeof(acc));
+        for (size_t j = 0; j < N; ++j) {
+            const vv_dsp_real* v = xt + j * VV_DSP_DCT_BLOCK;
+            for (size_t f = 0; f < VV_DSP_DCT_BLOCK; ++f) {
+                acc[0][f] += r0[j] * v[f];
+                acc[1][f] += r1[j] * v[f];
+                acc[2][f] += r2[j] * v[f];
+                acc[3][f] += r3[j] * v[f];
+            }
+        }
+#endif
+        for (size_t f = 0; f < count; ++f) {
+            vv_dsp_real* o = out + f * stride + k;
+            o[0] = acc[0][f]; o[1] = acc[1][f]; o[2] = acc[2][f]; o[3] = acc[3][f];
         }
-        x[n] = scale * sum;
+    }
+    for (; k < N; ++k) {
+        const vv_dsp_real* row = basis + k * N;
+        for (size_t f = 0; f < VV_DSP_DCT_BLOCK; ++f) acc[0][f] = 0;
+        for (size_t j = 0; j < N; ++j) {
+            const vv_dsp_real* v = xt + j * VV_DSP_DCT_BLOCK;
+            for (size_t f = 0; f < VV_DSP_DCT_BLOCK; ++f) acc[0][f] += row[j] * v[f];
+        }
+        for (size_t f = 0; f < count; ++f) out[f * stride + k] = acc[0][f];
     }
 }
 
-// DCT-III forward (unnormalized):
-// Y[k] = x[0] + 2 * sum_{n=1}^{N-1} x[n] * cos(pi/N * k * (n+0.5))
-static void dct3_forward(const vv_dsp_real* x, vv_dsp_real* Y, size_t N) {
-    for (size_t k = 0; k < N; ++k) {
-        vv_dsp_real sum = x[0];
-        for (size_t n = 1; n < N; ++n) {
-            vv_dsp_real ang = vv_pi() * (vv_dsp_real)k * ((vv_dsp_real)n + (vv_dsp_real)0.5) / (vv_dsp_real)N;
-            sum += (vv_dsp_real)2.0 * x[n] * VV_DSP_COS(ang);
+static void fill_twiddles(vv_dsp_cpx* tw, size_t count, double step, double offset) {
+    for (size_t k = 0; k < count; ++k) {
+        const double ang = -VV_DSP_PI_D * ((double)k + offset) * step;
+        tw[k] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
+    }
+}
+
+// X[k] = Re(exp(-i*pi*k/(2N)) * V[k]), V = FFT of x[0], x[2], ..., x[3], x[1]
+static vv_dsp_status dct2_fft(const vv_dsp_dct_plan* p, const vv_dsp_real* x, vv_dsp_real* X) {
+    const size_t N = p->n;
+    // Small powers of two: the same algorithm as a straight-line kernel, without the plan
+    if (N <= VV_DSP_FFT_SMALL_MAX && (N & (N - 1)) == 0) return vv_dsp_dct2_small(N, x, X);
+    vv_dsp_real* v = p->vbuf;
+    for (size_t i = 0; 2 * i < N; ++i) v[i] = x[2 * i];
+    for (size_t i = 0; 2 * i + 1 < N; ++i) v[N - 1 - i] = x[2 * i + 1];
+    vv_dsp_status s = vv_dsp_fft_execute(p->fft, v, p->cbuf);
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_cpx* V = p->cbuf;
+    for (size_t k = 0; k <= N / 2; ++k) {
+        X[k] = p->tw[k].re * V[k].re - p->tw[k].im * V[k].im;
+    }
+    // Upper half from Hermitian symmetry: V[k] = conj(V[N-k])
+    for (size_t k = N / 2 + 1; k < N; ++k) {
+        const vv_dsp_cpx c = V[N - k];
+        X[k] = p->tw[k].re * c.re + p->tw[k].im * c.im;
+    }
+    return VV_DSP_OK;
+}
+
+// Inverse of dct2_fft (DCT-III with 2/N scaling):
+// V[k] = exp(i*pi*k/(2N)) * (X[k] - i*X[N-k]) is Hermitian, so a C2R recovers v
+static vv_dsp_status dct3_inverse_fft(const vv_dsp_dct_plan* p, const vv_dsp_real* X, vv_dsp_real* x) {
+    const size_t N = p->n;
+    vv_dsp_cpx* V = p->cbuf;
+    V[0] = vv_dsp_cpx_make(X[0], 0);
+    for (size_t k = 1; k <= N / 2; ++k) {
+        const vv_dsp_real c = p->tw[k].re, s = -p->tw[k].im;
+        const vv_dsp_real a = X[k], b = X[N - k];
+        V[k] = vv_dsp_cpx_make(c * a + s * b, s * a - c * b);
+    }
+    vv_dsp_real* v = p->vbuf;
+    vv_dsp_status st = vv_dsp_fft_execute(p->fft, V, v);
+    if (st != VV_DSP_OK) return st;
+    for (size_t i = 0; 2 * i < N; ++i) x[2 * i] = v[i];
+    for (size_t i = 0; 2 * i + 1 < N; ++i) x[2 * i + 1] = v[N - 1 - i];
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status dct4_fft(const vv_dsp_dct_plan* p, const vv_dsp_real* x, vv_dsp_real* X, int inverse) {
+    const size_t N = p->n;
+    vv_dsp_status s;
+    if (N % 2 == 0) {
+        // z[j] = (x[2j] + i*x[N-1-2j]) * exp(-i*pi*(j+1/4)/N); Z = FFT_{N/2}(z);
+        // d[j] = Z[j] * exp(-i*pi*j/N) gives X[2j] = Re d[j], X[N-1-2j] = -Im d[j]
+        const size_t m = N / 2;
+        const vv_dsp_cpx* pre = p->tw;
+        const vv_dsp_cpx* post = p->tw + m;
+        vv_dsp_cpx* z = p->cbuf;
+        vv_dsp_cpx* Z = p->cbuf + m;
+        for (size_t j = 0; j < m; ++j) {
+            const vv_dsp_real a = x[2 * j], b = x[N - 1 - 2 * j];
+            z[j] = vv_dsp_cpx_make(a * pre[j].re - b * pre[j].im, a * pre[j].im + b * pre[j].re);
+        }
+        s = vv_dsp_fft_execute(p->fft, z, Z);
+        if (s != VV_DSP_OK) return s;
+        for (size_t j = 0; j < m; ++j) {
+            X[2 * j] = Z[j].re * post[j].re - Z[j].im * post[j].im;
+            X[N - 1 - 2 * j] = -(Z[j].re * post[j].im + Z[j].im * post[j].re);
         }
-        Y[k] = sum;
+    } else {
+        // X[k] = Re(exp(-i*pi*(2k+1)/(4N)) * U[k]), U = FFT_{2N}(x[n] * exp(-i*pi*n/(2N)), zero-padded)
+        const vv_dsp_cpx* pre = p->tw;
+        const vv_dsp_cpx* post = p->tw + N;
+        vv_dsp_cpx* u = p->cbuf;
+        vv_dsp_cpx* U = p->cbuf + 2 * N;
+        for (size_t n = 0; n < N; ++n) u[n] = vv_dsp_cpx_make(x[n] * pre[n].re, x[n] * pre[n].im);
+        for (size_t n = N; n < 2 * N; ++n) u[n] = vv_dsp_cpx_make(0, 0);
+        s = vv_dsp_fft_execute(p->fft, u, U);
+        if (s != VV_DSP_OK) return s;
+        for (size_t k = 0; k < N; ++k) X[k] = post[k].re * U[k].re - post[k].im * U[k].im;
+    }
+    if (inverse) {
+        const vv_dsp_real scale = (vv_dsp_real)2.0 / (vv_dsp_real)N;
+        for (size_t k = 0; k < N; ++k) X[k] *= scale;
     }
+    return VV_DSP_OK;
 }
 
-static void dct4_transform(const vv_dsp_real* x, vv_dsp_real* X, size_t N, int inverse) {
-    // DCT-IV is its own inverse up to a scale of 2/N
-    for (size_t k = 0; k < N; ++k) {
-        vv_dsp_real sum = 0;
-        for (size_t n = 0; n < N; ++n) {
-            vv_dsp_real ang = vv_pi() * ((vv_dsp_real)n + (vv_dsp_real)0.5) * ((vv_dsp_real)k + (vv_dsp_real)0.5) / (vv_dsp_real)N;
-            sum += x[n] * VV_DSP_COS(ang);
+static void dct_plan_free(vv_dsp_dct_plan* p) {
+    if (p->fft) vv_dsp_fft_plan_release(p->fft);
+    vv_dsp_free(p->tw);
+    vv_dsp_free(p->rbuf);
+    vv_dsp_free(p->vbuf);
+    vv_dsp_free(p->cbuf);
+    vv_dsp_aligned_free(p->basis);
+    vv_dsp_aligned_free(p->xt);
+    vv_dsp_free(p);
+}
+
+// Set up the FFT path; fills p->fft/tw/vbuf/cbuf
+static vv_dsp_status dct_plan_init_fft(vv_dsp_dct_plan* p) {
+    const size_t N = p->n;
+    vv_dsp_status s;
+    if (p->type == VV_DSP_DCT_IV) {
+        const int even = (N % 2) == 0;
+        const size_t fft_n = even ? N / 2 : 2 * N;
+        s = vv_dsp_fft_plan_acquire(fft_n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &p->fft);
+        if (s != VV_DSP_OK) return s;
+        p->tw = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * (even ? N : 2 * N));
+        p->cbuf = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * 2 * fft_n);
+        if (!p->tw || !p->cbuf) return VV_DSP_ERROR_INTERNAL;
+        if (even) {
+            fill_twiddles(p->tw, N / 2, 1.0 / (double)N, 0.25);
+            fill_twiddles(p->tw + N / 2, N / 2, 1.0 / (double)N, 0.0);
+        } else {
+            fill_twiddles(p->tw, N, 1.0 / (2.0 * (double)N), 0.0);
+            fill_twiddles(p->tw + N, N, 2.0 / (4.0 * (double)N), 0.5);
         }
-        if (inverse) sum *= (vv_dsp_real)2.0 / (vv_dsp_real)N;
-        X[k] = sum;
+        return VV_DSP_OK;
     }
+
+    // DCT-II/III: forward plans run R2C, inverse plans run C2R
+    const int inverse = (p->dir == VV_DSP_DCT_BACKWARD);
+    s = vv_dsp_fft_plan_acquire(N, inverse ? VV_DSP_FFT_C2R : VV_DSP_FFT_R2C,
+                                inverse ? VV_DSP_FFT_BACKWARD : VV_DSP_FFT_FORWARD, &p->fft);
+    if (s != VV_DSP_OK) return s;
+    p->tw = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * N);
+    p->vbuf = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * N);
+    p->cbuf = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * (N / 2 + 1));
+    if (!p->tw || !p->vbuf || !p->cbuf) return VV_DSP_ERROR_INTERNAL;
+    fill_twiddles(p->tw, N, 1.0 / (2.0 * (double)N), 0.0);
+    return VV_DSP_OK;
 }
 
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_make_plan(size_t n,
@@ -76,9 +333,21 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_make_plan(size_t n,
     if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
     if (!(type == VV_DSP_DCT_II || type == VV_DSP_DCT_III || type == VV_DSP_DCT_IV)) return VV_DSP_ERROR_OUT_OF_RANGE;
     if (!(dir == VV_DSP_DCT_FORWARD || dir == VV_DSP_DCT_BACKWARD)) return VV_DSP_ERROR_OUT_OF_RANGE;
-    vv_dsp_dct_plan* p = (vv_dsp_dct_plan*)malloc(sizeof(vv_dsp_dct_plan));
+    vv_dsp_dct_plan* p = (vv_dsp_dct_plan*)vv_dsp_calloc(1, sizeof(vv_dsp_dct_plan));
     if (!p) return VV_DSP_ERROR_INTERNAL;
     p->n = n; p->type = type; p->dir = dir;
+    p->rbuf = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * n);
+    if (!p->rbuf) { dct_plan_free(p); return VV_DSP_ERROR_INTERNAL; }
+    if (n <= VV_DSP_DCT_MATRIX_MAX_N) {
+        p->basis = (vv_dsp_real*)vv_dsp_aligned_malloc_default(sizeof(vv_dsp_real) * n * n);
+        p->xt = (vv_dsp_real*)vv_dsp_aligned_malloc_default(sizeof(vv_dsp_real) * n * VV_DSP_DCT_BLOCK);
+        if (!p->basis || !p->xt) { dct_plan_free(p); return VV_DSP_ERROR_INTERNAL; }
+        fill_basis(p->basis, n, type, dir);
+    }
+    if (n >= VV_DSP_DCT_FFT_MIN_N) {
+        vv_dsp_status s = dct_plan_init_fft(p);
+        if (s != VV_DSP_OK) { dct_plan_free(p); return s; }
+    }
     *out_plan = p;
     return VV_DSP_OK;
 }
@@ -90,54 +359,97 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_execute(const vv_dsp_dct_plan* plan,
 
     const size_t N = plan->n;
 
-    // Allocate temporary buffer for NaN/Inf processed input
-    vv_dsp_real* temp_input = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
-    if (!temp_input) return VV_DSP_ERROR_INTERNAL;
-
-    // Check and handle NaN/Inf in input according to policy
-    vv_dsp_status status = vv_dsp_apply_nan_policy_copy(in, N, temp_input);
+    // NaN/Inf policy, fetched once: checked while the input is copied into plan
+    // storage, and on the output
+    const vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
+    vv_dsp_real* temp_input = plan->rbuf;
+    unsigned bad = 0;
+    for (size_t j = 0; j < N; ++j) {
+        temp_input[j] = in[j];
+        bad |= vv_dsp_nonfinite_flag(in[j]);
+    }
+    vv_dsp_status status = bad ? vv_dsp_nan_policy_fixup(policy, temp_input, N) : VV_DSP_OK;
     if (status != VV_DSP_OK) {
-        free(temp_input);
         return status;  // Return early on error (e.g., if policy is ERROR and NaN/Inf found)
     }
 
-    // Apply the appropriate DCT transform
-    if (plan->type == VV_DSP_DCT_II) {
-        if (plan->dir == VV_DSP_DCT_FORWARD) {
-            dct2_forward(temp_input, out, N);
-        } else {
-            // inverse of DCT-II is DCT-III with 2/N scaling and half-weight for k=0 term
-            dct3_inverse_from_ii(temp_input, out, N);
-        }
-    } else if (plan->type == VV_DSP_DCT_III) {
-        if (plan->dir == VV_DSP_DCT_FORWARD) {
-            // Compute DCT-III directly
-            dct3_forward(temp_input, out, N);
+    if (plan->fft) {
+        if (plan->type == VV_DSP_DCT_IV) {
+            status = dct4_fft(plan, temp_input, out, plan->dir == VV_DSP_DCT_BACKWARD);
+        } else if (plan->dir == VV_DSP_DCT_BACKWARD) {
+            // Both inverses share the DCT-III reconstruction
+            status = dct3_inverse_fft(plan, temp_input, out);
         } else {
-            // inverse of DCT-III recovers time via same formula as dct3_inverse_from_ii
-            dct3_inverse_from_ii(temp_input, out, N);
+            status = dct2_fft(plan, temp_input, out);
+            if (status == VV_DSP_OK && plan->type == VV_DSP_DCT_III) {
+                // Y[k] = x[0] + 2*sum_{n>=1} x[n] cos(pi*k*(n+0.5)/N)
+                //      = 2*DCT-II[k] - 2*x[0]*cos(pi*k/(2N)) + x[0]
+                const vv_dsp_real x0 = temp_input[0];
+                for (size_t k = 0; k < N; ++k) {
+                    out[k] = (vv_dsp_real)2.0 * (out[k] - x0 * plan->tw[k].re) + x0;
+                }
+            }
         }
-    } else if (plan->type == VV_DSP_DCT_IV) {
-        dct4_transform(temp_input, out, N, plan->dir == VV_DSP_DCT_BACKWARD);
-    } else {
-        free(temp_input);
-        return VV_DSP_ERROR_OUT_OF_RANGE;
+        if (status != VV_DSP_OK) return status;
+        // The FFT paths end in their own store loops: scan the output instead
+        return vv_dsp_nan_policy_fixup(policy, out, N);
     }
+    bad = dct_matvec(plan->basis, temp_input, out, N);
+    return bad ? vv_dsp_nan_policy_fixup(policy, out, N) : VV_DSP_OK;
+}
 
-    free(temp_input);
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_dct_execute_batch(const vv_dsp_dct_plan* plan,
+                                                        const vv_dsp_real* in,
+                                                        vv_dsp_real* out,
+                                                        size_t num_frames,
+                                                        size_t stride) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t N = plan->n;
+    if (stride < N) return VV_DSP_ERROR_INVALID_SIZE;
 
-    // Apply NaN/Inf policy to output
-    status = vv_dsp_apply_nan_policy_inplace(out, N);
-    if (status != VV_DSP_OK) {
-        return status;
+    if (!plan->basis) {
+        for (size_t f = 0; f < num_frames; ++f) {
+            vv_dsp_status s = vv_dsp_dct_execute(plan, in + f * stride, out + f * stride);
+            if (s != VV_DSP_OK) return s;
+        }
+        return VV_DSP_OK;
     }
 
+    const vv_dsp_nan_policy_e policy = vv_dsp_get_nan_policy();
+    vv_dsp_real* xt = plan->xt;
+    for (size_t f0 = 0; f0 < num_frames; f0 += VV_DSP_DCT_BLOCK) {
+        const size_t count = (num_frames - f0 < VV_DSP_DCT_BLOCK) ? num_frames - f0 : VV_DSP_DCT_BLOCK;
+        // The whole block is read before any output is written, so in == out is fine
+        for (size_t f = 0; f < count; ++f) {
+            const vv_dsp_real* x = in + (f0 + f) * stride;
+            unsigned bad = 0;
+            for (size_t j = 0; j < N; ++j) {
+                xt[j * VV_DSP_DCT_BLOCK + f] = x[j];
+                bad |= vv_dsp_nonfinite_flag(x[j]);
+            }
+            if (bad) {
+                // Rare: policy on a copy of the frame, then transpose it again
+                memcpy(plan->rbuf, x, N * sizeof(vv_dsp_real));
+                vv_dsp_status s = vv_dsp_nan_policy_fixup(policy, plan->rbuf, N);
+                if (s != VV_DSP_OK) return s;
+                for (size_t j = 0; j < N; ++j) xt[j * VV_DSP_DCT_BLOCK + f] = plan->rbuf[j];
+            }
+        }
+        for (size_t f = count; f < VV_DSP_DCT_BLOCK; ++f) {
+            for (size_t j = 0; j < N; ++j) xt[j * VV_DSP_DCT_BLOCK + f] = 0;
+        }
+        dct_block(plan->basis, xt, N, out + f0 * stride, stride, count);
+        for (size_t f = 0; f < count && policy != VV_DSP_NAN_POLICY_PROPAGATE; ++f) {
+            vv_dsp_status s = vv_dsp_nan_policy_fixup(policy, out + (f0 + f) * stride, N);
+            if (s != VV_DSP_OK) return s;
+        }
+    }
     return VV_DSP_OK;
 }
 
 vv_dsp_status vv_dsp_dct_destroy(vv_dsp_dct_plan* plan) {
     if (!plan) return VV_DSP_ERROR_NULL_POINTER;
-    free(plan);
+    dct_plan_free(plan);
     return VV_DSP_OK;
 }
 
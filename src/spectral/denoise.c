@@ -0,0 +1,295 @@
+#include "vv_dsp/spectral/denoise.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/core/alloc.h"
+#include <math.h>
+#include <string.h>
+
+#define DENOISE_SUBWINDOWS 8                 // minimum-search sub-windows
+#define DENOISE_SMOOTH ((vv_dsp_real)0.85)   // recursive power smoothing
+#define DENOISE_BIAS ((vv_dsp_real)2.2)      // minimum-to-mean bias of S over ~100 frames
+#define DENOISE_TINY ((vv_dsp_real)1e-30)    // keeps silent bins at unity gain
+
+struct vv_dsp_denoise {
+    vv_dsp_stft** stft;     // one HALF handle per channel on a shared config
+    size_t channels;
+    size_t nfft;
+    size_t nh;              // nfft/2+1 bins
+    size_t hop;
+    size_t max_block;
+    size_t sub_len;         // frames per sub-window
+    size_t sub_frames;      // frames in the current sub-window
+    size_t sub_next;        // sub-window slot replaced next
+    int primed;             // a frame has been analyzed since create / reset
+    vv_dsp_real gmin2;      // squared gain floor
+    vv_dsp_real over;
+    vv_dsp_real pole;       // mask smoothing
+    // Per-bin state and scratch, nh each (sub_min: DENOISE_SUBWINDOWS rows)
+    vv_dsp_real* power;     // channel-averaged |X|^2 of the frame
+    vv_dsp_real* smooth;
+    vv_dsp_real* cur_min;   // minimum of the current sub-window
+    vv_dsp_real* sub_min;
+    vv_dsp_real* noise;
+    vv_dsp_real* gain;
+    vv_dsp_real* mask;
+    // Per-channel scratch: split spectra (nh each) and output FIFOs (fifo_cap each)
+    vv_dsp_real* re;
+    vv_dsp_real* im;
+    vv_dsp_cpx* spec;
+    vv_dsp_real* fifo;
+    size_t fifo_cap;
+    size_t fifo_count;      // samples queued per channel
+    void* block;            // everything above but the STFTs
+};
+
+#define DENOISE_BIN_ARRAYS (6 + DENOISE_SUBWINDOWS)
+
+vv_dsp_status vv_dsp_denoise_destroy(vv_dsp_denoise* dn) {
+    if (!dn) return VV_DSP_ERROR_NULL_POINTER;
+    if (dn->stft) {
+        for (size_t c = 0; c < dn->channels; ++c) (void)vv_dsp_stft_destroy(dn->stft[c]);
+        vv_dsp_free(dn->stft);
+    }
+    vv_dsp_free(dn->block);
+    vv_dsp_free(dn);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_denoise_create(const vv_dsp_denoise_params* params, vv_dsp_denoise** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const size_t nfft = params->fft_size, hop = params->hop_size;
+    const size_t window = params->noise_window ? params->noise_window : 96;
+    if (nfft < 4 || (nfft & 1) || hop == 0 || hop > nfft / 2 || params->channels == 0 ||
+        window < DENOISE_SUBWINDOWS) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    // Written so that NaN fails too
+    if (!(params->reduction_db >= 0) || !(params->oversubtraction >= 0) ||
+        !(params->mask_smoothing >= 0 && params->mask_smoothing < 1)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    vv_dsp_denoise* dn = (vv_dsp_denoise*)vv_dsp_calloc(1, sizeof(*dn));
+    if (!dn) return VV_DSP_ERROR_INTERNAL;
+    dn->channels = params->channels;
+    dn->nfft = nfft;
+    dn->nh = nfft / 2 + 1;
+    dn->hop = hop;
+    dn->max_block = params->max_block ? params->max_block : hop;
+    dn->sub_len = window / DENOISE_SUBWINDOWS;
+    const double reduction = params->reduction_db > 0 ? (double)params->reduction_db : 18.0;
+    dn->gmin2 = (vv_dsp_real)pow(10.0, -reduction / 10.0);
+    dn->over = params->oversubtraction > 0 ? params->oversubtraction : (vv_dsp_real)2;
+    dn->pole = params->mask_smoothing > 0 ? params->mask_smoothing : (vv_dsp_real)0.5;
+
+    // One config, one stream handle per channel
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = nfft;
+    sp.hop_size = hop;
+    sp.window = params->window;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    sp.periodic = 1;
+    vv_dsp_stft_config* cfg = NULL;
+    vv_dsp_status s = vv_dsp_stft_config_create(&sp, &cfg);
+    if (s == VV_DSP_OK) {
+        dn->stft = (vv_dsp_stft**)vv_dsp_calloc(dn->channels, sizeof(vv_dsp_stft*));
+        if (!dn->stft) s = VV_DSP_ERROR_INTERNAL;
+        for (size_t c = 0; s == VV_DSP_OK && c < dn->channels; ++c) {
+            s = vv_dsp_stft_create_from_config(cfg, &dn->stft[c]);
+            if (s == VV_DSP_OK) s = vv_dsp_stft_prepare(dn->stft[c], dn->max_block);
+        }
+        (void)vv_dsp_stft_config_release(cfg);
+    }
+    if (s != VV_DSP_OK) {
+        (void)vv_dsp_denoise_destroy(dn);
+        return s;
+    }
+
+    // A call queues at most hop + max_block samples per channel (see process)
+    const size_t nh = dn->nh, ch = dn->channels;
+    dn->fifo_cap = hop + dn->max_block;
+    dn->block = vv_dsp_malloc(ch * nh * sizeof(vv_dsp_cpx) +
+                              (DENOISE_BIN_ARRAYS * nh + ch * (2 * nh + dn->fifo_cap)) * sizeof(vv_dsp_real));
+    if (!dn->block) {
+        (void)vv_dsp_denoise_destroy(dn);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    dn->spec = (vv_dsp_cpx*)dn->block;
+    vv_dsp_real* r = (vv_dsp_real*)(void*)(dn->spec + ch * nh);
+    vv_dsp_real** arrays[6] = { &dn->power, &dn->smooth, &dn->cur_min, &dn->noise, &dn->gain, &dn->mask };
+    for (size_t a = 0; a < 6; ++a) *arrays[a] = r + a * nh;
+    dn->sub_min = r + 6 * nh;
+    dn->re = r + DENOISE_BIN_ARRAYS * nh;
+    dn->im = dn->re + ch * nh;
+    dn->fifo = dn->im + ch * nh;
+    s = vv_dsp_denoise_reset(dn);
+    if (s != VV_DSP_OK) {
+        (void)vv_dsp_denoise_destroy(dn);
+        return s;
+    }
+    *out = dn;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_denoise_latency(const vv_dsp_denoise* dn) {
+    return dn ? dn->nfft : 0;
+}
+
+size_t vv_dsp_denoise_num_bins(const vv_dsp_denoise* dn) {
+    return dn ? dn->nh : 0;
+}
+
+// Minimum-statistics floor from the frame power
+static void denoise_track_noise(vv_dsp_denoise* dn) {
+    const size_t nh = dn->nh;
+    const vv_dsp_real* P = dn->power;
+    vv_dsp_real* S = dn->smooth;
+    vv_dsp_real* cur = dn->cur_min;
+    if (!dn->primed) {
+        memcpy(S, P, nh * sizeof(vv_dsp_real));
+        memcpy(cur, P, nh * sizeof(vv_dsp_real));
+        for (size_t u = 0; u < DENOISE_SUBWINDOWS; ++u) memcpy(dn->sub_min + u * nh, P, nh * sizeof(vv_dsp_real));
+        dn->primed = 1;
+    } else {
+        for (size_t k = 0; k < nh; ++k) {
+            S[k] = DENOISE_SMOOTH * S[k] + (1 - DENOISE_SMOOTH) * P[k];
+            cur[k] = S[k] < cur[k] ? S[k] : cur[k];
+        }
+    }
+
+    vv_dsp_real* N = dn->noise;
+    memcpy(N, cur, nh * sizeof(vv_dsp_real));
+    for (size_t u = 0; u < DENOISE_SUBWINDOWS; ++u) {
+        const vv_dsp_real* m = dn->sub_min + u * nh;
+        for (size_t k = 0; k < nh; ++k) N[k] = m[k] < N[k] ? m[k] : N[k];
+    }
+    for (size_t k = 0; k < nh; ++k) N[k] *= DENOISE_BIAS;
+
+    // A finished sub-window replaces the oldest one, and the next starts at S
+    if (++dn->sub_frames == dn->sub_len) {
+        memcpy(dn->sub_min + dn->sub_next * nh, cur, nh * sizeof(vv_dsp_real));
+        memcpy(cur, S, nh * sizeof(vv_dsp_real));
+        dn->sub_next = (dn->sub_next + 1) % DENOISE_SUBWINDOWS;
+        dn->sub_frames = 0;
+    }
+}
+
+// Subtraction gain, floored and smoothed over frames
+static vv_dsp_status denoise_update_mask(vv_dsp_denoise* dn) {
+    const size_t nh = dn->nh;
+    const vv_dsp_real* P = dn->power;
+    const vv_dsp_real* N = dn->noise;
+    vv_dsp_real* g = dn->gain;
+    const vv_dsp_real over = dn->over, gmin2 = dn->gmin2;
+    for (size_t k = 0; k < nh; ++k) {
+        const vv_dsp_real g2 = 1 - over * N[k] / (P[k] + DENOISE_TINY);
+        g[k] = g2 > gmin2 ? g2 : gmin2;
+    }
+    vv_dsp_status s = vv_dsp_vsqrt(g, g, nh);
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_real a = dn->pole;
+    vv_dsp_real* mask = dn->mask;
+    for (size_t k = 0; k < nh; ++k) mask[k] = a * mask[k] + (1 - a) * g[k];
+    return VV_DSP_OK;
+}
+
+// One frame of every channel: analyze, update the shared mask, gate and synthesize
+// one hop into each FIFO
+static vv_dsp_status denoise_frame(vv_dsp_denoise* dn) {
+    const size_t nh = dn->nh, ch = dn->channels;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < ch; ++c) {
+        vv_dsp_real* re = dn->re + c * nh;
+        vv_dsp_real* im = dn->im + c * nh;
+        s = vv_dsp_stft_pop_frame(dn->stft[c], dn->spec + c * nh);
+        if (s == VV_DSP_OK) s = vv_dsp_cpx_to_split(dn->spec + c * nh, re, im, nh);
+        if (s == VV_DSP_OK) s = vv_dsp_split_power(re, im, c ? dn->gain : dn->power, nh);
+        if (s == VV_DSP_OK && c) {
+            for (size_t k = 0; k < nh; ++k) dn->power[k] += dn->gain[k];
+        }
+    }
+    if (s != VV_DSP_OK) return s;
+    if (ch > 1) {
+        const vv_dsp_real inv = (vv_dsp_real)(1.0 / (double)ch);
+        for (size_t k = 0; k < nh; ++k) dn->power[k] *= inv;
+    }
+    denoise_track_noise(dn);
+    s = denoise_update_mask(dn);
+    for (size_t c = 0; s == VV_DSP_OK && c < ch; ++c) {
+        vv_dsp_real* re = dn->re + c * nh;
+        vv_dsp_real* im = dn->im + c * nh;
+        s = vv_dsp_split_apply_mask(re, im, dn->mask, nh);
+        if (s == VV_DSP_OK) s = vv_dsp_split_to_cpx(re, im, dn->spec + c * nh, nh);
+        if (s == VV_DSP_OK) {
+            s = vv_dsp_stft_synth_frame(dn->stft[c], dn->spec + c * nh, dn->fifo + c * dn->fifo_cap + dn->fifo_count);
+        }
+    }
+    if (s == VV_DSP_OK) dn->fifo_count += dn->hop;
+    return s;
+}
+
+// After n pushed samples the STFT streams hold fft_size - hop_size zeros plus the
+// input, so floor(n_total / hop) frames have been synthesized; the FIFOs start with
+// hop zeros, which makes the delay exactly fft_size. Before a call's output is taken
+// the FIFOs hold at most hop + n samples, and at least n.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_denoise_process(vv_dsp_denoise* dn,
+                                                      const vv_dsp_real* const* in,
+                                                      vv_dsp_real* const* out,
+                                                      size_t n) {
+    if (!dn || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (n > dn->max_block) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t ch = dn->channels;
+    for (size_t c = 0; c < ch; ++c) {
+        if (!in[c] || !out[c]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < ch; ++c) s = vv_dsp_stft_push(dn->stft[c], in[c], n);
+    while (s == VV_DSP_OK && vv_dsp_stft_frames_ready(dn->stft[0]) > 0) s = denoise_frame(dn);
+    if (s != VV_DSP_OK) return s;
+    for (size_t c = 0; c < ch; ++c) {
+        vv_dsp_real* f = dn->fifo + c * dn->fifo_cap;
+        memcpy(out[c], f, n * sizeof(vv_dsp_real));
+        memmove(f, f + n, (dn->fifo_count - n) * sizeof(vv_dsp_real));
+    }
+    dn->fifo_count -= n;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_denoise_get_mask(const vv_dsp_denoise* dn, vv_dsp_real* mask) {
+    if (!dn || !mask) return VV_DSP_ERROR_NULL_POINTER;
+    memcpy(mask, dn->mask, dn->nh * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_denoise_get_noise(const vv_dsp_denoise* dn, vv_dsp_real* noise) {
+    if (!dn || !noise) return VV_DSP_ERROR_NULL_POINTER;
+    memcpy(noise, dn->noise, dn->nh * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_denoise_reset(vv_dsp_denoise* dn) {
+    if (!dn) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t nh = dn->nh;
+    dn->primed = 0;
+    dn->sub_frames = 0;
+    dn->sub_next = 0;
+    memset(dn->noise, 0, nh * sizeof(vv_dsp_real));
+    for (size_t k = 0; k < nh; ++k) dn->mask[k] = 1;
+    memset(dn->fifo, 0, dn->channels * dn->fifo_cap * sizeof(vv_dsp_real));
+    dn->fifo_count = dn->hop;
+    // Pre-roll of fft_size - hop_size zeros, pushed from the zeroed first FIFO
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < dn->channels; ++c) {
+        s = vv_dsp_stft_stream_reset(dn->stft[c]);
+        if (s == VV_DSP_OK) s = vv_dsp_stft_synth_reset(dn->stft[c]);
+        for (size_t left = dn->nfft - dn->hop; s == VV_DSP_OK && left > 0;) {
+            const size_t m = left < dn->fifo_cap ? left : dn->fifo_cap;
+            s = vv_dsp_stft_push(dn->stft[c], dn->fifo, m);
+            left -= m;
+        }
+    }
+    return s;
+}
@@ -1,19 +1,26 @@
 #include <stdlib.h>
 #include <string.h>
 #include "fft_backend.h"
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/profile.h"
+#include "../core/typed_foreign.h"
+
 
 // Forward declaration for initialization function
 static void vv_dsp_fft_init_backends_once(void);
 
 // Global backend state
 vv_dsp_fft_backend g_current_fft_backend = VV_DSP_FFT_BACKEND_KISS;
+size_t g_fft_num_threads = 1;
 
 // Backend dispatch table (initialized at the bottom of this file)
-const vv_dsp_fft_backend_vtable* g_fft_backends[3] = {NULL, NULL, NULL};
+const vv_dsp_fft_backend_vtable* g_fft_backends[VV_DSP_FFT_BACKEND_COUNT] = {NULL, NULL, NULL, NULL, NULL, NULL};
 
 // Backend management API implementations
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_backend(vv_dsp_fft_backend backend) {
-    if (backend >= 3) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
 
     // Ensure backends are initialized
     vv_dsp_fft_init_backends_once();
@@ -30,7 +37,7 @@ vv_dsp_fft_backend vv_dsp_fft_get_backend(void) {
 }
 
 int vv_dsp_fft_is_backend_available(vv_dsp_fft_backend backend) {
-    if (backend >= 3) return 0;
+    if (backend >= VV_DSP_FFT_BACKEND_COUNT) return 0;
 
     // Ensure backends are initialized
     vv_dsp_fft_init_backends_once();
@@ -38,11 +45,23 @@ int vv_dsp_fft_is_backend_available(vv_dsp_fft_backend backend) {
     return g_fft_backends[backend] && g_fft_backends[backend]->is_available();
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_num_threads(size_t nthreads) {
+    if (nthreads == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    g_fft_num_threads = nthreads;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_fft_get_num_threads(void) {
+    return g_fft_num_threads;
+}
+
 // FFTW-specific configuration (only available if FFTW backend is compiled in)
 #ifdef VV_DSP_BACKEND_FFT_fftw
 // These functions are implemented in fft_fftw.c
 extern VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag_impl(vv_dsp_fftw_flag flag);
 extern VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_flush_fftw_cache_impl(void);
+extern VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_wisdom_impl(const char* path);
+extern VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_wisdom_impl(const char* path);
 
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag(vv_dsp_fftw_flag flag) {
     return vv_dsp_fft_set_fftw_flag_impl(flag);
@@ -50,6 +69,14 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag(vv_dsp_fftw_flag flag) {
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_flush_fftw_cache(void) {
     return vv_dsp_fft_flush_fftw_cache_impl();
 }
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_wisdom(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    return vv_dsp_fft_export_wisdom_impl(path);
+}
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_wisdom(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    return vv_dsp_fft_import_wisdom_impl(path);
+}
 #else
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag(vv_dsp_fftw_flag flag) {
     (void)flag;
@@ -58,33 +85,68 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag(vv_dsp_fftw_flag flag) {
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_flush_fftw_cache(void) {
     return VV_DSP_ERROR_UNSUPPORTED;
 }
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_wisdom(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    return VV_DSP_ERROR_UNSUPPORTED;
+}
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_wisdom(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    return VV_DSP_ERROR_UNSUPPORTED;
+}
 #endif
 
-VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan(size_t n,
-                                                    vv_dsp_fft_type type,
-                                                    vv_dsp_fft_dir dir,
-                                                    vv_dsp_fft_plan** out_plan) {
+static size_t fft_in_len(const vv_dsp_fft_plan* p) { return p->type == VV_DSP_FFT_C2R ? p->n/2 + 1 : p->n; }
+static size_t fft_out_len(const vv_dsp_fft_plan* p) { return p->type == VV_DSP_FFT_R2C ? p->n/2 + 1 : p->n; }
+static size_t fft_in_elem(const vv_dsp_fft_plan* p) { return p->type == VV_DSP_FFT_R2C ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx); }
+static size_t fft_out_elem(const vv_dsp_fft_plan* p) { return p->type == VV_DSP_FFT_C2R ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx); }
+
+static vv_dsp_status fft_make_plan_impl(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                        vv_dsp_fft_backend backend,
+                                        size_t howmany, size_t istride, size_t idist,
+                                        size_t ostride, size_t odist, size_t nthreads,
+                                        vv_dsp_fft_plan** out_plan) {
     if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
     *out_plan = NULL;
     if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
     if (!(type == VV_DSP_FFT_C2C || type == VV_DSP_FFT_R2C || type == VV_DSP_FFT_C2R)) return VV_DSP_ERROR_OUT_OF_RANGE;
     if (!(dir == VV_DSP_FFT_FORWARD || dir == VV_DSP_FFT_BACKWARD)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (howmany == 0 || istride == 0 || ostride == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
 
     // Ensure backends are initialized (thread-safe, one-time initialization)
     vv_dsp_fft_init_backends_once();
 
-    vv_dsp_fft_plan* plan = (vv_dsp_fft_plan*)malloc(sizeof(vv_dsp_fft_plan));
+    vv_dsp_fft_plan* plan = (vv_dsp_fft_plan*)vv_dsp_malloc(sizeof(vv_dsp_fft_plan));
     if (!plan) return VV_DSP_ERROR_INTERNAL;
 
     plan->n = n;
     plan->type = type;
     plan->dir = dir;
-    plan->backend = g_current_fft_backend;
+    plan->backend = backend;
+    plan->howmany = howmany;
+    plan->istride = istride;
+    plan->idist = idist;
+    plan->ostride = ostride;
+    plan->odist = odist;
+    plan->batch_buf = NULL;
+    plan->nthreads = nthreads;
+    plan->cache_prev = NULL;
+    plan->cache_next = NULL;
     plan->backend_plan.generic = NULL;
 
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[plan->backend];
+    if (vt && !vt->execute_many && (istride != 1 || ostride != 1)) {
+        plan->batch_buf = vv_dsp_malloc(fft_in_len(plan) * fft_in_elem(plan) + fft_out_len(plan) * fft_out_elem(plan));
+        if (!plan->batch_buf) {
+            vv_dsp_free(plan);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
     vv_dsp_status st = vv_dsp_fft_backend_make(plan, &plan->backend_plan.generic);
     if (st != VV_DSP_OK) {
-        free(plan);
+        vv_dsp_free(plan->batch_buf);
+        vv_dsp_free(plan);
         return st;
     }
 
@@ -92,17 +154,425 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan(size_t n,
     return VV_DSP_OK;
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan(size_t n,
+                                                    vv_dsp_fft_type type,
+                                                    vv_dsp_fft_dir dir,
+                                                    vv_dsp_fft_plan** out_plan) {
+    const size_t in_len = (type == VV_DSP_FFT_C2R) ? n/2 + 1 : n;
+    const size_t out_len = (type == VV_DSP_FFT_R2C) ? n/2 + 1 : n;
+    return fft_make_plan_impl(n, type, dir, g_current_fft_backend, 1, 1, in_len, 1, out_len, g_fft_num_threads,
+                              out_plan);
+}
+
+vv_dsp_status vv_dsp_fft_make_plan_backend(size_t n,
+                                           vv_dsp_fft_type type,
+                                           vv_dsp_fft_dir dir,
+                                           vv_dsp_fft_backend backend,
+                                           vv_dsp_fft_plan** out_plan) {
+    const size_t in_len = (type == VV_DSP_FFT_C2R) ? n/2 + 1 : n;
+    const size_t out_len = (type == VV_DSP_FFT_R2C) ? n/2 + 1 : n;
+    return fft_make_plan_impl(n, type, dir, backend, 1, 1, in_len, 1, out_len, g_fft_num_threads, out_plan);
+}
+
+vv_dsp_status vv_dsp_fft_context_backend(const vv_dsp_context* ctx, vv_dsp_fft_backend* out) {
+    if (!ctx || ctx->fft_backend == VV_DSP_CONTEXT_DEFAULT) {
+        *out = g_current_fft_backend;
+        return VV_DSP_OK;
+    }
+    if (ctx->fft_backend < 0 || ctx->fft_backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_fft_init_backends_once();
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[ctx->fft_backend];
+    if (!vt || !vt->is_available()) return VV_DSP_ERROR_UNSUPPORTED;
+    *out = (vv_dsp_fft_backend)ctx->fft_backend;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_ctx(const vv_dsp_context* ctx,
+                                                        size_t n,
+                                                        vv_dsp_fft_type type,
+                                                        vv_dsp_fft_dir dir,
+                                                        vv_dsp_fft_plan** out_plan) {
+    if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    vv_dsp_fft_backend backend;
+    const vv_dsp_status st = vv_dsp_fft_context_backend(ctx, &backend);
+    if (st != VV_DSP_OK) return st;
+    return vv_dsp_fft_make_plan_backend(n, type, dir, backend, out_plan);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_many(size_t n,
+                                                         vv_dsp_fft_type type,
+                                                         vv_dsp_fft_dir dir,
+                                                         size_t howmany,
+                                                         size_t istride, size_t idist,
+                                                         size_t ostride, size_t odist,
+                                                         vv_dsp_fft_plan** out_plan) {
+    return fft_make_plan_impl(n, type, dir, g_current_fft_backend, howmany, istride, idist, ostride, odist,
+                              g_fft_num_threads, out_plan);
+}
+
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute(const vv_dsp_fft_plan* plan,
                                                   const void* in,
                                                   void* out) {
     if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
-    return vv_dsp_fft_backend_exec(plan, plan->backend_plan.generic, in, out);
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_FFT_EXECUTE);
+    const vv_dsp_status s = vv_dsp_fft_backend_exec(plan, plan->backend_plan.generic, in, out);
+    VV_DSP_PROFILE_END(prof, plan->n);
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_workspace_size(const vv_dsp_fft_plan* plan,
+                                                         size_t* out_bytes) {
+    if (!plan || !out_bytes) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[plan->backend];
+    if (!vt || !vt->workspace_size || !vt->execute_ws) return VV_DSP_ERROR_UNSUPPORTED;
+    *out_bytes = vt->workspace_size(plan, plan->backend_plan.generic);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_ws(const vv_dsp_fft_plan* plan,
+                                                     const void* in,
+                                                     void* out,
+                                                     void* ws) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[plan->backend];
+    if (!vt || !vt->workspace_size || !vt->execute_ws) return VV_DSP_ERROR_UNSUPPORTED;
+    if (!ws && vt->workspace_size(plan, plan->backend_plan.generic) > 0) return VV_DSP_ERROR_NULL_POINTER;
+    return vt->execute_ws(plan, plan->backend_plan.generic, in, out, ws);
+}
+
+// Scalars per input and output vector of a plan: complex entries count twice
+static void fft_vector_lengths(const vv_dsp_fft_plan* plan, size_t* in_len, size_t* out_len) {
+    const size_t n = plan->n;
+    const size_t nh = n / 2 + 1;
+    *in_len = plan->type == VV_DSP_FFT_R2C ? n : 2 * (plan->type == VV_DSP_FFT_C2R ? nh : n);
+    *out_len = plan->type == VV_DSP_FFT_C2R ? n : 2 * (plan->type == VV_DSP_FFT_R2C ? nh : n);
+}
+
+size_t vv_dsp_fft_execute_typed_scratch_size(const vv_dsp_fft_plan* plan) {
+    if (!plan) return 0;
+    size_t in_len, out_len;
+    fft_vector_lengths(plan, &in_len, &out_len);
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_real) * (in_len + out_len));
+}
+
+// Foreign-precision execute: widen or narrow one vector into scratch, transform, convert back
+static vv_dsp_status fft_execute_foreign(const vv_dsp_fft_plan* plan, const void* in, void* out, vv_dsp_arena* arena) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    size_t in_len, out_len;
+    fft_vector_lengths(plan, &in_len, &out_len);
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* scratch = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, sizeof(vv_dsp_real) * (in_len + out_len));
+    if (!scratch) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_status st = VV_FOREIGN_TO_REAL((const vv_foreign_real*)in, scratch, in_len);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_execute(plan, scratch, scratch + in_len);
+    if (st == VV_DSP_OK) st = VV_REAL_TO_FOREIGN(scratch + in_len, (vv_foreign_real*)out, out_len);
+    vv_dsp_scratch_free(arena, scratch);
+    vv_dsp_arena_reset_to(arena, mark);
+    return st;
+}
+
+#ifdef VV_DSP_USE_DOUBLE
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f32(const vv_dsp_fft_plan* plan, const void* in, void* out,
+                                                      vv_dsp_arena* arena) {
+    return fft_execute_foreign(plan, in, out, arena);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f64(const vv_dsp_fft_plan* plan, const void* in, void* out,
+                                                      vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_fft_execute(plan, in, out);
+}
+#else
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f32(const vv_dsp_fft_plan* plan, const void* in, void* out,
+                                                      vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_fft_execute(plan, in, out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_f64(const vv_dsp_fft_plan* plan, const void* in, void* out,
+                                                      vv_dsp_arena* arena) {
+    return fft_execute_foreign(plan, in, out, arena);
+}
+#endif
+
+// Generic split execute: stage through interleaved buffers and the normal path
+static vv_dsp_status fft_execute_split_staged(const vv_dsp_fft_plan* plan,
+                                              const vv_dsp_real* in_re, const vv_dsp_real* in_im,
+                                              vv_dsp_real* out_re, vv_dsp_real* out_im) {
+    const size_t n = plan->n;
+    const size_t nh = n / 2 + 1;
+    const size_t in_len = (plan->type == VV_DSP_FFT_C2R) ? nh : n;
+    const size_t out_len = (plan->type == VV_DSP_FFT_R2C) ? nh : n;
+    vv_dsp_cpx* cin = NULL;
+    vv_dsp_cpx* cout = NULL;
+    if (plan->type != VV_DSP_FFT_R2C) cin = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * in_len);
+    if (plan->type != VV_DSP_FFT_C2R) cout = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * out_len);
+    if ((plan->type != VV_DSP_FFT_R2C && !cin) || (plan->type != VV_DSP_FFT_C2R && !cout)) {
+        vv_dsp_free(cin);
+        vv_dsp_free(cout);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    vv_dsp_status st = VV_DSP_OK;
+    if (cin) st = vv_dsp_split_to_cpx(in_re, in_im, cin, in_len);
+    if (st == VV_DSP_OK) {
+        st = vv_dsp_fft_backend_exec(plan, plan->backend_plan.generic,
+                                     cin ? (const void*)cin : (const void*)in_re,
+                                     cout ? (void*)cout : (void*)out_re);
+    }
+    if (st == VV_DSP_OK && cout) st = vv_dsp_cpx_to_split(cout, out_re, out_im, out_len);
+    vv_dsp_free(cin);
+    vv_dsp_free(cout);
+    return st;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_split(const vv_dsp_fft_plan* plan,
+                                                        const vv_dsp_real* in_re,
+                                                        const vv_dsp_real* in_im,
+                                                        vv_dsp_real* out_re,
+                                                        vv_dsp_real* out_im) {
+    if (!plan || !in_re || !out_re) return VV_DSP_ERROR_NULL_POINTER;
+    if (plan->type != VV_DSP_FFT_R2C && !in_im) return VV_DSP_ERROR_NULL_POINTER;
+    if (plan->type != VV_DSP_FFT_C2R && !out_im) return VV_DSP_ERROR_NULL_POINTER;
+    if (plan->howmany > 1 || plan->istride != 1 || plan->ostride != 1) return VV_DSP_ERROR_UNSUPPORTED;
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[plan->backend];
+    if (vt && vt->execute_split) {
+        return vt->execute_split(plan, plan->backend_plan.generic, in_re,
+                                 plan->type == VV_DSP_FFT_R2C ? NULL : in_im, out_re,
+                                 plan->type == VV_DSP_FFT_C2R ? NULL : out_im);
+    }
+    return fft_execute_split_staged(plan, in_re, in_im, out_re, out_im);
+}
+
+static void copy_strided(unsigned char* dst, size_t dst_stride,
+                         const unsigned char* src, size_t src_stride,
+                         size_t count, size_t elem) {
+    if (elem == sizeof(vv_dsp_cpx)) {
+        vv_dsp_cpx* d = (vv_dsp_cpx*)(void*)dst;
+        const vv_dsp_cpx* s = (const vv_dsp_cpx*)(const void*)src;
+        for (size_t i = 0; i < count; ++i) d[i * dst_stride] = s[i * src_stride];
+    } else {
+        vv_dsp_real* d = (vv_dsp_real*)(void*)dst;
+        const vv_dsp_real* s = (const vv_dsp_real*)(const void*)src;
+        for (size_t i = 0; i < count; ++i) d[i * dst_stride] = s[i * src_stride];
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_execute_batch(const vv_dsp_fft_plan* plan,
+                                                        const void* in,
+                                                        void* out) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (plan->backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const vv_dsp_fft_backend_vtable* vt = g_fft_backends[plan->backend];
+    if (!vt || !vt->is_available()) return VV_DSP_ERROR_UNSUPPORTED;
+    if (vt->execute_many) return vt->execute_many(plan, plan->backend_plan.generic, in, out);
+
+    // Generic path: one backend call per vector, gathering/scattering strided data
+    const size_t in_len = fft_in_len(plan), out_len = fft_out_len(plan);
+    const size_t in_elem = fft_in_elem(plan), out_elem = fft_out_elem(plan);
+    unsigned char* gather = (unsigned char*)plan->batch_buf;
+    unsigned char* scatter = gather ? gather + in_len * in_elem : NULL;
+    for (size_t j = 0; j < plan->howmany; ++j) {
+        const unsigned char* src = (const unsigned char*)in + j * plan->idist * in_elem;
+        unsigned char* dst = (unsigned char*)out + j * plan->odist * out_elem;
+        const void* fin = src;
+        void* fout = dst;
+        if (plan->istride != 1) {
+            copy_strided(gather, 1, src, plan->istride, in_len, in_elem);
+            fin = gather;
+        }
+        if (plan->ostride != 1) fout = scatter;
+        vv_dsp_status st = vt->execute(plan, plan->backend_plan.generic, fin, fout);
+        if (st != VV_DSP_OK) return st;
+        if (plan->ostride != 1) copy_strided(dst, plan->ostride, scatter, 1, out_len, out_elem);
+    }
+    return VV_DSP_OK;
 }
 
 vv_dsp_status vv_dsp_fft_destroy(vv_dsp_fft_plan* plan) {
     if (!plan) return VV_DSP_OK;  // Allow safe destruction of null plan
-    vv_dsp_fft_backend_free(plan->backend_plan.generic);
-    free(plan);
+    if (plan->backend < VV_DSP_FFT_BACKEND_COUNT && g_fft_backends[plan->backend] && g_fft_backends[plan->backend]->free_plan) {
+        g_fft_backends[plan->backend]->free_plan(plan->backend_plan.generic);
+    }
+    vv_dsp_free(plan->batch_buf);
+    vv_dsp_free(plan);
+    return VV_DSP_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Process-wide plan cache: an LRU list of idle plans. Acquire takes a plan
+// out of the list, release puts it back at the head.
+// ---------------------------------------------------------------------------
+
+#define VV_DSP_FFT_CACHE_DEFAULT_CAPACITY 32
+
+static fft_mutex g_cache_mutex = FFT_MUTEX_INIT;
+static vv_dsp_fft_plan* g_cache_head = NULL;
+static vv_dsp_fft_plan* g_cache_tail = NULL;
+static size_t g_cache_count = 0;
+static size_t g_cache_capacity = VV_DSP_FFT_CACHE_DEFAULT_CAPACITY;
+static size_t g_cache_hits = 0;
+static size_t g_cache_misses = 0;
+static size_t g_cache_in_use = 0;
+
+static void cache_unlink(vv_dsp_fft_plan* p) {
+    if (p->cache_prev) p->cache_prev->cache_next = p->cache_next;
+    else g_cache_head = p->cache_next;
+    if (p->cache_next) p->cache_next->cache_prev = p->cache_prev;
+    else g_cache_tail = p->cache_prev;
+    p->cache_prev = p->cache_next = NULL;
+    g_cache_count--;
+}
+
+// Detach idle plans beyond `keep` (oldest first) and return them as a list
+// linked through cache_next, to be destroyed outside the lock.
+static vv_dsp_fft_plan* cache_trim(size_t keep) {
+    vv_dsp_fft_plan* victims = NULL;
+    while (g_cache_count > keep && g_cache_tail) {
+        vv_dsp_fft_plan* p = g_cache_tail;
+        cache_unlink(p);
+        p->cache_next = victims;
+        victims = p;
+    }
+    return victims;
+}
+
+static void destroy_list(vv_dsp_fft_plan* p) {
+    while (p) {
+        vv_dsp_fft_plan* next = p->cache_next;
+        p->cache_next = NULL;
+        (void)vv_dsp_fft_destroy(p);
+        p = next;
+    }
+}
+
+static int plan_is_single(const vv_dsp_fft_plan* p) {
+    return p->howmany == 1 && p->istride == 1 && p->ostride == 1;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_plan_acquire(size_t n,
+                                                       vv_dsp_fft_type type,
+                                                       vv_dsp_fft_dir dir,
+                                                       vv_dsp_fft_plan** out_plan) {
+    return vv_dsp_fft_plan_acquire_backend(n, type, dir, g_current_fft_backend, out_plan);
+}
+
+static vv_dsp_status fft_plan_acquire_impl(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                           vv_dsp_fft_backend backend, size_t nthreads,
+                                           vv_dsp_fft_plan** out_plan) {
+    if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    fft_mutex_lock(&g_cache_mutex);
+    for (vv_dsp_fft_plan* p = g_cache_head; p; p = p->cache_next) {
+        if (p->n == n && p->type == type && p->dir == dir && p->backend == backend &&
+            p->nthreads == nthreads) {
+            cache_unlink(p);
+            g_cache_hits++;
+            g_cache_in_use++;
+            fft_mutex_unlock(&g_cache_mutex);
+            *out_plan = p;
+            return VV_DSP_OK;
+        }
+    }
+    g_cache_misses++;
+    fft_mutex_unlock(&g_cache_mutex);
+
+    const size_t in_len = (type == VV_DSP_FFT_C2R) ? n/2 + 1 : n;
+    const size_t out_len = (type == VV_DSP_FFT_R2C) ? n/2 + 1 : n;
+    vv_dsp_status st = fft_make_plan_impl(n, type, dir, backend, 1, 1, in_len, 1, out_len, nthreads, out_plan);
+    if (st == VV_DSP_OK) {
+        fft_mutex_lock(&g_cache_mutex);
+        g_cache_in_use++;
+        fft_mutex_unlock(&g_cache_mutex);
+    }
+    return st;
+}
+
+vv_dsp_status vv_dsp_fft_plan_acquire_backend(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                              vv_dsp_fft_backend backend, vv_dsp_fft_plan** out_plan) {
+    return fft_plan_acquire_impl(n, type, dir, backend, g_fft_num_threads, out_plan);
+}
+
+vv_dsp_status vv_dsp_fft_plan_acquire_reproducible(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                                   vv_dsp_fft_plan** out_plan) {
+    return fft_plan_acquire_impl(n, type, dir, VV_DSP_FFT_BACKEND_KISS, 1, out_plan);
+}
+
+vv_dsp_status vv_dsp_fft_plan_release(vv_dsp_fft_plan* plan) {
+    if (!plan) return VV_DSP_OK;
+    if (!plan_is_single(plan)) return vv_dsp_fft_destroy(plan);
+
+    fft_mutex_lock(&g_cache_mutex);
+    if (g_cache_in_use > 0) g_cache_in_use--;
+    plan->cache_prev = NULL;
+    plan->cache_next = g_cache_head;
+    if (g_cache_head) g_cache_head->cache_prev = plan;
+    g_cache_head = plan;
+    if (!g_cache_tail) g_cache_tail = plan;
+    g_cache_count++;
+    vv_dsp_fft_plan* victims = cache_trim(g_cache_capacity);
+    fft_mutex_unlock(&g_cache_mutex);
+
+    destroy_list(victims);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fft_cache_set_capacity(size_t capacity) {
+    fft_mutex_lock(&g_cache_mutex);
+    g_cache_capacity = capacity;
+    vv_dsp_fft_plan* victims = cache_trim(capacity);
+    fft_mutex_unlock(&g_cache_mutex);
+    destroy_list(victims);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fft_cache_get_stats(vv_dsp_fft_cache_stats* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    fft_mutex_lock(&g_cache_mutex);
+    out->hits = g_cache_hits;
+    out->misses = g_cache_misses;
+    out->entries = g_cache_count;
+    out->in_use = g_cache_in_use;
+    out->capacity = g_cache_capacity;
+    fft_mutex_unlock(&g_cache_mutex);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_fft_cache_clear(void) {
+    fft_mutex_lock(&g_cache_mutex);
+    vv_dsp_fft_plan* victims = cache_trim(0);
+    g_cache_hits = 0;
+    g_cache_misses = 0;
+    fft_mutex_unlock(&g_cache_mutex);
+    destroy_list(victims);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_prewarm(const size_t* sizes,
+                                                 const vv_dsp_fft_type* types,
+                                                 size_t count) {
+    if (count == 0) return VV_DSP_OK;
+    if (!sizes || !types) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < count; ++i) {
+        if (types[i] != VV_DSP_FFT_C2C && types[i] != VV_DSP_FFT_R2C && types[i] != VV_DSP_FFT_C2R) {
+            return VV_DSP_ERROR_OUT_OF_RANGE;
+        }
+        // Real transforms only run in their natural direction; C2C in both
+        const vv_dsp_fft_dir dirs[2] = {
+            types[i] == VV_DSP_FFT_C2R ? VV_DSP_FFT_BACKWARD : VV_DSP_FFT_FORWARD,
+            VV_DSP_FFT_BACKWARD
+        };
+        const int ndirs = (types[i] == VV_DSP_FFT_C2C) ? 2 : 1;
+        for (int d = 0; d < ndirs; ++d) {
+            vv_dsp_fft_plan* plan = NULL;
+            vv_dsp_status st = vv_dsp_fft_plan_acquire(sizes[i], types[i], dirs[d], &plan);
+            if (st != VV_DSP_OK) return st;
+            (void)vv_dsp_fft_plan_release(plan);
+        }
+    }
     return VV_DSP_OK;
 }
 
@@ -119,6 +589,15 @@ static void vv_dsp_fft_init_backends_once(void) {
 #ifdef VV_DSP_BACKEND_FFT_ffts
     g_fft_backends[VV_DSP_FFT_BACKEND_FFTS] = &vv_dsp_fft_ffts_vtable;
 #endif
+#ifdef VV_DSP_BACKEND_FFT_cufft
+    g_fft_backends[VV_DSP_FFT_BACKEND_CUFFT] = &vv_dsp_fft_cufft_vtable;
+#endif
+#ifdef VV_DSP_BACKEND_FFT_vdsp
+    g_fft_backends[VV_DSP_FFT_BACKEND_VDSP] = &vv_dsp_fft_vdsp_vtable;
+#endif
+#ifdef VV_DSP_BACKEND_FFT_pocketfft
+    g_fft_backends[VV_DSP_FFT_BACKEND_POCKETFFT] = &vv_dsp_fft_pocketfft_vtable;
+#endif
 
     g_backends_initialized = 1;
 }
@@ -0,0 +1,239 @@
+/*
+This file is part of vv-dsp
+
+2-D FFT over the 1-D plans: a row pass, then a column pass in panels of
+FFT2D_PANEL columns. A panel is gathered row by row into FFT2D_PANEL contiguous
+vectors (each row read touches one short contiguous run), transformed, and
+scattered back the same way, so neither pass strides through the matrix one
+element per cache line. C2R runs the columns first, into a plan-owned matrix.
+*/
+
+#include <string.h>
+#include "vv_dsp/spectral/fft2d.h"
+#include "vv_dsp/core/alloc.h"
+#include "fft_backend.h"
+#include "parallel.h"
+
+#define FFT2D_PANEL 8                  // columns moved together by the blocked transposes
+#define FFT2D_PARALLEL_MIN (1u << 15)  // elements below which both passes run serially
+
+typedef struct fft2d_worker {
+    void* ws;                // workspace of the shared plans
+    vv_dsp_fft_plan* own_row; // private plans when the backend has no workspace entry point
+    vv_dsp_fft_plan* own_col;
+    vv_dsp_cpx* panel;       // 2 * FFT2D_PANEL * rows: gathered columns and their transforms
+    vv_dsp_status status;
+} fft2d_worker;
+
+struct vv_dsp_fft2d_plan {
+    size_t rows, cols;
+    size_t hcols;            // columns on the complex side: cols, or cols/2+1 for R2C / C2R
+    vv_dsp_fft_type type;
+    vv_dsp_fft_dir dir;
+    vv_dsp_fft_plan* row_plan; // length cols, the plan's type
+    vv_dsp_fft_plan* col_plan; // length rows, C2C in the plan's direction
+    int use_ws;
+    vv_dsp_threadpool* pool;
+    size_t num_workers;
+    fft2d_worker* workers;
+    vv_dsp_cpx* mid;         // C2R: the column-transformed input
+#ifdef VV_DSP_BACKEND_FFT_fftw
+    vv_dsp_fftw_2d* native;
+#endif
+};
+
+// One pass of one call
+typedef struct fft2d_job {
+    const vv_dsp_fft2d_plan* plan;
+    const void* src;
+    void* dst;
+    size_t parts;            // workers sharing the pass
+} fft2d_job;
+
+static vv_dsp_status fft2d_exec(const vv_dsp_fft2d_plan* p, fft2d_worker* wk, int row, const void* in, void* out) {
+    if (p->use_ws) return vv_dsp_fft_execute_ws(row ? p->row_plan : p->col_plan, in, out, wk->ws);
+    return vv_dsp_fft_execute(row ? wk->own_row : wk->own_col, in, out);
+}
+
+static void fft2d_rows_worker(void* ctx, size_t w) {
+    const fft2d_job* job = (const fft2d_job*)ctx;
+    const vv_dsp_fft2d_plan* p = job->plan;
+    fft2d_worker* wk = &p->workers[w];
+    const size_t r0 = p->rows * w / job->parts, r1 = p->rows * (w + 1) / job->parts;
+    // Row lengths on each side, in elements of that side
+    const size_t in_len = p->type == VV_DSP_FFT_C2R ? p->hcols : p->cols;
+    const size_t out_len = p->type == VV_DSP_FFT_R2C ? p->hcols : p->cols;
+    const size_t in_elem = p->type == VV_DSP_FFT_R2C ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx);
+    const size_t out_elem = p->type == VV_DSP_FFT_C2R ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx);
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t r = r0; s == VV_DSP_OK && r < r1; ++r) {
+        s = fft2d_exec(p, wk, 1, (const unsigned char*)job->src + r * in_len * in_elem,
+                       (unsigned char*)job->dst + r * out_len * out_elem);
+    }
+    wk->status = s;
+}
+
+static void fft2d_cols_worker(void* ctx, size_t w) {
+    const fft2d_job* job = (const fft2d_job*)ctx;
+    const vv_dsp_fft2d_plan* p = job->plan;
+    fft2d_worker* wk = &p->workers[w];
+    const size_t R = p->rows, H = p->hcols;
+    const size_t panels = (H + FFT2D_PANEL - 1) / FFT2D_PANEL;
+    const size_t c_begin = panels * w / job->parts * FFT2D_PANEL;
+    size_t c_end = panels * (w + 1) / job->parts * FFT2D_PANEL;
+    if (c_end > H) c_end = H;
+    const vv_dsp_cpx* src = (const vv_dsp_cpx*)job->src;
+    vv_dsp_cpx* dst = (vv_dsp_cpx*)job->dst;
+    vv_dsp_cpx* gathered = wk->panel;
+    vv_dsp_cpx* spectra = wk->panel + FFT2D_PANEL * R;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c0 = c_begin; s == VV_DSP_OK && c0 < c_end; c0 += FFT2D_PANEL) {
+        const size_t cb = (c_end - c0 < FFT2D_PANEL) ? c_end - c0 : FFT2D_PANEL;
+        for (size_t r = 0; r < R; ++r) {
+            const vv_dsp_cpx* row = src + r * H + c0;
+            for (size_t b = 0; b < cb; ++b) gathered[b * R + r] = row[b];
+        }
+        for (size_t b = 0; s == VV_DSP_OK && b < cb; ++b) {
+            s = fft2d_exec(p, wk, 0, gathered + b * R, spectra + b * R);
+        }
+        for (size_t r = 0; s == VV_DSP_OK && r < R; ++r) {
+            vv_dsp_cpx* row = dst + r * H + c0;
+            for (size_t b = 0; b < cb; ++b) row[b] = spectra[b * R + r];
+        }
+    }
+    wk->status = s;
+}
+
+static vv_dsp_status fft2d_pass(const vv_dsp_fft2d_plan* p, vv_dsp_parallel_fn fn, size_t units, const void* src,
+                                void* dst) {
+    fft2d_job job;
+    job.plan = p;
+    job.src = src;
+    job.dst = dst;
+    job.parts = p->num_workers < units ? p->num_workers : units;
+    if (p->rows * p->cols < FFT2D_PARALLEL_MIN) job.parts = 1;
+    vv_dsp_status s = VV_DSP_OK;
+    if (job.parts <= 1) {
+        job.parts = 1;
+        fn(&job, 0);
+    } else {
+        s = vv_dsp_parallel_run_on(p->pool, job.parts, fn, &job);
+    }
+    for (size_t w = 0; s == VV_DSP_OK && w < job.parts; ++w) s = p->workers[w].status;
+    return s;
+}
+
+vv_dsp_status vv_dsp_fft2d_destroy(vv_dsp_fft2d_plan* plan) {
+    if (!plan) return VV_DSP_OK;
+#ifdef VV_DSP_BACKEND_FFT_fftw
+    vv_dsp_fftw_2d_free(plan->native);
+#endif
+    if (plan->workers) {
+        for (size_t w = 0; w < plan->num_workers; ++w) {
+            vv_dsp_fft_destroy(plan->workers[w].own_row);
+            vv_dsp_fft_destroy(plan->workers[w].own_col);
+            vv_dsp_free(plan->workers[w].ws);
+            vv_dsp_free(plan->workers[w].panel);
+        }
+        vv_dsp_free(plan->workers);
+    }
+    vv_dsp_fft_destroy(plan->row_plan);
+    vv_dsp_fft_destroy(plan->col_plan);
+    vv_dsp_free(plan->mid);
+    vv_dsp_free(plan);
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status fft2d_make_plans(const vv_dsp_fft2d_plan* p, vv_dsp_fft_backend be, vv_dsp_fft_plan** row,
+                                      vv_dsp_fft_plan** col) {
+    vv_dsp_status s = vv_dsp_fft_make_plan_backend(p->cols, p->type, p->dir, be, row);
+    if (s == VV_DSP_OK) s = vv_dsp_fft_make_plan_backend(p->rows, VV_DSP_FFT_C2C, p->dir, be, col);
+    return s;
+}
+
+static vv_dsp_status fft2d_setup(vv_dsp_fft2d_plan* p, vv_dsp_fft_backend be) {
+    vv_dsp_status s = fft2d_make_plans(p, be, &p->row_plan, &p->col_plan);
+    if (s != VV_DSP_OK) return s;
+    size_t wr = 0, wc = 0;
+    p->use_ws = vv_dsp_fft_workspace_size(p->row_plan, &wr) == VV_DSP_OK &&
+                vv_dsp_fft_workspace_size(p->col_plan, &wc) == VV_DSP_OK;
+    const size_t ws_bytes = wr > wc ? wr : wc;
+    p->num_workers = p->rows * p->cols < FFT2D_PARALLEL_MIN ? 1 : vv_dsp_parallel_pool_workers(p->pool);
+    p->workers = (fft2d_worker*)vv_dsp_calloc(p->num_workers, sizeof(fft2d_worker));
+    if (!p->workers) return VV_DSP_ERROR_INTERNAL;
+    for (size_t w = 0; w < p->num_workers; ++w) {
+        fft2d_worker* wk = &p->workers[w];
+        wk->panel = (vv_dsp_cpx*)vv_dsp_malloc(2 * FFT2D_PANEL * p->rows * sizeof(vv_dsp_cpx));
+        if (!wk->panel) return VV_DSP_ERROR_INTERNAL;
+        if (p->use_ws) {
+            wk->ws = ws_bytes ? vv_dsp_malloc(ws_bytes) : NULL;
+            if (ws_bytes && !wk->ws) return VV_DSP_ERROR_INTERNAL;
+        } else {
+            s = fft2d_make_plans(p, be, &wk->own_row, &wk->own_col);
+            if (s != VV_DSP_OK) return s;
+        }
+    }
+    if (p->type == VV_DSP_FFT_C2R) {
+        p->mid = (vv_dsp_cpx*)vv_dsp_malloc(p->rows * p->hcols * sizeof(vv_dsp_cpx));
+        if (!p->mid) return VV_DSP_ERROR_INTERNAL;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_make_plan(size_t rows, size_t cols, vv_dsp_fft_type type,
+                                                      vv_dsp_fft_dir dir, vv_dsp_fft2d_plan** out_plan) {
+    return vv_dsp_fft2d_make_plan_ctx(NULL, rows, cols, type, dir, out_plan);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_make_plan_ctx(const vv_dsp_context* ctx, size_t rows, size_t cols,
+                                                          vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                                          vv_dsp_fft2d_plan** out_plan) {
+    if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (rows == 0 || cols == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(type == VV_DSP_FFT_C2C || type == VV_DSP_FFT_R2C || type == VV_DSP_FFT_C2R)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!(dir == VV_DSP_FFT_FORWARD || dir == VV_DSP_FFT_BACKWARD)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if ((type == VV_DSP_FFT_R2C && dir != VV_DSP_FFT_FORWARD) || (type == VV_DSP_FFT_C2R && dir != VV_DSP_FFT_BACKWARD))
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_fft_backend be;
+    vv_dsp_status s = vv_dsp_context_check(ctx);
+    if (s == VV_DSP_OK) s = vv_dsp_fft_context_backend(ctx, &be);
+    if (s != VV_DSP_OK) return s;
+
+    vv_dsp_fft2d_plan* p = (vv_dsp_fft2d_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->rows = rows;
+    p->cols = cols;
+    p->hcols = type == VV_DSP_FFT_C2C ? cols : cols / 2 + 1;
+    p->type = type;
+    p->dir = dir;
+    p->pool = ctx ? ctx->pool : NULL;
+#ifdef VV_DSP_BACKEND_FFT_fftw
+    if (be == VV_DSP_FFT_BACKEND_FFTW &&
+        vv_dsp_fftw_2d_make(rows, cols, type, dir, g_fft_num_threads, &p->native) == VV_DSP_OK) {
+        *out_plan = p;
+        return VV_DSP_OK;
+    }
+#endif
+    s = fft2d_setup(p, be);
+    if (s != VV_DSP_OK) {
+        (void)vv_dsp_fft2d_destroy(p);
+        return s;
+    }
+    *out_plan = p;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft2d_execute(const vv_dsp_fft2d_plan* plan, const void* in, void* out) {
+    if (!plan || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+#ifdef VV_DSP_BACKEND_FFT_fftw
+    if (plan->native) return vv_dsp_fftw_2d_execute(plan->native, in, out);
+#endif
+    const size_t panels = (plan->hcols + FFT2D_PANEL - 1) / FFT2D_PANEL;
+    if (plan->type == VV_DSP_FFT_C2R) {
+        vv_dsp_status s = fft2d_pass(plan, fft2d_cols_worker, panels, in, plan->mid);
+        return s == VV_DSP_OK ? fft2d_pass(plan, fft2d_rows_worker, plan->rows, plan->mid, out) : s;
+    }
+    vv_dsp_status s = fft2d_pass(plan, fft2d_rows_worker, plan->rows, in, out);
+    return s == VV_DSP_OK ? fft2d_pass(plan, fft2d_cols_worker, panels, out, out) : s;
+}
@@ -5,6 +5,20 @@
 #include "vv_dsp/vv_dsp_types.h"
 #include "vv_dsp/spectral/fft.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+typedef SRWLOCK fft_mutex;
+#define FFT_MUTEX_INIT SRWLOCK_INIT
+#define fft_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define fft_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t fft_mutex;
+#define FFT_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define fft_mutex_lock(m) pthread_mutex_lock(m)
+#define fft_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,9 +34,21 @@ struct vv_dsp_fft_plan {
     vv_dsp_fft_dir dir;
     vv_dsp_fft_backend backend;
 
+    // Batch geometry (vv_dsp_fft_make_plan_many); single plans use
+    // howmany = 1 with unit strides and contiguous distances
+    size_t howmany;
+    size_t istride, idist;
+    size_t ostride, odist;
+    void* batch_buf;            // gather/scatter buffer for strided generic batches
+    size_t nthreads;            // worker threads for large transforms (vv_dsp_fft_set_num_threads)
+
+    // Process-wide plan cache links (idle plans only)
+    struct vv_dsp_fft_plan* cache_prev;
+    struct vv_dsp_fft_plan* cache_next;
+
     // Backend-specific plan data
     union {
-        void* generic;          // For KissFFT (stateless)
+        void* generic;          // For KissFFT (tables + scratch)
         fftw_plan fftw;         // FFTW plan handle
         ffts_plan ffts;         // FFTS plan handle
     } backend_plan;
@@ -33,13 +59,30 @@ typedef struct vv_dsp_fft_backend_vtable {
     vv_dsp_status (*make_plan)(const struct vv_dsp_fft_plan* spec, void** backend_data);
     vv_dsp_status (*execute)(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out);
     void (*free_plan)(void* backend_data);
+    // Optional: transform the whole batch (spec->howmany vectors). When NULL,
+    // vv_dsp_fft_execute_batch loops over execute() itself.
+    vv_dsp_status (*execute_many)(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out);
+    // Bytes of caller workspace execute_ws needs (including any alignment slack)
+    size_t (*workspace_size)(const struct vv_dsp_fft_plan* spec, const void* backend_data);
+    // Execute using only `ws` for mutable scratch, so one plan can run
+    // concurrently from threads that each pass their own workspace
+    vv_dsp_status (*execute_ws)(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                const void* in, void* out, void* ws);
+    // Optional: single-vector execute on split-complex buffers. in_im/out_im
+    // are unused (NULL) on the real side of R2C/C2R. When NULL,
+    // vv_dsp_fft_execute_split converts through interleaved temporaries.
+    vv_dsp_status (*execute_split)(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                   const vv_dsp_real* in_re, const vv_dsp_real* in_im,
+                                   vv_dsp_real* out_re, vv_dsp_real* out_im);
     int (*is_available)(void);
     const char* name;
 } vv_dsp_fft_backend_vtable;
 
 // Global backend management
 extern vv_dsp_fft_backend g_current_fft_backend;
-extern const vv_dsp_fft_backend_vtable* g_fft_backends[3];
+extern size_t g_fft_num_threads;
+#define VV_DSP_FFT_BACKEND_COUNT 6
+extern const vv_dsp_fft_backend_vtable* g_fft_backends[VV_DSP_FFT_BACKEND_COUNT];
 
 // Backend implementations
 extern const vv_dsp_fft_backend_vtable vv_dsp_fft_kiss_vtable;
@@ -49,12 +92,70 @@ extern const vv_dsp_fft_backend_vtable vv_dsp_fft_fftw_vtable;
 #ifdef VV_DSP_BACKEND_FFT_ffts
 extern const vv_dsp_fft_backend_vtable vv_dsp_fft_ffts_vtable;
 #endif
+#ifdef VV_DSP_BACKEND_FFT_cufft
+extern const vv_dsp_fft_backend_vtable vv_dsp_fft_cufft_vtable;
+#endif
+#ifdef VV_DSP_BACKEND_FFT_vdsp
+extern const vv_dsp_fft_backend_vtable vv_dsp_fft_vdsp_vtable;
+#endif
+#ifdef VV_DSP_BACKEND_FFT_pocketfft
+extern const vv_dsp_fft_backend_vtable vv_dsp_fft_pocketfft_vtable;
+#endif
 
 // Internal backend interface functions
 vv_dsp_status vv_dsp_fft_backend_make(const struct vv_dsp_fft_plan* spec, void** backend);
 vv_dsp_status vv_dsp_fft_backend_exec(const struct vv_dsp_fft_plan* spec, void* backend, const void* in, void* out);
 void vv_dsp_fft_backend_free(void* backend);
 
+// Single-vector plan on an explicit backend, ignoring g_current_fft_backend
+vv_dsp_status vv_dsp_fft_make_plan_backend(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                           vv_dsp_fft_backend backend, vv_dsp_fft_plan** out_plan);
+
+// vv_dsp_fft_plan_acquire() on an explicit backend
+vv_dsp_status vv_dsp_fft_plan_acquire_backend(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                              vv_dsp_fft_backend backend, vv_dsp_fft_plan** out_plan);
+
+// Cached single-threaded KissFFT plan: the same bits whatever the current backend,
+// FFT thread count and SIMD level (the reproducible reduction modes)
+vv_dsp_status vv_dsp_fft_plan_acquire_reproducible(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                                   vv_dsp_fft_plan** out_plan);
+
+// Backend a context selects (the current one for NULL or VV_DSP_CONTEXT_DEFAULT);
+// VV_DSP_ERROR_OUT_OF_RANGE / VV_DSP_ERROR_UNSUPPORTED for an unknown or missing backend
+vv_dsp_status vv_dsp_fft_context_backend(const vv_dsp_context* ctx, vv_dsp_fft_backend* out);
+
+// Device-resident spectrogram of the cuFFT backend (fft_cufft.c), used by STFT
+// handles whose plans run on VV_DSP_FFT_BACKEND_CUFFT. The state keeps the window,
+// batched plans and buffers on the device between calls; it is created by the first
+// call into *state and freed with vv_dsp_cufft_spectrogram_free(). The signal goes
+// up once, frames are windowed, transformed, scaled and mel-projected on the device
+// and only the finished rows come back. scale is a vv_dsp_spectrogram_scale; full
+// mirrors the Hermitian half into nfft columns. Returns VV_DSP_ERROR_UNSUPPORTED
+// without touching out when the backend is not built or the geometry does not fit
+// the kernels, so the caller falls back to the host path.
+typedef struct vv_dsp_cufft_spectrogram vv_dsp_cufft_spectrogram;
+vv_dsp_status vv_dsp_cufft_spectrogram_run(vv_dsp_cufft_spectrogram** state, const vv_dsp_real* win,
+                                           size_t nfft, size_t hop, int full,
+                                           const vv_dsp_real* signal, size_t n, size_t frames,
+                                           int scale, vv_dsp_real floor_v,
+                                           const vv_dsp_real* mel, size_t n_mels, vv_dsp_real* out);
+void vv_dsp_cufft_spectrogram_free(vv_dsp_cufft_spectrogram* state);
+
+#ifdef VV_DSP_BACKEND_FFT_fftw
+// Native 2-D plan of the FFTW backend (fft_fftw.c) behind vv_dsp_fft2d: one fftwf plan
+// over staging buffers it owns, scaled by 1/(rows*cols) when backward. Execute converts
+// through the staging buffers, so one state must not run on several threads at once.
+typedef struct vv_dsp_fftw_2d vv_dsp_fftw_2d;
+vv_dsp_status vv_dsp_fftw_2d_make(size_t rows, size_t cols, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                  size_t nthreads, vv_dsp_fftw_2d** out);
+vv_dsp_status vv_dsp_fftw_2d_execute(const vv_dsp_fftw_2d* p, const void* in, void* out);
+void vv_dsp_fftw_2d_free(vv_dsp_fftw_2d* p);
+#endif
+
+// Unscaled out-of-place kernel of fft_small.c for power-of-two n in 2..64 (sign +1
+// forward, -1 backward); returns 0 when n has no kernel
+int vv_dsp_fft_small_raw(size_t n, int sign, const vv_dsp_cpx* in, vv_dsp_cpx* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,414 @@
+/*
+This file is part of vv-dsp
+
+cuFFT backend implementation for the vv-dsp FFT abstraction layer.
+Runs transforms on the first CUDA device through cuFFT, with device-resident
+plans and buffers, and a fused device spectrogram for STFT handles.
+
+Plans keep their cuFFT handles, device buffers and pinned host staging for the
+plan's lifetime, so an execute call is one upload, one transform and one
+download on the plan's stream. Batch plans (vv_dsp_fft_make_plan_many) map onto
+cufftPlanMany with the same strides and distances, so a whole batch is one
+launch. vv_dsp_cufft_spectrogram_run() goes further for STFT: the signal is
+uploaded once and frames are windowed, transformed, scaled and mel-projected on
+the device in chunks on two streams, so the download of one chunk overlaps the
+kernels of the next and only finished rows cross the bus.
+*/
+
+#include "fft_backend.h"
+
+#ifdef VV_DSP_BACKEND_FFT_cufft
+
+#include <limits.h>
+#include <string.h>
+#include <cuda_runtime_api.h>
+#include <cufft.h>
+#include "vv_dsp/core/alloc.h"
+#include "fft_cufft.h"
+
+#ifdef VV_DSP_USE_DOUBLE
+#define CUFFT_T_R2C CUFFT_D2Z
+#define CUFFT_T_C2R CUFFT_Z2D
+#define CUFFT_T_C2C CUFFT_Z2Z
+#else
+#define CUFFT_T_R2C CUFFT_R2C
+#define CUFFT_T_C2R CUFFT_C2R
+#define CUFFT_T_C2C CUFFT_C2C
+#endif
+
+// Probed once: -1 unknown, then 0 / 1. A race only repeats the probe.
+static volatile int g_cufft_available = -1;
+
+static int cufft_is_available(void) {
+    int a = g_cufft_available;
+    if (a < 0) {
+        int count = 0;
+        a = (cudaGetDeviceCount(&count) == cudaSuccess && count > 0) ? 1 : 0;
+        g_cufft_available = a;
+    }
+    return a;
+}
+
+static cufftType cufft_type(vv_dsp_fft_type type) {
+    return type == VV_DSP_FFT_R2C ? CUFFT_T_R2C : (type == VV_DSP_FFT_C2R ? CUFFT_T_C2R : CUFFT_T_C2C);
+}
+
+static cufftResult cufft_exec(cufftHandle plan, vv_dsp_fft_type type, vv_dsp_fft_dir dir, void* din, void* dout) {
+#ifdef VV_DSP_USE_DOUBLE
+    switch (type) {
+        case VV_DSP_FFT_R2C: return cufftExecD2Z(plan, (cufftDoubleReal*)din, (cufftDoubleComplex*)dout);
+        case VV_DSP_FFT_C2R: return cufftExecZ2D(plan, (cufftDoubleComplex*)din, (cufftDoubleReal*)dout);
+        default:
+            return cufftExecZ2Z(plan, (cufftDoubleComplex*)din, (cufftDoubleComplex*)dout,
+                                dir == VV_DSP_FFT_FORWARD ? CUFFT_FORWARD : CUFFT_INVERSE);
+    }
+#else
+    switch (type) {
+        case VV_DSP_FFT_R2C: return cufftExecR2C(plan, (cufftReal*)din, (cufftComplex*)dout);
+        case VV_DSP_FFT_C2R: return cufftExecC2R(plan, (cufftComplex*)din, (cufftReal*)dout);
+        default:
+            return cufftExecC2C(plan, (cufftComplex*)din, (cufftComplex*)dout,
+                                dir == VV_DSP_FFT_FORWARD ? CUFFT_FORWARD : CUFFT_INVERSE);
+    }
+#endif
+}
+
+// cuFFT plan wrapper. `single` transforms one contiguous vector (vv_dsp_fft_execute);
+// `many` the plan's whole batch geometry, and only exists for batch plans.
+typedef struct {
+    cufftHandle single;
+    cufftHandle many;
+    int has_single, has_many;
+    cudaStream_t stream;
+    void* d_in;                 // device spans of the batch geometry
+    void* d_out;
+    void* h_in;                 // pinned staging of the same spans
+    void* h_out;
+    size_t in_len, out_len;     // elements per vector
+    size_t in_elem, out_elem;   // bytes per element
+    size_t in_span, out_span;   // elements from the first to the last addressed one
+} cufft_plan_wrapper;
+
+static void cufft_free_plan(void* backend_data) {
+    if (!backend_data) return;
+    cufft_plan_wrapper* w = (cufft_plan_wrapper*)backend_data;
+    if (w->stream) (void)cudaStreamSynchronize(w->stream);
+    if (w->has_single) (void)cufftDestroy(w->single);
+    if (w->has_many) (void)cufftDestroy(w->many);
+    if (w->stream) (void)cudaStreamDestroy(w->stream);
+    (void)cudaFree(w->d_in);
+    (void)cudaFree(w->d_out);
+    (void)cudaFreeHost(w->h_in);
+    (void)cudaFreeHost(w->h_out);
+    vv_dsp_free(w);
+}
+
+static vv_dsp_status cufft_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
+    if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
+    if (spec->n > INT_MAX || spec->howmany > INT_MAX || spec->istride > INT_MAX || spec->idist > INT_MAX ||
+        spec->ostride > INT_MAX || spec->odist > INT_MAX) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    if (!cufft_is_available()) return VV_DSP_ERROR_UNSUPPORTED;
+
+    cufft_plan_wrapper* w = (cufft_plan_wrapper*)vv_dsp_calloc(1, sizeof(cufft_plan_wrapper));
+    if (!w) return VV_DSP_ERROR_INTERNAL;
+    const size_t nh = spec->n / 2 + 1;
+    w->in_len = spec->type == VV_DSP_FFT_C2R ? nh : spec->n;
+    w->out_len = spec->type == VV_DSP_FFT_R2C ? nh : spec->n;
+    w->in_elem = spec->type == VV_DSP_FFT_R2C ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx);
+    w->out_elem = spec->type == VV_DSP_FFT_C2R ? sizeof(vv_dsp_real) : sizeof(vv_dsp_cpx);
+    w->in_span = (spec->howmany - 1) * spec->idist + (w->in_len - 1) * spec->istride + 1;
+    w->out_span = (spec->howmany - 1) * spec->odist + (w->out_len - 1) * spec->ostride + 1;
+    if (w->in_span < w->in_len) w->in_span = w->in_len;
+    if (w->out_span < w->out_len) w->out_span = w->out_len;
+
+    int n = (int)spec->n;
+    const cufftType type = cufft_type(spec->type);
+    int ok = cudaStreamCreateWithFlags(&w->stream, cudaStreamNonBlocking) == cudaSuccess;
+    ok = ok && cufftPlan1d(&w->single, n, type, 1) == CUFFT_SUCCESS;
+    w->has_single = ok;
+    ok = ok && cufftSetStream(w->single, w->stream) == CUFFT_SUCCESS;
+    if (ok && (spec->howmany > 1 || spec->istride != 1 || spec->ostride != 1)) {
+        // inembed / onembed only switch on the advanced layout for rank 1
+        int inembed = (int)w->in_span, onembed = (int)w->out_span;
+        ok = cufftPlanMany(&w->many, 1, &n, &inembed, (int)spec->istride, (int)spec->idist, &onembed,
+                           (int)spec->ostride, (int)spec->odist, type, (int)spec->howmany) == CUFFT_SUCCESS;
+        w->has_many = ok;
+        ok = ok && cufftSetStream(w->many, w->stream) == CUFFT_SUCCESS;
+    }
+    ok = ok && cudaMalloc(&w->d_in, w->in_span * w->in_elem) == cudaSuccess &&
+         cudaMalloc(&w->d_out, w->out_span * w->out_elem) == cudaSuccess &&
+         cudaMallocHost(&w->h_in, w->in_span * w->in_elem) == cudaSuccess &&
+         cudaMallocHost(&w->h_out, w->out_span * w->out_elem) == cudaSuccess;
+    if (!ok) {
+        cufft_free_plan(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *backend_data = w;
+    return VV_DSP_OK;
+}
+
+// Copy `count` vectors of `len` elements between layouts (stride, dist) and packed
+// staging laid out the same way; contiguous geometry is one memcpy
+static void cufft_copy(unsigned char* dst, const unsigned char* src, size_t count, size_t len, size_t stride,
+                       size_t dist, size_t elem) {
+    if (stride == 1 && (count == 1 || dist == len)) {
+        memcpy(dst, src, count * len * elem);
+        return;
+    }
+    for (size_t j = 0; j < count; ++j) {
+        for (size_t i = 0; i < len; ++i) {
+            const size_t off = (j * dist + i * stride) * elem;
+            memcpy(dst + off, src + off, elem);
+        }
+    }
+}
+
+// count = 1 with unit stride runs `single`, anything else the batch plan
+static vv_dsp_status cufft_run(const struct vv_dsp_fft_plan* spec, cufft_plan_wrapper* w, const void* in,
+                               void* out, int batch) {
+    const size_t count = batch ? spec->howmany : 1;
+    const size_t is = batch ? spec->istride : 1, os = batch ? spec->ostride : 1;
+    const size_t id = batch ? spec->idist : w->in_len, od = batch ? spec->odist : w->out_len;
+    const size_t in_bytes = (batch ? w->in_span : w->in_len) * w->in_elem;
+    const size_t out_bytes = (batch ? w->out_span : w->out_len) * w->out_elem;
+    const cufftHandle plan = (batch && w->has_many) ? w->many : w->single;
+
+    cufft_copy((unsigned char*)w->h_in, (const unsigned char*)in, count, w->in_len, is, id, w->in_elem);
+    int ok = cudaMemcpyAsync(w->d_in, w->h_in, in_bytes, cudaMemcpyHostToDevice, w->stream) == cudaSuccess;
+    ok = ok && cufft_exec(plan, spec->type, spec->dir, w->d_in, w->d_out) == CUFFT_SUCCESS;
+    // Backward transforms are scaled by 1/n, as on every other backend
+    if (ok && (spec->type == VV_DSP_FFT_C2R || (spec->type == VV_DSP_FFT_C2C && spec->dir == VV_DSP_FFT_BACKWARD))) {
+        ok = vv_cufft_scale((vv_dsp_real*)w->d_out, out_bytes / sizeof(vv_dsp_real),
+                            (vv_dsp_real)1.0 / (vv_dsp_real)spec->n, w->stream) == cudaSuccess;
+    }
+    ok = ok && cudaMemcpyAsync(w->h_out, w->d_out, out_bytes, cudaMemcpyDeviceToHost, w->stream) == cudaSuccess;
+    ok = (cudaStreamSynchronize(w->stream) == cudaSuccess) && ok;
+    if (!ok) return VV_DSP_ERROR_INTERNAL;
+    // Only addressed elements are written, so gaps in the caller's buffer stay untouched
+    cufft_copy((unsigned char*)out, (const unsigned char*)w->h_out, count, w->out_len, os, od, w->out_elem);
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status cufft_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in,
+                                   void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    return cufft_run(spec, (cufft_plan_wrapper*)backend_data, in, out, 0);
+}
+
+static vv_dsp_status cufft_execute_many(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in,
+                                        void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    return cufft_run(spec, (cufft_plan_wrapper*)backend_data, in, out, 1);
+}
+
+const vv_dsp_fft_backend_vtable vv_dsp_fft_cufft_vtable = {
+    .make_plan = cufft_make_plan,
+    .execute = cufft_execute,
+    .free_plan = cufft_free_plan,
+    .execute_many = cufft_execute_many,
+    .is_available = cufft_is_available,
+    .name = "cuFFT"
+};
+
+// --------------- Device spectrogram ---------------
+
+// Frames per device batch: about 8 MiB of windowed frames, at most 1024
+#define CUFFT_SPEC_BATCH_BYTES (8u * 1024u * 1024u)
+#define CUFFT_SPEC_MAX_CHUNK 1024u
+// Chunks in flight: one computing while the other one downloads
+#define CUFFT_SPEC_SLOTS 2
+
+typedef struct {
+    cudaStream_t stream;
+    cufftHandle plan;            // R2C over `chunk` frames
+    int has_plan;
+    vv_dsp_real* d_frames;       // chunk x nfft
+    vv_dsp_cpx* d_spec;          // chunk x nh
+    vv_dsp_real* d_rows;         // chunk x row_cap
+    vv_dsp_real* h_rows;         // pinned copy of d_rows
+    size_t row_cap;
+    size_t f0, count;            // chunk in flight, count = 0 when idle
+} cufft_spec_slot;
+
+struct vv_dsp_cufft_spectrogram {
+    const vv_dsp_real* win_src;  // host window the device copy was made from
+    size_t nfft, hop, chunk;
+    vv_dsp_real* d_win;
+    vv_dsp_real* d_signal;
+    size_t signal_cap;
+    vv_dsp_real* d_mel;
+    size_t mel_cap;
+    cudaEvent_t uploaded;
+    int has_event;
+    cufft_spec_slot slot[CUFFT_SPEC_SLOTS];
+};
+
+void vv_dsp_cufft_spectrogram_free(vv_dsp_cufft_spectrogram* st) {
+    if (!st) return;
+    for (int i = 0; i < CUFFT_SPEC_SLOTS; ++i) {
+        cufft_spec_slot* s = &st->slot[i];
+        if (s->stream) (void)cudaStreamSynchronize(s->stream);
+        if (s->has_plan) (void)cufftDestroy(s->plan);
+        if (s->stream) (void)cudaStreamDestroy(s->stream);
+        (void)cudaFree(s->d_frames);
+        (void)cudaFree(s->d_spec);
+        (void)cudaFree(s->d_rows);
+        (void)cudaFreeHost(s->h_rows);
+    }
+    if (st->has_event) (void)cudaEventDestroy(st->uploaded);
+    (void)cudaFree(st->d_win);
+    (void)cudaFree(st->d_signal);
+    (void)cudaFree(st->d_mel);
+    vv_dsp_free(st);
+}
+
+static vv_dsp_cufft_spectrogram* cufft_spec_create(const vv_dsp_real* win, size_t nfft, size_t hop) {
+    vv_dsp_cufft_spectrogram* st = (vv_dsp_cufft_spectrogram*)vv_dsp_calloc(1, sizeof(*st));
+    if (!st) return NULL;
+    st->win_src = win;
+    st->nfft = nfft;
+    st->hop = hop;
+    size_t chunk = CUFFT_SPEC_BATCH_BYTES / (nfft * sizeof(vv_dsp_real));
+    st->chunk = chunk == 0 ? 1 : (chunk > CUFFT_SPEC_MAX_CHUNK ? CUFFT_SPEC_MAX_CHUNK : chunk);
+    const size_t nh = nfft / 2 + 1;
+    int ok = cudaMalloc((void**)&st->d_win, nfft * sizeof(vv_dsp_real)) == cudaSuccess &&
+             cudaMemcpy(st->d_win, win, nfft * sizeof(vv_dsp_real), cudaMemcpyHostToDevice) == cudaSuccess &&
+             cudaEventCreateWithFlags(&st->uploaded, cudaEventDisableTiming) == cudaSuccess;
+    st->has_event = ok;
+    for (int i = 0; ok && i < CUFFT_SPEC_SLOTS; ++i) {
+        cufft_spec_slot* s = &st->slot[i];
+        int n = (int)nfft;
+        ok = cudaStreamCreateWithFlags(&s->stream, cudaStreamNonBlocking) == cudaSuccess &&
+             cufftPlanMany(&s->plan, 1, &n, NULL, 1, n, NULL, 1, (int)nh, CUFFT_T_R2C, (int)st->chunk) ==
+                 CUFFT_SUCCESS;
+        s->has_plan = ok;
+        ok = ok && cufftSetStream(s->plan, s->stream) == CUFFT_SUCCESS &&
+             cudaMalloc((void**)&s->d_frames, st->chunk * nfft * sizeof(vv_dsp_real)) == cudaSuccess &&
+             cudaMalloc((void**)&s->d_spec, st->chunk * nh * sizeof(vv_dsp_cpx)) == cudaSuccess;
+    }
+    if (!ok) {
+        vv_dsp_cufft_spectrogram_free(st);
+        return NULL;
+    }
+    return st;
+}
+
+// Grow a device buffer to cap elements; contents are not kept
+static int cufft_reserve(vv_dsp_real** d, size_t* cap, size_t want) {
+    if (want <= *cap) return 1;
+    (void)cudaFree(*d);
+    *d = NULL;
+    *cap = 0;
+    if (cudaMalloc((void**)d, want * sizeof(vv_dsp_real)) != cudaSuccess) {
+        *d = NULL;
+        return 0;
+    }
+    *cap = want;
+    return 1;
+}
+
+static int cufft_reserve_rows(vv_dsp_cufft_spectrogram* st, cufft_spec_slot* s, size_t width) {
+    if (width <= s->row_cap) return 1;
+    (void)cudaFree(s->d_rows);
+    (void)cudaFreeHost(s->h_rows);
+    s->d_rows = NULL;
+    s->h_rows = NULL;
+    s->row_cap = 0;
+    if (cudaMalloc((void**)&s->d_rows, st->chunk * width * sizeof(vv_dsp_real)) != cudaSuccess ||
+        cudaMallocHost((void**)&s->h_rows, st->chunk * width * sizeof(vv_dsp_real)) != cudaSuccess) {
+        return 0;
+    }
+    s->row_cap = width;
+    return 1;
+}
+
+// Wait for a slot's download and copy its rows out of pinned memory
+static int cufft_spec_drain(cufft_spec_slot* s, size_t width, vv_dsp_real* out) {
+    if (!s->count) return 1;
+    const int ok = cudaStreamSynchronize(s->stream) == cudaSuccess;
+    if (ok) memcpy(out + s->f0 * width, s->h_rows, s->count * width * sizeof(vv_dsp_real));
+    s->count = 0;
+    return ok;
+}
+
+vv_dsp_status vv_dsp_cufft_spectrogram_run(vv_dsp_cufft_spectrogram** state, const vv_dsp_real* win,
+                                           size_t nfft, size_t hop, int full,
+                                           const vv_dsp_real* signal, size_t n, size_t frames,
+                                           int scale, vv_dsp_real floor_v,
+                                           const vv_dsp_real* mel, size_t n_mels, vv_dsp_real* out) {
+    if (!state || !win || !signal || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t nh = nfft / 2 + 1;
+    if (nfft > INT_MAX || nh * sizeof(vv_dsp_real) > VV_CUFFT_ROWS_SMEM_MAX) return VV_DSP_ERROR_UNSUPPORTED;
+    if (!cufft_is_available()) return VV_DSP_ERROR_UNSUPPORTED;
+    vv_dsp_cufft_spectrogram* st = *state;
+    if (st && (st->win_src != win || st->nfft != nfft || st->hop != hop)) {
+        vv_dsp_cufft_spectrogram_free(st);
+        st = *state = NULL;
+    }
+    if (!st) {
+        st = *state = cufft_spec_create(win, nfft, hop);
+        if (!st) return VV_DSP_ERROR_UNSUPPORTED;
+    }
+
+    const size_t width = mel ? n_mels : (full ? nfft : nh);
+    int ok = cufft_reserve(&st->d_signal, &st->signal_cap, n ? n : 1) &&
+             (!mel || cufft_reserve(&st->d_mel, &st->mel_cap, n_mels * nh));
+    for (int i = 0; ok && i < CUFFT_SPEC_SLOTS; ++i) ok = cufft_reserve_rows(st, &st->slot[i], width);
+    if (!ok) return VV_DSP_ERROR_INTERNAL;
+
+    // One upload of the signal and the weights; both streams wait for it
+    cudaStream_t up = st->slot[0].stream;
+    ok = (!n || cudaMemcpyAsync(st->d_signal, signal, n * sizeof(vv_dsp_real), cudaMemcpyHostToDevice, up) ==
+                    cudaSuccess) &&
+         (!mel || cudaMemcpyAsync(st->d_mel, mel, n_mels * nh * sizeof(vv_dsp_real), cudaMemcpyHostToDevice, up) ==
+                      cudaSuccess) &&
+         cudaEventRecord(st->uploaded, up) == cudaSuccess;
+    for (int i = 1; ok && i < CUFFT_SPEC_SLOTS; ++i) {
+        ok = cudaStreamWaitEvent(st->slot[i].stream, st->uploaded, 0) == cudaSuccess;
+    }
+
+    size_t c = 0;
+    for (size_t f0 = 0; ok && f0 < frames; f0 += st->chunk, ++c) {
+        cufft_spec_slot* s = &st->slot[c % CUFFT_SPEC_SLOTS];
+        // The slot's previous chunk finishes downloading while the other slot computes
+        ok = cufft_spec_drain(s, width, out);
+        const size_t count = frames - f0 < st->chunk ? frames - f0 : st->chunk;
+        ok = ok &&
+             vv_cufft_frames(st->d_signal, n, st->d_win, nfft, hop, f0, count, s->d_frames, s->stream) == cudaSuccess;
+        // The plan transforms the full chunk; rows past count are never read
+        ok = ok && cufft_exec(s->plan, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, s->d_frames, s->d_spec) == CUFFT_SUCCESS;
+        ok = ok && vv_cufft_rows(s->d_spec, nh, count, scale, floor_v, mel ? st->d_mel : NULL, n_mels, width, nfft,
+                                 s->d_rows, s->stream) == cudaSuccess;
+        ok = ok && cudaMemcpyAsync(s->h_rows, s->d_rows, count * width * sizeof(vv_dsp_real),
+                                   cudaMemcpyDeviceToHost, s->stream) == cudaSuccess;
+        if (ok) {
+            s->f0 = f0;
+            s->count = count;
+        }
+    }
+    for (int i = 0; i < CUFFT_SPEC_SLOTS; ++i) {
+        if (!cufft_spec_drain(&st->slot[i], width, out)) ok = 0;
+    }
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+#else
+
+// cuFFT not available: STFT keeps its host path
+void vv_dsp_cufft_spectrogram_free(vv_dsp_cufft_spectrogram* state) {
+    (void)state;
+}
+
+vv_dsp_status vv_dsp_cufft_spectrogram_run(vv_dsp_cufft_spectrogram** state, const vv_dsp_real* win,
+                                           size_t nfft, size_t hop, int full,
+                                           const vv_dsp_real* signal, size_t n, size_t frames,
+                                           int scale, vv_dsp_real floor_v,
+                                           const vv_dsp_real* mel, size_t n_mels, vv_dsp_real* out) {
+    (void)state; (void)win; (void)nfft; (void)hop; (void)full; (void)signal; (void)n; (void)frames;
+    (void)scale; (void)floor_v; (void)mel; (void)n_mels; (void)out;
+    return VV_DSP_ERROR_UNSUPPORTED;
+}
+
+#endif // VV_DSP_BACKEND_FFT_cufft
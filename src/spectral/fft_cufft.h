@@ -0,0 +1,52 @@
+/*
+This file is part of vv-dsp
+
+Private interface between the host side of the cuFFT backend (fft_cufft.c) and
+its device kernels (fft_cufft_kernels.cu). Only compiled with CUDA.
+*/
+
+#ifndef VV_DSP_INTERNAL_FFT_CUFFT_H
+#define VV_DSP_INTERNAL_FFT_CUFFT_H
+
+#include <stddef.h>
+#include <cuda_runtime_api.h>
+#include "vv_dsp/vv_dsp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// vv_dsp_spectrogram_scale values, repeated here so the kernels need no STFT header
+enum {
+    VV_CUFFT_MAGNITUDE = 0,
+    VV_CUFFT_POWER = 1,
+    VV_CUFFT_LOG = 2,
+    VV_CUFFT_LOG1P = 3,
+    VV_CUFFT_DB = 4
+};
+
+// The row kernel keeps one frame's |X| or |X|^2 (nfft/2+1 values) in shared memory
+#define VV_CUFFT_ROWS_SMEM_MAX (48u * 1024u)
+
+// Launchers; each enqueues on stream and returns the launch error
+
+// d[i] *= s for i < count (backward transforms are scaled by 1/n like the host backends)
+cudaError_t vv_cufft_scale(vv_dsp_real* d, size_t count, vv_dsp_real s, cudaStream_t stream);
+
+// Frames f0..f0+count-1 of the device signal, windowed: frames[j*nfft + i] =
+// sig[(f0+j)*hop + i] * win[i], zero past the end of the signal
+cudaError_t vv_cufft_frames(const vv_dsp_real* sig, size_t n, const vv_dsp_real* win, size_t nfft, size_t hop,
+                            size_t f0, size_t count, vv_dsp_real* frames, cudaStream_t stream);
+
+// Spectrogram rows of count R2C spectra (nh bins each): |X| or |X|^2, optional mel
+// projection (n_mels x nh weights), then the log / dB step. width is the row pitch;
+// without mel, columns past nh (FULL layout) mirror the Hermitian half.
+cudaError_t vv_cufft_rows(const vv_dsp_cpx* spec, size_t nh, size_t count, int scale, vv_dsp_real floor_v,
+                          const vv_dsp_real* mel, size_t n_mels, size_t width, size_t nfft, vv_dsp_real* rows,
+                          cudaStream_t stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VV_DSP_INTERNAL_FFT_CUFFT_H */
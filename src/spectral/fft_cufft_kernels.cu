@@ -0,0 +1,95 @@
+/*
+This file is part of vv-dsp
+
+Device kernels of the cuFFT backend: backward-transform scaling, framing with
+the analysis window, and the fused spectrogram row transform (magnitude or
+power, mel projection, log / dB) so that only finished rows leave the device.
+*/
+
+#include <cuda_runtime.h>
+#include "fft_cufft.h"
+
+#define CUFFT_THREADS 256
+// Grid-stride loops cover any count with at most this many blocks
+#define CUFFT_MAX_BLOCKS 4096
+
+static unsigned int grid_for(size_t count) {
+    const size_t blocks = (count + CUFFT_THREADS - 1) / CUFFT_THREADS;
+    return (unsigned int)(blocks < CUFFT_MAX_BLOCKS ? (blocks ? blocks : 1) : CUFFT_MAX_BLOCKS);
+}
+
+__global__ static void scale_kernel(vv_dsp_real* d, size_t count, vv_dsp_real s) {
+    for (size_t i = blockIdx.x * (size_t)blockDim.x + threadIdx.x; i < count; i += (size_t)gridDim.x * blockDim.x) {
+        d[i] *= s;
+    }
+}
+
+__global__ static void frames_kernel(const vv_dsp_real* sig, size_t n, const vv_dsp_real* win, size_t nfft,
+                                     size_t hop, size_t f0, size_t total, vv_dsp_real* frames) {
+    for (size_t idx = blockIdx.x * (size_t)blockDim.x + threadIdx.x; idx < total;
+         idx += (size_t)gridDim.x * blockDim.x) {
+        const size_t j = idx / nfft, i = idx - j * nfft;
+        const size_t src = (f0 + j) * hop + i;
+        frames[idx] = src < n ? sig[src] * win[i] : (vv_dsp_real)0;
+    }
+}
+
+__device__ static vv_dsp_real row_post(int scale, vv_dsp_real v, vv_dsp_real floor_v) {
+    switch (scale) {
+        case VV_CUFFT_LOG: return log(v + floor_v);
+        case VV_CUFFT_LOG1P: return log((vv_dsp_real)1 + v);
+        case VV_CUFFT_DB: return (vv_dsp_real)(10.0 / 2.302585092994045684) * log(v > floor_v ? v : floor_v);
+        default: return v;
+    }
+}
+
+// One block per frame: the frame's base quantity goes to shared memory once, then
+// every output column (mel band or bin) is produced from it
+__global__ static void rows_kernel(const vv_dsp_cpx* spec, size_t nh, int scale, vv_dsp_real floor_v,
+                                   const vv_dsp_real* mel, size_t n_mels, size_t width, size_t nfft,
+                                   vv_dsp_real* rows) {
+    extern __shared__ unsigned char smem[];
+    vv_dsp_real* base = (vv_dsp_real*)smem;
+    const vv_dsp_cpx* x = spec + (size_t)blockIdx.x * nh;
+    for (size_t k = threadIdx.x; k < nh; k += blockDim.x) {
+        const vv_dsp_real p = x[k].re * x[k].re + x[k].im * x[k].im;
+        base[k] = scale == VV_CUFFT_MAGNITUDE ? sqrt(p) : p;
+    }
+    __syncthreads();
+    vv_dsp_real* row = rows + (size_t)blockIdx.x * width;
+    if (mel) {
+        for (size_t m = threadIdx.x; m < n_mels; m += blockDim.x) {
+            const vv_dsp_real* w = mel + m * nh;
+            vv_dsp_real acc = 0;
+            for (size_t k = 0; k < nh; ++k) acc += w[k] * base[k];
+            row[m] = row_post(scale, acc, floor_v);
+        }
+    } else {
+        for (size_t k = threadIdx.x; k < width; k += blockDim.x) {
+            row[k] = row_post(scale, base[k < nh ? k : nfft - k], floor_v);
+        }
+    }
+}
+
+extern "C" cudaError_t vv_cufft_scale(vv_dsp_real* d, size_t count, vv_dsp_real s, cudaStream_t stream) {
+    scale_kernel<<<grid_for(count), CUFFT_THREADS, 0, stream>>>(d, count, s);
+    return cudaGetLastError();
+}
+
+extern "C" cudaError_t vv_cufft_frames(const vv_dsp_real* sig, size_t n, const vv_dsp_real* win, size_t nfft,
+                                       size_t hop, size_t f0, size_t count, vv_dsp_real* frames,
+                                       cudaStream_t stream) {
+    const size_t total = count * nfft;
+    frames_kernel<<<grid_for(total), CUFFT_THREADS, 0, stream>>>(sig, n, win, nfft, hop, f0, total, frames);
+    return cudaGetLastError();
+}
+
+extern "C" cudaError_t vv_cufft_rows(const vv_dsp_cpx* spec, size_t nh, size_t count, int scale,
+                                     vv_dsp_real floor_v, const vv_dsp_real* mel, size_t n_mels, size_t width,
+                                     size_t nfft, vv_dsp_real* rows, cudaStream_t stream) {
+    const size_t smem = nh * sizeof(vv_dsp_real);
+    if (smem > VV_CUFFT_ROWS_SMEM_MAX) return cudaErrorInvalidValue;
+    rows_kernel<<<(unsigned int)count, CUFFT_THREADS, smem, stream>>>(spec, nh, scale, floor_v, mel, n_mels, width,
+                                                                      nfft, rows);
+    return cudaGetLastError();
+}
@@ -15,6 +15,7 @@ into the vv-dsp FFT system, supporting complex-to-complex and real FFT transform
 #include <stdlib.h>
 #include <string.h>
 #include <ffts.h>
+#include "vv_dsp/core/alloc.h"
 
 // FFTS plan wrapper structure
 typedef struct {
@@ -23,21 +24,25 @@ typedef struct {
     vv_dsp_fft_type type;
     vv_dsp_fft_dir dir;
 
-    // Temporary buffers for R2C/C2R transforms
+    // Staging buffers for R2C/C2R transforms (full-length complex in and out)
     float* temp_buffer;
+    float* temp_out;
     size_t temp_size;
 } ffts_plan_wrapper;
 
+#define FFTS_WS_ALIGN 32  // FFTS kernels use aligned SIMD loads
+
 static vv_dsp_status ffts_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
     if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
 
-    ffts_plan_wrapper* wrapper = (ffts_plan_wrapper*)malloc(sizeof(ffts_plan_wrapper));
+    ffts_plan_wrapper* wrapper = (ffts_plan_wrapper*)vv_dsp_malloc(sizeof(ffts_plan_wrapper));
     if (!wrapper) return VV_DSP_ERROR_INTERNAL;
 
     wrapper->n = spec->n;
     wrapper->type = spec->type;
     wrapper->dir = spec->dir;
     wrapper->temp_buffer = NULL;
+    wrapper->temp_out = NULL;
     wrapper->temp_size = 0;
 
     // FFTS uses -1 for forward, +1 for backward (opposite of our convention)
@@ -47,7 +52,7 @@ static vv_dsp_status ffts_make_plan(const struct vv_dsp_fft_plan* spec, void** b
         // Complex-to-complex transform
         wrapper->plan = ffts_init_1d(spec->n, ffts_sign);
         if (!wrapper->plan) {
-            free(wrapper);
+            vv_dsp_free(wrapper);
             return VV_DSP_ERROR_INTERNAL;
         }
     } else if (spec->type == VV_DSP_FFT_R2C) {
@@ -55,36 +60,42 @@ static vv_dsp_status ffts_make_plan(const struct vv_dsp_fft_plan* spec, void** b
         // We'll create a complex plan and handle R2C manually
         wrapper->plan = ffts_init_1d(spec->n, -1); // Always forward for R2C
         if (!wrapper->plan) {
-            free(wrapper);
+            vv_dsp_free(wrapper);
             return VV_DSP_ERROR_INTERNAL;
         }
 
         // Allocate temporary buffer for complex input
         wrapper->temp_size = spec->n * 2; // Complex numbers (re,im pairs)
-        wrapper->temp_buffer = (float*)malloc(wrapper->temp_size * sizeof(float));
-        if (!wrapper->temp_buffer) {
+        wrapper->temp_buffer = (float*)vv_dsp_malloc(wrapper->temp_size * sizeof(float));
+        wrapper->temp_out = (float*)vv_dsp_malloc(wrapper->temp_size * sizeof(float));
+        if (!wrapper->temp_buffer || !wrapper->temp_out) {
+            vv_dsp_free(wrapper->temp_buffer);
+            vv_dsp_free(wrapper->temp_out);
             ffts_free(wrapper->plan);
-            free(wrapper);
+            vv_dsp_free(wrapper);
             return VV_DSP_ERROR_INTERNAL;
         }
     } else if (spec->type == VV_DSP_FFT_C2R) {
         // Complex-to-real: use complex FFT with complex input
         wrapper->plan = ffts_init_1d(spec->n, 1); // Always backward for C2R
         if (!wrapper->plan) {
-            free(wrapper);
+            vv_dsp_free(wrapper);
             return VV_DSP_ERROR_INTERNAL;
         }
 
         // Allocate temporary buffer for full complex spectrum
         wrapper->temp_size = spec->n * 2; // Complex numbers (re,im pairs)
-        wrapper->temp_buffer = (float*)malloc(wrapper->temp_size * sizeof(float));
-        if (!wrapper->temp_buffer) {
+        wrapper->temp_buffer = (float*)vv_dsp_malloc(wrapper->temp_size * sizeof(float));
+        wrapper->temp_out = (float*)vv_dsp_malloc(wrapper->temp_size * sizeof(float));
+        if (!wrapper->temp_buffer || !wrapper->temp_out) {
+            vv_dsp_free(wrapper->temp_buffer);
+            vv_dsp_free(wrapper->temp_out);
             ffts_free(wrapper->plan);
-            free(wrapper);
+            vv_dsp_free(wrapper);
             return VV_DSP_ERROR_INTERNAL;
         }
     } else {
-        free(wrapper);
+        vv_dsp_free(wrapper);
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
 
@@ -92,11 +103,9 @@ static vv_dsp_status ffts_make_plan(const struct vv_dsp_fft_plan* spec, void** b
     return VV_DSP_OK;
 }
 
-static vv_dsp_status ffts_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
-    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
-
-    ffts_plan_wrapper* wrapper = (ffts_plan_wrapper*)backend_data;
-
+// temp_in/temp_out: 2*n floats each (unused for C2C)
+static vv_dsp_status ffts_exec_impl(const struct vv_dsp_fft_plan* spec, const ffts_plan_wrapper* wrapper,
+                                    const void* in, void* out, float* temp_in, float* temp_out) {
     if (spec->type == VV_DSP_FFT_C2C) {
         // Direct complex-to-complex execution
         // FFTS expects interleaved float arrays [re0,im0,re1,im1,...]
@@ -109,15 +118,12 @@ static vv_dsp_status ffts_execute(const struct vv_dsp_fft_plan* spec, void* back
 
         // Convert real input to complex (zero imaginary parts)
         for (size_t i = 0; i < spec->n; ++i) {
-            wrapper->temp_buffer[2*i] = (float)real_in[i];     // Real part
-            wrapper->temp_buffer[2*i+1] = 0.0f;               // Imaginary part
+            temp_in[2*i] = (float)real_in[i];     // Real part
+            temp_in[2*i+1] = 0.0f;               // Imaginary part
         }
 
         // Execute FFT
-        float* temp_out = (float*)malloc(spec->n * 2 * sizeof(float));
-        if (!temp_out) return VV_DSP_ERROR_INTERNAL;
-
-        ffts_execute(wrapper->plan, wrapper->temp_buffer, temp_out);
+        ffts_execute(wrapper->plan, temp_in, temp_out);
 
         // Extract Hermitian-packed output (first n/2+1 complex values)
         size_t nh = spec->n/2 + 1;
@@ -126,7 +132,6 @@ static vv_dsp_status ffts_execute(const struct vv_dsp_fft_plan* spec, void* back
             cpx_out[i].im = (vv_dsp_real)temp_out[2*i+1];
         }
 
-        free(temp_out);
         return VV_DSP_OK;
     } else if (spec->type == VV_DSP_FFT_C2R) {
         // Complex-to-real: expand Hermitian input to full spectrum, execute, extract real
@@ -137,24 +142,21 @@ static vv_dsp_status ffts_execute(const struct vv_dsp_fft_plan* spec, void* back
         // Expand Hermitian-packed input to full complex spectrum
         // k=0..nh-1: copy directly
         for (size_t k = 0; k < nh; ++k) {
-            wrapper->temp_buffer[2*k] = (float)cpx_in[k].re;
-            wrapper->temp_buffer[2*k+1] = (float)cpx_in[k].im;
+            temp_in[2*k] = (float)cpx_in[k].re;
+            temp_in[2*k+1] = (float)cpx_in[k].im;
         }
 
         // k=nh..n-1: conjugate symmetry
         for (size_t k = nh; k < spec->n; ++k) {
             size_t mirror_idx = spec->n - k;
             if (mirror_idx < nh) {
-                wrapper->temp_buffer[2*k] = (float)cpx_in[mirror_idx].re;    // Real part
-                wrapper->temp_buffer[2*k+1] = -(float)cpx_in[mirror_idx].im; // Conjugate imaginary
+                temp_in[2*k] = (float)cpx_in[mirror_idx].re;    // Real part
+                temp_in[2*k+1] = -(float)cpx_in[mirror_idx].im; // Conjugate imaginary
             }
         }
 
         // Execute inverse FFT
-        float* temp_out = (float*)malloc(spec->n * 2 * sizeof(float));
-        if (!temp_out) return VV_DSP_ERROR_INTERNAL;
-
-        ffts_execute(wrapper->plan, wrapper->temp_buffer, temp_out);
+        ffts_execute(wrapper->plan, temp_in, temp_out);
 
         // Extract real parts and apply 1/n scaling (FFTS doesn't scale)
         vv_dsp_real scale = (vv_dsp_real)1.0 / (vv_dsp_real)spec->n;
@@ -162,13 +164,39 @@ static vv_dsp_status ffts_execute(const struct vv_dsp_fft_plan* spec, void* back
             real_out[i] = (vv_dsp_real)temp_out[2*i] * scale;
         }
 
-        free(temp_out);
         return VV_DSP_OK;
     }
 
     return VV_DSP_ERROR_OUT_OF_RANGE;
 }
 
+static vv_dsp_status vv_dsp_ffts_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    ffts_plan_wrapper* wrapper = (ffts_plan_wrapper*)backend_data;
+    return ffts_exec_impl(spec, wrapper, in, out, wrapper->temp_buffer, wrapper->temp_out);
+}
+
+static size_t ffts_workspace_size(const struct vv_dsp_fft_plan* spec, const void* backend_data) {
+    (void)backend_data;
+    if (spec->type == VV_DSP_FFT_C2C) return 0;
+    const size_t region = (spec->n * 2 * sizeof(float) + FFTS_WS_ALIGN - 1) / FFTS_WS_ALIGN * FFTS_WS_ALIGN;
+    return FFTS_WS_ALIGN + 2 * region;
+}
+
+static vv_dsp_status ffts_execute_ws(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                     const void* in, void* out, void* ws) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (spec->type == VV_DSP_FFT_C2C) {
+        return ffts_exec_impl(spec, (const ffts_plan_wrapper*)backend_data, in, out, NULL, NULL);
+    }
+    if (!ws) return VV_DSP_ERROR_NULL_POINTER;
+    unsigned char* base = (unsigned char*)ws;
+    base += (FFTS_WS_ALIGN - ((size_t)base % FFTS_WS_ALIGN)) % FFTS_WS_ALIGN;
+    const size_t region = (spec->n * 2 * sizeof(float) + FFTS_WS_ALIGN - 1) / FFTS_WS_ALIGN * FFTS_WS_ALIGN;
+    return ffts_exec_impl(spec, (const ffts_plan_wrapper*)backend_data, in, out,
+                          (float*)base, (float*)(base + region));
+}
+
 static void ffts_free_plan(void* backend_data) {
     if (!backend_data) return;
 
@@ -179,10 +207,14 @@ static void ffts_free_plan(void* backend_data) {
     }
 
     if (wrapper->temp_buffer) {
-        free(wrapper->temp_buffer);
+        vv_dsp_free(wrapper->temp_buffer);
+    }
+
+    if (wrapper->temp_out) {
+        vv_dsp_free(wrapper->temp_out);
     }
 
-    free(wrapper);
+    vv_dsp_free(wrapper);
 }
 
 static int ffts_is_available(void) {
@@ -192,8 +224,10 @@ static int ffts_is_available(void) {
 // FFTS vtable
 const vv_dsp_fft_backend_vtable vv_dsp_fft_ffts_vtable = {
     .make_plan = ffts_make_plan,
-    .execute = ffts_execute,
+    .execute = vv_dsp_ffts_execute,
     .free_plan = ffts_free_plan,
+    .workspace_size = ffts_workspace_size,
+    .execute_ws = ffts_execute_ws,
     .is_available = ffts_is_available,
     .name = "FFTS"
 };
@@ -12,48 +12,72 @@ sophisticated plan caching to optimize performance for repeated transforms.
 
 #ifdef VV_DSP_BACKEND_FFT_fftw
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 #include <fftw3.h>
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/simd_utils.h"
 
-// Global FFTW configuration
+// Global FFTW configuration. The FFTW planner (fftwf_plan_* and
+// fftwf_destroy_plan) is not thread-safe, so g_fftw_mutex serializes those
+// calls and nothing else; cache hits and execution never take it.
 static vv_dsp_fftw_flag g_fftw_planning_flag = VV_DSP_FFTW_MEASURE;
 static pthread_mutex_t g_fftw_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+#define FFTW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define FFTW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define FFTW_ADD(p, v) __atomic_add_fetch((p), (v), __ATOMIC_ACQ_REL)
+
+// Planning and work arrays come from the library allocator rather than
+// fftwf_malloc, which has no hooks; 64 bytes covers every alignment FFTW's
+// SIMD codelets check for.
+#define FFTW_BUF_ALIGN 64
+
+static float* fftw_buf_real(size_t n) {
+    return (float*)vv_dsp_aligned_malloc(n * sizeof(float), FFTW_BUF_ALIGN);
+}
+
+static fftwf_complex* fftw_buf_cpx(size_t n) {
+    return (fftwf_complex*)vv_dsp_aligned_malloc(n * sizeof(fftwf_complex), FFTW_BUF_ALIGN);
+}
+
 // Plan cache key structure
 typedef struct fftw_cache_key {
     size_t n;
     vv_dsp_fft_type type;
     vv_dsp_fft_dir dir;
     vv_dsp_fftw_flag flag;
+    size_t nthreads;
 } fftw_cache_key;
 
-// Plan cache entry structure
+// Plan cache entry. Entries are immutable once published: the FFTW plan is
+// only ever run through the new-array execute interface, so one plan serves
+// every wrapper (and thread) with matching key.
 typedef struct fftw_cache_entry {
     fftw_cache_key key;
-
-    // FFTW plans for different precision/types
-    union {
-        fftwf_plan complex_plan;  // For C2C transforms
-        fftwf_plan r2c_plan;      // For R2C transforms
-        fftwf_plan c2r_plan;      // For C2R transforms
-    } plan;
-
-    // Reference counting for safe deletion
-    int ref_count;
-
-    // Linked list pointers for cache management
-    struct fftw_cache_entry* next;
-    struct fftw_cache_entry* prev;
+    fftwf_plan plan;
+    int users;                       // live wrappers referencing this plan (atomic)
+    struct fftw_cache_entry* next;   // bucket chain, or retired list after a flush
 } fftw_cache_entry;
 
-// Global plan cache
+// Read-mostly hash table: buckets only grow, and new entries are published
+// with a release store, so lookups walk the chains without locking.
 #define FFTW_CACHE_SIZE 64
 static fftw_cache_entry* g_plan_cache[FFTW_CACHE_SIZE] = {NULL};
-static fftw_cache_entry* g_cache_lru_head = NULL;
-static fftw_cache_entry* g_cache_lru_tail = NULL;
-static size_t g_cache_count = 0;
+// Entries unpublished by a flush while still in use; destroyed by their last user
+static fftw_cache_entry* g_retired = NULL;
+// Bumped by every flush so that per-thread caches drop stale entries
+static unsigned g_cache_generation = 0;
+
+// Per-thread fast cache of recently used entries, checked before the table
+#if defined(__GNUC__) || defined(__clang__)
+#define FFTW_TLS_SLOTS 4
+static __thread fftw_cache_entry* t_recent[FFTW_TLS_SLOTS];
+static __thread unsigned t_recent_gen;
+static __thread unsigned t_recent_next;
+#endif
 
 // FFTW plan wrapper structure
 typedef struct {
@@ -62,10 +86,20 @@ typedef struct {
     vv_dsp_fft_type type;
     vv_dsp_fft_dir dir;
 
-    // Input/output buffers (FFTW-aligned)
+    // Input/output buffers (FFTW-aligned), private to this wrapper
     void* in_buffer;
     void* out_buffer;
     size_t buffer_size;
+
+    // Batched plan (fftwf_plan_many_dft*) for vv_dsp_fft_make_plan_many; NULL
+    // for single-vector plans. Not cached: batch geometry rarely repeats.
+    fftwf_plan many_plan;
+    void* many_in;
+    void* many_out;
+
+    // Guru split-array plan for vv_dsp_fft_execute_split, created on first
+    // use and published atomically; NULL until then
+    fftwf_plan split_plan;
 } fftw_plan_wrapper;
 
 // Hash function for cache key
@@ -74,158 +108,209 @@ static size_t hash_cache_key(const fftw_cache_key* key) {
     hash = hash * 31 + (size_t)key->type;
     hash = hash * 31 + (size_t)key->dir;
     hash = hash * 31 + (size_t)key->flag;
+    hash = hash * 31 + key->nthreads;
     return hash % FFTW_CACHE_SIZE;
 }
 
 // Compare cache keys
 static int keys_equal(const fftw_cache_key* a, const fftw_cache_key* b) {
-    return (a->n == b->n && a->type == b->type && a->dir == b->dir && a->flag == b->flag);
+    return (a->n == b->n && a->type == b->type && a->dir == b->dir && a->flag == b->flag &&
+            a->nthreads == b->nthreads);
 }
 
-// Move cache entry to front of LRU list
-static void move_to_front(fftw_cache_entry* entry) {
-    if (entry == g_cache_lru_head) return;
-
-    // Remove from current position
-    if (entry->prev) entry->prev->next = entry->next;
-    if (entry->next) entry->next->prev = entry->prev;
-    if (entry == g_cache_lru_tail) g_cache_lru_tail = entry->prev;
-
-    // Insert at head
-    entry->prev = NULL;
-    entry->next = g_cache_lru_head;
-    if (g_cache_lru_head) g_cache_lru_head->prev = entry;
-    g_cache_lru_head = entry;
-    if (!g_cache_lru_tail) g_cache_lru_tail = entry;
+// Called with g_fftw_mutex held before every planner call. Without
+// libfftw3f_threads the request is ignored and plans stay single-threaded.
+static void set_planner_threads(size_t nthreads) {
+#if defined(VV_DSP_HAVE_FFTW_THREADS)
+    static int threads_ready = 0;
+    if (!threads_ready) threads_ready = fftwf_init_threads() ? 1 : -1;
+    if (threads_ready > 0) fftwf_plan_with_nthreads(nthreads > 1 ? (int)nthreads : 1);
+#else
+    (void)nthreads;
+#endif
 }
 
-// Remove LRU entry from cache
-static void evict_lru_entry(void) {
-    if (!g_cache_lru_tail) return;
-
-    fftw_cache_entry* victim = g_cache_lru_tail;
-    size_t hash = hash_cache_key(&victim->key);
-
-    // Remove from hash table
-    fftw_cache_entry** bucket = &g_plan_cache[hash];
-    while (*bucket && *bucket != victim) {
-        bucket = &((*bucket)->next);
+static unsigned int to_fftw_flags(vv_dsp_fftw_flag flag) {
+    unsigned int fftw_flags = FFTW_DESTROY_INPUT;
+    switch (flag) {
+        case VV_DSP_FFTW_ESTIMATE: fftw_flags |= FFTW_ESTIMATE; break;
+        case VV_DSP_FFTW_MEASURE:  fftw_flags |= FFTW_MEASURE; break;
+        case VV_DSP_FFTW_PATIENT:  fftw_flags |= FFTW_PATIENT; break;
     }
-    if (*bucket) *bucket = victim->next;
-
-    // Remove from LRU list
-    if (victim->prev) victim->prev->next = victim->next;
-    if (victim->next) victim->next->prev = victim->prev;
-    if (victim == g_cache_lru_head) g_cache_lru_head = victim->next;
-    if (victim == g_cache_lru_tail) g_cache_lru_tail = victim->prev;
+    return fftw_flags;
+}
 
-    // Free FFTW plan
-    if (victim->key.type == VV_DSP_FFT_C2C) {
-        fftwf_destroy_plan(victim->plan.complex_plan);
-    } else if (victim->key.type == VV_DSP_FFT_R2C) {
-        fftwf_destroy_plan(victim->plan.r2c_plan);
-    } else if (victim->key.type == VV_DSP_FFT_C2R) {
-        fftwf_destroy_plan(victim->plan.c2r_plan);
+static fftw_cache_entry* find_in_bucket(fftw_cache_entry* entry, const fftw_cache_key* key) {
+    for (; entry; entry = FFTW_LOAD(&entry->next)) {
+        if (keys_equal(&entry->key, key)) return entry;
     }
+    return NULL;
+}
 
-    free(victim);
-    g_cache_count--;
+// Lock-free lookup: per-thread cache first, then the shared table
+static fftw_cache_entry* lookup_cached_plan(const fftw_cache_key* key) {
+#ifdef FFTW_TLS_SLOTS
+    const unsigned gen = FFTW_LOAD(&g_cache_generation);
+    if (t_recent_gen != gen) {
+        memset(t_recent, 0, sizeof(t_recent));
+        t_recent_gen = gen;
+    }
+    for (unsigned i = 0; i < FFTW_TLS_SLOTS; ++i) {
+        if (t_recent[i] && keys_equal(&t_recent[i]->key, key)) return t_recent[i];
+    }
+#endif
+    fftw_cache_entry* entry = find_in_bucket(FFTW_LOAD(&g_plan_cache[hash_cache_key(key)]), key);
+#ifdef FFTW_TLS_SLOTS
+    if (entry) {
+        t_recent[t_recent_next] = entry;
+        t_recent_next = (t_recent_next + 1) % FFTW_TLS_SLOTS;
+    }
+#endif
+    return entry;
 }
 
-// Find or create cached plan
+// Find or create cached plan; in_buf/out_buf are only used while planning
 static fftw_cache_entry* get_cached_plan(const fftw_cache_key* key, void* in_buf, void* out_buf) {
-    size_t hash = hash_cache_key(key);
-
-    // Search in cache
-    fftw_cache_entry* entry = g_plan_cache[hash];
-    while (entry) {
-        if (keys_equal(&entry->key, key)) {
-            entry->ref_count++;
-            move_to_front(entry);
-            return entry;
-        }
-        entry = entry->next;
+    fftw_cache_entry* entry = lookup_cached_plan(key);
+    if (entry) {
+        FFTW_ADD(&entry->users, 1);
+        return entry;
     }
 
-    // Not found - create new entry
-    entry = (fftw_cache_entry*)malloc(sizeof(fftw_cache_entry));
-    if (!entry) return NULL;
-
-    entry->key = *key;
-    entry->ref_count = 1;
-    entry->next = NULL;
-    entry->prev = NULL;
+    pthread_mutex_lock(&g_fftw_mutex);
+    // Another thread may have planned the same key while we waited
+    fftw_cache_entry** bucket = &g_plan_cache[hash_cache_key(key)];
+    entry = find_in_bucket(*bucket, key);
+    if (entry) {
+        FFTW_ADD(&entry->users, 1);
+        pthread_mutex_unlock(&g_fftw_mutex);
+        return entry;
+    }
 
-    // Convert planning flag to FFTW flag
-    unsigned int fftw_flags = FFTW_DESTROY_INPUT;
-    switch (key->flag) {
-        case VV_DSP_FFTW_ESTIMATE: fftw_flags |= FFTW_ESTIMATE; break;
-        case VV_DSP_FFTW_MEASURE:  fftw_flags |= FFTW_MEASURE; break;
-        case VV_DSP_FFTW_PATIENT:  fftw_flags |= FFTW_PATIENT; break;
+    entry = (fftw_cache_entry*)vv_dsp_malloc(sizeof(fftw_cache_entry));
+    if (!entry) {
+        pthread_mutex_unlock(&g_fftw_mutex);
+        return NULL;
     }
+    entry->key = *key;
+    entry->users = 1;
 
-    // Create FFTW plan based on type
+    const unsigned int fftw_flags = to_fftw_flags(key->flag);
+    set_planner_threads(key->nthreads);
     if (key->type == VV_DSP_FFT_C2C) {
         int sign = (key->dir == VV_DSP_FFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-        entry->plan.complex_plan = fftwf_plan_dft_1d((int)key->n,
-                                                    (fftwf_complex*)in_buf,
-                                                    (fftwf_complex*)out_buf,
-                                                    sign, fftw_flags);
-        if (!entry->plan.complex_plan) {
-            free(entry);
-            return NULL;
-        }
+        entry->plan = fftwf_plan_dft_1d((int)key->n, (fftwf_complex*)in_buf, (fftwf_complex*)out_buf,
+                                        sign, fftw_flags);
     } else if (key->type == VV_DSP_FFT_R2C) {
-        entry->plan.r2c_plan = fftwf_plan_dft_r2c_1d((int)key->n,
-                                                     (float*)in_buf,
-                                                     (fftwf_complex*)out_buf,
-                                                     fftw_flags);
-        if (!entry->plan.r2c_plan) {
-            free(entry);
-            return NULL;
-        }
-    } else if (key->type == VV_DSP_FFT_C2R) {
-        entry->plan.c2r_plan = fftwf_plan_dft_c2r_1d((int)key->n,
-                                                     (fftwf_complex*)in_buf,
-                                                     (float*)out_buf,
-                                                     fftw_flags);
-        if (!entry->plan.c2r_plan) {
-            free(entry);
-            return NULL;
-        }
+        entry->plan = fftwf_plan_dft_r2c_1d((int)key->n, (float*)in_buf, (fftwf_complex*)out_buf, fftw_flags);
     } else {
-        free(entry);
-        return NULL;
+        entry->plan = fftwf_plan_dft_c2r_1d((int)key->n, (fftwf_complex*)in_buf, (float*)out_buf, fftw_flags);
     }
-
-    // Add to cache
-    if (g_cache_count >= FFTW_CACHE_SIZE) {
-        evict_lru_entry();
+    if (!entry->plan) {
+        vv_dsp_free(entry);
+        pthread_mutex_unlock(&g_fftw_mutex);
+        return NULL;
     }
 
-    entry->next = g_plan_cache[hash];
-    g_plan_cache[hash] = entry;
-    move_to_front(entry);
-    g_cache_count++;
-
+    // Publish: the entry is fully initialized before it becomes reachable
+    entry->next = *bucket;
+    FFTW_STORE(bucket, entry);
+    pthread_mutex_unlock(&g_fftw_mutex);
     return entry;
 }
 
-// Release cached plan reference
+// Called with g_fftw_mutex held: destroy retired entries nobody uses any more
+static void sweep_retired(void) {
+    fftw_cache_entry** link = &g_retired;
+    while (*link) {
+        fftw_cache_entry* entry = *link;
+        if (FFTW_LOAD(&entry->users) == 0) {
+            *link = entry->next;
+            fftwf_destroy_plan(entry->plan);
+            vv_dsp_free(entry);
+        } else {
+            link = &entry->next;
+        }
+    }
+}
+
+// Release cached plan reference. Published entries stay cached; only entries
+// retired by a flush are destroyed once their last user is gone.
 static void release_cached_plan(fftw_cache_entry* entry) {
     if (!entry) return;
-    entry->ref_count--;
-    // Note: We don't immediately delete here - let LRU eviction handle it
+    if (FFTW_ADD(&entry->users, -1) == 0 && FFTW_LOAD(&g_retired)) {
+        pthread_mutex_lock(&g_fftw_mutex);
+        sweep_retired();
+        pthread_mutex_unlock(&g_fftw_mutex);
+    }
+}
+
+// Number of elements spanned by a batch: last vector start + last element + 1
+static size_t batch_extent(size_t howmany, size_t dist, size_t len, size_t stride) {
+    return (howmany - 1) * dist + (len - 1) * stride + 1;
+}
+
+// Planner calls take g_fftw_mutex; buffer allocation happens outside it
+static vv_dsp_status create_many_plan(const struct vv_dsp_fft_plan* spec, fftw_plan_wrapper* w) {
+    const int n = (int)spec->n;
+    const int howmany = (int)spec->howmany;
+    const size_t nh = spec->n / 2 + 1;
+    const unsigned int fftw_flags = to_fftw_flags(FFTW_LOAD(&g_fftw_planning_flag));
+
+    if (spec->type == VV_DSP_FFT_C2C) {
+        w->many_in = fftw_buf_cpx(batch_extent(spec->howmany, spec->idist, spec->n, spec->istride));
+        w->many_out = fftw_buf_cpx(batch_extent(spec->howmany, spec->odist, spec->n, spec->ostride));
+        if (w->many_in && w->many_out) {
+            int sign = (spec->dir == VV_DSP_FFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+            pthread_mutex_lock(&g_fftw_mutex);
+            set_planner_threads(spec->nthreads);
+            w->many_plan = fftwf_plan_many_dft(1, &n, howmany,
+                                               (fftwf_complex*)w->many_in, NULL, (int)spec->istride, (int)spec->idist,
+                                               (fftwf_complex*)w->many_out, NULL, (int)spec->ostride, (int)spec->odist,
+                                               sign, fftw_flags);
+            pthread_mutex_unlock(&g_fftw_mutex);
+        }
+    } else if (spec->type == VV_DSP_FFT_R2C) {
+        w->many_in = fftw_buf_real(batch_extent(spec->howmany, spec->idist, spec->n, spec->istride));
+        w->many_out = fftw_buf_cpx(batch_extent(spec->howmany, spec->odist, nh, spec->ostride));
+        if (w->many_in && w->many_out) {
+            pthread_mutex_lock(&g_fftw_mutex);
+            set_planner_threads(spec->nthreads);
+            w->many_plan = fftwf_plan_many_dft_r2c(1, &n, howmany,
+                                                   (float*)w->many_in, NULL, (int)spec->istride, (int)spec->idist,
+                                                   (fftwf_complex*)w->many_out, NULL, (int)spec->ostride, (int)spec->odist,
+                                                   fftw_flags);
+            pthread_mutex_unlock(&g_fftw_mutex);
+        }
+    } else {
+        w->many_in = fftw_buf_cpx(batch_extent(spec->howmany, spec->idist, nh, spec->istride));
+        w->many_out = fftw_buf_real(batch_extent(spec->howmany, spec->odist, spec->n, spec->ostride));
+        if (w->many_in && w->many_out) {
+            pthread_mutex_lock(&g_fftw_mutex);
+            set_planner_threads(spec->nthreads);
+            w->many_plan = fftwf_plan_many_dft_c2r(1, &n, howmany,
+                                                   (fftwf_complex*)w->many_in, NULL, (int)spec->istride, (int)spec->idist,
+                                                   (float*)w->many_out, NULL, (int)spec->ostride, (int)spec->odist,
+                                                   fftw_flags);
+            pthread_mutex_unlock(&g_fftw_mutex);
+        }
+    }
+
+    if (!w->many_plan) {
+        if (w->many_in) vv_dsp_aligned_free(w->many_in);
+        if (w->many_out) vv_dsp_aligned_free(w->many_out);
+        w->many_in = NULL;
+        w->many_out = NULL;
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    return VV_DSP_OK;
 }
 
 static vv_dsp_status fftw_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
     if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
 
-    pthread_mutex_lock(&g_fftw_mutex);
-
-    fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)malloc(sizeof(fftw_plan_wrapper));
+    fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)vv_dsp_malloc(sizeof(fftw_plan_wrapper));
     if (!wrapper) {
-        pthread_mutex_unlock(&g_fftw_mutex);
         return VV_DSP_ERROR_INTERNAL;
     }
 
@@ -235,62 +320,74 @@ static vv_dsp_status fftw_make_plan(const struct vv_dsp_fft_plan* spec, void** b
     wrapper->cache_entry = NULL;
     wrapper->in_buffer = NULL;
     wrapper->out_buffer = NULL;
+    wrapper->many_plan = NULL;
+    wrapper->split_plan = NULL;
+    wrapper->many_in = NULL;
+    wrapper->many_out = NULL;
 
     // Calculate buffer sizes and allocate FFTW-aligned memory
     if (spec->type == VV_DSP_FFT_C2C) {
         wrapper->buffer_size = spec->n * sizeof(fftwf_complex);
-        wrapper->in_buffer = fftwf_alloc_complex(spec->n);
-        wrapper->out_buffer = fftwf_alloc_complex(spec->n);
+        wrapper->in_buffer = fftw_buf_cpx(spec->n);
+        wrapper->out_buffer = fftw_buf_cpx(spec->n);
     } else if (spec->type == VV_DSP_FFT_R2C) {
         wrapper->buffer_size = spec->n * sizeof(float);
-        wrapper->in_buffer = fftwf_alloc_real(spec->n);
-        wrapper->out_buffer = fftwf_alloc_complex(spec->n/2 + 1);
+        wrapper->in_buffer = fftw_buf_real(spec->n);
+        wrapper->out_buffer = fftw_buf_cpx(spec->n/2 + 1);
     } else if (spec->type == VV_DSP_FFT_C2R) {
         wrapper->buffer_size = spec->n * sizeof(float);
-        wrapper->in_buffer = fftwf_alloc_complex(spec->n/2 + 1);
-        wrapper->out_buffer = fftwf_alloc_real(spec->n);
+        wrapper->in_buffer = fftw_buf_cpx(spec->n/2 + 1);
+        wrapper->out_buffer = fftw_buf_real(spec->n);
     } else {
-        free(wrapper);
-        pthread_mutex_unlock(&g_fftw_mutex);
+        vv_dsp_free(wrapper);
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
 
     if (!wrapper->in_buffer || !wrapper->out_buffer) {
-        if (wrapper->in_buffer) fftwf_free(wrapper->in_buffer);
-        if (wrapper->out_buffer) fftwf_free(wrapper->out_buffer);
-        free(wrapper);
-        pthread_mutex_unlock(&g_fftw_mutex);
+        if (wrapper->in_buffer) vv_dsp_aligned_free(wrapper->in_buffer);
+        if (wrapper->out_buffer) vv_dsp_aligned_free(wrapper->out_buffer);
+        vv_dsp_free(wrapper);
         return VV_DSP_ERROR_INTERNAL;
     }
 
     // Get or create cached plan
-    fftw_cache_key key = {spec->n, spec->type, spec->dir, g_fftw_planning_flag};
+    fftw_cache_key key = {spec->n, spec->type, spec->dir, FFTW_LOAD(&g_fftw_planning_flag), spec->nthreads};
     wrapper->cache_entry = get_cached_plan(&key, wrapper->in_buffer, wrapper->out_buffer);
 
     if (!wrapper->cache_entry) {
-        fftwf_free(wrapper->in_buffer);
-        fftwf_free(wrapper->out_buffer);
-        free(wrapper);
-        pthread_mutex_unlock(&g_fftw_mutex);
+        vv_dsp_aligned_free(wrapper->in_buffer);
+        vv_dsp_aligned_free(wrapper->out_buffer);
+        vv_dsp_free(wrapper);
         return VV_DSP_ERROR_INTERNAL;
     }
 
+    if (spec->howmany > 1 || spec->istride != 1 || spec->ostride != 1) {
+        if (create_many_plan(spec, wrapper) != VV_DSP_OK) {
+            release_cached_plan(wrapper->cache_entry);
+            vv_dsp_aligned_free(wrapper->in_buffer);
+            vv_dsp_aligned_free(wrapper->out_buffer);
+            vv_dsp_free(wrapper);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+
     *backend_data = wrapper;
-    pthread_mutex_unlock(&g_fftw_mutex);
     return VV_DSP_OK;
 }
 
-static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
-    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
-
-    fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)backend_data;
+// Runs the cached plan on the staging buffers fin/fout, which must share the
+// alignment of the planning arrays (wrapper buffers, or 64-byte aligned
+// regions of a caller workspace)
+static vv_dsp_status fftw_exec_impl(const struct vv_dsp_fft_plan* spec, const fftw_plan_wrapper* wrapper,
+                                    const void* in, void* out, void* fin, void* fout) {
     if (!wrapper->cache_entry) return VV_DSP_ERROR_INTERNAL;
 
     if (spec->type == VV_DSP_FFT_C2C) {
         // Copy input to FFTW buffer, execute, copy output
-        memcpy(wrapper->in_buffer, in, spec->n * sizeof(fftwf_complex));
-        fftwf_execute(wrapper->cache_entry->plan.complex_plan);
-        memcpy(out, wrapper->out_buffer, spec->n * sizeof(fftwf_complex));
+        memcpy(fin, in, spec->n * sizeof(fftwf_complex));
+        fftwf_execute_dft(wrapper->cache_entry->plan, (fftwf_complex*)fin,
+                          (fftwf_complex*)fout);
+        memcpy(out, fout, spec->n * sizeof(fftwf_complex));
 
         // FFTW doesn't apply 1/n scaling for backward transforms - apply it ourselves
         if (spec->dir == VV_DSP_FFT_BACKWARD) {
@@ -304,16 +401,16 @@ static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, voi
     } else if (spec->type == VV_DSP_FFT_R2C) {
         // Copy real input, execute R2C, copy complex output
         const vv_dsp_real* real_in = (const vv_dsp_real*)in;
-        float* fftw_in = (float*)wrapper->in_buffer;
+        float* fftw_in = (float*)fin;
 
         for (size_t i = 0; i < spec->n; ++i) {
             fftw_in[i] = (float)real_in[i];
         }
 
-        fftwf_execute(wrapper->cache_entry->plan.r2c_plan);
+        fftwf_execute_dft_r2c(wrapper->cache_entry->plan, fftw_in, (fftwf_complex*)fout);
 
         vv_dsp_cpx* cpx_out = (vv_dsp_cpx*)out;
-        fftwf_complex* fftw_out = (fftwf_complex*)wrapper->out_buffer;
+        fftwf_complex* fftw_out = (fftwf_complex*)fout;
         size_t nh = spec->n/2 + 1;
 
         for (size_t i = 0; i < nh; ++i) {
@@ -323,7 +420,7 @@ static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, voi
     } else if (spec->type == VV_DSP_FFT_C2R) {
         // Copy Hermitian input, execute C2R, copy real output with scaling
         const vv_dsp_cpx* cpx_in = (const vv_dsp_cpx*)in;
-        fftwf_complex* fftw_in = (fftwf_complex*)wrapper->in_buffer;
+        fftwf_complex* fftw_in = (fftwf_complex*)fin;
         size_t nh = spec->n/2 + 1;
 
         for (size_t i = 0; i < nh; ++i) {
@@ -331,10 +428,10 @@ static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, voi
             fftw_in[i][1] = (float)cpx_in[i].im;
         }
 
-        fftwf_execute(wrapper->cache_entry->plan.c2r_plan);
+        fftwf_execute_dft_c2r(wrapper->cache_entry->plan, fftw_in, (float*)fout);
 
         vv_dsp_real* real_out = (vv_dsp_real*)out;
-        float* fftw_out = (float*)wrapper->out_buffer;
+        float* fftw_out = (float*)fout;
         vv_dsp_real scale = (vv_dsp_real)1.0 / (vv_dsp_real)spec->n;
 
         for (size_t i = 0; i < spec->n; ++i) {
@@ -347,11 +444,91 @@ static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, voi
     return VV_DSP_OK;
 }
 
+static vv_dsp_status vv_dsp_fftw_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)backend_data;
+    return fftw_exec_impl(spec, wrapper, in, out, wrapper->in_buffer, wrapper->out_buffer);
+}
+
+#define FFTW_WS_ALIGN 64
+
+static size_t fftw_ws_region(size_t bytes) {
+    return (bytes + FFTW_WS_ALIGN - 1) / FFTW_WS_ALIGN * FFTW_WS_ALIGN;
+}
+
+static size_t fftw_stage_bytes(const struct vv_dsp_fft_plan* spec, int input) {
+    const size_t nh = spec->n / 2 + 1;
+    const int real_side = input ? (spec->type == VV_DSP_FFT_R2C) : (spec->type == VV_DSP_FFT_C2R);
+    const size_t len = real_side ? spec->n : (spec->type == VV_DSP_FFT_C2C ? spec->n : nh);
+    return len * (real_side ? sizeof(float) : sizeof(fftwf_complex));
+}
+
+static size_t fftw_workspace_size(const struct vv_dsp_fft_plan* spec, const void* backend_data) {
+    (void)backend_data;
+    // Slack for aligning the start, then two aligned staging regions
+    return FFTW_WS_ALIGN + fftw_ws_region(fftw_stage_bytes(spec, 1)) + fftw_ws_region(fftw_stage_bytes(spec, 0));
+}
+
+static vv_dsp_status fftw_execute_ws(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                     const void* in, void* out, void* ws) {
+    if (!spec || !backend_data || !in || !out || !ws) return VV_DSP_ERROR_NULL_POINTER;
+    unsigned char* base = (unsigned char*)ws;
+    base += (FFTW_WS_ALIGN - ((size_t)base % FFTW_WS_ALIGN)) % FFTW_WS_ALIGN;
+    void* fin = base;
+    void* fout = base + fftw_ws_region(fftw_stage_bytes(spec, 1));
+    return fftw_exec_impl(spec, (const fftw_plan_wrapper*)backend_data, in, out, fin, fout);
+}
+
+static vv_dsp_status fftw_execute_many(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+
+    fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)backend_data;
+    if (!wrapper->many_plan) {
+        // Single contiguous vector
+        return vv_dsp_fftw_execute(spec, backend_data, in, out);
+    }
+
+    const size_t nh = spec->n / 2 + 1;
+    const size_t in_len = (spec->type == VV_DSP_FFT_C2R) ? nh : spec->n;
+    const size_t out_len = (spec->type == VV_DSP_FFT_R2C) ? nh : spec->n;
+    const vv_dsp_real scale = (spec->type == VV_DSP_FFT_R2C || (spec->type == VV_DSP_FFT_C2C && spec->dir == VV_DSP_FFT_FORWARD))
+                                  ? (vv_dsp_real)1.0 : (vv_dsp_real)1.0 / (vv_dsp_real)spec->n;
+
+    // Copy only the addressed elements so gaps in the caller's buffers are untouched
+    for (size_t j = 0; j < spec->howmany; ++j) {
+        for (size_t i = 0; i < in_len; ++i) {
+            const size_t idx = j * spec->idist + i * spec->istride;
+            if (spec->type == VV_DSP_FFT_R2C) {
+                ((float*)wrapper->many_in)[idx] = (float)((const vv_dsp_real*)in)[idx];
+            } else {
+                const vv_dsp_cpx v = ((const vv_dsp_cpx*)in)[idx];
+                ((fftwf_complex*)wrapper->many_in)[idx][0] = (float)v.re;
+                ((fftwf_complex*)wrapper->many_in)[idx][1] = (float)v.im;
+            }
+        }
+    }
+
+    fftwf_execute(wrapper->many_plan);
+
+    for (size_t j = 0; j < spec->howmany; ++j) {
+        for (size_t i = 0; i < out_len; ++i) {
+            const size_t idx = j * spec->odist + i * spec->ostride;
+            if (spec->type == VV_DSP_FFT_C2R) {
+                ((vv_dsp_real*)out)[idx] = (vv_dsp_real)((const float*)wrapper->many_out)[idx] * scale;
+            } else {
+                const fftwf_complex* v = &((const fftwf_complex*)wrapper->many_out)[idx];
+                ((vv_dsp_cpx*)out)[idx].re = (vv_dsp_real)(*v)[0] * scale;
+                ((vv_dsp_cpx*)out)[idx].im = (vv_dsp_real)(*v)[1] * scale;
+            }
+        }
+    }
+
+    return VV_DSP_OK;
+}
+
 static void fftw_free_plan(void* backend_data) {
     if (!backend_data) return;
 
-    pthread_mutex_lock(&g_fftw_mutex);
-
     fftw_plan_wrapper* wrapper = (fftw_plan_wrapper*)backend_data;
 
     if (wrapper->cache_entry) {
@@ -359,18 +536,108 @@ static void fftw_free_plan(void* backend_data) {
     }
 
     if (wrapper->in_buffer) {
-        fftwf_free(wrapper->in_buffer);
+        vv_dsp_aligned_free(wrapper->in_buffer);
     }
 
     if (wrapper->out_buffer) {
-        fftwf_free(wrapper->out_buffer);
+        vv_dsp_aligned_free(wrapper->out_buffer);
     }
 
-    free(wrapper);
+    if (wrapper->split_plan) {
+        pthread_mutex_lock(&g_fftw_mutex);
+        fftwf_destroy_plan(wrapper->split_plan);
+        pthread_mutex_unlock(&g_fftw_mutex);
+    }
 
-    pthread_mutex_unlock(&g_fftw_mutex);
+    if (wrapper->many_plan) {
+        pthread_mutex_lock(&g_fftw_mutex);
+        fftwf_destroy_plan(wrapper->many_plan);
+        pthread_mutex_unlock(&g_fftw_mutex);
+        vv_dsp_aligned_free(wrapper->many_in);
+        vv_dsp_aligned_free(wrapper->many_out);
+    }
+
+    vv_dsp_free(wrapper);
 }
 
+#if !defined(VV_DSP_USE_DOUBLE)
+// Plan on private scratch arrays (MEASURE overwrites them). UNALIGNED and
+// PRESERVE_INPUT let the plan run on any caller arrays, including const input.
+static fftwf_plan get_split_plan(const struct vv_dsp_fft_plan* spec, fftw_plan_wrapper* w) {
+    fftwf_plan plan = FFTW_LOAD(&w->split_plan);
+    if (plan) return plan;
+
+    const size_t nh = spec->n / 2 + 1;
+    const size_t in_len = (spec->type == VV_DSP_FFT_C2R) ? nh : spec->n;
+    const size_t out_len = (spec->type == VV_DSP_FFT_R2C) ? nh : spec->n;
+    float* ri = fftw_buf_real(in_len);
+    float* ii = fftw_buf_real(in_len);
+    float* ro = fftw_buf_real(out_len);
+    float* io = fftw_buf_real(out_len);
+    if (ri && ii && ro && io) {
+        const unsigned int flags = (to_fftw_flags(FFTW_LOAD(&g_fftw_planning_flag)) & ~FFTW_DESTROY_INPUT) |
+                                   FFTW_PRESERVE_INPUT | FFTW_UNALIGNED;
+        fftwf_iodim dim;
+        dim.n = (int)spec->n;
+        dim.is = 1;
+        dim.os = 1;
+        pthread_mutex_lock(&g_fftw_mutex);
+        plan = w->split_plan;
+        if (!plan) {
+            set_planner_threads(spec->nthreads);
+            if (spec->type == VV_DSP_FFT_C2C) {
+                // FFTW's split interface is forward-only; backward swaps re/im at execute time
+                plan = fftwf_plan_guru_split_dft(1, &dim, 0, NULL, ri, ii, ro, io, flags);
+            } else if (spec->type == VV_DSP_FFT_R2C) {
+                plan = fftwf_plan_guru_split_dft_r2c(1, &dim, 0, NULL, ri, ro, io, flags);
+            } else {
+                plan = fftwf_plan_guru_split_dft_c2r(1, &dim, 0, NULL, ri, ii, ro, flags);
+            }
+            if (plan) FFTW_STORE(&w->split_plan, plan);
+        }
+        pthread_mutex_unlock(&g_fftw_mutex);
+    }
+    vv_dsp_aligned_free(ri);
+    vv_dsp_aligned_free(ii);
+    vv_dsp_aligned_free(ro);
+    vv_dsp_aligned_free(io);
+    return plan;
+}
+
+static void scale_split(float* re, float* im, size_t len, size_t n) {
+    const float scale = 1.0f / (float)n;
+    for (size_t i = 0; i < len; ++i) re[i] *= scale;
+    for (size_t i = 0; im && i < len; ++i) im[i] *= scale;
+}
+
+static vv_dsp_status fftw_execute_split(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                        const vv_dsp_real* in_re, const vv_dsp_real* in_im,
+                                        vv_dsp_real* out_re, vv_dsp_real* out_im) {
+    if (!spec || !backend_data || !in_re || !out_re) return VV_DSP_ERROR_NULL_POINTER;
+    fftwf_plan plan = get_split_plan(spec, (fftw_plan_wrapper*)backend_data);
+    if (!plan) return VV_DSP_ERROR_INTERNAL;
+    // FFTW takes non-const pointers; PRESERVE_INPUT guarantees inputs are unchanged
+    float* ri = (float*)in_re;
+    float* ii = (float*)in_im;
+    if (spec->type == VV_DSP_FFT_C2C) {
+        if (spec->dir == VV_DSP_FFT_FORWARD) {
+            fftwf_execute_split_dft(plan, ri, ii, out_re, out_im);
+        } else {
+            fftwf_execute_split_dft(plan, ii, ri, out_im, out_re);
+            scale_split(out_re, out_im, spec->n, spec->n);
+        }
+    } else if (spec->type == VV_DSP_FFT_R2C) {
+        fftwf_execute_split_dft_r2c(plan, ri, out_re, out_im);
+    } else if (spec->type == VV_DSP_FFT_C2R) {
+        fftwf_execute_split_dft_c2r(plan, ri, ii, out_re);
+        scale_split(out_re, NULL, spec->n, spec->n);
+    } else {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    return VV_DSP_OK;
+}
+#endif
+
 static int fftw_is_available(void) {
     return 1; // FFTW is available if this file is compiled
 }
@@ -380,6 +647,12 @@ const vv_dsp_fft_backend_vtable vv_dsp_fft_fftw_vtable = {
     .make_plan = fftw_make_plan,
     .execute = vv_dsp_fftw_execute,
     .free_plan = fftw_free_plan,
+    .execute_many = fftw_execute_many,
+    .workspace_size = fftw_workspace_size,
+    .execute_ws = fftw_execute_ws,
+#if !defined(VV_DSP_USE_DOUBLE)
+    .execute_split = fftw_execute_split,
+#endif
     .is_available = fftw_is_available,
     .name = "FFTW3"
 };
@@ -390,9 +663,7 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag_impl(vv_dsp_fftw_flag fl
         return VV_DSP_ERROR_OUT_OF_RANGE;
     }
 
-    pthread_mutex_lock(&g_fftw_mutex);
-    g_fftw_planning_flag = flag;
-    pthread_mutex_unlock(&g_fftw_mutex);
+    FFTW_STORE(&g_fftw_planning_flag, flag);
 
     return VV_DSP_OK;
 }
@@ -400,36 +671,134 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_set_fftw_flag_impl(vv_dsp_fftw_flag fl
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_flush_fftw_cache_impl(void) {
     pthread_mutex_lock(&g_fftw_mutex);
 
-    // Clear all cache entries
+    // Unpublish every entry; ones still referenced by live plans are retired
+    // and destroyed when their last user releases them
     for (size_t i = 0; i < FFTW_CACHE_SIZE; ++i) {
         fftw_cache_entry* entry = g_plan_cache[i];
+        FFTW_STORE(&g_plan_cache[i], (fftw_cache_entry*)NULL);
         while (entry) {
             fftw_cache_entry* next = entry->next;
-
-            // Free FFTW plan
-            if (entry->key.type == VV_DSP_FFT_C2C) {
-                fftwf_destroy_plan(entry->plan.complex_plan);
-            } else if (entry->key.type == VV_DSP_FFT_R2C) {
-                fftwf_destroy_plan(entry->plan.r2c_plan);
-            } else if (entry->key.type == VV_DSP_FFT_C2R) {
-                fftwf_destroy_plan(entry->plan.c2r_plan);
-            }
-
-            free(entry);
+            entry->next = g_retired;
+            g_retired = entry;
             entry = next;
         }
-        g_plan_cache[i] = NULL;
+    }
+    FFTW_ADD(&g_cache_generation, 1u);
+    sweep_retired();
+
+    // Also cleanup FFTW wisdom, which is only allowed once no plan is alive
+    if (!g_retired) {
+        fftwf_cleanup();
     }
 
-    g_cache_lru_head = NULL;
-    g_cache_lru_tail = NULL;
-    g_cache_count = 0;
+    pthread_mutex_unlock(&g_fftw_mutex);
 
-    // Also cleanup FFTW wisdom
-    fftwf_cleanup();
+    return VV_DSP_OK;
+}
 
+// Wisdom files use FFTW's own text format; the calls touch planner state and
+// therefore run under g_fftw_mutex like planning does
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_wisdom_impl(const char* path) {
+    pthread_mutex_lock(&g_fftw_mutex);
+    int ok = fftwf_export_wisdom_to_filename(path);
+    pthread_mutex_unlock(&g_fftw_mutex);
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_wisdom_impl(const char* path) {
+    pthread_mutex_lock(&g_fftw_mutex);
+    int ok = fftwf_import_wisdom_from_filename(path);
     pthread_mutex_unlock(&g_fftw_mutex);
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+struct vv_dsp_fftw_2d {
+    vv_dsp_fft_type type;
+    size_t in_len, out_len;  // elements on each side
+    vv_dsp_real scale;
+    fftwf_plan plan;
+    void* in_buf;
+    void* out_buf;
+};
+
+void vv_dsp_fftw_2d_free(vv_dsp_fftw_2d* p) {
+    if (!p) return;
+    if (p->plan) {
+        pthread_mutex_lock(&g_fftw_mutex);
+        fftwf_destroy_plan(p->plan);
+        pthread_mutex_unlock(&g_fftw_mutex);
+    }
+    if (p->in_buf) vv_dsp_aligned_free(p->in_buf);
+    if (p->out_buf) vv_dsp_aligned_free(p->out_buf);
+    vv_dsp_free(p);
+}
+
+vv_dsp_status vv_dsp_fftw_2d_make(size_t rows, size_t cols, vv_dsp_fft_type type, vv_dsp_fft_dir dir,
+                                  size_t nthreads, vv_dsp_fftw_2d** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (rows > (size_t)INT_MAX || cols > (size_t)INT_MAX) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_fftw_2d* p = (vv_dsp_fftw_2d*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    const size_t nh = cols / 2 + 1;
+    p->type = type;
+    p->in_len = rows * (type == VV_DSP_FFT_C2R ? nh : cols);
+    p->out_len = rows * (type == VV_DSP_FFT_R2C ? nh : cols);
+    p->scale = dir == VV_DSP_FFT_BACKWARD ? (vv_dsp_real)(1.0 / ((double)rows * (double)cols)) : (vv_dsp_real)1.0;
+    p->in_buf = type == VV_DSP_FFT_R2C ? (void*)fftw_buf_real(p->in_len) : (void*)fftw_buf_cpx(p->in_len);
+    p->out_buf = type == VV_DSP_FFT_C2R ? (void*)fftw_buf_real(p->out_len) : (void*)fftw_buf_cpx(p->out_len);
+    if (p->in_buf && p->out_buf) {
+        const unsigned int fftw_flags = to_fftw_flags(FFTW_LOAD(&g_fftw_planning_flag));
+        pthread_mutex_lock(&g_fftw_mutex);
+        set_planner_threads(nthreads);
+        if (type == VV_DSP_FFT_C2C) {
+            const int sign = (dir == VV_DSP_FFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+            p->plan = fftwf_plan_dft_2d((int)rows, (int)cols, (fftwf_complex*)p->in_buf, (fftwf_complex*)p->out_buf,
+                                        sign, fftw_flags);
+        } else if (type == VV_DSP_FFT_R2C) {
+            p->plan = fftwf_plan_dft_r2c_2d((int)rows, (int)cols, (float*)p->in_buf, (fftwf_complex*)p->out_buf,
+                                            fftw_flags);
+        } else {
+            p->plan = fftwf_plan_dft_c2r_2d((int)rows, (int)cols, (fftwf_complex*)p->in_buf, (float*)p->out_buf,
+                                            fftw_flags);
+        }
+        pthread_mutex_unlock(&g_fftw_mutex);
+    }
+    if (!p->plan) {
+        vv_dsp_fftw_2d_free(p);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *out = p;
+    return VV_DSP_OK;
+}
 
+vv_dsp_status vv_dsp_fftw_2d_execute(const vv_dsp_fftw_2d* p, const void* in, void* out) {
+    if (!p || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (p->type == VV_DSP_FFT_R2C) {
+        const vv_dsp_real* x = (const vv_dsp_real*)in;
+        float* fin = (float*)p->in_buf;
+        for (size_t i = 0; i < p->in_len; ++i) fin[i] = (float)x[i];
+    } else {
+        const vv_dsp_cpx* x = (const vv_dsp_cpx*)in;
+        fftwf_complex* fin = (fftwf_complex*)p->in_buf;
+        for (size_t i = 0; i < p->in_len; ++i) {
+            fin[i][0] = (float)x[i].re;
+            fin[i][1] = (float)x[i].im;
+        }
+    }
+    fftwf_execute(p->plan);
+    if (p->type == VV_DSP_FFT_C2R) {
+        const float* fout = (const float*)p->out_buf;
+        vv_dsp_real* y = (vv_dsp_real*)out;
+        for (size_t i = 0; i < p->out_len; ++i) y[i] = (vv_dsp_real)fout[i] * p->scale;
+    } else {
+        const fftwf_complex* fout = (const fftwf_complex*)p->out_buf;
+        vv_dsp_cpx* y = (vv_dsp_cpx*)out;
+        for (size_t i = 0; i < p->out_len; ++i) {
+            y[i].re = (vv_dsp_real)fout[i][0] * p->scale;
+            y[i].im = (vv_dsp_real)fout[i][1] * p->scale;
+        }
+    }
     return VV_DSP_OK;
 }
 
@@ -0,0 +1,131 @@
+/*
+This file is part of vv-dsp
+
+Block-floating-point Q15 FFT: iterative radix-2 decimation in time with Q15
+twiddles. Instead of halving the data at every stage (the usual fixed-point
+FFT scaling) the block is scanned before each stage and shifted only as much
+as the coming butterflies need.
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "vv_dsp/spectral/fft_fixed.h"
+#include "vv_dsp/core/alloc.h"
+
+// A butterfly output component is at most |a| + |w b| <= (1 + sqrt(2)) * max component,
+// so a stage is safe without scaling while max <= 32767 / (1 + sqrt(2))
+#define BFP_LIMIT 13572
+
+struct vv_dsp_fft_q15_plan {
+    size_t n;
+    vv_dsp_cpx_q15* tw;      // n/2 twiddles e^(-+i 2 pi k / n)
+    uint16_t* rev;           // bit-reversed index permutation
+};
+
+void vv_dsp_fft_q15_destroy(vv_dsp_fft_q15_plan* p) {
+    if (!p) return;
+    vv_dsp_free(p->tw);
+    vv_dsp_free(p->rev);
+    vv_dsp_free(p);
+}
+
+static vv_dsp_q15 q15_const(double v) {
+    const double r = floor(v * 32767.0 + 0.5);
+    return (vv_dsp_q15)(r > 32767.0 ? 32767 : (r < -32767.0 ? -32767 : (int)r));
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_q15_make_plan(size_t n,
+                                                        vv_dsp_fft_dir dir,
+                                                        vv_dsp_fft_q15_plan** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (n < 2 || n > 32768 || (n & (n - 1)) != 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (dir != VV_DSP_FFT_FORWARD && dir != VV_DSP_FFT_BACKWARD) return VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_fft_q15_plan* p = (vv_dsp_fft_q15_plan*)vv_dsp_calloc(1, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->n = n;
+    p->tw = (vv_dsp_cpx_q15*)vv_dsp_malloc((n / 2) * sizeof(vv_dsp_cpx_q15));
+    p->rev = (uint16_t*)vv_dsp_malloc(n * sizeof(uint16_t));
+    if (!p->tw || !p->rev) {
+        vv_dsp_fft_q15_destroy(p);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    const double sgn = (dir == VV_DSP_FFT_FORWARD) ? -1.0 : 1.0;
+    for (size_t k = 0; k < n / 2; ++k) {
+        const double ang = 2.0 * 3.14159265358979323846 * (double)k / (double)n;
+        p->tw[k].re = q15_const(cos(ang));
+        p->tw[k].im = q15_const(sgn * sin(ang));
+    }
+    unsigned bits = 0;
+    while (((size_t)1 << bits) < n) ++bits;
+    for (size_t i = 0; i < n; ++i) {
+        size_t r = 0;
+        for (unsigned b = 0; b < bits; ++b) r |= ((i >> b) & 1u) << (bits - 1 - b);
+        p->rev[i] = (uint16_t)r;
+    }
+    *out = p;
+    return VV_DSP_OK;
+}
+
+// Shift that keeps the next stage's butterflies within Q15
+static int stage_shift(const vv_dsp_cpx_q15* x, size_t n) {
+    int32_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int32_t r = x[i].re < 0 ? -(int32_t)x[i].re : x[i].re;
+        const int32_t q = x[i].im < 0 ? -(int32_t)x[i].im : x[i].im;
+        if (r > m) m = r;
+        if (q > m) m = q;
+    }
+    int s = 0;
+    while ((m >> s) > BFP_LIMIT) ++s;     // at most 2 for full-scale data
+    return s;
+}
+
+static vv_dsp_q15 shift_round(int32_t v, int s) {
+    if (s) v = (v + (1 << (s - 1))) >> s;
+    return vv_dsp_sat_q15(v);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_q15_execute(const vv_dsp_fft_q15_plan* p,
+                                                      const vv_dsp_cpx_q15* in,
+                                                      vv_dsp_cpx_q15* out,
+                                                      int* out_exponent) {
+    if (!p || !in || !out || !out_exponent) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t n = p->n;
+    if (in == out) {
+        for (size_t i = 0; i < n; ++i) {
+            const size_t r = p->rev[i];
+            if (i < r) {
+                const vv_dsp_cpx_q15 t = out[i];
+                out[i] = out[r];
+                out[r] = t;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) out[p->rev[i]] = in[i];
+    }
+    int exponent = 0;
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2, step = n / len;
+        // Butterflies run in 32 bits; only their outputs are shifted and rounded
+        const int s = stage_shift(out, n);
+        exponent += s;
+        for (size_t start = 0; start < n; start += len) {
+            vv_dsp_cpx_q15* a = out + start;
+            vv_dsp_cpx_q15* b = a + half;
+            for (size_t k = 0; k < half; ++k) {
+                const vv_dsp_cpx_q15 w = p->tw[k * step];
+                const int32_t tr = ((int32_t)b[k].re * w.re - (int32_t)b[k].im * w.im + (1 << 14)) >> 15;
+                const int32_t ti = ((int32_t)b[k].re * w.im + (int32_t)b[k].im * w.re + (1 << 14)) >> 15;
+                const int32_t ar = a[k].re, ai = a[k].im;
+                a[k].re = shift_round(ar + tr, s);
+                a[k].im = shift_round(ai + ti, s);
+                b[k].re = shift_round(ar - tr, s);
+                b[k].im = shift_round(ai - ti, s);
+            }
+        }
+    }
+    *out_exponent = exponent;
+    return VV_DSP_OK;
+}
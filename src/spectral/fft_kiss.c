@@ -3,14 +3,74 @@
 #include <stdlib.h>
 #include <string.h>
 #include "fft_backend.h"
+#include "vv_dsp/spectral/fft_small.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/threadpool.h"
 
 // Minimal FFT backend
+// Plans own their twiddle/bit-reversal tables and scratch buffer.
 // Provides:
-//  - Power-of-two iterative radix-2 Cooley-Tukey O(n log n)
-//  - Fallback naive O(n^2) DFT when size not power-of-two
+//  - Power-of-two sizes up to VV_DSP_FFT_SMALL_MAX on the straight-line
+//    kernels of fft_small.c (constant twiddles, no bit-reversal pass)
+//  - Larger powers of two: iterative radix-4 Cooley-Tukey O(n log n), with SSE4.1 /
+//    AVX2 / AVX-512 / NEON butterflies in single-precision SIMD builds
+//  - Mixed-radix (4, 2, 3, 5 and generic odd radices) for smooth sizes
+//  - Bluestein chirp-z fallback when a prime factor exceeds KISS_MAX_GENERIC_RADIX
+//  - Four-step (transpose / row FFTs / twiddle / transpose) for power-of-two
+//    sizes >= KISS_FOURSTEP_MIN_N in multi-threaded plans; the passes are
+//    split across the plan's threads. Single-threaded plans keep the direct
+//    radix-4 engine, which is as fast on one core.
+//  - Even-length R2C/C2R via an n/2 complex FFT plus a split/merge pass
 // Forward transform: no scaling
 // Backward transform: 1/n scaling (to match existing semantics)
 
+#define KISS_MAX_FACTORS 64
+#define KISS_MAX_GENERIC_RADIX 31
+#define KISS_FOURSTEP_MIN_N ((size_t)1 << 18)
+#define KISS_FOURSTEP_BLOCK 8   // columns moved together by the blocked transposes
+#define KISS_MAX_THREADS 64
+
+typedef enum {
+    KISS_ALGO_POW2 = 0,
+    KISS_ALGO_MIXED,
+    KISS_ALGO_BLUESTEIN,
+    KISS_ALGO_FOURSTEP,
+    KISS_ALGO_SMALL
+} kiss_algo;
+
+// Complex transform engine of fixed length and direction. Twiddles already
+// carry the direction sign, so butterflies never branch on it.
+typedef struct kiss_cfft {
+    size_t n;
+    int sign;                        // +1 forward, -1 backward
+    kiss_algo algo;
+    size_t* bitrev;                  // pow2: bit-reversal permutation (n entries)
+    int radix2_first;                // pow2: log2(n) odd, one radix-2 pass precedes radix-4
+    vv_dsp_cpx* twiddles;            // pow2: per-pass W^k, W^2k, W^3k runs; mixed: n entries
+    size_t factors[2 * KISS_MAX_FACTORS]; // mixed: (radix, remaining length) pairs
+    size_t work_len;                 // execute scratch (entries): mixed: largest radix; bluestein: 2 * sub->n
+    struct kiss_cfft* sub;           // bluestein: forward power-of-two engine
+    vv_dsp_cpx* chirp;               // bluestein: exp(-sign*i*pi*k^2/n), n entries
+    vv_dsp_cpx* chirp_fft;           // bluestein: FFT of the conjugate chirp filter
+    size_t n1, n2;                   // fourstep: n = n1 * n2; sub has length n1, sub2 length n2
+    struct kiss_cfft* sub2;
+    vv_dsp_cpx* tw_hi;               // fourstep: W^(a*n1), a < n2
+    vv_dsp_cpx* tw_lo;               // fourstep: W^b, b < n1; W^m = tw_hi[m / n1] * tw_lo[m % n1]
+    size_t nthreads;                 // fourstep: worker count for the parallel passes
+} kiss_cfft;
+
+// Per-plan state. Everything that depends only on (n, type, dir) is computed
+// once in kiss_make_plan so that execute performs arithmetic only.
+typedef struct kiss_plan_data {
+    kiss_cfft* cfft;       // complex engine (length n, or n/2 for even real transforms)
+    vv_dsp_cpx* real_tw;   // exp(-2*pi*i*k/n), k < n/2, for even-length R2C/C2R
+    size_t scratch_len;    // entries used by the real/in-place paths, ahead of the engine's work_len
+    vv_dsp_cpx* scratch;   // owned workspace (scratch_len + cfft->work_len) for kiss_execute
+    vv_dsp_cpx* split_stage; // interleaved staging for kiss_execute_split
+} kiss_plan_data;
+
 static int is_power_of_two(size_t n) {
     return n && ((n & (n - 1)) == 0);
 }
@@ -24,160 +84,885 @@ static size_t reverse_bits(size_t x, unsigned int bits) {
     return r;
 }
 
-static void fft_iterative_radix2(vv_dsp_cpx* data, size_t n, int sign) {
-    // sign: +1 forward, -1 backward (angle uses -sign to match naive implementation)
+static VV_DSP_INLINE vv_dsp_cpx cmul(vv_dsp_cpx a, vv_dsp_cpx b) {
+    return vv_dsp_cpx_make(a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re);
+}
+
+static void fill_roots(vv_dsp_cpx* tw, size_t count, size_t n, int sign) {
+    // Computed in double so float builds get correctly rounded tables
+    for (size_t k = 0; k < count; ++k) {
+        const double ang = -(double)sign * VV_DSP_TWO_PI_D * (double)k / (double)n;
+        tw[k] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Power-of-two: bit-reversal followed by radix-4 passes (plus one radix-2
+// pass when log2(n) is odd). Each radix-4 pass combines four length-h blocks
+// laid out in bit-reversed order: blocks 0..3 hold the DFTs of the
+// subsequences y[4j], y[4j+2], y[4j+1], y[4j+3].
+// ---------------------------------------------------------------------------
+
+#if !defined(VV_DSP_USE_DOUBLE)
+#  if defined(VV_DSP_SIMD_AVX512)
+#    define KISS_R4_SIMD_WIDTH 8
+#  elif defined(VV_DSP_SIMD_AVX2)
+#    define KISS_R4_SIMD_WIDTH 4
+#  elif defined(VV_DSP_SIMD_SSE41)
+#    define KISS_R4_SIMD_WIDTH 2
+#  elif defined(VV_DSP_SIMD_NEON)
+#    define KISS_R4_SIMD_WIDTH 4
+#  endif
+#endif
+
+static void r4_pass_scalar(vv_dsp_cpx* x, size_t n, size_t h, const vv_dsp_cpx* tw, int sign) {
+    const vv_dsp_cpx* w1 = tw;
+    const vv_dsp_cpx* w2 = tw + h;
+    const vv_dsp_cpx* w3 = tw + 2 * h;
+    // r = (-i*sign) * t3 = (sign*t3.im, -sign*t3.re)
+    const vv_dsp_real sg = (sign > 0) ? (vv_dsp_real)1.0 : (vv_dsp_real)-1.0;
+    for (size_t start = 0; start < n; start += 4 * h) {
+        vv_dsp_cpx* p0 = x + start;
+        vv_dsp_cpx* p1 = p0 + h;
+        vv_dsp_cpx* p2 = p1 + h;
+        vv_dsp_cpx* p3 = p2 + h;
+        for (size_t k = 0; k < h; ++k) {
+            const vv_dsp_real ar = p0[k].re, ai = p0[k].im;
+            const vv_dsp_real br = p1[k].re * w2[k].re - p1[k].im * w2[k].im;
+            const vv_dsp_real bi = p1[k].re * w2[k].im + p1[k].im * w2[k].re;
+            const vv_dsp_real cr = p2[k].re * w1[k].re - p2[k].im * w1[k].im;
+            const vv_dsp_real ci = p2[k].re * w1[k].im + p2[k].im * w1[k].re;
+            const vv_dsp_real dr = p3[k].re * w3[k].re - p3[k].im * w3[k].im;
+            const vv_dsp_real di = p3[k].re * w3[k].im + p3[k].im * w3[k].re;
+            const vv_dsp_real t0r = ar + br, t0i = ai + bi;
+            const vv_dsp_real t1r = ar - br, t1i = ai - bi;
+            const vv_dsp_real t2r = cr + dr, t2i = ci + di;
+            const vv_dsp_real rr = sg * (ci - di);
+            const vv_dsp_real ri = sg * (dr - cr);
+            p0[k].re = t0r + t2r; p0[k].im = t0i + t2i;
+            p2[k].re = t0r - t2r; p2[k].im = t0i - t2i;
+            p1[k].re = t1r + rr;  p1[k].im = t1i + ri;
+            p3[k].re = t1r - rr;  p3[k].im = t1i - ri;
+        }
+    }
+}
+
+#if defined(KISS_R4_SIMD_WIDTH)
+#if defined(VV_DSP_SIMD_NEON)
+// NEON: de-interleave four complex values into re/im lanes
+static VV_DSP_INLINE float32x4x2_t r4_cmul_neon(float32x4x2_t a, float32x4x2_t w) {
+    float32x4x2_t r;
+    r.val[0] = vmlsq_f32(vmulq_f32(a.val[0], w.val[0]), a.val[1], w.val[1]);
+    r.val[1] = vmlaq_f32(vmulq_f32(a.val[0], w.val[1]), a.val[1], w.val[0]);
+    return r;
+}
+
+static void r4_pass_simd(vv_dsp_cpx* x, size_t n, size_t h, const vv_dsp_cpx* tw, int sign) {
+    const float* w1 = (const float*)tw;
+    const float* w2 = (const float*)(tw + h);
+    const float* w3 = (const float*)(tw + 2 * h);
+    for (size_t start = 0; start < n; start += 4 * h) {
+        float* p0 = (float*)(x + start);
+        float* p1 = (float*)(x + start + h);
+        float* p2 = (float*)(x + start + 2 * h);
+        float* p3 = (float*)(x + start + 3 * h);
+        for (size_t k = 0; k < 2 * h; k += 8) {
+            float32x4x2_t a = vld2q_f32(p0 + k);
+            float32x4x2_t b = r4_cmul_neon(vld2q_f32(p1 + k), vld2q_f32(w2 + k));
+            float32x4x2_t c = r4_cmul_neon(vld2q_f32(p2 + k), vld2q_f32(w1 + k));
+            float32x4x2_t d = r4_cmul_neon(vld2q_f32(p3 + k), vld2q_f32(w3 + k));
+            float32x4_t t0r = vaddq_f32(a.val[0], b.val[0]), t0i = vaddq_f32(a.val[1], b.val[1]);
+            float32x4_t t1r = vsubq_f32(a.val[0], b.val[0]), t1i = vsubq_f32(a.val[1], b.val[1]);
+            float32x4_t t2r = vaddq_f32(c.val[0], d.val[0]), t2i = vaddq_f32(c.val[1], d.val[1]);
+            float32x4_t t3r = vsubq_f32(c.val[0], d.val[0]), t3i = vsubq_f32(c.val[1], d.val[1]);
+            float32x4_t rr = (sign > 0) ? t3i : vnegq_f32(t3i);
+            float32x4_t ri = (sign > 0) ? vnegq_f32(t3r) : t3r;
+            float32x4x2_t o;
+            o.val[0] = vaddq_f32(t0r, t2r); o.val[1] = vaddq_f32(t0i, t2i); vst2q_f32(p0 + k, o);
+            o.val[0] = vsubq_f32(t0r, t2r); o.val[1] = vsubq_f32(t0i, t2i); vst2q_f32(p2 + k, o);
+            o.val[0] = vaddq_f32(t1r, rr);  o.val[1] = vaddq_f32(t1i, ri);  vst2q_f32(p1 + k, o);
+            o.val[0] = vsubq_f32(t1r, rr);  o.val[1] = vsubq_f32(t1i, ri);  vst2q_f32(p3 + k, o);
+        }
+    }
+}
+#else
+// x86: interleaved (re, im) lanes; complex multiply via duplicate/swap/addsub.
+#if defined(VV_DSP_SIMD_AVX512)
+typedef __m512 r4_vec;
+#define R4_LOAD(p) _mm512_loadu_ps(p)
+#define R4_STORE(p, v) _mm512_storeu_ps((p), (v))
+#define R4_ADD(a, b) _mm512_add_ps((a), (b))
+#define R4_SUB(a, b) _mm512_sub_ps((a), (b))
+#define R4_SWAP(a) _mm512_permute_ps((a), 0xB1)
+#define R4_XOR(a, m) _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(m)))
+static VV_DSP_INLINE r4_vec r4_cmul(r4_vec a, r4_vec w) {
+    return _mm512_fmaddsub_ps(a, _mm512_moveldup_ps(w), _mm512_mul_ps(R4_SWAP(a), _mm512_movehdup_ps(w)));
+}
+static VV_DSP_INLINE r4_vec r4_rot_mask(int sign) {
+    // sign > 0: negate imaginary lanes after swap; sign < 0: negate real lanes
+    return (sign > 0) ? _mm512_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f,
+                                       0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)
+                      : _mm512_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f,
+                                       -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+}
+#elif defined(VV_DSP_SIMD_AVX2)
+typedef __m256 r4_vec;
+#define R4_LOAD(p) _mm256_loadu_ps(p)
+#define R4_STORE(p, v) _mm256_storeu_ps((p), (v))
+#define R4_ADD(a, b) _mm256_add_ps((a), (b))
+#define R4_SUB(a, b) _mm256_sub_ps((a), (b))
+#define R4_SWAP(a) _mm256_permute_ps((a), 0xB1)
+#define R4_XOR(a, m) _mm256_xor_ps((a), (m))
+static VV_DSP_INLINE r4_vec r4_cmul(r4_vec a, r4_vec w) {
+    return _mm256_addsub_ps(_mm256_mul_ps(a, _mm256_moveldup_ps(w)),
+                            _mm256_mul_ps(R4_SWAP(a), _mm256_movehdup_ps(w)));
+}
+static VV_DSP_INLINE r4_vec r4_rot_mask(int sign) {
+    return (sign > 0) ? _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)
+                      : _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+}
+#else /* SSE4.1 (SSE3 addsub/moveldup are implied) */
+typedef __m128 r4_vec;
+#define R4_LOAD(p) _mm_loadu_ps(p)
+#define R4_STORE(p, v) _mm_storeu_ps((p), (v))
+#define R4_ADD(a, b) _mm_add_ps((a), (b))
+#define R4_SUB(a, b) _mm_sub_ps((a), (b))
+#define R4_SWAP(a) _mm_shuffle_ps((a), (a), 0xB1)
+#define R4_XOR(a, m) _mm_xor_ps((a), (m))
+static VV_DSP_INLINE r4_vec r4_cmul(r4_vec a, r4_vec w) {
+    return _mm_addsub_ps(_mm_mul_ps(a, _mm_moveldup_ps(w)),
+                         _mm_mul_ps(R4_SWAP(a), _mm_movehdup_ps(w)));
+}
+static VV_DSP_INLINE r4_vec r4_rot_mask(int sign) {
+    return (sign > 0) ? _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)
+                      : _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+}
+#endif
+
+static void r4_pass_simd(vv_dsp_cpx* x, size_t n, size_t h, const vv_dsp_cpx* tw, int sign) {
+    const r4_vec mask = r4_rot_mask(sign);
+    const float* w1 = (const float*)tw;
+    const float* w2 = (const float*)(tw + h);
+    const float* w3 = (const float*)(tw + 2 * h);
+    for (size_t start = 0; start < n; start += 4 * h) {
+        float* p0 = (float*)(x + start);
+        float* p1 = (float*)(x + start + h);
+        float* p2 = (float*)(x + start + 2 * h);
+        float* p3 = (float*)(x + start + 3 * h);
+        for (size_t k = 0; k < 2 * h; k += 2 * KISS_R4_SIMD_WIDTH) {
+            r4_vec a = R4_LOAD(p0 + k);
+            r4_vec b = r4_cmul(R4_LOAD(p1 + k), R4_LOAD(w2 + k));
+            r4_vec c = r4_cmul(R4_LOAD(p2 + k), R4_LOAD(w1 + k));
+            r4_vec d = r4_cmul(R4_LOAD(p3 + k), R4_LOAD(w3 + k));
+            r4_vec t0 = R4_ADD(a, b), t1 = R4_SUB(a, b);
+            r4_vec t2 = R4_ADD(c, d), t3 = R4_SUB(c, d);
+            r4_vec r = R4_XOR(R4_SWAP(t3), mask);
+            R4_STORE(p0 + k, R4_ADD(t0, t2));
+            R4_STORE(p2 + k, R4_SUB(t0, t2));
+            R4_STORE(p1 + k, R4_ADD(t1, r));
+            R4_STORE(p3 + k, R4_SUB(t1, r));
+        }
+    }
+}
+#endif
+#endif /* KISS_R4_SIMD_WIDTH */
+
+static void fft_pow2(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* data) {
+    const size_t n = st->n;
+    for (size_t i = 0; i < n; ++i) data[i] = in[st->bitrev[i]];
+
+    size_t h = 1;
+    if (st->radix2_first) {
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            const vv_dsp_cpx a = data[i], b = data[i + 1];
+            data[i] = vv_dsp_cpx_make(a.re + b.re, a.im + b.im);
+            data[i + 1] = vv_dsp_cpx_make(a.re - b.re, a.im - b.im);
+        }
+        h = 2;
+    }
+    const vv_dsp_cpx* tw = st->twiddles;
+    for (; 4 * h <= n; h *= 4) {
+#if defined(KISS_R4_SIMD_WIDTH)
+        if (h >= KISS_R4_SIMD_WIDTH) r4_pass_simd(data, n, h, tw, st->sign);
+        else r4_pass_scalar(data, n, h, tw, st->sign);
+#else
+        r4_pass_scalar(data, n, h, tw, st->sign);
+#endif
+        tw += 3 * h;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mixed radix (recursive decimation in time, KissFFT-style butterflies)
+// ---------------------------------------------------------------------------
+
+static void bfly2(vv_dsp_cpx* out, size_t fstride, const kiss_cfft* st, size_t m) {
+    const vv_dsp_cpx* tw = st->twiddles;
+    for (size_t k = 0; k < m; ++k) {
+        vv_dsp_cpx t = cmul(out[m + k], tw[k * fstride]);
+        out[m + k].re = out[k].re - t.re;
+        out[m + k].im = out[k].im - t.im;
+        out[k].re += t.re;
+        out[k].im += t.im;
+    }
+}
+
+static void bfly3(vv_dsp_cpx* out, size_t fstride, const kiss_cfft* st, size_t m) {
+    const vv_dsp_cpx* tw = st->twiddles;
+    const vv_dsp_real epi3 = tw[fstride * m].im; // Im(exp(-sign*2*pi*i/3))
+    const vv_dsp_real half = (vv_dsp_real)0.5;
+    for (size_t k = 0; k < m; ++k) {
+        vv_dsp_cpx* f0 = &out[k];
+        vv_dsp_cpx* f1 = &out[k + m];
+        vv_dsp_cpx* f2 = &out[k + 2 * m];
+        vv_dsp_cpx s1 = cmul(*f1, tw[k * fstride]);
+        vv_dsp_cpx s2 = cmul(*f2, tw[2 * k * fstride]);
+        vv_dsp_cpx s3 = vv_dsp_cpx_make(s1.re + s2.re, s1.im + s2.im);
+        vv_dsp_cpx s0 = vv_dsp_cpx_make((s1.re - s2.re) * epi3, (s1.im - s2.im) * epi3);
+        vv_dsp_cpx mid = vv_dsp_cpx_make(f0->re - half * s3.re, f0->im - half * s3.im);
+        f0->re += s3.re;
+        f0->im += s3.im;
+        f2->re = mid.re + s0.im;
+        f2->im = mid.im - s0.re;
+        f1->re = mid.re - s0.im;
+        f1->im = mid.im + s0.re;
+    }
+}
+
+static void bfly4(vv_dsp_cpx* out, size_t fstride, const kiss_cfft* st, size_t m) {
+    const vv_dsp_cpx* tw = st->twiddles;
+    for (size_t k = 0; k < m; ++k) {
+        vv_dsp_cpx* f0 = &out[k];
+        vv_dsp_cpx s0 = cmul(out[k + m], tw[k * fstride]);
+        vv_dsp_cpx s1 = cmul(out[k + 2 * m], tw[2 * k * fstride]);
+        vv_dsp_cpx s2 = cmul(out[k + 3 * m], tw[3 * k * fstride]);
+        vv_dsp_cpx s5 = vv_dsp_cpx_make(f0->re - s1.re, f0->im - s1.im);
+        vv_dsp_cpx a = vv_dsp_cpx_make(f0->re + s1.re, f0->im + s1.im);
+        vv_dsp_cpx s3 = vv_dsp_cpx_make(s0.re + s2.re, s0.im + s2.im);
+        vv_dsp_cpx s4 = vv_dsp_cpx_make(s0.re - s2.re, s0.im - s2.im);
+        out[k + 2 * m] = vv_dsp_cpx_make(a.re - s3.re, a.im - s3.im);
+        out[k] = vv_dsp_cpx_make(a.re + s3.re, a.im + s3.im);
+        if (st->sign > 0) {
+            out[k + m] = vv_dsp_cpx_make(s5.re + s4.im, s5.im - s4.re);
+            out[k + 3 * m] = vv_dsp_cpx_make(s5.re - s4.im, s5.im + s4.re);
+        } else {
+            out[k + m] = vv_dsp_cpx_make(s5.re - s4.im, s5.im + s4.re);
+            out[k + 3 * m] = vv_dsp_cpx_make(s5.re + s4.im, s5.im - s4.re);
+        }
+    }
+}
+
+static void bfly5(vv_dsp_cpx* out, size_t fstride, const kiss_cfft* st, size_t m) {
+    const vv_dsp_cpx* tw = st->twiddles;
+    const vv_dsp_cpx ya = tw[fstride * m];
+    const vv_dsp_cpx yb = tw[fstride * 2 * m];
+    for (size_t u = 0; u < m; ++u) {
+        vv_dsp_cpx* f0 = &out[u];
+        vv_dsp_cpx* f1 = &out[u + m];
+        vv_dsp_cpx* f2 = &out[u + 2 * m];
+        vv_dsp_cpx* f3 = &out[u + 3 * m];
+        vv_dsp_cpx* f4 = &out[u + 4 * m];
+        vv_dsp_cpx s0 = *f0;
+        vv_dsp_cpx s1 = cmul(*f1, tw[u * fstride]);
+        vv_dsp_cpx s2 = cmul(*f2, tw[2 * u * fstride]);
+        vv_dsp_cpx s3 = cmul(*f3, tw[3 * u * fstride]);
+        vv_dsp_cpx s4 = cmul(*f4, tw[4 * u * fstride]);
+        vv_dsp_cpx s7 = vv_dsp_cpx_make(s1.re + s4.re, s1.im + s4.im);
+        vv_dsp_cpx s10 = vv_dsp_cpx_make(s1.re - s4.re, s1.im - s4.im);
+        vv_dsp_cpx s8 = vv_dsp_cpx_make(s2.re + s3.re, s2.im + s3.im);
+        vv_dsp_cpx s9 = vv_dsp_cpx_make(s2.re - s3.re, s2.im - s3.im);
+
+        f0->re = s0.re + s7.re + s8.re;
+        f0->im = s0.im + s7.im + s8.im;
+
+        vv_dsp_cpx s5 = vv_dsp_cpx_make(s0.re + s7.re * ya.re + s8.re * yb.re,
+                                        s0.im + s7.im * ya.re + s8.im * yb.re);
+        vv_dsp_cpx s6 = vv_dsp_cpx_make(s10.im * ya.im + s9.im * yb.im,
+                                        -s10.re * ya.im - s9.re * yb.im);
+        *f1 = vv_dsp_cpx_make(s5.re - s6.re, s5.im - s6.im);
+        *f4 = vv_dsp_cpx_make(s5.re + s6.re, s5.im + s6.im);
+
+        vv_dsp_cpx s11 = vv_dsp_cpx_make(s0.re + s7.re * yb.re + s8.re * ya.re,
+                                         s0.im + s7.im * yb.re + s8.im * ya.re);
+        vv_dsp_cpx s12 = vv_dsp_cpx_make(-s10.im * yb.im + s9.im * ya.im,
+                                         s10.re * yb.im - s9.re * ya.im);
+        *f2 = vv_dsp_cpx_make(s11.re + s12.re, s11.im + s12.im);
+        *f3 = vv_dsp_cpx_make(s11.re - s12.re, s11.im - s12.im);
+    }
+}
+
+static void bfly_generic(vv_dsp_cpx* out, size_t fstride, const kiss_cfft* st, size_t m, size_t p,
+                         vv_dsp_cpx* scratch) {
+    const vv_dsp_cpx* tw = st->twiddles;
+    const size_t norig = st->n;
+    for (size_t u = 0; u < m; ++u) {
+        size_t k = u;
+        for (size_t q1 = 0; q1 < p; ++q1) { scratch[q1] = out[k]; k += m; }
+        k = u;
+        for (size_t q1 = 0; q1 < p; ++q1) {
+            size_t twidx = 0;
+            vv_dsp_cpx acc = scratch[0];
+            for (size_t q = 1; q < p; ++q) {
+                twidx += fstride * k;
+                twidx %= norig;
+                vv_dsp_cpx t = cmul(scratch[q], tw[twidx]);
+                acc.re += t.re;
+                acc.im += t.im;
+            }
+            out[k] = acc;
+            k += m;
+        }
+    }
+}
+
+static void mixed_work(const kiss_cfft* st, vv_dsp_cpx* out, const vv_dsp_cpx* in,
+                       size_t fstride, const size_t* factors, vv_dsp_cpx* work) {
+    const size_t p = factors[0];
+    const size_t m = factors[1];
+    if (m == 1) {
+        for (size_t i = 0; i < p; ++i) out[i] = in[i * fstride];
+    } else {
+        for (size_t i = 0; i < p; ++i) {
+            mixed_work(st, out + i * m, in + i * fstride, fstride * p, factors + 2, work);
+        }
+    }
+    switch (p) {
+        case 2: bfly2(out, fstride, st, m); break;
+        case 3: bfly3(out, fstride, st, m); break;
+        case 4: bfly4(out, fstride, st, m); break;
+        case 5: bfly5(out, fstride, st, m); break;
+        default: bfly_generic(out, fstride, st, m, p, work); break;
+    }
+}
+
+// Factor n into radices 4, 2, 3, 5, 7, ... Returns the largest radix, or 0 if
+// the factor list would overflow.
+static size_t factorize(size_t n, size_t* factors) {
+    size_t p = 4, maxp = 1, count = 0;
+    double floor_sqrt = floor(sqrt((double)n));
+    do {
+        while (n % p) {
+            switch (p) {
+                case 4: p = 2; break;
+                case 2: p = 3; break;
+                default: p += 2; break;
+            }
+            if ((double)p > floor_sqrt) p = n; // no more factors below sqrt(n)
+        }
+        n /= p;
+        if (count >= KISS_MAX_FACTORS) return 0;
+        factors[2 * count] = p;
+        factors[2 * count + 1] = n;
+        count++;
+        if (p > maxp) maxp = p;
+    } while (n > 1);
+    return maxp;
+}
+
+// ---------------------------------------------------------------------------
+// Engine construction / execution
+// ---------------------------------------------------------------------------
+
+static void cfft_free(kiss_cfft* st) {
+    if (!st) return;
+    vv_dsp_free(st->bitrev);
+    vv_dsp_free(st->twiddles);
+    cfft_free(st->sub);
+    vv_dsp_free(st->chirp);
+    vv_dsp_free(st->chirp_fft);
+    cfft_free(st->sub2);
+    vv_dsp_free(st->tw_hi);
+    vv_dsp_free(st->tw_lo);
+    vv_dsp_free(st);
+}
+
+static void cfft_raw(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_cpx* work);
+
+// Direct radix-4/2 engine for power-of-two n; returns 0 on allocation failure
+static int pow2_init(kiss_cfft* st) {
+    const size_t n = st->n;
+    const int sign = st->sign;
     unsigned int levels = 0;
-    size_t temp = n;
-    while (temp > 1) { levels++; temp >>= 1; }
-
-    // Bit-reversal permutation
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = reverse_bits(i, levels);
-        if (j > i) {
-            vv_dsp_cpx t = data[i];
-            data[i] = data[j];
-            data[j] = t;
-        }
-    }
-
-    const vv_dsp_real PI = VV_DSP_PI;
-    for (size_t size = 2; size <= n; size <<= 1) {
-        vv_dsp_real theta = (vv_dsp_real)(-sign) * (vv_dsp_real)2.0 * PI / (vv_dsp_real)size;
-        vv_dsp_real wpr = VV_DSP_COS(theta);
-        vv_dsp_real wpi = VV_DSP_SIN(theta);
-        for (size_t start = 0; start < n; start += size) {
-            vv_dsp_real wr = (vv_dsp_real)1.0;
-            vv_dsp_real wi = (vv_dsp_real)0.0;
-            size_t half = size >> 1;
-            for (size_t k = 0; k < half; ++k) {
-                vv_dsp_cpx* even = &data[start + k];
-                vv_dsp_cpx* odd  = &data[start + k + half];
-                vv_dsp_real tr = wr * odd->re - wi * odd->im;
-                vv_dsp_real ti = wr * odd->im + wi * odd->re;
-                odd->re = even->re - tr;
-                odd->im = even->im - ti;
-                even->re += tr;
-                even->im += ti;
-                // Update twiddle (complex multiply by w)
-                vv_dsp_real new_wr = wr * wpr - wi * wpi;
-                vv_dsp_real new_wi = wr * wpi + wi * wpr;
-                wr = new_wr; wi = new_wi;
+    for (size_t t = n; t > 1; t >>= 1) levels++;
+    st->algo = KISS_ALGO_POW2;
+    st->radix2_first = (int)(levels & 1u);
+    st->bitrev = (size_t*)vv_dsp_malloc(sizeof(size_t) * n);
+    // Radix-4 passes store 3*h contiguous twiddles each; the sum stays below n
+    st->twiddles = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * n);
+    if (!st->bitrev || !st->twiddles) return 0;
+    for (size_t i = 0; i < n; ++i) st->bitrev[i] = reverse_bits(i, levels);
+    vv_dsp_cpx* tw = st->twiddles;
+    for (size_t h = st->radix2_first ? 2 : 1; 4 * h <= n; h *= 4) {
+        for (size_t j = 1; j <= 3; ++j) {
+            for (size_t k = 0; k < h; ++k) {
+                const double ang = -(double)sign * VV_DSP_TWO_PI_D * (double)(j * k) / (double)(4 * h);
+                tw[(j - 1) * h + k] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
             }
         }
+        tw += 3 * h;
+    }
+    return 1;
+}
+
+static kiss_cfft* cfft_alloc(size_t n, int sign, size_t nthreads) {
+    kiss_cfft* st = (kiss_cfft*)vv_dsp_calloc(1, sizeof(kiss_cfft));
+    if (!st) return NULL;
+    st->n = n;
+    st->sign = sign;
+
+    if (nthreads > 1 && is_power_of_two(n) && n >= KISS_FOURSTEP_MIN_N) {
+        unsigned int levels = 0;
+        for (size_t t = n; t > 1; t >>= 1) levels++;
+        st->algo = KISS_ALGO_FOURSTEP;
+        st->n1 = (size_t)1 << (levels / 2);
+        st->n2 = n / st->n1;
+        st->nthreads = nthreads > KISS_MAX_THREADS ? KISS_MAX_THREADS : nthreads;
+        st->work_len = 2 * n;
+        // Row engines are always direct: the passes call fft_pow2 on them
+        st->sub = (kiss_cfft*)vv_dsp_calloc(1, sizeof(kiss_cfft));
+        st->sub2 = (kiss_cfft*)vv_dsp_calloc(1, sizeof(kiss_cfft));
+        if (st->sub) { st->sub->n = st->n1; st->sub->sign = sign; }
+        if (st->sub2) { st->sub2->n = st->n2; st->sub2->sign = sign; }
+        st->tw_hi = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * st->n2);
+        st->tw_lo = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * st->n1);
+        if (!st->sub || !st->sub2 || !pow2_init(st->sub) || !pow2_init(st->sub2) || !st->tw_hi || !st->tw_lo) { cfft_free(st); return NULL; }
+        for (size_t a = 0; a < st->n2; ++a) {
+            const double ang = -(double)sign * VV_DSP_TWO_PI_D * (double)(a * st->n1) / (double)n;
+            st->tw_hi[a] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
+        }
+        fill_roots(st->tw_lo, st->n1, n, sign);
+        return st;
+    }
+
+    if (is_power_of_two(n) && n >= 2 && n <= VV_DSP_FFT_SMALL_MAX) {
+        st->algo = KISS_ALGO_SMALL;
+        return st;
     }
 
-    // Backward: scale by 1/n
-    if (sign < 0) {
-        vv_dsp_real invn = (vv_dsp_real)1.0 / (vv_dsp_real)n;
-        for (size_t i = 0; i < n; ++i) { data[i].re *= invn; data[i].im *= invn; }
+    if (is_power_of_two(n)) {
+        if (!pow2_init(st)) { cfft_free(st); return NULL; }
+        return st;
     }
+
+    size_t maxp = factorize(n, st->factors);
+    if (maxp != 0 && maxp <= KISS_MAX_GENERIC_RADIX) {
+        st->algo = KISS_ALGO_MIXED;
+        st->twiddles = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * n);
+        st->work_len = maxp;
+        if (!st->twiddles) { cfft_free(st); return NULL; }
+        fill_roots(st->twiddles, n, n, sign);
+        return st;
+    }
+
+    // Bluestein: X[k] = w[k] * sum_t (x[t] w[t]) conj(w[k-t]), w[k] = exp(-sign*i*pi*k^2/n),
+    // evaluated as a circular convolution of power-of-two length M >= 2n-1.
+    st->algo = KISS_ALGO_BLUESTEIN;
+    size_t M = 1;
+    while (M < 2 * n - 1) M <<= 1;
+    st->sub = cfft_alloc(M, +1, nthreads);
+    st->chirp = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * n);
+    st->chirp_fft = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * M);
+    vv_dsp_cpx* filt = NULL;
+    vv_dsp_cpx* sub_work = NULL;
+    if (st->sub) {
+        st->work_len = 2 * M + st->sub->work_len;
+        filt = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * (M + st->sub->work_len));
+        sub_work = filt ? filt + M : NULL;
+    }
+    if (!st->sub || !st->chirp || !st->chirp_fft || !filt) { vv_dsp_free(filt); cfft_free(st); return NULL; }
+    for (size_t k = 0; k < n; ++k) {
+        // k^2 mod 2n keeps the angle argument small for large k
+        const size_t k2 = (size_t)(((unsigned long long)k * k) % (2ULL * n));
+        const double ang = -(double)sign * VV_DSP_PI_D * (double)k2 / (double)n;
+        st->chirp[k] = vv_dsp_cpx_make((vv_dsp_real)cos(ang), (vv_dsp_real)sin(ang));
+    }
+    for (size_t i = 0; i < M; ++i) filt[i] = vv_dsp_cpx_make(0, 0);
+    filt[0] = vv_dsp_cpx_make(st->chirp[0].re, -st->chirp[0].im);
+    for (size_t k = 1; k < n; ++k) {
+        const vv_dsp_cpx c = vv_dsp_cpx_make(st->chirp[k].re, -st->chirp[k].im);
+        filt[k] = c;
+        filt[M - k] = c;
+    }
+    cfft_raw(st->sub, filt, st->chirp_fft, sub_work);
+    vv_dsp_free(filt);
+    return st;
 }
 
-static void dft_naive(const vv_dsp_cpx* in, vv_dsp_cpx* out, size_t n, int sign) {
-    const vv_dsp_real PI = VV_DSP_PI;
-    const vv_dsp_real one = (vv_dsp_real)1.0;
-    const vv_dsp_real two = (vv_dsp_real)2.0;
-    const vv_dsp_real scale = (sign < 0) ? (one/(vv_dsp_real)n) : one; // backward scales by 1/n
+static void bluestein_exec(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_cpx* work) {
+    const size_t n = st->n;
+    const size_t M = st->sub->n;
+    vv_dsp_cpx* a = work;
+    vv_dsp_cpx* b = work + M;
+    vv_dsp_cpx* sub_work = work + 2 * M;
+    for (size_t t = 0; t < n; ++t) a[t] = cmul(in[t], st->chirp[t]);
+    for (size_t t = n; t < M; ++t) a[t] = vv_dsp_cpx_make(0, 0);
+    cfft_raw(st->sub, a, b, sub_work);
+    // Pointwise product, then inverse as conj(FFT(conj(.))) / M so one forward
+    // engine serves both directions
+    for (size_t i = 0; i < M; ++i) {
+        vv_dsp_cpx v = cmul(b[i], st->chirp_fft[i]);
+        b[i] = vv_dsp_cpx_make(v.re, -v.im);
+    }
+    cfft_raw(st->sub, b, a, sub_work);
+    const vv_dsp_real invM = (vv_dsp_real)1.0 / (vv_dsp_real)M;
     for (size_t k = 0; k < n; ++k) {
-        vv_dsp_real sum_re = 0, sum_im = 0;
-        for (size_t t = 0; t < n; ++t) {
-            vv_dsp_real ang = (vv_dsp_real)(-sign) * two * PI * (vv_dsp_real)(k * t) / (vv_dsp_real)n;
-            vv_dsp_real c = VV_DSP_COS(ang), s = VV_DSP_SIN(ang);
-            sum_re += in[t].re * c - in[t].im * s;
-            sum_im += in[t].re * s + in[t].im * c;
+        vv_dsp_cpx c = vv_dsp_cpx_make(a[k].re * invM, -a[k].im * invM);
+        out[k] = cmul(c, st->chirp[k]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Four-step engine. With n = n1 * n2, input index t = n2*t1 + t2 and output
+// index k = k1 + n1*k2:
+//   X[k] = sum_t2 W_n^(t2*k1) [sum_t1 x[n2*t1 + t2] W_n1^(t1*k1)] W_n2^(t2*k2)
+// Pass 1 gathers the n2 strided columns into rows, runs the length-n1 row
+// FFTs and applies W_n^(t2*k1); pass 2 transposes and runs the length-n2 row
+// FFTs; pass 3 transposes into the natural output order. Every FFT works on a
+// contiguous row, and each pass splits its rows across worker threads.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const kiss_cfft* st;
+    const vv_dsp_cpx* in;
+    vv_dsp_cpx* out;
+    vv_dsp_cpx* a;      // n entries
+    vv_dsp_cpx* b;      // n entries
+} fourstep_ctx;
+
+typedef void (*kiss_task_fn)(const fourstep_ctx* ctx, size_t begin, size_t end);
+
+typedef struct {
+    kiss_task_fn fn;
+    const fourstep_ctx* ctx;
+    size_t count;
+} kiss_job;
+
+// Blocks [b0, b1) of a pass
+static void kiss_block_range(void* arg, size_t b0, size_t b1, size_t worker) {
+    const kiss_job* job = (const kiss_job*)arg;
+    const size_t begin = b0 * KISS_FOURSTEP_BLOCK;
+    const size_t end = b1 * KISS_FOURSTEP_BLOCK;
+    (void)worker;
+    job->fn(job->ctx, begin, end < job->count ? end : job->count);
+}
+
+// Split [0, count) into nthreads chunks on KISS_FOURSTEP_BLOCK boundaries, so
+// workers never share a transpose block, and run them on the default thread
+// pool. Without a pool every chunk runs inline.
+static void kiss_parallel_for(size_t nthreads, size_t count, kiss_task_fn fn, const fourstep_ctx* ctx) {
+    const size_t nblocks = (count + KISS_FOURSTEP_BLOCK - 1) / KISS_FOURSTEP_BLOCK;
+    if (nthreads > nblocks) nthreads = nblocks;
+    if (nthreads <= 1) { fn(ctx, 0, count); return; }
+    kiss_job job = { fn, ctx, count };
+    if (vv_dsp_threadpool_parallel_for(NULL, nblocks, (nblocks + nthreads - 1) / nthreads,
+                                       kiss_block_range, &job) != VV_DSP_OK) {
+        fn(ctx, 0, count);
+    }
+}
+
+// Pass 1 over columns t2: gather x[n2*t1 + t2] into row t2 of a, FFT into b, twiddle
+static void fourstep_pass1(const fourstep_ctx* c, size_t begin, size_t end) {
+    const kiss_cfft* st = c->st;
+    const size_t n1 = st->n1, n2 = st->n2;
+    for (size_t c0 = begin; c0 < end; c0 += KISS_FOURSTEP_BLOCK) {
+        const size_t cb = (end - c0 < KISS_FOURSTEP_BLOCK) ? end - c0 : KISS_FOURSTEP_BLOCK;
+        for (size_t t1 = 0; t1 < n1; ++t1) {
+            const vv_dsp_cpx* src = c->in + n2 * t1 + c0;
+            for (size_t j = 0; j < cb; ++j) c->a[(c0 + j) * n1 + t1] = src[j];
+        }
+        for (size_t j = 0; j < cb; ++j) {
+            const size_t t2 = c0 + j;
+            vv_dsp_cpx* row = c->b + t2 * n1;
+            fft_pow2(st->sub, c->a + t2 * n1, row);
+            for (size_t k1 = 1; k1 < n1; ++k1) {
+                const size_t m = t2 * k1;  // < n, no reduction needed
+                const vv_dsp_cpx w = cmul(st->tw_hi[m / n1], st->tw_lo[m % n1]);
+                row[k1] = cmul(row[k1], w);
+            }
+        }
+    }
+}
+
+// Pass 2 over rows k1 of a: transpose b (n2 x n1) into a (n1 x n2)
+static void fourstep_pass2(const fourstep_ctx* c, size_t begin, size_t end) {
+    const size_t n1 = c->st->n1, n2 = c->st->n2;
+    for (size_t k0 = begin; k0 < end; k0 += KISS_FOURSTEP_BLOCK) {
+        const size_t cb = (end - k0 < KISS_FOURSTEP_BLOCK) ? end - k0 : KISS_FOURSTEP_BLOCK;
+        for (size_t t2 = 0; t2 < n2; ++t2) {
+            const vv_dsp_cpx* src = c->b + t2 * n1 + k0;
+            for (size_t j = 0; j < cb; ++j) c->a[(k0 + j) * n2 + t2] = src[j];
+        }
+    }
+}
+
+// Pass 3 over rows k1: FFT row k1 of a into b, scatter it to out[k2*n1 + k1]
+static void fourstep_pass3(const fourstep_ctx* c, size_t begin, size_t end) {
+    const kiss_cfft* st = c->st;
+    const size_t n1 = st->n1, n2 = st->n2;
+    for (size_t k0 = begin; k0 < end; k0 += KISS_FOURSTEP_BLOCK) {
+        const size_t cb = (end - k0 < KISS_FOURSTEP_BLOCK) ? end - k0 : KISS_FOURSTEP_BLOCK;
+        for (size_t j = 0; j < cb; ++j) {
+            fft_pow2(st->sub2, c->a + (k0 + j) * n2, c->b + (k0 + j) * n2);
+        }
+        for (size_t k2 = 0; k2 < n2; ++k2) {
+            vv_dsp_cpx* dst = c->out + k2 * n1 + k0;
+            for (size_t j = 0; j < cb; ++j) dst[j] = c->b[(k0 + j) * n2 + k2];
         }
-        out[k].re = sum_re * scale;
-        out[k].im = sum_im * scale;
     }
 }
 
-// KissFFT backend implementation using vtable interface
+static void fourstep_exec(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_cpx* work) {
+    fourstep_ctx c;
+    c.st = st;
+    c.in = in;
+    c.out = out;
+    c.a = work;
+    c.b = work + st->n;
+    kiss_parallel_for(st->nthreads, st->n2, fourstep_pass1, &c);
+    kiss_parallel_for(st->nthreads, st->n1, fourstep_pass2, &c);
+    kiss_parallel_for(st->nthreads, st->n1, fourstep_pass3, &c);
+}
+
+// Out-of-place complex transform without scaling; `work` provides
+// st->work_len entries of scratch.
+static void cfft_raw(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_cpx* work) {
+    switch (st->algo) {
+        case KISS_ALGO_POW2: fft_pow2(st, in, out); break;
+        case KISS_ALGO_MIXED: mixed_work(st, out, in, 1, st->factors, work); break;
+        case KISS_ALGO_BLUESTEIN: bluestein_exec(st, in, out, work); break;
+        case KISS_ALGO_FOURSTEP: fourstep_exec(st, in, out, work); break;
+        case KISS_ALGO_SMALL: (void)vv_dsp_fft_small_raw(st->n, st->sign, in, out); break;
+    }
+}
+
+// Out-of-place complex transform (`in` and `out` must not alias) with the
+// library's scaling convention: backward transforms are scaled by 1/n.
+// `work` provides st->work_len entries of scratch.
+static void cfft_exec(const kiss_cfft* st, const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_cpx* work) {
+    cfft_raw(st, in, out, work);
+    if (st->sign < 0) {
+        const vv_dsp_real invn = (vv_dsp_real)1.0 / (vv_dsp_real)st->n;
+        for (size_t i = 0; i < st->n; ++i) { out[i].re *= invn; out[i].im *= invn; }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Real-input helpers
+// ---------------------------------------------------------------------------
+
+// Real-FFT post-processing for even n. `z` holds the n/2-point forward FFT of
+// x[2k] + i*x[2k+1]; writes the n/2+1 Hermitian bins of the n-point real FFT:
+//   E[k] = (Z[k] + conj(Z[m-k])) / 2,  O[k] = (Z[k] - conj(Z[m-k])) / 2i
+//   X[k] = E[k] + W^k O[k],  W = exp(-2*pi*i/n)
+static void fft_real_split(const vv_dsp_cpx* rtw, const vv_dsp_cpx* z, vv_dsp_cpx* X, size_t n) {
+    const size_t m = n / 2;
+    const vv_dsp_real half = (vv_dsp_real)0.5;
+    X[0] = vv_dsp_cpx_make(z[0].re + z[0].im, (vv_dsp_real)0.0);
+    X[m] = vv_dsp_cpx_make(z[0].re - z[0].im, (vv_dsp_real)0.0);
+    for (size_t k = 1; k <= m / 2; ++k) {
+        const size_t j = m - k;
+        const vv_dsp_real wr = rtw[k].re;
+        const vv_dsp_real wi = rtw[k].im;
+        const vv_dsp_real er = half * (z[k].re + z[j].re);
+        const vv_dsp_real ei = half * (z[k].im - z[j].im);
+        const vv_dsp_real or_ = half * (z[k].im + z[j].im);
+        const vv_dsp_real oi = half * (z[j].re - z[k].re);
+        const vv_dsp_real tr = wr * or_ - wi * oi;
+        const vv_dsp_real ti = wr * oi + wi * or_;
+        X[k] = vv_dsp_cpx_make(er + tr, ei + ti);
+        // Bin m-k uses W^(m-k) = -conj(W^k) and the mirrored E/O terms
+        X[j] = vv_dsp_cpx_make(er - tr, ti - ei);
+    }
+}
+
+// Inverse of fft_real_split: rebuilds the n/2-point spectrum Z = E + i*O from
+// the n/2+1 Hermitian bins so that an n/2-point inverse yields x[2k] + i*x[2k+1].
+static void fft_real_merge(const vv_dsp_cpx* rtw, const vv_dsp_cpx* X, vv_dsp_cpx* z, size_t n) {
+    const size_t m = n / 2;
+    const vv_dsp_real half = (vv_dsp_real)0.5;
+    for (size_t k = 0; k < m; ++k) {
+        const size_t j = m - k;
+        const vv_dsp_real wr = rtw[k].re;
+        const vv_dsp_real wi = -rtw[k].im; // W^-k
+        const vv_dsp_real er = half * (X[k].re + X[j].re);
+        const vv_dsp_real ei = half * (X[k].im - X[j].im);
+        const vv_dsp_real dr = half * (X[k].re - X[j].re);
+        const vv_dsp_real di = half * (X[k].im + X[j].im);
+        const vv_dsp_real or_ = dr * wr - di * wi;
+        const vv_dsp_real oi = dr * wi + di * wr;
+        z[k] = vv_dsp_cpx_make(er - oi, ei + or_);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Backend vtable implementation
+// ---------------------------------------------------------------------------
+
+static void kiss_free_plan(void* backend_data) {
+    kiss_plan_data* pd = (kiss_plan_data*)backend_data;
+    if (!pd) return;
+    cfft_free(pd->cfft);
+    vv_dsp_free(pd->real_tw);
+    vv_dsp_free(pd->scratch);
+    vv_dsp_free(pd->split_stage);
+    vv_dsp_free(pd);
+}
+
 static vv_dsp_status kiss_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
-    (void)spec; // KissFFT is stateless
-    *backend_data = NULL; // No backend-specific data needed
+    if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
+    *backend_data = NULL;
+    const size_t n = spec->n;
+    const int real_even = (spec->type != VV_DSP_FFT_C2C) && n >= 2 && (n % 2) == 0;
+    int sign;
+    if (spec->type == VV_DSP_FFT_C2C) sign = (spec->dir == VV_DSP_FFT_FORWARD) ? +1 : -1;
+    else sign = (spec->type == VV_DSP_FFT_R2C) ? +1 : -1;
+
+    kiss_plan_data* pd = (kiss_plan_data*)vv_dsp_calloc(1, sizeof(kiss_plan_data));
+    if (!pd) return VV_DSP_ERROR_INTERNAL;
+    const size_t m = real_even ? n / 2 : n;
+
+    // Scratch: C2C needs n for in-place calls, even real transforms need
+    // z + Z (2*m), odd real transforms need two complex n buffers.
+    // The engine's own work area follows.
+    pd->scratch_len = (spec->type == VV_DSP_FFT_C2C) ? n : (real_even ? 2 * m : 2 * n);
+    pd->cfft = cfft_alloc(m, sign, spec->nthreads);
+    if (!pd->cfft) { kiss_free_plan(pd); return VV_DSP_ERROR_INTERNAL; }
+    pd->scratch = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * (pd->scratch_len + pd->cfft->work_len));
+    if (!pd->scratch) { kiss_free_plan(pd); return VV_DSP_ERROR_INTERNAL; }
+
+    if (real_even) {
+        pd->real_tw = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * m);
+        if (!pd->real_tw) { kiss_free_plan(pd); return VV_DSP_ERROR_INTERNAL; }
+        fill_roots(pd->real_tw, m, n, +1);
+    }
+
+    // Allocated up front so split execution stays allocation-free
+    pd->split_stage = (vv_dsp_cpx*)vv_dsp_malloc(sizeof(vv_dsp_cpx) * ((spec->type == VV_DSP_FFT_C2C) ? n : n / 2 + 1));
+    if (!pd->split_stage) { kiss_free_plan(pd); return VV_DSP_ERROR_INTERNAL; }
+
+    *backend_data = pd;
     return VV_DSP_OK;
 }
 
-static vv_dsp_status kiss_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
-    (void)backend_data;
-    if (!spec || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+// Shared by kiss_execute (plan-owned scratch) and kiss_execute_ws (caller
+// memory); `ws` holds pd->scratch_len + pd->cfft->work_len entries.
+static vv_dsp_status kiss_exec_impl(const struct vv_dsp_fft_plan* spec, const kiss_plan_data* pd,
+                                    const void* in, void* out, vv_dsp_cpx* ws) {
     const size_t n = spec->n;
+    vv_dsp_cpx* work = ws + pd->scratch_len;
 
     if (spec->type == VV_DSP_FFT_C2C) {
-        int sign = (spec->dir == VV_DSP_FFT_FORWARD) ? +1 : -1;
-        if (is_power_of_two(n)) {
-            // Copy input to out, operate in-place
-            const vv_dsp_cpx* cin = (const vv_dsp_cpx*)in;
-            vv_dsp_cpx* cout = (vv_dsp_cpx*)out;
-            if (cout != cin) memcpy(cout, cin, sizeof(vv_dsp_cpx)*n);
-            fft_iterative_radix2(cout, n, sign);
-        } else {
-            dft_naive((const vv_dsp_cpx*)in, (vv_dsp_cpx*)out, n, sign);
+        const vv_dsp_cpx* cin = (const vv_dsp_cpx*)in;
+        vv_dsp_cpx* cout = (vv_dsp_cpx*)out;
+        if (cout == cin) {
+            memcpy(ws, cin, sizeof(vv_dsp_cpx) * n);
+            cin = ws;
         }
+        cfft_exec(pd->cfft, cin, cout, work);
         return VV_DSP_OK;
     }
 
     if (spec->type == VV_DSP_FFT_R2C) {
-        // Build complex input from real, run C2C forward, then keep first n/2+1 bins
         const vv_dsp_real* rin = (const vv_dsp_real*)in;
-        vv_dsp_cpx* tmp_in = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx) * n);
-        vv_dsp_cpx* tmp_out = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx) * n);
-        if (!tmp_in || !tmp_out) { free(tmp_in); free(tmp_out); return VV_DSP_ERROR_INTERNAL; }
-        for (size_t i = 0; i < n; ++i) tmp_in[i] = vv_dsp_cpx_make(rin[i], 0);
-
-        // Use fast FFT for power-of-two sizes, naive DFT for others
-        if (is_power_of_two(n)) {
-            memcpy(tmp_out, tmp_in, sizeof(vv_dsp_cpx) * n);
-            fft_iterative_radix2(tmp_out, n, +1);
-        } else {
-            dft_naive(tmp_in, tmp_out, n, +1);
-        }
-
-        size_t nh = n/2 + 1;
         vv_dsp_cpx* cout = (vv_dsp_cpx*)out;
-        memcpy(cout, tmp_out, sizeof(vv_dsp_cpx) * nh);
-
-        // Ensure Nyquist component is real for even-sized inputs
-        if (n % 2 == 0 && nh > 1) {
-            cout[nh-1].im = (vv_dsp_real)0.0;
+        if (pd->real_tw) {
+            // Even n: pack x[2k] + i*x[2k+1] into an n/2 complex FFT, then split
+            const size_t m = n / 2;
+            vv_dsp_cpx* z = ws;
+            vv_dsp_cpx* Z = ws + m;
+            for (size_t k = 0; k < m; ++k) z[k] = vv_dsp_cpx_make(rin[2*k], rin[2*k+1]);
+            cfft_exec(pd->cfft, z, Z, work);
+            fft_real_split(pd->real_tw, Z, cout, n);
+            return VV_DSP_OK;
         }
 
-        free(tmp_in); free(tmp_out);
+        // Odd n: promote to complex and run a full-length transform
+        vv_dsp_cpx* tmp_in = ws;
+        vv_dsp_cpx* tmp_out = ws + n;
+        for (size_t i = 0; i < n; ++i) tmp_in[i] = vv_dsp_cpx_make(rin[i], 0);
+        cfft_exec(pd->cfft, tmp_in, tmp_out, work);
+        memcpy(cout, tmp_out, sizeof(vv_dsp_cpx) * (n/2 + 1));
         return VV_DSP_OK;
     }
 
     if (spec->type == VV_DSP_FFT_C2R) {
-        // Expand Hermitian-packed input to full spectrum, run inverse, which scales by 1/n
         vv_dsp_real* rout = (vv_dsp_real*)out;
-        const size_t nh = n/2 + 1;
         const vv_dsp_cpx* inhp = (const vv_dsp_cpx*)in;
-        vv_dsp_cpx* full = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx) * n);
-        vv_dsp_cpx* time = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx) * n);
-        if (!full || !time) { free(full); free(time); return VV_DSP_ERROR_INTERNAL; }
-        // k=0..nh-1 copy, then reconstruct k=nh..n-1 from conjugate symmetry
+        if (pd->real_tw) {
+            // Even n: merge the half spectrum into an n/2 complex inverse,
+            // whose 1/(n/2) scaling matches the 1/n of the full-length inverse
+            const size_t m = n / 2;
+            vv_dsp_cpx* Z = ws;
+            vv_dsp_cpx* z = ws + m;
+            fft_real_merge(pd->real_tw, inhp, Z, n);
+            cfft_exec(pd->cfft, Z, z, work);
+            for (size_t k = 0; k < m; ++k) { rout[2*k] = z[k].re; rout[2*k+1] = z[k].im; }
+            return VV_DSP_OK;
+        }
+
+        // Odd n: expand Hermitian-packed input to full spectrum, run inverse (scales by 1/n)
+        const size_t nh = n/2 + 1;
+        vv_dsp_cpx* full = ws;
+        vv_dsp_cpx* time = ws + n;
         for (size_t k = 0; k < nh; ++k) full[k] = inhp[k];
         for (size_t k = nh; k < n; ++k) {
-            size_t m = n - k; // mirror index
-            if (m < nh && m > 0) {  // Ensure valid index and skip DC
-                vv_dsp_cpx v = inhp[m];
-                full[k].re = v.re;
-                full[k].im = -v.im;
-            } else {
-                full[k].re = (vv_dsp_real)0.0;
-                full[k].im = (vv_dsp_real)0.0;
-            }
+            vv_dsp_cpx v = inhp[n - k];
+            full[k].re = v.re;
+            full[k].im = -v.im;
         }
-        dft_naive(full, time, n, -1);
+        cfft_exec(pd->cfft, full, time, work);
         for (size_t i = 0; i < n; ++i) rout[i] = time[i].re; // imaginary should be ~0
-        free(full); free(time);
         return VV_DSP_OK;
     }
 
     return VV_DSP_ERROR_OUT_OF_RANGE;
 }
 
-static void kiss_free_plan(void* backend_data) {
-    (void)backend_data; // Nothing to free for stateless KissFFT
+static vv_dsp_status kiss_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
+    if (!spec || !in || !out || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
+    const kiss_plan_data* pd = (const kiss_plan_data*)backend_data;
+    return kiss_exec_impl(spec, pd, in, out, pd->scratch);
+}
+
+static size_t kiss_workspace_size(const struct vv_dsp_fft_plan* spec, const void* backend_data) {
+    (void)spec;
+    const kiss_plan_data* pd = (const kiss_plan_data*)backend_data;
+    return pd ? sizeof(vv_dsp_cpx) * (pd->scratch_len + pd->cfft->work_len) : 0;
+}
+
+static vv_dsp_status kiss_execute_ws(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                     const void* in, void* out, void* ws) {
+    if (!spec || !in || !out || !backend_data || !ws) return VV_DSP_ERROR_NULL_POINTER;
+    return kiss_exec_impl(spec, (const kiss_plan_data*)backend_data, in, out, (vv_dsp_cpx*)ws);
+}
+
+// Split-complex execute: the complex side is staged through one interleaved
+// buffer (C2C runs in place on it), so only the layout conversions are extra
+static vv_dsp_status kiss_execute_split(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                        const vv_dsp_real* in_re, const vv_dsp_real* in_im,
+                                        vv_dsp_real* out_re, vv_dsp_real* out_im) {
+    if (!spec || !backend_data || !in_re || !out_re) return VV_DSP_ERROR_NULL_POINTER;
+    kiss_plan_data* pd = (kiss_plan_data*)backend_data;
+    const size_t len = (spec->type == VV_DSP_FFT_C2C) ? spec->n : spec->n / 2 + 1;
+    vv_dsp_cpx* stage = pd->split_stage;
+    vv_dsp_status st;
+    switch (spec->type) {
+        case VV_DSP_FFT_C2C:
+            st = vv_dsp_split_to_cpx(in_re, in_im, stage, len);
+            if (st == VV_DSP_OK) st = kiss_exec_impl(spec, pd, stage, stage, pd->scratch);
+            if (st == VV_DSP_OK) st = vv_dsp_cpx_to_split(stage, out_re, out_im, len);
+            return st;
+        case VV_DSP_FFT_R2C:
+            st = kiss_exec_impl(spec, pd, in_re, stage, pd->scratch);
+            if (st == VV_DSP_OK) st = vv_dsp_cpx_to_split(stage, out_re, out_im, len);
+            return st;
+        case VV_DSP_FFT_C2R:
+            st = vv_dsp_split_to_cpx(in_re, in_im, stage, len);
+            if (st == VV_DSP_OK) st = kiss_exec_impl(spec, pd, stage, out_re, pd->scratch);
+            return st;
+        default:
+            return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
 }
 
 static int kiss_is_available(void) {
@@ -189,20 +974,23 @@ const vv_dsp_fft_backend_vtable vv_dsp_fft_kiss_vtable = {
     .make_plan = kiss_make_plan,
     .execute = kiss_execute,
     .free_plan = kiss_free_plan,
+    .workspace_size = kiss_workspace_size,
+    .execute_ws = kiss_execute_ws,
+    .execute_split = kiss_execute_split,
     .is_available = kiss_is_available,
     .name = "KissFFT"
 };
 
 // Legacy backend interface compatibility
 vv_dsp_status vv_dsp_fft_backend_make(const struct vv_dsp_fft_plan* spec, void** backend) {
-    if (!spec || spec->backend >= 3) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!spec || spec->backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
     const vv_dsp_fft_backend_vtable* vtable = g_fft_backends[spec->backend];
     if (!vtable || !vtable->is_available()) return VV_DSP_ERROR_UNSUPPORTED;
     return vtable->make_plan(spec, backend);
 }
 
 vv_dsp_status vv_dsp_fft_backend_exec(const struct vv_dsp_fft_plan* spec, void* backend, const void* in, void* out) {
-    if (!spec || spec->backend >= 3) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!spec || spec->backend >= VV_DSP_FFT_BACKEND_COUNT) return VV_DSP_ERROR_OUT_OF_RANGE;
     const vv_dsp_fft_backend_vtable* vtable = g_fft_backends[spec->backend];
     if (!vtable || !vtable->is_available()) return VV_DSP_ERROR_UNSUPPORTED;
     return vtable->execute(spec, backend, in, out);
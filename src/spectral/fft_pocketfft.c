@@ -0,0 +1,162 @@
+/*
+This file is part of vv-dsp
+
+PocketFFT backend for the vv-dsp FFT abstraction layer.
+
+PocketFFT (the C version used by NumPy) is a self-contained FFTPACK descendant
+with mixed-radix kernels and Bluestein's algorithm for large prime factors, so
+it plans every length with near-O(n log n) cost and no external dependency. It
+works in double precision; float builds stage through the workspace.
+*/
+
+#include "fft_backend.h"
+
+#ifdef VV_DSP_BACKEND_FFT_pocketfft
+
+#include <stdlib.h>
+#include <string.h>
+#include <pocketfft.h>
+#include "vv_dsp/core/alloc.h"
+
+// Plans are read-only after creation (PocketFFT allocates its own scratch per
+// call), so one plan may run on several threads with separate workspaces
+typedef struct {
+    cfft_plan cplan;  // C2C
+    rfft_plan rplan;  // R2C / C2R
+    double* buf;      // 2*n doubles for execute()
+} pocketfft_plan_wrapper;
+
+static void pocketfft_free_plan(void* backend_data) {
+    if (!backend_data) return;
+    pocketfft_plan_wrapper* w = (pocketfft_plan_wrapper*)backend_data;
+    if (w->cplan) destroy_cfft_plan(w->cplan);
+    if (w->rplan) destroy_rfft_plan(w->rplan);
+    vv_dsp_free(w->buf);
+    vv_dsp_free(w);
+}
+
+static vv_dsp_status pocketfft_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
+    if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
+    if (spec->type != VV_DSP_FFT_C2C && spec->type != VV_DSP_FFT_R2C && spec->type != VV_DSP_FFT_C2R) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    pocketfft_plan_wrapper* w = (pocketfft_plan_wrapper*)vv_dsp_malloc(sizeof(*w));
+    if (!w) return VV_DSP_ERROR_INTERNAL;
+    w->cplan = NULL;
+    w->rplan = NULL;
+    w->buf = (double*)vv_dsp_malloc(2 * spec->n * sizeof(double));
+    if (spec->type == VV_DSP_FFT_C2C) {
+        w->cplan = make_cfft_plan(spec->n);
+    } else {
+        w->rplan = make_rfft_plan(spec->n);
+    }
+    if (!w->buf || (!w->cplan && !w->rplan)) {
+        pocketfft_free_plan(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *backend_data = w;
+    return VV_DSP_OK;
+}
+
+// buf: 2*n doubles. Real transforms use PocketFFT's FFTPACK half-complex order
+// r0, r1, i1, r2, i2, ... (plus r(n/2) last for even n)
+static vv_dsp_status pocketfft_exec_impl(const struct vv_dsp_fft_plan* spec, const pocketfft_plan_wrapper* w,
+                                         const void* in, void* out, double* buf) {
+    const size_t n = spec->n;
+    const double inv_n = 1.0 / (double)n;
+    if (spec->type == VV_DSP_FFT_C2C) {
+        const vv_dsp_cpx* x = (const vv_dsp_cpx*)in;
+        vv_dsp_cpx* y = (vv_dsp_cpx*)out;
+        for (size_t i = 0; i < n; ++i) {
+            buf[2 * i] = (double)x[i].re;
+            buf[2 * i + 1] = (double)x[i].im;
+        }
+        const int rc = spec->dir == VV_DSP_FFT_FORWARD ? cfft_forward(w->cplan, buf, 1.0)
+                                                       : cfft_backward(w->cplan, buf, inv_n);
+        if (rc != 0) return VV_DSP_ERROR_INTERNAL;
+        for (size_t i = 0; i < n; ++i) {
+            y[i].re = (vv_dsp_real)buf[2 * i];
+            y[i].im = (vv_dsp_real)buf[2 * i + 1];
+        }
+        return VV_DSP_OK;
+    }
+    const size_t half = (n - 1) / 2;  // bins with both parts stored
+    if (spec->type == VV_DSP_FFT_R2C) {
+        const vv_dsp_real* x = (const vv_dsp_real*)in;
+        vv_dsp_cpx* y = (vv_dsp_cpx*)out;
+        for (size_t i = 0; i < n; ++i) buf[i] = (double)x[i];
+        if (rfft_forward(w->rplan, buf, 1.0) != 0) return VV_DSP_ERROR_INTERNAL;
+        y[0].re = (vv_dsp_real)buf[0];
+        y[0].im = 0;
+        for (size_t k = 1; k <= half; ++k) {
+            y[k].re = (vv_dsp_real)buf[2 * k - 1];
+            y[k].im = (vv_dsp_real)buf[2 * k];
+        }
+        if ((n & 1) == 0) {
+            y[n / 2].re = (vv_dsp_real)buf[n - 1];
+            y[n / 2].im = 0;
+        }
+        return VV_DSP_OK;
+    }
+    const vv_dsp_cpx* x = (const vv_dsp_cpx*)in;
+    vv_dsp_real* y = (vv_dsp_real*)out;
+    buf[0] = (double)x[0].re;
+    for (size_t k = 1; k <= half; ++k) {
+        buf[2 * k - 1] = (double)x[k].re;
+        buf[2 * k] = (double)x[k].im;
+    }
+    if ((n & 1) == 0) buf[n - 1] = (double)x[n / 2].re;
+    if (rfft_backward(w->rplan, buf, inv_n) != 0) return VV_DSP_ERROR_INTERNAL;
+    for (size_t i = 0; i < n; ++i) y[i] = (vv_dsp_real)buf[i];
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status pocketfft_execute(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                       const void* in, void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    pocketfft_plan_wrapper* w = (pocketfft_plan_wrapper*)backend_data;
+    return pocketfft_exec_impl(spec, w, in, out, w->buf);
+}
+
+static size_t pocketfft_workspace_size(const struct vv_dsp_fft_plan* spec, const void* backend_data) {
+    (void)backend_data;
+    return 2 * spec->n * sizeof(double) + sizeof(double);
+}
+
+static vv_dsp_status pocketfft_execute_ws(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                          const void* in, void* out, void* ws) {
+    if (!spec || !backend_data || !in || !out || !ws) return VV_DSP_ERROR_NULL_POINTER;
+    unsigned char* base = (unsigned char*)ws;
+    base += (sizeof(double) - ((size_t)base % sizeof(double))) % sizeof(double);
+    return pocketfft_exec_impl(spec, (const pocketfft_plan_wrapper*)backend_data, in, out, (double*)base);
+}
+
+static int pocketfft_is_available(void) {
+    return 1;
+}
+
+const vv_dsp_fft_backend_vtable vv_dsp_fft_pocketfft_vtable = {
+    .make_plan = pocketfft_make_plan,
+    .execute = pocketfft_execute,
+    .free_plan = pocketfft_free_plan,
+    .workspace_size = pocketfft_workspace_size,
+    .execute_ws = pocketfft_execute_ws,
+    .is_available = pocketfft_is_available,
+    .name = "PocketFFT"
+};
+
+#else
+
+static int pocketfft_not_available(void) {
+    return 0;
+}
+
+const vv_dsp_fft_backend_vtable vv_dsp_fft_pocketfft_vtable = {
+    .make_plan = NULL,
+    .execute = NULL,
+    .free_plan = NULL,
+    .is_available = pocketfft_not_available,
+    .name = "PocketFFT (not available)"
+};
+
+#endif // VV_DSP_BACKEND_FFT_pocketfft
@@ -0,0 +1,251 @@
+/*
+This file is part of vv-dsp
+
+Plan-free FFT and DCT-II kernels for power-of-two sizes up to 64. Each size
+and direction is its own function, generated below from one radix-2
+decimation-in-time template: the half-size kernels run on the even and odd
+samples and one combine pass joins them with twiddles read from a constant
+table, so after inlining every loop has a fixed trip count and every twiddle
+is a compile-time constant. The combine skips the multiplies by 1 and -i.
+*/
+
+#include <string.h>
+#include "vv_dsp/spectral/fft_small.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "fft_backend.h"
+
+#define R(v) ((vv_dsp_real)(v))
+
+// W_256^k = exp(-2 pi i k / 256), k < 128: W_n^k for n <= 64 is entry k * (256 / n),
+// and the DCT-II post-twiddle exp(-i pi k / (2n)) is entry k * (64 / n)
+static const vv_dsp_cpx small_tw[128] = {
+    {R(1.0), R(0.0)}, {R(0.99969881869620425), R(-0.024541228522912288)},
+    {R(0.99879545620517241), R(-0.049067674327418015)}, {R(0.99729045667869021), R(-0.073564563599667426)},
+    {R(0.99518472667219693), R(-0.098017140329560604)}, {R(0.99247953459870997), R(-0.1224106751992162)},
+    {R(0.98917650996478101), R(-0.14673047445536175)}, {R(0.98527764238894122), R(-0.17096188876030122)},
+    {R(0.98078528040323043), R(-0.19509032201612825)}, {R(0.97570213003852857), R(-0.2191012401568698)},
+    {R(0.97003125319454397), R(-0.24298017990326387)}, {R(0.96377606579543984), R(-0.26671275747489837)},
+    {R(0.95694033573220882), R(-0.29028467725446233)}, {R(0.94952818059303667), R(-0.31368174039889152)},
+    {R(0.94154406518302081), R(-0.33688985339222005)}, {R(0.93299279883473896), R(-0.35989503653498811)},
+    {R(0.92387953251128674), R(-0.38268343236508978)}, {R(0.91420975570353069), R(-0.40524131400498986)},
+    {R(0.90398929312344334), R(-0.42755509343028208)}, {R(0.89322430119551532), R(-0.44961132965460654)},
+    {R(0.88192126434835505), R(-0.47139673682599764)}, {R(0.87008699110871146), R(-0.49289819222978404)},
+    {R(0.85772861000027212), R(-0.51410274419322166)}, {R(0.84485356524970712), R(-0.53499761988709715)},
+    {R(0.83146961230254524), R(-0.55557023301960218)}, {R(0.81758481315158371), R(-0.57580819141784534)},
+    {R(0.80320753148064494), R(-0.59569930449243336)}, {R(0.78834642762660634), R(-0.61523159058062682)},
+    {R(0.77301045336273699), R(-0.63439328416364549)}, {R(0.75720884650648457), R(-0.65317284295377676)},
+    {R(0.74095112535495911), R(-0.67155895484701833)}, {R(0.724247082951467), R(-0.68954054473706683)},
+    {R(0.70710678118654757), R(-0.70710678118654746)}, {R(0.68954054473706694), R(-0.72424708295146689)},
+    {R(0.67155895484701833), R(-0.74095112535495911)}, {R(0.65317284295377676), R(-0.75720884650648446)},
+    {R(0.63439328416364549), R(-0.77301045336273699)}, {R(0.61523159058062682), R(-0.78834642762660623)},
+    {R(0.59569930449243347), R(-0.80320753148064483)}, {R(0.57580819141784534), R(-0.81758481315158371)},
+    {R(0.55557023301960229), R(-0.83146961230254524)}, {R(0.53499761988709726), R(-0.84485356524970701)},
+    {R(0.51410274419322166), R(-0.85772861000027212)}, {R(0.49289819222978409), R(-0.87008699110871135)},
+    {R(0.47139673682599781), R(-0.88192126434835494)}, {R(0.4496113296546066), R(-0.89322430119551532)},
+    {R(0.4275550934302822), R(-0.90398929312344334)}, {R(0.40524131400498986), R(-0.91420975570353069)},
+    {R(0.38268343236508984), R(-0.92387953251128674)}, {R(0.35989503653498828), R(-0.93299279883473885)},
+    {R(0.33688985339222005), R(-0.94154406518302081)}, {R(0.31368174039889157), R(-0.94952818059303667)},
+    {R(0.29028467725446233), R(-0.95694033573220894)}, {R(0.26671275747489842), R(-0.96377606579543984)},
+    {R(0.24298017990326398), R(-0.97003125319454397)}, {R(0.21910124015686977), R(-0.97570213003852857)},
+    {R(0.19509032201612833), R(-0.98078528040323043)}, {R(0.17096188876030136), R(-0.98527764238894122)},
+    {R(0.14673047445536175), R(-0.98917650996478101)}, {R(0.12241067519921628), R(-0.99247953459870997)},
+    {R(0.09801714032956077), R(-0.99518472667219682)}, {R(0.073564563599667454), R(-0.99729045667869021)},
+    {R(0.049067674327418126), R(-0.99879545620517241)}, {R(0.024541228522912264), R(-0.99969881869620425)},
+    {R(0.0), R(-1.0)}, {R(-0.024541228522912142), R(-0.99969881869620425)},
+    {R(-0.049067674327418008), R(-0.99879545620517241)}, {R(-0.073564563599667329), R(-0.99729045667869021)},
+    {R(-0.098017140329560645), R(-0.99518472667219693)}, {R(-0.12241067519921615), R(-0.99247953459870997)},
+    {R(-0.14673047445536164), R(-0.98917650996478101)}, {R(-0.17096188876030124), R(-0.98527764238894122)},
+    {R(-0.19509032201612819), R(-0.98078528040323043)}, {R(-0.21910124015686966), R(-0.97570213003852857)},
+    {R(-0.24298017990326387), R(-0.97003125319454397)}, {R(-0.26671275747489831), R(-0.96377606579543984)},
+    {R(-0.29028467725446216), R(-0.95694033573220894)}, {R(-0.31368174039889141), R(-0.94952818059303667)},
+    {R(-0.33688985339221994), R(-0.94154406518302081)}, {R(-0.35989503653498817), R(-0.93299279883473885)},
+    {R(-0.38268343236508973), R(-0.92387953251128674)}, {R(-0.40524131400498975), R(-0.91420975570353069)},
+    {R(-0.42755509343028186), R(-0.90398929312344345)}, {R(-0.44961132965460671), R(-0.89322430119551521)},
+    {R(-0.4713967368259977), R(-0.88192126434835505)}, {R(-0.49289819222978398), R(-0.87008699110871146)},
+    {R(-0.51410274419322166), R(-0.85772861000027212)}, {R(-0.53499761988709704), R(-0.84485356524970723)},
+    {R(-0.55557023301960196), R(-0.83146961230254546)}, {R(-0.57580819141784534), R(-0.81758481315158371)},
+    {R(-0.59569930449243336), R(-0.80320753148064494)}, {R(-0.61523159058062671), R(-0.78834642762660634)},
+    {R(-0.63439328416364538), R(-0.7730104533627371)}, {R(-0.65317284295377653), R(-0.75720884650648468)},
+    {R(-0.67155895484701844), R(-0.74095112535495899)}, {R(-0.68954054473706694), R(-0.72424708295146689)},
+    {R(-0.70710678118654746), R(-0.70710678118654757)}, {R(-0.72424708295146678), R(-0.68954054473706705)},
+    {R(-0.74095112535495888), R(-0.67155895484701855)}, {R(-0.75720884650648457), R(-0.65317284295377664)},
+    {R(-0.77301045336273699), R(-0.63439328416364549)}, {R(-0.78834642762660623), R(-0.61523159058062693)},
+    {R(-0.80320753148064483), R(-0.59569930449243347)}, {R(-0.8175848131515836), R(-0.57580819141784545)},
+    {R(-0.83146961230254535), R(-0.55557023301960218)}, {R(-0.84485356524970712), R(-0.53499761988709715)},
+    {R(-0.85772861000027201), R(-0.51410274419322177)}, {R(-0.87008699110871135), R(-0.49289819222978415)},
+    {R(-0.88192126434835494), R(-0.47139673682599786)}, {R(-0.89322430119551521), R(-0.44961132965460687)},
+    {R(-0.90398929312344334), R(-0.42755509343028203)}, {R(-0.91420975570353069), R(-0.40524131400498992)},
+    {R(-0.92387953251128674), R(-0.38268343236508989)}, {R(-0.93299279883473885), R(-0.35989503653498833)},
+    {R(-0.9415440651830207), R(-0.33688985339222033)}, {R(-0.94952818059303667), R(-0.31368174039889141)},
+    {R(-0.95694033573220882), R(-0.29028467725446239)}, {R(-0.96377606579543984), R(-0.26671275747489848)},
+    {R(-0.97003125319454397), R(-0.24298017990326407)}, {R(-0.97570213003852846), R(-0.21910124015687005)},
+    {R(-0.98078528040323043), R(-0.19509032201612861)}, {R(-0.98527764238894122), R(-0.17096188876030122)},
+    {R(-0.98917650996478101), R(-0.1467304744553618)}, {R(-0.99247953459870997), R(-0.12241067519921635)},
+    {R(-0.99518472667219682), R(-0.098017140329560826)}, {R(-0.99729045667869021), R(-0.073564563599667732)},
+    {R(-0.99879545620517241), R(-0.049067674327417966)}, {R(-0.99969881869620425), R(-0.024541228522912326)},
+};
+
+#undef R
+
+// out[0..h) holds the transform of the even samples, out[h..2h) that of the odd
+// ones; out[k], out[k + h] = E[k] +- W^k O[k] with W = exp(-sgn 2 pi i / 2h)
+static VV_DSP_SIMD_FORCE_INLINE void small_combine(vv_dsp_cpx* out, size_t h, size_t step, vv_dsp_real sgn) {
+    vv_dsp_cpx* o = out + h;
+    vv_dsp_cpx e = out[0], t = o[0];
+    out[0] = vv_dsp_cpx_make(e.re + t.re, e.im + t.im);
+    o[0] = vv_dsp_cpx_make(e.re - t.re, e.im - t.im);
+    // k = h/2: W^k = -sgn i
+    e = out[h / 2];
+    t = vv_dsp_cpx_make(sgn * o[h / 2].im, -sgn * o[h / 2].re);
+    out[h / 2] = vv_dsp_cpx_make(e.re + t.re, e.im + t.im);
+    o[h / 2] = vv_dsp_cpx_make(e.re - t.re, e.im - t.im);
+    for (size_t k = 1; k < h; ++k) {
+        if (k == h / 2) continue;
+        const vv_dsp_real wr = small_tw[k * step].re, wi = sgn * small_tw[k * step].im;
+        const vv_dsp_cpx b = o[k];
+        e = out[k];
+        t = vv_dsp_cpx_make(b.re * wr - b.im * wi, b.re * wi + b.im * wr);
+        out[k] = vv_dsp_cpx_make(e.re + t.re, e.im + t.im);
+        o[k] = vv_dsp_cpx_make(e.re - t.re, e.im - t.im);
+    }
+}
+
+// Leaf kernels: 2 and 4 points straight from the definition
+#define SMALL_FFT_LEAVES(D, SGN)                                                             \
+    static void small_fft2##D(const vv_dsp_cpx* in, size_t is, vv_dsp_cpx* out) {             \
+        const vv_dsp_cpx a = in[0], b = in[is];                                               \
+        out[0] = vv_dsp_cpx_make(a.re + b.re, a.im + b.im);                                   \
+        out[1] = vv_dsp_cpx_make(a.re - b.re, a.im - b.im);                                   \
+    }                                                                                         \
+    static void small_fft4##D(const vv_dsp_cpx* in, size_t is, vv_dsp_cpx* out) {             \
+        const vv_dsp_cpx a = in[0], b = in[is], c = in[2 * is], d = in[3 * is];               \
+        const vv_dsp_real s = (vv_dsp_real)(SGN);                                             \
+        const vv_dsp_cpx t0 = vv_dsp_cpx_make(a.re + c.re, a.im + c.im);                      \
+        const vv_dsp_cpx t1 = vv_dsp_cpx_make(a.re - c.re, a.im - c.im);                      \
+        const vv_dsp_cpx t2 = vv_dsp_cpx_make(b.re + d.re, b.im + d.im);                      \
+        const vv_dsp_cpx t3 = vv_dsp_cpx_make(b.re - d.re, b.im - d.im);                      \
+        out[0] = vv_dsp_cpx_make(t0.re + t2.re, t0.im + t2.im);                               \
+        out[2] = vv_dsp_cpx_make(t0.re - t2.re, t0.im - t2.im);                               \
+        out[1] = vv_dsp_cpx_make(t1.re + s * t3.im, t1.im - s * t3.re);                       \
+        out[3] = vv_dsp_cpx_make(t1.re - s * t3.im, t1.im + s * t3.re);                       \
+    }
+
+// Kernel of N points from two of H = N/2
+#define SMALL_FFT_DEFINE(N, H, D, SGN)                                                        \
+    static void small_fft##N##D(const vv_dsp_cpx* in, size_t is, vv_dsp_cpx* out) {           \
+        small_fft##H##D(in, 2 * is, out);                                                     \
+        small_fft##H##D(in + is, 2 * is, out + (H));                                          \
+        small_combine(out, (H), 256 / (N), (vv_dsp_real)(SGN));                               \
+    }
+
+#define SMALL_FFT_FAMILY(D, SGN)          \
+    SMALL_FFT_LEAVES(D, SGN)              \
+    SMALL_FFT_DEFINE(8, 4, D, SGN)        \
+    SMALL_FFT_DEFINE(16, 8, D, SGN)       \
+    SMALL_FFT_DEFINE(32, 16, D, SGN)      \
+    SMALL_FFT_DEFINE(64, 32, D, SGN)
+
+SMALL_FFT_FAMILY(_fwd, 1)
+SMALL_FFT_FAMILY(_bwd, -1)
+
+int vv_dsp_fft_small_raw(size_t n, int sign, const vv_dsp_cpx* in, vv_dsp_cpx* out) {
+    const int fwd = sign > 0;
+    switch (n) {
+        case 2: if (fwd) small_fft2_fwd(in, 1, out); else small_fft2_bwd(in, 1, out); return 1;
+        case 4: if (fwd) small_fft4_fwd(in, 1, out); else small_fft4_bwd(in, 1, out); return 1;
+        case 8: if (fwd) small_fft8_fwd(in, 1, out); else small_fft8_bwd(in, 1, out); return 1;
+        case 16: if (fwd) small_fft16_fwd(in, 1, out); else small_fft16_bwd(in, 1, out); return 1;
+        case 32: if (fwd) small_fft32_fwd(in, 1, out); else small_fft32_bwd(in, 1, out); return 1;
+        case 64: if (fwd) small_fft64_fwd(in, 1, out); else small_fft64_bwd(in, 1, out); return 1;
+        default: return 0;
+    }
+}
+
+// Public kernels follow fft.h: in may equal out, backward transforms are scaled by 1/n
+#define SMALL_PUBLIC_FFT(N)                                                                       \
+    vv_dsp_status vv_dsp_fft_small_##N(const vv_dsp_cpx* in, vv_dsp_cpx* out, vv_dsp_fft_dir dir) { \
+        if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;                                        \
+        vv_dsp_cpx tmp[N];                                                                        \
+        if (in == out) {                                                                          \
+            memcpy(tmp, in, sizeof(tmp));                                                         \
+            in = tmp;                                                                             \
+        }                                                                                         \
+        if (dir == VV_DSP_FFT_FORWARD) {                                                          \
+            small_fft##N##_fwd(in, 1, out);                                                       \
+            return VV_DSP_OK;                                                                     \
+        }                                                                                         \
+        if (dir != VV_DSP_FFT_BACKWARD) return VV_DSP_ERROR_OUT_OF_RANGE;                         \
+        small_fft##N##_bwd(in, 1, out);                                                           \
+        for (size_t i = 0; i < (N); ++i) {                                                        \
+            out[i].re *= (vv_dsp_real)1.0 / (vv_dsp_real)(N);                                     \
+            out[i].im *= (vv_dsp_real)1.0 / (vv_dsp_real)(N);                                     \
+        }                                                                                         \
+        return VV_DSP_OK;                                                                         \
+    }
+
+SMALL_PUBLIC_FFT(8)
+SMALL_PUBLIC_FFT(16)
+SMALL_PUBLIC_FFT(32)
+SMALL_PUBLIC_FFT(64)
+
+vv_dsp_status vv_dsp_fft_small(size_t n, vv_dsp_fft_dir dir, const vv_dsp_cpx* in, vv_dsp_cpx* out) {
+    switch (n) {
+        case 8: return vv_dsp_fft_small_8(in, out, dir);
+        case 16: return vv_dsp_fft_small_16(in, out, dir);
+        case 32: return vv_dsp_fft_small_32(in, out, dir);
+        case 64: return vv_dsp_fft_small_64(in, out, dir);
+        default: return (in && out) ? VV_DSP_ERROR_UNSUPPORTED : VV_DSP_ERROR_NULL_POINTER;
+    }
+}
+
+// Makhoul: the even samples ascending then the odd ones descending form v, whose
+// n-point real FFT runs as an n/2-point complex one on v[2j] + i v[2j+1] followed by
+// the even/odd split; X[k] = Re(exp(-i pi k / (2n)) V[k])
+vv_dsp_status vv_dsp_dct2_small(size_t n, const vv_dsp_real* in, vv_dsp_real* out) {
+    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n < 8 || n > VV_DSP_FFT_SMALL_MAX || (n & (n - 1)) != 0) return VV_DSP_ERROR_UNSUPPORTED;
+    const size_t m = n / 2;
+    vv_dsp_cpx z[VV_DSP_FFT_SMALL_MAX / 2], Z[VV_DSP_FFT_SMALL_MAX / 2 + 1], V[VV_DSP_FFT_SMALL_MAX / 2 + 1];
+    for (size_t j = 0; j < m; ++j) {
+        // v[2j], v[2j+1] with v[i] = x[2i] (i < m) and v[n-1-i] = x[2i+1]
+        const size_t a = 2 * j, b = 2 * j + 1;
+        const vv_dsp_real va = a < m ? in[2 * a] : in[2 * (n - 1 - a) + 1];
+        const vv_dsp_real vb = b < m ? in[2 * b] : in[2 * (n - 1 - b) + 1];
+        z[j] = vv_dsp_cpx_make(va, vb);
+    }
+    if (!vv_dsp_fft_small_raw(m, 1, z, Z)) return VV_DSP_ERROR_INTERNAL;
+    const size_t rstep = 256 / n;
+    const vv_dsp_real half = (vv_dsp_real)0.5;
+    V[0] = vv_dsp_cpx_make(Z[0].re + Z[0].im, 0);
+    V[m] = vv_dsp_cpx_make(Z[0].re - Z[0].im, 0);
+    for (size_t k = 1; k <= m / 2; ++k) {
+        const size_t j = m - k;
+        const vv_dsp_real wr = small_tw[k * rstep].re, wi = small_tw[k * rstep].im;
+        const vv_dsp_real er = half * (Z[k].re + Z[j].re), ei = half * (Z[k].im - Z[j].im);
+        const vv_dsp_real orr = half * (Z[k].im + Z[j].im), oi = half * (Z[j].re - Z[k].re);
+        const vv_dsp_real tr = wr * orr - wi * oi, ti = wr * oi + wi * orr;
+        V[k] = vv_dsp_cpx_make(er + tr, ei + ti);
+        V[j] = vv_dsp_cpx_make(er - tr, ti - ei);
+    }
+    const size_t pstep = 64 / n;
+    for (size_t k = 0; k <= m; ++k) {
+        const vv_dsp_cpx w = small_tw[k * pstep];
+        out[k] = w.re * V[k].re - w.im * V[k].im;
+    }
+    // Upper half from Hermitian symmetry: V[k] = conj(V[n-k])
+    for (size_t k = m + 1; k < n; ++k) {
+        const vv_dsp_cpx w = small_tw[k * pstep];
+        out[k] = w.re * V[n - k].re + w.im * V[n - k].im;
+    }
+    return VV_DSP_OK;
+}
+
+#define SMALL_PUBLIC_DCT2(N)                                                         \
+    vv_dsp_status vv_dsp_dct2_small_##N(const vv_dsp_real* in, vv_dsp_real* out) { \
+        return vv_dsp_dct2_small(N, in, out);                                        \
+    }
+
+SMALL_PUBLIC_DCT2(8)
+SMALL_PUBLIC_DCT2(16)
+SMALL_PUBLIC_DCT2(32)
+SMALL_PUBLIC_DCT2(64)
@@ -0,0 +1,254 @@
+/*
+This file is part of vv-dsp
+
+Per-size FFT backend auto-tuning. The first request for a given
+(n, type, dir) times every available backend and remembers the fastest;
+later requests reuse the recorded choice. Choices can be saved and loaded
+as a small text file, typically kept next to FFTW wisdom.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fft_backend.h"
+#include "vv_dsp/core/alloc.h"
+
+#define FFT_TUNE_MAX_ENTRIES 256
+#define FFT_TUNE_MIN_SECONDS 1e-3  // per timing trial
+#define FFT_TUNE_MAX_REPS 65536
+#define FFT_TUNE_TRIALS 3
+#define FFT_TUNE_HEADER "# vv-dsp fft tuning v1"
+
+typedef struct fft_tune_entry {
+    size_t n;
+    vv_dsp_fft_type type;
+    vv_dsp_fft_dir dir;
+    vv_dsp_fft_backend backend;
+} fft_tune_entry;
+
+static fft_mutex g_tune_mutex = FFT_MUTEX_INIT;
+static fft_tune_entry g_tune[FFT_TUNE_MAX_ENTRIES];
+static size_t g_tune_count = 0;
+
+static double tune_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static int backend_usable(vv_dsp_fft_backend b) {
+    return b < VV_DSP_FFT_BACKEND_COUNT && g_fft_backends[b] && g_fft_backends[b]->is_available() && g_fft_backends[b]->make_plan;
+}
+
+// Called with g_tune_mutex held
+static fft_tune_entry* tune_find(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir) {
+    for (size_t i = 0; i < g_tune_count; ++i) {
+        if (g_tune[i].n == n && g_tune[i].type == type && g_tune[i].dir == dir) return &g_tune[i];
+    }
+    return NULL;
+}
+
+// Called with g_tune_mutex held; silently drops the entry when the table is full
+static void tune_record(size_t n, vv_dsp_fft_type type, vv_dsp_fft_dir dir, vv_dsp_fft_backend backend) {
+    fft_tune_entry* e = tune_find(n, type, dir);
+    if (!e) {
+        if (g_tune_count >= FFT_TUNE_MAX_ENTRIES) return;
+        e = &g_tune[g_tune_count++];
+        e->n = n;
+        e->type = type;
+        e->dir = dir;
+    }
+    e->backend = backend;
+}
+
+// Seconds per execute, best of FFT_TUNE_TRIALS; negative on failure
+static double time_plan(const vv_dsp_fft_plan* plan, size_t n, vv_dsp_fft_type type, void* in, void* out) {
+    const size_t nh = n / 2 + 1;
+    if (type == VV_DSP_FFT_R2C) {
+        vv_dsp_real* x = (vv_dsp_real*)in;
+        for (size_t i = 0; i < n; ++i) x[i] = (vv_dsp_real)((double)((i * 7919u) % 1024u) / 512.0 - 1.0);
+    } else {
+        vv_dsp_cpx* x = (vv_dsp_cpx*)in;
+        const size_t len = (type == VV_DSP_FFT_C2R) ? nh : n;
+        for (size_t i = 0; i < len; ++i) {
+            x[i] = vv_dsp_cpx_make((vv_dsp_real)((double)((i * 7919u) % 1024u) / 512.0 - 1.0),
+                                   (vv_dsp_real)((double)((i * 104729u) % 1024u) / 512.0 - 1.0));
+        }
+    }
+
+    // Warm-up, then grow the repetition count until one trial is measurable
+    if (vv_dsp_fft_execute(plan, in, out) != VV_DSP_OK) return -1.0;
+    size_t reps = 1;
+    for (;;) {
+        const double t0 = tune_now();
+        for (size_t r = 0; r < reps; ++r) {
+            if (vv_dsp_fft_execute(plan, in, out) != VV_DSP_OK) return -1.0;
+        }
+        if (tune_now() - t0 >= FFT_TUNE_MIN_SECONDS || reps >= FFT_TUNE_MAX_REPS) break;
+        reps *= 2;
+    }
+
+    double best = -1.0;
+    for (int t = 0; t < FFT_TUNE_TRIALS; ++t) {
+        const double t0 = tune_now();
+        for (size_t r = 0; r < reps; ++r) {
+            if (vv_dsp_fft_execute(plan, in, out) != VV_DSP_OK) return -1.0;
+        }
+        const double dt = (tune_now() - t0) / (double)reps;
+        if (best < 0.0 || dt < best) best = dt;
+    }
+    return best;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_make_plan_auto(size_t n,
+                                                         vv_dsp_fft_type type,
+                                                         vv_dsp_fft_dir dir,
+                                                         vv_dsp_fft_plan** out_plan) {
+    if (!out_plan) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!(type == VV_DSP_FFT_C2C || type == VV_DSP_FFT_R2C || type == VV_DSP_FFT_C2R)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (!(dir == VV_DSP_FFT_FORWARD || dir == VV_DSP_FFT_BACKWARD)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    // Make sure the backend table is populated before inspecting it
+    (void)vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_KISS);
+
+    fft_mutex_lock(&g_tune_mutex);
+    fft_tune_entry* known = tune_find(n, type, dir);
+    int have_choice = known && backend_usable(known->backend);
+    const vv_dsp_fft_backend choice = have_choice ? known->backend : VV_DSP_FFT_BACKEND_KISS;
+    fft_mutex_unlock(&g_tune_mutex);
+    if (have_choice) {
+        return vv_dsp_fft_make_plan_backend(n, type, dir, choice, out_plan);
+    }
+
+    // Time outside the lock; a concurrent tuner of the same key only repeats work
+    const size_t in_bytes = (type == VV_DSP_FFT_R2C) ? n * sizeof(vv_dsp_real)
+                          : ((type == VV_DSP_FFT_C2R) ? (n / 2 + 1) : n) * sizeof(vv_dsp_cpx);
+    const size_t out_bytes = (type == VV_DSP_FFT_C2R) ? n * sizeof(vv_dsp_real)
+                           : ((type == VV_DSP_FFT_R2C) ? (n / 2 + 1) : n) * sizeof(vv_dsp_cpx);
+    void* in = vv_dsp_malloc(in_bytes);
+    void* out = vv_dsp_malloc(out_bytes);
+    if (!in || !out) {
+        vv_dsp_free(in);
+        vv_dsp_free(out);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    vv_dsp_fft_plan* best = NULL;
+    vv_dsp_fft_backend best_backend = VV_DSP_FFT_BACKEND_KISS;
+    double best_time = 0.0;
+    vv_dsp_status last_err = VV_DSP_ERROR_UNSUPPORTED;
+    for (int b = 0; b < VV_DSP_FFT_BACKEND_COUNT; ++b) {
+        if (!backend_usable((vv_dsp_fft_backend)b)) continue;
+        vv_dsp_fft_plan* plan = NULL;
+        vv_dsp_status st = vv_dsp_fft_make_plan_backend(n, type, dir, (vv_dsp_fft_backend)b, &plan);
+        if (st != VV_DSP_OK) {
+            last_err = st;
+            continue;
+        }
+        const double t = time_plan(plan, n, type, in, out);
+        if (t >= 0.0 && (!best || t < best_time)) {
+            if (best) (void)vv_dsp_fft_destroy(best);
+            best = plan;
+            best_backend = (vv_dsp_fft_backend)b;
+            best_time = t;
+        } else {
+            (void)vv_dsp_fft_destroy(plan);
+        }
+    }
+    vv_dsp_free(in);
+    vv_dsp_free(out);
+    if (!best) return last_err;
+
+    fft_mutex_lock(&g_tune_mutex);
+    tune_record(n, type, dir, best_backend);
+    fft_mutex_unlock(&g_tune_mutex);
+
+    *out_plan = best;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_get_tuned_backend(size_t n,
+                                                            vv_dsp_fft_type type,
+                                                            vv_dsp_fft_dir dir,
+                                                            vv_dsp_fft_backend* out_backend) {
+    if (!out_backend) return VV_DSP_ERROR_NULL_POINTER;
+    fft_mutex_lock(&g_tune_mutex);
+    const fft_tune_entry* e = tune_find(n, type, dir);
+    if (e) *out_backend = e->backend;
+    fft_mutex_unlock(&g_tune_mutex);
+    return e ? VV_DSP_OK : VV_DSP_ERROR_OUT_OF_RANGE;
+}
+
+vv_dsp_status vv_dsp_fft_clear_tuning(void) {
+    fft_mutex_lock(&g_tune_mutex);
+    g_tune_count = 0;
+    fft_mutex_unlock(&g_tune_mutex);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_export_tuning(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    (void)vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_KISS);
+    FILE* fp = fopen(path, "w");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+
+    int ok = fprintf(fp, "%s\n", FFT_TUNE_HEADER) > 0;
+    fft_mutex_lock(&g_tune_mutex);
+    for (size_t i = 0; ok && i < g_tune_count; ++i) {
+        const fft_tune_entry* e = &g_tune[i];
+        const char* name = g_fft_backends[e->backend] ? g_fft_backends[e->backend]->name : NULL;
+        if (!name) continue;
+        ok = fprintf(fp, "%lu %d %d %s\n", (unsigned long)e->n, (int)e->type, (int)e->dir, name) > 0;
+    }
+    fft_mutex_unlock(&g_tune_mutex);
+
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? VV_DSP_OK : VV_DSP_ERROR_INTERNAL;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_fft_import_tuning(const char* path) {
+    if (!path) return VV_DSP_ERROR_NULL_POINTER;
+    (void)vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_KISS);
+    FILE* fp = fopen(path, "r");
+    if (!fp) return VV_DSP_ERROR_INTERNAL;
+
+    char line[128];
+    if (!fgets(line, sizeof(line), fp) || strncmp(line, FFT_TUNE_HEADER, strlen(FFT_TUNE_HEADER)) != 0) {
+        fclose(fp);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+
+    fft_mutex_lock(&g_tune_mutex);
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long n = 0;
+        int type = 0, dir = 0;
+        char name[64];
+        if (sscanf(line, "%lu %d %d %63s", &n, &type, &dir, name) != 4 || n == 0) continue;
+        if (type < VV_DSP_FFT_C2C || type > VV_DSP_FFT_C2R) continue;
+        if (dir != VV_DSP_FFT_FORWARD && dir != VV_DSP_FFT_BACKWARD) continue;
+        // Entries for backends missing from this build are skipped
+        for (int b = 0; b < VV_DSP_FFT_BACKEND_COUNT; ++b) {
+            if (backend_usable((vv_dsp_fft_backend)b) && strcmp(g_fft_backends[b]->name, name) == 0) {
+                tune_record((size_t)n, (vv_dsp_fft_type)type, (vv_dsp_fft_dir)dir, (vv_dsp_fft_backend)b);
+                break;
+            }
+        }
+    }
+    fft_mutex_unlock(&g_tune_mutex);
+
+    fclose(fp);
+    return VV_DSP_OK;
+}
@@ -0,0 +1,252 @@
+/*
+This file is part of vv-dsp
+
+Apple Accelerate (vDSP) backend for the vv-dsp FFT abstraction layer.
+
+vDSP's radix-2 FFTs work on split-complex data: C2C plans run vDSP_fft_zop, and
+real plans run vDSP_fft_zrip on the even/odd samples packed as n/2 complex
+values. The FFTSetup (twiddle tables) is created once and kept in the plan.
+Lengths that are not a power of two go to an internal KissFFT plan, so every
+length still plans on this backend.
+
+vDSP scaling differs from the library's: the packed real forward result is
+twice the DFT, and the inverse transforms are unnormalized. Both are folded into
+one vDSP_vsmul per call.
+*/
+
+#include "fft_backend.h"
+
+#ifdef VV_DSP_BACKEND_FFT_vdsp
+
+#include <stdlib.h>
+#include <string.h>
+#include <Accelerate/Accelerate.h>
+#include "vv_dsp/core/alloc.h"
+
+#if defined(VV_DSP_USE_DOUBLE)
+typedef FFTSetupD vdsp_setup;
+typedef DSPDoubleSplitComplex vdsp_split;
+typedef DSPDoubleComplex vdsp_cpx;
+#define VDSP_CREATE_SETUP vDSP_create_fftsetupD
+#define VDSP_DESTROY_SETUP vDSP_destroy_fftsetupD
+#define VDSP_ZOP vDSP_fft_zopD
+#define VDSP_ZRIP vDSP_fft_zripD
+#define VDSP_CTOZ vDSP_ctozD
+#define VDSP_ZTOC vDSP_ztocD
+#define VDSP_VSMUL vDSP_vsmulD
+#else
+typedef FFTSetup vdsp_setup;
+typedef DSPSplitComplex vdsp_split;
+typedef DSPComplex vdsp_cpx;
+#define VDSP_CREATE_SETUP vDSP_create_fftsetup
+#define VDSP_DESTROY_SETUP vDSP_destroy_fftsetup
+#define VDSP_ZOP vDSP_fft_zop
+#define VDSP_ZRIP vDSP_fft_zrip
+#define VDSP_CTOZ vDSP_ctoz
+#define VDSP_ZTOC vDSP_ztoc
+#define VDSP_VSMUL vDSP_vsmul
+#endif
+
+#define VDSP_WS_ALIGN 16  // vDSP prefers 16-byte aligned vectors
+
+typedef struct {
+    vdsp_setup setup;    // NULL when the plan runs on `kiss`
+    vDSP_Length log2n;
+    void* kiss;          // KissFFT plan data for lengths vDSP cannot do
+    vv_dsp_real* split;  // 2*n reals (re then im) for execute() / execute_split()
+} vdsp_plan_wrapper;
+
+static void vdsp_free_plan(void* backend_data) {
+    if (!backend_data) return;
+    vdsp_plan_wrapper* w = (vdsp_plan_wrapper*)backend_data;
+    if (w->setup) VDSP_DESTROY_SETUP(w->setup);
+    if (w->kiss) vv_dsp_fft_kiss_vtable.free_plan(w->kiss);
+    vv_dsp_free(w->split);
+    vv_dsp_free(w);
+}
+
+static vv_dsp_status vdsp_make_plan(const struct vv_dsp_fft_plan* spec, void** backend_data) {
+    if (!spec || !backend_data) return VV_DSP_ERROR_NULL_POINTER;
+    if (spec->type != VV_DSP_FFT_C2C && spec->type != VV_DSP_FFT_R2C && spec->type != VV_DSP_FFT_C2R) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    vdsp_plan_wrapper* w = (vdsp_plan_wrapper*)vv_dsp_calloc(1, sizeof(*w));
+    if (!w) return VV_DSP_ERROR_INTERNAL;
+    const size_t n = spec->n;
+    if (n < 4 || (n & (n - 1)) != 0) {
+        const vv_dsp_status st = vv_dsp_fft_kiss_vtable.make_plan(spec, &w->kiss);
+        if (st != VV_DSP_OK) {
+            vdsp_free_plan(w);
+            return st;
+        }
+        *backend_data = w;
+        return VV_DSP_OK;
+    }
+    while (((size_t)1 << w->log2n) < n) w->log2n++;
+    w->setup = VDSP_CREATE_SETUP(w->log2n, kFFTRadix2);
+    w->split = (vv_dsp_real*)vv_dsp_malloc(2 * n * sizeof(vv_dsp_real));
+    if (!w->setup || !w->split) {
+        vdsp_free_plan(w);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    *backend_data = w;
+    return VV_DSP_OK;
+}
+
+// re/im: n reals each (only n/2 used by real transforms)
+static vv_dsp_status vdsp_exec_impl(const struct vv_dsp_fft_plan* spec, const vdsp_plan_wrapper* w,
+                                    const void* in, void* out, vv_dsp_real* re, vv_dsp_real* im) {
+    const size_t n = spec->n;
+    vdsp_split z = {re, im};
+    if (spec->type == VV_DSP_FFT_C2C) {
+        VDSP_CTOZ((const vdsp_cpx*)in, 2, &z, 1, n);
+        VDSP_ZOP(w->setup, &z, 1, &z, 1, w->log2n,
+                 spec->dir == VV_DSP_FFT_FORWARD ? kFFTDirection_Forward : kFFTDirection_Inverse);
+        if (spec->dir == VV_DSP_FFT_BACKWARD) {
+            const vv_dsp_real s = (vv_dsp_real)1 / (vv_dsp_real)n;
+            VDSP_VSMUL(re, 1, &s, re, 1, n);
+            VDSP_VSMUL(im, 1, &s, im, 1, n);
+        }
+        VDSP_ZTOC(&z, 1, (vdsp_cpx*)out, 2, n);
+        return VV_DSP_OK;
+    }
+    const size_t h = n / 2;
+    if (spec->type == VV_DSP_FFT_R2C) {
+        // Packed result: re[0] = X[0], im[0] = X[n/2], bins 1..n/2-1 in place
+        VDSP_CTOZ((const vdsp_cpx*)in, 2, &z, 1, h);
+        VDSP_ZRIP(w->setup, &z, 1, w->log2n, kFFTDirection_Forward);
+        vv_dsp_cpx* y = (vv_dsp_cpx*)out;
+        const vv_dsp_real nyq = im[0];
+        im[0] = 0;
+        const vv_dsp_real s = (vv_dsp_real)0.5;
+        VDSP_VSMUL(re, 1, &s, re, 1, h);
+        VDSP_VSMUL(im, 1, &s, im, 1, h);
+        VDSP_ZTOC(&z, 1, (vdsp_cpx*)y, 2, h);
+        y[h].re = nyq * s;
+        y[h].im = 0;
+        return VV_DSP_OK;
+    }
+    const vv_dsp_cpx* x = (const vv_dsp_cpx*)in;
+    VDSP_CTOZ((const vdsp_cpx*)x, 2, &z, 1, h);
+    im[0] = x[h].re;
+    VDSP_ZRIP(w->setup, &z, 1, w->log2n, kFFTDirection_Inverse);
+    const vv_dsp_real s = (vv_dsp_real)1 / (vv_dsp_real)n;
+    VDSP_VSMUL(re, 1, &s, re, 1, h);
+    VDSP_VSMUL(im, 1, &s, im, 1, h);
+    VDSP_ZTOC(&z, 1, (vdsp_cpx*)out, 2, h);
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status vdsp_execute(const struct vv_dsp_fft_plan* spec, void* backend_data, const void* in, void* out) {
+    if (!spec || !backend_data || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    vdsp_plan_wrapper* w = (vdsp_plan_wrapper*)backend_data;
+    if (w->kiss) return vv_dsp_fft_kiss_vtable.execute(spec, w->kiss, in, out);
+    return vdsp_exec_impl(spec, w, in, out, w->split, w->split + spec->n);
+}
+
+static size_t vdsp_region(size_t n) {
+    return (n * sizeof(vv_dsp_real) + VDSP_WS_ALIGN - 1) / VDSP_WS_ALIGN * VDSP_WS_ALIGN;
+}
+
+static size_t vdsp_workspace_size(const struct vv_dsp_fft_plan* spec, const void* backend_data) {
+    const vdsp_plan_wrapper* w = (const vdsp_plan_wrapper*)backend_data;
+    if (w && w->kiss) return vv_dsp_fft_kiss_vtable.workspace_size(spec, w->kiss);
+    return VDSP_WS_ALIGN + 2 * vdsp_region(spec->n);
+}
+
+static vv_dsp_status vdsp_execute_ws(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                     const void* in, void* out, void* ws) {
+    if (!spec || !backend_data || !in || !out || !ws) return VV_DSP_ERROR_NULL_POINTER;
+    const vdsp_plan_wrapper* w = (const vdsp_plan_wrapper*)backend_data;
+    if (w->kiss) return vv_dsp_fft_kiss_vtable.execute_ws(spec, w->kiss, in, out, ws);
+    unsigned char* base = (unsigned char*)ws;
+    base += (VDSP_WS_ALIGN - ((size_t)base % VDSP_WS_ALIGN)) % VDSP_WS_ALIGN;
+    return vdsp_exec_impl(spec, w, in, out, (vv_dsp_real*)base, (vv_dsp_real*)(base + vdsp_region(spec->n)));
+}
+
+// Split-complex is vDSP's native layout: C2C and R2C write the caller's arrays
+// directly, only C2R stages the (read-only) input spectrum
+static vv_dsp_status vdsp_execute_split(const struct vv_dsp_fft_plan* spec, void* backend_data,
+                                        const vv_dsp_real* in_re, const vv_dsp_real* in_im,
+                                        vv_dsp_real* out_re, vv_dsp_real* out_im) {
+    if (!spec || !backend_data || !in_re || !out_re) return VV_DSP_ERROR_NULL_POINTER;
+    vdsp_plan_wrapper* w = (vdsp_plan_wrapper*)backend_data;
+    if (w->kiss) return vv_dsp_fft_kiss_vtable.execute_split(spec, w->kiss, in_re, in_im, out_re, out_im);
+    const size_t n = spec->n, h = n / 2;
+    switch (spec->type) {
+        case VV_DSP_FFT_C2C: {
+            if (!in_im || !out_im) return VV_DSP_ERROR_NULL_POINTER;
+            vdsp_split a = {(vv_dsp_real*)in_re, (vv_dsp_real*)in_im};
+            vdsp_split c = {out_re, out_im};
+            VDSP_ZOP(w->setup, &a, 1, &c, 1, w->log2n,
+                     spec->dir == VV_DSP_FFT_FORWARD ? kFFTDirection_Forward : kFFTDirection_Inverse);
+            if (spec->dir == VV_DSP_FFT_BACKWARD) {
+                const vv_dsp_real s = (vv_dsp_real)1 / (vv_dsp_real)n;
+                VDSP_VSMUL(out_re, 1, &s, out_re, 1, n);
+                VDSP_VSMUL(out_im, 1, &s, out_im, 1, n);
+            }
+            return VV_DSP_OK;
+        }
+        case VV_DSP_FFT_R2C: {
+            if (!out_im) return VV_DSP_ERROR_NULL_POINTER;
+            vdsp_split c = {out_re, out_im};
+            VDSP_CTOZ((const vdsp_cpx*)in_re, 2, &c, 1, h);
+            VDSP_ZRIP(w->setup, &c, 1, w->log2n, kFFTDirection_Forward);
+            out_re[h] = out_im[0];
+            out_im[0] = 0;
+            out_im[h] = 0;
+            const vv_dsp_real s = (vv_dsp_real)0.5;
+            VDSP_VSMUL(out_re, 1, &s, out_re, 1, h + 1);
+            VDSP_VSMUL(out_im, 1, &s, out_im, 1, h);
+            return VV_DSP_OK;
+        }
+        case VV_DSP_FFT_C2R: {
+            if (!in_im) return VV_DSP_ERROR_NULL_POINTER;
+            vv_dsp_real* re = w->split;
+            vv_dsp_real* im = w->split + n;
+            memcpy(re, in_re, h * sizeof(vv_dsp_real));
+            memcpy(im, in_im, h * sizeof(vv_dsp_real));
+            im[0] = in_re[h];
+            vdsp_split z = {re, im};
+            VDSP_ZRIP(w->setup, &z, 1, w->log2n, kFFTDirection_Inverse);
+            const vv_dsp_real s = (vv_dsp_real)1 / (vv_dsp_real)n;
+            VDSP_VSMUL(re, 1, &s, re, 1, h);
+            VDSP_VSMUL(im, 1, &s, im, 1, h);
+            VDSP_ZTOC(&z, 1, (vdsp_cpx*)out_re, 2, h);
+            return VV_DSP_OK;
+        }
+        default:
+            return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+}
+
+static int vdsp_is_available(void) {
+    return 1;
+}
+
+const vv_dsp_fft_backend_vtable vv_dsp_fft_vdsp_vtable = {
+    .make_plan = vdsp_make_plan,
+    .execute = vdsp_execute,
+    .free_plan = vdsp_free_plan,
+    .workspace_size = vdsp_workspace_size,
+    .execute_ws = vdsp_execute_ws,
+    .execute_split = vdsp_execute_split,
+    .is_available = vdsp_is_available,
+    .name = "vDSP"
+};
+
+#else
+
+static int vdsp_not_available(void) {
+    return 0;
+}
+
+const vv_dsp_fft_backend_vtable vv_dsp_fft_vdsp_vtable = {
+    .make_plan = NULL,
+    .execute = NULL,
+    .free_plan = NULL,
+    .is_available = vdsp_not_available,
+    .name = "vDSP (not available)"
+};
+
+#endif // VV_DSP_BACKEND_FFT_vdsp
@@ -0,0 +1,301 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/spectral/gcc_phat.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+#include "parallel.h"
+
+#define GP_MIN_RUN 4            // frames per worker before another worker is worth waking
+#define GP_MAG_FLOOR 1e-30      // |X|^2 below this whitens to zero instead of blowing up
+#define GP_LANES 8
+// The partial inverse costs 2 (max_lag + 1) nbins multiply-adds against roughly
+// P log2 P for the C2R; measured on x86-64 (frames of 256..4096) the two break even
+// where those counts are about equal
+#define GP_PARTIAL_FACTOR 1
+#define GP_TABLE_MAX_BYTES ((size_t)4 << 20)
+
+typedef struct {
+    vv_dsp_fft_plan* fwd;  // R2C, private to the worker
+    vv_dsp_fft_plan* inv;  // C2R (full inverse only)
+    vv_dsp_real* buf;      // fft_size: zero-padded frame, later the full inverse
+    vv_dsp_cpx* spec;      // nbins: R2C output, later the full-inverse cross-spectrum
+    vv_dsp_real* ur;       // channels * nbins: whitened spectra, split layout
+    vv_dsp_real* ui;
+    vv_dsp_real* gr;       // nbins: pair cross-spectrum, split layout
+    vv_dsp_real* gi;
+    vv_dsp_real* row;      // lag_count: correlation of the current pair
+} gp_scratch;
+
+struct vv_dsp_gcc_phat {
+    size_t channels;
+    size_t frame_len;
+    size_t max_lag;
+    size_t fft_size;
+    size_t nbins;
+    size_t pairs;
+    size_t lags;            // 2 * max_lag + 1
+    vv_dsp_real* tc;        // (max_lag + 1) * nbins: w_k cos(2 pi k t / P) / P, or NULL
+    vv_dsp_real* ts;        // (max_lag + 1) * nbins: w_k sin(2 pi k t / P) / P
+    size_t num_workers;
+    gp_scratch* scratch;    // one per worker
+    vv_dsp_status* status;  // one per worker
+
+    // Current process call
+    const vv_dsp_real* x;
+    size_t num_frames;
+    size_t hop;
+    size_t channel_stride;
+    size_t run;
+    vv_dsp_real* corr;
+    vv_dsp_real* delay;
+    vv_dsp_real* peak;
+};
+
+static size_t next_pow2(size_t v) {
+    size_t n = 1;
+    while (n < v) n <<= 1;
+    return n;
+}
+
+static void* gp_alloc(size_t bytes) {
+    return vv_dsp_aligned_malloc(bytes, VV_DSP_SIMD_ALIGN_DEFAULT);
+}
+
+void vv_dsp_gcc_phat_destroy(vv_dsp_gcc_phat* g) {
+    if (!g) return;
+    if (g->scratch) {
+        for (size_t w = 0; w < g->num_workers; ++w) {
+            gp_scratch* s = &g->scratch[w];
+            vv_dsp_fft_plan_release(s->fwd);
+            vv_dsp_fft_plan_release(s->inv);
+            vv_dsp_aligned_free(s->buf);
+            vv_dsp_aligned_free(s->spec);
+            vv_dsp_aligned_free(s->ur);
+            vv_dsp_aligned_free(s->ui);
+            vv_dsp_aligned_free(s->gr);
+            vv_dsp_aligned_free(s->gi);
+            vv_dsp_aligned_free(s->row);
+        }
+        vv_dsp_free(g->scratch);
+    }
+    vv_dsp_aligned_free(g->tc);
+    vv_dsp_aligned_free(g->ts);
+    vv_dsp_free(g->status);
+    vv_dsp_free(g);
+}
+
+// Real inverse DFT restricted to lags 0..max_lag: weights fold the Hermitian half
+// (1 at DC and Nyquist, 2 elsewhere) and the 1/P scale into the table
+static vv_dsp_status gp_build_table(vv_dsp_gcc_phat* g) {
+    const size_t P = g->fft_size, nb = g->nbins, L1 = g->max_lag + 1;
+    g->tc = (vv_dsp_real*)gp_alloc(L1 * nb * sizeof(vv_dsp_real));
+    g->ts = (vv_dsp_real*)gp_alloc(L1 * nb * sizeof(vv_dsp_real));
+    if (!g->tc || !g->ts) return VV_DSP_ERROR_INTERNAL;
+    for (size_t t = 0; t < L1; ++t) {
+        for (size_t k = 0; k < nb; ++k) {
+            const double wk = (k == 0 || 2 * k == P) ? 1.0 : 2.0;
+            const double ang = VV_DSP_TWO_PI_D * (double)((k * t) % P) / (double)P;
+            g->tc[t * nb + k] = (vv_dsp_real)(wk * cos(ang) / (double)P);
+            g->ts[t * nb + k] = (vv_dsp_real)(wk * sin(ang) / (double)P);
+        }
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_gcc_phat_create(const vv_dsp_gcc_phat_params* params, vv_dsp_gcc_phat** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const size_t C = params->num_channels, N = params->frame_len, L = params->max_lag;
+    if (C < 2 || N == 0 || L >= N) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t P = params->fft_size ? params->fft_size : next_pow2(N + L);
+    if (P < N + L) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_gcc_phat* g = (vv_dsp_gcc_phat*)vv_dsp_calloc(1, sizeof(*g));
+    if (!g) return VV_DSP_ERROR_INTERNAL;
+    g->channels = C;
+    g->frame_len = N;
+    g->max_lag = L;
+    g->fft_size = P;
+    g->nbins = P / 2 + 1;
+    g->pairs = C * (C - 1) / 2;
+    g->lags = 2 * L + 1;
+
+    size_t lg = 0;
+    while (((size_t)1 << lg) < P) ++lg;
+    const size_t partial_cost = 2 * (L + 1) * g->nbins;
+    const int partial = partial_cost <= GP_PARTIAL_FACTOR * P * lg &&
+                        2 * (L + 1) * g->nbins * sizeof(vv_dsp_real) <= GP_TABLE_MAX_BYTES;
+    if (partial && gp_build_table(g) != VV_DSP_OK) { vv_dsp_gcc_phat_destroy(g); return VV_DSP_ERROR_INTERNAL; }
+
+    g->num_workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+    if (g->num_workers == 0) g->num_workers = 1;
+    g->scratch = (gp_scratch*)vv_dsp_calloc(g->num_workers, sizeof(gp_scratch));
+    g->status = (vv_dsp_status*)vv_dsp_malloc(g->num_workers * sizeof(vv_dsp_status));
+    if (!g->scratch || !g->status) { vv_dsp_gcc_phat_destroy(g); return VV_DSP_ERROR_INTERNAL; }
+    for (size_t w = 0; w < g->num_workers; ++w) {
+        gp_scratch* s = &g->scratch[w];
+        if (vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &s->fwd) != VV_DSP_OK ||
+            (!partial && vv_dsp_fft_plan_acquire(P, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &s->inv) != VV_DSP_OK)) {
+            vv_dsp_gcc_phat_destroy(g);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        s->buf = (vv_dsp_real*)gp_alloc(P * sizeof(vv_dsp_real));
+        s->spec = (vv_dsp_cpx*)gp_alloc(g->nbins * sizeof(vv_dsp_cpx));
+        s->ur = (vv_dsp_real*)gp_alloc(C * g->nbins * sizeof(vv_dsp_real));
+        s->ui = (vv_dsp_real*)gp_alloc(C * g->nbins * sizeof(vv_dsp_real));
+        s->gr = (vv_dsp_real*)gp_alloc(g->nbins * sizeof(vv_dsp_real));
+        s->gi = (vv_dsp_real*)gp_alloc(g->nbins * sizeof(vv_dsp_real));
+        s->row = (vv_dsp_real*)gp_alloc(g->lags * sizeof(vv_dsp_real));
+        if (!s->buf || !s->spec || !s->ur || !s->ui || !s->gr || !s->gi || !s->row) {
+            vv_dsp_gcc_phat_destroy(g);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+    }
+    *out = g;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_gcc_phat_num_pairs(const vv_dsp_gcc_phat* g) {
+    return g ? g->pairs : 0;
+}
+
+size_t vv_dsp_gcc_phat_lag_count(const vv_dsp_gcc_phat* g) {
+    return g ? g->lags : 0;
+}
+
+// Transform channel c and store X / |X| in split layout
+static vv_dsp_status gp_whiten_channel(const vv_dsp_gcc_phat* g, gp_scratch* s, const vv_dsp_real* xc, size_t c) {
+    const size_t nb = g->nbins;
+    memcpy(s->buf, xc, g->frame_len * sizeof(vv_dsp_real));
+    memset(s->buf + g->frame_len, 0, (g->fft_size - g->frame_len) * sizeof(vv_dsp_real));
+    vv_dsp_status st = vv_dsp_fft_execute(s->fwd, s->buf, s->spec);
+    if (st != VV_DSP_OK) return st;
+    vv_dsp_real* ur = s->ur + c * nb;
+    vv_dsp_real* ui = s->ui + c * nb;
+    for (size_t k = 0; k < nb; ++k) {
+        const vv_dsp_real re = s->spec[k].re, im = s->spec[k].im;
+        const vv_dsp_real m2 = re * re + im * im;
+        const vv_dsp_real inv = (m2 > (vv_dsp_real)GP_MAG_FLOOR) ? (vv_dsp_real)1 / VV_DSP_SQRT(m2) : (vv_dsp_real)0;
+        ur[k] = re * inv;
+        ui[k] = im * inv;
+    }
+    return VV_DSP_OK;
+}
+
+// row[t + L] for t = -L..L from the split cross-spectrum (gr, gi)
+static vv_dsp_status gp_inverse(const vv_dsp_gcc_phat* g, gp_scratch* s) {
+    const size_t nb = g->nbins, L = g->max_lag;
+    vv_dsp_real* row = s->row;
+    if (g->tc) {
+        for (size_t t = 0; t <= L; ++t) {
+            const vv_dsp_real* tc = g->tc + t * nb;
+            const vv_dsp_real* ts = g->ts + t * nb;
+            vv_dsp_real a[GP_LANES] = {0}, b[GP_LANES] = {0};
+            const size_t nv = nb - nb % GP_LANES;
+            for (size_t k = 0; k < nv; k += GP_LANES) {
+                for (size_t j = 0; j < GP_LANES; ++j) {
+                    a[j] += s->gr[k + j] * tc[k + j];
+                    b[j] += s->gi[k + j] * ts[k + j];
+                }
+            }
+            for (size_t k = nv; k < nb; ++k) {
+                a[0] += s->gr[k] * tc[k];
+                b[0] += s->gi[k] * ts[k];
+            }
+            vv_dsp_real A = 0, B = 0;
+            for (size_t j = 0; j < GP_LANES; ++j) { A += a[j]; B += b[j]; }
+            // c[t] = A - B, c[-t] = A + B
+            row[L + t] = A - B;
+            row[L - t] = A + B;
+        }
+        return VV_DSP_OK;
+    }
+    for (size_t k = 0; k < nb; ++k) {
+        s->spec[k].re = s->gr[k];
+        s->spec[k].im = s->gi[k];
+    }
+    vv_dsp_status st = vv_dsp_fft_execute(s->inv, s->spec, s->buf);
+    if (st != VV_DSP_OK) return st;
+    const size_t P = g->fft_size;
+    for (size_t t = 0; t <= L; ++t) {
+        row[L + t] = s->buf[t];
+        row[L - t] = s->buf[(P - t) % P];
+    }
+    return VV_DSP_OK;
+}
+
+static void gp_peak(const vv_dsp_gcc_phat* g, const vv_dsp_real* row, vv_dsp_real* delay, vv_dsp_real* peak) {
+    size_t im = 0;
+    for (size_t i = 1; i < g->lags; ++i) {
+        if (row[i] > row[im]) im = i;
+    }
+    double d = (double)im - (double)g->max_lag;
+    if (im > 0 && im + 1 < g->lags) {
+        const double ym = (double)row[im - 1], y0 = (double)row[im], yp = (double)row[im + 1];
+        const double den = ym - 2.0 * y0 + yp;
+        if (den < 0.0) d += 0.5 * (ym - yp) / den;
+    }
+    if (delay) *delay = (vv_dsp_real)d;
+    if (peak) *peak = row[im];
+}
+
+static void gp_worker(void* ctx, size_t w) {
+    vv_dsp_gcc_phat* g = (vv_dsp_gcc_phat*)ctx;
+    gp_scratch* s = &g->scratch[w];
+    const size_t nb = g->nbins, C = g->channels;
+    const size_t f_begin = w * g->run;
+    const size_t f_end = (f_begin + g->run < g->num_frames) ? f_begin + g->run : g->num_frames;
+    vv_dsp_status st = VV_DSP_OK;
+    for (size_t f = f_begin; st == VV_DSP_OK && f < f_end; ++f) {
+        const vv_dsp_real* xf = g->x + f * g->hop;
+        for (size_t c = 0; st == VV_DSP_OK && c < C; ++c) st = gp_whiten_channel(g, s, xf + c * g->channel_stride, c);
+        size_t pair = 0;
+        for (size_t a = 0; st == VV_DSP_OK && a + 1 < C; ++a) {
+            for (size_t b = a + 1; st == VV_DSP_OK && b < C; ++b, ++pair) {
+                // conj(U_a) U_b: already PHAT-weighted since both have unit magnitude
+                const vv_dsp_real* ar = s->ur + a * nb;
+                const vv_dsp_real* ai = s->ui + a * nb;
+                const vv_dsp_real* br = s->ur + b * nb;
+                const vv_dsp_real* bi = s->ui + b * nb;
+                for (size_t k = 0; k < nb; ++k) {
+                    s->gr[k] = ar[k] * br[k] + ai[k] * bi[k];
+                    s->gi[k] = ar[k] * bi[k] - ai[k] * br[k];
+                }
+                st = gp_inverse(g, s);
+                if (st != VV_DSP_OK) break;
+                const size_t o = f * g->pairs + pair;
+                if (g->corr) memcpy(g->corr + o * g->lags, s->row, g->lags * sizeof(vv_dsp_real));
+                gp_peak(g, s->row, g->delay ? &g->delay[o] : NULL, g->peak ? &g->peak[o] : NULL);
+            }
+        }
+    }
+    g->status[w] = st;
+}
+
+vv_dsp_status vv_dsp_gcc_phat_process(vv_dsp_gcc_phat* g, const vv_dsp_real* x, size_t num_frames, size_t hop,
+                                      size_t channel_stride, vv_dsp_real* corr, vv_dsp_real* delay,
+                                      vv_dsp_real* peak) {
+    if (!g || !x) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    size_t run = (num_frames + g->num_workers - 1) / g->num_workers;
+    if (run < GP_MIN_RUN) run = GP_MIN_RUN;
+    const size_t workers = (num_frames + run - 1) / run;
+
+    g->x = x;
+    g->num_frames = num_frames;
+    g->hop = hop;
+    g->channel_stride = channel_stride;
+    g->run = run;
+    g->corr = corr;
+    g->delay = delay;
+    g->peak = peak;
+    vv_dsp_status s = vv_dsp_parallel_run(workers, gp_worker, g);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; ++w) s = g->status[w];
+    g->x = NULL;
+    g->corr = g->delay = g->peak = NULL;
+    return s;
+}
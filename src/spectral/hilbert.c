@@ -4,74 +4,98 @@
 #include "vv_dsp/spectral/fft.h"
 #include "vv_dsp/spectral/utils.h"
 #include "vv_dsp/spectral/hilbert.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/arena.h"
+#include "vv_dsp/core/alloc.h"
 
-// Helper: allocate zeroed memory for complex array
-static vv_dsp_cpx* cpx_calloc(size_t n) {
-    vv_dsp_cpx* p = (vv_dsp_cpx*)calloc(n, sizeof(vv_dsp_cpx));
-    return p;
+#define HILBERT_PHASE_BLOCK 256 // conjugate products per vv_dsp_vatan2 call
+
+struct vv_dsp_hilbert_plan {
+    size_t n;
+    vv_dsp_arena* arena;  // owner of the struct and Z, or NULL for the heap
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2c_inv;
+    vv_dsp_cpx* Z;  // n: half spectrum from R2C, turned into the analytic spectrum in place
+};
+
+void vv_dsp_hilbert_plan_destroy(vv_dsp_hilbert_plan* plan) {
+    if (!plan) return;
+    vv_dsp_fft_plan_release(plan->r2c);
+    vv_dsp_fft_plan_release(plan->c2c_inv);
+    vv_dsp_scratch_free(plan->arena, plan->Z);
+    vv_dsp_scratch_free(plan->arena, plan);
 }
 
-vv_dsp_status vv_dsp_hilbert_analytic(const vv_dsp_real* input, size_t N, vv_dsp_cpx* analytic_output) {
-    if (!input || !analytic_output) return VV_DSP_ERROR_NULL_POINTER;
-    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+size_t vv_dsp_hilbert_scratch_size(size_t N) {
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_hilbert_plan)) +
+           vv_dsp_arena_request_size(N * sizeof(vv_dsp_cpx));
+}
 
-    vv_dsp_status st;
-
-    // Step 1: R2C FFT
-    vv_dsp_fft_plan* plan_r2c = NULL;
-    st = vv_dsp_fft_make_plan(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan_r2c);
-    if (st != VV_DSP_OK || !plan_r2c) return (st == VV_DSP_OK ? VV_DSP_ERROR_INTERNAL : st);
-
-    size_t Nh = N/2 + 1; // Hermitian packed bins
-    vv_dsp_cpx* Xh = (vv_dsp_cpx*)malloc(Nh * sizeof(vv_dsp_cpx));
-    if (!Xh) { vv_dsp_fft_destroy(plan_r2c); return VV_DSP_ERROR_INTERNAL; }
-    st = vv_dsp_fft_execute(plan_r2c, input, Xh);
-    if (st != VV_DSP_OK) { free(Xh); vv_dsp_fft_destroy(plan_r2c); return st; }
-
-    // Step 2: Build full spectrum Xfull from Hermitian-packed Xh
-    vv_dsp_cpx* Xfull = cpx_calloc(N);
-    if (!Xfull) { free(Xh); vv_dsp_fft_destroy(plan_r2c); return VV_DSP_ERROR_INTERNAL; }
-    // k=0..Nh-1 copy
-    for (size_t k=0;k<Nh;++k) Xfull[k] = Xh[k];
-    // k=Nh..N-1 from conjugate symmetry
-    for (size_t k=Nh; k<N; ++k) {
-        size_t m = N - k; // mirror index in 0..Nh-1
-        Xfull[k].re = Xh[m].re;
-        Xfull[k].im = (vv_dsp_real)(-Xh[m].im);
+vv_dsp_status vv_dsp_hilbert_plan_create_ex(size_t N, vv_dsp_arena* arena, vv_dsp_hilbert_plan** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_hilbert_plan* p = (vv_dsp_hilbert_plan*)vv_dsp_scratch_alloc(arena, sizeof(*p));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    memset(p, 0, sizeof(*p));
+    p->n = N;
+    p->arena = arena;
+    vv_dsp_status st = vv_dsp_fft_plan_acquire(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &p->r2c);
+    if (st == VV_DSP_OK) st = vv_dsp_fft_plan_acquire(N, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &p->c2c_inv);
+    if (st == VV_DSP_OK) {
+        p->Z = (vv_dsp_cpx*)vv_dsp_scratch_alloc(arena, N * sizeof(vv_dsp_cpx));
+        if (!p->Z) st = VV_DSP_ERROR_INTERNAL;
     }
+    if (st != VV_DSP_OK) { vv_dsp_hilbert_plan_destroy(p); return st; }
+    *out = p;
+    return VV_DSP_OK;
+}
 
-    // Step 3: Apply Hilbert filter H to Xfull to obtain analytic spectrum Z
-    vv_dsp_cpx* Z = cpx_calloc(N);
-    if (!Z) { free(Xh); free(Xfull); vv_dsp_fft_destroy(plan_r2c); return VV_DSP_ERROR_INTERNAL; }
-    if ((N%2)==0) {
-        // even N: k=0 and k=N/2 pass with 1, k=1..N/2-1 *2, negatives zero
-        if (N >= 1) Z[0] = Xfull[0];
-        for (size_t k=1;k<(size_t)(N/2);++k) { Z[k].re = (vv_dsp_real)2.0 * Xfull[k].re; Z[k].im = (vv_dsp_real)2.0 * Xfull[k].im; }
-        Z[N/2] = Xfull[N/2];
-        // k>N/2 remain zero
-    } else {
-        // odd N: k=0 pass, k=1..(N-1)/2 *2, negatives zero
-        Z[0] = Xfull[0];
-        size_t kmax = (N-1)/2 + 1; // equals Nh
-        for (size_t k=1;k<kmax;++k) { Z[k].re = (vv_dsp_real)2.0 * Xfull[k].re; Z[k].im = (vv_dsp_real)2.0 * Xfull[k].im; }
-        // rest zero
-    }
+vv_dsp_status vv_dsp_hilbert_plan_create(size_t N, vv_dsp_hilbert_plan** out) {
+    return vv_dsp_hilbert_plan_create_ex(N, NULL, out);
+}
 
-    // Step 4: IFFT C2C to get analytic signal directly
-    vv_dsp_fft_plan* plan_c2c_inv = NULL;
-    st = vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &plan_c2c_inv);
-    if (st != VV_DSP_OK || !plan_c2c_inv) { free(Xh); free(Xfull); free(Z); vv_dsp_fft_destroy(plan_r2c); return (st == VV_DSP_OK ? VV_DSP_ERROR_INTERNAL : st); }
-    vv_dsp_cpx* z_time = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
-    if (!z_time) { free(Xh); free(Xfull); free(Z); vv_dsp_fft_destroy(plan_r2c); vv_dsp_fft_destroy(plan_c2c_inv); return VV_DSP_ERROR_INTERNAL; }
-    st = vv_dsp_fft_execute(plan_c2c_inv, Z, z_time);
-    if (st != VV_DSP_OK) { free(Xh); free(Xfull); free(Z); free(z_time); vv_dsp_fft_destroy(plan_r2c); vv_dsp_fft_destroy(plan_c2c_inv); return st; }
+size_t vv_dsp_hilbert_plan_size(const vv_dsp_hilbert_plan* plan) {
+    return plan ? plan->n : 0;
+}
 
-    for (size_t i=0;i<N;++i) analytic_output[i] = z_time[i];
+vv_dsp_status vv_dsp_hilbert_plan_execute(vv_dsp_hilbert_plan* plan, const vv_dsp_real* input, vv_dsp_cpx* analytic_output) {
+    if (!plan || !input || !analytic_output) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t N = plan->n, Nh = N / 2 + 1;
+    vv_dsp_cpx* Z = plan->Z;
 
-    free(Xh); free(Xfull); free(Z); free(z_time);
-    vv_dsp_fft_destroy(plan_r2c);
-    vv_dsp_fft_destroy(plan_c2c_inv);
-    return VV_DSP_OK;
+    // R2C fills Z[0..Nh) with the non-negative frequencies
+    vv_dsp_status st = vv_dsp_fft_execute(plan->r2c, input, Z);
+    if (st != VV_DSP_OK) return st;
+
+    // Analytic spectrum: DC (and Nyquist for even N) pass, positives doubled,
+    // negatives zero
+    const size_t kpos = (N % 2 == 0) ? N / 2 : Nh;
+    if (kpos > 1) (void)vv_dsp_cpx_scale_array(Z + 1, (vv_dsp_real)2.0, Z + 1, kpos - 1);
+    memset(&Z[Nh], 0, (N - Nh) * sizeof(vv_dsp_cpx));
+
+    return vv_dsp_fft_execute(plan->c2c_inv, Z, analytic_output);
+}
+
+vv_dsp_status vv_dsp_hilbert_analytic_ex(const vv_dsp_real* input, size_t N, vv_dsp_cpx* analytic_output,
+                                         vv_dsp_arena* arena) {
+    if (!input || !analytic_output) return VV_DSP_ERROR_NULL_POINTER;
+    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_hilbert_plan* plan = NULL;
+    vv_dsp_status st = vv_dsp_hilbert_plan_create_ex(N, arena, &plan);
+    if (st == VV_DSP_OK) {
+        st = vv_dsp_hilbert_plan_execute(plan, input, analytic_output);
+        vv_dsp_hilbert_plan_destroy(plan);
+    }
+    vv_dsp_arena_reset_to(arena, mark);
+    return st;
+}
+
+vv_dsp_status vv_dsp_hilbert_analytic(const vv_dsp_real* input, size_t N, vv_dsp_cpx* analytic_output) {
+    return vv_dsp_hilbert_analytic_ex(input, N, analytic_output, NULL);
 }
 
 vv_dsp_status vv_dsp_instantaneous_phase(const vv_dsp_cpx* analytic_input, size_t N, vv_dsp_real* phase_output) {
@@ -82,6 +106,7 @@ vv_dsp_status vv_dsp_instantaneous_phase(const vv_dsp_cpx* analytic_input, size_
     phase_output[0] = (vv_dsp_real)phi0;
     // Integrate phase increments via conjugate product to ensure continuity
     double acc = phi0;
+#if defined(VV_DSP_USE_DOUBLE)
     for (size_t i=1;i<N;++i) {
         double re = (double)analytic_input[i].re * (double)analytic_input[i-1].re + (double)analytic_input[i].im * (double)analytic_input[i-1].im; // Re(z_i * conj(z_{i-1}))
         double im = (double)analytic_input[i].im * (double)analytic_input[i-1].re - (double)analytic_input[i].re * (double)analytic_input[i-1].im; // Im(z_i * conj(z_{i-1}))
@@ -89,6 +114,24 @@ vv_dsp_status vv_dsp_instantaneous_phase(const vv_dsp_cpx* analytic_input, size_
         acc += dphi;
         phase_output[i] = (vv_dsp_real)acc;
     }
+#else
+    // Products in double, increments by the vector atan2 a block at a time
+    vv_dsp_real re[HILBERT_PHASE_BLOCK], im[HILBERT_PHASE_BLOCK];
+    for (size_t i0 = 1; i0 < N; i0 += HILBERT_PHASE_BLOCK) {
+        const size_t m = (N - i0 < HILBERT_PHASE_BLOCK) ? N - i0 : HILBERT_PHASE_BLOCK;
+        for (size_t j = 0; j < m; ++j) {
+            const vv_dsp_cpx a = analytic_input[i0 + j], b = analytic_input[i0 + j - 1];
+            re[j] = (vv_dsp_real)((double)a.re * (double)b.re + (double)a.im * (double)b.im); // Re(z_i * conj(z_{i-1}))
+            im[j] = (vv_dsp_real)((double)a.im * (double)b.re - (double)a.re * (double)b.im); // Im(z_i * conj(z_{i-1}))
+        }
+        vv_dsp_status st = vv_dsp_vatan2(im, re, re, m, VV_DSP_VMATH_MEDIUM); // in [-pi, pi]
+        if (st != VV_DSP_OK) return st;
+        for (size_t j = 0; j < m; ++j) {
+            acc += (double)re[j];
+            phase_output[i0 + j] = (vv_dsp_real)acc;
+        }
+    }
+#endif
     return VV_DSP_OK;
 }
 
@@ -111,3 +154,129 @@ vv_dsp_status vv_dsp_instantaneous_frequency(const vv_dsp_real* unwrapped_phase_
     }
     return VV_DSP_OK;
 }
+
+// ---- Streaming FIR Hilbert transformer ----
+
+#define HILBERT_FIR_BLOCK 256  // samples filtered per pass over the taps
+
+struct vv_dsp_hilbert_fir {
+    size_t M;              // centre offset = latency
+    size_t K;              // odd offsets 1, 3, ..., 2K - 1 <= M
+    vv_dsp_real* g;        // K taps h[2k + 1]
+    vv_dsp_real* buf;      // 2M history samples followed by one block of input
+    vv_dsp_real* imag;     // one block of transformer output
+    vv_dsp_cpx* block;     // one block of analytic samples for the tracker
+    // Phase tracker
+    int has_prev;
+    double prev_re, prev_im;
+    double phase;
+};
+
+void vv_dsp_hilbert_fir_destroy(vv_dsp_hilbert_fir* h) {
+    if (!h) return;
+    vv_dsp_aligned_free(h->g);
+    vv_dsp_aligned_free(h->buf);
+    vv_dsp_aligned_free(h->imag);
+    vv_dsp_aligned_free(h->block);
+    vv_dsp_free(h);
+}
+
+vv_dsp_status vv_dsp_hilbert_fir_create(size_t num_taps, vv_dsp_hilbert_fir** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (num_taps < 3 || num_taps % 2 == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_hilbert_fir* h = (vv_dsp_hilbert_fir*)vv_dsp_calloc(1, sizeof(*h));
+    if (!h) return VV_DSP_ERROR_INTERNAL;
+    h->M = num_taps / 2;
+    h->K = (h->M + 1) / 2;
+    h->g = (vv_dsp_real*)vv_dsp_aligned_malloc(h->K * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+    h->buf = (vv_dsp_real*)vv_dsp_aligned_malloc((2 * h->M + HILBERT_FIR_BLOCK) * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+    h->imag = (vv_dsp_real*)vv_dsp_aligned_malloc(HILBERT_FIR_BLOCK * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+    h->block = (vv_dsp_cpx*)vv_dsp_aligned_malloc(HILBERT_FIR_BLOCK * sizeof(vv_dsp_cpx), VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (!h->g || !h->buf || !h->imag || !h->block) { vv_dsp_hilbert_fir_destroy(h); return VV_DSP_ERROR_INTERNAL; }
+    // Ideal response 2 / (pi n) at odd n, Blackman-windowed over [-M, M]
+    for (size_t k = 0; k < h->K; ++k) {
+        const double n = (double)(2 * k + 1);
+        const double a = VV_DSP_PI_D * n / (double)h->M;
+        const double w = 0.42 + 0.5 * cos(a) + 0.08 * cos(2.0 * a);
+        h->g[k] = (vv_dsp_real)(2.0 / (VV_DSP_PI_D * n) * w);
+    }
+    (void)vv_dsp_hilbert_fir_reset(h);
+    *out = h;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_hilbert_fir_latency(const vv_dsp_hilbert_fir* h) {
+    return h ? h->M : 0;
+}
+
+vv_dsp_status vv_dsp_hilbert_fir_reset(vv_dsp_hilbert_fir* h) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    memset(h->buf, 0, 2 * h->M * sizeof(vv_dsp_real));
+    h->has_prev = 0;
+    h->prev_re = h->prev_im = 0.0;
+    h->phase = 0.0;
+    return VV_DSP_OK;
+}
+
+// Filter m <= HILBERT_FIR_BLOCK new samples into out, then slide the history.
+// Taps in the outer loop keep the inner loop a contiguous, vectorizable sweep.
+static void hilbert_fir_block(vv_dsp_hilbert_fir* h, const vv_dsp_real* input, size_t m, vv_dsp_cpx* out) {
+    const size_t M = h->M, hist = 2 * M;
+    vv_dsp_real* buf = h->buf;
+    vv_dsp_real* y = h->imag;
+    memcpy(&buf[hist], input, m * sizeof(vv_dsp_real));
+    // Output i is centred on buf[i + M]
+    for (size_t i = 0; i < m; ++i) y[i] = 0;
+    for (size_t k = 0; k < h->K; ++k) {
+        const size_t n = 2 * k + 1;
+        const vv_dsp_real gk = h->g[k];
+        const vv_dsp_real* past = &buf[M - n];
+        const vv_dsp_real* future = &buf[M + n];
+        for (size_t i = 0; i < m; ++i) y[i] += gk * (past[i] - future[i]);
+    }
+    for (size_t i = 0; i < m; ++i) {
+        out[i].re = buf[i + M];
+        out[i].im = y[i];
+    }
+    memmove(buf, &buf[m], hist * sizeof(vv_dsp_real));
+}
+
+vv_dsp_status vv_dsp_hilbert_fir_process(vv_dsp_hilbert_fir* h, const vv_dsp_real* input, size_t n,
+                                         vv_dsp_cpx* analytic_output) {
+    if (!h || !input || !analytic_output) return VV_DSP_ERROR_NULL_POINTER;
+    for (size_t i = 0; i < n; i += HILBERT_FIR_BLOCK) {
+        const size_t m = (n - i < HILBERT_FIR_BLOCK) ? n - i : HILBERT_FIR_BLOCK;
+        hilbert_fir_block(h, &input[i], m, &analytic_output[i]);
+    }
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_hilbert_fir_track(vv_dsp_hilbert_fir* h, const vv_dsp_real* input, size_t n, double sample_rate,
+                                       vv_dsp_real* amplitude_output, vv_dsp_real* phase_output,
+                                       vv_dsp_real* freq_output) {
+    if (!h || !input) return VV_DSP_ERROR_NULL_POINTER;
+    const double scale = sample_rate / (2.0 * VV_DSP_PI_D);
+    for (size_t i = 0; i < n; i += HILBERT_FIR_BLOCK) {
+        const size_t m = (n - i < HILBERT_FIR_BLOCK) ? n - i : HILBERT_FIR_BLOCK;
+        hilbert_fir_block(h, &input[i], m, h->block);
+        for (size_t j = 0; j < m; ++j) {
+            const double re = (double)h->block[j].re, im = (double)h->block[j].im;
+            double dphi = 0.0;
+            if (h->has_prev) {
+                // Im/Re of z_j * conj(z_{j-1})
+                dphi = atan2(im * h->prev_re - re * h->prev_im, re * h->prev_re + im * h->prev_im);
+                h->phase += dphi;
+            } else {
+                h->phase = atan2(im, re);
+                h->has_prev = 1;
+            }
+            h->prev_re = re;
+            h->prev_im = im;
+            if (amplitude_output) amplitude_output[i + j] = (vv_dsp_real)sqrt(re * re + im * im);
+            if (phase_output) phase_output[i + j] = (vv_dsp_real)h->phase;
+            if (freq_output) freq_output[i + j] = (vv_dsp_real)(dphi * scale);
+        }
+    }
+    return VV_DSP_OK;
+}
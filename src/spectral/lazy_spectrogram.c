@@ -0,0 +1,441 @@
+#include "vv_dsp/spectral/lazy_spectrogram.h"
+#include "vv_dsp/core/alloc.h"
+#include "parallel.h"
+#include <stdint.h>
+#include <string.h>
+
+#define LS_DEFAULT_TILE 64
+#define LS_DEFAULT_BUDGET ((size_t)64 << 20)
+#define LS_NONE SIZE_MAX
+
+struct vv_dsp_lazy_spectrogram {
+    const vv_dsp_real* signal;
+    size_t n;
+    size_t fft_size;
+    size_t hop;
+    size_t cols;            // values per row
+    size_t tile;            // frames per tile
+    size_t prefetch;
+    vv_dsp_spectrogram_opts opts;
+    size_t num_frames;
+    size_t num_tiles;
+
+    vv_dsp_spectrogram_fetch_fn fetch;
+    void* fetch_user;
+
+    // Tile map
+    size_t* tile_slot;          // num_tiles, LS_NONE when not cached
+    unsigned char* edited;      // num_tiles, nonzero once the backing is stale for it
+
+    // Slots in LRU order: head is the most recently used
+    size_t budget_slots;        // slots the byte budget allows
+    size_t num_slots;           // min(budget_slots, num_tiles) so far
+    vv_dsp_real** slot_data;    // allocated on first use
+    size_t* slot_tile;
+    size_t* prev;
+    size_t* next;
+    size_t head, tail;
+
+    // Workers and the jobs of one fork-join
+    size_t num_workers;
+    vv_dsp_stft** handles;
+    vv_dsp_real** scratch;      // (tile + 1) rows per worker
+    vv_dsp_status* status;
+    size_t* job_tile;           // num_slots
+    size_t* job_slot;
+    unsigned char* job_fetched;
+    size_t num_jobs;
+    size_t job_workers;
+
+    vv_dsp_lazy_spectrogram_stats stats;
+};
+
+void vv_dsp_lazy_spectrogram_destroy(vv_dsp_lazy_spectrogram* ls) {
+    if (!ls) return;
+    for (size_t w = 0; w < ls->num_workers; ++w) {
+        if (ls->handles && ls->handles[w]) (void)vv_dsp_stft_destroy(ls->handles[w]);
+        if (ls->scratch) vv_dsp_free(ls->scratch[w]);
+    }
+    for (size_t s = 0; ls->slot_data && s < ls->num_slots; ++s) vv_dsp_free(ls->slot_data[s]);
+    vv_dsp_free(ls->handles);
+    vv_dsp_free(ls->scratch);
+    vv_dsp_free(ls->status);
+    vv_dsp_free(ls->slot_data);
+    vv_dsp_free(ls->slot_tile);
+    vv_dsp_free(ls->prev);
+    vv_dsp_free(ls->next);
+    vv_dsp_free(ls->job_tile);
+    vv_dsp_free(ls->job_slot);
+    vv_dsp_free(ls->job_fetched);
+    vv_dsp_free(ls->tile_slot);
+    vv_dsp_free(ls->edited);
+    vv_dsp_free(ls);
+}
+
+static size_t ls_frames(size_t fft_size, size_t hop, size_t n) {
+    return (n < fft_size) ? 1 : (1 + (n - fft_size + hop) / hop);
+}
+
+// ---------------- LRU list ----------------
+
+static void ls_unlink(vv_dsp_lazy_spectrogram* ls, size_t s) {
+    if (ls->prev[s] != LS_NONE) ls->next[ls->prev[s]] = ls->next[s];
+    else ls->head = ls->next[s];
+    if (ls->next[s] != LS_NONE) ls->prev[ls->next[s]] = ls->prev[s];
+    else ls->tail = ls->prev[s];
+}
+
+static void ls_push_front(vv_dsp_lazy_spectrogram* ls, size_t s) {
+    ls->prev[s] = LS_NONE;
+    ls->next[s] = ls->head;
+    if (ls->head != LS_NONE) ls->prev[ls->head] = s;
+    ls->head = s;
+    if (ls->tail == LS_NONE) ls->tail = s;
+}
+
+static void ls_push_back(vv_dsp_lazy_spectrogram* ls, size_t s) {
+    ls->next[s] = LS_NONE;
+    ls->prev[s] = ls->tail;
+    if (ls->tail != LS_NONE) ls->next[ls->tail] = s;
+    ls->tail = s;
+    if (ls->head == LS_NONE) ls->head = s;
+}
+
+static void ls_touch(vv_dsp_lazy_spectrogram* ls, size_t s) {
+    if (ls->head == s) return;
+    ls_unlink(ls, s);
+    ls_push_front(ls, s);
+}
+
+// Take the least recently used slot for tile t (most recently used afterwards)
+static vv_dsp_status ls_claim(vv_dsp_lazy_spectrogram* ls, size_t t, size_t* out_slot) {
+    const size_t s = ls->tail;
+    if (!ls->slot_data[s]) {
+        ls->slot_data[s] = (vv_dsp_real*)vv_dsp_malloc(ls->tile * ls->cols * sizeof(vv_dsp_real));
+        if (!ls->slot_data[s]) return VV_DSP_ERROR_INTERNAL;
+    }
+    if (ls->slot_tile[s] != LS_NONE) {
+        ls->tile_slot[ls->slot_tile[s]] = LS_NONE;
+        ls->stats.evicted++;
+        ls->stats.cached--;
+    }
+    ls->slot_tile[s] = t;
+    ls->tile_slot[t] = s;
+    ls->stats.cached++;
+    ls_touch(ls, s);
+    *out_slot = s;
+    return VV_DSP_OK;
+}
+
+// Release the slot of tile t to the back of the list; 1 if it was cached
+static int ls_release(vv_dsp_lazy_spectrogram* ls, size_t t) {
+    const size_t s = ls->tile_slot[t];
+    if (s == LS_NONE) return 0;
+    ls->tile_slot[t] = LS_NONE;
+    ls->slot_tile[s] = LS_NONE;
+    ls->stats.cached--;
+    ls_unlink(ls, s);
+    ls_push_back(ls, s);
+    return 1;
+}
+
+static void ls_drop(vv_dsp_lazy_spectrogram* ls, size_t t) {
+    ls->stats.invalidated += (size_t)ls_release(ls, t);
+}
+
+// Grow the slot bookkeeping to min(budget, num_tiles) slots; new slots are free
+static vv_dsp_status ls_grow_slots(vv_dsp_lazy_spectrogram* ls) {
+    const size_t want = ls->budget_slots < ls->num_tiles ? ls->budget_slots : ls->num_tiles;
+    if (want <= ls->num_slots) return VV_DSP_OK;
+    vv_dsp_real** data = (vv_dsp_real**)vv_dsp_realloc(ls->slot_data, want * sizeof(vv_dsp_real*));
+    if (data) ls->slot_data = data;
+    size_t** lists[] = { &ls->slot_tile, &ls->prev, &ls->next, &ls->job_tile, &ls->job_slot };
+    int ok = data != NULL;
+    for (size_t k = 0; ok && k < sizeof(lists) / sizeof(lists[0]); ++k) {
+        size_t* p = (size_t*)vv_dsp_realloc(*lists[k], want * sizeof(size_t));
+        if (p) *lists[k] = p;
+        ok = p != NULL;
+    }
+    unsigned char* fetched = ok ? (unsigned char*)vv_dsp_realloc(ls->job_fetched, want) : NULL;
+    if (fetched) ls->job_fetched = fetched;
+    if (!fetched) return VV_DSP_ERROR_INTERNAL;
+    for (size_t k = ls->num_slots; k < want; ++k) {
+        ls->slot_data[k] = NULL;
+        ls->slot_tile[k] = LS_NONE;
+        ls_push_back(ls, k);
+    }
+    ls->num_slots = want;
+    return VV_DSP_OK;
+}
+
+// ---------------- Creation ----------------
+
+static vv_dsp_status ls_alloc_tiles(vv_dsp_lazy_spectrogram* ls, size_t num_tiles, int edited) {
+    size_t* map = (size_t*)vv_dsp_malloc(num_tiles * sizeof(size_t));
+    unsigned char* ed = (unsigned char*)vv_dsp_malloc(num_tiles);
+    if (!map || !ed) {
+        vv_dsp_free(map);
+        vv_dsp_free(ed);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    const size_t keep = ls->tile_slot ? (ls->num_tiles < num_tiles ? ls->num_tiles : num_tiles) : 0;
+    for (size_t t = 0; t < num_tiles; ++t) {
+        map[t] = t < keep ? ls->tile_slot[t] : LS_NONE;
+        ed[t] = t < keep ? ls->edited[t] : (unsigned char)edited;
+    }
+    vv_dsp_free(ls->tile_slot);
+    vv_dsp_free(ls->edited);
+    ls->tile_slot = map;
+    ls->edited = ed;
+    ls->num_tiles = num_tiles;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_create(const vv_dsp_lazy_spectrogram_params* params,
+                                                              const vv_dsp_real* signal,
+                                                              size_t n,
+                                                              vv_dsp_lazy_spectrogram** out) {
+    if (!params || !out || (!signal && n > 0)) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const vv_dsp_spectrogram_opts* o = &params->opts;
+    if (params->stft.fft_size == 0 || params->stft.hop_size == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (o->scale < VV_DSP_SPECTROGRAM_MAGNITUDE || o->scale > VV_DSP_SPECTROGRAM_DB) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (o->floor < 0 || (o->scale == VV_DSP_SPECTROGRAM_DB && !(o->floor > 0))) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (o->mel_weights && o->n_mels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_lazy_spectrogram* ls = (vv_dsp_lazy_spectrogram*)vv_dsp_calloc(1, sizeof(*ls));
+    if (!ls) return VV_DSP_ERROR_INTERNAL;
+    ls->signal = signal;
+    ls->n = n;
+    ls->fft_size = params->stft.fft_size;
+    ls->hop = params->stft.hop_size;
+    ls->opts = *o;
+    ls->tile = params->tile_frames ? params->tile_frames : LS_DEFAULT_TILE;
+    ls->prefetch = params->prefetch;
+    ls->cols = o->mel_weights ? o->n_mels
+                              : (params->stft.spectrum == VV_DSP_STFT_SPECTRUM_HALF ? ls->fft_size / 2 + 1
+                                                                                      : ls->fft_size);
+    ls->num_frames = ls_frames(ls->fft_size, ls->hop, n);
+    ls->head = ls->tail = LS_NONE;
+
+    const size_t tile_bytes = ls->tile * ls->cols * sizeof(vv_dsp_real);
+    const size_t budget = params->cache_bytes ? params->cache_bytes : LS_DEFAULT_BUDGET;
+    ls->budget_slots = budget / tile_bytes ? budget / tile_bytes : 1;
+    ls->num_workers = params->num_threads ? params->num_threads : vv_dsp_parallel_default_workers();
+
+    vv_dsp_status s = ls_alloc_tiles(ls, (ls->num_frames + ls->tile - 1) / ls->tile, 0);
+    if (s == VV_DSP_OK) s = ls_grow_slots(ls);
+    if (s == VV_DSP_OK) {
+        ls->handles = (vv_dsp_stft**)vv_dsp_calloc(ls->num_workers, sizeof(vv_dsp_stft*));
+        ls->scratch = (vv_dsp_real**)vv_dsp_calloc(ls->num_workers, sizeof(vv_dsp_real*));
+        ls->status = (vv_dsp_status*)vv_dsp_malloc(ls->num_workers * sizeof(vv_dsp_status));
+        if (!ls->handles || !ls->scratch || !ls->status) s = VV_DSP_ERROR_INTERNAL;
+    }
+
+    vv_dsp_stft_config* cfg = NULL;
+    if (s == VV_DSP_OK) s = vv_dsp_stft_config_create(&params->stft, &cfg);
+    for (size_t w = 0; s == VV_DSP_OK && w < ls->num_workers; ++w) {
+        s = vv_dsp_stft_create_from_config(cfg, &ls->handles[w]);
+        ls->scratch[w] = (vv_dsp_real*)vv_dsp_malloc((ls->tile + 1) * ls->cols * sizeof(vv_dsp_real));
+        if (s == VV_DSP_OK && !ls->scratch[w]) s = VV_DSP_ERROR_INTERNAL;
+    }
+    if (cfg) (void)vv_dsp_stft_config_release(cfg);
+    if (s != VV_DSP_OK) {
+        vv_dsp_lazy_spectrogram_destroy(ls);
+        return s;
+    }
+    *out = ls;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_lazy_spectrogram_num_frames(const vv_dsp_lazy_spectrogram* ls) {
+    return ls ? ls->num_frames : 0;
+}
+
+size_t vv_dsp_lazy_spectrogram_row_size(const vv_dsp_lazy_spectrogram* ls) {
+    return ls ? ls->cols : 0;
+}
+
+vv_dsp_status vv_dsp_lazy_spectrogram_set_backing(vv_dsp_lazy_spectrogram* ls,
+                                                  vv_dsp_spectrogram_fetch_fn fetch,
+                                                  void* user) {
+    if (!ls) return VV_DSP_ERROR_NULL_POINTER;
+    ls->fetch = fetch;
+    ls->fetch_user = fetch ? user : NULL;
+    return VV_DSP_OK;
+}
+
+// ---------------- Tile computation ----------------
+
+// Rows of tile t
+static size_t ls_tile_rows(const vv_dsp_lazy_spectrogram* ls, size_t t) {
+    const size_t first = t * ls->tile;
+    return ls->num_frames - first < ls->tile ? ls->num_frames - first : ls->tile;
+}
+
+// Tile t into dst: the spectrogram of the samples its frames read, which yields its
+// rows plus at most one trailing row in scratch
+static vv_dsp_status ls_compute(vv_dsp_lazy_spectrogram* ls, size_t w, size_t t, vv_dsp_real* dst) {
+    const size_t rows = ls_tile_rows(ls, t);
+    const size_t start = t * ls->tile * ls->hop;
+    static const vv_dsp_real silence = 0;
+    const size_t span = (rows - 1) * ls->hop + ls->fft_size;
+    const size_t len = ls->n - start < span ? ls->n - start : span;
+    size_t got = 0;
+    vv_dsp_status s = vv_dsp_stft_spectrogram_ex(ls->handles[w], ls->n ? ls->signal + start : &silence, len,
+                                                 &ls->opts, ls->scratch[w], &got);
+    if (s != VV_DSP_OK) return s;
+    if (got < rows) return VV_DSP_ERROR_INTERNAL;
+    memcpy(dst, ls->scratch[w], rows * ls->cols * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+static void ls_worker(void* ctx, size_t w) {
+    vv_dsp_lazy_spectrogram* ls = (vv_dsp_lazy_spectrogram*)ctx;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t j = w; s == VV_DSP_OK && j < ls->num_jobs; j += ls->job_workers) {
+        const size_t t = ls->job_tile[j];
+        vv_dsp_real* dst = ls->slot_data[ls->job_slot[j]];
+        ls->job_fetched[j] = ls->fetch && !ls->edited[t] &&
+                             ls->fetch(ls->fetch_user, t * ls->tile, ls_tile_rows(ls, t), ls->cols, dst);
+        if (!ls->job_fetched[j]) s = ls_compute(ls, w, t, dst);
+    }
+    ls->status[w] = s;
+}
+
+// Queue uncached tile t into a free or least recently used slot
+static vv_dsp_status ls_queue(vv_dsp_lazy_spectrogram* ls, size_t t) {
+    size_t slot;
+    vv_dsp_status s = ls_claim(ls, t, &slot);
+    if (s != VV_DSP_OK) return s;
+    ls->job_tile[ls->num_jobs] = t;
+    ls->job_slot[ls->num_jobs] = slot;
+    ls->num_jobs++;
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status ls_run_jobs(vv_dsp_lazy_spectrogram* ls) {
+    if (ls->num_jobs == 0) return VV_DSP_OK;
+    ls->job_workers = ls->num_workers < ls->num_jobs ? ls->num_workers : ls->num_jobs;
+    vv_dsp_status s = vv_dsp_parallel_run(ls->job_workers, ls_worker, ls);
+    for (size_t w = 0; s == VV_DSP_OK && w < ls->job_workers; ++w) s = ls->status[w];
+    if (s != VV_DSP_OK) {
+        // Nothing half-written stays cached
+        for (size_t j = 0; j < ls->num_jobs; ++j) (void)ls_release(ls, ls->job_tile[j]);
+    } else {
+        for (size_t j = 0; j < ls->num_jobs; ++j) {
+            if (ls->job_fetched[j]) ls->stats.fetched++;
+            else ls->stats.computed++;
+        }
+    }
+    ls->num_jobs = 0;
+    return s;
+}
+
+// Make tiles [a, b] (b - a < num_slots) cached, with prefetch if room remains
+static vv_dsp_status ls_ensure(vv_dsp_lazy_spectrogram* ls, size_t a, size_t b, int with_prefetch) {
+    // Cached tiles of the slice become the most recent, so the claims below skip them
+    for (size_t t = a; t <= b; ++t) {
+        if (ls->tile_slot[t] != LS_NONE) {
+            ls_touch(ls, ls->tile_slot[t]);
+            ls->stats.hits++;
+        }
+    }
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t t = a; s == VV_DSP_OK && t <= b; ++t) {
+        if (ls->tile_slot[t] == LS_NONE) s = ls_queue(ls, t);
+    }
+    // Neighbours, following ones first, into the slots the slice does not need
+    size_t room = ls->num_slots - (b - a + 1);
+    for (size_t d = 1; s == VV_DSP_OK && with_prefetch && d <= ls->prefetch && room > 0; ++d) {
+        if (b + d < ls->num_tiles && ls->tile_slot[b + d] == LS_NONE) {
+            s = ls_queue(ls, b + d);
+            room--;
+        }
+        if (s == VV_DSP_OK && room > 0 && a >= d && ls->tile_slot[a - d] == LS_NONE) {
+            s = ls_queue(ls, a - d);
+            room--;
+        }
+    }
+    if (s == VV_DSP_OK) s = ls_run_jobs(ls);
+    // The requested tiles end up ahead of the prefetched ones
+    for (size_t t = b + 1; s == VV_DSP_OK && t-- > a;) ls_touch(ls, ls->tile_slot[t]);
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_get(vv_dsp_lazy_spectrogram* ls,
+                                                           size_t first_frame,
+                                                           size_t num_frames,
+                                                           vv_dsp_real* out) {
+    if (!ls) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_frames == 0) return VV_DSP_OK;
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    if (first_frame > ls->num_frames || num_frames > ls->num_frames - first_frame) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const size_t last_tile = (first_frame + num_frames - 1) / ls->tile;
+    size_t f = first_frame;
+    for (size_t a = first_frame / ls->tile; a <= last_tile; a += ls->num_slots) {
+        const size_t b = a + ls->num_slots - 1 < last_tile ? a + ls->num_slots - 1 : last_tile;
+        vv_dsp_status s = ls_ensure(ls, a, b, b == last_tile);
+        if (s != VV_DSP_OK) return s;
+        for (size_t t = a; t <= b; ++t) {
+            const size_t t0 = t * ls->tile;
+            const size_t end = first_frame + num_frames < t0 + ls->tile ? first_frame + num_frames : t0 + ls->tile;
+            memcpy(out + (f - first_frame) * ls->cols, ls->slot_data[ls->tile_slot[t]] + (f - t0) * ls->cols,
+                   (end - f) * ls->cols * sizeof(vv_dsp_real));
+            f = end;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+// ---------------- Edits ----------------
+
+vv_dsp_status vv_dsp_lazy_spectrogram_invalidate(vv_dsp_lazy_spectrogram* ls,
+                                                 size_t first_sample,
+                                                 size_t num_samples) {
+    if (!ls) return VV_DSP_ERROR_NULL_POINTER;
+    if (num_samples == 0) return VV_DSP_OK;
+    // Frame f reads [f * hop, f * hop + fft_size)
+    const size_t end = num_samples > SIZE_MAX - first_sample ? SIZE_MAX : first_sample + num_samples;
+    const size_t f_lo = first_sample >= ls->fft_size ? (first_sample - ls->fft_size) / ls->hop + 1 : 0;
+    size_t f_hi = (end - 1) / ls->hop;
+    if (f_lo >= ls->num_frames) return VV_DSP_OK;
+    if (f_hi >= ls->num_frames) f_hi = ls->num_frames - 1;
+    for (size_t t = f_lo / ls->tile; t <= f_hi / ls->tile; ++t) {
+        ls_drop(ls, t);
+        ls->edited[t] = 1;
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_lazy_spectrogram_set_signal(vv_dsp_lazy_spectrogram* ls,
+                                                                  const vv_dsp_real* signal,
+                                                                  size_t n) {
+    if (!ls || (!signal && n > 0)) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t frames = ls_frames(ls->fft_size, ls->hop, n);
+    const size_t tiles = (frames + ls->tile - 1) / ls->tile;
+    if (n != ls->n) {
+        vv_dsp_status s = vv_dsp_lazy_spectrogram_invalidate(ls, n < ls->n ? n : ls->n, SIZE_MAX);
+        if (s != VV_DSP_OK) return s;
+        // Tiles past the new end leave the cache before the map shrinks
+        for (size_t t = tiles; t < ls->num_tiles; ++t) ls_drop(ls, t);
+    }
+    if (tiles != ls->num_tiles) {
+        vv_dsp_status s = ls_alloc_tiles(ls, tiles, 1);
+        if (s == VV_DSP_OK) s = ls_grow_slots(ls);
+        if (s != VV_DSP_OK) return s;
+    }
+    ls->signal = signal;
+    ls->n = n;
+    ls->num_frames = frames;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_lazy_spectrogram_get_stats(const vv_dsp_lazy_spectrogram* ls,
+                                                vv_dsp_lazy_spectrogram_stats* stats) {
+    if (!ls || !stats) return VV_DSP_ERROR_NULL_POINTER;
+    *stats = ls->stats;
+    return VV_DSP_OK;
+}
@@ -0,0 +1,25 @@
+/*
+This file is part of vv-dsp
+
+Fork-join over the default thread pool or a captured one.
+*/
+
+#include "parallel.h"
+
+size_t vv_dsp_parallel_default_workers(void) {
+    return vv_dsp_parallel_pool_workers(NULL);
+}
+
+vv_dsp_status vv_dsp_parallel_run(size_t num_workers, vv_dsp_parallel_fn fn, void* ctx) {
+    return vv_dsp_threadpool_run(NULL, num_workers, fn, ctx);
+}
+
+size_t vv_dsp_parallel_pool_workers(vv_dsp_threadpool* pool) {
+    const size_t n = vv_dsp_threadpool_num_threads(pool ? pool : vv_dsp_threadpool_get_default());
+    return n ? n : 1;
+}
+
+vv_dsp_status vv_dsp_parallel_run_on(vv_dsp_threadpool* pool, size_t num_workers, vv_dsp_parallel_fn fn,
+                                     void* ctx) {
+    return vv_dsp_threadpool_run(pool, num_workers, fn, ctx);
+}
@@ -0,0 +1,32 @@
+/*
+This file is part of vv-dsp
+
+Private fork-join helper for the batch paths: runs fn(ctx, worker) for
+worker = 0..num_workers-1 as tasks of the default vv_dsp_threadpool (or of the
+pool a plan captured from its vv_dsp_context) and
+returns once every task has finished. Workers are tasks, not threads: more
+workers than pool threads simply queue, and no worker may wait for another.
+*/
+
+#ifndef VV_DSP_SPECTRAL_PARALLEL_H
+#define VV_DSP_SPECTRAL_PARALLEL_H
+
+#include <stddef.h>
+#include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/core/threadpool.h"
+
+typedef vv_dsp_task_fn vv_dsp_parallel_fn;
+
+// Workers of the default pool (at least 1): the worker count for num_threads 0
+size_t vv_dsp_parallel_default_workers(void);
+
+// Returns VV_DSP_ERROR_INTERNAL if the default pool cannot be created; no worker
+// runs then.
+vv_dsp_status vv_dsp_parallel_run(size_t num_workers, vv_dsp_parallel_fn fn, void* ctx);
+
+// The same on a plan's captured pool (NULL = the default pool)
+size_t vv_dsp_parallel_pool_workers(vv_dsp_threadpool* pool);
+vv_dsp_status vv_dsp_parallel_run_on(vv_dsp_threadpool* pool, size_t num_workers, vv_dsp_parallel_fn fn,
+                                     void* ctx);
+
+#endif // VV_DSP_SPECTRAL_PARALLEL_H
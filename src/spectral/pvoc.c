@@ -0,0 +1,350 @@
+#include "vv_dsp/spectral/pvoc.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(VV_DSP_USE_DOUBLE)
+#define PVOC_FLOOR(x) floor(x)
+#else
+#define PVOC_FLOOR(x) floorf(x)
+#endif
+
+struct vv_dsp_pvoc {
+    vv_dsp_stft* stft;      // HALF layout, hop = synthesis hop
+    size_t nfft;
+    size_t nh;              // nfft/2+1 bins
+    size_t hop;
+    double stretch;
+    double pitch;
+    double acc;             // fractional analysis position carried to the next hop
+    vv_dsp_precision_mode precision;
+    int primed;             // a frame has been analyzed since create / reset
+    // Linear input buffer; frames are windowed straight out of it
+    vv_dsp_real* in;
+    size_t cap;
+    size_t count;
+    size_t cur;             // offset of the last analyzed frame
+    // Stretched stream (stretch * pitch), read at pitch samples per output sample
+    vv_dsp_real* st;
+    size_t st_count;
+    double rpos;            // read position in st
+    // Per-bin state and scratch, nh each
+    vv_dsp_real* omega;     // nominal phase advance per sample, 2*pi*k/nfft
+    vv_dsp_real* re;
+    vv_dsp_real* im;
+    vv_dsp_real* mag;
+    vv_dsp_real* pha;       // analysis phase of the last frame
+    vv_dsp_real* pha_new;
+    vv_dsp_real* freq;      // instantaneous frequency, rad/sample
+    vv_dsp_real* syn;       // synthesis phase of the last frame
+    vv_dsp_real* ph;        // synthesis phase of the next frame
+    vv_dsp_cpx* spec;       // analysis, then synthesis spectrum
+    size_t* peaks;          // peak bins of the current analysis
+    void* block;            // everything above but the STFT
+};
+
+#define PVOC_REAL_ARRAYS 9
+// Pitch range: an output hop reads at most PVOC_PITCH_MAX hops of stretched samples
+#define PVOC_PITCH_MIN 0.25
+#define PVOC_PITCH_MAX 4.0
+
+// x wrapped to [-pi, pi); branch-free so the per-bin loops vectorize
+static VV_DSP_INLINE vv_dsp_real pvoc_wrap(vv_dsp_real x) {
+    const vv_dsp_real inv_two_pi = (vv_dsp_real)(1.0 / VV_DSP_TWO_PI_D);
+    return x - VV_DSP_TWO_PI * PVOC_FLOOR(x * inv_two_pi + (vv_dsp_real)0.5);
+}
+
+// Empty stretched stream: one zero sample ahead of the read position for the cubic
+static void pvoc_stream_reset(vv_dsp_pvoc* pv) {
+    pv->st[0] = 0;
+    pv->st_count = 1;
+    pv->rpos = 1.0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_create(const vv_dsp_pvoc_params* params, vv_dsp_pvoc** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const size_t nfft = params->fft_size, hop = params->hop_size;
+    if (nfft < 4 || (nfft & 1) || hop == 0 || hop > nfft / 2) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_pvoc* pv = (vv_dsp_pvoc*)vv_dsp_calloc(1, sizeof(*pv));
+    if (!pv) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = nfft;
+    sp.hop_size = hop;
+    sp.window = params->window;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    sp.periodic = 1;
+    vv_dsp_status s = vv_dsp_stft_create(&sp, &pv->stft);
+    if (s != VV_DSP_OK) { vv_dsp_free(pv); return s; }
+    pv->nfft = nfft;
+    pv->nh = nfft / 2 + 1;
+    pv->hop = hop;
+    pv->stretch = 1.0;
+    pv->pitch = 1.0;
+    pv->precision = VV_DSP_PRECISION_EXACT;
+    // The next frame starts at most nfft past the last one (stretch * pitch >= hop / nfft),
+    // so after pulling every ready hop less than 2*nfft samples stay buffered
+    pv->cap = 2 * nfft + (params->max_block ? params->max_block : hop);
+    const size_t nh = pv->nh;
+    // After compaction an output hop needs under (PVOC_PITCH_MAX * hop + 5) stretched
+    // samples, and frames append whole hops
+    const size_t st_cap = (size_t)(PVOC_PITCH_MAX * (double)hop) + hop + 8;
+    pv->block = vv_dsp_malloc(nh * sizeof(vv_dsp_cpx) + nh * sizeof(size_t) +
+                              (PVOC_REAL_ARRAYS * nh + pv->cap + st_cap) * sizeof(vv_dsp_real));
+    if (!pv->block) { (void)vv_dsp_stft_destroy(pv->stft); vv_dsp_free(pv); return VV_DSP_ERROR_INTERNAL; }
+    pv->spec = (vv_dsp_cpx*)pv->block;
+    pv->peaks = (size_t*)(void*)(pv->spec + nh);
+    vv_dsp_real* r = (vv_dsp_real*)(void*)(pv->peaks + nh);
+    vv_dsp_real** arrays[PVOC_REAL_ARRAYS] = {
+        &pv->omega, &pv->re, &pv->im, &pv->mag, &pv->pha, &pv->pha_new,
+        &pv->freq, &pv->syn, &pv->ph
+    };
+    for (size_t a = 0; a < PVOC_REAL_ARRAYS; ++a) *arrays[a] = r + a * nh;
+    pv->in = r + PVOC_REAL_ARRAYS * nh;
+    pv->st = pv->in + pv->cap;
+    pvoc_stream_reset(pv);
+    for (size_t k = 0; k < nh; ++k) pv->omega[k] = (vv_dsp_real)(VV_DSP_TWO_PI_D * (double)k / (double)nfft);
+    *out = pv;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_pvoc_destroy(vv_dsp_pvoc* pv) {
+    if (!pv) return VV_DSP_ERROR_NULL_POINTER;
+    (void)vv_dsp_stft_destroy(pv->stft);
+    vv_dsp_free(pv->block);
+    vv_dsp_free(pv);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_set_ratio(vv_dsp_pvoc* pv, double stretch, double pitch) {
+    if (!pv) return VV_DSP_ERROR_NULL_POINTER;
+    // Written so that NaN fails too
+    if (!(pitch >= PVOC_PITCH_MIN && pitch <= PVOC_PITCH_MAX) || !(stretch < HUGE_VAL) ||
+        !(stretch * pitch * (double)pv->nfft >= (double)pv->hop)) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    pv->stretch = stretch;
+    pv->pitch = pitch;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_set_precision(vv_dsp_pvoc* pv, vv_dsp_precision_mode mode) {
+    if (!pv) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_precision_mode_valid(mode)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    pv->precision = mode;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_pvoc_input_space(const vv_dsp_pvoc* pv) {
+    return pv ? pv->cap - (pv->count - pv->cur) : 0;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_push(vv_dsp_pvoc* pv, const vv_dsp_real* samples, size_t n) {
+    if (!pv || (!samples && n)) return VV_DSP_ERROR_NULL_POINTER;
+    if (n > vv_dsp_pvoc_input_space(pv)) return VV_DSP_ERROR_INVALID_SIZE;
+    if (pv->count + n > pv->cap) {
+        // Samples before the last analyzed frame are never read again
+        memmove(pv->in, pv->in + pv->cur, (pv->count - pv->cur) * sizeof(vv_dsp_real));
+        pv->count -= pv->cur;
+        pv->cur = 0;
+    }
+    memcpy(pv->in + pv->count, samples, n * sizeof(vv_dsp_real));
+    pv->count += n;
+    return VV_DSP_OK;
+}
+
+// Analysis hop from the last frame to the next at the internal stretch (stretch * pitch;
+// 0 before the first frame) and the fraction carried past it
+static size_t pvoc_next_hop(const vv_dsp_pvoc* pv, int primed, double acc, double* acc_out) {
+    if (!primed) {
+        *acc_out = acc;
+        return 0;
+    }
+    const double a = acc + (double)pv->hop / (pv->stretch * pv->pitch);
+    const size_t ha = (size_t)a;
+    *acc_out = a - (double)ha;
+    return ha;
+}
+
+// Frame at in + pos into mag / pha_new, and freq from the phase advance over ha samples
+static vv_dsp_status pvoc_analyze(vv_dsp_pvoc* pv, size_t pos, size_t ha) {
+    const size_t nh = pv->nh;
+    vv_dsp_status s = vv_dsp_stft_process(pv->stft, pv->in + pos, pv->spec);
+    if (s == VV_DSP_OK) s = vv_dsp_cpx_to_split(pv->spec, pv->re, pv->im, nh);
+    if (s == VV_DSP_OK) s = vv_dsp_split_magnitude(pv->re, pv->im, pv->mag, nh);
+    if (s == VV_DSP_OK) {
+        s = vv_dsp_vatan2(pv->im, pv->re, pv->pha_new, nh, vv_dsp_precision_vmath_tier(pv->precision));
+    }
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_real* omega = pv->omega;
+    if (!pv->primed) {
+        memcpy(pv->freq, omega, nh * sizeof(vv_dsp_real));
+        memcpy(pv->syn, pv->pha_new, nh * sizeof(vv_dsp_real));
+    } else {
+        // Deviation of the phase advance from the bin's nominal one, wrapped, over the hop
+        const vv_dsp_real fha = (vv_dsp_real)ha, inv_ha = (vv_dsp_real)1 / fha;
+        const vv_dsp_real* p0 = pv->pha;
+        const vv_dsp_real* p1 = pv->pha_new;
+        vv_dsp_real* freq = pv->freq;
+        for (size_t k = 0; k < nh; ++k) {
+            freq[k] = omega[k] + pvoc_wrap(p1[k] - p0[k] - omega[k] * fha) * inv_ha;
+        }
+    }
+    vv_dsp_real* t = pv->pha;
+    pv->pha = pv->pha_new;
+    pv->pha_new = t;
+    return VV_DSP_OK;
+}
+
+// Local maxima of mag over +-2 bins; their regions of influence split halfway between them
+static size_t pvoc_find_peaks(const vv_dsp_pvoc* pv) {
+    const vv_dsp_real* mag = pv->mag;
+    const size_t nh = pv->nh;
+    size_t np = 0;
+    for (size_t k = 0; k < nh; ++k) {
+        const vv_dsp_real m = mag[k];
+        if (m > 0 && (k < 1 || m > mag[k - 1]) && (k < 2 || m > mag[k - 2]) &&
+            (k + 1 >= nh || m >= mag[k + 1]) && (k + 2 >= nh || m >= mag[k + 2])) {
+            pv->peaks[np++] = k;
+        }
+    }
+    return np;
+}
+
+// Phase-locked synthesis spectrum of the current analysis. The first frame keeps the
+// analysis phases.
+static vv_dsp_status pvoc_synthesize(vv_dsp_pvoc* pv, int first) {
+    const size_t nh = pv->nh;
+    const vv_dsp_real adv = first ? (vv_dsp_real)0 : (vv_dsp_real)pv->hop;
+    const vv_dsp_real* omega = pv->omega;
+    const vv_dsp_real* syn = pv->syn;
+    const vv_dsp_real* pha = pv->pha;
+    const vv_dsp_real* freq = pv->freq;
+    vv_dsp_real* ph = pv->ph;
+    // Bins outside every region (silent frames) keep advancing at their nominal frequency
+    for (size_t k = 0; k < nh; ++k) ph[k] = syn[k] + omega[k] * adv;
+    const size_t np = pvoc_find_peaks(pv);
+    for (size_t i = 0; i < np; ++i) {
+        const size_t p = pv->peaks[i];
+        const size_t lo = i ? (pv->peaks[i - 1] + p) / 2 + 1 : 0;
+        const size_t hi = (i + 1 < np) ? (p + pv->peaks[i + 1]) / 2 + 1 : nh;
+        // The peak advances by its own frequency; the rest of its region keeps the
+        // analysis phase offset to it
+        const vv_dsp_real base = syn[p] + adv * freq[p] - pha[p];
+        for (size_t k = lo; k < hi; ++k) ph[k] = base + pha[k];
+    }
+    for (size_t k = 0; k < nh; ++k) ph[k] = pvoc_wrap(ph[k]);
+    vv_dsp_cpx* y = pv->spec;
+    vv_dsp_status s = vv_dsp_cpx_polar_to_cpx_array(pv->mag, ph, y, nh, vv_dsp_precision_vmath_tier(pv->precision));
+    if (s != VV_DSP_OK) return s;
+    // DC and Nyquist are real in a real signal's spectrum
+    y[0].im = 0;
+    y[nh - 1].im = 0;
+    // Reading the stretched stream faster raises every frequency by pitch; drop what
+    // would end up past Nyquist
+    if (pv->pitch > 1.0) {
+        for (size_t k = (size_t)((double)(nh - 1) / pv->pitch) + 1; k < nh; ++k) y[k].re = y[k].im = 0;
+    }
+    pv->ph = pv->syn;
+    pv->syn = ph;
+    return VV_DSP_OK;
+}
+
+// Append one synthesis hop to the stretched stream. VV_DSP_ERROR_INVALID_SIZE when the
+// input for the next analysis frame is not buffered yet.
+static vv_dsp_status pvoc_frame(vv_dsp_pvoc* pv) {
+    double acc;
+    const size_t ha = pvoc_next_hop(pv, pv->primed, pv->acc, &acc);
+    const size_t pos = pv->cur + ha;
+    if (pos + pv->nfft > pv->count) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_status s = VV_DSP_OK;
+    // A zero hop (internal stretch above hop_size) reuses the last analysis
+    if (!pv->primed || ha > 0) s = pvoc_analyze(pv, pos, ha);
+    if (s == VV_DSP_OK) s = pvoc_synthesize(pv, !pv->primed);
+    if (s == VV_DSP_OK) s = vv_dsp_stft_synth_frame(pv->stft, pv->spec, pv->st + pv->st_count);
+    if (s != VV_DSP_OK) return s;
+    pv->st_count += pv->hop;
+    pv->cur = pos;
+    pv->acc = acc;
+    pv->primed = 1;
+    return VV_DSP_OK;
+}
+
+// Output hops read whole samples (no interpolation) at pitch 1 from an integer position
+static int pvoc_copy_read(const vv_dsp_pvoc* pv, double rpos) {
+    return pv->pitch == 1.0 && rpos == floor(rpos);
+}
+
+// Stretched samples an output hop read from position rpos needs: the cubic reads one
+// sample before and two after each position
+static size_t pvoc_needed(const vv_dsp_pvoc* pv, double rpos) {
+    if (pvoc_copy_read(pv, rpos)) return (size_t)rpos + pv->hop;
+    return (size_t)(rpos + (double)(pv->hop - 1) * pv->pitch) + 3;
+}
+
+size_t vv_dsp_pvoc_hops_ready(const vv_dsp_pvoc* pv) {
+    if (!pv) return 0;
+    // Synthesis hops the buffered input still yields...
+    size_t frames = 0, pos = pv->cur;
+    double acc = pv->acc;
+    for (int primed = pv->primed;; primed = 1, ++frames) {
+        pos += pvoc_next_hop(pv, primed, acc, &acc);
+        if (pos + pv->nfft > pv->count) break;
+    }
+    // ...and the output hops their samples cover
+    const size_t avail = pv->st_count + frames * pv->hop;
+    size_t ready = 0;
+    for (double r = pv->rpos; pvoc_needed(pv, r) <= avail; r += (double)pv->hop * pv->pitch) ++ready;
+    return ready;
+}
+
+// Catmull-Rom interpolation between s[0] and s[1] at fraction f
+static VV_DSP_INLINE vv_dsp_real pvoc_cubic(const vv_dsp_real* s, vv_dsp_real f) {
+    const vv_dsp_real a = s[-1], b = s[0], c = s[1], d = s[2];
+    return b + (vv_dsp_real)0.5 * f *
+               (c - a + f * ((vv_dsp_real)2 * a - (vv_dsp_real)5 * b + (vv_dsp_real)4 * c - d +
+                             f * ((vv_dsp_real)3 * (b - c) + d - a)));
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_pvoc_pull(vv_dsp_pvoc* pv, vv_dsp_real* out_hop) {
+    if (!pv || !out_hop) return VV_DSP_ERROR_NULL_POINTER;
+    // Keep one stretched sample before the read position for the cubic
+    const size_t drop = (size_t)pv->rpos - 1;
+    if (drop) {
+        memmove(pv->st, pv->st + drop, (pv->st_count - drop) * sizeof(vv_dsp_real));
+        pv->st_count -= drop;
+        pv->rpos -= (double)drop;
+    }
+    const size_t need = pvoc_needed(pv, pv->rpos);
+    while (pv->st_count < need) {
+        vv_dsp_status s = pvoc_frame(pv);
+        if (s != VV_DSP_OK) return s;
+    }
+    const size_t hop = pv->hop;
+    const double step = pv->pitch;
+    if (pvoc_copy_read(pv, pv->rpos)) {
+        memcpy(out_hop, pv->st + (size_t)pv->rpos, hop * sizeof(vv_dsp_real));
+    } else {
+        for (size_t j = 0; j < hop; ++j) {
+            const double x = pv->rpos + (double)j * step;
+            const size_t i = (size_t)x;
+            out_hop[j] = pvoc_cubic(pv->st + i, (vv_dsp_real)(x - (double)i));
+        }
+    }
+    pv->rpos += (double)hop * step;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_pvoc_reset(vv_dsp_pvoc* pv) {
+    if (!pv) return VV_DSP_ERROR_NULL_POINTER;
+    pv->count = 0;
+    pv->cur = 0;
+    pv->acc = 0.0;
+    pv->primed = 0;
+    pvoc_stream_reset(pv);
+    return vv_dsp_stft_synth_reset(pv->stft);
+}
@@ -0,0 +1,215 @@
+/*
+This file is part of vv-dsp
+
+Sliding DFT tracker: selected bins of an N-sample window updated on every
+sample. The standard and damped resonators keep split real/imaginary state
+and update all bins with double-lane SIMD; the modulated variant (mSDFT)
+accumulates the modulated input against an exact twiddle table.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/spectral/sdft.h"
+#include "vv_dsp/core/alloc.h"
+#include "simd_f64.h"
+
+struct vv_dsp_sdft_plan {
+    size_t n;
+    size_t num_bins;
+    size_t padded;           // num_bins rounded up to VV_F64_LANES
+    vv_dsp_sdft_variant variant;
+    double r;                // damping (1 unless DAMPED)
+    double r_n;              // r^n, applied to the sample leaving the window
+
+    vv_dsp_real* ring;       // last n samples
+    size_t pos;              // ring slot of the oldest sample
+
+    // Standard / damped: X = rot * (r*X + d); modulated: A += d * W^(k*t)
+    double* re;              // padded
+    double* im;
+    double* rot_re;          // padded: cos(2*pi*k/n), zero in padding lanes
+    double* rot_im;          // padded: sin(2*pi*k/n)
+
+    // Modulated only
+    size_t* bin;             // k per bin
+    size_t* idx;             // (k * t) mod n for the next sample t
+    double* w_re;            // n: cos(-2*pi*m/n)
+    double* w_im;            // n: sin(-2*pi*m/n)
+};
+
+static void sdft_free(vv_dsp_sdft_plan* p) {
+    if (!p) return;
+    vv_dsp_free(p->ring);
+    vv_dsp_free(p->re); vv_dsp_free(p->im); vv_dsp_free(p->rot_re); vv_dsp_free(p->rot_im);
+    vv_dsp_free(p->bin); vv_dsp_free(p->idx); vv_dsp_free(p->w_re); vv_dsp_free(p->w_im);
+    vv_dsp_free(p);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_make_plan(size_t n,
+                                                     const size_t* bins,
+                                                     size_t num_bins,
+                                                     vv_dsp_sdft_variant variant,
+                                                     vv_dsp_real damping,
+                                                     vv_dsp_sdft_plan** out_plan) {
+    if (!out_plan || !bins) return VV_DSP_ERROR_NULL_POINTER;
+    *out_plan = NULL;
+    if (n == 0 || num_bins == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (variant < VV_DSP_SDFT_STANDARD || variant > VV_DSP_SDFT_MODULATED) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (variant == VV_DSP_SDFT_DAMPED && !(damping > 0 && damping < 1)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    for (size_t b = 0; b < num_bins; ++b) {
+        if (bins[b] >= n) return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+
+    vv_dsp_sdft_plan* p = (vv_dsp_sdft_plan*)vv_dsp_calloc(1, sizeof(vv_dsp_sdft_plan));
+    if (!p) return VV_DSP_ERROR_INTERNAL;
+    p->n = n;
+    p->num_bins = num_bins;
+    p->padded = (num_bins + VV_F64_LANES - 1) / VV_F64_LANES * VV_F64_LANES;
+    p->variant = variant;
+    p->r = (variant == VV_DSP_SDFT_DAMPED) ? (double)damping : 1.0;
+    p->r_n = pow(p->r, (double)n);
+
+    p->ring = (vv_dsp_real*)vv_dsp_calloc(n, sizeof(vv_dsp_real));
+    p->re = (double*)vv_dsp_calloc(p->padded, sizeof(double));
+    p->im = (double*)vv_dsp_calloc(p->padded, sizeof(double));
+    p->rot_re = (double*)vv_dsp_calloc(p->padded, sizeof(double));
+    p->rot_im = (double*)vv_dsp_calloc(p->padded, sizeof(double));
+    p->bin = (size_t*)vv_dsp_calloc(num_bins, sizeof(size_t));
+    p->idx = (size_t*)vv_dsp_calloc(num_bins, sizeof(size_t));
+    if (!p->ring || !p->re || !p->im || !p->rot_re || !p->rot_im || !p->bin || !p->idx) {
+        sdft_free(p);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    for (size_t b = 0; b < num_bins; ++b) {
+        const double ang = 2.0 * VV_DSP_PI_D * (double)bins[b] / (double)n;
+        p->bin[b] = bins[b];
+        p->rot_re[b] = cos(ang);
+        p->rot_im[b] = sin(ang);
+    }
+    if (variant == VV_DSP_SDFT_MODULATED) {
+        p->w_re = (double*)vv_dsp_malloc(n * sizeof(double));
+        p->w_im = (double*)vv_dsp_malloc(n * sizeof(double));
+        if (!p->w_re || !p->w_im) {
+            sdft_free(p);
+            return VV_DSP_ERROR_INTERNAL;
+        }
+        for (size_t m = 0; m < n; ++m) {
+            const double ang = -2.0 * VV_DSP_PI_D * (double)m / (double)n;
+            p->w_re[m] = cos(ang);
+            p->w_im[m] = sin(ang);
+        }
+    }
+    *out_plan = p;
+    return VV_DSP_OK;
+}
+
+// Slide the window by one sample; returns x[t] - r^n * x[t-n]
+static double sdft_slide(vv_dsp_sdft_plan* p, vv_dsp_real x) {
+    const double d = (double)x - p->r_n * (double)p->ring[p->pos];
+    p->ring[p->pos] = x;
+    if (++p->pos == p->n) p->pos = 0;
+    return d;
+}
+
+static void sdft_step_resonator(vv_dsp_sdft_plan* p, double d) {
+    double* re = p->re;
+    double* im = p->im;
+    const double r = p->r;
+    size_t b = 0;
+#if VV_F64_LANES > 1
+    const vv_f64_vec rv = VV_F64_SET1(r), dv = VV_F64_SET1(d);
+    for (; b < p->padded; b += VV_F64_LANES) {
+        const vv_f64_vec cr = VV_F64_LOAD(p->rot_re + b), ci = VV_F64_LOAD(p->rot_im + b);
+        const vv_f64_vec tr = VV_F64_MULADD(dv, rv, VV_F64_LOAD(re + b));
+        const vv_f64_vec ti = VV_F64_MUL(rv, VV_F64_LOAD(im + b));
+        VV_F64_STORE(re + b, VV_F64_SUB(VV_F64_MUL(cr, tr), VV_F64_MUL(ci, ti)));
+        VV_F64_STORE(im + b, VV_F64_MULADD(VV_F64_MUL(cr, ti), ci, tr));
+    }
+#endif
+    for (; b < p->num_bins; ++b) {
+        const double tr = r * re[b] + d, ti = r * im[b];
+        re[b] = p->rot_re[b] * tr - p->rot_im[b] * ti;
+        im[b] = p->rot_re[b] * ti + p->rot_im[b] * tr;
+    }
+}
+
+static void sdft_step_modulated(vv_dsp_sdft_plan* p, double d) {
+    for (size_t b = 0; b < p->num_bins; ++b) {
+        size_t m = p->idx[b];
+        p->re[b] += d * p->w_re[m];
+        p->im[b] += d * p->w_im[m];
+        m += p->bin[b];
+        if (m >= p->n) m -= p->n;
+        p->idx[b] = m;
+    }
+}
+
+static void sdft_read(const vv_dsp_sdft_plan* p, vv_dsp_cpx* out) {
+    if (p->variant == VV_DSP_SDFT_MODULATED) {
+        // X = A * W^(-k*(t+1)); idx already holds k*(t+1) mod n
+        for (size_t b = 0; b < p->num_bins; ++b) {
+            const double wr = p->w_re[p->idx[b]], wi = -p->w_im[p->idx[b]];
+            out[b] = vv_dsp_cpx_make((vv_dsp_real)(p->re[b] * wr - p->im[b] * wi),
+                                     (vv_dsp_real)(p->re[b] * wi + p->im[b] * wr));
+        }
+    } else {
+        for (size_t b = 0; b < p->num_bins; ++b) {
+            out[b] = vv_dsp_cpx_make((vv_dsp_real)p->re[b], (vv_dsp_real)p->im[b]);
+        }
+    }
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_update(vv_dsp_sdft_plan* plan, vv_dsp_real sample) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    const double d = sdft_slide(plan, sample);
+    if (plan->variant == VV_DSP_SDFT_MODULATED) {
+        sdft_step_modulated(plan, d);
+    } else {
+        sdft_step_resonator(plan, d);
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_process(vv_dsp_sdft_plan* plan,
+                                                   const vv_dsp_real* in,
+                                                   size_t len,
+                                                   vv_dsp_cpx* out) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    if (len == 0) return VV_DSP_OK;
+    if (!in) return VV_DSP_ERROR_NULL_POINTER;
+    const int modulated = plan->variant == VV_DSP_SDFT_MODULATED;
+    for (size_t t = 0; t < len; ++t) {
+        const double d = sdft_slide(plan, in[t]);
+        if (modulated) {
+            sdft_step_modulated(plan, d);
+        } else {
+            sdft_step_resonator(plan, d);
+        }
+        if (out) sdft_read(plan, out + t * plan->num_bins);
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_sdft_get_bins(const vv_dsp_sdft_plan* plan, vv_dsp_cpx* out) {
+    if (!plan || !out) return VV_DSP_ERROR_NULL_POINTER;
+    sdft_read(plan, out);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_sdft_reset(vv_dsp_sdft_plan* plan) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    memset(plan->ring, 0, plan->n * sizeof(vv_dsp_real));
+    memset(plan->re, 0, plan->padded * sizeof(double));
+    memset(plan->im, 0, plan->padded * sizeof(double));
+    memset(plan->idx, 0, plan->num_bins * sizeof(size_t));
+    plan->pos = 0;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_sdft_destroy(vv_dsp_sdft_plan* plan) {
+    if (!plan) return VV_DSP_ERROR_NULL_POINTER;
+    sdft_free(plan);
+    return VV_DSP_OK;
+}
@@ -0,0 +1,49 @@
+/*
+This file is part of vv-dsp
+
+Private double-lane SIMD helpers for spectral kernels that keep their
+recursive state in double precision (bin bank, sliding DFT) and are
+therefore vectorized in float and double builds alike.
+VV_F64_MULADD(a, b, c) = a + b*c.
+*/
+
+#ifndef VV_DSP_SPECTRAL_SIMD_F64_H
+#define VV_DSP_SPECTRAL_SIMD_F64_H
+
+#include "vv_dsp/core/simd_utils.h"
+
+#if defined(VV_DSP_SIMD_AVX2)
+#  define VV_F64_LANES 4
+typedef __m256d vv_f64_vec;
+#  define VV_F64_LOAD(p) _mm256_loadu_pd(p)
+#  define VV_F64_STORE(p, v) _mm256_storeu_pd((p), (v))
+#  define VV_F64_SET1(x) _mm256_set1_pd(x)
+#  define VV_F64_ADD(a, b) _mm256_add_pd((a), (b))
+#  define VV_F64_SUB(a, b) _mm256_sub_pd((a), (b))
+#  define VV_F64_MUL(a, b) _mm256_mul_pd((a), (b))
+#  define VV_F64_MULADD(a, b, c) _mm256_add_pd((a), _mm256_mul_pd((b), (c)))
+#elif defined(VV_DSP_SIMD_SSE41)
+#  define VV_F64_LANES 2
+typedef __m128d vv_f64_vec;
+#  define VV_F64_LOAD(p) _mm_loadu_pd(p)
+#  define VV_F64_STORE(p, v) _mm_storeu_pd((p), (v))
+#  define VV_F64_SET1(x) _mm_set1_pd(x)
+#  define VV_F64_ADD(a, b) _mm_add_pd((a), (b))
+#  define VV_F64_SUB(a, b) _mm_sub_pd((a), (b))
+#  define VV_F64_MUL(a, b) _mm_mul_pd((a), (b))
+#  define VV_F64_MULADD(a, b, c) _mm_add_pd((a), _mm_mul_pd((b), (c)))
+#elif defined(VV_DSP_SIMD_NEON) && defined(__aarch64__)
+#  define VV_F64_LANES 2
+typedef float64x2_t vv_f64_vec;
+#  define VV_F64_LOAD(p) vld1q_f64(p)
+#  define VV_F64_STORE(p, v) vst1q_f64((p), (v))
+#  define VV_F64_SET1(x) vdupq_n_f64(x)
+#  define VV_F64_ADD(a, b) vaddq_f64((a), (b))
+#  define VV_F64_SUB(a, b) vsubq_f64((a), (b))
+#  define VV_F64_MUL(a, b) vmulq_f64((a), (b))
+#  define VV_F64_MULADD(a, b, c) vfmaq_f64((a), (b), (c))
+#else
+#  define VV_F64_LANES 1
+#endif
+
+#endif /* VV_DSP_SPECTRAL_SIMD_F64_H */
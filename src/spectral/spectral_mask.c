@@ -0,0 +1,220 @@
+#include "vv_dsp/spectral/spectral_mask.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
+#include <string.h>
+
+typedef enum {
+    SM_MODE_REAL,
+    SM_MODE_COMPLEX,
+    SM_MODE_CALLBACK
+} sm_mode;
+
+struct vv_dsp_spectral_mask {
+    vv_dsp_stft** stft;     // one HALF handle per channel on a shared config
+    size_t channels;
+    size_t nfft;
+    size_t nh;              // nfft/2+1 bins
+    size_t hop;
+    size_t max_block;
+    sm_mode mode;
+    vv_dsp_spectral_mask_fn fn;
+    void* user;
+    // Frame bins (analysed, masked and synthesized in place), masks and output FIFOs
+    vv_dsp_cpx* spec;       // nh, shared by the channels
+    vv_dsp_cpx* cmask;      // nh
+    vv_dsp_real* rmask;     // nh
+    vv_dsp_real* fifo;      // fifo_cap per channel
+    size_t fifo_cap;
+    size_t fifo_count;      // samples queued per channel
+    void* block;            // everything above but the STFTs, SIMD-aligned
+};
+
+vv_dsp_status vv_dsp_spectral_mask_destroy(vv_dsp_spectral_mask* sm) {
+    if (!sm) return VV_DSP_ERROR_NULL_POINTER;
+    if (sm->stft) {
+        for (size_t c = 0; c < sm->channels; ++c) (void)vv_dsp_stft_destroy(sm->stft[c]);
+        vv_dsp_free(sm->stft);
+    }
+    vv_dsp_aligned_free(sm->block);
+    vv_dsp_free(sm);
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_mask_create(const vv_dsp_spectral_mask_params* params,
+                                                           vv_dsp_spectral_mask** out) {
+    if (!params || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    const size_t nfft = params->fft_size, hop = params->hop_size;
+    if (nfft < 4 || (nfft & 1) || hop == 0 || hop > nfft / 2 || params->channels == 0) {
+        return VV_DSP_ERROR_INVALID_SIZE;
+    }
+
+    vv_dsp_spectral_mask* sm = (vv_dsp_spectral_mask*)vv_dsp_calloc(1, sizeof(*sm));
+    if (!sm) return VV_DSP_ERROR_INTERNAL;
+    sm->channels = params->channels;
+    sm->nfft = nfft;
+    sm->nh = nfft / 2 + 1;
+    sm->hop = hop;
+    sm->max_block = params->max_block ? params->max_block : hop;
+    sm->mode = SM_MODE_REAL;
+
+    // One config, one stream handle per channel
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = nfft;
+    sp.hop_size = hop;
+    sp.window = params->window;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    sp.periodic = 1;
+    vv_dsp_stft_config* cfg = NULL;
+    vv_dsp_status s = vv_dsp_stft_config_create(&sp, &cfg);
+    if (s == VV_DSP_OK) {
+        sm->stft = (vv_dsp_stft**)vv_dsp_calloc(sm->channels, sizeof(vv_dsp_stft*));
+        if (!sm->stft) s = VV_DSP_ERROR_INTERNAL;
+        for (size_t c = 0; s == VV_DSP_OK && c < sm->channels; ++c) {
+            s = vv_dsp_stft_create_from_config(cfg, &sm->stft[c]);
+            if (s == VV_DSP_OK) s = vv_dsp_stft_prepare(sm->stft[c], sm->max_block);
+        }
+        (void)vv_dsp_stft_config_release(cfg);
+    }
+    if (s != VV_DSP_OK) {
+        (void)vv_dsp_spectral_mask_destroy(sm);
+        return s;
+    }
+
+    // A call queues at most hop + max_block samples per channel (see process)
+    const size_t nh = sm->nh;
+    sm->fifo_cap = hop + sm->max_block;
+    sm->block = vv_dsp_aligned_malloc(2 * nh * sizeof(vv_dsp_cpx) +
+                                      (nh + sm->channels * sm->fifo_cap) * sizeof(vv_dsp_real),
+                                      VV_DSP_SIMD_ALIGN_DEFAULT);
+    if (!sm->block) {
+        (void)vv_dsp_spectral_mask_destroy(sm);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    sm->spec = (vv_dsp_cpx*)sm->block;
+    sm->cmask = sm->spec + nh;
+    sm->rmask = (vv_dsp_real*)(void*)(sm->cmask + nh);
+    sm->fifo = sm->rmask + nh;
+    for (size_t k = 0; k < nh; ++k) sm->rmask[k] = 1;
+    s = vv_dsp_spectral_mask_reset(sm);
+    if (s != VV_DSP_OK) {
+        (void)vv_dsp_spectral_mask_destroy(sm);
+        return s;
+    }
+    *out = sm;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_spectral_mask_latency(const vv_dsp_spectral_mask* sm) {
+    return sm ? sm->nfft : 0;
+}
+
+size_t vv_dsp_spectral_mask_num_bins(const vv_dsp_spectral_mask* sm) {
+    return sm ? sm->nh : 0;
+}
+
+vv_dsp_status vv_dsp_spectral_mask_set_real(vv_dsp_spectral_mask* sm, const vv_dsp_real* mask) {
+    if (!sm || !mask) return VV_DSP_ERROR_NULL_POINTER;
+    memcpy(sm->rmask, mask, sm->nh * sizeof(vv_dsp_real));
+    sm->mode = SM_MODE_REAL;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_spectral_mask_set_complex(vv_dsp_spectral_mask* sm, const vv_dsp_cpx* mask) {
+    if (!sm || !mask) return VV_DSP_ERROR_NULL_POINTER;
+    memcpy(sm->cmask, mask, sm->nh * sizeof(vv_dsp_cpx));
+    sm->mode = SM_MODE_COMPLEX;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_spectral_mask_set_callback(vv_dsp_spectral_mask* sm, vv_dsp_spectral_mask_fn fn, void* user) {
+    if (!sm || !fn) return VV_DSP_ERROR_NULL_POINTER;
+    sm->fn = fn;
+    sm->user = user;
+    sm->mode = SM_MODE_CALLBACK;
+    return VV_DSP_OK;
+}
+
+// Mask the bins in place: straight loops over the interleaved spectrum
+static vv_dsp_status sm_apply(vv_dsp_spectral_mask* sm, size_t c) {
+    vv_dsp_cpx* X = sm->spec;
+    const size_t nh = sm->nh;
+    if (sm->mode == SM_MODE_REAL) {
+        const vv_dsp_real* g = sm->rmask;
+        for (size_t k = 0; k < nh; ++k) {
+            X[k].re *= g[k];
+            X[k].im *= g[k];
+        }
+    } else if (sm->mode == SM_MODE_COMPLEX) {
+        const vv_dsp_cpx* m = sm->cmask;
+        for (size_t k = 0; k < nh; ++k) {
+            const vv_dsp_real re = X[k].re * m[k].re - X[k].im * m[k].im;
+            X[k].im = X[k].re * m[k].im + X[k].im * m[k].re;
+            X[k].re = re;
+        }
+    } else {
+        return sm->fn(sm->user, c, X, nh);
+    }
+    return VV_DSP_OK;
+}
+
+// One frame of every channel: analyze into the shared bins, mask, synthesize one
+// hop into each FIFO
+static vv_dsp_status sm_frame(vv_dsp_spectral_mask* sm) {
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < sm->channels; ++c) {
+        s = vv_dsp_stft_pop_frame(sm->stft[c], sm->spec);
+        if (s == VV_DSP_OK) s = sm_apply(sm, c);
+        if (s == VV_DSP_OK) {
+            s = vv_dsp_stft_synth_frame(sm->stft[c], sm->spec, sm->fifo + c * sm->fifo_cap + sm->fifo_count);
+        }
+    }
+    if (s == VV_DSP_OK) sm->fifo_count += sm->hop;
+    return s;
+}
+
+// Same bookkeeping as vv_dsp_denoise_process(): after the pre-roll and hop zeros in
+// the FIFOs the delay is exactly fft_size, and the FIFOs hold between n and
+// hop + n samples before a call's output is taken.
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_spectral_mask_process(vv_dsp_spectral_mask* sm,
+                                                            const vv_dsp_real* const* in,
+                                                            vv_dsp_real* const* out,
+                                                            size_t n) {
+    if (!sm || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (n > sm->max_block) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t ch = sm->channels;
+    for (size_t c = 0; c < ch; ++c) {
+        if (!in[c] || !out[c]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < ch; ++c) s = vv_dsp_stft_push(sm->stft[c], in[c], n);
+    while (s == VV_DSP_OK && vv_dsp_stft_frames_ready(sm->stft[0]) > 0) s = sm_frame(sm);
+    if (s != VV_DSP_OK) return s;
+    for (size_t c = 0; c < ch; ++c) {
+        vv_dsp_real* f = sm->fifo + c * sm->fifo_cap;
+        memcpy(out[c], f, n * sizeof(vv_dsp_real));
+        memmove(f, f + n, (sm->fifo_count - n) * sizeof(vv_dsp_real));
+    }
+    sm->fifo_count -= n;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_spectral_mask_reset(vv_dsp_spectral_mask* sm) {
+    if (!sm) return VV_DSP_ERROR_NULL_POINTER;
+    memset(sm->fifo, 0, sm->channels * sm->fifo_cap * sizeof(vv_dsp_real));
+    sm->fifo_count = sm->hop;
+    // Pre-roll of fft_size - hop_size zeros, pushed from the zeroed first FIFO
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t c = 0; s == VV_DSP_OK && c < sm->channels; ++c) {
+        s = vv_dsp_stft_stream_reset(sm->stft[c]);
+        if (s == VV_DSP_OK) s = vv_dsp_stft_synth_reset(sm->stft[c]);
+        for (size_t left = sm->nfft - sm->hop; s == VV_DSP_OK && left > 0;) {
+            const size_t m = left < sm->fifo_cap ? left : sm->fifo_cap;
+            s = vv_dsp_stft_push(sm->stft[c], sm->fifo, m);
+            left -= m;
+        }
+    }
+    return s;
+}
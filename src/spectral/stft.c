@@ -1,73 +1,329 @@
 #include "vv_dsp/spectral/stft.h"
 #include "vv_dsp/window.h"
 #include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/split_complex.h"
+#include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
+#include "vv_dsp/core/profile.h"
+#include "vv_dsp/core.h"
+#include "parallel.h"
+#include "fft_backend.h"
+#include "../core/typed_foreign.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-struct vv_dsp_stft {
+#if defined(_MSC_VER)
+#include <windows.h>
+#define STFT_REF_INC(p) InterlockedIncrement(p)
+#define STFT_REF_DEC(p) InterlockedDecrement(p)
+#else
+#define STFT_REF_INC(p) __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+#define STFT_REF_DEC(p) __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#endif
+
+// Immutable after creation; shared by every handle created from it
+struct vv_dsp_stft_config {
     size_t nfft;
     size_t hop;
+    size_t nbins;
     vv_dsp_stft_window win_type;
-    vv_dsp_real* win;      // window coefficients length nfft
-    vv_dsp_real* timebuf;  // temp buffer length nfft
+    vv_dsp_stft_spectrum spectrum;
+    const vv_dsp_real* win;  // from the shared window cache
+    vv_dsp_real* shift_win;  // win * (-1)^i for fftshifted spectra, NULL otherwise
+    vv_dsp_real* synth_win;
+    vv_dsp_real cola_gain;   // 1 / constant window-square sum, 0 when not COLA
     vv_dsp_fft_plan* plan_f;
     vv_dsp_fft_plan* plan_b;
-    // Reusable complex buffers to avoid per-call allocations
-    vv_dsp_cpx* work_fft_in;
+    int ws_ok;             // both plans run with caller workspace
+    size_t ws_bytes;       // workspace for the larger of the two
+    // Captured from the creating vv_dsp_context
+    int backend;           // FFT backend, or VV_DSP_CONTEXT_DEFAULT
+    vv_dsp_precision_mode precision;
+    vv_dsp_threadpool* pool;
+    volatile long refs;
+};
+
+struct vv_dsp_stft {
+    vv_dsp_stft_config* cfg;
+    size_t nfft;
+    size_t hop;
+    size_t nbins;          // nfft (FULL) or nfft/2+1 (HALF)
+    vv_dsp_stft_spectrum spectrum;
+    const vv_dsp_real* win;      // window coefficients length nfft (config)
+    vv_dsp_real* timebuf;  // temp buffer length nfft
+    const vv_dsp_fft_plan* plan_f; // R2C in both layouts
+    const vv_dsp_fft_plan* plan_b; // C2R (HALF) or C2C (FULL)
+    // Shared handles run the config's plans with their own workspace, or own
+    // private plans when the backend has no workspace entry point
+    int use_ws;
+    void* ws;
+    vv_dsp_fft_plan* own_f;
+    vv_dsp_fft_plan* own_b;
+    // Reusable complex buffer for the FULL-layout inverse to avoid per-call allocations
     vv_dsp_cpx* work_fft_time;
+    // Split spectrum scratch (2 * (nfft/2+1)) for the serial spectrogram
+    vv_dsp_real* spec_split;
+    // Streaming analysis ring
+    vv_dsp_real* ring;
+    size_t ring_cap;
+    size_t ring_rd;        // ring index of the next frame's first sample
+    size_t ring_count;     // samples buffered from ring_rd
+    size_t max_block;      // block size from vv_dsp_stft_prepare(), 0 when not prepared
+    vv_dsp_precision_mode precision; // spectrogram log / dB step
+    vv_dsp_threadpool* pool; // parallel spectrogram (config's), NULL = default
+    // Streaming synthesis
+    const vv_dsp_real* synth_win; // win / periodic sum of win^2 at the hop (config)
+    vv_dsp_real* ola;       // overlap-add accumulator length nfft
+    // Scratch block holding work_fft_time, timebuf, spec_split and ola
+    void* scratch;
+    // Device-side spectrogram state on the cuFFT backend, created by the first call
+    vv_dsp_cufft_spectrogram* gpu;
 };
 
-static vv_dsp_status make_window(vv_dsp_stft_window wt, size_t n, vv_dsp_real* out) {
-    switch (wt) {
-        case VV_DSP_STFT_WIN_BOXCAR: return vv_dsp_window_boxcar(n, out);
-        case VV_DSP_STFT_WIN_HANN: return vv_dsp_window_hann(n, out);
-        case VV_DSP_STFT_WIN_HAMMING: return vv_dsp_window_hamming(n, out);
-        default: return VV_DSP_ERROR_OUT_OF_RANGE;
+// Take a reference on the cached analysis window
+static vv_dsp_status acquire_window(const vv_dsp_stft_params* p, const vv_dsp_real** out) {
+    static const vv_dsp_window_kind kinds[] = {
+        VV_DSP_WINDOW_KIND_BOXCAR, VV_DSP_WINDOW_KIND_HANN, VV_DSP_WINDOW_KIND_HAMMING,
+        VV_DSP_WINDOW_KIND_BLACKMAN, VV_DSP_WINDOW_KIND_BLACKMAN_HARRIS, VV_DSP_WINDOW_KIND_NUTTALL,
+        VV_DSP_WINDOW_KIND_FLATTOP, VV_DSP_WINDOW_KIND_KAISER, VV_DSP_WINDOW_KIND_TUKEY,
+        VV_DSP_WINDOW_KIND_BARTLETT, VV_DSP_WINDOW_KIND_BOHMAN, VV_DSP_WINDOW_KIND_COSINE,
+        VV_DSP_WINDOW_KIND_PLANCK_TAPER
+    };
+    if ((unsigned)p->window >= sizeof(kinds) / sizeof(kinds[0])) return VV_DSP_ERROR_OUT_OF_RANGE;
+    return vv_dsp_window_acquire(kinds[p->window], p->fft_size, p->window_param, p->periodic != 0, out);
+}
+
+// Relative spread of the window-square sum still treated as constant
+#define STFT_COLA_TOL 1e-6
+
+static void config_free(vv_dsp_stft_config* c) {
+    vv_dsp_fft_destroy(c->plan_f);
+    vv_dsp_fft_destroy(c->plan_b);
+    vv_dsp_window_release(c->win);
+    vv_dsp_free(c->shift_win);
+    vv_dsp_free(c->synth_win);
+    vv_dsp_free(c);
+}
+
+// Backend of the plans a handle creates or borrows after construction
+static vv_dsp_fft_backend stft_backend(const vv_dsp_stft_config* c) {
+    return c->backend == VV_DSP_CONTEXT_DEFAULT ? vv_dsp_fft_get_backend() : (vv_dsp_fft_backend)c->backend;
+}
+
+static vv_dsp_status stft_make_plans(const vv_dsp_stft_config* c, vv_dsp_fft_plan** f, vv_dsp_fft_plan** b) {
+    const vv_dsp_fft_backend be = stft_backend(c);
+    const int half = (c->spectrum == VV_DSP_STFT_SPECTRUM_HALF);
+    if (vv_dsp_fft_make_plan_backend(c->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, be, f) != VV_DSP_OK ||
+        vv_dsp_fft_make_plan_backend(c->nfft, half ? VV_DSP_FFT_C2R : VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, be, b) !=
+            VV_DSP_OK) {
+        return VV_DSP_ERROR_INTERNAL;
     }
+    return VV_DSP_OK;
 }
 
-VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create(const vv_dsp_stft_params* params, vv_dsp_stft** out) {
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_config_create(const vv_dsp_stft_params* params,
+                                                         vv_dsp_stft_config** out) {
+    return vv_dsp_stft_config_create_ctx(NULL, params, out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_config_create_ctx(const vv_dsp_context* ctx,
+                                                             const vv_dsp_stft_params* params,
+                                                             vv_dsp_stft_config** out) {
     if (!out || !params) return VV_DSP_ERROR_NULL_POINTER;
     *out = NULL;
+    vv_dsp_fft_backend backend;
+    vv_dsp_status cs = vv_dsp_context_check(ctx);
+    if (cs == VV_DSP_OK) cs = vv_dsp_fft_context_backend(ctx, &backend);
+    if (cs != VV_DSP_OK) return cs;
     if (params->fft_size == 0 || params->hop_size == 0 || params->hop_size > params->fft_size)
         return VV_DSP_ERROR_INVALID_SIZE;
-    vv_dsp_stft* h = (vv_dsp_stft*)calloc(1, sizeof(*h));
-    if (!h) return VV_DSP_ERROR_INTERNAL;
-    h->nfft = params->fft_size;
-    h->hop  = params->hop_size;
-    h->win_type = params->window;
-    h->win = (vv_dsp_real*)malloc(sizeof(vv_dsp_real)*h->nfft);
-    h->timebuf = (vv_dsp_real*)malloc(sizeof(vv_dsp_real)*h->nfft);
-    h->work_fft_in = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*h->nfft);
-    h->work_fft_time = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*h->nfft);
-    if (!h->win || !h->timebuf || !h->work_fft_in || !h->work_fft_time) {
-        free(h->win); free(h->timebuf); free(h->work_fft_in); free(h->work_fft_time); free(h);
+    if (params->spectrum != VV_DSP_STFT_SPECTRUM_FULL && params->spectrum != VV_DSP_STFT_SPECTRUM_HALF)
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (params->fftshift && params->spectrum != VV_DSP_STFT_SPECTRUM_FULL) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (params->fftshift && (params->fft_size & 1)) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_stft_config* c = (vv_dsp_stft_config*)vv_dsp_calloc(1, sizeof(*c));
+    if (!c) return VV_DSP_ERROR_INTERNAL;
+    c->refs = 1;
+    c->nfft = params->fft_size;
+    c->hop  = params->hop_size;
+    c->win_type = params->window;
+    c->spectrum = params->spectrum;
+    c->backend = ctx ? ctx->fft_backend : VV_DSP_CONTEXT_DEFAULT;
+    c->precision = ctx ? ctx->precision : VV_DSP_PRECISION_EXACT;
+    c->pool = ctx ? ctx->pool : NULL;
+    const int half = (c->spectrum == VV_DSP_STFT_SPECTRUM_HALF);
+    c->nbins = half ? c->nfft / 2 + 1 : c->nfft;
+    vv_dsp_status s = acquire_window(params, &c->win);
+    if (s != VV_DSP_OK) { config_free(c); return s; }
+    c->synth_win = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real)*c->nfft);
+    if (params->fftshift) c->shift_win = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * c->nfft);
+    if (!c->synth_win || (params->fftshift && !c->shift_win)) {
+        config_free(c);
         return VV_DSP_ERROR_INTERNAL;
     }
-    vv_dsp_status s = make_window(h->win_type, h->nfft, h->win);
-    if (s != VV_DSP_OK) { free(h->win); free(h->timebuf); free(h); return s; }
+    // A real frame times (-1)^i has X[k + nfft/2]: the R2C half and its mirror then
+    // come out fftshifted, and the inverse is undone by the same window
+    if (c->shift_win) {
+        for (size_t i = 0; i < c->nfft; ++i) c->shift_win[i] = (i & 1) ? -c->win[i] : c->win[i];
+    }
+    const vv_dsp_real* w = c->shift_win ? c->shift_win : c->win;
 
     // Per-sample normalization will be accumulated at reconstruction time via norm_add buffer.
+    // Streaming synthesis divides by its steady-state value instead, which only depends on
+    // i mod hop: d[r] = sum_k win[r + k*hop]^2. Stored temporarily in synth_win.
+    vv_dsp_real* d = c->synth_win;
+    double d_min = 0.0, d_max = 0.0;
+    for (size_t r = 0; r < c->hop; ++r) {
+        double acc = 0.0;
+        for (size_t i = r; i < c->nfft; i += c->hop) acc += (double)c->win[i] * (double)c->win[i];
+        d[r] = (vv_dsp_real)acc;
+        if (r == 0 || acc < d_min) d_min = acc;
+        if (r == 0 || acc > d_max) d_max = acc;
+    }
+    // A constant sum (COLA pair) makes synthesis the window times one scalar
+    if (d_min > 1e-12 && d_max - d_min <= STFT_COLA_TOL * d_max) {
+        c->cola_gain = (vv_dsp_real)(2.0 / (d_min + d_max));
+        for (size_t i = 0; i < c->nfft; ++i) c->synth_win[i] = w[i] * c->cola_gain;
+    } else {
+        // Walk backwards so d[i % hop] is still intact when synth_win[i] is written
+        for (size_t i = c->nfft; i-- > 0;) {
+            const vv_dsp_real di = d[i % c->hop];
+            c->synth_win[i] = (di > (vv_dsp_real)1e-12) ? w[i] / di : (vv_dsp_real)0;
+        }
+    }
 
-    // FFT plans for C2C forward/backward
-    if (vv_dsp_fft_make_plan(h->nfft, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &h->plan_f) != VV_DSP_OK) {
-        free(h->win); free(h->timebuf); free(h); return VV_DSP_ERROR_INTERNAL; }
-    if (vv_dsp_fft_make_plan(h->nfft, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &h->plan_b) != VV_DSP_OK) {
-        vv_dsp_fft_destroy(h->plan_f); free(h->win); free(h->timebuf); free(h); return VV_DSP_ERROR_INTERNAL; }
+    // Analysis is always real-input; synthesis matches the spectrum layout
+    if (stft_make_plans(c, &c->plan_f, &c->plan_b) != VV_DSP_OK) {
+        config_free(c);
+        return VV_DSP_ERROR_INTERNAL;
+    }
+    size_t wf = 0, wb = 0;
+    c->ws_ok = vv_dsp_fft_workspace_size(c->plan_f, &wf) == VV_DSP_OK &&
+               vv_dsp_fft_workspace_size(c->plan_b, &wb) == VV_DSP_OK;
+    c->ws_bytes = wf > wb ? wf : wb;
+    *out = c;
+    return VV_DSP_OK;
+}
 
+vv_dsp_status vv_dsp_stft_config_retain(vv_dsp_stft_config* cfg) {
+    if (!cfg) return VV_DSP_ERROR_NULL_POINTER;
+    STFT_REF_INC(&cfg->refs);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_stft_config_release(vv_dsp_stft_config* cfg) {
+    if (!cfg) return VV_DSP_ERROR_NULL_POINTER;
+    if (STFT_REF_DEC(&cfg->refs) == 0) config_free(cfg);
+    return VV_DSP_OK;
+}
+
+static void stft_free(vv_dsp_stft* h) {
+    vv_dsp_cufft_spectrogram_free(h->gpu);
+    vv_dsp_fft_destroy(h->own_f);
+    vv_dsp_fft_destroy(h->own_b);
+    vv_dsp_free(h->ws);
+    vv_dsp_free(h->scratch);
+    vv_dsp_free(h->ring);
+    if (h->cfg) (void)vv_dsp_stft_config_release(h->cfg);
+    vv_dsp_free(h);
+}
+
+// exclusive: the handle is the only user of the config's plans (vv_dsp_stft_create)
+static vv_dsp_status stft_create_from(vv_dsp_stft_config* cfg, int exclusive, vv_dsp_stft** out) {
+    vv_dsp_stft* h = (vv_dsp_stft*)vv_dsp_calloc(1, sizeof(*h));
+    if (!h) return VV_DSP_ERROR_INTERNAL;
+    (void)vv_dsp_stft_config_retain(cfg);
+    h->cfg = cfg;
+    h->nfft = cfg->nfft;
+    h->hop = cfg->hop;
+    h->nbins = cfg->nbins;
+    h->spectrum = cfg->spectrum;
+    h->win = cfg->shift_win ? cfg->shift_win : cfg->win;
+    h->synth_win = cfg->synth_win;
+    h->plan_f = cfg->plan_f;
+    h->plan_b = cfg->plan_b;
+    h->precision = cfg->precision;
+    h->pool = cfg->pool;
+    const int half = (h->spectrum == VV_DSP_STFT_SPECTRUM_HALF);
+    const size_t nfft = h->nfft, nh = nfft / 2 + 1;
+    // One block: [work_fft_time (FULL)] [timebuf] [spec_split] [ola]
+    const size_t ncpx = half ? 0 : nfft;
+    h->scratch = vv_dsp_calloc(1, sizeof(vv_dsp_cpx) * ncpx + sizeof(vv_dsp_real) * (nfft + 2 * nh + nfft));
+    if (!h->scratch) { stft_free(h); return VV_DSP_ERROR_INTERNAL; }
+    if (!half) h->work_fft_time = (vv_dsp_cpx*)h->scratch;
+    h->timebuf = (vv_dsp_real*)((vv_dsp_cpx*)h->scratch + ncpx);
+    h->spec_split = h->timebuf + nfft;
+    h->ola = h->spec_split + 2 * nh;
+    if (!exclusive) {
+        if (cfg->ws_ok) {
+            h->use_ws = 1;
+            h->ws = cfg->ws_bytes ? vv_dsp_malloc(cfg->ws_bytes) : NULL;
+            if (cfg->ws_bytes && !h->ws) { stft_free(h); return VV_DSP_ERROR_INTERNAL; }
+        } else {
+            if (stft_make_plans(cfg, &h->own_f, &h->own_b) != VV_DSP_OK) {
+                stft_free(h);
+                return VV_DSP_ERROR_INTERNAL;
+            }
+            h->plan_f = h->own_f;
+            h->plan_b = h->own_b;
+        }
+    }
+    *out = h;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create(const vv_dsp_stft_params* params, vv_dsp_stft** out) {
+    return vv_dsp_stft_create_ctx(NULL, params, out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create_ctx(const vv_dsp_context* ctx,
+                                                      const vv_dsp_stft_params* params,
+                                                      vv_dsp_stft** out) {
+    if (!out || !params) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    vv_dsp_stft_config* cfg = NULL;
+    vv_dsp_status s = vv_dsp_stft_config_create_ctx(ctx, params, &cfg);
+    if (s != VV_DSP_OK) return s;
+    vv_dsp_stft* h = NULL;
+    s = stft_create_from(cfg, 1, &h);
+    (void)vv_dsp_stft_config_release(cfg); // the handle holds its own reference
+    if (s == VV_DSP_OK) s = vv_dsp_stft_stream_reserve(h, h->nfft);
+    if (s != VV_DSP_OK) { if (h) stft_free(h); return s; }
     *out = h; return VV_DSP_OK;
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_create_from_config(vv_dsp_stft_config* cfg, vv_dsp_stft** out) {
+    if (!out || !cfg) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    return stft_create_from(cfg, 0, out);
+}
+
 vv_dsp_status vv_dsp_stft_destroy(vv_dsp_stft* h) {
     if (!h) return VV_DSP_ERROR_NULL_POINTER;
-    vv_dsp_fft_destroy(h->plan_f);
-    vv_dsp_fft_destroy(h->plan_b);
-    free(h->win);
-    free(h->timebuf);
-    free(h->work_fft_in);
-    free(h->work_fft_time);
-    free(h);
+    stft_free(h);
+    return VV_DSP_OK;
+}
+
+static vv_dsp_status stft_exec(const vv_dsp_stft* h, const vv_dsp_fft_plan* plan, const void* in, void* out) {
+    return h->use_ws ? vv_dsp_fft_execute_ws(plan, in, out, h->ws) : vv_dsp_fft_execute(plan, in, out);
+}
+
+size_t vv_dsp_stft_num_bins(const vv_dsp_stft* h) {
+    return h ? h->nbins : 0;
+}
+
+// FFT of the windowed frame in timebuf
+static vv_dsp_status stft_analyze(vv_dsp_stft* h, vv_dsp_cpx* out) {
+    vv_dsp_status s = stft_exec(h, h->plan_f, h->timebuf, out);
+    if (s != VV_DSP_OK) return s;
+    if (h->spectrum == VV_DSP_STFT_SPECTRUM_FULL) {
+        // Upper bins of a real frame: X[k] = conj(X[nfft-k])
+        for (size_t k = h->nfft / 2 + 1; k < h->nfft; ++k) {
+            out[k].re = out[h->nfft - k].re;
+            out[k].im = -out[h->nfft - k].im;
+        }
+    }
     return VV_DSP_OK;
 }
 
@@ -76,19 +332,25 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process(vv_dsp_stft* h,
                                                    vv_dsp_cpx* out) {
     if (!h || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
 
+    VV_DSP_PROFILE_BEGIN(prof, VV_DSP_PROFILE_STFT_PROCESS);
     // Apply window to input using vectorized operations if available
     vv_dsp_status s = vv_dsp_vectorized_window_apply(in, h->win, h->timebuf, h->nfft);
-    if (s != VV_DSP_OK) return s;
+    if (s == VV_DSP_OK) s = stft_analyze(h, out);
+    VV_DSP_PROFILE_END(prof, h->nfft);
+    return s;
+}
 
-    // Copy windowed real data into complex buffer (real as re, 0 as im)
-    vv_dsp_cpx* tmp = h->work_fft_in;
-    for (size_t i = 0; i < h->nfft; ++i) {
-        tmp[i].re = h->timebuf[i];
-        tmp[i].im = 0;
+// Inverse FFT of one spectrum; the real time samples are *time[i * *stride]
+static vv_dsp_status stft_inverse(vv_dsp_stft* h, const vv_dsp_cpx* in,
+                                  const vv_dsp_real** time, size_t* stride) {
+    if (h->spectrum == VV_DSP_STFT_SPECTRUM_HALF) {
+        *time = h->timebuf;
+        *stride = 1;
+        return stft_exec(h, h->plan_b, in, h->timebuf);
     }
-
-    s = vv_dsp_fft_execute(h->plan_f, tmp, out);
-    return s;
+    *time = &h->work_fft_time[0].re;
+    *stride = 2;
+    return stft_exec(h, h->plan_b, in, h->work_fft_time);
 }
 
 // Reconstruct: IFFT then window and overlap-add into out_add
@@ -97,48 +359,703 @@ VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_reconstruct(vv_dsp_stft* h,
                                                        vv_dsp_real* out_add,
                                                        vv_dsp_real* norm_add) {
     if (!h || !in || !out_add) return VV_DSP_ERROR_NULL_POINTER;
-    vv_dsp_cpx* time = h->work_fft_time;
-    vv_dsp_status s = vv_dsp_fft_execute(h->plan_b, in, time);
+    const vv_dsp_real* time = NULL;
+    size_t stride = 1;
+    vv_dsp_status s = stft_inverse(h, in, &time, &stride);
     if (s != VV_DSP_OK) { return s; }
     for (size_t i=0;i<h->nfft;++i) {
         vv_dsp_real w = h->win[i];
-        vv_dsp_real v = time[i].re * w;
-        out_add[i] += v; // caller manages buffer position and zeroing
+        out_add[i] += time[i * stride] * w; // caller manages buffer position and zeroing
         if (norm_add) norm_add[i] += w*w;
     }
     return VV_DSP_OK;
 }
 
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_reconstruct_normalized(vv_dsp_stft* h,
+                                                                  const vv_dsp_cpx* in,
+                                                                  vv_dsp_real* out_add) {
+    if (!h || !in || !out_add) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_real* time = NULL;
+    size_t stride = 1;
+    const int rt = VV_DSP_RT_ENTER(h->max_block != 0);
+    vv_dsp_status s = stft_inverse(h, in, &time, &stride);
+    VV_DSP_RT_LEAVE(rt);
+    if (s != VV_DSP_OK) return s;
+    const vv_dsp_real* ws = h->synth_win;
+    for (size_t i = 0; i < h->nfft; ++i) out_add[i] += time[i * stride] * ws[i];
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_stft_cola_gain(const vv_dsp_stft* h, vv_dsp_real* gain) {
+    if (!h || !gain) return VV_DSP_ERROR_NULL_POINTER;
+    *gain = h->cfg->cola_gain;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_stft_set_precision(vv_dsp_stft* h, vv_dsp_precision_mode mode) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (!vv_dsp_precision_mode_valid(mode)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    h->precision = mode;
+    return VV_DSP_OK;
+}
+
+static size_t spectrogram_frames(const vv_dsp_stft* h, size_t n) {
+    return (n < h->nfft) ? 1 : (1 + (n - h->nfft + h->hop) / h->hop);
+}
+
+size_t vv_dsp_stft_spectrogram_frames(const vv_dsp_stft* h, size_t n) {
+    return h ? spectrogram_frames(h, n) : 0;
+}
+
+static vv_dsp_status spectrogram_check_opts(const vv_dsp_spectrogram_opts* o) {
+    if (!o) return VV_DSP_OK;
+    if (o->scale < VV_DSP_SPECTROGRAM_MAGNITUDE || o->scale > VV_DSP_SPECTROGRAM_DB) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (o->floor < 0 || (o->scale == VV_DSP_SPECTROGRAM_DB && !(o->floor > 0))) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (o->mel_weights && o->n_mels == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    return VV_DSP_OK;
+}
+
+// The log / dB step of one row of nval base values (|X|, |X|^2 or their mel
+// projection), in place
+static vv_dsp_status spectrogram_finish_row(vv_dsp_real* row, size_t nval, vv_dsp_spectrogram_scale scale,
+                                            vv_dsp_real floor_v, vv_dsp_precision_mode precision) {
+    const vv_dsp_real db_scale = (vv_dsp_real)(10.0 / 2.302585092994045684);
+    vv_dsp_status s = VV_DSP_OK;
+    if (precision != VV_DSP_PRECISION_EXACT && scale >= VV_DSP_SPECTROGRAM_LOG) {
+        // Shift or floor the row in place, then one vectorized log over it
+        const vv_dsp_real add = (scale == VV_DSP_SPECTROGRAM_LOG1P) ? (vv_dsp_real)1 : floor_v;
+        if (scale == VV_DSP_SPECTROGRAM_DB) {
+            for (size_t k = 0; k < nval; ++k) row[k] = row[k] > floor_v ? row[k] : floor_v;
+        } else {
+            for (size_t k = 0; k < nval; ++k) row[k] += add;
+        }
+        s = vv_dsp_vlog(row, row, nval, vv_dsp_precision_vmath_tier(precision));
+        if (s != VV_DSP_OK) return s;
+        if (scale == VV_DSP_SPECTROGRAM_DB) {
+            for (size_t k = 0; k < nval; ++k) row[k] *= db_scale;
+        }
+    } else {
+        switch (scale) {
+            case VV_DSP_SPECTROGRAM_LOG:
+                for (size_t k = 0; k < nval; ++k) row[k] = VV_DSP_LOG(row[k] + floor_v);
+                break;
+            case VV_DSP_SPECTROGRAM_LOG1P:
+                for (size_t k = 0; k < nval; ++k) row[k] = VV_DSP_LOG((vv_dsp_real)1 + row[k]);
+                break;
+            case VV_DSP_SPECTROGRAM_DB:
+                for (size_t k = 0; k < nval; ++k) row[k] = db_scale * VV_DSP_LOG(row[k] > floor_v ? row[k] : floor_v);
+                break;
+            default:
+                break;
+        }
+    }
+    return VV_DSP_OK;
+}
+
+// Analysis window of a spectrogram: mel rows project the non-negative bins, so they
+// are taken from the unshifted window even on an fftshifted handle
+static const vv_dsp_real* spectrogram_window(const vv_dsp_stft* h, const vv_dsp_spectrogram_opts* opts) {
+    return (opts && opts->mel_weights) ? h->cfg->win : h->win;
+}
+
+// Output rows of frames [f0, f1), frame f0 in the first row of out. Scratch:
+// frame[nfft], re/im[nfft/2+1].
+// Serial and parallel spectrograms both go through here, so they agree bit for bit.
+// Frames come from view when given, else from signal with zero padding at the end.
+static vv_dsp_status spectrogram_rows(const vv_dsp_stft* h, const vv_dsp_fft_plan* plan,
+                                      const vv_dsp_real* signal, size_t n, const vv_dsp_frame_view* view,
+                                      const vv_dsp_spectrogram_opts* opts,
+                                      size_t f0, size_t f1, vv_dsp_real* out,
+                                      vv_dsp_real* frame, vv_dsp_real* re, vv_dsp_real* im) {
+    // Split layout end to end: the magnitude pass needs no deinterleaving
+    const size_t nfft = h->nfft;
+    const size_t nh = nfft / 2 + 1;
+    const vv_dsp_spectrogram_scale scale = opts ? opts->scale : VV_DSP_SPECTROGRAM_MAGNITUDE;
+    const vv_dsp_real floor_v = opts ? opts->floor : (vv_dsp_real)0;
+    const vv_dsp_real* mel = opts ? opts->mel_weights : NULL;
+    const size_t width = mel ? opts->n_mels : h->nbins;
+    const size_t nval = mel ? opts->n_mels : nh;
+    const vv_dsp_real* win = spectrogram_window(h, opts);
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t f = f0; f < f1 && s == VV_DSP_OK; ++f) {
+        size_t start = f * h->hop;
+        vv_dsp_real* row = out + (f - f0) * width;
+        // Frames inside the signal are windowed straight from it; the last
+        // ones are gathered with zero-padding first
+        const vv_dsp_real* src = view ? vv_dsp_frame_view_frame(view, f) : signal + start;
+        if (!view && start + nfft > n) {
+            for (size_t i = 0; i < nfft; ++i) {
+                size_t idx = start + i;
+                frame[i] = (idx < n) ? signal[idx] : (vv_dsp_real)0;
+            }
+            src = frame;
+        }
+        s = vv_dsp_vectorized_window_apply(src, win, frame, nfft);
+        if (s == VV_DSP_OK) s = vv_dsp_fft_execute_split(plan, frame, NULL, re, im);
+        if (s != VV_DSP_OK) break;
+        // Base quantity per bin, still in cache: |X| or |X|^2
+        vv_dsp_real* base = mel ? re : row;
+        s = (scale == VV_DSP_SPECTROGRAM_MAGNITUDE) ? vv_dsp_split_magnitude(re, im, base, nh)
+                                                    : vv_dsp_split_power(re, im, base, nh);
+        if (s != VV_DSP_OK) break;
+        if (mel) {
+            for (size_t m = 0; m < nval; ++m) {
+                const vv_dsp_real* w = mel + m * nh;
+                vv_dsp_real acc = 0;
+                for (size_t k = 0; k < nh; ++k) acc += w[k] * base[k];
+                row[m] = acc;
+            }
+        }
+        s = spectrogram_finish_row(row, nval, scale, floor_v, h->precision);
+        if (s != VV_DSP_OK) break;
+        // FULL rows mirror the Hermitian half
+        if (!mel && h->spectrum == VV_DSP_STFT_SPECTRUM_FULL) {
+            for (size_t k = nh; k < nfft; ++k) row[k] = row[nfft - k];
+        }
+    }
+    return s;
+}
+
+// Rows computed per block before a storage encoder packs them
+#define STFT_QUANT_ROWS 32
+
+// Frames [0, frames) into out, encoded with q when given: blocks of rows go through
+// one scratch buffer and are packed while still in cache
+static vv_dsp_status spectrogram_emit(const vv_dsp_stft* h, const vv_dsp_fft_plan* plan, const vv_dsp_real* signal,
+                                      size_t n, const vv_dsp_frame_view* view, size_t frames,
+                                      const vv_dsp_spectrogram_opts* opts, const vv_dsp_quant* q, void* out) {
+    const size_t nh = h->nfft / 2 + 1;
+    if (!q || q->type == VV_DSP_STORAGE_REAL) {
+        return spectrogram_rows(h, plan, signal, n, view, opts, 0, frames, (vv_dsp_real*)out,
+                                h->timebuf, h->spec_split, h->spec_split + nh);
+    }
+    const size_t width = (opts && opts->mel_weights) ? opts->n_mels : h->nbins;
+    const size_t row_bytes = width * vv_dsp_storage_bytes(q->type);
+    vv_dsp_real* rows = (vv_dsp_real*)vv_dsp_malloc(STFT_QUANT_ROWS * width * sizeof(vv_dsp_real));
+    if (!rows) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_status s = VV_DSP_OK;
+    for (size_t f0 = 0; f0 < frames && s == VV_DSP_OK; f0 += STFT_QUANT_ROWS) {
+        const size_t f1 = (frames - f0 < STFT_QUANT_ROWS) ? frames : f0 + STFT_QUANT_ROWS;
+        s = spectrogram_rows(h, plan, signal, n, view, opts, f0, f1, rows, h->timebuf, h->spec_split,
+                             h->spec_split + nh);
+        if (s == VV_DSP_OK) s = vv_dsp_quant_encode(q, rows, (f1 - f0) * width, (uint8_t*)out + f0 * row_bytes);
+    }
+    vv_dsp_free(rows);
+    return s;
+}
+
+// Serial spectrogram of frames [0, frames) from signal or view
+static vv_dsp_status spectrogram_serial(vv_dsp_stft* h, const vv_dsp_real* signal, size_t n,
+                                        const vv_dsp_frame_view* view, size_t frames,
+                                        const vv_dsp_spectrogram_opts* opts, const vv_dsp_quant* q, void* out) {
+    if (!h->use_ws) return spectrogram_emit(h, h->plan_f, signal, n, view, frames, opts, q, out);
+    // The config's plan is shared and split execution uses plan-owned staging:
+    // borrow a private plan for the call
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_status s = vv_dsp_fft_plan_acquire_backend(h->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD,
+                                                      stft_backend(h->cfg), &plan);
+    if (s != VV_DSP_OK) return s;
+    s = spectrogram_emit(h, plan, signal, n, view, frames, opts, q, out);
+    (void)vv_dsp_fft_plan_release(plan);
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex(vv_dsp_stft* h,
+                                                          const vv_dsp_real* signal,
+                                                          size_t n,
+                                                          const vv_dsp_spectrogram_opts* opts,
+                                                          vv_dsp_real* out,
+                                                          size_t* out_frames) {
+    if (!h || !signal || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (h->nfft == 0 || h->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_status s = spectrogram_check_opts(opts);
+    if (s != VV_DSP_OK) return s;
+    size_t frames = spectrogram_frames(h, n);
+    *out_frames = frames;
+    if (stft_backend(h->cfg) == VV_DSP_FFT_BACKEND_CUFFT) {
+        // Whole signal through the device; the host path runs what the kernels do not cover
+        s = vv_dsp_cufft_spectrogram_run(&h->gpu, spectrogram_window(h, opts), h->nfft, h->hop,
+                                         h->spectrum == VV_DSP_STFT_SPECTRUM_FULL, signal, n, frames,
+                                         opts ? (int)opts->scale : (int)VV_DSP_SPECTROGRAM_MAGNITUDE,
+                                         opts ? opts->floor : (vv_dsp_real)0, opts ? opts->mel_weights : NULL,
+                                         opts ? opts->n_mels : 0, out);
+        if (s != VV_DSP_ERROR_UNSUPPORTED) return s;
+    }
+    return spectrogram_serial(h, signal, n, NULL, frames, opts, NULL, out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_quant(vv_dsp_stft* h,
+                                                             const vv_dsp_real* signal,
+                                                             size_t n,
+                                                             const vv_dsp_spectrogram_opts* opts,
+                                                             const vv_dsp_quant* quant,
+                                                             void* out,
+                                                             size_t* out_frames) {
+    if (!h || !signal || !quant || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (h->nfft == 0 || h->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!vv_dsp_storage_bytes(quant->type)) return VV_DSP_ERROR_UNSUPPORTED;
+    if (quant->type == VV_DSP_STORAGE_REAL) {
+        return vv_dsp_stft_spectrogram_ex(h, signal, n, opts, (vv_dsp_real*)out, out_frames);
+    }
+    vv_dsp_status s = spectrogram_check_opts(opts);
+    if (s != VV_DSP_OK) return s;
+    const size_t frames = spectrogram_frames(h, n);
+    *out_frames = frames;
+    return spectrogram_serial(h, signal, n, NULL, frames, opts, quant, out);
+}
+
+size_t vv_dsp_stft_process_typed_scratch_size(const vv_dsp_stft* h) {
+    if (!h) return 0;
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_real) * (h->nfft + 2 * vv_dsp_stft_num_bins(h)));
+}
+
+size_t vv_dsp_stft_spectrogram_typed_scratch_size(const vv_dsp_stft* h, size_t n,
+                                                  const vv_dsp_spectrogram_opts* opts) {
+    if (!h || h->nfft == 0 || h->hop == 0) return 0;
+    const size_t cols = (opts && opts->mel_weights) ? opts->n_mels : vv_dsp_stft_num_bins(h);
+    return vv_dsp_arena_request_size(sizeof(vv_dsp_real) * (n + spectrogram_frames(h, n) * cols));
+}
+
+// Foreign-precision entry points: convert through one scratch block from the arena
+static vv_dsp_status stft_process_foreign(vv_dsp_stft* h, const vv_foreign_real* in, vv_foreign_cpx* out,
+                                          vv_dsp_arena* arena) {
+    if (!h || !in || !out) return VV_DSP_ERROR_NULL_POINTER;
+    const size_t nb = vv_dsp_stft_num_bins(h);
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* scratch = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, sizeof(vv_dsp_real) * (h->nfft + 2 * nb));
+    if (!scratch) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_cpx* spec = (vv_dsp_cpx*)(void*)(scratch + h->nfft);
+    vv_dsp_status s = VV_FOREIGN_TO_REAL(in, scratch, h->nfft);
+    if (s == VV_DSP_OK) s = vv_dsp_stft_process(h, scratch, spec);
+    if (s == VV_DSP_OK) s = VV_REAL_TO_FOREIGN(&spec[0].re, &out[0].re, 2 * nb);
+    vv_dsp_scratch_free(arena, scratch);
+    vv_dsp_arena_reset_to(arena, mark);
+    return s;
+}
+
+static vv_dsp_status stft_spectrogram_foreign(vv_dsp_stft* h, const vv_foreign_real* signal, size_t n,
+                                              const vv_dsp_spectrogram_opts* opts, vv_foreign_real* out,
+                                              size_t* out_frames, vv_dsp_arena* arena) {
+    if (!h || !signal || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (h->nfft == 0 || h->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    const size_t cols = (opts && opts->mel_weights) ? opts->n_mels : vv_dsp_stft_num_bins(h);
+    const size_t total = spectrogram_frames(h, n) * cols;
+    const size_t mark = vv_dsp_arena_mark(arena);
+    vv_dsp_real* scratch = (vv_dsp_real*)vv_dsp_scratch_alloc(arena, sizeof(vv_dsp_real) * (n + total));
+    if (!scratch) return VV_DSP_ERROR_INTERNAL;
+    vv_dsp_status s = VV_FOREIGN_TO_REAL(signal, scratch, n);
+    if (s == VV_DSP_OK) s = vv_dsp_stft_spectrogram_ex(h, scratch, n, opts, scratch + n, out_frames);
+    if (s == VV_DSP_OK) s = VV_REAL_TO_FOREIGN(scratch + n, out, total);
+    vv_dsp_scratch_free(arena, scratch);
+    vv_dsp_arena_reset_to(arena, mark);
+    return s;
+}
+
+#ifdef VV_DSP_USE_DOUBLE
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f32(vv_dsp_stft* h, const float* in, vv_dsp_cpx_f32* out,
+                                                       vv_dsp_arena* arena) {
+    return stft_process_foreign(h, in, out, arena);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f64(vv_dsp_stft* h, const double* in, vv_dsp_cpx_f64* out,
+                                                       vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_stft_process(h, in, (vv_dsp_cpx*)(void*)out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f32(vv_dsp_stft* h, const float* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, float* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena) {
+    return stft_spectrogram_foreign(h, signal, n, opts, out, out_frames, arena);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f64(vv_dsp_stft* h, const double* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, double* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_stft_spectrogram_ex(h, signal, n, opts, out, out_frames);
+}
+#else
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f32(vv_dsp_stft* h, const float* in, vv_dsp_cpx_f32* out,
+                                                       vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_stft_process(h, in, (vv_dsp_cpx*)(void*)out);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_process_f64(vv_dsp_stft* h, const double* in, vv_dsp_cpx_f64* out,
+                                                       vv_dsp_arena* arena) {
+    return stft_process_foreign(h, in, out, arena);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f32(vv_dsp_stft* h, const float* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, float* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena) {
+    (void)arena;
+    return vv_dsp_stft_spectrogram_ex(h, signal, n, opts, out, out_frames);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_ex_f64(vv_dsp_stft* h, const double* signal, size_t n,
+                                                              const vv_dsp_spectrogram_opts* opts, double* out,
+                                                              size_t* out_frames, vv_dsp_arena* arena) {
+    return stft_spectrogram_foreign(h, signal, n, opts, out, out_frames, arena);
+}
+#endif
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_view(vv_dsp_stft* h,
+                                                            const vv_dsp_frame_view* view,
+                                                            const vv_dsp_spectrogram_opts* opts,
+                                                            vv_dsp_real* out,
+                                                            size_t* out_frames) {
+    if (!h || !view || !view->signal || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    if (view->frame_len != h->nfft) return VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_status s = spectrogram_check_opts(opts);
+    if (s != VV_DSP_OK) return s;
+    *out_frames = view->num_frames;
+    return spectrogram_serial(h, view->signal, view->signal_len, view, view->num_frames, opts, NULL, out);
+}
+
 VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram(vv_dsp_stft* h,
                                                        const vv_dsp_real* signal,
                                                        size_t n,
                                                        vv_dsp_real* out_mag,
                                                        size_t* out_frames) {
-    if (!h || !signal || !out_mag || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
-    if (h->nfft == 0 || h->hop == 0) return VV_DSP_ERROR_INVALID_SIZE;
-    size_t frames = (n < h->nfft) ? 1 : (1 + (n - h->nfft + h->hop) / h->hop);
+    return vv_dsp_stft_spectrogram_ex(h, signal, n, NULL, out_mag, out_frames);
+}
+
+typedef struct spectrogram_job {
+    const vv_dsp_stft* h;
+    const vv_dsp_real* signal;
+    size_t n;
+    const vv_dsp_spectrogram_opts* opts;
+    size_t frames;
+    size_t workers;
+    vv_dsp_real* out;
+    vv_dsp_status* status; // one per worker
+} spectrogram_job;
+
+static void spectrogram_worker(void* ctx, size_t w) {
+    const spectrogram_job* job = (const spectrogram_job*)ctx;
+    const vv_dsp_stft* h = job->h;
+    const size_t f0 = job->frames * w / job->workers;
+    const size_t f1 = job->frames * (w + 1) / job->workers;
+    const size_t nh = h->nfft / 2 + 1;
+    // Private plan and scratch; the window and signal are shared read-only
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_real* buf = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * (h->nfft + 2 * nh));
+    vv_dsp_status s = buf ? vv_dsp_fft_plan_acquire_backend(h->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD,
+                                                            stft_backend(h->cfg), &plan)
+                          : VV_DSP_ERROR_INTERNAL;
+    if (s == VV_DSP_OK) {
+        const size_t width = (job->opts && job->opts->mel_weights) ? job->opts->n_mels : h->nbins;
+        s = spectrogram_rows(h, plan, job->signal, job->n, NULL, job->opts, f0, f1, job->out + f0 * width,
+                             buf, buf + h->nfft, buf + h->nfft + nh);
+    }
+    (void)vv_dsp_fft_plan_release(plan);
+    vv_dsp_free(buf);
+    job->status[w] = s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_spectrogram_parallel(vv_dsp_stft* h,
+                                                                const vv_dsp_real* signal,
+                                                                size_t n,
+                                                                const vv_dsp_spectrogram_opts* opts,
+                                                                vv_dsp_real* out,
+                                                                size_t* out_frames,
+                                                                size_t num_threads) {
+    if (!h || !signal || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status s = spectrogram_check_opts(opts);
+    if (s != VV_DSP_OK) return s;
+    // The device batches frames itself
+    if (stft_backend(h->cfg) == VV_DSP_FFT_BACKEND_CUFFT) {
+        return vv_dsp_stft_spectrogram_ex(h, signal, n, opts, out, out_frames);
+    }
+    const size_t frames = spectrogram_frames(h, n);
+    size_t workers = num_threads ? num_threads : vv_dsp_parallel_pool_workers(h->pool);
+    if (workers > frames) workers = frames;
+    if (workers <= 1) return vv_dsp_stft_spectrogram_ex(h, signal, n, opts, out, out_frames);
     *out_frames = frames;
-    vv_dsp_cpx* spec = (vv_dsp_cpx*)malloc(sizeof(vv_dsp_cpx)*h->nfft);
-    vv_dsp_real* frame = (vv_dsp_real*)malloc(sizeof(vv_dsp_real)*h->nfft);
-    if (!spec || !frame) { free(spec); free(frame); return VV_DSP_ERROR_INTERNAL; }
-    for (size_t f=0; f<frames; ++f) {
-        size_t start = f * h->hop;
-        // gather frame with zero-padding at end
-        for (size_t i=0;i<h->nfft;++i) {
-            size_t idx = start + i;
-            frame[i] = (idx < n) ? signal[idx] : (vv_dsp_real)0;
+
+    vv_dsp_status* status = (vv_dsp_status*)vv_dsp_malloc(workers * sizeof(vv_dsp_status));
+    if (!status) return VV_DSP_ERROR_INTERNAL;
+    spectrogram_job job = { h, signal, n, opts, frames, workers, out, status };
+    s = vv_dsp_parallel_run_on(h->pool, workers, spectrogram_worker, &job);
+    for (size_t w = 0; s == VV_DSP_OK && w < workers; ++w) s = status[w];
+    vv_dsp_free(status);
+    return s;
+}
+
+// Frames each resolution stages before one batched FFT
+#define STFT_MR_BATCH 16
+
+typedef struct stft_mr_res {
+    size_t nfft;
+    size_t nbins;          // row width: nfft (FULL) or nfft/2+1 (HALF)
+    size_t every;          // hop / step
+    size_t offset;         // frame start within the step's span: (nmax - nfft) / 2
+    vv_dsp_stft_spectrum spectrum;
+    const vv_dsp_real* win; // from the shared window cache
+    vv_dsp_fft_plan* plan; // R2C over STFT_MR_BATCH contiguous frames
+    vv_dsp_real* frames;   // STFT_MR_BATCH * nfft windowed frames
+    vv_dsp_cpx* spec;      // STFT_MR_BATCH * (nfft/2+1) bins
+    size_t staged;         // frames waiting in frames[]
+    size_t row;            // output row of the first staged frame
+} stft_mr_res;
+
+struct vv_dsp_stft_multires {
+    size_t num_res;
+    size_t step;           // smallest hop
+    size_t nmax;           // largest fft_size: the span read per step
+    stft_mr_res* res;
+    vv_dsp_real* edge;     // zero-padded span at the end of the signal
+};
+
+static void multires_free(vv_dsp_stft_multires* m) {
+    for (size_t r = 0; r < m->num_res; ++r) {
+        vv_dsp_fft_destroy(m->res[r].plan);
+        vv_dsp_window_release(m->res[r].win);
+        vv_dsp_free(m->res[r].frames);
+        vv_dsp_free(m->res[r].spec);
+    }
+    vv_dsp_free(m->res);
+    vv_dsp_free(m->edge);
+    vv_dsp_free(m);
+}
+
+// Steps of the traversal, i.e. frames of the largest size at the smallest hop
+static size_t multires_steps(const vv_dsp_stft_multires* m, size_t n) {
+    return (n < m->nmax) ? 1 : (1 + (n - m->nmax + m->step) / m->step);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_multires_create(const vv_dsp_stft_params* res, size_t num_res,
+                                                           vv_dsp_stft_multires** out) {
+    if (!res || !out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (num_res == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t step = 0, nmax = 0;
+    for (size_t r = 0; r < num_res; ++r) {
+        if (res[r].fft_size == 0 || res[r].hop_size == 0 || res[r].hop_size > res[r].fft_size)
+            return VV_DSP_ERROR_INVALID_SIZE;
+        if (res[r].spectrum != VV_DSP_STFT_SPECTRUM_FULL && res[r].spectrum != VV_DSP_STFT_SPECTRUM_HALF)
+            return VV_DSP_ERROR_OUT_OF_RANGE;
+        if (step == 0 || res[r].hop_size < step) step = res[r].hop_size;
+        if (res[r].fft_size > nmax) nmax = res[r].fft_size;
+    }
+    for (size_t r = 0; r < num_res; ++r) {
+        if (res[r].hop_size % step != 0) return VV_DSP_ERROR_INVALID_SIZE;
+    }
+    vv_dsp_stft_multires* m = (vv_dsp_stft_multires*)vv_dsp_calloc(1, sizeof(*m));
+    if (!m) return VV_DSP_ERROR_INTERNAL;
+    m->res = (stft_mr_res*)vv_dsp_calloc(num_res, sizeof(stft_mr_res));
+    m->edge = (vv_dsp_real*)vv_dsp_malloc(nmax * sizeof(vv_dsp_real));
+    if (!m->res || !m->edge) { multires_free(m); return VV_DSP_ERROR_INTERNAL; }
+    m->num_res = num_res;
+    m->step = step;
+    m->nmax = nmax;
+    for (size_t r = 0; r < num_res; ++r) {
+        stft_mr_res* rr = &m->res[r];
+        const size_t nh = res[r].fft_size / 2 + 1;
+        rr->nfft = res[r].fft_size;
+        rr->spectrum = res[r].spectrum;
+        rr->nbins = rr->spectrum == VV_DSP_STFT_SPECTRUM_HALF ? nh : rr->nfft;
+        rr->every = res[r].hop_size / step;
+        rr->offset = (nmax - rr->nfft) / 2;
+        vv_dsp_status s = acquire_window(&res[r], &rr->win);
+        if (s == VV_DSP_OK) {
+            s = vv_dsp_fft_make_plan_many(rr->nfft, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, STFT_MR_BATCH,
+                                          1, rr->nfft, 1, nh, &rr->plan);
+        }
+        if (s != VV_DSP_OK) { multires_free(m); return s; }
+        rr->frames = (vv_dsp_real*)vv_dsp_malloc(STFT_MR_BATCH * rr->nfft * sizeof(vv_dsp_real));
+        rr->spec = (vv_dsp_cpx*)vv_dsp_malloc(STFT_MR_BATCH * nh * sizeof(vv_dsp_cpx));
+        if (!rr->frames || !rr->spec) { multires_free(m); return VV_DSP_ERROR_INTERNAL; }
+    }
+    *out = m;
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_stft_multires_destroy(vv_dsp_stft_multires* m) {
+    if (!m) return VV_DSP_ERROR_NULL_POINTER;
+    multires_free(m);
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_stft_multires_frames(const vv_dsp_stft_multires* m, size_t r, size_t n) {
+    if (!m || r >= m->num_res) return 0;
+    return (multires_steps(m, n) - 1) / m->res[r].every + 1;
+}
+
+// Transform the frames staged in rr and write their rows to out
+static vv_dsp_status multires_flush(stft_mr_res* rr, vv_dsp_real* out, vv_dsp_spectrogram_scale scale,
+                                    vv_dsp_real floor_v) {
+    const size_t nfft = rr->nfft, nh = nfft / 2 + 1, c = rr->staged;
+    vv_dsp_status s = VV_DSP_OK;
+    if (c == STFT_MR_BATCH) {
+        s = vv_dsp_fft_execute_batch(rr->plan, rr->frames, rr->spec);
+    } else {
+        // The last, partial batch: the plan also runs single vectors
+        for (size_t i = 0; i < c && s == VV_DSP_OK; ++i) {
+            s = vv_dsp_fft_execute(rr->plan, rr->frames + i * nfft, rr->spec + i * nh);
+        }
+    }
+    for (size_t i = 0; i < c && s == VV_DSP_OK; ++i) {
+        const vv_dsp_cpx* x = rr->spec + i * nh;
+        vv_dsp_real* row = out + (rr->row + i) * rr->nbins;
+        s = (scale == VV_DSP_SPECTROGRAM_MAGNITUDE) ? vv_dsp_cpx_abs_array(x, row, nh) : vv_dsp_cpx_power_array(x, row, nh);
+        if (s == VV_DSP_OK) s = spectrogram_finish_row(row, nh, scale, floor_v, VV_DSP_PRECISION_EXACT);
+        if (rr->spectrum == VV_DSP_STFT_SPECTRUM_FULL) {
+            for (size_t k = nh; k < nfft; ++k) row[k] = row[nfft - k];
+        }
+    }
+    rr->row += c;
+    rr->staged = 0;
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_multires_spectrogram(vv_dsp_stft_multires* m,
+                                                                const vv_dsp_real* signal,
+                                                                size_t n,
+                                                                const vv_dsp_spectrogram_opts* opts,
+                                                                vv_dsp_real* const* out,
+                                                                size_t* out_frames) {
+    if (!m || !signal || !out || !out_frames) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status s = spectrogram_check_opts(opts);
+    if (s != VV_DSP_OK) return s;
+    if (opts && opts->mel_weights) return VV_DSP_ERROR_UNSUPPORTED;
+    for (size_t r = 0; r < m->num_res; ++r) {
+        if (!out[r]) return VV_DSP_ERROR_NULL_POINTER;
+    }
+    const vv_dsp_spectrogram_scale scale = opts ? opts->scale : VV_DSP_SPECTROGRAM_MAGNITUDE;
+    const vv_dsp_real floor_v = opts ? opts->floor : (vv_dsp_real)0;
+    const size_t steps = multires_steps(m, n);
+    for (size_t r = 0; r < m->num_res; ++r) {
+        out_frames[r] = (steps - 1) / m->res[r].every + 1;
+        m->res[r].staged = 0;
+        m->res[r].row = 0;
+    }
+    for (size_t t = 0; t < steps && s == VV_DSP_OK; ++t) {
+        // One span per step serves every resolution due at it; spans reaching past
+        // the signal are gathered with zero padding once for all of them
+        const size_t start = t * m->step;
+        const vv_dsp_real* span = signal + start;
+        if (start + m->nmax > n) {
+            for (size_t i = 0; i < m->nmax; ++i) m->edge[i] = (start + i < n) ? signal[start + i] : (vv_dsp_real)0;
+            span = m->edge;
         }
-        vv_dsp_status s = vv_dsp_stft_process(h, frame, spec);
-        if (s != VV_DSP_OK) { free(spec); free(frame); return s; }
-        for (size_t k=0;k<h->nfft;++k) {
-            vv_dsp_real re = spec[k].re, im = spec[k].im;
-            #if defined(VV_DSP_USE_DOUBLE)
-            out_mag[f*h->nfft + k] = (vv_dsp_real)sqrt(re*re + im*im);
-            #else
-            out_mag[f*h->nfft + k] = (vv_dsp_real)sqrtf(re*re + im*im);
-            #endif
+        for (size_t r = 0; r < m->num_res && s == VV_DSP_OK; ++r) {
+            stft_mr_res* rr = &m->res[r];
+            if (t % rr->every != 0) continue;
+            s = vv_dsp_vectorized_window_apply(span + rr->offset, rr->win, rr->frames + rr->staged * rr->nfft,
+                                               rr->nfft);
+            if (s == VV_DSP_OK && ++rr->staged == STFT_MR_BATCH) s = multires_flush(rr, out[r], scale, floor_v);
         }
     }
-    free(spec); free(frame);
+    for (size_t r = 0; r < m->num_res && s == VV_DSP_OK; ++r) {
+        if (m->res[r].staged) s = multires_flush(&m->res[r], out[r], scale, floor_v);
+    }
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_stream_reserve(vv_dsp_stft* h, size_t max_block) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (max_block == 0 || max_block > (size_t)-1 - h->nfft) return VV_DSP_ERROR_INVALID_SIZE;
+    // After popping every ready frame fewer than nfft samples remain buffered
+    const size_t cap = h->nfft + max_block;
+    if (cap != h->ring_cap) {
+        vv_dsp_real* ring = (vv_dsp_real*)vv_dsp_malloc(sizeof(vv_dsp_real) * cap);
+        if (!ring) return VV_DSP_ERROR_INTERNAL;
+        vv_dsp_free(h->ring);
+        h->ring = ring;
+        h->ring_cap = cap;
+    }
+    h->ring_rd = 0;
+    h->ring_count = 0;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_prepare(vv_dsp_stft* h, size_t max_block) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_status s = vv_dsp_stft_stream_reserve(h, max_block);
+    if (s != VV_DSP_OK) return s;
+    s = vv_dsp_stft_synth_reset(h);
+    if (s == VV_DSP_OK) h->max_block = max_block;
+    return s;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_push(vv_dsp_stft* h, const vv_dsp_real* samples, size_t n) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    if (n == 0) return VV_DSP_OK;
+    if (!samples) return VV_DSP_ERROR_NULL_POINTER;
+    if (!h->ring) {
+        // Handles from a shared config allocate the default ring on first use
+        vv_dsp_status s = vv_dsp_stft_stream_reserve(h, h->nfft);
+        if (s != VV_DSP_OK) return s;
+    }
+    if (n > h->ring_cap - h->ring_count) return VV_DSP_ERROR_INVALID_SIZE;
+    size_t wr = h->ring_rd + h->ring_count;
+    if (wr >= h->ring_cap) wr -= h->ring_cap;
+    const size_t first = (n < h->ring_cap - wr) ? n : h->ring_cap - wr;
+    memcpy(h->ring + wr, samples, sizeof(vv_dsp_real) * first);
+    if (first < n) memcpy(h->ring, samples + first, sizeof(vv_dsp_real) * (n - first));
+    h->ring_count += n;
+    return VV_DSP_OK;
+}
+
+size_t vv_dsp_stft_frames_ready(const vv_dsp_stft* h) {
+    if (!h || h->ring_count < h->nfft) return 0;
+    return 1 + (h->ring_count - h->nfft) / h->hop;
+}
+
+size_t vv_dsp_stft_stream_space(const vv_dsp_stft* h) {
+    if (!h) return 0;
+    return h->ring ? h->ring_cap - h->ring_count : 2 * h->nfft;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_pop_frame(vv_dsp_stft* h, vv_dsp_cpx* out) {
+    if (!h || !out) return VV_DSP_ERROR_NULL_POINTER;
+    if (h->ring_count < h->nfft) return VV_DSP_ERROR_INVALID_SIZE;
+    // Window straight out of the ring: one pass, or two when the frame wraps
+    const size_t first = (h->nfft < h->ring_cap - h->ring_rd) ? h->nfft : h->ring_cap - h->ring_rd;
+    vv_dsp_status s = vv_dsp_vectorized_window_apply(h->ring + h->ring_rd, h->win, h->timebuf, first);
+    if (s == VV_DSP_OK && first < h->nfft) {
+        s = vv_dsp_vectorized_window_apply(h->ring, h->win + first, h->timebuf + first, h->nfft - first);
+    }
+    if (s != VV_DSP_OK) return s;
+    h->ring_rd += h->hop;
+    if (h->ring_rd >= h->ring_cap) h->ring_rd -= h->ring_cap;
+    h->ring_count -= h->hop;
+    const int rt = VV_DSP_RT_ENTER(h->max_block != 0);
+    s = stft_analyze(h, out);
+    VV_DSP_RT_LEAVE(rt);
+    return s;
+}
+
+vv_dsp_status vv_dsp_stft_stream_reset(vv_dsp_stft* h) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    h->ring_rd = 0;
+    h->ring_count = 0;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_stft_synth_frame(vv_dsp_stft* h,
+                                                       const vv_dsp_cpx* in,
+                                                       vv_dsp_real* out_hop) {
+    if (!h || !in || !out_hop) return VV_DSP_ERROR_NULL_POINTER;
+    const vv_dsp_real* time = NULL;
+    size_t stride = 1;
+    vv_dsp_status s = stft_inverse(h, in, &time, &stride);
+    if (s != VV_DSP_OK) return s;
+    vv_dsp_real* ola = h->ola;
+    const vv_dsp_real* ws = h->synth_win;
+    const size_t hop = h->hop, nfft = h->nfft;
+    // The first hop samples are final once this frame is added
+    for (size_t i = 0; i < hop; ++i) out_hop[i] = ola[i] + time[i * stride] * ws[i];
+    for (size_t i = hop; i < nfft; ++i) ola[i - hop] = ola[i] + time[i * stride] * ws[i];
+    memset(ola + (nfft - hop), 0, sizeof(vv_dsp_real) * hop);
+    return VV_DSP_OK;
+}
+
+vv_dsp_status vv_dsp_stft_synth_reset(vv_dsp_stft* h) {
+    if (!h) return VV_DSP_ERROR_NULL_POINTER;
+    memset(h->ola, 0, sizeof(vv_dsp_real) * h->nfft);
     return VV_DSP_OK;
 }
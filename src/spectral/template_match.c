@@ -0,0 +1,290 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/spectral/template_match.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/core.h"
+#include "vv_dsp/core/alloc.h"
+
+#define TM_MIN_FFT 256
+#define TM_DIRECT_BLOCK 1024    // offsets per block on the direct path
+#define TM_VAR_FLOOR 1e-12      // window variance below this fraction of its energy scores 0
+
+struct vv_dsp_template_matcher {
+    size_t T;
+    size_t Lmax;
+    size_t K;
+    size_t sep;                 // 0 = per template len / 2
+    int direct;
+    size_t P;                   // FFT block (FFT path)
+    size_t nb;                  // P / 2 + 1
+    size_t hop;                 // offsets per block
+    vv_dsp_fft_plan* r2c;
+    vv_dsp_fft_plan* c2r;
+    vv_dsp_real* tpl;           // T * Lmax: zero-mean, unit-norm templates
+    size_t* len;                // T, 0 = unset
+    vv_dsp_cpx* spec;           // T * nb template spectra (FFT path)
+    vv_dsp_real* seg;           // P: signal block, later the correlation
+    vv_dsp_cpx* X;              // nb
+    vv_dsp_cpx* G;              // nb
+    vv_dsp_real* num;           // hop numerators of the current template and block
+    double* s1;                 // T running sums of the window
+    double* s2;
+    vv_dsp_template_match* top; // T * K
+    size_t* cnt;                // T
+};
+
+static size_t next_pow2(size_t v) {
+    size_t n = 1;
+    while (n < v) n <<= 1;
+    return n;
+}
+
+void vv_dsp_template_matcher_destroy(vv_dsp_template_matcher* m) {
+    if (!m) return;
+    if (m->r2c) (void)vv_dsp_fft_plan_release(m->r2c);
+    if (m->c2r) (void)vv_dsp_fft_plan_release(m->c2r);
+    vv_dsp_free(m->tpl); vv_dsp_free(m->len); vv_dsp_free(m->spec); vv_dsp_free(m->seg);
+    vv_dsp_free(m->X); vv_dsp_free(m->G); vv_dsp_free(m->num); vv_dsp_free(m->s1); vv_dsp_free(m->s2);
+    vv_dsp_free(m->top); vv_dsp_free(m->cnt);
+    vv_dsp_free(m);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_create(const vv_dsp_template_match_params* prm,
+                                                              vv_dsp_template_matcher** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (!prm) return VV_DSP_ERROR_NULL_POINTER;
+    if (prm->num_templates == 0 || prm->max_template_len == 0 || prm->top_k == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (prm->method != VV_DSP_TEMPLATE_AUTO && prm->method != VV_DSP_TEMPLATE_DIRECT &&
+        prm->method != VV_DSP_TEMPLATE_FFT) {
+        return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    const size_t T = prm->num_templates, L = prm->max_template_len;
+    if (prm->fft_size && prm->fft_size <= L) return VV_DSP_ERROR_INVALID_SIZE;
+
+    vv_dsp_template_matcher* m = (vv_dsp_template_matcher*)vv_dsp_calloc(1, sizeof(*m));
+    if (!m) return VV_DSP_ERROR_INTERNAL;
+    m->T = T;
+    m->Lmax = L;
+    m->K = prm->top_k;
+    m->sep = prm->min_separation;
+    m->direct = prm->method == VV_DSP_TEMPLATE_DIRECT ||
+                (prm->method == VV_DSP_TEMPLATE_AUTO && L <= VV_DSP_TEMPLATE_DIRECT_MAX);
+    vv_dsp_status s = VV_DSP_OK;
+    if (m->direct) {
+        m->hop = TM_DIRECT_BLOCK;
+    } else {
+        m->P = prm->fft_size ? prm->fft_size : next_pow2(4 * L > TM_MIN_FFT ? 4 * L : TM_MIN_FFT);
+        m->nb = m->P / 2 + 1;
+        m->hop = m->P - L + 1;
+        m->spec = (vv_dsp_cpx*)vv_dsp_calloc(T * m->nb, sizeof(vv_dsp_cpx));
+        m->seg = (vv_dsp_real*)vv_dsp_malloc(m->P * sizeof(vv_dsp_real));
+        m->X = (vv_dsp_cpx*)vv_dsp_malloc(m->nb * sizeof(vv_dsp_cpx));
+        m->G = (vv_dsp_cpx*)vv_dsp_malloc(m->nb * sizeof(vv_dsp_cpx));
+        if (!m->spec || !m->seg || !m->X || !m->G) s = VV_DSP_ERROR_INTERNAL;
+        if (s == VV_DSP_OK) s = vv_dsp_fft_plan_acquire(m->P, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &m->r2c);
+        if (s == VV_DSP_OK) s = vv_dsp_fft_plan_acquire(m->P, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &m->c2r);
+    }
+    m->tpl = (vv_dsp_real*)vv_dsp_calloc(T * L, sizeof(vv_dsp_real));
+    m->len = (size_t*)vv_dsp_calloc(T, sizeof(size_t));
+    m->num = (vv_dsp_real*)vv_dsp_malloc(m->hop * sizeof(vv_dsp_real));
+    m->s1 = (double*)vv_dsp_malloc(T * sizeof(double));
+    m->s2 = (double*)vv_dsp_malloc(T * sizeof(double));
+    m->top = (vv_dsp_template_match*)vv_dsp_malloc(T * m->K * sizeof(vv_dsp_template_match));
+    m->cnt = (size_t*)vv_dsp_calloc(T, sizeof(size_t));
+    if (s == VV_DSP_OK && (!m->tpl || !m->len || !m->num || !m->s1 || !m->s2 || !m->top || !m->cnt)) {
+        s = VV_DSP_ERROR_INTERNAL;
+    }
+    if (s != VV_DSP_OK) {
+        vv_dsp_template_matcher_destroy(m);
+        return s;
+    }
+    *out = m;
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_set(vv_dsp_template_matcher* m,
+                                                           size_t idx,
+                                                           const vv_dsp_real* t,
+                                                           size_t len) {
+    if (!m || !t) return VV_DSP_ERROR_NULL_POINTER;
+    if (len == 0 || len > m->Lmax) return VV_DSP_ERROR_INVALID_SIZE;
+    if (idx >= m->T) return VV_DSP_ERROR_OUT_OF_RANGE;
+    double mean = 0.0, e = 0.0;
+    for (size_t i = 0; i < len; ++i) mean += (double)t[i];
+    mean /= (double)len;
+    for (size_t i = 0; i < len; ++i) e += ((double)t[i] - mean) * ((double)t[i] - mean);
+    if (!(e > 0.0)) return VV_DSP_ERROR_OUT_OF_RANGE;
+    const double g = 1.0 / sqrt(e);
+    vv_dsp_real* dst = m->tpl + idx * m->Lmax;
+    for (size_t i = 0; i < len; ++i) dst[i] = (vv_dsp_real)(((double)t[i] - mean) * g);
+    m->len[idx] = 0;
+    if (!m->direct) {
+        memset(m->seg, 0, m->P * sizeof(vv_dsp_real));
+        memcpy(m->seg, dst, len * sizeof(vv_dsp_real));
+        const vv_dsp_status s = vv_dsp_fft_execute(m->r2c, m->seg, m->spec + idx * m->nb);
+        if (s != VV_DSP_OK) return s;
+    }
+    m->len[idx] = len;
+    return VV_DSP_OK;
+}
+
+// Keep the best separated matches of one template (see the header)
+static void tm_offer(vv_dsp_template_match* top, size_t* cnt, size_t K, size_t sep, size_t off, vv_dsp_real score) {
+    size_t n = *cnt;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t d = off > top[i].offset ? off - top[i].offset : top[i].offset - off;
+        if (d < sep && !(score > top[i].score)) return;
+    }
+    size_t w = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t d = off > top[i].offset ? off - top[i].offset : top[i].offset - off;
+        if (d >= sep) top[w++] = top[i];
+    }
+    n = w;
+    if (n < K) {
+        top[n].offset = off;
+        top[n].score = score;
+        *cnt = n + 1;
+        return;
+    }
+    size_t worst = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (top[i].score < top[worst].score) worst = i;
+    }
+    if (score > top[worst].score) {
+        top[worst].offset = off;
+        top[worst].score = score;
+    }
+    *cnt = n;
+}
+
+// Numerators of template j for offsets [b, b + cnt) into m->num
+static vv_dsp_status tm_numerators(vv_dsp_template_matcher* m, size_t j, const vv_dsp_real* x, size_t b,
+                                   size_t cnt) {
+    const size_t L = m->len[j];
+    if (m->direct) {
+        const vv_dsp_real* t = m->tpl + j * m->Lmax;
+        for (size_t k = 0; k < cnt; ++k) {
+            const vv_dsp_real* w = x + b + k;
+            vv_dsp_real acc = 0;
+            for (size_t i = 0; i < L; ++i) acc += t[i] * w[i];
+            m->num[k] = acc;
+        }
+        return VV_DSP_OK;
+    }
+    // m->X holds the block spectrum; the circular correlation is exact for lags <= P - L
+    (void)vv_dsp_cpx_conj_mul_array(m->X, m->spec + j * m->nb, m->G, m->nb);
+    const vv_dsp_status s = vv_dsp_fft_execute(m->c2r, m->G, m->seg);
+    if (s != VV_DSP_OK) return s;
+    memcpy(m->num, m->seg, cnt * sizeof(vv_dsp_real));
+    return VV_DSP_OK;
+}
+
+// Scores of template j for offsets [b, b + cnt): running window sums, then either a
+// score row or the top-k list
+static void tm_score(vv_dsp_template_matcher* m, size_t j, const vv_dsp_real* x, size_t b, size_t cnt,
+                     vv_dsp_real* row) {
+    const size_t L = m->len[j];
+    const double invL = 1.0 / (double)L;
+    const size_t sep = m->sep ? m->sep : (L / 2 ? L / 2 : 1);
+    double s1 = m->s1[j], s2 = m->s2[j];
+    for (size_t k = 0; k < cnt; ++k) {
+        const size_t o = b + k;
+        if (o == 0) {
+            s1 = s2 = 0.0;
+            for (size_t i = 0; i < L; ++i) {
+                s1 += (double)x[i];
+                s2 += (double)x[i] * (double)x[i];
+            }
+        } else {
+            const double in = (double)x[o + L - 1], gone = (double)x[o - 1];
+            s1 += in - gone;
+            s2 += in * in - gone * gone;
+        }
+        const double var = s2 - s1 * s1 * invL;
+        double sc = 0.0;
+        if (var > TM_VAR_FLOOR * s2 && var > 0.0) {
+            sc = (double)m->num[k] / sqrt(var);
+            sc = sc > 1.0 ? 1.0 : (sc < -1.0 ? -1.0 : sc);
+        }
+        if (row) {
+            row[k] = (vv_dsp_real)sc;
+        } else {
+            tm_offer(m->top + j * m->K, &m->cnt[j], m->K, sep, o, (vv_dsp_real)sc);
+        }
+    }
+    m->s1[j] = s1;
+    m->s2[j] = s2;
+}
+
+// Blocks of hop offsets; one signal transform per block serves every selected template
+static vv_dsp_status tm_run(vv_dsp_template_matcher* m, const vv_dsp_real* x, size_t n, size_t only,
+                            vv_dsp_real* row) {
+    for (size_t b = 0;; b += m->hop) {
+        int any = 0;
+        for (size_t j = 0; j < m->T; ++j) {
+            if ((only < m->T && j != only) || !m->len[j] || m->len[j] > n || b > n - m->len[j]) continue;
+            any = 1;
+        }
+        if (!any) return VV_DSP_OK;
+        if (!m->direct) {
+            const size_t avail = n - b < m->P ? n - b : m->P;
+            memcpy(m->seg, x + b, avail * sizeof(vv_dsp_real));
+            memset(m->seg + avail, 0, (m->P - avail) * sizeof(vv_dsp_real));
+            const vv_dsp_status s = vv_dsp_fft_execute(m->r2c, m->seg, m->X);
+            if (s != VV_DSP_OK) return s;
+        }
+        for (size_t j = 0; j < m->T; ++j) {
+            const size_t L = m->len[j];
+            if ((only < m->T && j != only) || !L || L > n || b > n - L) continue;
+            const size_t last = n - L;  // final offset
+            const size_t cnt = (last - b + 1 < m->hop) ? last - b + 1 : m->hop;
+            const vv_dsp_status s = tm_numerators(m, j, x, b, cnt);
+            if (s != VV_DSP_OK) return s;
+            tm_score(m, j, x, b, cnt, row ? row + b : NULL);
+        }
+    }
+}
+
+static int tm_by_score(const void* a, const void* b) {
+    const vv_dsp_template_match* p = (const vv_dsp_template_match*)a;
+    const vv_dsp_template_match* q = (const vv_dsp_template_match*)b;
+    if (p->score != q->score) return p->score > q->score ? -1 : 1;
+    return p->offset < q->offset ? -1 : (p->offset > q->offset);
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_match(vv_dsp_template_matcher* m,
+                                                             const vv_dsp_real* x,
+                                                             size_t n,
+                                                             vv_dsp_template_match* matches,
+                                                             size_t* counts) {
+    if (!m || !matches) return VV_DSP_ERROR_NULL_POINTER;
+    if (n && !x) return VV_DSP_ERROR_NULL_POINTER;
+    memset(m->cnt, 0, m->T * sizeof(size_t));
+    const vv_dsp_status s = tm_run(m, x, n, m->T, NULL);
+    if (s != VV_DSP_OK) return s;
+    for (size_t j = 0; j < m->T; ++j) {
+        vv_dsp_template_match* top = m->top + j * m->K;
+        qsort(top, m->cnt[j], sizeof(*top), tm_by_score);
+        memcpy(matches + j * m->K, top, m->cnt[j] * sizeof(*top));
+        for (size_t i = m->cnt[j]; i < m->K; ++i) {
+            matches[j * m->K + i].offset = 0;
+            matches[j * m->K + i].score = 0;
+        }
+        if (counts) counts[j] = m->cnt[j];
+    }
+    return VV_DSP_OK;
+}
+
+VV_DSP_NODISCARD vv_dsp_status vv_dsp_template_matcher_scores(vv_dsp_template_matcher* m,
+                                                              size_t idx,
+                                                              const vv_dsp_real* x,
+                                                              size_t n,
+                                                              vv_dsp_real* scores) {
+    if (!m || !x || !scores) return VV_DSP_ERROR_NULL_POINTER;
+    if (idx >= m->T || !m->len[idx]) return VV_DSP_ERROR_OUT_OF_RANGE;
+    if (m->len[idx] > n) return VV_DSP_ERROR_INVALID_SIZE;
+    return tm_run(m, x, n, idx, scores);
+}
@@ -1,12 +1,54 @@
 #include <stddef.h>
 #include <string.h>
 #include "vv_dsp/spectral/utils.h"
+#include "vv_dsp/core/vmath.h"
+
+// Rotate left by k in place: swap the halves when they are equal, else three reversals
+static void reverse_real(vv_dsp_real* x, size_t n) {
+    for (size_t i = 0, j = n; i + 1 < j; ++i) {
+        --j;
+        const vv_dsp_real t = x[i]; x[i] = x[j]; x[j] = t;
+    }
+}
+
+static void rotate_real(vv_dsp_real* x, size_t n, size_t k) {
+    if (2 * k == n) {
+        for (size_t i = 0; i < k; ++i) {
+            const vv_dsp_real t = x[i]; x[i] = x[i + k]; x[i + k] = t;
+        }
+        return;
+    }
+    reverse_real(x, k);
+    reverse_real(x + k, n - k);
+    reverse_real(x, n);
+}
+
+static void reverse_cpx(vv_dsp_cpx* x, size_t n) {
+    for (size_t i = 0, j = n; i + 1 < j; ++i) {
+        --j;
+        const vv_dsp_cpx t = x[i]; x[i] = x[j]; x[j] = t;
+    }
+}
+
+static void rotate_cpx(vv_dsp_cpx* x, size_t n, size_t k) {
+    if (2 * k == n) {
+        for (size_t i = 0; i < k; ++i) {
+            const vv_dsp_cpx t = x[i]; x[i] = x[i + k]; x[i + k] = t;
+        }
+        return;
+    }
+    reverse_cpx(x, k);
+    reverse_cpx(x + k, n - k);
+    reverse_cpx(x, n);
+}
 
 static vv_dsp_status shift_core_real(const vv_dsp_real* in, vv_dsp_real* out, size_t n, int inverse) {
     if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
     if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
     size_t k = n/2;
-    if (!inverse) {
+    if (in == out) {
+        rotate_real(out, n, inverse ? n - k : k);
+    } else if (!inverse) {
         // fftshift: swap halves
         memcpy(out, in + k, sizeof(*out) * (n - k));
         memcpy(out + (n - k), in, sizeof(*out) * k);
@@ -22,7 +64,9 @@ static vv_dsp_status shift_core_cpx(const vv_dsp_cpx* in, vv_dsp_cpx* out, size_
     if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
     if (n == 0) return VV_DSP_ERROR_INVALID_SIZE;
     size_t k = n/2;
-    if (!inverse) {
+    if (in == out) {
+        rotate_cpx(out, n, inverse ? n - k : k);
+    } else if (!inverse) {
         memcpy(out, in + k, sizeof(*out) * (n - k));
         memcpy(out + (n - k), in, sizeof(*out) * k);
     } else {
@@ -45,27 +89,25 @@ vv_dsp_status vv_dsp_ifftshift_cpx(const vv_dsp_cpx* in, vv_dsp_cpx* out, size_t
     return shift_core_cpx(in, out, n, 1);
 }
 
+vv_dsp_status vv_dsp_fftshift_inplace_real(vv_dsp_real* x, size_t n) {
+    return shift_core_real(x, x, n, 0);
+}
+vv_dsp_status vv_dsp_ifftshift_inplace_real(vv_dsp_real* x, size_t n) {
+    return shift_core_real(x, x, n, 1);
+}
+vv_dsp_status vv_dsp_fftshift_inplace_cpx(vv_dsp_cpx* x, size_t n) {
+    return shift_core_cpx(x, x, n, 0);
+}
+vv_dsp_status vv_dsp_ifftshift_inplace_cpx(vv_dsp_cpx* x, size_t n) {
+    return shift_core_cpx(x, x, n, 1);
+}
+
 vv_dsp_status vv_dsp_phase_wrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n) {
-    if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
-    for (size_t i=0;i<n;++i) {
-        vv_dsp_real x = in[i];
-        // map to (-pi, pi]
-        while (x <= -VV_DSP_PI) x += VV_DSP_TWO_PI;
-        while (x > VV_DSP_PI) x -= VV_DSP_TWO_PI;
-        out[i] = x;
-    }
-    return VV_DSP_OK;
+    return vv_dsp_vphase_wrap(in, out, n);
 }
 
 vv_dsp_status vv_dsp_phase_unwrap(const vv_dsp_real* in, vv_dsp_real* out, size_t n) {
     if (!in || !out) return VV_DSP_ERROR_NULL_POINTER;
     if (n==0) return VV_DSP_ERROR_INVALID_SIZE;
-    out[0] = in[0];
-    for (size_t i=1;i<n;++i) {
-        vv_dsp_real delta = in[i] - in[i-1];
-        if (delta > VV_DSP_PI) delta -= VV_DSP_TWO_PI;
-        else if (delta < -VV_DSP_PI) delta += VV_DSP_TWO_PI;
-        out[i] = out[i-1] + delta;
-    }
-    return VV_DSP_OK;
+    return vv_dsp_vphase_unwrap(in, out, n);
 }
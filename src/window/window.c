@@ -3,7 +3,32 @@
 
 #include <math.h>
 #include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/alloc.h"
 #include <stddef.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef SRWLOCK window_mutex;
+#define WINDOW_MUTEX_INIT SRWLOCK_INIT
+#define WINDOW_LOCK(m)   AcquireSRWLockExclusive(m)
+#define WINDOW_UNLOCK(m) ReleaseSRWLockExclusive(m)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t window_mutex;
+#define WINDOW_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define WINDOW_LOCK(m)   pthread_mutex_lock(m)
+#define WINDOW_UNLOCK(m) pthread_mutex_unlock(m)
+#endif
+
+// Single-cosine windows take the vector cosine; double builds keep libm
+#if defined(VV_DSP_USE_DOUBLE)
+#define WINDOW_COS_TIER VV_DSP_VMATH_EXACT
+#else
+#define WINDOW_COS_TIER VV_DSP_VMATH_MEDIUM
+#endif
 
 
 // Internal helper for common validation
@@ -22,85 +47,70 @@ vv_dsp_status vv_dsp_window_boxcar(size_t N, vv_dsp_real* out) {
     return VV_DSP_OK;
 }
 
+// Symmetric cosine-sum window w[n] = sum_k (-1)^k a[k] cos(k x), x = 2 pi n / (N - 1), N > 1.
+// One vector cosine per sample of the first half; the harmonics follow pointwise from the
+// Chebyshev recurrence cos(kx) = 2 cos(x) cos((k-1)x) - cos((k-2)x), so no error builds up
+// along n, and the second half mirrors the first.
+static vv_dsp_status window_cosine_sum(size_t N, const double* a, int terms, vv_dsp_real* out) {
+    const size_t half = (N + 1) / 2;
+    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / (vv_dsp_real)(N - 1);
+    for (size_t n = 0; n < half; ++n) out[n] = two_pi_over * (vv_dsp_real)n;
+    vv_dsp_status s = vv_dsp_vcos(out, out, half, WINDOW_COS_TIER);
+    if (s != VV_DSP_OK) return s;
+    for (size_t n = 0; n < half; ++n) {
+        const double c = (double)out[n];
+        double t_prev = 1.0, t = c;
+        double acc = a[0] - a[1] * c;
+        for (int k = 2; k < terms; ++k) {
+            const double t_next = 2.0 * c * t - t_prev;
+            t_prev = t;
+            t = t_next;
+            acc += (k & 1) ? -a[k] * t : a[k] * t;
+        }
+        out[n] = (vv_dsp_real)acc;
+    }
+    for (size_t n = 0; n < N / 2; ++n) out[N - 1 - n] = out[n];
+    return VV_DSP_OK;
+}
+
 vv_dsp_status vv_dsp_window_hann(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / denom;
-    for (size_t n = 0; n < N; ++n) {
-    vv_dsp_real c = (vv_dsp_real)VV_DSP_COS(two_pi_over * (vv_dsp_real)n);
-        out[n] = (vv_dsp_real)0.5 - (vv_dsp_real)0.5 * c;
-    }
-    return VV_DSP_OK;
+    static const double a[2] = { 0.5, 0.5 };
+    return window_cosine_sum(N, a, 2, out);
 }
 
 vv_dsp_status vv_dsp_window_hamming(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / denom;
-    for (size_t n = 0; n < N; ++n) {
-    vv_dsp_real c = (vv_dsp_real)VV_DSP_COS(two_pi_over * (vv_dsp_real)n);
-        out[n] = (vv_dsp_real)0.54 - (vv_dsp_real)0.46 * c;
-    }
-    return VV_DSP_OK;
+    static const double a[2] = { 0.54, 0.46 };
+    return window_cosine_sum(N, a, 2, out);
 }
 
 vv_dsp_status vv_dsp_window_blackman(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / denom;
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real x = two_pi_over * (vv_dsp_real)n;
-    vv_dsp_real c1 = (vv_dsp_real)VV_DSP_COS(x);
-    vv_dsp_real c2 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)2.0 * x);
-        out[n] = (vv_dsp_real)0.42 - (vv_dsp_real)0.5 * c1 + (vv_dsp_real)0.08 * c2;
-    }
-    return VV_DSP_OK;
+    static const double a[3] = { 0.42, 0.5, 0.08 };
+    return window_cosine_sum(N, a, 3, out);
 }
 
 vv_dsp_status vv_dsp_window_blackman_harris(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-    const vv_dsp_real a0 = (vv_dsp_real)0.35875;
-    const vv_dsp_real a1 = (vv_dsp_real)0.48829;
-    const vv_dsp_real a2 = (vv_dsp_real)0.14128;
-    const vv_dsp_real a3 = (vv_dsp_real)0.01168;
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / denom;
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real x = two_pi_over * (vv_dsp_real)n;
-    vv_dsp_real c1 = (vv_dsp_real)VV_DSP_COS(x);
-    vv_dsp_real c2 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)2.0 * x);
-    vv_dsp_real c3 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)3.0 * x);
-        out[n] = a0 - a1 * c1 + a2 * c2 - a3 * c3;
-    }
-    return VV_DSP_OK;
+    static const double a[4] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+    return window_cosine_sum(N, a, 4, out);
 }
 
 vv_dsp_status vv_dsp_window_nuttall(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-    const vv_dsp_real a0 = (vv_dsp_real)0.3635819;
-    const vv_dsp_real a1 = (vv_dsp_real)0.4891775;
-    const vv_dsp_real a2 = (vv_dsp_real)0.1365995;
-    const vv_dsp_real a3 = (vv_dsp_real)0.0106411;
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = (vv_dsp_real)(VV_DSP_TWO_PI) / denom;
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real x = two_pi_over * (vv_dsp_real)n;
-    vv_dsp_real c1 = (vv_dsp_real)VV_DSP_COS(x);
-    vv_dsp_real c2 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)2.0 * x);
-    vv_dsp_real c3 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)3.0 * x);
-        out[n] = a0 - a1 * c1 + a2 * c2 - a3 * c3;
-    }
-    return VV_DSP_OK;
+    static const double a[4] = { 0.3635819, 0.4891775, 0.1365995, 0.0106411 };
+    return window_cosine_sum(N, a, 4, out);
 }
 
 vv_dsp_status vv_dsp_window_bartlett(size_t N, vv_dsp_real* out) {
@@ -183,45 +193,30 @@ vv_dsp_status vv_dsp_window_planck_taper(size_t N, vv_dsp_real* out) {
     return VV_DSP_OK;
 }
 
-// Helper function for Kaiser window: Modified Bessel function of the first kind, order 0
-static vv_dsp_real vv_dsp__bessel_i0(vv_dsp_real x) {
-    // Approximation for I_0(x) using series expansion
-    vv_dsp_real result = (vv_dsp_real)1.0;
-    vv_dsp_real term = (vv_dsp_real)1.0;
-    vv_dsp_real x_squared = x * x / (vv_dsp_real)4.0;
-
-    for (int n = 1; n <= 20; ++n) { // 20 terms should be sufficient for most cases
-        term *= x_squared / ((vv_dsp_real)n * (vv_dsp_real)n);
-        result += term;
-        if (term < (vv_dsp_real)1e-12) break; // Early termination for convergence
+// Kaiser window: I_0 by its power series sum_k (x^2/4)^k / (k!)^2 in double.
+// Terms needed for arguments up to x; *i0 receives I_0(x)
+static size_t window_i0_terms(double x, double* i0) {
+    const double q = x * x / 4.0;
+    double sum = 1.0, term = 1.0;
+    size_t k = 0;
+    while (k < 1000) {
+        ++k;
+        term *= q / ((double)k * (double)k);
+        if (sum + term == sum) break;
+        sum += term;
     }
-    return result;
+    *i0 = sum;
+    return k;
 }
 
+#define WINDOW_I0_BLOCK 256
+
 vv_dsp_status vv_dsp_window_flattop(size_t N, vv_dsp_real* out) {
     vv_dsp_status s = vv_dsp__validate_window_args(N, out);
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
-
-    // Flattop window coefficients
-    const vv_dsp_real a0 = (vv_dsp_real)0.21557895;
-    const vv_dsp_real a1 = (vv_dsp_real)0.41663158;
-    const vv_dsp_real a2 = (vv_dsp_real)0.277263158;
-    const vv_dsp_real a3 = (vv_dsp_real)0.083578947;
-    const vv_dsp_real a4 = (vv_dsp_real)0.006947368;
-
-    const vv_dsp_real denom = (vv_dsp_real)(N - 1);
-    const vv_dsp_real two_pi_over = VV_DSP_TWO_PI / denom;
-
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real x = two_pi_over * (vv_dsp_real)n;
-        vv_dsp_real c1 = (vv_dsp_real)VV_DSP_COS(x);
-        vv_dsp_real c2 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)2.0 * x);
-        vv_dsp_real c3 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)3.0 * x);
-        vv_dsp_real c4 = (vv_dsp_real)VV_DSP_COS((vv_dsp_real)4.0 * x);
-        out[n] = a0 - a1 * c1 + a2 * c2 - a3 * c3 + a4 * c4;
-    }
-    return VV_DSP_OK;
+    static const double a[5] = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+    return window_cosine_sum(N, a, 5, out);
 }
 
 vv_dsp_status vv_dsp_window_kaiser(size_t N, vv_dsp_real beta, vv_dsp_real* out) {
@@ -229,20 +224,34 @@ vv_dsp_status vv_dsp_window_kaiser(size_t N, vv_dsp_real beta, vv_dsp_real* out)
     if (s != VV_DSP_OK) return s;
     if (N == 1) { out[0] = (vv_dsp_real)1.0; return VV_DSP_OK; }
 
-    const vv_dsp_real bessel_beta = vv_dsp__bessel_i0(beta);
-    const vv_dsp_real half_N_minus_1 = (vv_dsp_real)(N - 1) / (vv_dsp_real)2.0;
-
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real alpha = ((vv_dsp_real)n - half_N_minus_1) / half_N_minus_1;
-        vv_dsp_real sqrt_term = (vv_dsp_real)1.0 - alpha * alpha;
-        if (sqrt_term >= (vv_dsp_real)0.0) {
-            vv_dsp_real sqrt_val = (vv_dsp_real)VV_DSP_SQRT(sqrt_term);
-            vv_dsp_real bessel_arg = beta * sqrt_val;
-            out[n] = vv_dsp__bessel_i0(bessel_arg) / bessel_beta;
-        } else {
-            out[n] = (vv_dsp_real)0.0;
+    // I_0(beta sqrt(1 - alpha^2)) takes the series in q = beta^2 (1 - alpha^2) / 4; the
+    // largest argument, beta, fixes the term count for the whole window, so each block
+    // runs the same loop over all its samples and vectorizes along n
+    double i0_beta;
+    const size_t terms = window_i0_terms((double)beta, &i0_beta);
+    const double q_beta = (double)beta * (double)beta / 4.0;
+    const double h = (double)(N - 1) / 2.0;
+    const size_t half = (N + 1) / 2;
+    double q[WINDOW_I0_BLOCK], term[WINDOW_I0_BLOCK], sum[WINDOW_I0_BLOCK];
+    for (size_t n0 = 0; n0 < half; n0 += WINDOW_I0_BLOCK) {
+        const size_t m = (half - n0 < WINDOW_I0_BLOCK) ? half - n0 : WINDOW_I0_BLOCK;
+        for (size_t i = 0; i < m; ++i) {
+            const double alpha = ((double)(n0 + i) - h) / h;
+            const double r = 1.0 - alpha * alpha;
+            q[i] = (r > 0.0) ? q_beta * r : 0.0;
+            term[i] = 1.0;
+            sum[i] = 1.0;
+        }
+        for (size_t k = 1; k <= terms; ++k) {
+            const double inv_k2 = 1.0 / ((double)k * (double)k);
+            for (size_t i = 0; i < m; ++i) {
+                term[i] *= q[i] * inv_k2;
+                sum[i] += term[i];
+            }
         }
+        for (size_t i = 0; i < m; ++i) out[n0 + i] = (vv_dsp_real)(sum[i] / i0_beta);
     }
+    for (size_t n = 0; n < N / 2; ++n) out[N - 1 - n] = out[n];
     return VV_DSP_OK;
 }
 
@@ -258,21 +267,173 @@ vv_dsp_status vv_dsp_window_tukey(size_t N, vv_dsp_real alpha, vv_dsp_real* out)
     const vv_dsp_real N_real = (vv_dsp_real)N;
     const vv_dsp_real taper_width = alpha * (N_real - (vv_dsp_real)1.0) / (vv_dsp_real)2.0;
 
-    for (size_t n = 0; n < N; ++n) {
-        vv_dsp_real n_real = (vv_dsp_real)n;
+    // The taper occupies n < taper_width at each end and the window is symmetric:
+    // one vector cosine over the left taper, constant middle, mirrored right half
+    const size_t half = (N + 1) / 2;
+    size_t taper = 0;
+    while (taper < half && (vv_dsp_real)taper < taper_width) ++taper;
+    for (size_t n = 0; n < taper; ++n) out[n] = VV_DSP_PI * (vv_dsp_real)n / taper_width;
+    s = vv_dsp_vcos(out, out, taper, WINDOW_COS_TIER);
+    if (s != VV_DSP_OK) return s;
+    for (size_t n = 0; n < taper; ++n) out[n] = (vv_dsp_real)0.5 * ((vv_dsp_real)1.0 - out[n]);
+    for (size_t n = taper; n < half; ++n) out[n] = (vv_dsp_real)1.0;
+    for (size_t n = 0; n < N / 2; ++n) out[N - 1 - n] = out[n];
+    return VV_DSP_OK;
+}
 
-        if (n_real < taper_width) {
-            // Left taper (Hann-like)
-            vv_dsp_real cos_arg = VV_DSP_PI * n_real / taper_width;
-            out[n] = (vv_dsp_real)0.5 * ((vv_dsp_real)1.0 - (vv_dsp_real)VV_DSP_COS(cos_arg));
-        } else if (n_real >= N_real - taper_width) {
-            // Right taper (Hann-like)
-            vv_dsp_real cos_arg = VV_DSP_PI * (N_real - (vv_dsp_real)1.0 - n_real) / taper_width;
-            out[n] = (vv_dsp_real)0.5 * ((vv_dsp_real)1.0 - (vv_dsp_real)VV_DSP_COS(cos_arg));
+static vv_dsp_status window_generate(vv_dsp_window_kind kind, size_t N, vv_dsp_real param, vv_dsp_real* out) {
+    switch (kind) {
+        case VV_DSP_WINDOW_KIND_BOXCAR: return vv_dsp_window_boxcar(N, out);
+        case VV_DSP_WINDOW_KIND_HANN: return vv_dsp_window_hann(N, out);
+        case VV_DSP_WINDOW_KIND_HAMMING: return vv_dsp_window_hamming(N, out);
+        case VV_DSP_WINDOW_KIND_BLACKMAN: return vv_dsp_window_blackman(N, out);
+        case VV_DSP_WINDOW_KIND_BLACKMAN_HARRIS: return vv_dsp_window_blackman_harris(N, out);
+        case VV_DSP_WINDOW_KIND_NUTTALL: return vv_dsp_window_nuttall(N, out);
+        case VV_DSP_WINDOW_KIND_BARTLETT: return vv_dsp_window_bartlett(N, out);
+        case VV_DSP_WINDOW_KIND_BOHMAN: return vv_dsp_window_bohman(N, out);
+        case VV_DSP_WINDOW_KIND_COSINE: return vv_dsp_window_cosine(N, out);
+        case VV_DSP_WINDOW_KIND_PLANCK_TAPER: return vv_dsp_window_planck_taper(N, out);
+        case VV_DSP_WINDOW_KIND_FLATTOP: return vv_dsp_window_flattop(N, out);
+        case VV_DSP_WINDOW_KIND_KAISER: return vv_dsp_window_kaiser(N, param, out);
+        case VV_DSP_WINDOW_KIND_TUKEY: return vv_dsp_window_tukey(N, param, out);
+        default: return VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+}
+
+static int window_takes_param(vv_dsp_window_kind kind) {
+    return kind == VV_DSP_WINDOW_KIND_KAISER || kind == VV_DSP_WINDOW_KIND_TUKEY;
+}
+
+vv_dsp_status vv_dsp_window_fill(vv_dsp_window_kind kind, size_t N, vv_dsp_real param, int periodic,
+                                 vv_dsp_real* out) {
+    vv_dsp_status s = vv_dsp__validate_window_args(N, out);
+    if (s != VV_DSP_OK) return s;
+    if (!periodic || N == 1) return window_generate(kind, N, param, out);
+    // Periodic: the first N points of the symmetric window of length N + 1
+    vv_dsp_real* tmp = (vv_dsp_real*)vv_dsp_malloc((N + 1) * sizeof(vv_dsp_real));
+    if (!tmp) return VV_DSP_ERROR_INTERNAL;
+    s = window_generate(kind, N + 1, param, tmp);
+    if (s == VV_DSP_OK) memcpy(out, tmp, N * sizeof(vv_dsp_real));
+    vv_dsp_free(tmp);
+    return s;
+}
+
+// --------------- Shared Window Cache ---------------
+
+// One entry per (kind, N, param, periodic). Coefficients are read-only once
+// published, so holders read them without locking; the entry is freed when its
+// last holder releases it.
+typedef struct window_cache_entry {
+    vv_dsp_window_kind kind;
+    size_t n;
+    vv_dsp_real param;
+    int periodic;
+    vv_dsp_real* coeffs;  // VV_DSP_SIMD_ALIGN_DEFAULT-aligned
+    size_t refs;
+    struct window_cache_entry* next;
+} window_cache_entry;
+
+static window_mutex g_window_cache_mutex = WINDOW_MUTEX_INIT;
+static window_cache_entry* g_window_cache = NULL;
+static size_t g_window_cache_hits = 0;
+static size_t g_window_cache_misses = 0;
+
+// Called with the lock held
+static window_cache_entry* window_cache_find(vv_dsp_window_kind kind, size_t N, vv_dsp_real param, int periodic) {
+    for (window_cache_entry* e = g_window_cache; e; e = e->next) {
+        if (e->kind == kind && e->n == N && e->param == param && e->periodic == periodic) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+vv_dsp_status vv_dsp_window_acquire(vv_dsp_window_kind kind, size_t N, vv_dsp_real param, int periodic,
+                                    const vv_dsp_real** out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    *out = NULL;
+    if (N == 0) return VV_DSP_ERROR_INVALID_SIZE;
+    if (!window_takes_param(kind)) param = (vv_dsp_real)0;  // one entry regardless of the ignored value
+    periodic = (periodic != 0);
+
+    WINDOW_LOCK(&g_window_cache_mutex);
+    window_cache_entry* e = window_cache_find(kind, N, param, periodic);
+    if (e) {
+        e->refs++;
+        g_window_cache_hits++;
+    } else {
+        g_window_cache_misses++;
+    }
+    WINDOW_UNLOCK(&g_window_cache_mutex);
+
+    if (!e) {
+        window_cache_entry* fresh = (window_cache_entry*)vv_dsp_calloc(1, sizeof(window_cache_entry));
+        if (!fresh) return VV_DSP_ERROR_INTERNAL;
+        fresh->coeffs = (vv_dsp_real*)vv_dsp_aligned_malloc(N * sizeof(vv_dsp_real), VV_DSP_SIMD_ALIGN_DEFAULT);
+        vv_dsp_status s = fresh->coeffs ? vv_dsp_window_fill(kind, N, param, periodic, fresh->coeffs)
+                                        : VV_DSP_ERROR_INTERNAL;
+        if (s != VV_DSP_OK) {
+            vv_dsp_aligned_free(fresh->coeffs);
+            vv_dsp_free(fresh);
+            return s;
+        }
+        fresh->kind = kind;
+        fresh->n = N;
+        fresh->param = param;
+        fresh->periodic = periodic;
+        fresh->refs = 1;
+
+        // Another thread may have published the same window meanwhile
+        WINDOW_LOCK(&g_window_cache_mutex);
+        e = window_cache_find(kind, N, param, periodic);
+        if (e) {
+            e->refs++;
         } else {
-            // Middle section (constant)
-            out[n] = (vv_dsp_real)1.0;
+            fresh->next = g_window_cache;
+            g_window_cache = fresh;
+            e = fresh;
+            fresh = NULL;
         }
+        WINDOW_UNLOCK(&g_window_cache_mutex);
+        if (fresh) {
+            vv_dsp_aligned_free(fresh->coeffs);
+            vv_dsp_free(fresh);
+        }
+    }
+
+    *out = e->coeffs;
+    return VV_DSP_OK;
+}
+
+void vv_dsp_window_release(const vv_dsp_real* window) {
+    if (!window) return;
+    WINDOW_LOCK(&g_window_cache_mutex);
+    window_cache_entry** link = &g_window_cache;
+    while (*link && (*link)->coeffs != window) {
+        link = &(*link)->next;
+    }
+    window_cache_entry* e = *link;
+    int last = 0;
+    if (e && --e->refs == 0) {
+        *link = e->next;
+        last = 1;
+    }
+    WINDOW_UNLOCK(&g_window_cache_mutex);
+    if (last) {
+        vv_dsp_aligned_free(e->coeffs);
+        vv_dsp_free(e);
+    }
+}
+
+vv_dsp_status vv_dsp_window_cache_get_stats(vv_dsp_window_cache_stats* out) {
+    if (!out) return VV_DSP_ERROR_NULL_POINTER;
+    WINDOW_LOCK(&g_window_cache_mutex);
+    out->hits = g_window_cache_hits;
+    out->misses = g_window_cache_misses;
+    out->entries = 0;
+    for (const window_cache_entry* e = g_window_cache; e; e = e->next) {
+        out->entries++;
     }
+    WINDOW_UNLOCK(&g_window_cache_mutex);
     return VV_DSP_OK;
 }
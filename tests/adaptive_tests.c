@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+// Exponentially decaying random echo path
+static void make_path(vv_dsp_real* h, size_t L, unsigned int seed) {
+    for (size_t i = 0; i < L; ++i) h[i] = (vv_dsp_real)(frand(&seed) * exp(-4.0 * (double)i / (double)L) * 0.5);
+}
+
+// mic[t] = sum_c (h_c * ref_c)[t]
+static void echo_of(const vv_dsp_real* const* refs, const vv_dsp_real* const* paths, size_t C, size_t L, size_t n,
+                    vv_dsp_real* mic) {
+    for (size_t t = 0; t < n; ++t) {
+        double acc = 0.0;
+        for (size_t c = 0; c < C; ++c) {
+            for (size_t k = 0; k < L && k <= t; ++k) acc += (double)paths[c][k] * (double)refs[c][t - k];
+        }
+        mic[t] = (vv_dsp_real)acc;
+    }
+}
+
+static double misalignment_db(const vv_dsp_fdaf* f, size_t c, const vv_dsp_real* h, size_t L) {
+    vv_dsp_real* w = (vv_dsp_real*)malloc(L * sizeof(vv_dsp_real));
+    if (!w || vv_dsp_fdaf_get_filter(f, c, w, L) != VV_DSP_OK) {
+        free(w);
+        return 0.0;
+    }
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < L; ++i) {
+        const double d = (double)w[i] - (double)h[i];
+        num += d * d;
+        den += (double)h[i] * (double)h[i];
+    }
+    free(w);
+    return 10.0 * log10(num / den + 1e-30);
+}
+
+// Identify C random paths from white references; over the last quarter the error must be
+// far below the echo (ERLE) and the taps close to the paths
+static int check_identify(size_t C, size_t L, size_t B, vv_dsp_fdaf_constraint mode, size_t chunk) {
+    const size_t n = 48000;
+    vv_dsp_real* buf = (vv_dsp_real*)malloc((2 * C + 2) * n * sizeof(vv_dsp_real));
+    vv_dsp_real* hbuf = (vv_dsp_real*)malloc(C * L * sizeof(vv_dsp_real));
+    if (!buf || !hbuf) {
+        free(buf);
+        free(hbuf);
+        return 0;
+    }
+    const vv_dsp_real* refs[4];
+    const vv_dsp_real* paths[4];
+    unsigned int seed = (unsigned int)(C * 7u + L);
+    for (size_t c = 0; c < C; ++c) {
+        vv_dsp_real* r = buf + c * n;
+        for (size_t i = 0; i < n; ++i) r[i] = (vv_dsp_real)frand(&seed);
+        make_path(hbuf + c * L, L, (unsigned int)(c + 11));
+        refs[c] = r;
+        paths[c] = hbuf + c * L;
+    }
+    vv_dsp_real* mic = buf + C * n;
+    vv_dsp_real* err = buf + (C + 1) * n;
+    echo_of(refs, paths, C, L, n, mic);
+
+    vv_dsp_fdaf_params p;
+    memset(&p, 0, sizeof(p));
+    p.block_size = B;
+    p.num_taps = L;
+    p.num_channels = C;
+    p.constraint = mode;
+    vv_dsp_fdaf* f = NULL;
+    int ok = vv_dsp_fdaf_create(&p, &f) == VV_DSP_OK && vv_dsp_fdaf_latency(f) == B &&
+             vv_dsp_fdaf_num_partitions(f) == (L + B - 1) / B;
+    for (size_t pos = 0; ok && pos < n; pos += chunk) {
+        const size_t m = (n - pos < chunk) ? n - pos : chunk;
+        const vv_dsp_real* rc[4];
+        for (size_t c = 0; c < C; ++c) rc[c] = refs[c] + pos;
+        ok = vv_dsp_fdaf_process(f, rc, mic + pos, err + pos, NULL, m) == VV_DSP_OK;
+    }
+    double e = 0.0, d = 0.0;
+    for (size_t t = 3 * n / 4; ok && t < n; ++t) {
+        e += (double)err[t] * (double)err[t];
+        d += (double)mic[t - B] * (double)mic[t - B];
+    }
+    const double erle = ok ? 10.0 * log10(d / (e + 1e-30)) : 0.0;
+    double mis = 0.0;
+    for (size_t c = 0; ok && c < C; ++c) {
+        const double mc = misalignment_db(f, c, paths[c], L);
+        if (mc > mis || c == 0) mis = mc;
+    }
+    // Unconstrained partitions keep circular wrap-around: only a rough echo estimate
+    const int loose = mode == VV_DSP_FDAF_CONSTRAIN_NONE;
+    if (ok && (erle < (loose ? 20.0 : 30.0) || (!loose && mis > -25.0))) {
+        fprintf(stderr, "C=%zu L=%zu B=%zu mode %d: ERLE %.1f dB, misalignment %.1f dB\n", C, L, B, (int)mode, erle,
+                mis);
+        ok = 0;
+    }
+    vv_dsp_fdaf_destroy(f);
+    free(buf);
+    free(hbuf);
+    return ok;
+}
+
+static int test_identify(void) {
+    int ok = check_identify(1, 1024, 128, VV_DSP_FDAF_CONSTRAIN_ROTATE, 4096);
+    ok &= check_identify(1, 1000, 256, VV_DSP_FDAF_CONSTRAIN_ALL, 100);
+    ok &= check_identify(1, 512, 64, VV_DSP_FDAF_CONSTRAIN_NONE, 77);
+    ok &= check_identify(2, 512, 128, VV_DSP_FDAF_CONSTRAIN_ROTATE, 333);
+    return ok;
+}
+
+typedef struct {
+    size_t calls;
+    size_t freeze_from;
+    double last_ref;
+} hook_state;
+
+static vv_dsp_real freeze_hook(const vv_dsp_fdaf_block_stats* st, void* user) {
+    hook_state* h = (hook_state*)user;
+    h->last_ref = (double)st->ref_power;
+    if (st->block != h->calls++) return (vv_dsp_real)1;
+    return (st->block >= h->freeze_from) ? (vv_dsp_real)0 : (vv_dsp_real)1;
+}
+
+// A near-end burst while the hook freezes adaptation leaves the converged taps intact,
+// and the hook sees every block in order
+static int test_step_hook(void) {
+    const size_t L = 256, B = 64, n = 24000, conv = 16000;
+    vv_dsp_real* ref = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* mic = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* err = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* echo = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real h[256], w1[256], w2[256];
+    int ok = ref && mic && err && echo;
+    unsigned int seed = 3u;
+    for (size_t i = 0; ok && i < n; ++i) ref[i] = (vv_dsp_real)frand(&seed);
+    make_path(h, L, 5u);
+    const vv_dsp_real* refs[1] = {ref};
+    const vv_dsp_real* paths[1] = {h};
+    if (ok) echo_of(refs, paths, 1, L, n, mic);
+    for (size_t i = conv; ok && i < n; ++i) mic[i] += (vv_dsp_real)(0.8 * frand(&seed));
+
+    vv_dsp_fdaf_params p;
+    memset(&p, 0, sizeof(p));
+    p.block_size = B;
+    p.num_taps = L;
+    vv_dsp_fdaf* f = NULL;
+    hook_state hs = {0, conv / B, 0.0};
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_OK && vv_dsp_fdaf_set_step_callback(f, freeze_hook, &hs) == VV_DSP_OK &&
+         vv_dsp_fdaf_process(f, refs, mic, err, echo, conv) == VV_DSP_OK &&
+         vv_dsp_fdaf_get_filter(f, 0, w1, L) == VV_DSP_OK;
+    const vv_dsp_real* rest[1] = {ref + conv};
+    ok = ok && vv_dsp_fdaf_process(f, rest, mic + conv, err + conv, echo + conv, n - conv) == VV_DSP_OK &&
+         vv_dsp_fdaf_get_filter(f, 0, w2, L) == VV_DSP_OK && hs.calls == n / B && fabs(hs.last_ref - 1.0 / 3.0) < 0.1;
+    ok = ok && memcmp(w1, w2, sizeof(w1)) == 0 && misalignment_db(f, 0, h, L) < -25.0;
+    // error + echo reproduces the delayed microphone signal
+    for (size_t t = B; ok && t < n; ++t) ok = fabs((double)err[t] + (double)echo[t] - (double)mic[t - B]) < 1e-4;
+    for (size_t t = 0; ok && t < B; ++t) ok = err[t] == 0 && echo[t] == 0;
+
+    // step 0 through set_step freezes as well; reset clears the taps
+    ok = ok && vv_dsp_fdaf_set_step_callback(f, NULL, NULL) == VV_DSP_OK && vv_dsp_fdaf_set_step(f, 0) == VV_DSP_OK &&
+         vv_dsp_fdaf_process(f, refs, mic, err, NULL, 4000) == VV_DSP_OK &&
+         vv_dsp_fdaf_get_filter(f, 0, w1, L) == VV_DSP_OK && memcmp(w1, w2, sizeof(w1)) == 0 &&
+         vv_dsp_fdaf_reset(f) == VV_DSP_OK && vv_dsp_fdaf_get_filter(f, 0, w1, L) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < L; ++i) ok = w1[i] == 0;
+    vv_dsp_fdaf_destroy(f);
+    free(ref);
+    free(mic);
+    free(err);
+    free(echo);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_fdaf_params p;
+    memset(&p, 0, sizeof(p));
+    vv_dsp_fdaf* f = (vv_dsp_fdaf*)1;
+    p.block_size = 48;
+    p.num_taps = 100;
+    int ok = vv_dsp_fdaf_create(&p, &f) == VV_DSP_ERROR_INVALID_SIZE && f == NULL;
+    p.block_size = 32;
+    p.num_taps = 0;
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_ERROR_INVALID_SIZE;
+    p.num_taps = 100;
+    p.step = (vv_dsp_real)2.5;
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_ERROR_OUT_OF_RANGE;
+    p.step = 0;
+    p.regularization = (vv_dsp_real)-1;
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_ERROR_OUT_OF_RANGE;
+    p.regularization = 0;
+    p.constraint = (vv_dsp_fdaf_constraint)9;
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_fdaf_create(NULL, &f) == VV_DSP_ERROR_NULL_POINTER && vv_dsp_fdaf_create(&p, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    p.constraint = VV_DSP_FDAF_CONSTRAIN_ROTATE;
+    p.num_channels = 2;
+    ok = ok && vv_dsp_fdaf_create(&p, &f) == VV_DSP_OK;
+    if (!ok) return 0;
+    vv_dsp_real x[8] = {0}, taps[4];
+    const vv_dsp_real* one[2] = {x, NULL};
+    const vv_dsp_real* two[2] = {x, x};
+    ok = vv_dsp_fdaf_num_partitions(f) == 4 && vv_dsp_fdaf_process(f, one, x, x, NULL, 8) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fdaf_process(f, NULL, x, x, NULL, 8) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fdaf_process(f, two, x, NULL, NULL, 8) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fdaf_process(f, two, x, x, NULL, 0) == VV_DSP_OK && vv_dsp_fdaf_process(f, two, x, x, x, 8) == VV_DSP_OK &&
+         vv_dsp_fdaf_set_step(f, (vv_dsp_real)2) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_fdaf_get_filter(f, 2, taps, 4) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_fdaf_get_filter(f, 0, NULL, 4) == VV_DSP_ERROR_NULL_POINTER && vv_dsp_fdaf_reset(NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fdaf_latency(NULL) == 0;
+    vv_dsp_fdaf_destroy(f);
+    vv_dsp_fdaf_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_identify()) { fprintf(stderr, "fdaf identification test failed\n"); rc = 1; }
+    if (!test_step_hook()) { fprintf(stderr, "fdaf step hook test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "fdaf error test failed\n"); rc = 1; }
+    if (rc == 0) printf("fdaf tests passed\n");
+    return rc;
+}
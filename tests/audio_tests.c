@@ -1,10 +1,19 @@
 #include "vv_dsp/audio.h"
 #include "vv_dsp/vv_dsp_math.h"
+#include "vv_dsp/core/alloc.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include <assert.h>
+#if defined(_WIN32)
+#include <direct.h>
+#define rmdir _rmdir
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // Test constants
 #define TEST_SAMPLE_RATE 44100.0
@@ -132,6 +141,22 @@ static int test_wav_roundtrip(int bit_depth, int is_float, int num_channels) {
 
     int buffers_match = compare_buffers(original_buffers, read_buffers, num_channels, TEST_DURATION_SAMPLES, tolerance);
 
+    // Both buffer layouts hold exactly what vv_dsp_wav_read() decoded
+    for (int layout = 0; layout < 2 && buffers_match; layout++) {
+        vv_dsp_buffer buf;
+        vv_dsp_wav_info buf_info;
+        buffers_match = vv_dsp_wav_read_buffer(temp_filename, (vv_dsp_buffer_layout)layout, &buf, &buf_info) ==
+                            VV_DSP_OK && buf.channels == (size_t)num_channels && buf.frames == TEST_DURATION_SAMPLES;
+        for (int ch = 0; buffers_match && ch < num_channels; ch++) {
+            for (size_t i = 0; i < TEST_DURATION_SAMPLES; i++) {
+                if (buf.data[(size_t)ch * buf.channel_stride + i * buf.frame_stride] != read_buffers[ch][i]) {
+                    buffers_match = 0;
+                }
+            }
+        }
+        vv_dsp_buffer_free(&buf);
+    }
+
     // Cleanup
     for (int ch = 0; ch < num_channels; ch++) {
         free(original_buffers[ch]);
@@ -152,6 +177,733 @@ static int test_wav_roundtrip(int bit_depth, int is_float, int num_channels) {
     return 1;
 }
 
+// Streaming reader: chunked planar and interleaved reads across staging blocks and a
+// seek must match vv_dsp_wav_read() exactly
+static int test_wav_reader(void) {
+    printf("Testing streaming WAV reader...\n");
+
+    const int num_channels = 2;
+    const size_t num_samples = 20000;  // spans several 64 KiB staging blocks at 24-bit stereo
+    vv_dsp_real* original[2];
+    for (int ch = 0; ch < num_channels; ch++) {
+        original[ch] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+        if (!original[ch]) {
+            printf("ERROR: Failed to allocate original buffer for channel %d\n", ch);
+            return 0;
+        }
+    }
+    generate_sine_wave(original, num_channels, num_samples, TEST_FREQUENCY, TEST_SAMPLE_RATE);
+
+    vv_dsp_wav_info write_info;
+    write_info.num_samples = num_samples;
+    write_info.num_channels = num_channels;
+    write_info.sample_rate = TEST_SAMPLE_RATE;
+    write_info.bit_depth = 24;
+    write_info.is_float = 0;
+
+    const char* temp_filename = "/tmp/test_audio_reader.wav";
+    if (vv_dsp_wav_write(temp_filename, (const vv_dsp_real* const*)original, &write_info) != VV_DSP_OK) {
+        printf("ERROR: Failed to write WAV file: %s\n", vv_dsp_wav_get_error_string());
+        return 0;
+    }
+
+    vv_dsp_real** whole = NULL;
+    vv_dsp_wav_info read_info;
+    if (vv_dsp_wav_read(temp_filename, &whole, &read_info) != VV_DSP_OK) {
+        printf("ERROR: Failed to read WAV file: %s\n", vv_dsp_wav_get_error_string());
+        return 0;
+    }
+
+    vv_dsp_wav_reader* reader = NULL;
+    if (vv_dsp_wav_reader_open(temp_filename, &reader) != VV_DSP_OK) {
+        printf("ERROR: Failed to open reader: %s\n", vv_dsp_wav_get_error_string());
+        return 0;
+    }
+
+    int ok = 1;
+    vv_dsp_wav_info info;
+    ok &= vv_dsp_wav_reader_info(reader, &info) == VV_DSP_OK && info.num_samples == num_samples &&
+          info.num_channels == num_channels && info.bit_depth == 24;
+
+    // Planar, in chunks that straddle the staging blocks
+    vv_dsp_real* planar[2];
+    planar[0] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+    planar[1] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+    size_t pos = 0;
+    while (ok && pos < num_samples) {
+        vv_dsp_real* dst[2] = { planar[0] + pos, planar[1] + pos };
+        size_t got = 0;
+        ok &= vv_dsp_wav_reader_read_planar(reader, dst, 777, &got) == VV_DSP_OK;
+        if (got == 0) break;
+        pos += got;
+    }
+    ok &= pos == num_samples && vv_dsp_wav_reader_tell(reader) == num_samples;
+    for (int ch = 0; ok && ch < num_channels; ch++) {
+        ok &= memcmp(planar[ch], whole[ch], sizeof(vv_dsp_real) * num_samples) == 0;
+    }
+
+    // At the end: a zero-frame read, and no seeking past it
+    size_t got = 1;
+    vv_dsp_real tail[2];
+    ok &= vv_dsp_wav_reader_read_interleaved(reader, tail, 1, &got) == VV_DSP_OK && got == 0;
+    ok &= vv_dsp_wav_reader_seek(reader, num_samples + 1) == VV_DSP_ERROR_OUT_OF_RANGE;
+
+    // Interleaved after a seek, running off the end
+    const size_t start = 12345;
+    vv_dsp_real* inter = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * 2 * num_samples);
+    ok &= vv_dsp_wav_reader_seek(reader, start) == VV_DSP_OK;
+    ok &= vv_dsp_wav_reader_read_interleaved(reader, inter, num_samples, &got) == VV_DSP_OK &&
+          got == num_samples - start;
+    for (size_t i = 0; ok && i < got; i++) {
+        ok &= inter[2 * i] == whole[0][start + i] && inter[2 * i + 1] == whole[1][start + i];
+    }
+
+    vv_dsp_wav_reader_close(reader);
+    vv_dsp_wav_free_buffer(&whole, num_channels);
+    for (int ch = 0; ch < num_channels; ch++) {
+        free(original[ch]);
+        free(planar[ch]);
+    }
+    free(inter);
+    remove(temp_filename);
+
+    if (!ok) {
+        printf("ERROR: Streaming reader mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: Streaming reader test passed\n");
+    return 1;
+}
+
+// Memory-mapped access: zero-copy float32 view, random-access PCM decode and a
+// data chunk at an offset misaligned for its samples
+static int test_wav_mmap(void) {
+    printf("Testing memory-mapped WAV access...\n");
+
+    const int num_channels = 2;
+    const size_t num_samples = 5000;
+    vv_dsp_real* original[2];
+    for (int ch = 0; ch < num_channels; ch++) {
+        original[ch] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+        if (!original[ch]) {
+            printf("ERROR: Failed to allocate original buffer for channel %d\n", ch);
+            return 0;
+        }
+    }
+    generate_sine_wave(original, num_channels, num_samples, TEST_FREQUENCY, TEST_SAMPLE_RATE);
+
+    const char* temp_filename = "/tmp/test_audio_mmap.wav";
+    vv_dsp_wav_info write_info;
+    write_info.num_samples = num_samples;
+    write_info.num_channels = num_channels;
+    write_info.sample_rate = TEST_SAMPLE_RATE;
+    int ok = 1;
+
+    // Float32: the view is the file's samples
+    write_info.bit_depth = 32;
+    write_info.is_float = 1;
+    ok &= vv_dsp_wav_write(temp_filename, (const vv_dsp_real* const*)original, &write_info) == VV_DSP_OK;
+    vv_dsp_wav_map* map = NULL;
+    const float* view = NULL;
+    ok &= vv_dsp_wav_mmap_open(temp_filename, &map) == VV_DSP_OK;
+    ok &= vv_dsp_wav_mmap_float32(map, &view) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < num_samples; i++) {
+        ok &= view[2 * i] == (float)original[0][i] && view[2 * i + 1] == (float)original[1][i];
+    }
+    vv_dsp_wav_mmap_close(map);
+
+    // PCM24: no view; decoded ranges match vv_dsp_wav_read()
+    write_info.bit_depth = 24;
+    write_info.is_float = 0;
+    ok &= vv_dsp_wav_write(temp_filename, (const vv_dsp_real* const*)original, &write_info) == VV_DSP_OK;
+    vv_dsp_real** whole = NULL;
+    vv_dsp_wav_info read_info;
+    ok &= vv_dsp_wav_read(temp_filename, &whole, &read_info) == VV_DSP_OK;
+    ok &= vv_dsp_wav_mmap_open(temp_filename, &map) == VV_DSP_OK;
+    ok &= vv_dsp_wav_mmap_float32(map, &view) == VV_DSP_ERROR_UNSUPPORTED && view == NULL;
+
+    vv_dsp_real left[300], right[300], inter[600];
+    vv_dsp_real* dst[2] = { left, right };
+    size_t got = 0;
+    ok &= vv_dsp_wav_mmap_read_planar(map, 4321, dst, 300, &got) == VV_DSP_OK && got == 300;
+    for (size_t i = 0; ok && i < got; i++) {
+        ok &= left[i] == whole[0][4321 + i] && right[i] == whole[1][4321 + i];
+    }
+    ok &= vv_dsp_wav_mmap_read_interleaved(map, num_samples - 100, inter, 300, &got) == VV_DSP_OK && got == 100;
+    for (size_t i = 0; ok && i < got; i++) {
+        ok &= inter[2 * i] == whole[0][num_samples - 100 + i] && inter[2 * i + 1] == whole[1][num_samples - 100 + i];
+    }
+    ok &= vv_dsp_wav_mmap_read_planar(map, num_samples + 1, dst, 1, &got) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_wav_mmap_close(map);
+    vv_dsp_wav_free_buffer(&whole, num_channels);
+
+    // Mono float32 behind a 2-byte extra chunk: offset 54, so no view but correct decode
+    {
+        static const unsigned char header[] = {
+            'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+            'f', 'm', 't', ' ', 16, 0, 0, 0, 3, 0, 1, 0, 0x44, 0xAC, 0, 0,
+            0x10, 0xB1, 0x02, 0, 4, 0, 32, 0,
+            'p', 'a', 'd', ' ', 2, 0, 0, 0, 0, 0,
+            'd', 'a', 't', 'a', 0x40, 0x9C, 0, 0  // 10000 bytes = 2500 frames
+        };
+        FILE* fp = fopen(temp_filename, "wb");
+        ok &= fp != NULL;
+        if (fp) {
+            fwrite(header, 1, sizeof(header), fp);
+            for (size_t i = 0; i < 2500; i++) {
+                float v = (float)original[0][i];
+                fwrite(&v, sizeof(v), 1, fp);
+            }
+            fclose(fp);
+        }
+        vv_dsp_real mono[2500];
+        vv_dsp_real* mono_dst[1] = { mono };
+        ok &= vv_dsp_wav_mmap_open(temp_filename, &map) == VV_DSP_OK;
+        ok &= vv_dsp_wav_mmap_float32(map, &view) == VV_DSP_ERROR_UNSUPPORTED;
+        ok &= vv_dsp_wav_mmap_read_planar(map, 0, mono_dst, 2500, &got) == VV_DSP_OK && got == 2500;
+        for (size_t i = 0; ok && i < got; i++) {
+            ok &= mono[i] == (vv_dsp_real)(float)original[0][i];
+        }
+        vv_dsp_wav_mmap_close(map);
+    }
+
+    for (int ch = 0; ch < num_channels; ch++) {
+        free(original[ch]);
+    }
+    remove(temp_filename);
+
+    if (!ok) {
+        printf("ERROR: Memory-mapped access mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: Memory-mapped access test passed\n");
+    return 1;
+}
+
+// Streaming writer: asynchronous and synchronous queues with appends that straddle
+// blocks, checked against vv_dsp_wav_write(), and an RF64 file read back
+static int test_wav_writer(void) {
+    printf("Testing streaming WAV writer...\n");
+
+    const int num_channels = 2;
+    const size_t num_samples = 20000;
+    vv_dsp_real* original[2];
+    for (int ch = 0; ch < num_channels; ch++) {
+        original[ch] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+        if (!original[ch]) {
+            printf("ERROR: Failed to allocate original buffer for channel %d\n", ch);
+            return 0;
+        }
+    }
+    generate_sine_wave(original, num_channels, num_samples, TEST_FREQUENCY, TEST_SAMPLE_RATE);
+
+    vv_dsp_wav_info format;
+    format.num_samples = num_samples;
+    format.num_channels = num_channels;
+    format.sample_rate = TEST_SAMPLE_RATE;
+    format.bit_depth = 24;
+    format.is_float = 0;
+
+    const char* ref_filename = "/tmp/test_audio_writer_ref.wav";
+    const char* temp_filename = "/tmp/test_audio_writer.wav";
+    vv_dsp_real** whole = NULL;
+    vv_dsp_wav_info read_info;
+    if (vv_dsp_wav_write(ref_filename, (const vv_dsp_real* const*)original, &format) != VV_DSP_OK ||
+        vv_dsp_wav_read(ref_filename, &whole, &read_info) != VV_DSP_OK) {
+        printf("ERROR: Failed to write reference WAV file: %s\n", vv_dsp_wav_get_error_string());
+        return 0;
+    }
+
+    // {block_frames, num_blocks, synchronous, rf64}
+    const vv_dsp_wav_writer_config configs[] = {
+        { 256, 4, 0, VV_DSP_WAV_RF64_AUTO },
+        { 1000, 3, 1, VV_DSP_WAV_RF64_NEVER },
+        { 0, 0, 0, VV_DSP_WAV_RF64_ALWAYS },
+    };
+    int ok = 1;
+    for (size_t c = 0; ok && c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const vv_dsp_wav_writer_config* cfg = &configs[c];
+        vv_dsp_wav_writer* writer = NULL;
+        if (vv_dsp_wav_writer_open(temp_filename, &format, cfg, &writer) != VV_DSP_OK) {
+            printf("ERROR: Failed to open writer: %s\n", vv_dsp_wav_get_error_string());
+            ok = 0;
+            break;
+        }
+        if (cfg->synchronous) {
+            // More than the whole queue at once is refused
+            ok &= vv_dsp_wav_writer_append_frames(writer, (const vv_dsp_real* const*)original, 3001) ==
+                  VV_DSP_ERROR_OUT_OF_RANGE;
+        }
+        size_t pos = 0;
+        while (ok && pos < num_samples) {
+            size_t n = num_samples - pos < 333 ? num_samples - pos : 333;
+            const vv_dsp_real* src[2] = { original[0] + pos, original[1] + pos };
+            vv_dsp_status st;
+            while ((st = vv_dsp_wav_writer_append_frames(writer, src, n)) == VV_DSP_ERROR_OUT_OF_RANGE) {
+                // the I/O thread is behind; retry
+            }
+            ok &= st == VV_DSP_OK;
+            pos += n;
+        }
+        vv_dsp_wav_writer_stats stats;
+        ok &= vv_dsp_wav_writer_get_stats(writer, &stats) == VV_DSP_OK && stats.frames_appended == num_samples;
+        ok &= !cfg->synchronous || stats.overruns == 1;
+        ok &= vv_dsp_wav_writer_close(writer) == VV_DSP_OK;
+
+        vv_dsp_real** back = NULL;
+        vv_dsp_wav_info back_info;
+        ok &= vv_dsp_wav_read(temp_filename, &back, &back_info) == VV_DSP_OK;
+        ok &= back_info.num_samples == num_samples && back_info.num_channels == num_channels &&
+              back_info.bit_depth == 24 && !back_info.is_float;
+        for (int ch = 0; ok && ch < num_channels; ch++) {
+            ok &= memcmp(back[ch], whole[ch], sizeof(vv_dsp_real) * num_samples) == 0;
+        }
+        vv_dsp_wav_free_buffer(&back, num_channels);
+
+        // Plain RIFF matches the one-shot writer byte for byte; RF64 says so up front
+        FILE* fp = fopen(temp_filename, "rb");
+        FILE* ref = fopen(ref_filename, "rb");
+        ok &= fp != NULL && ref != NULL;
+        if (ok && cfg->rf64 == VV_DSP_WAV_RF64_NEVER) {
+            int a, b;
+            do {
+                a = fgetc(fp);
+                b = fgetc(ref);
+            } while (a == b && a != EOF);
+            ok &= a == b;
+        } else if (ok) {
+            char magic[4] = { 0 };
+            ok &= fread(magic, 1, 4, fp) == 4;
+            ok &= memcmp(magic, cfg->rf64 == VV_DSP_WAV_RF64_ALWAYS ? "RF64" : "RIFF", 4) == 0;
+        }
+        if (fp) fclose(fp);
+        if (ref) fclose(ref);
+        if (!ok) printf("ERROR: Streaming writer mismatch with config %zu\n", c);
+    }
+
+    vv_dsp_wav_free_buffer(&whole, num_channels);
+    for (int ch = 0; ch < num_channels; ch++) {
+        free(original[ch]);
+    }
+    remove(temp_filename);
+    remove(ref_filename);
+
+    if (!ok) {
+        return 0;
+    }
+    printf("SUCCESS: Streaming writer test passed\n");
+    return 1;
+}
+
+// Feature store: chunks written and mapped back, key lookups, zero-copy frame
+// ranges and rejection of a damaged header
+static int test_feature_store(void) {
+    printf("Testing feature store...\n");
+
+    const size_t dim = 13;
+    const char* keys[] = { "utt/c", "utt/a", "empty", "utt/b" };
+    const size_t frames[] = { 100, 7, 0, 1234 };
+    const size_t num_chunks = sizeof(keys) / sizeof(keys[0]);
+    const char* temp_filename = "/tmp/test_feature_store.vvfs";
+
+    vv_dsp_feature_store_writer* writer = NULL;
+    if (vv_dsp_feature_store_writer_open(temp_filename, dim, 160, 16000.0, &writer) != VV_DSP_OK) {
+        printf("ERROR: Failed to create feature store\n");
+        return 0;
+    }
+    int ok = 1;
+    vv_dsp_real* data = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * 1234 * dim);
+    for (size_t c = 0; ok && c < num_chunks; c++) {
+        for (size_t i = 0; i < frames[c] * dim; i++) data[i] = (vv_dsp_real)(c * 100000 + i);
+        ok &= vv_dsp_feature_store_write_chunk(writer, keys[c], data, frames[c]) == VV_DSP_OK;
+    }
+    ok &= vv_dsp_feature_store_write_chunk(writer, "", data, 1) == VV_DSP_ERROR_INVALID_SIZE;
+    ok &= vv_dsp_feature_store_writer_close(writer) == VV_DSP_OK;
+
+    vv_dsp_feature_store* store = NULL;
+    ok &= vv_dsp_feature_store_open(temp_filename, &store) == VV_DSP_OK;
+    vv_dsp_feature_store_info info;
+    ok &= ok && vv_dsp_feature_store_get_info(store, &info) == VV_DSP_OK && info.dim == dim && info.hop == 160 &&
+          info.sample_rate == 16000.0 && info.num_chunks == num_chunks && info.total_frames == 1341;
+    for (size_t c = 0; ok && c < num_chunks; c++) {
+        const char* key = NULL;
+        size_t n = 0;
+        ok &= vv_dsp_feature_store_chunk(store, c, &key, &n) == VV_DSP_OK && strcmp(key, keys[c]) == 0 &&
+              n == frames[c];
+        ok &= vv_dsp_feature_store_find(store, keys[c]) == c;
+
+        // A range from the middle, in place and aligned at frame 0
+        const size_t first = n / 3, count = n - n / 3;
+        const vv_dsp_real* view = NULL;
+        ok &= vv_dsp_feature_store_frames(store, c, first, count, &view) == VV_DSP_OK;
+        for (size_t i = 0; ok && i < count * dim; i++) {
+            ok &= view[i] == (vv_dsp_real)(c * 100000 + first * dim + i);
+        }
+        ok &= vv_dsp_feature_store_frames(store, c, 0, 0, &view) == VV_DSP_OK && ((uintptr_t)view & 63) == 0;
+        ok &= vv_dsp_feature_store_frames(store, c, first, count + 1, &view) == VV_DSP_ERROR_OUT_OF_RANGE;
+    }
+    ok &= vv_dsp_feature_store_find(store, "utt/d") == num_chunks;
+
+    // As the backing source of a lazy spectrogram
+    vv_dsp_feature_store_source source = { store, 3 };
+    vv_dsp_real rows[10 * 13];
+    ok &= vv_dsp_feature_store_fetch(&source, 20, 10, dim, rows) == 1 && rows[0] == (vv_dsp_real)(300000 + 20 * dim);
+    ok &= vv_dsp_feature_store_fetch(&source, 20, 10, dim + 1, rows) == 0;
+    ok &= vv_dsp_feature_store_fetch(&source, 1230, 10, dim, rows) == 0;
+    ok &= vv_dsp_feature_store_chunk(store, num_chunks, NULL, NULL) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_feature_store_close(store);
+
+    // A damaged magic is refused
+    FILE* fp = fopen(temp_filename, "r+b");
+    ok &= fp != NULL && fputc('X', fp) != EOF;
+    if (fp) fclose(fp);
+    store = NULL;
+    ok &= vv_dsp_feature_store_open(temp_filename, &store) == VV_DSP_ERROR_INVALID_SIZE && store == NULL;
+
+    // A binary16 store: half the bytes, widened exactly on read (quarter steps below 512)
+    vv_dsp_quant quant;
+    ok &= vv_dsp_quant_init(&quant, VV_DSP_STORAGE_F16, 0, 0) == VV_DSP_OK &&
+          vv_dsp_feature_store_writer_open_ex(temp_filename, dim, 160, 16000.0, &quant, &writer) == VV_DSP_OK;
+    for (size_t i = 0; i < 1234 * dim; i++) data[i] = (vv_dsp_real)(i % 2000) * (vv_dsp_real)0.25;
+    ok &= ok && vv_dsp_feature_store_write_chunk(writer, "half", data, 1234) == VV_DSP_OK &&
+          vv_dsp_feature_store_writer_close(writer) == VV_DSP_OK;
+    ok &= ok && vv_dsp_feature_store_open(temp_filename, &store) == VV_DSP_OK &&
+          vv_dsp_feature_store_get_info(store, &info) == VV_DSP_OK && info.storage == VV_DSP_STORAGE_F16 &&
+          info.total_frames == 1234;
+    const void* raw = NULL;
+    const vv_dsp_real* real_view = NULL;
+    uint16_t codes[10 * 13];
+    ok &= ok && vv_dsp_feature_store_frames(store, 0, 0, 1, &real_view) == VV_DSP_ERROR_UNSUPPORTED &&
+          vv_dsp_feature_store_frames_raw(store, 0, 20, 10, &raw) == VV_DSP_OK &&
+          vv_dsp_quant_encode(&quant, data + 20 * dim, 10 * dim, codes) == VV_DSP_OK &&
+          memcmp(raw, codes, sizeof(codes)) == 0;
+    vv_dsp_real* wide = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * 1234 * dim);
+    ok &= ok && wide && vv_dsp_feature_store_read(store, 0, 0, 1234, wide) == VV_DSP_OK &&
+          memcmp(wide, data, sizeof(vv_dsp_real) * 1234 * dim) == 0;
+    source.store = store;
+    source.chunk = 0;
+    ok &= ok && vv_dsp_feature_store_fetch(&source, 20, 10, dim, rows) == 1 && rows[0] == data[20 * dim];
+    vv_dsp_feature_store_close(store);
+    free(wide);
+
+    free(data);
+    remove(temp_filename);
+    if (!ok) {
+        printf("ERROR: Feature store mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: Feature store test passed\n");
+    return 1;
+}
+
+// Voicebank: oto.ini parsing (BOM, CR LF, empty alias, short and negative-cutoff
+// lines), alias lookup, segment bounds against a full decode and the LRU budget
+static int test_voicebank(void) {
+    printf("Testing voicebank...\n");
+
+    const char* dir = "/tmp/test_voicebank";
+    const char* wav_filename = "/tmp/test_voicebank/_a_ka.wav";
+    const char* oto_filename = "/tmp/test_voicebank/oto.ini";
+#if defined(_WIN32)
+    _mkdir(dir);
+#else
+    mkdir(dir, 0755);
+#endif
+
+    // 1 s of stereo at 8 kHz
+    const size_t num_samples = 8000;
+    vv_dsp_real* original[2];
+    for (int ch = 0; ch < 2; ch++) {
+        original[ch] = (vv_dsp_real*)malloc(sizeof(vv_dsp_real) * num_samples);
+        if (!original[ch]) return 0;
+    }
+    generate_sine_wave(original, 2, num_samples, TEST_FREQUENCY, 8000.0);
+    vv_dsp_wav_info format;
+    format.num_samples = num_samples;
+    format.num_channels = 2;
+    format.sample_rate = 8000.0;
+    format.bit_depth = 16;
+    format.is_float = 0;
+    if (vv_dsp_wav_write(wav_filename, (const vv_dsp_real* const*)original, &format) != VV_DSP_OK) {
+        printf("ERROR: Failed to write voicebank sample\n");
+        return 0;
+    }
+    FILE* fp = fopen(oto_filename, "wb");
+    if (!fp) return 0;
+    fputs("\xEF\xBB\xBF_a_ka.wav=a,100,50,200,30,10\r\n"
+          "\r\n"
+          "_a_ka.wav=ka,500,40,-250,60,-5\r\n"
+          "_a_ka.wav=,0\r\n", fp);
+    fclose(fp);
+
+    vv_dsp_real** whole = NULL;
+    vv_dsp_wav_info info;
+    vv_dsp_voicebank* vb = NULL;
+    int ok = vv_dsp_wav_read(wav_filename, &whole, &info) == VV_DSP_OK;
+    ok &= vv_dsp_voicebank_open(dir, 8000 * sizeof(vv_dsp_real), &vb) == VV_DSP_OK;
+    ok &= ok && vv_dsp_voicebank_count(vb) == 3;
+
+    vv_dsp_oto_entry e;
+    ok &= ok && vv_dsp_voicebank_entry(vb, 1, &e) == VV_DSP_OK && strcmp(e.filename, "_a_ka.wav") == 0 &&
+          strcmp(e.alias, "ka") == 0 && e.offset_ms == 500.0 && e.consonant_ms == 40.0 && e.cutoff_ms == -250.0 &&
+          e.preutterance_ms == 60.0 && e.overlap_ms == -5.0;
+    ok &= ok && vv_dsp_voicebank_entry(vb, 2, &e) == VV_DSP_OK && strcmp(e.alias, "_a_ka") == 0 &&
+          e.offset_ms == 0.0 && e.cutoff_ms == 0.0;
+    ok &= ok && vv_dsp_voicebank_find(vb, "ka") == 1 && vv_dsp_voicebank_find(vb, "a") == 0 &&
+          vv_dsp_voicebank_find(vb, "sa") == 3;
+
+    // [offset, end - cutoff), [offset, offset + |cutoff|) and the whole file
+    const size_t starts[3] = { 800, 4000, 0 };
+    const size_t lengths[3] = { 8000 - 800 - 1600, 2000, 8000 };
+    for (size_t i = 0; ok && i < 3; i++) {
+        vv_dsp_voicebank_segment seg;
+        ok &= vv_dsp_voicebank_acquire(vb, i, &seg) == VV_DSP_OK && seg.start_sample == starts[i] &&
+              seg.num_samples == lengths[i] && seg.sample_rate == 8000.0;
+        for (size_t k = 0; ok && k < seg.num_samples; k++) {
+            const vv_dsp_real mono = (whole[0][starts[i] + k] + whole[1][starts[i] + k]) * (vv_dsp_real)0.5;
+            ok &= fabs((double)(seg.samples[k] - mono)) < 1e-6;
+        }
+        vv_dsp_voicebank_release(vb, i);
+    }
+
+    // The budget holds one second: the full-file segment pushed out the others
+    vv_dsp_voicebank_stats stats;
+    ok &= ok && vv_dsp_voicebank_get_stats(vb, &stats) == VV_DSP_OK && stats.misses == 3 && stats.hits == 0 &&
+          stats.evictions == 2 && stats.cached_segments == 1 && stats.cached_bytes == 8000 * sizeof(vv_dsp_real);
+
+    // Pinned segments survive any budget; a re-acquire is a hit
+    vv_dsp_voicebank_segment a, b;
+    ok &= ok && vv_dsp_voicebank_acquire(vb, 2, &a) == VV_DSP_OK && vv_dsp_voicebank_acquire(vb, 0, &b) == VV_DSP_OK &&
+          vv_dsp_voicebank_acquire(vb, 1, &b) == VV_DSP_OK;
+    ok &= ok && vv_dsp_voicebank_get_stats(vb, &stats) == VV_DSP_OK && stats.hits == 1 && stats.misses == 5 &&
+          stats.cached_segments == 3;
+    vv_dsp_voicebank_release(vb, 0);
+    vv_dsp_voicebank_release(vb, 1);
+    vv_dsp_voicebank_release(vb, 2);
+    ok &= ok && vv_dsp_voicebank_get_stats(vb, &stats) == VV_DSP_OK && stats.cached_segments == 1;
+    ok &= ok && vv_dsp_voicebank_acquire(vb, 3, &a) == VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_voicebank_close(vb);
+    vv_dsp_wav_free_buffer(&whole, 2);
+    free(original[0]);
+    free(original[1]);
+    remove(wav_filename);
+    remove(oto_filename);
+    rmdir(dir);
+
+    if (!ok) {
+        printf("ERROR: Voicebank mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: Voicebank test passed\n");
+    return 1;
+}
+
+// .frq maps: round trip with the source hash, the on-disk layout and truncation
+static int test_frq(void) {
+    printf("Testing .frq files...\n");
+
+    const char* temp_filename = "/tmp/test_audio.frq";
+    double f0[300], amplitude[300];
+    for (size_t i = 0; i < 300; i++) {
+        f0[i] = i % 7 == 0 ? 0.0 : 100.0 + (double)i * 0.25;
+        amplitude[i] = (double)i * 3.5;
+    }
+    vv_dsp_frq map;
+    map.hop = 256;
+    map.average_f0 = 137.5;
+    map.source_hash = 0x0123456789ABCDEFull;
+    map.num_frames = 300;
+    map.f0 = f0;
+    map.amplitude = amplitude;
+    int ok = vv_dsp_frq_write(temp_filename, &map) == VV_DSP_OK;
+
+    vv_dsp_frq back;
+    ok &= ok && vv_dsp_frq_read(temp_filename, &back) == VV_DSP_OK && back.hop == 256 && back.average_f0 == 137.5 &&
+          back.source_hash == map.source_hash && back.num_frames == 300 &&
+          memcmp(back.f0, f0, sizeof(f0)) == 0 && memcmp(back.amplitude, amplitude, sizeof(amplitude)) == 0;
+    vv_dsp_frq_free(&back);
+
+    // 40-byte header, then interleaved F0 and amplitude
+    unsigned char bytes[56];
+    FILE* fp = fopen(temp_filename, "rb");
+    ok &= fp && fread(bytes, 1, sizeof(bytes), fp) == sizeof(bytes);
+    if (fp) fclose(fp);
+    double first_amp;
+    memcpy(&first_amp, bytes + 48, sizeof(first_amp));
+    ok &= memcmp(bytes, "FREQ0003", 8) == 0 && bytes[8] == 0 && bytes[9] == 1 && bytes[36] == 44 &&
+          bytes[37] == 1 && first_amp == 0.0;
+
+    uint64_t h1 = 0, h2 = 0;
+    ok &= vv_dsp_frq_file_hash(temp_filename, &h1) == VV_DSP_OK &&
+          vv_dsp_frq_file_hash(temp_filename, &h2) == VV_DSP_OK && h1 == h2 && h1 != 0;
+
+    // One frame short
+    map.num_frames = 299;
+    ok &= vv_dsp_frq_write(temp_filename, &map) == VV_DSP_OK;
+    fp = fopen(temp_filename, "r+b");
+    ok &= fp != NULL;
+    if (fp) {
+        fseek(fp, 36, SEEK_SET);
+        fputc(44, fp);  // claims 300
+        fclose(fp);
+    }
+    ok &= vv_dsp_frq_read(temp_filename, &back) == VV_DSP_ERROR_INVALID_SIZE && back.f0 == NULL;
+    ok &= vv_dsp_frq_file_hash(temp_filename, &h2) == VV_DSP_OK && h2 != h1;
+    remove(temp_filename);
+
+    if (!ok) {
+        printf("ERROR: .frq mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: .frq test passed\n");
+    return 1;
+}
+
+// Period of y[0, n) in samples: the autocorrelation peak over lags [min_lag, max_lag]
+static size_t psola_period(const vv_dsp_real* y, size_t n, size_t min_lag, size_t max_lag) {
+    size_t best = min_lag;
+    double best_r = -1e300;
+    for (size_t lag = min_lag; lag <= max_lag; lag++) {
+        double r = 0.0;
+        for (size_t t = 0; t + lag < n; t++) r += (double)y[t] * (double)y[t + lag];
+        r /= (double)(n - lag);
+        if (r > best_r) {
+            best_r = r;
+            best = lag;
+        }
+    }
+    return best;
+}
+
+static double psola_rms(const vv_dsp_real* y, size_t n) {
+    double e = 0.0;
+    for (size_t t = 0; t < n; t++) e += (double)y[t] * (double)y[t];
+    return sqrt(e / (double)n);
+}
+
+// Pitch marks and PSOLA rendering: marks on the peaks of a 150 Hz harmonic source,
+// the .pmk round trip, and notes that keep or change the pitch at the source level
+static int test_psola(void) {
+    printf("Testing PSOLA...\n");
+
+    enum { N = 16000, HOP = 256, FRAMES = N / HOP + 1, OUT = 6000 };
+    const double rate = 16000.0, f0 = 150.0, period = rate / f0;
+    const char* temp_filename = "/tmp/test_audio.pmk";
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(OUT * sizeof(vv_dsp_real));
+    vv_dsp_real* curve = (vv_dsp_real*)malloc(OUT * sizeof(vv_dsp_real));
+    double track[FRAMES];
+    int ok = x && y && curve;
+
+    // Low-level noise for the first ten frames, then harmonics 1-8 with 1/k amplitudes
+    uint32_t lcg = 12345u;
+    for (size_t t = 0; ok && t < N; t++) {
+        double v = 0.0;
+        if (t < 10 * HOP) {
+            lcg = lcg * 1664525u + 1013904223u;
+            v = 0.01 * ((double)(lcg >> 8) / 8388608.0 - 1.0);
+        } else {
+            for (int k = 1; k <= 8; k++) v += 0.3 / k * sin(2.0 * PI * f0 * k * (double)t / rate);
+        }
+        x[t] = (vv_dsp_real)v;
+    }
+    for (size_t i = 0; i < FRAMES; i++) track[i] = i < 10 ? 0.0 : f0;
+    vv_dsp_frq map;
+    memset(&map, 0, sizeof(map));
+    map.hop = HOP;
+    map.average_f0 = f0;
+    map.source_hash = 42;
+    map.num_frames = FRAMES;
+    map.f0 = track;
+    map.amplitude = track;
+
+    vv_dsp_pitch_marks marks, back;
+    memset(&marks, 0, sizeof(marks));
+    memset(&back, 0, sizeof(back));
+    ok = ok && vv_dsp_pitch_marks_compute(x, N, rate, &map, &marks) == VV_DSP_OK && marks.source_hash == 42;
+    size_t voiced = 0;
+    for (size_t i = 0; ok && i < marks.num_marks; i++) {
+        const vv_dsp_pitch_mark* m = &marks.marks[i];
+        ok = (i == 0 || m->position > marks.marks[i - 1].position) && m->position < N;
+        if (!ok || !m->voiced) continue;
+        // Voiced marks one period apart, each on the largest sample of its period
+        if (voiced++ > 0) ok = fabs((double)(m->position - marks.marks[i - 1].position) - period) <= 1.0;
+        for (size_t t = m->position > 40 ? m->position - 40 : 0; ok && t < m->position + 40 && t < N; t++) {
+            ok = x[t] <= x[m->position];
+        }
+    }
+    ok = ok && voiced > 120 && voiced < 135;
+
+    ok = ok && vv_dsp_pitch_marks_write(temp_filename, &marks) == VV_DSP_OK &&
+         vv_dsp_pitch_marks_read(temp_filename, &back) == VV_DSP_OK && back.sample_rate == rate &&
+         back.source_hash == 42 && back.num_marks == marks.num_marks;
+    for (size_t i = 0; ok && i < back.num_marks; i++) {
+        ok = back.marks[i].position == marks.marks[i].position && back.marks[i].period == marks.marks[i].period &&
+             (back.marks[i].voiced != 0) == (marks.marks[i].voiced != 0);
+    }
+    vv_dsp_pitch_marks_free(&back);
+    remove(temp_filename);
+
+    // An engine over a segment starting at sample 2000
+    vv_dsp_psola* ps = NULL;
+    ok = ok && vv_dsp_psola_create(x + 2000, N - 4000, 2000, &marks, &ps) == VV_DSP_OK &&
+         vv_dsp_psola_num_grains(ps) > 100;
+    const double source_rms = psola_rms(x + 6000, OUT);
+    const double targets[3] = { 0.0, 225.0, 100.0 };
+    for (int k = 0; ok && k < 3; k++) {
+        vv_dsp_psola_note note;
+        memset(&note, 0, sizeof(note));
+        note.source_start = 2000.0;
+        note.source_rate = 0.8;
+        note.target_f0 = targets[k];
+        memset(y, 0, OUT * sizeof(vv_dsp_real));
+        vv_dsp_alloc_stats a0, a1;
+        ok = vv_dsp_get_thread_alloc_stats(&a0) == VV_DSP_OK && vv_dsp_psola_render(ps, &note, y, OUT) == VV_DSP_OK &&
+             vv_dsp_get_thread_alloc_stats(&a1) == VV_DSP_OK && a1.allocations == a0.allocations;
+        // Shifted notes sample the source's falling 1/k envelope at new harmonics, so
+        // their level only stays near the source's
+        const double want = targets[k] > 0.0 ? rate / targets[k] : period;
+        const size_t got = ok ? psola_period(y + 500, OUT - 1000, 40, (size_t)(1.5 * want)) : 0;
+        const double level = ok ? psola_rms(y + 500, OUT - 1000) : 0.0;
+        if (ok && (fabs((double)got - want) > 1.5 || fabs(level / source_rms - 1.0) > 0.2)) {
+            printf("ERROR: PSOLA at %.0f Hz: period %zu (want %.1f), level %.3f\n", targets[k], got, want,
+                   level / source_rms);
+            ok = 0;
+        }
+
+        // A constant F0 curve renders the same note
+        if (ok && targets[k] > 0.0) {
+            for (size_t t = 0; t < OUT; t++) curve[t] = (vv_dsp_real)targets[k];
+            note.target_f0 = 0.0;
+            note.f0_curve = curve;
+            ok = vv_dsp_psola_render(ps, &note, y, OUT) == VV_DSP_OK;  // adds a second copy
+            const size_t again = ok ? psola_period(y + 500, OUT - 1000, 40, (size_t)(1.5 * want)) : 0;
+            ok = ok && again == got && fabs(psola_rms(y + 500, OUT - 1000) / level - 2.0) < 1e-3;
+        }
+    }
+
+    vv_dsp_psola_note bad;
+    memset(&bad, 0, sizeof(bad));
+    bad.source_rate = -1.0;
+    vv_dsp_psola* none = NULL;
+    ok = ok && vv_dsp_psola_render(ps, &bad, y, OUT) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_psola_render(ps, &bad, y, 0) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_psola_create(x, 0, 0, &marks, &none) == VV_DSP_ERROR_INVALID_SIZE && none == NULL;
+    vv_dsp_psola_destroy(ps);
+    vv_dsp_pitch_marks_free(&marks);
+    free(x);
+    free(y);
+    free(curve);
+
+    if (!ok) {
+        printf("ERROR: PSOLA mismatch\n");
+        return 0;
+    }
+    printf("SUCCESS: PSOLA test passed\n");
+    return 1;
+}
+
 int main(void) {
     printf("Starting WAV audio I/O tests...\n\n");
 
@@ -187,6 +939,41 @@ int main(void) {
         }
     }
 
+    total_tests++;
+    if (test_wav_reader()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_wav_mmap()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_wav_writer()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_feature_store()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_voicebank()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_frq()) {
+        tests_passed++;
+    }
+
+    total_tests++;
+    if (test_psola()) {
+        tests_passed++;
+    }
+
     printf("\nTest Results: %d/%d tests passed\n", tests_passed, total_tests);
 
     if (tests_passed == total_tests) {
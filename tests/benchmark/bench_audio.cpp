@@ -0,0 +1,157 @@
+/**
+ * @file bench_audio.cpp
+ * @brief Google Benchmark suite for vv-dsp WAV I/O
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+
+extern "C" {
+#include "vv_dsp/audio/wav.h"
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+static const size_t kFileFrames = 48000 * 4;
+
+// Stereo 48 kHz file of kFileFrames frames at bit_depth (32 = float); written once per format and run
+static std::string bench_wav(int bit_depth) {
+    static std::string written[33];
+    std::string& cached = written[bit_depth];
+    if (!cached.empty()) return cached;
+    const std::string path =
+        (std::filesystem::temp_directory_path() / ("vv_dsp_bench_" + std::to_string(bit_depth) + ".wav")).string();
+    std::vector<vv_dsp_real> left = vv_bench::noise(kFileFrames, 1), right = vv_bench::noise(kFileFrames, 2);
+    const vv_dsp_real* channels[2] = {left.data(), right.data()};
+    vv_dsp_wav_info info = {kFileFrames, 2, 48000.0, bit_depth, bit_depth == 32};
+    if (vv_dsp_wav_write(path.c_str(), channels, &info) == VV_DSP_OK) cached = path;
+    return cached;
+}
+
+static const char* format_label(int bit_depth) {
+    return bit_depth == 16 ? "pcm16" : (bit_depth == 24 ? "pcm24" : "float32");
+}
+
+// Whole file into planar buffers; range(0) = bit depth
+static void BM_WavRead(benchmark::State& state) {
+    const int bit_depth = (int)state.range(0);
+    const std::string path = bench_wav(bit_depth);
+    if (path.empty()) {
+        state.SkipWithError("Failed to write WAV file");
+        return;
+    }
+
+    for (auto _ : state) {
+        vv_dsp_real** buffer = nullptr;
+        vv_dsp_wav_info info;
+        if (!vv_bench::check(state, vv_dsp_wav_read(path.c_str(), &buffer, &info))) break;
+        benchmark::DoNotOptimize(buffer);
+        vv_dsp_wav_free_buffer(&buffer, info.num_channels);
+    }
+
+    vv_bench::set_throughput(state, 2 * kFileFrames, 2 * kFileFrames * (bit_depth / 8 + sizeof(vv_dsp_real)),
+                             format_label(bit_depth));
+}
+
+// Streaming reader, blocks of range(1) frames
+static void BM_WavReaderPlanar(benchmark::State& state) {
+    const int bit_depth = (int)state.range(0);
+    const size_t block = state.range(1);
+    const std::string path = bench_wav(bit_depth);
+    vv_dsp_wav_reader* reader = nullptr;
+    if (path.empty() || vv_dsp_wav_reader_open(path.c_str(), &reader) != VV_DSP_OK) {
+        state.SkipWithError("Failed to open WAV reader");
+        return;
+    }
+    std::vector<vv_dsp_real> left(block), right(block);
+    vv_dsp_real* channels[2] = {left.data(), right.data()};
+
+    size_t frames = 0;
+    for (auto _ : state) {
+        size_t got = 0;
+        if (!vv_bench::check(state, vv_dsp_wav_reader_read_planar(reader, channels, block, &got))) break;
+        if (got < block) {
+            // Wrap to keep every iteration a full block
+            if (!vv_bench::check(state, vv_dsp_wav_reader_seek(reader, 0))) break;
+            if (!vv_bench::check(state, vv_dsp_wav_reader_read_planar(reader, channels, block, &got))) break;
+        }
+        benchmark::DoNotOptimize(left.data());
+        frames += got;
+    }
+
+    vv_dsp_wav_reader_close(reader);
+    state.SetItemsProcessed(2 * frames);
+    state.SetBytesProcessed(2 * frames * (bit_depth / 8 + sizeof(vv_dsp_real)));
+    state.SetLabel(format_label(bit_depth));
+}
+
+// Memory-mapped decode of range(1) frames from rotating positions
+static void BM_WavMmapPlanar(benchmark::State& state) {
+    const int bit_depth = (int)state.range(0);
+    const size_t block = state.range(1);
+    const std::string path = bench_wav(bit_depth);
+    vv_dsp_wav_map* map = nullptr;
+    if (path.empty() || vv_dsp_wav_mmap_open(path.c_str(), &map) != VV_DSP_OK) {
+        state.SkipWithError("Failed to map WAV file");
+        return;
+    }
+    std::vector<vv_dsp_real> left(block), right(block);
+    vv_dsp_real* channels[2] = {left.data(), right.data()};
+
+    size_t pos = 0;
+    for (auto _ : state) {
+        size_t got = 0;
+        if (!vv_bench::check(state, vv_dsp_wav_mmap_read_planar(map, pos, channels, block, &got))) break;
+        benchmark::DoNotOptimize(left.data());
+        pos = pos + 2 * block <= kFileFrames ? pos + block : 0;
+    }
+
+    vv_dsp_wav_mmap_close(map);
+    vv_bench::set_throughput(state, 2 * block, 2 * block * (bit_depth / 8 + sizeof(vv_dsp_real)),
+                             format_label(bit_depth));
+}
+
+// Synchronous streaming writer, appends of range(1) frames until the file reaches kFileFrames
+static void BM_WavWriter(benchmark::State& state) {
+    const int bit_depth = (int)state.range(0);
+    const size_t block = state.range(1);
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "vv_dsp_bench_writer.wav").string();
+    std::vector<vv_dsp_real> left = vv_bench::noise(block, 1), right = vv_bench::noise(block, 2);
+    const vv_dsp_real* channels[2] = {left.data(), right.data()};
+    vv_dsp_wav_info format = {0, 2, 48000.0, bit_depth, bit_depth == 32};
+    vv_dsp_wav_writer_config config = {};
+    config.synchronous = 1;
+
+    vv_dsp_wav_writer* writer = nullptr;
+    size_t written = 0;
+    for (auto _ : state) {
+        if (!writer || written + block > kFileFrames) {
+            state.PauseTiming();
+            vv_dsp_wav_writer_close(writer);
+            writer = nullptr;
+            written = 0;
+            if (vv_dsp_wav_writer_open(path.c_str(), &format, &config, &writer) != VV_DSP_OK) {
+                state.SkipWithError("Failed to open WAV writer");
+                break;
+            }
+            state.ResumeTiming();
+        }
+        if (!vv_bench::check(state, vv_dsp_wav_writer_append_frames(writer, channels, block))) break;
+        written += block;
+    }
+
+    vv_dsp_wav_writer_close(writer);
+    std::remove(path.c_str());
+    vv_bench::set_throughput(state, 2 * block, 2 * block * (bit_depth / 8 + sizeof(vv_dsp_real)),
+                             format_label(bit_depth));
+}
+
+BENCHMARK(BM_WavRead)->Arg(16)->Arg(24)->Arg(32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WavReaderPlanar)->ArgsProduct({{16, 24, 32}, {256, 4096}});
+BENCHMARK(BM_WavMmapPlanar)->ArgsProduct({{16, 24, 32}, {256, 4096}});
+BENCHMARK(BM_WavWriter)->ArgsProduct({{16, 24, 32}, {256, 4096}});
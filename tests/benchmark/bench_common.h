@@ -0,0 +1,50 @@
+/**
+ * @file bench_common.h
+ * @brief Input generation and counters shared by the per-module Google Benchmark suites
+ */
+
+#ifndef VV_DSP_BENCH_COMMON_H
+#define VV_DSP_BENCH_COMMON_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+namespace vv_bench {
+
+// Precision of vv_dsp_real in this build; the float and double builds are two runs of the
+// same suite, told apart by this label (fixed-point paths label themselves q15 / q31)
+inline const char* precision() {
+    return sizeof(vv_dsp_real) == sizeof(double) ? "double" : "float";
+}
+
+// Uniform noise in [-1, 1) from a fixed seed, so every run sees the same input
+inline std::vector<vv_dsp_real> noise(size_t n, uint32_t seed = 42) {
+    std::mt19937 gen{seed};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::vector<vv_dsp_real> out(n);
+    for (auto& v : out) v = (vv_dsp_real)dist(gen);
+    return out;
+}
+
+// Stop the benchmark with an error when a timed call fails
+inline bool check(benchmark::State& state, int status) {
+    if (status != VV_DSP_OK) state.SkipWithError("vv-dsp call failed");
+    return status == VV_DSP_OK;
+}
+
+// items/s for items per iteration, bytes/s for the bytes read plus written per iteration
+inline void set_throughput(benchmark::State& state, int64_t items, int64_t bytes, const char* label) {
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.SetLabel(label);
+}
+
+} // namespace vv_bench
+
+#endif // VV_DSP_BENCH_COMMON_H
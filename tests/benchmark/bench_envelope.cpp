@@ -0,0 +1,128 @@
+/**
+ * @file bench_envelope.cpp
+ * @brief Google Benchmark suite for vv-dsp LPC and cepstrum analysis
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "bench_common.h"
+
+extern "C" {
+#include "vv_dsp/envelope/cepstrum.h"
+#include "vv_dsp/envelope/lpc.h"
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+static const size_t kFrames = 64;
+
+// One frame of range(0) samples at order range(1)
+static void BM_Lpc(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t order = state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N), a(order + 1);
+    vv_dsp_real err = 0;
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_lpc(input.data(), N, order, a.data(), &err))) break;
+        benchmark::DoNotOptimize(a.data());
+    }
+
+    state.SetComplexityN(N * order);
+    vv_bench::set_throughput(state, N, (N + order + 1) * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// kFrames frames of range(0) samples at order range(1), one worker
+static void BM_LpcPlan(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t order = state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N * kFrames), a(kFrames * (order + 1));
+    vv_dsp_lpc_params params = {};
+    params.order = order;
+    params.frame_len = N;
+    params.num_threads = 1;
+    vv_dsp_lpc_plan* plan = nullptr;
+    if (vv_dsp_lpc_plan_create(&params, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create LPC plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_lpc_plan_process(plan, input.data(), kFrames, N, a.data(), nullptr,
+                                                            nullptr))) {
+            break;
+        }
+        benchmark::DoNotOptimize(a.data());
+    }
+
+    vv_dsp_lpc_plan_destroy(plan);
+    vv_bench::set_throughput(state, kFrames * N, kFrames * (N + order + 1) * sizeof(vv_dsp_real),
+                             vv_bench::precision());
+}
+
+// Envelopes of kFrames coefficient rows on range(0) FFT points
+static void BM_LpSpecBatch(benchmark::State& state) {
+    const size_t nfft = state.range(0);
+    const size_t order = state.range(1);
+    const size_t bins = nfft / 2 + 1;
+    std::vector<vv_dsp_real> a(kFrames * (order + 1)), mag(kFrames * bins);
+    for (size_t f = 0; f < kFrames; ++f) {
+        a[f * (order + 1)] = 1;
+        a[f * (order + 1) + 1] = (vv_dsp_real)-0.5;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_lpspec_batch(a.data(), order, nullptr, kFrames, nfft, mag.data()))) {
+            break;
+        }
+        benchmark::DoNotOptimize(mag.data());
+    }
+
+    vv_bench::set_throughput(state, kFrames * bins, kFrames * (order + 1 + bins) * sizeof(vv_dsp_real),
+                             vv_bench::precision());
+}
+
+// Real cepstra of kFrames frames of range(0) samples
+static void BM_CepstrumPlan(benchmark::State& state) {
+    const size_t N = state.range(0);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N * kFrames), cep(N * kFrames);
+    vv_dsp_cepstrum_plan* plan = nullptr;
+    if (vv_dsp_cepstrum_plan_create(N, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create cepstrum plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_cepstrum_plan_real(plan, input.data(), kFrames, cep.data()))) break;
+        benchmark::DoNotOptimize(cep.data());
+    }
+
+    vv_dsp_cepstrum_plan_destroy(plan);
+    vv_bench::set_throughput(state, kFrames * N, 2 * kFrames * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// Minimum-phase signals back from kFrames cepstra
+static void BM_CepstrumMinphase(benchmark::State& state) {
+    const size_t N = state.range(0);
+    std::vector<vv_dsp_real> cep = vv_bench::noise(N * kFrames), out(N * kFrames);
+    for (auto& c : cep) c *= (vv_dsp_real)0.01;
+    vv_dsp_cepstrum_plan* plan = nullptr;
+    if (vv_dsp_cepstrum_plan_create(N, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create cepstrum plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_cepstrum_plan_minphase(plan, cep.data(), kFrames, out.data()))) break;
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    vv_dsp_cepstrum_plan_destroy(plan);
+    vv_bench::set_throughput(state, kFrames * N, 2 * kFrames * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+BENCHMARK(BM_Lpc)->ArgsProduct({{256, 512, 1024, 2048}, {8, 16, 24, 48}})->Complexity();
+BENCHMARK(BM_LpcPlan)->ArgsProduct({{512, 1024}, {16, 24, 48}});
+BENCHMARK(BM_LpSpecBatch)->ArgsProduct({{512, 2048}, {16, 48}});
+BENCHMARK(BM_CepstrumPlan)->RangeMultiplier(2)->Range(256, 4096);
+BENCHMARK(BM_CepstrumMinphase)->RangeMultiplier(2)->Range(256, 4096);
@@ -0,0 +1,108 @@
+/**
+ * @file bench_features.cpp
+ * @brief Google Benchmark suite for the vv-dsp mel / MFCC path
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "bench_common.h"
+
+extern "C" {
+#include "vv_dsp/features/mel.h"
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+static const size_t kFrames = 64;
+static const vv_dsp_real kSampleRate = 16000;
+
+// Positive power spectra, kFrames frames of n_fft/2 + 1 bins
+static std::vector<vv_dsp_real> power_frames(size_t bins) {
+    std::vector<vv_dsp_real> power = vv_bench::noise(kFrames * bins);
+    for (auto& p : power) p = p * p + (vv_dsp_real)1e-3;
+    return power;
+}
+
+// range(0) = FFT size, range(1) = mel bands
+static void BM_LogMelSparse(benchmark::State& state) {
+    const size_t n_fft = state.range(0);
+    const size_t n_mels = state.range(1);
+    const size_t bins = n_fft / 2 + 1;
+    std::vector<vv_dsp_real> power = power_frames(bins), out(kFrames * n_mels);
+    vv_dsp_mel_sparse* fb = nullptr;
+    if (vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, kSampleRate, 0, kSampleRate / 2,
+                                            VV_DSP_MEL_VARIANT_HTK, &fb) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create mel filterbank");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_compute_log_mel_spectrogram_sparse(power.data(), kFrames, fb,
+                                                                              (vv_dsp_real)1e-10, out.data()))) {
+            break;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    vv_dsp_mel_sparse_destroy(fb);
+    vv_bench::set_throughput(state, kFrames, kFrames * (bins + n_mels) * sizeof(vv_dsp_real),
+                             vv_bench::precision());
+}
+
+// Dense filterbank product, the reference the sparse form is measured against
+static void BM_LogMelDense(benchmark::State& state) {
+    const size_t n_fft = state.range(0);
+    const size_t n_mels = state.range(1);
+    const size_t bins = n_fft / 2 + 1;
+    std::vector<vv_dsp_real> power = power_frames(bins), out(kFrames * n_mels);
+    vv_dsp_real* weights = nullptr;
+    size_t num_filters = 0, filter_len = 0;
+    if (vv_dsp_mel_filterbank_create(n_fft, n_mels, kSampleRate, 0, kSampleRate / 2, VV_DSP_MEL_VARIANT_HTK,
+                                     &weights, &num_filters, &filter_len) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create mel filterbank");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_compute_log_mel_spectrogram(power.data(), kFrames, bins, weights, n_mels,
+                                                                       (vv_dsp_real)1e-10, out.data()))) {
+            break;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    vv_dsp_mel_filterbank_free(weights, n_mels);
+    vv_bench::set_throughput(state, kFrames, kFrames * (bins + n_mels) * sizeof(vv_dsp_real),
+                             vv_bench::precision());
+}
+
+// range(2) = cepstral coefficients kept, range(3) = log accuracy (0 exact, 1 fast)
+static void BM_MfccProcess(benchmark::State& state) {
+    const size_t n_fft = state.range(0);
+    const size_t n_mels = state.range(1);
+    const size_t n_coeffs = state.range(2);
+    const size_t bins = n_fft / 2 + 1;
+    std::vector<vv_dsp_real> power = power_frames(bins), out(kFrames * n_coeffs);
+    vv_dsp_mfcc_plan* plan = nullptr;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, kSampleRate, 0, kSampleRate / 2, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22, (vv_dsp_real)1e-10, &plan) != VV_DSP_OK ||
+        vv_dsp_mfcc_set_log_accuracy(plan, (vv_dsp_log_accuracy)state.range(3)) != VV_DSP_OK) {
+        vv_dsp_mfcc_destroy(plan);
+        state.SkipWithError("Failed to create MFCC plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_mfcc_process(plan, power.data(), kFrames, out.data()))) break;
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    vv_dsp_mfcc_destroy(plan);
+    vv_bench::set_throughput(state, kFrames, kFrames * (bins + n_coeffs) * sizeof(vv_dsp_real),
+                             vv_bench::precision());
+}
+
+BENCHMARK(BM_LogMelSparse)->ArgsProduct({{256, 512, 2048}, {26, 40, 80, 128}});
+BENCHMARK(BM_LogMelDense)->ArgsProduct({{256, 512, 2048}, {26, 40, 80, 128}});
+BENCHMARK(BM_MfccProcess)->ArgsProduct({{256, 512, 2048}, {26, 40, 80}, {13, 20},
+                                        {VV_DSP_LOG_ACCURACY_EXACT, VV_DSP_LOG_ACCURACY_FAST}});
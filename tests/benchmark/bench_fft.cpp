@@ -214,6 +214,50 @@ static void BM_FFTBackendComparison(benchmark::State& state) {
 
 BENCHMARK(BM_FFTBackendComparison);
 
+// Built-in backend against FFTW in FFTW_ESTIMATE mode at the same size.
+// Arg 0 selects the backend (0 = KissFFT, 1 = FFTW); unavailable backends are skipped.
+static void BM_FFTKissVsFFTWEstimate(benchmark::State& state) {
+    const vv_dsp_fft_backend backend = state.range(0) == 0 ? VV_DSP_FFT_BACKEND_KISS : VV_DSP_FFT_BACKEND_FFTW;
+    const size_t N = static_cast<size_t>(state.range(1));
+    if (!vv_dsp_fft_is_backend_available(backend)) {
+        state.SkipWithError("Backend not available");
+        return;
+    }
+    const vv_dsp_fft_backend previous = vv_dsp_fft_get_backend();
+    (void)vv_dsp_fft_set_backend(backend);
+    if (backend == VV_DSP_FFT_BACKEND_FFTW) {
+        (void)vv_dsp_fft_set_fftw_flag(VV_DSP_FFTW_ESTIMATE);
+    }
+
+    std::vector<vv_dsp_cpx> input(N), output(N);
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<vv_dsp_real> dist{-1.0, 1.0};
+    for (auto& sample : input) {
+        sample.re = dist(gen);
+        sample.im = dist(gen);
+    }
+
+    vv_dsp_fft_plan* plan = nullptr;
+    if (vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) {
+        (void)vv_dsp_fft_set_backend(previous);
+        state.SkipWithError("Failed to create FFT plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        vv_dsp_fft_execute(plan, input.data(), output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_fft_destroy(plan);
+    (void)vv_dsp_fft_set_backend(previous);
+    state.SetItemsProcessed(state.iterations() * N);
+    state.SetLabel(backend == VV_DSP_FFT_BACKEND_KISS ? "Kiss" : "FFTW-estimate");
+}
+
+BENCHMARK(BM_FFTKissVsFFTWEstimate)
+    ->ArgsProduct({{0, 1}, {256, 1024, 4096, 441, 960}});
+
 // Memory throughput benchmark
 static void BM_FFTMemoryThroughput(benchmark::State& state) {
     const size_t N = state.range(0);
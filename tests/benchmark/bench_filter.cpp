@@ -0,0 +1,194 @@
+/**
+ * @file bench_filter.cpp
+ * @brief Google Benchmark suite for vv-dsp FIR and IIR filters
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "bench_common.h"
+
+extern "C" {
+#include "vv_dsp/core/fixed_point.h"
+#include "vv_dsp/filter/fir.h"
+#include "vv_dsp/filter/fixed.h"
+#include "vv_dsp/filter/iir.h"
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+// Streaming FIR over blocks of range(0) samples with range(1) taps
+static void BM_FirApply(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t taps = state.range(1);
+    std::vector<vv_dsp_real> coeffs(taps), output(N);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N);
+    vv_dsp_fir_state fir;
+    if (vv_dsp_fir_design_lowpass(coeffs.data(), taps, (vv_dsp_real)0.25, VV_DSP_WINDOW_HAMMING) != VV_DSP_OK ||
+        vv_dsp_fir_state_init(&fir, taps) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create FIR");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_fir_apply(&fir, coeffs.data(), input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_fir_state_free(&fir);
+    state.SetComplexityN(N * taps);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// Single-block linear convolution through the FFT
+static void BM_FirApplyFFT(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t taps = state.range(1);
+    std::vector<vv_dsp_real> coeffs(taps), output(N);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N);
+    vv_dsp_fir_state fir;
+    if (vv_dsp_fir_design_lowpass(coeffs.data(), taps, (vv_dsp_real)0.25, VV_DSP_WINDOW_HAMMING) != VV_DSP_OK ||
+        vv_dsp_fir_state_init(&fir, taps) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create FIR");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_fir_apply_fft(&fir, coeffs.data(), input.data(), output.data(), N))) {
+            break;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_fir_state_free(&fir);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+static void BM_FirQ15(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t taps = state.range(1);
+    std::vector<vv_dsp_real> real_in = vv_bench::noise(N), real_taps = vv_bench::noise(taps, 7);
+    std::vector<vv_dsp_q15> coeffs(taps), input(N), output(N);
+    for (auto& c : real_taps) c /= (vv_dsp_real)taps;
+    vv_dsp_real_to_q15(real_taps.data(), coeffs.data(), taps);
+    vv_dsp_real_to_q15(real_in.data(), input.data(), N);
+    vv_dsp_fir_q15* fir = nullptr;
+    if (vv_dsp_fir_q15_create(coeffs.data(), taps, &fir) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create Q15 FIR");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_fir_q15_process(fir, input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_fir_q15_destroy(fir);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_q15), "q15");
+}
+
+static void BM_FirQ31(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t taps = state.range(1);
+    std::vector<vv_dsp_real> real_in = vv_bench::noise(N), real_taps = vv_bench::noise(taps, 7);
+    std::vector<vv_dsp_q31> coeffs(taps), input(N), output(N);
+    for (auto& c : real_taps) c /= (vv_dsp_real)taps;
+    vv_dsp_real_to_q31(real_taps.data(), coeffs.data(), taps);
+    vv_dsp_real_to_q31(real_in.data(), input.data(), N);
+    vv_dsp_fir_q31* fir = nullptr;
+    if (vv_dsp_fir_q31_create(coeffs.data(), taps, &fir) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create Q31 FIR");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_fir_q31_process(fir, input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_fir_q31_destroy(fir);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_q31), "q31");
+}
+
+// range(1) identical low-pass sections; stable for any cascade length
+static std::vector<vv_dsp_biquad> make_cascade(size_t stages) {
+    std::vector<vv_dsp_biquad> bq(stages);
+    for (auto& b : bq) {
+        (void)vv_dsp_biquad_init(&b, (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                 (vv_dsp_real)-0.5, (vv_dsp_real)0.1);
+    }
+    return bq;
+}
+
+static void BM_IirApply(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t stages = state.range(1);
+    std::vector<vv_dsp_biquad> bq = make_cascade(stages);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N), output(N);
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_iir_apply(bq.data(), stages, input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetComplexityN(N * stages);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// range(2) selects the realization (0 = cascade, 1 = block state-space)
+static void BM_IirPlan(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t stages = state.range(1);
+    const vv_dsp_iir_realization realization = (vv_dsp_iir_realization)state.range(2);
+    std::vector<vv_dsp_biquad> bq = make_cascade(stages);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N), output(N);
+    vv_dsp_iir_plan* plan = nullptr;
+    if (vv_dsp_iir_make_plan(bq.data(), stages, realization, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create IIR plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_iir_plan_apply(plan, input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_iir_plan_destroy(plan);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+static void BM_BiquadQ31(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t stages = state.range(1);
+    std::vector<vv_dsp_real> real_in = vv_bench::noise(N);
+    std::vector<vv_dsp_q31> input(N), output(N);
+    for (auto& v : real_in) v *= (vv_dsp_real)0.5;
+    vv_dsp_real_to_q31(real_in.data(), input.data(), N);
+    vv_dsp_biquad_q31* bq = nullptr;
+    if (vv_dsp_biquad_q31_create(stages, 1, &bq) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create Q31 biquad");
+        return;
+    }
+    for (size_t s = 0; s < stages; ++s) {
+        vv_dsp_biquad_q31_set_stage(bq, s, (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                    (vv_dsp_real)-0.5, (vv_dsp_real)0.1);
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_biquad_q31_process(bq, input.data(), output.data(), N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_biquad_q31_destroy(bq);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_q31), "q31");
+}
+
+// Block sizes of an audio callback up to an offline buffer, taps around the FFT crossover
+BENCHMARK(BM_FirApply)->ArgsProduct({{64, 512, 4096}, {8, 32, 128, 512}})->Complexity();
+BENCHMARK(BM_FirApplyFFT)->ArgsProduct({{512, 4096, 32768}, {32, 128, 512}});
+BENCHMARK(BM_FirQ15)->ArgsProduct({{64, 512, 4096}, {8, 32, 128}});
+BENCHMARK(BM_FirQ31)->ArgsProduct({{64, 512, 4096}, {8, 32, 128}});
+
+BENCHMARK(BM_IirApply)->ArgsProduct({{64, 512, 4096}, {1, 2, 4, 8}})->Complexity();
+BENCHMARK(BM_IirPlan)->ArgsProduct({{64, 512, 4096}, {1, 4, 8},
+                                    {VV_DSP_IIR_REALIZATION_CASCADE, VV_DSP_IIR_REALIZATION_BLOCK}});
+BENCHMARK(BM_BiquadQ31)->ArgsProduct({{64, 512, 4096}, {1, 4, 8}});
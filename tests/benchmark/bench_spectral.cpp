@@ -0,0 +1,128 @@
+/**
+ * @file bench_spectral.cpp
+ * @brief Google Benchmark suite for vv-dsp DCT, CZT and Hilbert transforms
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "bench_common.h"
+
+extern "C" {
+#include "vv_dsp/spectral/czt.h"
+#include "vv_dsp/spectral/dct.h"
+#include "vv_dsp/spectral/hilbert.h"
+#include "vv_dsp/vv_dsp_types.h"
+}
+
+// range(0) = length, range(1) = DCT type (2, 3 or 4)
+static void BM_DctExecute(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const vv_dsp_dct_type type = (vv_dsp_dct_type)state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N), output(N);
+    vv_dsp_dct_plan* plan = nullptr;
+    if (vv_dsp_dct_make_plan(N, type, VV_DSP_DCT_FORWARD, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create DCT plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_dct_execute(plan, input.data(), output.data()))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_dct_destroy(plan);
+    state.SetComplexityN(N);
+    vv_bench::set_throughput(state, N, 2 * N * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// range(1) frames of length range(0), as MFCC runs its DCT
+static void BM_DctBatch(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t frames = state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N * frames), output(N * frames);
+    vv_dsp_dct_plan* plan = nullptr;
+    if (vv_dsp_dct_make_plan(N, VV_DSP_DCT_II, VV_DSP_DCT_FORWARD, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create DCT plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_dct_execute_batch(plan, input.data(), output.data(), frames, N))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_dct_destroy(plan);
+    vv_bench::set_throughput(state, N * frames, 2 * N * frames * sizeof(vv_dsp_real), vv_bench::precision());
+}
+
+// range(0) inputs zoomed onto range(1) bins of the lower quarter band
+static void BM_CztExecute(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t M = state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N);
+    std::vector<vv_dsp_cpx> output(M);
+    vv_dsp_real Wr, Wi, Ar, Ai;
+    vv_dsp_czt_plan* plan = nullptr;
+    if (vv_dsp_czt_params_for_freq_range(0, (vv_dsp_real)0.125, M, 1, &Wr, &Wi, &Ar, &Ai) != VV_DSP_OK ||
+        vv_dsp_czt_plan_create(N, M, Wr, Wi, Ar, Ai, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create CZT plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_czt_plan_execute_real(plan, input.data(), output.data()))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_czt_plan_destroy(plan);
+    vv_bench::set_throughput(state, N, N * sizeof(vv_dsp_real) + M * sizeof(vv_dsp_cpx), vv_bench::precision());
+}
+
+static void BM_HilbertPlan(benchmark::State& state) {
+    const size_t N = state.range(0);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N);
+    std::vector<vv_dsp_cpx> output(N);
+    vv_dsp_hilbert_plan* plan = nullptr;
+    if (vv_dsp_hilbert_plan_create(N, &plan) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create Hilbert plan");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_hilbert_plan_execute(plan, input.data(), output.data()))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_hilbert_plan_destroy(plan);
+    state.SetComplexityN(N);
+    vv_bench::set_throughput(state, N, N * (sizeof(vv_dsp_real) + sizeof(vv_dsp_cpx)), vv_bench::precision());
+}
+
+// Streaming FIR Hilbert transformer, range(1) taps
+static void BM_HilbertFir(benchmark::State& state) {
+    const size_t N = state.range(0);
+    const size_t taps = state.range(1);
+    std::vector<vv_dsp_real> input = vv_bench::noise(N);
+    std::vector<vv_dsp_cpx> output(N);
+    vv_dsp_hilbert_fir* h = nullptr;
+    if (vv_dsp_hilbert_fir_create(taps, &h) != VV_DSP_OK) {
+        state.SkipWithError("Failed to create Hilbert FIR");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (!vv_bench::check(state, vv_dsp_hilbert_fir_process(h, input.data(), N, output.data()))) break;
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    vv_dsp_hilbert_fir_destroy(h);
+    vv_bench::set_throughput(state, N, N * (sizeof(vv_dsp_real) + sizeof(vv_dsp_cpx)), vv_bench::precision());
+}
+
+BENCHMARK(BM_DctExecute)->ArgsProduct({benchmark::CreateRange(16, 4096, 4),
+                                       {VV_DSP_DCT_II, VV_DSP_DCT_III, VV_DSP_DCT_IV}});
+BENCHMARK(BM_DctBatch)->ArgsProduct({{13, 26, 40, 64}, {1, 64, 512}});
+BENCHMARK(BM_CztExecute)->ArgsProduct({{256, 1024, 4096}, {64, 512}});
+BENCHMARK(BM_HilbertPlan)->Range(64, 16384)->Complexity();
+BENCHMARK(BM_HilbertFir)->ArgsProduct({{256, 4096}, {31, 63, 127}});
@@ -79,12 +79,47 @@ static void BM_WindowKaiser(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * N);
 }
 
+static void BM_WindowTukey(benchmark::State& state) {
+    const size_t N = state.range(0);
+    std::vector<vv_dsp_real> window(N);
+    const vv_dsp_real alpha = 0.5;
+
+    for (auto _ : state) {
+        vv_dsp_window_tukey(N, alpha, window.data());
+        benchmark::DoNotOptimize(window.data());
+    }
+
+    state.SetComplexityN(N);
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_WindowFlattop(benchmark::State& state) {
+    const size_t N = state.range(0);
+    std::vector<vv_dsp_real> window(N);
+
+    for (auto _ : state) {
+        vv_dsp_window_flattop(N, window.data());
+        benchmark::DoNotOptimize(window.data());
+    }
+
+    state.SetComplexityN(N);
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
 // Register benchmarks with range of window sizes
 BENCHMARK(BM_WindowHann)->Range(64, 8192)->Complexity();
 BENCHMARK(BM_WindowHamming)->Range(64, 8192)->Complexity();
 BENCHMARK(BM_WindowBlackman)->Range(64, 8192)->Complexity();
 BENCHMARK(BM_WindowBoxcar)->Range(64, 8192)->Complexity();
 BENCHMARK(BM_WindowKaiser)->Range(64, 8192)->Complexity();
+BENCHMARK(BM_WindowTukey)->Range(64, 8192)->Complexity();
+BENCHMARK(BM_WindowFlattop)->Range(64, 8192)->Complexity();
+
+// Long tapers over million-sample segments, where generation cost shows up at startup
+BENCHMARK(BM_WindowKaiser)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WindowTukey)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WindowFlattop)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WindowBlackman)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
 
 // Benchmark comparing different window types at fixed size
 static void BM_WindowComparison_Hann(benchmark::State& state) {
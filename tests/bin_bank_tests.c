@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+// Direct double-precision DFT at a (possibly fractional) bin position
+static void ref_bin(const vv_dsp_real* x, size_t n, double f, double* re, double* im) {
+    double sr = 0.0, si = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        const double ang = -2.0 * VV_DSP_PI_D * f * (double)j / (double)n;
+        sr += (double)x[j] * cos(ang);
+        si += (double)x[j] * sin(ang);
+    }
+    *re = sr; *im = si;
+}
+
+static int check_bins(const vv_dsp_real* x, size_t n, const vv_dsp_real* bins, size_t nb, const vv_dsp_cpx* X) {
+    const double tol = 1e-5 * (double)n;
+    for (size_t b = 0; b < nb; ++b) {
+        double re, im;
+        ref_bin(x, n, (double)bins[b], &re, &im);
+        if (fabs((double)X[b].re - re) > tol || fabs((double)X[b].im - im) > tol) {
+            fprintf(stderr, "bin %g: got (%g,%g) want (%g,%g)\n", (double)bins[b], (double)X[b].re, (double)X[b].im, re, im);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Every method agrees with the direct DFT for whole blocks and for streamed input
+static int test_methods(size_t n, size_t nb) {
+    const vv_dsp_bin_bank_method methods[] = {VV_DSP_BIN_BANK_AUTO, VV_DSP_BIN_BANK_GOERTZEL,
+                                              VV_DSP_BIN_BANK_GOERTZEL_SIMD, VV_DSP_BIN_BANK_PRUNED_FFT};
+    const size_t blocks = 3;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * blocks * sizeof(vv_dsp_real));
+    vv_dsp_real* bins = (vv_dsp_real*)malloc(nb * sizeof(vv_dsp_real));
+    vv_dsp_cpx* X = (vv_dsp_cpx*)malloc(nb * blocks * sizeof(vv_dsp_cpx));
+    if (!x || !bins || !X) { free(x); free(bins); free(X); return 0; }
+    for (size_t i = 0; i < n * blocks; ++i) {
+        x[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.3 * cos(1.3 * (double)i) + 0.01 * (double)(i % 7));
+    }
+    for (size_t b = 0; b < nb; ++b) bins[b] = (vv_dsp_real)((b * 97 + 3) % n);
+
+    int ok = 1;
+    for (size_t mi = 0; ok && mi < 4; ++mi) {
+        vv_dsp_bin_bank_plan* p = NULL;
+        if (vv_dsp_bin_bank_make_plan(n, bins, nb, methods[mi], &p) != VV_DSP_OK) { ok = 0; break; }
+        if (vv_dsp_bin_bank_get_method(p) == VV_DSP_BIN_BANK_AUTO) ok = 0;
+        if (ok && (vv_dsp_bin_bank_execute(p, x, X) != VV_DSP_OK || !check_bins(x, n, bins, nb, X))) ok = 0;
+
+        // Stream the three blocks in uneven chunks
+        size_t done = 0, frames = 0;
+        const size_t chunks[] = {1, n / 3 + 1, n, 2 * n};
+        for (size_t c = 0; ok && done < n * blocks; ++c) {
+            size_t len = chunks[c % 4];
+            if (len > n * blocks - done) len = n * blocks - done;
+            size_t got = 0;
+            if (vv_dsp_bin_bank_process(p, x + done, len, X + frames * nb, blocks - frames, &got) != VV_DSP_OK) ok = 0;
+            frames += got;
+            done += len;
+        }
+        if (frames != blocks) ok = 0;
+        for (size_t f = 0; ok && f < blocks; ++f) {
+            if (!check_bins(x + f * n, n, bins, nb, X + f * nb)) ok = 0;
+        }
+        vv_dsp_bin_bank_destroy(p);
+    }
+    free(x); free(bins); free(X);
+    return ok;
+}
+
+static int test_fractional_and_errors(void) {
+    enum { N = 256 };
+    vv_dsp_real x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)sin(2.0 * VV_DSP_PI_D * 10.25 * (double)i / N);
+    const vv_dsp_real bins[] = {10.25f, 0.5f, 200.75f, 3.0f, 255.0f};
+    vv_dsp_cpx X[5];
+    vv_dsp_bin_bank_plan* p = NULL;
+    if (vv_dsp_bin_bank_make_plan(N, bins, 5, VV_DSP_BIN_BANK_AUTO, &p) != VV_DSP_OK) return 0;
+    if (vv_dsp_bin_bank_get_method(p) == VV_DSP_BIN_BANK_PRUNED_FFT) return 0;
+    int ok = vv_dsp_bin_bank_execute(p, x, X) == VV_DSP_OK && check_bins(x, N, bins, 5, X);
+    // Tone at exactly bin 10.25 has magnitude N/2, up to leakage from its negative image
+    if (ok && fabs(sqrt((double)X[0].re * (double)X[0].re + (double)X[0].im * (double)X[0].im) - N / 2.0) > 3.0) ok = 0;
+    // Too many frames for the output: nothing consumed
+    size_t got = 7;
+    if (vv_dsp_bin_bank_process(p, x, N, X, 0, &got) != VV_DSP_ERROR_INVALID_SIZE || got != 0) ok = 0;
+    vv_dsp_bin_bank_destroy(p);
+
+    // Hz helper: 1 kHz at 8 kHz with n = 256 is bin 32
+    const vv_dsp_real hz = 1000.0f;
+    if (vv_dsp_bin_bank_make_plan_hz(N, &hz, 1, 8000.0f, VV_DSP_BIN_BANK_PRUNED_FFT, &p) != VV_DSP_OK) return 0;
+    vv_dsp_bin_bank_destroy(p);
+    if (vv_dsp_bin_bank_make_plan(N, bins, 5, VV_DSP_BIN_BANK_PRUNED_FFT, &p) != VV_DSP_ERROR_OUT_OF_RANGE) ok = 0;
+    if (vv_dsp_bin_bank_make_plan(0, bins, 5, VV_DSP_BIN_BANK_AUTO, &p) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+    return ok;
+}
+
+int main(void) {
+    if (!test_methods(4096, 5)) { fprintf(stderr, "bin bank 4096/5 failed\n"); return 1; }
+    if (!test_methods(4096, 50)) { fprintf(stderr, "bin bank 4096/50 failed\n"); return 1; }
+    if (!test_methods(1000, 13)) { fprintf(stderr, "bin bank 1000/13 failed\n"); return 1; }
+    if (!test_methods(97, 3)) { fprintf(stderr, "bin bank 97/3 failed\n"); return 1; }
+    if (!test_fractional_and_errors()) { fprintf(stderr, "bin bank fractional/errors failed\n"); return 1; }
+    printf("bin bank tests passed\n");
+    return 0;
+}
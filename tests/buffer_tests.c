@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define CH 3
+#define FRAMES 1000
+
+static vv_dsp_real sample(size_t c, size_t f) {
+    return (vv_dsp_real)(sin(0.013 * (double)(f + 1) * (double)(c + 1)) + 0.1 * (double)c);
+}
+
+static void fill(vv_dsp_buffer* b) {
+    for (size_t c = 0; c < b->channels; ++c) {
+        for (size_t f = 0; f < b->frames; ++f) b->data[c * b->channel_stride + f * b->frame_stride] = sample(c, f);
+    }
+}
+
+// Same samples whatever the layouts
+static int same(const vv_dsp_buffer* a, const vv_dsp_buffer* b, double tol) {
+    if (a->channels != b->channels || a->frames != b->frames) return 0;
+    for (size_t c = 0; c < a->channels; ++c) {
+        for (size_t f = 0; f < a->frames; ++f) {
+            const double d = (double)a->data[c * a->channel_stride + f * a->frame_stride] -
+                             (double)b->data[c * b->channel_stride + f * b->frame_stride];
+            if (fabs(d) > tol) return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_views(void) {
+    static vv_dsp_real mem[CH * 64];
+    vv_dsp_buffer p, i, r;
+    int ok = vv_dsp_buffer_view_planar(mem, CH, 50, 64, &p) == VV_DSP_OK &&
+             vv_dsp_buffer_get_layout(&p) == VV_DSP_BUFFER_PLANAR && vv_dsp_buffer_channel(&p, 2) == mem + 128 &&
+             vv_dsp_buffer_channel(&p, 3) == NULL;
+    ok = ok && vv_dsp_buffer_view_planar(mem, CH, 50, 40, &p) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_buffer_view_interleaved(mem, 4, 16, &i) == VV_DSP_OK &&
+         vv_dsp_buffer_get_layout(&i) == VV_DSP_BUFFER_INTERLEAVED;
+    // Channels 1..2 of an interleaved stream: adjacent channels, wider frames
+    ok = ok && vv_dsp_buffer_view_range(&i, 1, 2, 3, 10, &r) == VV_DSP_OK && r.data == mem + 13 &&
+         r.frame_stride == 4 && vv_dsp_buffer_get_layout(&r) == VV_DSP_BUFFER_STRIDED;
+    ok = ok && vv_dsp_buffer_view_range(&i, 3, 2, 0, 1, &r) == VV_DSP_ERROR_OUT_OF_RANGE;
+
+    vv_dsp_buffer a;
+    ok = ok && vv_dsp_buffer_create(CH, 33, VV_DSP_BUFFER_PLANAR, &a) == VV_DSP_OK;
+    for (size_t c = 0; ok && c < CH; ++c) ok = vv_dsp_is_simd_aligned(vv_dsp_buffer_channel(&a, c));
+    vv_dsp_buffer_free(&a);
+    return ok && a.data == NULL;
+}
+
+// Layout conversion, per-channel gain and a mix matrix agree across layouts
+static int test_copy_gain_mix(void) {
+    vv_dsp_buffer p, i, s, mp, mi;
+    int ok = vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_PLANAR, &p) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_INTERLEAVED, &i) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH + 2, FRAMES, VV_DSP_BUFFER_INTERLEAVED, &s) == VV_DSP_OK &&
+             vv_dsp_buffer_create(2, FRAMES, VV_DSP_BUFFER_PLANAR, &mp) == VV_DSP_OK &&
+             vv_dsp_buffer_create(2, FRAMES, VV_DSP_BUFFER_INTERLEAVED, &mi) == VV_DSP_OK;
+    if (ok) {
+        fill(&p);
+        ok = vv_dsp_buffer_copy(&p, &i) == VV_DSP_OK && same(&p, &i, 0);
+        // Into channels 1..3 of a five-channel stream (strided), and back
+        vv_dsp_buffer r;
+        ok = ok && vv_dsp_buffer_view_range(&s, 1, CH, 0, FRAMES, &r) == VV_DSP_OK &&
+             vv_dsp_buffer_copy(&i, &r) == VV_DSP_OK && same(&p, &r, 0) && s.data[0] == 0;
+        const vv_dsp_real gains[CH] = {(vv_dsp_real)0.5, 2, -1};
+        ok = ok && vv_dsp_buffer_gain(&p, gains, 0) == VV_DSP_OK && vv_dsp_buffer_gain(&i, gains, 0) == VV_DSP_OK &&
+             vv_dsp_buffer_gain(&r, gains, 0) == VV_DSP_OK && same(&p, &i, 0) && same(&p, &r, 0);
+        ok = ok && fabs((double)p.data[p.channel_stride] - 2.0 * (double)sample(1, 0)) < 1e-6;
+        const vv_dsp_real m[2 * CH] = {1, (vv_dsp_real)0.5, 0, 0, (vv_dsp_real)0.5, 1};
+        ok = ok && vv_dsp_buffer_mix(&p, m, &mp, 0) == VV_DSP_OK && vv_dsp_buffer_mix(&i, m, &mi, 0) == VV_DSP_OK &&
+             same(&mp, &mi, 1e-5);
+        ok = ok && vv_dsp_buffer_mix(&i, m, &mi, 1) == VV_DSP_OK && vv_dsp_buffer_gain(&mp, NULL, 2) == VV_DSP_OK &&
+             same(&mp, &mi, 1e-5);
+        ok = ok && vv_dsp_buffer_clear(&r) == VV_DSP_OK && vv_dsp_buffer_copy(&p, &mp) == VV_DSP_ERROR_INVALID_SIZE;
+        for (size_t k = 0; ok && k < s.channels * s.frames; ++k) ok = s.data[k] == 0;
+    }
+    vv_dsp_buffer_free(&p);
+    vv_dsp_buffer_free(&i);
+    vv_dsp_buffer_free(&s);
+    vv_dsp_buffer_free(&mp);
+    vv_dsp_buffer_free(&mi);
+    return ok;
+}
+
+// Multichannel FIR in blocks equals one single-channel stream per channel
+static int test_fir(size_t taps, vv_dsp_buffer_layout layout) {
+    vv_dsp_real* h = (vv_dsp_real*)malloc(taps * sizeof(vv_dsp_real));
+    vv_dsp_fir_state st[CH], ref[CH];
+    memset(st, 0, sizeof(st));
+    memset(ref, 0, sizeof(ref));
+    vv_dsp_buffer in, out, expect;
+    int ok = h && vv_dsp_fir_design_lowpass(h, taps, (vv_dsp_real)0.4, VV_DSP_WINDOW_HAMMING) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, layout, &in) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, layout, &out) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_PLANAR, &expect) == VV_DSP_OK;
+    for (size_t c = 0; ok && c < CH; ++c) {
+        ok = vv_dsp_fir_state_init(&st[c], taps) == VV_DSP_OK && vv_dsp_fir_state_init(&ref[c], taps) == VV_DSP_OK;
+    }
+    if (ok) {
+        fill(&in);
+        for (size_t c = 0; ok && c < CH; ++c) {
+            vv_dsp_real x[FRAMES];
+            for (size_t f = 0; f < FRAMES; ++f) x[f] = sample(c, f);
+            ok = vv_dsp_fir_apply(&ref[c], h, x, vv_dsp_buffer_channel(&expect, c), FRAMES) == VV_DSP_OK;
+        }
+        const size_t blocks[3] = {1, 299, 700};
+        for (size_t k = 0, pos = 0; ok && k < 3; pos += blocks[k++]) {
+            vv_dsp_buffer bi, bo;
+            ok = vv_dsp_buffer_view_range(&in, 0, CH, pos, blocks[k], &bi) == VV_DSP_OK &&
+                 vv_dsp_buffer_view_range(&out, 0, CH, pos, blocks[k], &bo) == VV_DSP_OK &&
+                 vv_dsp_fir_apply_buffer(st, h, &bi, &bo) == VV_DSP_OK;
+        }
+        ok = ok && same(&out, &expect, 1e-4);
+        // In place continues the stream
+        ok = ok && vv_dsp_fir_apply_buffer(st, h, &in, &in) == VV_DSP_OK;
+    }
+    for (size_t c = 0; c < CH; ++c) {
+        vv_dsp_fir_state_free(&st[c]);
+        vv_dsp_fir_state_free(&ref[c]);
+    }
+    vv_dsp_buffer_free(&in);
+    vv_dsp_buffer_free(&out);
+    vv_dsp_buffer_free(&expect);
+    free(h);
+    return ok;
+}
+
+// A biquad bank gives the same output on planar and interleaved buffers
+static int test_bank(void) {
+    vv_dsp_biquad_bank* a = NULL;
+    vv_dsp_biquad_bank* b = NULL;
+    vv_dsp_buffer p, i;
+    int ok = vv_dsp_biquad_bank_create(CH, 2, &a) == VV_DSP_OK && vv_dsp_biquad_bank_create(CH, 2, &b) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_PLANAR, &p) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_INTERLEAVED, &i) == VV_DSP_OK;
+    for (size_t s = 0; ok && s < 2; ++s) {
+        ok = vv_dsp_biquad_bank_set_stage(a, s, (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                          (vv_dsp_real)-0.6, (vv_dsp_real)0.2) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_set_stage(b, s, (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                          (vv_dsp_real)-0.6, (vv_dsp_real)0.2) == VV_DSP_OK;
+    }
+    ok = ok && vv_dsp_biquad_bank_set_channel_stage(a, 1, 0, 1, -1, 0, (vv_dsp_real)-0.9, 0) == VV_DSP_OK &&
+         vv_dsp_biquad_bank_set_channel_stage(b, 1, 0, 1, -1, 0, (vv_dsp_real)-0.9, 0) == VV_DSP_OK;
+    if (ok) {
+        fill(&p);
+        fill(&i);
+        ok = vv_dsp_biquad_bank_process_buffer(a, &p, &p) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_process_buffer(b, &i, &i) == VV_DSP_OK && same(&p, &i, 1e-5);
+        vv_dsp_buffer two;
+        ok = ok && vv_dsp_buffer_view_range(&i, 0, 2, 0, FRAMES, &two) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_process_buffer(a, &two, &two) == VV_DSP_ERROR_INVALID_SIZE;
+    }
+    vv_dsp_biquad_bank_destroy(a);
+    vv_dsp_biquad_bank_destroy(b);
+    vv_dsp_buffer_free(&p);
+    vv_dsp_buffer_free(&i);
+    return ok;
+}
+
+// Multichannel resampler on planar buffers matches its interleaved path
+static int test_resampler(void) {
+    vv_dsp_resampler_mc* a = vv_dsp_resampler_mc_create(3, 2, CH);
+    vv_dsp_resampler_mc* b = vv_dsp_resampler_mc_create(3, 2, CH);
+    vv_dsp_buffer in, out, ii, io;
+    int ok = a && b && vv_dsp_resampler_mc_set_quality(a, 1, 16) == VV_DSP_OK &&
+             vv_dsp_resampler_mc_set_quality(b, 1, 16) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_PLANAR, &in) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, 2 * FRAMES, VV_DSP_BUFFER_PLANAR, &out) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, FRAMES, VV_DSP_BUFFER_INTERLEAVED, &ii) == VV_DSP_OK &&
+             vv_dsp_buffer_create(CH, 2 * FRAMES, VV_DSP_BUFFER_INTERLEAVED, &io) == VV_DSP_OK;
+    if (ok) {
+        fill(&in);
+        fill(&ii);
+        size_t na = 0, nb = 0, fa = 0, fb = 0;
+        ok = vv_dsp_resampler_mc_process_buffer(a, &in, &out, &na) == VV_DSP_OK &&
+             vv_dsp_resampler_mc_process_interleaved(b, ii.data, FRAMES, io.data, 2 * FRAMES, &nb) == VV_DSP_OK &&
+             na == nb && na > FRAMES;
+        vv_dsp_buffer ta, tb;
+        ok = ok && vv_dsp_buffer_view_range(&out, 0, CH, na, 2 * FRAMES - na, &ta) == VV_DSP_OK &&
+             vv_dsp_buffer_view_range(&io, 0, CH, nb, 2 * FRAMES - nb, &tb) == VV_DSP_OK &&
+             vv_dsp_resampler_mc_flush_buffer(a, &ta, &fa) == VV_DSP_OK &&
+             vv_dsp_resampler_mc_flush_buffer(b, &tb, &fb) == VV_DSP_OK && fa == fb;
+        vv_dsp_buffer ra, rb;
+        ok = ok && vv_dsp_buffer_view_range(&out, 0, CH, 0, na + fa, &ra) == VV_DSP_OK &&
+             vv_dsp_buffer_view_range(&io, 0, CH, 0, nb + fb, &rb) == VV_DSP_OK && same(&ra, &rb, 1e-6);
+    }
+    vv_dsp_resampler_mc_destroy(a);
+    vv_dsp_resampler_mc_destroy(b);
+    vv_dsp_buffer_free(&in);
+    vv_dsp_buffer_free(&out);
+    vv_dsp_buffer_free(&ii);
+    vv_dsp_buffer_free(&io);
+    return ok;
+}
+
+int main(void) {
+    if (!test_views()) { fprintf(stderr, "buffer view test failed\n"); return 1; }
+    if (!test_copy_gain_mix()) { fprintf(stderr, "buffer copy/gain/mix test failed\n"); return 1; }
+    const size_t long_taps = 2 * vv_dsp_conv_get_crossover() + 3;
+    for (int l = 0; l < 2; ++l) {
+        const vv_dsp_buffer_layout layout = l ? VV_DSP_BUFFER_INTERLEAVED : VV_DSP_BUFFER_PLANAR;
+        if (!test_fir(15, layout) || !test_fir(long_taps, layout)) {
+            fprintf(stderr, "multichannel FIR test failed (layout %d)\n", l);
+            return 1;
+        }
+    }
+    if (!test_bank()) { fprintf(stderr, "biquad bank buffer test failed\n"); return 1; }
+    if (!test_resampler()) { fprintf(stderr, "multichannel resampler buffer test failed\n"); return 1; }
+    printf("buffer tests passed\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, HOP = 80, LEN = SR / 2 };
+
+// Pulse train at 200 Hz through the tilt filter 1 - 0.5 z^-1
+static void make_signal(vv_dsp_real* x) {
+    for (size_t i = 0; i < LEN; ++i) {
+        x[i] = (vv_dsp_real)((i % 80) == 0 ? 1.0 : ((i % 80) == 1 ? -0.5 : 0.0));
+    }
+}
+
+static int test_shape(void) {
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_cheaptrick_params p = { (vv_dsp_real)SR, 0, 0, VV_DSP_CHEAPTRICK_DEFAULT_Q1, 1 };
+    vv_dsp_cheaptrick_plan* plan = NULL;
+    int ok = x && vv_dsp_cheaptrick_plan_create(&p, &plan) == VV_DSP_OK;
+    // 2^(1 + floor(log2(3 * 16000 / 71))) = 1024
+    ok = ok && vv_dsp_cheaptrick_fft_size(plan) == 1024;
+    // Second frame sits mid-signal, on a pulse
+    vv_dsp_real f0[2] = { 200.0f, 200.0f };
+    vv_dsp_real rows[2 * 513];
+    const vv_dsp_real* env = &rows[513];
+    if (ok) {
+        make_signal(x);
+        ok = vv_dsp_cheaptrick_process(plan, x, LEN, LEN / 2, f0, 2, rows) == VV_DSP_OK;
+    }
+    // Up to a constant, the envelope follows |H|^2 = |1 - 0.5 e^{-jw}|^2
+    double dev[513], mean = 0.0;
+    size_t count = 0;
+    for (size_t k = 0; ok && k < 513; ++k) {
+        const double w = 2.0 * 3.14159265358979 * (double)k / 1024.0;
+        const double h2 = 1.25 - cos(w);
+        if (!(env[k] > 0.0f)) ok = 0;
+        dev[count] = 10.0 * log10((double)env[k] / h2);
+        mean += dev[count++];
+    }
+    mean /= (double)(count ? count : 1);
+    for (size_t i = 0; ok && i < count; ++i) {
+        if (fabs(dev[i] - mean) > 0.5) {
+            fprintf(stderr, "envelope off by %.2f dB at bin %zu\n", dev[i] - mean, i);
+            ok = 0;
+        }
+    }
+    vv_dsp_cheaptrick_plan_destroy(plan);
+    free(x);
+    return ok;
+}
+
+// Threaded runs match the single-worker run exactly; unvoiced and edge frames stay finite
+static int test_threads(void) {
+    enum { FRAMES = LEN / HOP + 1 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real f0[FRAMES];
+    for (size_t f = 0; f < FRAMES; ++f) {
+        f0[f] = (vv_dsp_real)(120.0 + 2.0 * (double)f);
+        if (f % 10 == 0) f0[f] = 0.0f;     // unvoiced
+        if (f % 10 == 5) f0[f] = 30.0f;    // below the floor
+        if (f % 10 == 7) f0[f] = 9000.0f;  // above sample_rate / 4
+    }
+    vv_dsp_cheaptrick_params p = { (vv_dsp_real)SR, 0, 0, VV_DSP_CHEAPTRICK_DEFAULT_Q1, 1 };
+    vv_dsp_cheaptrick_plan* one = NULL;
+    vv_dsp_cheaptrick_plan* many = NULL;
+    int ok = x != NULL && vv_dsp_cheaptrick_plan_create(&p, &one) == VV_DSP_OK;
+    p.num_threads = 4;
+    ok = ok && vv_dsp_cheaptrick_plan_create(&p, &many) == VV_DSP_OK;
+    const size_t nb = vv_dsp_cheaptrick_fft_size(one) / 2 + 1;
+    vv_dsp_real* a = (vv_dsp_real*)malloc(FRAMES * nb * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(FRAMES * nb * sizeof(vv_dsp_real));
+    ok = ok && a && b;
+    if (ok) {
+        make_signal(x);
+        ok = vv_dsp_cheaptrick_process(one, x, LEN, HOP, f0, FRAMES, a) == VV_DSP_OK &&
+             vv_dsp_cheaptrick_process(many, x, LEN, HOP, f0, FRAMES, b) == VV_DSP_OK;
+    }
+    if (ok && memcmp(a, b, FRAMES * nb * sizeof(vv_dsp_real)) != 0) {
+        fprintf(stderr, "threaded envelopes differ\n");
+        ok = 0;
+    }
+    for (size_t i = 0; ok && i < FRAMES * nb; ++i) {
+        if (!(a[i] > 0.0f) || !isfinite(a[i])) {
+            fprintf(stderr, "bad envelope value at %zu: %g\n", i, (double)a[i]);
+            ok = 0;
+        }
+    }
+    vv_dsp_cheaptrick_plan_destroy(one);
+    vv_dsp_cheaptrick_plan_destroy(many);
+    free(x); free(a); free(b);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_cheaptrick_plan* plan = NULL;
+    vv_dsp_cheaptrick_params p = { (vv_dsp_real)SR, 0, 0, VV_DSP_CHEAPTRICK_DEFAULT_Q1, 1 };
+    int ok = vv_dsp_cheaptrick_plan_create(NULL, &plan) == VV_DSP_ERROR_NULL_POINTER;
+    p.fft_size = 256;  // shorter than the 71 Hz window
+    ok = ok && vv_dsp_cheaptrick_plan_create(&p, &plan) == VV_DSP_ERROR_INVALID_SIZE && plan == NULL;
+    p.fft_size = 0;
+    p.sample_rate = 0;
+    ok = ok && vv_dsp_cheaptrick_plan_create(&p, &plan) == VV_DSP_ERROR_OUT_OF_RANGE;
+    p.sample_rate = (vv_dsp_real)SR;
+    ok = ok && vv_dsp_cheaptrick_plan_create(&p, &plan) == VV_DSP_OK;
+    vv_dsp_real x[4] = { 0 }, f0[1] = { 100.0f }, env[1];
+    ok = ok && vv_dsp_cheaptrick_process(plan, x, 4, HOP, NULL, 1, env) == VV_DSP_ERROR_NULL_POINTER;
+    ok = ok && vv_dsp_cheaptrick_process(plan, x, 0, HOP, f0, 1, env) == VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_cheaptrick_plan_destroy(plan);
+    vv_dsp_cheaptrick_plan_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    if (!test_shape()) {
+        fprintf(stderr, "cheaptrick envelope shape failed\n");
+        return 1;
+    }
+    if (!test_threads()) {
+        fprintf(stderr, "cheaptrick threading failed\n");
+        return 1;
+    }
+    if (!test_errors()) {
+        fprintf(stderr, "cheaptrick error handling failed\n");
+        return 1;
+    }
+    printf("cheaptrick tests passed\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define N 1024
+
+static int test_check(void) {
+    vv_dsp_context c;
+    vv_dsp_context_init(&c);
+    if (vv_dsp_context_check(&c) != VV_DSP_OK || vv_dsp_context_check(NULL) != VV_DSP_OK) return 0;
+    c.nan_policy = 9;
+    if (vv_dsp_context_check(&c) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    vv_dsp_context_init(&c);
+    c.precision = (vv_dsp_precision_mode)7;
+    if (vv_dsp_context_check(&c) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+
+    // Invalid contexts are rejected by every creator
+    vv_dsp_mfcc_plan* mp = NULL;
+    vv_dsp_stft_params p = { .fft_size = 256, .hop_size = 64, .window = VV_DSP_STFT_WIN_HANN,
+                             .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft* st = NULL;
+    if (vv_dsp_mfcc_init_ctx(&c, 512, 40, 13, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II,
+                             22.0f, 1e-10f, &mp) != VV_DSP_ERROR_OUT_OF_RANGE || mp) return 0;
+    if (vv_dsp_stft_create_ctx(&c, &p, &st) != VV_DSP_ERROR_OUT_OF_RANGE || st) return 0;
+    if (vv_dsp_resampler_create_ctx(&c, 2, 1) != NULL) return 0;
+
+    // FFT backend: unknown index, or one not built in
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_context_init(&c);
+    c.fft_backend = 99;
+    if (vv_dsp_fft_make_plan_ctx(&c, 64, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    if (vv_dsp_stft_create_ctx(&c, &p, &st) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    if (!vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_FFTW)) {
+        c.fft_backend = VV_DSP_FFT_BACKEND_FFTW;
+        if (vv_dsp_fft_make_plan_ctx(&c, 64, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_ERROR_UNSUPPORTED)
+            return 0;
+    }
+    return 1;
+}
+
+// An explicitly captured backend and the current one give the same transform
+static int test_fft(const vv_dsp_real* x) {
+    vv_dsp_context c;
+    vv_dsp_context_init(&c);
+    c.fft_backend = VV_DSP_FFT_BACKEND_KISS;
+    vv_dsp_fft_plan *pc = NULL, *pd = NULL;
+    vv_dsp_cpx a[N / 2 + 1], b[N / 2 + 1];
+    if (vv_dsp_fft_make_plan_ctx(&c, N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &pc) != VV_DSP_OK ||
+        vv_dsp_fft_make_plan_ctx(NULL, N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &pd) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_fft_execute(pc, x, a) == VV_DSP_OK && vv_dsp_fft_execute(pd, x, b) == VV_DSP_OK;
+    for (size_t k = 0; ok && k < N / 2 + 1; ++k) {
+        ok = fabs((double)(a[k].re - b[k].re)) < 1e-3 && fabs((double)(a[k].im - b[k].im)) < 1e-3;
+    }
+    vv_dsp_fft_destroy(pc);
+    vv_dsp_fft_destroy(pd);
+    return ok && vv_dsp_fft_make_plan_ctx(&c, N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, NULL) == VV_DSP_ERROR_NULL_POINTER;
+}
+
+// The captured precision equals set_precision() on a default handle, and a default
+// context is the plain creator
+static int test_stft(const vv_dsp_real* x) {
+    vv_dsp_stft_params p = { .fft_size = 256, .hop_size = 64, .window = VV_DSP_STFT_WIN_HANN,
+                             .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_context c;
+    vv_dsp_context_init(&c);
+    c.precision = VV_DSP_PRECISION_FAST;
+    vv_dsp_threadpool_params tp;
+    memset(&tp, 0, sizeof(tp));
+    tp.num_threads = 2;
+    vv_dsp_stft *a = NULL, *b = NULL, *d = NULL;
+    int ok = vv_dsp_threadpool_create(&tp, &c.pool) == VV_DSP_OK && vv_dsp_stft_create_ctx(&c, &p, &a) == VV_DSP_OK &&
+             vv_dsp_stft_create(&p, &b) == VV_DSP_OK && vv_dsp_stft_set_precision(b, VV_DSP_PRECISION_FAST) == VV_DSP_OK &&
+             vv_dsp_stft_create_ctx(NULL, &p, &d) == VV_DSP_OK;
+    vv_dsp_spectrogram_opts o;
+    memset(&o, 0, sizeof(o));
+    o.scale = VV_DSP_SPECTROGRAM_DB;
+    o.floor = (vv_dsp_real)1e-8;
+    const size_t rows = ok ? vv_dsp_stft_spectrogram_frames(a, N) : 0;
+    const size_t len = rows * vv_dsp_stft_num_bins(a);
+    vv_dsp_real* ra = (vv_dsp_real*)malloc((len + 1) * sizeof(vv_dsp_real));
+    vv_dsp_real* rb = (vv_dsp_real*)malloc((len + 1) * sizeof(vv_dsp_real));
+    size_t fa = 0, fb = 0;
+    ok = ok && ra && rb && vv_dsp_stft_spectrogram_ex(a, x, N, &o, ra, &fa) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_ex(b, x, N, &o, rb, &fb) == VV_DSP_OK && fa == fb && fa == rows &&
+         memcmp(ra, rb, len * sizeof(vv_dsp_real)) == 0;
+    // The parallel spectrogram runs on the captured pool
+    ok = ok && vv_dsp_stft_spectrogram_parallel(a, x, N, &o, rb, &fb, 0) == VV_DSP_OK && fb == fa &&
+         memcmp(ra, rb, len * sizeof(vv_dsp_real)) == 0;
+    // A shared config hands the context to its handles
+    vv_dsp_stft_config* cfg = NULL;
+    vv_dsp_stft* h = NULL;
+    ok = ok && vv_dsp_stft_config_create_ctx(&c, &p, &cfg) == VV_DSP_OK &&
+         vv_dsp_stft_create_from_config(cfg, &h) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_ex(h, x, N, &o, rb, &fb) == VV_DSP_OK && memcmp(ra, rb, len * sizeof(vv_dsp_real)) == 0;
+    if (h) (void)vv_dsp_stft_destroy(h);
+    if (cfg) (void)vv_dsp_stft_config_release(cfg);
+    free(ra);
+    free(rb);
+    if (a) (void)vv_dsp_stft_destroy(a);
+    if (b) (void)vv_dsp_stft_destroy(b);
+    if (d) (void)vv_dsp_stft_destroy(d);
+    if (c.pool) vv_dsp_threadpool_destroy(c.pool);
+    return ok;
+}
+
+// A captured NaN policy wins over the calling thread's
+static int test_mfcc_nan_policy(void) {
+    enum { FRAMES = 4, BINS = 257, COEFFS = 13 };
+    vv_dsp_context c;
+    vv_dsp_context_init(&c);
+    c.nan_policy = VV_DSP_NAN_POLICY_ERROR;
+    vv_dsp_mfcc_plan *strict = NULL, *plain = NULL;
+    if (vv_dsp_mfcc_init_ctx(&c, 512, 40, COEFFS, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II,
+                             22.0f, 1e-10f, &strict) != VV_DSP_OK ||
+        vv_dsp_mfcc_init_ctx(NULL, 512, 40, COEFFS, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II,
+                             22.0f, 1e-10f, &plain) != VV_DSP_OK) return 0;
+    vv_dsp_real power[FRAMES * BINS], out[FRAMES * COEFFS];
+    for (size_t i = 0; i < FRAMES * BINS; ++i) power[i] = (vv_dsp_real)(1e-3 * (1.0 + (double)(i % 7)));
+    power[BINS + 3] = (vv_dsp_real)NAN;
+
+    const vv_dsp_nan_policy_e saved = vv_dsp_get_nan_policy();
+    vv_dsp_set_nan_policy(VV_DSP_NAN_POLICY_PROPAGATE);
+    int ok = vv_dsp_mfcc_process(strict, power, FRAMES, out) == VV_DSP_ERROR_NAN_INF &&
+             vv_dsp_mfcc_process_parallel(strict, power, FRAMES, out, 2) == VV_DSP_ERROR_NAN_INF &&
+             vv_dsp_mfcc_process(plain, power, FRAMES, out) == VV_DSP_OK;
+    vv_dsp_set_nan_policy(VV_DSP_NAN_POLICY_ERROR);
+    ok = ok && vv_dsp_mfcc_process(plain, power, FRAMES, out) == VV_DSP_ERROR_NAN_INF;
+    vv_dsp_set_nan_policy(saved);
+    vv_dsp_mfcc_destroy(strict);
+    vv_dsp_mfcc_destroy(plain);
+    return ok;
+}
+
+static int test_resampler(void) {
+    vv_dsp_context c;
+    vv_dsp_context_init(&c);
+    c.precision = VV_DSP_PRECISION_BALANCED;
+    vv_dsp_resampler* rs = vv_dsp_resampler_create_ctx(&c, 3, 2);
+    vv_dsp_resampler* rd = vv_dsp_resampler_create_ctx(NULL, 3, 2);
+    const int ok = rs && rd;
+    vv_dsp_resampler_destroy(rs);
+    vv_dsp_resampler_destroy(rd);
+    return ok && vv_dsp_resampler_create_ctx(&c, 0, 2) == NULL;
+}
+
+int main(void) {
+    vv_dsp_real x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.3 * cos(0.61 * (double)i));
+    if (!test_check()) { fprintf(stderr, "context validation test failed\n"); return 1; }
+    if (!test_fft(x)) { fprintf(stderr, "context FFT test failed\n"); return 1; }
+    if (!test_stft(x)) { fprintf(stderr, "context STFT test failed\n"); return 1; }
+    if (!test_mfcc_nan_policy()) { fprintf(stderr, "context MFCC NaN policy test failed\n"); return 1; }
+    if (!test_resampler()) { fprintf(stderr, "context resampler test failed\n"); return 1; }
+    printf("context tests passed\n");
+    return 0;
+}
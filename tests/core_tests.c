@@ -1,7 +1,15 @@
 #include <stdio.h>
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include "vv_dsp/vv_dsp.h"
 
+// Counting allocator over malloc, so blocks may cross back to the default one
+typedef struct { size_t allocs, frees; } alloc_counter;
+static void* count_alloc(size_t size, void* user) { ((alloc_counter*)user)->allocs++; return malloc(size); }
+static void* count_realloc(void* p, size_t size, void* user) { (void)user; return realloc(p, size); }
+static void count_free(void* p, void* user) { ((alloc_counter*)user)->frees++; free(p); }
+
 static int approx_equal(vv_dsp_real a, vv_dsp_real b) {
 #ifdef VV_DSP_USE_DOUBLE
     const vv_dsp_real eps = (vv_dsp_real)1e-9;
@@ -98,6 +106,260 @@ int main(void) {
         ok &= approx_equal(rcross[0], (vv_dsp_real)1);
     }
 
+    // --- Fused statistics: every field against the single-metric functions ---
+    {
+        enum { SN = 1037 };  // several blocks plus a ragged tail
+        static vv_dsp_real sx[SN];
+        unsigned seed = 12345u;
+        for (int i = 0; i < SN; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const double u = (double)(seed >> 8) / 16777216.0;
+            sx[i] = (vv_dsp_real)(3.0 + u * u * u * 4.0);  // offset, skewed
+        }
+        vv_dsp_stats st;
+        ok &= (vv_dsp_stats_all(sx, SN, &st, VV_DSP_STATS_ALL) == VV_DSP_OK);
+        vv_dsp_real e_mean, e_var, e_mn, e_mx, e_rms, e_cf;
+        ok &= (vv_dsp_mean(sx, SN, &e_mean) == VV_DSP_OK) && approx_equal(st.mean, e_mean);
+        ok &= (vv_dsp_var(sx, SN, &e_var) == VV_DSP_OK) && approx_equal(st.var, e_var);
+        ok &= (vv_dsp_peak(sx, SN, &e_mn, &e_mx) == VV_DSP_OK) && st.min == e_mn && st.max == e_mx;
+        ok &= (vv_dsp_rms(sx, SN, &e_rms) == VV_DSP_OK) && approx_equal(st.rms, e_rms);
+        ok &= approx_equal(st.crest, e_mx / e_rms);
+        ok &= (vv_dsp_crest_factor(sx, SN, &e_cf) == VV_DSP_OK) && e_cf == st.crest;
+
+        // Two-pass double-precision reference for the higher moments
+        double mu = 0.0, c2 = 0.0, c3 = 0.0, c4 = 0.0;
+        for (int i = 0; i < SN; ++i) mu += (double)sx[i];
+        mu /= SN;
+        for (int i = 0; i < SN; ++i) {
+            const double dd = (double)sx[i] - mu;
+            c2 += dd * dd; c3 += dd * dd * dd; c4 += dd * dd * dd * dd;
+        }
+        c2 /= SN; c3 /= SN; c4 /= SN;
+        ok &= approx_equal(st.skewness, (vv_dsp_real)(c3 / pow(c2, 1.5)));
+        ok &= approx_equal(st.kurtosis, (vv_dsp_real)(c4 / (c2 * c2) - 3.0));
+
+        // Only the selected fields are touched
+        vv_dsp_stats part;
+        ok &= (vv_dsp_stats_all(sx, SN, &part, VV_DSP_STATS_MAX | VV_DSP_STATS_VAR) == VV_DSP_OK);
+        ok &= part.max == st.max && approx_equal(part.var, st.var);
+        ok &= part.mean == 0 && part.min == 0 && part.rms == 0 && part.kurtosis == 0;
+
+        // Too few samples for the requested moment
+        ok &= (vv_dsp_stats_all(sx, 3, &part, VV_DSP_STATS_KURTOSIS | VV_DSP_STATS_MEAN) == VV_DSP_ERROR_INVALID_SIZE);
+        ok &= part.kurtosis == 0 && approx_equal(part.mean, (sx[0] + sx[1] + sx[2]) / 3);
+        ok &= (vv_dsp_stats_all(NULL, 3, &part, VV_DSP_STATS_ALL) == VV_DSP_ERROR_NULL_POINTER);
+    }
+
+    // --- Long correlations take the FFT path; compare with direct double sums ---
+    {
+        enum { CN = 3000, CM = 1700, CL = 1800 };
+        static vv_dsp_real cx[CN], cy[CM], ra[CL], rb[CL], rc[CL];
+        unsigned seed = 777u;
+        for (int i = 0; i < CN; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            cx[i] = (vv_dsp_real)((double)(seed >> 8) / 8388608.0 - 1.0 + sin(0.05 * i));
+        }
+        for (int i = 0; i < CM; ++i) cy[i] = cx[(i + 40) % CN];
+        ok &= (vv_dsp_autocorrelation(cx, CN, ra, CL, 1) == VV_DSP_OK);
+        ok &= (vv_dsp_autocorrelation(cx, CN, rb, CL, 0) == VV_DSP_OK);
+        ok &= (vv_dsp_cross_correlation(cx, CN, cy, CM, rc, CL) == VV_DSP_OK);
+        int corr_ok = 1;
+        for (int lag = 0; lag < CL; ++lag) {
+            double acc = 0.0, accx = 0.0;
+            for (int i = 0; i + lag < CN; ++i) acc += (double)cx[i] * (double)cx[i + lag];
+            const int cnt = (CM - lag < CN) ? CM - lag : CN;
+            for (int i = 0; i < cnt; ++i) accx += (double)cx[i] * (double)cy[i + lag];
+            const double wb = acc / CN, wu = acc / (CN - lag), wx = (cnt > 0) ? accx / cnt : 0.0;
+            // absolute error of the float transform scales with the lag-0 energy
+            corr_ok &= fabs((double)ra[lag] - wb) < 2e-4;
+            corr_ok &= fabs((double)rb[lag] - wu) < 2e-4 * (double)CN / (double)(CN - lag);
+            corr_ok &= (lag >= CM) ? rc[lag] == 0 : fabs((double)rc[lag] - wx) < 2e-4 * (double)CN / (double)cnt;
+        }
+        ok &= corr_ok;
+        // A short lag range stays on the direct loop
+        vv_dsp_real rs[4];
+        ok &= (vv_dsp_autocorrelation(cx, CN, rs, 4, 1) == VV_DSP_OK) && fabs((double)(rs[3] - ra[3])) < 2e-4;
+    }
+
+    // --- Split-complex layout and kernels (odd length exercises the SIMD tails) ---
+    {
+        enum { SN = 19 };
+        vv_dsp_cpx za[SN], zb[SN], back[SN];
+        vv_dsp_split_cpx sa, sb;
+        vv_dsp_real mag[SN], pw[SN], mask[SN];
+        ok &= (vv_dsp_split_alloc(SN, &sa) == VV_DSP_OK);
+        ok &= (vv_dsp_split_alloc(SN, &sb) == VV_DSP_OK);
+        if (sa.re && sb.re) {
+            for (int i = 0; i < SN; ++i) {
+                za[i] = vv_dsp_cpx_make((vv_dsp_real)(i - 7), (vv_dsp_real)(2 * i % 5));
+                zb[i] = vv_dsp_cpx_make((vv_dsp_real)(i % 3), (vv_dsp_real)(1 - i));
+                mask[i] = (vv_dsp_real)(i % 4) * (vv_dsp_real)0.25;
+            }
+            ok &= (vv_dsp_cpx_to_split(za, sa.re, sa.im, SN) == VV_DSP_OK);
+            ok &= (vv_dsp_cpx_to_split(zb, sb.re, sb.im, SN) == VV_DSP_OK);
+            ok &= (vv_dsp_split_to_cpx(sa.re, sa.im, back, SN) == VV_DSP_OK);
+            ok &= (vv_dsp_split_magnitude(sa.re, sa.im, mag, SN) == VV_DSP_OK);
+            ok &= (vv_dsp_split_power(sa.re, sa.im, pw, SN) == VV_DSP_OK);
+            for (int i = 0; i < SN; ++i) {
+                ok &= approx_equal(back[i].re, za[i].re) && approx_equal(back[i].im, za[i].im);
+                ok &= approx_equal(mag[i], vv_dsp_cpx_abs(za[i]));
+                ok &= approx_equal(pw[i], za[i].re * za[i].re + za[i].im * za[i].im);
+            }
+            // In-place product into a, then mask
+            ok &= (vv_dsp_split_complex_multiply(sa.re, sa.im, sb.re, sb.im, sa.re, sa.im, SN) == VV_DSP_OK);
+            ok &= (vv_dsp_split_apply_mask(sa.re, sa.im, mask, SN) == VV_DSP_OK);
+            for (int i = 0; i < SN; ++i) {
+                vv_dsp_cpx e = vv_dsp_cpx_mul(za[i], zb[i]);
+                ok &= approx_equal(sa.re[i], e.re * mask[i]) && approx_equal(sa.im[i], e.im * mask[i]);
+            }
+        }
+        ok &= (vv_dsp_cpx_to_split(NULL, mag, pw, SN) == VV_DSP_ERROR_NULL_POINTER);
+        vv_dsp_split_free(&sa);
+        vv_dsp_split_free(&sb);
+        ok &= (sa.re == NULL && sa.im == NULL);
+        vv_dsp_split_cpx empty;
+        ok &= (vv_dsp_split_alloc(0, &empty) == VV_DSP_ERROR_INVALID_SIZE);
+    }
+
+    // Complex array kernels against the scalar helpers at every SIMD level (the
+    // length crosses the 256-element blocks of the phase and polar kernels)
+    {
+        enum { CN = 600 };
+        static vv_dsp_cpx z[CN], w[CN], cy[CN];
+        static vv_dsp_real mag[CN], ph[CN], ro[2 * CN];
+        for (int i = 0; i < CN; ++i) {
+            z[i] = vv_dsp_cpx_make((vv_dsp_real)sin(0.37 * i) * (vv_dsp_real)(1 + i % 9),
+                                   (vv_dsp_real)cos(0.11 * i * i) * (vv_dsp_real)(1 + i % 5));
+            w[i] = vv_dsp_cpx_make((vv_dsp_real)(i % 7) - (vv_dsp_real)3, (vv_dsp_real)(i % 4) * (vv_dsp_real)0.5);
+            mag[i] = (vv_dsp_real)(i % 11) * (vv_dsp_real)0.75;
+            ph[i] = (vv_dsp_real)(i - CN / 2) * (vv_dsp_real)0.05;
+        }
+        z[0] = vv_dsp_cpx_make(0, 0);
+        z[1] = vv_dsp_cpx_make(-2, 0);
+        const vv_dsp_simd_level saved = vv_dsp_simd_get_level();
+        for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; ++lvl) {
+            if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+            ok &= (vv_dsp_cpx_abs_array(z, ro, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= approx_equal(ro[i], vv_dsp_cpx_abs(z[i]));
+            ok &= (vv_dsp_cpx_power_array(z, ro, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= (ro[i] == z[i].re * z[i].re + z[i].im * z[i].im);
+            // Medium tiers compute in single precision in double builds too
+            ok &= (vv_dsp_cpx_phase_array(z, ro, CN, VV_DSP_VMATH_MEDIUM) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= fabs((double)(ro[i] - vv_dsp_cpx_phase(z[i]))) < 2e-6;
+            ok &= (vv_dsp_cpx_phase_array(z, ro, CN, VV_DSP_VMATH_EXACT) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= (ro[i] == vv_dsp_cpx_phase(z[i]));
+            ok &= (vv_dsp_cpx_polar_to_cpx_array(mag, ph, cy, CN, VV_DSP_VMATH_MEDIUM) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) {
+                const vv_dsp_cpx e = vv_dsp_cpx_from_polar(mag[i], ph[i]);
+                ok &= fabs((double)(cy[i].re - e.re)) < 1e-5 && fabs((double)(cy[i].im - e.im)) < 1e-5;
+            }
+            ok &= (vv_dsp_cpx_polar_to_cpx_array(mag, ph, cy, CN, VV_DSP_VMATH_EXACT) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) {
+                const vv_dsp_cpx e = vv_dsp_cpx_from_polar(mag[i], ph[i]);
+                ok &= (cy[i].re == e.re && cy[i].im == e.im);
+            }
+            ok &= (vv_dsp_cpx_conj_mul_array(z, w, cy, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) {
+                const vv_dsp_cpx e = vv_dsp_cpx_mul(z[i], vv_dsp_cpx_conj(w[i]));
+                ok &= approx_equal(cy[i].re, e.re) && approx_equal(cy[i].im, e.im);
+            }
+            ok &= (vv_dsp_cpx_scale_array(z, (vv_dsp_real)-1.5, cy, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= (cy[i].re == z[i].re * (vv_dsp_real)-1.5 && cy[i].im == z[i].im * (vv_dsp_real)-1.5);
+            // In place: the power over the front of its complex input, the product and gain over a
+            ok &= (vv_dsp_cpx_scale_array(z, 1, cy, CN) == VV_DSP_OK);
+            ok &= (vv_dsp_cpx_power_array(cy, (vv_dsp_real*)(void*)cy, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= (((vv_dsp_real*)(void*)cy)[i] == z[i].re * z[i].re + z[i].im * z[i].im);
+            ok &= (vv_dsp_cpx_scale_array(z, 1, cy, CN) == VV_DSP_OK);
+            ok &= (vv_dsp_cpx_phase_array(cy, (vv_dsp_real*)(void*)cy, CN, VV_DSP_VMATH_FAST) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) ok &= fabs((double)(((vv_dsp_real*)(void*)cy)[i] - vv_dsp_cpx_phase(z[i]))) < 2e-5;
+            ok &= (vv_dsp_cpx_scale_array(z, 1, cy, CN) == VV_DSP_OK);
+            ok &= (vv_dsp_cpx_conj_mul_array(cy, w, cy, CN) == VV_DSP_OK);
+            for (int i = 0; i < CN; ++i) {
+                const vv_dsp_cpx e = vv_dsp_cpx_mul(z[i], vv_dsp_cpx_conj(w[i]));
+                ok &= approx_equal(cy[i].re, e.re) && approx_equal(cy[i].im, e.im);
+            }
+        }
+        ok &= (vv_dsp_simd_set_level(saved) == VV_DSP_OK);
+        ok &= (vv_dsp_cpx_abs_array(NULL, ro, 1) == VV_DSP_ERROR_NULL_POINTER);
+        ok &= (vv_dsp_cpx_power_array(z, ro, 0) == VV_DSP_OK);
+        ok &= (vv_dsp_cpx_phase_array(z, ro, 1, (vv_dsp_vmath_tier)3) == VV_DSP_ERROR_OUT_OF_RANGE);
+        ok &= (vv_dsp_cpx_polar_to_cpx_array(mag, NULL, cy, 1, VV_DSP_VMATH_FAST) == VV_DSP_ERROR_NULL_POINTER);
+        ok &= (vv_dsp_cpx_conj_mul_array(z, NULL, cy, 1) == VV_DSP_ERROR_NULL_POINTER);
+        ok &= (vv_dsp_cpx_scale_array(z, 1, NULL, 1) == VV_DSP_ERROR_NULL_POINTER);
+    }
+
+    // Non-finite scan and NaN policy fix-up
+    {
+        enum { PN = 1000 };
+        static vv_dsp_real pv[PN];
+        for (int i = 0; i < PN; ++i) pv[i] = (vv_dsp_real)(i % 13) - (vv_dsp_real)6;
+        ok &= (vv_dsp_find_nonfinite(pv, PN) == PN);
+        pv[777] = (vv_dsp_real)NAN;
+        pv[901] = (vv_dsp_real)-INFINITY;
+        ok &= (vv_dsp_find_nonfinite(pv, PN) == 777);
+        ok &= (vv_dsp_find_nonfinite(pv + 778, PN - 778) == 901 - 778);
+        ok &= (vv_dsp_nonfinite_flag(pv[777]) == 1 && vv_dsp_nonfinite_flag(pv[0]) == 0);
+        ok &= (vv_dsp_nan_policy_fixup(VV_DSP_NAN_POLICY_PROPAGATE, pv, PN) == VV_DSP_OK && isnan(pv[777]));
+        ok &= (vv_dsp_nan_policy_fixup(VV_DSP_NAN_POLICY_ERROR, pv, PN) == VV_DSP_ERROR_NAN_INF);
+        ok &= (vv_dsp_nan_policy_fixup(VV_DSP_NAN_POLICY_CLAMP, pv, PN) == VV_DSP_OK);
+        ok &= (pv[777] == 0 && pv[901] < 0 && !isinf(pv[901]) && vv_dsp_find_nonfinite(pv, PN) == PN);
+        pv[5] = (vv_dsp_real)INFINITY;
+        vv_dsp_set_nan_policy(VV_DSP_NAN_POLICY_IGNORE);
+        vv_dsp_real pc[PN];
+        ok &= (vv_dsp_apply_nan_policy_copy(pv, PN, pc) == VV_DSP_OK && pc[5] == 0 && pc[6] == pv[6]);
+        ok &= (vv_dsp_apply_nan_policy_inplace(pv, PN) == VV_DSP_OK && pv[5] == 0);
+        vv_dsp_set_nan_policy(VV_DSP_NAN_POLICY_PROPAGATE);
+    }
+
+    // Workspace arena: aligned slices, mark / reset, overflow
+    {
+        vv_dsp_arena* ar = NULL;
+        ok &= (vv_dsp_arena_create(0, &ar) == VV_DSP_ERROR_INVALID_SIZE && ar == NULL);
+        ok &= (vv_dsp_arena_create(4096, &ar) == VV_DSP_OK && vv_dsp_arena_capacity(ar) == 4096);
+        void* a0 = vv_dsp_arena_alloc(ar, 10);
+        const size_t mk = vv_dsp_arena_mark(ar);
+        void* a1 = vv_dsp_arena_alloc(ar, 100);
+        ok &= (a0 && a1 && ((uintptr_t)a1 % VV_DSP_SIMD_ALIGN_DEFAULT) == 0);
+        ok &= (mk == vv_dsp_arena_request_size(10) && vv_dsp_arena_used(ar) == mk + vv_dsp_arena_request_size(100));
+        ok &= (vv_dsp_arena_alloc(ar, 8192) == NULL);
+        vv_dsp_arena_reset_to(ar, mk);
+        ok &= (vv_dsp_arena_used(ar) == mk && vv_dsp_arena_alloc(ar, 1) == a1);
+        ok &= (vv_dsp_arena_high_water(ar) == mk + vv_dsp_arena_request_size(100));
+        vv_dsp_arena_reset(ar);
+        ok &= (vv_dsp_arena_used(ar) == 0 && vv_dsp_arena_alloc(ar, 4096) == a0);
+        vv_dsp_arena_destroy(ar);
+        void* heap = vv_dsp_scratch_alloc(NULL, 64);
+        ok &= (heap != NULL && vv_dsp_arena_alloc(NULL, 64) == NULL);
+        vv_dsp_scratch_free(NULL, heap);
+    }
+
+    // Allocator hooks: aligned blocks and arenas route through the installed allocator
+    {
+        alloc_counter cnt = {0, 0};
+        ok &= (vv_dsp_set_allocator(count_alloc, NULL, count_free, &cnt) == VV_DSP_ERROR_NULL_POINTER);
+        ok &= (vv_dsp_set_allocator(count_alloc, count_realloc, count_free, &cnt) == VV_DSP_OK);
+        vv_dsp_reset_alloc_stats();
+        void* blk = vv_dsp_aligned_malloc(100, 64);
+        ok &= (blk != NULL && vv_dsp_is_aligned(blk, 64) && cnt.allocs == 1);
+        vv_dsp_arena* ar = NULL;
+        ok &= (vv_dsp_arena_create(256, &ar) == VV_DSP_OK && cnt.allocs == 3);
+        vv_dsp_arena_destroy(ar);
+        vv_dsp_aligned_free(blk);
+        unsigned char* z = (unsigned char*)vv_dsp_calloc(8, 4);
+        ok &= (z != NULL && z[31] == 0);
+        z = (unsigned char*)vv_dsp_realloc(z, 64);
+        ok &= (z != NULL && vv_dsp_realloc(z, 0) == NULL);
+        ok &= (vv_dsp_calloc((size_t)-1, 2) == NULL && vv_dsp_malloc(0) == NULL);
+        ok &= (cnt.allocs == 4 && cnt.frees == 4);
+        vv_dsp_alloc_stats as;
+        ok &= (vv_dsp_get_alloc_stats(&as) == VV_DSP_OK);
+        ok &= (as.allocations == 4 && as.frees == 4 && as.reallocations == 1 && as.failures == 1);
+        ok &= (vv_dsp_set_allocator(NULL, NULL, NULL, NULL) == VV_DSP_OK);
+        blk = vv_dsp_malloc(16);
+        vv_dsp_free(blk);
+        ok &= (cnt.allocs == 4 && vv_dsp_get_alloc_stats(NULL) == VV_DSP_ERROR_NULL_POINTER);
+    }
+
     if (!ok) {
         fprintf(stderr, "core_tests failed\n");
         return 1;
@@ -0,0 +1,236 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "vv_dsp/vv_dsp.hpp"
+
+namespace {
+
+constexpr std::size_t kBlock = 256;
+constexpr std::size_t kTotal = 2048;
+
+static_assert(!std::is_copy_constructible_v<vv_dsp::fft_plan>, "owners are move-only");
+static_assert(!std::is_copy_assignable_v<vv_dsp::fir>, "owners are move-only");
+static_assert(std::is_nothrow_move_constructible_v<vv_dsp::stft>, "moves never throw");
+static_assert(std::is_nothrow_move_assignable_v<vv_dsp::buffer>, "moves never throw");
+
+bool near(const vv_dsp::real* a, const vv_dsp::real* b, std::size_t n, double tol) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::fabs(static_cast<double>(a[i]) - static_cast<double>(b[i])) > tol) return false;
+    }
+    return true;
+}
+
+// Moves transfer the handle and leave the source empty
+bool test_move() {
+    vv_dsp::fft_plan a;
+    if (vv_dsp::fft_plan::create(64, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, a) != VV_DSP_OK || !a) return false;
+    vv_dsp_fft_plan* raw = a.get();
+    vv_dsp::fft_plan b(std::move(a));
+    vv_dsp::fft_plan c;
+    c = std::move(b);
+    vv_dsp::fir f, g;
+    bool ok = !a && !b && c.get() == raw && c.size() == 64;
+    ok = ok && vv_dsp::fir::create(9, f) == VV_DSP_OK && f.num_taps() == 9;
+    g = std::move(f);
+    ok = ok && !f && g.num_taps() == 9;
+    // Failed creation leaves the target untouched
+    ok = ok && vv_dsp::fir::create(0, g) != VV_DSP_OK && g.num_taps() == 9;
+    return ok;
+}
+
+// Forward and inverse through spans over aligned containers
+bool test_fft(const vv_dsp::aligned_vector<vv_dsp::real>& x) {
+    const std::size_t n = 256;
+    vv_dsp::fft_plan fwd, inv;
+    vv_dsp::aligned_vector<vv_dsp::cpx> spec(n / 2 + 1);
+    vv_dsp::aligned_vector<vv_dsp::real> y(n);
+    bool ok = vv_dsp::fft_plan::create(n, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, fwd) == VV_DSP_OK &&
+              vv_dsp::fft_plan::create(n, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, inv) == VV_DSP_OK;
+    ok = ok && reinterpret_cast<std::uintptr_t>(spec.data()) % VV_DSP_SIMD_ALIGN_DEFAULT == 0;
+    const vv_dsp::span<const vv_dsp::real> in(x.data(), n);
+    ok = ok && fwd.execute(in, vv_dsp::span<vv_dsp::cpx>(spec)) == VV_DSP_OK;
+    ok = ok && inv.execute(vv_dsp::span<const vv_dsp::cpx>(spec), vv_dsp::span<vv_dsp::real>(y)) == VV_DSP_OK;
+    ok = ok && near(y.data(), x.data(), n, 1e-4);
+    // Short spans and the wrong plan type are refused before the C call
+    ok = ok && fwd.execute(in.first(n - 1), vv_dsp::span<vv_dsp::cpx>(spec)) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && inv.execute(in, vv_dsp::span<vv_dsp::cpx>(spec)) == VV_DSP_ERROR_UNSUPPORTED;
+
+    // Fixed-size kernels agree with a plan of the same size
+    vv_dsp::fft_plan p16;
+    vv_dsp::cpx z[16], a[16], b[16];
+    for (std::size_t i = 0; i < 16; ++i) z[i] = vv_dsp_cpx_make(x[i], x[i + 16]);
+    ok = ok && vv_dsp::fft_plan::create(16, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, p16) == VV_DSP_OK &&
+         p16.execute(vv_dsp::span<const vv_dsp::cpx>(z), vv_dsp::span<vv_dsp::cpx>(a)) == VV_DSP_OK &&
+         vv_dsp::small_fft<16>::forward(vv_dsp::span<const vv_dsp::cpx>(z), vv_dsp::span<vv_dsp::cpx>(b)) == VV_DSP_OK;
+    for (std::size_t k = 0; ok && k < 16; ++k) ok = a[k].re == b[k].re && a[k].im == b[k].im;
+    vv_dsp::real d[32];
+    ok = ok && vv_dsp::small_dct2<32>::forward(in.first(32), vv_dsp::span<vv_dsp::real>(d)) == VV_DSP_OK;
+    ok = ok && vv_dsp::small_dct2<32>::forward(in.first(31), vv_dsp::span<vv_dsp::real>(d)) == VV_DSP_ERROR_INVALID_SIZE;
+    return ok;
+}
+
+// The span FIR matches the C API and its process calls neither copy nor allocate
+bool test_fir(const vv_dsp::aligned_vector<vv_dsp::real>& x) {
+    const std::size_t taps = 2 * vv_dsp_conv_get_crossover() + 3;
+    vv_dsp::aligned_vector<vv_dsp::real> h(taps), ya(kTotal), yb(kTotal);
+    vv_dsp::fir f;
+    vv_dsp_fir_state ref;
+    std::memset(&ref, 0, sizeof(ref));
+    bool ok = vv_dsp_fir_design_lowpass(h.data(), taps, static_cast<vv_dsp::real>(0.25), VV_DSP_WINDOW_HANNING) ==
+                  VV_DSP_OK &&
+              vv_dsp::fir::create(taps, f) == VV_DSP_OK && f.prepare(kBlock) == VV_DSP_OK &&
+              vv_dsp_fir_state_init(&ref, taps) == VV_DSP_OK;
+    const vv_dsp::span<const vv_dsp::real> hs(h);
+    if (ok) {
+        vv_dsp_reset_alloc_stats();
+        for (std::size_t pos = 0; ok && pos < kTotal; pos += kBlock) {
+            ok = f.apply(hs, vv_dsp::span<const vv_dsp::real>(x.data() + pos, kBlock),
+                         vv_dsp::span<vv_dsp::real>(ya.data() + pos, kBlock)) == VV_DSP_OK;
+        }
+        vv_dsp_alloc_stats st;
+        ok = ok && vv_dsp_get_alloc_stats(&st) == VV_DSP_OK && st.allocations == 0 && st.frees == 0;
+        ok = ok && vv_dsp_fir_apply(&ref, h.data(), x.data(), yb.data(), kTotal) == VV_DSP_OK;
+        ok = ok && near(ya.data(), yb.data(), kTotal, 1e-4);
+        ok = ok && f.apply(hs.first(taps - 1), vv_dsp::span<const vv_dsp::real>(x), vv_dsp::span<vv_dsp::real>(ya)) ==
+                       VV_DSP_ERROR_INVALID_SIZE;
+    }
+    vv_dsp_fir_state_free(&ref);
+    return ok;
+}
+
+// Streaming STFT resynthesis through owners and spans
+bool test_stft(const vv_dsp::aligned_vector<vv_dsp::real>& x) {
+    vv_dsp_stft_params p;
+    std::memset(&p, 0, sizeof(p));
+    p.fft_size = 512;
+    p.hop_size = 128;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    vv_dsp::stft s;
+    bool ok = vv_dsp::stft::create(p, s) == VV_DSP_OK && s.prepare(kBlock) == VV_DSP_OK;
+    vv_dsp::aligned_vector<vv_dsp::cpx> spec(ok ? s.num_bins() : 0);
+    vv_dsp::aligned_vector<vv_dsp::real> y(kTotal);
+    std::size_t out = 0;
+    for (std::size_t pos = 0; ok && pos < kTotal; pos += kBlock) {
+        ok = s.push(vv_dsp::span<const vv_dsp::real>(x.data() + pos, kBlock)) == VV_DSP_OK;
+        while (ok && s.frames_ready() > 0) {
+            ok = s.pop_frame(vv_dsp::span<vv_dsp::cpx>(spec)) == VV_DSP_OK &&
+                 s.synth_frame(vv_dsp::span<const vv_dsp::cpx>(spec),
+                               vv_dsp::span<vv_dsp::real>(y.data() + out, p.hop_size)) == VV_DSP_OK;
+            out += p.hop_size;
+        }
+    }
+    return ok && out > 2 * p.fft_size && near(y.data() + p.fft_size, x.data() + p.fft_size, out - p.fft_size, 1e-3);
+}
+
+bool test_resampler_and_ring(const vv_dsp::aligned_vector<vv_dsp::real>& x) {
+    vv_dsp::resampler rs;
+    vv_dsp::aligned_vector<vv_dsp::real> y(2 * kTotal);
+    std::size_t produced = 0, total = 0;
+    bool ok = vv_dsp::resampler::create(0, 1, rs) == VV_DSP_ERROR_INVALID_SIZE && !rs;
+    ok = ok && vv_dsp::resampler::create(2, 1, rs) == VV_DSP_OK && rs.prepare(kBlock) == VV_DSP_OK;
+    for (std::size_t pos = 0; ok && pos < kTotal; pos += kBlock) {
+        ok = rs.process(vv_dsp::span<const vv_dsp::real>(x.data() + pos, kBlock),
+                        vv_dsp::span<vv_dsp::real>(y.data() + total, y.size() - total), produced) == VV_DSP_OK;
+        total += produced;
+    }
+    ok = ok && rs.flush(vv_dsp::span<vv_dsp::real>(y.data() + total, y.size() - total), produced) == VV_DSP_OK;
+    total += produced;
+    // Same stream as one C call on the whole signal
+    vv_dsp_resampler* ref = vv_dsp_resampler_create(2, 1);
+    vv_dsp::aligned_vector<vv_dsp::real> yr(2 * kTotal);
+    std::size_t nr = 0, nf = 0;
+    ok = ok && ref && vv_dsp_resampler_process_stream(ref, x.data(), kTotal, yr.data(), yr.size(), &nr) == VV_DSP_OK &&
+         vv_dsp_resampler_flush(ref, yr.data() + nr, yr.size() - nr, &nf) == VV_DSP_OK;
+    ok = ok && total == nr + nf && near(y.data(), yr.data(), total, 1e-5);
+    vv_dsp_resampler_destroy(ref);
+
+    vv_dsp::ring<int> r;
+    int in[5] = {1, 2, 3, 4, 5}, back[8] = {0};
+    std::size_t n = 0;
+    ok = ok && vv_dsp::ring<int>::create(VV_DSP_RING_SPSC, 4, r) == VV_DSP_OK;
+    ok = ok && r.write(vv_dsp::span<const int>(in), n) == VV_DSP_OK && n == 4 && r.size() == 4;
+    ok = ok && r.read(vv_dsp::span<int>(back), n) == VV_DSP_OK && n == 4 && back[3] == 4;
+    return ok;
+}
+
+bool test_buffer() {
+    vv_dsp::buffer planar, inter;
+    bool ok = vv_dsp::buffer::create(2, 100, VV_DSP_BUFFER_PLANAR, planar) == VV_DSP_OK &&
+              vv_dsp::buffer::create(2, 100, VV_DSP_BUFFER_INTERLEAVED, inter) == VV_DSP_OK;
+    ok = ok && planar.channel(1).size() == 100 && planar.interleaved().empty() && inter.channel(0).empty() &&
+         inter.interleaved().size() == 200;
+    if (!ok) return false;
+    for (std::size_t f = 0; f < 100; ++f) {
+        planar.channel(0)[f] = static_cast<vv_dsp::real>(f);
+        planar.channel(1)[f] = -static_cast<vv_dsp::real>(f);
+    }
+    ok = vv_dsp_buffer_copy(&planar.view(), &inter.view()) == VV_DSP_OK;
+    ok = ok && inter.interleaved()[2 * 7] == 7 && inter.interleaved()[2 * 7 + 1] == -7;
+
+    // The bank filters the interleaved view through its descriptor
+    vv_dsp::biquad_bank bank;
+    ok = ok && vv_dsp::biquad_bank::create(2, 1, bank) == VV_DSP_OK && bank.set_stage(0, 2, 0, 0, 0, 0) == VV_DSP_OK;
+    ok = ok && bank.process(inter.view(), inter.view()) == VV_DSP_OK && inter.interleaved()[2 * 7 + 1] == -14;
+    vv_dsp::buffer moved(std::move(inter));
+    return ok && !inter && moved.frames() == 100;
+}
+
+// Fused expressions match the operator-per-pass C calls
+bool test_expr(vv_dsp::span<const vv_dsp::real> x) {
+    constexpr std::size_t n = 203;  // not a multiple of any vector width
+    vv_dsp::aligned_vector<vv_dsp::real> win(n), out(n), ref(n);
+    if (vv_dsp_window_hann(n, win.data()) != VV_DSP_OK) return false;
+    const vv_dsp::real gain = static_cast<vv_dsp::real>(0.5);
+    const auto a = x.first(n);
+    const auto b = x.subspan(n, n);
+
+    bool ok = vv_dsp::eval((vv_dsp::lazy(a) * vv_dsp::lazy(win) + vv_dsp::lazy(b)) * gain,
+                           vv_dsp::span<vv_dsp::real>(out)) == VV_DSP_OK;
+    ok = ok && vv_dsp_mul_real_simd(a.data(), win.data(), ref.data(), n) == VV_DSP_OK &&
+         vv_dsp_add_real_simd(ref.data(), b.data(), ref.data(), n) == VV_DSP_OK;
+    for (std::size_t i = 0; i < n; ++i) ref[i] *= gain;
+    ok = ok && near(out.data(), ref.data(), n, 1e-6);
+
+    // In place, with a scalar on the left and the unary forms
+    ok = ok && vv_dsp::eval(1 - vv_dsp::expr::abs(-vv_dsp::lazy(out)), vv_dsp::span<vv_dsp::real>(out)) == VV_DSP_OK;
+    ok = ok && std::fabs(static_cast<double>(out[7] - (1 - std::fabs(ref[7])))) < 1e-6;
+
+    double energy = 0;
+    for (std::size_t i = 0; i < n; ++i) energy += static_cast<double>(a[i]) * static_cast<double>(a[i]);
+    vv_dsp::real e = 0;
+    ok = ok && vv_dsp::sum(vv_dsp::expr::sq(vv_dsp::lazy(a)), e) == VV_DSP_OK &&
+         std::fabs(static_cast<double>(e) - energy) < 1e-4 * energy;
+
+    // Length mismatches are reported, not read past
+    ok = ok && vv_dsp::eval(vv_dsp::lazy(a) + vv_dsp::lazy(x.first(n - 1)), vv_dsp::span<vv_dsp::real>(out)) ==
+                   VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp::eval(vv_dsp::lazy(a) * 2, vv_dsp::span<vv_dsp::real>(out).first(n - 1)) ==
+                   VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp::sum(vv_dsp::expr::scalar(1), e) == VV_DSP_ERROR_INVALID_SIZE;
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    vv_dsp::aligned_vector<vv_dsp::real> x(kTotal);
+    for (std::size_t i = 0; i < kTotal; ++i) {
+        const double t = static_cast<double>(i);
+        x[i] = static_cast<vv_dsp::real>(std::sin(0.05 * t) + 0.25 * std::sin(0.9 * t));
+    }
+
+    if (!test_move()) { std::fprintf(stderr, "C++ move test failed\n"); return 1; }
+    if (!test_fft(x)) { std::fprintf(stderr, "C++ FFT test failed\n"); return 1; }
+    if (!test_fir(x)) { std::fprintf(stderr, "C++ FIR test failed\n"); return 1; }
+    if (!test_stft(x)) { std::fprintf(stderr, "C++ STFT test failed\n"); return 1; }
+    if (!test_resampler_and_ring(x)) { std::fprintf(stderr, "C++ resampler/ring test failed\n"); return 1; }
+    if (!test_buffer()) { std::fprintf(stderr, "C++ buffer test failed\n"); return 1; }
+    if (!test_expr(x)) { std::fprintf(stderr, "C++ expression test failed\n"); return 1; }
+
+    std::printf("C++ API tests passed\n");
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, BPO = 12, NBINS = 72, HOP = 512, N = 16 * 1024 };
+static const double FMIN = 55.0;  // A1; bin 36 is A4 and the top bin about 3.3 kHz
+
+static double mag(vv_dsp_cpx z) {
+    return sqrt((double)z.re * (double)z.re + (double)z.im * (double)z.im);
+}
+
+static vv_dsp_cqt* make(int recursive) {
+    vv_dsp_cqt_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fmin = (vv_dsp_real)FMIN;
+    p.bins_per_octave = BPO;
+    p.num_bins = NBINS;
+    p.hop = HOP;
+    p.recursive = recursive;
+    vv_dsp_cqt* q = NULL;
+    return vv_dsp_cqt_create(&p, &q) == VV_DSP_OK ? q : NULL;
+}
+
+// Definition: bin k of the frame centred on c, in double precision
+static void reference(const vv_dsp_real* x, size_t c, size_t k, double* re, double* im) {
+    const double f = FMIN * pow(2.0, (double)k / BPO), Q = 1.0 / (pow(2.0, 1.0 / BPO) - 1.0);
+    const size_t len = (size_t)ceil(Q * SR / f);
+    double sr = 0.0, si = 0.0, wsum = 0.0;
+    for (size_t j = 0; j < len; ++j) {
+        const double w = len > 1 ? 0.5 - 0.5 * cos(2.0 * VV_DSP_PI_D * (double)j / (double)(len - 1)) : 1.0;
+        const long n = (long)c - (long)(len / 2) + (long)j;
+        const double ph = 2.0 * VV_DSP_PI_D * f * (double)(n - (long)c) / SR;
+        wsum += w;
+        if (n < 0 || n >= N) continue;
+        sr += (double)x[n] * w * cos(ph);
+        si -= (double)x[n] * w * sin(ph);
+    }
+    *re = sr / wsum;
+    *im = si / wsum;
+}
+
+// Direct mode matches the definition; a cosine on a bin centre reads a/2 there in both modes
+static int test_tones(void) {
+    vv_dsp_cqt* direct = make(0);
+    vv_dsp_cqt* rec = make(1);
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    const size_t frames = N / HOP + 1;
+    vv_dsp_cpx* a = (vv_dsp_cpx*)malloc(frames * NBINS * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* b = (vv_dsp_cpx*)malloc(frames * NBINS * sizeof(vv_dsp_cpx));
+    int ok = direct && rec && x && a && b && vv_dsp_cqt_output_count(direct, N) == frames &&
+             vv_dsp_cqt_fft_size(rec) < vv_dsp_cqt_fft_size(direct) &&
+             vv_dsp_cqt_kernel_nonzeros(rec) < vv_dsp_cqt_kernel_nonzeros(direct) &&
+             vv_dsp_cqt_kernel_nonzeros(direct) < NBINS * (vv_dsp_cqt_fft_size(direct) / 2 + 1) / 20;
+
+    const size_t tone_bins[4] = { 36, 24, 61, 5 };
+    for (int i = 0; ok && i < 4; ++i) {
+        const size_t k0 = tone_bins[i];
+        const double f0 = (double)vv_dsp_cqt_bin_freq(direct, k0);
+        for (size_t n = 0; n < N; ++n) {
+            x[n] = (vv_dsp_real)(0.8 * cos(2.0 * VV_DSP_PI_D * f0 * (double)n / SR) +
+                                 0.3 * sin(2.0 * VV_DSP_PI_D * 1.37 * f0 * (double)n / SR));
+        }
+        size_t fa = 0, fb = 0;
+        ok = vv_dsp_cqt_process(direct, x, N, a, frames - 1, &fa) == VV_DSP_ERROR_INVALID_SIZE && fa == 0 &&
+             vv_dsp_cqt_process(direct, x, N, a, frames, &fa) == VV_DSP_OK && fa == frames &&
+             vv_dsp_cqt_process(rec, x, N, b, frames, &fb) == VV_DSP_OK && fb == frames;
+
+        // Frames well inside the signal
+        for (size_t t = 8; ok && t < frames - 8; ++t) {
+            for (size_t k = 0; k < NBINS; k += 7) {
+                double re, im;
+                reference(x, t * HOP, k, &re, &im);
+                const vv_dsp_cpx v = a[t * NBINS + k];
+                if (fabs((double)v.re - re) > 2e-3 || fabs((double)v.im - im) > 2e-3) {
+                    fprintf(stderr, "bin %zu frame %zu: %f%+fi vs %f%+fi\n", k, t, (double)v.re, (double)v.im, re, im);
+                    ok = 0;
+                    break;
+                }
+            }
+            const double da = mag(a[t * NBINS + k0]), db = mag(b[t * NBINS + k0]);
+            if (ok && (fabs(da - 0.4) > 0.02 || fabs(db - 0.4) > 0.02)) {
+                fprintf(stderr, "tone on bin %zu: direct %f, recursive %f\n", k0, da, db);
+                ok = 0;
+            }
+            for (size_t k = 0; ok && k < NBINS; ++k) {
+                if (k != k0 && (mag(a[t * NBINS + k]) > da || mag(b[t * NBINS + k]) > db)) {
+                    fprintf(stderr, "tone on bin %zu peaks at bin %zu\n", k0, k);
+                    ok = 0;
+                }
+            }
+        }
+    }
+
+    // A4 folds onto pitch class A; the Hann main lobe leaks about a quarter of the
+    // energy into each neighbouring semitone
+    if (ok) {
+        for (size_t n = 0; n < N; ++n) x[n] = (vv_dsp_real)(0.5 * cos(2.0 * VV_DSP_PI_D * 440.0 * (double)n / SR));
+        size_t fa = 0;
+        vv_dsp_real chroma[12 * (N / HOP + 1)];
+        ok = vv_dsp_cqt_process(rec, x, N, a, frames, &fa) == VV_DSP_OK &&
+             vv_dsp_cqt_chroma(rec, a, fa, chroma) == VV_DSP_OK;
+        const vv_dsp_real* mid = chroma + 12 * (frames / 2);
+        for (int c = 0; ok && c < 12; ++c) ok = c == 9 ? mid[c] == 1 : mid[c] < (vv_dsp_real)(c == 8 || c == 10 ? 0.35 : 0.01);
+    }
+
+    vv_dsp_cqt_destroy(direct);
+    vv_dsp_cqt_destroy(rec);
+    free(x);
+    free(a);
+    free(b);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_cqt_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fmin = (vv_dsp_real)FMIN;
+    p.bins_per_octave = BPO;
+    p.num_bins = NBINS;
+    p.hop = HOP + 16;  // not a multiple of 2^5
+    p.recursive = 1;
+    vv_dsp_cqt* q = NULL;
+    if (vv_dsp_cqt_create(&p, &q) != VV_DSP_ERROR_INVALID_SIZE || q) return 0;
+    p.hop = HOP;
+    p.num_taps = 63;
+    if (vv_dsp_cqt_create(&p, &q) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    p.num_taps = 0;
+    p.num_bins = 120;  // past Nyquist
+    if (vv_dsp_cqt_create(&p, &q) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    p.num_bins = NBINS;
+    p.fmin = 0;
+    if (vv_dsp_cqt_create(&p, &q) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    if (vv_dsp_cqt_create(NULL, &q) != VV_DSP_ERROR_NULL_POINTER) return 0;
+    vv_dsp_cqt_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    int ok = 1;
+    if (!test_tones()) { fprintf(stderr, "cqt tone test failed\n"); ok = 0; }
+    if (!test_errors()) { fprintf(stderr, "cqt error test failed\n"); ok = 0; }
+    if (!ok) return 1;
+    printf("cqt tests passed\n");
+    return 0;
+}
@@ -7,6 +7,75 @@ static int nearly_equal(vv_dsp_real a, vv_dsp_real b, vv_dsp_real tol){
     vv_dsp_real d = a - b; if (d<0) d = -d; return d <= tol;
 }
 
+// Direct evaluation of X[k] = sum x[n] A^{-n} W^{nk} for the plan checks
+static void czt_naive(const vv_dsp_cpx* x, size_t N, size_t M, double Wre, double Wim,
+                      double Are, double Aim, vv_dsp_cpx* X){
+    double argW = atan2(Wim, Wre), argA = atan2(Aim, Are);
+    for (size_t k=0;k<M;++k){
+        double sr = 0.0, si = 0.0;
+        for (size_t n=0;n<N;++n){
+            double ph = -argA * (double)n + argW * (double)n * (double)k;
+            double c = cos(ph), s = sin(ph);
+            sr += (double)x[n].re * c - (double)x[n].im * s;
+            si += (double)x[n].re * s + (double)x[n].im * c;
+        }
+        X[k].re = (vv_dsp_real)sr; X[k].im = (vv_dsp_real)si;
+    }
+}
+
+static int test_plan(void){
+    enum { N = 100, M = 37 };
+    vv_dsp_real Wre, Wim, Are, Aim;
+    if (vv_dsp_czt_params_for_freq_range((vv_dsp_real)900, (vv_dsp_real)1300, M, (vv_dsp_real)8000,
+                                         &Wre, &Wim, &Are, &Aim) != VV_DSP_OK) return 1;
+    vv_dsp_czt_plan* plan = NULL;
+    if (vv_dsp_czt_plan_create(N, M, Wre, Wim, Are, Aim, &plan) != VV_DSP_OK) return 1;
+    if (vv_dsp_czt_plan_input_size(plan) != N || vv_dsp_czt_plan_output_size(plan) != M) return 1;
+
+    vv_dsp_real xr[N];
+    vv_dsp_cpx xc[N], ref[M], got[M], once[M];
+    for (int frame = 0; frame < 3; ++frame){
+        for (size_t n=0;n<N;++n){
+            double t = (double)n / 8000.0;
+            xr[n] = (vv_dsp_real)(cos(2.0 * VV_DSP_PI_D * (1000.0 + 50.0 * frame) * t) + 0.1 * (double)frame);
+            xc[n].re = xr[n];
+            xc[n].im = (vv_dsp_real)(0.5 * sin(2.0 * VV_DSP_PI_D * 1150.0 * t));
+        }
+        // real path: plan reused across frames, compared with direct sums
+        vv_dsp_cpx xr_c[N];
+        for (size_t n=0;n<N;++n){ xr_c[n].re = xr[n]; xr_c[n].im = 0; }
+        czt_naive(xr_c, N, M, (double)Wre, (double)Wim, (double)Are, (double)Aim, ref);
+        if (vv_dsp_czt_plan_execute_real(plan, xr, got) != VV_DSP_OK) return 1;
+        for (size_t k=0;k<M;++k){
+            if (!nearly_equal(got[k].re, ref[k].re, (vv_dsp_real)1e-3) || !nearly_equal(got[k].im, ref[k].im, (vv_dsp_real)1e-3)){
+                fprintf(stderr, "CZT plan real mismatch frame %d k=%zu: (%g,%g) vs (%g,%g)\n", frame, k,
+                        (double)got[k].re, (double)got[k].im, (double)ref[k].re, (double)ref[k].im);
+                return 1;
+            }
+        }
+        // complex path, and the one-shot wrapper must agree bit-for-bit
+        czt_naive(xc, N, M, (double)Wre, (double)Wim, (double)Are, (double)Aim, ref);
+        if (vv_dsp_czt_plan_execute_cpx(plan, xc, got) != VV_DSP_OK) return 1;
+        if (vv_dsp_czt_exec_cpx(xc, N, M, Wre, Wim, Are, Aim, once) != VV_DSP_OK) return 1;
+        for (size_t k=0;k<M;++k){
+            if (!nearly_equal(got[k].re, ref[k].re, (vv_dsp_real)1e-3) || !nearly_equal(got[k].im, ref[k].im, (vv_dsp_real)1e-3)){
+                fprintf(stderr, "CZT plan cpx mismatch frame %d k=%zu\n", frame, k);
+                return 1;
+            }
+            if (got[k].re != once[k].re || got[k].im != once[k].im){
+                fprintf(stderr, "CZT one-shot differs from plan at k=%zu\n", k);
+                return 1;
+            }
+        }
+    }
+    vv_dsp_czt_plan_destroy(plan);
+
+    if (vv_dsp_czt_plan_create(0, M, Wre, Wim, Are, Aim, &plan) != VV_DSP_ERROR_INVALID_SIZE || plan) return 1;
+    if (vv_dsp_czt_plan_create(N, M, Wre, Wim, Are, Aim, NULL) != VV_DSP_ERROR_NULL_POINTER) return 1;
+    vv_dsp_czt_plan_destroy(NULL);
+    return 0;
+}
+
 int main(void){
     // Simple sanity: CZT with parameters equivalent to DFT of length N
     // For DFT, choose M=N, A=1, W=exp(-j*2*pi/N)
@@ -35,6 +104,11 @@ int main(void){
         }
     }
 
+    if (test_plan() != 0){
+        fprintf(stderr, "czt plan test failed\n");
+        return 1;
+    }
+
     printf("czt tests passed\n");
     return 0;
 }
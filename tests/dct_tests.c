@@ -42,9 +42,121 @@ static int test_dct4_involution(size_t n) {
     free(x); free(X); free(xr); return ok;
 }
 
+// Direct double-precision evaluation of the definitions in dct.h
+static double ref_dct(vv_dsp_dct_type type, vv_dsp_dct_dir dir, const vv_dsp_real* x, size_t N, size_t k) {
+    const double pi = 3.14159265358979323846;
+    double sum = 0.0;
+    if (type == VV_DSP_DCT_IV) {
+        for (size_t n = 0; n < N; ++n) sum += (double)x[n] * cos(pi * ((double)n + 0.5) * ((double)k + 0.5) / (double)N);
+        return dir == VV_DSP_DCT_BACKWARD ? sum * 2.0 / (double)N : sum;
+    }
+    if (dir == VV_DSP_DCT_BACKWARD) {
+        sum = 0.5 * (double)x[0];
+        for (size_t j = 1; j < N; ++j) sum += (double)x[j] * cos(pi * (double)j * ((double)k + 0.5) / (double)N);
+        return sum * 2.0 / (double)N;
+    }
+    if (type == VV_DSP_DCT_II) {
+        for (size_t n = 0; n < N; ++n) sum += (double)x[n] * cos(pi * ((double)n + 0.5) * (double)k / (double)N);
+        return sum;
+    }
+    sum = (double)x[0];
+    for (size_t n = 1; n < N; ++n) sum += 2.0 * (double)x[n] * cos(pi * (double)k * ((double)n + 0.5) / (double)N);
+    return sum;
+}
+
+// FFT-backed plans (even and odd sizes) must match the definitions
+static int test_dct_fft_matches_reference(void) {
+    const size_t sizes[] = {7, 8, 15, 16, 32, 33, 64, 257, 1000};
+    const vv_dsp_dct_type types[] = {VV_DSP_DCT_II, VV_DSP_DCT_III, VV_DSP_DCT_IV};
+    const vv_dsp_dct_dir dirs[] = {VV_DSP_DCT_FORWARD, VV_DSP_DCT_BACKWARD};
+    vv_dsp_real* x = (vv_dsp_real*)malloc(1000 * sizeof(vv_dsp_real));
+    vv_dsp_real* X = (vv_dsp_real*)malloc(1000 * sizeof(vv_dsp_real));
+    if (!x || !X) { free(x); free(X); return 0; }
+    int ok = 1;
+    for (size_t si = 0; ok && si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        const size_t n = sizes[si];
+        for (size_t i = 0; i < n; ++i) x[i] = (vv_dsp_real)(sin(0.37 * (double)i) + 0.25 * cos(1.9 * (double)(i * i % 13)));
+        for (size_t ti = 0; ok && ti < 3; ++ti) {
+            for (size_t di = 0; ok && di < 2; ++di) {
+                vv_dsp_dct_plan* p = NULL;
+                if (vv_dsp_dct_make_plan(n, types[ti], dirs[di], &p) != VV_DSP_OK) { ok = 0; break; }
+                // Run twice: plan-owned buffers must not leak state between calls
+                if (vv_dsp_dct_execute(p, x, X) != VV_DSP_OK || vv_dsp_dct_execute(p, x, X) != VV_DSP_OK) ok = 0;
+                // Outputs grow like sqrt(n) (or n for DCT-III), so scale the tolerance
+                const double tol = 2e-5 * (double)n;
+                for (size_t k = 0; ok && k < n; ++k) {
+                    if (fabs((double)X[k] - ref_dct(types[ti], dirs[di], x, n, k)) > tol) ok = 0;
+                }
+                vv_dsp_dct_destroy(p);
+            }
+        }
+    }
+    free(x); free(X);
+    return ok;
+}
+
+// Plan-free DCT-II kernels, out of place and in place
+static int test_dct2_small(void) {
+    vv_dsp_real x[64] = {0}, X[64], y[64];
+    int ok = vv_dsp_dct2_small(48, x, X) == VV_DSP_ERROR_UNSUPPORTED && vv_dsp_dct2_small(128, x, X) == VV_DSP_ERROR_UNSUPPORTED;
+    for (size_t n = 8; ok && n <= 64; n *= 2) {
+        for (size_t i = 0; i < n; ++i) x[i] = (vv_dsp_real)(cos(0.53 * (double)i) - 0.4 * sin(2.3 * (double)i));
+        memcpy(y, x, n * sizeof(vv_dsp_real));
+        ok = vv_dsp_dct2_small(n, x, X) == VV_DSP_OK && vv_dsp_dct2_small(n, y, y) == VV_DSP_OK;
+        for (size_t k = 0; ok && k < n; ++k) {
+            const double ref = ref_dct(VV_DSP_DCT_II, VV_DSP_DCT_FORWARD, x, n, k);
+            ok = fabs((double)X[k] - ref) <= 2e-5 * (double)n && X[k] == y[k];
+        }
+    }
+    return ok && vv_dsp_dct2_small_32(x, X) == VV_DSP_OK;
+}
+
+// Batched execution (matrix and per-frame plans, strided and in place) must match the definitions
+static int test_dct_batch_matches_reference(void) {
+    const size_t sizes[] = {5, 13, 40, 64, 128, 200};
+    const size_t frames = 19;  // not a multiple of the block size
+    const vv_dsp_dct_type types[] = {VV_DSP_DCT_II, VV_DSP_DCT_III, VV_DSP_DCT_IV};
+    const vv_dsp_dct_dir dirs[] = {VV_DSP_DCT_FORWARD, VV_DSP_DCT_BACKWARD};
+    int ok = 1;
+    for (size_t si = 0; ok && si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        const size_t n = sizes[si], stride = n + 3;
+        vv_dsp_real* x = (vv_dsp_real*)malloc(frames * stride * sizeof(vv_dsp_real));
+        vv_dsp_real* X = (vv_dsp_real*)malloc(frames * stride * sizeof(vv_dsp_real));
+        vv_dsp_real* y = (vv_dsp_real*)malloc(frames * stride * sizeof(vv_dsp_real));
+        if (!x || !X || !y) { free(x); free(X); free(y); return 0; }
+        for (size_t i = 0; i < frames * stride; ++i) x[i] = (vv_dsp_real)(sin(0.11 * (double)i) + 0.5 * cos(0.7 * (double)(i % 17)));
+        for (size_t ti = 0; ok && ti < 3; ++ti) {
+            for (size_t di = 0; ok && di < 2; ++di) {
+                vv_dsp_dct_plan* p = NULL;
+                if (vv_dsp_dct_make_plan(n, types[ti], dirs[di], &p) != VV_DSP_OK) { ok = 0; break; }
+                memcpy(y, x, frames * stride * sizeof(vv_dsp_real));
+                if (vv_dsp_dct_execute_batch(p, x, X, frames, stride) != VV_DSP_OK) ok = 0;
+                if (vv_dsp_dct_execute_batch(p, y, y, frames, stride) != VV_DSP_OK) ok = 0;
+                if (vv_dsp_dct_execute_batch(p, x, X, frames, n - 1) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+                const double tol = 2e-5 * (double)n;
+                for (size_t f = 0; ok && f < frames; ++f) {
+                    for (size_t k = 0; ok && k < n; ++k) {
+                        const double ref = ref_dct(types[ti], dirs[di], x + f * stride, n, k);
+                        if (fabs((double)X[f * stride + k] - ref) > tol || fabs((double)y[f * stride + k] - ref) > tol) ok = 0;
+                    }
+                }
+                vv_dsp_dct_destroy(p);
+            }
+        }
+        free(x); free(X); free(y);
+    }
+    return ok;
+}
+
 int main(void) {
     if (!test_dct2_iii_roundtrip(8)) { fprintf(stderr, "DCT-II/III roundtrip failed\n"); return 1; }
     if (!test_dct4_involution(8)) { fprintf(stderr, "DCT-IV involution failed\n"); return 1; }
+    if (!test_dct2_iii_roundtrip(2048)) { fprintf(stderr, "DCT-II/III roundtrip (2048) failed\n"); return 1; }
+    if (!test_dct4_involution(2048)) { fprintf(stderr, "DCT-IV involution (2048) failed\n"); return 1; }
+    if (!test_dct4_involution(1023)) { fprintf(stderr, "DCT-IV involution (1023) failed\n"); return 1; }
+    if (!test_dct_fft_matches_reference()) { fprintf(stderr, "DCT FFT path mismatch\n"); return 1; }
+    if (!test_dct2_small()) { fprintf(stderr, "small DCT-II kernel mismatch\n"); return 1; }
+    if (!test_dct_batch_matches_reference()) { fprintf(stderr, "DCT batch mismatch\n"); return 1; }
     printf("dct tests passed\n");
     return 0;
 }
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+// Direct HTK formula with clamped frame indices
+static double ref_delta(const vv_dsp_real* c, size_t T, size_t C, size_t N, size_t t, size_t j) {
+    double acc = 0.0, norm = 0.0;
+    for (size_t n = 1; n <= N; ++n) {
+        const size_t tp = (t + n < T) ? t + n : T - 1, tm = (t >= n) ? t - n : 0;
+        acc += (double)n * ((double)c[tp * C + j] - (double)c[tm * C + j]);
+        norm += 2.0 * (double)(n * n);
+    }
+    return acc / norm;
+}
+
+static int test_batch(size_t T, size_t C, size_t N) {
+    vv_dsp_real* c = (vv_dsp_real*)malloc(T * C * sizeof(vv_dsp_real));
+    vv_dsp_real* d = (vv_dsp_real*)malloc(T * C * sizeof(vv_dsp_real));
+    int ok = c && d;
+    for (size_t i = 0; ok && i < T * C; ++i) c[i] = (vv_dsp_real)(sin(0.1 * (double)i) + (double)(i % 5));
+    ok = ok && vv_dsp_deltas_compute(c, T, C, N, d) == VV_DSP_OK;
+    for (size_t t = 0; ok && t < T; ++t) {
+        for (size_t j = 0; ok && j < C; ++j) {
+            const double r = ref_delta(c, T, C, N, t, j);
+            if (fabs((double)d[t * C + j] - r) > 1e-5) {
+                fprintf(stderr, "batch T=%zu N=%zu: %zu,%zu: %g vs %g\n", T, N, t, j, (double)d[t * C + j], r);
+                ok = 0;
+            }
+        }
+    }
+    free(c);
+    free(d);
+    return ok;
+}
+
+// Streaming in uneven chunks equals [c | batch delta | batch delta of that]
+static int test_stream(size_t T, size_t C, size_t order, size_t N) {
+    const size_t dim = C * (1 + order);
+    vv_dsp_real* c = (vv_dsp_real*)malloc(T * C * sizeof(vv_dsp_real));
+    vv_dsp_real* d1 = (vv_dsp_real*)malloc(T * C * sizeof(vv_dsp_real));
+    vv_dsp_real* d2 = (vv_dsp_real*)malloc(T * C * sizeof(vv_dsp_real));
+    vv_dsp_real* out = (vv_dsp_real*)malloc(T * dim * sizeof(vv_dsp_real));
+    vv_dsp_deltas* dl = NULL;
+    int ok = c && d1 && d2 && out && vv_dsp_deltas_create(C, order, N, &dl) == VV_DSP_OK &&
+             vv_dsp_deltas_frame_size(dl) == dim && vv_dsp_deltas_latency(dl) == order * N;
+    for (size_t i = 0; ok && i < T * C; ++i) c[i] = (vv_dsp_real)cos(0.37 * (double)i * (double)(1 + i % 3));
+    ok = ok && vv_dsp_deltas_compute(c, T, C, N, d1) == VV_DSP_OK && vv_dsp_deltas_compute(d1, T, C, N, d2) == VV_DSP_OK;
+
+    const size_t chunks[4] = {1, 3, 0, 11};
+    size_t pos = 0, k = 0, total = 0;
+    while (ok && pos < T) {
+        size_t n = chunks[k++ % 4], got = 0;
+        if (n > T - pos) n = T - pos;
+        const size_t expect = vv_dsp_deltas_output_count(dl, n);
+        ok = vv_dsp_deltas_process(dl, c + pos * C, n, out + total * dim, T - total, &got) == VV_DSP_OK && got == expect;
+        pos += n;
+        total += got;
+    }
+    size_t got = 0;
+    ok = ok && total == (T > order * N ? T - order * N : 0) &&
+         vv_dsp_deltas_flush(dl, out + total * dim, T - total, &got) == VV_DSP_OK && total + got == T;
+    for (size_t t = 0; ok && t < T; ++t) {
+        for (size_t j = 0; ok && j < dim; ++j) {
+            const vv_dsp_real* src = (j < C) ? c : (j < 2 * C) ? d1 : d2;
+            const double r = (double)src[t * C + j % C];
+            if (fabs((double)out[t * dim + j] - r) > 1e-5) {
+                fprintf(stderr, "stream T=%zu order=%zu N=%zu: %zu,%zu: %g vs %g\n", T, order, N, t, j,
+                        (double)out[t * dim + j], r);
+                ok = 0;
+            }
+        }
+    }
+    vv_dsp_deltas_destroy(dl);
+    free(c);
+    free(d1);
+    free(d2);
+    free(out);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_real x[4] = {0}, y[12];
+    vv_dsp_deltas* d = NULL;
+    size_t n = 0;
+    int ok = vv_dsp_deltas_compute(x, 4, 1, 0, y) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_deltas_compute(x, 4, 1, 65, y) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_deltas_create(4, 3, 2, &d) == VV_DSP_ERROR_OUT_OF_RANGE && d == NULL &&
+             vv_dsp_deltas_create(0, 1, 2, &d) == VV_DSP_ERROR_INVALID_SIZE;
+    // Too little room consumes nothing
+    ok = ok && vv_dsp_deltas_create(1, 1, 1, &d) == VV_DSP_OK &&
+         vv_dsp_deltas_process(d, x, 4, y, 2, &n) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_deltas_output_count(d, 4) == 3 && vv_dsp_deltas_process(d, x, 4, y, 3, &n) == VV_DSP_OK && n == 3 &&
+         vv_dsp_deltas_flush(d, y, 0, &n) == VV_DSP_ERROR_INVALID_SIZE;
+    vv_dsp_deltas_destroy(d);
+    return ok;
+}
+
+int main(void) {
+    const size_t lengths[4] = {1, 3, 9, 200};
+    for (size_t l = 0; l < 4; ++l) {
+        for (size_t N = 1; N <= 4; ++N) {
+            if (!test_batch(lengths[l], 7, N)) return 1;
+            for (size_t order = 1; order <= 2; ++order) {
+                if (!test_stream(lengths[l], 5, order, N)) return 1;
+            }
+        }
+    }
+    if (!test_errors()) {
+        fprintf(stderr, "delta error handling failed\n");
+        return 1;
+    }
+    printf("delta tests passed\n");
+    return 0;
+}
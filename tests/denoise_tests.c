@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { NFFT = 512, HOP = 128, MAX_BLOCK = 256, SR = 16000 };
+
+static vv_dsp_denoise* make(size_t channels) {
+    vv_dsp_denoise_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.channels = channels;
+    p.max_block = MAX_BLOCK;
+    vv_dsp_denoise* dn = NULL;
+    return vv_dsp_denoise_create(&p, &dn) == VV_DSP_OK ? dn : NULL;
+}
+
+// Stream len samples per channel in blocks cycling through sizes; 0 on failure.
+// Processing runs on preallocated state only.
+static int run(vv_dsp_denoise* dn, size_t channels, vv_dsp_real* const* x, vv_dsp_real* const* y, size_t len,
+               const size_t* sizes, size_t num_sizes) {
+    size_t i = 0;
+    for (size_t pos = 0; pos < len; ++i) {
+        size_t n = sizes[i % num_sizes];
+        if (n > len - pos) n = len - pos;
+        const vv_dsp_real* in[2];
+        vv_dsp_real* out[2];
+        for (size_t c = 0; c < channels; ++c) {
+            in[c] = x[c] + pos;
+            out[c] = y[c] + pos;
+        }
+        vv_dsp_alloc_stats a0, a1;
+        if (vv_dsp_get_thread_alloc_stats(&a0) != VV_DSP_OK || vv_dsp_denoise_process(dn, in, out, n) != VV_DSP_OK ||
+            vv_dsp_get_thread_alloc_stats(&a1) != VV_DSP_OK || a1.allocations != a0.allocations) return 0;
+        pos += n;
+    }
+    return 1;
+}
+
+// An impulse after digital silence keeps a mask of one: both channels come out
+// delayed by exactly fft_size, whatever the block sizes, and in place
+static int test_latency(void) {
+    enum { LEN = 6000, AT = 3001 };
+    vv_dsp_denoise* dn = make(2);
+    vv_dsp_real* a = (vv_dsp_real*)calloc(LEN, sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)calloc(LEN, sizeof(vv_dsp_real));
+    int ok = dn && a && b && vv_dsp_denoise_latency(dn) == NFFT && vv_dsp_denoise_num_bins(dn) == NFFT / 2 + 1;
+    if (ok) {
+        a[AT] = 1;
+        b[AT] = (vv_dsp_real)-0.5;
+        vv_dsp_real* const bufs[2] = { a, b };
+        const size_t sizes[4] = { 1, 255, 37, 256 };
+        ok = run(dn, 2, bufs, bufs, LEN, sizes, 4);
+    }
+    for (size_t t = 0; ok && t < LEN; ++t) {
+        const double want = t == AT + NFFT ? 1.0 : 0.0;
+        if (fabs((double)a[t] - want) > 1e-5 || fabs((double)b[t] + 0.5 * want) > 1e-5) {
+            fprintf(stderr, "sample %zu: %f %f\n", t, (double)a[t], (double)b[t]);
+            ok = 0;
+        }
+    }
+    if (dn) (void)vv_dsp_denoise_destroy(dn);
+    free(a);
+    free(b);
+    return ok;
+}
+
+// Stationary noise with tone bursts: noise-only stretches drop by more than 10 dB
+// once the floor has settled, the bursts keep their level, and block sizes do not
+// change the result
+static int test_reduction(void) {
+    enum { LEN = 4 * SR, BURST = SR / 4, PERIOD = 3 * SR / 4 };
+    vv_dsp_denoise* dn = make(1);
+    vv_dsp_denoise* dn2 = make(1);
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* tone = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y2 = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    int ok = dn && dn2 && x && tone && y && y2;
+    if (!ok) goto done;
+    unsigned int seed = 12345u;
+    for (size_t t = 0; t < LEN; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        const double u = (double)(seed >> 8) / 16777216.0 - 0.5;
+        const int on = t >= SR && (t - SR) % PERIOD < BURST;
+        tone[t] = on ? (vv_dsp_real)(0.5 * sin(2.0 * VV_DSP_PI_D * 1000.0 * (double)t / SR)) : 0;
+        x[t] = (vv_dsp_real)(0.1 * u) + tone[t];
+    }
+    {
+        vv_dsp_real* const xs[1] = { x };
+        vv_dsp_real* const ys[1] = { y };
+        vv_dsp_real* const ys2[1] = { y2 };
+        const size_t hops[1] = { HOP };
+        const size_t odd[3] = { 100, 3, 256 };
+        ok = run(dn, 1, xs, ys, LEN, hops, 1) && run(dn2, 1, xs, ys2, LEN, odd, 3) &&
+             memcmp(y, y2, LEN * sizeof(vv_dsp_real)) == 0;
+    }
+
+    // Noise between bursts (clear of the window overlap) and the tone in each burst
+    for (size_t b = 0; ok && SR + (b + 1) * PERIOD <= LEN - NFFT; ++b) {
+        const size_t on = SR + b * PERIOD, off = on + BURST + NFFT, end = on + PERIOD - NFFT;
+        double e_in = 0.0, e_out = 0.0;
+        for (size_t t = off; t < end; ++t) {
+            e_in += (double)x[t] * (double)x[t];
+            e_out += (double)y[t + NFFT] * (double)y[t + NFFT];
+        }
+        double proj = 0.0, norm = 0.0;
+        for (size_t t = on + NFFT; t < on + BURST - NFFT; ++t) {
+            proj += (double)y[t + NFFT] * (double)tone[t];
+            norm += (double)tone[t] * (double)tone[t];
+        }
+        const double reduction_db = 10.0 * log10(e_in / e_out), level = proj / norm;
+        if (reduction_db < 10.0 || fabs(level - 1.0) > 0.1) {
+            fprintf(stderr, "gap %zu: %.1f dB reduction, burst level %.3f\n", b, reduction_db, level);
+            ok = 0;
+        }
+    }
+
+done:
+    if (dn) (void)vv_dsp_denoise_destroy(dn);
+    if (dn2) (void)vv_dsp_denoise_destroy(dn2);
+    free(x);
+    free(tone);
+    free(y);
+    free(y2);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_denoise_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = NFFT;
+    p.hop_size = NFFT / 2 + 1;
+    p.channels = 1;
+    vv_dsp_denoise* dn = NULL;
+    if (vv_dsp_denoise_create(&p, &dn) != VV_DSP_ERROR_INVALID_SIZE || dn) return 0;
+    p.hop_size = HOP;
+    p.noise_window = 4;
+    if (vv_dsp_denoise_create(&p, &dn) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    p.noise_window = 0;
+    p.mask_smoothing = 1;
+    if (vv_dsp_denoise_create(&p, &dn) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    p.mask_smoothing = 0;
+    if (vv_dsp_denoise_create(&p, &dn) != VV_DSP_OK) return 0;
+    vv_dsp_real buf[HOP + 1] = { 0 };
+    const vv_dsp_real* in[1] = { buf };
+    vv_dsp_real* out[1] = { buf };
+    const int ok = vv_dsp_denoise_process(dn, in, out, HOP + 1) == VV_DSP_ERROR_INVALID_SIZE &&
+                   vv_dsp_denoise_process(dn, in, out, HOP) == VV_DSP_OK &&
+                   vv_dsp_denoise_reset(dn) == VV_DSP_OK &&
+                   vv_dsp_denoise_destroy(NULL) == VV_DSP_ERROR_NULL_POINTER;
+    (void)vv_dsp_denoise_destroy(dn);
+    return ok;
+}
+
+int main(void) {
+    int ok = 1;
+    if (!test_latency()) { fprintf(stderr, "denoise latency test failed\n"); ok = 0; }
+    if (!test_reduction()) { fprintf(stderr, "denoise reduction test failed\n"); ok = 0; }
+    if (!test_errors()) { fprintf(stderr, "denoise error test failed\n"); ok = 0; }
+    if (!ok) return 1;
+    printf("denoise tests passed\n");
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define FS 48000.0
+#define PI_D 3.14159265358979323846
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+// Interleaved sines: channel c at freq[c] with amplitude amp[c]
+static void fill_sines(vv_dsp_real* x, size_t C, size_t n, const double* freq, const double* amp) {
+    for (size_t t = 0; t < n; ++t) {
+        for (size_t c = 0; c < C; ++c) x[t * C + c] = (vv_dsp_real)(amp[c] * sin(2.0 * PI_D * freq[c] * (double)t / FS));
+    }
+}
+
+// Amplitude of a steady sine on channel c over frames [t0, n)
+static double sine_amp(const vv_dsp_real* y, size_t C, size_t c, size_t t0, size_t n) {
+    double e = 0.0;
+    for (size_t t = t0; t < n; ++t) e += (double)y[t * C + c] * (double)y[t * C + c];
+    return sqrt(2.0 * e / (double)(n - t0));
+}
+
+static vv_dsp_dynamics_band band_cfg(double thr, double ratio, double knee, double att, double rel) {
+    vv_dsp_dynamics_band b;
+    b.threshold_db = (vv_dsp_real)thr;
+    b.ratio = (vv_dsp_real)ratio;
+    b.knee_db = (vv_dsp_real)knee;
+    b.makeup_db = 0;
+    b.attack_ms = (vv_dsp_real)att;
+    b.release_ms = (vv_dsp_real)rel;
+    return b;
+}
+
+// With unity band gains the LR4 tree sums to an allpass: every frequency, including
+// the crossovers, comes out at its input amplitude
+static int test_flat_sum(void) {
+    const vv_dsp_real xo[3] = {200, 1000, 5000};
+    const double freqs[] = {50, 200, 450, 1000, 2200, 5000, 9000, 16000};
+    const size_t C = 8, n = 24000;
+    double amp[8];
+    for (size_t c = 0; c < C; ++c) amp[c] = 0.5;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_dynamics_params p = {(vv_dsp_real)FS, 8, 4, xo, VV_DSP_DYNAMICS_PEAK, 0};
+    vv_dsp_dynamics* d = NULL;
+    int ok = x && y && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK;
+    if (ok) fill_sines(x, C, n, freqs, amp);
+    ok = ok && vv_dsp_dynamics_process(d, x, y, n) == VV_DSP_OK;
+    for (size_t c = 0; ok && c < C; ++c) {
+        const double a = sine_amp(y, C, c, n / 2, n);
+        if (fabs(20.0 * log10(a / 0.5)) > 0.05) {
+            fprintf(stderr, "flat sum: %.0f Hz at %.3f dB\n", freqs[c], 20.0 * log10(a / 0.5));
+            ok = 0;
+        }
+    }
+    vv_dsp_dynamics_destroy(d);
+    free(x);
+    free(y);
+    return ok;
+}
+
+// Steady sines at different levels per channel (11 channels: full SIMD vectors plus a
+// scalar tail) land on the static curve; the meter reports the same gain
+static int test_static_curve(void) {
+    const size_t C = 11, n = 48000;
+    const double thr = -20.0, ratio = 4.0;
+    double freq[11], amp[11];
+    for (size_t c = 0; c < C; ++c) {
+        freq[c] = 700.0 + 130.0 * (double)c;
+        amp[c] = pow(10.0, (-30.0 + 3.0 * (double)c) / 20.0);
+    }
+    vv_dsp_real* x = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_dynamics_params p = {(vv_dsp_real)FS, 11, 1, NULL, VV_DSP_DYNAMICS_RMS, 0};
+    vv_dsp_dynamics* d = NULL;
+    const vv_dsp_dynamics_band b = band_cfg(thr, ratio, 0, 50, 50);
+    int ok = x && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK && vv_dsp_dynamics_set_band(d, 0, &b) == VV_DSP_OK;
+    if (ok) fill_sines(x, C, n, freq, amp);
+    ok = ok && vv_dsp_dynamics_process(d, x, x, n) == VV_DSP_OK;  // in place
+    for (size_t c = 0; ok && c < C; ++c) {
+        const double level = 20.0 * log10(amp[c] / sqrt(2.0));
+        const double want = (1.0 / ratio - 1.0) * (level > thr ? level - thr : 0.0);
+        const double got = 20.0 * log10(sine_amp(x, C, c, n / 2, n) / amp[c]);
+        vv_dsp_real meter = 1;
+        ok = vv_dsp_dynamics_get_gain_reduction(d, 0, c, &meter) == VV_DSP_OK;
+        if (!ok || fabs(got - want) > 0.1 || fabs((double)meter - want) > 0.1) {
+            fprintf(stderr, "static curve: ch %zu gain %.2f dB, meter %.2f, want %.2f\n", c, got, (double)meter, want);
+            ok = 0;
+        }
+    }
+    vv_dsp_dynamics_destroy(d);
+
+    // Soft knee: a level right at the threshold is reduced by slope * knee / 8
+    const double a = sqrt(2.0) * pow(10.0, -10.0 / 20.0);
+    const double f1 = 1000.0;
+    p.num_channels = 1;
+    const vv_dsp_dynamics_band k = band_cfg(-10.0, 4.0, 12.0, 50, 50);
+    vv_dsp_real meter = 0;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK && vv_dsp_dynamics_set_band(d, 0, &k) == VV_DSP_OK;
+    if (ok) fill_sines(x, 1, n, &f1, &a);
+    ok = ok && vv_dsp_dynamics_process(d, x, x, n) == VV_DSP_OK &&
+         vv_dsp_dynamics_get_gain_reduction(d, 0, 0, &meter) == VV_DSP_OK && fabs((double)meter + 0.75 * 12.0 / 8.0) < 0.05;
+    vv_dsp_dynamics_destroy(d);
+    free(x);
+    return ok;
+}
+
+// Only the compressed band loses level; linked channels share one gain
+static int test_bands_and_link(void) {
+    const vv_dsp_real xo[2] = {500, 4000};
+    const size_t C = 2, n = 24000;
+    const double freq[2] = {100.0, 10000.0}, amp[2] = {0.5, 0.5};
+    vv_dsp_real* x = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_dynamics_params p = {(vv_dsp_real)FS, 2, 3, xo, VV_DSP_DYNAMICS_PEAK, 0};
+    vv_dsp_dynamics* d = NULL;
+    const vv_dsp_dynamics_band hard = band_cfg(-40.0, 20.0, 6.0, 1, 200);
+    int ok = x && y && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK && vv_dsp_dynamics_set_band(d, 2, &hard) == VV_DSP_OK;
+    if (ok) fill_sines(x, C, n, freq, amp);
+    ok = ok && vv_dsp_dynamics_process(d, x, y, n) == VV_DSP_OK;
+    const double low = ok ? 20.0 * log10(sine_amp(y, C, 0, n / 2, n) / 0.5) : 0.0;
+    const double high = ok ? 20.0 * log10(sine_amp(y, C, 1, n / 2, n) / 0.5) : 0.0;
+    ok = ok && fabs(low) < 0.1 && high < -25.0;
+    vv_dsp_dynamics_destroy(d);
+
+    // Linked: a quiet channel next to a loud one gets the loud channel's gain
+    const double famp[2] = {0.9, 0.009}, ff[2] = {1000.0, 1000.0};
+    p.num_bands = 1;
+    p.link_channels = 1;
+    const vv_dsp_dynamics_band b = band_cfg(-20.0, 4.0, 0, 5, 100);
+    vv_dsp_real g0 = 0, g1 = 1;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK && vv_dsp_dynamics_set_band(d, 0, &b) == VV_DSP_OK;
+    if (ok) fill_sines(x, C, n, ff, famp);
+    ok = ok && vv_dsp_dynamics_process(d, x, y, n) == VV_DSP_OK &&
+         vv_dsp_dynamics_get_gain_reduction(d, 0, 0, &g0) == VV_DSP_OK &&
+         vv_dsp_dynamics_get_gain_reduction(d, 0, 1, &g1) == VV_DSP_OK && g0 == g1 && g0 < (vv_dsp_real)-10;
+    if (ok) {
+        const double r0 = sine_amp(y, C, 0, n / 2, n) / famp[0], r1 = sine_amp(y, C, 1, n / 2, n) / famp[1];
+        ok = fabs(20.0 * log10(r0 / r1)) < 0.05;
+    }
+    vv_dsp_dynamics_destroy(d);
+    free(x);
+    free(y);
+    return ok;
+}
+
+// Streaming in uneven chunks matches one call; reset restarts from silence
+static int test_streaming(void) {
+    const vv_dsp_real xo[2] = {300, 3000};
+    const size_t C = 5, n = 5000;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* y1 = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* y2 = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_dynamics_params p = {(vv_dsp_real)FS, 5, 3, xo, VV_DSP_DYNAMICS_PEAK, 0};
+    vv_dsp_dynamics* d = NULL;
+    const vv_dsp_dynamics_band b = band_cfg(-18.0, 3.0, 4.0, 2, 60);
+    int ok = x && y1 && y2 && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < 3; ++i) ok = vv_dsp_dynamics_set_band(d, i, &b) == VV_DSP_OK;
+    unsigned int seed = 9u;
+    for (size_t i = 0; ok && i < C * n; ++i) x[i] = (vv_dsp_real)(0.7 * frand(&seed));
+    ok = ok && vv_dsp_dynamics_process(d, x, y1, n) == VV_DSP_OK && vv_dsp_dynamics_reset(d) == VV_DSP_OK;
+    const size_t chunks[] = {1, 7, 63, 64, 65, 200, 1};
+    size_t pos = 0, k = 0;
+    while (ok && pos < n) {
+        size_t m = chunks[k++ % 7];
+        if (m > n - pos) m = n - pos;
+        ok = vv_dsp_dynamics_process(d, x + pos * C, y2 + pos * C, m) == VV_DSP_OK;
+        pos += m;
+    }
+    double err = 0.0, ref = 0.0;
+    for (size_t i = 0; ok && i < C * n; ++i) {
+        err = fmax(err, fabs((double)y1[i] - (double)y2[i]));
+        ref = fmax(ref, fabs((double)y1[i]));
+    }
+    ok = ok && err <= 1e-5 * ref && ref > 0.1;
+    vv_dsp_dynamics_destroy(d);
+    free(x);
+    free(y1);
+    free(y2);
+    return ok;
+}
+
+static int test_errors(void) {
+    const vv_dsp_real xo[2] = {1000, 500};
+    vv_dsp_dynamics_params p = {(vv_dsp_real)FS, 2, 3, xo, VV_DSP_DYNAMICS_PEAK, 0};
+    vv_dsp_dynamics* d = (vv_dsp_dynamics*)1;
+    int ok = vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_OUT_OF_RANGE && d == NULL;
+    p.crossover_hz = NULL;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_NULL_POINTER;
+    p.num_bands = 0;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_INVALID_SIZE;
+    p.num_bands = VV_DSP_DYNAMICS_MAX_BANDS + 1;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_INVALID_SIZE;
+    p.num_bands = 1;
+    p.num_channels = 0;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_INVALID_SIZE;
+    p.num_channels = 2;
+    p.sample_rate = 0;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_OUT_OF_RANGE;
+    p.sample_rate = (vv_dsp_real)FS;
+    p.num_bands = 2;
+    const vv_dsp_real nyq = (vv_dsp_real)(FS / 2);
+    p.crossover_hz = &nyq;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_dynamics_create(NULL, &d) == VV_DSP_ERROR_NULL_POINTER;
+    p.crossover_hz = xo;
+    ok = ok && vv_dsp_dynamics_create(&p, &d) == VV_DSP_OK;
+    if (!ok) return 0;
+    vv_dsp_dynamics_band b = band_cfg(-10, 0.5, 0, 1, 1);
+    vv_dsp_real g = 0, buf[4] = {0};
+    ok = vv_dsp_dynamics_set_band(d, 0, &b) == VV_DSP_ERROR_OUT_OF_RANGE;
+    b.ratio = 2;
+    b.knee_db = -1;
+    ok = ok && vv_dsp_dynamics_set_band(d, 0, &b) == VV_DSP_ERROR_OUT_OF_RANGE;
+    b.knee_db = 0;
+    ok = ok && vv_dsp_dynamics_set_band(d, 2, &b) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_dynamics_set_band(d, 1, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_dynamics_set_band(d, 1, &b) == VV_DSP_OK &&
+         vv_dsp_dynamics_process(d, NULL, buf, 2) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_dynamics_process(d, buf, buf, 0) == VV_DSP_OK &&
+         vv_dsp_dynamics_get_gain_reduction(d, 0, 2, &g) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_dynamics_get_gain_reduction(d, 1, 1, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_dynamics_reset(NULL) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_dynamics_destroy(d);
+    vv_dsp_dynamics_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_flat_sum()) { fprintf(stderr, "dynamics flat sum test failed\n"); rc = 1; }
+    if (!test_static_curve()) { fprintf(stderr, "dynamics static curve test failed\n"); rc = 1; }
+    if (!test_bands_and_link()) { fprintf(stderr, "dynamics band/link test failed\n"); rc = 1; }
+    if (!test_streaming()) { fprintf(stderr, "dynamics streaming test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "dynamics error test failed\n"); rc = 1; }
+    if (rc == 0) printf("dynamics tests passed\n");
+    return rc;
+}
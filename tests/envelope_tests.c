@@ -2,6 +2,7 @@
 #include <math.h>
 #include <string.h>
 #include "vv_dsp/envelope.h"
+#include "vv_dsp/core/simd_core.h"
 
 static int nearly_equal(float a, float b, float eps){ return fabsf(a-b) < eps; }
 
@@ -35,6 +36,85 @@ int main(void){
     float mag[N]; if (vv_dsp_lpspec(a, ORDER, 1.0f, N, mag) != VV_DSP_OK) return 1;
     // DC bin should be reasonably bounded
     if (!(mag[0] > 0.0f)) { fprintf(stderr, "mag[0]=%f\n", (double)mag[0]); return 1; }
+    // Matches direct evaluation of 1/|A(e^{jw})| on bins 0..N/2 (resonance at DC for a pole at 0.9)
+    for (size_t k=0;k<=N/2;k++) {
+        double w = 2.0*3.14159265358979*(double)k/(double)N;
+        double re = 1.0 + (double)a[1]*cos(w), im = -(double)a[1]*sin(w);
+        double ref = 1.0/sqrt(re*re + im*im);
+        if (fabs((double)mag[k] - ref) > 1e-4*ref) { fprintf(stderr, "lpspec[%zu]=%f ref=%f\n", k, (double)mag[k], ref); return 1; }
+    }
+    if (!(mag[0] > mag[N/2])) { fprintf(stderr, "lpspec not lowpass\n"); return 1; }
+
+    // Batch over two frames with per-frame gains equals two single calls
+    {
+        float a2[2*(ORDER+1)] = { 1.0f, a[1], 1.0f, 0.5f };
+        float g2[2] = { 2.0f, 0.5f };
+        float mb[2*(N/2+1)], m1[N/2+1];
+        if (vv_dsp_lpspec_batch(a2, ORDER, g2, 2, N, mb) != VV_DSP_OK) return 1;
+        for (size_t f=0; f<2; f++) {
+            if (vv_dsp_lpspec(&a2[f*(ORDER+1)], ORDER, g2[f], N, m1) != VV_DSP_OK) return 1;
+            if (memcmp(m1, &mb[f*(N/2+1)], sizeof(m1)) != 0) { fprintf(stderr, "lpspec batch mismatch\n"); return 1; }
+        }
+    }
+
+    // Fast exp over the clamped range
+    {
+        float ex[512], ey[512];
+        for (size_t i=0;i<512;i++) ex[i] = -87.0f + 175.0f*(float)i/511.0f;
+        if (vv_dsp_exp_real_fast(ex, ey, 512) != VV_DSP_OK) return 1;
+        for (size_t i=0;i<512;i++) {
+            double ref = exp((double)ex[i]);
+            if (fabs((double)ey[i] - ref) > 1.5e-7*ref) { fprintf(stderr, "exp_fast(%f)=%g ref=%g\n", (double)ex[i], (double)ey[i], ref); return 1; }
+        }
+    }
+
+    // Cepstrum plan: batch matches one-shot; minimum-phase round trip of 1 + 0.5 z^-1
+    {
+        enum { M = 64, F = 3 };
+        float frames[F*M], cep[F*M], one[M], h[F*M];
+        for (size_t f=0; f<F; f++) {
+            memset(&frames[f*M], 0, M*sizeof(float));
+            frames[f*M] = 1.0f; frames[f*M+1] = 0.5f*(float)(f+1)/(float)F;
+        }
+        vv_dsp_cepstrum_plan* cp = NULL;
+        if (vv_dsp_cepstrum_plan_create(M, &cp) != VV_DSP_OK || vv_dsp_cepstrum_plan_size(cp) != M) return 1;
+        if (vv_dsp_cepstrum_plan_real(cp, frames, F, cep) != VV_DSP_OK) return 1;
+        if (vv_dsp_cepstrum_plan_minphase(cp, cep, F, h) != VV_DSP_OK) return 1;
+        for (size_t f=0; f<F; f++) {
+            if (vv_dsp_cepstrum_real(&frames[f*M], M, one) != VV_DSP_OK) return 1;
+            if (memcmp(one, &cep[f*M], sizeof(one)) != 0) { fprintf(stderr, "cepstrum batch mismatch\n"); return 1; }
+            // Already minimum phase, so reconstruction returns the frame itself
+            for (size_t i=0;i<M;i++) {
+                if (!nearly_equal(h[f*M+i], frames[f*M+i], 1e-4f)) { fprintf(stderr, "minphase f=%zu h[%zu]=%f\n", f, i, (double)h[f*M+i]); return 1; }
+            }
+        }
+        vv_dsp_cpx half[F*(M/2+1)], full[M];
+        if (vv_dsp_cepstrum_plan_minphase_spectrum(cp, cep, F, half) != VV_DSP_OK) return 1;
+        if (vv_dsp_minphase_from_cepstrum(&cep[M], M, full) != VV_DSP_OK) return 1;
+        for (size_t k=1;k<M/2;k++) {
+            const vv_dsp_cpx a0 = half[(M/2+1)+k], b0 = full[k], c0 = full[M-k];
+            if (!nearly_equal(a0.re, b0.re, 1e-6f) || !nearly_equal(a0.im, b0.im, 1e-6f) ||
+                !nearly_equal(c0.re, b0.re, 1e-6f) || !nearly_equal(c0.im, -b0.im, 1e-6f)) { fprintf(stderr, "minphase spectrum k=%zu\n", k); return 1; }
+        }
+        if (vv_dsp_cepstrum_plan_real(NULL, frames, 1, cep) != VV_DSP_ERROR_NULL_POINTER) return 1;
+        vv_dsp_cepstrum_plan_destroy(cp);
+        vv_dsp_cepstrum_plan_destroy(NULL);
+        if (vv_dsp_cepstrum_plan_create(0, &cp) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+
+        // Arena variants match the heap ones and leave the arena as they found it
+        vv_dsp_arena* ar = NULL;
+        if (vv_dsp_arena_create(vv_dsp_cepstrum_scratch_size(M), &ar) != VV_DSP_OK) return 1;
+        vv_dsp_real ce[M];
+        if (vv_dsp_cepstrum_real_ex(frames, M, ce, ar) != VV_DSP_OK || memcmp(ce, cep, sizeof(ce)) != 0) {
+            fprintf(stderr, "cepstrum arena mismatch\n"); return 1;
+        }
+        if (vv_dsp_minphase_from_cepstrum_ex(&cep[M], M, half, ar) != VV_DSP_OK ||
+            memcmp(half, full, (M/2+1)*sizeof(vv_dsp_cpx)) != 0) { fprintf(stderr, "minphase arena mismatch\n"); return 1; }
+        if (vv_dsp_arena_used(ar) != 0 || vv_dsp_arena_high_water(ar) != vv_dsp_cepstrum_scratch_size(M)) return 1;
+        // Too small an arena fails cleanly
+        if (vv_dsp_cepstrum_real_ex(frames, 2*M, ce, ar) != VV_DSP_ERROR_INTERNAL || vv_dsp_arena_used(ar) != 0) return 1;
+        vv_dsp_arena_destroy(ar);
+    }
 
     printf("envelope tests passed\n");
     return 0;
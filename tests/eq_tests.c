@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define FS 48000.0
+#define PI_D 3.14159265358979323846
+
+#ifdef VV_DSP_USE_DOUBLE
+#define MATCH_TOL 1e-8
+#else
+#define MATCH_TOL 2e-4
+#endif
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+// |H(e^jw)| in dB at f Hz
+static double mag_db(const vv_dsp_biquad* q, double f) {
+    const double w = 2.0 * PI_D * f / FS;
+    const double c1 = cos(w), s1 = sin(w), c2 = cos(2.0 * w), s2 = sin(2.0 * w);
+    const double nr = (double)q->b0 + (double)q->b1 * c1 + (double)q->b2 * c2;
+    const double ni = -(double)q->b1 * s1 - (double)q->b2 * s2;
+    const double dr = 1.0 + (double)q->a1 * c1 + (double)q->a2 * c2;
+    const double di = -(double)q->a1 * s1 - (double)q->a2 * s2;
+    return 10.0 * log10((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static int test_design(void) {
+    vv_dsp_biquad q;
+    const vv_dsp_real fs = (vv_dsp_real)FS;
+    int ok = vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_PEAKING, fs, 1000, 1, 6) == VV_DSP_OK &&
+             fabs(mag_db(&q, 1000) - 6.0) < 1e-3 && fabs(mag_db(&q, 10)) < 0.01 && fabs(mag_db(&q, 23000)) < 0.05;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_LOWSHELF, fs, 200, (vv_dsp_real)0.7071, 9) == VV_DSP_OK &&
+         fabs(mag_db(&q, 1) - 9.0) < 0.01 && fabs(mag_db(&q, 200) - 4.5) < 0.01 && fabs(mag_db(&q, 20000)) < 0.01;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_HIGHSHELF, fs, 5000, (vv_dsp_real)0.7071, -6) == VV_DSP_OK &&
+         fabs(mag_db(&q, 23999) + 6.0) < 0.05 && fabs(mag_db(&q, 50)) < 0.01;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_NOTCH, fs, 60, 10, 0) == VV_DSP_OK && mag_db(&q, 60) < -40.0 &&
+         fabs(mag_db(&q, 1000)) < 0.01;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_BANDPASS, fs, 3000, 4, 0) == VV_DSP_OK &&
+         fabs(mag_db(&q, 3000)) < 1e-3 && mag_db(&q, 300) < -20.0;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_LOWPASS, fs, 2000, (vv_dsp_real)0.7071, 0) == VV_DSP_OK &&
+         fabs(mag_db(&q, 1)) < 1e-3 && fabs(mag_db(&q, 2000) + 3.01) < 0.01;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_HIGHPASS, fs, 2000, (vv_dsp_real)0.7071, 0) == VV_DSP_OK &&
+         fabs(mag_db(&q, 23999)) < 1e-3 && mag_db(&q, 20) < -70.0;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_ALLPASS, fs, 700, 2, 0) == VV_DSP_OK &&
+         fabs(mag_db(&q, 123)) < 1e-4 && fabs(mag_db(&q, 700)) < 1e-4;
+    ok = ok && vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_PEAKING, fs, 24000, 1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_biquad_design(&q, VV_DSP_BIQUAD_PEAKING, fs, 100, 0, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_biquad_design(&q, (vv_dsp_biquad_type)42, fs, 100, 1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_biquad_design(NULL, VV_DSP_BIQUAD_NOTCH, fs, 100, 1, 0) == VV_DSP_ERROR_NULL_POINTER;
+    return ok;
+}
+
+// Settings on the cache grid (frequency and Q powers of two, gain in 0.01 dB) give
+// exactly the direct designs: every channel matches its own vv_dsp_iir_apply cascade
+static int test_matches_cascade(void) {
+    const size_t C = 9, S = 3, n = 2000;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(C * n * sizeof(vv_dsp_real));
+    vv_dsp_real* xc = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_eq* eq = NULL;
+    int ok = x && y && xc && vv_dsp_eq_create((vv_dsp_real)FS, C, S, &eq) == VV_DSP_OK &&
+             vv_dsp_eq_set_smoothing(eq, 0) == VV_DSP_OK;
+    vv_dsp_biquad ref[9][3];
+    for (size_t c = 0; ok && c < C; ++c) {
+        const vv_dsp_real f0 = (vv_dsp_real)(64 << (c % 5)), g = (vv_dsp_real)(-6.5 + (double)c);
+        ok = vv_dsp_eq_set_band(eq, c, 0, VV_DSP_BIQUAD_LOWSHELF, f0, 1, g) == VV_DSP_OK &&
+             vv_dsp_eq_set_band(eq, c, 1, VV_DSP_BIQUAD_PEAKING, 2 * f0 * 8, 2, -g) == VV_DSP_OK &&
+             vv_dsp_biquad_design(&ref[c][0], VV_DSP_BIQUAD_LOWSHELF, (vv_dsp_real)FS, f0, 1, g) == VV_DSP_OK &&
+             vv_dsp_biquad_design(&ref[c][1], VV_DSP_BIQUAD_PEAKING, (vv_dsp_real)FS, 2 * f0 * 8, 2, -g) == VV_DSP_OK &&
+             vv_dsp_biquad_init(&ref[c][2], 1, 0, 0, 0, 0) == VV_DSP_OK;
+    }
+    unsigned int seed = 21u;
+    for (size_t i = 0; ok && i < C * n; ++i) x[i] = (vv_dsp_real)frand(&seed);
+    ok = ok && vv_dsp_eq_process(eq, x, y, n) == VV_DSP_OK;
+    for (size_t c = 0; ok && c < C; ++c) {
+        for (size_t t = 0; t < n; ++t) xc[t] = x[t * C + c];
+        ok = vv_dsp_iir_apply(ref[c], S, xc, xc, n) == VV_DSP_OK;
+        for (size_t t = 0; ok && t < n; ++t) ok = fabs((double)xc[t] - (double)y[t * C + c]) < MATCH_TOL;
+    }
+    vv_dsp_eq_destroy(eq);
+    free(x);
+    free(y);
+    free(xc);
+    return ok;
+}
+
+// A +12 dB boost on a sine at the band center rises over the smoothing time instead of
+// jumping, then settles on the unsmoothed result; chunking does not change the output
+static int test_glide(void) {
+    const size_t n = 9600, at = 1000;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* ys = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* yc = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* yj = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_eq *a = NULL, *b = NULL, *j = NULL;
+    int ok = x && ys && yc && yj && vv_dsp_eq_create((vv_dsp_real)FS, 1, 1, &a) == VV_DSP_OK &&
+             vv_dsp_eq_create((vv_dsp_real)FS, 1, 1, &b) == VV_DSP_OK &&
+             vv_dsp_eq_create((vv_dsp_real)FS, 1, 1, &j) == VV_DSP_OK && vv_dsp_eq_set_smoothing(a, 10) == VV_DSP_OK &&
+             vv_dsp_eq_set_smoothing(b, 10) == VV_DSP_OK && vv_dsp_eq_set_smoothing(j, 0) == VV_DSP_OK;
+    for (size_t t = 0; t < n && x; ++t) x[t] = (vv_dsp_real)(0.25 * sin(2.0 * PI_D * 1024.0 * (double)t / FS));
+    // whole calls around the change
+    ok = ok && vv_dsp_eq_process(a, x, ys, at) == VV_DSP_OK && vv_dsp_eq_process(j, x, yj, at) == VV_DSP_OK &&
+         vv_dsp_eq_set_band(a, 0, 0, VV_DSP_BIQUAD_PEAKING, 1024, 1, 12) == VV_DSP_OK &&
+         vv_dsp_eq_set_band(j, 0, 0, VV_DSP_BIQUAD_PEAKING, 1024, 1, 12) == VV_DSP_OK &&
+         vv_dsp_eq_process(a, x + at, ys + at, n - at) == VV_DSP_OK &&
+         vv_dsp_eq_process(j, x + at, yj + at, n - at) == VV_DSP_OK;
+    // uneven chunks, in place
+    memcpy(yc, x, n * sizeof(vv_dsp_real));
+    size_t pos = 0, k = 0;
+    const size_t chunks[] = {5, 31, 32, 33, 100, 1};
+    while (ok && pos < n) {
+        size_t m = chunks[k++ % 6];
+        if (pos < at && pos + m > at) m = at - pos;
+        if (m > n - pos) m = n - pos;
+        if (pos == at) ok = vv_dsp_eq_set_band(b, 0, 0, VV_DSP_BIQUAD_PEAKING, 1024, 1, 12) == VV_DSP_OK;
+        ok = ok && vv_dsp_eq_process(b, yc + pos, yc + pos, m) == VV_DSP_OK;
+        pos += m;
+    }
+    for (size_t t = 0; ok && t < n; ++t) ok = ys[t] == yc[t];
+    // largest sample-to-sample step right after the change: gliding stays near the
+    // 1 kHz sine's own slope, the jump rings well above it
+    double ds = 0.0, dj = 0.0, tail = 0.0;
+    for (size_t t = at; ok && t < at + 64; ++t) {
+        ds = fmax(ds, fabs((double)ys[t + 1] - (double)ys[t]));
+        dj = fmax(dj, fabs((double)yj[t + 1] - (double)yj[t]));
+    }
+    for (size_t t = n - 2400; ok && t < n; ++t) tail = fmax(tail, fabs((double)ys[t] - (double)yj[t]));
+    ok = ok && ds < 0.6 * dj && tail < 1e-4;
+    vv_dsp_eq_destroy(a);
+    vv_dsp_eq_destroy(b);
+    vv_dsp_eq_destroy(j);
+    free(x);
+    free(ys);
+    free(yc);
+    free(yj);
+    return ok;
+}
+
+static int test_cache(void) {
+    vv_dsp_eq* eq = NULL;
+    size_t hits = 0, misses = 0;
+    int ok = vv_dsp_eq_create((vv_dsp_real)FS, 16, 2, &eq) == VV_DSP_OK;
+    for (size_t c = 0; ok && c < 16; ++c) {
+        ok = vv_dsp_eq_set_band(eq, c, 0, VV_DSP_BIQUAD_PEAKING, 2500, 1.4f, 3) == VV_DSP_OK;
+    }
+    // same cache key up to the quantization; a new gain is a new design
+    ok = ok && vv_dsp_eq_set_band(eq, VV_DSP_EQ_ALL_CHANNELS, 1, VV_DSP_BIQUAD_PEAKING, 2500.3f, 1.4f, 3.001f) == VV_DSP_OK &&
+         vv_dsp_eq_set_band(eq, 3, 1, VV_DSP_BIQUAD_PEAKING, 2500, 1.4f, 3.5f) == VV_DSP_OK &&
+         vv_dsp_eq_bypass_band(eq, VV_DSP_EQ_ALL_CHANNELS, 0) == VV_DSP_OK &&
+         vv_dsp_eq_cache_stats(eq, &hits, &misses) == VV_DSP_OK && hits == 16 && misses == 2;
+    vv_dsp_eq_destroy(eq);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_eq* eq = (vv_dsp_eq*)1;
+    int ok = vv_dsp_eq_create((vv_dsp_real)FS, 0, 1, &eq) == VV_DSP_ERROR_INVALID_SIZE && eq == NULL &&
+             vv_dsp_eq_create((vv_dsp_real)FS, 1, 0, &eq) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_eq_create(0, 1, 1, &eq) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_eq_create((vv_dsp_real)FS, 1, 1, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+             vv_dsp_eq_create((vv_dsp_real)FS, 2, 2, &eq) == VV_DSP_OK;
+    if (!ok) return 0;
+    vv_dsp_real buf[4] = {0};
+    ok = vv_dsp_eq_set_band(eq, 2, 0, VV_DSP_BIQUAD_PEAKING, 1000, 1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_set_band(eq, 0, 2, VV_DSP_BIQUAD_PEAKING, 1000, 1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_set_band(eq, 0, 0, VV_DSP_BIQUAD_PEAKING, 30000, 1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_set_band(eq, 0, 0, VV_DSP_BIQUAD_PEAKING, 1000, -1, 0) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_bypass_band(eq, 0, 5) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_set_smoothing(eq, -1) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_eq_process(eq, NULL, buf, 2) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_eq_process(eq, buf, buf, 0) == VV_DSP_OK && vv_dsp_eq_reset(eq) == VV_DSP_OK &&
+         vv_dsp_eq_reset(NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_eq_cache_stats(NULL, NULL, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_eq_destroy(eq);
+    vv_dsp_eq_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_design()) { fprintf(stderr, "biquad design test failed\n"); rc = 1; }
+    if (!test_matches_cascade()) { fprintf(stderr, "eq cascade match test failed\n"); rc = 1; }
+    if (!test_glide()) { fprintf(stderr, "eq glide test failed\n"); rc = 1; }
+    if (!test_cache()) { fprintf(stderr, "eq cache test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "eq error test failed\n"); rc = 1; }
+    if (rc == 0) printf("eq tests passed\n");
+    return rc;
+}
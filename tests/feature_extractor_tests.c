@@ -0,0 +1,377 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, NFFT = 400, HOP = 160, NMELS = 40, NCEP = 13, NSIG = 16000 };
+
+static vv_dsp_real tone(size_t i) {
+    const double t = (double)i / SR;
+    return (vv_dsp_real)(0.5 * sin(2.0 * M_PI * 440.0 * t) + 0.2 * sin(2.0 * M_PI * 3100.0 * t * (1.0 + t)) +
+                         0.01 * (double)((i * 2654435761u) % 1000u) / 1000.0);
+}
+
+// Static features frame by frame through the public building blocks
+static int reference(vv_dsp_feature_kind kind, const vv_dsp_real* x, size_t frames, vv_dsp_real* ref) {
+    vv_dsp_stft_params sp = { .fft_size = NFFT, .hop_size = HOP, .window = VV_DSP_STFT_WIN_HANN,
+                              .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft* st = NULL;
+    vv_dsp_mel_sparse* fb = NULL;
+    vv_dsp_mfcc_plan* plan = NULL;
+    const size_t bins = NFFT / 2 + 1, D = (kind == VV_DSP_FEATURE_MFCC) ? NCEP : NMELS;
+    vv_dsp_cpx spec[NFFT / 2 + 1];
+    vv_dsp_real power[NFFT / 2 + 1];
+    int ok = vv_dsp_stft_create(&sp, &st) == VV_DSP_OK &&
+             vv_dsp_mel_filterbank_create_sparse(NFFT, NMELS, SR, 0.0f, SR / 2, VV_DSP_MEL_VARIANT_HTK, &fb) == VV_DSP_OK &&
+             vv_dsp_mfcc_init(NFFT, NMELS, NCEP, SR, 0.0f, SR / 2, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22.0f, 1e-10f,
+                              &plan) == VV_DSP_OK;
+    for (size_t f = 0; ok && f < frames; ++f) {
+        ok = vv_dsp_stft_process(st, x + f * HOP, spec) == VV_DSP_OK;
+        for (size_t k = 0; k < bins; ++k) power[k] = spec[k].re * spec[k].re + spec[k].im * spec[k].im;
+        if (ok && kind == VV_DSP_FEATURE_MFCC) {
+            ok = vv_dsp_mfcc_process(plan, power, 1, ref + f * D) == VV_DSP_OK;
+        } else if (ok) {
+            ok = vv_dsp_compute_log_mel_spectrogram_sparse(power, 1, fb, 1e-10f, ref + f * D) == VV_DSP_OK;
+        }
+    }
+    if (st) (void)vv_dsp_stft_destroy(st);
+    vv_dsp_mel_sparse_destroy(fb);
+    if (plan) (void)vv_dsp_mfcc_destroy(plan);
+    return ok;
+}
+
+// HTK regression over +-N frames with clamped edges: out is frames x D
+static void ref_delta(const vv_dsp_real* in, size_t stride, size_t frames, size_t D, size_t N, double* out) {
+    double norm = 0.0;
+    for (size_t n = 1; n <= N; ++n) norm += 2.0 * (double)(n * n);
+    for (size_t t = 0; t < frames; ++t) {
+        for (size_t j = 0; j < D; ++j) {
+            double acc = 0.0;
+            for (size_t n = 1; n <= N; ++n) {
+                const size_t tp = (t + n < frames) ? t + n : frames - 1, tm = (t >= n) ? t - n : 0;
+                acc += (double)n * ((double)in[tp * stride + j] - (double)in[tm * stride + j]);
+            }
+            out[t * D + j] = acc / norm;
+        }
+    }
+}
+
+// Streams the signal in uneven blocks and checks every frame against the reference
+static int check(vv_dsp_feature_kind kind, size_t order, size_t width) {
+    vv_dsp_feature_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.n_mels = NMELS;
+    p.kind = kind;
+    p.num_mfcc_coeffs = NCEP;
+    p.lifter_coeff = 22.0f;
+    p.delta_order = order;
+    p.delta_width = width;
+    vv_dsp_feature_extractor* fx = NULL;
+    if (vv_dsp_feature_extractor_create(&p, &fx) != VV_DSP_OK) return 0;
+
+    const size_t D = (kind == VV_DSP_FEATURE_MFCC) ? NCEP : NMELS, dim = vv_dsp_feature_extractor_frame_size(fx);
+    const size_t frames = (NSIG - NFFT) / HOP + 1, N = width ? width : 2;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(NSIG * sizeof(vv_dsp_real));
+    vv_dsp_real* ref = (vv_dsp_real*)malloc(frames * D * sizeof(vv_dsp_real));
+    vv_dsp_real* got = (vv_dsp_real*)malloc((frames + 1) * dim * sizeof(vv_dsp_real));
+    double* d1 = (double*)malloc(frames * D * sizeof(double));
+    double* d2 = (double*)malloc(frames * D * sizeof(double));
+    vv_dsp_real* d1r = (vv_dsp_real*)malloc(frames * D * sizeof(vv_dsp_real));
+    int ok = x && ref && got && d1 && d2 && d1r && dim == D * (1 + order);
+    for (size_t i = 0; ok && i < NSIG; ++i) x[i] = tone(i);
+    ok = ok && reference(kind, x, frames, ref);
+
+    const size_t blocks[5] = {1, 37, 400, 1023, 5000};
+    size_t pos = 0, b = 0, total = 0;
+    while (ok && pos < NSIG) {
+        size_t n = blocks[b++ % 5], got_n = 0;
+        if (n > NSIG - pos) n = NSIG - pos;
+        const size_t expect = vv_dsp_feature_extractor_output_count(fx, n);
+        ok = vv_dsp_feature_extractor_process(fx, x + pos, n, got + total * dim, frames - total, &got_n) == VV_DSP_OK &&
+             got_n == expect;
+        pos += n;
+        total += got_n;
+    }
+    if (ok) {
+        size_t got_n = 0;
+        ok = total == frames - order * N &&
+             vv_dsp_feature_extractor_flush(fx, got + total * dim, frames + 1 - total, &got_n) == VV_DSP_OK;
+        total += got_n;
+        ok = ok && total == frames;
+    }
+    if (!ok) fprintf(stderr, "kind %d order %zu: streaming failed after %zu frames\n", (int)kind, order, total);
+
+    if (ok && order >= 1) {
+        ref_delta(ref, D, frames, D, N, d1);
+        for (size_t i = 0; i < frames * D; ++i) d1r[i] = (vv_dsp_real)d1[i];
+        if (order == 2) ref_delta(d1r, D, frames, D, N, d2);
+    }
+    for (size_t t = 0; ok && t < frames; ++t) {
+        for (size_t j = 0; ok && j < dim; ++j) {
+            const size_t part = j / D, c = j % D;
+            const double r = part == 0 ? (double)ref[t * D + c] : part == 1 ? d1[t * D + c] : d2[t * D + c];
+            const double v = (double)got[t * dim + j];
+            if (fabs(v - r) > 1e-3 * (1.0 + fabs(r))) {
+                fprintf(stderr, "kind %d order %zu: frame %zu value %zu: %g vs %g\n", (int)kind, order, t, j, v, r);
+                ok = 0;
+            }
+        }
+    }
+
+    // After the flush the stream restarts from frame 0
+    if (ok) {
+        size_t got_n = 0;
+        ok = vv_dsp_feature_extractor_process(fx, x, NFFT + HOP * order * N, got, frames, &got_n) == VV_DSP_OK &&
+             got_n == 1 && fabs((double)got[0] - (double)ref[0]) <= 1e-3 * (1.0 + fabs((double)ref[0]));
+        if (!ok) fprintf(stderr, "kind %d order %zu: restart mismatch\n", (int)kind, order);
+    }
+
+    vv_dsp_feature_extractor_destroy(fx);
+    free(x);
+    free(ref);
+    free(got);
+    free(d1);
+    free(d2);
+    free(d1r);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_feature_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.n_mels = NMELS;
+    vv_dsp_feature_extractor* fx = NULL;
+    int ok = vv_dsp_feature_extractor_create(NULL, &fx) == VV_DSP_ERROR_NULL_POINTER;
+    p.delta_order = 3;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fx) == VV_DSP_ERROR_OUT_OF_RANGE && fx == NULL;
+    p.delta_order = 0;
+    p.hop_size = NFFT + 1;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fx) == VV_DSP_ERROR_INVALID_SIZE;
+    p.hop_size = HOP;
+    p.kind = VV_DSP_FEATURE_MFCC;
+    p.num_mfcc_coeffs = NMELS + 1;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fx) != VV_DSP_OK;
+
+    // Too small an output buffer consumes nothing
+    p.kind = VV_DSP_FEATURE_LOG_MEL;
+    vv_dsp_real x[NFFT + HOP] = {0}, out[2 * NMELS];
+    size_t n = 0;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fx) == VV_DSP_OK;
+    ok = ok && vv_dsp_feature_extractor_process(fx, x, NFFT + HOP, out, 1, &n) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_feature_extractor_process(fx, x, NFFT + HOP, out, 2, &n) == VV_DSP_OK && n == 2;
+    vv_dsp_feature_extractor_destroy(fx);
+    return ok;
+}
+
+static double magnitude(vv_dsp_cpx c) {
+    return sqrt((double)c.re * (double)c.re + (double)c.im * (double)c.im);
+}
+
+// Spectral descriptors in double precision, straight from their definitions
+static void ref_descriptors(const vv_dsp_cpx* X, const double* prev, int first, double* out) {
+    const size_t bins = NFFT / 2 + 1;
+    const double hz = (double)SR / NFFT;
+    double sm = 0.0, smf = 0.0, sp = 0.0, slp = 0.0, d2 = 0.0;
+    for (size_t k = 0; k < bins; ++k) {
+        const double m = magnitude(X[k]), p = m * m;
+        sm += m;
+        smf += m * (double)k * hz;
+        sp += p > 1e-10 ? p : 1e-10;
+        slp += log(p > 1e-10 ? p : 1e-10);
+        d2 += (m - prev[k]) * (m - prev[k]);
+    }
+    const double c = smf / sm;
+    double var = 0.0, acc = 0.0;
+    size_t roll = bins - 1;
+    for (size_t k = 0; k < bins; ++k) {
+        const double m = magnitude(X[k]);
+        var += m * ((double)k * hz - c) * ((double)k * hz - c);
+        acc += m;
+        if (acc >= 0.85 * sm && roll == bins - 1) roll = k;
+    }
+    out[0] = c;
+    out[1] = sqrt(var / sm);
+    out[2] = (double)roll * hz;
+    out[3] = first ? 0.0 : sqrt(d2);
+    out[4] = exp(slp / (double)bins) / (sp / (double)bins);
+}
+
+// Descriptors against their definitions, on their own and appended by the extractor
+static int test_descriptors(void) {
+    enum { FRAMES = (NSIG - NFFT) / HOP + 1, BINS = NFFT / 2 + 1 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(NSIG * sizeof(vv_dsp_real));
+    vv_dsp_cpx* spec = (vv_dsp_cpx*)malloc(FRAMES * BINS * sizeof(vv_dsp_cpx));
+    vv_dsp_real* out = (vv_dsp_real*)malloc(FRAMES * (NMELS + 5) * sizeof(vv_dsp_real));
+    vv_dsp_real got[5];
+    double prev[BINS] = {0}, want[5];
+    vv_dsp_stft_params sp = { .fft_size = NFFT, .hop_size = HOP, .window = VV_DSP_STFT_WIN_HANN,
+                              .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft* st = NULL;
+    vv_dsp_spectral_features* sf = NULL;
+    int ok = x && spec && out && vv_dsp_stft_create(&sp, &st) == VV_DSP_OK &&
+             vv_dsp_spectral_features_create(NFFT, SR, VV_DSP_SPECTRAL_ALL, 0, &sf) == VV_DSP_OK &&
+             vv_dsp_spectral_features_count(sf) == 5;
+    for (size_t i = 0; ok && i < NSIG; ++i) x[i] = tone(i);
+    for (size_t f = 0; ok && f < FRAMES; ++f) ok = vv_dsp_stft_process(st, x + f * HOP, spec + f * BINS) == VV_DSP_OK;
+
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        ok = vv_dsp_spectral_features_process(sf, spec + f * BINS, 1, got) == VV_DSP_OK;
+        ref_descriptors(spec + f * BINS, prev, f == 0, want);
+        for (size_t k = 0; k < BINS; ++k) prev[k] = magnitude(spec[f * BINS + k]);
+        for (size_t j = 0; ok && j < 5; ++j) {
+            // Rolloff is a bin frequency: allow one bin where the sum sits on the threshold
+            const double tol = j == 2 ? (double)SR / NFFT : 1e-3 * fabs(want[j]) + 1e-4;
+            if (fabs((double)got[j] - want[j]) > tol) {
+                fprintf(stderr, "descriptor %zu of frame %zu: %g vs %g\n", j, f, (double)got[j], want[j]);
+                ok = 0;
+            }
+        }
+    }
+
+    // A flat spectrum is perfectly flat with its centroid mid-band; a single bin has
+    // no bandwidth
+    vv_dsp_cpx flat[BINS];
+    for (size_t k = 0; k < BINS; ++k) flat[k].re = 1, flat[k].im = 0;
+    ok = ok && vv_dsp_spectral_features_reset(sf) == VV_DSP_OK &&
+         vv_dsp_spectral_features_process(sf, flat, 1, got) == VV_DSP_OK && fabs((double)got[4] - 1.0) < 1e-5 &&
+         fabs((double)got[0] - SR / 4.0) < 1e-2 && got[3] == 0;
+    for (size_t k = 0; k < BINS; ++k) flat[k].re = k == 50 ? 1.0f : 0.0f;
+    ok = ok && vv_dsp_spectral_features_process(sf, flat, 1, got) == VV_DSP_OK &&
+         fabs((double)got[0] - 50.0 * SR / NFFT) < 1e-2 && fabs((double)got[1]) < 1e-2 &&
+         fabs((double)got[2] - 50.0 * SR / NFFT) < 1e-2 && got[3] > 0;
+
+    // The extractor appends the same values after the log-mel bands
+    vv_dsp_feature_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.n_mels = NMELS;
+    p.spectral_features = VV_DSP_SPECTRAL_CENTROID | VV_DSP_SPECTRAL_FLUX;
+    vv_dsp_feature_extractor* fx = NULL;
+    size_t n = 0;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fx) == VV_DSP_OK &&
+         vv_dsp_feature_extractor_frame_size(fx) == NMELS + 2 &&
+         vv_dsp_feature_extractor_process(fx, x, NSIG, out, FRAMES, &n) == VV_DSP_OK && n == FRAMES;
+    vv_dsp_spectral_features_destroy(sf);
+    sf = NULL;
+    ok = ok && vv_dsp_spectral_features_create(NFFT, SR, p.spectral_features, 0, &sf) == VV_DSP_OK;
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        ok = vv_dsp_spectral_features_process(sf, spec + f * BINS, 1, got) == VV_DSP_OK &&
+             out[f * (NMELS + 2) + NMELS] == got[0] && out[f * (NMELS + 2) + NMELS + 1] == got[1];
+        if (!ok) fprintf(stderr, "extractor descriptors differ at frame %zu\n", f);
+    }
+
+    vv_dsp_spectral_features* none = NULL;
+    ok = ok && vv_dsp_spectral_features_create(NFFT, SR, 0, 0, &none) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_spectral_features_create(NFFT, SR, 1u << 5, 0, &none) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_spectral_features_create(1, SR, VV_DSP_SPECTRAL_ALL, 0, &none) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_spectral_features_create(NFFT, SR, VV_DSP_SPECTRAL_ALL, 1.5f, &none) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         none == NULL;
+    vv_dsp_feature_extractor_destroy(fx);
+    vv_dsp_spectral_features_destroy(sf);
+    if (st) (void)vv_dsp_stft_destroy(st);
+    free(x);
+    free(spec);
+    free(out);
+    return ok;
+}
+
+// One-pass features over the whole signal: process, then flush
+static int extract_all(vv_dsp_feature_extractor* fx, const vv_dsp_real* x, size_t total, vv_dsp_real* out) {
+    size_t n = 0, tail = 0;
+    const size_t dim = vv_dsp_feature_extractor_frame_size(fx);
+    return vv_dsp_feature_extractor_process(fx, x, NSIG, out, total, &n) == VV_DSP_OK &&
+           vv_dsp_feature_extractor_flush(fx, out + n * dim, total - n, &tail) == VV_DSP_OK && n + tail == total;
+}
+
+// After an edit, frames outside the affected range keep their values and recomputing
+// the range reproduces a full pass over the edited signal exactly
+static int check_incremental(size_t order, unsigned int descriptors) {
+    vv_dsp_feature_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.n_mels = NMELS;
+    p.kind = VV_DSP_FEATURE_MFCC;
+    p.num_mfcc_coeffs = NCEP;
+    p.delta_order = order;
+    p.spectral_features = descriptors;
+    vv_dsp_feature_extractor* fx = NULL;
+    if (vv_dsp_feature_extractor_create(&p, &fx) != VV_DSP_OK) return 0;
+    const size_t total = vv_dsp_feature_extractor_total_frames(fx, NSIG);
+    const size_t dim = vv_dsp_feature_extractor_frame_size(fx);
+    vv_dsp_real* x = (vv_dsp_real*)malloc(NSIG * sizeof(vv_dsp_real));
+    vv_dsp_real* before = (vv_dsp_real*)malloc(total * dim * sizeof(vv_dsp_real));
+    vv_dsp_real* after = (vv_dsp_real*)malloc(total * dim * sizeof(vv_dsp_real));
+    vv_dsp_real* part = (vv_dsp_real*)malloc(total * dim * sizeof(vv_dsp_real));
+    int ok = x && before && after && part && total == (NSIG - NFFT) / HOP + 1;
+    for (size_t i = 0; ok && i < NSIG; ++i) x[i] = tone(i);
+    ok = ok && extract_all(fx, x, total, before);
+    const size_t edits[5][2] = {{0, 50}, {8000, 30}, {5000, 1}, {NSIG - 150, 40}, {NSIG - 10, 10}};
+    for (size_t k = 0; ok && k < 5; ++k) {
+        for (size_t i = edits[k][0]; i < edits[k][0] + edits[k][1]; ++i) x[i] = (vv_dsp_real)(0.7 * sin(0.3 * (double)i));
+        size_t f0 = 0, nf = 0;
+        ok = extract_all(fx, x, total, after) &&
+             vv_dsp_feature_extractor_affected_frames(fx, NSIG, edits[k][0], edits[k][1], &f0, &nf) == VV_DSP_OK &&
+             (nf > 0) == (k < 4) && nf <= NFFT / HOP + 2 + 2 * order * 2 &&
+             vv_dsp_feature_extractor_recompute(fx, x, NSIG, f0, nf, part) == VV_DSP_OK;
+        for (size_t f = 0; ok && f < total; ++f) {
+            const int inside = f >= f0 && f < f0 + nf;
+            ok = memcmp(after + f * dim, inside ? part + (f - f0) * dim : before + f * dim, dim * sizeof(vv_dsp_real)) == 0;
+            if (!ok) fprintf(stderr, "order %zu edit %zu: frame %zu (range %zu+%zu) differs\n", order, k, f, f0, nf);
+        }
+        memcpy(before, after, total * dim * sizeof(vv_dsp_real));
+    }
+    // Frames past the end; samples after the last frame
+    size_t f0 = 1, nf = 1;
+    ok = ok && vv_dsp_feature_extractor_recompute(fx, x, NSIG, total - 1, 2, part) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_feature_extractor_affected_frames(fx, NSIG, NSIG, 5, &f0, &nf) == VV_DSP_OK && nf == 0 &&
+         vv_dsp_feature_extractor_recompute(fx, x, NSIG, 0, total, part) == VV_DSP_OK &&
+         memcmp(part, before, total * dim * sizeof(vv_dsp_real)) == 0;
+    vv_dsp_feature_extractor_destroy(fx);
+    free(x);
+    free(before);
+    free(after);
+    free(part);
+    return ok;
+}
+
+static int test_incremental(void) {
+    return check_incremental(0, 0) && check_incremental(1, VV_DSP_SPECTRAL_FLUX) &&
+           check_incremental(2, VV_DSP_SPECTRAL_FLUX | VV_DSP_SPECTRAL_CENTROID);
+}
+
+int main(void) {
+    const vv_dsp_feature_kind kinds[2] = {VV_DSP_FEATURE_LOG_MEL, VV_DSP_FEATURE_MFCC};
+    for (size_t k = 0; k < 2; ++k) {
+        for (size_t order = 0; order <= 2; ++order) {
+            if (!check(kinds[k], order, order == 1 ? 3 : 0)) return 1;
+        }
+    }
+    if (!test_errors()) {
+        fprintf(stderr, "feature extractor error handling failed\n");
+        return 1;
+    }
+    if (!test_descriptors()) {
+        fprintf(stderr, "spectral descriptors failed\n");
+        return 1;
+    }
+    if (!test_incremental()) {
+        fprintf(stderr, "incremental recompute failed\n");
+        return 1;
+    }
+    printf("feature extractor tests passed\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#ifdef VV_DSP_USE_DOUBLE
+#define TOL 1e-9
+#else
+#define TOL 2e-4
+#endif
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+// Direct 2-D DFT of one bin of a complex matrix (backward: conjugate kernel, 1/(rows*cols))
+static void dft_bin(const vv_dsp_cpx* x, size_t rows, size_t cols, size_t k1, size_t k2, int backward, double* re,
+                    double* im) {
+    const double sign = backward ? 1.0 : -1.0;
+    double sr = 0.0, si = 0.0;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            const double ph = sign * 2.0 * VV_DSP_PI_D *
+                              ((double)((k1 * r) % rows) / (double)rows + (double)((k2 * c) % cols) / (double)cols);
+            const double xr = (double)x[r * cols + c].re, xi = (double)x[r * cols + c].im;
+            sr += xr * cos(ph) - xi * sin(ph);
+            si += xr * sin(ph) + xi * cos(ph);
+        }
+    }
+    const double scale = backward ? 1.0 / ((double)rows * (double)cols) : 1.0;
+    *re = sr * scale;
+    *im = si * scale;
+}
+
+static int close_to(double got, double want, double mag) {
+    return fabs(got - want) <= TOL * (1.0 + mag);
+}
+
+static double peak(const vv_dsp_cpx* x, size_t n) {
+    double m = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double a = fabs((double)x[i].re) + fabs((double)x[i].im);
+        if (a > m) m = a;
+    }
+    return m;
+}
+
+// One size on one context: C2C forward / backward against the direct DFT (every bin
+// for small matrices, a stride of bins otherwise), round trips, and R2C / C2R against
+// the C2C transform of the same real matrix
+static int check_size(const vv_dsp_context* ctx, size_t rows, size_t cols) {
+    const size_t n = rows * cols, hc = cols / 2 + 1;
+    vv_dsp_cpx* x = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* y = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* z = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* h = (vv_dsp_cpx*)malloc(rows * hc * sizeof(vv_dsp_cpx));
+    vv_dsp_real* xr = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* back = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_fft2d_plan *fwd = NULL, *bwd = NULL, *r2c = NULL, *c2r = NULL;
+    int ok = x && y && z && h && xr && back &&
+             vv_dsp_fft2d_make_plan_ctx(ctx, rows, cols, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &fwd) == VV_DSP_OK &&
+             vv_dsp_fft2d_make_plan_ctx(ctx, rows, cols, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &bwd) == VV_DSP_OK &&
+             vv_dsp_fft2d_make_plan_ctx(ctx, rows, cols, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &r2c) == VV_DSP_OK &&
+             vv_dsp_fft2d_make_plan_ctx(ctx, rows, cols, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &c2r) == VV_DSP_OK;
+    unsigned int seed = (unsigned int)(rows * 131u + cols);
+    for (size_t i = 0; ok && i < n; ++i) {
+        x[i].re = (vv_dsp_real)frand(&seed);
+        x[i].im = (vv_dsp_real)frand(&seed);
+    }
+    const size_t step = n <= 256 ? 1 : 1009;
+    ok = ok && vv_dsp_fft2d_execute(fwd, x, y) == VV_DSP_OK;
+    const double ymag = ok ? peak(y, n) : 0.0;
+    for (size_t i = 0; ok && i < n; i += step) {
+        double re, im;
+        dft_bin(x, rows, cols, i / cols, i % cols, 0, &re, &im);
+        ok = close_to((double)y[i].re, re, ymag) && close_to((double)y[i].im, im, ymag);
+        if (!ok) fprintf(stderr, "%zux%zu forward bin %zu: %g%+gi, expected %g%+gi\n", rows, cols, i,
+                         (double)y[i].re, (double)y[i].im, re, im);
+    }
+    ok = ok && vv_dsp_fft2d_execute(bwd, x, z) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < n; i += step) {
+        double re, im;
+        dft_bin(x, rows, cols, i / cols, i % cols, 1, &re, &im);
+        ok = close_to((double)z[i].re, re, 1.0) && close_to((double)z[i].im, im, 1.0);
+        if (!ok) fprintf(stderr, "%zux%zu backward bin %zu mismatch\n", rows, cols, i);
+    }
+    ok = ok && vv_dsp_fft2d_execute(bwd, y, z) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < n; ++i) {
+        ok = close_to((double)z[i].re, (double)x[i].re, 1.0) && close_to((double)z[i].im, (double)x[i].im, 1.0);
+        if (!ok) fprintf(stderr, "%zux%zu C2C round trip differs at %zu\n", rows, cols, i);
+    }
+
+    // Real input: R2C is the left half of the C2C spectrum, C2R inverts it
+    for (size_t i = 0; ok && i < n; ++i) {
+        xr[i] = x[i].re;
+        x[i].im = 0;
+    }
+    ok = ok && vv_dsp_fft2d_execute(fwd, x, y) == VV_DSP_OK && vv_dsp_fft2d_execute(r2c, xr, h) == VV_DSP_OK;
+    for (size_t r = 0; ok && r < rows; ++r) {
+        for (size_t c = 0; ok && c < hc; ++c) {
+            const vv_dsp_cpx a = h[r * hc + c], b = y[r * cols + c];
+            ok = close_to((double)a.re, (double)b.re, ymag) && close_to((double)a.im, (double)b.im, ymag);
+            if (!ok) fprintf(stderr, "%zux%zu R2C bin (%zu, %zu) differs from C2C\n", rows, cols, r, c);
+        }
+    }
+    ok = ok && vv_dsp_fft2d_execute(c2r, h, back) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < n; ++i) {
+        ok = close_to((double)back[i], (double)xr[i], 1.0);
+        if (!ok) fprintf(stderr, "%zux%zu C2R round trip differs at %zu\n", rows, cols, i);
+    }
+    (void)vv_dsp_fft2d_destroy(fwd);
+    (void)vv_dsp_fft2d_destroy(bwd);
+    (void)vv_dsp_fft2d_destroy(r2c);
+    (void)vv_dsp_fft2d_destroy(c2r);
+    free(x);
+    free(y);
+    free(z);
+    free(h);
+    free(xr);
+    free(back);
+    return ok;
+}
+
+static int test_sizes(const vv_dsp_context* ctx) {
+    static const size_t sizes[][2] = {{1, 1}, {1, 8}, {8, 1}, {5, 7}, {6, 10}, {16, 9}, {12, 16}};
+    int ok = 1;
+    for (size_t i = 0; ok && i < sizeof(sizes) / sizeof(sizes[0]); ++i) ok = check_size(ctx, sizes[i][0], sizes[i][1]);
+    return ok;
+}
+
+// Matrices large enough for both passes to split across the pool, with column
+// counts that leave a partial transpose panel
+static int test_large(void) {
+    vv_dsp_threadpool_params tp = {0};
+    tp.num_threads = 4;
+    vv_dsp_threadpool* pool = NULL;
+    if (vv_dsp_threadpool_create(&tp, &pool) != VV_DSP_OK) return 0;
+    vv_dsp_context ctx;
+    vv_dsp_context_init(&ctx);
+    ctx.pool = pool;
+    const int ok = check_size(&ctx, 256, 256) && check_size(&ctx, 180, 202) && check_size(NULL, 128, 300);
+    vv_dsp_threadpool_destroy(pool);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_fft2d_plan* p = (vv_dsp_fft2d_plan*)1;
+    vv_dsp_cpx buf[4] = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
+    int ok = vv_dsp_fft2d_make_plan(0, 4, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &p) == VV_DSP_ERROR_INVALID_SIZE &&
+             p == NULL &&
+             vv_dsp_fft2d_make_plan(4, 0, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &p) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_fft2d_make_plan(2, 2, VV_DSP_FFT_R2C, VV_DSP_FFT_BACKWARD, &p) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_fft2d_make_plan(2, 2, VV_DSP_FFT_C2R, VV_DSP_FFT_FORWARD, &p) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_fft2d_make_plan(2, 2, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+             vv_dsp_fft2d_make_plan(2, 2, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &p) == VV_DSP_OK;
+    ok = ok && vv_dsp_fft2d_execute(p, NULL, buf) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fft2d_execute(NULL, buf, buf) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_fft2d_destroy(NULL) == VV_DSP_OK;
+    if (ok) (void)vv_dsp_fft2d_destroy(p);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_sizes(NULL)) { fprintf(stderr, "fft2d size test failed\n"); rc = 1; }
+    if (!test_large()) { fprintf(stderr, "fft2d parallel test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "fft2d error test failed\n"); rc = 1; }
+    if (rc == 0) printf("fft2d tests passed\n");
+    return rc;
+}
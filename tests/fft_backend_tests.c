@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include "vv_dsp/vv_dsp.h"
 
@@ -45,6 +46,32 @@ static int test_fft_backend_availability(void) {
     printf("NOT AVAILABLE\n");
 #endif
 
+    // cuFFT also needs a CUDA device at run time
+    printf("  cuFFT: ");
+#ifdef VV_DSP_BACKEND_FFT_cufft
+    printf(vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_CUFFT) ? "AVAILABLE\n" : "BUILT, NO DEVICE\n");
+#else
+    printf("NOT AVAILABLE\n");
+    if (vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_CUFFT) ||
+        vv_dsp_fft_set_backend(VV_DSP_FFT_BACKEND_CUFFT) != VV_DSP_ERROR_UNSUPPORTED) return 0;
+#endif
+
+    printf("  vDSP: ");
+#ifdef VV_DSP_BACKEND_FFT_vdsp
+    printf("AVAILABLE\n");
+#else
+    printf("NOT AVAILABLE\n");
+    if (vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_VDSP)) return 0;
+#endif
+
+    printf("  PocketFFT: ");
+#ifdef VV_DSP_BACKEND_FFT_pocketfft
+    printf("AVAILABLE\n");
+#else
+    printf("NOT AVAILABLE\n");
+    if (vv_dsp_fft_is_backend_available(VV_DSP_FFT_BACKEND_POCKETFFT)) return 0;
+#endif
+
     return 1;
 }
 
@@ -237,6 +264,530 @@ static int test_real_fft_backend(const char* backend_name) {
     }
 }
 
+// Compare R2C against a double-precision reference DFT and check C2R roundtrip
+// across even (half-length path), odd and non-power-of-two sizes.
+static int test_real_fft_sizes(void) {
+    printf("Testing R2C/C2R against reference DFT over several sizes:\n");
+    static const size_t sizes[] = { 2, 6, 12, 15, 16, 37, 64, 74, 441, 882, 960, 1024 };
+    enum { MAXN = 1024 };
+    static vv_dsp_real x[MAXN], y[MAXN];
+    static vv_dsp_cpx X[MAXN/2 + 1];
+    const double PI = 3.14159265358979323846264338327950288;
+    int ok = 1;
+    for (size_t si = 0; si < sizeof(sizes)/sizeof(sizes[0]) && ok; ++si) {
+        const size_t n = sizes[si];
+        vv_dsp_fft_plan *pf = NULL, *pb = NULL;
+        if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &pf) != VV_DSP_OK) return 0;
+        if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &pb) != VV_DSP_OK) { vv_dsp_fft_destroy(pf); return 0; }
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = (vv_dsp_real)(sin(0.37 * (double)i) + 0.25 * cos(1.3 * (double)i * (double)i / (double)n));
+        }
+        if (vv_dsp_fft_execute(pf, x, X) != VV_DSP_OK || vv_dsp_fft_execute(pb, X, y) != VV_DSP_OK) ok = 0;
+        const vv_dsp_real tol = (vv_dsp_real)(sizeof(vv_dsp_real) == sizeof(double) ? 1e-9 : 2e-3);
+        for (size_t k = 0; ok && k <= n/2; ++k) {
+            double re = 0.0, im = 0.0;
+            for (size_t t = 0; t < n; ++t) {
+                double ang = -2.0 * PI * (double)((k * t) % n) / (double)n;
+                re += (double)x[t] * cos(ang);
+                im += (double)x[t] * sin(ang);
+            }
+            if (!nearly_equal(X[k].re, (vv_dsp_real)re, tol) || !nearly_equal(X[k].im, (vv_dsp_real)im, tol)) {
+                printf("  n=%zu bin %zu: got (%g, %g), expected (%g, %g)\n", n, k, (double)X[k].re, (double)X[k].im, re, im);
+                ok = 0;
+            }
+        }
+        for (size_t i = 0; ok && i < n; ++i) {
+            if (!nearly_equal(y[i], x[i], tol)) {
+                printf("  n=%zu roundtrip mismatch at %zu: %g vs %g\n", n, i, (double)y[i], (double)x[i]);
+                ok = 0;
+            }
+        }
+        vv_dsp_fft_destroy(pf);
+        vv_dsp_fft_destroy(pb);
+    }
+    printf("  R2C/C2R sizes: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// Plans keep their tables between calls: repeated and in-place execution on
+// one plan must give identical results for power-of-two and other sizes.
+static int test_plan_reuse_inplace(void) {
+    printf("Testing plan reuse and in-place C2C execution:\n");
+    static const size_t sizes[] = { 12, 64 };
+    enum { MAXN = 64 };
+    vv_dsp_cpx x[MAXN], X1[MAXN], X2[MAXN];
+    int ok = 1;
+    for (size_t si = 0; si < sizeof(sizes)/sizeof(sizes[0]) && ok; ++si) {
+        const size_t n = sizes[si];
+        vv_dsp_fft_plan* plan = NULL;
+        if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < n; ++i) x[i] = vv_dsp_cpx_make((vv_dsp_real)i, (vv_dsp_real)(n - i));
+        memcpy(X2, x, sizeof(vv_dsp_cpx) * n);
+        if (vv_dsp_fft_execute(plan, x, X1) != VV_DSP_OK) ok = 0;
+        if (ok && vv_dsp_fft_execute(plan, x, X1) != VV_DSP_OK) ok = 0;
+        if (ok && vv_dsp_fft_execute(plan, X2, X2) != VV_DSP_OK) ok = 0;
+        for (size_t k = 0; ok && k < n; ++k) {
+            if (!nearly_equal(X1[k].re, X2[k].re, TOL * (vv_dsp_real)n) || !nearly_equal(X1[k].im, X2[k].im, TOL * (vv_dsp_real)n)) {
+                printf("  n=%zu mismatch at bin %zu\n", n, k);
+                ok = 0;
+            }
+        }
+        vv_dsp_fft_destroy(plan);
+    }
+    printf("  Plan reuse / in-place: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// Forward/backward C2C against a double-precision reference DFT for sizes that
+// exercise radix-2, mixed radix (2/3/4/5/generic) and Bluestein.
+static int test_c2c_mixed_sizes(void) {
+    printf("Testing C2C against reference DFT over mixed-radix and prime sizes:\n");
+    static const size_t sizes[] = { 1, 3, 5, 7, 9, 12, 30, 49, 97, 127, 441, 960, 1009 };
+    enum { MAXN = 1009 };
+    static vv_dsp_cpx x[MAXN], X[MAXN], y[MAXN];
+    const double PI = 3.14159265358979323846264338327950288;
+    int ok = 1;
+    for (size_t si = 0; si < sizeof(sizes)/sizeof(sizes[0]) && ok; ++si) {
+        const size_t n = sizes[si];
+        vv_dsp_fft_plan *pf = NULL, *pb = NULL;
+        if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &pf) != VV_DSP_OK) return 0;
+        if (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &pb) != VV_DSP_OK) { vv_dsp_fft_destroy(pf); return 0; }
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = vv_dsp_cpx_make((vv_dsp_real)cos(0.21 * (double)i * (double)i / (double)n),
+                                   (vv_dsp_real)sin(0.9 * (double)i));
+        }
+        if (vv_dsp_fft_execute(pf, x, X) != VV_DSP_OK || vv_dsp_fft_execute(pb, X, y) != VV_DSP_OK) ok = 0;
+        const double tol = (sizeof(vv_dsp_real) == sizeof(double)) ? 1e-9 : 2e-3;
+        for (size_t k = 0; ok && k < n; ++k) {
+            double re = 0.0, im = 0.0;
+            for (size_t t = 0; t < n; ++t) {
+                double ang = -2.0 * PI * (double)((k * t) % n) / (double)n;
+                re += (double)x[t].re * cos(ang) - (double)x[t].im * sin(ang);
+                im += (double)x[t].re * sin(ang) + (double)x[t].im * cos(ang);
+            }
+            if (fabs((double)X[k].re - re) > tol || fabs((double)X[k].im - im) > tol) {
+                printf("  n=%zu bin %zu: got (%g, %g), expected (%g, %g)\n", n, k, (double)X[k].re, (double)X[k].im, re, im);
+                ok = 0;
+            }
+        }
+        for (size_t i = 0; ok && i < n; ++i) {
+            if (fabs((double)(y[i].re - x[i].re)) > tol || fabs((double)(y[i].im - x[i].im)) > tol) {
+                printf("  n=%zu roundtrip mismatch at %zu\n", n, i);
+                ok = 0;
+            }
+        }
+        vv_dsp_fft_destroy(pf);
+        vv_dsp_fft_destroy(pb);
+    }
+    printf("  C2C mixed sizes: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// Batched plans must match per-vector execution, both for back-to-back frames
+// and for frame-interleaved (strided) layouts.
+static int test_batch_execute(void) {
+    printf("Testing batched FFT execution:\n");
+    enum { BN = 48, BH = BN/2 + 1, FRAMES = 5 };
+    static vv_dsp_real xr[BN * FRAMES], yr[BN * FRAMES];
+    static vv_dsp_cpx X[BH * FRAMES], Xref[BH];
+    static vv_dsp_cpx xc[BN * FRAMES], Yc[BN * FRAMES], Yref[BN], frame[BN];
+    vv_dsp_fft_plan *single = NULL, *many = NULL, *single_c = NULL, *many_c = NULL, *many_b = NULL;
+    int ok = 1;
+    for (size_t i = 0; i < BN * FRAMES; ++i) {
+        xr[i] = (vv_dsp_real)sin(0.05 * (double)(i * i % 97));
+        xc[i] = vv_dsp_cpx_make((vv_dsp_real)cos(0.3 * (double)i), (vv_dsp_real)sin(0.11 * (double)i));
+    }
+
+    // R2C: contiguous frames, output rows of BH bins
+    if (vv_dsp_fft_make_plan(BN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &single) != VV_DSP_OK ||
+        vv_dsp_fft_make_plan_many(BN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, FRAMES, 1, BN, 1, BH, &many) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_execute_batch(many, xr, X) != VV_DSP_OK) ok = 0;
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        if (vv_dsp_fft_execute(single, xr + f * BN, Xref) != VV_DSP_OK) { ok = 0; break; }
+        for (size_t k = 0; k < BH; ++k) {
+            if (!nearly_equal(X[f * BH + k].re, Xref[k].re, TOL * 10) || !nearly_equal(X[f * BH + k].im, Xref[k].im, TOL * 10)) { ok = 0; break; }
+        }
+    }
+    // C2R batch back, same layout
+    if (ok && vv_dsp_fft_make_plan_many(BN, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, FRAMES, 1, BH, 1, BN, &many_b) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_execute_batch(many_b, X, yr) != VV_DSP_OK) ok = 0;
+    for (size_t i = 0; ok && i < BN * FRAMES; ++i) {
+        if (!nearly_equal(yr[i], xr[i], TOL * 10)) ok = 0;
+    }
+
+    // C2C: frames interleaved sample by sample (stride FRAMES, distance 1)
+    if (ok && (vv_dsp_fft_make_plan(BN, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &single_c) != VV_DSP_OK ||
+               vv_dsp_fft_make_plan_many(BN, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, FRAMES, FRAMES, 1, FRAMES, 1, &many_c) != VV_DSP_OK)) ok = 0;
+    if (ok && vv_dsp_fft_execute_batch(many_c, xc, Yc) != VV_DSP_OK) ok = 0;
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        for (size_t i = 0; i < BN; ++i) frame[i] = xc[i * FRAMES + f];
+        if (vv_dsp_fft_execute(single_c, frame, Yref) != VV_DSP_OK) { ok = 0; break; }
+        for (size_t k = 0; k < BN; ++k) {
+            const vv_dsp_cpx v = Yc[k * FRAMES + f];
+            if (!nearly_equal(v.re, Yref[k].re, TOL * 10) || !nearly_equal(v.im, Yref[k].im, TOL * 10)) { ok = 0; break; }
+        }
+    }
+
+    // Invalid geometry
+    vv_dsp_fft_plan* bad = NULL;
+    if (vv_dsp_fft_make_plan_many(BN, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, 0, 1, BN, 1, BN, &bad) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+
+    vv_dsp_fft_destroy(single);
+    vv_dsp_fft_destroy(many);
+    vv_dsp_fft_destroy(many_b);
+    vv_dsp_fft_destroy(single_c);
+    vv_dsp_fft_destroy(many_c);
+    printf("  Batched execution: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+#ifdef VV_DSP_BACKEND_FFT_cufft
+// Device spectrogram (fused power, mel and log) against the host path on KissFFT
+static int test_cufft_spectrogram(void) {
+    printf("Testing device spectrogram on cuFFT:\n");
+    enum { SN = 20000, NMELS = 32 };
+    vv_dsp_stft_params p = { .fft_size = 512, .hop_size = 128, .window = VV_DSP_STFT_WIN_HANN,
+                             .spectrum = VV_DSP_STFT_SPECTRUM_HALF, .periodic = 1 };
+    vv_dsp_context gpu, cpu;
+    vv_dsp_context_init(&gpu);
+    vv_dsp_context_init(&cpu);
+    gpu.fft_backend = VV_DSP_FFT_BACKEND_CUFFT;
+    cpu.fft_backend = VV_DSP_FFT_BACKEND_KISS;
+    static vv_dsp_real x[SN];
+    for (size_t i = 0; i < SN; ++i) x[i] = (vv_dsp_real)(sin(0.031 * (double)i) + 0.2 * sin(0.7 * (double)i));
+    vv_dsp_real* fb = NULL;
+    size_t nf = 0, flen = 0, fg = 0, fc = 0;
+    vv_dsp_stft *hg = NULL, *hc = NULL;
+    int ok = vv_dsp_stft_create_ctx(&gpu, &p, &hg) == VV_DSP_OK && vv_dsp_stft_create_ctx(&cpu, &p, &hc) == VV_DSP_OK &&
+             vv_dsp_mel_filterbank_create(512, NMELS, (vv_dsp_real)16000, 0, (vv_dsp_real)8000,
+                                          VV_DSP_MEL_VARIANT_HTK, &fb, &nf, &flen) == VV_DSP_OK;
+    const size_t rows = ok ? vv_dsp_stft_spectrogram_frames(hg, SN) : 0;
+    vv_dsp_real* g = (vv_dsp_real*)malloc(rows * 257 * sizeof(vv_dsp_real) + 1);
+    vv_dsp_real* c = (vv_dsp_real*)malloc(rows * 257 * sizeof(vv_dsp_real) + 1);
+    vv_dsp_spectrogram_opts o;
+    memset(&o, 0, sizeof(o));
+    o.scale = VV_DSP_SPECTROGRAM_LOG;
+    o.floor = (vv_dsp_real)1e-6;
+    for (int pass = 0; ok && g && c && pass < 2; ++pass) {
+        // Pass 0: plain magnitude rows, pass 1: log-mel rows
+        const vv_dsp_spectrogram_opts* po = pass ? &o : NULL;
+        if (pass) {
+            o.mel_weights = fb;
+            o.n_mels = NMELS;
+        }
+        const size_t width = pass ? NMELS : 257;
+        ok = vv_dsp_stft_spectrogram_ex(hg, x, SN, po, g, &fg) == VV_DSP_OK &&
+             vv_dsp_stft_spectrogram_ex(hc, x, SN, po, c, &fc) == VV_DSP_OK && fg == fc && fg == rows;
+        for (size_t i = 0; ok && i < rows * width; ++i) {
+            ok = fabs((double)(g[i] - c[i])) <= 1e-3 * (1.0 + fabs((double)c[i]));
+        }
+    }
+    free(g);
+    free(c);
+    if (fb) vv_dsp_mel_filterbank_free(fb, NMELS);
+    if (hg) (void)vv_dsp_stft_destroy(hg);
+    if (hc) (void)vv_dsp_stft_destroy(hc);
+    printf("  Device spectrogram: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+#endif
+
+static int test_plan_cache(void) {
+    printf("Testing process-wide plan cache:\n");
+    vv_dsp_fft_cache_stats st;
+    vv_dsp_fft_plan *a = NULL, *b = NULL, *c = NULL;
+    int ok = 1;
+    if (vv_dsp_fft_cache_clear() != VV_DSP_OK || vv_dsp_fft_cache_set_capacity(2) != VV_DSP_OK) ok = 0;
+
+    // First acquire misses, re-acquire after release hits the same plan
+    if (ok && vv_dsp_fft_plan_acquire(64, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &a) != VV_DSP_OK) ok = 0;
+    vv_dsp_fft_plan* first = a;
+    if (ok && vv_dsp_fft_plan_release(a) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_plan_acquire(64, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &a) != VV_DSP_OK) ok = 0;
+    if (ok && a != first) ok = 0;
+    // A second concurrent user of the same key gets its own plan
+    if (ok && vv_dsp_fft_plan_acquire(64, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &b) != VV_DSP_OK) ok = 0;
+    if (ok && b == a) ok = 0;
+    if (ok && vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && (st.hits != 1 || st.misses != 2 || st.entries != 0 || st.in_use != 2)) ok = 0;
+
+    // Capacity bounds the idle set
+    if (ok && vv_dsp_fft_plan_acquire(30, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &c) != VV_DSP_OK) ok = 0;
+    vv_dsp_fft_plan_release(a);
+    vv_dsp_fft_plan_release(b);
+    vv_dsp_fft_plan_release(c);
+    if (ok && vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && (st.entries != 2 || st.in_use != 0 || st.capacity != 2)) ok = 0;
+
+    // Keys include direction and type
+    if (ok && vv_dsp_fft_plan_acquire(30, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &c) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && st.hits != 1) ok = 0;
+    vv_dsp_fft_plan_release(c);
+
+    if (vv_dsp_fft_cache_clear() != VV_DSP_OK || vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && (st.entries != 0 || st.hits != 0 || st.misses != 0)) ok = 0;
+    if (vv_dsp_fft_cache_get_stats(NULL) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+    vv_dsp_fft_cache_set_capacity(32);
+    printf("  Plan cache: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+static int test_prewarm_and_wisdom(void) {
+    printf("Testing plan prewarm and wisdom API:\n");
+    const size_t sizes[] = {128, 90};
+    const vv_dsp_fft_type types[] = {VV_DSP_FFT_R2C, VV_DSP_FFT_C2C};
+    vv_dsp_fft_cache_stats st;
+    vv_dsp_fft_plan* p = NULL;
+    int ok = 1;
+    if (vv_dsp_fft_cache_clear() != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_prewarm(sizes, types, 2) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && (st.entries != 3 || st.misses != 3)) ok = 0;
+    // Every prewarmed key is now a hit
+    if (ok && vv_dsp_fft_plan_acquire(90, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &p) != VV_DSP_OK) ok = 0;
+    vv_dsp_fft_plan_release(p);
+    if (ok && vv_dsp_fft_cache_get_stats(&st) != VV_DSP_OK) ok = 0;
+    if (ok && st.hits != 1) ok = 0;
+    if (vv_dsp_fft_prewarm(NULL, types, 2) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+    if (vv_dsp_fft_prewarm(NULL, NULL, 0) != VV_DSP_OK) ok = 0;
+    if (vv_dsp_fft_export_wisdom(NULL) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+    if (vv_dsp_fft_import_wisdom(NULL) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+#ifndef VV_DSP_BACKEND_FFT_fftw
+    if (vv_dsp_fft_export_wisdom("unused.wisdom") != VV_DSP_ERROR_UNSUPPORTED) ok = 0;
+#endif
+    (void)vv_dsp_fft_cache_clear();
+    printf("  Prewarm and wisdom: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+static int test_auto_tuning(void) {
+    printf("Testing per-size backend auto-tuning:\n");
+    enum { AN = 96 };
+    vv_dsp_fft_plan *autop = NULL, *ref = NULL;
+    vv_dsp_fft_backend chosen = VV_DSP_FFT_BACKEND_FFTS;
+    static vv_dsp_real x[AN];
+    static vv_dsp_cpx X[AN / 2 + 1], R[AN / 2 + 1];
+    const char* path = "vv_dsp_fft_tuning_test.txt";
+    int ok = 1;
+    for (size_t i = 0; i < AN; ++i) x[i] = (vv_dsp_real)cos(0.2 * (double)i);
+
+    (void)vv_dsp_fft_clear_tuning();
+    if (vv_dsp_fft_get_tuned_backend(AN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &chosen) != VV_DSP_ERROR_OUT_OF_RANGE) ok = 0;
+    if (ok && vv_dsp_fft_make_plan_auto(AN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &autop) != VV_DSP_OK) ok = 0;
+    if (ok && vv_dsp_fft_get_tuned_backend(AN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &chosen) != VV_DSP_OK) ok = 0;
+    if (ok && !vv_dsp_fft_is_backend_available(chosen)) ok = 0;
+    // Result must match a plan on the default backend
+    if (ok && vv_dsp_fft_make_plan(AN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &ref) != VV_DSP_OK) ok = 0;
+    if (ok && (vv_dsp_fft_execute(autop, x, X) != VV_DSP_OK || vv_dsp_fft_execute(ref, x, R) != VV_DSP_OK)) ok = 0;
+    for (size_t k = 0; ok && k < AN / 2 + 1; ++k) {
+        if (!nearly_equal(X[k].re, R[k].re, TOL * 10) || !nearly_equal(X[k].im, R[k].im, TOL * 10)) ok = 0;
+    }
+
+    // Persist and reload the choice
+    if (ok && vv_dsp_fft_export_tuning(path) != VV_DSP_OK) ok = 0;
+    (void)vv_dsp_fft_clear_tuning();
+    if (ok && vv_dsp_fft_import_tuning(path) != VV_DSP_OK) ok = 0;
+    vv_dsp_fft_backend reloaded = VV_DSP_FFT_BACKEND_FFTS;
+    if (ok && (vv_dsp_fft_get_tuned_backend(AN, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &reloaded) != VV_DSP_OK || reloaded != chosen)) ok = 0;
+    remove(path);
+    if (vv_dsp_fft_import_tuning(path) != VV_DSP_ERROR_INTERNAL) ok = 0;
+    vv_dsp_fft_plan* bad = NULL;
+    if (vv_dsp_fft_make_plan_auto(0, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &bad) != VV_DSP_ERROR_INVALID_SIZE || bad) ok = 0;
+
+    vv_dsp_fft_destroy(autop);
+    vv_dsp_fft_destroy(ref);
+    (void)vv_dsp_fft_clear_tuning();
+    printf("  Auto-tuning: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+static int test_workspace_execute(void) {
+    printf("Testing caller-workspace execution:\n");
+    const size_t sizes[] = {16, 37, 74, 97, 1009};
+    const vv_dsp_fft_type types[] = {VV_DSP_FFT_C2C, VV_DSP_FFT_R2C, VV_DSP_FFT_C2R};
+    static vv_dsp_cpx in[1009], a[1009], b[1009];
+    int ok = 1;
+    for (size_t i = 0; i < 1009; ++i) {
+        in[i] = vv_dsp_cpx_make((vv_dsp_real)sin(0.07 * (double)i), (vv_dsp_real)cos(0.05 * (double)(i * i % 89)));
+    }
+    for (size_t si = 0; ok && si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        for (size_t ti = 0; ok && ti < 3; ++ti) {
+            const size_t n = sizes[si];
+            const vv_dsp_fft_dir dir = (types[ti] == VV_DSP_FFT_C2R) ? VV_DSP_FFT_BACKWARD : VV_DSP_FFT_FORWARD;
+            const size_t out_len = (types[ti] == VV_DSP_FFT_R2C) ? n / 2 + 1 : n;
+            vv_dsp_fft_plan* plan = NULL;
+            size_t bytes = 0;
+            if (vv_dsp_fft_make_plan(n, types[ti], dir, &plan) != VV_DSP_OK ||
+                vv_dsp_fft_workspace_size(plan, &bytes) != VV_DSP_OK) { ok = 0; break; }
+            // Fill the workspace with garbage: results must not depend on it
+            unsigned char* ws = (unsigned char*)malloc(bytes ? bytes : 1);
+            if (!ws) { ok = 0; vv_dsp_fft_destroy(plan); break; }
+            memset(ws, 0x7f, bytes);
+            const void* src = in;  // read as reals for R2C
+            if (vv_dsp_fft_execute(plan, src, a) != VV_DSP_OK ||
+                vv_dsp_fft_execute_ws(plan, src, b, ws) != VV_DSP_OK) ok = 0;
+            const vv_dsp_real* ar = (const vv_dsp_real*)a;
+            const vv_dsp_real* br = (const vv_dsp_real*)b;
+            const size_t reals = (types[ti] == VV_DSP_FFT_C2R) ? n : 2 * out_len;
+            for (size_t i = 0; ok && i < reals; ++i) {
+                if (!nearly_equal(ar[i], br[i], TOL)) ok = 0;
+            }
+            if (bytes > 0 && vv_dsp_fft_execute_ws(plan, src, b, NULL) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+            free(ws);
+            vv_dsp_fft_destroy(plan);
+        }
+    }
+    printf("  Workspace execution: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+static int test_split_execute(void) {
+    printf("Testing split-complex execution:\n");
+    const size_t sizes[] = {16, 45, 64, 97};
+    const vv_dsp_fft_type types[] = {VV_DSP_FFT_C2C, VV_DSP_FFT_C2C, VV_DSP_FFT_R2C, VV_DSP_FFT_C2R};
+    const vv_dsp_fft_dir dirs[] = {VV_DSP_FFT_FORWARD, VV_DSP_FFT_BACKWARD, VV_DSP_FFT_FORWARD, VV_DSP_FFT_BACKWARD};
+    static vv_dsp_cpx in[97], ref[97];
+    static vv_dsp_real in_re[97], in_im[97], out_re[97], out_im[97];
+    int ok = 1;
+    for (size_t si = 0; ok && si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        const size_t n = sizes[si];
+        for (size_t ti = 0; ok && ti < 4; ++ti) {
+            const vv_dsp_fft_type type = types[ti];
+            const size_t in_len = (type == VV_DSP_FFT_C2R) ? n / 2 + 1 : n;
+            const size_t out_len = (type == VV_DSP_FFT_R2C) ? n / 2 + 1 : n;
+            for (size_t i = 0; i < in_len; ++i) {
+                in_re[i] = (vv_dsp_real)sin(0.3 * (double)i + (double)ti);
+                in_im[i] = (type == VV_DSP_FFT_R2C) ? 0 : (vv_dsp_real)cos(0.11 * (double)(i * i % 31));
+                in[i] = vv_dsp_cpx_make(in_re[i], in_im[i]);
+            }
+            if (type == VV_DSP_FFT_C2R) {
+                // Hermitian endpoints must be real
+                in[0].im = in_im[0] = 0;
+                if (n % 2 == 0) in[n / 2].im = in_im[n / 2] = 0;
+            }
+            vv_dsp_fft_plan* plan = NULL;
+            if (vv_dsp_fft_make_plan(n, type, dirs[ti], &plan) != VV_DSP_OK) { ok = 0; break; }
+            const void* src = (type == VV_DSP_FFT_R2C) ? (const void*)in_re : (const void*)in;
+            if (vv_dsp_fft_execute(plan, src, ref) != VV_DSP_OK) ok = 0;
+            // Repeat to reuse any storage set up by the first split call
+            for (int rep = 0; ok && rep < 2; ++rep) {
+                if (vv_dsp_fft_execute_split(plan, in_re, type == VV_DSP_FFT_R2C ? NULL : in_im,
+                                             out_re, type == VV_DSP_FFT_C2R ? NULL : out_im) != VV_DSP_OK) ok = 0;
+            }
+            const vv_dsp_real* ref_r = (const vv_dsp_real*)ref;
+            for (size_t i = 0; ok && i < out_len; ++i) {
+                if (type == VV_DSP_FFT_C2R) {
+                    if (!nearly_equal(out_re[i], ref_r[i], TOL * 10)) ok = 0;
+                } else if (!nearly_equal(out_re[i], ref[i].re, TOL * 10) ||
+                           !nearly_equal(out_im[i], ref[i].im, TOL * 10)) {
+                    ok = 0;
+                }
+            }
+            if (type == VV_DSP_FFT_C2C &&
+                vv_dsp_fft_execute_split(plan, in_re, NULL, out_re, out_im) != VV_DSP_ERROR_NULL_POINTER) ok = 0;
+            vv_dsp_fft_destroy(plan);
+        }
+    }
+
+    // Batched plans have no split entry point
+    vv_dsp_fft_plan* many = NULL;
+    if (ok && vv_dsp_fft_make_plan_many(16, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, 2, 1, 16, 1, 16, &many) == VV_DSP_OK) {
+        if (vv_dsp_fft_execute_split(many, in_re, in_im, out_re, out_im) != VV_DSP_ERROR_UNSUPPORTED) ok = 0;
+        vv_dsp_fft_destroy(many);
+    }
+    printf("  Split execution: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+// Direct DFT of one bin in double precision, for spot-checking large transforms
+static void dft_bin(const vv_dsp_cpx* x, size_t n, size_t k, double* re, double* im) {
+    double sr = 0.0, si = 0.0;
+    for (size_t t = 0; t < n; ++t) {
+        const double ang = -2.0 * 3.14159265358979323846 * (double)((k * t) % n) / (double)n;
+        const double c = cos(ang), s = sin(ang);
+        sr += (double)x[t].re * c - (double)x[t].im * s;
+        si += (double)x[t].re * s + (double)x[t].im * c;
+    }
+    *re = sr;
+    *im = si;
+}
+
+static int test_fourstep_large(void) {
+    printf("Testing four-step FFT for large sizes:\n");
+    const size_t n = (size_t)1 << 18;
+    const size_t bins[] = {0, 1, 5, 511, 4097, 65536, 131071, 262143};
+    const size_t threads[] = {1, 4};
+    vv_dsp_cpx* x = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* y = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* z = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* ref = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    int ok = x && y && z && ref;
+    for (size_t i = 0; ok && i < n; ++i) {
+        x[i] = vv_dsp_cpx_make((vv_dsp_real)((double)((i * 7919u) % 1024u) / 512.0 - 1.0),
+                               (vv_dsp_real)((double)((i * 104729u) % 1024u) / 512.0 - 1.0));
+    }
+    // Output magnitude grows like sqrt(n); allow float rounding relative to that
+    const double tol = 1e-4 * sqrt((double)n);
+
+    if (vv_dsp_fft_set_num_threads(0) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+    for (size_t ti = 0; ok && ti < 2; ++ti) {
+        vv_dsp_fft_plan *fwd = NULL, *bwd = NULL;
+        if (vv_dsp_fft_set_num_threads(threads[ti]) != VV_DSP_OK || vv_dsp_fft_get_num_threads() != threads[ti]) ok = 0;
+        if (ok && (vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &fwd) != VV_DSP_OK ||
+                   vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_BACKWARD, &bwd) != VV_DSP_OK)) ok = 0;
+        if (ok && (vv_dsp_fft_execute(fwd, x, y) != VV_DSP_OK || vv_dsp_fft_execute(bwd, y, z) != VV_DSP_OK)) ok = 0;
+        for (size_t b = 0; ok && b < sizeof(bins) / sizeof(bins[0]); ++b) {
+            double re, im;
+            dft_bin(x, n, bins[b], &re, &im);
+            if (fabs((double)y[bins[b]].re - re) > tol || fabs((double)y[bins[b]].im - im) > tol) ok = 0;
+        }
+        for (size_t i = 0; ok && i < n; ++i) {
+            if (!nearly_equal(z[i].re, x[i].re, TOL * 10) || !nearly_equal(z[i].im, x[i].im, TOL * 10)) ok = 0;
+        }
+        // The threaded four-step result must match the single-threaded direct one
+        if (ok && ti == 0) memcpy(ref, y, n * sizeof(vv_dsp_cpx));
+        for (size_t i = 0; ok && ti > 0 && i < n; ++i) {
+            if (fabs((double)(y[i].re - ref[i].re)) > tol || fabs((double)(y[i].im - ref[i].im)) > tol) ok = 0;
+        }
+        vv_dsp_fft_destroy(fwd);
+        vv_dsp_fft_destroy(bwd);
+    }
+
+    // Even-size R2C runs a half-length complex transform, still on four threads here
+    if (ok) {
+        const size_t rn = 2 * n;
+        vv_dsp_real* r = (vv_dsp_real*)malloc(rn * sizeof(vv_dsp_real));
+        vv_dsp_cpx* R = (vv_dsp_cpx*)malloc((n + 1) * sizeof(vv_dsp_cpx));
+        vv_dsp_fft_plan* plan = NULL;
+        if (!r || !R || vv_dsp_fft_make_plan(rn, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) ok = 0;
+        for (size_t i = 0; ok && i < rn; ++i) r[i] = (vv_dsp_real)sin(0.001 * (double)i * (double)(i % 17));
+        if (ok && vv_dsp_fft_execute(plan, r, R) != VV_DSP_OK) ok = 0;
+        for (size_t b = 0; ok && b < 4; ++b) {
+            const size_t k = bins[b * 2 + 1];
+            double sr = 0.0, si = 0.0;
+            for (size_t t = 0; t < rn; ++t) {
+                const double ang = -2.0 * 3.14159265358979323846 * (double)((k * t) % rn) / (double)rn;
+                sr += (double)r[t] * cos(ang);
+                si += (double)r[t] * sin(ang);
+            }
+            if (fabs((double)R[k].re - sr) > tol * 1.5 || fabs((double)R[k].im - si) > tol * 1.5) ok = 0;
+        }
+        vv_dsp_fft_destroy(plan);
+        free(r);
+        free(R);
+    }
+
+    if (vv_dsp_fft_set_num_threads(1) != VV_DSP_OK) ok = 0;
+    (void)vv_dsp_fft_cache_clear();
+    free(x);
+    free(y);
+    free(z);
+    free(ref);
+    printf("  Four-step large FFT: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
 int main(void) {
     printf("VV-DSP FFT Backend Tests\n");
     printf("========================\n\n");
@@ -256,13 +807,34 @@ int main(void) {
 
     // Test each available backend
 #ifdef VV_DSP_BACKEND_FFT_kissfft
-    total_tests += 2;
+    total_tests += 9;
     if (test_fft_backend_basic_functionality("KissFFT")) {
         tests_passed++;
     }
     if (test_real_fft_backend("KissFFT")) {
         tests_passed++;
     }
+    if (test_real_fft_sizes()) {
+        tests_passed++;
+    }
+    if (test_plan_reuse_inplace()) {
+        tests_passed++;
+    }
+    if (test_c2c_mixed_sizes()) {
+        tests_passed++;
+    }
+    if (test_batch_execute()) {
+        tests_passed++;
+    }
+    if (test_workspace_execute()) {
+        tests_passed++;
+    }
+    if (test_fourstep_large()) {
+        tests_passed++;
+    }
+    if (test_split_execute()) {
+        tests_passed++;
+    }
     printf("\n");
 #endif
 
@@ -288,6 +860,75 @@ int main(void) {
     printf("\n");
 #endif
 
+#ifdef VV_DSP_BACKEND_FFT_cufft
+    if (vv_dsp_fft_set_backend(VV_DSP_FFT_BACKEND_CUFFT) == VV_DSP_OK) {
+        total_tests += 4;
+        if (test_fft_backend_basic_functionality("cuFFT")) {
+            tests_passed++;
+        }
+        if (test_real_fft_backend("cuFFT")) {
+            tests_passed++;
+        }
+        if (test_batch_execute()) {
+            tests_passed++;
+        }
+        if (test_cufft_spectrogram()) {
+            tests_passed++;
+        }
+        if (vv_dsp_fft_set_backend(VV_DSP_FFT_BACKEND_KISS) != VV_DSP_OK) {
+            printf("Restoring KissFFT backend: FAIL\n");
+            return 1;
+        }
+        printf("\n");
+    }
+#endif
+
+    // vDSP and PocketFFT: power-of-two and mixed sizes, shared-plan workspaces, split I/O
+#if defined(VV_DSP_BACKEND_FFT_vdsp) || defined(VV_DSP_BACKEND_FFT_pocketfft)
+    {
+        const vv_dsp_fft_backend extra[2] = {VV_DSP_FFT_BACKEND_VDSP, VV_DSP_FFT_BACKEND_POCKETFFT};
+        const char* extra_names[2] = {"vDSP", "PocketFFT"};
+        for (int b = 0; b < 2; ++b) {
+            if (vv_dsp_fft_set_backend(extra[b]) != VV_DSP_OK) continue;
+            total_tests += 5;
+            if (test_fft_backend_basic_functionality(extra_names[b])) {
+                tests_passed++;
+            }
+            if (test_real_fft_backend(extra_names[b])) {
+                tests_passed++;
+            }
+            if (test_real_fft_sizes()) {
+                tests_passed++;
+            }
+            if (test_workspace_execute()) {
+                tests_passed++;
+            }
+            if (test_split_execute()) {
+                tests_passed++;
+            }
+            printf("\n");
+        }
+        if (vv_dsp_fft_set_backend(VV_DSP_FFT_BACKEND_KISS) != VV_DSP_OK) {
+            printf("Restoring KissFFT backend: FAIL\n");
+            return 1;
+        }
+    }
+#endif
+
+    total_tests++;
+    if (test_plan_cache()) {
+        tests_passed++;
+    }
+    total_tests++;
+    if (test_prewarm_and_wisdom()) {
+        tests_passed++;
+    }
+    total_tests++;
+    if (test_auto_tuning()) {
+        tests_passed++;
+    }
+    printf("\n");
+
     printf("Summary: %d/%d tests passed\n", tests_passed, total_tests);
 
     if (tests_passed == total_tests) {
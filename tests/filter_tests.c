@@ -80,12 +80,397 @@ static void test_filtfilt_basic(void) {
     assert(fabsf(m) < 0.2f);
 }
 
+// Streaming direct-form FIR against a textbook convolution, with uneven block
+// sizes so blocks straddle the staging boundary, and in place
+static void test_fir_apply_streaming(void) {
+    enum { LEN = 3000 };
+    const size_t taps[] = {1, 5, 127, 511, 700};
+    static vv_dsp_real x[LEN], y[LEN], yi[LEN];
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)(sin(0.013 * (double)i) + 0.25 * cos(1.7 * (double)i));
+    for (size_t t = 0; t < sizeof(taps) / sizeof(taps[0]); ++t) {
+        const size_t L = taps[t];
+        vv_dsp_real h[700];
+        for (size_t k = 0; k < L; ++k) h[k] = (vv_dsp_real)(1.0 / (1.0 + (double)k) * ((k % 3) ? 1.0 : -0.5));
+        vv_dsp_fir_state st, sti;
+        assert(vv_dsp_fir_state_init(&st, L) == VV_DSP_OK);
+        assert(vv_dsp_fir_state_init(&sti, L) == VV_DSP_OK);
+        memcpy(yi, x, sizeof(x));
+        size_t pos = 0, blk = 1;
+        while (pos < LEN) {
+            const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+            assert(vv_dsp_fir_apply(&st, h, x + pos, y + pos, n) == VV_DSP_OK);
+            assert(vv_dsp_fir_apply(&sti, h, yi + pos, yi + pos, n) == VV_DSP_OK);
+            pos += n;
+            blk = blk * 3 + 7; if (blk > 900) blk = 5;
+        }
+        for (size_t i = 0; i < LEN; ++i) {
+            double ref = 0;
+            for (size_t k = 0; k < L && k <= i; ++k) ref += (double)h[k] * (double)x[i - k];
+            assert(fabs((double)y[i] - ref) < 1e-3);
+            assert(y[i] == yi[i]);
+        }
+        vv_dsp_fir_state_free(&st);
+        vv_dsp_fir_state_free(&sti);
+    }
+}
+
+// Overlap-save convolver matches the direct-form stream for any call size, in place
+static void test_fft_convolver_stream(void) {
+    enum { LEN = 12000 };
+    const size_t taps[] = {1, 33, 4097};
+    const size_t blocks[] = {0, 64, 1000};
+    static vv_dsp_real x[LEN], yd[LEN], yc[LEN], h[4097];
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)(sin(0.021 * (double)i) + 0.3 * cos(2.3 * (double)i));
+    for (size_t t = 0; t < sizeof(taps) / sizeof(taps[0]); ++t) {
+        const size_t L = taps[t];
+        for (size_t k = 0; k < L; ++k) h[k] = (vv_dsp_real)(exp(-(double)k / 600.0) * ((k % 2) ? 0.01 : -0.02));
+        vv_dsp_fir_state st;
+        assert(vv_dsp_fir_state_init(&st, L) == VV_DSP_OK);
+        assert(vv_dsp_fir_apply(&st, h, x, yd, LEN) == VV_DSP_OK);
+        vv_dsp_fir_state_free(&st);
+        vv_dsp_fft_convolver* conv = NULL;
+        assert(vv_dsp_fft_convolver_create(h, L, blocks[t], &conv) == VV_DSP_OK);
+        assert(vv_dsp_fft_convolver_block_size(conv) + L - 1 == vv_dsp_fft_convolver_fft_size(conv));
+        for (int pass = 0; pass < 2; ++pass) {
+            memcpy(yc, x, sizeof(x));
+            size_t pos = 0, blk = 7;
+            while (pos < LEN) {
+                const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+                assert(vv_dsp_fft_convolver_process(conv, yc + pos, yc + pos, n) == VV_DSP_OK);
+                pos += n;
+                blk = blk * 5 + 3; if (blk > 9000) blk = 1;
+            }
+            for (size_t i = 0; i < LEN; ++i) assert(fabs((double)yc[i] - (double)yd[i]) < 1e-4);
+            assert(vv_dsp_fft_convolver_reset(conv) == VV_DSP_OK);
+        }
+        vv_dsp_fft_convolver_destroy(conv);
+    }
+    vv_dsp_fft_convolver* conv = NULL;
+    assert(vv_dsp_fft_convolver_create(h, 0, 0, &conv) == VV_DSP_ERROR_INVALID_SIZE && conv == NULL);
+    (void)conv;
+}
+
+// Direct and FFT paths of the shared dispatch agree for the whole-buffer convolution,
+// streaming FIR, filtfilt and Savitzky-Golay users
+static void test_conv_dispatch(void) {
+    enum { LEN = 5000 };
+    static vv_dsp_real x[LEN + 400], h[301], ref[LEN], yd[LEN], yf[LEN];
+    for (size_t i = 0; i < LEN + 400; ++i) x[i] = (vv_dsp_real)(sin(0.013 * (double)i) + 0.4 * cos(1.7 * (double)i));
+    const size_t taps[] = {5, 301};
+    for (size_t t = 0; t < sizeof(taps) / sizeof(taps[0]); ++t) {
+        const size_t L = taps[t];
+        for (size_t k = 0; k < L; ++k) h[k] = (vv_dsp_real)(0.5 / (double)(k + 1) * ((k % 3) ? 1.0 : -1.0));
+        for (size_t i = 0; i < LEN; ++i) {
+            double acc = 0.0;
+            for (size_t k = 0; k < L; ++k) acc += (double)h[k] * (double)x[i + L - 1 - k];
+            ref[i] = (vv_dsp_real)acc;
+        }
+        vv_dsp_conv_set_crossover(1);
+        assert(vv_dsp_conv_select(L, LEN) == VV_DSP_CONV_FFT);
+        assert(vv_dsp_conv_select(L, L - 1) == VV_DSP_CONV_DIRECT);
+        assert(vv_dsp_convolve_valid(h, L, x, LEN, yf) == VV_DSP_OK);
+        vv_dsp_conv_set_crossover((size_t)-1);
+        assert(vv_dsp_conv_select(L, LEN) == VV_DSP_CONV_DIRECT);
+        assert(vv_dsp_convolve_valid(h, L, x, LEN, yd) == VV_DSP_OK);
+        for (size_t i = 0; i < LEN; ++i) {
+            assert(fabs((double)yd[i] - (double)ref[i]) < 1e-4);
+            assert(fabs((double)yf[i] - (double)ref[i]) < 1e-4);
+        }
+
+        // Streaming FIR in uneven calls
+        for (int fft = 0; fft < 2; ++fft) {
+            vv_dsp_conv_set_crossover(fft ? 1 : (size_t)-1);
+            vv_dsp_fir_state st;
+            assert(vv_dsp_fir_state_init(&st, L) == VV_DSP_OK);
+            size_t pos = 0, blk = 3;
+            while (pos < LEN) {
+                const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+                assert(vv_dsp_fir_apply(&st, h, x + pos, fft ? yf + pos : yd + pos, n) == VV_DSP_OK);
+                pos += n;
+                blk = blk * 3 + 1; if (blk > 2000) blk = 1;
+            }
+            vv_dsp_fir_state_free(&st);
+        }
+        for (size_t i = 0; i < LEN; ++i) assert(fabs((double)yf[i] - (double)yd[i]) < 1e-4);
+
+        vv_dsp_conv_set_crossover(1);
+        assert(vv_dsp_filtfilt_fir(h, L, x, yf, LEN) == VV_DSP_OK);
+        vv_dsp_conv_set_crossover((size_t)-1);
+        assert(vv_dsp_filtfilt_fir(h, L, x, yd, LEN) == VV_DSP_OK);
+        for (size_t i = 0; i < LEN; ++i) assert(fabs((double)yf[i] - (double)yd[i]) < 1e-3);
+    }
+
+    vv_dsp_conv_set_crossover(1);
+    assert(vv_dsp_savgol(x, LEN, 201, 3, 0, (vv_dsp_real)1, VV_DSP_SAVGOL_MODE_REFLECT, yf) == VV_DSP_OK);
+    vv_dsp_conv_set_crossover((size_t)-1);
+    assert(vv_dsp_savgol(x, LEN, 201, 3, 0, (vv_dsp_real)1, VV_DSP_SAVGOL_MODE_REFLECT, yd) == VV_DSP_OK);
+    for (size_t i = 0; i < LEN; ++i) assert(fabs((double)yf[i] - (double)yd[i]) < 1e-4);
+    vv_dsp_conv_set_crossover(0);
+    assert(vv_dsp_convolve_valid(h, 0, x, LEN, yd) == VV_DSP_ERROR_INVALID_SIZE);
+    (void)ref; (void)yd; (void)yf;
+}
+
+// Partitioned engine equals the direct-form output delayed by block_size, for the
+// uniform schedule and the non-uniform one computed inline or on the worker thread
+static void test_partconv_schedules(void) {
+    enum { LEN = 40000, L = 9000, B = 64 };
+    static vv_dsp_real x[LEN], yd[LEN], yp[LEN], h[L];
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)(sin(0.017 * (double)i) + 0.5 * cos(2.9 * (double)i));
+    for (size_t k = 0; k < L; ++k) h[k] = (vv_dsp_real)(exp(-(double)k / 2000.0) * ((k * 7919u) % 17u == 0 ? 0.05 : -0.002));
+    vv_dsp_fft_convolver* ref = NULL;
+    assert(vv_dsp_fft_convolver_create(h, L, 4096, &ref) == VV_DSP_OK);
+    assert(vv_dsp_fft_convolver_process(ref, x, yd, LEN) == VV_DSP_OK);
+    vv_dsp_fft_convolver_destroy(ref);
+    const vv_dsp_partconv_params prms[] = { {B, 0, 0}, {B, 4096, 0}, {B, 4096, 1}, {B, 1 << 20, 1} };
+    const size_t stages[] = {1, 4, 4, 4};
+    for (size_t c = 0; c < sizeof(prms) / sizeof(prms[0]); ++c) {
+        vv_dsp_partconv* pc = NULL;
+        assert(vv_dsp_partconv_create(h, L, &prms[c], &pc) == VV_DSP_OK);
+        assert(vv_dsp_partconv_num_stages(pc) == stages[c]);
+        assert(vv_dsp_partconv_latency(pc) == B);
+        for (int pass = 0; pass < 2; ++pass) {
+            memcpy(yp, x, sizeof(x));
+            size_t pos = 0, blk = 1;
+            while (pos < LEN) {
+                const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+                assert(vv_dsp_partconv_process(pc, yp + pos, yp + pos, n) == VV_DSP_OK);
+                pos += n;
+                blk = blk * 3 + 1; if (blk > 3000) blk = 2;
+            }
+            for (size_t i = 0; i < LEN; ++i) {
+                const double want = (i >= B) ? (double)yd[i - B] : 0.0;
+                assert(fabs((double)yp[i] - want) < 1e-4);
+            }
+            assert(vv_dsp_partconv_reset(pc) == VV_DSP_OK);
+        }
+        vv_dsp_partconv_destroy(pc);
+    }
+    const vv_dsp_partconv_params bad = {48, 0, 0};
+    vv_dsp_partconv* pc = NULL;
+    assert(vv_dsp_partconv_create(h, L, &bad, &pc) == VV_DSP_ERROR_INVALID_SIZE && pc == NULL);
+    (void)pc; (void)stages;
+}
+
+// Polyphase decimator equals filtering at full rate and keeping every factor-th output;
+// the interpolator equals zero-stuffing then filtering
+static void test_polyphase_rate_change(void) {
+    enum { LEN = 2400, MAXF = 5 };
+    const size_t factors[] = {1, 2, 3, 5};
+    static vv_dsp_real x[LEN], full[LEN * MAXF], stuffed[LEN * MAXF], y[LEN * MAXF];
+    vv_dsp_real h[61];
+    assert(vv_dsp_fir_design_lowpass(h, 61, (vv_dsp_real)0.3, VV_DSP_WINDOW_HAMMING) == VV_DSP_OK);
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.2 * cos(1.1 * (double)i));
+    for (size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); ++f) {
+        const size_t M = factors[f];
+        vv_dsp_fir_state st;
+        assert(vv_dsp_fir_state_init(&st, 61) == VV_DSP_OK);
+        assert(vv_dsp_fir_apply(&st, h, x, full, LEN) == VV_DSP_OK);
+        vv_dsp_fir_state_free(&st);
+
+        vv_dsp_fir_decimator* dec = NULL;
+        assert(vv_dsp_fir_decimator_create(h, 61, M, &dec) == VV_DSP_OK);
+        memcpy(y, x, sizeof(x));
+        size_t pos = 0, made = 0, blk = 1;
+        while (pos < LEN) {
+            const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+            const size_t want = vv_dsp_fir_decimator_output_count(dec, n);
+            size_t got = 0;
+            if (want > 0) assert(vv_dsp_fir_decimator_process(dec, y + pos, n, y + made, want - 1, &got) == VV_DSP_ERROR_INVALID_SIZE);
+            assert(vv_dsp_fir_decimator_process(dec, y + pos, n, y + made, want, &got) == VV_DSP_OK && got == want);
+            pos += n; made += got;
+            blk = blk * 2 + 1; if (blk > 700) blk = 3;
+        }
+        assert(made == (LEN + M - 1) / M);
+        for (size_t m = 0; m < made; ++m) assert(fabs((double)y[m] - (double)full[m * M]) < 1e-5);
+        vv_dsp_fir_decimator_destroy(dec);
+
+        assert(vv_dsp_fir_state_init(&st, 61) == VV_DSP_OK);
+        memset(stuffed, 0, sizeof(stuffed));
+        for (size_t i = 0; i < LEN; ++i) stuffed[i * M] = x[i];
+        assert(vv_dsp_fir_apply(&st, h, stuffed, full, LEN * M) == VV_DSP_OK);
+        vv_dsp_fir_state_free(&st);
+        vv_dsp_fir_interpolator* up = NULL;
+        assert(vv_dsp_fir_interpolator_create(h, 61, M, &up) == VV_DSP_OK);
+        pos = 0; blk = 2;
+        while (pos < LEN) {
+            const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+            assert(vv_dsp_fir_interpolator_process(up, x + pos, n, y + pos * M) == VV_DSP_OK);
+            pos += n;
+            blk = blk * 3; if (blk > 900) blk = 1;
+        }
+        for (size_t i = 0; i < LEN * M; ++i) assert(fabs((double)y[i] - (double)full[i]) < 1e-5);
+        vv_dsp_fir_interpolator_destroy(up);
+    }
+}
+
+// SoA biquad bank equals one vv_dsp_iir_apply() cascade per channel, across vector and
+// scalar-tail channels, chunked and in place
+static void test_biquad_bank_channels(void) {
+    enum { C = 21, S = 3, LEN = 997 };
+    static vv_dsp_real x[LEN * C], y[LEN * C], ch_in[LEN], ch_out[LEN];
+    for (size_t i = 0; i < LEN * C; ++i) x[i] = (vv_dsp_real)sin(0.011 * (double)i + 0.3 * (double)(i % C));
+    vv_dsp_biquad_bank* bank = NULL;
+    assert(vv_dsp_biquad_bank_create(C, S, &bank) == VV_DSP_OK);
+    assert(vv_dsp_biquad_bank_set_stage(bank, 0, (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2, (vv_dsp_real)-0.6, (vv_dsp_real)0.2) == VV_DSP_OK);
+    assert(vv_dsp_biquad_bank_set_stage(bank, 2, (vv_dsp_real)0.9, (vv_dsp_real)-1.2, (vv_dsp_real)0.5, (vv_dsp_real)-1.1, (vv_dsp_real)0.45) == VV_DSP_OK);
+    for (size_t c = 0; c < C; ++c) {
+        const vv_dsp_real g = (vv_dsp_real)(0.5 + 0.02 * (double)c);
+        assert(vv_dsp_biquad_bank_set_channel_stage(bank, c, 1, g, 0, 0, (vv_dsp_real)(-0.3 + 0.01 * (double)c), 0) == VV_DSP_OK);
+    }
+    assert(vv_dsp_biquad_bank_set_stage(bank, S, 1, 0, 0, 0, 0) == VV_DSP_ERROR_OUT_OF_RANGE);
+    for (int pass = 0; pass < 2; ++pass) {
+        memcpy(y, x, sizeof(x));
+        size_t pos = 0, blk = 1;
+        while (pos < LEN) {
+            const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+            assert(vv_dsp_biquad_bank_process(bank, y + pos * C, y + pos * C, n) == VV_DSP_OK);
+            pos += n;
+            blk = blk * 4 + 1; if (blk > 400) blk = 2;
+        }
+        for (size_t c = 0; c < C; ++c) {
+            vv_dsp_biquad bq[S];
+            vv_dsp_biquad_init(&bq[0], (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2, (vv_dsp_real)-0.6, (vv_dsp_real)0.2);
+            vv_dsp_biquad_init(&bq[1], (vv_dsp_real)(0.5 + 0.02 * (double)c), 0, 0, (vv_dsp_real)(-0.3 + 0.01 * (double)c), 0);
+            vv_dsp_biquad_init(&bq[2], (vv_dsp_real)0.9, (vv_dsp_real)-1.2, (vv_dsp_real)0.5, (vv_dsp_real)-1.1, (vv_dsp_real)0.45);
+            for (size_t t = 0; t < LEN; ++t) ch_in[t] = x[t * C + c];
+            assert(vv_dsp_iir_apply(bq, S, ch_in, ch_out, LEN) == VV_DSP_OK);
+            for (size_t t = 0; t < LEN; ++t) assert(fabs((double)y[t * C + c] - (double)ch_out[t]) < 1e-4);
+        }
+        assert(vv_dsp_biquad_bank_reset(bank) == VV_DSP_OK);
+    }
+    vv_dsp_biquad_bank_destroy(bank);
+}
+
+// Batch of clips through one cascade equals vv_dsp_iir_apply() on a copy of the
+// sections per clip, started from their state, for any worker count and in place
+static void test_iir_apply_batch(void) {
+    enum { M = 45, S = 2, MAXLEN = 1300 };
+    static vv_dsp_real x[M][MAXLEN], y[M][MAXLEN], ref[MAXLEN];
+    const vv_dsp_real* in[M];
+    vv_dsp_real* out[M];
+    size_t len[M];
+    vv_dsp_biquad bq[S], work[S];
+    vv_dsp_biquad_init(&bq[0], (vv_dsp_real)0.0675, (vv_dsp_real)0.135, (vv_dsp_real)0.0675, (vv_dsp_real)-1.143, (vv_dsp_real)0.4128);
+    vv_dsp_biquad_init(&bq[1], (vv_dsp_real)1.0, (vv_dsp_real)-1.6, (vv_dsp_real)0.8, (vv_dsp_real)-1.85, (vv_dsp_real)0.97);
+    bq[1].z1 = (vv_dsp_real)0.25;
+    for (size_t i = 0; i < M; ++i) {
+        len[i] = i % 9 == 0 ? 0 : (i == 3 ? 1 : (i * 7919u) % MAXLEN + 1);
+        for (size_t t = 0; t < MAXLEN; ++t) x[i][t] = (vv_dsp_real)sin(0.02 * (double)t * (double)(1 + i % 6) + (double)i);
+        in[i] = x[i];
+        out[i] = y[i];
+    }
+    for (size_t threads = 0; threads < 3; threads += 2) {
+        memset(y, 0, sizeof(y));
+        assert(vv_dsp_iir_apply_batch(bq, S, in, out, len, M, threads) == VV_DSP_OK);
+        for (size_t i = 0; i < M; ++i) {
+            memcpy(work, bq, sizeof(bq));
+            assert(vv_dsp_iir_apply(work, S, x[i], ref, len[i]) == VV_DSP_OK);
+            for (size_t t = 0; t < len[i]; ++t) assert(fabs((double)y[i][t] - (double)ref[t]) < 1e-4);
+            for (size_t t = len[i]; t < MAXLEN; ++t) assert(y[i][t] == 0);
+        }
+    }
+    assert(bq[1].z1 == (vv_dsp_real)0.25);
+    // In place
+    memcpy(y, x, sizeof(x));
+    for (size_t i = 0; i < M; ++i) in[i] = y[i];
+    assert(vv_dsp_iir_apply_batch(bq, S, in, out, len, M, 0) == VV_DSP_OK);
+    for (size_t i = 0; i < M; ++i) {
+        memcpy(work, bq, sizeof(bq));
+        assert(vv_dsp_iir_apply(work, S, x[i], ref, len[i]) == VV_DSP_OK);
+        for (size_t t = 0; t < len[i]; ++t) assert(fabs((double)y[i][t] - (double)ref[t]) < 1e-4);
+    }
+    assert(vv_dsp_iir_apply_batch(bq, 0, in, out, len, M, 0) == VV_DSP_ERROR_INVALID_SIZE);
+    assert(vv_dsp_iir_apply_batch(NULL, S, in, out, len, M, 0) == VV_DSP_ERROR_NULL_POINTER);
+}
+
+// Both IIR plan realizations track the direct cascade, including a high-Q section
+static void test_iir_plan_realizations(void) {
+    enum { S = 3, LEN = 5003 };
+    static vv_dsp_real x[LEN], ref[LEN], y[LEN];
+    vv_dsp_biquad bq[S], work[S];
+    vv_dsp_biquad_init(&bq[0], (vv_dsp_real)0.0675, (vv_dsp_real)0.135, (vv_dsp_real)0.0675, (vv_dsp_real)-1.143, (vv_dsp_real)0.4128);
+    vv_dsp_biquad_init(&bq[1], (vv_dsp_real)1.0, (vv_dsp_real)-1.6, (vv_dsp_real)0.8, (vv_dsp_real)-1.85, (vv_dsp_real)0.97);
+    vv_dsp_biquad_init(&bq[2], (vv_dsp_real)0.5, (vv_dsp_real)0.0, (vv_dsp_real)-0.5, (vv_dsp_real)0.2, (vv_dsp_real)0.1);
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)(sin(0.03 * (double)i) + (double)((i * 2654435761u) % 1000u) / 2000.0);
+    memcpy(work, bq, sizeof(bq));
+    assert(vv_dsp_iir_apply(work, S, x, ref, LEN) == VV_DSP_OK);
+    double peak = 0;
+    for (size_t i = 0; i < LEN; ++i) if (fabs((double)ref[i]) > peak) peak = fabs((double)ref[i]);
+    const vv_dsp_iir_realization kinds[] = { VV_DSP_IIR_REALIZATION_CASCADE, VV_DSP_IIR_REALIZATION_BLOCK };
+    for (size_t r = 0; r < 2; ++r) {
+        vv_dsp_iir_plan* plan = NULL;
+        assert(vv_dsp_iir_make_plan(bq, S, kinds[r], &plan) == VV_DSP_OK);
+        for (int pass = 0; pass < 2; ++pass) {
+            memcpy(y, x, sizeof(x));
+            size_t pos = 0, blk = 1;
+            while (pos < LEN) {
+                const size_t n = (LEN - pos < blk) ? LEN - pos : blk;
+                assert(vv_dsp_iir_plan_apply(plan, y + pos, y + pos, n) == VV_DSP_OK);
+                pos += n;
+                blk = blk * 3 + 2; if (blk > 1500) blk = 5;
+            }
+            for (size_t i = 0; i < LEN; ++i) assert(fabs((double)y[i] - (double)ref[i]) < 1e-4 * peak);
+            assert(vv_dsp_iir_plan_reset(plan) == VV_DSP_OK);
+        }
+        vv_dsp_iir_plan_destroy(plan);
+    }
+    vv_dsp_iir_plan* plan = NULL;
+    assert(vv_dsp_iir_make_plan(bq, S, (vv_dsp_iir_realization)7, &plan) == VV_DSP_ERROR_OUT_OF_RANGE);
+    (void)plan; (void)kinds; (void)peak;
+}
+
+// Forward-backward IIR: steady-state starts leave a constant untouched by transients,
+// a passband tone comes out with zero phase and |H|^2 gain, in-place equals out-of-place
+static void test_filtfilt_iir_zero_phase(void) {
+    enum { LEN = 3000, S = 2 };
+    static vv_dsp_real x[LEN], y[LEN], yi[LEN];
+    vv_dsp_biquad bq[S];
+    // Two sections of a 4th-order Butterworth lowpass at 0.1 * Nyquist
+    vv_dsp_biquad_init(&bq[0], (vv_dsp_real)4.16599e-4, (vv_dsp_real)8.33198e-4, (vv_dsp_real)4.16599e-4, (vv_dsp_real)-1.47967, (vv_dsp_real)0.55734);
+    vv_dsp_biquad_init(&bq[1], (vv_dsp_real)1.0, (vv_dsp_real)2.0, (vv_dsp_real)1.0, (vv_dsp_real)-1.70096, (vv_dsp_real)0.78849);
+    double g = 1.0;
+    for (size_t s = 0; s < S; ++s) g *= (double)(bq[s].b0 + bq[s].b1 + bq[s].b2) / (double)(1 + bq[s].a1 + bq[s].a2);
+
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)0.75;
+    assert(vv_dsp_filtfilt_iir(bq, S, x, y, LEN, VV_DSP_FILTFILT_DEFAULT_PAD) == VV_DSP_OK);
+    for (size_t i = 0; i < LEN; ++i) assert(fabs((double)y[i] - 0.75 * g * g) < 1e-4);
+
+    // Tone at 0.02 * Nyquist: H(w) from the sections, compared in the middle of the signal
+    const double w = 0.02 * 3.14159265358979323846;
+    double mag2 = 1.0;
+    for (size_t s = 0; s < S; ++s) {
+        const double nr = (double)bq[s].b0 + (double)bq[s].b1 * cos(w) + (double)bq[s].b2 * cos(2 * w);
+        const double ni = -(double)bq[s].b1 * sin(w) - (double)bq[s].b2 * sin(2 * w);
+        const double dr = 1 + (double)bq[s].a1 * cos(w) + (double)bq[s].a2 * cos(2 * w);
+        const double di = -(double)bq[s].a1 * sin(w) - (double)bq[s].a2 * sin(2 * w);
+        mag2 *= (nr * nr + ni * ni) / (dr * dr + di * di);
+    }
+    for (size_t i = 0; i < LEN; ++i) x[i] = (vv_dsp_real)sin(w * (double)i + 0.4);
+    assert(vv_dsp_filtfilt_iir(bq, S, x, y, LEN, 60) == VV_DSP_OK);
+    for (size_t i = 500; i < LEN - 500; ++i) assert(fabs((double)y[i] - mag2 * (double)x[i]) < 2e-3);
+    memcpy(yi, x, sizeof(x));
+    assert(vv_dsp_filtfilt_iir(bq, S, yi, yi, LEN, 60) == VV_DSP_OK);
+    for (size_t i = 0; i < LEN; ++i) assert(yi[i] == y[i]);
+    // Padding longer than the signal is clamped
+    assert(vv_dsp_filtfilt_iir(bq, S, x, y, 5, 100) == VV_DSP_OK);
+    (void)g; (void)mag2;
+}
+
 int main(void){
     test_fir_design_basic();
     test_fir_apply_impulse();
+    test_fir_apply_streaming();
+    test_fft_convolver_stream();
+    test_conv_dispatch();
+    test_partconv_schedules();
+    test_polyphase_rate_change();
     test_biquad_init_reset_process();
     test_iir_apply_two_stage();
+    test_biquad_bank_channels();
+    test_iir_apply_batch();
+    test_iir_plan_realizations();
     test_filtfilt_basic();
+    test_filtfilt_iir_zero_phase();
     printf("filter tests passed\n");
     return 0;
 }
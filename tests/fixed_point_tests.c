@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+static int test_conversions(void) {
+    const vv_dsp_real r[6] = {0, (vv_dsp_real)0.5, (vv_dsp_real)-0.25, (vv_dsp_real)1.5, (vv_dsp_real)-2.0,
+                              (vv_dsp_real)(1.0 / 32768.0)};
+    vv_dsp_q15 q[6];
+    if (vv_dsp_real_to_q15(r, q, 6) != VV_DSP_OK) return 0;
+    if (q[0] != 0 || q[1] != 16384 || q[2] != -8192 || q[3] != INT16_MAX || q[4] != INT16_MIN || q[5] != 1) return 0;
+    vv_dsp_real back[6];
+    if (vv_dsp_q15_to_real(q, back, 6) != VV_DSP_OK) return 0;
+    if (fabs((double)back[1] - 0.5) > 1e-6 || fabs((double)back[4] + 1.0) > 1e-6) return 0;
+    vv_dsp_q31 w[6];
+    if (vv_dsp_real_to_q31(r, w, 6) != VV_DSP_OK) return 0;
+    if (w[1] != (1 << 30) || w[3] != INT32_MAX || w[4] != INT32_MIN || w[5] != (1 << 16)) return 0;
+    if (vv_dsp_q31_to_real(w, back, 6) != VV_DSP_OK) return 0;
+    if (fabs((double)back[2] + 0.25) > 1e-6) return 0;
+    if (vv_dsp_real_to_q15(NULL, q, 1) != VV_DSP_ERROR_NULL_POINTER) return 0;
+    return 1;
+}
+
+static vv_dsp_q15 ref_q15(const vv_dsp_q15* h, size_t L, const vv_dsp_q15* x, size_t t) {
+    int64_t acc = 0;
+    for (size_t k = 0; k < L && k <= t; ++k) acc += (int64_t)h[k] * x[t - k];
+    const int64_t v = (acc + (1 << 14)) >> 15;
+    return (vv_dsp_q15)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+// Streams x through a Q15 FIR in uneven blocks, in place, and compares bit for bit
+static int check_fir_q15(const vv_dsp_q15* h, size_t L, const vv_dsp_q15* x, size_t n) {
+    vv_dsp_fir_q15* f = NULL;
+    if (vv_dsp_fir_q15_create(h, L, &f) != VV_DSP_OK) return 0;
+    vv_dsp_q15* y = (vv_dsp_q15*)malloc(n * sizeof(vv_dsp_q15));
+    int ok = 1;
+    for (size_t i = 0; i < n; ++i) y[i] = x[i];
+    const size_t blocks[5] = {1, 37, 600, 5, 1000};
+    size_t pos = 0, b = 0;
+    while (pos < n) {
+        size_t c = blocks[b++ % 5];
+        if (c > n - pos) c = n - pos;
+        if (vv_dsp_fir_q15_process(f, y + pos, y + pos, c) != VV_DSP_OK) ok = 0;
+        pos += c;
+    }
+    for (size_t t = 0; t < n && ok; ++t) {
+        if (y[t] != ref_q15(h, L, x, t)) {
+            fprintf(stderr, "q15 fir (L=%zu) mismatch at %zu: %d vs %d\n", L, t, y[t], ref_q15(h, L, x, t));
+            ok = 0;
+        }
+    }
+    // After reset the history is clear again
+    if (ok && vv_dsp_fir_q15_reset(f) == VV_DSP_OK) {
+        vv_dsp_q15 y0;
+        if (vv_dsp_fir_q15_process(f, x, &y0, 1) != VV_DSP_OK || y0 != ref_q15(h, L, x, 0)) ok = 0;
+    }
+    free(y);
+    vv_dsp_fir_q15_destroy(f);
+    return ok;
+}
+
+static int test_fir_q15(void) {
+    enum { N = 3000 };
+    vv_dsp_q15 x[N];
+    uint32_t s = 12345u;
+    for (size_t i = 0; i < N; ++i) {
+        s = s * 1664525u + 1013904223u;
+        x[i] = (vv_dsp_q15)(int16_t)(s >> 16);  // full-scale noise
+    }
+    // Unity-gain lowpass (fast path), odd length
+    vv_dsp_q15 lp[45];
+    double sum = 0.0;
+    for (size_t k = 0; k < 45; ++k) sum += 0.54 - 0.46 * cos(2.0 * VV_DSP_PI_D * (double)k / 44.0);
+    for (size_t k = 0; k < 45; ++k)
+        lp[k] = (vv_dsp_q15)floor(32767.0 * (0.54 - 0.46 * cos(2.0 * VV_DSP_PI_D * (double)k / 44.0)) / sum);
+    if (!check_fir_q15(lp, 45, x, N)) return 0;
+    // High-gain taps (wide path) that saturate
+    vv_dsp_q15 hg[7] = {20000, -30000, 32767, 12000, -32768, 9000, 15000};
+    if (!check_fir_q15(hg, 7, x, N)) return 0;
+    vv_dsp_q15 one = INT16_MAX;
+    if (!check_fir_q15(&one, 1, x, N)) return 0;
+    vv_dsp_fir_q15* f = NULL;
+    if (vv_dsp_fir_q15_create(lp, 0, &f) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    return 1;
+}
+
+// Q31 FIR against the floating-point FIR on a lowpass
+static int test_fir_q31(void) {
+    enum { N = 2000, L = 31 };
+    vv_dsp_real hr[L], xr[N], yr[N];
+    vv_dsp_q31 h[L], x[N], y[N];
+    for (size_t k = 0; k < L; ++k) {
+        const double m = (double)k - (L - 1) / 2.0;
+        hr[k] = (vv_dsp_real)(m == 0.0 ? 0.25 : sin(0.25 * VV_DSP_PI_D * m) / (VV_DSP_PI_D * m));
+    }
+    for (size_t i = 0; i < N; ++i) xr[i] = (vv_dsp_real)(0.6 * sin(0.013 * (double)i) + 0.3 * sin(1.9 * (double)i));
+    if (vv_dsp_real_to_q31(hr, h, L) != VV_DSP_OK || vv_dsp_real_to_q31(xr, x, N) != VV_DSP_OK) return 0;
+    vv_dsp_fir_state st;
+    if (vv_dsp_fir_state_init(&st, L) != VV_DSP_OK) return 0;
+    if (vv_dsp_fir_apply(&st, hr, xr, yr, N) != VV_DSP_OK) return 0;
+    vv_dsp_fir_state_free(&st);
+    vv_dsp_fir_q31* f = NULL;
+    if (vv_dsp_fir_q31_create(h, L, &f) != VV_DSP_OK) return 0;
+    if (vv_dsp_fir_q31_process(f, x, y, 700) != VV_DSP_OK ||
+        vv_dsp_fir_q31_process(f, x + 700, y + 700, N - 700) != VV_DSP_OK) return 0;
+    vv_dsp_fir_q31_destroy(f);
+    vv_dsp_real yq[N];
+    if (vv_dsp_q31_to_real(y, yq, N) != VV_DSP_OK) return 0;
+    for (size_t i = 0; i < N; ++i) {
+        if (fabs((double)yq[i] - (double)yr[i]) > 1e-5) {
+            fprintf(stderr, "q31 fir mismatch at %zu: %g vs %g\n", i, (double)yq[i], (double)yr[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Two-section Q31 cascade (resonant lowpass, peaking boost) against the float cascade
+static int test_biquad_q31(void) {
+    enum { N = 4000 };
+    const vv_dsp_real c[2][5] = {
+        {(vv_dsp_real)0.0036216815, (vv_dsp_real)0.007243363, (vv_dsp_real)0.0036216815,
+         (vv_dsp_real)-1.8226949, (vv_dsp_real)0.8371816},
+        {(vv_dsp_real)1.0472, (vv_dsp_real)-1.8811, (vv_dsp_real)0.8566,
+         (vv_dsp_real)-1.8811, (vv_dsp_real)0.9038},
+    };
+    vv_dsp_biquad fb[2];
+    vv_dsp_biquad_q31* qb = NULL;
+    if (vv_dsp_biquad_q31_create(2, 1, &qb) != VV_DSP_OK) return 0;
+    for (size_t s = 0; s < 2; ++s) {
+        if (vv_dsp_biquad_init(&fb[s], c[s][0], c[s][1], c[s][2], c[s][3], c[s][4]) != VV_DSP_OK) return 0;
+        if (vv_dsp_biquad_q31_set_stage(qb, s, c[s][0], c[s][1], c[s][2], c[s][3], c[s][4]) != VV_DSP_OK) return 0;
+    }
+    vv_dsp_real xr[N], yr[N], yq[N];
+    vv_dsp_q31 xq[N];
+    for (size_t i = 0; i < N; ++i) xr[i] = (vv_dsp_real)(0.4 * sin(0.02 * (double)i) + 0.2 * sin(0.7 * (double)i));
+    if (vv_dsp_iir_apply(fb, 2, xr, yr, N) != VV_DSP_OK) return 0;
+    if (vv_dsp_real_to_q31(xr, xq, N) != VV_DSP_OK) return 0;
+    if (vv_dsp_biquad_q31_process(qb, xq, xq, 1234) != VV_DSP_OK ||
+        vv_dsp_biquad_q31_process(qb, xq + 1234, xq + 1234, N - 1234) != VV_DSP_OK) return 0;
+    if (vv_dsp_q31_to_real(xq, yq, N) != VV_DSP_OK) return 0;
+    for (size_t i = 0; i < N; ++i) {
+        if (fabs((double)yq[i] - (double)yr[i]) > 2e-4) {
+            fprintf(stderr, "q31 biquad mismatch at %zu: %g vs %g\n", i, (double)yq[i], (double)yr[i]);
+            vv_dsp_biquad_q31_destroy(qb);
+            return 0;
+        }
+    }
+    // a1 = -1.82 does not fit without headroom; the stage keeps its old coefficients
+    vv_dsp_biquad_q31* nb = NULL;
+    if (vv_dsp_biquad_q31_create(1, 0, &nb) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_biquad_q31_set_stage(nb, 0, c[0][0], c[0][1], c[0][2], c[0][3], c[0][4]) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_q31 v = 1 << 20, o = 0;
+    ok = ok && vv_dsp_biquad_q31_process(nb, &v, &o, 1) == VV_DSP_OK && llabs((long long)o - (long long)v) <= 1;
+    ok = ok && vv_dsp_biquad_q31_set_stage(qb, 2, 1, 0, 0, 0, 0) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_biquad_q31_destroy(nb);
+    ok = ok && vv_dsp_biquad_q31_create(1, 9, &nb) == VV_DSP_ERROR_OUT_OF_RANGE && nb == NULL;
+    vv_dsp_biquad_q31_destroy(qb);
+    return ok;
+}
+
+// Block-floating-point FFT against the float FFT, after scaling by 2^exponent
+static int check_fft_q15(size_t n, double amp) {
+    vv_dsp_cpx_q15* xq = (vv_dsp_cpx_q15*)malloc(n * sizeof(vv_dsp_cpx_q15));
+    vv_dsp_cpx* xf = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* Xf = (vv_dsp_cpx*)malloc(n * sizeof(vv_dsp_cpx));
+    int ok = xq && xf && Xf;
+    for (size_t i = 0; ok && i < n; ++i) {
+        const double v = amp * (0.5 * cos(2.0 * VV_DSP_PI_D * 5.0 * (double)i / (double)n) + 0.3 +
+                                0.15 * sin(2.0 * VV_DSP_PI_D * 0.37 * (double)i));
+        xq[i].re = (vv_dsp_q15)floor(v * 32768.0 + 0.5);
+        xq[i].im = (vv_dsp_q15)floor(0.5 * v * 32768.0 + 0.5);
+        xf[i] = vv_dsp_cpx_make((vv_dsp_real)(xq[i].re / 32768.0), (vv_dsp_real)(xq[i].im / 32768.0));
+    }
+    vv_dsp_fft_plan* fp = NULL;
+    vv_dsp_fft_q15_plan* qp = NULL;
+    ok = ok && vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &fp) == VV_DSP_OK;
+    ok = ok && vv_dsp_fft_execute(fp, xf, Xf) == VV_DSP_OK;
+    ok = ok && vv_dsp_fft_q15_make_plan(n, VV_DSP_FFT_FORWARD, &qp) == VV_DSP_OK;
+    int e = -1;
+    ok = ok && vv_dsp_fft_q15_execute(qp, xq, xq, &e) == VV_DSP_OK;
+    double peak = 0.0, err = 0.0;
+    for (size_t k = 0; ok && k < n; ++k) {
+        const double sc = ldexp(1.0, e) / 32768.0;
+        const double dr = xq[k].re * sc - (double)Xf[k].re, di = xq[k].im * sc - (double)Xf[k].im;
+        const double m = hypot((double)Xf[k].re, (double)Xf[k].im);
+        if (m > peak) peak = m;
+        if (fabs(dr) > err) err = fabs(dr);
+        if (fabs(di) > err) err = fabs(di);
+    }
+    // A few LSBs of the final block exponent per stage
+    if (ok && err > 8.0 * log2((double)n) * ldexp(1.0, e) / 32768.0 + 1e-3 * peak) {
+        fprintf(stderr, "q15 fft n=%zu amp=%g: error %g (peak %g, exponent %d)\n", n, amp, err, peak, e);
+        ok = 0;
+    }
+    // Quiet signals must not be scaled down for nothing
+    if (ok && amp * (double)n < 0.1 && e != 0) {
+        fprintf(stderr, "q15 fft n=%zu amp=%g: unexpected exponent %d\n", n, amp, e);
+        ok = 0;
+    }
+    vv_dsp_fft_q15_destroy(qp);
+    vv_dsp_fft_destroy(fp);
+    free(xq); free(xf); free(Xf);
+    return ok;
+}
+
+static int test_fft_q15(void) {
+    if (!check_fft_q15(8, 0.9)) return 0;
+    if (!check_fft_q15(256, 0.9)) return 0;
+    if (!check_fft_q15(1024, 0.5)) return 0;
+    if (!check_fft_q15(64, 0.001)) return 0;
+    // Full-scale DC: exponent log2(N), bin 0 at (almost) full scale
+    enum { N = 128 };
+    vv_dsp_cpx_q15 x[N], X[N];
+    for (size_t i = 0; i < N; ++i) { x[i].re = INT16_MAX; x[i].im = 0; }
+    vv_dsp_fft_q15_plan* p = NULL;
+    if (vv_dsp_fft_q15_make_plan(N, VV_DSP_FFT_FORWARD, &p) != VV_DSP_OK) return 0;
+    int e = 0;
+    int ok = vv_dsp_fft_q15_execute(p, x, X, &e) == VV_DSP_OK;
+    ok = ok && ldexp((double)X[0].re, e) > 0.99 * N * INT16_MAX && ldexp((double)X[0].re, e) < 1.01 * N * INT16_MAX;
+    for (size_t k = 1; ok && k < N; ++k) if (abs(X[k].re) > 1 || abs(X[k].im) > 1) ok = 0;
+    vv_dsp_fft_q15_destroy(p);
+    if (vv_dsp_fft_q15_make_plan(48, VV_DSP_FFT_FORWARD, &p) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+    return ok;
+}
+
+int main(void) {
+    if (!test_conversions()) { fprintf(stderr, "fixed-point conversions failed\n"); return 1; }
+    if (!test_fir_q15()) { fprintf(stderr, "q15 fir failed\n"); return 1; }
+    if (!test_fir_q31()) { fprintf(stderr, "q31 fir failed\n"); return 1; }
+    if (!test_biquad_q31()) { fprintf(stderr, "q31 biquad failed\n"); return 1; }
+    if (!test_fft_q15()) { fprintf(stderr, "q15 fft failed\n"); return 1; }
+    printf("fixed-point tests passed\n");
+    return 0;
+}
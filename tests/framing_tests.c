@@ -123,6 +123,70 @@ static int test_fetch_frame_windowing(void) {
     return ok;
 }
 
+static int test_fetch_frames_matches_single(void) {
+    int ok = 1;
+
+    // Batch rows must equal single-frame extraction, edge frames included
+    enum { SL = 300, FL = 64, HOP = 24, MAXF = 16 };
+    vv_dsp_real signal[SL], window[FL];
+    for (int i = 0; i < SL; i++) signal[i] = (vv_dsp_real)sin(0.37 * i) + (vv_dsp_real)(i % 5);
+    for (int i = 0; i < FL; i++) window[i] = (vv_dsp_real)(0.5 - 0.5 * cos(2.0 * M_PI * i / FL));
+    static vv_dsp_real rows[MAXF * FL];
+    vv_dsp_real one[FL];
+    for (int center = 0; center <= 1; center++) {
+        for (int w = 0; w <= 1; w++) {
+            const vv_dsp_real* win = w ? window : NULL;
+            const size_t first = 3, count = MAXF;  // runs past the end of the signal
+            ok &= (vv_dsp_fetch_frames(signal, SL, FL, HOP, center, win, rows, first, count) == VV_DSP_OK);
+            for (size_t f = 0; f < count; f++) {
+                ok &= (vv_dsp_fetch_frame(signal, SL, one, FL, HOP, first + f, center, win) == VV_DSP_OK);
+                ok &= (memcmp(one, &rows[f * FL], sizeof(one)) == 0);
+            }
+            ok &= (vv_dsp_fetch_frames(signal, SL, FL, HOP, center, win, rows, 0, 2) == VV_DSP_OK);
+            ok &= (vv_dsp_fetch_frame(signal, SL, one, FL, HOP, 1, center, win) == VV_DSP_OK);
+            ok &= (memcmp(one, &rows[FL], sizeof(one)) == 0);
+        }
+    }
+    // Frames longer than the signal reflect more than once
+    ok &= (vv_dsp_fetch_frames(signal, 5, FL, HOP, 1, NULL, rows, 0, 2) == VV_DSP_OK);
+    ok &= (vv_dsp_fetch_frame(signal, 5, one, FL, HOP, 1, 1, NULL) == VV_DSP_OK);
+    ok &= (memcmp(one, &rows[FL], sizeof(one)) == 0);
+    ok &= (vv_dsp_fetch_frames(NULL, SL, FL, HOP, 0, NULL, rows, 0, 1) == VV_DSP_ERROR_NULL_POINTER);
+    ok &= (vv_dsp_fetch_frames(signal, SL, FL, 0, 0, NULL, rows, 0, 1) == VV_DSP_ERROR_INVALID_SIZE);
+
+    return ok;
+}
+
+static int test_frame_view(void) {
+    int ok = 1;
+
+    // Interior frames point into the signal; every frame matches fetch_frame
+    enum { SL = 300, FL = 64, HOP = 24 };
+    vv_dsp_real signal[SL], one[FL];
+    for (int i = 0; i < SL; i++) signal[i] = (vv_dsp_real)cos(0.21 * i) - (vv_dsp_real)(i % 3);
+    for (int center = 0; center <= 1; center++) {
+        vv_dsp_frame_view view;
+        ok &= (vv_dsp_frame_view_init(&view, signal, SL, FL, HOP, center) == VV_DSP_OK);
+        ok &= (view.num_frames == vv_dsp_get_num_frames(SL, FL, HOP, center));
+        ok &= (view.interior_count > 0);
+        for (size_t f = 0; f < view.num_frames; f++) {
+            const vv_dsp_real* p = vv_dsp_frame_view_frame(&view, f);
+            const int interior = f >= view.interior_first && f < view.interior_first + view.interior_count;
+            ok &= (p != NULL);
+            ok &= (interior == (p >= signal && p + FL <= signal + SL));
+            ok &= (vv_dsp_fetch_frame(signal, SL, one, FL, HOP, f, center, NULL) == VV_DSP_OK);
+            ok &= (memcmp(one, p, sizeof(one)) == 0);
+        }
+        ok &= (vv_dsp_frame_view_frame(&view, view.num_frames) == NULL);
+        vv_dsp_frame_view_free(&view);
+    }
+    vv_dsp_frame_view view;
+    ok &= (vv_dsp_frame_view_init(&view, NULL, SL, FL, HOP, 0) == VV_DSP_ERROR_NULL_POINTER);
+    ok &= (vv_dsp_frame_view_init(&view, signal, SL, FL, 0, 0) == VV_DSP_ERROR_INVALID_SIZE);
+
+    return ok;
+}
+
 static int test_overlap_add(void) {
     int ok = 1;
 
@@ -152,6 +216,33 @@ static int test_overlap_add(void) {
     return ok;
 }
 
+static int test_overlap_add_frames(void) {
+    int ok = 1;
+
+    // Batch overlap-add equals windowing, scaling and adding frame by frame,
+    // including the frames clipped by the end of the buffer
+    enum { FL = 48, HOP = 20, COUNT = 9, OUT = 190 };
+    static vv_dsp_real frames[COUNT * FL];
+    vv_dsp_real window[FL], scaled[FL], ref[OUT], out[OUT];
+    const vv_dsp_real gain = (vv_dsp_real)0.75;
+    for (int i = 0; i < COUNT * FL; i++) frames[i] = (vv_dsp_real)sin(0.3 * i);
+    for (int i = 0; i < FL; i++) window[i] = (vv_dsp_real)(0.5 - 0.5 * cos(2.0 * M_PI * i / FL));
+    for (int w = 0; w <= 1; w++) {
+        const vv_dsp_real* win = w ? window : NULL;
+        for (int i = 0; i < OUT; i++) ref[i] = out[i] = (vv_dsp_real)(i % 4);
+        for (size_t f = 0; f < COUNT; f++) {
+            for (size_t i = 0; i < FL; i++) scaled[i] = frames[f * FL + i] * (win ? win[i] : (vv_dsp_real)1) * gain;
+            ok &= (vv_dsp_overlap_add(scaled, ref, OUT, FL, HOP, f) == VV_DSP_OK);
+        }
+        ok &= (vv_dsp_overlap_add_frames(frames, COUNT, FL, HOP, win, gain, out, OUT) == VV_DSP_OK);
+        for (int i = 0; i < OUT; i++) ok &= approx_equal(out[i], ref[i]);
+    }
+    ok &= (vv_dsp_overlap_add_frames(NULL, COUNT, FL, HOP, NULL, gain, out, OUT) == VV_DSP_ERROR_NULL_POINTER);
+    ok &= (vv_dsp_overlap_add_frames(frames, COUNT, FL, 0, NULL, gain, out, OUT) == VV_DSP_ERROR_INVALID_SIZE);
+
+    return ok;
+}
+
 static int test_analysis_synthesis_loop(void) {
     int ok = 1;
 
@@ -235,9 +326,18 @@ int main(void) {
     ok &= test_fetch_frame_windowing();
     printf("  test_fetch_frame_windowing: %s\n", ok ? "PASS" : "FAIL");
 
+    ok &= test_fetch_frames_matches_single();
+    printf("  test_fetch_frames_matches_single: %s\n", ok ? "PASS" : "FAIL");
+
+    ok &= test_frame_view();
+    printf("  test_frame_view: %s\n", ok ? "PASS" : "FAIL");
+
     ok &= test_overlap_add();
     printf("  test_overlap_add: %s\n", ok ? "PASS" : "FAIL");
 
+    ok &= test_overlap_add_frames();
+    printf("  test_overlap_add_frames: %s\n", ok ? "PASS" : "FAIL");
+
     ok &= test_analysis_synthesis_loop();
     printf("  test_analysis_synthesis_loop: %s\n", ok ? "PASS" : "FAIL");
 
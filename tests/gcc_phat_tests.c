@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { CH = 3, LEN = 4096, FRAME = 256, HOP = 128, FRAMES = (LEN - FRAME - 16) / HOP };
+
+static vv_dsp_real g_x[CH * LEN];
+
+// ch0 = s[n], ch1 = s[n - 5] (lags by 5), ch2 = s[n + 3] (leads by 3)
+static void make_signal(void) {
+    static vv_dsp_real src[LEN + 16];
+    uint32_t s = 2024u;
+    for (size_t i = 0; i < LEN + 16; ++i) {
+        s = s * 1664525u + 1013904223u;
+        src[i] = (vv_dsp_real)((double)(s >> 8) / 8388608.0 - 1.0);
+    }
+    for (size_t i = 0; i < LEN; ++i) {
+        g_x[i] = src[i + 8];
+        g_x[LEN + i] = src[i + 8 - 5];
+        g_x[2 * LEN + i] = src[i + 8 + 3];
+    }
+}
+
+static int test_delays(void) {
+    vv_dsp_gcc_phat_params p = {CH, FRAME, 10, 0, 2};
+    vv_dsp_gcc_phat* g = NULL;
+    if (vv_dsp_gcc_phat_create(&p, &g) != VV_DSP_OK) return 0;
+    if (vv_dsp_gcc_phat_num_pairs(g) != 3 || vv_dsp_gcc_phat_lag_count(g) != 21) return 0;
+    static vv_dsp_real delay[FRAMES * 3], peak[FRAMES * 3];
+    int ok = vv_dsp_gcc_phat_process(g, g_x, FRAMES, HOP, LEN, NULL, delay, peak) == VV_DSP_OK;
+    const double want[3] = {5.0, -3.0, -8.0};
+    for (size_t f = 0; f < FRAMES && ok; ++f) {
+        for (size_t q = 0; q < 3; ++q) {
+            const double d = (double)delay[f * 3 + q];
+            if (fabs(d - want[q]) > 0.25 || !(peak[f * 3 + q] > (vv_dsp_real)0.5) || peak[f * 3 + q] > (vv_dsp_real)1.0001) {
+                fprintf(stderr, "gcc-phat frame %zu pair %zu: delay %g (want %g) peak %g\n", f, q, d, want[q],
+                        (double)peak[f * 3 + q]);
+                ok = 0;
+            }
+        }
+    }
+    vv_dsp_gcc_phat_destroy(g);
+    return ok;
+}
+
+// A wide window takes the full C2R inverse; the narrow table path must agree on the
+// shared lags, and worker count must not change the output
+static int test_paths_threads(void) {
+    vv_dsp_gcc_phat_params narrow = {CH, FRAME, 6, 512, 1};
+    vv_dsp_gcc_phat_params wide = {CH, FRAME, 200, 512, 1};
+    vv_dsp_gcc_phat *gn = NULL, *gw = NULL, *g4 = NULL;
+    if (vv_dsp_gcc_phat_create(&narrow, &gn) != VV_DSP_OK) return 0;
+    if (vv_dsp_gcc_phat_create(&wide, &gw) != VV_DSP_OK) return 0;
+    narrow.num_threads = 4;
+    if (vv_dsp_gcc_phat_create(&narrow, &g4) != VV_DSP_OK) return 0;
+    static vv_dsp_real cn[FRAMES * 3 * 13], c4[FRAMES * 3 * 13], cw[FRAMES * 3 * 401];
+    int ok = vv_dsp_gcc_phat_process(gn, g_x, FRAMES, HOP, LEN, cn, NULL, NULL) == VV_DSP_OK &&
+             vv_dsp_gcc_phat_process(g4, g_x, FRAMES, HOP, LEN, c4, NULL, NULL) == VV_DSP_OK &&
+             vv_dsp_gcc_phat_process(gw, g_x, FRAMES, HOP, LEN, cw, NULL, NULL) == VV_DSP_OK;
+    ok = ok && memcmp(cn, c4, sizeof(cn)) == 0;
+    for (size_t r = 0; r < FRAMES * 3 && ok; ++r) {
+        for (size_t t = 0; t < 13; ++t) {
+            const double a = (double)cn[r * 13 + t], b = (double)cw[r * 401 + 194 + t];
+            if (fabs(a - b) > 1e-5) {
+                fprintf(stderr, "gcc-phat path mismatch row %zu lag %d: %g vs %g\n", r, (int)t - 6, a, b);
+                ok = 0;
+                break;
+            }
+        }
+    }
+    vv_dsp_gcc_phat_destroy(gn);
+    vv_dsp_gcc_phat_destroy(gw);
+    vv_dsp_gcc_phat_destroy(g4);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_gcc_phat* g = NULL;
+    vv_dsp_gcc_phat_params p = {1, FRAME, 10, 0, 1};
+    if (vv_dsp_gcc_phat_create(&p, &g) != VV_DSP_ERROR_INVALID_SIZE || g) return 0;
+    p.num_channels = 2;
+    p.max_lag = FRAME;
+    if (vv_dsp_gcc_phat_create(&p, &g) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    p.max_lag = 10;
+    p.fft_size = FRAME;
+    if (vv_dsp_gcc_phat_create(&p, &g) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    if (vv_dsp_gcc_phat_create(NULL, &g) != VV_DSP_ERROR_NULL_POINTER) return 0;
+    p.fft_size = 0;
+    if (vv_dsp_gcc_phat_create(&p, &g) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_gcc_phat_process(g, g_x, 0, HOP, LEN, NULL, NULL, NULL) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_gcc_phat_process(g, NULL, 1, HOP, LEN, NULL, NULL, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_gcc_phat_destroy(g);
+    vv_dsp_gcc_phat_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    make_signal();
+    int ok = 1;
+    if (!test_delays()) { fprintf(stderr, "gcc-phat delay test failed\n"); ok = 0; }
+    if (!test_paths_threads()) { fprintf(stderr, "gcc-phat path/thread test failed\n"); ok = 0; }
+    if (!test_errors()) { fprintf(stderr, "gcc-phat error test failed\n"); ok = 0; }
+    if (!ok) return 1;
+    printf("gcc-phat tests passed\n");
+    return 0;
+}
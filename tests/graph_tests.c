@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define N_SIG 4096
+
+static void make_signal(vv_dsp_real* x, size_t n, unsigned seed) {
+    uint32_t s = seed;
+    for (size_t i = 0; i < n; ++i) {
+        s = s * 1664525u + 1013904223u;
+        x[i] = (vv_dsp_real)(0.5 * sin(0.031 * (double)i) + 0.25 * ((double)(s >> 8) / 16777216.0 - 0.5));
+    }
+}
+
+// Run x through the graph's single input in uneven blocks, appending output 0 to y;
+// fails if any process call allocates
+static int run_blocks(vv_dsp_graph* g, const vv_dsp_real* x, size_t n, size_t width, vv_dsp_real* y,
+                      size_t y_cap, size_t* out_items) {
+    static const size_t blocks[5] = {256, 1, 97, 200, 13};
+    size_t pos = 0, b = 0, items = 0;
+    vv_dsp_reset_alloc_stats();
+    while (pos < n) {
+        size_t len = blocks[b++ % 5];
+        if (len > n - pos) len = n - pos;
+        const vv_dsp_real* in = x + pos;
+        if (vv_dsp_graph_process(g, &in, len) != VV_DSP_OK) return 0;
+        const vv_dsp_real* data = NULL;
+        size_t got = 0;
+        if (vv_dsp_graph_output(g, 0, &data, &got) != VV_DSP_OK) return 0;
+        if ((items + got) * width > y_cap) return 0;
+        if (got) memcpy(y + items * width, data, got * width * sizeof(vv_dsp_real));
+        items += got;
+        pos += len;
+    }
+    vv_dsp_alloc_stats st;
+    if (vv_dsp_get_alloc_stats(&st) != VV_DSP_OK || st.allocations || st.reallocations) {
+        fprintf(stderr, "graph process allocated\n");
+        return 0;
+    }
+    *out_items = items;
+    return 1;
+}
+
+// FIR (direct and FFT) and biquad branches, summed and scaled, against the modules
+static int test_filters(void) {
+    static vv_dsp_real x[N_SIG], y[N_SIG], ref[N_SIG], tmp[N_SIG];
+    make_signal(x, N_SIG, 7u);
+    const vv_dsp_real short_h[5] = {0.1f, 0.2f, 0.4f, 0.2f, 0.1f};
+    enum { LONG_TAPS = 300 };
+    vv_dsp_real long_h[LONG_TAPS];
+    for (size_t k = 0; k < LONG_TAPS; ++k) long_h[k] = (vv_dsp_real)(0.01 * cos(0.05 * (double)k));
+    vv_dsp_biquad bq[2];
+    (void)vv_dsp_biquad_init(&bq[0], 0.2f, 0.4f, 0.2f, -0.5f, 0.3f);
+    (void)vv_dsp_biquad_init(&bq[1], 1.0f, -0.3f, 0.0f, 0.2f, 0.0f);
+
+    vv_dsp_graph* g = NULL;
+    vv_dsp_graph_node in, a, b, c, sum, out;
+    size_t idx;
+    int ok = vv_dsp_graph_create(&g) == VV_DSP_OK &&
+             vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+             vv_dsp_graph_add_fir(g, in, short_h, 5, &a) == VV_DSP_OK &&
+             vv_dsp_graph_add_biquad(g, a, bq, 2, &b) == VV_DSP_OK &&
+             vv_dsp_graph_add_fir(g, in, long_h, LONG_TAPS, &c) == VV_DSP_OK;
+    const vv_dsp_graph_node terms[2] = {b, c};
+    ok = ok && vv_dsp_graph_add_sum(g, terms, 2, &sum) == VV_DSP_OK &&
+         vv_dsp_graph_add_gain(g, sum, 0.5f, &out) == VV_DSP_OK &&
+         vv_dsp_graph_add_output(g, out, &idx) == VV_DSP_OK && idx == 0 &&
+         vv_dsp_graph_prepare(g, 256, 16000.0) == VV_DSP_OK;
+    size_t items = 0;
+    ok = ok && run_blocks(g, x, N_SIG, 1, y, N_SIG, &items) && items == N_SIG;
+
+    // Reference: each module over the whole signal
+    vv_dsp_fir_state fs;
+    ok = ok && vv_dsp_fir_state_init(&fs, 5) == VV_DSP_OK;
+    ok = ok && vv_dsp_fir_apply(&fs, short_h, x, ref, N_SIG) == VV_DSP_OK;
+    vv_dsp_fir_state_free(&fs);
+    ok = ok && vv_dsp_iir_apply(bq, 2, ref, ref, N_SIG) == VV_DSP_OK;
+    ok = ok && vv_dsp_fir_state_init(&fs, LONG_TAPS) == VV_DSP_OK;
+    ok = ok && vv_dsp_fir_apply(&fs, long_h, x, tmp, N_SIG) == VV_DSP_OK;
+    vv_dsp_fir_state_free(&fs);
+    double err = 0.0;
+    for (size_t i = 0; ok && i < N_SIG; ++i) {
+        const double d = fabs((double)y[i] - 0.5 * ((double)ref[i] + (double)tmp[i]));
+        if (d > err) err = d;
+    }
+    if (err > 1e-4) {
+        fprintf(stderr, "graph filter chain error %g\n", err);
+        ok = 0;
+    }
+
+    // The sum's inputs die there, so six edges fit in fewer buffers
+    vv_dsp_graph_info info;
+    ok = ok && vv_dsp_graph_get_info(g, &info) == VV_DSP_OK && info.num_nodes == 6 &&
+         info.num_buffers < 5 && info.buffer_bytes < info.edge_bytes;
+
+    // Reset restarts the stream
+    ok = ok && vv_dsp_graph_reset(g) == VV_DSP_OK && run_blocks(g, x, 512, 1, tmp, N_SIG, &items);
+    for (size_t i = 0; ok && i < 512; ++i) ok = fabs((double)tmp[i] - (double)y[i]) < 1e-6;
+    vv_dsp_graph_destroy(g);
+    return ok;
+}
+
+typedef struct {
+    size_t calls;
+} gate_state;
+
+// Passes the spectrum through, counting frames
+static vv_dsp_status gate_kernel(void* user, const vv_dsp_real* const* inputs, size_t num_inputs,
+                                 size_t num_items, size_t width, vv_dsp_real* out) {
+    gate_state* gs = (gate_state*)user;
+    if (num_inputs != 1) return VV_DSP_ERROR_INVALID_SIZE;
+    memcpy(out, inputs[0], num_items * width * sizeof(vv_dsp_real));
+    gs->calls += num_items;
+    return VV_DSP_OK;
+}
+
+// STFT -> custom -> ISTFT resynthesis and STFT -> power -> log-mel from one analysis
+static int test_spectral(void) {
+    enum { FFT = 512, HOP = 128, MELS = 40 };
+    static vv_dsp_real x[N_SIG], y[N_SIG], mel[N_SIG / HOP * MELS];
+    make_signal(x, N_SIG, 11u);
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = FFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    p.periodic = 1;
+
+    gate_state gs = {0};
+    const vv_dsp_graph_kernel kernel = {gate_kernel, &gs};
+    vv_dsp_graph* g = NULL;
+    vv_dsp_graph_node in, st, gate, syn, pw, lm;
+    size_t o0, o1;
+    int ok = vv_dsp_graph_create(&g) == VV_DSP_OK &&
+             vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+             vv_dsp_graph_add_stft(g, in, &p, &st) == VV_DSP_OK &&
+             vv_dsp_graph_add_custom(g, &st, 1, &kernel, &gate) == VV_DSP_OK &&
+             vv_dsp_graph_add_istft(g, gate, &p, &syn) == VV_DSP_OK &&
+             vv_dsp_graph_add_power(g, st, &pw) == VV_DSP_OK &&
+             vv_dsp_graph_add_log_mel(g, pw, MELS, 0, 0, VV_DSP_MEL_VARIANT_HTK, 0, &lm) == VV_DSP_OK &&
+             vv_dsp_graph_add_output(g, syn, &o0) == VV_DSP_OK &&
+             vv_dsp_graph_add_output(g, lm, &o1) == VV_DSP_OK &&
+             vv_dsp_graph_prepare(g, 256, 16000.0) == VV_DSP_OK;
+
+    vv_dsp_graph_shape sh;
+    ok = ok && vv_dsp_graph_node_shape(g, st, &sh) == VV_DSP_OK && sh.stream == VV_DSP_GRAPH_SPECTRUM &&
+         sh.width == 2 * (FFT / 2 + 1) && fabs(sh.item_rate - 16000.0 / HOP) < 1e-9;
+    ok = ok && vv_dsp_graph_node_shape(g, lm, &sh) == VV_DSP_OK && sh.stream == VV_DSP_GRAPH_FRAMES &&
+         sh.width == MELS;
+
+    // Feed blocks and collect both outputs
+    size_t pos = 0, ny = 0, nm = 0;
+    while (ok && pos < N_SIG) {
+        size_t len = (pos / 256) % 2 ? 256 : 77;
+        if (len > N_SIG - pos) len = N_SIG - pos;
+        const vv_dsp_real* src = x + pos;
+        const vv_dsp_real* data;
+        size_t got;
+        ok = vv_dsp_graph_process(g, &src, len) == VV_DSP_OK;
+        ok = ok && vv_dsp_graph_output(g, o0, &data, &got) == VV_DSP_OK;
+        if (ok) memcpy(y + ny, data, got * sizeof(vv_dsp_real));
+        ny += got;
+        ok = ok && vv_dsp_graph_output(g, o1, &data, &got) == VV_DSP_OK;
+        if (ok) memcpy(mel + nm * MELS, data, got * MELS * sizeof(vv_dsp_real));
+        nm += got;
+        pos += len;
+    }
+    const size_t frames = (N_SIG - FFT) / HOP + 1;
+    ok = ok && nm == frames && ny == frames * HOP && gs.calls == frames;
+
+    // Resynthesis reproduces the input once the overlap has ramped in
+    double err = 0.0;
+    for (size_t i = FFT - HOP; ok && i < ny; ++i) {
+        const double d = fabs((double)y[i] - (double)x[i]);
+        if (d > err) err = d;
+    }
+    if (err > 1e-4) {
+        fprintf(stderr, "graph resynthesis error %g\n", err);
+        ok = 0;
+    }
+
+    // Log-mel against the modules driven by hand
+    vv_dsp_stft* h = NULL;
+    const vv_dsp_mel_sparse* fb = NULL;
+    vv_dsp_cpx spec[FFT / 2 + 1];
+    vv_dsp_real power[FFT / 2 + 1], ref[MELS];
+    ok = ok && vv_dsp_stft_create(&p, &h) == VV_DSP_OK && vv_dsp_stft_stream_reserve(h, N_SIG) == VV_DSP_OK &&
+         vv_dsp_stft_push(h, x, N_SIG) == VV_DSP_OK &&
+         vv_dsp_mel_sparse_acquire(FFT, MELS, 16000.0f, 0.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, &fb) == VV_DSP_OK;
+    err = 0.0;
+    for (size_t f = 0; ok && f < frames; ++f) {
+        ok = vv_dsp_stft_pop_frame(h, spec) == VV_DSP_OK;
+        for (size_t k = 0; k <= FFT / 2; ++k) power[k] = spec[k].re * spec[k].re + spec[k].im * spec[k].im;
+        ok = ok && vv_dsp_mel_sparse_project(fb, power, ref) == VV_DSP_OK;
+        for (size_t m = 0; ok && m < MELS; ++m) {
+            const double d = fabs(log((double)ref[m] + 1e-10) - (double)mel[f * MELS + m]);
+            if (d > err) err = d;
+        }
+    }
+    if (err > 1e-3) {
+        fprintf(stderr, "graph log-mel error %g\n", err);
+        ok = 0;
+    }
+    vv_dsp_mel_sparse_release(fb);
+    if (h) (void)vv_dsp_stft_destroy(h);
+    vv_dsp_graph_destroy(g);
+    return ok;
+}
+
+// A detector node gating an STFT -> power branch: the branch runs only on blocks the
+// detector calls speech, and the detector node passes its input through
+static int test_vad_gate(void) {
+    enum { SR = 16000, LEN = 5 * SR / 2, BLOCK = SR / 100, FFT = 512, HOP = 160 };
+    static vv_dsp_real x[LEN];
+    uint32_t seed = 5u;
+    for (size_t t = 0; t < LEN; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        double v = 0.02 * ((double)(seed >> 8) / 16777216.0 - 0.5);
+        if (t >= SR && t < 3 * SR / 2) {
+            for (int h = 1; h < 20; ++h) v += 0.2 / h * sin(2.0 * VV_DSP_PI_D * 150.0 * h * (double)t / SR);
+        }
+        x[t] = (vv_dsp_real)v;
+    }
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = FFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    p.periodic = 1;
+    vv_dsp_vad_params vp;
+    memset(&vp, 0, sizeof(vp));
+    vp.sample_rate = SR;
+
+    vv_dsp_vad* vad = NULL;
+    vv_dsp_graph* g = NULL;
+    vv_dsp_graph_node in, det, st, pw;
+    size_t o0, o1;
+    int ok = vv_dsp_vad_create(&vp, &vad) == VV_DSP_OK && vv_dsp_graph_create(&g) == VV_DSP_OK &&
+             vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+             vv_dsp_graph_add_vad(g, in, vad, &det) == VV_DSP_OK &&
+             vv_dsp_graph_add_stft(g, det, &p, &st) == VV_DSP_OK &&
+             vv_dsp_graph_add_power(g, st, &pw) == VV_DSP_OK &&
+             vv_dsp_graph_add_output(g, det, &o0) == VV_DSP_OK &&
+             vv_dsp_graph_add_output(g, pw, &o1) == VV_DSP_OK &&
+             vv_dsp_graph_set_gate(g, st, vv_dsp_vad_gate, vad) == VV_DSP_OK &&
+             vv_dsp_graph_set_gate(g, pw + 1, vv_dsp_vad_gate, vad) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_graph_prepare(g, BLOCK, SR) == VV_DSP_OK;
+
+    size_t early = 0, speech = 0, idle = 0;
+    for (size_t pos = 0; ok && pos < LEN; pos += BLOCK) {
+        const vv_dsp_real* src = x + pos;
+        const vv_dsp_real* data;
+        size_t got;
+        ok = vv_dsp_graph_process(g, &src, BLOCK) == VV_DSP_OK &&
+             vv_dsp_graph_output(g, o0, &data, &got) == VV_DSP_OK && got == BLOCK &&
+             memcmp(data, src, BLOCK * sizeof(vv_dsp_real)) == 0 &&
+             vv_dsp_graph_output(g, o1, &data, &got) == VV_DSP_OK;
+        if (!vv_dsp_vad_active(vad)) idle += got;
+        if (pos < SR) early += got;
+        else if (pos + BLOCK <= 3 * SR / 2) speech += got;
+    }
+    if (ok && (early || idle || speech < SR / 2 / HOP - FFT / HOP)) {
+        fprintf(stderr, "vad gate: %zu early, %zu idle, %zu speech frames\n", early, idle, speech);
+        ok = 0;
+    }
+
+    // Without the gate every block runs the branch again
+    size_t frames = 0;
+    ok = ok && vv_dsp_graph_set_gate(g, st, NULL, NULL) == VV_DSP_OK;
+    for (size_t pos = 0; ok && pos < SR; pos += BLOCK) {
+        const vv_dsp_real* src = x + pos;
+        const vv_dsp_real* data;
+        size_t got;
+        ok = vv_dsp_graph_process(g, &src, BLOCK) == VV_DSP_OK &&
+             vv_dsp_graph_output(g, o1, &data, &got) == VV_DSP_OK;
+        frames += got;
+    }
+    ok = ok && frames >= SR / HOP - FFT / HOP;
+    vv_dsp_graph_destroy(g);
+    vv_dsp_vad_destroy(vad);
+    return ok;
+}
+
+// A 3/2 resampler emits what each block completes, matching a standalone stream
+static int test_resampler(void) {
+    static vv_dsp_real x[N_SIG], y[2 * N_SIG], ref[2 * N_SIG];
+    make_signal(x, N_SIG, 3u);
+    vv_dsp_graph* g = NULL;
+    vv_dsp_graph_node in, rs;
+    size_t idx, items = 0, got = 0;
+    int ok = vv_dsp_graph_create(&g) == VV_DSP_OK &&
+             vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+             vv_dsp_graph_add_resampler(g, in, 3, 2, 16, &rs) == VV_DSP_OK &&
+             vv_dsp_graph_add_output(g, rs, &idx) == VV_DSP_OK &&
+             vv_dsp_graph_prepare(g, 256, 32000.0) == VV_DSP_OK &&
+             run_blocks(g, x, N_SIG, 1, y, 2 * N_SIG, &items);
+    vv_dsp_graph_shape sh;
+    ok = ok && vv_dsp_graph_node_shape(g, rs, &sh) == VV_DSP_OK && fabs(sh.item_rate - 48000.0) < 1e-6;
+
+    vv_dsp_resampler* r = vv_dsp_resampler_create(3, 2);
+    ok = ok && r && vv_dsp_resampler_set_quality(r, 1, 16) == VV_DSP_OK &&
+         vv_dsp_resampler_process_stream(r, x, N_SIG, ref, 2 * N_SIG, &got) == VV_DSP_OK && got == items;
+    for (size_t i = 0; ok && i < items; ++i) {
+        if (fabs((double)y[i] - (double)ref[i]) > 1e-4) {
+            fprintf(stderr, "graph resampler mismatch at %zu\n", i);
+            ok = 0;
+        }
+    }
+    vv_dsp_resampler_destroy(r);
+    vv_dsp_graph_destroy(g);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_graph* g = NULL;
+    vv_dsp_graph_node in, in2, rs, bad, node;
+    size_t idx;
+    vv_dsp_real x[4] = {0};
+    const vv_dsp_real* src[2] = {x, x};
+    int ok = vv_dsp_graph_create(&g) == VV_DSP_OK &&
+             vv_dsp_graph_prepare(g, 64, 8000.0) == VV_DSP_ERROR_INVALID_SIZE &&  // empty
+             vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+             vv_dsp_graph_add_gain(g, 7, 1.0f, &node) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_graph_process(g, src, 4) == VV_DSP_ERROR_INTERNAL &&      // not prepared
+             vv_dsp_graph_prepare(g, 0, 8000.0) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_graph_prepare(g, 64, 8000.0) == VV_DSP_OK &&
+             vv_dsp_graph_process(g, src, 65) == VV_DSP_ERROR_INVALID_SIZE;
+
+    // Log-mel on a signal is a shape error; summing two rates is a rate error
+    ok = ok && vv_dsp_graph_add_log_mel(g, in, 20, 0, 0, VV_DSP_MEL_VARIANT_HTK, 0, &bad) == VV_DSP_OK &&
+         vv_dsp_graph_prepare(g, 64, 8000.0) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_graph_process(g, src, 4) == VV_DSP_ERROR_INTERNAL;
+    vv_dsp_graph_destroy(g);
+
+    g = NULL;
+    ok = ok && vv_dsp_graph_create(&g) == VV_DSP_OK && vv_dsp_graph_add_input(g, &in) == VV_DSP_OK &&
+         vv_dsp_graph_add_input(g, &in2) == VV_DSP_OK &&
+         vv_dsp_graph_add_resampler(g, in2, 2, 1, 0, &rs) == VV_DSP_OK;
+    const vv_dsp_graph_node terms[2] = {in, rs};
+    ok = ok && vv_dsp_graph_add_sum(g, terms, 2, &node) == VV_DSP_OK &&
+         vv_dsp_graph_add_output(g, node, &idx) == VV_DSP_OK &&
+         vv_dsp_graph_prepare(g, 64, 8000.0) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_graph_destroy(g);
+    return ok;
+}
+
+int main(void) {
+    if (!test_filters()) { fprintf(stderr, "graph filter test failed\n"); return 1; }
+    if (!test_spectral()) { fprintf(stderr, "graph spectral test failed\n"); return 1; }
+    if (!test_resampler()) { fprintf(stderr, "graph resampler test failed\n"); return 1; }
+    if (!test_vad_gate()) { fprintf(stderr, "graph vad gate test failed\n"); return 1; }
+    if (!test_errors()) { fprintf(stderr, "graph error test failed\n"); return 1; }
+    printf("graph tests passed\n");
+    return 0;
+}
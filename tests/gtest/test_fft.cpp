@@ -406,3 +406,30 @@ TEST_F(FFTTest, BasicPerformanceCheck) {
 
     vv_dsp_fft_destroy(plan);
 }
+
+// Executing a plan, split layout included, allocates nothing on this thread
+TEST_F(FFTTest, ExecuteDoesNotAllocate) {
+    const size_t N = 1000;
+    std::vector<vv_dsp_real> re(N), im(N, 0), out_re(N), out_im(N);
+    std::vector<vv_dsp_cpx> spec(N / 2 + 1);
+    generateSineWave(re, 10.0, static_cast<vv_dsp_real>(N));
+
+    vv_dsp_fft_plan* r2c = nullptr;
+    vv_dsp_fft_plan* c2r = nullptr;
+    ASSERT_EQ(vv_dsp_fft_make_plan(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &r2c), VV_DSP_OK);
+    ASSERT_EQ(vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &c2r), VV_DSP_OK);
+
+    vv_dsp_alloc_stats before, after;
+    ASSERT_EQ(vv_dsp_get_thread_alloc_stats(&before), VV_DSP_OK);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(vv_dsp_fft_execute(r2c, re.data(), spec.data()), VV_DSP_OK);
+        ASSERT_EQ(vv_dsp_fft_execute(c2r, spec.data(), out_re.data()), VV_DSP_OK);
+        ASSERT_EQ(vv_dsp_fft_execute_split(r2c, re.data(), im.data(), out_re.data(), out_im.data()), VV_DSP_OK);
+    }
+    ASSERT_EQ(vv_dsp_get_thread_alloc_stats(&after), VV_DSP_OK);
+    EXPECT_EQ(after.allocations + after.reallocations, before.allocations + before.reallocations);
+    EXPECT_EQ(after.frees, before.frees);
+
+    vv_dsp_fft_destroy(r2c);
+    vv_dsp_fft_destroy(c2r);
+}
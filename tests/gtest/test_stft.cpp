@@ -92,7 +92,7 @@ protected:
 
 // Test STFT creation and destruction
 TEST_F(STFTTest, STFTLifecycle) {
-    vv_dsp_stft_params params;
+    vv_dsp_stft_params params = {};
     params.fft_size = 64;
     params.hop_size = 32;
     params.window = VV_DSP_STFT_WIN_HANN;
@@ -119,7 +119,7 @@ TEST_F(STFTTest, InvalidSTFTCreation) {
     EXPECT_NE(vv_dsp_stft_create(nullptr, &stft), VV_DSP_OK);
 
     // Test with null output pointer
-    vv_dsp_stft_params params;
+    vv_dsp_stft_params params = {};
     params.fft_size = 64;
     params.hop_size = 32;
     params.window = VV_DSP_STFT_WIN_HANN;
@@ -47,9 +47,90 @@ static int test_plain_sine(void) {
     return 0;
 }
 
+// Plan output matches the one-shot path for even and odd sizes across repeated calls
+static int test_plan(void) {
+    const size_t sizes[] = { 1, 2, 7, 64, 255 };
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        const size_t N = sizes[si];
+        vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+        vv_dsp_cpx* a = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
+        vv_dsp_cpx* b = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
+        vv_dsp_hilbert_plan* plan = NULL;
+        if (!x || !a || !b || vv_dsp_hilbert_plan_create(N, &plan) != VV_DSP_OK) return 10;
+        if (vv_dsp_hilbert_plan_size(plan) != N) return 11;
+        for (int rep = 0; rep < 3; ++rep) {
+            for (size_t n = 0; n < N; ++n) x[n] = (vv_dsp_real)(sin(0.3 * (double)(n + 1) * (rep + 1)) + 0.1 * (double)rep);
+            if (vv_dsp_hilbert_plan_execute(plan, x, a) != VV_DSP_OK) return 12;
+            if (vv_dsp_hilbert_analytic(x, N, b) != VV_DSP_OK) return 13;
+            for (size_t n = 0; n < N; ++n) {
+                if (fabs((double)a[n].re - (double)b[n].re) > 1e-6 || fabs((double)a[n].im - (double)b[n].im) > 1e-6 ||
+                    fabs((double)a[n].re - (double)x[n]) > 1e-4) {
+                    fprintf(stderr, "plan mismatch N=%zu n=%zu\n", N, n);
+                    return 14;
+                }
+            }
+        }
+        vv_dsp_hilbert_plan_destroy(plan);
+        free(x); free(a); free(b);
+    }
+    vv_dsp_hilbert_plan* bad = NULL;
+    if (vv_dsp_hilbert_plan_create(0, &bad) != VV_DSP_ERROR_INVALID_SIZE || bad) return 15;
+    vv_dsp_hilbert_plan_destroy(NULL);
+    return 0;
+}
+
+// Streaming FIR transformer: fixed latency, unit envelope in band, block invariance
+static int test_fir_stream(void) {
+    const size_t N = 2000, taps = 127;
+    const double fs = 1000.0, f0 = 60.0;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_cpx* z = (vv_dsp_cpx*)malloc(N * sizeof(vv_dsp_cpx));
+    vv_dsp_real* amp = (vv_dsp_real*)malloc(4 * N * sizeof(vv_dsp_real));
+    vv_dsp_hilbert_fir* h = NULL;
+    if (!x || !z || !amp || vv_dsp_hilbert_fir_create(taps, &h) != VV_DSP_OK) return 20;
+    vv_dsp_real* ph = amp + N;
+    vv_dsp_real* fr = amp + 2 * N;
+    vv_dsp_real* fr2 = amp + 3 * N;
+    const size_t M = vv_dsp_hilbert_fir_latency(h);
+    if (M != taps / 2) return 21;
+    gen_sine(x, N, fs, f0, 0.3);
+
+    if (vv_dsp_hilbert_fir_process(h, x, N, z) != VV_DSP_OK) return 22;
+    for (size_t i = 0; i < N; ++i) {
+        if (z[i].re != (i >= M ? x[i - M] : 0.0f)) { fprintf(stderr, "fir delay mismatch at %zu\n", i); return 23; }
+        if (i >= 2 * M) {
+            const double a = sqrt((double)z[i].re * (double)z[i].re + (double)z[i].im * (double)z[i].im);
+            if (fabs(a - 1.0) > 0.01) { fprintf(stderr, "fir envelope %g at %zu\n", a, i); return 24; }
+        }
+    }
+
+    // Tracker in one call versus uneven blocks
+    if (vv_dsp_hilbert_fir_reset(h) != VV_DSP_OK) return 25;
+    if (vv_dsp_hilbert_fir_track(h, x, N, fs, amp, ph, fr) != VV_DSP_OK) return 26;
+    if (vv_dsp_hilbert_fir_reset(h) != VV_DSP_OK) return 27;
+    for (size_t i = 0, step = 1; i < N; step = step * 7 % 301 + 1) {
+        const size_t m = (N - i < step) ? N - i : step;
+        if (vv_dsp_hilbert_fir_track(h, &x[i], m, fs, NULL, NULL, &fr2[i]) != VV_DSP_OK) return 28;
+        i += m;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (fr[i] != fr2[i]) { fprintf(stderr, "fir block dependence at %zu\n", i); return 29; }
+        if (i >= 2 * M && fabs((double)fr[i] - f0) > 0.5) { fprintf(stderr, "fir freq %g at %zu\n", (double)fr[i], i); return 30; }
+    }
+
+    vv_dsp_hilbert_fir* bad = NULL;
+    if (vv_dsp_hilbert_fir_create(64, &bad) != VV_DSP_ERROR_INVALID_SIZE || bad) return 31;
+    vv_dsp_hilbert_fir_destroy(h);
+    vv_dsp_hilbert_fir_destroy(NULL);
+    free(x); free(z); free(amp);
+    return 0;
+}
+
 int main(void) {
     int rc = 0;
+    rc |= test_fir_stream();
     rc |= test_plain_sine();
+    rc |= test_plan();
     if (rc != 0) {
         fprintf(stderr, "hilbert_tests failed with rc=%d\n", rc);
         return 1;
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { FFT = 512, HOP = 128, TILE = 16, BINS = FFT / 2 + 1, LEN = 60000, SLOTS = 6 };
+
+static void make_signal(vv_dsp_real* x, size_t n, unsigned int seed) {
+    for (size_t t = 0; t < n; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double)(seed >> 8) / 16777216.0 - 0.5;
+        x[t] = (vv_dsp_real)(0.3 * sin(0.0021 * (double)t * (1.0 + 1e-5 * (double)t)) + 0.05 * noise);
+    }
+}
+
+static void make_params(vv_dsp_lazy_spectrogram_params* p) {
+    memset(p, 0, sizeof(*p));
+    p->stft.fft_size = FFT;
+    p->stft.hop_size = HOP;
+    p->stft.window = VV_DSP_STFT_WIN_HANN;
+    p->stft.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    p->stft.periodic = 1;
+    p->opts.scale = VV_DSP_SPECTROGRAM_DB;
+    p->opts.floor = (vv_dsp_real)1e-10;
+    p->tile_frames = TILE;
+    p->cache_bytes = SLOTS * TILE * BINS * sizeof(vv_dsp_real);
+    p->prefetch = 1;
+    p->num_threads = 3;
+}
+
+// Whole-signal spectrogram_ex rows; caller frees
+static vv_dsp_real* reference(const vv_dsp_real* x, size_t n, size_t* frames) {
+    vv_dsp_lazy_spectrogram_params p;
+    make_params(&p);
+    vv_dsp_stft* h = NULL;
+    if (vv_dsp_stft_create(&p.stft, &h) != VV_DSP_OK) return NULL;
+    *frames = vv_dsp_stft_spectrogram_frames(h, n);
+    vv_dsp_real* out = (vv_dsp_real*)malloc(*frames * BINS * sizeof(vv_dsp_real));
+    if (out && vv_dsp_stft_spectrogram_ex(h, x, n, &p.opts, out, frames) != VV_DSP_OK) {
+        free(out);
+        out = NULL;
+    }
+    (void)vv_dsp_stft_destroy(h);
+    return out;
+}
+
+static int check_range(vv_dsp_lazy_spectrogram* ls, const vv_dsp_real* ref, size_t first, size_t count,
+                       vv_dsp_real* buf) {
+    return vv_dsp_lazy_spectrogram_get(ls, first, count, buf) == VV_DSP_OK &&
+           memcmp(buf, ref + first * BINS, count * BINS * sizeof(vv_dsp_real)) == 0;
+}
+
+// Scattered and oversized requests match the whole-signal rows bit for bit; repeats hit
+static int test_random_access(const vv_dsp_real* x, const vv_dsp_real* ref, size_t frames) {
+    vv_dsp_lazy_spectrogram_params p;
+    make_params(&p);
+    vv_dsp_lazy_spectrogram* ls = NULL;
+    vv_dsp_real* buf = (vv_dsp_real*)malloc(frames * BINS * sizeof(vv_dsp_real));
+    int ok = buf && vv_dsp_lazy_spectrogram_create(&p, x, LEN, &ls) == VV_DSP_OK &&
+             vv_dsp_lazy_spectrogram_num_frames(ls) == frames && vv_dsp_lazy_spectrogram_row_size(ls) == BINS;
+
+    // One tile plus a neighbour on each side
+    vv_dsp_lazy_spectrogram_stats st;
+    ok = ok && check_range(ls, ref, 5 * TILE + 3, 4, buf) && vv_dsp_lazy_spectrogram_get_stats(ls, &st) == VV_DSP_OK &&
+         st.computed == 3 && st.hits == 0 && st.cached == 3;
+    // The prefetched neighbour is a hit
+    ok = ok && check_range(ls, ref, 6 * TILE, TILE, buf) && vv_dsp_lazy_spectrogram_get_stats(ls, &st) == VV_DSP_OK &&
+         st.hits == 1 && st.computed == 4;
+
+    const size_t starts[] = { 0, 17, 250, 401, 33, 3 * TILE - 1 };
+    for (size_t k = 0; ok && k < sizeof(starts) / sizeof(starts[0]); ++k) {
+        ok = check_range(ls, ref, starts[k], 2 * TILE + 5, buf);
+    }
+    // Larger than the cache, and the last rows
+    ok = ok && check_range(ls, ref, 0, frames, buf) && check_range(ls, ref, frames - 3, 3, buf) &&
+         vv_dsp_lazy_spectrogram_get_stats(ls, &st) == VV_DSP_OK && st.cached == SLOTS && st.evicted > 0;
+    ok = ok && vv_dsp_lazy_spectrogram_get(ls, frames - 3, 4, buf) == VV_DSP_ERROR_OUT_OF_RANGE;
+    vv_dsp_lazy_spectrogram_destroy(ls);
+    free(buf);
+    return ok;
+}
+
+// Backing source serving stale rows from before an edit
+typedef struct {
+    const vv_dsp_real* rows;
+    size_t calls;
+} backing;
+
+static int fetch_rows(void* user, size_t first, size_t n, size_t row_size, vv_dsp_real* out) {
+    backing* b = (backing*)user;
+    memcpy(out, b->rows + first * row_size, n * row_size * sizeof(vv_dsp_real));
+    b->calls++;
+    return 1;
+}
+
+// An edit drops only the overlapping tiles, which are recomputed even with a backing
+static int test_edits(const vv_dsp_real* x, const vv_dsp_real* ref, size_t frames) {
+    vv_dsp_real* y = (vv_dsp_real*)malloc((LEN + 7000) * sizeof(vv_dsp_real));
+    vv_dsp_real* buf = (vv_dsp_real*)malloc((frames + 64) * BINS * sizeof(vv_dsp_real));
+    if (!y || !buf) {
+        free(y);
+        free(buf);
+        return 0;
+    }
+    memcpy(y, x, LEN * sizeof(vv_dsp_real));
+    vv_dsp_lazy_spectrogram_params p;
+    make_params(&p);
+    p.prefetch = 0;
+    p.cache_bytes = 0;  // the default budget holds every tile here
+    vv_dsp_lazy_spectrogram* ls = NULL;
+    backing b = { ref, 0 };
+    int ok = vv_dsp_lazy_spectrogram_create(&p, y, LEN, &ls) == VV_DSP_OK &&
+             vv_dsp_lazy_spectrogram_set_backing(ls, fetch_rows, &b) == VV_DSP_OK &&
+             check_range(ls, ref, 0, frames, buf) && b.calls == (frames + TILE - 1) / TILE;
+
+    // Samples of frames 100..105 (tile 6) change
+    const size_t e0 = 100 * HOP + FFT - 10, e1 = 105 * HOP + 5;
+    for (size_t t = e0; t < e1; ++t) y[t] = (vv_dsp_real)0.5;
+    vv_dsp_lazy_spectrogram_stats st;
+    size_t nf = 0;
+    vv_dsp_real* ref2 = reference(y, LEN, &nf);
+    ok = ok && ref2 && vv_dsp_lazy_spectrogram_invalidate(ls, e0, e1 - e0) == VV_DSP_OK &&
+         vv_dsp_lazy_spectrogram_get_stats(ls, &st) == VV_DSP_OK && st.invalidated == 1 &&
+         check_range(ls, ref2, 0, frames, buf) && vv_dsp_lazy_spectrogram_get_stats(ls, &st) == VV_DSP_OK &&
+         st.computed == 1;
+    free(ref2);
+
+    // Append 7000 samples: the old tail and the new tiles are computed
+    make_signal(y + LEN, 7000, 3u);
+    vv_dsp_real* ref3 = reference(y, LEN + 7000, &nf);
+    ok = ok && ref3 && vv_dsp_lazy_spectrogram_set_signal(ls, y, LEN + 7000) == VV_DSP_OK &&
+         vv_dsp_lazy_spectrogram_num_frames(ls) == nf && check_range(ls, ref3, 0, nf, buf);
+    free(ref3);
+
+    // Shrink below one frame
+    ref3 = reference(y, 100, &nf);
+    ok = ok && ref3 && nf == 1 && vv_dsp_lazy_spectrogram_set_signal(ls, y, 100) == VV_DSP_OK &&
+         check_range(ls, ref3, 0, 1, buf);
+    free(ref3);
+    vv_dsp_lazy_spectrogram_destroy(ls);
+    free(y);
+    free(buf);
+    return ok;
+}
+
+static int test_errors(const vv_dsp_real* x) {
+    vv_dsp_lazy_spectrogram_params p;
+    make_params(&p);
+    vv_dsp_lazy_spectrogram* ls = NULL;
+    int ok = vv_dsp_lazy_spectrogram_create(&p, NULL, 10, &ls) == VV_DSP_ERROR_NULL_POINTER && ls == NULL;
+    p.stft.hop_size = 0;
+    ok = ok && vv_dsp_lazy_spectrogram_create(&p, x, LEN, &ls) == VV_DSP_ERROR_INVALID_SIZE;
+    make_params(&p);
+    p.opts.floor = 0;
+    ok = ok && vv_dsp_lazy_spectrogram_create(&p, x, LEN, &ls) == VV_DSP_ERROR_OUT_OF_RANGE;
+    make_params(&p);
+    vv_dsp_real row[BINS];
+    ok = ok && vv_dsp_lazy_spectrogram_create(&p, x, LEN, &ls) == VV_DSP_OK &&
+         vv_dsp_lazy_spectrogram_get(ls, 0, 1, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_lazy_spectrogram_get(ls, 0, 0, NULL) == VV_DSP_OK &&
+         vv_dsp_lazy_spectrogram_get(ls, vv_dsp_lazy_spectrogram_num_frames(ls), 1, row) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_lazy_spectrogram_set_signal(ls, NULL, 5) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_lazy_spectrogram_destroy(ls);
+    vv_dsp_lazy_spectrogram_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    if (!x) return 1;
+    make_signal(x, LEN, 1u);
+    size_t frames = 0;
+    vv_dsp_real* ref = reference(x, LEN, &frames);
+    int rc = ref ? 0 : 1;
+    if (!rc && !test_random_access(x, ref, frames)) { fprintf(stderr, "lazy spectrogram access test failed\n"); rc = 1; }
+    if (!rc && !test_edits(x, ref, frames)) { fprintf(stderr, "lazy spectrogram edit test failed\n"); rc = 1; }
+    if (!test_errors(x)) { fprintf(stderr, "lazy spectrogram error test failed\n"); rc = 1; }
+    free(ref);
+    free(x);
+    if (rc == 0) printf("lazy spectrogram tests passed\n");
+    return rc;
+}
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+// Per-frame reference: same conditioning by hand, then the one-shot vv_dsp_lpc()
+static void ref_frame(const vv_dsp_real* in, size_t n, const vv_dsp_real* win, vv_dsp_real pre,
+                      vv_dsp_real* x) {
+    x[0] = in[0];
+    for (size_t i = 1; i < n; ++i) x[i] = (pre != (vv_dsp_real)0) ? in[i] - pre * in[i - 1] : in[i];
+    if (win) for (size_t i = 0; i < n; ++i) x[i] *= win[i];
+}
+
+static int test_against_lpc(size_t threads, int use_window, vv_dsp_real pre) {
+    enum { LEN = 320, ORDER = 12, HOP = 80, FRAMES = 150 };
+    const size_t total = (FRAMES - 1) * HOP + LEN;
+    vv_dsp_real* sig = (vv_dsp_real*)malloc(total * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(FRAMES * (ORDER + 1) * sizeof(vv_dsp_real));
+    vv_dsp_real* k = (vv_dsp_real*)malloc(FRAMES * ORDER * sizeof(vv_dsp_real));
+    vv_dsp_real* e = (vv_dsp_real*)malloc(FRAMES * sizeof(vv_dsp_real));
+    vv_dsp_real win[LEN], x[LEN], ar[ORDER + 1], er;
+    int ok = sig && a && k && e;
+    for (size_t i = 0; ok && i < total; ++i) {
+        sig[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.5 * sin(0.31 * (double)i) + 0.01 * (double)(i % 7));
+    }
+    for (size_t i = 0; i < LEN; ++i) win[i] = (vv_dsp_real)(0.54 - 0.46 * cos(2.0 * 3.14159265358979 * (double)i / (LEN - 1)));
+
+    vv_dsp_lpc_params p = { ORDER, LEN, use_window ? win : NULL, pre, threads };
+    vv_dsp_lpc_plan* plan = NULL;
+    ok = ok && vv_dsp_lpc_plan_create(&p, &plan) == VV_DSP_OK;
+    ok = ok && vv_dsp_lpc_plan_process(plan, sig, FRAMES, HOP, a, k, e) == VV_DSP_OK;
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        ref_frame(&sig[f * HOP], LEN, use_window ? win : NULL, pre, x);
+        ok = vv_dsp_lpc(x, LEN, ORDER, ar, &er) == VV_DSP_OK;
+        for (size_t i = 0; ok && i <= ORDER; ++i) {
+            if (fabsf(a[f * (ORDER + 1) + i] - ar[i]) > 1e-4f * (1.0f + fabsf(ar[i]))) {
+                fprintf(stderr, "threads=%zu frame %zu a[%zu]: %g vs %g\n", threads, f, i,
+                        (double)a[f * (ORDER + 1) + i], (double)ar[i]);
+                ok = 0;
+            }
+        }
+        if (ok && fabsf(e[f] - er) > 1e-4f * (1.0f + fabsf(er))) ok = 0;
+        // Last reflection coefficient is the last predictor tap
+        if (ok && k[f * ORDER + ORDER - 1] != a[f * (ORDER + 1) + ORDER]) ok = 0;
+    }
+    vv_dsp_lpc_plan_destroy(plan);
+    free(sig); free(a); free(k); free(e);
+    return ok;
+}
+
+static int test_silent_and_errors(void) {
+    enum { LEN = 64, ORDER = 4 };
+    vv_dsp_real zeros[LEN * 2], a[2 * (ORDER + 1)], k[2 * ORDER], e[2];
+    memset(zeros, 0, sizeof(zeros));
+    vv_dsp_lpc_params p = { ORDER, LEN, NULL, 0.97f, 1 };
+    vv_dsp_lpc_plan* plan = NULL;
+    if (vv_dsp_lpc_plan_create(&p, &plan) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_lpc_plan_process(plan, zeros, 2, LEN, a, k, e) == VV_DSP_OK;
+    for (size_t f = 0; ok && f < 2; ++f) {
+        ok = a[f * (ORDER + 1)] == 1.0f && e[f] == 0.0f;
+        for (size_t i = 1; ok && i <= ORDER; ++i) ok = a[f * (ORDER + 1) + i] == 0.0f && k[f * ORDER + i - 1] == 0.0f;
+    }
+    // Optional outputs may be omitted
+    ok = ok && vv_dsp_lpc_plan_process(plan, zeros, 1, LEN, a, NULL, NULL) == VV_DSP_OK;
+    ok = ok && vv_dsp_lpc_plan_process(plan, zeros, 0, LEN, a, k, e) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_lpc_plan_process(plan, zeros, 1, 0, a, k, e) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_lpc_plan_process(plan, NULL, 1, LEN, a, k, e) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_lpc_plan_destroy(plan);
+
+    vv_dsp_lpc_plan* bad = NULL;
+    vv_dsp_lpc_params q = { LEN, LEN, NULL, 0, 1 };
+    ok = ok && vv_dsp_lpc_plan_create(&q, &bad) == VV_DSP_ERROR_INVALID_SIZE && bad == NULL;
+    q.order = 0;
+    ok = ok && vv_dsp_lpc_plan_create(&q, &bad) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_lpc_plan_create(NULL, &bad) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_lpc_plan_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    const size_t threads[] = { 1, 4, 0 };
+    for (size_t t = 0; t < 3; ++t) {
+        if (!test_against_lpc(threads[t], 0, 0.0f)) return 1;
+        if (!test_against_lpc(threads[t], 1, 0.97f)) return 1;
+    }
+    if (!test_silent_and_errors()) {
+        fprintf(stderr, "lpc plan silent/error handling failed\n");
+        return 1;
+    }
+    printf("lpc plan tests passed\n");
+    return 0;
+}
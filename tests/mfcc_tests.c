@@ -1,7 +1,10 @@
 #include "vv_dsp/features/mel.h"
+#include "vv_dsp/core/simd_core.h"
 #include "vv_dsp/vv_dsp_types.h"
+#include "vv_dsp/vv_dsp_math.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #define TOLERANCE 1e-3f
@@ -178,6 +181,409 @@ static int test_mfcc_basic(void) {
     return 0;
 }
 
+static int test_mel_sparse(void) {
+    printf("Testing sparse Mel filterbank...\n");
+
+    const size_t n_fft = 2048, n_mels = 80, n_bins = n_fft / 2 + 1, frames = 3;
+    vv_dsp_real* dense = NULL;
+    vv_dsp_mel_sparse* fb = NULL;
+    size_t num_filters = 0, filter_len = 0;
+    if (vv_dsp_mel_filterbank_create(n_fft, n_mels, 22050.0f, 0.0f, 11025.0f, VV_DSP_MEL_VARIANT_HTK,
+                                     &dense, &num_filters, &filter_len) != VV_DSP_OK ||
+        vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, 22050.0f, 0.0f, 11025.0f, VV_DSP_MEL_VARIANT_HTK,
+                                            &fb) != VV_DSP_OK) {
+        printf("ERROR: Failed to create filterbanks\n");
+        vv_dsp_mel_filterbank_free(dense, n_mels);
+        return 1;
+    }
+
+    // Spans hold every nonzero weight, and far fewer than the dense matrix
+    int errors = 0;
+    size_t total = 0;
+    for (size_t m = 0; m < n_mels; m++) {
+        total += fb->length[m];
+        for (size_t k = 0; k < n_bins; k++) {
+            const int inside = k >= fb->start[m] && k < fb->start[m] + fb->length[m];
+            const vv_dsp_real w = inside ? fb->weights[fb->offset[m] + k - fb->start[m]] : 0.0f;
+            if (w != dense[m * n_bins + k]) errors = 1;
+        }
+    }
+    if (errors || total * 10 > n_mels * n_bins) {
+        printf("ERROR: Sparse spans wrong or too large (%zu of %zu)\n", total, n_mels * n_bins);
+        errors = 1;
+    }
+
+    // Same log-Mel spectrogram as the dense projection
+    vv_dsp_real* power = (vv_dsp_real*)malloc(frames * n_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    if (!power || !a || !b) errors = 1;
+    for (size_t i = 0; !errors && i < frames * n_bins; i++) {
+        power[i] = (vv_dsp_real)(1.0 + sin(0.37 * (double)i)) * (vv_dsp_real)(1.0 + (double)(i % 7));
+    }
+    if (!errors && (vv_dsp_compute_log_mel_spectrogram(power, frames, n_bins, dense, n_mels, 1e-10f, a) != VV_DSP_OK ||
+                    vv_dsp_compute_log_mel_spectrogram_sparse(power, frames, fb, 1e-10f, b) != VV_DSP_OK)) {
+        errors = 1;
+    }
+    for (size_t i = 0; !errors && i < frames * n_mels; i++) {
+        if (fabs((double)a[i] - (double)b[i]) > 1e-5) {
+            printf("ERROR: Sparse log-Mel differs at %zu: %f vs %f\n", i, (double)b[i], (double)a[i]);
+            errors = 1;
+        }
+    }
+
+    // An all-zero band gets an empty span
+    vv_dsp_real rows[2 * 4] = {0.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    vv_dsp_mel_sparse* small = NULL;
+    if (!errors && (vv_dsp_mel_sparse_from_dense(rows, 2, 4, &small) != VV_DSP_OK || small->start[0] != 1 ||
+                    small->length[0] != 2 || small->length[1] != 0)) {
+        printf("ERROR: Sparse conversion of a small bank failed\n");
+        errors = 1;
+    }
+
+    vv_dsp_mel_sparse_destroy(small);
+    vv_dsp_mel_sparse_destroy(fb);
+    vv_dsp_mel_filterbank_free(dense, n_mels);
+    free(power);
+    free(a);
+    free(b);
+    if (errors) return 1;
+    printf("Sparse Mel filterbank PASSED\n");
+    return 0;
+}
+
+static int test_mfcc_plan_matches(void) {
+    printf("Testing MFCC plan against the unfused pipeline...\n");
+
+    const size_t n_fft = 512, n_mels = 40, n_coeffs = 20, n_bins = n_fft / 2 + 1, frames = 37;
+    vv_dsp_mfcc_plan* plan = NULL;
+    vv_dsp_mel_sparse* fb = NULL;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &plan) != VV_DSP_OK ||
+        vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                                            &fb) != VV_DSP_OK) {
+        printf("ERROR: Failed to create MFCC plan or filterbank\n");
+        if (plan) vv_dsp_mfcc_destroy(plan);
+        return 1;
+    }
+
+    int errors = 0;
+    vv_dsp_real* power = (vv_dsp_real*)malloc(frames * n_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* log_mel = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(frames * n_coeffs * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(frames * n_coeffs * sizeof(vv_dsp_real));
+    if (!power || !log_mel || !a || !b) errors = 1;
+    for (size_t i = 0; !errors && i < frames * n_bins; i++) {
+        power[i] = (vv_dsp_real)((1.1 + cos(0.013 * (double)i)) / (1.0 + (double)(i % n_bins) * 0.05));
+    }
+    if (!errors && (vv_dsp_compute_log_mel_spectrogram_sparse(power, frames, fb, 1e-10f, log_mel) != VV_DSP_OK ||
+                    vv_dsp_mfcc(log_mel, frames, n_mels, n_coeffs, VV_DSP_DCT_II, 22.0f, a) != VV_DSP_OK ||
+                    vv_dsp_mfcc_process(plan, power, frames, b) != VV_DSP_OK)) {
+        printf("ERROR: MFCC computation failed\n");
+        errors = 1;
+    }
+    for (size_t i = 0; !errors && i < frames * n_coeffs; i++) {
+        if (fabs((double)a[i] - (double)b[i]) > 1e-4 * (1.0 + fabs((double)a[i]))) {
+            printf("ERROR: Plan output differs at %zu: %f vs %f\n", i, (double)b[i], (double)a[i]);
+            errors = 1;
+        }
+    }
+
+    // Unsupported settings are rejected when the plan is made
+    vv_dsp_mfcc_plan* bad = NULL;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 0.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_IV, 0.0f, 1e-10f, &bad) != VV_DSP_ERROR_OUT_OF_RANGE) {
+        printf("ERROR: DCT-IV MFCC plan was not rejected\n");
+        errors = 1;
+    }
+
+    vv_dsp_mel_sparse_destroy(fb);
+    vv_dsp_mfcc_destroy(plan);
+    free(power);
+    free(log_mel);
+    free(a);
+    free(b);
+    if (errors) return 1;
+    printf("MFCC plan PASSED\n");
+    return 0;
+}
+
+static int test_mfcc_plan_fast_log(void) {
+    printf("Testing MFCC plan with the fast log...\n");
+
+    // The approximation itself, over many decades
+    int errors = 0;
+    vv_dsp_real x[256], y[256];
+    for (size_t i = 0; i < 256; i++) {
+        x[i] = (vv_dsp_real)pow(10.0, -30.0 + 60.0 * (double)i / 255.0) * (vv_dsp_real)(1.0 + 0.37 * sin((double)i));
+    }
+    if (vv_dsp_log_real_fast(x, y, 256) != VV_DSP_OK) errors = 1;
+    for (size_t i = 0; !errors && i < 256; i++) {
+        const double ref = log((double)x[i]);
+        if (fabs((double)y[i] - ref) > 1.2e-7 * (1.0 + fabs(ref))) {
+            printf("ERROR: fast log(%g) = %.9f, expected %.9f\n", (double)x[i], (double)y[i], ref);
+            errors = 1;
+        }
+    }
+
+    const size_t n_fft = 512, n_mels = 40, n_coeffs = 13, n_bins = n_fft / 2 + 1, frames = 9;
+    vv_dsp_mfcc_plan* exact = NULL;
+    vv_dsp_mfcc_plan* fast = NULL;
+    vv_dsp_mfcc_plan* fastest = NULL;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &exact) != VV_DSP_OK ||
+        vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &fast) != VV_DSP_OK ||
+        vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &fastest) != VV_DSP_OK ||
+        vv_dsp_mfcc_set_log_accuracy(fast, VV_DSP_LOG_ACCURACY_FAST) != VV_DSP_OK ||
+        vv_dsp_mfcc_set_log_accuracy(fast, (vv_dsp_log_accuracy)7) != VV_DSP_ERROR_OUT_OF_RANGE ||
+        vv_dsp_mfcc_set_precision(fastest, VV_DSP_PRECISION_FAST) != VV_DSP_OK ||
+        vv_dsp_mfcc_set_precision(fastest, (vv_dsp_precision_mode)7) != VV_DSP_ERROR_OUT_OF_RANGE) {
+        printf("ERROR: Failed to set up fast-log MFCC plan\n");
+        if (exact) vv_dsp_mfcc_destroy(exact);
+        if (fast) vv_dsp_mfcc_destroy(fast);
+        if (fastest) vv_dsp_mfcc_destroy(fastest);
+        return 1;
+    }
+
+    vv_dsp_real* power = (vv_dsp_real*)malloc(frames * n_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(frames * n_coeffs * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(frames * n_coeffs * sizeof(vv_dsp_real));
+    if (!power || !a || !b) errors = 1;
+    for (size_t i = 0; !errors && i < frames * n_bins; i++) {
+        power[i] = (vv_dsp_real)(1e-3 * (1.5 + sin(0.07 * (double)i)) / (1.0 + (double)(i % n_bins)));
+    }
+    if (!errors && (vv_dsp_mfcc_process(exact, power, frames, a) != VV_DSP_OK ||
+                    vv_dsp_mfcc_process(fast, power, frames, b) != VV_DSP_OK)) {
+        printf("ERROR: MFCC computation failed\n");
+        errors = 1;
+    }
+    for (size_t i = 0; !errors && i < frames * n_coeffs; i++) {
+        if (fabs((double)a[i] - (double)b[i]) > 1e-4 * (1.0 + fabs((double)a[i]))) {
+            printf("ERROR: Fast-log output differs at %zu: %f vs %f\n", i, (double)b[i], (double)a[i]);
+            errors = 1;
+        }
+    }
+    // PRECISION_FAST: each log-mel energy within 7e-5, summed over n_mels by the DCT
+    if (!errors && vv_dsp_mfcc_process(fastest, power, frames, b) != VV_DSP_OK) {
+        printf("ERROR: Fast-precision MFCC computation failed\n");
+        errors = 1;
+    }
+    for (size_t i = 0; !errors && i < frames * n_coeffs; i++) {
+        if (fabs((double)a[i] - (double)b[i]) > 5e-3 * (1.0 + fabs((double)a[i]))) {
+            printf("ERROR: Fast-precision output differs at %zu: %f vs %f\n", i, (double)b[i], (double)a[i]);
+            errors = 1;
+        }
+    }
+
+    vv_dsp_mfcc_destroy(exact);
+    vv_dsp_mfcc_destroy(fast);
+    vv_dsp_mfcc_destroy(fastest);
+    free(power);
+    free(a);
+    free(b);
+    if (errors) return 1;
+    printf("MFCC fast log PASSED\n");
+    return 0;
+}
+
+static int test_mfcc_parallel(void) {
+    printf("Testing frame-parallel MFCC and log-mel...\n");
+
+    // Several tiles (n_fft 512 gives 63 frames per tile) and a ragged last one
+    const size_t n_fft = 512, n_mels = 40, n_coeffs = 13, n_bins = n_fft / 2 + 1, frames = 300;
+    vv_dsp_mfcc_plan* plan = NULL;
+    vv_dsp_mel_sparse* fb = NULL;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &plan) != VV_DSP_OK ||
+        vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                                            &fb) != VV_DSP_OK) {
+        printf("ERROR: Failed to create MFCC plan or filterbank\n");
+        if (plan) vv_dsp_mfcc_destroy(plan);
+        return 1;
+    }
+
+    int errors = 0;
+    vv_dsp_real* power = (vv_dsp_real*)malloc(frames * n_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    if (!power || !a || !b) errors = 1;
+    for (size_t i = 0; !errors && i < frames * n_bins; i++) {
+        power[i] = (vv_dsp_real)((1.2 + sin(0.0071 * (double)i)) / (1.0 + (double)(i % n_bins) * 0.03));
+    }
+
+    const size_t threads[4] = {0, 1, 3, 8};
+    for (int fast = 0; !errors && fast < 2; fast++) {
+        if (vv_dsp_mfcc_set_log_accuracy(plan, fast ? VV_DSP_LOG_ACCURACY_FAST : VV_DSP_LOG_ACCURACY_EXACT) != VV_DSP_OK ||
+            vv_dsp_mfcc_process(plan, power, frames, a) != VV_DSP_OK) {
+            errors = 1;
+            break;
+        }
+        for (size_t t = 0; !errors && t < 4; t++) {
+            memset(b, 0, frames * n_coeffs * sizeof(vv_dsp_real));
+            if (vv_dsp_mfcc_process_parallel(plan, power, frames, b, threads[t]) != VV_DSP_OK ||
+                memcmp(a, b, frames * n_coeffs * sizeof(vv_dsp_real)) != 0) {
+                printf("ERROR: Parallel MFCC (%zu threads, fast=%d) differs from serial\n", threads[t], fast);
+                errors = 1;
+            }
+        }
+    }
+
+    if (!errors && vv_dsp_compute_log_mel_spectrogram_sparse(power, frames, fb, 1e-10f, a) != VV_DSP_OK) {
+        errors = 1;
+    }
+    for (size_t t = 0; !errors && t < 4; t++) {
+        memset(b, 0, frames * n_mels * sizeof(vv_dsp_real));
+        if (vv_dsp_compute_log_mel_spectrogram_parallel(power, frames, fb, 1e-10f, b, threads[t]) != VV_DSP_OK ||
+            memcmp(a, b, frames * n_mels * sizeof(vv_dsp_real)) != 0) {
+            printf("ERROR: Parallel log-mel (%zu threads) differs from serial\n", threads[t]);
+            errors = 1;
+        }
+    }
+    if (!errors && (vv_dsp_mfcc_process_parallel(plan, power, 0, b, 2) != VV_DSP_ERROR_INVALID_SIZE ||
+                    vv_dsp_compute_log_mel_spectrogram_parallel(power, frames, fb, -1.0f, b, 2) != VV_DSP_ERROR_OUT_OF_RANGE)) {
+        printf("ERROR: Bad parallel batch arguments were not rejected\n");
+        errors = 1;
+    }
+
+    vv_dsp_mel_sparse_destroy(fb);
+    vv_dsp_mfcc_destroy(plan);
+    free(power);
+    free(a);
+    free(b);
+    if (errors) return 1;
+    printf("Parallel MFCC PASSED\n");
+    return 0;
+}
+
+static int test_mel_tiling(void) {
+    printf("Testing frame-tiled batches against single frames...\n");
+
+    // A frame count that leaves a ragged last tile
+    const size_t n_fft = 512, n_mels = 40, n_coeffs = 13, n_bins = n_fft / 2 + 1, frames = 21;
+    vv_dsp_mfcc_plan* plan = NULL;
+    vv_dsp_mel_sparse* fb = NULL;
+    vv_dsp_real* dense = NULL;
+    size_t nf = 0, len = 0;
+    if (vv_dsp_mfcc_init(n_fft, n_mels, n_coeffs, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                         VV_DSP_DCT_II, 22.0f, 1e-10f, &plan) != VV_DSP_OK ||
+        vv_dsp_mel_filterbank_create_sparse(n_fft, n_mels, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK,
+                                            &fb) != VV_DSP_OK ||
+        vv_dsp_mel_filterbank_create(n_fft, n_mels, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, &dense, &nf,
+                                     &len) != VV_DSP_OK) {
+        printf("ERROR: Failed to create MFCC plan or filterbanks\n");
+        vv_dsp_mel_sparse_destroy(fb);
+        if (plan) vv_dsp_mfcc_destroy(plan);
+        return 1;
+    }
+
+    int errors = 0;
+    vv_dsp_real* power = (vv_dsp_real*)malloc(frames * n_bins * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(frames * n_mels * sizeof(vv_dsp_real));
+    if (!power || !a || !b) errors = 1;
+    for (size_t i = 0; !errors && i < frames * n_bins; i++) {
+        power[i] = (vv_dsp_real)(0.01 + fabs(sin(0.37 * (double)i) * cos(0.011 * (double)i)));
+    }
+
+    // Whole batches and frame-by-frame calls agree bit for bit
+    for (int fast = 0; !errors && fast < 2; fast++) {
+        errors = vv_dsp_mfcc_set_precision(plan, fast ? VV_DSP_PRECISION_FAST : VV_DSP_PRECISION_EXACT) != VV_DSP_OK ||
+                 vv_dsp_mfcc_process(plan, power, frames, a) != VV_DSP_OK;
+        for (size_t f = 0; !errors && f < frames; f++) {
+            errors = vv_dsp_mfcc_process(plan, power + f * n_bins, 1, b + f * n_coeffs) != VV_DSP_OK;
+        }
+        if (!errors && memcmp(a, b, frames * n_coeffs * sizeof(vv_dsp_real)) != 0) {
+            printf("ERROR: Batched MFCC (precision %d) differs from single frames\n", fast);
+            errors = 1;
+        }
+    }
+    errors = errors || vv_dsp_compute_log_mel_spectrogram_sparse(power, frames, fb, 1e-10f, a) != VV_DSP_OK;
+    for (size_t f = 0; !errors && f < frames; f++) {
+        errors = vv_dsp_mel_sparse_project(fb, power + f * n_bins, b + f * n_mels) != VV_DSP_OK;
+        for (size_t m = 0; m < n_mels; m++) b[f * n_mels + m] = VV_DSP_LOG(b[f * n_mels + m] + (vv_dsp_real)1e-10f);
+    }
+    if (!errors && memcmp(a, b, frames * n_mels * sizeof(vv_dsp_real)) != 0) {
+        printf("ERROR: Batched sparse log-mel differs from single frames\n");
+        errors = 1;
+    }
+    errors = errors || vv_dsp_compute_log_mel_spectrogram(power, frames, n_bins, dense, n_mels, 1e-10f, a) != VV_DSP_OK;
+    for (size_t f = 0; !errors && f < frames; f++) {
+        errors = vv_dsp_compute_log_mel_spectrogram(power + f * n_bins, 1, n_bins, dense, n_mels, 1e-10f,
+                                                    b + f * n_mels) != VV_DSP_OK;
+    }
+    if (!errors && memcmp(a, b, frames * n_mels * sizeof(vv_dsp_real)) != 0) {
+        printf("ERROR: Batched dense log-mel differs from single frames\n");
+        errors = 1;
+    }
+
+    vv_dsp_mel_filterbank_free(dense, n_mels);
+    vv_dsp_mel_sparse_destroy(fb);
+    vv_dsp_mfcc_destroy(plan);
+    free(power);
+    free(a);
+    free(b);
+    if (errors) return 1;
+    printf("Frame tiling PASSED\n");
+    return 0;
+}
+
+static int test_mel_cache(void) {
+    printf("Testing shared filterbank cache...\n");
+
+    // A configuration no other test uses
+    const size_t n_fft = 1024, n_mels = 23;
+    vv_dsp_mel_cache_stats before, mid, after;
+    vv_dsp_mfcc_plan* p1 = NULL;
+    vv_dsp_mfcc_plan* p2 = NULL;
+    const vv_dsp_mel_sparse* fb = NULL;
+    int errors = vv_dsp_mel_cache_get_stats(&before) != VV_DSP_OK;
+    if (!errors && (vv_dsp_mfcc_init(n_fft, n_mels, 13, 22050.0f, 30.0f, 11025.0f, VV_DSP_MEL_VARIANT_HTK,
+                                     VV_DSP_DCT_II, 0.0f, 1e-10f, &p1) != VV_DSP_OK ||
+                    vv_dsp_mfcc_init(n_fft, n_mels, 20, 22050.0f, 30.0f, 11025.0f, VV_DSP_MEL_VARIANT_HTK,
+                                     VV_DSP_DCT_II, 22.0f, 1e-6f, &p2) != VV_DSP_OK ||
+                    vv_dsp_mel_sparse_acquire(n_fft, n_mels, 22050.0f, 30.0f, 11025.0f, VV_DSP_MEL_VARIANT_HTK,
+                                              &fb) != VV_DSP_OK ||
+                    vv_dsp_mel_cache_get_stats(&mid) != VV_DSP_OK)) {
+        printf("ERROR: Failed to create cached plans\n");
+        errors = 1;
+    }
+    // One build, then two lookups, all holding the same entry
+    if (!errors && (mid.misses != before.misses + 1 || mid.hits != before.hits + 2 ||
+                    mid.entries != before.entries + 1 || fb->n_mels != n_mels)) {
+        printf("ERROR: Cache counters %zu/%zu/%zu after %zu/%zu/%zu\n", mid.hits, mid.misses, mid.entries,
+               before.hits, before.misses, before.entries);
+        errors = 1;
+    }
+
+    // Plans sharing an entry still agree with the unshared pipeline
+    vv_dsp_real power[513], log_mel[23], ref[20], got[20];
+    for (size_t k = 0; k < 513; k++) power[k] = (vv_dsp_real)(1.0 + 0.5 * cos(0.05 * (double)k));
+    if (!errors && (vv_dsp_compute_log_mel_spectrogram_sparse(power, 1, fb, 1e-6f, log_mel) != VV_DSP_OK ||
+                    vv_dsp_mfcc(log_mel, 1, n_mels, 20, VV_DSP_DCT_II, 22.0f, ref) != VV_DSP_OK ||
+                    vv_dsp_mfcc_process(p2, power, 1, got) != VV_DSP_OK)) {
+        errors = 1;
+    }
+    for (size_t i = 0; !errors && i < 20; i++) {
+        if (fabs((double)ref[i] - (double)got[i]) > 1e-4 * (1.0 + fabs((double)ref[i]))) {
+            printf("ERROR: Shared-plan coefficient %zu: %f vs %f\n", i, (double)got[i], (double)ref[i]);
+            errors = 1;
+        }
+    }
+
+    if (p1) vv_dsp_mfcc_destroy(p1);
+    if (p2) vv_dsp_mfcc_destroy(p2);
+    vv_dsp_mel_sparse_release(fb);
+    if (!errors && (vv_dsp_mel_cache_get_stats(&after) != VV_DSP_OK || after.entries != before.entries)) {
+        printf("ERROR: Cache entry outlived its last holder\n");
+        errors = 1;
+    }
+    if (errors) return 1;
+    printf("Filterbank cache PASSED\n");
+    return 0;
+}
+
 int main(void) {
     printf("=== VV-DSP MFCC Tests ===\n");
 
@@ -186,6 +592,12 @@ int main(void) {
     errors += test_mel_scale_conversions();
     errors += test_mel_filterbank_creation();
     errors += test_mfcc_basic();
+    errors += test_mel_sparse();
+    errors += test_mfcc_plan_matches();
+    errors += test_mfcc_plan_fast_log();
+    errors += test_mfcc_parallel();
+    errors += test_mel_tiling();
+    errors += test_mel_cache();
 
     if (errors == 0) {
         printf("\nAll MFCC tests PASSED!\n");
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+static int cmp_double(const void* a, const void* b) {
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Brute-force statistic of x[lo..t] of channel c
+static double ref_stat(vv_dsp_moving_kind kind, const vv_dsp_real* x, size_t C, size_t c, size_t t, size_t W) {
+    const size_t lo = (t + 1 >= W) ? t + 1 - W : 0, cnt = t + 1 - lo;
+    double buf[64], acc = 0.0;
+    for (size_t j = 0; j < cnt; ++j) buf[j] = (double)x[(lo + j) * C + c];
+    switch (kind) {
+        case VV_DSP_MOVING_MEAN:
+            for (size_t j = 0; j < cnt; ++j) acc += buf[j];
+            return acc / (double)cnt;
+        case VV_DSP_MOVING_RMS:
+            for (size_t j = 0; j < cnt; ++j) acc += buf[j] * buf[j];
+            return sqrt(acc / (double)cnt);
+        case VV_DSP_MOVING_MIN:
+        case VV_DSP_MOVING_MAX:
+            acc = buf[0];
+            for (size_t j = 1; j < cnt; ++j)
+                acc = (kind == VV_DSP_MOVING_MIN) ? fmin(acc, buf[j]) : fmax(acc, buf[j]);
+            return acc;
+        case VV_DSP_MOVING_MEDIAN:
+            qsort(buf, cnt, sizeof(double), cmp_double);
+            return (cnt & 1) ? buf[cnt / 2] : 0.5 * (buf[cnt / 2 - 1] + buf[cnt / 2]);
+    }
+    return 0.0;
+}
+
+// Interleaved channels, uneven blocks, in place, against the brute force
+static int check_kind(vv_dsp_moving_kind kind, size_t W) {
+    enum { C = 3, N = 700 };
+    vv_dsp_real x[N * C], y[N * C];
+    unsigned s = 777u + (unsigned)W;
+    for (size_t i = 0; i < N * C; ++i) {
+        s = s * 1103515245u + 12345u;
+        // Small integers give plenty of ties for the deque and heap
+        x[i] = (i % C == 2) ? (vv_dsp_real)((s >> 16) % 7) - 3 : (vv_dsp_real)((double)((s >> 8) & 0xFFFF) / 65536.0 - 0.3);
+    }
+    memcpy(y, x, sizeof(x));
+    vv_dsp_moving* m = NULL;
+    if (vv_dsp_moving_create(kind, W, C, &m) != VV_DSP_OK) return 0;
+    const size_t blocks[4] = {1, W + 3, 2, 97};
+    size_t pos = 0, b = 0;
+    int ok = 1;
+    while (pos < N && ok) {
+        size_t n = blocks[b++ % 4];
+        if (n > N - pos) n = N - pos;
+        ok = vv_dsp_moving_process(m, y + pos * C, y + pos * C, n) == VV_DSP_OK;
+        pos += n;
+    }
+    for (size_t t = 0; t < N && ok; ++t) {
+        for (size_t c = 0; c < C; ++c) {
+            const double r = ref_stat(kind, x, C, c, t, W);
+            if (fabs((double)y[t * C + c] - r) > 1e-5) {
+                fprintf(stderr, "kind %d W=%zu: mismatch at t=%zu c=%zu: %g vs %g\n", (int)kind, W, t, c,
+                        (double)y[t * C + c], r);
+                ok = 0;
+                break;
+            }
+        }
+    }
+    // Reset starts a new partial window
+    if (ok) {
+        vv_dsp_real out[C];
+        ok = vv_dsp_moving_reset(m) == VV_DSP_OK && vv_dsp_moving_process(m, x, out, 1) == VV_DSP_OK;
+        for (size_t c = 0; ok && c < C; ++c) {
+            const double r = (kind == VV_DSP_MOVING_RMS) ? fabs((double)x[c]) : (double)x[c];
+            if (fabs((double)out[c] - r) > 1e-6) ok = 0;
+        }
+    }
+    vv_dsp_moving_destroy(m);
+    return ok;
+}
+
+// A large offset plus a tiny signal: the running sum must not drift
+static int test_long_mean(void) {
+    enum { W = 100, N = 300000, BLK = 4096 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_moving* m = NULL;
+    int ok = x && y && vv_dsp_moving_create(VV_DSP_MOVING_MEAN, W, 1, &m) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < N; ++i) x[i] = (vv_dsp_real)(1000.0 + 0.01 * sin(0.001 * (double)i) + (double)((i * 37u) % 11u) * 0.1);
+    for (size_t p = 0; ok && p < N; p += BLK)
+        ok = vv_dsp_moving_process(m, x + p, y + p, (N - p < BLK) ? N - p : BLK) == VV_DSP_OK;
+    for (size_t t = N - 1000; ok && t < N; ++t) {
+        double r = 0.0;
+        for (size_t j = t + 1 - W; j <= t; ++j) r += (double)x[j];
+        r /= W;
+        if (fabs((double)y[t] - r) > 1e-3) {
+            fprintf(stderr, "long mean drifted at %zu: %.6f vs %.6f\n", t, (double)y[t], r);
+            ok = 0;
+        }
+    }
+    vv_dsp_moving_destroy(m);
+    free(x);
+    free(y);
+    return ok;
+}
+
+int main(void) {
+    const vv_dsp_moving_kind kinds[5] = {VV_DSP_MOVING_MEAN, VV_DSP_MOVING_RMS, VV_DSP_MOVING_MIN,
+                                         VV_DSP_MOVING_MAX, VV_DSP_MOVING_MEDIAN};
+    const size_t windows[5] = {1, 2, 5, 16, 33};
+    for (size_t k = 0; k < 5; ++k) {
+        for (size_t w = 0; w < 5; ++w) {
+            if (!check_kind(kinds[k], windows[w])) {
+                fprintf(stderr, "moving filter kind %d window %zu failed\n", (int)kinds[k], windows[w]);
+                return 1;
+            }
+        }
+    }
+    if (!test_long_mean()) return 1;
+    vv_dsp_moving* m = NULL;
+    if (vv_dsp_moving_create(VV_DSP_MOVING_MEAN, 0, 1, &m) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+    if (vv_dsp_moving_create((vv_dsp_moving_kind)9, 4, 1, &m) != VV_DSP_ERROR_OUT_OF_RANGE) return 1;
+    printf("moving filter tests passed\n");
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, FFT = 1024, HOP = 256, LEN = 4 * SR, MAX_ONSETS = 64 };
+static const double ONSETS[] = { 0.5, 1.1, 1.45, 2.2, 2.75, 3.4 };
+#define NUM_ONSETS (sizeof(ONSETS) / sizeof(ONSETS[0]))
+
+// Low noise with decaying plucked tones (a few harmonics) starting at ONSETS
+static void make_signal(vv_dsp_real* x, size_t n, unsigned int seed) {
+    for (size_t t = 0; t < n; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        double v = 0.01 * ((double)(seed >> 8) / 16777216.0 - 0.5);
+        for (size_t k = 0; k < NUM_ONSETS; ++k) {
+            const double tt = (double)t / SR - ONSETS[k];
+            if (tt < 0) continue;
+            const double f0 = 220.0 * (1.0 + 0.25 * (double)k);
+            for (int h = 1; h <= 4; ++h) v += 0.3 / h * exp(-6.0 * tt) * sin(2.0 * VV_DSP_PI_D * f0 * h * tt);
+        }
+        x[t] = (vv_dsp_real)v;
+    }
+}
+
+static void make_params(vv_dsp_onset_params* p) {
+    memset(p, 0, sizeof(*p));
+    p->fft_size = FFT;
+    p->hop_size = HOP;
+    p->sample_rate = SR;
+    p->delta = (vv_dsp_real)0.5;
+    p->post_max = 2;
+    p->min_gap = 4;
+    p->window = VV_DSP_STFT_WIN_HANN;
+}
+
+// Stream x through an STFT in blocks of `block` frames into a detector
+static int stream(const vv_dsp_real* x, size_t n, size_t block, vv_dsp_real* times, size_t* count) {
+    vv_dsp_onset_params p;
+    make_params(&p);
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = FFT;
+    sp.hop_size = HOP;
+    sp.window = VV_DSP_STFT_WIN_HANN;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    sp.periodic = 1;
+    vv_dsp_stft* h = NULL;
+    vv_dsp_onset* od = NULL;
+    const size_t bins = FFT / 2 + 1;
+    vv_dsp_cpx* spec = (vv_dsp_cpx*)malloc(block * bins * sizeof(vv_dsp_cpx));
+    vv_dsp_real* strength = (vv_dsp_real*)malloc(block * sizeof(vv_dsp_real));
+    vv_dsp_real* found = (vv_dsp_real*)malloc((block + 2) * sizeof(vv_dsp_real));
+    int ok = spec && strength && found && vv_dsp_stft_create(&sp, &h) == VV_DSP_OK &&
+             vv_dsp_onset_create(&p, &od) == VV_DSP_OK && vv_dsp_onset_latency(od) == 2;
+    const size_t frames = 1 + (n - FFT) / HOP;
+    *count = 0;
+    for (size_t f = 0; ok && f < frames; f += block) {
+        const size_t m = f + block <= frames ? block : frames - f;
+        for (size_t j = 0; ok && j < m; ++j) {
+            ok = vv_dsp_stft_process(h, x + (f + j) * HOP, spec + j * bins) == VV_DSP_OK;
+        }
+        size_t k = 0;
+        ok = ok && vv_dsp_onset_process(od, spec, m, strength, found, m, &k) == VV_DSP_OK;
+        for (size_t j = 0; ok && j < m; ++j) ok = strength[j] >= 0;
+        for (size_t j = 0; ok && j < k && *count < MAX_ONSETS; ++j) times[(*count)++] = found[j];
+    }
+    size_t k = 0;
+    ok = ok && vv_dsp_onset_flush(od, found, 2, &k) == VV_DSP_OK;
+    for (size_t j = 0; ok && j < k && *count < MAX_ONSETS; ++j) times[(*count)++] = found[j];
+    vv_dsp_onset_destroy(od);
+    if (h) (void)vv_dsp_stft_destroy(h);
+    free(found);
+    free(strength);
+    free(spec);
+    return ok;
+}
+
+// Every plucked note is found once, within one frame of its start
+static int test_detection(const vv_dsp_real* x) {
+    vv_dsp_real times[MAX_ONSETS];
+    size_t count = 0;
+    if (!stream(x, LEN, 1, times, &count)) return 0;
+    int ok = count == NUM_ONSETS;
+    for (size_t k = 0; ok && k < NUM_ONSETS; ++k) ok = fabs((double)times[k] - ONSETS[k]) < (double)FFT / SR;
+    if (!ok) {
+        fprintf(stderr, "onsets: %zu found\n", count);
+        for (size_t k = 0; k < count; ++k) fprintf(stderr, "  %.3f\n", (double)times[k]);
+    }
+    return ok;
+}
+
+// Frame blocks of any size give the same onsets
+static int test_blocks(const vv_dsp_real* x) {
+    vv_dsp_real ref[MAX_ONSETS], got[MAX_ONSETS];
+    size_t n_ref = 0, n_got = 0;
+    if (!stream(x, LEN, 1, ref, &n_ref)) return 0;
+    const size_t blocks[] = { 3, 7, 64 };
+    for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); ++b) {
+        if (!stream(x, LEN, blocks[b], got, &n_got) || n_got != n_ref ||
+            memcmp(got, ref, n_ref * sizeof(vv_dsp_real)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// The batch over several signals equals streaming each, and counts past max_onsets
+static int test_batch(const vv_dsp_real* x) {
+    enum { NSIG = 5 };
+    vv_dsp_real* sig[NSIG];
+    size_t len[NSIG], max[NSIG], num[NSIG];
+    vv_dsp_real* out[NSIG];
+    int ok = 1;
+    for (size_t i = 0; i < NSIG; ++i) {
+        len[i] = LEN - i * SR / 2;
+        sig[i] = (vv_dsp_real*)malloc(len[i] * sizeof(vv_dsp_real));
+        out[i] = (vv_dsp_real*)malloc(MAX_ONSETS * sizeof(vv_dsp_real));
+        max[i] = i == 3 ? 2 : MAX_ONSETS;
+        if (!sig[i] || !out[i]) ok = 0;
+        else if (i == 0) memcpy(sig[i], x, len[i] * sizeof(vv_dsp_real));
+        else make_signal(sig[i], len[i], 7u + (unsigned int)i);
+    }
+    vv_dsp_onset_params p;
+    make_params(&p);
+    p.num_threads = 3;
+    ok = ok && vv_dsp_onset_detect_batch(&p, (const vv_dsp_real* const*)sig, len, NSIG, out, max, num) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < NSIG; ++i) {
+        vv_dsp_real ref[MAX_ONSETS];
+        size_t n_ref = 0;
+        ok = stream(sig[i], len[i], 5, ref, &n_ref) && num[i] == n_ref &&
+             memcmp(out[i], ref, (n_ref < max[i] ? n_ref : max[i]) * sizeof(vv_dsp_real)) == 0;
+    }
+    ok = ok && num[3] > 2;
+    // Counting only
+    ok = ok && vv_dsp_onset_detect_batch(&p, (const vv_dsp_real* const*)sig, len, NSIG, NULL, NULL, num) == VV_DSP_OK &&
+         num[0] == NUM_ONSETS;
+    for (size_t i = 0; i < NSIG; ++i) {
+        free(sig[i]);
+        free(out[i]);
+    }
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_onset_params p;
+    make_params(&p);
+    vv_dsp_onset* od = NULL;
+    int ok = vv_dsp_onset_create(NULL, &od) == VV_DSP_ERROR_NULL_POINTER && od == NULL;
+    p.fft_size = 1;
+    ok = ok && vv_dsp_onset_create(&p, &od) == VV_DSP_ERROR_INVALID_SIZE;
+    make_params(&p);
+    p.delta = -1;
+    ok = ok && vv_dsp_onset_create(&p, &od) == VV_DSP_ERROR_OUT_OF_RANGE;
+    make_params(&p);
+    p.sample_rate = 0;
+    ok = ok && vv_dsp_onset_create(&p, &od) == VV_DSP_ERROR_OUT_OF_RANGE;
+    make_params(&p);
+    ok = ok && vv_dsp_onset_create(&p, &od) == VV_DSP_OK;
+
+    // Three frames decide one frame (two wait for their look-ahead)
+    vv_dsp_cpx spec[3 * (FFT / 2 + 1)];
+    memset(spec, 0, sizeof(spec));
+    vv_dsp_real t[3];
+    size_t k = 9;
+    ok = ok && vv_dsp_onset_process(od, spec, 3, NULL, t, 0, &k) == VV_DSP_ERROR_INVALID_SIZE && k == 0 &&
+         vv_dsp_onset_process(od, spec, 3, NULL, t, 1, &k) == VV_DSP_OK && k == 0 &&
+         vv_dsp_onset_flush(od, t, 1, &k) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_onset_flush(od, t, 2, &k) == VV_DSP_OK && k == 0 && vv_dsp_onset_reset(od) == VV_DSP_OK &&
+         vv_dsp_onset_process(od, NULL, 1, NULL, NULL, 0, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_onset_destroy(od);
+    vv_dsp_onset_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    if (!x) return 1;
+    make_signal(x, LEN, 1u);
+    int rc = 0;
+    if (!test_detection(x)) { fprintf(stderr, "onset detection test failed\n"); rc = 1; }
+    if (!test_blocks(x)) { fprintf(stderr, "onset block test failed\n"); rc = 1; }
+    if (!test_batch(x)) { fprintf(stderr, "onset batch test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "onset error test failed\n"); rc = 1; }
+    free(x);
+    if (rc == 0) printf("onset tests passed\n");
+    return rc;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, LEN = SR };
+
+// Voiced glide 150 -> 300 Hz with two harmonics for the first half, then silence
+// for a quarter and white noise for the rest
+static void make_signal(vv_dsp_real* x) {
+    double phase = 0.0;
+    uint32_t seed = 12345u;
+    for (size_t i = 0; i < LEN; ++i) {
+        if (i < LEN / 2) {
+            const double f = 150.0 + 150.0 * (double)i / (double)(LEN / 2);
+            phase += 2.0 * 3.14159265358979 * f / SR;
+            x[i] = (vv_dsp_real)(0.6 * sin(phase) + 0.3 * sin(2.0 * phase + 0.4));
+        } else if (i < 3 * LEN / 4) {
+            x[i] = 0.0f;
+        } else {
+            seed = seed * 1664525u + 1013904223u;
+            x[i] = (vv_dsp_real)((double)(seed >> 8) / 8388608.0 - 1.0);
+        }
+    }
+}
+
+// Instantaneous F0 at the middle of the W-sample integration window
+static double glide_f0(size_t start, size_t W) {
+    const double mid = (double)start + 0.5 * (double)W;
+    return 150.0 + 150.0 * mid / (double)(LEN / 2);
+}
+
+static int test_batch_and_stream(size_t threads) {
+    vv_dsp_yin_params p = { (vv_dsp_real)SR, 70.0f, 800.0f, 0, 128, 0.15f, threads };
+    vv_dsp_yin* y = NULL;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    int ok = x && vv_dsp_yin_create(&p, &y) == VV_DSP_OK;
+    const size_t frames = ok ? vv_dsp_yin_num_frames(y, LEN) : 0;
+    const size_t span = ok ? vv_dsp_yin_frame_span(y) : 0;
+    vv_dsp_real* f0 = (vv_dsp_real*)malloc((frames + 1) * 2 * sizeof(vv_dsp_real));
+    vv_dsp_real* per = f0 ? f0 + frames + 1 : NULL;
+    ok = ok && f0 && frames == 1 + (LEN - span) / 128;
+    if (ok) {
+        make_signal(x);
+        ok = vv_dsp_yin_process(y, x, LEN, f0, per) == VV_DSP_OK;
+    }
+    for (size_t f = 0; ok && f < frames; ++f) {
+        const size_t start = f * 128;
+        if (start + span <= LEN / 2) {
+            const double ref = glide_f0(start, span / 2);  // W = tau_max
+            if (fabs((double)f0[f] - ref) > 0.01 * ref || per[f] < 0.9f) {
+                fprintf(stderr, "frame %zu: f0 %g (expected ~%g), periodicity %g\n", f, (double)f0[f], ref, (double)per[f]);
+                ok = 0;
+            }
+        } else if (start >= LEN / 2) {
+            if (f0[f] != 0.0f) {
+                fprintf(stderr, "frame %zu: expected unvoiced, got %g\n", f, (double)f0[f]);
+                ok = 0;
+            }
+        }
+    }
+
+    // Streaming in uneven chunks reproduces the batch frames exactly
+    vv_dsp_real* sf0 = (vv_dsp_real*)malloc((frames + 1) * 2 * sizeof(vv_dsp_real));
+    vv_dsp_real* sper = sf0 ? sf0 + frames + 1 : NULL;
+    size_t got = 0, pos = 0, chunk = 1;
+    ok = ok && sf0 && vv_dsp_yin_reset(y) == VV_DSP_OK;
+    while (ok && pos < LEN) {
+        size_t n = (pos + chunk < LEN) ? chunk : LEN - pos, out = 0;
+        const size_t expect = vv_dsp_yin_output_count(y, n);
+        ok = vv_dsp_yin_push(y, &x[pos], n, &sf0[got], &sper[got], frames - got, &out) == VV_DSP_OK && out == expect;
+        got += out;
+        pos += n;
+        chunk = chunk * 3 % 997 + 1;
+    }
+    ok = ok && got == frames && memcmp(sf0, f0, frames * sizeof(vv_dsp_real)) == 0 &&
+         memcmp(sper, per, frames * sizeof(vv_dsp_real)) == 0;
+    if (!ok) fprintf(stderr, "threads=%zu: streaming / batch mismatch (%zu of %zu frames)\n", threads, got, frames);
+
+    vv_dsp_yin_destroy(y);
+    free(x); free(f0); free(sf0);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_yin_params p = { (vv_dsp_real)SR, 70.0f, 800.0f, 0, 0, 0, 1 };
+    vv_dsp_yin* y = NULL;
+    int ok = vv_dsp_yin_create(NULL, &y) == VV_DSP_ERROR_NULL_POINTER;
+    p.f0_max = 60.0f;
+    ok = ok && vv_dsp_yin_create(&p, &y) == VV_DSP_ERROR_OUT_OF_RANGE && y == NULL;
+    p.f0_max = 800.0f;
+    ok = ok && vv_dsp_yin_create(&p, &y) == VV_DSP_OK && vv_dsp_yin_hop(y) == 256;
+    vv_dsp_real x[16] = { 0 }, f0[1];
+    size_t out = 99;
+    ok = ok && vv_dsp_yin_process(y, x, 16, f0, NULL) == VV_DSP_ERROR_INVALID_SIZE;
+    // A full span with room for no frames is refused without consuming anything
+    vv_dsp_real* big = (vv_dsp_real*)calloc(vv_dsp_yin_frame_span(y), sizeof(vv_dsp_real));
+    ok = ok && big && vv_dsp_yin_push(y, big, vv_dsp_yin_frame_span(y), f0, NULL, 0, &out) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_yin_push(y, big, vv_dsp_yin_frame_span(y), f0, NULL, 1, &out) == VV_DSP_OK && out == 1;
+    // Silence is unvoiced with zero periodicity
+    vv_dsp_real per = -1.0f;
+    ok = ok && vv_dsp_yin_reset(y) == VV_DSP_OK &&
+         vv_dsp_yin_push(y, big, vv_dsp_yin_frame_span(y), f0, &per, 1, &out) == VV_DSP_OK &&
+         out == 1 && f0[0] == 0.0f && per == 0.0f;
+    free(big);
+    vv_dsp_yin_destroy(y);
+    vv_dsp_yin_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    if (!test_batch_and_stream(1) || !test_batch_and_stream(4)) return 1;
+    if (!test_errors()) {
+        fprintf(stderr, "pitch error handling failed\n");
+        return 1;
+    }
+    printf("pitch tests passed\n");
+    return 0;
+}
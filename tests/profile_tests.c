@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "vv_dsp/vv_dsp.h"
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define N 256
+
+static vv_dsp_profile_report g_report;
+static size_t g_hook_calls;
+
+static void count_hook(const vv_dsp_profile_event* event, void* user) {
+    (void)user;
+    if (event->point == VV_DSP_PROFILE_FFT_EXECUTE && event->samples == N) g_hook_calls++;
+}
+
+static const vv_dsp_profile_entry* entry(vv_dsp_profile_point point) {
+    if (vv_dsp_profile_snapshot(&g_report) != VV_DSP_OK) return NULL;
+    return &g_report.entries[point];
+}
+
+static int run_fft(size_t times) {
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_cpx in[N], out[N];
+    for (size_t i = 0; i < N; ++i) in[i] = vv_dsp_cpx_make((vv_dsp_real)(i % 7), 0);
+    if (vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) return 0;
+    int ok = 1;
+    for (size_t k = 0; ok && k < times; ++k) ok = vv_dsp_fft_execute(plan, in, out) == VV_DSP_OK;
+    vv_dsp_fft_destroy(plan);
+    return ok;
+}
+
+#ifndef _WIN32
+static void* fft_thread(void* arg) {
+    return run_fft((size_t)(uintptr_t)arg) ? arg : NULL;
+}
+#endif
+
+// Every instrumented entry point once, counted with its samples
+static int test_entry_points(int enabled) {
+    vv_dsp_profile_reset();
+    vv_dsp_real x[N], y[N];
+    vv_dsp_cpx spec[N];
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)(i % 13) - 6;
+    int ok = run_fft(10);
+
+    vv_dsp_stft* stft = NULL;
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = N;
+    sp.hop_size = N / 4;
+    sp.window = VV_DSP_STFT_WIN_HANN;
+    ok = ok && vv_dsp_stft_create(&sp, &stft) == VV_DSP_OK;
+    ok = ok && vv_dsp_stft_process(stft, x, spec) == VV_DSP_OK;
+    vv_dsp_stft_destroy(stft);
+
+    // FIR allocations must match what the allocator counted around the call
+    vv_dsp_fir_state fir;
+    vv_dsp_real taps[64];
+    for (size_t i = 0; i < 64; ++i) taps[i] = (vv_dsp_real)1 / (vv_dsp_real)(i + 1);
+    vv_dsp_alloc_stats a0, a1;
+    ok = ok && vv_dsp_fir_state_init(&fir, 64) == VV_DSP_OK;
+    ok = ok && vv_dsp_get_alloc_stats(&a0) == VV_DSP_OK;
+    ok = ok && vv_dsp_fir_apply(&fir, taps, x, y, N) == VV_DSP_OK;
+    ok = ok && vv_dsp_get_alloc_stats(&a1) == VV_DSP_OK;
+    vv_dsp_fir_state_free(&fir);
+    const uint64_t fir_allocs = (uint64_t)((a1.allocations + a1.reallocations) - (a0.allocations + a0.reallocations));
+
+    vv_dsp_biquad bq[2];
+    ok = ok && vv_dsp_biquad_init(&bq[0], (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                  (vv_dsp_real)-0.5, (vv_dsp_real)0.1) == VV_DSP_OK;
+    bq[1] = bq[0];
+    ok = ok && vv_dsp_iir_apply(bq, 2, x, y, 100) == VV_DSP_OK;
+
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(2, 1);
+    vv_dsp_real up[4 * N];
+    size_t produced = 0;
+    ok = ok && rs && vv_dsp_resampler_process_stream(rs, x, 50, up, 4 * N, &produced) == VV_DSP_OK;
+    ok = ok && rs && vv_dsp_resampler_process_real(rs, x, 60, up, 4 * N, &produced) == VV_DSP_OK;
+    vv_dsp_resampler_destroy(rs);
+
+    vv_dsp_mfcc_plan* mfcc = NULL;
+    vv_dsp_real power[3 * (N / 2 + 1)], coeffs[3 * 13];
+    for (size_t i = 0; i < 3 * (N / 2 + 1); ++i) power[i] = (vv_dsp_real)(1 + i % 5);
+    ok = ok && vv_dsp_mfcc_init(N, 26, 13, 16000, 0, 8000, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22,
+                                (vv_dsp_real)1e-10, &mfcc) == VV_DSP_OK;
+    ok = ok && vv_dsp_mfcc_process(mfcc, power, 3, coeffs) == VV_DSP_OK;
+    vv_dsp_mfcc_destroy(mfcc);
+    if (!ok || !entry(VV_DSP_PROFILE_FFT_EXECUTE)) return 0;
+
+    const vv_dsp_profile_entry* e = g_report.entries;
+    for (size_t k = 0; k < VV_DSP_PROFILE_POINT_COUNT; ++k) {
+        if (!e[k].name || strcmp(e[k].name, vv_dsp_profile_point_name((vv_dsp_profile_point)k)) != 0) return 0;
+        if (!enabled && (e[k].calls || e[k].samples || e[k].ns || e[k].allocations)) return 0;
+    }
+    if (!enabled) return 1;
+
+    // The STFT frame also runs an FFT (sizes differ: the STFT may use a half-size real plan)
+    ok = e[VV_DSP_PROFILE_FFT_EXECUTE].calls >= 11 && e[VV_DSP_PROFILE_FFT_EXECUTE].samples >= 10 * N;
+    ok = ok && e[VV_DSP_PROFILE_FFT_EXECUTE].ns > 0;
+    ok = ok && e[VV_DSP_PROFILE_STFT_PROCESS].calls == 1 && e[VV_DSP_PROFILE_STFT_PROCESS].samples == N;
+    ok = ok && e[VV_DSP_PROFILE_FIR_APPLY].calls == 1 && e[VV_DSP_PROFILE_FIR_APPLY].samples == N;
+    ok = ok && e[VV_DSP_PROFILE_FIR_APPLY].allocations == fir_allocs;
+    ok = ok && e[VV_DSP_PROFILE_IIR_APPLY].calls == 1 && e[VV_DSP_PROFILE_IIR_APPLY].samples == 100;
+    ok = ok && e[VV_DSP_PROFILE_RESAMPLE].calls == 2 && e[VV_DSP_PROFILE_RESAMPLE].samples == 110;
+    ok = ok && e[VV_DSP_PROFILE_MFCC_PROCESS].calls == 1 && e[VV_DSP_PROFILE_MFCC_PROCESS].samples == 3;
+    return ok;
+}
+
+// Counters of exited threads stay in the totals
+static int test_threads(void) {
+#ifndef _WIN32
+    vv_dsp_profile_reset();
+    pthread_t th[3];
+    for (size_t t = 0; t < 3; ++t) {
+        if (pthread_create(&th[t], NULL, fft_thread, (void*)(uintptr_t)(t + 1)) != 0) return 0;
+    }
+    int ok = 1;
+    for (size_t t = 0; t < 3; ++t) {
+        void* r = NULL;
+        pthread_join(th[t], &r);
+        ok = ok && r != NULL;
+    }
+    const vv_dsp_profile_entry* e = entry(VV_DSP_PROFILE_FFT_EXECUTE);
+    return ok && e && e->calls == 6 && e->samples == 6 * N;
+#else
+    return 1;
+#endif
+}
+
+// Events reach the hook and the Chrome trace; the buffer drops what does not fit
+static int test_trace(int enabled) {
+    vv_dsp_profile_set_hook(count_hook, NULL);
+    if (vv_dsp_profile_trace_start(0) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    if (vv_dsp_profile_trace_start(4) != VV_DSP_OK) return 0;
+    int ok = run_fft(6);
+    vv_dsp_profile_set_hook(NULL, NULL);
+
+    FILE* f = tmpfile();
+    ok = ok && f && vv_dsp_profile_trace_write(f) == VV_DSP_OK;
+    vv_dsp_profile_trace_stop();
+    if (!f) return 0;
+    char doc[4096];
+    rewind(f);
+    const size_t len = fread(doc, 1, sizeof(doc) - 1, f);
+    fclose(f);
+    doc[len] = '\0';
+
+    size_t events = 0;
+    for (const char* p = doc; (p = strstr(p, "\"ph\": \"X\"")) != NULL; ++p) events++;
+    ok = ok && strncmp(doc, "{\"traceEvents\": [", 17) == 0 && vv_dsp_profile_trace_write(NULL) == VV_DSP_ERROR_NULL_POINTER;
+    if (!enabled) return ok && events == 0 && g_hook_calls == 0;
+    return ok && events == 4 && g_hook_calls == 6 && strstr(doc, "\"name\": \"fft_execute\"") &&
+           strstr(doc, "\"dropped_events\": 2");
+}
+
+int main(void) {
+    const int enabled = vv_dsp_profile_enabled();
+    if (vv_dsp_profile_snapshot(NULL) != VV_DSP_ERROR_NULL_POINTER) return 1;
+    if (vv_dsp_profile_point_name(VV_DSP_PROFILE_POINT_COUNT) != NULL) return 1;
+
+    if (!test_entry_points(enabled)) { fprintf(stderr, "profile entry point test failed\n"); return 1; }
+    if (enabled && !test_threads()) { fprintf(stderr, "profile thread test failed\n"); return 1; }
+    if (!test_trace(enabled)) { fprintf(stderr, "profile trace test failed\n"); return 1; }
+    printf("profile tests passed (%s build)\n", enabled ? "profiling" : "plain");
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { NFFT = 1024, HOP = 256, BLOCK = 100 };
+
+static vv_dsp_real signal_at(size_t t, double w) {
+    return (vv_dsp_real)(0.8 * sin(w * (double)t) + 0.1 * sin(3.1 * w * (double)t + 0.3));
+}
+
+// Stream len input samples through pv in BLOCK-sized pushes, pulling every ready hop.
+// Returns the number of output samples written to y (capacity cap), 0 on failure.
+static size_t run(vv_dsp_pvoc* pv, const vv_dsp_real* x, size_t len, vv_dsp_real* y, size_t cap) {
+    size_t written = 0;
+    for (size_t pos = 0; pos < len; pos += BLOCK) {
+        const size_t n = (len - pos < BLOCK) ? len - pos : BLOCK;
+        if (vv_dsp_pvoc_push(pv, x + pos, n) != VV_DSP_OK) return 0;
+        while (vv_dsp_pvoc_hops_ready(pv) > 0) {
+            if (written + HOP > cap) return 0;
+            // Pulling runs on preallocated state only
+            vv_dsp_alloc_stats a0, a1;
+            if (vv_dsp_get_thread_alloc_stats(&a0) != VV_DSP_OK || vv_dsp_pvoc_pull(pv, y + written) != VV_DSP_OK ||
+                vv_dsp_get_thread_alloc_stats(&a1) != VV_DSP_OK || a1.allocations != a0.allocations) return 0;
+            written += HOP;
+        }
+        if (vv_dsp_pvoc_input_space(pv) < BLOCK) return 0;
+    }
+    return written;
+}
+
+// Zero crossings per sample of y[from, to)
+static double crossing_rate(const vv_dsp_real* y, size_t from, size_t to) {
+    size_t c = 0;
+    for (size_t t = from + 1; t < to; ++t) c += (y[t - 1] < 0) != (y[t] < 0);
+    return (double)c / (double)(to - from - 1);
+}
+
+static int test_identity(vv_dsp_precision_mode mode, double tol) {
+    enum { LEN = 20000 };
+    vv_dsp_pvoc_params p = { NFFT, HOP, VV_DSP_STFT_WIN_HANN, BLOCK };
+    vv_dsp_pvoc* pv = NULL;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    int ok = x && y && vv_dsp_pvoc_create(&p, &pv) == VV_DSP_OK && vv_dsp_pvoc_set_precision(pv, mode) == VV_DSP_OK;
+    for (size_t t = 0; ok && t < LEN; ++t) x[t] = signal_at(t, 0.05 + 1e-6 * (double)t);
+    const size_t n = ok ? run(pv, x, LEN, y, LEN) : 0;
+    ok = ok && n == HOP * (1 + (LEN - NFFT) / HOP);
+    // Stretch 1 / pitch 1 reproduces the input once the overlap has ramped in
+    for (size_t t = NFFT; ok && t < n; ++t) {
+        if (fabs((double)y[t] - (double)x[t]) > tol) {
+            fprintf(stderr, "identity mismatch at %zu: %f vs %f\n", t, (double)y[t], (double)x[t]);
+            ok = 0;
+        }
+    }
+    free(x); free(y);
+    if (pv) vv_dsp_pvoc_destroy(pv);
+    return ok;
+}
+
+// Stretching keeps the frequency and scales the length; pitch shifting scales the
+// frequency and keeps the length
+static int test_ratio(double stretch, double pitch) {
+    enum { LEN = 24000 };
+    const double w = 0.09;
+    vv_dsp_pvoc_params p = { NFFT, HOP, VV_DSP_STFT_WIN_HANN, BLOCK };
+    vv_dsp_pvoc* pv = NULL;
+    const size_t cap = (size_t)(stretch * LEN) + 4 * NFFT;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    int ok = x && y && vv_dsp_pvoc_create(&p, &pv) == VV_DSP_OK &&
+             vv_dsp_pvoc_set_ratio(pv, stretch, pitch) == VV_DSP_OK;
+    for (size_t t = 0; ok && t < LEN; ++t) x[t] = (vv_dsp_real)(0.7 * sin(w * (double)t));
+    const size_t n = ok ? run(pv, x, LEN, y, cap) : 0;
+    const double want_len = stretch * (double)(LEN - NFFT);
+    if (ok && fabs((double)n - want_len) > 2.0 * HOP) { fprintf(stderr, "length %zu, want %.0f\n", n, want_len); ok = 0; }
+    if (ok) {
+        const double rate = crossing_rate(y, NFFT, n - NFFT), want = pitch * w / 3.14159265358979323846;
+        if (fabs(rate - want) > 0.01 * want) { fprintf(stderr, "crossing rate %f, want %f\n", rate, want); ok = 0; }
+        double e = 0.0;
+        for (size_t t = NFFT; t < n - NFFT; ++t) e += (double)y[t] * (double)y[t];
+        e /= (double)(n - 2 * NFFT);
+        // A sinusoid of amplitude 0.7 has mean square 0.245
+        if (fabs(e - 0.245) > 0.01) { fprintf(stderr, "mean square %f\n", e); ok = 0; }
+    }
+    free(x); free(y);
+    if (pv) vv_dsp_pvoc_destroy(pv);
+    return ok;
+}
+
+int main(void) {
+    if (!test_identity(VV_DSP_PRECISION_EXACT, 1e-3)) { fprintf(stderr, "identity failed\n"); return 1; }
+    if (!test_identity(VV_DSP_PRECISION_FAST, 2e-3)) { fprintf(stderr, "fast identity failed\n"); return 1; }
+    if (!test_ratio(2.0, 1.0)) { fprintf(stderr, "stretch 2 failed\n"); return 1; }
+    if (!test_ratio(0.6, 1.0)) { fprintf(stderr, "stretch 0.6 failed\n"); return 1; }
+    if (!test_ratio(1.0, 1.5)) { fprintf(stderr, "pitch 1.5 failed\n"); return 1; }
+    if (!test_ratio(1.7, 0.75)) { fprintf(stderr, "stretch 1.7 / pitch 0.75 failed\n"); return 1; }
+
+    vv_dsp_pvoc_params p = { NFFT, NFFT / 2 + 1, VV_DSP_STFT_WIN_HANN, 0 };
+    vv_dsp_pvoc* pv = NULL;
+    if (vv_dsp_pvoc_create(&p, &pv) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+    p.hop_size = HOP;
+    if (vv_dsp_pvoc_create(&p, &pv) != VV_DSP_OK) return 1;
+    if (vv_dsp_pvoc_set_ratio(pv, 0.2, 1.0) != VV_DSP_ERROR_OUT_OF_RANGE ||
+        vv_dsp_pvoc_set_ratio(pv, 1.0, 0.0) != VV_DSP_ERROR_OUT_OF_RANGE ||
+        vv_dsp_pvoc_set_ratio(pv, NAN, 1.0) != VV_DSP_ERROR_OUT_OF_RANGE ||
+        vv_dsp_pvoc_set_precision(pv, (vv_dsp_precision_mode)7) != VV_DSP_ERROR_OUT_OF_RANGE) return 1;
+    vv_dsp_real buf[NFFT] = {0};
+    if (vv_dsp_pvoc_pull(pv, buf) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+    if (vv_dsp_pvoc_push(pv, buf, NFFT) != VV_DSP_OK || vv_dsp_pvoc_hops_ready(pv) != 1) return 1;
+    if (vv_dsp_pvoc_reset(pv) != VV_DSP_OK || vv_dsp_pvoc_hops_ready(pv) != 0) return 1;
+    vv_dsp_pvoc_destroy(pv);
+    printf("pvoc tests passed\n");
+    return 0;
+}
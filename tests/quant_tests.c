@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { N = 4099 };
+
+static uint16_t code16(const uint8_t* p, size_t i) {
+    uint16_t h;
+    memcpy(&h, p + 2 * i, sizeof(h));
+    return h;
+}
+
+static double decode1(const vv_dsp_quant* q, uint16_t h) {
+    vv_dsp_real v = 0;
+    (void)vv_dsp_quant_decode(q, &h, 1, &v);
+    return (double)v;
+}
+
+static uint16_t encode1(const vv_dsp_quant* q, double v) {
+    const vv_dsp_real x = (vv_dsp_real)v;
+    uint16_t h = 0;
+    (void)vv_dsp_quant_encode(q, &x, 1, &h);
+    return h;
+}
+
+// Every non-NaN code widens and narrows back to itself, NaNs stay NaN, and each
+// encoded value is no farther from the input than either neighbouring code
+static int check_half(vv_dsp_storage_type type, const vv_dsp_real* x) {
+    vv_dsp_quant q;
+    if (vv_dsp_quant_init(&q, type, 0, 0) != VV_DSP_OK) return 0;
+    static uint16_t codes[65536];
+    static vv_dsp_real wide[65536];
+    static uint8_t back[2 * 65536];
+    for (size_t i = 0; i < 65536; ++i) codes[i] = (uint16_t)i;
+    int ok = vv_dsp_quant_decode(&q, codes, 65536, wide) == VV_DSP_OK &&
+             vv_dsp_quant_encode(&q, wide, 65536, back) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < 65536; ++i) {
+        ok = isnan((double)wide[i]) ? isnan(decode1(&q, code16(back, i))) : code16(back, i) == codes[i];
+        if (!ok) fprintf(stderr, "code %04zx does not round-trip\n", i);
+    }
+    static uint8_t enc[2 * N];
+    ok = ok && vv_dsp_quant_encode(&q, x, N, enc) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < N; ++i) {
+        const uint16_t h = code16(enc, i);
+        const double v = (double)(float)x[i], err = fabs(decode1(&q, h) - v);
+        const uint16_t mag = h & 0x7fff, sign = h & 0x8000;
+        const uint16_t inf = type == VV_DSP_STORAGE_F16 ? 0x7c00 : 0x7f80;
+        if (mag == inf) {
+            ok = fabs(v) >= (type == VV_DSP_STORAGE_F16 ? 65520.0 : 3.396e38);
+            continue;
+        }
+        if (mag < inf - 1) ok = err <= fabs(decode1(&q, (uint16_t)(sign | (mag + 1))) - v);
+        if (ok && mag > 0) ok = err <= fabs(decode1(&q, (uint16_t)(sign | (mag - 1))) - v);
+        if (!ok) fprintf(stderr, "%g encoded as %04x\n", v, h);
+    }
+    return ok;
+}
+
+// Round-to-nearest-even ties, overflow, subnormals and specials
+static int test_half_edges(void) {
+    vv_dsp_quant f16, bf16;
+    int ok = vv_dsp_quant_init(&f16, VV_DSP_STORAGE_F16, 0, 0) == VV_DSP_OK &&
+             vv_dsp_quant_init(&bf16, VV_DSP_STORAGE_BF16, 0, 0) == VV_DSP_OK;
+    ok = ok && encode1(&f16, 1.0 + ldexp(1, -11)) == 0x3c00 && encode1(&f16, 1.0 + 3 * ldexp(1, -11)) == 0x3c02 &&
+         encode1(&f16, 65519.0) == 0x7bff && encode1(&f16, 65520.0) == 0x7c00 && encode1(&f16, -1e6) == 0xfc00 &&
+         encode1(&f16, ldexp(1, -25)) == 0x0000 && encode1(&f16, 3 * ldexp(1, -25)) == 0x0002 &&
+         encode1(&f16, ldexp(1, -14) - ldexp(1, -25)) == 0x0400 && encode1(&f16, -0.0) == 0x8000 &&
+         encode1(&f16, (double)INFINITY) == 0x7c00 && (encode1(&f16, (double)NAN) & 0x7fff) == 0x7e00 &&
+         decode1(&f16, 0x0001) == ldexp(1, -24) && decode1(&f16, 0x7bff) == 65504.0 &&
+         decode1(&f16, 0xfc00) == -(double)INFINITY;
+    ok = ok && encode1(&bf16, 1.0 + ldexp(1, -8)) == 0x3f80 && encode1(&bf16, 1.0 + 3 * ldexp(1, -8)) == 0x3f82 &&
+         encode1(&bf16, 1e30) == 0x714a && encode1(&bf16, 3.4e38) == 0x7f80 &&
+         (encode1(&bf16, (double)NAN) & 0x7fc0) == 0x7fc0 && decode1(&bf16, 0x3f80) == 1.0;
+    return ok;
+}
+
+// Codes saturate at the range ends, NaN gives the first code, and values in range
+// come back within half a step (plus the float log in the dB domain)
+static int test_u8(const vv_dsp_real* x) {
+    vv_dsp_quant q;
+    static uint8_t codes[N];
+    static vv_dsp_real in[N], out[N];
+    int ok = vv_dsp_quant_init(&q, VV_DSP_STORAGE_U8, -80, 0) == VV_DSP_OK && q.lut[0] == -80 && q.lut[255] == 0;
+    for (size_t i = 0; i < N; ++i) in[i] = (vv_dsp_real)(-40.0 + 45.0 * (double)x[i] / 1000.0);
+    ok = ok && vv_dsp_quant_encode(&q, in, N, codes) == VV_DSP_OK && vv_dsp_quant_decode(&q, codes, N, out) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < N; ++i) {
+        const double v = (double)in[i], clamped = v < -80 ? -80 : v > 0 ? 0 : v;
+        ok = fabs((double)out[i] - clamped) <= 80.0 / 255 / 2 + 1e-4;
+        if (!ok) fprintf(stderr, "u8: %g decoded as %g\n", v, (double)out[i]);
+    }
+    const vv_dsp_real special[4] = { (vv_dsp_real)NAN, (vv_dsp_real)-INFINITY, (vv_dsp_real)INFINITY, -80 };
+    ok = ok && vv_dsp_quant_encode(&q, special, 4, codes) == VV_DSP_OK && codes[0] == 0 && codes[1] == 0 &&
+         codes[2] == 255 && codes[3] == 0;
+
+    // Power over [-100, 20] dB in the log domain
+    ok = ok && vv_dsp_quant_init(&q, VV_DSP_STORAGE_U8_DB, -100, 20) == VV_DSP_OK;
+    for (size_t i = 0; i < N; ++i) in[i] = (vv_dsp_real)pow(10.0, (-95.0 + 0.0271 * (double)i) / 10.0);
+    ok = ok && vv_dsp_quant_encode(&q, in, N, codes) == VV_DSP_OK && vv_dsp_quant_decode(&q, codes, N, out) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < N; ++i) {
+        const double db = 10.0 * log10((double)in[i]), got = 10.0 * log10((double)out[i]);
+        ok = fabs(got - db) <= 120.0 / 255 / 2 + 1e-3;
+        if (!ok) fprintf(stderr, "u8 dB: %g dB decoded as %g dB\n", db, got);
+    }
+    const vv_dsp_real power[3] = { 0, -1, (vv_dsp_real)1e9 };
+    ok = ok && vv_dsp_quant_encode(&q, power, 3, codes) == VV_DSP_OK && codes[0] == 0 && codes[1] == 0 &&
+         codes[2] == 255;
+    return ok;
+}
+
+// Every dispatch level writes the same codes
+static int test_levels(const vv_dsp_real* x) {
+    const vv_dsp_storage_type types[4] = { VV_DSP_STORAGE_F16, VV_DSP_STORAGE_BF16, VV_DSP_STORAGE_U8,
+                                           VV_DSP_STORAGE_U8_DB };
+    static uint8_t ref[4][2 * N], got[2 * N + 1];
+    static vv_dsp_real pos[N];
+    for (size_t i = 0; i < N; ++i) pos[i] = (vv_dsp_real)fabs((double)x[i]);
+    const vv_dsp_simd_level detected = vv_dsp_simd_get_level();
+    int ok = 1, first = 1;
+    for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; lvl++) {
+        if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+        for (int t = 0; t < 4 && ok; ++t) {
+            vv_dsp_quant q;
+            const vv_dsp_real* in = types[t] == VV_DSP_STORAGE_U8_DB ? pos : x;
+            const size_t bytes = N * vv_dsp_storage_bytes(types[t]);
+            // Odd destination: codes need no alignment
+            ok = vv_dsp_quant_init(&q, types[t], -500, 800) == VV_DSP_OK &&
+                 vv_dsp_quant_encode(&q, in, N, got + 1) == VV_DSP_OK;
+            if (first) memcpy(ref[t], got + 1, bytes);
+            else ok = ok && memcmp(ref[t], got + 1, bytes) == 0;
+            if (!ok) fprintf(stderr, "storage type %d differs at level %d\n", t, lvl);
+        }
+        first = 0;
+    }
+    if (vv_dsp_simd_set_level(detected) != VV_DSP_OK) ok = 0;
+    return ok;
+}
+
+// The spectrogram and extractor output modes equal encoding their vv_dsp_real output
+static int test_output_modes(const vv_dsp_real* x) {
+    enum { FFT = 256, HOP = 64, BINS = FFT / 2 + 1, MELS = 24 };
+    vv_dsp_stft_params sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.fft_size = FFT;
+    sp.hop_size = HOP;
+    sp.window = VV_DSP_STFT_WIN_HANN;
+    sp.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    vv_dsp_spectrogram_opts opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.scale = VV_DSP_SPECTROGRAM_DB;
+    opts.floor = (vv_dsp_real)1e-10;
+    vv_dsp_stft* h = NULL;
+    vv_dsp_quant q;
+    const size_t frames = 1 + (N - FFT + HOP) / HOP;
+    vv_dsp_real* rows = (vv_dsp_real*)malloc(frames * BINS * sizeof(vv_dsp_real));
+    uint8_t* ref = (uint8_t*)malloc(frames * BINS * 2);
+    uint8_t* got = (uint8_t*)malloc(frames * BINS * 2);
+    size_t nf = 0, nq = 0;
+    int ok = rows && ref && got && vv_dsp_stft_create(&sp, &h) == VV_DSP_OK &&
+             vv_dsp_quant_init(&q, VV_DSP_STORAGE_F16, 0, 0) == VV_DSP_OK &&
+             vv_dsp_stft_spectrogram_ex(h, x, N, &opts, rows, &nf) == VV_DSP_OK && nf == frames &&
+             vv_dsp_quant_encode(&q, rows, nf * BINS, ref) == VV_DSP_OK &&
+             vv_dsp_stft_spectrogram_quant(h, x, N, &opts, &q, got, &nq) == VV_DSP_OK && nq == nf &&
+             memcmp(ref, got, nf * BINS * 2) == 0;
+    // 8-bit codes of a dB spectrogram, linear in dB
+    ok = ok && vv_dsp_quant_init(&q, VV_DSP_STORAGE_U8, -120, 40) == VV_DSP_OK &&
+         vv_dsp_quant_encode(&q, rows, nf * BINS, ref) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_quant(h, x, N, &opts, &q, got, &nq) == VV_DSP_OK &&
+         memcmp(ref, got, nf * BINS) == 0;
+    q.type = (vv_dsp_storage_type)9;
+    ok = ok && vv_dsp_stft_spectrogram_quant(h, x, N, &opts, &q, got, &nq) == VV_DSP_ERROR_UNSUPPORTED &&
+         vv_dsp_stft_spectrogram_quant(h, x, N, &opts, NULL, got, &nq) == VV_DSP_ERROR_NULL_POINTER;
+    if (h) (void)vv_dsp_stft_destroy(h);
+
+    // Log-mel with deltas in bfloat16, including the flushed tail
+    vv_dsp_feature_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = 16000;
+    p.fft_size = FFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.n_mels = MELS;
+    p.delta_order = 1;
+    vv_dsp_feature_extractor* fa = NULL;
+    vv_dsp_feature_extractor* fb = NULL;
+    ok = ok && vv_dsp_feature_extractor_create(&p, &fa) == VV_DSP_OK &&
+         vv_dsp_feature_extractor_create(&p, &fb) == VV_DSP_OK &&
+         vv_dsp_quant_init(&q, VV_DSP_STORAGE_BF16, 0, 0) == VV_DSP_OK;
+    const size_t dim = 2 * MELS;
+    size_t done = 0, ka = 0, kb = 0;
+    for (size_t t = 0; ok && t < N; t += 700) {
+        const size_t m = N - t < 700 ? N - t : 700;
+        size_t na = 0, nb = 0;
+        ok = vv_dsp_feature_extractor_process(fa, x + t, m, rows + done * dim, frames, &na) == VV_DSP_OK &&
+             vv_dsp_feature_extractor_process_quant(fb, x + t, m, &q, got + done * dim * 2, frames, &nb) == VV_DSP_OK &&
+             na == nb;
+        done += na;
+    }
+    ok = ok && vv_dsp_feature_extractor_flush_quant(fb, &q, got + done * dim * 2, 1, &kb) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_feature_extractor_flush(fa, rows + done * dim, frames, &ka) == VV_DSP_OK &&
+         vv_dsp_feature_extractor_flush_quant(fb, &q, got + done * dim * 2, frames, &kb) == VV_DSP_OK && ka == kb &&
+         ka == 2 && vv_dsp_quant_encode(&q, rows, (done + ka) * dim, ref) == VV_DSP_OK &&
+         memcmp(ref, got, (done + ka) * dim * 2) == 0;
+    vv_dsp_feature_extractor_destroy(fa);
+    vv_dsp_feature_extractor_destroy(fb);
+    free(rows);
+    free(ref);
+    free(got);
+    return ok;
+}
+
+static int test_errors(const vv_dsp_real* x) {
+    vv_dsp_quant q;
+    uint8_t b[4];
+    return vv_dsp_storage_bytes(VV_DSP_STORAGE_REAL) == sizeof(vv_dsp_real) &&
+           vv_dsp_storage_bytes(VV_DSP_STORAGE_BF16) == 2 && vv_dsp_storage_bytes(VV_DSP_STORAGE_U8_DB) == 1 &&
+           vv_dsp_storage_bytes((vv_dsp_storage_type)5) == 0 &&
+           vv_dsp_quant_init(&q, (vv_dsp_storage_type)5, 0, 1) == VV_DSP_ERROR_UNSUPPORTED &&
+           vv_dsp_quant_init(&q, VV_DSP_STORAGE_U8, 1, 1) == VV_DSP_ERROR_OUT_OF_RANGE &&
+           vv_dsp_quant_init(&q, VV_DSP_STORAGE_U8_DB, 0, (vv_dsp_real)INFINITY) == VV_DSP_ERROR_OUT_OF_RANGE &&
+           vv_dsp_quant_init(NULL, VV_DSP_STORAGE_F16, 0, 0) == VV_DSP_ERROR_NULL_POINTER &&
+           vv_dsp_quant_init(&q, VV_DSP_STORAGE_F16, 0, 0) == VV_DSP_OK &&
+           vv_dsp_quant_encode(&q, x, 2, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+           vv_dsp_quant_encode(&q, NULL, 0, NULL) == VV_DSP_OK &&
+           vv_dsp_quant_decode(&q, b, 1, NULL) == VV_DSP_ERROR_NULL_POINTER;
+}
+
+int main(void) {
+    static vv_dsp_real x[N];
+    unsigned int seed = 1u;
+    for (size_t i = 0; i < N; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        // Magnitudes from 1e-9 to 1e5 with both signs
+        const double u = (double)(seed >> 8) / 16777216.0;
+        x[i] = (vv_dsp_real)((i & 1 ? -1.0 : 1.0) * pow(10.0, -9.0 + 14.0 * u) + (i % 7 == 0 ? 1000.0 * u : 0.0));
+    }
+    int rc = 0;
+    if (!check_half(VV_DSP_STORAGE_F16, x)) { fprintf(stderr, "f16 test failed\n"); rc = 1; }
+    if (!check_half(VV_DSP_STORAGE_BF16, x)) { fprintf(stderr, "bf16 test failed\n"); rc = 1; }
+    if (!test_half_edges()) { fprintf(stderr, "half edge case test failed\n"); rc = 1; }
+    if (!test_u8(x)) { fprintf(stderr, "u8 test failed\n"); rc = 1; }
+    if (!test_levels(x)) { fprintf(stderr, "storage level test failed\n"); rc = 1; }
+    if (!test_output_modes(x)) { fprintf(stderr, "storage output mode test failed\n"); rc = 1; }
+    if (!test_errors(x)) { fprintf(stderr, "storage error test failed\n"); rc = 1; }
+    if (rc == 0) printf("quant tests passed\n");
+    return rc;
+}
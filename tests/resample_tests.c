@@ -23,6 +23,51 @@ static int test_interpolate_linear_basic(void) {
     return 1;
 }
 
+// Batch and uniform forms against the single-sample functions, edges included
+static int test_interpolate_batch(void) {
+    enum { N = 50, M = 400 };
+    vv_dsp_real x[N], pos[M], y[M], ref[M];
+    unsigned s = 12345u;
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)sin(0.37 * (double)i) + (vv_dsp_real)(0.01 * (double)i);
+    for (size_t k = 0; k < M; ++k) {
+        s = s * 1103515245u + 12345u;
+        pos[k] = (vv_dsp_real)((double)((s >> 8) & 0xFFFF) / 65536.0 * (N + 6) - 3.0); // unsorted, past both ends
+    }
+    for (int cubic = 0; cubic < 2; ++cubic) {
+        const vv_dsp_status st = cubic ? vv_dsp_interpolate_cubic_batch(x, N, pos, M, y)
+                                       : vv_dsp_interpolate_linear_batch(x, N, pos, M, y);
+        if (st != VV_DSP_OK) return 0;
+        for (size_t k = 0; k < M; ++k) {
+            if ((cubic ? vv_dsp_interpolate_cubic_real(x, N, pos[k], &ref[k])
+                       : vv_dsp_interpolate_linear_real(x, N, pos[k], &ref[k])) != VV_DSP_OK) return 0;
+            if (!approx_equal(y[k], ref[k], (vv_dsp_real)1e-6)) {
+                fprintf(stderr, "batch %d mismatch at %g: %g vs %g\n", cubic, (double)pos[k], (double)y[k], (double)ref[k]);
+                return 0;
+            }
+        }
+        // Uniform steps from before the start to past the end, and a zero step
+        const double starts[3] = {-3.3, 0.0, 48.9}, steps[3] = {0.137, 0.5, 0.0};
+        for (size_t c = 0; c < 3; ++c) {
+            if ((cubic ? vv_dsp_interpolate_cubic_uniform(x, N, starts[c], steps[c], M, y)
+                       : vv_dsp_interpolate_linear_uniform(x, N, starts[c], steps[c], M, y)) != VV_DSP_OK) return 0;
+            for (size_t k = 0; k < M; ++k) {
+                const vv_dsp_real p = (vv_dsp_real)(starts[c] + (double)k * steps[c]);
+                vv_dsp_real r = 0;
+                if ((cubic ? vv_dsp_interpolate_cubic_real(x, N, p, &r)
+                           : vv_dsp_interpolate_linear_real(x, N, p, &r)) != VV_DSP_OK) return 0;
+                if (!approx_equal(y[k], r, (vv_dsp_real)1e-5)) {
+                    fprintf(stderr, "uniform %d mismatch at %g: %g vs %g\n", cubic, (double)p, (double)y[k], (double)r);
+                    return 0;
+                }
+            }
+        }
+    }
+    if (vv_dsp_interpolate_linear_uniform(x, N, 0.0, -1.0, M, y) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    if (vv_dsp_interpolate_cubic_uniform(x, N, NAN, 1.0, M, y) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    if (vv_dsp_interpolate_linear_batch(x, 0, pos, M, y) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    return 1;
+}
+
 static int test_resampler_up_down_roundtrip(void) {
     const unsigned int Fs = 48000;
     const double f = 1000.0; // 1 kHz tone
@@ -75,10 +120,477 @@ static int test_resampler_up_down_roundtrip(void) {
     return (err < (vv_dsp_real)0.1) ? 1 : 0;
 }
 
+// The per-tap windowed-sinc evaluation the polyphase table replaces
+static vv_dsp_real ref_sinc_out(const vv_dsp_real* in, size_t in_n, double ratio, unsigned int taps, size_t k) {
+    const double cutoff = fmin(1.0, ratio);
+    const int half = (int)(taps / 2);
+    const double in_pos = (double)k / ratio;
+    const int center = (int)floor(in_pos + 1e-9);
+    double acc = 0.0, wsum = 0.0;
+    for (int m = -half; m < (int)taps - half; ++m) {
+        int idx = center + m;
+        const double t = ((double)idx - in_pos) * cutoff;
+        const double s = (t == 0.0) ? 1.0 : sin(VV_DSP_PI_D * t) / (VV_DSP_PI_D * t);
+        const double w = 0.5 - 0.5 * cos(VV_DSP_TWO_PI_D * (double)(m + half) / (double)(taps - 1));
+        if (idx < 0) idx = 0;
+        if (idx >= (int)in_n) idx = (int)in_n - 1;
+        acc += (double)in[idx] * s * w;
+        wsum += s * w;
+    }
+    return (vv_dsp_real)(acc / wsum);
+}
+
+static int test_resampler_table(unsigned int num, unsigned int den, double tol) {
+    enum { N = 600, TAPS = 64 };
+    vv_dsp_real x[N];
+    for (size_t n = 0; n < N; ++n) x[n] = (vv_dsp_real)(sin(0.05 * (double)n) + 0.3 * cos(0.61 * (double)n));
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(num, den);
+    if (!rs) return 0;
+    const double ratio = (double)num / (double)den;
+    const size_t cap = (size_t)floor((N - 1) * ratio) + 1;
+    vv_dsp_real* y = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    size_t got = 0;
+    int ok = y && vv_dsp_resampler_set_quality(rs, 1, TAPS) == VV_DSP_OK &&
+             vv_dsp_resampler_process_real(rs, x, N, y, cap, &got) == VV_DSP_OK && got == cap;
+    for (size_t k = 0; ok && k < got; ++k) {
+        const vv_dsp_real r = ref_sinc_out(x, N, ratio, TAPS, k);
+        if (!approx_equal(y[k], r, (vv_dsp_real)tol)) {
+            fprintf(stderr, "resampler %u/%u: output %zu is %g, expected %g\n", num, den, k, (double)y[k], (double)r);
+            ok = 0;
+        }
+    }
+    // The table follows ratio changes
+    ok = ok && vv_dsp_resampler_set_ratio(rs, 3, 2) == VV_DSP_OK &&
+         vv_dsp_resampler_process_real(rs, x, 100, y, cap, &got) == VV_DSP_OK && got == 149;
+    for (size_t k = 0; ok && k < got; ++k)
+        if (!approx_equal(y[k], ref_sinc_out(x, 100, 1.5, TAPS, k), (vv_dsp_real)tol)) ok = 0;
+    free(y);
+    vv_dsp_resampler_destroy(rs);
+    return ok;
+}
+
+// BALANCED halves the taps; FAST quarters them and takes the nearest interpolated row
+static int test_resampler_precision(unsigned int num, unsigned int den, vv_dsp_precision_mode mode,
+                                    unsigned int taps, double tol) {
+    enum { N = 600 };
+    vv_dsp_real x[N];
+    for (size_t n = 0; n < N; ++n) x[n] = (vv_dsp_real)(sin(0.05 * (double)n) + 0.3 * cos(0.61 * (double)n));
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(num, den);
+    if (!rs) return 0;
+    const double ratio = (double)num / (double)den;
+    const size_t cap = (size_t)floor((N - 1) * ratio) + 1;
+    vv_dsp_real* y = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    size_t got = 0;
+    int ok = y && vv_dsp_resampler_set_quality(rs, 1, 64) == VV_DSP_OK &&
+             vv_dsp_resampler_set_precision(rs, (vv_dsp_precision_mode)9) == VV_DSP_ERROR_OUT_OF_RANGE &&
+             vv_dsp_resampler_set_precision(rs, mode) == VV_DSP_OK &&
+             vv_dsp_resampler_process_real(rs, x, N, y, cap, &got) == VV_DSP_OK && got == cap;
+    for (size_t k = 0; ok && k < got; ++k) {
+        const vv_dsp_real r = ref_sinc_out(x, N, ratio, taps, k);
+        if (!approx_equal(y[k], r, (vv_dsp_real)tol)) {
+            fprintf(stderr, "resampler %u/%u mode %d: output %zu is %g, expected %g\n", num, den, (int)mode, k,
+                    (double)y[k], (double)r);
+            ok = 0;
+        }
+    }
+    // Back to EXACT restores the full kernel
+    ok = ok && vv_dsp_resampler_set_precision(rs, VV_DSP_PRECISION_EXACT) == VV_DSP_OK &&
+         vv_dsp_resampler_process_real(rs, x, N, y, cap, &got) == VV_DSP_OK &&
+         approx_equal(y[cap / 2], ref_sinc_out(x, N, ratio, 64, cap / 2), (vv_dsp_real)2e-4);
+    free(y);
+    vv_dsp_resampler_destroy(rs);
+    return ok;
+}
+
+// Chunked streaming plus flush reproduces the whole-signal result
+static int test_resampler_stream(unsigned int num, unsigned int den, int use_sinc, double tol) {
+    enum { N = 4410 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    const double ratio = (double)num / (double)den;
+    const size_t cap = (size_t)floor((N - 1) * ratio) + 1;
+    vv_dsp_real* whole = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    vv_dsp_real* str = (vv_dsp_real*)malloc((cap + 8) * sizeof(vv_dsp_real));
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(num, den);
+    int ok = x && whole && str && rs && vv_dsp_resampler_set_quality(rs, use_sinc, 64) == VV_DSP_OK;
+    for (size_t n = 0; ok && n < N; ++n) x[n] = (vv_dsp_real)(sin(0.031 * (double)n) + 0.2 * sin(0.9 * (double)n));
+    size_t nw = 0, ns = 0, pos = 0, b = 0;
+    ok = ok && vv_dsp_resampler_process_real(rs, x, N, whole, cap, &nw) == VV_DSP_OK;
+    const size_t blocks[5] = {441, 1, 17, 1000, 63};
+    while (ok && pos < N) {
+        size_t n = blocks[b++ % 5], got = 0;
+        if (n > N - pos) n = N - pos;
+        const size_t want = vv_dsp_resampler_out_needed(rs, n);
+        if (want && vv_dsp_resampler_process_stream(rs, x + pos, n, str + ns, want - 1, &got) != VV_DSP_ERROR_INVALID_SIZE)
+            ok = 0;
+        ok = ok && vv_dsp_resampler_process_stream(rs, x + pos, n, str + ns, cap + 8 - ns, &got) == VV_DSP_OK &&
+             got == want;
+        ns += got;
+        pos += n;
+    }
+    size_t tail = 0;
+    ok = ok && vv_dsp_resampler_flush(rs, str + ns, cap + 8 - ns, &tail) == VV_DSP_OK;
+    ns += tail;
+    if (ok && ns != nw) {
+        fprintf(stderr, "stream %u/%u: %zu outputs, whole signal %zu\n", num, den, ns, nw);
+        ok = 0;
+    }
+    for (size_t k = 0; ok && k < nw; ++k) {
+        if (!approx_equal(str[k], whole[k], (vv_dsp_real)tol)) {
+            fprintf(stderr, "stream %u/%u: output %zu is %g, expected %g\n", num, den, k, (double)str[k], (double)whole[k]);
+            ok = 0;
+        }
+    }
+    // in_needed() is the smallest input count that completes the requested outputs
+    if (ok) {
+        const size_t need = vv_dsp_resampler_in_needed(rs, 100);
+        ok = need > 0 && vv_dsp_resampler_out_needed(rs, need) >= 100 && vv_dsp_resampler_out_needed(rs, need - 1) < 100;
+    }
+    vv_dsp_resampler_destroy(rs);
+    free(x);
+    free(whole);
+    free(str);
+    return ok;
+}
+
+// Variable ratio: a tone through drifting and ramped ratios against its exact sampling
+// at the expected read positions, chunked input against one call
+static int test_asrc(double r0, double r1, size_t ramp) {
+    enum { N = 20000 };
+    const double w = VV_DSP_TWO_PI_D * 1000.0 / 44100.0;
+    const size_t cap = (size_t)((double)N * fmax(r0, r1)) + 64;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* whole = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    vv_dsp_real* str = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    vv_dsp_asrc* a = NULL;
+    int ok = x && whole && str && vv_dsp_asrc_create(r0, 32, &a) == VV_DSP_OK;
+    for (size_t n = 0; ok && n < N; ++n) x[n] = (vv_dsp_real)sin(w * (double)n);
+    // One call, ramp started up front
+    size_t nw = 0, nf = 0;
+    ok = ok && vv_dsp_asrc_set_ratio(a, r1, ramp) == VV_DSP_OK;
+    ok = ok && vv_dsp_asrc_out_needed(a, N) <= cap;
+    const size_t expect = ok ? vv_dsp_asrc_out_needed(a, N) : 0;
+    ok = ok && vv_dsp_asrc_process(a, x, N, whole, cap, &nw) == VV_DSP_OK && nw == expect;
+    ok = ok && vv_dsp_asrc_flush(a, whole + nw, cap - nw, &nf) == VV_DSP_OK;
+    nw += nf;
+    ok = ok && fabs(vv_dsp_asrc_get_ratio(a) - r1) < 1e-12;
+    // Reference read positions with the same ramp
+    double pos = 0.0, ratio = r0, inc = (ramp ? (r1 - r0) / (double)ramp : 0.0);
+    size_t left = ramp, checked = 0;
+    if (!ramp) ratio = r1;
+    for (size_t k = 0; ok && k < nw; ++k) {
+        if (pos > 64.0 && pos < N - 64.0) {
+            ++checked;
+            if (fabs((double)whole[k] - sin(w * pos)) > 2e-3) {
+                fprintf(stderr, "asrc %g->%g: output %zu at %.4f is %g, want %g\n", r0, r1, k, pos,
+                        (double)whole[k], sin(w * pos));
+                ok = 0;
+            }
+        }
+        pos += 1.0 / ratio;
+        if (left) ratio = (--left == 0) ? r1 : ratio + inc;
+    }
+    ok = ok && checked > N / 2 && pos > (double)N - 1.0 && pos - 1.0 / ratio <= (double)N - 1.0 + 1e-9;
+    // Uneven chunks after a reset reproduce the single call
+    const size_t chunks[5] = {1, 7, 333, 4096, 50};
+    size_t in_pos = 0, ns = 0, c = 0;
+    ok = ok && vv_dsp_asrc_reset(a) == VV_DSP_OK && vv_dsp_asrc_set_ratio(a, r0, 0) == VV_DSP_OK &&
+         vv_dsp_asrc_set_ratio(a, r1, ramp) == VV_DSP_OK;
+    while (ok && in_pos < N) {
+        size_t n = chunks[c++ % 5], got = 0;
+        if (n > N - in_pos) n = N - in_pos;
+        ok = vv_dsp_asrc_process(a, x + in_pos, n, str + ns, cap - ns, &got) == VV_DSP_OK;
+        ns += got;
+        in_pos += n;
+    }
+    ok = ok && vv_dsp_asrc_flush(a, str + ns, cap - ns, &nf) == VV_DSP_OK;
+    ns += nf;
+    ok = ok && ns == nw;
+    for (size_t k = 0; ok && k < nw; ++k) {
+        if (!approx_equal(str[k], whole[k], (vv_dsp_real)1e-6)) {
+            fprintf(stderr, "asrc chunked mismatch at %zu: %g vs %g\n", k, (double)str[k], (double)whole[k]);
+            ok = 0;
+        }
+    }
+    // Too little capacity consumes nothing
+    if (ok) {
+        size_t got = 0;
+        ok = vv_dsp_asrc_process(a, x, 1000, str, 10, &got) == VV_DSP_ERROR_INVALID_SIZE && got == 0 &&
+             vv_dsp_asrc_out_needed(a, 1000) > 10;
+    }
+    vv_dsp_asrc_destroy(a);
+    free(x);
+    free(whole);
+    free(str);
+    return ok;
+}
+
+// Cascade: a passband tone lands at its exact output positions, a tone that would alias
+// into the passband is suppressed, and chunked input matches a single call
+static int run_cascade(vv_dsp_resample_cascade* c, const vv_dsp_real* x, size_t n, size_t chunk,
+                       vv_dsp_real* y, size_t cap, size_t* ny) {
+    size_t k = 0, got = 0, c_i = 0;
+    const size_t sizes[3] = {chunk, 1, 4097};
+    for (size_t pos = 0; pos < n;) {
+        size_t m = sizes[c_i++ % 3];
+        if (m > n - pos) m = n - pos;
+        if (vv_dsp_resample_cascade_process(c, x + pos, m, y + k, cap - k, &got) != VV_DSP_OK) return 0;
+        k += got;
+        pos += m;
+    }
+    if (vv_dsp_resample_cascade_flush(c, y + k, cap - k, &got) != VV_DSP_OK) return 0;
+    *ny = k + got;
+    return 1;
+}
+
+static int test_cascade(unsigned int fin, unsigned int fout, size_t stages, double f_pass, double f_alias) {
+    const size_t N = fin / 5, cap = (size_t)((double)N * fout / fin) + 4096;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    vv_dsp_resample_cascade* c = NULL;
+    int ok = x && a && b && vv_dsp_resample_cascade_create(fin, fout, 0.9, 100.0, &c) == VV_DSP_OK;
+    ok = ok && vv_dsp_resample_cascade_num_stages(c) == stages;
+    size_t na = 0, nb = 0;
+    const double ratio = (double)fout / (double)fin, margin = 0.02 * (double)fout;
+    for (int pass = 0; ok && pass < 2; ++pass) {
+        const double f = pass ? f_alias : f_pass;
+        for (size_t n = 0; n < N; ++n) x[n] = (vv_dsp_real)sin(VV_DSP_TWO_PI_D * f * (double)n / fin);
+        ok = run_cascade(c, x, N, N, a, cap, &na) && run_cascade(c, x, N, 333, b, cap, &nb) && na == nb;
+        ok = ok && na + 2 >= (size_t)((double)(N - 1) * ratio) + 1 && na <= (size_t)((double)(N - 1) * ratio) + 3;
+        double err = 0.0;
+        for (size_t k = 0; ok && k < na; ++k) {
+            if (!approx_equal(a[k], b[k], (vv_dsp_real)1e-6)) ok = 0;
+            if ((double)k < margin || (double)k > (double)na - margin) continue;
+            const double want = pass ? 0.0 : sin(VV_DSP_TWO_PI_D * f * (double)k / fout);
+            err = fmax(err, fabs((double)a[k] - want));
+        }
+        if (err > (pass ? 1e-3 : 2e-4)) {
+            fprintf(stderr, "cascade %u->%u tone %g: error %g\n", fin, fout, f, err);
+            ok = 0;
+        }
+    }
+    vv_dsp_resample_cascade_destroy(c);
+    free(x);
+    free(a);
+    free(b);
+    return ok;
+}
+
+// Multi-channel stream (interleaved and planar, uneven chunks) against one
+// single-channel stream per channel
+static int test_resampler_mc(unsigned int num, unsigned int den, size_t C, int use_sinc) {
+    enum { N = 3000 };
+    const size_t cap = (size_t)((double)N * num / den) + 64;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * C * sizeof(vv_dsp_real));
+    vv_dsp_real* yi = (vv_dsp_real*)malloc(cap * C * sizeof(vv_dsp_real));
+    vv_dsp_real* yp = (vv_dsp_real*)malloc(cap * C * sizeof(vv_dsp_real));
+    vv_dsp_real* ch = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* ref = (vv_dsp_real*)malloc(cap * sizeof(vv_dsp_real));
+    const vv_dsp_real* in_p[8];
+    vv_dsp_real* out_p[8];
+    vv_dsp_resampler_mc* mi = vv_dsp_resampler_mc_create(num, den, C);
+    vv_dsp_resampler_mc* mp = vv_dsp_resampler_mc_create(num, den, C);
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(num, den);
+    int ok = x && yi && yp && ch && ref && mi && mp && rs && C <= 8;
+    ok = ok && vv_dsp_resampler_mc_set_quality(mi, use_sinc, 32) == VV_DSP_OK &&
+         vv_dsp_resampler_mc_set_quality(mp, use_sinc, 32) == VV_DSP_OK &&
+         vv_dsp_resampler_set_quality(rs, use_sinc, 32) == VV_DSP_OK;
+    for (size_t i = 0; ok && i < N * C; ++i)
+        x[i] = (vv_dsp_real)(sin(0.013 * (double)i * (double)(1 + i % C)) + 0.1 * cos(0.7 * (double)(i / C)));
+    // Planar copy of the input
+    vv_dsp_real* planar = ok ? (vv_dsp_real*)malloc(N * C * sizeof(vv_dsp_real)) : NULL;
+    ok = ok && planar;
+    for (size_t c = 0; ok && c < C; ++c) {
+        for (size_t n = 0; n < N; ++n) planar[c * N + n] = x[n * C + c];
+    }
+    const size_t chunks[4] = {1, 250, 17, 1024};
+    size_t pos = 0, ni = 0, np = 0, b = 0, got = 0;
+    while (ok && pos < N) {
+        size_t n = chunks[b++ % 4];
+        if (n > N - pos) n = N - pos;
+        ok = vv_dsp_resampler_mc_out_needed(mi, n) <= cap - ni &&
+             vv_dsp_resampler_mc_process_interleaved(mi, x + pos * C, n, yi + ni * C, cap - ni, &got) == VV_DSP_OK;
+        ni += got;
+        for (size_t c = 0; c < C; ++c) {
+            in_p[c] = planar + c * N + pos;
+            out_p[c] = yp + c * cap + np;
+        }
+        ok = ok && vv_dsp_resampler_mc_process_planar(mp, in_p, n, out_p, cap - np, &got) == VV_DSP_OK;
+        np += got;
+        pos += n;
+    }
+    ok = ok && vv_dsp_resampler_mc_flush_interleaved(mi, yi + ni * C, cap - ni, &got) == VV_DSP_OK;
+    ni += got;
+    for (size_t c = 0; ok && c < C; ++c) out_p[c] = yp + c * cap + np;
+    ok = ok && vv_dsp_resampler_mc_flush_planar(mp, out_p, cap - np, &got) == VV_DSP_OK;
+    np += got;
+    ok = ok && ni == np;
+    for (size_t c = 0; ok && c < C; ++c) {
+        size_t nr = 0, nf = 0;
+        for (size_t n = 0; n < N; ++n) ch[n] = x[n * C + c];
+        ok = vv_dsp_resampler_process_stream(rs, ch, N, ref, cap, &nr) == VV_DSP_OK &&
+             vv_dsp_resampler_flush(rs, ref + nr, cap - nr, &nf) == VV_DSP_OK && nr + nf == ni;
+        for (size_t k = 0; ok && k < ni; ++k) {
+            if (!approx_equal(yi[k * C + c], ref[k], (vv_dsp_real)1e-5) ||
+                !approx_equal(yp[c * cap + k], ref[k], (vv_dsp_real)1e-5)) {
+                fprintf(stderr, "mc %u/%u C=%zu ch %zu: mismatch at %zu: %g / %g vs %g\n", num, den, C, c, k,
+                        (double)yi[k * C + c], (double)yp[c * cap + k], (double)ref[k]);
+                ok = 0;
+            }
+        }
+    }
+    vv_dsp_resampler_mc_destroy(mi);
+    vv_dsp_resampler_mc_destroy(mp);
+    vv_dsp_resampler_destroy(rs);
+    free(x);
+    free(yi);
+    free(yp);
+    free(ch);
+    free(ref);
+    free(planar);
+    return ok;
+}
+
+// Batch of clips of assorted lengths (empty, single-sample, packed and one past the
+// packing limit) matches vv_dsp_resampler_process_real() clip by clip, for any worker
+// count; a short capacity is rejected before anything is written
+static int test_resampler_batch(unsigned int num, unsigned int den, int use_sinc) {
+    enum { M = 37, LONG = 20000 };
+    const vv_dsp_real* in[M];
+    vv_dsp_real* out[M];
+    size_t in_n[M], cap[M], got[M];
+    vv_dsp_resampler* rs = vv_dsp_resampler_create(num, den);
+    vv_dsp_real* ref = (vv_dsp_real*)malloc(((size_t)LONG * num / den + 64) * sizeof(vv_dsp_real));
+    int ok = rs && ref && vv_dsp_resampler_set_quality(rs, use_sinc, 32) == VV_DSP_OK;
+    for (size_t i = 0; i < M; ++i) {
+        in_n[i] = i == 5 ? LONG : (i * 7919u) % 1500u + (i % 4 == 0 ? 0 : 1);
+        cap[i] = (size_t)((double)in_n[i] * num / den) + 2;
+        vv_dsp_real* x = (vv_dsp_real*)malloc((in_n[i] + 1) * sizeof(vv_dsp_real));
+        out[i] = (vv_dsp_real*)malloc(cap[i] * sizeof(vv_dsp_real));
+        for (size_t t = 0; x && t < in_n[i]; ++t)
+            x[t] = (vv_dsp_real)(sin(0.05 * (double)t * (double)(1 + i % 5)) + 0.2 * cos(0.9 * (double)t + (double)i));
+        in[i] = x;
+        ok = ok && x && out[i];
+    }
+    for (size_t threads = 0; ok && threads < 4; threads += 3) {
+        ok = vv_dsp_resampler_process_batch(rs, in, in_n, out, cap, got, M, threads) == VV_DSP_OK;
+        for (size_t i = 0; ok && i < M; ++i) {
+            size_t nr = 0;
+            ok = vv_dsp_resampler_process_real(rs, in[i], in_n[i], ref, cap[i], &nr) == VV_DSP_OK && nr == got[i];
+            for (size_t k = 0; ok && k < nr; ++k) {
+                if (!approx_equal(out[i][k], ref[k], (vv_dsp_real)1e-5)) {
+                    fprintf(stderr, "batch %u/%u clip %zu: mismatch at %zu: %g vs %g\n", num, den, i, k,
+                            (double)out[i][k], (double)ref[k]);
+                    ok = 0;
+                }
+            }
+        }
+    }
+    if (ok) {
+        got[3] = 12345;
+        cap[7] = 1;
+        ok = vv_dsp_resampler_process_batch(rs, in, in_n, out, cap, got, M, 0) == VV_DSP_ERROR_INVALID_SIZE &&
+             got[3] == 12345;
+    }
+    for (size_t i = 0; i < M; ++i) {
+        free((void*)in[i]);
+        free(out[i]);
+    }
+    free(ref);
+    vv_dsp_resampler_destroy(rs);
+    return ok;
+}
+
+// Band-limited periodic input: the spectral resampler is exact up to rounding
+static double periodic_tone(double t, size_t period) {
+    const double w = VV_DSP_TWO_PI_D / (double)period;
+    return sin(3.0 * w * t) + 0.5 * cos(17.0 * w * t + 0.3) + 0.25 * sin(40.0 * w * t);
+}
+
+static int test_resample_fft(size_t n_in, size_t n_out) {
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n_in * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(n_out * sizeof(vv_dsp_real));
+    int ok = x && y;
+    for (size_t i = 0; ok && i < n_in; ++i) x[i] = (vv_dsp_real)periodic_tone((double)i, n_in);
+    ok = ok && vv_dsp_resample_fft(x, n_in, y, n_out) == VV_DSP_OK;
+    for (size_t k = 0; ok && k < n_out; ++k) {
+        const double want = periodic_tone((double)k * (double)n_in / (double)n_out, n_in);
+        if (fabs((double)y[k] - want) > 1e-4) {
+            fprintf(stderr, "fft resample %zu->%zu: output %zu is %g, want %g\n", n_in, n_out, k, (double)y[k], want);
+            ok = 0;
+        }
+    }
+    free(x);
+    free(y);
+    return ok;
+}
+
+// Chunked transforms with context agree with one transform away from the ends
+static int test_resample_fft_chunked(void) {
+    enum { NI = 48000, NO = 44100 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(NI * sizeof(vv_dsp_real));
+    vv_dsp_real* a = (vv_dsp_real*)malloc(NO * sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)malloc(NO * sizeof(vv_dsp_real));
+    int ok = x && a && b;
+    for (size_t i = 0; ok && i < NI; ++i)
+        x[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.3 * sin(0.0071 * (double)i * (1.0 + 1e-5 * (double)i)));
+    ok = ok && vv_dsp_resample_fft_ex(x, NI, a, NO, 0.1, 0, 0) == VV_DSP_OK &&
+         vv_dsp_resample_fft_ex(x, NI, b, NO, 0.1, 4000, 1000) == VV_DSP_OK;
+    double err = 0.0;
+    for (size_t k = 2000; ok && k < NO - 2000; ++k) err = fmax(err, fabs((double)a[k] - (double)b[k]));
+    if (ok && err > 2e-3) {
+        fprintf(stderr, "chunked fft resample differs by %g\n", err);
+        ok = 0;
+    }
+    // Equal lengths reproduce the input
+    ok = ok && vv_dsp_resample_fft(x, 1000, a, 1000) == VV_DSP_OK;
+    for (size_t k = 0; ok && k < 1000; ++k) ok = approx_equal(a[k], x[k], (vv_dsp_real)1e-5);
+    ok = ok && vv_dsp_resample_fft(x, 0, a, 10) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_resample_fft_ex(x, 10, a, 10, 1.5, 0, 0) == VV_DSP_ERROR_OUT_OF_RANGE;
+    free(x);
+    free(a);
+    free(b);
+    return ok;
+}
+
 int main(void) {
     int ok = 1;
     ok &= test_interpolate_linear_basic();
+    ok &= test_interpolate_batch();
     ok &= test_resampler_up_down_roundtrip();
+    ok &= test_resampler_table(160, 147, 1e-5);     // 44.1k -> 48k, one row per phase
+    ok &= test_resampler_table(147, 160, 1e-5);
+    ok &= test_resampler_table(48000, 44101, 2e-4); // interpolated rows
+    ok &= test_resampler_precision(160, 147, VV_DSP_PRECISION_BALANCED, 32, 1e-5);
+    ok &= test_resampler_precision(48000, 44101, VV_DSP_PRECISION_BALANCED, 32, 2e-4);
+    ok &= test_resampler_precision(48000, 44101, VV_DSP_PRECISION_FAST, 16, 2e-3);
+    ok &= test_resampler_stream(160, 147, 1, 1e-5);
+    ok &= test_resampler_stream(1, 5, 1, 1e-5);
+    ok &= test_resampler_stream(48000, 44101, 1, 1e-5);
+    ok &= test_resampler_stream(3, 1, 0, 1e-4);
+    ok &= test_resampler_stream(147, 160, 0, 1e-4);
+    ok &= test_asrc(48000.0 / 44100.0, 48000.0 / 44100.0 * (1.0 + 50e-6), 0);
+    ok &= test_asrc(1.0, 1.0 + 200e-6, 8000);                  // ppm ramp
+    ok &= test_resampler_mc(160, 147, 2, 1);
+    ok &= test_resampler_mc(147, 160, 5, 1);
+    ok &= test_resampler_mc(1, 3, 8, 1);
+    ok &= test_resampler_mc(3, 1, 4, 0);
+    ok &= test_resampler_batch(160, 147, 1);
+    ok &= test_resampler_batch(147, 160, 1);
+    ok &= test_resampler_batch(48000, 44101, 1);
+    ok &= test_resampler_batch(1, 3, 1);
+    ok &= test_resampler_batch(3, 2, 0);
+    ok &= test_resample_fft(480, 441);
+    ok &= test_resample_fft(441, 480);
+    ok &= test_resample_fft(256, 1024);
+    ok &= test_resample_fft(1000, 101);
+    ok &= test_resample_fft_chunked();
+    ok &= test_cascade(192000, 8000, 5, 1000.0, 11000.0);  // 4 half-bands + 2/3
+    ok &= test_cascade(44100, 16000, 2, 3000.0, 12000.0);
+    ok &= test_cascade(8000, 48000, 3, 1500.0, 0.0);        // 3/2 + 2 half-bands
+    ok &= test_cascade(16000, 64000, 2, 2500.0, 0.0);       // half-bands only
+    ok &= test_cascade(48000, 48000, 0, 1000.0, 0.0);
+    ok &= test_asrc(44100.0 / 48000.0, 44100.0 / 48000.0 * 0.999, 3000);
     if (!ok) {
         fprintf(stderr, "resample tests failed\n");
         return 1;
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vv_dsp/vv_dsp.h"
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Wrapping, partial commits and the region invariants on one thread
+static int test_spsc_single_thread(void) {
+    vv_dsp_ring* ring = NULL;
+    if (vv_dsp_ring_create(VV_DSP_RING_SPSC, sizeof(vv_dsp_real), 100, &ring) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_ring_capacity(ring) == 128 && vv_dsp_ring_record_size(ring) == sizeof(vv_dsp_real) &&
+             vv_dsp_ring_space(ring) == 128;
+
+    vv_dsp_real in[300], out[300];
+    for (size_t i = 0; i < 300; ++i) in[i] = (vv_dsp_real)i;
+    size_t n = 0;
+    for (int round = 0; ok && round < 20; ++round) {
+        // 100 in, 100 out: every round after the first wraps
+        ok = vv_dsp_ring_write(ring, in, 100, &n) == VV_DSP_OK && n == 100 && vv_dsp_ring_size(ring) == 100;
+        ok = ok && vv_dsp_ring_write(ring, in, 100, &n) == VV_DSP_OK && n == 28;
+        ok = ok && vv_dsp_ring_read(ring, out, 300, &n) == VV_DSP_OK && n == 128;
+        ok = ok && memcmp(out, in, 100 * sizeof(vv_dsp_real)) == 0 && memcmp(out + 100, in, 28 * sizeof(vv_dsp_real)) == 0;
+        ok = ok && vv_dsp_ring_size(ring) == 0;
+    }
+
+    // Zero-copy: write a region in place, commit part of it, read it back in place
+    vv_dsp_ring_region r;
+    ok = ok && vv_dsp_ring_begin_write(ring, 64, &r) == VV_DSP_OK && r.count > 0;
+    if (ok) {
+        const size_t claimed = r.count;
+        for (size_t i = 0; i < claimed; ++i) ((vv_dsp_real*)r.data)[i] = (vv_dsp_real)(1000 + i);
+        r.count = claimed / 2;
+        ok = vv_dsp_ring_end_write(ring, &r) == VV_DSP_OK && vv_dsp_ring_size(ring) == claimed / 2;
+        r.count = claimed + 1;
+        ok = ok && vv_dsp_ring_end_write(ring, &r) == VV_DSP_ERROR_INVALID_SIZE;
+        vv_dsp_ring_region rd;
+        ok = ok && vv_dsp_ring_begin_read(ring, 1000, &rd) == VV_DSP_OK && rd.count == claimed / 2;
+        for (size_t i = 0; ok && i < rd.count; ++i) ok = ((vv_dsp_real*)rd.data)[i] == (vv_dsp_real)(1000 + i);
+        ok = ok && vv_dsp_ring_end_read(ring, &rd) == VV_DSP_OK && vv_dsp_ring_size(ring) == 0;
+    }
+
+    vv_dsp_ring_reset(ring);
+    ok = ok && vv_dsp_ring_size(ring) == 0 && vv_dsp_ring_begin_write(ring, 1000, &r) == VV_DSP_OK && r.count == 128;
+    vv_dsp_ring_destroy(ring);
+    return ok;
+}
+
+// MPSC batches are all or nothing, so a batch never straddles a full ring
+static int test_mpsc_single_thread(void) {
+    vv_dsp_ring* ring = NULL;
+    if (vv_dsp_ring_create(VV_DSP_RING_MPSC, 3 * sizeof(int), 8, &ring) != VV_DSP_OK) return 0;
+    int recs[10 * 3], out[10 * 3];
+    for (int i = 0; i < 30; ++i) recs[i] = i;
+    size_t n = 0;
+    int ok = vv_dsp_ring_write(ring, recs, 5, &n) == VV_DSP_OK && n == 5;
+    ok = ok && vv_dsp_ring_write(ring, recs, 5, &n) == VV_DSP_OK && n == 0;
+    ok = ok && vv_dsp_ring_write(ring, recs, 9, &n) == VV_DSP_ERROR_INVALID_SIZE;
+    ok = ok && vv_dsp_ring_read(ring, out, 10, &n) == VV_DSP_OK && n == 5 && memcmp(out, recs, 15 * sizeof(int)) == 0;
+
+    // A claimed region hides everything behind it until it is published
+    vv_dsp_ring_region a;
+    ok = ok && vv_dsp_ring_begin_write(ring, 2, &a) == VV_DSP_OK && a.count == 2;
+    ok = ok && vv_dsp_ring_write(ring, recs + 6, 1, &n) == VV_DSP_OK && n == 1;
+    vv_dsp_ring_region rd;
+    ok = ok && vv_dsp_ring_begin_read(ring, 8, &rd) == VV_DSP_OK && rd.count == 0;
+    if (ok) {
+        memcpy(a.data, recs + 12, 2 * 3 * sizeof(int));
+        a.count = 1;
+        ok = vv_dsp_ring_end_write(ring, &a) == VV_DSP_ERROR_INVALID_SIZE;
+        a.count = 2;
+        ok = ok && vv_dsp_ring_end_write(ring, &a) == VV_DSP_OK;
+    }
+    // Positions 5..7 arrive in order once the region is published
+    ok = ok && vv_dsp_ring_read(ring, out, 10, &n) == VV_DSP_OK && n == 3;
+    ok = ok && memcmp(out, recs + 12, 6 * sizeof(int)) == 0 && memcmp(out + 6, recs + 6, 3 * sizeof(int)) == 0;
+    vv_dsp_ring_destroy(ring);
+    return ok;
+}
+
+#ifndef _WIN32
+#define STREAM_RECORDS 200000
+#define PRODUCERS 4
+
+typedef struct {
+    vv_dsp_ring* ring;
+    size_t id;
+} producer_arg;
+
+// SPSC stream: the producer writes a counting sequence through regions
+static void* spsc_producer(void* arg) {
+    vv_dsp_ring* ring = ((producer_arg*)arg)->ring;
+    size_t next = 0;
+    while (next < STREAM_RECORDS) {
+        vv_dsp_ring_region r;
+        if (vv_dsp_ring_begin_write(ring, 37, &r) != VV_DSP_OK) break;
+        if (r.count == 0) {
+            sched_yield();
+            continue;
+        }
+        if (r.count > STREAM_RECORDS - next) r.count = STREAM_RECORDS - next;
+        for (size_t i = 0; i < r.count; ++i) ((unsigned int*)r.data)[i] = (unsigned int)next++;
+        if (vv_dsp_ring_end_write(ring, &r) != VV_DSP_OK) break;
+    }
+    return NULL;
+}
+
+static int test_spsc_threads(void) {
+    vv_dsp_ring* ring = NULL;
+    if (vv_dsp_ring_create(VV_DSP_RING_SPSC, sizeof(unsigned int), 256, &ring) != VV_DSP_OK) return 0;
+    producer_arg arg = {ring, 0};
+    pthread_t th;
+    if (pthread_create(&th, NULL, spsc_producer, &arg) != 0) {
+        vv_dsp_ring_destroy(ring);
+        return 0;
+    }
+    int ok = 1;
+    size_t expect = 0;
+    unsigned int buf[50];
+    while (expect < STREAM_RECORDS) {
+        size_t n = 0;
+        if (vv_dsp_ring_read(ring, buf, 50, &n) != VV_DSP_OK) ok = 0;
+        if (n == 0) sched_yield();
+        for (size_t i = 0; i < n; ++i) {
+            if (buf[i] != (unsigned int)expect++) ok = 0;
+        }
+    }
+    pthread_join(th, NULL);
+    vv_dsp_ring_destroy(ring);
+    return ok;
+}
+
+// MPSC stream: each producer sends (id, sequence) records; per producer they arrive in order
+static void* mpsc_producer(void* arg) {
+    producer_arg* p = (producer_arg*)arg;
+    for (size_t s = 0; s < STREAM_RECORDS / PRODUCERS;) {
+        size_t rec[2] = {p->id, s};
+        size_t n = 0;
+        if (vv_dsp_ring_write(p->ring, rec, 1, &n) != VV_DSP_OK) break;
+        if (n) s++;
+        else sched_yield();
+    }
+    return NULL;
+}
+
+static int test_mpsc_threads(void) {
+    vv_dsp_ring* ring = NULL;
+    if (vv_dsp_ring_create(VV_DSP_RING_MPSC, 2 * sizeof(size_t), 64, &ring) != VV_DSP_OK) return 0;
+    producer_arg args[PRODUCERS];
+    pthread_t th[PRODUCERS];
+    size_t started = 0;
+    for (; started < PRODUCERS; ++started) {
+        args[started].ring = ring;
+        args[started].id = started;
+        if (pthread_create(&th[started], NULL, mpsc_producer, &args[started]) != 0) break;
+    }
+    int ok = started == PRODUCERS;
+    size_t next[PRODUCERS] = {0};
+    size_t received = 0;
+    // Drain everything even after a mismatch, so no producer is left waiting
+    while (started == PRODUCERS && received < STREAM_RECORDS) {
+        vv_dsp_ring_region r;
+        if (vv_dsp_ring_begin_read(ring, 16, &r) != VV_DSP_OK) return 0;
+        if (r.count == 0) sched_yield();
+        const size_t* rec = (const size_t*)r.data;
+        for (size_t i = 0; ok && i < r.count; ++i) {
+            const size_t id = rec[2 * i], s = rec[2 * i + 1];
+            if (id >= PRODUCERS || s != next[id]++) ok = 0;
+        }
+        received += r.count;
+        if (vv_dsp_ring_end_read(ring, &r) != VV_DSP_OK) ok = 0;
+    }
+    for (size_t t = 0; t < started; ++t) pthread_join(th[t], NULL);
+    vv_dsp_ring_destroy(ring);
+    return ok && received == STREAM_RECORDS;
+}
+#endif
+
+int main(void) {
+    vv_dsp_ring* ring = NULL;
+    if (vv_dsp_ring_create(VV_DSP_RING_SPSC, 0, 16, &ring) != VV_DSP_ERROR_INVALID_SIZE || ring) return 1;
+    if (vv_dsp_ring_create(VV_DSP_RING_SPSC, 4, 0, &ring) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+
+    if (!test_spsc_single_thread()) { fprintf(stderr, "SPSC ring test failed\n"); return 1; }
+    if (!test_mpsc_single_thread()) { fprintf(stderr, "MPSC ring test failed\n"); return 1; }
+#ifndef _WIN32
+    if (!test_spsc_threads()) { fprintf(stderr, "SPSC ring stream test failed\n"); return 1; }
+    if (!test_mpsc_threads()) { fprintf(stderr, "MPSC ring stream test failed\n"); return 1; }
+#endif
+    printf("ring tests passed\n");
+    return 0;
+}
@@ -0,0 +1,337 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define MAX_BLOCK 256
+#define TOTAL 4096
+
+static size_t g_traps;
+static vv_dsp_alloc_stats g_before;
+
+static void count_trap(const char* operation, size_t size, void* user) {
+    (void)operation;
+    (void)size;
+    (void)user;
+    g_traps++;
+}
+
+// Block sizes 1..MAX_BLOCK in a fixed irregular pattern
+static size_t block_at(size_t k) {
+    static const size_t sizes[] = {1, 17, MAX_BLOCK, 64, 3, 200, 128, 255, 31};
+    return sizes[k % (sizeof(sizes) / sizeof(sizes[0]))];
+}
+
+static int near(const vv_dsp_real* a, const vv_dsp_real* b, size_t n, double tol) {
+    for (size_t i = 0; i < n; ++i) {
+        if (fabs((double)a[i] - (double)b[i]) > tol) return 0;
+    }
+    return 1;
+}
+
+// Open a section and count what the allocator sees on this thread until the matching close
+static void rt_begin(void) {
+    g_traps = 0;
+    (void)vv_dsp_get_thread_alloc_stats(&g_before);
+    vv_dsp_rt_enter();
+}
+
+static int rt_end(const char* what) {
+    vv_dsp_rt_leave();
+    vv_dsp_alloc_stats st;
+    if (vv_dsp_get_thread_alloc_stats(&st) != VV_DSP_OK) return 0;
+    const size_t allocations = st.allocations - g_before.allocations;
+    const size_t frees = st.frees - g_before.frees;
+    const size_t reallocations = st.reallocations - g_before.reallocations;
+    if (g_traps || allocations || frees || reallocations) {
+        fprintf(stderr, "%s: %zu traps, %zu allocations, %zu frees in the process calls\n", what, g_traps,
+                allocations + reallocations, frees);
+        return 0;
+    }
+    return 1;
+}
+
+static int test_trap(void) {
+    rt_begin();
+    void* p = vv_dsp_malloc(16);
+    vv_dsp_free(p);
+    vv_dsp_rt_leave();
+    const size_t inside = g_traps;
+    p = vv_dsp_malloc(16);
+    vv_dsp_free(p);
+    // Two in the section, none outside it; sections nest
+    vv_dsp_rt_enter();
+    vv_dsp_rt_enter();
+    vv_dsp_rt_leave();
+    const int nested = vv_dsp_rt_active();
+    vv_dsp_rt_leave();
+    return inside == 2 && g_traps == 2 && nested && !vv_dsp_rt_active();
+}
+
+// A long FIR on the FFT path whose taps change mid-stream
+static int test_fir(const vv_dsp_real* x) {
+    const size_t taps = 2 * vv_dsp_conv_get_crossover() + 5;
+    vv_dsp_real* h1 = (vv_dsp_real*)malloc(taps * sizeof(vv_dsp_real));
+    vv_dsp_real* h2 = (vv_dsp_real*)malloc(taps * sizeof(vv_dsp_real));
+    vv_dsp_real* ya = (vv_dsp_real*)malloc(TOTAL * sizeof(vv_dsp_real));
+    vv_dsp_real* yb = (vv_dsp_real*)malloc(TOTAL * sizeof(vv_dsp_real));
+    vv_dsp_fir_state a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    int ok = h1 && h2 && ya && yb && vv_dsp_fir_design_lowpass(h1, taps, (vv_dsp_real)0.3, VV_DSP_WINDOW_HANNING) == VV_DSP_OK &&
+             vv_dsp_fir_design_lowpass(h2, taps, (vv_dsp_real)0.6, VV_DSP_WINDOW_HANNING) == VV_DSP_OK &&
+             vv_dsp_fir_state_init(&a, taps) == VV_DSP_OK && vv_dsp_fir_state_init(&b, taps) == VV_DSP_OK &&
+             vv_dsp_fir_state_prepare(&a, MAX_BLOCK) == VV_DSP_OK;
+    if (ok) {
+        size_t pos = 0;
+        rt_begin();
+        for (size_t k = 0; ok && pos < TOTAL; ++k) {
+            const size_t n = block_at(k) < TOTAL - pos ? block_at(k) : TOTAL - pos;
+            ok = vv_dsp_fir_apply(&a, pos < TOTAL / 2 ? h1 : h2, x + pos, ya + pos, n) == VV_DSP_OK;
+            pos += n;
+        }
+        ok = rt_end("FIR") && ok;
+        pos = 0;
+        for (size_t k = 0; ok && pos < TOTAL; ++k) {
+            const size_t n = block_at(k) < TOTAL - pos ? block_at(k) : TOTAL - pos;
+            ok = vv_dsp_fir_apply(&b, pos < TOTAL / 2 ? h1 : h2, x + pos, yb + pos, n) == VV_DSP_OK;
+            pos += n;
+        }
+        ok = ok && near(ya, yb, TOTAL, 1e-4);
+    }
+    vv_dsp_fir_state_free(&a);
+    vv_dsp_fir_state_free(&b);
+    free(h1);
+    free(h2);
+    free(ya);
+    free(yb);
+    return ok;
+}
+
+static int test_iir(const vv_dsp_real* x) {
+    vv_dsp_biquad bq[2];
+    vv_dsp_real y[MAX_BLOCK];
+    vv_dsp_iir_plan* plan = NULL;
+    int ok = vv_dsp_biquad_init(&bq[0], (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2, (vv_dsp_real)-0.5,
+                                (vv_dsp_real)0.3) == VV_DSP_OK &&
+             vv_dsp_biquad_init(&bq[1], 1, (vv_dsp_real)-1.2, (vv_dsp_real)0.5, (vv_dsp_real)-0.9,
+                                (vv_dsp_real)0.4) == VV_DSP_OK &&
+             vv_dsp_iir_make_plan(bq, 2, VV_DSP_IIR_REALIZATION_BLOCK, &plan) == VV_DSP_OK;
+    if (ok) {
+        rt_begin();
+        for (size_t k = 0, pos = 0; ok && pos + MAX_BLOCK <= TOTAL; pos += block_at(k++)) {
+            ok = vv_dsp_iir_plan_apply(plan, x + pos, y, block_at(k)) == VV_DSP_OK &&
+                 vv_dsp_iir_apply(bq, 2, x + pos, y, block_at(k)) == VV_DSP_OK;
+        }
+        ok = rt_end("IIR") && ok;
+    }
+    vv_dsp_iir_plan_destroy(plan);
+    return ok;
+}
+
+// Prepared and unprepared resamplers give the same stream
+static int test_resampler(const vv_dsp_real* x) {
+    vv_dsp_resampler* a = vv_dsp_resampler_create(3, 2);
+    vv_dsp_resampler* b = vv_dsp_resampler_create(3, 2);
+    static vv_dsp_real ya[2 * TOTAL], yb[2 * TOTAL];
+    int ok = a && b && vv_dsp_resampler_set_quality(a, 1, 32) == VV_DSP_OK &&
+             vv_dsp_resampler_set_quality(b, 1, 32) == VV_DSP_OK && vv_dsp_resampler_prepare(a, MAX_BLOCK) == VV_DSP_OK &&
+             vv_dsp_resampler_prepare(a, 0) == VV_DSP_ERROR_INVALID_SIZE;
+    size_t na = 0, nb = 0, got = 0;
+    if (ok) {
+        size_t pos = 0;
+        rt_begin();
+        for (size_t k = 0; ok && pos < TOTAL; ++k) {
+            const size_t n = block_at(k) < TOTAL - pos ? block_at(k) : TOTAL - pos;
+            ok = vv_dsp_resampler_process_stream(a, x + pos, n, ya + na, 2 * TOTAL - na, &got) == VV_DSP_OK;
+            na += got;
+            pos += n;
+        }
+        ok = rt_end("resampler") && ok;
+        ok = ok && vv_dsp_resampler_process_stream(b, x, TOTAL, yb, 2 * TOTAL, &nb) == VV_DSP_OK;
+        ok = ok && na == nb && near(ya, yb, na, 1e-5);
+    }
+    vv_dsp_resampler_destroy(a);
+    vv_dsp_resampler_destroy(b);
+    if (!ok) return 0;
+
+    // Multi-channel, including a quality change after preparation
+    vv_dsp_resampler_mc* mc = vv_dsp_resampler_mc_create(2, 3, 2);
+    static vv_dsp_real in2[2 * MAX_BLOCK], out2[2 * MAX_BLOCK];
+    for (size_t i = 0; i < 2 * MAX_BLOCK; ++i) in2[i] = x[i];
+    ok = mc && vv_dsp_resampler_mc_prepare(mc, MAX_BLOCK) == VV_DSP_OK &&
+         vv_dsp_resampler_mc_set_quality(mc, 1, 64) == VV_DSP_OK;
+    if (ok) {
+        rt_begin();
+        for (size_t k = 0; ok && k < 32; ++k) {
+            ok = vv_dsp_resampler_mc_process_interleaved(mc, in2, block_at(k), out2, MAX_BLOCK, &got) == VV_DSP_OK;
+        }
+        ok = rt_end("multi-channel resampler") && ok;
+    }
+    vv_dsp_resampler_mc_destroy(mc);
+    return ok;
+}
+
+// Streaming analysis and resynthesis of a prepared STFT
+static int test_stft(const vv_dsp_real* x) {
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = 512;
+    p.hop_size = 128;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    vv_dsp_stft* h = NULL;
+    static vv_dsp_cpx spec[512 / 2 + 1];
+    static vv_dsp_real y[TOTAL];
+    int ok = vv_dsp_stft_create(&p, &h) == VV_DSP_OK && vv_dsp_stft_prepare(h, MAX_BLOCK) == VV_DSP_OK;
+    if (ok) {
+        size_t pos = 0, out = 0;
+        rt_begin();
+        for (size_t k = 0; ok && pos < TOTAL; ++k) {
+            const size_t n = block_at(k) < TOTAL - pos ? block_at(k) : TOTAL - pos;
+            ok = vv_dsp_stft_push(h, x + pos, n) == VV_DSP_OK;
+            pos += n;
+            while (ok && vv_dsp_stft_frames_ready(h) > 0) {
+                ok = vv_dsp_stft_pop_frame(h, spec) == VV_DSP_OK && vv_dsp_stft_synth_frame(h, spec, y + out) == VV_DSP_OK;
+                out += p.hop_size;
+            }
+        }
+        ok = rt_end("STFT") && ok;
+        // Past the ramp-in, synthesis reproduces the input
+        ok = ok && out > 2 * p.fft_size && near(y + p.fft_size, x + p.fft_size, out - p.fft_size, 1e-3);
+    }
+    if (h) (void)vv_dsp_stft_destroy(h);
+    return ok;
+}
+
+// Plan-based calls allocate nothing once their plan exists. fir_apply_fft_ex draws
+// its plans from the shared cache, so a first call outside the region builds them.
+static int test_plans(const vv_dsp_real* x) {
+    enum { N = 512, BINS = N / 2 + 1, TAPS = 48 };
+    static vv_dsp_cpx cin[N], cout[N], half[BINS];
+    static vv_dsp_real rout[N], mag[32 * BINS], power[4 * BINS], coeffs[4 * 13], y[MAX_BLOCK];
+    vv_dsp_fft_plan* plans[3] = {NULL, NULL, NULL};
+    vv_dsp_stft* h = NULL;
+    vv_dsp_mfcc_plan* mfcc = NULL;
+    vv_dsp_arena* arena = NULL;
+    vv_dsp_fir_state fir;
+    vv_dsp_real taps[TAPS];
+    memset(&fir, 0, sizeof(fir));
+    for (size_t i = 0; i < N; ++i) cin[i] = vv_dsp_cpx_make(x[i], x[N + i]);
+    for (size_t i = 0; i < 4 * BINS; ++i) power[i] = (vv_dsp_real)1 + x[i] * x[i];
+    for (size_t i = 0; i < TAPS; ++i) taps[i] = (vv_dsp_real)1 / (vv_dsp_real)(i + 1);
+
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = N;
+    p.hop_size = N / 4;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    int ok = vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2C, VV_DSP_FFT_FORWARD, &plans[0]) == VV_DSP_OK &&
+             vv_dsp_fft_make_plan(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plans[1]) == VV_DSP_OK &&
+             vv_dsp_fft_make_plan(N, VV_DSP_FFT_C2R, VV_DSP_FFT_BACKWARD, &plans[2]) == VV_DSP_OK &&
+             vv_dsp_stft_create(&p, &h) == VV_DSP_OK &&
+             vv_dsp_mfcc_init(N, 26, 13, 16000, 0, 8000, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22,
+                              (vv_dsp_real)1e-10, &mfcc) == VV_DSP_OK &&
+             vv_dsp_fir_state_init(&fir, TAPS) == VV_DSP_OK &&
+             vv_dsp_arena_create(vv_dsp_fir_apply_fft_scratch_size(TAPS, MAX_BLOCK), &arena) == VV_DSP_OK &&
+             vv_dsp_fir_apply_fft_ex(&fir, taps, x, y, MAX_BLOCK, arena) == VV_DSP_OK;
+    if (ok) {
+        size_t frames = 0;
+        rt_begin();
+        for (size_t k = 0; ok && k < 4; ++k) {
+            ok = vv_dsp_fft_execute(plans[0], cin, cout) == VV_DSP_OK &&
+                 vv_dsp_fft_execute(plans[1], x, half) == VV_DSP_OK &&
+                 vv_dsp_fft_execute(plans[2], half, rout) == VV_DSP_OK &&
+                 vv_dsp_stft_process(h, x + k * N, half) == VV_DSP_OK &&
+                 vv_dsp_stft_spectrogram(h, x, 4 * N, mag, &frames) == VV_DSP_OK &&
+                 vv_dsp_mfcc_process(mfcc, power, 4, coeffs) == VV_DSP_OK &&
+                 vv_dsp_fir_apply_fft_ex(&fir, taps, x, y, MAX_BLOCK, arena) == VV_DSP_OK;
+        }
+        ok = rt_end("plan-based calls") && ok;
+    }
+    for (size_t i = 0; i < 3; ++i) vv_dsp_fft_destroy(plans[i]);
+    if (h) (void)vv_dsp_stft_destroy(h);
+    vv_dsp_mfcc_destroy(mfcc);
+    vv_dsp_fir_state_free(&fir);
+    vv_dsp_arena_destroy(arena);
+    return ok;
+}
+
+// The float / double entry points draw their conversion scratch from an arena
+static int test_typed(const vv_dsp_real* x) {
+    enum { N = 512, BINS = N / 2 + 1, FRAMES = 4, COEFFS = 13 };
+    static float xf[4 * N], of[4 * N];
+    static double xd[4 * N], od[4 * N];
+    static float pf[FRAMES * BINS];
+    static double pd[FRAMES * BINS];
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_stft* h = NULL;
+    vv_dsp_mfcc_plan* mfcc = NULL;
+    vv_dsp_arena* arena = NULL;
+    for (size_t i = 0; i < 4 * N; ++i) {
+        xf[i] = (float)x[i];
+        xd[i] = (double)x[i];
+    }
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = N;
+    p.hop_size = N / 4;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    int ok = vv_dsp_fft_make_plan(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan) == VV_DSP_OK &&
+             vv_dsp_stft_create(&p, &h) == VV_DSP_OK &&
+             vv_dsp_mfcc_init(N, 26, COEFFS, 16000, 0, 8000, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22,
+                              (vv_dsp_real)1e-10, &mfcc) == VV_DSP_OK;
+    size_t bytes = vv_dsp_fft_execute_typed_scratch_size(plan);
+    const size_t sizes[3] = {vv_dsp_stft_process_typed_scratch_size(h),
+                             vv_dsp_stft_spectrogram_typed_scratch_size(h, 2 * N, NULL),
+                             vv_dsp_mfcc_process_typed_scratch_size(mfcc, FRAMES)};
+    for (size_t i = 0; i < 3; ++i) bytes = sizes[i] > bytes ? sizes[i] : bytes;
+    ok = ok && vv_dsp_arena_create(bytes, &arena) == VV_DSP_OK;
+    // Power spectra for the MFCC calls, kept positive for the log
+    for (size_t i = 0; i < FRAMES * BINS; ++i) {
+        pf[i] = 1.0f + xf[i] * xf[i];
+        pd[i] = 1.0 + xd[i] * xd[i];
+    }
+    if (ok) {
+        size_t frames = 0;
+        rt_begin();
+        for (size_t k = 0; ok && k < 4; ++k) {
+            ok = vv_dsp_fft_execute_f32(plan, xf, of, arena) == VV_DSP_OK &&
+                 vv_dsp_fft_execute_f64(plan, xd, od, arena) == VV_DSP_OK &&
+                 vv_dsp_stft_process_f32(h, xf, (vv_dsp_cpx_f32*)(void*)of, arena) == VV_DSP_OK &&
+                 vv_dsp_stft_process_f64(h, xd, (vv_dsp_cpx_f64*)(void*)od, arena) == VV_DSP_OK &&
+                 vv_dsp_stft_spectrogram_ex_f32(h, xf, 2 * N, NULL, of, &frames, arena) == VV_DSP_OK &&
+                 vv_dsp_stft_spectrogram_ex_f64(h, xd, 2 * N, NULL, od, &frames, arena) == VV_DSP_OK &&
+                 vv_dsp_mfcc_process_f32(mfcc, pf, FRAMES, of, arena) == VV_DSP_OK &&
+                 vv_dsp_mfcc_process_f64(mfcc, pd, FRAMES, od, arena) == VV_DSP_OK &&
+                 vv_dsp_arena_used(arena) == 0;
+        }
+        ok = rt_end("typed calls with an arena") && ok;
+    }
+    vv_dsp_fft_destroy(plan);
+    if (h) (void)vv_dsp_stft_destroy(h);
+    vv_dsp_mfcc_destroy(mfcc);
+    vv_dsp_arena_destroy(arena);
+    return ok;
+}
+
+int main(void) {
+    static vv_dsp_real x[TOTAL];
+    for (size_t i = 0; i < TOTAL; ++i) x[i] = (vv_dsp_real)(sin(0.03 * (double)i) + 0.3 * sin(0.71 * (double)i));
+    vv_dsp_set_rt_trap(count_trap, NULL);
+
+    if (!test_trap()) { fprintf(stderr, "real-time trap test failed\n"); return 1; }
+    if (!test_fir(x)) { fprintf(stderr, "FIR real-time test failed\n"); return 1; }
+    if (!test_iir(x)) { fprintf(stderr, "IIR real-time test failed\n"); return 1; }
+    if (!test_resampler(x)) { fprintf(stderr, "resampler real-time test failed\n"); return 1; }
+    if (!test_stft(x)) { fprintf(stderr, "STFT real-time test failed\n"); return 1; }
+    if (!test_plans(x)) { fprintf(stderr, "plan-based zero-allocation test failed\n"); return 1; }
+    if (!test_typed(x)) { fprintf(stderr, "typed zero-allocation test failed\n"); return 1; }
+
+    vv_dsp_set_rt_trap(NULL, NULL);
+    printf("real-time contract tests passed\n");
+    return 0;
+}
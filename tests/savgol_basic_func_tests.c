@@ -28,6 +28,45 @@ int main(void) {
         if (!almost_equal(y[i], expect, (vv_dsp_real)1e-2)) { fprintf(stderr, "deriv1 mismatch at %d: got %f expect %f\n", i, (double)y[i], (double)expect); fails++; break; }
     }
 
+    // Plan: cached kernel matches vv_dsp_savgol for every mode, streaming matches
+    // the NEAREST whole-signal result delayed by the latency
+    {
+        #define SN 200
+        vv_dsp_real sig[SN], ref[SN], got[SN], st[SN];
+        for (int i=0;i<SN;++i) sig[i] = (vv_dsp_real)(sin(0.07*i) + 0.3*cos(0.9*i) + 0.001*i*i);
+        vv_dsp_savgol_plan* plan = NULL;
+        s = vv_dsp_savgol_plan_create(11, 3, 0, (vv_dsp_real)1, &plan);
+        if (s != VV_DSP_OK || !plan) { fprintf(stderr, "savgol plan create status=%d\n", (int)s); return 1; }
+        for (int mode = VV_DSP_SAVGOL_MODE_REFLECT; mode <= VV_DSP_SAVGOL_MODE_WRAP; ++mode) {
+            s = vv_dsp_savgol(sig, SN, 11, 3, 0, (vv_dsp_real)1, (vv_dsp_savgol_mode)mode, ref);
+            vv_dsp_status s2 = vv_dsp_savgol_plan_apply(plan, sig, SN, (vv_dsp_savgol_mode)mode, got);
+            if (s != VV_DSP_OK || s2 != VV_DSP_OK) { fprintf(stderr, "savgol plan apply status=%d/%d\n", (int)s, (int)s2); fails++; break; }
+            for (int i=0;i<SN;++i) if (ref[i] != got[i]) { fprintf(stderr, "plan apply mode %d mismatch at %d\n", mode, i); fails++; break; }
+        }
+        if (vv_dsp_savgol_plan_latency(plan) != 5) { fprintf(stderr, "savgol plan latency\n"); fails++; }
+        (void)vv_dsp_savgol(sig, SN, 11, 3, 0, (vv_dsp_real)1, VV_DSP_SAVGOL_MODE_NEAREST, ref);
+        size_t pos = 0, emitted = 0, cnt = 0;
+        const size_t blocks[] = {1, 3, 4, 7, 60, 2, 100};
+        for (size_t b = 0; pos < SN; ++b) {
+            size_t n = blocks[b % (sizeof(blocks)/sizeof(blocks[0]))];
+            if (n > SN - pos) n = SN - pos;
+            if (pos + n > 5 && vv_dsp_savgol_plan_process(plan, sig + pos, n, st + emitted, 0, &cnt) != VV_DSP_ERROR_INVALID_SIZE) {
+                fprintf(stderr, "savgol stream should reject small max_out\n"); fails++;
+            }
+            s = vv_dsp_savgol_plan_process(plan, sig + pos, n, st + emitted, SN - emitted, &cnt);
+            if (s != VV_DSP_OK) { fprintf(stderr, "savgol stream status=%d\n", (int)s); fails++; break; }
+            pos += n; emitted += cnt;
+        }
+        s = vv_dsp_savgol_plan_flush(plan, st + emitted, SN - emitted, &cnt);
+        emitted += cnt;
+        if (s != VV_DSP_OK || emitted != SN) { fprintf(stderr, "savgol stream emitted %zu of %d\n", emitted, SN); fails++; }
+        for (int i=0;i<SN && i<(int)emitted;++i) {
+            if (!almost_equal(st[i], ref[i], (vv_dsp_real)1e-4)) { fprintf(stderr, "stream mismatch at %d: got %f expect %f\n", i, (double)st[i], (double)ref[i]); fails++; break; }
+        }
+        vv_dsp_savgol_plan_destroy(plan);
+        #undef SN
+    }
+
     if (fails) { fprintf(stderr, "savgol_basic_func_tests: %d failures\n", fails); return 1; }
     printf("savgol_basic_func_tests: OK\n");
     return 0;
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+static vv_dsp_real signal_at(size_t t) {
+    return (vv_dsp_real)(sin(0.071 * (double)t) + 0.4 * cos(0.93 * (double)t) + 0.05 * (double)((t * 7919u) % 13u));
+}
+
+// Direct DFT of the window ending at t; ages weighted by r^(t - tau)
+static void ref_bin(size_t t, size_t n, size_t k, double r, double* re, double* im) {
+    double sr = 0.0, si = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        if (t + 1 + j < n) continue;  // before the first sample
+        const size_t tau = t + 1 + j - n;
+        const double w = pow(r, (double)(t - tau));
+        const double ang = -2.0 * VV_DSP_PI_D * (double)(k * j) / (double)n;
+        sr += w * (double)signal_at(tau) * cos(ang);
+        si += w * (double)signal_at(tau) * sin(ang);
+    }
+    *re = sr; *im = si;
+}
+
+static int test_variant(vv_dsp_sdft_variant variant, double r) {
+    enum { N = 64, K = 7, LEN = 3 * N + 17 };
+    const size_t bins[K] = {0, 1, 5, 17, 32, 47, 63};
+    vv_dsp_sdft_plan* p = NULL;
+    if (vv_dsp_sdft_make_plan(N, bins, K, variant, (vv_dsp_real)r, &p) != VV_DSP_OK) return 0;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_cpx* X = (vv_dsp_cpx*)malloc((size_t)LEN * K * sizeof(vv_dsp_cpx));
+    if (!x || !X) { free(x); free(X); vv_dsp_sdft_destroy(p); return 0; }
+    for (size_t t = 0; t < LEN; ++t) x[t] = signal_at(t);
+
+    // Block API for the first part, single-sample updates for the rest
+    const size_t split = N + 5;
+    int ok = vv_dsp_sdft_process(p, x, split, X) == VV_DSP_OK;
+    for (size_t t = split; ok && t < LEN; ++t) {
+        ok = vv_dsp_sdft_update(p, x[t]) == VV_DSP_OK && vv_dsp_sdft_get_bins(p, X + t * K) == VV_DSP_OK;
+    }
+    const double wr = (variant == VV_DSP_SDFT_DAMPED) ? r : 1.0;
+    for (size_t t = 0; ok && t < LEN; t += 11) {
+        for (size_t b = 0; ok && b < K; ++b) {
+            double re, im;
+            ref_bin(t, N, bins[b], wr, &re, &im);
+            if (fabs((double)X[t * K + b].re - re) > 1e-3 || fabs((double)X[t * K + b].im - im) > 1e-3) {
+                fprintf(stderr, "variant %d t=%zu k=%zu: got (%g,%g) want (%g,%g)\n", (int)variant, t, bins[b],
+                        (double)X[t * K + b].re, (double)X[t * K + b].im, re, im);
+                ok = 0;
+            }
+        }
+    }
+    // Reset restarts from an empty window
+    if (ok && vv_dsp_sdft_reset(p) == VV_DSP_OK && vv_dsp_sdft_process(p, x, 1, X) == VV_DSP_OK) {
+        double re, im;
+        ref_bin(0, N, bins[3], wr, &re, &im);
+        if (fabs((double)X[3].re - re) > 1e-5 || fabs((double)X[3].im - im) > 1e-5) ok = 0;
+    }
+    free(x); free(X);
+    vv_dsp_sdft_destroy(p);
+    return ok;
+}
+
+// A long run must not drift away from the direct DFT
+static int test_long_run(vv_dsp_sdft_variant variant) {
+    enum { N = 256, K = 3, LEN = 400000 };
+    const size_t bins[K] = {3, 100, 255};
+    vv_dsp_sdft_plan* p = NULL;
+    if (vv_dsp_sdft_make_plan(N, bins, K, variant, (vv_dsp_real)1, &p) != VV_DSP_OK) return 0;
+    vv_dsp_real buf[1000];
+    int ok = 1;
+    for (size_t t0 = 0; ok && t0 < LEN; t0 += 1000) {
+        for (size_t i = 0; i < 1000; ++i) buf[i] = signal_at(t0 + i);
+        ok = vv_dsp_sdft_process(p, buf, 1000, NULL) == VV_DSP_OK;
+    }
+    vv_dsp_cpx X[K];
+    ok = ok && vv_dsp_sdft_get_bins(p, X) == VV_DSP_OK;
+    for (size_t b = 0; ok && b < K; ++b) {
+        double re, im;
+        ref_bin(LEN - 1, N, bins[b], 1.0, &re, &im);
+        if (fabs((double)X[b].re - re) > 1e-3 || fabs((double)X[b].im - im) > 1e-3) ok = 0;
+    }
+    vv_dsp_sdft_destroy(p);
+    return ok;
+}
+
+int main(void) {
+    if (!test_variant(VV_DSP_SDFT_STANDARD, 1.0)) { fprintf(stderr, "standard SDFT failed\n"); return 1; }
+    if (!test_variant(VV_DSP_SDFT_DAMPED, 0.999)) { fprintf(stderr, "damped SDFT failed\n"); return 1; }
+    if (!test_variant(VV_DSP_SDFT_MODULATED, 1.0)) { fprintf(stderr, "modulated SDFT failed\n"); return 1; }
+    if (!test_long_run(VV_DSP_SDFT_STANDARD)) { fprintf(stderr, "standard SDFT drifted\n"); return 1; }
+    if (!test_long_run(VV_DSP_SDFT_MODULATED)) { fprintf(stderr, "modulated SDFT drifted\n"); return 1; }
+
+    const size_t bad_bin = 64;
+    vv_dsp_sdft_plan* p = NULL;
+    if (vv_dsp_sdft_make_plan(64, &bad_bin, 1, VV_DSP_SDFT_STANDARD, 1, &p) != VV_DSP_ERROR_OUT_OF_RANGE) return 1;
+    const size_t bin = 1;
+    if (vv_dsp_sdft_make_plan(64, &bin, 1, VV_DSP_SDFT_DAMPED, 1, &p) != VV_DSP_ERROR_OUT_OF_RANGE) return 1;
+    printf("sdft tests passed\n");
+    return 0;
+}
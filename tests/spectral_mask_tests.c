@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { NFFT = 512, HOP = 128, MAX_BLOCK = 256, NH = NFFT / 2 + 1 };
+
+static vv_dsp_spectral_mask* make(size_t channels) {
+    vv_dsp_spectral_mask_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = NFFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.channels = channels;
+    p.max_block = MAX_BLOCK;
+    vv_dsp_spectral_mask* sm = NULL;
+    return vv_dsp_spectral_mask_create(&p, &sm) == VV_DSP_OK ? sm : NULL;
+}
+
+// Stream len samples per channel in blocks cycling through sizes; 0 on failure.
+// Processing runs on preallocated state only.
+static int run(vv_dsp_spectral_mask* sm, size_t channels, vv_dsp_real* const* x, vv_dsp_real* const* y,
+               size_t len, const size_t* sizes, size_t num_sizes) {
+    size_t i = 0;
+    for (size_t pos = 0; pos < len; ++i) {
+        size_t n = sizes[i % num_sizes];
+        if (n > len - pos) n = len - pos;
+        const vv_dsp_real* in[2];
+        vv_dsp_real* out[2];
+        for (size_t c = 0; c < channels; ++c) {
+            in[c] = x[c] + pos;
+            out[c] = y[c] + pos;
+        }
+        vv_dsp_alloc_stats a0, a1;
+        if (vv_dsp_get_thread_alloc_stats(&a0) != VV_DSP_OK ||
+            vv_dsp_spectral_mask_process(sm, in, out, n) != VV_DSP_OK ||
+            vv_dsp_get_thread_alloc_stats(&a1) != VV_DSP_OK || a1.allocations != a0.allocations) return 0;
+        pos += n;
+    }
+    return 1;
+}
+
+static void fill_noise(vv_dsp_real* x, size_t n, unsigned int seed) {
+    for (size_t t = 0; t < n; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        x[t] = (vv_dsp_real)((double)(seed >> 8) / 16777216.0 - 0.5);
+    }
+}
+
+// The default mask of one reconstructs both channels delayed by exactly fft_size,
+// whatever the block sizes, and in place
+static int test_latency(void) {
+    enum { LEN = 6000, AT = 3001 };
+    vv_dsp_spectral_mask* sm = make(2);
+    vv_dsp_real* a = (vv_dsp_real*)calloc(LEN, sizeof(vv_dsp_real));
+    vv_dsp_real* b = (vv_dsp_real*)calloc(LEN, sizeof(vv_dsp_real));
+    int ok = sm && a && b && vv_dsp_spectral_mask_latency(sm) == NFFT && vv_dsp_spectral_mask_num_bins(sm) == NH;
+    if (ok) {
+        a[AT] = 1;
+        b[AT] = (vv_dsp_real)-0.5;
+        vv_dsp_real* const bufs[2] = { a, b };
+        const size_t sizes[4] = { 1, 255, 37, 256 };
+        ok = run(sm, 2, bufs, bufs, LEN, sizes, 4);
+    }
+    for (size_t t = 0; ok && t < LEN; ++t) {
+        const double want = t == AT + NFFT ? 1.0 : 0.0;
+        if (fabs((double)a[t] - want) > 1e-5 || fabs((double)b[t] + 0.5 * want) > 1e-5) {
+            fprintf(stderr, "sample %zu: %f %f\n", t, (double)a[t], (double)b[t]);
+            ok = 0;
+        }
+    }
+    if (sm) (void)vv_dsp_spectral_mask_destroy(sm);
+    free(a);
+    free(b);
+    return ok;
+}
+
+// A real mask cutting every bin above 48 keeps a bin-centred tone at bin 8 and
+// removes one at bin 96
+static int test_real_mask(void) {
+    enum { LEN = 8 * NFFT };
+    vv_dsp_spectral_mask* sm = make(1);
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_real mask[NH];
+    int ok = sm && x && y;
+    if (!ok) goto done;
+    for (size_t k = 0; k < NH; ++k) mask[k] = k <= 48 ? (vv_dsp_real)1 : (vv_dsp_real)0;
+    for (size_t t = 0; t < LEN; ++t) {
+        x[t] = (vv_dsp_real)(sin(2.0 * VV_DSP_PI_D * 8.0 * (double)t / NFFT) +
+                             0.5 * sin(2.0 * VV_DSP_PI_D * 96.0 * (double)t / NFFT));
+    }
+    ok = vv_dsp_spectral_mask_set_real(sm, mask) == VV_DSP_OK;
+    if (ok) {
+        vv_dsp_real* const xs[1] = { x };
+        vv_dsp_real* const ys[1] = { y };
+        const size_t sizes[1] = { HOP };
+        ok = run(sm, 1, xs, ys, LEN, sizes, 1);
+    }
+    for (size_t t = 2 * NFFT; ok && t < LEN; ++t) {
+        const double want = sin(2.0 * VV_DSP_PI_D * 8.0 * (double)(t - NFFT) / NFFT);
+        if (fabs((double)y[t] - want) > 1e-4) {
+            fprintf(stderr, "sample %zu: %f, want %f\n", t, (double)y[t], want);
+            ok = 0;
+        }
+    }
+done:
+    if (sm) (void)vv_dsp_spectral_mask_destroy(sm);
+    free(x);
+    free(y);
+    return ok;
+}
+
+typedef struct {
+    const vv_dsp_cpx* mask;
+    size_t frames[2];
+} cb_state;
+
+static vv_dsp_status complex_cb(void* user, size_t channel, vv_dsp_cpx* bins, size_t num_bins) {
+    cb_state* st = (cb_state*)user;
+    if (num_bins != NH || channel > 1) return VV_DSP_ERROR_INVALID_SIZE;
+    ++st->frames[channel];
+    for (size_t k = 0; k < num_bins; ++k) {
+        const vv_dsp_cpx m = st->mask[k];
+        const vv_dsp_real re = bins[k].re * m.re - bins[k].im * m.im;
+        bins[k].im = bins[k].re * m.im + bins[k].im * m.re;
+        bins[k].re = re;
+    }
+    return VV_DSP_OK;
+}
+
+// A complex mask and a callback applying the same product agree on noise, and the
+// callback runs once per frame and channel
+static int test_complex_and_callback(void) {
+    enum { LEN = 4000 };
+    vv_dsp_spectral_mask* a = make(2);
+    vv_dsp_spectral_mask* b = make(2);
+    vv_dsp_real* buf = (vv_dsp_real*)malloc(6 * LEN * sizeof(vv_dsp_real));
+    vv_dsp_cpx mask[NH];
+    int ok = a && b && buf;
+    if (!ok) goto done;
+    vv_dsp_real *x0 = buf, *x1 = buf + LEN, *ya0 = buf + 2 * LEN, *ya1 = buf + 3 * LEN;
+    vv_dsp_real *yb0 = buf + 4 * LEN, *yb1 = buf + 5 * LEN;
+    fill_noise(x0, LEN, 7u);
+    fill_noise(x1, LEN, 99u);
+    for (size_t k = 0; k < NH; ++k) {
+        mask[k].re = (vv_dsp_real)cos(0.05 * (double)k);
+        mask[k].im = (vv_dsp_real)(0.5 * sin(0.11 * (double)k));
+    }
+    cb_state st;
+    st.mask = mask;
+    st.frames[0] = st.frames[1] = 0;
+    ok = vv_dsp_spectral_mask_set_complex(a, mask) == VV_DSP_OK &&
+         vv_dsp_spectral_mask_set_callback(b, complex_cb, &st) == VV_DSP_OK;
+    if (ok) {
+        vv_dsp_real* const xs[2] = { x0, x1 };
+        vv_dsp_real* const yas[2] = { ya0, ya1 };
+        vv_dsp_real* const ybs[2] = { yb0, yb1 };
+        const size_t sizes[3] = { 100, 3, 256 };
+        const size_t hops[1] = { HOP };
+        ok = run(a, 2, xs, yas, LEN, sizes, 3) && run(b, 2, xs, ybs, LEN, hops, 1);
+    }
+    // With the pre-roll, floor(LEN / hop) frames were analyzed per channel
+    const size_t frames = LEN / HOP;
+    ok = ok && st.frames[0] == frames && st.frames[1] == frames;
+    // Both channels: ya1 and yb1 follow ya0 and yb0
+    for (size_t t = 0; ok && t < 2 * LEN; ++t) {
+        if (fabs((double)ya0[t] - (double)yb0[t]) > 1e-5) {
+            fprintf(stderr, "sample %zu: %f %f\n", t, (double)ya0[t], (double)yb0[t]);
+            ok = 0;
+        }
+    }
+done:
+    if (a) (void)vv_dsp_spectral_mask_destroy(a);
+    if (b) (void)vv_dsp_spectral_mask_destroy(b);
+    free(buf);
+    return ok;
+}
+
+static vv_dsp_status failing_cb(void* user, size_t channel, vv_dsp_cpx* bins, size_t num_bins) {
+    (void)user;
+    (void)bins;
+    (void)num_bins;
+    return channel == 1 ? VV_DSP_ERROR_INTERNAL : VV_DSP_OK;
+}
+
+static int test_errors(void) {
+    vv_dsp_spectral_mask_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = NFFT;
+    p.hop_size = NFFT / 2 + 1;
+    p.channels = 2;
+    vv_dsp_spectral_mask* sm = NULL;
+    if (vv_dsp_spectral_mask_create(&p, &sm) != VV_DSP_ERROR_INVALID_SIZE || sm) return 0;
+    p.hop_size = HOP;
+    p.fft_size = NFFT + 1;
+    if (vv_dsp_spectral_mask_create(&p, &sm) != VV_DSP_ERROR_INVALID_SIZE) return 0;
+    p.fft_size = NFFT;
+    if (vv_dsp_spectral_mask_create(&p, &sm) != VV_DSP_OK) return 0;
+    vv_dsp_real buf[NFFT] = { 0 };
+    const vv_dsp_real* in[2] = { buf, buf };
+    vv_dsp_real* out[2] = { buf, buf };
+    int ok = vv_dsp_spectral_mask_process(sm, in, out, HOP + 1) == VV_DSP_ERROR_INVALID_SIZE &&
+             vv_dsp_spectral_mask_set_real(sm, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+             vv_dsp_spectral_mask_set_callback(sm, NULL, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+             vv_dsp_spectral_mask_set_callback(sm, failing_cb, NULL) == VV_DSP_OK;
+    // The first frame is complete after one hop; the callback's status stops the call
+    ok = ok && vv_dsp_spectral_mask_process(sm, in, out, HOP) == VV_DSP_ERROR_INTERNAL &&
+         vv_dsp_spectral_mask_reset(sm) == VV_DSP_OK &&
+         vv_dsp_spectral_mask_destroy(NULL) == VV_DSP_ERROR_NULL_POINTER;
+    (void)vv_dsp_spectral_mask_destroy(sm);
+    return ok;
+}
+
+int main(void) {
+    int ok = 1;
+    if (!test_latency()) { fprintf(stderr, "spectral mask latency test failed\n"); ok = 0; }
+    if (!test_real_mask()) { fprintf(stderr, "spectral mask real mask test failed\n"); ok = 0; }
+    if (!test_complex_and_callback()) { fprintf(stderr, "spectral mask complex/callback test failed\n"); ok = 0; }
+    if (!test_errors()) { fprintf(stderr, "spectral mask error test failed\n"); ok = 0; }
+    if (!ok) return 1;
+    printf("spectral mask tests passed\n");
+    return 0;
+}
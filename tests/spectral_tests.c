@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include "vv_dsp/vv_dsp.h"
 
@@ -65,7 +66,192 @@ static int test_fft_r2c_c2r_roundtrip(void) {
     return ok;
 }
 
+// Plan-free kernels and the plans that run on them against a direct DFT
+static int test_fft_small(void) {
+    vv_dsp_cpx x[64], X[64], Y[64];
+    memset(x, 0, sizeof(x));
+    int ok = vv_dsp_fft_small(12, VV_DSP_FFT_FORWARD, x, X) == VV_DSP_ERROR_UNSUPPORTED &&
+             vv_dsp_fft_small(128, VV_DSP_FFT_FORWARD, x, X) == VV_DSP_ERROR_UNSUPPORTED;
+    const double PI = 3.14159265358979323846264338327950288;
+    for (size_t n = 8; ok && n <= 64; n *= 2) {
+        for (size_t i = 0; i < n; ++i) x[i] = vv_dsp_cpx_make((vv_dsp_real)sin(0.7 * (double)i), (vv_dsp_real)cos(1.3 * (double)(i * i % 11)));
+        for (int d = 0; ok && d < 2; ++d) {
+            const vv_dsp_fft_dir dir = d ? VV_DSP_FFT_BACKWARD : VV_DSP_FFT_FORWARD;
+            vv_dsp_fft_plan* plan = NULL;
+            memcpy(Y, x, n * sizeof(vv_dsp_cpx));
+            ok = vv_dsp_fft_small(n, dir, x, X) == VV_DSP_OK && vv_dsp_fft_small(n, dir, Y, Y) == VV_DSP_OK &&
+                 memcmp(X, Y, n * sizeof(vv_dsp_cpx)) == 0;
+            for (size_t k = 0; ok && k < n; ++k) {
+                double re = 0, im = 0;
+                for (size_t t = 0; t < n; ++t) {
+                    const double a = (d ? 2.0 : -2.0) * PI * (double)((k * t) % n) / (double)n;
+                    re += (double)x[t].re * cos(a) - (double)x[t].im * sin(a);
+                    im += (double)x[t].re * sin(a) + (double)x[t].im * cos(a);
+                }
+                if (d) { re /= (double)n; im /= (double)n; }
+                ok = fabs((double)X[k].re - re) < 1e-4 && fabs((double)X[k].im - im) < 1e-4;
+            }
+            // A KissFFT plan of this size runs the same kernel
+            ok = ok && vv_dsp_fft_make_plan(n, VV_DSP_FFT_C2C, dir, &plan) == VV_DSP_OK &&
+                 vv_dsp_fft_execute(plan, x, Y) == VV_DSP_OK;
+            for (size_t k = 0; ok && k < n; ++k) {
+                ok = nearly_equal(X[k].re, Y[k].re, (vv_dsp_real)1e-5) && nearly_equal(X[k].im, Y[k].im, (vv_dsp_real)1e-5);
+            }
+            if (plan) vv_dsp_fft_destroy(plan);
+        }
+    }
+    return ok && vv_dsp_fft_small_16(x, X, VV_DSP_FFT_FORWARD) == VV_DSP_OK &&
+           vv_dsp_fft_small_16(x, X, (vv_dsp_fft_dir)0) == VV_DSP_ERROR_OUT_OF_RANGE;
+}
+
+// In-place shifts match the out-of-place copies for odd and even sizes
+static int test_shift_inplace(void) {
+    int ok = 1;
+    for (size_t n = 1; n <= 9 && ok; ++n) {
+        vv_dsp_real a[9], ref[9], b[9];
+        vv_dsp_cpx c[9], cref[9];
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = (vv_dsp_real)i;
+            c[i].re = (vv_dsp_real)i;
+            c[i].im = (vv_dsp_real)(10 + i);
+        }
+        memcpy(b, a, sizeof(a));
+        ok = vv_dsp_fftshift_real(a, ref, n) == VV_DSP_OK && vv_dsp_fftshift_inplace_real(b, n) == VV_DSP_OK &&
+             memcmp(b, ref, n * sizeof(*b)) == 0 && vv_dsp_ifftshift_inplace_real(b, n) == VV_DSP_OK &&
+             memcmp(b, a, n * sizeof(*b)) == 0;
+        // in == out takes the in-place path too
+        ok = ok && vv_dsp_ifftshift_real(a, ref, n) == VV_DSP_OK && vv_dsp_ifftshift_real(b, b, n) == VV_DSP_OK &&
+             memcmp(b, ref, n * sizeof(*b)) == 0;
+        ok = ok && vv_dsp_fftshift_cpx(c, cref, n) == VV_DSP_OK && vv_dsp_fftshift_inplace_cpx(c, n) == VV_DSP_OK &&
+             memcmp(c, cref, n * sizeof(*c)) == 0 && vv_dsp_ifftshift_inplace_cpx(c, n) == VV_DSP_OK &&
+             c[0].re == 0 && c[n - 1].im == (vv_dsp_real)(9 + n);
+    }
+    return ok && vv_dsp_fftshift_inplace_real(NULL, 4) == VV_DSP_ERROR_NULL_POINTER &&
+           vv_dsp_fftshift_inplace_cpx(NULL, 0) == VV_DSP_ERROR_NULL_POINTER;
+}
+
+// |a - b| modulo whole turns
+static double turn_distance(double a, double b) {
+    const double two_pi = 6.283185307179586476925286766559;
+    double d = fmod(a - b, two_pi);
+    if (d > two_pi / 2) d -= two_pi;
+    if (d < -two_pi / 2) d += two_pi;
+    return fabs(d);
+}
+
+// Wrap and unwrap against the old scalar loops, identical on every dispatch level
+static int test_phase_utils(void) {
+    enum { NP = 1000 };
+    const double pi = 3.14159265358979323846264338327950288;
+#if defined(VV_DSP_USE_DOUBLE)
+    const double tol = 1e-9;
+#else
+    const double tol = 1e-4;
+#endif
+    static vv_dsp_real x[NP], w[NP], u[NP], w0[NP], u0[NP];
+    for (size_t i = 0; i < NP; ++i) {
+        const double t = (double)i;
+        x[i] = (vv_dsp_real)(0.0007 * t * t - 40.0 * sin(0.01 * t));  // up to ~700 rad
+    }
+    x[7] = (vv_dsp_real)1e7;  // forces the fmod path for its block
+    x[500] = (vv_dsp_real)-pi;
+    const vv_dsp_simd_level detected = vv_dsp_simd_get_level();
+    int ok = 1, first = 1;
+    for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; lvl++) {
+        if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+        ok = vv_dsp_phase_wrap(x, w, NP) == VV_DSP_OK;
+        for (size_t i = 0; i < NP && ok; ++i) {
+            ok = w[i] > -VV_DSP_PI && w[i] <= VV_DSP_PI &&
+                 turn_distance((double)w[i], (double)x[i]) <= tol * (1.0 + fabs((double)x[i]) * 1e-3);
+        }
+        // Unwrapping the wrapped ramp restores it where steps stay below pi
+        memcpy(u, w, sizeof(u));
+        ok = ok && vv_dsp_phase_unwrap(u, u, NP) == VV_DSP_OK;
+        double acc = (double)w[0];
+        for (size_t i = 1; i < NP && ok; ++i) {
+            double d = (double)w[i] - (double)w[i - 1];
+            if (d > pi) d -= 2 * pi;
+            else if (d < -pi) d += 2 * pi;
+            acc += d;
+            ok = fabs((double)u[i] - acc) <= tol * (1.0 + fabs(acc));
+        }
+        if (first) {
+            memcpy(w0, w, sizeof(w0));
+            memcpy(u0, u, sizeof(u0));
+            first = 0;
+        } else {
+            ok = ok && memcmp(w, w0, sizeof(w)) == 0 && memcmp(u, u0, sizeof(u)) == 0;
+        }
+    }
+    if (vv_dsp_simd_set_level(detected) != VV_DSP_OK) ok = 0;
+    const vv_dsp_real special[3] = { (vv_dsp_real)INFINITY, (vv_dsp_real)NAN, VV_DSP_PI };
+    vv_dsp_real out[3];
+    return ok && vv_dsp_phase_wrap(special, out, 3) == VV_DSP_OK && out[0] != out[0] && out[1] != out[1] &&
+           out[2] == VV_DSP_PI && vv_dsp_phase_unwrap(x, u, 0) == VV_DSP_ERROR_INVALID_SIZE &&
+           vv_dsp_vphase_unwrap(x, NULL, 1) == VV_DSP_ERROR_NULL_POINTER;
+}
+
+// fftshift flag: shifted FULL spectra that reconstruct the same frame
+static int test_stft_fftshift(void) {
+    enum { NF = 64 };
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = NF;
+    p.hop_size = NF / 4;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.periodic = 1;
+    vv_dsp_stft *plain = NULL, *shifted = NULL;
+    vv_dsp_real x[NF], y0[NF] = {0}, y1[NF] = {0};
+    vv_dsp_cpx X[NF], Xs[NF];
+    for (size_t i = 0; i < NF; ++i) x[i] = (vv_dsp_real)(sin(0.37 * (double)i) + 0.2 * cos(1.9 * (double)i));
+    int ok = vv_dsp_stft_create(&p, &plain) == VV_DSP_OK;
+    p.fftshift = 1;
+    ok = ok && vv_dsp_stft_create(&p, &shifted) == VV_DSP_OK && vv_dsp_stft_process(plain, x, X) == VV_DSP_OK &&
+         vv_dsp_stft_process(shifted, x, Xs) == VV_DSP_OK && vv_dsp_fftshift_inplace_cpx(X, NF) == VV_DSP_OK;
+    for (size_t k = 0; k < NF && ok; ++k) {
+        ok = nearly_equal(X[k].re, Xs[k].re, (vv_dsp_real)1e-4) && nearly_equal(X[k].im, Xs[k].im, (vv_dsp_real)1e-4);
+    }
+    ok = ok && vv_dsp_ifftshift_inplace_cpx(X, NF) == VV_DSP_OK &&
+         vv_dsp_stft_reconstruct_normalized(plain, X, y0) == VV_DSP_OK &&
+         vv_dsp_stft_reconstruct_normalized(shifted, Xs, y1) == VV_DSP_OK;
+    for (size_t i = 0; i < NF && ok; ++i) ok = nearly_equal(y0[i], y1[i], (vv_dsp_real)1e-4);
+    // Mel rows project the non-negative bins whatever the shift, serial and parallel
+    enum { N_MELS = 8, N_SIG = 4 * NF, ROWS = 1 + (N_SIG - NF / 4 * 3) / (NF / 4) };
+    vv_dsp_real sig[N_SIG], m0[ROWS * N_MELS], m1[ROWS * N_MELS], m2[ROWS * N_MELS];
+    for (size_t i = 0; i < N_SIG; ++i) sig[i] = (vv_dsp_real)(sin(0.21 * (double)i) + 0.5 * sin(2.3 * (double)i));
+    vv_dsp_real* fb = NULL;
+    size_t nf = 0, flen = 0, f0 = 0, f1 = 0, f2 = 0;
+    ok = ok && vv_dsp_mel_filterbank_create(NF, N_MELS, (vv_dsp_real)16000, (vv_dsp_real)0, (vv_dsp_real)8000,
+                                            VV_DSP_MEL_VARIANT_HTK, &fb, &nf, &flen) == VV_DSP_OK;
+    if (ok) {
+        vv_dsp_spectrogram_opts o;
+        memset(&o, 0, sizeof(o));
+        o.scale = VV_DSP_SPECTROGRAM_POWER;
+        o.mel_weights = fb;
+        o.n_mels = N_MELS;
+        ok = vv_dsp_stft_spectrogram_ex(plain, sig, N_SIG, &o, m0, &f0) == VV_DSP_OK &&
+             vv_dsp_stft_spectrogram_ex(shifted, sig, N_SIG, &o, m1, &f1) == VV_DSP_OK &&
+             vv_dsp_stft_spectrogram_parallel(shifted, sig, N_SIG, &o, m2, &f2, 2) == VV_DSP_OK &&
+             f0 == ROWS && f1 == ROWS && f2 == ROWS && memcmp(m0, m1, sizeof(m0)) == 0 &&
+             memcmp(m0, m2, sizeof(m0)) == 0;
+    }
+    vv_dsp_mel_filterbank_free(fb, nf);
+    vv_dsp_stft_destroy(plain);
+    vv_dsp_stft_destroy(shifted);
+    // Only FULL spectra of even size shift
+    vv_dsp_stft* h = NULL;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    ok = ok && vv_dsp_stft_create(&p, &h) == VV_DSP_ERROR_OUT_OF_RANGE;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_FULL;
+    p.fft_size = NF - 1;
+    return ok && vv_dsp_stft_create(&p, &h) == VV_DSP_ERROR_INVALID_SIZE && h == NULL;
+}
+
 int main(void) {
+    if (!test_fft_small()) { fprintf(stderr, "small FFT kernel test failed\n"); return 1; }
+    if (!test_shift_inplace()) { fprintf(stderr, "in-place fftshift test failed\n"); return 1; }
+    if (!test_phase_utils()) { fprintf(stderr, "phase wrap/unwrap test failed\n"); return 1; }
+    if (!test_stft_fftshift()) { fprintf(stderr, "STFT fftshift test failed\n"); return 1; }
     int ok1 = test_fft_c2c_basic();
     int ok2 = test_fft_r2c_c2r_roundtrip();
     // fftshift/ifftshift
@@ -92,9 +278,15 @@ int main(void) {
         x[i] = (vv_dsp_real)sinf((vv_dsp_real)2.0*(vv_dsp_real)PI*(vv_dsp_real)i/(vv_dsp_real)32.0f);
 #endif
 
-        vv_dsp_stft_params p; p.fft_size = FFT_SZ; p.hop_size = HOP_SZ; p.window = VV_DSP_STFT_WIN_HANN;
+        // Round trip in both spectrum layouts; HALF must equal the lower FULL bins
+        vv_dsp_cpx Xfull[FFT_SZ];
+        vv_dsp_real mag_full[16 * FFT_SZ];
+        for (int layout = 0; layout < 2; ++layout) {
+        vv_dsp_stft_params p; memset(&p, 0, sizeof(p)); p.fft_size = FFT_SZ; p.hop_size = HOP_SZ; p.window = VV_DSP_STFT_WIN_HANN;
+        p.spectrum = layout ? VV_DSP_STFT_SPECTRUM_HALF : VV_DSP_STFT_SPECTRUM_FULL;
         vv_dsp_stft* st = NULL;
         if (vv_dsp_stft_create(&p, &st) != VV_DSP_OK) { fprintf(stderr, "stft create failed\n"); return 1; }
+        if (vv_dsp_stft_num_bins(st) != (layout ? FFT_SZ / 2 + 1 : FFT_SZ)) { fprintf(stderr, "stft bin count wrong\n"); return 1; }
         vv_dsp_cpx X[FFT_SZ];
         vv_dsp_real y[N_STFT+TAIL]; memset(y, 0, sizeof(y));
         vv_dsp_real norm[N_STFT+TAIL]; memset(norm, 0, sizeof(norm));
@@ -105,6 +297,14 @@ int main(void) {
                 frame[i] = (idx < N_STFT) ? x[idx] : (vv_dsp_real)0;
             }
             if (vv_dsp_stft_process(st, frame, X) != VV_DSP_OK) { fprintf(stderr, "stft process failed\n"); vv_dsp_stft_destroy(st); return 1; }
+            if (start == 2 * HOP_SZ) {
+                if (!layout) memcpy(Xfull, X, sizeof(Xfull));
+                for (size_t k = 0; layout && k <= FFT_SZ / 2; ++k) {
+                    if (!nearly_equal(X[k].re, Xfull[k].re, (vv_dsp_real)1e-4) || !nearly_equal(X[k].im, Xfull[k].im, (vv_dsp_real)1e-4)) {
+                        fprintf(stderr, "STFT half spectrum mismatch at %zu\n", k); return 1;
+                    }
+                }
+            }
             if (vv_dsp_stft_reconstruct(st, X, y + start, norm + start) != VV_DSP_OK) { fprintf(stderr, "istft failed\n"); vv_dsp_stft_destroy(st); return 1; }
         }
         for (size_t i=0;i<N_STFT+TAIL;++i) if (norm[i] > (vv_dsp_real)1e-12) y[i] /= norm[i];
@@ -116,8 +316,177 @@ int main(void) {
             mse += d*d; count++;
         }
         mse /= (vv_dsp_real)count;
+        // Spectrogram rows hold num_bins magnitudes; HALF rows are the lower FULL columns
+        const size_t nb = vv_dsp_stft_num_bins(st);
+        vv_dsp_real mag[16 * FFT_SZ];
+        size_t frames = 0;
+        if (vv_dsp_stft_spectrogram(st, x, N_STFT, mag, &frames) != VV_DSP_OK || frames == 0 || frames > 16) { fprintf(stderr, "spectrogram failed\n"); return 1; }
+        if (!layout) memcpy(mag_full, mag, frames * FFT_SZ * sizeof(vv_dsp_real));
+        for (size_t f = 0; layout && f < frames; ++f) {
+            for (size_t k = 0; k < nb; ++k) {
+                if (!nearly_equal(mag[f * nb + k], mag_full[f * FFT_SZ + k], (vv_dsp_real)1e-4)) { fprintf(stderr, "half spectrogram mismatch\n"); return 1; }
+            }
+        }
         vv_dsp_stft_destroy(st);
         if (!(mse < (vv_dsp_real)1e-2)) { fprintf(stderr, "STFT roundtrip MSE too high: %f\n", (double)mse); return 1; }
+        }
+    }
+
+    // Parallel spectrogram is bit-identical to the serial one
+    {
+        enum { N_SIG = 20000, NFFT = 512, HOP = 128 };
+        vv_dsp_stft_params p = { NFFT, HOP, VV_DSP_STFT_WIN_HANN, VV_DSP_STFT_SPECTRUM_HALF, 0, 0, 0 };
+        vv_dsp_stft* st = NULL;
+        if (vv_dsp_stft_create(&p, &st) != VV_DSP_OK) return 1;
+        const size_t max_rows = N_SIG / HOP + 1, nb = vv_dsp_stft_num_bins(st);
+        vv_dsp_real* sig = (vv_dsp_real*)malloc(N_SIG * sizeof(vv_dsp_real));
+        vv_dsp_real* ser = (vv_dsp_real*)malloc(max_rows * nb * sizeof(vv_dsp_real));
+        vv_dsp_real* par = (vv_dsp_real*)malloc(max_rows * nb * sizeof(vv_dsp_real));
+        if (!sig || !ser || !par) return 1;
+        for (size_t i = 0; i < N_SIG; ++i) sig[i] = (vv_dsp_real)sin(0.05 * (double)i + 1e-5 * (double)(i * i));
+        size_t fs = 0, fp = 0;
+        if (vv_dsp_stft_spectrogram(st, sig, N_SIG, ser, &fs) != VV_DSP_OK) return 1;
+        const size_t threads[3] = {4, 7, 0};
+        for (int t = 0; t < 3; ++t) {
+            memset(par, 0, max_rows * nb * sizeof(vv_dsp_real));
+            if (vv_dsp_stft_spectrogram_parallel(st, sig, N_SIG, NULL, par, &fp, threads[t]) != VV_DSP_OK || fp != fs ||
+                memcmp(ser, par, fs * nb * sizeof(vv_dsp_real)) != 0) {
+                fprintf(stderr, "parallel spectrogram differs (%zu threads)\n", threads[t]); return 1;
+            }
+        }
+
+        // Fused output modes against the unfused two-step pipeline
+        enum { N_MELS = 40 };
+        vv_dsp_real* fb = NULL;
+        size_t nf = 0, flen = 0;
+        if (vv_dsp_mel_filterbank_create(NFFT, N_MELS, (vv_dsp_real)16000, (vv_dsp_real)0, (vv_dsp_real)8000,
+                                         VV_DSP_MEL_VARIANT_HTK, &fb, &nf, &flen) != VV_DSP_OK || flen != nb) return 1;
+        vv_dsp_spectrogram_opts o;
+        memset(&o, 0, sizeof(o));
+        o.scale = VV_DSP_SPECTROGRAM_POWER;
+        if (vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, &o, par, &fp) != VV_DSP_OK || fp != fs) return 1;
+        for (size_t i = 0; i < fs * nb; ++i) {
+            if (!nearly_equal(par[i], ser[i] * ser[i], (vv_dsp_real)1e-3 * (ser[i] * ser[i] + (vv_dsp_real)1))) {
+                fprintf(stderr, "power spectrogram mismatch at %zu\n", i); return 1;
+            }
+        }
+        vv_dsp_real* ref = (vv_dsp_real*)malloc(fs * N_MELS * sizeof(vv_dsp_real));
+        if (!ref || vv_dsp_compute_log_mel_spectrogram(par, fs, nb, fb, N_MELS, (vv_dsp_real)1e-6, ref) != VV_DSP_OK) return 1;
+        o.scale = VV_DSP_SPECTROGRAM_LOG;
+        o.floor = (vv_dsp_real)1e-6;
+        o.mel_weights = fb;
+        o.n_mels = N_MELS;
+        if (vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, &o, ser, &fs) != VV_DSP_OK) return 1;
+        for (size_t i = 0; i < fs * N_MELS; ++i) {
+            if (!nearly_equal(ser[i], ref[i], (vv_dsp_real)1e-3)) { fprintf(stderr, "fused log-mel mismatch at %zu\n", i); return 1; }
+        }
+        // Fast precision mode: the vectorized log stays within 7e-5 of libm
+        if (vv_dsp_stft_set_precision(st, (vv_dsp_precision_mode)5) != VV_DSP_ERROR_OUT_OF_RANGE ||
+            vv_dsp_stft_set_precision(st, VV_DSP_PRECISION_FAST) != VV_DSP_OK ||
+            vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, &o, ser, &fs) != VV_DSP_OK) return 1;
+        for (size_t i = 0; i < fs * N_MELS; ++i) {
+            if (!nearly_equal(ser[i], ref[i], (vv_dsp_real)1e-3)) { fprintf(stderr, "fast log-mel mismatch at %zu\n", i); return 1; }
+        }
+        if (vv_dsp_stft_set_precision(st, VV_DSP_PRECISION_EXACT) != VV_DSP_OK) return 1;
+        // dB with floor clamps silence; the parallel path stays bit-identical
+        o.scale = VV_DSP_SPECTROGRAM_DB;
+        o.floor = (vv_dsp_real)1e-10;
+        memset(sig, 0, NFFT * sizeof(vv_dsp_real));
+        if (vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, &o, ser, &fs) != VV_DSP_OK) return 1;
+        if (!nearly_equal(ser[0], (vv_dsp_real)-100, (vv_dsp_real)1e-3)) { fprintf(stderr, "dB floor not applied\n"); return 1; }
+        if (vv_dsp_stft_spectrogram_parallel(st, sig, N_SIG, &o, par, &fp, 3) != VV_DSP_OK ||
+            memcmp(ser, par, fs * N_MELS * sizeof(vv_dsp_real)) != 0) { fprintf(stderr, "parallel dB mel differs\n"); return 1; }
+        o.floor = 0;
+        if (vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, &o, ser, &fs) != VV_DSP_ERROR_OUT_OF_RANGE) return 1;
+        free(ref);
+        vv_dsp_mel_filterbank_free(fb, N_MELS);
+        free(sig); free(ser); free(par);
+        vv_dsp_stft_destroy(st);
+    }
+
+    // Spectrogram over a non-centered frame view matches the signal path row for row
+    {
+        enum { N_SIG = 5000, NFFT = 256, HOP = 96 };
+        vv_dsp_stft_params p = { NFFT, HOP, VV_DSP_STFT_WIN_HANN, VV_DSP_STFT_SPECTRUM_HALF, 0, 0, 0 };
+        vv_dsp_stft* st = NULL;
+        if (vv_dsp_stft_create(&p, &st) != VV_DSP_OK) return 1;
+        const size_t max_rows = N_SIG / HOP + 1, nb = vv_dsp_stft_num_bins(st);
+        vv_dsp_real* sig = (vv_dsp_real*)malloc(N_SIG * sizeof(vv_dsp_real));
+        vv_dsp_real* ref = (vv_dsp_real*)malloc(max_rows * nb * sizeof(vv_dsp_real));
+        vv_dsp_real* got = (vv_dsp_real*)malloc(max_rows * nb * sizeof(vv_dsp_real));
+        if (!sig || !ref || !got) return 1;
+        for (size_t i = 0; i < N_SIG; ++i) sig[i] = (vv_dsp_real)sin(0.11 * (double)i) * (vv_dsp_real)(1 + i % 7);
+        vv_dsp_frame_view view;
+        if (vv_dsp_frame_view_init(&view, sig, N_SIG, NFFT, HOP, 0) != VV_DSP_OK) return 1;
+        size_t fr = 0, fv = 0;
+        if (vv_dsp_stft_spectrogram_ex(st, sig, N_SIG, NULL, ref, &fr) != VV_DSP_OK) return 1;
+        if (vv_dsp_stft_spectrogram_view(st, &view, NULL, got, &fv) != VV_DSP_OK || fv != view.num_frames ||
+            fv > fr || memcmp(ref, got, fv * nb * sizeof(vv_dsp_real)) != 0) {
+            fprintf(stderr, "frame view spectrogram differs\n"); return 1;
+        }
+        vv_dsp_frame_view_free(&view);
+        if (vv_dsp_frame_view_init(&view, sig, N_SIG, NFFT / 2, HOP, 0) != VV_DSP_OK) return 1;
+        if (vv_dsp_stft_spectrogram_view(st, &view, NULL, got, &fv) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+        vv_dsp_frame_view_free(&view);
+        free(sig); free(ref); free(got);
+        vv_dsp_stft_destroy(st);
+    }
+
+    // Multi-resolution spectrogram: resolution q row j equals the single-resolution
+    // spectrogram of the signal shifted by the centring offset (nmax - nfft_r) / 2
+    {
+        enum { N_SIG = 9000, N_RES = 4 };
+        vv_dsp_stft_params res[N_RES] = {
+            { 256, 64, VV_DSP_STFT_WIN_HANN, VV_DSP_STFT_SPECTRUM_HALF, 1, 0, 0 },
+            { 512, 128, VV_DSP_STFT_WIN_HANN, VV_DSP_STFT_SPECTRUM_HALF, 1, 0, 0 },
+            { 1024, 128, VV_DSP_STFT_WIN_BLACKMAN, VV_DSP_STFT_SPECTRUM_FULL, 0, 0, 0 },
+            { 2048, 256, VV_DSP_STFT_WIN_HANN, VV_DSP_STFT_SPECTRUM_HALF, 1, 0, 0 }
+        };
+        vv_dsp_stft_multires* mr = NULL;
+        if (vv_dsp_stft_multires_create(res, N_RES, &mr) != VV_DSP_OK) return 1;
+        vv_dsp_real* sig = (vv_dsp_real*)malloc(N_SIG * sizeof(vv_dsp_real));
+        vv_dsp_real* outs[N_RES];
+        vv_dsp_real* ref = (vv_dsp_real*)malloc((N_SIG / 64 + 1) * 2048 * sizeof(vv_dsp_real));
+        if (!sig || !ref) return 1;
+        for (size_t i = 0; i < N_SIG; ++i) sig[i] = (vv_dsp_real)(sin(0.07 * (double)i) + 0.3 * cos(0.9 * (double)i));
+        for (int q = 0; q < N_RES; ++q) {
+            outs[q] = (vv_dsp_real*)malloc(vv_dsp_stft_multires_frames(mr, (size_t)q, N_SIG) * res[q].fft_size *
+                                           sizeof(vv_dsp_real));
+            if (!outs[q]) return 1;
+        }
+        vv_dsp_spectrogram_opts o;
+        memset(&o, 0, sizeof(o));
+        for (int pass = 0; pass < 2; ++pass) {
+            if (pass == 1) { o.scale = VV_DSP_SPECTROGRAM_DB; o.floor = (vv_dsp_real)1e-10; }
+            size_t frames[N_RES];
+            if (vv_dsp_stft_multires_spectrogram(mr, sig, N_SIG, &o, outs, frames) != VV_DSP_OK) return 1;
+            for (int q = 0; q < N_RES; ++q) {
+                const size_t off = (2048 - res[q].fft_size) / 2;
+                vv_dsp_stft* st = NULL;
+                size_t fr = 0;
+                if (frames[q] != vv_dsp_stft_multires_frames(mr, (size_t)q, N_SIG) ||
+                    vv_dsp_stft_create(&res[q], &st) != VV_DSP_OK ||
+                    vv_dsp_stft_spectrogram_ex(st, sig + off, N_SIG - off, &o, ref, &fr) != VV_DSP_OK ||
+                    fr < frames[q]) { fprintf(stderr, "multires setup failed\n"); return 1; }
+                const size_t nb = vv_dsp_stft_num_bins(st);
+                for (size_t i = 0; i < frames[q] * nb; ++i) {
+                    if (!nearly_equal(outs[q][i], ref[i], (vv_dsp_real)1e-4 * ((vv_dsp_real)1 + (ref[i] < 0 ? -ref[i] : ref[i])))) {
+                        fprintf(stderr, "multires mismatch res %d at %zu\n", q, i); return 1;
+                    }
+                }
+                vv_dsp_stft_destroy(st);
+            }
+        }
+        o.mel_weights = ref;
+        o.n_mels = 4;
+        size_t frames[N_RES];
+        if (vv_dsp_stft_multires_spectrogram(mr, sig, N_SIG, &o, outs, frames) != VV_DSP_ERROR_UNSUPPORTED) return 1;
+        vv_dsp_stft_multires_destroy(mr);
+        // Hops must be multiples of the smallest one
+        res[1].hop_size = 96;
+        if (vv_dsp_stft_multires_create(res, N_RES, &mr) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+        for (int q = 0; q < N_RES; ++q) free(outs[q]);
+        free(sig); free(ref);
     }
 
     printf("spectral tests passed\n");
@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+static vv_dsp_real signal_at(size_t t) {
+    return (vv_dsp_real)(sin(0.071 * (double)t) + 0.4 * cos(0.93 * (double)t) + 0.05 * (double)((t * 7919u) % 13u));
+}
+
+// Frames popped from odd-sized pushes must equal vv_dsp_stft_process() on the same samples
+static int test_push_pop(vv_dsp_stft_spectrum spectrum, size_t block) {
+    enum { NFFT = 256, HOP = 96, LEN = 4000 };
+    vv_dsp_stft_params prm = { .fft_size = NFFT, .hop_size = HOP, .window = VV_DSP_STFT_WIN_HANN,
+                               .spectrum = spectrum };
+    vv_dsp_stft* h = NULL;
+    if (vv_dsp_stft_create(&prm, &h) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_stft_stream_reserve(h, block) == VV_DSP_OK;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    vv_dsp_cpx* got = (vv_dsp_cpx*)malloc(NFFT * sizeof(vv_dsp_cpx));
+    vv_dsp_cpx* want = (vv_dsp_cpx*)malloc(NFFT * sizeof(vv_dsp_cpx));
+    if (!x || !got || !want) ok = 0;
+    for (size_t t = 0; ok && t < LEN; ++t) x[t] = signal_at(t);
+
+    const size_t nb = vv_dsp_stft_num_bins(h);
+    size_t frame = 0;
+    for (size_t pos = 0; ok && pos < LEN; pos += block) {
+        const size_t n = (LEN - pos < block) ? LEN - pos : block;
+        ok = vv_dsp_stft_push(h, x + pos, n) == VV_DSP_OK;
+        while (ok && vv_dsp_stft_frames_ready(h) > 0) {
+            ok = vv_dsp_stft_pop_frame(h, got) == VV_DSP_OK &&
+                 vv_dsp_stft_process(h, x + frame * HOP, want) == VV_DSP_OK;
+            for (size_t k = 0; ok && k < nb; ++k) {
+                if (fabs((double)got[k].re - (double)want[k].re) > 1e-4 ||
+                    fabs((double)got[k].im - (double)want[k].im) > 1e-4) {
+                    fprintf(stderr, "frame %zu bin %zu mismatch\n", frame, k);
+                    ok = 0;
+                }
+            }
+            ++frame;
+        }
+        // Every ready frame was popped, so the next block always fits
+        if (ok && vv_dsp_stft_stream_space(h) < block) ok = 0;
+    }
+    if (ok && frame != 1 + (LEN - NFFT) / HOP) { fprintf(stderr, "popped %zu frames\n", frame); ok = 0; }
+    if (ok && vv_dsp_stft_pop_frame(h, got) != VV_DSP_ERROR_INVALID_SIZE) ok = 0;
+    free(x); free(got); free(want);
+    vv_dsp_stft_destroy(h);
+    return ok;
+}
+
+// Push/pop analysis straight into streaming synthesis reproduces the input once the
+// overlap has ramped in
+static int test_resynthesis(vv_dsp_stft_spectrum spectrum, vv_dsp_stft_window window, size_t hop) {
+    enum { NFFT = 128, LEN = 3000 };
+    vv_dsp_stft_params prm = { .fft_size = NFFT, .hop_size = hop, .window = window, .spectrum = spectrum };
+    vv_dsp_stft* h = NULL;
+    if (vv_dsp_stft_create(&prm, &h) != VV_DSP_OK) return 0;
+    vv_dsp_cpx X[NFFT];
+    vv_dsp_real* y = (vv_dsp_real*)calloc(LEN + NFFT, sizeof(vv_dsp_real));
+    int ok = y != NULL;
+    size_t written = 0;
+    for (size_t t = 0; ok && t < LEN; ++t) {
+        const vv_dsp_real v = signal_at(t);
+        ok = vv_dsp_stft_push(h, &v, 1) == VV_DSP_OK;
+        if (ok && vv_dsp_stft_frames_ready(h) > 0) {
+            ok = vv_dsp_stft_pop_frame(h, X) == VV_DSP_OK &&
+                 vv_dsp_stft_synth_frame(h, X, y + written) == VV_DSP_OK;
+            written += hop;
+        }
+    }
+    double max_err = 0.0;
+    for (size_t t = NFFT - hop; ok && t < written; ++t) {
+        const double e = fabs((double)y[t] - (double)signal_at(t));
+        if (e > max_err) max_err = e;
+    }
+    if (ok && !(max_err < 1e-4)) { fprintf(stderr, "resynthesis error %g\n", max_err); ok = 0; }
+    free(y);
+    vv_dsp_stft_destroy(h);
+    return ok;
+}
+
+// COLA pairs are detected at create; offline reconstruction with the folded synthesis
+// window restores the interior without a normalization buffer for any window
+static int test_cola_reconstruct(vv_dsp_stft_window window, vv_dsp_real param, int periodic, int expect_cola) {
+    enum { NFFT = 128, HOP = 32, LEN = 2048 };
+    vv_dsp_stft_params prm = { .fft_size = NFFT, .hop_size = HOP, .window = window,
+                               .spectrum = VV_DSP_STFT_SPECTRUM_HALF, .periodic = periodic, .window_param = param };
+    vv_dsp_stft* h = NULL;
+    if (vv_dsp_stft_create(&prm, &h) != VV_DSP_OK) return 0;
+    vv_dsp_real gain = -1;
+    int ok = vv_dsp_stft_cola_gain(h, &gain) == VV_DSP_OK && ((gain > 0) == expect_cola);
+    // Periodic Hann squares at 4x overlap sum to 1.5
+    if (ok && window == VV_DSP_STFT_WIN_HANN && periodic) ok = fabs((double)gain - 1.0 / 1.5) < 1e-5;
+    vv_dsp_cpx X[NFFT];
+    vv_dsp_real frame[NFFT];
+    vv_dsp_real* y = (vv_dsp_real*)calloc(LEN + NFFT, sizeof(vv_dsp_real));
+    ok = ok && y != NULL;
+    for (size_t start = 0; ok && start + NFFT <= LEN; start += HOP) {
+        for (size_t i = 0; i < NFFT; ++i) frame[i] = signal_at(start + i);
+        ok = vv_dsp_stft_process(h, frame, X) == VV_DSP_OK &&
+             vv_dsp_stft_reconstruct_normalized(h, X, y + start) == VV_DSP_OK;
+    }
+    double max_err = 0.0;
+    for (size_t t = NFFT - HOP; ok && t < LEN - NFFT + HOP; ++t) {
+        const double e = fabs((double)y[t] - (double)signal_at(t));
+        if (e > max_err) max_err = e;
+    }
+    if (ok && !(max_err < 1e-4)) { fprintf(stderr, "normalized reconstruction error %g\n", max_err); ok = 0; }
+    free(y);
+    vv_dsp_stft_destroy(h);
+    return ok;
+}
+
+// Handles on one shared config keep independent state and match a private handle
+static int test_shared_config(void) {
+    enum { NFFT = 256, HOP = 64, LEN = 2048, STREAMS = 3 };
+    vv_dsp_stft_params prm = { .fft_size = NFFT, .hop_size = HOP, .window = VV_DSP_STFT_WIN_HANN,
+                               .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft_config* cfg = NULL;
+    vv_dsp_stft* ref = NULL;
+    vv_dsp_stft* hs[STREAMS] = {NULL, NULL, NULL};
+    if (vv_dsp_stft_config_create(&prm, &cfg) != VV_DSP_OK || vv_dsp_stft_create(&prm, &ref) != VV_DSP_OK) return 0;
+    int ok = 1;
+    for (int i = 0; ok && i < STREAMS; ++i) ok = vv_dsp_stft_create_from_config(cfg, &hs[i]) == VV_DSP_OK;
+    // Handles keep the config alive
+    ok = ok && vv_dsp_stft_config_release(cfg) == VV_DSP_OK;
+    vv_dsp_cpx X[NFFT], Y[NFFT];
+    vv_dsp_real out_ref[HOP], out[HOP];
+    // Stream i carries the signal scaled by (i + 1); interleave the streams sample by sample
+    for (size_t t = 0; ok && t < LEN; ++t) {
+        const vv_dsp_real v = signal_at(t);
+        ok = vv_dsp_stft_push(ref, &v, 1) == VV_DSP_OK;
+        for (int i = 0; ok && i < STREAMS; ++i) {
+            const vv_dsp_real vi = v * (vv_dsp_real)(i + 1);
+            ok = vv_dsp_stft_push(hs[i], &vi, 1) == VV_DSP_OK;
+        }
+        if (!ok || vv_dsp_stft_frames_ready(ref) == 0) continue;
+        ok = vv_dsp_stft_pop_frame(ref, X) == VV_DSP_OK && vv_dsp_stft_synth_frame(ref, X, out_ref) == VV_DSP_OK;
+        for (int i = 0; ok && i < STREAMS; ++i) {
+            const double scale = (double)(i + 1);
+            ok = vv_dsp_stft_pop_frame(hs[i], Y) == VV_DSP_OK && vv_dsp_stft_synth_frame(hs[i], Y, out) == VV_DSP_OK;
+            for (size_t k = 0; ok && k < NFFT / 2 + 1; ++k) {
+                if (fabs((double)Y[k].re - scale * (double)X[k].re) > 1e-3 * scale ||
+                    fabs((double)Y[k].im - scale * (double)X[k].im) > 1e-3 * scale) ok = 0;
+            }
+            for (size_t k = 0; ok && k < HOP; ++k) {
+                if (fabs((double)out[k] - scale * (double)out_ref[k]) > 1e-4 * scale) ok = 0;
+            }
+        }
+    }
+    // Spectrogram through a shared handle matches the private one
+    vv_dsp_real* m1 = (vv_dsp_real*)malloc(64 * (NFFT / 2 + 1) * sizeof(vv_dsp_real));
+    vv_dsp_real* m2 = (vv_dsp_real*)malloc(64 * (NFFT / 2 + 1) * sizeof(vv_dsp_real));
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    size_t f1 = 0, f2 = 0;
+    if (!m1 || !m2 || !x) ok = 0;
+    for (size_t t = 0; ok && t < LEN; ++t) x[t] = signal_at(t);
+    ok = ok && vv_dsp_stft_spectrogram(ref, x, LEN, m1, &f1) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram(hs[1], x, LEN, m2, &f2) == VV_DSP_OK && f1 == f2;
+    for (size_t i = 0; ok && i < f1 * (NFFT / 2 + 1); ++i) {
+        if (fabs((double)m1[i] - (double)m2[i]) > 1e-4 * (1.0 + fabs((double)m1[i]))) ok = 0;
+    }
+    free(m1); free(m2); free(x);
+    for (int i = 0; i < STREAMS; ++i) vv_dsp_stft_destroy(hs[i]);
+    vv_dsp_stft_destroy(ref);
+    return ok;
+}
+
+int main(void) {
+    if (!test_push_pop(VV_DSP_STFT_SPECTRUM_HALF, 64)) { fprintf(stderr, "stream 64-sample blocks failed\n"); return 1; }
+    if (!test_push_pop(VV_DSP_STFT_SPECTRUM_HALF, 480)) { fprintf(stderr, "stream 480-sample blocks failed\n"); return 1; }
+    if (!test_push_pop(VV_DSP_STFT_SPECTRUM_FULL, 127)) { fprintf(stderr, "stream full-spectrum failed\n"); return 1; }
+
+    if (!test_resynthesis(VV_DSP_STFT_SPECTRUM_HALF, VV_DSP_STFT_WIN_HANN, 32)) { fprintf(stderr, "hann resynthesis failed\n"); return 1; }
+    if (!test_resynthesis(VV_DSP_STFT_SPECTRUM_HALF, VV_DSP_STFT_WIN_HAMMING, 50)) { fprintf(stderr, "hamming resynthesis failed\n"); return 1; }
+    if (!test_resynthesis(VV_DSP_STFT_SPECTRUM_FULL, VV_DSP_STFT_WIN_BOXCAR, 128)) { fprintf(stderr, "boxcar resynthesis failed\n"); return 1; }
+
+    if (!test_cola_reconstruct(VV_DSP_STFT_WIN_HANN, 0, 1, 1)) { fprintf(stderr, "periodic hann COLA failed\n"); return 1; }
+    if (!test_cola_reconstruct(VV_DSP_STFT_WIN_HANN, 0, 0, 0)) { fprintf(stderr, "symmetric hann failed\n"); return 1; }
+    if (!test_cola_reconstruct(VV_DSP_STFT_WIN_KAISER, (vv_dsp_real)8, 1, 0)) { fprintf(stderr, "kaiser failed\n"); return 1; }
+    if (!test_cola_reconstruct(VV_DSP_STFT_WIN_BLACKMAN_HARRIS, 0, 1, 0)) { fprintf(stderr, "blackman-harris failed\n"); return 1; }
+    if (!test_resynthesis(VV_DSP_STFT_SPECTRUM_HALF, VV_DSP_STFT_WIN_TUKEY, 32)) { fprintf(stderr, "tukey resynthesis failed\n"); return 1; }
+
+    if (!test_shared_config()) { fprintf(stderr, "shared config handles failed\n"); return 1; }
+
+    // Oversized pushes are rejected without consuming
+    vv_dsp_stft_params prm = { .fft_size = 64, .hop_size = 16, .window = VV_DSP_STFT_WIN_HANN,
+                               .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft* h = NULL;
+    if (vv_dsp_stft_create(&prm, &h) != VV_DSP_OK) return 1;
+    vv_dsp_real buf[256] = {0};
+    if (vv_dsp_stft_stream_space(h) != 128) return 1;
+    if (vv_dsp_stft_push(h, buf, 129) != VV_DSP_ERROR_INVALID_SIZE) return 1;
+    if (vv_dsp_stft_push(h, buf, 100) != VV_DSP_OK || vv_dsp_stft_frames_ready(h) != 3) return 1;
+    if (vv_dsp_stft_stream_reset(h) != VV_DSP_OK || vv_dsp_stft_frames_ready(h) != 0) return 1;
+    vv_dsp_stft_destroy(h);
+    printf("stft stream tests passed\n");
+    return 0;
+}
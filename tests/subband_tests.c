@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+// Near-perfect reconstruction floor of the default designs is about -65 dB
+#define RECON_DB -55.0
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+static vv_dsp_subband* make_bank(vv_dsp_subband_type type, size_t bands, size_t dec, size_t taps) {
+    vv_dsp_subband_params p;
+    memset(&p, 0, sizeof(p));
+    p.type = type;
+    p.num_bands = bands;
+    p.decimation = dec;
+    p.taps_per_band = taps;
+    vv_dsp_subband* fb = NULL;
+    if (vv_dsp_subband_create(&p, &fb) != VV_DSP_OK) return NULL;
+    return fb;
+}
+
+static size_t row_bytes(const vv_dsp_subband* fb, vv_dsp_subband_type type) {
+    return vv_dsp_subband_frame_size(fb) * (type == VV_DSP_SUBBAND_DFT ? sizeof(vv_dsp_cpx) : sizeof(vv_dsp_real));
+}
+
+// Analyze noise in uneven chunks, synthesize in uneven frame groups, and compare the
+// output with the input delayed by the latency
+static int check_reconstruction(vv_dsp_subband_type type, size_t bands, size_t dec, size_t taps) {
+    static const size_t chunks[] = {1, 7, 64, 3, 500, 33, 1000, 2};
+    vv_dsp_subband* fb = make_bank(type, bands, dec, taps);
+    if (!fb) return 0;
+    const size_t D = vv_dsp_subband_decimation(fb), lat = vv_dsp_subband_latency(fb);
+    const size_t n = 16 * lat + 4000, max_frames = n / D + 1;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* y = (vv_dsp_real*)malloc(max_frames * D * sizeof(vv_dsp_real));
+    char* frames = (char*)malloc(max_frames * row_bytes(fb, type));
+    int ok = x && y && frames;
+    unsigned int seed = (unsigned int)(bands * 31u + D);
+    for (size_t i = 0; ok && i < n; ++i) x[i] = (vv_dsp_real)frand(&seed);
+
+    size_t total = 0;
+    for (size_t pos = 0, c = 0; ok && pos < n; ++c) {
+        size_t len = chunks[c % (sizeof(chunks) / sizeof(chunks[0]))];
+        if (len > n - pos) len = n - pos;
+        const size_t expect = vv_dsp_subband_analysis_count(fb, len);
+        size_t got = 0;
+        ok = vv_dsp_subband_analyze(fb, x + pos, len, frames + total * row_bytes(fb, type), max_frames - total,
+                                    &got) == VV_DSP_OK &&
+             got == expect;
+        total += got;
+        pos += len;
+    }
+    ok = ok && total == n / D;
+    for (size_t f = 0, c = 0; ok && f < total; ++c) {
+        size_t cnt = chunks[(c + 3) % (sizeof(chunks) / sizeof(chunks[0]))] % 40 + 1;
+        if (cnt > total - f) cnt = total - f;
+        ok = vv_dsp_subband_synthesize(fb, frames + f * row_bytes(fb, type), cnt, y + f * D) == VV_DSP_OK;
+        f += cnt;
+    }
+    double err = 0.0, ref = 0.0;
+    for (size_t i = lat; ok && i < total * D; ++i) {
+        const double e = (double)y[i] - (double)x[i - lat];
+        err += e * e;
+        ref += (double)x[i - lat] * (double)x[i - lat];
+    }
+    const double db = (ok && ref > 0.0) ? 10.0 * log10(err / ref + 1e-30) : 0.0;
+    if (ok && !(db < RECON_DB)) {
+        fprintf(stderr, "%s M=%zu D=%zu: reconstruction error %.1f dB\n", type == VV_DSP_SUBBAND_DFT ? "DFT" : "PQMF",
+                bands, D, db);
+        ok = 0;
+    }
+    free(x);
+    free(y);
+    free(frames);
+    vv_dsp_subband_destroy(fb);
+    return ok;
+}
+
+static int test_reconstruction(void) {
+    return check_reconstruction(VV_DSP_SUBBAND_PQMF, 2, 0, 0) && check_reconstruction(VV_DSP_SUBBAND_PQMF, 8, 0, 0) &&
+           check_reconstruction(VV_DSP_SUBBAND_PQMF, 32, 32, 0) && check_reconstruction(VV_DSP_SUBBAND_PQMF, 5, 0, 18) &&
+           check_reconstruction(VV_DSP_SUBBAND_DFT, 2, 0, 0) && check_reconstruction(VV_DSP_SUBBAND_DFT, 16, 0, 0) &&
+           check_reconstruction(VV_DSP_SUBBAND_DFT, 64, 0, 0) && check_reconstruction(VV_DSP_SUBBAND_DFT, 16, 4, 0) &&
+           check_reconstruction(VV_DSP_SUBBAND_DFT, 12, 5, 10);
+}
+
+// A cosine at the center of one band lands in that band: at least 99% of the frame
+// energy for PQMF (adjacent bands see its edge), a constant a/2 for the DFT bank
+static int test_band_isolation(void) {
+    int ok = 1;
+    const size_t M = 16, n = 8192;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_cpx* frames = (vv_dsp_cpx*)malloc(2 * n * sizeof(vv_dsp_cpx));
+    if (!x || !frames) ok = 0;
+    for (size_t k = 3; ok && k < M; k += 5) {
+        vv_dsp_subband* fb = make_bank(VV_DSP_SUBBAND_PQMF, M, 0, 0);
+        const double w = VV_DSP_PI_D * ((double)k + 0.5) / (double)M;
+        for (size_t i = 0; i < n; ++i) x[i] = (vv_dsp_real)(0.8 * cos(w * (double)i));
+        size_t nf = 0;
+        ok = fb && vv_dsp_subband_analyze(fb, x, n, frames, n, &nf) == VV_DSP_OK && nf == n / M;
+        double in_band = 0.0, all = 0.0;
+        const vv_dsp_real* r = (const vv_dsp_real*)frames;
+        for (size_t f = 64; ok && f < nf; ++f) {
+            for (size_t b = 0; b < M; ++b) {
+                const double v = (double)r[f * M + b];
+                all += v * v;
+                if (b == k) in_band += v * v;
+            }
+        }
+        if (ok && !(in_band > 0.99 * all)) {
+            fprintf(stderr, "PQMF band %zu holds %.4f of the energy\n", k, in_band / all);
+            ok = 0;
+        }
+        vv_dsp_subband_destroy(fb);
+    }
+    for (size_t k = 1; ok && k < M / 2; k += 3) {
+        vv_dsp_subband* fb = make_bank(VV_DSP_SUBBAND_DFT, M, 0, 0);
+        const double w = VV_DSP_TWO_PI_D * (double)k / (double)M;
+        for (size_t i = 0; i < n; ++i) x[i] = (vv_dsp_real)(0.8 * cos(w * (double)i + 0.3));
+        size_t nf = 0;
+        ok = fb && vv_dsp_subband_analyze(fb, x, n, frames, n / (M / 2), &nf) == VV_DSP_OK;
+        const size_t B = M / 2 + 1;
+        for (size_t f = 64; ok && f < nf; ++f) {
+            const vv_dsp_cpx z = frames[f * B + k];
+            const double mag = sqrt((double)z.re * (double)z.re + (double)z.im * (double)z.im);
+            const double ph = atan2((double)z.im, (double)z.re);
+            ok = fabs(mag - 0.4) < 2e-3 && fabs(ph - 0.3) < 5e-3;
+            for (size_t b = 0; ok && b < B; ++b) {
+                if (b + 1 >= k && b <= k + 1) continue;
+                const vv_dsp_cpx o = frames[f * B + b];
+                ok = fabs((double)o.re) + fabs((double)o.im) < 2e-3;
+            }
+            if (!ok) fprintf(stderr, "DFT band %zu frame %zu: %g%+gi\n", k, f, (double)z.re, (double)z.im);
+        }
+        vv_dsp_subband_destroy(fb);
+    }
+    free(x);
+    free(frames);
+    return ok;
+}
+
+// reset restores the state of a fresh bank for both directions
+static int test_reset(void) {
+    vv_dsp_subband* fb = make_bank(VV_DSP_SUBBAND_DFT, 8, 0, 0);
+    if (!fb) return 0;
+    vv_dsp_real x[300], y1[300], y2[300];
+    vv_dsp_cpx f1[75 * 5], f2[75 * 5];
+    unsigned int seed = 5u;
+    for (size_t i = 0; i < 300; ++i) x[i] = (vv_dsp_real)frand(&seed);
+    size_t n1 = 0, n2 = 0;
+    int ok = vv_dsp_subband_analyze(fb, x, 300, f1, 75, &n1) == VV_DSP_OK &&
+             vv_dsp_subband_synthesize(fb, f1, n1, y1) == VV_DSP_OK && vv_dsp_subband_reset(fb) == VV_DSP_OK &&
+             vv_dsp_subband_analyze(fb, x, 300, f2, 75, &n2) == VV_DSP_OK && n1 == n2 && n1 == 75 &&
+             vv_dsp_subband_synthesize(fb, f2, n2, y2) == VV_DSP_OK;
+    ok = ok && memcmp(f1, f2, sizeof(f1)) == 0 && memcmp(y1, y2, n1 * 4 * sizeof(vv_dsp_real)) == 0;
+    vv_dsp_subband_destroy(fb);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_subband_params p;
+    memset(&p, 0, sizeof(p));
+    vv_dsp_subband* fb = (vv_dsp_subband*)1;
+    p.num_bands = 1;
+    int ok = vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_INVALID_SIZE && fb == NULL;
+    p.num_bands = 8;
+    p.decimation = 4;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_INVALID_SIZE;
+    p.decimation = 0;
+    p.taps_per_band = 7;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_INVALID_SIZE;
+    p.type = VV_DSP_SUBBAND_DFT;
+    p.taps_per_band = 0;
+    p.decimation = 5;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_INVALID_SIZE;
+    p.decimation = 0;
+    p.num_bands = 9;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_INVALID_SIZE;
+    p.type = (vv_dsp_subband_type)7;
+    p.num_bands = 8;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_subband_create(NULL, &fb) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_subband_create(&p, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    p.type = VV_DSP_SUBBAND_DFT;
+    ok = ok && vv_dsp_subband_create(&p, &fb) == VV_DSP_OK;
+    if (!ok) return 0;
+    vv_dsp_real x[16] = {0};
+    vv_dsp_cpx frames[5 * 4];
+    size_t got = 99;
+    ok = vv_dsp_subband_frame_size(fb) == 5 && vv_dsp_subband_decimation(fb) == 4 &&
+         vv_dsp_subband_latency(fb) == 60 && vv_dsp_subband_analysis_count(fb, 16) == 4 &&
+         vv_dsp_subband_analyze(fb, x, 16, frames, 3, &got) == VV_DSP_ERROR_INVALID_SIZE && got == 0 &&
+         vv_dsp_subband_analysis_count(fb, 16) == 4 &&
+         vv_dsp_subband_analyze(fb, x, 3, NULL, 0, &got) == VV_DSP_OK && got == 0 &&
+         vv_dsp_subband_analyze(fb, NULL, 3, frames, 4, &got) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_subband_analyze(fb, x, 1, NULL, 1, &got) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_subband_synthesize(fb, NULL, 1, x) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_subband_synthesize(fb, frames, 0, NULL) == VV_DSP_OK &&
+         vv_dsp_subband_reset(NULL) == VV_DSP_ERROR_NULL_POINTER && vv_dsp_subband_frame_size(NULL) == 0;
+    vv_dsp_subband_destroy(fb);
+    vv_dsp_subband_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_reconstruction()) { fprintf(stderr, "subband reconstruction test failed\n"); rc = 1; }
+    if (!test_band_isolation()) { fprintf(stderr, "subband band isolation test failed\n"); rc = 1; }
+    if (!test_reset()) { fprintf(stderr, "subband reset test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "subband error test failed\n"); rc = 1; }
+    if (rc == 0) printf("subband tests passed\n");
+    return rc;
+}
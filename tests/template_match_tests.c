@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#ifdef VV_DSP_USE_DOUBLE
+#define SCORE_TOL 1e-9
+#else
+#define SCORE_TOL 2e-3
+#endif
+
+static double frand(unsigned int* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(*seed >> 8) / 8388608.0 - 1.0;
+}
+
+// Reference NCC at offset k in double
+static double ncc_ref(const vv_dsp_real* t, size_t L, const vv_dsp_real* x) {
+    double mt = 0.0, mx = 0.0;
+    for (size_t i = 0; i < L; ++i) {
+        mt += (double)t[i];
+        mx += (double)x[i];
+    }
+    mt /= (double)L;
+    mx /= (double)L;
+    double num = 0.0, et = 0.0, ex = 0.0;
+    for (size_t i = 0; i < L; ++i) {
+        const double a = (double)t[i] - mt, b = (double)x[i] - mx;
+        num += a * b;
+        et += a * a;
+        ex += b * b;
+    }
+    return (ex > 0.0) ? num / sqrt(et * ex) : 0.0;
+}
+
+// Both paths give the reference NCC curve, across block edges and for templates of
+// different lengths sharing one FFT block size
+static int check_scores(vv_dsp_template_method method, size_t fft_size) {
+    const size_t n = 3000, lens[3] = {20, 100, 257};
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real* t = (vv_dsp_real*)malloc(3 * 257 * sizeof(vv_dsp_real));
+    vv_dsp_real* sc = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    unsigned int seed = 4u;
+    // slowly varying gain and DC so the window normalization matters
+    for (size_t i = 0; x && i < n; ++i) x[i] = (vv_dsp_real)((1.0 + 0.5 * sin((double)i * 0.003)) * frand(&seed) + 2.0);
+    for (size_t i = 0; t && i < 3 * 257; ++i) t[i] = (vv_dsp_real)frand(&seed);
+    vv_dsp_template_match_params p = {3, 257, 1, 0, fft_size, method};
+    vv_dsp_template_matcher* m = NULL;
+    int ok = x && t && sc && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_OK;
+    // template 1 is a slice of the signal: its curve reaches 1 there
+    if (ok) memcpy(t + 257, x + 1234, 100 * sizeof(vv_dsp_real));
+    for (size_t j = 0; ok && j < 3; ++j) ok = vv_dsp_template_matcher_set(m, j, t + j * 257, lens[j]) == VV_DSP_OK;
+    for (size_t j = 0; ok && j < 3; ++j) {
+        const size_t L = lens[j];
+        ok = vv_dsp_template_matcher_scores(m, j, x, n, sc) == VV_DSP_OK;
+        double err = 0.0;
+        for (size_t k = 0; ok && k + L <= n; ++k) err = fmax(err, fabs((double)sc[k] - ncc_ref(t + j * 257, L, x + k)));
+        if (err > SCORE_TOL) {
+            fprintf(stderr, "method %d fft %zu template %zu: max score error %g\n", (int)method, fft_size, j, err);
+            ok = 0;
+        }
+    }
+    ok = ok && vv_dsp_template_matcher_scores(m, 1, x, n, sc) == VV_DSP_OK && sc[1234] > (vv_dsp_real)0.999;
+    vv_dsp_template_matcher_destroy(m);
+    free(x);
+    free(t);
+    free(sc);
+    return ok;
+}
+
+static int test_scores(void) {
+    return check_scores(VV_DSP_TEMPLATE_DIRECT, 0) && check_scores(VV_DSP_TEMPLATE_FFT, 0) &&
+           check_scores(VV_DSP_TEMPLATE_FFT, 300) && check_scores(VV_DSP_TEMPLATE_AUTO, 0);
+}
+
+// Takes embedded with new gain, offset and noise are found at their exact offsets,
+// best first and separated; a region of digital silence does not produce matches
+static int check_align(vv_dsp_template_method method) {
+    const size_t n = 20000, L0 = 400, L1 = 24;
+    const size_t at0[3] = {2500, 9000, 15321}, at1 = 7777;
+    vv_dsp_real* x = (vv_dsp_real*)malloc(n * sizeof(vv_dsp_real));
+    vv_dsp_real t0[400], t1[24];
+    unsigned int seed = 17u;
+    for (size_t i = 0; i < L0; ++i) t0[i] = (vv_dsp_real)(sin(0.05 * (double)i * (1.0 + 0.002 * (double)i)) + 0.3 * frand(&seed));
+    for (size_t i = 0; i < L1; ++i) t1[i] = (vv_dsp_real)frand(&seed);
+    for (size_t i = 0; x && i < n; ++i) x[i] = (vv_dsp_real)(0.3 * frand(&seed));
+    for (size_t i = 12000; x && i < 13000; ++i) x[i] = 0;
+    const double gain[3] = {0.8, 2.0, 0.3};
+    for (size_t r = 0; x && r < 3; ++r) {
+        for (size_t i = 0; i < L0; ++i) x[at0[r] + i] = (vv_dsp_real)(gain[r] * (double)t0[i] + 0.5 + 0.02 * frand(&seed));
+    }
+    for (size_t i = 0; x && i < L1; ++i) x[at1 + i] = (vv_dsp_real)(-1.5 * (double)t1[i]);  // inverted
+    vv_dsp_template_match_params p = {2, 400, 3, 0, 0, method};
+    vv_dsp_template_matcher* m = NULL;
+    vv_dsp_template_match res[6];
+    size_t cnt[2] = {0, 0};
+    int ok = x && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_OK &&
+             vv_dsp_template_matcher_set(m, 0, t0, L0) == VV_DSP_OK &&
+             vv_dsp_template_matcher_set(m, 1, t1, L1) == VV_DSP_OK &&
+             vv_dsp_template_matcher_match(m, x, n, res, cnt) == VV_DSP_OK && cnt[0] == 3 && cnt[1] == 3;
+    // template 0: all three takes; best first
+    for (size_t r = 0; ok && r < 3; ++r) {
+        int found = 0;
+        for (size_t i = 0; i < 3; ++i) found |= res[i].offset == at0[r];
+        ok = found && res[r].score > (vv_dsp_real)0.9 && (r == 0 || res[r].score <= res[r - 1].score);
+    }
+    // template 1 is inverted in the signal: its best positive match is elsewhere, and
+    // matching the negated template finds it with score 1
+    for (size_t i = 0; ok && i < L1; ++i) t1[i] = -t1[i];
+    ok = ok && vv_dsp_template_matcher_set(m, 1, t1, L1) == VV_DSP_OK &&
+         vv_dsp_template_matcher_match(m, x, n, res, NULL) == VV_DSP_OK && res[3].offset == at1 &&
+         res[3].score > (vv_dsp_real)0.999;
+    for (size_t i = 0; ok && i < 3; ++i) {
+        for (size_t k = i + 1; k < 3; ++k) {
+            const size_t a = res[3 + i].offset, b = res[3 + k].offset;
+            ok = ok && (a > b ? a - b : b - a) >= L1 / 2;
+        }
+    }
+    // short signals: fewer offsets than top_k, or none at all
+    ok = ok && vv_dsp_template_matcher_match(m, x + at1, L1 + 1, res, cnt) == VV_DSP_OK && cnt[0] == 0 &&
+         cnt[1] == 1 && res[3].offset == 0;
+    vv_dsp_template_matcher_destroy(m);
+    free(x);
+    return ok;
+}
+
+static int test_align(void) {
+    return check_align(VV_DSP_TEMPLATE_AUTO) && check_align(VV_DSP_TEMPLATE_DIRECT);
+}
+
+static int test_errors(void) {
+    vv_dsp_template_match_params p = {0, 10, 1, 0, 0, VV_DSP_TEMPLATE_AUTO};
+    vv_dsp_template_matcher* m = (vv_dsp_template_matcher*)1;
+    int ok = vv_dsp_template_matcher_create(&p, &m) == VV_DSP_ERROR_INVALID_SIZE && m == NULL;
+    p.num_templates = 2;
+    p.top_k = 0;
+    ok = ok && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_ERROR_INVALID_SIZE;
+    p.top_k = 1;
+    p.fft_size = 10;
+    ok = ok && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_ERROR_INVALID_SIZE;
+    p.fft_size = 0;
+    p.method = (vv_dsp_template_method)5;
+    ok = ok && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_template_matcher_create(NULL, &m) == VV_DSP_ERROR_NULL_POINTER;
+    p.method = VV_DSP_TEMPLATE_FFT;
+    ok = ok && vv_dsp_template_matcher_create(&p, &m) == VV_DSP_OK;
+    if (!ok) return 0;
+    vv_dsp_real t[11] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, flat[4] = {1, 1, 1, 1}, sc[11];
+    vv_dsp_template_match res[2];
+    ok = vv_dsp_template_matcher_set(m, 0, t, 11) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_template_matcher_set(m, 0, t, 0) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_template_matcher_set(m, 2, t, 5) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_template_matcher_set(m, 0, flat, 4) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_template_matcher_scores(m, 0, t, 11, sc) == VV_DSP_ERROR_OUT_OF_RANGE &&
+         vv_dsp_template_matcher_set(m, 0, t, 10) == VV_DSP_OK &&
+         vv_dsp_template_matcher_scores(m, 0, t, 9, sc) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_template_matcher_match(m, NULL, 5, res, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_template_matcher_match(m, t, 11, NULL, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_template_matcher_scores(m, 0, t, 11, sc) == VV_DSP_OK && sc[0] > (vv_dsp_real)0.999;
+    vv_dsp_template_matcher_destroy(m);
+    vv_dsp_template_matcher_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int rc = 0;
+    if (!test_scores()) { fprintf(stderr, "template match score test failed\n"); rc = 1; }
+    if (!test_align()) { fprintf(stderr, "template match alignment test failed\n"); rc = 1; }
+    if (!test_errors()) { fprintf(stderr, "template match error test failed\n"); rc = 1; }
+    if (rc == 0) printf("template match tests passed\n");
+    return rc;
+}
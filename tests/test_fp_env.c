@@ -4,6 +4,8 @@
  */
 
 #include "vv_dsp/core/fp_env.h"
+#include "vv_dsp/core/context.h"
+#include "vv_dsp/filter/iir.h"
 #include "vv_dsp/vv_dsp_types.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -245,6 +247,68 @@ void test_legacy_compatibility(void) {
     printf("Legacy compatibility verified\n");
 }
 
+/**
+ * @brief Test scoped denormal handling and the plans that use it
+ */
+void test_fp_scope(void) {
+    printf("\n=== Testing Denormal Scopes ===\n");
+
+    vv_dsp_set_flush_denormals(false);
+    vv_dsp_fp_scope outer, inner;
+    vv_dsp_fp_scope_enter(&outer, VV_DSP_DENORMALS_KEEP);
+    TEST_ASSERT(!outer.changed && !vv_dsp_get_flush_denormals_mode(), "KEEP scope leaves the mode alone");
+    vv_dsp_fp_scope_exit(&outer);
+
+    vv_dsp_fp_scope_enter(&outer, VV_DSP_DENORMALS_FLUSH);
+    vv_dsp_fp_scope_enter(&inner, VV_DSP_DENORMALS_FLUSH);
+#if HAVE_REGISTER_ACCESS
+    TEST_ASSERT(vv_dsp_get_flush_denormals_mode(), "FLUSH scope enables FTZ");
+    TEST_ASSERT(outer.changed && !inner.changed, "Nested FLUSH scope does not write the register again");
+#endif
+    vv_dsp_fp_scope_exit(&inner);
+    TEST_ASSERT(vv_dsp_get_flush_denormals_mode() == (bool)HAVE_REGISTER_ACCESS, "Inner exit keeps the outer mode");
+    vv_dsp_fp_scope_exit(&outer);
+    TEST_ASSERT(!vv_dsp_get_flush_denormals_mode(), "Outer exit restores the thread mode");
+
+    // A decaying one-pole tail (y = x + 0.5 y[n-1]) goes subnormal without a scope
+    // and reaches exactly zero with one; the thread mode is the same afterwards
+#ifdef VV_DSP_USE_DOUBLE
+    const vv_dsp_real real_min = DBL_MIN;
+#else
+    const vv_dsp_real real_min = FLT_MIN;
+#endif
+    enum { FRAMES = 1200 };
+    static vv_dsp_real x[FRAMES], y[FRAMES];
+    x[0] = 1;
+    vv_dsp_biquad_bank* bank = NULL;
+    int ok = vv_dsp_biquad_bank_create(1, 1, &bank) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_set_stage(bank, 0, 1, 0, 0, (vv_dsp_real)-0.5, 0) == VV_DSP_OK;
+    size_t subnormal[2] = {0, 0};
+    for (int m = 0; ok && m < 2; ++m) {
+        ok = vv_dsp_biquad_bank_reset(bank) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_set_denormals(bank, (vv_dsp_denormal_mode)m) == VV_DSP_OK &&
+             vv_dsp_biquad_bank_process(bank, x, y, FRAMES) == VV_DSP_OK;
+        for (size_t i = 0; i < FRAMES; ++i) subnormal[m] += y[i] != 0 && fabs((double)y[i]) < (double)real_min;
+    }
+    TEST_ASSERT(ok, "Biquad bank processes with either denormal mode");
+#if HAVE_REGISTER_ACCESS
+    TEST_ASSERT(subnormal[0] > 0 && subnormal[1] == 0, "FLUSH bank output never goes subnormal");
+#endif
+    TEST_ASSERT(!vv_dsp_get_flush_denormals_mode(), "Bank process leaves the thread mode unchanged");
+    TEST_ASSERT(vv_dsp_biquad_bank_set_denormals(bank, (vv_dsp_denormal_mode)2) == VV_DSP_ERROR_OUT_OF_RANGE,
+                "Unknown bank denormal mode rejected");
+    vv_dsp_biquad_bank_destroy(bank);
+
+    vv_dsp_context ctx;
+    vv_dsp_context_init(&ctx);
+    TEST_ASSERT(vv_dsp_context_denormals(&ctx) == VV_DSP_DENORMALS_KEEP, "Default context keeps denormals");
+    ctx.denormals = VV_DSP_DENORMALS_FLUSH;
+    TEST_ASSERT(vv_dsp_context_check(&ctx) == VV_DSP_OK && vv_dsp_context_denormals(&ctx) == VV_DSP_DENORMALS_FLUSH,
+                "Context carries FLUSH");
+    ctx.denormals = 7;
+    TEST_ASSERT(vv_dsp_context_check(&ctx) == VV_DSP_ERROR_OUT_OF_RANGE, "Context rejects unknown denormal mode");
+}
+
 int main(void) {
     printf("Starting FP Environment Control Tests\n");
     printf("Platform: ");
@@ -264,6 +328,7 @@ int main(void) {
     test_fp_env_api_state();
     test_denormal_behavior();
     test_legacy_compatibility();
+    test_fp_scope();
 
     printf("\n=== Test Summary ===\n");
     printf("Tests run: %d\n", test_count);
@@ -11,6 +11,15 @@
 
 #include "vv_dsp/core/simd_core.h"
 #include "vv_dsp/core/simd_utils.h"
+#include "vv_dsp/core/vv_dsp_vectorized_math.h"
+#include "vv_dsp/core/vmath.h"
+#include "vv_dsp/core/convert.h"
+#include "vv_dsp/spectral/fft.h"
+#include "vv_dsp/vv_dsp_math.h"
+
+/* Declared in core.h (implemented in the spectral module) */
+extern vv_dsp_status vv_dsp_autocorrelation(const vv_dsp_real* x, size_t n, vv_dsp_real* r, size_t r_len,
+                                            int biased);
 
 /* External declaration for simd features string */
 extern const char* vv_dsp_simd_features_string(void);
@@ -19,27 +28,28 @@ extern const char* vv_dsp_simd_features_string(void);
 #define TOLERANCE 1e-6f
 
 /* Helper function to generate test data */
-static void generate_test_data(float* data, size_t n) {
+static void generate_test_data(vv_dsp_real* data, size_t n) {
     srand(42); /* Fixed seed for reproducible tests */
     for (size_t i = 0; i < n; i++) {
-        data[i] = (float)(rand() % 1000) / 100.0f - 5.0f; /* Range: -5.0 to 5.0 */
+        data[i] = (vv_dsp_real)((float)(rand() % 1000) / 100.0f - 5.0f); /* Range: -5.0 to 5.0 */
     }
 }
 
 /* Helper function to compare floats with tolerance */
-static int float_equals(float a, float b, float tolerance) {
-    return fabsf(a - b) < tolerance;
+static int float_equals(vv_dsp_real a, vv_dsp_real b, vv_dsp_real tolerance) {
+    return fabs((double)(a - b)) < (double)tolerance;
 }
 
 /* Test element-wise addition */
 static int test_add_real_simd(void) {
     printf("Testing vv_dsp_add_real_simd...\n");
 
-    float* a = malloc(TEST_SIZE * sizeof(float));
-    float* b = malloc(TEST_SIZE * sizeof(float));
-    float* result = malloc(TEST_SIZE * sizeof(float));
-    float* expected = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* a = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* b = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* result = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* expected = malloc(TEST_SIZE * sizeof(vv_dsp_real));
 
+    int passed = 0;
     if (!a || !b || !result || !expected) {
         printf("Memory allocation failed\n");
         return 0;
@@ -62,11 +72,11 @@ static int test_add_real_simd(void) {
     }
 
     /* Compare results */
-    int passed = 1;
+    passed = 1;
     for (size_t i = 0; i < TEST_SIZE; i++) {
         if (!float_equals(result[i], expected[i], TOLERANCE)) {
             printf("  FAILED: Mismatch at index %zu: got %f, expected %f\n",
-                   i, result[i], expected[i]);
+                   i, (double)result[i], (double)expected[i]);
             passed = 0;
             break;
         }
@@ -88,11 +98,12 @@ cleanup:
 static int test_mul_real_simd(void) {
     printf("Testing vv_dsp_mul_real_simd...\n");
 
-    float* a = malloc(TEST_SIZE * sizeof(float));
-    float* b = malloc(TEST_SIZE * sizeof(float));
-    float* result = malloc(TEST_SIZE * sizeof(float));
-    float* expected = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* a = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* b = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* result = malloc(TEST_SIZE * sizeof(vv_dsp_real));
+    vv_dsp_real* expected = malloc(TEST_SIZE * sizeof(vv_dsp_real));
 
+    int passed = 0;
     if (!a || !b || !result || !expected) {
         printf("Memory allocation failed\n");
         return 0;
@@ -115,11 +126,11 @@ static int test_mul_real_simd(void) {
     }
 
     /* Compare results */
-    int passed = 1;
+    passed = 1;
     for (size_t i = 0; i < TEST_SIZE; i++) {
         if (!float_equals(result[i], expected[i], TOLERANCE)) {
             printf("  FAILED: Mismatch at index %zu: got %f, expected %f\n",
-                   i, result[i], expected[i]);
+                   i, (double)result[i], (double)expected[i]);
             passed = 0;
             break;
         }
@@ -141,7 +152,7 @@ cleanup:
 static int test_sum_optimized(void) {
     printf("Testing vv_dsp_sum_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -159,7 +170,7 @@ static int test_sum_optimized(void) {
     }
 
     /* Calculate SIMD result */
-    float result_sum;
+    vv_dsp_real result_sum;
     vv_dsp_status status = vv_dsp_sum_optimized(data, TEST_SIZE, &result_sum);
 
     if (status != VV_DSP_OK) {
@@ -169,12 +180,12 @@ static int test_sum_optimized(void) {
     }
 
     /* Compare results */
-    int passed = float_equals(result_sum, (float)expected_sum, TOLERANCE * 100); /* Increased tolerance for SIMD vs scalar differences */
+    int passed = float_equals(result_sum, (vv_dsp_real)expected_sum, TOLERANCE * 100); /* Increased tolerance for SIMD vs scalar differences */
 
     if (passed) {
-        printf("  PASSED (sum: %f)\n", result_sum);
+        printf("  PASSED (sum: %f)\n", (double)result_sum);
     } else {
-        printf("  FAILED: got %f, expected %f\n", result_sum, (float)expected_sum);
+        printf("  FAILED: got %f, expected %f\n", (double)result_sum, expected_sum);
     }
 
     free(data);
@@ -185,7 +196,7 @@ static int test_sum_optimized(void) {
 static int test_rms_optimized(void) {
     printf("Testing vv_dsp_rms_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -199,10 +210,10 @@ static int test_rms_optimized(void) {
         double v = (double)data[i];
         acc += v * v;
     }
-    float expected_rms = (float)sqrt(acc / (double)TEST_SIZE);
+    vv_dsp_real expected_rms = (vv_dsp_real)sqrt(acc / (double)TEST_SIZE);
 
     /* Calculate SIMD result */
-    float result_rms;
+    vv_dsp_real result_rms;
     vv_dsp_status status = vv_dsp_rms_optimized(data, TEST_SIZE, &result_rms);
 
     if (status != VV_DSP_OK) {
@@ -215,9 +226,9 @@ static int test_rms_optimized(void) {
     int passed = float_equals(result_rms, expected_rms, TOLERANCE * 10);
 
     if (passed) {
-        printf("  PASSED (RMS: %f)\n", result_rms);
+        printf("  PASSED (RMS: %f)\n", (double)result_rms);
     } else {
-        printf("  FAILED: got %f, expected %f\n", result_rms, expected_rms);
+        printf("  FAILED: got %f, expected %f\n", (double)result_rms, (double)expected_rms);
     }
 
     free(data);
@@ -228,7 +239,7 @@ static int test_rms_optimized(void) {
 static int test_peak_optimized(void) {
     printf("Testing vv_dsp_peak_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -237,15 +248,15 @@ static int test_peak_optimized(void) {
     generate_test_data(data, TEST_SIZE);
 
     /* Calculate expected result (scalar) */
-    float expected_min = data[0];
-    float expected_max = data[0];
+    vv_dsp_real expected_min = data[0];
+    vv_dsp_real expected_max = data[0];
     for (size_t i = 1; i < TEST_SIZE; i++) {
         if (data[i] < expected_min) expected_min = data[i];
         if (data[i] > expected_max) expected_max = data[i];
     }
 
     /* Calculate SIMD result */
-    float result_min, result_max;
+    vv_dsp_real result_min, result_max;
     vv_dsp_status status = vv_dsp_peak_optimized(data, TEST_SIZE, &result_min, &result_max);
 
     if (status != VV_DSP_OK) {
@@ -259,10 +270,10 @@ static int test_peak_optimized(void) {
                  float_equals(result_max, expected_max, TOLERANCE);
 
     if (passed) {
-        printf("  PASSED (min: %f, max: %f)\n", result_min, result_max);
+        printf("  PASSED (min: %f, max: %f)\n", (double)result_min, (double)result_max);
     } else {
         printf("  FAILED: got min=%f max=%f, expected min=%f max=%f\n",
-               result_min, result_max, expected_min, expected_max);
+               (double)result_min, (double)result_max, (double)expected_min, (double)expected_max);
     }
 
     free(data);
@@ -273,7 +284,7 @@ static int test_peak_optimized(void) {
 static int test_mean_optimized(void) {
     printf("Testing vv_dsp_mean_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -286,10 +297,10 @@ static int test_mean_optimized(void) {
     for (size_t i = 0; i < TEST_SIZE; i++) {
         expected_sum += (double)data[i];
     }
-    float expected_mean = (float)(expected_sum / (double)TEST_SIZE);
+    vv_dsp_real expected_mean = (vv_dsp_real)(expected_sum / (double)TEST_SIZE);
 
     /* Calculate SIMD result */
-    float result_mean;
+    vv_dsp_real result_mean;
     vv_dsp_status status = vv_dsp_mean_optimized(data, TEST_SIZE, &result_mean);
 
     if (status != VV_DSP_OK) {
@@ -302,9 +313,9 @@ static int test_mean_optimized(void) {
     int passed = float_equals(result_mean, expected_mean, TOLERANCE * 100); /* Increased tolerance for SIMD vs scalar differences */
 
     if (passed) {
-        printf("  PASSED (mean: %f)\n", result_mean);
+        printf("  PASSED (mean: %f)\n", (double)result_mean);
     } else {
-        printf("  FAILED: got %f, expected %f\n", result_mean, expected_mean);
+        printf("  FAILED: got %f, expected %f\n", (double)result_mean, (double)expected_mean);
     }
 
     free(data);
@@ -315,7 +326,7 @@ static int test_mean_optimized(void) {
 static int test_variance_optimized(void) {
     printf("Testing vv_dsp_variance_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -335,10 +346,10 @@ static int test_variance_optimized(void) {
         double diff = (double)data[i] - mean;
         var_sum += diff * diff;
     }
-    float expected_variance = (float)(var_sum / (double)(TEST_SIZE - 1)); /* unbiased */
+    vv_dsp_real expected_variance = (vv_dsp_real)(var_sum / (double)(TEST_SIZE - 1)); /* unbiased */
 
     /* Calculate SIMD result */
-    float result_variance;
+    vv_dsp_real result_variance;
     vv_dsp_status status = vv_dsp_variance_optimized(data, TEST_SIZE, &result_variance);
 
     if (status != VV_DSP_OK) {
@@ -351,9 +362,9 @@ static int test_variance_optimized(void) {
     int passed = float_equals(result_variance, expected_variance, TOLERANCE * 100); /* Larger tolerance for variance */
 
     if (passed) {
-        printf("  PASSED (variance: %f)\n", result_variance);
+        printf("  PASSED (variance: %f)\n", (double)result_variance);
     } else {
-        printf("  FAILED: got %f, expected %f\n", result_variance, expected_variance);
+        printf("  FAILED: got %f, expected %f\n", (double)result_variance, (double)expected_variance);
     }
 
     free(data);
@@ -364,7 +375,7 @@ static int test_variance_optimized(void) {
 static int test_stddev_optimized(void) {
     printf("Testing vv_dsp_stddev_optimized...\n");
 
-    float* data = malloc(TEST_SIZE * sizeof(float));
+    vv_dsp_real* data = malloc(TEST_SIZE * sizeof(vv_dsp_real));
     if (!data) {
         printf("Memory allocation failed\n");
         return 0;
@@ -385,10 +396,10 @@ static int test_stddev_optimized(void) {
         var_sum += diff * diff;
     }
     double variance = var_sum / (double)(TEST_SIZE - 1); /* unbiased */
-    float expected_stddev = (float)sqrt(variance);
+    vv_dsp_real expected_stddev = (vv_dsp_real)sqrt(variance);
 
     /* Calculate SIMD result */
-    float result_stddev;
+    vv_dsp_real result_stddev;
     vv_dsp_status status = vv_dsp_stddev_optimized(data, TEST_SIZE, &result_stddev);
 
     if (status != VV_DSP_OK) {
@@ -401,9 +412,9 @@ static int test_stddev_optimized(void) {
     int passed = float_equals(result_stddev, expected_stddev, TOLERANCE * 100);
 
     if (passed) {
-        printf("  PASSED (stddev: %f)\n", result_stddev);
+        printf("  PASSED (stddev: %f)\n", (double)result_stddev);
     } else {
-        printf("  FAILED: got %f, expected %f\n", result_stddev, expected_stddev);
+        printf("  FAILED: got %f, expected %f\n", (double)result_stddev, (double)expected_stddev);
     }
 
     free(data);
@@ -415,9 +426,9 @@ static void benchmark_simd_functions(void) {
     const size_t bench_size = 100000;
     const int iterations = 1000;
 
-    float* a = malloc(bench_size * sizeof(float));
-    float* b = malloc(bench_size * sizeof(float));
-    float* result = malloc(bench_size * sizeof(float));
+    vv_dsp_real* a = malloc(bench_size * sizeof(vv_dsp_real));
+    vv_dsp_real* b = malloc(bench_size * sizeof(vv_dsp_real));
+    vv_dsp_real* result = malloc(bench_size * sizeof(vv_dsp_real));
 
     if (!a || !b || !result) {
         printf("Memory allocation failed for benchmark\n");
@@ -455,6 +466,363 @@ static void benchmark_simd_functions(void) {
     free(result);
 }
 
+/* Every dispatch level the host runs must reproduce the baseline bits (complex product: to rounding) */
+static int test_dispatch_levels(void) {
+    printf("Testing runtime dispatch levels (active: %s)...\n", vv_dsp_simd_get_features());
+
+    enum { N = 1003 };
+    static vv_dsp_real a[N], b[N], ref_add[N], ref_mul[N], ref_log[N], ref_exp[N], ref_trig[3][N], ref_tier[3][N];
+    static vv_dsp_real out_add[N], out_mul[N], out_log[N], out_exp[N], out_trig[3][N], out_tier[3][N];
+    static vv_dsp_cpx ca[N / 2], cb[N / 2], ref_cpx[N / 2], out_cpx[N / 2];
+    generate_test_data(a, N);
+    for (size_t i = 0; i < N; i++) b[i] = (vv_dsp_real)(fabsf((float)a[i]) + 1e-3f);
+    memcpy(ca, a, sizeof(ca));
+    memcpy(cb, b, sizeof(cb));
+
+    const vv_dsp_simd_level detected = vv_dsp_simd_detect_level();
+    if (vv_dsp_simd_get_level() != detected) {
+        printf("  FAILED: active level %d, detected %d\n", (int)vv_dsp_simd_get_level(), (int)detected);
+        return 0;
+    }
+    if (vv_dsp_simd_set_level((vv_dsp_simd_level)99) != VV_DSP_ERROR_UNSUPPORTED) {
+        printf("  FAILED: unknown level accepted\n");
+        return 0;
+    }
+
+    int have_ref = 0, ok = 1;
+    vv_dsp_real ref_sum = 0, ref_rms = 0;
+    for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; lvl++) {
+        if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+        vv_dsp_real sum = 0, rms = 0;
+        ok = vv_dsp_add_real_simd(a, b, out_add, N) == VV_DSP_OK &&
+             vv_dsp_mul_real_simd(a, b, out_mul, N) == VV_DSP_OK &&
+             vv_dsp_sum_optimized(a, N, &sum) == VV_DSP_OK &&
+             vv_dsp_rms_optimized(a, N, &rms) == VV_DSP_OK &&
+             vv_dsp_log_real_fast(b, out_log, N) == VV_DSP_OK &&
+             vv_dsp_exp_real_fast(a, out_exp, N) == VV_DSP_OK &&
+             vv_dsp_vectorized_complex_multiply(ca, cb, out_cpx, N / 2) == VV_DSP_OK;
+        for (int f = 0; f < 3 && ok; f++) ok = vv_dsp_vectorized_trig_apply(a, out_trig[f], N, f) == VV_DSP_OK;
+        ok = ok && vv_dsp_vatan2(a, b, out_tier[0], N, VV_DSP_VMATH_MEDIUM) == VV_DSP_OK &&
+             vv_dsp_vatan2(b, a, out_tier[1], N, VV_DSP_VMATH_FAST) == VV_DSP_OK &&
+             vv_dsp_vsin(a, out_tier[2], N, VV_DSP_VMATH_FAST) == VV_DSP_OK;
+        if (!ok) break;
+        if (!have_ref) {
+            memcpy(ref_add, out_add, sizeof(ref_add));
+            memcpy(ref_mul, out_mul, sizeof(ref_mul));
+            memcpy(ref_log, out_log, sizeof(ref_log));
+            memcpy(ref_exp, out_exp, sizeof(ref_exp));
+            memcpy(ref_cpx, out_cpx, sizeof(ref_cpx));
+            memcpy(ref_trig, out_trig, sizeof(ref_trig));
+            memcpy(ref_tier, out_tier, sizeof(ref_tier));
+            ref_sum = sum;
+            ref_rms = rms;
+            have_ref = 1;
+            continue;
+        }
+        ok = memcmp(ref_add, out_add, sizeof(ref_add)) == 0 && memcmp(ref_mul, out_mul, sizeof(ref_mul)) == 0 &&
+             memcmp(ref_log, out_log, sizeof(ref_log)) == 0 && memcmp(ref_exp, out_exp, sizeof(ref_exp)) == 0 &&
+             memcmp(&ref_sum, &sum, sizeof(sum)) == 0 && memcmp(&ref_rms, &rms, sizeof(rms)) == 0 &&
+             memcmp(ref_trig, out_trig, sizeof(ref_trig)) == 0 && memcmp(ref_tier, out_tier, sizeof(ref_tier)) == 0;
+        /* the complex product may be fused at the AVX levels */
+        for (size_t i = 0; i < N / 2 && ok; i++) {
+            ok = float_equals(ref_cpx[i].re, out_cpx[i].re, 1e-5f) && float_equals(ref_cpx[i].im, out_cpx[i].im, 1e-5f);
+        }
+        if (!ok) printf("  FAILED: level %d differs from the baseline\n", lvl);
+        else printf("  level %d (%s) matches\n", lvl, vv_dsp_simd_get_features());
+    }
+    if (vv_dsp_simd_set_level(detected) != VV_DSP_OK) ok = 0;
+    if (ok && have_ref) printf("  PASSED\n");
+    return ok && have_ref;
+}
+
+/* Scalar reference decode of one little-endian sample */
+static vv_dsp_real convert_ref_load(const unsigned char* p, vv_dsp_sample_format format) {
+    if (format == VV_DSP_SAMPLE_F32) {
+        float f;
+        memcpy(&f, p, 4);
+        return (vv_dsp_real)f;
+    }
+    const size_t w = vv_dsp_sample_format_bytes(format);
+    uint32_t u = 0;
+    for (size_t k = 0; k < w; k++) u |= (uint32_t)p[k] << (8 * (k + 4 - w));
+    /* sample in the top bits, so the int32 value is v * 2^(32 - 8w) */
+    return (vv_dsp_real)((int32_t)u >> (32 - 8 * w)) * (vv_dsp_real)(1.0 / (double)(1ul << (8 * w - 1)));
+}
+
+/* Scalar reference encode of one sample, little-endian */
+static void convert_ref_store(unsigned char* p, vv_dsp_real x, vv_dsp_sample_format format) {
+    vv_dsp_real c = x;
+    if (isnan(c)) c = signbit(c) ? (vv_dsp_real)-1 : (vv_dsp_real)1;
+    c = c > 1 ? 1 : (c < -1 ? -1 : c);
+    int32_t v;
+    if (format == VV_DSP_SAMPLE_F32) {
+        const float f = (float)x;
+        memcpy(p, &f, 4);
+        return;
+    }
+    if (format == VV_DSP_SAMPLE_S16) v = (int32_t)(c * (vv_dsp_real)32767.0);
+    else if (format == VV_DSP_SAMPLE_S24) v = (int32_t)(c * (vv_dsp_real)8388607.0);
+    else v = (int32_t)((double)c * 2147483647.0);
+    const size_t w = vv_dsp_sample_format_bytes(format);
+    for (size_t k = 0; k < w; k++) p[k] = (unsigned char)((uint32_t)v >> (8 * k));
+}
+
+/* Sample conversion at every level: bit-exact against a scalar reference for
+   every format, 1-3 channels, unaligned buffers and out-of-range / NaN input */
+/* PAIRWISE / COMPENSATED: the same bits for every thread count and SIMD level */
+static int test_reproducible_reductions(void) {
+    printf("Testing reproducible reduction modes...\n");
+    enum { N = 100003, LAGS = 2048 };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(N * sizeof(vv_dsp_real));
+    vv_dsp_real* r1 = (vv_dsp_real*)malloc(LAGS * sizeof(vv_dsp_real));
+    vv_dsp_real* r4 = (vv_dsp_real*)malloc(LAGS * sizeof(vv_dsp_real));
+    if (!x || !r1 || !r4) { free(x); free(r1); free(r4); return 0; }
+    double ref = 0.0, mag = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        x[i] = (vv_dsp_real)(1.0f + 0.25f * sinf(0.001f * (float)i) + 1e-3f * (float)(i % 97));
+        ref += (double)x[i];
+        mag += fabs((double)x[i]);
+    }
+
+    int ok = vv_dsp_get_reduction_mode() == VV_DSP_REDUCTION_FAST &&
+             vv_dsp_set_reduction_mode((vv_dsp_reduction_mode)7) == VV_DSP_ERROR_OUT_OF_RANGE;
+    const vv_dsp_simd_level saved_level = vv_dsp_simd_get_level();
+    for (int mode = VV_DSP_REDUCTION_PAIRWISE; mode <= VV_DSP_REDUCTION_COMPENSATED && ok; mode++) {
+        ok = vv_dsp_set_reduction_mode((vv_dsp_reduction_mode)mode) == VV_DSP_OK;
+        vv_dsp_real sum = 0, var = 0, v = 0;
+        ok = ok && vv_dsp_sum_optimized(x, N, &sum) == VV_DSP_OK && vv_dsp_variance_optimized(x, N, &var) == VV_DSP_OK;
+        for (size_t t = 1; t <= 7 && ok; t += 2) {
+            ok = vv_dsp_sum_parallel(x, N, &v, t) == VV_DSP_OK && memcmp(&v, &sum, sizeof(v)) == 0 &&
+                 vv_dsp_variance_parallel(x, N, &v, t) == VV_DSP_OK && memcmp(&v, &var, sizeof(v)) == 0;
+        }
+        for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; lvl++) {
+            if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+            ok = vv_dsp_sum_parallel(x, N, &v, 3) == VV_DSP_OK && memcmp(&v, &sum, sizeof(v)) == 0;
+        }
+        (void)vv_dsp_simd_set_level(saved_level);
+        /* both stay within a few float ulps of the double sum */
+        const double tol = (mode == VV_DSP_REDUCTION_COMPENSATED ? 1e-7 : 1e-6) * mag;
+        ok = ok && fabs((double)sum - ref) <= tol;
+        if (!ok) printf("  FAILED: mode %d sum %.9g ref %.9g\n", mode, (double)sum, ref);
+    }
+
+    /* correlation transforms ignore the FFT thread count */
+    ok = ok && vv_dsp_set_reduction_mode(VV_DSP_REDUCTION_PAIRWISE) == VV_DSP_OK &&
+         vv_dsp_autocorrelation(x, N, r1, LAGS, 0) == VV_DSP_OK && vv_dsp_fft_set_num_threads(4) == VV_DSP_OK &&
+         vv_dsp_autocorrelation(x, N, r4, LAGS, 0) == VV_DSP_OK && memcmp(r1, r4, LAGS * sizeof(vv_dsp_real)) == 0;
+    if (vv_dsp_fft_set_num_threads(1) != VV_DSP_OK || vv_dsp_set_reduction_mode(VV_DSP_REDUCTION_FAST) != VV_DSP_OK) {
+        ok = 0;
+    }
+    free(x);
+    free(r1);
+    free(r4);
+    printf(ok ? "  PASSED\n" : "  FAILED\n");
+    return ok;
+}
+
+static int test_convert(void) {
+    printf("Testing sample format conversion...\n");
+
+    enum { FRAMES = 517, MAXCH = 3 };
+    static vv_dsp_real x[MAXCH][FRAMES], dec[MAXCH][FRAMES], flat[MAXCH * FRAMES];
+    static unsigned char ref[MAXCH * FRAMES * 4], raw[MAXCH * FRAMES * 4 + 1];
+    for (int ch = 0; ch < MAXCH; ch++) {
+        for (size_t i = 0; i < FRAMES; i++) x[ch][i] = (vv_dsp_real)(1.2 * sin(0.013 * (double)(i * (size_t)(ch + 1))));
+    }
+    x[0][3] = (vv_dsp_real)NAN;
+    x[1][5] = (vv_dsp_real)-NAN;
+    x[0][7] = (vv_dsp_real)1e30;
+    x[1][9] = (vv_dsp_real)-INFINITY;
+
+    const vv_dsp_simd_level detected = vv_dsp_simd_get_level();
+    int ok = 1;
+    for (int lvl = VV_DSP_SIMD_LEVEL_SCALAR; lvl <= VV_DSP_SIMD_LEVEL_AVX512 && ok; lvl++) {
+        if (vv_dsp_simd_set_level((vv_dsp_simd_level)lvl) != VV_DSP_OK) continue;
+        for (int f = VV_DSP_SAMPLE_S16; f <= VV_DSP_SAMPLE_F32 && ok; f++) {
+            const vv_dsp_sample_format format = (vv_dsp_sample_format)f;
+            const size_t w = vv_dsp_sample_format_bytes(format);
+            for (size_t channels = 1; channels <= MAXCH && ok; channels++) {
+                const vv_dsp_real* in[MAXCH] = { x[0], x[1], x[2] };
+                vv_dsp_real* out[MAXCH] = { dec[0], dec[1], dec[2] };
+                for (size_t i = 0; i < FRAMES; i++) {
+                    for (size_t ch = 0; ch < channels; ch++) convert_ref_store(ref + (i * channels + ch) * w, x[ch][i], format);
+                }
+                /* raw + 1: deliberately misaligned */
+                ok = vv_dsp_convert_interleave(in, channels, FRAMES, format, raw + 1) == VV_DSP_OK &&
+                     memcmp(raw + 1, ref, FRAMES * channels * w) == 0;
+                ok = ok && vv_dsp_convert_deinterleave(raw + 1, format, channels, FRAMES, out) == VV_DSP_OK &&
+                     vv_dsp_convert_to_real(raw + 1, format, FRAMES * channels, flat) == VV_DSP_OK;
+                for (size_t i = 0; i < FRAMES && ok; i++) {
+                    for (size_t ch = 0; ch < channels && ok; ch++) {
+                        const vv_dsp_real r = convert_ref_load(ref + (i * channels + ch) * w, format);
+                        ok = memcmp(&r, &dec[ch][i], sizeof(r)) == 0 && memcmp(&r, &flat[i * channels + ch], sizeof(r)) == 0;
+                    }
+                }
+                if (channels == 1) {
+                    ok = ok && vv_dsp_convert_from_real(x[0], FRAMES, format, raw + 1) == VV_DSP_OK &&
+                         memcmp(raw + 1, ref, FRAMES * w) == 0;
+                }
+                if (!ok) printf("  FAILED: level %d, format %d, %zu channels\n", lvl, f, channels);
+            }
+        }
+    }
+    if (vv_dsp_simd_set_level(detected) != VV_DSP_OK) ok = 0;
+
+    /* Error handling */
+    vv_dsp_real* none[1] = { NULL };
+    ok = ok && vv_dsp_convert_to_real(raw, (vv_dsp_sample_format)7, 1, flat) == VV_DSP_ERROR_UNSUPPORTED &&
+         vv_dsp_convert_deinterleave(raw, VV_DSP_SAMPLE_S16, 0, 1, none) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_convert_deinterleave(raw, VV_DSP_SAMPLE_S16, 1, 1, none) == VV_DSP_ERROR_NULL_POINTER &&
+         vv_dsp_convert_from_real(NULL, 0, VV_DSP_SAMPLE_S24, NULL) == VV_DSP_OK &&
+         vv_dsp_sample_format_bytes(VV_DSP_SAMPLE_S24) == 3;
+    if (ok) printf("  PASSED\n");
+    return ok;
+}
+
+/* Vectorized sin/cos/tan against double libm, including the libm fallback range */
+static int test_vectorized_trig(void) {
+    printf("Testing vv_dsp_vectorized_trig_apply...\n");
+
+    enum { N = 4096 };
+    static vv_dsp_real x[N], y[N];
+    for (size_t i = 0; i < N; i++) x[i] = (vv_dsp_real)(((float)i - N / 2) * 2.4414f);  /* about +-5000 */
+    x[0] = 1e6f;
+    x[1] = -3.5e4f;
+    x[2] = 0.0f;
+    x[3] = -0.0f;
+    x[4] = 1e-20f;
+
+    const double max_ulp[3] = {2.0, 2.0, 4.0};
+    for (int f = 0; f < 3; f++) {
+        /* in place, so the libm fallback has to work from its own copy of the input */
+        vv_dsp_real* buf = y;
+        memcpy(buf, x, sizeof(x));
+        if (vv_dsp_vectorized_trig_apply(buf, buf, N, f) != VV_DSP_OK) {
+            printf("  FAILED: function %d returned error status\n", f);
+            return 0;
+        }
+        for (size_t i = 0; i < N; i++) {
+            const double ref = f == 0 ? sin((double)x[i]) : f == 1 ? cos((double)x[i]) : tan((double)x[i]);
+            const float fr = (float)ref;
+            const double ulp = (double)nextafterf(fabsf(fr), INFINITY) - (double)fabsf(fr);
+            const double err = fabs((double)buf[i] - ref) / ulp;
+            if (!(err <= max_ulp[f]) || !signbit(buf[i]) != !signbit(fr)) {
+                printf("  FAILED: function %d at x=%g: %.9g vs %.9g (%.2f ulp)\n", f, (double)x[i],
+                       (double)buf[i], ref, err);
+                return 0;
+            }
+        }
+    }
+    vv_dsp_real nan_in = NAN, nan_out = 0.0f;
+    if (vv_dsp_vectorized_trig_apply(&nan_in, &nan_out, 1, 0) != VV_DSP_OK || !isnan(nan_out) ||
+        vv_dsp_vectorized_trig_apply(x, y, N, 3) != VV_DSP_ERROR_OUT_OF_RANGE) {
+        printf("  FAILED: NaN or bad function type\n");
+        return 0;
+    }
+    printf("  PASSED\n");
+    return 1;
+}
+
+/* Error of got against ref in float ulps of ref */
+static double ulp_error(vv_dsp_real got, double ref) {
+    const float fr = (float)ref;
+    return fabs((double)got - ref) / ((double)nextafterf(fabsf(fr), INFINITY) - (double)fabsf(fr));
+}
+
+/* vmath tiers against double libm: fast to its absolute / relative bound, medium to a few ulp, exact to libm */
+static int test_vmath_tiers(void) {
+    printf("Testing vmath accuracy tiers...\n");
+
+    enum { N = 4096 };
+    static vv_dsp_real x[N], y[N], s[N], c[N];
+    for (int tier = VV_DSP_VMATH_FAST; tier <= VV_DSP_VMATH_EXACT; tier++) {
+        const vv_dsp_vmath_tier t = (vv_dsp_vmath_tier)tier;
+        const int fast = t == VV_DSP_VMATH_FAST, exact = t == VV_DSP_VMATH_EXACT;
+
+        for (size_t i = 0; i < N; i++) x[i] = (vv_dsp_real)(((float)i - N / 2) * 0.0731f);  /* about +-150 */
+        if (vv_dsp_vsincos(x, s, c, N, t) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < N; i++) {
+            const double rs = sin((double)x[i]), rc = cos((double)x[i]);
+            const int bad = exact ? (s[i] != VV_DSP_SIN(x[i]) || c[i] != VV_DSP_COS(x[i]))
+                          : fast  ? (fabs((double)s[i] - rs) > 5e-5 || fabs((double)c[i] - rc) > 5e-5)
+                                  : (ulp_error(s[i], rs) > 2.0 || ulp_error(c[i], rc) > 2.0);
+            if (bad) {
+                printf("  FAILED: tier %d sincos(%g) = %g, %g\n", tier, (double)x[i], (double)s[i], (double)c[i]);
+                return 0;
+            }
+        }
+
+        for (size_t i = 0; i < N; i++) x[i] = (vv_dsp_real)(((float)i - N / 2) * 0.042f);  /* about +-86 */
+        if (vv_dsp_vexp(x, y, N, t) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < N; i++) {
+            const double r = exp((double)x[i]);
+            const double rel = fabs((double)y[i] - r) / r;
+            if (exact ? y[i] != VV_DSP_EXP(x[i]) : rel > (fast ? 6e-5 : 2.4e-7)) {
+                printf("  FAILED: tier %d exp(%g) = %g\n", tier, (double)x[i], (double)y[i]);
+                return 0;
+            }
+        }
+
+        for (size_t i = 0; i < N; i++) x[i] = (vv_dsp_real)expf(((float)i - N / 2) * 0.04f);
+        if (vv_dsp_vlog(x, y, N, t) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < N; i++) {
+            const double r = log((double)x[i]);
+            const double err = fabs((double)y[i] - r);
+            if (exact ? y[i] != VV_DSP_LOG(x[i]) : err > (fast ? 7e-5 : (fabs(r) + 1.0) * 6e-8)) {
+                printf("  FAILED: tier %d log(%g) = %g\n", tier, (double)x[i], (double)y[i]);
+                return 0;
+            }
+        }
+
+        /* every octant and magnitude ratio; x doubles as the output */
+        for (size_t i = 0; i < N; i++) {
+            const float ang = ((float)i / N) * 6.2831853f;
+            y[i] = (vv_dsp_real)(sinf(ang) * (float)(1 + i % 7));
+            s[i] = (vv_dsp_real)(cosf(ang) * 3.0f);
+        }
+        memcpy(x, s, sizeof(x));
+        if (vv_dsp_vatan2(y, x, x, N, t) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < N; i++) {
+            const double r = atan2((double)y[i], (double)s[i]);
+            if (exact ? x[i] != VV_DSP_ATAN2(y[i], s[i]) : fast ? fabs((double)x[i] - r) > 1.2e-5 : ulp_error(x[i], r) > 3.0) {
+                printf("  FAILED: tier %d atan2(%g, %g) = %g\n", tier, (double)y[i], (double)s[i], (double)x[i]);
+                return 0;
+            }
+        }
+
+        /* signed zeros and non-finite inputs follow C99 atan2 */
+        const vv_dsp_real zy[6] = {0.0f, -0.0f, 0.0f, -0.0f, 1.0f, INFINITY};
+        const vv_dsp_real zx[6] = {0.0f, 0.0f, -0.0f, -0.0f, -0.0f, INFINITY};
+        vv_dsp_real zo[6];
+        if (vv_dsp_vatan2(zy, zx, zo, 6, t) != VV_DSP_OK) return 0;
+        for (size_t i = 0; i < 6; i++) {
+            const vv_dsp_real r = VV_DSP_ATAN2(zy[i], zx[i]);
+            if (fabs((double)(zo[i] - r)) > 1e-6 || !signbit(zo[i]) != !signbit(r)) {
+                printf("  FAILED: tier %d atan2(%g, %g) = %g\n", tier, (double)zy[i], (double)zx[i], (double)zo[i]);
+                return 0;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < N; i++) x[i] = (vv_dsp_real)((float)i * 0.37f);
+    if (vv_dsp_vsqrt(x, y, N) != VV_DSP_OK) return 0;
+    for (size_t i = 0; i < N; i++) {
+        if (y[i] != VV_DSP_SQRT(x[i])) {
+            printf("  FAILED: sqrt(%g) = %g\n", (double)x[i], (double)y[i]);
+            return 0;
+        }
+    }
+
+    if (vv_dsp_vsin(x, NULL, N, VV_DSP_VMATH_FAST) != VV_DSP_ERROR_NULL_POINTER ||
+        vv_dsp_vsincos(x, s, NULL, N, VV_DSP_VMATH_FAST) != VV_DSP_ERROR_NULL_POINTER ||
+        vv_dsp_vexp(x, y, N, (vv_dsp_vmath_tier)3) != VV_DSP_ERROR_OUT_OF_RANGE) {
+        printf("  FAILED: bad arguments accepted\n");
+        return 0;
+    }
+    printf("  PASSED\n");
+    return 1;
+}
+
 int main(void) {
     printf("=== SIMD Core Functions Test ===\n");
     printf("Testing SIMD-optimized core functions\n");
@@ -472,6 +840,11 @@ int main(void) {
     total_tests++; passed_tests += test_mean_optimized();
     total_tests++; passed_tests += test_variance_optimized();
     total_tests++; passed_tests += test_stddev_optimized();
+    total_tests++; passed_tests += test_vectorized_trig();
+    total_tests++; passed_tests += test_vmath_tiers();
+    total_tests++; passed_tests += test_dispatch_levels();
+    total_tests++; passed_tests += test_convert();
+    total_tests++; passed_tests += test_reproducible_reductions();
 
     printf("\nTest Results: %d/%d passed\n", passed_tests, total_tests);
 
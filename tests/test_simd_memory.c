@@ -8,6 +8,17 @@
 #include <string.h>
 #include <assert.h>
 #include "vv_dsp/core/simd_utils.h"
+#ifndef _WIN32
+#include <pthread.h>
+
+/* Allocates and frees on its own thread; its cache is flushed on exit */
+static void* pool_thread(void* arg) {
+    (void)arg;
+    void* p = vv_dsp_aligned_malloc(3000, 32);
+    vv_dsp_aligned_free(p);
+    return NULL;
+}
+#endif
 
 int main(void) {
     printf("Testing SIMD Aligned Memory Allocation\n");
@@ -116,6 +127,47 @@ int main(void) {
         if (invalid_ptr) vv_dsp_aligned_free(invalid_ptr);
     }
 
+    /* Size-class pool: reuse, bounded retention, per-thread flush */
+    printf("Testing aligned pool... ");
+    total_tests++;
+    {
+        int ok = 1;
+        vv_dsp_aligned_pool_stats st0, st;
+        ok &= (vv_dsp_aligned_pool_enable(8192) == VV_DSP_OK);
+        ok &= (vv_dsp_aligned_pool_get_stats(&st0) == VV_DSP_OK);
+        void* a = vv_dsp_aligned_malloc(1000, 64);
+        vv_dsp_aligned_free(a);
+        void* b = vv_dsp_aligned_malloc(1024, 16); /* same 1 KiB class */
+        ok &= (a == b && vv_dsp_is_aligned(b, 64));
+        void* big[3];
+        for (int i = 0; i < 3; ++i) big[i] = vv_dsp_aligned_malloc(4096, 32);
+        for (int i = 0; i < 3; ++i) vv_dsp_aligned_free(big[i]); /* only two fit in 8 KiB */
+        ok &= (vv_dsp_aligned_pool_get_stats(&st) == VV_DSP_OK);
+        ok &= (st.hits - st0.hits == 1 && st.released - st0.released == 1);
+        ok &= (st.cached_bytes - st0.cached_bytes == 8192);
+        void* huge = vv_dsp_aligned_malloc((size_t)4 << 20, 64); /* above the largest class */
+        vv_dsp_aligned_free(huge);
+        vv_dsp_aligned_free(b);
+        vv_dsp_aligned_pool_trim();
+        ok &= (vv_dsp_aligned_pool_get_stats(&st) == VV_DSP_OK && st.cached_bytes == st0.cached_bytes);
+#ifndef _WIN32
+        pthread_t th;
+        ok &= (pthread_create(&th, NULL, pool_thread, NULL) == 0 && pthread_join(th, NULL) == 0);
+        ok &= (vv_dsp_aligned_pool_get_stats(&st) == VV_DSP_OK && st.cached_blocks == st0.cached_blocks);
+#endif
+        ok &= (vv_dsp_aligned_pool_enable(0) == VV_DSP_OK);
+        void* c = vv_dsp_aligned_malloc(1000, 64);
+        vv_dsp_aligned_free(c);
+        ok &= (vv_dsp_aligned_pool_get_stats(&st) == VV_DSP_OK && st.cached_blocks == st0.cached_blocks);
+        ok &= (vv_dsp_aligned_pool_get_stats(NULL) == VV_DSP_ERROR_NULL_POINTER);
+        if (ok) {
+            printf("PASSED\n");
+            tests_passed++;
+        } else {
+            printf("FAILED\n");
+        }
+    }
+
     printf("\n");
     printf("Test Results: %d/%d tests passed\n", tests_passed, total_tests);
 
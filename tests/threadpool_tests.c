@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define TEST_ADD(p, v) InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v))
+#else
+#define TEST_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#endif
+
+#define COUNT 5000
+
+typedef struct {
+    int hits[COUNT];
+    int worker_of[COUNT];
+    size_t num_threads;
+    int bad_chunk;
+    size_t grain;
+} cover_job;
+
+static void cover_range(void* ctx, size_t begin, size_t end, size_t worker) {
+    cover_job* j = (cover_job*)ctx;
+    if (end <= begin || end - begin > j->grain || worker >= j->num_threads) j->bad_chunk = 1;
+    for (size_t i = begin; i < end; ++i) {
+        TEST_ADD(&j->hits[i], 1);
+        j->worker_of[i] = (int)worker;
+        // Worker 0's share is slow, so the others must steal from it
+        if (i < COUNT / 4) {
+            volatile double acc = 0;
+            for (int k = 0; k < 2000; ++k) acc += sqrt((double)k);
+        }
+    }
+}
+
+// Every index exactly once, in chunks of at most grain, for several grains
+static int test_cover(vv_dsp_threadpool* pool, int expect_steal) {
+    static cover_job j;
+    const size_t grains[4] = {1, 7, 64, COUNT};
+    for (size_t g = 0; g < 4; ++g) {
+        memset(&j, 0, sizeof(j));
+        j.num_threads = vv_dsp_threadpool_num_threads(pool);
+        j.grain = grains[g];
+        if (vv_dsp_threadpool_parallel_for(pool, COUNT, grains[g], cover_range, &j) != VV_DSP_OK) return 0;
+        if (j.bad_chunk) return 0;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (j.hits[i] != 1) {
+                fprintf(stderr, "threadpool index %zu hit %d times (grain %zu)\n", i, j.hits[i], grains[g]);
+                return 0;
+            }
+        }
+        if (expect_steal && grains[g] == 1) {
+            // Part of the slow first quarter was taken by other workers
+            size_t stolen = 0;
+            for (size_t i = 0; i < COUNT / 4; ++i) stolen += j.worker_of[i] != j.worker_of[0];
+            if (stolen == 0) {
+                fprintf(stderr, "threadpool: no work was stolen\n");
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+typedef struct {
+    vv_dsp_threadpool* pool;
+    int inner[64];
+    int failed;
+} nested_job;
+
+static void inner_task(void* ctx, size_t k) {
+    int* row = (int*)ctx;
+    row[k] += 1;
+}
+
+// A task that starts a job on its own pool runs it inline
+static void outer_task(void* ctx, size_t k) {
+    nested_job* j = (nested_job*)ctx;
+    int row[8] = {0};
+    if (vv_dsp_threadpool_run(j->pool, 8, inner_task, row) != VV_DSP_OK) j->failed = 1;
+    for (size_t i = 0; i < 8; ++i) {
+        if (row[i] != 1) j->failed = 1;
+    }
+    j->inner[k] = 1;
+}
+
+// Host executor: runs the tasks one after another on the calling thread
+typedef struct {
+    size_t runs;
+    size_t tasks;
+} serial_executor;
+
+static void serial_run(void* user, size_t num_tasks, void (*task)(void*, size_t), void* task_ctx) {
+    serial_executor* e = (serial_executor*)user;
+    e->runs++;
+    for (size_t k = 0; k < num_tasks; ++k) {
+        task(task_ctx, k);
+        e->tasks++;
+    }
+}
+
+static int test_executor(void) {
+    serial_executor e = {0, 0};
+    const vv_dsp_executor ex = {serial_run, &e, 3};
+    vv_dsp_threadpool* pool = NULL;
+    if (vv_dsp_threadpool_create_with_executor(&ex, &pool) != VV_DSP_OK) return 0;
+    int ok = vv_dsp_threadpool_num_threads(pool) == 3 && test_cover(pool, 0) && e.runs > 0 && e.tasks == 3 * e.runs;
+
+    // As the default pool, it carries the library's batch calls
+    vv_dsp_threadpool_set_default(pool);
+    ok = ok && vv_dsp_threadpool_get_default() == pool;
+    enum { N = 16000, FFT = 512, HOP = 128 };
+    static vv_dsp_real x[N], a[(N / HOP + 1) * (FFT / 2 + 1)], b[(N / HOP + 1) * (FFT / 2 + 1)];
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)sin(0.01 * (double)i);
+    vv_dsp_stft_params p;
+    memset(&p, 0, sizeof(p));
+    p.fft_size = FFT;
+    p.hop_size = HOP;
+    p.window = VV_DSP_STFT_WIN_HANN;
+    p.spectrum = VV_DSP_STFT_SPECTRUM_HALF;
+    vv_dsp_stft* h = NULL;
+    size_t fa = 0, fb = 0;
+    const size_t runs = e.runs;
+    ok = ok && vv_dsp_stft_create(&p, &h) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_ex(h, x, N, NULL, a, &fa) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_parallel(h, x, N, NULL, b, &fb, 0) == VV_DSP_OK &&
+         fa == fb && memcmp(a, b, fa * (FFT / 2 + 1) * sizeof(vv_dsp_real)) == 0 && e.runs == runs + 1;
+    if (h) (void)vv_dsp_stft_destroy(h);
+    vv_dsp_threadpool_set_default(NULL);
+    ok = ok && vv_dsp_threadpool_get_default() != pool;
+    vv_dsp_threadpool_destroy(pool);
+    return ok;
+}
+
+int main(void) {
+    vv_dsp_threadpool* pool = NULL;
+    vv_dsp_threadpool_params params;
+    memset(&params, 0, sizeof(params));
+    params.num_threads = 4;
+    if (vv_dsp_threadpool_create(&params, &pool) != VV_DSP_OK || vv_dsp_threadpool_num_threads(pool) != 4) {
+        fprintf(stderr, "threadpool create failed\n");
+        return 1;
+    }
+    if (!test_cover(pool, 1)) { fprintf(stderr, "threadpool parallel for failed\n"); return 1; }
+
+    static nested_job nj;
+    nj.pool = pool;
+    if (vv_dsp_threadpool_run(pool, 64, outer_task, &nj) != VV_DSP_OK || nj.failed) {
+        fprintf(stderr, "threadpool nested run failed\n");
+        return 1;
+    }
+    for (size_t k = 0; k < 64; ++k) {
+        if (nj.inner[k] != 1) { fprintf(stderr, "threadpool task %zu skipped\n", k); return 1; }
+    }
+    if (vv_dsp_threadpool_run(pool, 4, NULL, NULL) != VV_DSP_ERROR_NULL_POINTER) return 1;
+    vv_dsp_threadpool_destroy(pool);
+
+    // Pinned and NUMA-ordered pools cover the same way, whatever the host topology
+    params.num_threads = 3;
+    params.numa_aware = 1;
+    if (vv_dsp_threadpool_create(&params, &pool) != VV_DSP_OK || !test_cover(pool, 0)) {
+        fprintf(stderr, "threadpool NUMA pool failed\n");
+        return 1;
+    }
+    vv_dsp_threadpool_destroy(pool);
+
+    // One thread runs everything inline
+    params.num_threads = 1;
+    params.numa_aware = 0;
+    if (vv_dsp_threadpool_create(&params, &pool) != VV_DSP_OK || !test_cover(pool, 0)) return 1;
+    vv_dsp_threadpool_destroy(pool);
+
+    if (!test_executor()) { fprintf(stderr, "threadpool executor test failed\n"); return 1; }
+    if (!vv_dsp_threadpool_get_default() || vv_dsp_threadpool_num_threads(vv_dsp_threadpool_get_default()) == 0) {
+        return 1;
+    }
+    printf("threadpool tests passed\n");
+    return 0;
+}
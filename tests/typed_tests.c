@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+#define N 512
+#define IS_F64 (sizeof(vv_dsp_real) == sizeof(double))
+
+static float g_f32[4 * N];
+static double g_f64[4 * N];
+static float g_f32_out[4 * N];
+static double g_f64_out[4 * N];
+
+// Both typed outputs against the vv_dsp_real one: the build's own variant bit for
+// bit, the other one within float rounding
+static int check(const char* what, const vv_dsp_real* ref, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const double r = (double)ref[i];
+        const double tol = 1e-4 * (1.0 + fabs(r));
+        const int f32_native = !IS_F64 && memcmp(&g_f32_out[i], &ref[i], sizeof(float)) == 0;
+        const int f64_native = IS_F64 && memcmp(&g_f64_out[i], &ref[i], sizeof(double)) == 0;
+        if ((IS_F64 ? fabs((double)g_f32_out[i] - r) > tol : !f32_native) ||
+            (IS_F64 ? !f64_native : fabs(g_f64_out[i] - r) > tol)) {
+            fprintf(stderr, "%s differs at %zu: ref %g, f32 %g, f64 %g\n", what, i, r, (double)g_f32_out[i],
+                    g_f64_out[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void load(const vv_dsp_real* x, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        g_f32[i] = (float)x[i];
+        g_f64[i] = (double)x[i];
+    }
+}
+
+static int test_conversions(void) {
+    vv_dsp_real x[4] = {(vv_dsp_real)0.25, (vv_dsp_real)-1.5, 0, (vv_dsp_real)3};
+    vv_dsp_real back[4];
+    float f[4];
+    double d[4];
+    if (vv_dsp_real_to_f32(x, f, 4) != VV_DSP_OK || vv_dsp_f32_to_real(f, back, 4) != VV_DSP_OK ||
+        memcmp(back, x, sizeof(x)) != 0) return 0;
+    if (vv_dsp_real_to_f64(x, d, 4) != VV_DSP_OK || vv_dsp_f64_to_real(d, back, 4) != VV_DSP_OK ||
+        memcmp(back, x, sizeof(x)) != 0) return 0;
+    return vv_dsp_real_to_f32(NULL, f, 1) == VV_DSP_ERROR_NULL_POINTER &&
+           vv_dsp_f64_to_real(d, NULL, 1) == VV_DSP_ERROR_NULL_POINTER && vv_dsp_real_to_f32(NULL, NULL, 0) == VV_DSP_OK;
+}
+
+static int test_fft(const vv_dsp_real* x) {
+    vv_dsp_fft_plan* plan = NULL;
+    vv_dsp_cpx ref[N / 2 + 1];
+    if (vv_dsp_fft_make_plan(N, VV_DSP_FFT_R2C, VV_DSP_FFT_FORWARD, &plan) != VV_DSP_OK) return 0;
+    load(x, N);
+    int ok = vv_dsp_fft_execute(plan, x, ref) == VV_DSP_OK &&
+             vv_dsp_fft_execute_f32(plan, g_f32, g_f32_out, NULL) == VV_DSP_OK &&
+             vv_dsp_fft_execute_f64(plan, g_f64, g_f64_out, NULL) == VV_DSP_OK &&
+             check("fft r2c", &ref[0].re, 2 * (N / 2 + 1));
+    vv_dsp_fft_destroy(plan);
+    return ok && vv_dsp_fft_execute_f32(NULL, g_f32, g_f32_out, NULL) == VV_DSP_ERROR_NULL_POINTER &&
+           vv_dsp_fft_execute_f64(NULL, g_f64, g_f64_out, NULL) == VV_DSP_ERROR_NULL_POINTER;
+}
+
+static int test_stft(const vv_dsp_real* x) {
+    vv_dsp_stft_params p = { .fft_size = 256, .hop_size = 64, .window = VV_DSP_STFT_WIN_HANN,
+                             .spectrum = VV_DSP_STFT_SPECTRUM_HALF };
+    vv_dsp_stft* st = NULL;
+    if (vv_dsp_stft_create(&p, &st) != VV_DSP_OK) return 0;
+    vv_dsp_cpx spec[129];
+    load(x, N);
+    int ok = vv_dsp_stft_process(st, x, spec) == VV_DSP_OK &&
+             vv_dsp_stft_process_f32(st, g_f32, (vv_dsp_cpx_f32*)(void*)g_f32_out, NULL) == VV_DSP_OK &&
+             vv_dsp_stft_process_f64(st, g_f64, (vv_dsp_cpx_f64*)(void*)g_f64_out, NULL) == VV_DSP_OK &&
+             check("stft frame", &spec[0].re, 2 * 129);
+
+    // Fused log-mel rows
+    vv_dsp_real* fb = NULL;
+    size_t nf = 0, flen = 0, fr = 0, f32_rows = 0, f64_rows = 0;
+    vv_dsp_real* ref = (vv_dsp_real*)malloc(4 * N * sizeof(vv_dsp_real));
+    ok = ok && ref &&
+         vv_dsp_mel_filterbank_create(256, 20, (vv_dsp_real)16000, 0, (vv_dsp_real)8000, VV_DSP_MEL_VARIANT_HTK,
+                                      &fb, &nf, &flen) == VV_DSP_OK;
+    vv_dsp_spectrogram_opts o;
+    memset(&o, 0, sizeof(o));
+    o.scale = VV_DSP_SPECTROGRAM_LOG;
+    o.floor = (vv_dsp_real)1e-6;
+    o.mel_weights = fb;
+    o.n_mels = 20;
+    ok = ok && vv_dsp_stft_spectrogram_ex(st, x, N, &o, ref, &fr) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_ex_f32(st, g_f32, N, &o, g_f32_out, &f32_rows, NULL) == VV_DSP_OK &&
+         vv_dsp_stft_spectrogram_ex_f64(st, g_f64, N, &o, g_f64_out, &f64_rows, NULL) == VV_DSP_OK &&
+         f32_rows == fr && f64_rows == fr && check("log-mel spectrogram", ref, fr * 20);
+    if (fb) vv_dsp_mel_filterbank_free(fb, 20);
+    free(ref);
+    vv_dsp_stft_destroy(st);
+    return ok;
+}
+
+static int test_filters(const vv_dsp_real* x) {
+    enum { TAPS = 31, STAGES = 3 };
+    vv_dsp_real h[TAPS], ref[N];
+    vv_dsp_fir_state s0, s1, s2;
+    if (vv_dsp_fir_design_lowpass(h, TAPS, (vv_dsp_real)0.2, VV_DSP_WINDOW_HAMMING) != VV_DSP_OK ||
+        vv_dsp_fir_state_init(&s0, TAPS) != VV_DSP_OK || vv_dsp_fir_state_init(&s1, TAPS) != VV_DSP_OK ||
+        vv_dsp_fir_state_init(&s2, TAPS) != VV_DSP_OK) return 0;
+    load(x, N);
+    // Two calls each, so the foreign variants carry state across their stack blocks
+    int ok = vv_dsp_fir_apply(&s0, h, x, ref, 300) == VV_DSP_OK &&
+             vv_dsp_fir_apply(&s0, h, x + 300, ref + 300, N - 300) == VV_DSP_OK &&
+             vv_dsp_fir_apply_f32(&s1, h, g_f32, g_f32_out, 300) == VV_DSP_OK &&
+             vv_dsp_fir_apply_f32(&s1, h, g_f32 + 300, g_f32_out + 300, N - 300) == VV_DSP_OK &&
+             vv_dsp_fir_apply_f64(&s2, h, g_f64, g_f64_out, 300) == VV_DSP_OK &&
+             vv_dsp_fir_apply_f64(&s2, h, g_f64 + 300, g_f64_out + 300, N - 300) == VV_DSP_OK &&
+             check("fir", ref, N);
+    vv_dsp_fir_state_free(&s0);
+    vv_dsp_fir_state_free(&s1);
+    vv_dsp_fir_state_free(&s2);
+
+    vv_dsp_biquad bq[3][STAGES];
+    for (int k = 0; k < 3; ++k) {
+        for (int s = 0; s < STAGES; ++s) {
+            ok = ok && vv_dsp_biquad_init(&bq[k][s], (vv_dsp_real)0.2, (vv_dsp_real)0.4, (vv_dsp_real)0.2,
+                                          (vv_dsp_real)-0.5, (vv_dsp_real)0.1) == VV_DSP_OK;
+        }
+    }
+    return ok && vv_dsp_iir_apply(bq[0], STAGES, x, ref, N) == VV_DSP_OK &&
+           vv_dsp_iir_apply_f32(bq[1], STAGES, g_f32, g_f32_out, N) == VV_DSP_OK &&
+           vv_dsp_iir_apply_f64(bq[2], STAGES, g_f64, g_f64_out, N) == VV_DSP_OK && check("iir", ref, N);
+}
+
+static int test_mfcc(void) {
+    enum { FRAMES = 6, BINS = 257, COEFFS = 13 };
+    vv_dsp_mfcc_plan* plan = NULL;
+    if (vv_dsp_mfcc_init(512, 40, COEFFS, 16000.0f, 20.0f, 8000.0f, VV_DSP_MEL_VARIANT_HTK, VV_DSP_DCT_II, 22.0f,
+                         1e-10f, &plan) != VV_DSP_OK) return 0;
+    vv_dsp_real* power = (vv_dsp_real*)malloc(FRAMES * BINS * sizeof(vv_dsp_real));
+    vv_dsp_real ref[FRAMES * COEFFS];
+    float* pf = (float*)malloc(FRAMES * BINS * sizeof(float));
+    double* pd = (double*)malloc(FRAMES * BINS * sizeof(double));
+    int ok = power && pf && pd;
+    for (size_t i = 0; ok && i < FRAMES * BINS; ++i) {
+        power[i] = (vv_dsp_real)(1e-3 * (1.5 + sin(0.07 * (double)i)) / (1.0 + (double)(i % BINS)));
+        pf[i] = (float)power[i];
+        pd[i] = (double)power[i];
+    }
+    ok = ok && vv_dsp_mfcc_process(plan, power, FRAMES, ref) == VV_DSP_OK &&
+         vv_dsp_mfcc_process_f32(plan, pf, FRAMES, g_f32_out, NULL) == VV_DSP_OK &&
+         vv_dsp_mfcc_process_f64(plan, pd, FRAMES, g_f64_out, NULL) == VV_DSP_OK && check("mfcc", ref, FRAMES * COEFFS) &&
+         vv_dsp_mfcc_process_f32(plan, pf, 0, g_f32_out, NULL) == VV_DSP_ERROR_INVALID_SIZE &&
+         vv_dsp_mfcc_process_f64(plan, pd, 0, g_f64_out, NULL) == VV_DSP_ERROR_INVALID_SIZE;
+    free(power);
+    free(pf);
+    free(pd);
+    vv_dsp_mfcc_destroy(plan);
+    return ok;
+}
+
+int main(void) {
+    vv_dsp_real x[N];
+    for (size_t i = 0; i < N; ++i) x[i] = (vv_dsp_real)(sin(0.05 * (double)i) + 0.3 * cos(0.61 * (double)i));
+    if (!test_conversions()) { fprintf(stderr, "typed conversion test failed\n"); return 1; }
+    if (!test_fft(x)) { fprintf(stderr, "typed FFT test failed\n"); return 1; }
+    if (!test_stft(x)) { fprintf(stderr, "typed STFT test failed\n"); return 1; }
+    if (!test_filters(x)) { fprintf(stderr, "typed filter test failed\n"); return 1; }
+    if (!test_mfcc()) { fprintf(stderr, "typed MFCC test failed\n"); return 1; }
+    printf("typed entry point tests passed (%s build)\n", IS_F64 ? "double" : "float");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vv_dsp/vv_dsp.h"
+
+enum { SR = 16000, FRAME = SR / 100, LEN = 7 * SR / 2 };
+static const size_t SPEECH_ON = SR, SPEECH_OFF = 5 * SR / 2;
+
+// Low white noise throughout; from 1 s to 2.5 s a 120 Hz harmonic "voice" whose
+// level follows a 4 Hz syllable envelope
+static void make_signal(vv_dsp_real* x) {
+    unsigned int seed = 99u;
+    for (size_t t = 0; t < LEN; ++t) {
+        seed = seed * 1664525u + 1013904223u;
+        double v = 0.02 * ((double)(seed >> 8) / 16777216.0 - 0.5);
+        if (t >= SPEECH_ON && t < SPEECH_OFF) {
+            const double tt = (double)(t - SPEECH_ON) / SR;
+            const double env = 0.55 - 0.45 * cos(2.0 * VV_DSP_PI_D * 4.0 * tt);
+            for (int h = 1; h * 120 < 3500; ++h) v += env * 0.3 / h * sin(2.0 * VV_DSP_PI_D * 120.0 * h * tt);
+        }
+        x[t] = (vv_dsp_real)v;
+    }
+}
+
+static vv_dsp_vad* make(void) {
+    vv_dsp_vad_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = SR;
+    vv_dsp_vad* vad = NULL;
+    return vv_dsp_vad_create(&p, &vad) == VV_DSP_OK ? vad : NULL;
+}
+
+// Speech is found, noise is not, and block sizes do not change a decision
+static int test_decisions(void) {
+    enum { FRAMES = LEN / FRAME };
+    vv_dsp_real* x = (vv_dsp_real*)malloc(LEN * sizeof(vv_dsp_real));
+    unsigned char whole[FRAMES], blocks[FRAMES];
+    vv_dsp_vad* a = make();
+    vv_dsp_vad* b = make();
+    size_t got = 0;
+    int ok = x && a && b && vv_dsp_vad_frame_size(a) == FRAME;
+    if (ok) {
+        make_signal(x);
+        ok = vv_dsp_vad_process(a, x, LEN, whole, FRAMES - 1, &got) == VV_DSP_ERROR_INVALID_SIZE && got == 0 &&
+             vv_dsp_vad_process(a, x, LEN, whole, FRAMES, &got) == VV_DSP_OK && got == FRAMES;
+    }
+    // Odd block sizes, decisions read back from the flag of the last frame
+    static const size_t sizes[4] = { 1, 333, 64, 1000 };
+    size_t frames = 0;
+    for (size_t pos = 0, i = 0; ok && pos < LEN; ++i) {
+        size_t n = sizes[i % 4];
+        if (n > LEN - pos) n = LEN - pos;
+        ok = vv_dsp_vad_process(b, x + pos, n, blocks + frames, FRAMES - frames, &got) == VV_DSP_OK;
+        frames += got;
+        if (ok && got) ok = vv_dsp_vad_active(b) == blocks[frames - 1];
+        pos += n;
+    }
+    ok = ok && frames == FRAMES && memcmp(whole, blocks, FRAMES) == 0;
+
+    size_t false_alarms = 0, misses = 0, late = 0;
+    for (size_t f = 0; ok && f < FRAMES; ++f) {
+        const size_t t = f * FRAME;
+        if (t < SPEECH_ON) false_alarms += whole[f];
+        else if (t + FRAME <= SPEECH_OFF) misses += !whole[f];
+        else if (t >= SPEECH_OFF + 30 * FRAME) late += whole[f];  // past the hangover
+    }
+    if (ok && (false_alarms > 2 || misses > (SPEECH_OFF - SPEECH_ON) / FRAME / 10 || late > 2)) {
+        fprintf(stderr, "vad: %zu false alarms, %zu misses, %zu late\n", false_alarms, misses, late);
+        ok = 0;
+    }
+    vv_dsp_vad_destroy(a);
+    vv_dsp_vad_destroy(b);
+    free(x);
+    return ok;
+}
+
+static int test_errors(void) {
+    vv_dsp_vad_params p;
+    memset(&p, 0, sizeof(p));
+    p.sample_rate = 500;
+    vv_dsp_vad* vad = NULL;
+    if (vv_dsp_vad_create(&p, &vad) != VV_DSP_ERROR_OUT_OF_RANGE || vad) return 0;
+    p.sample_rate = SR;
+    p.energy_floor_db = 3;
+    if (vv_dsp_vad_create(&p, &vad) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    p.energy_floor_db = 0;
+    p.zcr_max = 2;
+    if (vv_dsp_vad_create(&p, &vad) != VV_DSP_ERROR_OUT_OF_RANGE) return 0;
+    // 8 kHz drops the 3 kHz band but still works
+    p.zcr_max = 0;
+    p.sample_rate = 8000;
+    if (vv_dsp_vad_create(&p, &vad) != VV_DSP_OK) return 0;
+    const vv_dsp_real x[100] = { 0 };
+    size_t got = 1;
+    const int ok = vv_dsp_vad_process(vad, x, 100, NULL, 0, &got) == VV_DSP_OK && got == 1 &&
+                   vv_dsp_vad_active(vad) == 0 && vv_dsp_vad_reset(vad) == VV_DSP_OK &&
+                   vv_dsp_vad_process(NULL, x, 100, NULL, 0, NULL) == VV_DSP_ERROR_NULL_POINTER;
+    vv_dsp_vad_destroy(vad);
+    vv_dsp_vad_destroy(NULL);
+    return ok;
+}
+
+int main(void) {
+    int ok = 1;
+    if (!test_decisions()) { fprintf(stderr, "vad decision test failed\n"); ok = 0; }
+    if (!test_errors()) { fprintf(stderr, "vad error test failed\n"); ok = 0; }
+    if (!ok) return 1;
+    printf("vad tests passed\n");
+    return 0;
+}
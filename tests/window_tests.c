@@ -275,12 +275,46 @@ static int test_parameterized_windows(void) {
     return 0;
 }
 
+static int test_window_cache(void) {
+    enum { N = 64 };
+    vv_dsp_real ref[N], sym[N + 1];
+    const vv_dsp_real tol = (vv_dsp_real)1e-6;
+
+    // Periodic form is the symmetric window of length N + 1 without its last point
+    if (vv_dsp_window_fill(VV_DSP_WINDOW_KIND_HANN, N, 0, 1, ref) != VV_DSP_OK) return 60;
+    if (vv_dsp_window_hann(N + 1, sym) != VV_DSP_OK) return 61;
+    for (size_t n = 0; n < N; ++n) if (!almost_equal(ref[n], sym[n], tol)) return 62;
+
+    // Identical requests share one read-only array; a different key gets its own
+    vv_dsp_window_cache_stats before, after;
+    if (vv_dsp_window_cache_get_stats(&before) != VV_DSP_OK) return 63;
+    const vv_dsp_real *a = NULL, *b = NULL, *c = NULL, *k = NULL;
+    if (vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_HANN, N, 0, 1, &a) != VV_DSP_OK) return 64;
+    if (vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_HANN, N, (vv_dsp_real)3, 1, &b) != VV_DSP_OK) return 65;
+    if (vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_HANN, N, 0, 0, &c) != VV_DSP_OK) return 66;
+    if (vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_KAISER, N, (vv_dsp_real)5, 0, &k) != VV_DSP_OK) return 67;
+    if (a != b || a == c || memcmp(a, ref, sizeof(ref)) != 0) return 68;
+    if (vv_dsp_window_cache_get_stats(&after) != VV_DSP_OK) return 69;
+    if (after.hits != before.hits + 1 || after.misses != before.misses + 3 ||
+        after.entries != before.entries + 3) return 70;
+    vv_dsp_window_release(a);
+    vv_dsp_window_release(b);
+    vv_dsp_window_release(c);
+    vv_dsp_window_release(k);
+    if (vv_dsp_window_cache_get_stats(&after) != VV_DSP_OK || after.entries != before.entries) return 71;
+
+    if (vv_dsp_window_acquire(VV_DSP_WINDOW_KIND_HANN, 0, 0, 0, &a) != VV_DSP_ERROR_INVALID_SIZE) return 72;
+    if (vv_dsp_window_acquire((vv_dsp_window_kind)99, N, 0, 0, &a) != VV_DSP_ERROR_OUT_OF_RANGE || a) return 73;
+    return 0;
+}
+
 int main(void) {
     int rc;
     if ((rc = test_validation()) != 0) { printf("validation failed: %d\n", rc); return rc; }
     if ((rc = test_N_eq_1()) != 0) { printf("N==1 failed: %d\n", rc); return rc; }
     if ((rc = test_symmetry_and_values()) != 0) { printf("symmetry/values failed: %d\n", rc); return rc; }
     if ((rc = test_parameterized_windows()) != 0) { printf("parameterized windows failed: %d\n", rc); return rc; }
+    if ((rc = test_window_cache()) != 0) { printf("window cache failed: %d\n", rc); return rc; }
     printf("window tests passed\n");
     return 0;
 }
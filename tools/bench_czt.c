@@ -47,6 +47,17 @@ int main(int argc, char** argv){
     double avg_ms = (t1 - t0) * 1e3 / (double)iters;
     printf("CZT bench: N=%zu M=%zu iters=%zu avg=%.3f ms\n", N, M, iters, avg_ms);
 
+    // same band on every frame: reuse one plan
+    vv_dsp_czt_plan* plan = NULL;
+    if (vv_dsp_czt_plan_create(N, M, Wre, Wim, Are, Aim, &plan) != VV_DSP_OK){ fprintf(stderr, "plan fail\n"); return 2; }
+    t0 = now_sec();
+    for (size_t i=0;i<iters;++i){
+        if (vv_dsp_czt_plan_execute_real(plan, x, X) != VV_DSP_OK){ fprintf(stderr, "exec fail\n"); return 2; }
+    }
+    t1 = now_sec();
+    vv_dsp_czt_plan_destroy(plan);
+    printf("CZT plan bench: N=%zu M=%zu iters=%zu avg=%.3f ms\n", N, M, iters, (t1 - t0) * 1e3 / (double)iters);
+
     // print peak bin
     size_t argmax = 0; vv_dsp_real maxmag = 0;
     for (size_t k=0;k<M;++k){ vv_dsp_real m = X[k].re*X[k].re + X[k].im*X[k].im; if (m>maxmag){maxmag=m; argmax=k;} }
@@ -34,7 +34,7 @@ int main(int argc, char** argv){
         for(size_t i=0;i<n;++i) sig[i] = (float)rand()/RAND_MAX*2.f-1.f;
     }
 
-    vv_dsp_stft_params params = { fft, hop, w };
+    vv_dsp_stft_params params = { .fft_size = fft, .hop_size = hop, .window = w, .spectrum = VV_DSP_STFT_SPECTRUM_FULL };
     vv_dsp_stft* h = NULL;
     if(vv_dsp_stft_create(&params, &h)!=VV_DSP_OK || !h) return 1;
 
@@ -0,0 +1,443 @@
+// Corpus feature extraction: decode every WAV file of a list with the streaming
+// reader, mix to mono, resample to one rate and compute log-mel or MFCC frames
+// (and optionally YIN F0) on a vv_dsp_threadpool. Each pool worker owns its plans
+// and buffers and takes files one at a time, stealing from busy workers when its
+// share runs out; finished files are appended to a feature store under a lock, so the decode and the DSP of different files
+// overlap and throughput follows the core count until the disk saturates.
+//
+// Each file becomes one chunk keyed by its path, in completion order; F0 goes to
+// a second store with one value per frame.
+
+#include "vv_dsp/audio/wav.h"
+#include "vv_dsp/audio/feature_store.h"
+#include "vv_dsp/features/extractor.h"
+#include "vv_dsp/features/pitch.h"
+#include "vv_dsp/core/threadpool.h"
+#include "vv_dsp/resample/resampler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef CRITICAL_SECTION ex_mutex;
+#define EX_LOCK(m)   EnterCriticalSection(m)
+#define EX_UNLOCK(m) LeaveCriticalSection(m)
+static double now_sec(void) {
+    LARGE_INTEGER freq, ctr;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&ctr);
+    return (double)ctr.QuadPart / (double)freq.QuadPart;
+}
+#else
+#include <pthread.h>
+#include <time.h>
+typedef pthread_mutex_t ex_mutex;
+#define EX_LOCK(m)   pthread_mutex_lock(m)
+#define EX_UNLOCK(m) pthread_mutex_unlock(m)
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+#define EX_BLOCK 4096       // frames decoded per read
+#define EX_MAX_CHANNELS 8   // the WAV reader's limit
+
+typedef struct {
+    vv_dsp_feature_params features;
+    int f0;
+    vv_dsp_real f0_min;
+    vv_dsp_real f0_max;
+    unsigned int rate;      // target sample rate
+} ex_config;
+
+// Shared state: the file list and the output
+typedef struct {
+    const ex_config* cfg;
+    char** paths;
+    size_t num_paths;
+    vv_dsp_feature_store_writer* out;
+    vv_dsp_feature_store_writer* f0_out;  // NULL without F0
+    ex_mutex out_lock;
+    size_t failed;          // under out_lock
+    double audio_seconds;   // under out_lock
+} ex_job;
+
+// One worker's plan set and growable output buffers
+typedef struct {
+    ex_job* job;
+    vv_dsp_feature_extractor* fx;
+    vv_dsp_yin* yin;
+    vv_dsp_resampler* rs;
+    unsigned int rs_rate;   // source rate rs is set up for
+    size_t dim;
+    vv_dsp_real* planar[EX_MAX_CHANNELS];
+    vv_dsp_real* mono;
+    vv_dsp_real* resampled;
+    size_t resampled_cap;
+    vv_dsp_real* feats;
+    size_t feats_frames, feats_cap;
+    vv_dsp_real* f0;
+    size_t f0_frames, f0_cap;
+} ex_worker;
+
+static void print_usage(const char* program_name) {
+    printf("Usage: %s --list FILE --output FILE [options]\n", program_name);
+    printf("Options:\n");
+    printf("  --list FILE         Text file with one WAV path per line\n");
+    printf("  --output FILE       Feature store to write\n");
+    printf("  --threads N         Worker threads (default: online processors)\n");
+    printf("  --sample-rate SR    Analysis rate; other rates are resampled (default: 16000)\n");
+    printf("  --feature KIND      logmel or mfcc (default: logmel)\n");
+    printf("  --n-fft N           FFT size (default: 512)\n");
+    printf("  --hop-length H      Hop length in samples (default: 160)\n");
+    printf("  --n-mels M          Number of Mel filters (default: 80)\n");
+    printf("  --n-mfcc C          Number of MFCC coefficients (default: 13)\n");
+    printf("  --fmin F            Minimum frequency in Hz (default: 0)\n");
+    printf("  --fmax F            Maximum frequency in Hz (default: SR/2)\n");
+    printf("  --f0-output FILE    Also track F0 with YIN at the same hop into this store\n");
+    printf("  --f0-min F          Lowest F0 in Hz (default: 60)\n");
+    printf("  --f0-max F          Highest F0 in Hz (default: 800)\n");
+    printf("  --help              Show this help\n");
+}
+
+static int grow(vv_dsp_real** buf, size_t* cap, size_t need) {
+    if (need <= *cap) return 1;
+    size_t n = *cap ? *cap : 1024;
+    while (n < need) n *= 2;
+    vv_dsp_real* p = (vv_dsp_real*)realloc(*buf, n * sizeof(vv_dsp_real));
+    if (!p) return 0;
+    *buf = p;
+    *cap = n;
+    return 1;
+}
+
+// Feed n mono samples at the analysis rate to the extractor and the F0 tracker
+static int worker_feed(ex_worker* w, const vv_dsp_real* x, size_t n) {
+    size_t got = 0;
+    const size_t frames = vv_dsp_feature_extractor_output_count(w->fx, n);
+    if (!grow(&w->feats, &w->feats_cap, (w->feats_frames + frames) * w->dim)) return 0;
+    if (vv_dsp_feature_extractor_process(w->fx, x, n, w->feats + w->feats_frames * w->dim, frames, &got) !=
+        VV_DSP_OK) {
+        return 0;
+    }
+    w->feats_frames += got;
+    if (w->yin) {
+        const size_t f0_frames = vv_dsp_yin_output_count(w->yin, n);
+        if (!grow(&w->f0, &w->f0_cap, w->f0_frames + f0_frames)) return 0;
+        if (vv_dsp_yin_push(w->yin, x, n, w->f0 + w->f0_frames, NULL, f0_frames, &got) != VV_DSP_OK) return 0;
+        w->f0_frames += got;
+    }
+    return 1;
+}
+
+// Feed n mono samples at the file's rate, resampling when it differs
+static int worker_feed_source(ex_worker* w, const vv_dsp_real* x, size_t n) {
+    if (!w->rs_rate) return worker_feed(w, x, n);
+    size_t out_n = 0;
+    if (!grow(&w->resampled, &w->resampled_cap, vv_dsp_resampler_out_needed(w->rs, n)) ||
+        vv_dsp_resampler_process_stream(w->rs, x, n, w->resampled, w->resampled_cap, &out_n) != VV_DSP_OK) {
+        return 0;
+    }
+    return worker_feed(w, w->resampled, out_n);
+}
+
+// Decode and analyse one file into the worker's buffers
+static int worker_extract(ex_worker* w, const char* path, double* seconds) {
+    const ex_config* cfg = w->job->cfg;
+    vv_dsp_wav_reader* reader = NULL;
+    if (vv_dsp_wav_reader_open(path, &reader) != VV_DSP_OK) return 0;
+    vv_dsp_wav_info info;
+    int ok = vv_dsp_wav_reader_info(reader, &info) == VV_DSP_OK;
+    *seconds = ok ? (double)info.num_samples / info.sample_rate : 0.0;
+
+    const unsigned int rate = (unsigned int)(info.sample_rate + 0.5);
+    w->rs_rate = 0;
+    if (ok && rate != cfg->rate) {
+        if (!w->rs) {
+            w->rs = vv_dsp_resampler_create(cfg->rate, rate);
+            ok = w->rs && vv_dsp_resampler_set_quality(w->rs, 1, 32) == VV_DSP_OK;
+        } else {
+            ok = vv_dsp_resampler_set_ratio(w->rs, cfg->rate, rate) == VV_DSP_OK;
+        }
+        w->rs_rate = rate;
+    }
+
+    w->feats_frames = 0;
+    w->f0_frames = 0;
+    const size_t channels = (size_t)info.num_channels;
+    while (ok) {
+        size_t got = 0;
+        ok = vv_dsp_wav_reader_read_planar(reader, w->planar, EX_BLOCK, &got) == VV_DSP_OK;
+        if (!ok || got == 0) break;
+        // Mix down to mono
+        const vv_dsp_real gain = (vv_dsp_real)1 / (vv_dsp_real)channels;
+        for (size_t i = 0; i < got; i++) {
+            vv_dsp_real s = w->planar[0][i];
+            for (size_t ch = 1; ch < channels; ch++) s += w->planar[ch][i];
+            w->mono[i] = s * gain;
+        }
+        ok = worker_feed_source(w, w->mono, got);
+    }
+    vv_dsp_wav_reader_close(reader);
+
+    // End of file: drain the resampler, then the extractor's delta window
+    while (ok && w->rs_rate) {
+        size_t out_n = 0;
+        const int st = vv_dsp_resampler_flush(w->rs, w->resampled, w->resampled_cap, &out_n);
+        if (st == VV_DSP_ERROR_INVALID_SIZE) {
+            ok = grow(&w->resampled, &w->resampled_cap, w->resampled_cap * 2 + 1);
+            continue;
+        }
+        ok = st == VV_DSP_OK && worker_feed(w, w->resampled, out_n);
+        break;
+    }
+    if (ok) {
+        size_t got = 0;
+        const size_t tail = w->job->cfg->features.delta_order * 64;
+        ok = grow(&w->feats, &w->feats_cap, (w->feats_frames + tail) * w->dim) &&
+             vv_dsp_feature_extractor_flush(w->fx, w->feats + w->feats_frames * w->dim, tail, &got) == VV_DSP_OK;
+        w->feats_frames += got;
+    }
+    if (!ok) {
+        (void)vv_dsp_feature_extractor_reset(w->fx);
+        if (w->rs_rate) (void)vv_dsp_resampler_reset(w->rs);
+    }
+    if (w->yin) (void)vv_dsp_yin_reset(w->yin);
+    return ok;
+}
+
+// Store one file's results; the caller holds out_lock
+static int write_record(ex_worker* w, const char* path) {
+    ex_job* job = w->job;
+    if (vv_dsp_feature_store_write_chunk(job->out, path, w->feats, w->feats_frames) != VV_DSP_OK) return 0;
+    return !job->f0_out || vv_dsp_feature_store_write_chunk(job->f0_out, path, w->f0, w->f0_frames) == VV_DSP_OK;
+}
+
+// Files [begin, end) on pool worker `worker`, which owns workers[worker]
+static void worker_range(void* ctx, size_t begin, size_t end, size_t worker) {
+    ex_worker* w = (ex_worker*)ctx + worker;
+    ex_job* job = w->job;
+    for (size_t index = begin; index < end; index++) {
+        double seconds = 0.0;
+        const int ok = worker_extract(w, job->paths[index], &seconds);
+        EX_LOCK(&job->out_lock);
+        if (ok && write_record(w, job->paths[index])) {
+            job->audio_seconds += seconds;
+        } else {
+            fprintf(stderr, "Error: %s: %s\n", job->paths[index],
+                    ok ? "write failed" : vv_dsp_wav_get_error_string());
+            job->failed++;
+        }
+        EX_UNLOCK(&job->out_lock);
+    }
+}
+
+static void worker_destroy(ex_worker* w) {
+    vv_dsp_feature_extractor_destroy(w->fx);
+    vv_dsp_yin_destroy(w->yin);
+    vv_dsp_resampler_destroy(w->rs);
+    for (size_t ch = 0; ch < EX_MAX_CHANNELS; ch++) free(w->planar[ch]);
+    free(w->mono);
+    free(w->resampled);
+    free(w->feats);
+    free(w->f0);
+}
+
+static int worker_init(ex_worker* w, ex_job* job) {
+    const ex_config* cfg = job->cfg;
+    memset(w, 0, sizeof(*w));
+    w->job = job;
+    if (vv_dsp_feature_extractor_create(&cfg->features, &w->fx) != VV_DSP_OK) return 0;
+    w->dim = vv_dsp_feature_extractor_frame_size(w->fx);
+    if (cfg->f0) {
+        vv_dsp_yin_params yp;
+        memset(&yp, 0, sizeof(yp));
+        yp.sample_rate = (vv_dsp_real)cfg->rate;
+        yp.f0_min = cfg->f0_min;
+        yp.f0_max = cfg->f0_max;
+        yp.hop = cfg->features.hop_size;
+        yp.num_threads = 1;
+        if (vv_dsp_yin_create(&yp, &w->yin) != VV_DSP_OK) return 0;
+    }
+    for (size_t ch = 0; ch < EX_MAX_CHANNELS; ch++) {
+        w->planar[ch] = (vv_dsp_real*)malloc(EX_BLOCK * sizeof(vv_dsp_real));
+        if (!w->planar[ch]) return 0;
+    }
+    w->mono = (vv_dsp_real*)malloc(EX_BLOCK * sizeof(vv_dsp_real));
+    return w->mono != NULL;
+}
+
+// Read the non-empty lines of a list file (trailing CR/LF and blanks stripped)
+static char** read_list(const char* list_file, size_t* count) {
+    FILE* fp = fopen(list_file, "r");
+    if (!fp) return NULL;
+    char** paths = NULL;
+    size_t n = 0, cap = 0;
+    char line[4096];
+    while (fgets(line, sizeof(line), fp)) {
+        size_t len = strlen(line);
+        while (len && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) line[--len] = '\0';
+        if (len == 0) continue;
+        if (n == cap) {
+            cap = cap ? cap * 2 : 256;
+            char** p = (char**)realloc(paths, cap * sizeof(char*));
+            if (!p) break;
+            paths = p;
+        }
+        paths[n] = (char*)malloc(len + 1);
+        if (!paths[n]) break;
+        memcpy(paths[n++], line, len + 1);
+    }
+    fclose(fp);
+    *count = n;
+    return paths;
+}
+
+int main(int argc, char* argv[]) {
+    ex_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.rate = 16000;
+    cfg.features.fft_size = 512;
+    cfg.features.hop_size = 160;
+    cfg.features.window = VV_DSP_STFT_WIN_HANN;
+    cfg.features.n_mels = 80;
+    cfg.features.variant = VV_DSP_MEL_VARIANT_HTK;
+    cfg.features.kind = VV_DSP_FEATURE_LOG_MEL;
+    cfg.features.num_mfcc_coeffs = 13;
+    cfg.features.lifter_coeff = 22.0f;
+    cfg.f0_min = 60.0f;
+    cfg.f0_max = 800.0f;
+    const char* list_file = NULL;
+    const char* output_file = NULL;
+    const char* f0_file = NULL;
+    size_t num_threads = 0;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--list") == 0 && i + 1 < argc) {
+            list_file = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sample-rate") == 0 && i + 1 < argc) {
+            cfg.rate = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--feature") == 0 && i + 1 < argc) {
+            const char* kind = argv[++i];
+            if (strcmp(kind, "mfcc") == 0) {
+                cfg.features.kind = VV_DSP_FEATURE_MFCC;
+            } else if (strcmp(kind, "logmel") != 0) {
+                fprintf(stderr, "Unknown feature: %s\n", kind);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--n-fft") == 0 && i + 1 < argc) {
+            cfg.features.fft_size = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hop-length") == 0 && i + 1 < argc) {
+            cfg.features.hop_size = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--n-mels") == 0 && i + 1 < argc) {
+            cfg.features.n_mels = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--n-mfcc") == 0 && i + 1 < argc) {
+            cfg.features.num_mfcc_coeffs = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fmin") == 0 && i + 1 < argc) {
+            cfg.features.fmin = (vv_dsp_real)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--fmax") == 0 && i + 1 < argc) {
+            cfg.features.fmax = (vv_dsp_real)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--f0-output") == 0 && i + 1 < argc) {
+            f0_file = argv[++i];
+            cfg.f0 = 1;
+        } else if (strcmp(argv[i], "--f0-min") == 0 && i + 1 < argc) {
+            cfg.f0_min = (vv_dsp_real)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--f0-max") == 0 && i + 1 < argc) {
+            cfg.f0_max = (vv_dsp_real)atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!list_file || !output_file || cfg.rate == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    cfg.features.sample_rate = (vv_dsp_real)cfg.rate;
+    if (num_threads == 0) num_threads = vv_dsp_threadpool_num_threads(vv_dsp_threadpool_get_default());
+    if (num_threads == 0) num_threads = 1;
+
+    ex_job job;
+    memset(&job, 0, sizeof(job));
+    job.cfg = &cfg;
+    job.paths = read_list(list_file, &job.num_paths);
+    if (!job.paths) {
+        fprintf(stderr, "Error: Cannot read file list %s\n", list_file);
+        return 1;
+    }
+    if (num_threads > job.num_paths) num_threads = job.num_paths ? job.num_paths : 1;
+
+    ex_worker* workers = (ex_worker*)calloc(num_threads, sizeof(ex_worker));
+    int status = workers != NULL;
+    for (size_t t = 0; status && t < num_threads; t++) {
+        if (!worker_init(&workers[t], &job)) {
+            fprintf(stderr, "Error: Invalid feature configuration\n");
+            status = 0;
+        }
+    }
+    if (status && vv_dsp_feature_store_writer_open(output_file, workers[0].dim, cfg.features.hop_size,
+                                                   (double)cfg.rate, &job.out) != VV_DSP_OK) {
+        fprintf(stderr, "Error: Cannot open output file %s\n", output_file);
+        status = 0;
+    }
+    if (status && f0_file &&
+        vv_dsp_feature_store_writer_open(f0_file, 1, cfg.features.hop_size, (double)cfg.rate, &job.f0_out) !=
+            VV_DSP_OK) {
+        fprintf(stderr, "Error: Cannot open output file %s\n", f0_file);
+        status = 0;
+    }
+
+    vv_dsp_threadpool* pool = NULL;
+    if (status) {
+        vv_dsp_threadpool_params tp;
+        memset(&tp, 0, sizeof(tp));
+        tp.num_threads = num_threads;
+        if (vv_dsp_threadpool_create(&tp, &pool) != VV_DSP_OK) {
+            fprintf(stderr, "Error: Cannot start %zu threads\n", num_threads);
+            status = 0;
+        }
+    }
+
+    const double t0 = now_sec();
+    if (status) {
+#if defined(_WIN32)
+        InitializeCriticalSection(&job.out_lock);
+#else
+        pthread_mutex_init(&job.out_lock, NULL);
+#endif
+        status = vv_dsp_threadpool_parallel_for(pool, job.num_paths, 1, worker_range, workers) == VV_DSP_OK;
+#if defined(_WIN32)
+        DeleteCriticalSection(&job.out_lock);
+#else
+        pthread_mutex_destroy(&job.out_lock);
+#endif
+    }
+    vv_dsp_threadpool_destroy(pool);
+    const double elapsed = now_sec() - t0;
+    if (vv_dsp_feature_store_writer_close(job.out) != VV_DSP_OK) status = 0;
+    if (vv_dsp_feature_store_writer_close(job.f0_out) != VV_DSP_OK) status = 0;
+
+    if (status) {
+        printf("# %zu files (%zu failed), %.1f s of audio in %.2f s on %zu threads (%.0fx real time)\n",
+               job.num_paths, job.failed, job.audio_seconds, elapsed, num_threads,
+               elapsed > 0.0 ? job.audio_seconds / elapsed : 0.0);
+    }
+
+    for (size_t t = 0; workers && t < num_threads; t++) worker_destroy(&workers[t]);
+    free(workers);
+    for (size_t i = 0; i < job.num_paths; i++) free(job.paths[i]);
+    free(job.paths);
+    return status && job.failed == 0 ? 0 : 1;
+}
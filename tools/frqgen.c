@@ -0,0 +1,493 @@
+// Voicebank .frq generation: find every WAV file under a voicebank directory and
+// write its UTAU frequency map ("name_wav.frq" next to "name.wav") with YIN F0 and
+// RMS amplitude per 256-sample frame, on a vv_dsp_threadpool whose workers take
+// files one at a time and steal from busy workers. Maps that are already current are skipped: by default a map
+// newer than its WAV is current; with --hash it must record the WAV's content hash,
+// which also catches WAVs replaced by older copies or edited within a second.
+//
+// Frame i is centred on sample i * hop, as UTAU's own maps are: the mono signal is
+// zero-padded by half a YIN span on the left and the map has n / hop + 1 frames.
+//
+// With --marks the PSOLA pitch marks (audio/psola.h) are placed from the same F0
+// track and cached as "name_wav.pmk" next to the map; a file is then current only
+// when both are.
+
+#include "vv_dsp/audio/wav.h"
+#include "vv_dsp/audio/frq.h"
+#include "vv_dsp/audio/psola.h"
+#include "vv_dsp/features/pitch.h"
+#include "vv_dsp/core/threadpool.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef CRITICAL_SECTION fg_mutex;
+#define FG_LOCK(m)   EnterCriticalSection(m)
+#define FG_UNLOCK(m) LeaveCriticalSection(m)
+#define FG_SEP '\\'
+typedef struct __stat64 fg_stat;
+#define FG_STAT(path, st) _stat64((path), (st))
+static double now_sec(void) {
+    LARGE_INTEGER freq, ctr;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&ctr);
+    return (double)ctr.QuadPart / (double)freq.QuadPart;
+}
+#else
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+typedef pthread_mutex_t fg_mutex;
+#define FG_LOCK(m)   pthread_mutex_lock(m)
+#define FG_UNLOCK(m) pthread_mutex_unlock(m)
+#define FG_SEP '/'
+typedef struct stat fg_stat;
+#define FG_STAT(path, st) stat((path), (st))
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+typedef struct {
+    size_t hop;
+    vv_dsp_real f0_min;
+    vv_dsp_real f0_max;
+    vv_dsp_real threshold;
+    int use_hash;
+    int force;
+    int marks;
+} fg_config;
+
+// Shared state: the WAV list and the counters
+typedef struct {
+    const fg_config* cfg;
+    char** paths;
+    size_t num_paths;
+    fg_mutex lock;
+    size_t generated;       // under lock
+    size_t current;         // under lock
+    size_t failed;          // under lock
+    double audio_seconds;   // under lock, generated files only
+} fg_job;
+
+// One worker's tracker (rebuilt when the sample rate changes) and buffers
+typedef struct {
+    fg_job* job;
+    vv_dsp_yin* yin;
+    double yin_rate;
+    vv_dsp_real* padded;
+    size_t padded_cap;
+    double* energy;         // prefix sums of the squared mono signal
+    size_t energy_cap;
+    vv_dsp_real* f0;
+    size_t f0_cap;
+    double* frames;         // f0 then amplitude, as written
+    size_t frames_cap;
+} fg_worker;
+
+static void print_usage(const char* program_name) {
+    printf("Usage: %s [options] VOICEBANK_DIR\n", program_name);
+    printf("Options:\n");
+    printf("  --threads N         Worker threads (default: online processors)\n");
+    printf("  --hash              Regenerate when the WAV content hash differs (default: when the WAV is newer)\n");
+    printf("  --force             Regenerate every map\n");
+    printf("  --marks             Also cache PSOLA pitch marks (name_wav.pmk)\n");
+    printf("  --hop H             Samples per frame (default: 256)\n");
+    printf("  --f0-min F          Lowest F0 in Hz (default: 50)\n");
+    printf("  --f0-max F          Highest F0 in Hz (default: 1000)\n");
+    printf("  --threshold T       YIN threshold (default: 0.1)\n");
+    printf("  --help              Show this help\n");
+}
+
+static int grow(void** buf, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return 1;
+    size_t n = *cap ? *cap : 4096;
+    while (n < need) n *= 2;
+    void* p = realloc(*buf, n * elem);
+    if (!p) return 0;
+    *buf = p;
+    *cap = n;
+    return 1;
+}
+
+// "dir/name.wav" -> "dir/name_wav.frq" (ext "frq") or "dir/name_wav.pmk" (ext "pmk")
+static char* frq_path_for(const char* wav_path, const char* ext) {
+    const size_t len = strlen(wav_path);
+    char* p = (char*)malloc(len + 5);
+    if (!p) return NULL;
+    memcpy(p, wav_path, len - 4);
+    memcpy(p + len - 4, "_wav.", 5);
+    memcpy(p + len + 1, ext, 4);
+    return p;
+}
+
+// A map is current when it records the WAV's hash (--hash) or is not older than it;
+// with --marks the pitch marks must be current too
+static int map_is_current(const fg_config* cfg, const char* wav_path, const char* frq_path,
+                          const char* pmk_path, uint64_t* hash) {
+    if (cfg->use_hash) {
+        vv_dsp_frq old;
+        if (vv_dsp_frq_file_hash(wav_path, hash) != VV_DSP_OK) return 0;
+        if (vv_dsp_frq_read(frq_path, &old) != VV_DSP_OK) return 0;
+        int same = old.source_hash == *hash && old.hop == cfg->hop;
+        vv_dsp_frq_free(&old);
+        if (same && pmk_path) {
+            vv_dsp_pitch_marks marks;
+            same = vv_dsp_pitch_marks_read(pmk_path, &marks) == VV_DSP_OK && marks.source_hash == *hash;
+            vv_dsp_pitch_marks_free(&marks);
+        }
+        return same;
+    }
+    fg_stat ws, fs, ps;
+    if (FG_STAT(wav_path, &ws) != 0 || FG_STAT(frq_path, &fs) != 0) return 0;
+    if (pmk_path && (FG_STAT(pmk_path, &ps) != 0 || ps.st_mtime < ws.st_mtime)) return 0;
+    return fs.st_mtime >= ws.st_mtime;
+}
+
+static int worker_tracker(fg_worker* w, double rate) {
+    if (w->yin && w->yin_rate == rate) return 1;
+    vv_dsp_yin_destroy(w->yin);
+    w->yin = NULL;
+    const fg_config* cfg = w->job->cfg;
+    vv_dsp_yin_params yp;
+    memset(&yp, 0, sizeof(yp));
+    yp.sample_rate = (vv_dsp_real)rate;
+    yp.f0_min = cfg->f0_min;
+    yp.f0_max = cfg->f0_max;
+    yp.hop = cfg->hop;
+    yp.threshold = cfg->threshold;
+    yp.num_threads = 1;
+    if (vv_dsp_yin_create(&yp, &w->yin) != VV_DSP_OK) return 0;
+    w->yin_rate = rate;
+    return 1;
+}
+
+// Analyse one WAV file and write its map, and its pitch marks when pmk_path is set
+static int worker_generate(fg_worker* w, const char* wav_path, const char* frq_path, const char* pmk_path,
+                           uint64_t hash, double* seconds) {
+    const fg_config* cfg = w->job->cfg;
+    vv_dsp_real** channels = NULL;
+    vv_dsp_wav_info info;
+    if (vv_dsp_wav_read(wav_path, &channels, &info) != VV_DSP_OK) return 0;
+    *seconds = (double)info.num_samples / info.sample_rate;
+    const size_t n = info.num_samples;
+    const size_t hop = cfg->hop;
+    const size_t num_frames = n / hop + 1;
+
+    int ok = worker_tracker(w, info.sample_rate);
+    const size_t span = ok ? vv_dsp_yin_frame_span(w->yin) : 0;
+    const size_t lead = span / 2;
+    const size_t padded_n = (num_frames - 1) * hop + span;
+    ok = ok && grow((void**)&w->padded, &w->padded_cap, padded_n, sizeof(vv_dsp_real)) &&
+         grow((void**)&w->energy, &w->energy_cap, n + 1, sizeof(double)) &&
+         grow((void**)&w->f0, &w->f0_cap, num_frames, sizeof(vv_dsp_real)) &&
+         grow((void**)&w->frames, &w->frames_cap, 2 * num_frames, sizeof(double));
+    if (ok) {
+        // Mono mix, zero-padded around the signal, and its energy prefix sums
+        const vv_dsp_real gain = (vv_dsp_real)1 / (vv_dsp_real)info.num_channels;
+        memset(w->padded, 0, padded_n * sizeof(vv_dsp_real));
+        vv_dsp_real* mono = w->padded + lead;
+        w->energy[0] = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            vv_dsp_real s = channels[0][i];
+            for (int ch = 1; ch < info.num_channels; ch++) s += channels[ch][i];
+            s *= gain;
+            if (lead + i < padded_n) mono[i] = s;  // the last frame may end before the signal
+            w->energy[i + 1] = w->energy[i] + (double)s * (double)s;
+        }
+        ok = vv_dsp_yin_process(w->yin, w->padded, padded_n, w->f0, NULL) == VV_DSP_OK;
+    }
+    vv_dsp_wav_free_buffer(&channels, info.num_channels);
+    if (!ok) return 0;
+
+    // Amplitude: RMS over the hop centred on the frame, in 16-bit full scale
+    vv_dsp_frq map;
+    map.hop = hop;
+    map.source_hash = hash;
+    map.num_frames = num_frames;
+    map.f0 = w->frames;
+    map.amplitude = w->frames + num_frames;
+    double f0_sum = 0.0;
+    size_t voiced = 0;
+    for (size_t i = 0; i < num_frames; i++) {
+        const size_t c = i * hop;
+        const size_t a = c > hop / 2 ? c - hop / 2 : 0;
+        const size_t b = c + hop - hop / 2 < n ? c + hop - hop / 2 : n;
+        const double rms = b > a ? sqrt((w->energy[b] - w->energy[a]) / (double)(b - a)) : 0.0;
+        map.f0[i] = (double)w->f0[i];
+        map.amplitude[i] = rms * 32768.0;
+        if (map.f0[i] > 0.0) {
+            f0_sum += map.f0[i];
+            voiced++;
+        }
+    }
+    map.average_f0 = voiced ? f0_sum / (double)voiced : 0.0;
+    if (vv_dsp_frq_write(frq_path, &map) != VV_DSP_OK) return 0;
+    if (!pmk_path || n == 0) return 1;
+
+    // Marks on the mono signal, which the padding may cut short by less than a hop
+    vv_dsp_pitch_marks marks;
+    const size_t mono_n = padded_n - lead < n ? padded_n - lead : n;
+    ok = vv_dsp_pitch_marks_compute(w->padded + lead, mono_n, info.sample_rate, &map, &marks) == VV_DSP_OK;
+    ok = ok && vv_dsp_pitch_marks_write(pmk_path, &marks) == VV_DSP_OK;
+    vv_dsp_pitch_marks_free(&marks);
+    return ok;
+}
+
+// Files [begin, end) on pool worker `worker`, which owns workers[worker]
+static void worker_range(void* ctx, size_t begin, size_t end, size_t worker) {
+    fg_worker* w = (fg_worker*)ctx + worker;
+    fg_job* job = w->job;
+    for (size_t index = begin; index < end; index++) {
+        const char* wav_path = job->paths[index];
+        char* frq_path = frq_path_for(wav_path, "frq");
+        char* pmk_path = job->cfg->marks ? frq_path_for(wav_path, "pmk") : NULL;
+        uint64_t hash = 0;
+        int current = 0, ok = frq_path != NULL && (pmk_path != NULL || !job->cfg->marks);
+        double seconds = 0.0;
+        if (ok && !job->cfg->force) current = map_is_current(job->cfg, wav_path, frq_path, pmk_path, &hash);
+        if (ok && !current) {
+            // Always record the hash, so a later --hash run can trust the map
+            ok = (hash || vv_dsp_frq_file_hash(wav_path, &hash) == VV_DSP_OK) &&
+                 worker_generate(w, wav_path, frq_path, pmk_path, hash, &seconds);
+        }
+        FG_LOCK(&job->lock);
+        if (!ok) {
+            fprintf(stderr, "Error: %s: %s\n", wav_path, vv_dsp_wav_get_error_string());
+            job->failed++;
+        } else if (current) {
+            job->current++;
+        } else {
+            job->generated++;
+            job->audio_seconds += seconds;
+        }
+        FG_UNLOCK(&job->lock);
+        free(frq_path);
+        free(pmk_path);
+    }
+}
+
+static void worker_destroy(fg_worker* w) {
+    vv_dsp_yin_destroy(w->yin);
+    free(w->padded);
+    free(w->energy);
+    free(w->f0);
+    free(w->frames);
+}
+
+typedef struct {
+    char** paths;
+    size_t count;
+    size_t cap;
+    int failed;
+} fg_list;
+
+static int has_wav_extension(const char* name) {
+    const size_t len = strlen(name);
+    if (len < 5) return 0;
+    const char* ext = name + len - 4;
+    return ext[0] == '.' && (ext[1] == 'w' || ext[1] == 'W') && (ext[2] == 'a' || ext[2] == 'A') &&
+           (ext[3] == 'v' || ext[3] == 'V');
+}
+
+static char* join_path(const char* dir, const char* name) {
+    const size_t a = strlen(dir), b = strlen(name);
+    char* p = (char*)malloc(a + b + 2);
+    if (!p) return NULL;
+    memcpy(p, dir, a);
+    p[a] = FG_SEP;
+    memcpy(p + a + 1, name, b + 1);
+    return p;
+}
+
+static void list_add(fg_list* list, char* path) {
+    if (!path) {
+        list->failed = 1;
+        return;
+    }
+    if (list->count == list->cap) {
+        const size_t cap = list->cap ? list->cap * 2 : 256;
+        char** p = (char**)realloc(list->paths, cap * sizeof(char*));
+        if (!p) {
+            free(path);
+            list->failed = 1;
+            return;
+        }
+        list->paths = p;
+        list->cap = cap;
+    }
+    list->paths[list->count++] = path;
+}
+
+// Collect the WAV files under dir, subdirectories (per-pitch banks) included
+static void scan_directory(const char* dir, fg_list* list) {
+#if defined(_WIN32)
+    char* pattern = join_path(dir, "*");
+    if (!pattern) {
+        list->failed = 1;
+        return;
+    }
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA(pattern, &fd);
+    free(pattern);
+    if (h == INVALID_HANDLE_VALUE) {
+        list->failed = 1;
+        return;
+    }
+    do {
+        const char* name = fd.cFileName;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+        if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            char* sub = join_path(dir, name);
+            if (!sub) {
+                list->failed = 1;
+                continue;
+            }
+            scan_directory(sub, list);
+            free(sub);
+        } else if (has_wav_extension(name)) {
+            list_add(list, join_path(dir, name));
+        }
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+#else
+    DIR* d = opendir(dir);
+    if (!d) {
+        list->failed = 1;
+        return;
+    }
+    struct dirent* e;
+    while ((e = readdir(d)) != NULL) {
+        const char* name = e->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+        char* path = join_path(dir, name);
+        fg_stat st;
+        if (!path || FG_STAT(path, &st) != 0) {
+            free(path);
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            scan_directory(path, list);
+            free(path);
+        } else if (S_ISREG(st.st_mode) && has_wav_extension(name)) {
+            list_add(list, path);
+        } else {
+            free(path);
+        }
+    }
+    closedir(d);
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    fg_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.hop = 256;
+    cfg.f0_min = 50.0f;
+    cfg.f0_max = 1000.0f;
+    cfg.threshold = 0.1f;
+    const char* directory = NULL;
+    size_t num_threads = 0;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hash") == 0) {
+            cfg.use_hash = 1;
+        } else if (strcmp(argv[i], "--force") == 0) {
+            cfg.force = 1;
+        } else if (strcmp(argv[i], "--marks") == 0) {
+            cfg.marks = 1;
+        } else if (strcmp(argv[i], "--hop") == 0 && i + 1 < argc) {
+            cfg.hop = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--f0-min") == 0 && i + 1 < argc) {
+            cfg.f0_min = (vv_dsp_real)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--f0-max") == 0 && i + 1 < argc) {
+            cfg.f0_max = (vv_dsp_real)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            cfg.threshold = (vv_dsp_real)atof(argv[++i]);
+        } else if (argv[i][0] != '-' && !directory) {
+            directory = argv[i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!directory || cfg.hop == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (num_threads == 0) num_threads = vv_dsp_threadpool_num_threads(vv_dsp_threadpool_get_default());
+    if (num_threads == 0) num_threads = 1;
+
+    fg_list list;
+    memset(&list, 0, sizeof(list));
+    scan_directory(directory, &list);
+    if (list.failed) {
+        fprintf(stderr, "Error: Cannot scan %s\n", directory);
+        for (size_t i = 0; i < list.count; i++) free(list.paths[i]);
+        free(list.paths);
+        return 1;
+    }
+
+    fg_job job;
+    memset(&job, 0, sizeof(job));
+    job.cfg = &cfg;
+    job.paths = list.paths;
+    job.num_paths = list.count;
+    if (num_threads > job.num_paths) num_threads = job.num_paths ? job.num_paths : 1;
+
+    fg_worker* workers = (fg_worker*)calloc(num_threads, sizeof(fg_worker));
+    int status = workers != NULL;
+    for (size_t t = 0; status && t < num_threads; t++) workers[t].job = &job;
+
+    vv_dsp_threadpool* pool = NULL;
+    if (status) {
+        vv_dsp_threadpool_params tp;
+        memset(&tp, 0, sizeof(tp));
+        tp.num_threads = num_threads;
+        if (vv_dsp_threadpool_create(&tp, &pool) != VV_DSP_OK) {
+            fprintf(stderr, "Error: Cannot start %zu threads\n", num_threads);
+            status = 0;
+        }
+    }
+
+    const double t0 = now_sec();
+    if (status) {
+#if defined(_WIN32)
+        InitializeCriticalSection(&job.lock);
+#else
+        pthread_mutex_init(&job.lock, NULL);
+#endif
+        status = vv_dsp_threadpool_parallel_for(pool, job.num_paths, 1, worker_range, workers) == VV_DSP_OK;
+#if defined(_WIN32)
+        DeleteCriticalSection(&job.lock);
+#else
+        pthread_mutex_destroy(&job.lock);
+#endif
+    }
+    vv_dsp_threadpool_destroy(pool);
+    const double elapsed = now_sec() - t0;
+
+    if (status) {
+        printf("# %zu WAV files: %zu generated (%.1f s of audio), %zu current, %zu failed in %.2f s on %zu threads\n",
+               job.num_paths, job.generated, job.audio_seconds, job.current, job.failed, elapsed, num_threads);
+    }
+
+    for (size_t t = 0; workers && t < num_threads; t++) worker_destroy(&workers[t]);
+    free(workers);
+    for (size_t i = 0; i < job.num_paths; i++) free(job.paths[i]);
+    free(job.paths);
+    return status && job.failed == 0 ? 0 : 1;
+}